@@ -675,6 +675,14 @@ void Agent::queryAvatars() {
 
     destinationBuffer += conicalView.serialize(destinationBuffer);
 
+    // no rate or bandwidth limits
+    uint8_t maxUpdateRate = 0;
+    memcpy(destinationBuffer, &maxUpdateRate, sizeof(maxUpdateRate));
+    destinationBuffer += sizeof(maxUpdateRate);
+    uint16_t maxReceiveKbps = 0;
+    memcpy(destinationBuffer, &maxReceiveKbps, sizeof(maxReceiveKbps));
+    destinationBuffer += sizeof(maxReceiveKbps);
+
     avatarPacket->setPayloadSize(destinationBuffer - bufferStart);
 
     DependencyManager::get<NodeList>()->broadcastToNodes(std::move(avatarPacket),
@@ -50,6 +50,9 @@ AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QStri
                                    bool disableDomainPortAutoDiscovery) :
     _assignmentServerHostname(DEFAULT_ASSIGNMENT_SERVER_HOSTNAME)
 {
+    _startedUsecs = usecTimestampNow();
+    _idleSinceUsecs = _startedUsecs;
+
     LogUtils::init();
 
     DependencyManager::set<tracing::Tracer>();
@@ -103,6 +106,8 @@ AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QStri
 
     connect(&_requestTimer, SIGNAL(timeout()), SLOT(sendAssignmentRequest()));
     _requestTimer.start(ASSIGNMENT_REQUEST_INTERVAL_MSECS);
+    // and ask as soon as we're up, rather than an interval from now
+    QTimer::singleShot(0, this, &AssignmentClient::sendAssignmentRequest);
 
     // connections to AccountManager for authentication
     connect(DependencyManager::get<AccountManager>().data(), &AccountManager::authRequired,
@@ -224,6 +229,9 @@ void AssignmentClient::sendAssignmentRequest() {
         }
 
         nodeList->sendAssignment(_requestAssignment);
+        if (_firstRequestUsecs == 0) {
+            _firstRequestUsecs = usecTimestampNow();
+        }
     }
 }
 
@@ -242,6 +250,17 @@ void AssignmentClient::handleCreateAssignmentPacket(QSharedPointer<ReceivedMessa
         qDebug(assignment_client) << "Received an assignment -" << *_currentAssignment;
         _isAssigned = true;
 
+        quint64 receivedUsecs = usecTimestampNow();
+        QJsonObject assignmentClientStats;
+        assignmentClientStats["startupMsecs"] = (double)(_firstRequestUsecs - _startedUsecs) / USECS_PER_MSEC;
+        assignmentClientStats["idleMsecs"] = (double)(receivedUsecs - _idleSinceUsecs) / USECS_PER_MSEC;
+        assignmentClientStats["previousAssignments"] = _numCompletedAssignments;
+
+        if (!_assignmentClientMonitorSocket.isNull()) {
+            // let the monitor know this spare is taken right away, so that it can start another
+            sendStatusPacketToACM();
+        }
+
         auto nodeList = DependencyManager::get<NodeList>();
 
         // switch our DomainHandler hostname and port to whoever sent us the assignment
@@ -255,8 +274,11 @@ void AssignmentClient::handleCreateAssignmentPacket(QSharedPointer<ReceivedMessa
         QThread* workerThread = new QThread();
         workerThread->setObjectName("ThreadedAssignment Worker");
 
-        connect(workerThread, &QThread::started, _currentAssignment.data(), [this] {
+        connect(workerThread, &QThread::started, _currentAssignment.data(), [this, receivedUsecs, assignmentClientStats] {
             setThreadName("ThreadedAssignment Worker");
+            QJsonObject stats = assignmentClientStats;
+            stats["launchMsecs"] = (double)(usecTimestampNow() - receivedUsecs) / USECS_PER_MSEC;
+            _currentAssignment->setAssignmentClientStats(stats);
             _currentAssignment->run();
         });
 
@@ -346,6 +368,14 @@ void AssignmentClient::assignmentCompleted() {
     nodeList->resetNodeInterestSet();
 
     _isAssigned = false;
+    ++_numCompletedAssignments;
+    _idleSinceUsecs = usecTimestampNow();
+
+    // This process is reused for the next assignment rather than restarted, so it is ready as soon as it asks
+    if (!_assignmentClientMonitorSocket.isNull()) {
+        sendStatusPacketToACM();
+    }
+    sendAssignmentRequest();
 }
 
 #if defined(WEBRTC_DATA_CHANNELS)
@@ -64,6 +64,12 @@ private:
     QTimer _requestTimer; // timer for requesting and assignment
     QTimer _statsTimerACM; // timer for sending stats to assignment client monitor
     QUuid _childAssignmentUUID = QUuid::createUuid();
+
+    // for the stats of the assignments, how long this client took to be ready and waited for each of them
+    quint64 _startedUsecs { 0 };
+    quint64 _firstRequestUsecs { 0 };
+    quint64 _idleSinceUsecs { 0 };
+    int _numCompletedAssignments { 0 };
     bool _disableDomainPortAutoDiscovery { false };
 
  protected:
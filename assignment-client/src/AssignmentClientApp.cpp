@@ -89,6 +89,10 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
     const QCommandLineOption maxChildsOption(ASSIGNMENT_MAX_FORKS_OPTION, "maximum number of children", "child-count");
     parser.addOption(maxChildsOption);
 
+    const QCommandLineOption spareChildsOption(ASSIGNMENT_SPARE_FORKS_OPTION,
+        "number of idle children kept started and ready for new assignments (default 1)", "child-count");
+    parser.addOption(spareChildsOption);
+
     const QCommandLineOption monitorPortOption(ASSIGNMENT_CLIENT_MONITOR_PORT_OPTION, "assignment-client monitor port", "port");
     parser.addOption(monitorPortOption);
 
@@ -154,6 +158,11 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
         maxForks = parser.value(maxChildsOption).toInt();
     }
 
+    unsigned int spareForks = 1;
+    if (parser.isSet(spareChildsOption)) {
+        spareForks = parser.value(spareChildsOption).toInt();
+    }
+
     unsigned short monitorPort = 0;
     if (parser.isSet(monitorPortOption)) {
         monitorPort = parser.value(monitorPortOption).toUShort();
@@ -246,6 +255,12 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
         }
     }
 
+    if (maxForks && spareForks > maxForks) {
+        qCritical() << "--spares can't be more than --max";
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
     if (parser.isSet(parentPIDOption)) {
         bool ok = false;
         int parentPID = parser.value(parentPIDOption).toInt(&ok);
@@ -269,7 +284,7 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
     DependencyManager::set<ScriptInitializers>();
 
     if (numForks || minForks || maxForks) {
-        AssignmentClientMonitor* monitor =  new AssignmentClientMonitor(numForks, minForks, maxForks,
+        AssignmentClientMonitor* monitor =  new AssignmentClientMonitor(numForks, minForks, maxForks, spareForks,
                                                                         requestAssignmentType, assignmentPool, listenPort,
                                                                         childMinListenPort, assignmentServerHostname,
                                                                         assignmentServerPort, httpStatusPort, logDirectory,
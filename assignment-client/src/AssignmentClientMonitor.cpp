@@ -40,6 +40,7 @@ void* PROCESS_GROUP = createProcessGroup();
 AssignmentClientMonitor::AssignmentClientMonitor(const unsigned int numAssignmentClientForks,
                                                  const unsigned int minAssignmentClientForks,
                                                  const unsigned int maxAssignmentClientForks,
+                                                 const unsigned int spareAssignmentClientForks,
                                                  Assignment::Type requestAssignmentType, QString assignmentPool,
                                                  quint16 listenPort, quint16 childMinListenPort, QString assignmentServerHostname,
                                                  quint16 assignmentServerPort, quint16 httpStatusServerPort, QString logDirectory,
@@ -48,6 +49,7 @@ AssignmentClientMonitor::AssignmentClientMonitor(const unsigned int numAssignmen
     _numAssignmentClientForks(numAssignmentClientForks),
     _minAssignmentClientForks(minAssignmentClientForks),
     _maxAssignmentClientForks(maxAssignmentClientForks),
+    _spareAssignmentClientForks(spareAssignmentClientForks),
     _requestAssignmentType(requestAssignmentType),
     _assignmentPool(assignmentPool),
     _assignmentServerHostname(assignmentServerHostname),
@@ -125,11 +127,17 @@ void AssignmentClientMonitor::childProcessFinished(qint64 pid, quint16 listenPor
             qCritical() << qPrintable(message.arg("crashed"));
             break;
     }
+
+    if (!_isStoppingChildren) {
+        // replace it now rather than at the next check, the domain-server is likely to want its assignment again
+        checkSparesSoon();
+    }
 }
 
 void AssignmentClientMonitor::stopChildProcesses() {
     qDebug() << "Stopping child processes";
     auto nodeList = DependencyManager::get<NodeList>();
+    _isStoppingChildren = true;
 
     // ask child processes to terminate
     for (auto& ac : _childProcesses) {
@@ -286,7 +294,21 @@ void AssignmentClientMonitor::spawnChildClient() {
     }
 }
 
+void AssignmentClientMonitor::checkSparesSoon() {
+    if (!_isCheckSparesScheduled) {
+        _isCheckSparesScheduled = true;
+        QTimer::singleShot(0, this, [this] {
+            _isCheckSparesScheduled = false;
+            checkSpares();
+        });
+    }
+}
+
 void AssignmentClientMonitor::checkSpares() {
+    if (_isStoppingChildren) {
+        return;
+    }
+
     auto nodeList = DependencyManager::get<NodeList>();
     QUuid aSpareId = "";
     unsigned int spareCount = 0;
@@ -303,16 +325,22 @@ void AssignmentClientMonitor::checkSpares() {
         }
     });
 
+    // children that haven't reported yet are still starting, and will be spares once they have
+    unsigned int childCount = std::max((unsigned int)_childProcesses.size(), totalCount);
+    unsigned int startingCount = childCount - totalCount;
+
     // Spawn or kill children, as needed.  If --min or --max weren't specified, allow the child count
     // to drift up or down as far as needed.
 
-    if (spareCount < 1 || totalCount < _minAssignmentClientForks) {
-        if (!_maxAssignmentClientForks || totalCount < _maxAssignmentClientForks) {
-            spawnChildClient();
-        }
+    unsigned int idleCount = spareCount + startingCount;
+    while ((idleCount < _spareAssignmentClientForks || childCount < _minAssignmentClientForks) &&
+           (!_maxAssignmentClientForks || childCount < _maxAssignmentClientForks)) {
+        spawnChildClient();
+        ++idleCount;
+        ++childCount;
     }
 
-    if (spareCount > 1) {
+    if (spareCount > std::max(_spareAssignmentClientForks, 1u)) {
         if (!_minAssignmentClientForks || totalCount > _minAssignmentClientForks) {
             // kill aSpareId
             qDebug() << "asking child" << aSpareId << "to exit.";
@@ -370,6 +398,10 @@ void AssignmentClientMonitor::handleChildStatusPacket(QSharedPointer<ReceivedMes
         quint8 assignmentType;
         message->readPrimitive(&assignmentType);
 
+        if (childData->getChildType() == Assignment::Type::AllTypes && assignmentType != Assignment::Type::AllTypes) {
+            // a spare took an assignment, start its replacement before the next one is handed out
+            checkSparesSoon();
+        }
         childData->setChildType(Assignment::Type(assignmentType));
 
         // note when this child talked
@@ -395,6 +427,18 @@ bool AssignmentClientMonitor::handleHTTPRequest(HTTPConnection* connection, cons
 
         status["servers"] = servers;
 
+        unsigned int spareCount = 0;
+        DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
+            auto childData = static_cast<AssignmentClientChildData*>(node->getLinkedData());
+            if (childData && childData->getChildType() == Assignment::Type::AllTypes) {
+                ++spareCount;
+            }
+        });
+        QJsonObject pool;
+        pool["spares"] = (int)spareCount;
+        pool["targetSpares"] = (int)_spareAssignmentClientForks;
+        status["pool"] = pool;
+
         QJsonDocument document { status };
 
         connection->respond(HTTPConnection::StatusCode200, document.toJson());
@@ -38,7 +38,8 @@ class AssignmentClientMonitor : public QObject, public HTTPRequestHandler {
     Q_OBJECT
 public:
     AssignmentClientMonitor(const unsigned int numAssignmentClientForks, const unsigned int minAssignmentClientForks,
-                            const unsigned int maxAssignmentClientForks, Assignment::Type requestAssignmentType,
+                            const unsigned int maxAssignmentClientForks, const unsigned int spareAssignmentClientForks,
+                            Assignment::Type requestAssignmentType,
                             QString assignmentPool, quint16 listenPort, quint16 childMinListenPort,
                             QString assignmentServerHostname, quint16 assignmentServerPort, quint16 httpStatusServerPort,
                             QString logDirectory, bool disableDomainPortAutoDiscovery);
@@ -57,6 +58,7 @@ public slots:
 
 private:
     void spawnChildClient();
+    void checkSparesSoon();
     void simultaneousWaitOnChildren(int waitMsecs);
     void adjustOSResources(unsigned int numForks) const;
 
@@ -69,6 +71,10 @@ private:
     const unsigned int _numAssignmentClientForks;
     const unsigned int _minAssignmentClientForks;
     const unsigned int _maxAssignmentClientForks;
+    // idle children kept ready, so that an assignment doesn't wait for a child to start
+    const unsigned int _spareAssignmentClientForks;
+    bool _isCheckSparesScheduled { false };
+    bool _isStoppingChildren { false };
 
     Assignment::Type _requestAssignmentType;
     QString _assignmentPool;
@@ -0,0 +1,83 @@
+//
+//  AssetFileCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AssetFileCache.h"
+
+AssetFileCache::MappedFile::MappedFile(const QString& filePath) : _file(filePath) {
+    if (!_file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    _size = _file.size();
+    if (_size == 0) {
+        // an empty file can't be mapped, but there's nothing to read from it
+        _isValid = true;
+        return;
+    }
+    _data = _file.map(0, _size);
+    _isValid = _data != nullptr;
+}
+
+AssetFileCache::MappedFile::~MappedFile() {
+    if (_data) {
+        _file.unmap(_data);
+    }
+}
+
+AssetFileCache::AssetFileCache(qint64 maxSize) : _maxSize(maxSize) {
+}
+
+AssetFileCache::MappedFilePointer AssetFileCache::get(const QString& hash, const QString& filePath) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto itr = _entriesByHash.find(hash);
+        if (itr != _entriesByHash.end()) {
+            _entries.splice(_entries.begin(), _entries, itr.value());
+            return _entries.front().second;
+        }
+    }
+
+    // the file is mapped outside of the lock, a concurrent request for the same asset maps it once more at worst
+    auto file = std::make_shared<const MappedFile>(filePath);
+    if (!file->isValid()) {
+        return nullptr;
+    }
+    if (file->getSize() > _maxSize) {
+        // too big to keep, it's unmapped once it has been sent
+        return file;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto itr = _entriesByHash.find(hash);
+    if (itr != _entriesByHash.end()) {
+        _entries.splice(_entries.begin(), _entries, itr.value());
+        return _entries.front().second;
+    }
+    _entries.emplace_front(hash, file);
+    _entriesByHash[hash] = _entries.begin();
+    _size += file->getSize();
+    while (_size > _maxSize) {
+        auto& oldest = _entries.back();
+        _size -= oldest.second->getSize();
+        _entriesByHash.remove(oldest.first);
+        _entries.pop_back();
+    }
+    return file;
+}
+
+void AssetFileCache::remove(const QString& hash) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto itr = _entriesByHash.find(hash);
+    if (itr != _entriesByHash.end()) {
+        _size -= itr.value()->second->getSize();
+        _entries.erase(itr.value());
+        _entriesByHash.erase(itr);
+    }
+}
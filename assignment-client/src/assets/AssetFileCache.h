@@ -0,0 +1,63 @@
+//
+//  AssetFileCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_AssetFileCache_h
+#define overte_AssetFileCache_h
+
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+/// The asset files that were sent recently, mapped into memory so that the transfer tasks write their data into the reply
+/// packets straight from the mapped pages, rather than reading it into a buffer first.  The least recently used files are
+/// unmapped once the mapped files add up to more than the size limit.  It's used from the threads of the transfer pool.
+class AssetFileCache {
+public:
+    class MappedFile {
+    public:
+        MappedFile(const QString& filePath);
+        ~MappedFile();
+
+        bool isValid() const { return _isValid; }
+        const char* getData() const { return reinterpret_cast<const char*>(_data); }
+        qint64 getSize() const { return _size; }
+
+    private:
+        QFile _file;
+        uchar* _data { nullptr };
+        qint64 _size { 0 };
+        bool _isValid { false };
+    };
+    using MappedFilePointer = std::shared_ptr<const MappedFile>;
+
+    AssetFileCache(qint64 maxSize);
+
+    /// Returns the mapped file of an asset, mapping it if it isn't yet, or nullptr if the file can't be opened
+    MappedFilePointer get(const QString& hash, const QString& filePath);
+    /// Unmaps the file of an asset that's about to be deleted, once the tasks that are sending it are done with it
+    void remove(const QString& hash);
+
+private:
+    using Entry = std::pair<QString, MappedFilePointer>;
+
+    std::mutex _mutex;
+    // the most recently used first
+    std::list<Entry> _entries;
+    QHash<QString, std::list<Entry>::iterator> _entriesByHash;
+    qint64 _size { 0 };
+    qint64 _maxSize;
+};
+
+#endif // overte_AssetFileCache_h
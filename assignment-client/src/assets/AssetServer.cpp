@@ -12,6 +12,7 @@
 
 #include "AssetServer.h"
 
+#include <algorithm>
 #include <thread>
 #include <memory>
 
@@ -22,6 +23,7 @@
 #include <QtCore/QDirIterator>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QSaveFile>
 #include <QtCore/QString>
@@ -31,6 +33,7 @@
 
 #include <ClientServerUtils.h>
 #include <NodeType.h>
+#include <NumericalConstants.h>
 #include <SharedUtil.h>
 #include <PathUtils.h>
 #include <image/TextureProcessing.h>
@@ -47,6 +50,9 @@ static const uint8_t CPU_AFFINITY_COUNT_LOW = 1;
 static const int INTERFACE_RUNNING_CHECK_FREQUENCY_MS = 1000;
 #endif
 
+// the asset files that were sent recently stay mapped while they add up to less than this
+static const qint64 MAX_MAPPED_ASSET_FILES_SIZE = 512 * 1024 * 1024;
+
 static const QStringList BAKEABLE_MODEL_EXTENSIONS = { "fbx" };
 static QStringList BAKEABLE_TEXTURE_EXTENSIONS;
 static const QStringList BAKEABLE_SCRIPT_EXTENSIONS = { };
@@ -117,7 +123,8 @@ void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetU
     qDebug() << "Starting bake for: " << assetPath << assetHash;
     auto it = _pendingBakes.find(assetHash);
     if (it == _pendingBakes.end()) {
-        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath);
+        auto bakeVersion = currentBakeVersionForAssetType(assetTypeForFilename(assetPath));
+        auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath, _bakeQueuePath, bakeVersion);
         task->setAutoDelete(false);
         _pendingBakes[assetHash] = task;
 
@@ -294,6 +301,7 @@ void updateConsumedCores() {
 AssetServer::AssetServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
     _transferTaskPool(this),
+    _fileCache(MAX_MAPPED_ASSET_FILES_SIZE),
     _bakingTaskPool(this),
     _filesizeLimit(AssetUtils::MAX_UPLOAD_SIZE)
 {
@@ -305,6 +313,7 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     static const int TASK_POOL_THREAD_COUNT = 50;
     _transferTaskPool.setMaxThreadCount(TASK_POOL_THREAD_COUNT);
     _bakingTaskPool.setMaxThreadCount(1);
+    _lastTransferStatsTime = usecTimestampNow();
 
     // Queue all requests until the Asset Server is fully setup
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
@@ -395,6 +404,23 @@ void AssetServer::completeSetup() {
                     " (" << maxBandwidth << "bits/s)";
     }
 
+    // the default keeps latency low on short links, the model based controllers fill long, high-RTT ones better
+    static const QString CONGESTION_CONTROL_OPTION = "congestion_control";
+    auto congestionControl = assetServerObject[CONGESTION_CONTROL_OPTION].toString();
+    if (!congestionControl.isEmpty() && nodeList->setConnectionCongestionControl(congestionControl)) {
+        qCInfo(asset_server) << "Using" << congestionControl << "congestion control for asset transfers";
+    }
+
+    // the bakes are handed to the ovens serving a bake queue, on this machine or on others sharing its directory
+    static const QString BAKE_QUEUE_PATH_OPTION = "bake_queue_path";
+    _bakeQueuePath = assetServerObject[BAKE_QUEUE_PATH_OPTION].toString();
+    if (!_bakeQueuePath.isEmpty()) {
+        // the ovens started here only wait for the workers of the queue
+        static const int BAKE_QUEUE_SUBMISSION_COUNT = 16;
+        _bakingTaskPool.setMaxThreadCount(BAKE_QUEUE_SUBMISSION_COUNT);
+        qCInfo(asset_server) << "Baking assets through the bake queue" << _bakeQueuePath;
+    }
+
     // get the path to the asset folder from the domain server settings
     static const QString ASSETS_PATH_OPTION = "assets_path";
     auto assetsJSONValue = assetServerObject[ASSETS_PATH_OPTION];
@@ -543,6 +569,7 @@ void AssetServer::cleanupUnmappedFiles() {
             }
             if (!matched) {
                 // remove the unmapped file
+                _fileCache.remove(filename);
                 QFile removeableFile { fileInfo.absoluteFilePath() };
 
                 if (removeableFile.remove()) {
@@ -611,7 +638,7 @@ void AssetServer::handleAssetMappingOperation(QSharedPointer<ReceivedMessage> me
             handleGetMappingOperation(*message, *replyPacket);
             break;
         case AssetMappingOperationType::GetAll:
-            handleGetAllMappingOperation(*replyPacket);
+            handleGetAllMappingOperation(*message, *replyPacket);
             break;
         case AssetMappingOperationType::Set:
             handleSetMappingOperation(*message, canWriteToAssetServer, *replyPacket);
@@ -708,14 +735,36 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketLi
     }
 }
 
-void AssetServer::handleGetAllMappingOperation(NLPacketList& replyPacket) {
+void AssetServer::handleGetAllMappingOperation(ReceivedMessage& message, NLPacketList& replyPacket) {
+    // a request for a page of the mappings has the prefix of the paths to list, the last path of the previous page and the
+    // size of the page, the requests that don't have them list all the mappings
+    AssetUtils::AssetPath prefix;
+    AssetUtils::AssetPath startAfter;
+    uint32_t pageSize = 0;
+    bool isPaged = message.getBytesLeftToRead() > 0;
+    if (isPaged) {
+        prefix = message.readString();
+        startAfter = message.readString();
+        message.readPrimitive(&pageSize);
+    }
+
     replyPacket.writePrimitive(AssetUtils::AssetServerError::NoError);
 
-    uint32_t count = (uint32_t)_fileMappings.size();
+    // the mappings are sorted by path, the ones with the prefix follow it
+    auto begin = _fileMappings.lower_bound(prefix);
+    if (!startAfter.isEmpty() && startAfter >= prefix) {
+        begin = _fileMappings.upper_bound(startAfter);
+    }
+    auto end = begin;
+    uint32_t count = 0;
+    while (end != _fileMappings.cend() && end->first.startsWith(prefix) && (pageSize == 0 || count < pageSize)) {
+        ++end;
+        ++count;
+    }
 
     replyPacket.writePrimitive(count);
 
-    for (auto it = _fileMappings.cbegin(); it != _fileMappings.cend(); ++ it) {
+    for (auto it = begin; it != end; ++ it) {
         auto mapping = it->first;
         auto hash = it->second;
         replyPacket.writeString(mapping);
@@ -729,6 +778,11 @@ void AssetServer::handleGetAllMappingOperation(NLPacketList& replyPacket) {
             replyPacket.writeString(lastBakeErrors);
         }
     }
+
+    if (isPaged) {
+        bool hasMore = end != _fileMappings.cend() && end->first.startsWith(prefix);
+        replyPacket.writePrimitive(hasMore);
+    }
 }
 
 void AssetServer::handleSetMappingOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket) {
@@ -874,7 +928,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, this);
     _transferTaskPool.start(task);
 }
 
@@ -888,7 +942,7 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     if (canWriteToAssetServer) {
         qCDebug(asset_server) << "Starting an UploadAssetTask for upload from" << message->getSourceID();
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit);
+        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit, _fileCache);
         _transferTaskPool.start(task);
     } else {
         // this is a node the domain told us is not allowed to rez entities
@@ -914,9 +968,26 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     }
 }
 
+void AssetServer::recordAssetTransfer(const QUuid& nodeID, qint64 bytes) {
+    std::lock_guard<std::mutex> lock(_transferStatsMutex);
+    auto& stats = _transferStats[nodeID];
+    stats.requests++;
+    stats.bytes += bytes;
+}
+
 void AssetServer::sendStatsPacket() {
     QJsonObject serverStats;
 
+    QHash<QUuid, AssetTransferStats> transferStats;
+    quint64 now = usecTimestampNow();
+    float transferStatsElapsed;
+    {
+        std::lock_guard<std::mutex> lock(_transferStatsMutex);
+        transferStats.swap(_transferStats);
+        transferStatsElapsed = std::max((float)(now - _lastTransferStatsTime) / USECS_PER_SECOND, 1.0f / USECS_PER_SECOND);
+        _lastTransferStatsTime = now;
+    }
+
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->eachNode([&](auto& node) {
         auto& stats = node->getConnectionStats();
@@ -961,6 +1032,12 @@ void AssetServer::sendStatsPacket() {
         downstreamStats["4. Duplicates"] = (int)stats.duplicatePackets;
         nodeStats["Downstream Stats"] = downstreamStats;
 
+        AssetTransferStats nodeTransferStats = transferStats.value(node->getUUID());
+        QJsonObject assetTransferStats;
+        assetTransferStats["1. Requests (/s)"] = nodeTransferStats.requests / transferStatsElapsed;
+        assetTransferStats["2. Sent (Mb/s)"] = nodeTransferStats.bytes * MEGABITS_PER_BYTE / transferStatsElapsed;
+        nodeStats["Asset Transfer Stats"] = assetTransferStats;
+
         QString uuid = uuidStringWithoutCurlyBraces(node->getUUID());
         nodeStats[USERNAME_UUID_REPLACEMENT_STATS_KEY] = uuid;
 
@@ -972,6 +1049,9 @@ void AssetServer::sendStatsPacket() {
 }
 
 static const QString MAP_FILE_NAME = "map.json";
+// the changes to the mappings since map.json was written
+static const QString MAP_JOURNAL_FILE_NAME = "map.journal";
+static const size_t MIN_MAPPINGS_JOURNAL_SIZE = 1000;
 
 bool AssetServer::loadMappingsFromFile() {
 
@@ -1017,7 +1097,7 @@ bool AssetServer::loadMappingsFromFile() {
                 }
 
                 qCInfo(asset_server) << "Loaded" << _fileMappings.size() << "mappings from map file at" << mapFilePath;
-                return true;
+                return replayMappingsJournal();
             }
         }
 
@@ -1027,6 +1107,104 @@ bool AssetServer::loadMappingsFromFile() {
         qCInfo(asset_server) << "No existing mappings loaded from file since no file was found at" << mapFilePath;
     }
 
+    return replayMappingsJournal();
+}
+
+bool AssetServer::replayMappingsJournal() {
+    auto journalFilePath = _resourcesDirectory.absoluteFilePath(MAP_JOURNAL_FILE_NAME);
+
+    QFile journalFile { journalFilePath };
+    if (!journalFile.exists()) {
+        return true;
+    }
+    if (!journalFile.open(QIODevice::ReadOnly)) {
+        qCCritical(asset_server) << "Failed to read mappings journal at" << journalFilePath;
+        return false;
+    }
+
+    int numChanges = 0;
+    while (!journalFile.atEnd()) {
+        QJsonParseError error;
+        auto jsonDocument = QJsonDocument::fromJson(journalFile.readLine(), &error);
+        if (error.error != QJsonParseError::NoError || !jsonDocument.isObject()) {
+            // the last change was cut short while it was written, it wasn't reported as done
+            qCWarning(asset_server) << "Ignoring the end of the mappings journal at" << journalFilePath << "since it is incomplete";
+            break;
+        }
+
+        auto change = jsonDocument.object();
+        for (const auto& path : change["delete"].toArray()) {
+            _fileMappings.erase(path.toString());
+        }
+        auto setMappings = change["set"].toObject();
+        for (auto it = setMappings.begin(); it != setMappings.end(); ++it) {
+            auto hash = it.value().toString();
+            if (AssetUtils::isValidFilePath(it.key()) && AssetUtils::isValidHash(hash)) {
+                _fileMappings[it.key()] = hash;
+            }
+        }
+        ++numChanges;
+    }
+    journalFile.close();
+
+    qCInfo(asset_server) << "Replayed" << numChanges << "mapping changes from journal at" << journalFilePath;
+
+    // start again from a map file that has them all
+    if (!compactMappings()) {
+        qCWarning(asset_server) << "Failed to fold the mappings journal into the map file, it will be replayed again";
+    }
+    return true;
+}
+
+bool AssetServer::writeMappingChanges(const AssetUtils::Mappings& setMappings, const AssetUtils::AssetPathList& deletedPaths) {
+    auto journalFilePath = _resourcesDirectory.absoluteFilePath(MAP_JOURNAL_FILE_NAME);
+
+    QFile journalFile { journalFilePath };
+    if (!journalFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCWarning(asset_server) << "Failed to open mappings journal at" << journalFilePath;
+        return false;
+    }
+
+    // each change is a line of its own, that's replayed as a whole or not at all, the deletes before the sets
+    QJsonObject change;
+    QJsonObject setObject;
+    for (const auto& mapping : setMappings) {
+        setObject[mapping.first] = mapping.second;
+    }
+    change["set"] = setObject;
+    change["delete"] = QJsonArray::fromStringList(deletedPaths);
+
+    auto line = QJsonDocument(change).toJson(QJsonDocument::Compact) + '\n';
+    auto sizeBefore = journalFile.size();
+    if (journalFile.write(line) != line.size() || !journalFile.flush()) {
+        qCWarning(asset_server) << "Failed to write mapping change to journal at" << journalFilePath;
+        // leave out what may have been written of the change, so that the next ones can be read back
+        journalFile.resize(sizeBefore);
+        return false;
+    }
+    journalFile.close();
+
+    // the journal is folded into the map file once it has about as many changes as there are mappings, so that each
+    // change costs a constant time on average
+    _mappingsJournalSize += setMappings.size() + deletedPaths.size();
+    if (_mappingsJournalSize > std::max(MIN_MAPPINGS_JOURNAL_SIZE, _fileMappings.size())) {
+        compactMappings();
+    }
+    return true;
+}
+
+bool AssetServer::compactMappings() {
+    if (!writeMappingsToFile()) {
+        return false;
+    }
+
+    auto journalFilePath = _resourcesDirectory.absoluteFilePath(MAP_JOURNAL_FILE_NAME);
+    if (QFile::exists(journalFilePath) && !QFile::remove(journalFilePath)) {
+        // the changes are replayed again over the map file that has them already, which leaves the same mappings
+        qCWarning(asset_server) << "Failed to remove mappings journal at" << journalFilePath;
+        return false;
+    }
+    _mappingsJournalSize = 0;
     return true;
 }
 
@@ -1081,7 +1259,7 @@ bool AssetServer::setMapping(AssetUtils::AssetPath path, AssetUtils::AssetHash h
     _fileMappings[path] = hash;
 
     // attempt to write to file
-    if (writeMappingsToFile()) {
+    if (writeMappingChanges({ { path, hash } }, AssetUtils::AssetPathList())) {
         // persistence succeeded, we are good to go
         qCDebug(asset_server) << "Set mapping:" << path << "=>" << hash;
         maybeBake(path, hash);
@@ -1117,8 +1295,8 @@ void AssetServer::removeBakedPathsForDeletedAsset(AssetUtils::AssetHash hash) {
 }
 
 bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
-    // take a copy of the current mappings in case persistence of these deletes fails
-    auto oldMappings = _fileMappings;
+    // keep the deleted mappings in case persistence of these deletes fails
+    AssetUtils::Mappings deletedMappings;
 
     QSet<QString> hashesToCheckForDeletion;
 
@@ -1128,19 +1306,16 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
 
         // figure out if this path will delete a file or folder
         if (pathIsFolder(path)) {
-            // enumerate the in memory file mappings and remove anything that matches
-            auto it = _fileMappings.begin();
+            // the mappings are sorted by path, the ones in the folder follow its path
+            auto it = _fileMappings.lower_bound(path);
             auto sizeBefore = _fileMappings.size();
 
-            while (it != _fileMappings.end()) {
-                if (it->first.startsWith(path)) {
-                    // add this hash to the list we need to check for asset removal from the server
-                    hashesToCheckForDeletion << it->second;
+            while (it != _fileMappings.end() && it->first.startsWith(path)) {
+                // add this hash to the list we need to check for asset removal from the server
+                hashesToCheckForDeletion << it->second;
 
-                    it = _fileMappings.erase(it);
-                } else {
-                    ++it;
-                }
+                deletedMappings[it->first] = it->second;
+                it = _fileMappings.erase(it);
             }
 
             auto sizeNow = _fileMappings.size();
@@ -1158,6 +1333,7 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
 
                 qCDebug(asset_server) << "Deleted a mapping:" << path << "=>" << it->second;
 
+                deletedMappings[it->first] = it->second;
                 _fileMappings.erase(it);
             } else {
                 qCDebug(asset_server) << "Unable to delete a mapping that was not found:" << path;
@@ -1165,8 +1341,13 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
         }
     }
 
+    AssetUtils::AssetPathList deletedPaths;
+    for (const auto& mapping : deletedMappings) {
+        deletedPaths << mapping.first;
+    }
+
     // deleted the old mappings, attempt to persist to file
-    if (writeMappingsToFile()) {
+    if (writeMappingChanges(AssetUtils::Mappings(), deletedPaths)) {
         // persistence succeeded we are good to go
 
         // TODO iterate through hashesToCheckForDeletion instead
@@ -1180,6 +1361,7 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
         // we now have a set of hashes that are unmapped - we will delete those asset files
         for (auto& hash : hashesToCheckForDeletion) {
             // remove the unmapped file
+            _fileCache.remove(hash);
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
 
             if (removeableFile.remove()) {
@@ -1196,7 +1378,9 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
         qCWarning(asset_server) << "Failed to persist deleted mappings, rolling back";
 
         // we didn't delete the previous mapping, put it back in our in-memory representation
-        _fileMappings = oldMappings;
+        for (const auto& mapping : deletedMappings) {
+            _fileMappings[mapping.first] = mapping.second;
+        }
 
         return false;
     }
@@ -1222,34 +1406,47 @@ bool AssetServer::renameMapping(AssetUtils::AssetPath oldPath, AssetUtils::Asset
             return false;
         }
 
-        // take a copy of the old mappings
-        auto oldMappings = _fileMappings;
-
-        // iterate the current mappings and adjust any that matches the renamed folder
-        auto it = oldMappings.begin();
-
-        while (it != oldMappings.end()) {
-            auto& oldKey = it->first;
-            if (oldKey.startsWith(oldPath)) {
-                auto newKey = oldKey;
-                newKey.replace(0, oldPath.size(), newPath);
+        // take the mappings of the folder out, they follow its path as the mappings are sorted by path
+        AssetUtils::Mappings renamedMappings;
+        auto it = _fileMappings.lower_bound(oldPath);
+        while (it != _fileMappings.end() && it->first.startsWith(oldPath)) {
+            renamedMappings[it->first] = it->second;
+            it = _fileMappings.erase(it);
+        }
 
-                // remove the old version from the in memory file mappings
-                _fileMappings.erase(_fileMappings.find(oldKey));
-                _fileMappings[newKey] = it->second;
+        // put them back under the new folder, keeping the mappings that they overwrite for potential rollback
+        AssetUtils::Mappings newMappings;
+        AssetUtils::Mappings overwrittenMappings;
+        AssetUtils::AssetPathList oldKeys;
+        for (const auto& mapping : renamedMappings) {
+            auto newKey = mapping.first;
+            newKey.replace(0, oldPath.size(), newPath);
+
+            auto existing = _fileMappings.find(newKey);
+            if (existing != _fileMappings.end()) {
+                overwrittenMappings[newKey] = existing->second;
             }
-
-            ++it;
+            _fileMappings[newKey] = mapping.second;
+            newMappings[newKey] = mapping.second;
+            oldKeys << mapping.first;
         }
 
-        if (writeMappingsToFile()) {
+        if (writeMappingChanges(newMappings, oldKeys)) {
             // persisted the changed mappings, return success
             qCDebug(asset_server) << "Renamed folder mapping:" << oldPath << "=>" << newPath;
 
             return true;
         } else {
             // couldn't persist the renamed paths, rollback and return failure
-            _fileMappings = oldMappings;
+            for (const auto& mapping : newMappings) {
+                _fileMappings.erase(mapping.first);
+            }
+            for (const auto& mapping : overwrittenMappings) {
+                _fileMappings[mapping.first] = mapping.second;
+            }
+            for (const auto& mapping : renamedMappings) {
+                _fileMappings[mapping.first] = mapping.second;
+            }
 
             qCWarning(asset_server) << "Failed to persist renamed folder mapping:" << oldPath << "=>" << newPath;
 
@@ -1265,16 +1462,21 @@ bool AssetServer::renameMapping(AssetUtils::AssetPath oldPath, AssetUtils::Asset
 
         // take the old hash to remove the old mapping
         auto it = _fileMappings.find(oldPath);
+        if (it == _fileMappings.end()) {
+            // failed to find a mapping that was to be renamed, return failure
+            return false;
+        }
         auto oldSourceMapping = it->second;
         _fileMappings.erase(it);
 
         // in case we're overwriting, keep the current destination mapping for potential rollback
         auto oldDestinationIt = _fileMappings.find(newPath);
+        AssetUtils::AssetHash oldDestinationMapping = oldDestinationIt != _fileMappings.end() ? oldDestinationIt->second : "";
 
         if (!oldSourceMapping.isEmpty()) {
             _fileMappings[newPath] = oldSourceMapping;
 
-            if (writeMappingsToFile()) {
+            if (writeMappingChanges({ { newPath, oldSourceMapping } }, { oldPath })) {
                 // persisted the renamed mapping, return success
                 qCDebug(asset_server) << "Renamed mapping:" << oldPath << "=>" << newPath;
 
@@ -1283,9 +1485,9 @@ bool AssetServer::renameMapping(AssetUtils::AssetPath oldPath, AssetUtils::Asset
                 // we couldn't persist the renamed mapping, rollback and return failure
                 _fileMappings[oldPath] = oldSourceMapping;
 
-                if (oldDestinationIt != _fileMappings.end()) {
+                if (!oldDestinationMapping.isEmpty()) {
                     // put back the overwritten mapping for the destination path
-                    _fileMappings[newPath] = oldDestinationIt->second;
+                    _fileMappings[newPath] = oldDestinationMapping;
                 } else {
                     // clear the new mapping
                     _fileMappings.erase(_fileMappings.find(newPath));
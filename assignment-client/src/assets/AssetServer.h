@@ -12,6 +12,8 @@
 #ifndef hifi_AssetServer_h
 #define hifi_AssetServer_h
 
+#include <mutex>
+
 #include <QtCore/QDir>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QThreadPool>
@@ -19,6 +21,7 @@
 
 #include <ThreadedAssignment.h>
 
+#include "AssetFileCache.h"
 #include "AssetUtils.h"
 #include "ReceivedMessage.h"
 
@@ -78,6 +81,10 @@ public:
 
     void aboutToFinish() override;
 
+    AssetFileCache& getFileCache() { return _fileCache; }
+    /// Counts an asset sent to a node, for the stats.  Called by the transfer tasks, from the threads of the transfer pool.
+    void recordAssetTransfer(const QUuid& nodeID, qint64 bytes);
+
 public slots:
     void run() override;
 
@@ -96,7 +103,7 @@ private:
     void replayRequests();
 
     void handleGetMappingOperation(ReceivedMessage& message, NLPacketList& replyPacket);
-    void handleGetAllMappingOperation(NLPacketList& replyPacket);
+    void handleGetAllMappingOperation(ReceivedMessage& message, NLPacketList& replyPacket);
     void handleSetMappingOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
     void handleDeleteMappingsOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
     void handleRenameMappingOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
@@ -108,6 +115,11 @@ private:
     // Mapping file operations must be called from main assignment thread only
     bool loadMappingsFromFile();
     bool writeMappingsToFile();
+    // The changes to the mappings are appended to a journal, which is replayed over the map file when it's loaded and
+    // folded into it once it's grown as big as the mappings
+    bool replayMappingsJournal();
+    bool writeMappingChanges(const AssetUtils::Mappings& setMappings, const AssetUtils::AssetPathList& deletedPaths);
+    bool compactMappings();
 
     /// Set the mapping for path to hash
     bool setMapping(AssetUtils::AssetPath path, AssetUtils::AssetHash hash);
@@ -150,15 +162,27 @@ private:
     void removeBakedPathsForDeletedAsset(AssetUtils::AssetHash originalAssetHash);
 
     AssetUtils::Mappings _fileMappings;
+    size_t _mappingsJournalSize { 0 };
 
     QDir _resourcesDirectory;
     QDir _filesDirectory;
 
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
+    AssetFileCache _fileCache;
+
+    struct AssetTransferStats {
+        quint64 requests { 0 };
+        quint64 bytes { 0 };
+    };
+    // the assets sent to each node since the last stats packet
+    std::mutex _transferStatsMutex;
+    QHash<QUuid, AssetTransferStats> _transferStats;
+    quint64 _lastTransferStatsTime { 0 };
 
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
     QThreadPool _bakingTaskPool;
+    QString _bakeQueuePath;
 
     QMutex _queuedRequestsMutex;
     bool _isQueueingRequests { true };
@@ -24,10 +24,13 @@ static const int OVEN_STATUS_CODE_ABORT { 2 };
 
 std::once_flag registerMetaTypesFlag;
 
-BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) :
+BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath,
+                             const QString& bakeQueuePath, int bakeVersion) :
     _assetHash(assetHash),
     _assetPath(assetPath),
-    _filePath(filePath)
+    _filePath(filePath),
+    _bakeQueuePath(bakeQueuePath),
+    _bakeVersion(bakeVersion)
 {
 
     std::call_once(registerMetaTypesFlag, []() {
@@ -71,6 +74,9 @@ void BakeAssetTask::run() {
         "-o", tempOutputDir,
         "-t", extension,
     };
+    if (!_bakeQueuePath.isEmpty()) {
+        args << "--queue" << _bakeQueuePath << "--bake-version" << QString::number(_bakeVersion);
+    }
 
     _ovenProcess.reset(new QProcess());
 
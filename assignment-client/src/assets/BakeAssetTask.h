@@ -25,7 +25,9 @@
 class BakeAssetTask : public QObject, public QRunnable {
     Q_OBJECT
 public:
-    BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
+    // with a bakeQueuePath, the oven hands the bake to the ovens serving that queue, which keep its result per bakeVersion
+    BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath,
+                  const QString& bakeQueuePath = QString(), int bakeVersion = 0);
 
     // Thread-safe inspection methods
     bool isBaking() { return _isBaking.load(); }
@@ -46,6 +48,8 @@ private:
     AssetUtils::AssetHash _assetHash;
     AssetUtils::AssetPath _assetPath;
     QString _filePath;
+    QString _bakeQueuePath;
+    int _bakeVersion { 0 };
     std::unique_ptr<QProcess> _ovenProcess { nullptr };
     std::atomic<bool> _wasAborted { false };
 };
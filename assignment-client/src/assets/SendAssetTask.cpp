@@ -26,11 +26,13 @@
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                             AssetServer* server) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _server(server)
 {
     
 }
@@ -64,17 +66,19 @@ void SendAssetTask::run() {
         replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
     } else {
         QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
-        QFile file { filePath };
 
-        if (file.open(QIODevice::ReadOnly)) {
+        // the data is written into the packets from the mapped file, which stays mapped for the next requests of the asset
+        auto file = _server->getFileCache().get(hexHash, filePath);
+
+        if (file) {
+            auto fileSize = file->getSize();
 
             // first fixup the range based on the now known file size
-            byteRange.fixupRange(file.size());
+            byteRange.fixupRange(fileSize);
 
             // check if we're being asked to read data that we just don't have
             // because of the file size
-            if (file.size() < byteRange.fromInclusive || file.size() < byteRange.toExclusive) {
+            if (fileSize < byteRange.fromInclusive || fileSize < byteRange.toExclusive) {
                 replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
                 qCDebug(networking) << "Bad byte range: " << hexHash << " "
                     << byteRange.fromInclusive << ":" << byteRange.toExclusive;
@@ -82,29 +86,20 @@ void SendAssetTask::run() {
                 // we have a valid byte range, handle it and send the asset
                 auto size = byteRange.size();
 
-                if (byteRange.fromInclusive >= 0) {
-
-                    // this range is positive, meaning we just need to seek into the file and then read from there
-                    file.seek(byteRange.fromInclusive);
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-                    replyPacketList->write(file.read(size));
-                } else {
-                    // this range is negative, at least the first part of the read will be back into the end of the file
-
-                    // seek to the part of the file where the negative range begins
-                    file.seek(file.size() + byteRange.fromInclusive);
+                // a negative range is read back from the end of the file
+                auto offset = byteRange.fromInclusive >= 0 ? byteRange.fromInclusive : fileSize + byteRange.fromInclusive;
 
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-
-                    // first write everything from the negative range to the end of the file
-                    replyPacketList->write(file.read(size));
+                replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
+                replyPacketList->writePrimitive(size);
+                if (size > 0) {
+                    replyPacketList->write(file->getData() + offset, size);
                 }
 
+                if (_senderNode) {
+                    _server->recordAssetTransfer(_senderNode->getUUID(), size);
+                }
                 qCDebug(networking) << "Sending asset: " << hexHash;
             }
-            file.close();
         } else {
             qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
             replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
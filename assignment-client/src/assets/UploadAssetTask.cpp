@@ -11,36 +11,50 @@
 
 #include "UploadAssetTask.h"
 
-#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QFile>
+#include <QtCore/QSaveFile>
 
 #include <AssetUtils.h>
 #include <NodeList.h>
 #include <NLPacketList.h>
 
+#include "AssetFileCache.h"
 #include "ClientServerUtils.h"
 
 UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir, uint64_t filesizeLimit) :
+                                 const QDir& resourcesDir, uint64_t filesizeLimit, AssetFileCache& fileCache) :
     _receivedMessage(receivedMessage),
     _senderNode(senderNode),
     _resourcesDir(resourcesDir),
-    _filesizeLimit(filesizeLimit)
+    _filesizeLimit(filesizeLimit),
+    _fileCache(fileCache)
 {
     
 }
 
+static QByteArray hashFile(QFile& file) {
+    // the file is hashed a block at a time rather than read into memory whole
+    static const qint64 HASH_BLOCK_SIZE = 1024 * 1024;
+
+    QCryptographicHash hasher { QCryptographicHash::Sha256 };
+    QByteArray block(HASH_BLOCK_SIZE, Qt::Uninitialized);
+    qint64 bytesRead;
+    while ((bytesRead = file.read(block.data(), HASH_BLOCK_SIZE)) > 0) {
+        hasher.addData(block.constData(), bytesRead);
+    }
+    if (bytesRead < 0) {
+        return QByteArray();
+    }
+    return hasher.result();
+}
+
 void UploadAssetTask::run() {
-    auto data = _receivedMessage->getMessage();
-    
-    QBuffer buffer { &data };
-    buffer.open(QIODevice::ReadOnly);
-    
     MessageID messageID;
-    buffer.read(reinterpret_cast<char*>(&messageID), sizeof(messageID));
+    _receivedMessage->readPrimitive(&messageID);
     
     uint64_t fileSize;
-    buffer.read(reinterpret_cast<char*>(&fileSize), sizeof(fileSize));
+    _receivedMessage->readPrimitive(&fileSize);
 
     if (_senderNode) {
         qDebug() << "UploadAssetTask reading a file of " << fileSize << "bytes from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID());
@@ -53,10 +67,18 @@ void UploadAssetTask::run() {
     
     if (fileSize > _filesizeLimit) {
         replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
+    } else if (fileSize > (uint64_t)_receivedMessage->getBytesLeftToRead()) {
+        qWarning() << "Upload of" << fileSize << "bytes only has" << _receivedMessage->getBytesLeftToRead() << "bytes - upload failed.";
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
     } else {
-        QByteArray fileData = buffer.read(fileSize);
-        
-        auto hash = AssetUtils::hashData(fileData);
+        // the file data is hashed and written straight from the packets of the message, the message isn't made contiguous
+        auto spans = _receivedMessage->readSpans(fileSize);
+
+        QCryptographicHash hasher { QCryptographicHash::Sha256 };
+        for (const auto& span : spans) {
+            hasher.addData(span.data, span.size);
+        }
+        auto hash = hasher.result();
         auto hexHash = hash.toHex();
 
         if (_senderNode) {
@@ -65,13 +87,14 @@ void UploadAssetTask::run() {
             qDebug() << "Hash for uploaded file from" << _receivedMessage->getSenderSockAddr() << "is: (" << hexHash << ")";
         }
         
-        QFile file { _resourcesDir.filePath(QString(hexHash)) };
+        QString filePath = _resourcesDir.filePath(QString(hexHash));
 
         bool existingCorrectFile = false;
         
-        if (file.exists()) {
+        QFile existingFile { filePath };
+        if (existingFile.exists()) {
             // check if the local file has the correct contents, otherwise we overwrite
-            if (file.open(QIODevice::ReadOnly) && AssetUtils::hashData(file.readAll()) == hash) {
+            if (existingFile.open(QIODevice::ReadOnly) && hashFile(existingFile) == hash) {
                 qDebug() << "Not overwriting existing verified file: " << hexHash;
 
                 existingCorrectFile = true;
@@ -80,32 +103,39 @@ void UploadAssetTask::run() {
                 replyPacket->write(hash);
             } else {
                 qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
-                file.close();
             }
+            existingFile.close();
         }
 
         if (!existingCorrectFile) {
-            if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
+            // the file is written to a temporary file that's renamed to the hash once it's complete and synced, so that a
+            // failed upload never leaves a partial file behind, nor replaces a file that's being sent
+            QSaveFile file { filePath };
+            bool written = file.open(QIODevice::WriteOnly);
+            for (const auto& span : spans) {
+                if (!written) {
+                    break;
+                }
+                written = file.write(span.data, span.size) == span.size;
+            }
+
+            if (written && file.commit()) {
                 qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
-                file.close();
+
+                // a mapping of the file that it replaced isn't sent anymore
+                _fileCache.remove(QString(hexHash));
 
                 replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
                 replyPacket->write(hash);
             } else {
                 qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
 
-                // upload has failed - remove the file and return an error
-                auto removed = file.remove();
-
-                if (!removed) {
-                    qWarning() << "Removal of failed upload file" << hexHash << "failed.";
-                }
+                // upload has failed - the temporary file is removed and an error returned
+                file.cancelWriting();
                 
                 replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
             }
         }
-
-
     }
     
     auto nodeList = DependencyManager::get<NodeList>();
@@ -21,13 +21,14 @@
 
 #include "ReceivedMessage.h"
 
+class AssetFileCache;
 class NLPacketList;
 class Node;
 
 class UploadAssetTask : public QRunnable {
 public:
     UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, 
-                    const QDir& resourcesDir, uint64_t filesizeLimit);
+                    const QDir& resourcesDir, uint64_t filesizeLimit, AssetFileCache& fileCache);
 
     void run() override;
 
@@ -36,6 +37,7 @@ private:
     QSharedPointer<Node> _senderNode;
     QDir _resourcesDir;
     uint64_t _filesizeLimit;
+    AssetFileCache& _fileCache;
 };
 
 #endif // hifi_UploadAssetTask_h
@@ -0,0 +1,56 @@
+//
+//  AudioFOABus.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AudioFOABus.h"
+
+const float AudioFOABus::DEFAULT_NEAR_DISTANCE = 16.0f;
+
+// a listener's own stream, at most half a cell's diagonal away from the center, always stays near
+static const float CELLS_PER_NEAR_DISTANCE = 4.0f;
+
+size_t AudioFOABus::CellHasher::operator()(const glm::ivec3& cell) const {
+    size_t hash = (size_t)cell.x;
+    hash = hash * 31 + (size_t)cell.y;
+    hash = hash * 31 + (size_t)cell.z;
+    return hash;
+}
+
+glm::vec3 AudioFOABus::getCellCenter(const glm::vec3& listenerPosition) const {
+    float cellSize = _nearDistance / CELLS_PER_NEAR_DISTANCE;
+    return (glm::floor(listenerPosition / cellSize) + 0.5f) * cellSize;
+}
+
+void AudioFOABus::beginFrame(unsigned int frame) {
+    _frame = frame;
+
+    std::lock_guard<std::mutex> lock(_busesMutex);
+    for (auto it = _buses.begin(); it != _buses.end();) {
+        if (it->second->encodedFrame + 1 < frame) {
+            it = _buses.erase(it);
+            --_numBuses;
+        } else {
+            ++it;
+        }
+    }
+}
+
+AudioFOABus::Bus& AudioFOABus::findBus(const glm::vec3& cellCenter) {
+    float cellSize = _nearDistance / CELLS_PER_NEAR_DISTANCE;
+    glm::ivec3 cell = glm::ivec3(glm::floor(cellCenter / cellSize));
+
+    std::lock_guard<std::mutex> lock(_busesMutex);
+    auto& bus = _buses[cell];
+    if (!bus) {
+        bus.reset(new Bus);
+        ++_numBuses;
+    }
+    return *bus;
+}
@@ -0,0 +1,109 @@
+//
+//  AudioFOABus.h
+//  assignment-client/src/audio
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#ifndef overte_AudioFOABus_h
+#define overte_AudioFOABus_h
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+#include <glm/gtx/norm.hpp>
+
+#include <AudioConstants.h>
+#include <PositionalAudioStream.h>
+
+/// @brief Per-zone first-order ambisonic buses that far-away sources are encoded into once for every listener in the
+/// zone.
+/// @details Space is split into cubic cells, the zones, a quarter of the near distance on a side. Every mono source
+/// farther than the near distance from a cell's center is encoded into that cell's bus, at its direction and
+/// attenuation as heard from the center. A listener in the cell decodes the bus to binaural once, and only renders the
+/// sources near the center through its own HRTFs. The listener hears a far source no more than about 13 degrees from
+/// where it actually is.
+/// <p>getBus() is thread-safe and is called by the slaves while they mix. beginFrame() is called by the mixer between
+/// mixes.</p>
+class AudioFOABus {
+public:
+    static const float DEFAULT_NEAR_DISTANCE; // meters
+    static const int NUM_CHANNELS = 4; // ambiX (ACN/SN3D): W, Y, Z, X
+
+    using Block = std::array<float, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * NUM_CHANNELS>;
+
+    void setEnabled(bool enabled) { _isEnabled = enabled; }
+    bool isEnabled() const { return _isEnabled; }
+
+    void setNearDistance(float nearDistance) { _nearDistance = nearDistance; }
+    float getNearDistance() const { return _nearDistance; }
+
+    /// @brief The center of the cell a listener is in.
+    glm::vec3 getCellCenter(const glm::vec3& listenerPosition) const;
+
+    /// @brief Whether a stream is encoded into the bus of the cell with this center, rather than mixed directly.
+    bool isEncoded(const glm::vec3& cellCenter, const PositionalAudioStream& stream) const {
+        return !stream.isStereo() && glm::distance2(stream.getPosition(), cellCenter) > _nearDistance * _nearDistance;
+    }
+
+    /// @brief Starts a frame, dropping the buses of cells that had no listener in the previous one.
+    void beginFrame(unsigned int frame);
+
+    /// @brief The bus of the cell with this center, calling encode(cellCenter, block) to fill it if no other listener has
+    /// for this frame.
+    /// @return Interleaved ambiX samples at full scale 1.0, valid until the next beginFrame().
+    template <typename Encoder>
+    const float* getBus(const glm::vec3& cellCenter, Encoder&& encode, bool& wasEncoded);
+
+    int getNumBuses() const { return _numBuses; }
+
+private:
+    struct CellHasher {
+        size_t operator()(const glm::ivec3& cell) const;
+    };
+
+    struct Bus {
+        std::mutex mutex;
+        unsigned int encodedFrame { 0 };
+        Block block;
+    };
+
+    Bus& findBus(const glm::vec3& cellCenter);
+
+    std::mutex _busesMutex;
+    std::unordered_map<glm::ivec3, std::unique_ptr<Bus>, CellHasher> _buses;
+
+    bool _isEnabled { false };
+    float _nearDistance { DEFAULT_NEAR_DISTANCE };
+    unsigned int _frame { 0 };
+    std::atomic<int> _numBuses { 0 };
+};
+
+template <typename Encoder>
+const float* AudioFOABus::getBus(const glm::vec3& cellCenter, Encoder&& encode, bool& wasEncoded) {
+    // buses are only erased between frames, so this one outlives the lookup
+    Bus& bus = findBus(cellCenter);
+
+    std::lock_guard<std::mutex> lock(bus.mutex);
+    wasEncoded = bus.encodedFrame != _frame;
+    if (wasEncoded) {
+        bus.block.fill(0.0f);
+        encode(cellCenter, bus.block.data());
+        bus.encodedFrame = _frame;
+    }
+
+    // the bus won't change again until the next frame
+    return bus.block.data();
+}
+
+#endif // overte_AudioFOABus_h
@@ -0,0 +1,87 @@
+//
+//  AudioMixDeduplicator.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AudioMixDeduplicator.h"
+
+#include <cstring>
+
+#include <QtCore/QHash>
+
+#include "AudioMixerClientData.h"
+
+size_t AudioMixDeduplicator::KeyHasher::operator()(const Key& key) const {
+    return key.hash ^ qHash(key.codecName);
+}
+
+void AudioMixDeduplicator::addMix(AudioMixerClientData& listenerData, Node::LocalID listenerID) {
+    auto& mix = listenerData.getPreparedMix();
+    mix.hash = qHashBits(mix.samples.data(), sizeof(mix.samples));
+    mix.isGrouped = false;
+
+    Key key { mix.hash, listenerData.getCodecName() };
+
+    std::lock_guard<std::mutex> lock(_groupsMutex);
+    auto& group = _groups[key];
+    if (!group) {
+        group.reset(new Group);
+    } else if (std::memcmp(group->leader->getPreparedMix().samples.data(), mix.samples.data(), sizeof(mix.samples)) != 0) {
+        // a hash collision, this one is encoded on its own
+        return;
+    }
+
+    if (!group->leader || listenerID < group->leaderID) {
+        group->leader = &listenerData;
+        group->leaderID = listenerID;
+    }
+    ++group->numMembers;
+    mix.isGrouped = true;
+}
+
+bool AudioMixDeduplicator::encode(AudioMixerClientData& listenerData, QByteArray& encodedBuffer) {
+    auto& mix = listenerData.getPreparedMix();
+
+    Group* group = nullptr;
+    if (mix.isGrouped) {
+        std::lock_guard<std::mutex> lock(_groupsMutex);
+        auto it = _groups.find({ mix.hash, listenerData.getCodecName() });
+        if (it != _groups.end() && it->second->numMembers > 1) {
+            group = it->second.get();
+        }
+    }
+
+    if (!group) {
+        listenerData.encode(reinterpret_cast<const char*>(mix.samples.data()), (int)sizeof(mix.samples), encodedBuffer);
+        return true;
+    }
+
+    // groups are only erased between frames, so this one outlives the lookup
+    std::lock_guard<std::mutex> lock(group->mutex);
+    bool wasEncoded = !group->isEncoded;
+    if (wasEncoded) {
+        auto& leaderMix = group->leader->getPreparedMix();
+        group->leader->encode(reinterpret_cast<const char*>(leaderMix.samples.data()), (int)sizeof(leaderMix.samples),
+                              group->encodedBuffer);
+        group->isEncoded = true;
+    }
+
+    if (&listenerData != group->leader) {
+        listenerData.setEncodedByShare();
+    }
+
+    // implicitly shared, the payload isn't copied
+    encodedBuffer = group->encodedBuffer;
+    return wasEncoded;
+}
+
+void AudioMixDeduplicator::clear() {
+    std::lock_guard<std::mutex> lock(_groupsMutex);
+    _groups.clear();
+}
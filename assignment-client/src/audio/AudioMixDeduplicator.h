@@ -0,0 +1,73 @@
+//
+//  AudioMixDeduplicator.h
+//  assignment-client/src/audio
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#ifndef overte_AudioMixDeduplicator_h
+#define overte_AudioMixDeduplicator_h
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include <Node.h>
+
+class AudioMixerClientData;
+
+/// @brief Encodes identical mixes once per frame and hands the encoded payload to every listener that gets them.
+/// @details After all listeners are mixed, the mixes that hold audio are grouped by codec and by content. A group's
+/// mix is encoded once, with the encoder of the member with the lowest local ID, so that a group that lasts from frame
+/// to frame keeps encoding with the same encoder state. Spectators who only hear the same injector, for instance, are
+/// all sent one encode.
+/// <p>Codecs like Opus keep state between frames, and a member's own encoder sits idle while it is in a group. A
+/// listener whose mix joins or leaves a group hears that like a dropped frame, where its mix changes anyway.</p>
+/// <p>addMix() and encode() are thread-safe and are called by the slaves, addMix() for every listener before any
+/// encode(). clear() is called by the mixer between frames.</p>
+class AudioMixDeduplicator {
+public:
+    /// @brief Adds a listener's mix for this frame, from its AudioMixerClientData::PreparedMix.
+    void addMix(AudioMixerClientData& listenerData, Node::LocalID listenerID);
+
+    /// @brief Encodes a listener's mix, or fetches the encode of an identical one.
+    /// @return Whether this call ran an encoder.
+    bool encode(AudioMixerClientData& listenerData, QByteArray& encodedBuffer);
+
+    void clear();
+
+private:
+    struct Key {
+        uint hash;
+        QString codecName;
+
+        bool operator==(const Key& other) const { return hash == other.hash && codecName == other.codecName; }
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Group {
+        std::mutex mutex;
+        AudioMixerClientData* leader { nullptr };
+        Node::LocalID leaderID { 0 };
+        int numMembers { 0 };
+        QByteArray encodedBuffer;
+        bool isEncoded { false };
+    };
+
+    std::mutex _groupsMutex;
+    std::unordered_map<Key, std::unique_ptr<Group>, KeyHasher> _groups;
+};
+
+#endif // overte_AudioMixDeduplicator_h
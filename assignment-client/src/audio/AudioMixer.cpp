@@ -11,6 +11,7 @@
 
 #include "AudioMixer.h"
 
+#include <algorithm>
 #include <thread>
 
 #include <QtCore/QJsonArray>
@@ -23,6 +24,7 @@
 #include <NetworkAccessManager.h>
 #include <NodeList.h>
 #include <Node.h>
+#include <udt/PacketBufferPool.h>
 #include <OctreeConstants.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
@@ -45,6 +47,7 @@ using namespace std;
 static const float DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE = 0.5f;    // attenuation = -6dB * log2(distance)
 static const int DISABLE_STATIC_JITTER_FRAMES = -1;
 static const float DEFAULT_NOISE_MUTING_THRESHOLD = 1.0f;
+static const int DISABLE_VOICE_ACTIVITY_DETECTION = 0;
 static const QString AUDIO_MIXER_LOGGING_TARGET_NAME = "audio-mixer";
 static const QString AUDIO_ENV_GROUP_KEY = "audio_env";
 static const QString AUDIO_BUFFER_GROUP_KEY = "audio_buffer";
@@ -52,7 +55,9 @@ static const QString AUDIO_THREADING_GROUP_KEY = "audio_threading";
 
 
 int AudioMixer::_numStaticJitterFrames{ DISABLE_STATIC_JITTER_FRAMES };
+float AudioMixer::_jitterLateLossTarget{ InboundAudioStream::DEFAULT_JITTER_LATE_LOSS_TARGET };
 float AudioMixer::_noiseMutingThreshold{ DEFAULT_NOISE_MUTING_THRESHOLD };
+int AudioMixer::_voiceActivityHangoverFrames{ DISABLE_VOICE_ACTIVITY_DETECTION };
 float AudioMixer::_attenuationPerDoublingInDistance{ DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE };
 map<QString, shared_ptr<CodecPlugin>> AudioMixer::_availableCodecs{ };
 QStringList AudioMixer::_codecPreferenceOrder{};
@@ -125,6 +130,9 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
 }
 
 void AudioMixer::aboutToFinish() {
+    // kill and disconnect packets sent while shutting down must not wait for a batch flush that won't come
+    DependencyManager::get<NodeList>()->setSendBatchingEnabled(false);
+
     DependencyManager::destroy<PluginManager>();
 }
 
@@ -283,11 +291,19 @@ void AudioMixer::sendStatsPacket() {
 
     // general stats
     statsObject["useDynamicJitterBuffers"] = _numStaticJitterFrames == DISABLE_STATIC_JITTER_FRAMES;
+    statsObject["jitter_late_loss_target%"] = _jitterLateLossTarget * 100.0f;
 
     statsObject["threads"] = _slavePool.numThreads();
 
+    QJsonObject threadStats;
+    _slavePool.threadStats(threadStats);
+    statsObject["thread_times"] = threadStats;
+
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
+    statsObject["send_batching"] = DependencyManager::get<NodeList>()->sampleSendBatchStats().toJson();
+    statsObject["packet_buffer_pool"] = udt::PacketBufferPool::getStats().toJson();
+    statsObject["packet_dispatch"] = DependencyManager::get<NodeList>()->getPacketReceiver().sampleDispatchStats();
 
     statsObject["avg_streams_per_frame"] = (float)_stats.sumStreams / (float)_numStatFrames;
     statsObject["avg_listeners_per_frame"] = (float)_stats.sumListeners / (float)_numStatFrames;
@@ -313,6 +329,15 @@ void AudioMixer::sendStatsPacket() {
     addTiming(_mixTiming, "mix");
     addTiming(_eventsTiming, "events");
 
+    // per slave thread, per frame
+    auto threadFrames = (uint64_t)_numStatFrames * std::max(_slavePool.numThreads(), 1);
+    timingStats["us_per_thread_busy"] = (qint64)(_stats.busyTime / threadFrames);
+    timingStats["us_per_thread_idle"] = (qint64)(_stats.idleTime / threadFrames);
+
+    timingStats["ns_per_hrtf_mix"] = _hrtfMixCost;
+    timingStats["ns_per_manual_mix"] = _manualMixCost;
+    timingStats["us_per_frame_stream_mixing"] = _trailingStreamCost;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     timingStats["ns_per_mix"] = (_stats.totalMixes > 0) ?  (float)(_stats.mixTime / _stats.totalMixes) : 0;
 #endif
@@ -324,15 +349,36 @@ void AudioMixer::sendStatsPacket() {
     QJsonObject mixStats;
 
     mixStats["%_hrtf_mixes"] = percentageForMixStats(_stats.hrtfRenders);
+    mixStats["%_hrtf_cache_hits"] = percentageForMixStats(_stats.hrtfCacheHits);
+    mixStats["%_foa_bus_mixes"] = percentageForMixStats(_stats.foaBusMixes);
     mixStats["%_manual_stereo_mixes"] = percentageForMixStats(_stats.manualStereoMixes);
     mixStats["%_manual_echo_mixes"] = percentageForMixStats(_stats.manualEchoMixes);
 
     mixStats["1_hrtf_renders"] = (int)(_stats.hrtfRenders / (float)_numStatFrames);
     mixStats["1_hrtf_resets"] = (int)(_stats.hrtfResets / (float)_numStatFrames);
     mixStats["1_hrtf_updates"] = (int)(_stats.hrtfUpdates / (float)_numStatFrames);
+    mixStats["1_hrtf_cache_hits"] = (int)(_stats.hrtfCacheHits / (float)_numStatFrames);
+    mixStats["1_hrtf_cache_buckets"] = _workerSharedData.spatializationCache.getNumEntries();
+
+    mixStats["1_foa_bus_mixes"] = (int)(_stats.foaBusMixes / (float)_numStatFrames);
+    mixStats["1_foa_bus_encodes"] = (int)(_stats.foaBusEncodes / (float)_numStatFrames);
+    mixStats["1_foa_bus_decodes"] = (int)(_stats.foaBusDecodes / (float)_numStatFrames);
+    mixStats["1_foa_buses"] = _workerSharedData.foaBus.getNumBuses();
+
+    mixStats["1_mix_packets"] = (int)(_stats.mixPackets / (float)_numStatFrames);
+    mixStats["1_mix_encodes"] = (int)(_stats.mixEncodes / (float)_numStatFrames);
+    mixStats["1_mix_bytes"] = (int)(_stats.mixBytes / (float)_numStatFrames);
+    mixStats["dedup_ratio"] = _stats.mixEncodes > 0 ? (float)_stats.mixPackets / (float)_stats.mixEncodes : 1.0f;
+
+    mixStats["1_throttled_streams"] = (int)(_stats.throttledStreams / (float)_numStatFrames);
+    mixStats["1_throttled_microphones"] = (int)(_stats.throttledMicrophones / (float)_numStatFrames);
+    mixStats["1_throttled_injectors"] = (int)(_stats.throttledInjectors / (float)_numStatFrames);
+    mixStats["1_throttled_near_streams"] = (int)(_stats.throttledNearStreams / (float)_numStatFrames);
+    mixStats["1_throttled_hrtf_renders"] = _stats.throttledCost / (float)_numStatFrames;
 
     mixStats["2_skipped_streams"] = (int)(_stats.skipped / (float)_numStatFrames);
     mixStats["2_inactive_streams"] = (int)(_stats.inactive / (float)_numStatFrames);
+    mixStats["2_voice_inactive_streams"] = (int)(_stats.voiceInactive / (float)_numStatFrames);
     mixStats["2_active_streams"] = (int)(_stats.active / (float)_numStatFrames);
 
     mixStats["3_skippped_to_active"] = (int)(_stats.skippedToActive / (float)_numStatFrames);
@@ -417,6 +463,12 @@ void AudioMixer::start() {
         parseSettingsObject(settingsObject);
     }
 
+    // the mix for every listener goes out in one burst per frame, collect it and write it with as few syscalls as possible
+    nodeList->setSendBatchingEnabled(true);
+
+    // mixed audio is unreliable, follow it with parity for listeners that report loss so a lost frame isn't a gap
+    nodeList->setForwardErrorCorrectionTypes({ PacketType::MixedAudio });
+
     // mix state
     unsigned int frame = 1;
 
@@ -457,22 +509,26 @@ void AudioMixer::start() {
             QCoreApplication::processEvents();
         }
 
-        int numToRetain = -1;
         assert(_throttlingRatio >= 0.0f && _throttlingRatio <= 1.0f);
-        if (_throttlingRatio > EPSILON) {
-            numToRetain = nodeList->size() * (1.0f - _throttlingRatio);
-        }
+        float throttlingRatio = _throttlingRatio > EPSILON ? _throttlingRatio : 0.0f;
+        _workerSharedData.spatializationCache.beginFrame(frame);
+        _workerSharedData.foaBus.beginFrame(frame);
+        _workerSharedData.mixDeduplicator.clear();
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
             // mix across slave threads
             auto mixTimer = _mixTiming.timer();
-            _slavePool.mix(cbegin, cend, frame, numToRetain);
+            _slavePool.mix(cbegin, cend, frame, throttlingRatio);
         });
+        nodeList->flushSendBatch();
 
         // gather stats
+        AudioMixerStats frameStats;
         _slavePool.each([&](AudioMixerSlave& slave) {
-            _stats.accumulate(slave.stats);
+            frameStats.accumulate(slave.stats);
             slave.stats.reset();
         });
+        updateMixCosts(frameStats);
+        _stats.accumulate(frameStats);
 
         ++frame;
         ++_numStatFrames;
@@ -484,6 +540,9 @@ void AudioMixer::start() {
             break;
         }
     }
+
+    // write out whatever the last frame left in the batch, anything sent from here on goes out directly
+    nodeList->setSendBatchingEnabled(false);
 }
 
 chrono::microseconds AudioMixer::timeFrame() {
@@ -505,6 +564,34 @@ chrono::microseconds AudioMixer::timeFrame() {
     return duration;
 }
 
+void AudioMixer::updateMixCosts(const AudioMixerStats& frameStats) {
+    // a few seconds of samples, a mix costs about the same from one frame to the next
+    const float CURRENT_FRAME_RATIO = 1.0f / 200.0f;
+    const float PREVIOUS_FRAMES_RATIO = 1.0f - CURRENT_FRAME_RATIO;
+
+    if (frameStats.hrtfMixesTimed > 0) {
+        float hrtfMixCost = (float)frameStats.hrtfMixTime / frameStats.hrtfMixesTimed;
+        _hrtfMixCost = _hrtfMixCost > 0.0f ? PREVIOUS_FRAMES_RATIO * _hrtfMixCost + CURRENT_FRAME_RATIO * hrtfMixCost
+                                           : hrtfMixCost;
+    }
+    if (frameStats.manualMixesTimed > 0) {
+        float manualMixCost = (float)frameStats.manualMixTime / frameStats.manualMixesTimed;
+        _manualMixCost = _manualMixCost > 0.0f ? PREVIOUS_FRAMES_RATIO * _manualMixCost + CURRENT_FRAME_RATIO * manualMixCost
+                                               : manualMixCost;
+    }
+
+    // the slaves budget streams in HRTF renders, so tell them what the other mixes cost in those
+    if (_hrtfMixCost > 0.0f && _manualMixCost > 0.0f) {
+        _workerSharedData.manualMixCost = _manualMixCost / _hrtfMixCost;
+    }
+
+    // usecs of CPU that mixing streams took this frame, what the throttle can shed
+    const float NSECS_PER_USEC = 1000.0f;
+    float streamCost = (frameStats.hrtfRenders * _hrtfMixCost +
+                        (frameStats.manualStereoMixes + frameStats.manualEchoMixes) * _manualMixCost) / NSECS_PER_USEC;
+    _trailingStreamCost = PREVIOUS_FRAMES_RATIO * _trailingStreamCost + CURRENT_FRAME_RATIO * streamCost;
+}
+
 void AudioMixer::throttle(chrono::microseconds duration, int frame) {
     // throttle using a modified proportional-integral controller
     const float FRAME_TIME = 10000.0f;
@@ -535,28 +622,44 @@ void AudioMixer::throttle(chrono::microseconds duration, int frame) {
     if (frame % TRAILING_FRAMES == 0) {
         if (_trailingMixRatio > TARGET) {
             int proportionalTerm = 1 + (_trailingMixRatio - TARGET) / 0.1f;
-            _throttlingRatio += THROTTLE_RATE * proportionalTerm;
+            float step = THROTTLE_RATE * proportionalTerm;
+
+            // when what mixing streams costs is known, shed enough of it to get back under the target at once,
+            // bounded so that a bad estimate doesn't silence a crowd
+            const float MAX_COST_STEP = 0.25f;
+            if (_trailingStreamCost > 0.0f) {
+                float excessTime = (_trailingMixRatio - TARGET) * FRAME_TIME * std::max(_slavePool.numThreads(), 1);
+                step = max(step, min(excessTime / _trailingStreamCost, MAX_COST_STEP));
+            }
+
+            _throttlingRatio += step;
             _throttlingRatio = min(_throttlingRatio, 1.0f);
             qCDebug(audio) << "audio-mixer is struggling (" << _trailingMixRatio << "mix/sleep) - throttling"
-                << _throttlingRatio << "of streams";
+                << _throttlingRatio << "of stream mixing";
         } else if (_throttlingRatio > 0.0f && _trailingMixRatio <= BACKOFF_TARGET) {
             int proportionalTerm = 1 + (TARGET - _trailingMixRatio) / 0.2f;
             _throttlingRatio -= BACKOFF_RATE * proportionalTerm;
             _throttlingRatio = max(_throttlingRatio, 0.0f);
             qCDebug(audio) << "audio-mixer is recovering (" << _trailingMixRatio << "mix/sleep) - throttling"
-                << _throttlingRatio << "of streams";
+                << _throttlingRatio << "of stream mixing";
         }
     }
 }
 
 void AudioMixer::clearDomainSettings() {
     _numStaticJitterFrames = DISABLE_STATIC_JITTER_FRAMES;
+    _jitterLateLossTarget = InboundAudioStream::DEFAULT_JITTER_LATE_LOSS_TARGET;
     _attenuationPerDoublingInDistance = DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE;
     _noiseMutingThreshold = DEFAULT_NOISE_MUTING_THRESHOLD;
+    _voiceActivityHangoverFrames = DISABLE_VOICE_ACTIVITY_DETECTION;
     _codecPreferenceOrder.clear();
     _audioZones.clear();
     _zoneSettings.clear();
     _zoneReverbSettings.clear();
+    _workerSharedData.spatializationCache.setEnabled(false);
+    _workerSharedData.spatializationCache.setAzimuthStep(AudioSpatializationCache::DEFAULT_AZIMUTH_STEP);
+    _workerSharedData.foaBus.setEnabled(false);
+    _workerSharedData.foaBus.setNearDistance(AudioFOABus::DEFAULT_NEAR_DISTANCE);
 }
 
 void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
@@ -594,6 +697,40 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
         }
 
         qCDebug(audio) << "Throttle Start:" << _throttleStartTarget << "Throttle Backoff:" << _throttleBackoffTarget;
+
+        // listeners that hear a source from about the same place share its HRTF render
+        const QString CLUSTERED_LISTENERS_KEY = "clustered_listeners";
+        const QString CLUSTER_AZIMUTH_STEP_KEY = "cluster_azimuth_step";
+
+        auto& spatializationCache = _workerSharedData.spatializationCache;
+        spatializationCache.setEnabled(audioThreadingGroupObject[CLUSTERED_LISTENERS_KEY].toBool());
+
+        bool ok;
+        float azimuthStep = audioThreadingGroupObject[CLUSTER_AZIMUTH_STEP_KEY].toString().toFloat(&ok);
+        if (ok && azimuthStep > 0.0f && azimuthStep <= 90.0f) {
+            spatializationCache.setAzimuthStep(azimuthStep * RADIANS_PER_DEGREE);
+        }
+
+        if (spatializationCache.isEnabled()) {
+            qCDebug(audio) << "Clustered listeners enabled, azimuth step:"
+                << spatializationCache.getAzimuthStep() / RADIANS_PER_DEGREE << "degrees";
+        }
+
+        // far-away sources are encoded once per zone into an ambisonic bus that its listeners share
+        const QString FOA_BUS_KEY = "foa_bus";
+        const QString FOA_BUS_NEAR_DISTANCE_KEY = "foa_bus_near_distance";
+
+        auto& foaBus = _workerSharedData.foaBus;
+        foaBus.setEnabled(audioThreadingGroupObject[FOA_BUS_KEY].toBool());
+
+        float nearDistance = audioThreadingGroupObject[FOA_BUS_NEAR_DISTANCE_KEY].toString().toFloat(&ok);
+        if (ok && nearDistance > 0.0f) {
+            foaBus.setNearDistance(nearDistance);
+        }
+
+        if (foaBus.isEnabled()) {
+            qCDebug(audio) << "FOA bus enabled, near distance:" << foaBus.getNearDistance() << "m";
+        }
     }
 
     if (settingsObject.contains(AUDIO_BUFFER_GROUP_KEY)) {
@@ -615,6 +752,15 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
         } else {
             qCDebug(audio) << "Enabling dynamic jitter buffers.";
             _numStaticJitterFrames = DISABLE_STATIC_JITTER_FRAMES;
+
+            // size dynamic jitter buffers from a packet-delay histogram, to play all but this percent in time
+            bool ok;
+            const QString JITTER_LATE_LOSS_PERCENT_KEY = "jitter_late_loss_percent";
+            float lateLossPercent = audioBufferGroupObject[JITTER_LATE_LOSS_PERCENT_KEY].toString().toFloat(&ok);
+            if (ok && lateLossPercent > 0.0f) {
+                _jitterLateLossTarget = lateLossPercent / 100.0f;
+                qCDebug(audio) << "Histogram jitter buffers enabled, late loss target:" << lateLossPercent << "%";
+            }
         }
 
         // check for deprecated audio settings
@@ -690,6 +836,17 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             }
         }
 
+        // microphones that stay near their noise floor for this many frames are not mixed until they speak again
+        const QString VOICE_ACTIVITY_HANGOVER_FRAMES = "voice_activity_hangover_frames";
+        if (audioEnvGroupObject[VOICE_ACTIVITY_HANGOVER_FRAMES].isString()) {
+            bool ok = false;
+            int hangoverFrames = audioEnvGroupObject[VOICE_ACTIVITY_HANGOVER_FRAMES].toString().toInt(&ok);
+            if (ok && hangoverFrames >= 0) {
+                _voiceActivityHangoverFrames = hangoverFrames;
+                qCDebug(audio) << "Voice activity hangover changed to" << _voiceActivityHangoverFrames << "frames";
+            }
+        }
+
         const QString AUDIO_ZONES = "zones";
         if (audioEnvGroupObject[AUDIO_ZONES].isObject()) {
             const QJsonObject& zones = audioEnvGroupObject[AUDIO_ZONES].toObject();
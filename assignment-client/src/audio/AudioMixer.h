@@ -53,7 +53,9 @@ public:
     };
 
     static int getStaticJitterFrames() { return _numStaticJitterFrames; }
+    static float getJitterLateLossTarget() { return _jitterLateLossTarget; }
     static bool shouldMute(float quietestFrame) { return quietestFrame > _noiseMutingThreshold; }
+    static int getVoiceActivityHangoverFrames() { return _voiceActivityHangoverFrames; }
     static float getAttenuationPerDoublingInDistance() { return _attenuationPerDoublingInDistance; }
     static const std::vector<ZoneDescription>& getAudioZones() { return _audioZones; }
     static const std::vector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
@@ -87,6 +89,7 @@ private slots:
 private:
     // mixing helpers
     std::chrono::microseconds timeFrame();
+    void updateMixCosts(const AudioMixerStats& frameStats);
     void throttle(std::chrono::microseconds frameDuration, int frame);
 
     AudioMixerClientData* getOrCreateClientData(Node* node);
@@ -102,6 +105,11 @@ private:
     float _trailingMixRatio { 0.0f };
     float _throttlingRatio { 0.0f };
 
+    // trailing nsecs per HRTF and per stereo or echo mix, and usecs of CPU spent mixing streams per frame
+    float _hrtfMixCost { 0.0f };
+    float _manualMixCost { 0.0f };
+    float _trailingStreamCost { 0.0f };
+
     int _numSilentPackets { 0 };
 
     int _numStatFrames { 0 };
@@ -141,7 +149,9 @@ private:
     Timer _packetsTiming;
 
     static int _numStaticJitterFrames; // -1 denotes dynamic jitter buffering
+    static float _jitterLateLossTarget; // 0 uses the time-gap scheme for dynamic jitter buffering
     static float _noiseMutingThreshold;
+    static int _voiceActivityHangoverFrames; // 0 disables server-side voice activity detection
     static float _attenuationPerDoublingInDistance;
     static std::map<QString, CodecPluginPointer> _availableCodecs;
     static QStringList _codecPreferenceOrder;
@@ -11,6 +11,8 @@
 
 #include "AudioMixerClientData.h"
 
+#include <algorithm>
+#include <cmath>
 #include <random>
 
 #include <glm/common.hpp>
@@ -485,6 +487,8 @@ void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, Concurr
             }
 
             auto avatarAudioStream = new AvatarAudioStream(isStereo, AudioMixer::getStaticJitterFrames());
+            avatarAudioStream->setJitterLateLossTarget(AudioMixer::getJitterLateLossTarget());
+            avatarAudioStream->setVoiceActivityHangover(AudioMixer::getVoiceActivityHangoverFrames());
             avatarAudioStream->setupCodec(_codec, _selectedCodecName, isStereo ? AudioConstants::STEREO : AudioConstants::MONO);
 
             if (_isIgnoreRadiusEnabled) {
@@ -524,6 +528,7 @@ void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, Concurr
 
             // we don't have this injected stream yet, so add it
             auto injectorStream = new InjectedAudioStream(streamIdentifier, isStereo, AudioMixer::getStaticJitterFrames());
+            injectorStream->setJitterLateLossTarget(AudioMixer::getJitterLateLossTarget());
 
 #if INJECTORS_SUPPORT_CODECS
             injectorStream->setupCodec(_codec, _selectedCodecName, isStereo ? AudioConstants::STEREO : AudioConstants::MONO);
@@ -695,6 +700,11 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
         AudioStreamStats streamStats = avatarAudioStream->getAudioStreamStats();
         upstreamStats["mic.desired"] = streamStats._desiredJitterBufferFrames;
         upstreamStats["desired_calc"] = avatarAudioStream->getCalculatedJitterBufferFrames();
+        if (avatarAudioStream->histogramJitterBufferEnabled()) {
+            upstreamStats["late_loss%"] = avatarAudioStream->getLateLossRatio() * 100.0f;
+            upstreamStats["latency_ms"] = streamStats._desiredJitterBufferFrames * AudioConstants::NETWORK_FRAME_MSECS;
+            upstreamStats["stretched_ms"] = avatarAudioStream->getStretchedMsecs();
+        }
         upstreamStats["available_avg_10s"] = streamStats._framesAvailableAverage;
         upstreamStats["available"] = (double) streamStats._framesAvailable;
         upstreamStats["unplayed"] = (double) streamStats._unplayedMs;
@@ -732,6 +742,11 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
             AudioStreamStats streamStats = injectorPair->getAudioStreamStats();
             upstreamStats["inj.desired"]  = streamStats._desiredJitterBufferFrames;
             upstreamStats["desired_calc"] = injectorPair->getCalculatedJitterBufferFrames();
+            if (injectorPair->histogramJitterBufferEnabled()) {
+                upstreamStats["late_loss%"] = injectorPair->getLateLossRatio() * 100.0f;
+                upstreamStats["latency_ms"] = streamStats._desiredJitterBufferFrames * AudioConstants::NETWORK_FRAME_MSECS;
+                upstreamStats["stretched_ms"] = injectorPair->getStretchedMsecs();
+            }
             upstreamStats["available_avg_10s"] = streamStats._framesAvailableAverage;
             upstreamStats["available"] = (double) streamStats._framesAvailable;
             upstreamStats["unplayed"] = (double) streamStats._unplayedMs;
@@ -774,11 +789,27 @@ void AudioMixerClientData::sendSelectAudioFormat(SharedNodePointer node, const Q
     nodeList->sendPacket(std::move(replyPacket), *node);
 }
 
+void AudioMixerClientData::encode(const char* decodedData, int decodedSize, QByteArray& encodedBuffer) {
+    if (_encoder) {
+        // the mix packet has room for a frame of uncompressed stereo, no codec needs more
+        _encodedBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+        int encodedSize = _encoder->encodeInto(decodedData, decodedSize, _encodedBuffer.data(), _encodedBuffer.size());
+        _encodedBuffer.resize(std::max(encodedSize, 0));
+
+        // implicitly shared, and released once the packet is written, so the next frame doesn't reallocate
+        encodedBuffer = _encodedBuffer;
+    } else {
+        encodedBuffer = QByteArray(decodedData, decodedSize);
+    }
+    // once you have encoded, you need to flush eventually.
+    _shouldFlushEncoder = true;
+}
+
 void AudioMixerClientData::encodeFrameOfZeros(QByteArray& encodedZeros) {
-    static QByteArray zeros(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
+    static const QByteArray zeros(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
     if (_shouldFlushEncoder) {
         if (_encoder) {
-            _encoder->encode(zeros, encodedZeros);
+            encode(zeros.constData(), zeros.size(), encodedZeros);
         } else {
             encodedZeros = zeros;
         }
@@ -786,6 +817,44 @@ void AudioMixerClientData::encodeFrameOfZeros(QByteArray& encodedZeros) {
     _shouldFlushEncoder = false;
 }
 
+void AudioMixerClientData::adaptEncoder(float throttlingRatio) {
+    if (!_encoder) {
+        return;
+    }
+
+    // the bitrate follows the loss the listener reports on the mix it receives:
+    // backing off quickly when it loses packets, and recovering slowly once it doesn't
+    const int MIN_BITRATE = 24000;
+    const int MAX_BITRATE = 128000;
+    const float BACKOFF_LOSS_RATE = 0.05f;
+    const float RECOVERY_LOSS_RATE = 0.01f;
+    const float BACKOFF_FACTOR = 0.7f;
+    const float RECOVERY_FACTOR = 1.15f;
+
+    float lossRate = _downstreamAudioStreamStats._packetStreamWindowStats.getLostRate();
+    int currentBitrate = _encoderBitrate > 0 ? _encoderBitrate : MAX_BITRATE;
+    int bitrate = currentBitrate;
+    if (lossRate > BACKOFF_LOSS_RATE) {
+        bitrate = std::max((int)(bitrate * BACKOFF_FACTOR), MIN_BITRATE);
+    } else if (lossRate < RECOVERY_LOSS_RATE) {
+        bitrate = std::min((int)(bitrate * RECOVERY_FACTOR), MAX_BITRATE);
+    }
+    if (bitrate != currentBitrate) {
+        _encoder->setBitrate(bitrate);
+        _encoderBitrate = bitrate;
+    }
+
+    // the complexity sheds encoding work in step with the mixing the throttle sheds
+    const int MIN_COMPLEXITY = 2;
+    const int MAX_COMPLEXITY = 10;
+    int currentComplexity = _encoderComplexity > 0 ? _encoderComplexity : MAX_COMPLEXITY;
+    int complexity = MAX_COMPLEXITY - (int)std::ceil(throttlingRatio * (MAX_COMPLEXITY - MIN_COMPLEXITY));
+    if (complexity != currentComplexity) {
+        _encoder->setComplexity(complexity);
+        _encoderComplexity = complexity;
+    }
+}
+
 void AudioMixerClientData::setupCodec(CodecPluginPointer codec, const QString& codecName) {
     cleanupCodec(); // cleanup any previously allocated coders first
     _codec = codec;
@@ -793,7 +862,10 @@ void AudioMixerClientData::setupCodec(CodecPluginPointer codec, const QString& c
     if (codec) {
         _encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
         _decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::MONO);
+        _encodedBuffer.reserve(AudioConstants::NETWORK_FRAME_BYTES_STEREO);
     }
+    _encoderBitrate = 0;
+    _encoderComplexity = 0;
 
     auto avatarAudioStream = getAvatarAudioStream();
     if (avatarAudioStream) {
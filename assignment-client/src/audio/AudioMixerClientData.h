@@ -12,6 +12,7 @@
 #ifndef hifi_AudioMixerClientData_h
 #define hifi_AudioMixerClientData_h
 
+#include <array>
 #include <queue>
 
 #if !defined(Q_MOC_RUN)
@@ -24,6 +25,7 @@
 
 #include <AABox.h>
 #include <AudioHRTF.h>
+#include <AudioFOA.h>
 #include <AudioLimiter.h>
 #include <UUIDHasher.h>
 
@@ -93,20 +95,22 @@ public:
 
     AudioLimiter audioLimiter;
 
+    // decodes the far sources of the listener's zone, see AudioFOABus
+    AudioFOA foaBusDecoder;
+    bool isDecodingFOABus { false };
+
     void setupCodec(CodecPluginPointer codec, const QString& codecName);
     void cleanupCodec();
-    void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
-        if (_encoder) {
-            _encoder->encode(decodedBuffer, encodedBuffer);
-        } else {
-            encodedBuffer = decodedBuffer;
-        }
-        // once you have encoded, you need to flush eventually.
-        _shouldFlushEncoder = true;
-    }
+    void encode(const char* decodedData, int decodedSize, QByteArray& encodedBuffer);
     void encodeFrameOfZeros(QByteArray& encodedZeros);
+
+    // adjusts the encoder to the loss the listener reports on its mix, and to the load of the mixer
+    void adaptEncoder(float throttlingRatio);
     bool shouldFlushEncoder() { return _shouldFlushEncoder; }
 
+    // this listener was sent the encode of an identical mix, see AudioMixDeduplicator
+    void setEncodedByShare() { _shouldFlushEncoder = true; }
+
     QString getCodecName() { return _selectedCodecName; }
 
     bool shouldMuteClient() { return _shouldMuteClient; }
@@ -118,12 +122,14 @@ public:
     void setupCodecForReplicatedAgent(QSharedPointer<ReceivedMessage> message);
 
     struct MixableStream {
-        float approximateVolume { 0.0f };
+        float priority { 0.0f }; // the order streams are kept in while throttling, highest first
         NodeIDStreamID nodeStreamID;
         std::unique_ptr<AudioHRTF> hrtf;
         PositionalAudioStream* positionalStream;
         bool ignoredByListener { false };
         bool ignoringListener { false };
+        float clusteredGain { 0.0f }; // gain of the last block mixed from the spatialization cache
+        bool isOnFOABus { false }; // mixed in the listener's zone bus rather than through its own HRTF
 
         MixableStream(NodeIDStreamID nodeIDStreamID, PositionalAudioStream* positionalStream) :
             nodeStreamID(nodeIDStreamID), hrtf(new AudioHRTF), positionalStream(positionalStream) {};
@@ -163,6 +169,20 @@ public:
     bool getHasReceivedFirstMix() const { return _hasReceivedFirstMix; }
     void setHasReceivedFirstMix(bool hasReceivedFirstMix) { _hasReceivedFirstMix = hasReceivedFirstMix; }
 
+    // how long the last mix for this listener took, in usecs - the slave pool hands out the costliest mixes first
+    uint64_t getMixCost() const { return _mixCost; }
+    void setMixCost(uint64_t mixCost) { _mixCost = mixCost; }
+
+    // the listener's mix, kept from mixing to sending so that identical mixes can be encoded once
+    struct PreparedMix {
+        bool isPrepared { false };
+        bool hasAudio { false };
+        bool isGrouped { false };
+        uint hash { 0 };
+        std::array<int16_t, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO> samples;
+    };
+    PreparedMix& getPreparedMix() { return _preparedMix; }
+
     // end of methods called non-concurrently from single AudioMixerSlave
 
 signals:
@@ -202,6 +222,11 @@ private:
     Encoder* _encoder{ nullptr }; // for outbound mixed stream
     Decoder* _decoder{ nullptr }; // for mic stream
 
+    // reused from frame to frame, so that encoding the mix doesn't allocate
+    QByteArray _encodedBuffer;
+    int _encoderBitrate { 0 };      // 0 until adapted, when the codec's own default is in use
+    int _encoderComplexity { 0 };
+
     bool _shouldFlushEncoder { false };
 
     bool _shouldMuteClient { false };
@@ -223,6 +248,9 @@ private:
     std::vector<QUuid> _soloedNodes;
 
     bool _hasReceivedFirstMix { false };
+
+    uint64_t _mixCost { 0 };
+    PreparedMix _preparedMix;
 };
 
 #endif // hifi_AudioMixerClientData_h
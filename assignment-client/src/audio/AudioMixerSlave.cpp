@@ -12,6 +12,7 @@
 #include "AudioMixerSlave.h"
 
 #include <algorithm>
+#include <cfloat>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
@@ -22,6 +23,7 @@
 #include <NodeList.h>
 #include <Node.h>
 #include <OctreeConstants.h>
+#include <PortableHighResolutionClock.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
 #include <udt/PacketHeaders.h>
@@ -43,18 +45,43 @@ using MixableStreamsVector = AudioMixerClientData::MixableStreamsVector;
 
 // packet helpers
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec);
-void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer);
-void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
+qint64 sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer);
+qint64 sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
 void sendMutePacket(const SharedNodePointer& node, AudioMixerClientData&);
 void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
 
 // mix helpers
 inline float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd);
-inline float computeGain(float masterAvatarGain, float masterInjectorGain, const AvatarAudioStream& listeningNodeStream,
+inline float computeGain(float masterAvatarGain, float masterInjectorGain, const glm::vec3& listenerPosition,
         const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance);
 inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         const glm::vec3& relativePosition);
 
+static const int HRTF_DATASET_INDEX = 1;
+
+// one in this many mixes of each kind is timed, for the throttle's estimate of what they cost
+static const int MIX_TIMING_INTERVAL = 16;
+
+// while throttling, talkers are kept ahead of injectors as loud as them
+static const float MICROPHONE_PRIORITY_BOOST = 4.0f;   // +12dB
+
+// throttled streams nearer than this are reported apart, they are the ones listeners notice
+static const float NEAR_THROTTLE_DISTANCE = 5.0f;
+
+// runs a mix, timing it if it is one of the sampled ones
+template <typename Mix>
+void timeMix(int numMixes, uint64_t& mixTime, int& numTimed, Mix&& mix) {
+    if (numMixes % MIX_TIMING_INTERVAL != 0) {
+        mix();
+        return;
+    }
+
+    auto start = p_high_resolution_clock::now();
+    mix();
+    mixTime += std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - start).count();
+    ++numTimed;
+}
+
 void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
     if (data) {
@@ -63,11 +90,11 @@ void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     }
 }
 
-void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain) {
+void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio) {
     _begin = begin;
     _end = end;
     _frame = frame;
-    _numToRetain = numToRetain;
+    _throttlingRatio = throttlingRatio;
 }
 
 void AudioMixerSlave::mix(const SharedNodePointer& node) {
@@ -92,39 +119,65 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
         sendMutePacket(node, *data);
     }
 
-    // send audio packets, if necessary
+    // mix audio, if necessary - it is encoded and sent by send, once every listener is mixed
     if (node->getType() == NodeType::Agent && node->getActiveSocket()) {
         ++stats.sumListeners;
 
         // mix the audio
         bool mixHasAudio = prepareMix(node);
 
-        // send audio packet
-        if (mixHasAudio || data->shouldFlushEncoder()) {
-            QByteArray encodedBuffer;
-            if (mixHasAudio) {
-                // encode the audio
-                QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                data->encode(decodedBuffer, encodedBuffer);
-            } else {
-                // time to flush (resets shouldFlush until the next encode)
-                data->encodeFrameOfZeros(encodedBuffer);
-            }
+        auto& preparedMix = data->getPreparedMix();
+        preparedMix.isPrepared = true;
+        preparedMix.hasAudio = mixHasAudio;
+        if (mixHasAudio) {
+            memcpy(preparedMix.samples.data(), _bufferSamples, sizeof(_bufferSamples));
+            _sharedData.mixDeduplicator.addMix(*data, node->getLocalID());
+        }
+    }
+}
 
-            sendMixPacket(node, *data, encodedBuffer);
+void AudioMixerSlave::send(const SharedNodePointer& node) {
+    AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
+    if (data == nullptr) {
+        return;
+    }
+
+    auto& preparedMix = data->getPreparedMix();
+    if (!preparedMix.isPrepared) {
+        return;
+    }
+    preparedMix.isPrepared = false;
+
+    // send audio packet
+    if (preparedMix.hasAudio || data->shouldFlushEncoder()) {
+        QByteArray encodedBuffer;
+        if (preparedMix.hasAudio) {
+            // encode the audio, or share the encode of an identical mix
+            if (_sharedData.mixDeduplicator.encode(*data, encodedBuffer)) {
+                ++stats.mixEncodes;
+            }
+            ++stats.mixPackets;
         } else {
-            ++stats.sumListenersSilent;
-            sendSilentPacket(node, *data);
+            // time to flush (resets shouldFlush until the next encode)
+            data->encodeFrameOfZeros(encodedBuffer);
         }
 
-        // send environment packet
-        sendEnvironmentPacket(node, *data);
+        stats.mixBytes += sendMixPacket(node, *data, encodedBuffer);
+    } else {
+        ++stats.sumListenersSilent;
+        stats.mixBytes += sendSilentPacket(node, *data);
+    }
 
-        // send stats packet (about every second)
-        const unsigned int NUM_FRAMES_PER_SEC = (int)ceil(AudioConstants::NETWORK_FRAMES_PER_SEC);
-        if (data->shouldSendStats(_frame % NUM_FRAMES_PER_SEC)) {
-            data->sendAudioStreamStatsPackets(node);
-        }
+    // send environment packet
+    sendEnvironmentPacket(node, *data);
+
+    // send stats packet (about every second)
+    const unsigned int NUM_FRAMES_PER_SEC = (int)ceil(AudioConstants::NETWORK_FRAMES_PER_SEC);
+    if (data->shouldSendStats(_frame % NUM_FRAMES_PER_SEC)) {
+        data->sendAudioStreamStatsPackets(node);
+
+        // and adapt the encoder of its mix at the same pace
+        data->adaptEncoder(_throttlingRatio);
     }
 }
 
@@ -229,6 +282,108 @@ void AudioMixerSlave::addStreams(Node& listener, AudioMixerClientData& listenerD
     }
 }
 
+bool AudioMixerSlave::canShareFOABus(AudioMixerClientData& listenerData, bool isSoloing) {
+    // a bus is shared by everyone in the zone: it can't leave out the sources only this listener doesn't hear, nor apply
+    // the gains only this listener set
+    if (isSoloing || listenerData.getMasterAvatarGain() != listenerData.getMasterInjectorGain() ||
+        !listenerData.getNewIgnoredNodeIDs().empty() || !listenerData.getNewIgnoringNodeIDs().empty()) {
+        return false;
+    }
+
+    auto& foaBus = _sharedData.foaBus;
+    auto& streams = listenerData.getStreams();
+
+    auto isEncoded = [&](const MixableStream& stream) {
+        return foaBus.isEncoded(_foaBusCenter, *stream.positionalStream);
+    };
+    auto isAdjusted = [&](const MixableStream& stream) {
+        return stream.hrtf->getGainAdjustment() != HRTF_GAIN && isEncoded(stream);
+    };
+
+    return std::none_of(streams.skipped.begin(), streams.skipped.end(), isEncoded) &&
+           std::none_of(streams.active.begin(), streams.active.end(), isAdjusted) &&
+           std::none_of(streams.inactive.begin(), streams.inactive.end(), isAdjusted);
+}
+
+void AudioMixerSlave::encodeFOABus(const glm::vec3& cellCenter, float* bus) {
+    int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+
+    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (!nodeData) {
+            return;
+        }
+
+        for (auto& stream : nodeData->getAudioStreams()) {
+            if (!_sharedData.foaBus.isEncoded(cellCenter, *stream) || !stream->isVoiceActive()) {
+                continue;
+            }
+
+            float gain = 1.0f;
+            if (!stream->lastPopSucceeded()) {
+                // as in addStream, injectors go silent and other inputs repeat with a fade
+                if (stream->getLastPopOutput().isNull() || dynamic_cast<const InjectedAudioStream*>(stream.get())) {
+                    continue;
+                }
+                gain = calculateRepeatedFrameFadeFactor(stream->getConsecutiveNotMixedCount() - 1);
+            }
+
+            glm::vec3 relativePosition = stream->getPosition() - cellCenter;
+            float distance = glm::max(glm::length(relativePosition), EPSILON);
+            gain *= computeGain(1.0f, 1.0f, cellCenter, *stream, relativePosition, distance);
+            if (gain <= 0.0f) {
+                continue;
+            }
+
+            stream->getLastPopOutput().readSamples(samples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+            // encode as a plane wave from the source's direction, in the Z-up ambisonic coordinate system
+            glm::vec3 direction = relativePosition / distance;
+            float x = -direction.z;
+            float y = -direction.x;
+            float z = direction.y;
+            float scale = gain * (1 / 32768.0f);
+
+            for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+                float sample = samples[i] * scale;
+                bus[4 * i + 0] += sample;       // W
+                bus[4 * i + 1] += sample * y;   // Y
+                bus[4 * i + 2] += sample * z;   // Z
+                bus[4 * i + 3] += sample * x;   // X
+            }
+        }
+    });
+}
+
+void AudioMixerSlave::addFOABus(const AvatarAudioStream& listeningNodeStream, AudioMixerClientData& listenerData) {
+    bool wasEncoded;
+    const float* bus = _sharedData.foaBus.getBus(_foaBusCenter, [&](const glm::vec3& cellCenter, float* block) {
+        encodeFOABus(cellCenter, block);
+    }, wasEncoded);
+
+    if (wasEncoded) {
+        ++stats.foaBusEncodes;
+    }
+
+    if (!listenerData.isDecodingFOABus) {
+        listenerData.foaBusDecoder.reset();
+        listenerData.isDecodingFOABus = true;
+    }
+
+    // the bus is in world coordinates, turn it to face the listener
+    glm::quat relativeOrientation = glm::inverse(listeningNodeStream.getOrientation());
+
+    // convert from Y-up (OpenGL) to Z-up (Ambisonic) coordinate system
+    float qw = relativeOrientation.w;
+    float qx = -relativeOrientation.z;
+    float qy = -relativeOrientation.x;
+    float qz = relativeOrientation.y;
+
+    listenerData.foaBusDecoder.render(bus, _mixSamples, HRTF_DATASET_INDEX, qw, qx, qy, qz,
+                                      listenerData.getMasterAvatarGain(), AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    ++stats.foaBusDecodes;
+}
+
 bool shouldBeRemoved(const MixableStream& stream, const AudioMixerSlave::SharedData& sharedData) {
     return (contains(sharedData.removedNodes, stream.nodeStreamID.nodeLocalID) ||
             contains(sharedData.removedStreams, stream.nodeStreamID));
@@ -236,7 +391,8 @@ bool shouldBeRemoved(const MixableStream& stream, const AudioMixerSlave::SharedD
 
 bool shouldBeInactive(MixableStream& stream) {
     return (!stream.positionalStream->lastPopSucceeded() ||
-            stream.positionalStream->getLastPopOutputLoudness() == 0.0f);
+            stream.positionalStream->getLastPopOutputLoudness() == 0.0f ||
+            !stream.positionalStream->isVoiceActive());
 };
 
 bool shouldBeSkipped(MixableStream& stream, const Node& listener,
@@ -306,6 +462,34 @@ float approximateVolume(const MixableStream& stream, const AvatarAudioStream* li
     return stream.positionalStream->getLastPopOutputTrailingLoudness() * gain;
 };
 
+float streamPriority(const MixableStream& stream, const AvatarAudioStream* listenerAudioStream, bool isSoloing) {
+    // the listener's own echo and the streams it soloed are what it asked to hear
+    if (stream.positionalStream == listenerAudioStream || isSoloing) {
+        return FLT_MAX;
+    }
+
+    // otherwise far and quiet streams go first
+    float priority = approximateVolume(stream, listenerAudioStream);
+    if (stream.positionalStream->getType() == PositionalAudioStream::Microphone) {
+        priority *= MICROPHONE_PRIORITY_BOOST;
+    }
+    return priority;
+}
+
+float AudioMixerSlave::estimateMixCost(const MixableStream& mixableStream, const AvatarAudioStream& listeningNodeStream) const {
+    auto streamToAdd = mixableStream.positionalStream;
+
+    if (_isOnFOABus && _sharedData.foaBus.isEncoded(_foaBusCenter, *streamToAdd)) {
+        return 0.0f;
+    }
+
+    if (streamToAdd->isStereo() || streamToAdd == &listeningNodeStream) {
+        return _sharedData.manualMixCost;
+    }
+
+    return 1.0f;
+}
+
 bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     AvatarAudioStream* listenerAudioStream = static_cast<AudioMixerClientData*>(listener->getLinkedData())->getAvatarAudioStream();
     AudioMixerClientData* listenerData = static_cast<AudioMixerClientData*>(listener->getLinkedData());
@@ -313,13 +497,19 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     // zero out the mix for this listener
     memset(_mixSamples, 0, sizeof(_mixSamples));
 
-    bool isThrottling = _numToRetain != -1;
+    bool isThrottling = _throttlingRatio > 0.0f;
     bool isSoloing = !listenerData->getSoloedNodes().empty();
 
     auto& streams = listenerData->getStreams();
 
     addStreams(*listener, *listenerData);
 
+    _isOnFOABus = _sharedData.foaBus.isEnabled();
+    if (_isOnFOABus) {
+        _foaBusCenter = _sharedData.foaBus.getCellCenter(listenerAudioStream->getPosition());
+        _isOnFOABus = canShareFOABus(*listenerData, isSoloing);
+    }
+
     // Process skipped streams
     erase_if(streams.skipped, [&](MixableStream& stream) {
         if (shouldBeRemoved(stream, _sharedData)) {
@@ -376,9 +566,10 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
         }
 
         if (isThrottling) {
-            // we're throttling, so we need to update the approximate volume for any un-skipped streams
-            // unless this is simply for an echo (in which case the approx volume is 1.0)
-            stream.approximateVolume = approximateVolume(stream, listenerAudioStream);
+            // we're throttling, so we need to update the priority for any un-skipped streams,
+            // those heard through the zone bus cost nothing more and are always kept
+            bool isOnBus = _isOnFOABus && _sharedData.foaBus.isEncoded(_foaBusCenter, *stream.positionalStream);
+            stream.priority = isOnBus ? FLT_MAX : streamPriority(stream, listenerAudioStream, isSoloing);
         } else {
             if (shouldBeSkipped(stream, *listener, *listenerAudioStream, *listenerData)) {
                 addStream(stream, *listenerAudioStream, 0.0f, 0.0f, isSoloing);
@@ -404,15 +595,24 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     });
 
     if (isThrottling) {
-        // since we're throttling, we need to partition the mixable into throttled and unthrottled streams
-        int numToRetain = min(_numToRetain, (int)streams.active.size()); // Make sure we don't overflow
-        auto throttlePoint = begin(streams.active) + numToRetain;
+        // since we're throttling, we need to partition the mixable into throttled and unthrottled streams:
+        // by priority, keep streams until they use up this listener's share of what mixing all of them costs
+        std::sort(streams.active.begin(), streams.active.end(), [](const auto& a, const auto& b) {
+            return a.priority > b.priority;
+        });
+
+        float totalCost = 0.0f;
+        for (const auto& stream : streams.active) {
+            totalCost += estimateMixCost(stream, *listenerAudioStream);
+        }
 
-        std::nth_element(streams.active.begin(), throttlePoint, streams.active.end(),
-                         [](const auto& a, const auto& b)
-                         {
-                             return a.approximateVolume > b.approximateVolume;
-                         });
+        float budget = (1.0f - _throttlingRatio) * totalCost;
+        float retainedCost = 0.0f;
+        auto throttlePoint = begin(streams.active);
+        while (throttlePoint != end(streams.active) && (retainedCost < budget || throttlePoint->priority == FLT_MAX)) {
+            retainedCost += estimateMixCost(*throttlePoint, *listenerAudioStream);
+            ++throttlePoint;
+        }
 
         SegmentedEraseIf<MixableStreamsVector> erase(streams.active);
         erase.iterateTo(throttlePoint, [&](MixableStream& stream) {
@@ -444,6 +644,18 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
             // preventing excessive artifacts on the next first block
             resetHRTFState(stream);
 
+            ++stats.throttledStreams;
+            if (stream.positionalStream->getType() == PositionalAudioStream::Microphone) {
+                ++stats.throttledMicrophones;
+            } else {
+                ++stats.throttledInjectors;
+            }
+            if (glm::distance2(stream.positionalStream->getPosition(), listenerAudioStream->getPosition()) <
+                NEAR_THROTTLE_DISTANCE * NEAR_THROTTLE_DISTANCE) {
+                ++stats.throttledNearStreams;
+            }
+            stats.throttledCost += estimateMixCost(stream, *listenerAudioStream);
+
             if (shouldBeSkipped(stream, *listener, *listenerAudioStream, *listenerData)) {
                 streams.skipped.push_back(move(stream));
                 ++stats.activeToSkipped;
@@ -462,8 +674,17 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 
     stats.skipped += (int)streams.skipped.size();
     stats.inactive += (int)streams.inactive.size();
+    stats.voiceInactive += (int)std::count_if(streams.inactive.begin(), streams.inactive.end(), [](const MixableStream& stream) {
+        return !stream.positionalStream->isVoiceActive();
+    });
     stats.active += (int)streams.active.size();
 
+    if (_isOnFOABus) {
+        addFOABus(*listenerAudioStream, *listenerData);
+    } else {
+        listenerData->isDecodingFOABus = false;
+    }
+
     // clear the newly ignored, un-ignored, ignoring, and un-ignoring streams now that we've processed them
     listenerData->clearStagedIgnoreChanges();
 
@@ -498,6 +719,17 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
 
     auto streamToAdd = mixableStream.positionalStream;
 
+    if (_isOnFOABus && _sharedData.foaBus.isEncoded(_foaBusCenter, *streamToAdd)) {
+        // this one is heard in the listener's zone bus, start its HRTF over if it comes near again
+        if (!mixableStream.isOnFOABus) {
+            mixableStream.hrtf->reset();
+            mixableStream.isOnFOABus = true;
+        }
+        ++stats.foaBusMixes;
+        return;
+    }
+    mixableStream.isOnFOABus = false;
+
     // check if this is a server echo of a source back to itself
     bool isEcho = (streamToAdd == &listeningNodeStream);
 
@@ -506,12 +738,10 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
     float distance = glm::max(glm::length(relativePosition), EPSILON);
     float gain = isEcho ? 1.0f
                         : (isSoloing ? masterAvatarGain
-                                     : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream, *streamToAdd,
+                                     : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream.getPosition(), *streamToAdd,
                                                    relativePosition, distance));
     float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
 
-    const int HRTF_DATASET_INDEX = 1;
-
     if (!streamToAdd->lastPopSucceeded()) {
         bool forceSilentBlock = true;
 
@@ -536,10 +766,7 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
             // (this is not done for stereo streams since they do not go through the HRTF)
             if (!streamToAdd->isStereo() && !isEcho) {
                 static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
-                mixableStream.hrtf->render(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
-                ++stats.hrtfRenders;
+                renderHRTF(mixableStream, silentMonoBlock, azimuth, distance, gain);
             }
 
             return;
@@ -551,28 +778,65 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
 
     if (streamToAdd->isStereo()) {
 
-        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+        timeMix(stats.manualStereoMixes + stats.manualEchoMixes, stats.manualMixTime, stats.manualMixesTimed, [&] {
+            streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
 
-        // stereo sources are not passed through HRTF
-        mixableStream.hrtf->mixStereo(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            // stereo sources are not passed through HRTF
+            mixableStream.hrtf->mixStereo(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        });
 
         ++stats.manualStereoMixes;
     } else if (isEcho) {
 
-        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        timeMix(stats.manualStereoMixes + stats.manualEchoMixes, stats.manualMixTime, stats.manualMixesTimed, [&] {
+            streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
-        // echo sources are not passed through HRTF
-        mixableStream.hrtf->mixMono(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            // echo sources are not passed through HRTF
+            mixableStream.hrtf->mixMono(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        });
 
         ++stats.manualEchoMixes;
     } else {
 
         streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
-        mixableStream.hrtf->render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                   AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        renderHRTF(mixableStream, _bufferSamples, azimuth, distance, gain);
+    }
+}
+
+void AudioMixerSlave::renderHRTF(AudioMixerClientData::MixableStream& mixableStream, int16_t* input, float azimuth,
+                                 float distance, float gain) {
+    auto& cache = _sharedData.spatializationCache;
+    if (!cache.isEnabled()) {
+        timeMix(stats.hrtfRenders, stats.hrtfMixTime, stats.hrtfMixesTimed, [&] {
+            mixableStream.hrtf->render(input, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                                       AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        });
         ++stats.hrtfRenders;
+        return;
     }
+
+    bool wasRendered;
+    const float* block = cache.getBlock(mixableStream.nodeStreamID, input, HRTF_DATASET_INDEX, azimuth, distance,
+                                        wasRendered);
+    if (wasRendered) {
+        ++stats.hrtfRenders;
+    } else {
+        ++stats.hrtfCacheHits;
+    }
+
+    // the block was rendered at unity gain, so apply this listener's gain, ramped from the last block as the HRTF would
+    gain *= mixableStream.hrtf->getGainAdjustment() / HRTF_GAIN;
+    float startGain = mixableStream.clusteredGain;
+    float gainStep = (gain - startGain) / AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+        float frameGain = startGain + gainStep * (i + 1);
+        _mixSamples[2 * i + 0] += frameGain * block[2 * i + 0];
+        _mixSamples[2 * i + 1] += frameGain * block[2 * i + 1];
+    }
+
+    mixableStream.clusteredGain = gain;
 }
 
 void AudioMixerSlave::updateHRTFParameters(AudioMixerClientData::MixableStream& mixableStream,
@@ -587,17 +851,19 @@ void AudioMixerSlave::updateHRTFParameters(AudioMixerClientData::MixableStream&
     glm::vec3 relativePosition = streamToAdd->getPosition() - listeningNodeStream.getPosition();
 
     float distance = glm::max(glm::length(relativePosition), EPSILON);
-    float gain = isEcho ? 1.0f : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream, *streamToAdd, 
+    float gain = isEcho ? 1.0f : computeGain(masterAvatarGain, masterInjectorGain, listeningNodeStream.getPosition(), *streamToAdd, 
                                              relativePosition, distance);
     float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
 
     mixableStream.hrtf->setParameterHistory(azimuth, distance, gain);
+    mixableStream.clusteredGain = gain * mixableStream.hrtf->getGainAdjustment() / HRTF_GAIN;
 
     ++stats.hrtfUpdates;
 }
 
 void AudioMixerSlave::resetHRTFState(AudioMixerClientData::MixableStream& mixableStream) {
      mixableStream.hrtf->reset();
+    mixableStream.clusteredGain = 0.0f;
     ++stats.hrtfResets;
 }
 
@@ -608,7 +874,7 @@ std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 s
     return audioPacket;
 }
 
-void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer) {
+qint64 sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer) {
     const int MIX_PACKET_SIZE =
         sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE + AudioConstants::NETWORK_FRAME_BYTES_STEREO;
     quint16 sequence = data.getOutgoingSequenceNumber();
@@ -619,11 +885,13 @@ void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QB
     mixPacket->write(buffer.constData(), buffer.size());
 
     // send packet
+    qint64 packetSize = mixPacket->getDataSize();
     DependencyManager::get<NodeList>()->sendPacket(std::move(mixPacket), *node);
     data.incrementOutgoingMixedAudioSequenceNumber();
+    return packetSize;
 }
 
-void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data) {
+qint64 sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data) {
     const int SILENT_PACKET_SIZE =
         sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE + sizeof(quint16);
     quint16 sequence = data.getOutgoingSequenceNumber();
@@ -634,8 +902,10 @@ void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data)
     mixPacket->writePrimitive(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
 
     // send packet
+    qint64 packetSize = mixPacket->getDataSize();
     DependencyManager::get<NodeList>()->sendPacket(std::move(mixPacket), *node);
     data.incrementOutgoingMixedAudioSequenceNumber();
+    return packetSize;
 }
 
 void sendMutePacket(const SharedNodePointer& node, AudioMixerClientData& data) {
@@ -728,7 +998,7 @@ float approximateGain(const AvatarAudioStream& listeningNodeStream, const Positi
 
 float computeGain(float masterAvatarGain,
                   float masterInjectorGain,
-                  const AvatarAudioStream& listeningNodeStream,
+                  const glm::vec3& listenerPosition,
                   const PositionalAudioStream& streamToAdd,
                   const glm::vec3& relativePosition,
                   float distance) {
@@ -765,7 +1035,7 @@ float computeGain(float masterAvatarGain,
     float attenuationPerDoublingInDistance = AudioMixer::getAttenuationPerDoublingInDistance();
     for (const auto& settings : zoneSettings) {
         if (audioZones[settings.source].area.contains(streamToAdd.getPosition()) &&
-            audioZones[settings.listener].area.contains(listeningNodeStream.getPosition())) {
+            audioZones[settings.listener].area.contains(listenerPosition)) {
             attenuationPerDoublingInDistance = settings.coefficient;
             break;
         }
@@ -25,8 +25,11 @@
 #include <NodeList.h>
 #include <PositionalAudioStream.h>
 
+#include "AudioFOABus.h"
+#include "AudioMixDeduplicator.h"
 #include "AudioMixerClientData.h"
 #include "AudioMixerStats.h"
+#include "AudioSpatializationCache.h"
 
 class AvatarAudioStream;
 class AudioHRTF;
@@ -39,6 +42,12 @@ public:
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+        AudioSpatializationCache spatializationCache;
+        AudioFOABus foaBus;
+        AudioMixDeduplicator mixDeduplicator;
+
+        // what mixing a stereo or echo stream costs compared to an HRTF render, as measured by the mixer
+        float manualMixCost { 0.25f };
     };
 
     AudioMixerSlave(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -47,12 +56,14 @@ public:
     void processPackets(const SharedNodePointer& node);
 
     // configure a round of mixing
-    void configureMix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain);
+    void configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio);
 
-    // mix and broadcast non-ignored streams to the node (requires configuration using configureMix, above)
-    // returns true if a mixed packet was sent to the node
+    // mix non-ignored streams for the node (requires configuration using configureMix, above)
     void mix(const SharedNodePointer& node);
 
+    // encode and send the node's mix (requires every node to be mixed first, see AudioMixDeduplicator)
+    void send(const SharedNodePointer& node);
+
     AudioMixerStats stats;
 
 private:
@@ -68,8 +79,16 @@ private:
                               float masterAvatarGain,
                               float masterInjectorGain);
     void resetHRTFState(AudioMixerClientData::MixableStream& mixableStream);
+    void renderHRTF(AudioMixerClientData::MixableStream& mixableStream, int16_t* input, float azimuth, float distance,
+                    float gain);
 
     void addStreams(Node& listener, AudioMixerClientData& listenerData);
+    float estimateMixCost(const AudioMixerClientData::MixableStream& mixableStream,
+                          const AvatarAudioStream& listeningNodeStream) const;
+
+    bool canShareFOABus(AudioMixerClientData& listenerData, bool isSoloing);
+    void encodeFOABus(const glm::vec3& cellCenter, float* bus);
+    void addFOABus(const AvatarAudioStream& listeningNodeStream, AudioMixerClientData& listenerData);
 
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
@@ -79,7 +98,11 @@ private:
     ConstIter _begin;
     ConstIter _end;
     unsigned int _frame { 0 };
-    int _numToRetain { -1 };
+    float _throttlingRatio { 0.0f }; // share of each listener's stream mixing cost to shed
+
+    // listener state
+    bool _isOnFOABus { false };
+    glm::vec3 _foaBusCenter;
 
     SharedData& _sharedData;
 };
@@ -16,18 +16,39 @@
 #include <assert.h>
 #include <algorithm>
 
+#include <SharedUtil.h>
 #include <ThreadHelpers.h>
 
+static uint64_t mixCost(const SharedNodePointer& node) {
+    auto data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+    return data ? data->getMixCost() : 0;
+}
+
 void AudioMixerSlaveThread::run() {
     while (true) {
         wait();
 
+        auto roundStart = usecTimestampNow();
+
         // iterate over all available nodes
         SharedNodePointer node;
         while (try_pop(node)) {
-            (this->*_function)(node);
+            if (_measureCost) {
+                auto start = usecTimestampNow();
+                (this->*_function)(node);
+
+                auto data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+                if (data) {
+                    data->setMixCost(usecTimestampNow() - start);
+                }
+            } else {
+                (this->*_function)(node);
+            }
         }
 
+        _roundBusyTime = usecTimestampNow() - roundStart;
+        stats.busyTime += _roundBusyTime;
+
         bool stopping = _stop;
         notify(stopping);
         if (stopping) {
@@ -50,6 +71,7 @@ void AudioMixerSlaveThread::wait() {
         _pool._configure(*this);
     }
     _function = _pool._function;
+    _measureCost = _pool._measureCost;
 }
 
 void AudioMixerSlaveThread::notify(bool stopping) {
@@ -71,26 +93,46 @@ bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node) {
 void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end) {
     _function = &AudioMixerSlave::processPackets;
     _configure = [](AudioMixerSlave& slave) {};
-    run(begin, end);
+    run(begin, end, false);
 }
 
-void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain) {
+void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio) {
     _function = &AudioMixerSlave::mix;
     _configure = [=](AudioMixerSlave& slave) {
-        slave.configureMix(_begin, _end, frame, numToRetain);
+        slave.configureMix(_begin, _end, frame, throttlingRatio);
     };
 
-    run(begin, end);
+    run(begin, end, true);
+
+    // encoding waits for every mix, so that identical ones are only encoded once
+    _function = &AudioMixerSlave::send;
+    run(begin, end, false);
 }
 
-void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
+void AudioMixerSlavePool::run(ConstIter begin, ConstIter end, bool costliestFirst) {
     _begin = begin;
     _end = end;
+    _measureCost = costliestFirst;
 
     // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
-    });
+    if (costliestFirst) {
+        // a listener in a dense crowd costs many times one alone - started last, it would hold the round up while
+        // the other threads sit idle, started first, the cheap ones fill in around it
+        _sortedNodes.assign(_begin, _end);
+        std::stable_sort(_sortedNodes.begin(), _sortedNodes.end(), [](const SharedNodePointer& a, const SharedNodePointer& b) {
+            return mixCost(a) > mixCost(b);
+        });
+        for (const auto& node : _sortedNodes) {
+            _queue.push(node);
+        }
+        _sortedNodes.clear();
+    } else {
+        std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
+            _queue.push(node);
+        });
+    }
+
+    auto roundStart = usecTimestampNow();
 
     {
         Lock lock(_mutex);
@@ -109,6 +151,15 @@ void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
     }
 
     assert(_queue.empty());
+
+    // the slaves are all waiting for the next round, their times can be read
+    auto roundTime = usecTimestampNow() - roundStart;
+    for (auto& slave : _slaves) {
+        auto idleTime = roundTime > slave->_roundBusyTime ? roundTime - slave->_roundBusyTime : 0;
+        slave->stats.idleTime += idleTime;
+        slave->_totalBusyTime += slave->_roundBusyTime;
+        slave->_totalIdleTime += idleTime;
+    }
 }
 
 void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> functor) {
@@ -117,6 +168,22 @@ void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> funct
     }
 }
 
+void AudioMixerSlavePool::threadStats(QJsonObject& stats) {
+    unsigned i = 0;
+    for (auto& slave : _slaves) {
+        QJsonObject threadStats;
+        auto totalTime = slave->_totalBusyTime + slave->_totalIdleTime;
+        threadStats["busy_usecs"] = (qint64)slave->_totalBusyTime;
+        threadStats["idle_usecs"] = (qint64)slave->_totalIdleTime;
+        threadStats["busy_%"] = totalTime > 0 ? 100.0 * slave->_totalBusyTime / totalTime : 0.0;
+        stats[QString("thread_%1").arg(i)] = threadStats;
+
+        slave->_totalBusyTime = 0;
+        slave->_totalIdleTime = 0;
+        i++;
+    }
+}
+
 #ifdef DEBUG_EVENT_QUEUE
 void AudioMixerSlavePool::queueStats(QJsonObject& stats) {
     unsigned i = 0;
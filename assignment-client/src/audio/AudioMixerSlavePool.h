@@ -16,6 +16,7 @@
 #include <mutex>
 #include <vector>
 
+#include <QJsonObject>
 #include <QThread>
 #include <shared/QtHelpers.h>
 #include <TBBHelpers.h>
@@ -45,11 +46,20 @@ private:
 
     AudioMixerSlavePool& _pool;
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
+    bool _measureCost { false };
     bool _stop { false };
+
+    // usecs spent on nodes in the current round, and in all rounds since the last AudioMixerSlavePool::threadStats
+    uint64_t _roundBusyTime { 0 };
+    uint64_t _totalBusyTime { 0 };
+    uint64_t _totalIdleTime { 0 };
 };
 
 // Slave pool for audio mixers
 //   AudioMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
+//   The same threads serve every round. They take nodes off one shared queue as they go, so a thread that is done
+//   with a node picks up the next one whichever thread would otherwise have had it. Mixes are queued costliest
+//   first, by how long each listener's last mix took, so that threads finish a round at about the same time.
 class AudioMixerSlavePool {
     using Queue = tbb::concurrent_queue<SharedNodePointer>;
     using Mutex = std::mutex;
@@ -66,8 +76,8 @@ public:
     // process packets on slave threads
     void processPackets(ConstIter begin, ConstIter end);
 
-    // mix on slave threads
-    void mix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain);
+    // mix, then encode and send, on slave threads
+    void mix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio);
 
     // iterate over all slaves
     void each(std::function<void(AudioMixerSlave& slave)> functor);
@@ -76,11 +86,14 @@ public:
     void queueStats(QJsonObject& stats);
 #endif
 
+    // busy and idle time of each thread since the last call
+    void threadStats(QJsonObject& stats);
+
     void setNumThreads(int numThreads);
     int numThreads() { return _numThreads; }
 
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(ConstIter begin, ConstIter end, bool costliestFirst);
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AudioMixerSlaveThread>> _slaves;
@@ -95,6 +108,7 @@ private:
     ConditionVariable _poolCondition;
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node);
     std::function<void(AudioMixerSlave&)> _configure;
+    bool _measureCost { false };
     int _numThreads { 0 };
     int _numStarted { 0 }; // guarded by _mutex
     int _numFinished { 0 }; // guarded by _mutex
@@ -102,6 +116,7 @@ private:
 
     // frame state
     Queue _queue;
+    std::vector<SharedNodePointer> _sortedNodes;
     ConstIter _begin;
     ConstIter _end;
 
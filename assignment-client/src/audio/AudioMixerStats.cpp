@@ -21,10 +21,30 @@ void AudioMixerStats::reset() {
     hrtfRenders = 0;
     hrtfResets = 0;
     hrtfUpdates = 0;
+    hrtfCacheHits = 0;
+
+    foaBusMixes = 0;
+    foaBusEncodes = 0;
+    foaBusDecodes = 0;
+
+    mixPackets = 0;
+    mixEncodes = 0;
+    mixBytes = 0;
 
     manualStereoMixes = 0;
     manualEchoMixes = 0;
 
+    throttledStreams = 0;
+    throttledMicrophones = 0;
+    throttledInjectors = 0;
+    throttledNearStreams = 0;
+    throttledCost = 0.0f;
+
+    hrtfMixTime = 0;
+    hrtfMixesTimed = 0;
+    manualMixTime = 0;
+    manualMixesTimed = 0;
+
     skippedToActive = 0;
     skippedToInactive = 0;
     inactiveToSkipped = 0;
@@ -34,8 +54,12 @@ void AudioMixerStats::reset() {
 
     skipped = 0;
     inactive = 0;
+    voiceInactive = 0;
     active = 0;
 
+    busyTime = 0;
+    idleTime = 0;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
 #endif
@@ -51,10 +75,30 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     hrtfRenders += otherStats.hrtfRenders;
     hrtfResets += otherStats.hrtfResets;
     hrtfUpdates += otherStats.hrtfUpdates;
+    hrtfCacheHits += otherStats.hrtfCacheHits;
+
+    foaBusMixes += otherStats.foaBusMixes;
+    foaBusEncodes += otherStats.foaBusEncodes;
+    foaBusDecodes += otherStats.foaBusDecodes;
+
+    mixPackets += otherStats.mixPackets;
+    mixEncodes += otherStats.mixEncodes;
+    mixBytes += otherStats.mixBytes;
 
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
 
+    throttledStreams += otherStats.throttledStreams;
+    throttledMicrophones += otherStats.throttledMicrophones;
+    throttledInjectors += otherStats.throttledInjectors;
+    throttledNearStreams += otherStats.throttledNearStreams;
+    throttledCost += otherStats.throttledCost;
+
+    hrtfMixTime += otherStats.hrtfMixTime;
+    hrtfMixesTimed += otherStats.hrtfMixesTimed;
+    manualMixTime += otherStats.manualMixTime;
+    manualMixesTimed += otherStats.manualMixesTimed;
+
     skippedToActive += otherStats.skippedToActive;
     skippedToInactive += otherStats.skippedToInactive;
     inactiveToSkipped += otherStats.inactiveToSkipped;
@@ -64,8 +108,12 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
 
     skipped += otherStats.skipped;
     inactive += otherStats.inactive;
+    voiceInactive += otherStats.voiceInactive;
     active += otherStats.active;
 
+    busyTime += otherStats.busyTime;
+    idleTime += otherStats.idleTime;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
 #endif
@@ -12,9 +12,7 @@
 #ifndef hifi_AudioMixerStats_h
 #define hifi_AudioMixerStats_h
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
 #include <cstdint>
-#endif
 
 struct AudioMixerStats {
     int sumStreams { 0 };
@@ -26,10 +24,32 @@ struct AudioMixerStats {
     int hrtfRenders { 0 };
     int hrtfResets { 0 };
     int hrtfUpdates { 0 };
+    int hrtfCacheHits { 0 }; // blocks shared from the spatialization cache instead of rendered
+
+    int foaBusMixes { 0 }; // streams heard in a listener's zone bus instead of through its own HRTF
+    int foaBusEncodes { 0 };
+    int foaBusDecodes { 0 };
+
+    int mixPackets { 0 }; // mixes with audio sent to listeners
+    int mixEncodes { 0 }; // ... and the encodes they took, fewer when listeners share identical mixes
+    uint64_t mixBytes { 0 }; // the bytes of the mixes and the silent frames sent to listeners
 
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
 
+    // streams dropped from listeners' mixes by the throttle, and the HRTF renders their mixes would have cost
+    int throttledStreams { 0 };
+    int throttledMicrophones { 0 };
+    int throttledInjectors { 0 };
+    int throttledNearStreams { 0 };
+    float throttledCost { 0.0f };
+
+    // nsecs spent on the sampled mixes of each kind
+    uint64_t hrtfMixTime { 0 };
+    int hrtfMixesTimed { 0 };
+    uint64_t manualMixTime { 0 };
+    int manualMixesTimed { 0 };
+
     int skippedToActive { 0 };
     int skippedToInactive { 0 };
     int inactiveToSkipped { 0 };
@@ -39,8 +59,13 @@ struct AudioMixerStats {
 
     int skipped { 0 };
     int inactive { 0 };
+    int voiceInactive { 0 };
     int active { 0 };
 
+    // usecs slave threads spent on their share of a frame, and waiting for the other threads to finish theirs
+    uint64_t busyTime { 0 };
+    uint64_t idleTime { 0 };
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     uint64_t mixTime { 0 };
 #endif
@@ -0,0 +1,80 @@
+//
+//  AudioSpatializationCache.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AudioSpatializationCache.h"
+
+#include <cmath>
+
+#include <NumericalConstants.h>
+#include <UUIDHasher.h>
+
+// about the minimum audible angle to the side of the head, where it is widest
+const float AudioSpatializationCache::DEFAULT_AZIMUTH_STEP = 5.0f * RADIANS_PER_DEGREE;
+
+size_t AudioSpatializationCache::KeyHasher::operator()(const Key& key) const {
+    size_t hash = UUIDHasher()(key.streamID);
+    hash = hash * 31 + key.nodeLocalID;
+    hash = hash * 31 + (size_t)key.azimuthBucket;
+    hash = hash * 31 + (size_t)key.distanceBucket;
+    return hash;
+}
+
+void AudioSpatializationCache::beginFrame(unsigned int frame) {
+    _frame = frame;
+
+    // a bucket nobody mixed last frame has a stale filter state, have it start over if a listener comes back to it
+    for (auto& shard : _shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+            if (it->second->renderedFrame + 1 < frame) {
+                it = shard.entries.erase(it);
+                --_numEntries;
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+const float* AudioSpatializationCache::getBlock(const NodeIDStreamID& source, int16_t* input, int index, float azimuth,
+                                                float distance, bool& wasRendered) {
+    int azimuthBucket = (int)std::lround(azimuth / _azimuthStep);
+    int distanceBucket = (int)std::lround(std::log2(distance) * DISTANCE_STEPS_PER_OCTAVE);
+
+    Key key { source.nodeLocalID, source.streamID, azimuthBucket, distanceBucket };
+    size_t hash = KeyHasher()(key);
+
+    Entry* entry;
+    {
+        auto& shard = _shards[hash % NUM_SHARDS];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto& slot = shard.entries[key];
+        if (!slot) {
+            slot.reset(new Entry);
+            ++_numEntries;
+        }
+        entry = slot.get();
+    }
+
+    // entries are only erased between frames, so this one outlives the shard lock
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    wasRendered = entry->renderedFrame != _frame;
+    if (wasRendered) {
+        entry->block.fill(0.0f);
+        entry->hrtf.render(input, entry->block.data(), index, azimuthBucket * _azimuthStep,
+                           std::exp2((float)distanceBucket / DISTANCE_STEPS_PER_OCTAVE), 1.0f,
+                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        entry->renderedFrame = _frame;
+    }
+
+    // the block won't change again until the next frame
+    return entry->block.data();
+}
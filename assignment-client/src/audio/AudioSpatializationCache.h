@@ -0,0 +1,100 @@
+//
+//  AudioSpatializationCache.h
+//  assignment-client/src/audio
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#ifndef overte_AudioSpatializationCache_h
+#define overte_AudioSpatializationCache_h
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <AudioConstants.h>
+#include <AudioHRTF.h>
+#include <PositionalAudioStream.h>
+
+/// @brief Shares HRTF renders of a source between listeners that hear it from about the same place.
+/// @details In clustered listener mode, a listener's azimuth and distance to a mono source are quantized to a perceptual
+/// tolerance, and every listener that lands in the same bucket mixes the same block, rendered once per frame at the
+/// bucket's center and at unity gain. Each listener still applies its own gain, so only the direction and the distance
+/// filters are shared. A bucket keeps its own AudioHRTF, so its filter state stays continuous for as long as some listener
+/// hears the source from there.
+/// <p>getBlock() is thread-safe and is called by the slaves while they mix. beginFrame() is called by the mixer between
+/// mixes.</p>
+class AudioSpatializationCache {
+public:
+    static const float DEFAULT_AZIMUTH_STEP; // radians
+    static const int DISTANCE_STEPS_PER_OCTAVE = 8;
+
+    void setEnabled(bool enabled) { _isEnabled = enabled; }
+    bool isEnabled() const { return _isEnabled; }
+
+    /// @brief Sets the width of an azimuth bucket. Listeners are at most half of it away from the azimuth they hear.
+    void setAzimuthStep(float azimuthStep) { _azimuthStep = azimuthStep; }
+    float getAzimuthStep() const { return _azimuthStep; }
+
+    /// @brief Starts a frame, dropping the buckets that nobody mixed in the previous one.
+    void beginFrame(unsigned int frame);
+
+    /// @brief The source's block for a listener at the given azimuth and distance, rendering it if no other listener in
+    /// the bucket has this frame.
+    /// @param input The source's mono samples for this frame, only read if the block is rendered.
+    /// @param wasRendered Set to whether this call rendered the block.
+    /// @return Interleaved stereo samples, valid until the next beginFrame().
+    const float* getBlock(const NodeIDStreamID& source, int16_t* input, int index, float azimuth, float distance,
+                          bool& wasRendered);
+
+    int getNumEntries() const { return _numEntries; }
+
+private:
+    struct Key {
+        Node::LocalID nodeLocalID;
+        StreamID streamID;
+        int azimuthBucket;
+        int distanceBucket;
+
+        bool operator==(const Key& other) const {
+            return nodeLocalID == other.nodeLocalID && azimuthBucket == other.azimuthBucket &&
+                   distanceBucket == other.distanceBucket && streamID == other.streamID;
+        }
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        std::mutex mutex;
+        AudioHRTF hrtf;
+        unsigned int renderedFrame { 0 };
+        std::array<float, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO> block;
+    };
+
+    // slaves look up buckets for every stream they mix, so the map is split to keep them from contending on one lock
+    static const int NUM_SHARDS = 16;
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<Key, std::unique_ptr<Entry>, KeyHasher> entries;
+    };
+
+    std::array<Shard, NUM_SHARDS> _shards;
+
+    bool _isEnabled { false };
+    float _azimuthStep { DEFAULT_AZIMUTH_STEP };
+    unsigned int _frame { 0 };
+    std::atomic<int> _numEntries { 0 };
+};
+
+#endif // overte_AudioSpatializationCache_h
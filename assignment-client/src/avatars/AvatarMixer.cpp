@@ -31,6 +31,7 @@
 #include <AvatarLogging.h>
 #include <LogHandler.h>
 #include <NodeList.h>
+#include <udt/PacketBufferPool.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <UUID.h>
@@ -223,10 +224,9 @@ void AvatarMixer::queueIncomingPacket(QSharedPointer<ReceivedMessage> message, S
 
 void AvatarMixer::sendIdentityPacket(AvatarMixerClientData* nodeData, const SharedNodePointer& destinationNode) {
     if (destinationNode->getType() == NodeType::Agent && !destinationNode->isUpstream()) {
-        QByteArray individualData = nodeData->getAvatar().identityByteArray();
-        individualData.replace(0, NUM_BYTES_RFC4122_UUID, nodeData->getNodeID().toRfc4122());
+        nodeData->updateIdentityPacketData();
         auto identityPackets = NLPacketList::create(PacketType::AvatarIdentity, QByteArray(), true, true);
-        identityPackets->write(individualData);
+        identityPackets->write(nodeData->getIdentityPacketData());
         DependencyManager::get<NodeList>()->sendPacketList(std::move(identityPackets), *destinationNode);
         ++_sumIdentityPackets;
     }
@@ -256,6 +256,12 @@ void AvatarMixer::start() {
 
     auto nodeList = DependencyManager::get<NodeList>();
 
+    // collect the per-frame burst of avatar data packets and write it out with as few syscalls as possible
+    nodeList->setSendBatchingEnabled(true);
+
+    // follow avatar data with parity for clients that report loss, bulk packets filled right up to the MTU are left out
+    nodeList->setForwardErrorCorrectionTypes({ PacketType::BulkAvatarData });
+
     unsigned int frame = 1;
     auto frameTimestamp = p_high_resolution_clock::now();
 
@@ -333,10 +339,12 @@ void AvatarMixer::start() {
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 auto start = usecTimestampNow();
+                _slaveSharedData.avatarGrid.rebuild(cbegin, cend, frame);
                 _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio);
                 auto end = usecTimestampNow();
                 _broadcastAvatarDataInner += (end - start);
             }, &lockWait, &nodeTransform, &functor);
+            nodeList->flushSendBatch();
             auto end = usecTimestampNow();
             _broadcastAvatarDataElapsedTime += (end - start);
 
@@ -366,6 +374,9 @@ void AvatarMixer::start() {
         _lastFrameTimestamp = frameTimestamp;
 
     }
+
+    // write out whatever the last frame left in the batch, anything sent from here on goes out directly
+    nodeList->setSendBatchingEnabled(false);
 }
 
 
@@ -436,6 +447,11 @@ void AvatarMixer::manageIdentityData(const SharedNodePointer& node) {
         sendIdentityPacket(nodeData, node);
         avatar.setNeedsIdentityUpdate(false);
     }
+
+    // serialize the identity once here for every viewer the slaves send it to this frame
+    if (nodeData->needsIdentityPacketDataUpdate()) {
+        nodeData->updateIdentityPacketData();
+    }
 }
 
 void AvatarMixer::throttle(std::chrono::microseconds duration, int frame) {
@@ -638,6 +654,7 @@ void AvatarMixer::handleRequestsDomainListDataPacket(QSharedPointer<ReceivedMess
                     // so that the AvatarMixer will send Identity data to us
                     [&](const SharedNodePointer& node) {
                         nodeData->setLastBroadcastTime(node->getLocalID(), 0);
+                        nodeData->resetSentIdentityVersion(node->getLocalID());
                         nodeData->resetSentTraitData(node->getLocalID());
                 }
                 );
@@ -705,6 +722,7 @@ void AvatarMixer::handleNodeIgnoreRequestPacket(QSharedPointer<ReceivedMessage>
                 // so the AvatarMixer knows it'll have to send identity data about the ignored avatar
                 // to the ignorer if the ignorer unignores.
                 nodeData->setLastBroadcastTime(ignoredNode->getLocalID(), 0);
+                nodeData->resetSentIdentityVersion(ignoredNode->getLocalID());
                 nodeData->resetSentTraitData(ignoredNode->getLocalID());
             }
 
@@ -715,6 +733,7 @@ void AvatarMixer::handleNodeIgnoreRequestPacket(QSharedPointer<ReceivedMessage>
             AvatarMixerClientData* ignoredNodeData = reinterpret_cast<AvatarMixerClientData*>(ignoredNode->getLinkedData());
             if (ignoredNodeData) {
                 ignoredNodeData->setLastBroadcastTime(senderNode->getLocalID(), 0);
+                ignoredNodeData->resetSentIdentityVersion(senderNode->getLocalID());
                 ignoredNodeData->resetSentTraitData(senderNode->getLocalID());
             }
         }
@@ -764,6 +783,9 @@ void AvatarMixer::sendStatsPacket() {
     statsObject["threads"] = _slavePool.numThreads();
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
+    statsObject["send_batching"] = DependencyManager::get<NodeList>()->sampleSendBatchStats().toJson();
+    statsObject["packet_buffer_pool"] = udt::PacketBufferPool::getStats().toJson();
+    statsObject["packet_dispatch"] = DependencyManager::get<NodeList>()->getPacketReceiver().sampleDispatchStats();
 
 #ifdef DEBUG_EVENT_QUEUE
     QJsonObject qtStats;
@@ -847,6 +869,9 @@ void AvatarMixer::sendStatsPacket() {
     slavesAggregatObject["sent_5_averageTraitsBytes"] = TIGHT_LOOP_STAT(aggregateStats.numTraitsBytesSent);
     slavesAggregatObject["sent_6_averageIdentityBytes"] = TIGHT_LOOP_STAT(aggregateStats.numIdentityBytesSent);
     slavesAggregatObject["sent_7_averageHeroAvatars"] = TIGHT_LOOP_STAT(aggregateStats.numHeroesIncluded);
+    slavesAggregatObject["sent_8_averageCachedEncodings"] = TIGHT_LOOP_STAT(aggregateStats.numCachedEncodingsSent);
+    slavesAggregatObject["sent_9_averageDeferredTraits"] = TIGHT_LOOP_STAT(aggregateStats.numDeferredTraits);
+    slavesAggregatObject["sent_10_averageThrottledBroadcasts"] = TIGHT_LOOP_STAT(aggregateStats.numThrottledBroadcasts);
 
     slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
@@ -1156,6 +1181,9 @@ void AvatarMixer::entityChange() {
 }
 
 void AvatarMixer::aboutToFinish() {
+    // kill and disconnect packets sent while shutting down must not wait for a batch flush that won't come
+    DependencyManager::get<NodeList>()->setSendBatchingEnabled(false);
+
     DependencyManager::destroy<ResourceManager>();
     DependencyManager::destroy<ResourceCacheSharedItems>();
     DependencyManager::destroy<ModelCache>();
@@ -253,6 +253,9 @@ void AvatarMixerClientData::processSetTraitsMessage(ReceivedMessage& message,
                 if (packetTraitVersion > instanceVersionRef) {
                     if (traitSize == AvatarTraits::DELETED_TRAIT_SIZE) {
                         _avatar->processDeletedTraitInstance(traitType, instanceID);
+                        if (traitType == AvatarTraits::AvatarEntity) {
+                            _avatarEntityRevisions.erase(instanceID);
+                        }
                         // Mixer doesn't need deleted IDs.
                         _avatar->getAndClearRecentlyRemovedIDs();
 
@@ -265,6 +268,9 @@ void AvatarMixerClientData::processSetTraitsMessage(ReceivedMessage& message,
                         auto trait = message.read(traitSize);
                         if (sendingNode.getCanRezAvatarEntities()) {
                             _avatar->processTraitInstance(traitType, instanceID, trait);
+                            if (traitType == AvatarTraits::AvatarEntity) {
+                                recordAvatarEntity(instanceID, packetTraitVersion, trait, false);
+                            }
                         }
                         
                         instanceVersionRef = packetTraitVersion;
@@ -274,6 +280,27 @@ void AvatarMixerClientData::processSetTraitsMessage(ReceivedMessage& message,
                 } else {
                     message.seek(message.getPosition() + traitSize);
                 }
+            } else if (traitType == AvatarTraits::AvatarEntityDelta) {
+                auto& instanceVersionRef = _lastReceivedTraitVersions.getInstanceValueRef(AvatarTraits::AvatarEntity,
+                                                                                          instanceID);
+                if (packetTraitVersion > instanceVersionRef && traitSize > 0) {
+                    auto delta = message.read(traitSize);
+                    QByteArray trait;
+                    auto revisionsIt = _avatarEntityRevisions.find(instanceID);
+                    // the delta is to the last version received, which is only kept if it was accepted
+                    if (revisionsIt != _avatarEntityRevisions.end() && !revisionsIt->second.empty() &&
+                        revisionsIt->second.back().version == instanceVersionRef &&
+                        AvatarTraits::getAvatarEntityDeltaBase(delta) == instanceVersionRef &&
+                        AvatarTraits::patchAvatarEntityData(revisionsIt->second.back().data, delta, trait)) {
+                        _avatar->processTraitInstance(AvatarTraits::AvatarEntity, instanceID, trait);
+                        recordAvatarEntity(instanceID, packetTraitVersion, trait, true);
+
+                        instanceVersionRef = packetTraitVersion;
+                        anyTraitsChanged = true;
+                    }
+                } else if (traitSize > 0) {
+                    message.seek(message.getPosition() + traitSize);
+                }
             } else {
                 qWarning() << "Refusing to process traits packet with instanced trait of unprocessable type from"
                            << message.getSenderSockAddr();
@@ -296,6 +323,7 @@ void AvatarMixerClientData::emulateDeleteEntitiesTraitsMessage(const QList<QUuid
         auto& instanceVersionRef = _lastReceivedTraitVersions.getInstanceValueRef(traitType, entityID);
 
         _avatar->processDeletedTraitInstance(traitType, entityID);
+        _avatarEntityRevisions.erase(entityID);
         // Mixer doesn't need deleted IDs.
         _avatar->getAndClearRecentlyRemovedIDs();
 
@@ -310,6 +338,40 @@ void AvatarMixerClientData::emulateDeleteEntitiesTraitsMessage(const QList<QUuid
     _lastReceivedTraitsChange = std::chrono::steady_clock::now();
 }
 
+void AvatarMixerClientData::recordAvatarEntity(AvatarTraits::TraitInstanceID instanceID,
+                                               AvatarTraits::TraitVersion traitVersion, const QByteArray& data,
+                                               bool isDelta) {
+    const size_t MAX_AVATAR_ENTITY_REVISIONS = 4;
+
+    auto& revisions = _avatarEntityRevisions[instanceID];
+    if (!isDelta) {
+        // the sender sends the whole data when it changes too much for a delta, or when a peer may have missed one, so the
+        // listeners are sent the whole data too
+        revisions.clear();
+    } else if (revisions.size() >= MAX_AVATAR_ENTITY_REVISIONS) {
+        revisions.pop_front();
+    }
+    revisions.push_back({ traitVersion, data });
+}
+
+QByteArray AvatarMixerClientData::diffAvatarEntity(AvatarTraits::TraitInstanceID instanceID,
+                                                   AvatarTraits::TraitVersion fromVersion,
+                                                   AvatarTraits::TraitVersion toVersion) const {
+    auto revisionsIt = _avatarEntityRevisions.find(instanceID);
+    if (revisionsIt == _avatarEntityRevisions.end() || revisionsIt->second.empty() ||
+        revisionsIt->second.back().version != toVersion) {
+        return QByteArray();
+    }
+
+    const auto& revisions = revisionsIt->second;
+    auto fromIt = std::find_if(revisions.begin(), revisions.end(),
+                               [fromVersion](const AvatarEntityRevision& revision) { return revision.version == fromVersion; });
+    if (fromIt == revisions.end() || fromIt->version == toVersion) {
+        return QByteArray();
+    }
+    return AvatarTraits::diffAvatarEntityData(fromVersion, fromIt->data, revisions.back().data);
+}
+
 void AvatarMixerClientData::processBulkAvatarTraitsAckMessage(ReceivedMessage& message) {
     // Avatar Traits flow control marks each outgoing avatar traits packet with a
     // sequence number. The mixer caches the traits sent in the traits packet.
@@ -419,6 +481,29 @@ uint64_t AvatarMixerClientData::getLastBroadcastTime(NLPacket::LocalID nodeUUID)
     return 0;
 }
 
+uint32_t AvatarMixerClientData::getSentIdentityVersion(NLPacket::LocalID nodeID) const {
+    auto nodeMatch = _sentIdentityVersions.find(nodeID);
+    if (nodeMatch != _sentIdentityVersions.end()) {
+        return nodeMatch->second;
+    }
+    return 0;
+}
+
+void AvatarMixerClientData::updateIdentityPacketData() {
+    _identityPacketData = getAvatar().identityByteArray();
+    _identityPacketData.replace(0, NUM_BYTES_RFC4122_UUID, getNodeID().toRfc4122());
+    _identityPacketDataTimestamp = usecTimestampNow();
+
+    // the sequence number after the session UUID is left out of the hash, a bare bump is not a change for receivers
+    const int HASHED_OFFSET = NUM_BYTES_RFC4122_UUID + sizeof(udt::SequenceNumber::Type);
+    uint hash = qHash(QByteArray::fromRawData(_identityPacketData.constData() + HASHED_OFFSET,
+                                              std::max(_identityPacketData.size() - HASHED_OFFSET, 0)));
+    if (_identityVersion == 0 || hash != _identityHash) {
+        _identityHash = hash;
+        ++_identityVersion;
+    }
+}
+
 uint16_t AvatarMixerClientData::getLastBroadcastSequenceNumber(NLPacket::LocalID nodeID) const {
     // return the matching PacketSequenceNumber, or the default if we don't have it
     auto nodeMatch = _lastBroadcastSequenceNumbers.find(nodeID);
@@ -443,6 +528,7 @@ void AvatarMixerClientData::ignoreOther(const Node* self, const Node* other) {
             killPacket->writePrimitive(KillAvatarReason::YourAvatarEnteredTheirBubble);
         }
         setLastBroadcastTime(other->getLocalID(), 0);
+        resetSentIdentityVersion(other->getLocalID());
 
         resetSentTraitData(other->getLocalID());
 
@@ -491,6 +577,40 @@ void AvatarMixerClientData::readViewFrustumPacket(const QByteArray& message) {
 
         _currentViewFrustums.push_back(frustum);
     }
+
+    // the rate limits follow the frustums
+    auto sourceEnd = reinterpret_cast<const unsigned char*>(message.constData()) + message.size();
+    if (sourceEnd - sourceBuffer >= (ptrdiff_t)(sizeof(uint8_t) + sizeof(uint16_t))) {
+        uint8_t maxUpdateRate = 0;
+        memcpy(&maxUpdateRate, sourceBuffer, sizeof(maxUpdateRate));
+        sourceBuffer += sizeof(maxUpdateRate);
+
+        uint16_t maxReceiveKbps = 0;
+        memcpy(&maxReceiveKbps, sourceBuffer, sizeof(maxReceiveKbps));
+        sourceBuffer += sizeof(maxReceiveKbps);
+
+        _maxUpdateRate = maxUpdateRate;
+        _maxReceiveKbps = (float)maxReceiveKbps;
+    }
+}
+
+int AvatarMixerClientData::getFramesPerBroadcast(int mixerFramesPerSecond) const {
+    // don't let a stalled viewer's last report starve it of avatar updates
+    const int MIN_UPDATE_RATE = 10;
+
+    if (_maxUpdateRate <= 0 || _maxUpdateRate >= mixerFramesPerSecond) {
+        return 1;
+    }
+    int updateRate = std::max(_maxUpdateRate, MIN_UPDATE_RATE);
+    return (mixerFramesPerSecond + updateRate - 1) / updateRate;
+}
+
+bool AvatarMixerClientData::isBroadcastFrame(int framesPerBroadcast) {
+    if (++_framesSinceBroadcast < framesPerBroadcast) {
+        return false;
+    }
+    _framesSinceBroadcast = 0;
+    return true;
 }
 
 bool AvatarMixerClientData::otherAvatarInView(const AABox& otherAvatarBox) {
@@ -504,6 +624,8 @@ void AvatarMixerClientData::loadJSONStats(QJsonObject& jsonObject) const {
     jsonObject["avg_other_av_starves_per_second"] = getAvgNumOtherAvatarStarvesPerSecond();
     jsonObject["avg_other_av_skips_per_second"] = getAvgNumOtherAvatarSkipsPerSecond();
     jsonObject["total_num_out_of_order_sends"] = _numOutOfOrderSends;
+    jsonObject["client_max_update_rate"] = _maxUpdateRate;
+    jsonObject["client_max_receive_kbps"] = _maxReceiveKbps;
 
     jsonObject[OUTBOUND_AVATAR_DATA_STATS_KEY] = getOutboundAvatarDataKbps();
     jsonObject[OUTBOUND_AVATAR_TRAITS_STATS_KEY] = getOutboundAvatarTraitsKbps();
@@ -528,6 +650,7 @@ AvatarMixerClientData::TraitsCheckTimestamp AvatarMixerClientData::getLastOtherA
 void AvatarMixerClientData::cleanupKilledNode(const QUuid&, Node::LocalID nodeLocalID) {
     removeLastBroadcastSequenceNumber(nodeLocalID);
     removeLastBroadcastTime(nodeLocalID);
+    resetSentIdentityVersion(nodeLocalID);
     _lastSentTraitsTimestamps.erase(nodeLocalID);
     _perNodeSentTraitVersions.erase(nodeLocalID);
     _perNodeAckedTraitVersions.erase(nodeLocalID);
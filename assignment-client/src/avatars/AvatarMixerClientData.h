@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <deque>
 #include <unordered_map>
 #include <vector>
 #include <queue>
@@ -70,6 +71,18 @@ public:
 
     uint64_t getIdentityChangeTimestamp() const { return _identityChangeTimestamp; }
     void flagIdentityChange() { _identityChangeTimestamp = usecTimestampNow(); }
+
+    // Identity bytes as sent to other nodes, rebuilt on the main thread when the identity changes.
+    // The version only moves when the content hash does, so an identity update that changes nothing
+    // but the sequence number is not re-broadcast.
+    bool needsIdentityPacketDataUpdate() const { return _identityPacketDataTimestamp <= _identityChangeTimestamp; }
+    void updateIdentityPacketData();
+    const QByteArray& getIdentityPacketData() const { return _identityPacketData; }
+    uint32_t getIdentityVersion() const { return _identityVersion; }
+
+    uint32_t getSentIdentityVersion(NLPacket::LocalID nodeID) const;
+    void setSentIdentityVersion(NLPacket::LocalID nodeID, uint32_t version) { _sentIdentityVersions[nodeID] = version; }
+    void resetSentIdentityVersion(NLPacket::LocalID nodeID) { _sentIdentityVersions.erase(nodeID); }
     bool getAvatarSessionDisplayNameMustChange() const { return _avatarSessionDisplayNameMustChange; }
     void setAvatarSessionDisplayNameMustChange(bool set = true) { _avatarSessionDisplayNameMustChange = set; }
 
@@ -110,6 +123,14 @@ public:
 
     void readViewFrustumPacket(const QByteArray& message);
 
+    // The viewer's reported render rate and receive bandwidth cap, zero when it reported none.
+    // A viewer slower than the mixer is broadcast to every few frames with a budget for the frames it gets.
+    int getFramesPerBroadcast(int mixerFramesPerSecond) const;
+    float getMaxReceiveKbps() const { return _maxReceiveKbps; }
+
+    // counts the frames skipped for this viewer, returns true on the frames it is due a broadcast
+    bool isBroadcastFrame(int framesPerBroadcast);
+
     bool otherAvatarInView(const AABox& otherAvatarBox);
 
     void resetInViewStats() { _recentOtherAvatarsInView = _recentOtherAvatarsOutOfView = 0; }
@@ -160,7 +181,15 @@ public:
 
     void resetSentTraitData(Node::LocalID nodeID);
 
+    // The change to an avatar entity from a version a listener has to the given one, or a null QByteArray if either
+    // version is no longer kept or the change is best sent whole
+    QByteArray diffAvatarEntity(AvatarTraits::TraitInstanceID instanceID, AvatarTraits::TraitVersion fromVersion,
+                                AvatarTraits::TraitVersion toVersion) const;
+
 private:
+    void recordAvatarEntity(AvatarTraits::TraitInstanceID instanceID, AvatarTraits::TraitVersion traitVersion,
+                            const QByteArray& data, bool isDelta);
+
     struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
         QWeakPointer<Node> node;
     };
@@ -178,6 +207,11 @@ private:
     std::unordered_map<NLPacket::LocalID, QVector<JointData>> _lastOtherAvatarSentJoints;
 
     uint64_t _identityChangeTimestamp;
+    QByteArray _identityPacketData;
+    uint _identityHash { 0 };
+    uint32_t _identityVersion { 0 };
+    uint64_t _identityPacketDataTimestamp { 0 };
+    std::unordered_map<NLPacket::LocalID, uint32_t> _sentIdentityVersions;
     bool _avatarSessionDisplayNameMustChange{ true };
     bool _avatarSkeletonModelUrlMustChange{ false };
 
@@ -192,6 +226,9 @@ private:
     SimpleMovingAverage _avgOtherAvatarTraitsRate;
     std::vector<QUuid> _radiusIgnoredOthers;
     ConicalViewFrustums _currentViewFrustums;
+    int _maxUpdateRate { 0 };
+    float _maxReceiveKbps { 0.0f };
+    int _framesSinceBroadcast { 0 };
 
     int _recentOtherAvatarsInView { 0 };
     int _recentOtherAvatarsOutOfView { 0 };
@@ -224,6 +261,14 @@ private:
     // prevent sending traits that have already been sent.
     PerNodeTraitVersions _perNodeSentTraitVersions;
 
+    // the last few versions of each avatar entity since it was last received whole, so that the listeners a version or
+    // two behind are sent what changed since
+    struct AvatarEntityRevision {
+        AvatarTraits::TraitVersion version;
+        QByteArray data;
+    };
+    std::unordered_map<AvatarTraits::TraitInstanceID, std::deque<AvatarEntityRevision>> _avatarEntityRevisions;
+
     std::atomic_bool _isIgnoreRadiusEnabled { false };
 };
 
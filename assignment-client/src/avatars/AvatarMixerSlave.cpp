@@ -51,6 +51,10 @@ void AvatarMixerSlave::configureBroadcast(ConstIter begin, ConstIter end,
     _maxKbpsPerNode = maxKbpsPerNode;
     _throttlingRatio = throttlingRatio;
     _avatarHeroFraction = priorityReservedFraction;
+
+    // the avatars may have changed since the last frame
+    _encodingCache.clear();
+    _replicatedEncodingCache.clear();
 }
 
 void AvatarMixerSlave::harvestStats(AvatarMixerSlaveStats& stats) {
@@ -72,8 +76,7 @@ void AvatarMixerSlave::processIncomingPackets(const SharedNodePointer& node) {
 
 int AvatarMixerSlave::sendIdentityPacket(NLPacketList& packetList, const AvatarMixerClientData* nodeData, const Node& destinationNode) {
     if (destinationNode.getType() == NodeType::Agent && !destinationNode.isUpstream()) {
-        QByteArray individualData = nodeData->getConstAvatarData()->identityByteArray();
-        individualData.replace(0, NUM_BYTES_RFC4122_UUID, nodeData->getNodeID().toRfc4122()); // FIXME, this looks suspicious
+        const QByteArray& individualData = nodeData->getIdentityPacketData();
         packetList.write(individualData);
         _stats.numIdentityPacketsSent++;
         _stats.numIdentityBytesSent += individualData.size();
@@ -197,8 +200,19 @@ qint64 AvatarMixerSlave::addChangedTraitsToBulkPacket(AvatarMixerClientData* lis
                     bytesWritten += addTraitsNodeHeader(listeningNodeData, sendingNodeData, traitsPacketList, bytesWritten);
 
                     // this instance version exists and has never been sent or is newer so we need to send it
-                    bytesWritten += AvatarTraits::packVersionedTraitInstance(traitType, instanceID, traitsPacketList,
-                                                                             receivedVersion, *sendingAvatar);
+                    // an avatar entity the listener has a recent version of is sent as what changed since, which keeps
+                    // entities that move often, like held ones, to a small share of the budget
+                    QByteArray delta;
+                    if (traitType == AvatarTraits::AvatarEntity && sentInstanceIt != sentIDValuePairs.end()) {
+                        delta = sendingNodeData->diffAvatarEntity(instanceID, sentInstanceIt->value, receivedVersion);
+                    }
+                    if (!delta.isNull()) {
+                        bytesWritten += AvatarTraits::packVersionedTraitInstance(AvatarTraits::AvatarEntityDelta, instanceID,
+                                                                                 traitsPacketList, receivedVersion, delta);
+                    } else {
+                        bytesWritten += AvatarTraits::packVersionedTraitInstance(traitType, instanceID, traitsPacketList,
+                                                                                 receivedVersion, *sendingAvatar);
+                    }
 
                     if (sentInstanceIt != sentIDValuePairs.end()) {
                         sentInstanceIt->value = receivedVersion;
@@ -321,10 +335,17 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     std::mt19937 generator(randomDevice());
     std::uniform_real_distribution<float> distribution;
 
-    _stats.nodesBroadcastedTo++;
-
     AvatarMixerClientData* destinationNodeData = reinterpret_cast<AvatarMixerClientData*>(destinationNode->getLinkedData());
 
+    // viewers that render slower than the mixer runs are only sent every few frames
+    const int framesPerBroadcast = destinationNodeData->getFramesPerBroadcast(AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
+    if (!destinationNodeData->isBroadcastFrame(framesPerBroadcast)) {
+        _stats.numThrottledBroadcasts++;
+        return;
+    }
+
+    _stats.nodesBroadcastedTo++;
+
     destinationNodeData->resetInViewStats();
 
     const AvatarData& avatar = destinationNodeData->getAvatar();
@@ -344,10 +365,18 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     int identityBytesSent = 0;
     int traitBytesSent = 0;
 
-    // max number of avatarBytes per frame (13 900, typical)
-    const int maxAvatarBytesPerFrame = int(_maxKbpsPerNode * BYTES_PER_KILOBIT / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
+    // max number of avatarBytes per frame (13 900, typical), over the frames this viewer is actually sent
+    float maxKbps = _maxKbpsPerNode;
+    if (destinationNodeData->getMaxReceiveKbps() > 0.0f) {
+        maxKbps = std::min(maxKbps, destinationNodeData->getMaxReceiveKbps());
+    }
+    const int maxAvatarBytesPerFrame = int(maxKbps * BYTES_PER_KILOBIT * framesPerBroadcast / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
     const int maxHeroBytesPerFrame = int(maxAvatarBytesPerFrame * _avatarHeroFraction);  // 5555, typical
 
+    // traits for the avatars past this budget wait for a later frame, so a crowd arriving at once
+    // has its skeletons and avatar entities spread over several frames instead of one burst
+    const int maxTraitBytesPerFrame = maxAvatarBytesPerFrame;
+
     // keep track of the number of other avatars held back in this frame
     int numAvatarsHeldBack = 0;
 
@@ -384,10 +413,21 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge}
     };
 
-    avatarPriorityQueues[kNonhero].reserve(_end - _begin);
+    // In a crowded domain, consider the avatars around this viewer every frame and the far ones in turns.
+    // Everyone is considered while the PAL is open, and on the frame it closes so that kills go out.
+    _candidates.clear();
+    const AvatarSpatialGrid& avatarGrid = _sharedData->avatarGrid;
+    if (avatarGrid.isEnabled() && !PALIsOpen && !PALWasOpen) {
+        avatarGrid.getCandidates(destinationPosition, numToSendEst, _candidates);
+    } else {
+        for (auto listedNode = _begin; listedNode != _end; ++listedNode) {
+            _candidates.push_back((*listedNode).data());
+        }
+    }
 
-    for (auto listedNode = _begin; listedNode != _end; ++listedNode) {
-        Node* otherNodeRaw = (*listedNode).data();
+    avatarPriorityQueues[kNonhero].reserve(_candidates.size());
+
+    for (Node* otherNodeRaw : _candidates) {
         if (otherNodeRaw->getType() != NodeType::Agent
             || !otherNodeRaw->getLinkedData()
             || otherNodeRaw == destinationNode) {
@@ -518,8 +558,14 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
     // Loop over two priorities - hero avatars then everyone else:
     for (PriorityVariants currentVariant = kHero; currentVariant <= kNonhero; ++((int&)currentVariant)) {
-        const auto& sortedAvatarVector = avatarPriorityQueues[currentVariant].getSortedVector(numToSendEst);
-        for (const auto& sortedAvatar : sortedAvatarVector) {
+        auto& avatarPriorityQueue = avatarPriorityQueues[currentVariant];
+        const auto& sortedAvatarVector = avatarPriorityQueue.getSortedVector(numToSendEst);
+        for (size_t sortedIndex = 0; sortedIndex < sortedAvatarVector.size(); ++sortedIndex) {
+            if (sortedIndex == avatarPriorityQueue.getNumSorted()) {
+                // still within budget past the estimate, order the next batch
+                avatarPriorityQueue.sortNextBatch(numToSendEst);
+            }
+            const auto& sortedAvatar = sortedAvatarVector[sortedIndex];
             const Node* sourceNode = sortedAvatar.getNode();
             auto lastEncodeForOther = sortedAvatar.getTimestamp();
 
@@ -562,13 +608,14 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
                 detail = distribution(generator) < AVATAR_SEND_FULL_UPDATE_RATIO ? AvatarData::SendAllData : AvatarData::CullSmallData;
                 destinationNodeData->incrementAvatarInView();
 
-                // If the time that the mixer sent AVATAR DATA about Avatar B to Node A is BEFORE OR EQUAL TO
-                // the time that Avatar B flagged an IDENTITY DATA change, send IDENTITY DATA about Avatar B to Node A.
-                if (sourceAvatar->hasProcessedFirstIdentity()
-                    && destinationNodeData->getLastBroadcastTime(sourceNode->getLocalID()) <= sourceNodeData->getIdentityChangeTimestamp()) {
+                // If Node A has not been sent the current version of Avatar B's IDENTITY DATA, send it.
+                uint32_t identityVersion = sourceNodeData->getIdentityVersion();
+                if (sourceAvatar->hasProcessedFirstIdentity() && identityVersion != 0
+                    && destinationNodeData->getSentIdentityVersion(sourceNode->getLocalID()) != identityVersion) {
                     identityBytesSent += sendIdentityPacket(*identityPacketList, sourceNodeData, *destinationNode);
 
-                    // remember the last time we sent identity details about this other node to the receiver
+                    // remember which version of the identity details about this other node the receiver has
+                    destinationNodeData->setSentIdentityVersion(sourceNode->getLocalID(), identityVersion);
                     destinationNodeData->setLastBroadcastTime(sourceNode->getLocalID(), usecTimestampNow());
                 }
             }
@@ -580,26 +627,71 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             AvatarDataPacket::SendStatus sendStatus;
             sendStatus.sendUUID = true;
 
-            do {
-                auto startSerialize = chrono::high_resolution_clock::now();
-                QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
-                    sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
-                    &lastSentJointsForOther, avatarSpaceAvailable);
-                auto endSerialize = chrono::high_resolution_clock::now();
-                _stats.toByteArrayElapsedTime +=
-                    (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
-
-                avatarPacket->write(bytes);
-                avatarSpaceAvailable -= bytes.size();
-                numAvatarDataBytes += bytes.size();
-                if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
-                    // Weren't able to fit everything.
-                    nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
-                    ++numPacketsSent;
-                    avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
-                    avatarSpaceAvailable = avatarPacketCapacity;
+            // MinimumData and PALMinimum carry no joint deltas, so every viewer that has missed the same changes
+            // gets the same bytes: encode those once per frame and copy them into each viewer's packet
+            bool sentFromCache = false;
+            if (detail == AvatarData::MinimumData || detail == AvatarData::PALMinimum) {
+                AvatarDataPacket::HasFlags changedFlags =
+                    (detail == AvatarData::MinimumData) ? sourceAvatar->getChangedSinceFlags(lastEncodeForOther) : 0;
+                uint64_t cacheKey = ((uint64_t)sourceNode->getLocalID() << 32) | ((uint64_t)detail << 16) | changedFlags;
+
+                auto cached = _encodingCache.find(cacheKey);
+                if (cached == _encodingCache.end()) {
+                    auto startSerialize = chrono::high_resolution_clock::now();
+                    AvatarDataPacket::SendStatus cacheSendStatus;
+                    cacheSendStatus.sendUUID = true;
+                    QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
+                        cacheSendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
+                        nullptr, avatarPacketCapacity);
+                    auto endSerialize = chrono::high_resolution_clock::now();
+                    _stats.toByteArrayElapsedTime +=
+                        (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
+
+                    if (!cacheSendStatus) {
+                        // didn't fit in an empty packet, leave it to the split encoding below
+                        bytes.clear();
+                    }
+                    cached = _encodingCache.emplace(cacheKey, bytes).first;
                 }
-            } while (!sendStatus);
+
+                const QByteArray& bytes = cached->second;
+                if (!bytes.isEmpty() && bytes.size() <= avatarSpaceAvailable) {
+                    avatarPacket->write(bytes);
+                    avatarSpaceAvailable -= bytes.size();
+                    numAvatarDataBytes += bytes.size();
+                    _stats.numCachedEncodingsSent++;
+                    sentFromCache = true;
+                    if (avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
+                        nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+                        ++numPacketsSent;
+                        avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+                        avatarSpaceAvailable = avatarPacketCapacity;
+                    }
+                }
+            }
+
+            if (!sentFromCache) {
+                do {
+                    auto startSerialize = chrono::high_resolution_clock::now();
+                    QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
+                        sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
+                        &lastSentJointsForOther, avatarSpaceAvailable);
+                    auto endSerialize = chrono::high_resolution_clock::now();
+                    _stats.toByteArrayElapsedTime +=
+                        (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
+
+                    avatarPacket->write(bytes);
+                    avatarSpaceAvailable -= bytes.size();
+                    numAvatarDataBytes += bytes.size();
+                    if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
+                        // Weren't able to fit everything.
+                        nodeList->sendPacket(std::move(avatarPacket), *destinationNode);
+                        ++numPacketsSent;
+                        avatarPacket = NLPacket::create(PacketType::BulkAvatarData);
+                        avatarSpaceAvailable = avatarPacketCapacity;
+                    }
+                } while (!sendStatus);
+            }
 
             if (detail != AvatarData::NoData) {
                 _stats.numOthersIncluded++;
@@ -621,8 +713,14 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
                 (quint64)chrono::duration_cast<chrono::microseconds>(endAvatarDataPacking - startAvatarDataPacking).count();
 
             if (!overBudget) {
-                // use helper to add any changed traits to our packet list
-                traitBytesSent += addChangedTraitsToBulkPacket(destinationNodeData, sourceNodeData, *traitsPacketList);
+                if (traitBytesSent < maxTraitBytesPerFrame) {
+                    // use helper to add any changed traits to our packet list
+                    traitBytesSent += addChangedTraitsToBulkPacket(destinationNodeData, sourceNodeData, *traitsPacketList);
+                } else if (sourceNodeData->getLastReceivedTraitsChange() >
+                           destinationNodeData->getLastOtherAvatarTraitsSendPoint(sourceNode->getLocalID())) {
+                    // nothing was written for this avatar, so its traits are still pending next frame
+                    _stats.numDeferredTraits++;
+                }
             }
             numAvatarsSent++;
             remainingAvatars--;
@@ -712,24 +810,10 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
             // we cannot send a downstream avatar mixer any updates that expect them to have previous state for this avatar
             // since we have no idea if they're online and receiving our packets
 
-            // so we always send a full update for this avatar
+            // so we always send a full update for this avatar, which is the same for every downstream mixer:
+            // encode it once per frame and replicate those bytes to each of them
             
             quint64 start = usecTimestampNow();
-            AvatarDataPacket::SendStatus sendStatus;
-
-            QVector<JointData> emptyLastJointSendData { otherAvatar->getJointCount() };
-
-            QByteArray avatarByteArray = otherAvatar->toByteArray(AvatarData::SendAllData, 0, emptyLastJointSendData,
-                sendStatus, false, false, glm::vec3(0), nullptr, 0);
-            quint64 end = usecTimestampNow();
-            _stats.toByteArrayElapsedTime += (end - start);
-
-            auto lastBroadcastTime = nodeData->getLastBroadcastTime(agentNode->getLocalID());
-            if (lastBroadcastTime <= agentNodeData->getIdentityChangeTimestamp()
-                || (start - lastBroadcastTime) >= REBROADCAST_IDENTITY_TO_DOWNSTREAM_EVERY_US) {
-                sendReplicatedIdentityPacket(*agentNode, agentNodeData, *node);
-                nodeData->setLastBroadcastTime(agentNode->getLocalID(), start);
-            }
 
             // figure out how large our avatar byte array can be to fit in the packet list
             // given that we need it and the avatar UUID and the size of the byte array (16 bit)
@@ -741,20 +825,43 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
             auto sequenceNumberSize = sizeof(agentNodeData->getLastReceivedSequenceNumber());
             maxAvatarByteArraySize -= sequenceNumberSize;
 
-            if (avatarByteArray.size() > maxAvatarByteArraySize) {
-                qCWarning(avatars) << "Replicated avatar data too large for" << otherAvatar->getSessionUUID()
-                    << "-" << avatarByteArray.size() << "bytes";
+            auto cachedByteArray = _replicatedEncodingCache.find(agentNode->getLocalID());
+            if (cachedByteArray == _replicatedEncodingCache.end()) {
+                AvatarDataPacket::SendStatus sendStatus;
+
+                QVector<JointData> emptyLastJointSendData { otherAvatar->getJointCount() };
 
-                avatarByteArray = otherAvatar->toByteArray(AvatarData::SendAllData, 0, emptyLastJointSendData,
-                    sendStatus, true, false, glm::vec3(0), nullptr, 0);
+                QByteArray avatarByteArray = otherAvatar->toByteArray(AvatarData::SendAllData, 0, emptyLastJointSendData,
+                    sendStatus, false, false, glm::vec3(0), nullptr, 0);
 
                 if (avatarByteArray.size() > maxAvatarByteArraySize) {
-                    qCWarning(avatars) << "Replicated avatar data without facial data still too large for"
-                        << otherAvatar->getSessionUUID() << "-" << avatarByteArray.size() << "bytes";
+                    qCWarning(avatars) << "Replicated avatar data too large for" << otherAvatar->getSessionUUID()
+                        << "-" << avatarByteArray.size() << "bytes";
 
-                    avatarByteArray = otherAvatar->toByteArray(AvatarData::MinimumData, 0, emptyLastJointSendData,
+                    avatarByteArray = otherAvatar->toByteArray(AvatarData::SendAllData, 0, emptyLastJointSendData,
                         sendStatus, true, false, glm::vec3(0), nullptr, 0);
+
+                    if (avatarByteArray.size() > maxAvatarByteArraySize) {
+                        qCWarning(avatars) << "Replicated avatar data without facial data still too large for"
+                            << otherAvatar->getSessionUUID() << "-" << avatarByteArray.size() << "bytes";
+
+                        avatarByteArray = otherAvatar->toByteArray(AvatarData::MinimumData, 0, emptyLastJointSendData,
+                            sendStatus, true, false, glm::vec3(0), nullptr, 0);
+                    }
                 }
+
+                quint64 end = usecTimestampNow();
+                _stats.toByteArrayElapsedTime += (end - start);
+
+                cachedByteArray = _replicatedEncodingCache.emplace(agentNode->getLocalID(), avatarByteArray).first;
+            }
+            const QByteArray& avatarByteArray = cachedByteArray->second;
+
+            auto lastBroadcastTime = nodeData->getLastBroadcastTime(agentNode->getLocalID());
+            if (lastBroadcastTime <= agentNodeData->getIdentityChangeTimestamp()
+                || (start - lastBroadcastTime) >= REBROADCAST_IDENTITY_TO_DOWNSTREAM_EVERY_US) {
+                sendReplicatedIdentityPacket(*agentNode, agentNodeData, *node);
+                nodeData->setLastBroadcastTime(agentNode->getLocalID(), start);
             }
 
             if (avatarByteArray.size() <= maxAvatarByteArraySize) {
@@ -12,8 +12,12 @@
 #ifndef hifi_AvatarMixerSlave_h
 #define hifi_AvatarMixerSlave_h
 
+#include <unordered_map>
+
 #include <NodeList.h>
 
+#include "AvatarSpatialGrid.h"
+
 class AvatarMixerClientData;
 
 class AvatarMixerSlaveStats {
@@ -33,6 +37,9 @@ public:
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
     int numHeroesIncluded { 0 };
+    int numCachedEncodingsSent { 0 };
+    int numDeferredTraits { 0 };
+    int numThrottledBroadcasts { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
@@ -59,6 +66,9 @@ public:
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
         numHeroesIncluded = 0;
+        numCachedEncodingsSent = 0;
+        numDeferredTraits = 0;
+        numThrottledBroadcasts = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
@@ -83,6 +93,9 @@ public:
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
         numHeroesIncluded += rhs.numHeroesIncluded;
+        numCachedEncodingsSent += rhs.numCachedEncodingsSent;
+        numDeferredTraits += rhs.numDeferredTraits;
+        numThrottledBroadcasts += rhs.numThrottledBroadcasts;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
@@ -100,6 +113,7 @@ struct SlaveSharedData {
     QStringList skeletonURLWhitelist;
     QUrl skeletonReplacementURL;
     EntityTreePointer entityTree;
+    AvatarSpatialGrid avatarGrid;
 };
 
 class AvatarMixerSlave {
@@ -143,6 +157,15 @@ private:
     float _throttlingRatio { 0.0f };
     float _avatarHeroFraction { 0.4f };
 
+    // viewer-independent avatar encodings made this frame, keyed by source, detail and changed sections
+    std::unordered_map<uint64_t, QByteArray> _encodingCache;
+
+    // full avatar encodings replicated to downstream mixers this frame, keyed by source
+    std::unordered_map<Node::LocalID, QByteArray> _replicatedEncodingCache;
+
+    // avatars considered by the viewer being broadcast to
+    std::vector<Node*> _candidates;
+
     AvatarMixerSlaveStats _stats;
     SlaveSharedData* _sharedData;
 };
@@ -0,0 +1,80 @@
+//
+//  AvatarSpatialGrid.cpp
+//  assignment-client/src/avatars
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AvatarSpatialGrid.h"
+
+#include <algorithm>
+
+#include "AvatarMixerClientData.h"
+
+static const float CELL_SIZE = 16.0f; // meters
+static const int MAX_NEAR_RINGS = 8;
+
+AvatarSpatialGrid::Cell AvatarSpatialGrid::cellFor(const glm::vec3& position) {
+    return { (int)glm::floor(position.x / CELL_SIZE), (int)glm::floor(position.z / CELL_SIZE) };
+}
+
+void AvatarSpatialGrid::rebuild(ConstIter begin, ConstIter end, unsigned int frame) {
+    _cells.clear();
+    for (auto& staggered : _staggered) {
+        staggered.clear();
+    }
+    _frame = frame;
+    _numAvatars = 0;
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        if (node->getType() != NodeType::Agent || !node->getLinkedData()) {
+            return;
+        }
+        auto nodeData = reinterpret_cast<const AvatarMixerClientData*>(node->getLinkedData());
+        Cell cell = cellFor(nodeData->getAvatar().getClientGlobalPosition());
+
+        _cells[cell].push_back(node.data());
+        _staggered[node->getLocalID() % FAR_AVATAR_UPDATE_INTERVAL].push_back({ node.data(), cell });
+        ++_numAvatars;
+    });
+}
+
+void AvatarSpatialGrid::getCandidates(const glm::vec3& position, int minNearAvatars, std::vector<Node*>& candidates) const {
+    Cell center = cellFor(position);
+    int numNear = 0;
+
+    auto addCell = [&](int x, int z) {
+        auto cell = _cells.find({ x, z });
+        if (cell != _cells.end()) {
+            candidates.insert(candidates.end(), cell->second.begin(), cell->second.end());
+            numNear += (int)cell->second.size();
+        }
+    };
+
+    // walk the square rings outward until the viewer has enough nearby avatars to spend its budget on
+    int ring = 0;
+    addCell(center.x, center.z);
+    while (numNear < minNearAvatars && ring < MAX_NEAR_RINGS) {
+        ++ring;
+        for (int i = -ring; i <= ring; ++i) {
+            addCell(center.x + i, center.z - ring);
+            addCell(center.x + i, center.z + ring);
+        }
+        for (int i = -ring + 1; i <= ring - 1; ++i) {
+            addCell(center.x - ring, center.z + i);
+            addCell(center.x + ring, center.z + i);
+        }
+    }
+
+    // then the slice of the far avatars whose turn it is
+    for (const auto& avatar : _staggered[_frame % FAR_AVATAR_UPDATE_INTERVAL]) {
+        int distance = std::max(std::abs(avatar.cell.x - center.x), std::abs(avatar.cell.z - center.z));
+        if (distance > ring) {
+            candidates.push_back(avatar.node);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+//
+//  AvatarSpatialGrid.h
+//  assignment-client/src/avatars
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_AvatarSpatialGrid_h
+#define overte_AvatarSpatialGrid_h
+
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <NodeList.h>
+
+// Uniform horizontal grid of the agent avatars, rebuilt once per broadcast frame.
+//
+// A viewer takes the avatars in the rings of cells around its own position until it has enough of them to fill
+// its budget, and only a rotating slice of the avatars beyond those rings each frame. Far avatars are then sent
+// every FAR_AVATAR_UPDATE_INTERVAL frames rather than every frame, where they would mostly be dropped for budget.
+class AvatarSpatialGrid {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    static const int FAR_AVATAR_UPDATE_INTERVAL = 4;
+
+    // below this many agents every viewer considers every avatar, every frame
+    static const int MIN_AGENTS_FOR_GRID = 64;
+
+    void rebuild(ConstIter begin, ConstIter end, unsigned int frame);
+
+    bool isEnabled() const { return _numAvatars >= MIN_AGENTS_FOR_GRID; }
+
+    // Appends the avatars in the rings around position, out to at least minNearAvatars avatars,
+    // followed by the far avatars that are due this frame
+    void getCandidates(const glm::vec3& position, int minNearAvatars, std::vector<Node*>& candidates) const;
+
+private:
+    struct Cell {
+        int x;
+        int z;
+        bool operator==(const Cell& other) const { return x == other.x && z == other.z; }
+    };
+    struct CellHash {
+        size_t operator()(const Cell& cell) const { return std::hash<int64_t>()(((int64_t)cell.x << 32) ^ (uint32_t)cell.z); }
+    };
+    struct GridAvatar {
+        Node* node;
+        Cell cell;
+    };
+
+    static Cell cellFor(const glm::vec3& position);
+
+    std::unordered_map<Cell, std::vector<Node*>, CellHash> _cells;
+    std::vector<GridAvatar> _staggered[FAR_AVATAR_UPDATE_INTERVAL];
+    unsigned int _frame { 0 };
+    int _numAvatars { 0 };
+};
+
+#endif // overte_AvatarSpatialGrid_h
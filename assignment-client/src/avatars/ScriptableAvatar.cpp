@@ -57,6 +57,7 @@ void ScriptableAvatar::startAnimation(const QString& url, float fps, float prior
     _animationDetails = AnimationDetails("", QUrl(url), fps, 0, loop, hold, false, firstFrame, lastFrame, true, firstFrame, false);
     _maskedJoints = maskedJoints;
     _isAnimationRigValid = false;
+    _animationJointMapping.clear();
 }
 
 void ScriptableAvatar::stopAnimation() {
@@ -100,6 +101,7 @@ void ScriptableAvatar::setSkeletonModelURL(const QUrl& skeletonModelURL) {
     AvatarData::setSkeletonModelURL(skeletonModelURL);
     updateJointMappings();
     _isRigValid = false;
+    _animationJointMapping.clear();
 }
 
 int ScriptableAvatar::sendAvatarDataPacket(bool sendAll) {
@@ -151,7 +153,7 @@ void ScriptableAvatar::update(float deltatime) {
     Q_ASSERT(QThread::currentThread() == thread());
     if (_animation && _animation->isLoaded()) {
         Q_ASSERT(thread() == _animation->thread());
-        auto frames = _animation->getFramesReference();
+        const auto& frames = _animation->getFramesReference();
         if (frames.size() > 0 && _geometryResource && _geometryResource->isHFMModelLoaded()) {
             if (!_isRigValid) {
                 _rig.reset(_geometryResource->getHFMModel());
@@ -164,6 +166,18 @@ void ScriptableAvatar::update(float deltatime) {
             if (!_avatarAnimSkeleton) {
                 _avatarAnimSkeleton = std::make_shared<AnimSkeleton>(_geometryResource->getHFMModel());
             }
+            if (_animationJointMapping.empty()) {
+                // As long as we need the model preRotations anyway, let's get the jointIndex from the bind skeleton rather than
+                // trusting the .fst (which is sometimes not updated to match changes to .fbx).
+                // The names are only looked up when the animation, its mask or the model change, rather than every frame.
+                const HFMModel& model = _geometryResource->getHFMModel();
+                const QStringList animationJointNames = _animation->getJointNames();
+                _animationJointMapping.resize(animationJointNames.size());
+                for (int i = 0; i < animationJointNames.size(); i++) {
+                    const QString& name = animationJointNames[i];
+                    _animationJointMapping[i] = _maskedJoints.contains(name) ? -1 : model.getJointIndex(name);
+                }
+            }
             float currentFrame = _animationDetails.currentFrame + deltatime * _animationDetails.fps;
             if (_animationDetails.loop || currentFrame < _animationDetails.lastFrame) {
                 while (currentFrame >= _animationDetails.lastFrame) {
@@ -172,7 +186,6 @@ void ScriptableAvatar::update(float deltatime) {
                 _animationDetails.currentFrame = currentFrame;
 
                 const QVector<HFMJoint>& modelJoints = _geometryResource->getHFMModel().joints;
-                QStringList animationJointNames = _animation->getJointNames();
 
                 const int nJoints = modelJoints.size();
                 if (_jointData.size() != nJoints) {
@@ -183,19 +196,17 @@ void ScriptableAvatar::update(float deltatime) {
                 const HFMAnimationFrame& floorFrame = frames.at((int)glm::floor(currentFrame) % frameCount);
                 const HFMAnimationFrame& ceilFrame = frames.at((int)glm::ceil(currentFrame) % frameCount);
                 const float frameFraction = glm::fract(currentFrame);
-                std::vector<AnimPose> poses = _avatarAnimSkeleton->getRelativeDefaultPoses();
+                AnimPoseVec& poses = _relativePoses;
+                poses = _avatarAnimSkeleton->getRelativeDefaultPoses();
 
                 // TODO: this needs more testing, it's possible that we need not only scale but also rotation and translation
                 // According to tests with unmatching avatar and animation armatures, sometimes bones are not rotated correctly.
                 // Matching armatures already work very well now.
                 const float UNIT_SCALE = _animationRig.GetScaleFactorGeometryToUnscaledRig() / _rig.GetScaleFactorGeometryToUnscaledRig();
 
-                for (int i = 0; i < animationJointNames.size(); i++) {
-                    const QString& name = animationJointNames[i];
-                    // As long as we need the model preRotations anyway, let's get the jointIndex from the bind skeleton rather than
-                    // trusting the .fst (which is sometimes not updated to match changes to .fbx).
-                    int mapping = _geometryResource->getHFMModel().getJointIndex(name);
-                    if (mapping != -1 && !_maskedJoints.contains(name)) {
+                for (int i = 0; i < (int)_animationJointMapping.size(); i++) {
+                    int mapping = _animationJointMapping[i];
+                    if (mapping != -1) {
                         AnimPose floorPose = composeAnimPose(modelJoints[mapping], floorFrame.rotations[i],
                                                              floorFrame.translations[i] * UNIT_SCALE);
                         AnimPose ceilPose = composeAnimPose(modelJoints[mapping], ceilFrame.rotations[i],
@@ -204,7 +215,8 @@ void ScriptableAvatar::update(float deltatime) {
                     }
                 }
 
-                std::vector<AnimPose> absPoses = poses;
+                AnimPoseVec& absPoses = _absolutePoses;
+                absPoses = poses;
                 Q_ASSERT(_avatarAnimSkeleton != nullptr);
                 _avatarAnimSkeleton->convertRelativePosesToAbsolute(absPoses);
                 for (int i = 0; i < nJoints; i++) {
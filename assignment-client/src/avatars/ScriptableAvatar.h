@@ -226,6 +226,9 @@ private:
     Rig _animationRig;
     bool _isAnimationRigValid{false};
     std::shared_ptr<AnimSkeleton> _avatarAnimSkeleton;
+    std::vector<int> _animationJointMapping; ///< model joint of each animation joint, -1 if it's missing or masked
+    AnimPoseVec _relativePoses; ///< reused every frame rather than reallocated
+    AnimPoseVec _absolutePoses;
     QHash<QString, int> _fstJointIndices; ///< 1-based, since zero is returned for missing keys
     QStringList _fstJointNames; ///< in order of depth-first traversal
     QUrl _skeletonModelFilenameURL; // This contains URL from filename field in fst file
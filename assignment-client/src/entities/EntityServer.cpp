@@ -23,6 +23,8 @@
 #include <EntityEditFilters.h>
 #include <NetworkingConstants.h>
 #include <MetaverseAPI.h>
+#include <OctreeCompressionDictionary.h>
+#include <StringPool.h>
 #include <hfm/ModelFormatRegistry.h>
 
 #include "../AssignmentDynamicFactory.h"
@@ -116,6 +118,14 @@ void EntityServer::beforeRun() {
 
     DomainHandler& domainHandler = DependencyManager::get<NodeList>()->getDomainHandler();
     connect(&domainHandler, &DomainHandler::settingsReceiveFail, this, &EntityServer::domainSettingsRequestFailed);
+
+    if (_wantCompressionDictionary) {
+        quint64 trainStart = usecTimestampNow();
+        _compressionDictionary = std::static_pointer_cast<EntityTree>(_tree)->trainCompressionDictionary();
+        _compressionDictionaryChecksum = OctreeCompressionDictionary::checksum(_compressionDictionary);
+        qDebug() << "Trained a compression dictionary of" << _compressionDictionary.size() << "bytes in"
+                 << (usecTimestampNow() - trainStart) << "usecs";
+    }
 }
 
 void EntityServer::entityCreated(const EntityItem& newEntity, const SharedNodePointer& senderNode) {
@@ -320,6 +330,9 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
     tree->setWantEditLogging(wantEditLogging);
     tree->setWantTerseEditLogging(wantTerseEditLogging);
 
+    readOptionBool(QString("compressionDictionary"), settingsSectionObject, _wantCompressionDictionary);
+    qDebug("compressionDictionary=%s", debug::valueOf(_wantCompressionDictionary));
+
     QString entityScriptSourceWhitelist;
     if (readOptionString("entityScriptSourceWhitelist", settingsSectionObject, entityScriptSourceWhitelist)) {
         tree->setEntityScriptSourceWhitelist(entityScriptSourceWhitelist);
@@ -329,6 +342,11 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
 
     auto entityEditFilters = DependencyManager::get<EntityEditFilters>();
 
+    int filterTimeBudget = EntityEditFilters::DEFAULT_FILTER_TIME_BUDGET_MSECS;
+    readOptionInt("entityEditFilterTimeBudget", settingsSectionObject, filterTimeBudget);
+    entityEditFilters->setFilterTimeBudget(filterTimeBudget);
+    qDebug("entityEditFilterTimeBudget=%d", filterTimeBudget);
+
     QString filterURL;
     if (readOptionString("entityEditFilter", settingsSectionObject, filterURL) && !filterURL.isEmpty()) {
         // connect the filterAdded signal, and block edits until you hear back
@@ -397,6 +415,56 @@ QString EntityServer::serverSubclassStats() {
     statsString += QString("       EntityItem size... %1 bytes\r\n").arg(sizeof(EntityItem));
     statsString += "\r\n\r\n";
 
+    statsString += "<b>Entity Server Memory by Entity Type</b>\r\n";
+    statsString += "----- Type -----    -- Entities --    --- Object Bytes ---    --- String Bytes ---\r\n";
+    if (_tree) {
+        auto memoryStats = std::static_pointer_cast<EntityTree>(_tree)->getMemoryStats();
+        int totalEntities = 0;
+        size_t totalObjectBytes = 0;
+        size_t totalStringBytes = 0;
+        for (int type = 0; type < (int)memoryStats.size(); type++) {
+            const auto& typeStats = memoryStats[type];
+            if (typeStats.numEntities == 0) {
+                continue;
+            }
+            statsString += QString("%1    %2    %3    %4\r\n")
+                .arg(EntityTypes::getEntityTypeName((EntityTypes::EntityType)type), -18)
+                .arg(locale.toString(typeStats.numEntities), 14)
+                .arg(locale.toString((qulonglong)typeStats.objectBytes), 19)
+                .arg(locale.toString((qulonglong)typeStats.unsharedStringBytes), 20);
+            totalEntities += typeStats.numEntities;
+            totalObjectBytes += typeStats.objectBytes;
+            totalStringBytes += typeStats.unsharedStringBytes;
+        }
+        statsString += QString("%1    %2    %3    %4\r\n")
+            .arg("Total", -18)
+            .arg(locale.toString(totalEntities), 14)
+            .arg(locale.toString((qulonglong)totalObjectBytes), 19)
+            .arg(locale.toString((qulonglong)totalStringBytes), 20);
+    }
+    auto& stringPool = StringPool::instance();
+    statsString += QString("Interned strings... %1 (%2 bytes)\r\n")
+        .arg(locale.toString(stringPool.getNumStrings()))
+        .arg(locale.toString((qulonglong)stringPool.getNumBytes()));
+    statsString += "\r\n\r\n";
+
+    statsString += "<b>Entity Server Shared Traversal Statistics</b>\r\n";
+    statsString += QString("First traversals shared... %1\r\n").arg(locale.toString((qulonglong)_sharedTraversals.getNumHits()));
+    statsString += QString("First traversals walked... %1\r\n").arg(locale.toString((qulonglong)_sharedTraversals.getNumMisses()));
+    statsString += "\r\n\r\n";
+
+    statsString += "<b>Entity Server Compression Dictionary</b>\r\n";
+    statsString += QString("Dictionary size... %1 bytes\r\n").arg(locale.toString(_compressionDictionary.size()));
+    statsString += QString("Dictionary checksum... %1\r\n").arg(_compressionDictionaryChecksum, 8, 16, QChar('0'));
+    statsString += "\r\n\r\n";
+
+    auto entityEditFilters = DependencyManager::get<EntityEditFilters>();
+    statsString += "<b>Entity Server Edit Filter Statistics</b>\r\n";
+    statsString += QString("Edits checked by filter rules... %1\r\n").arg(locale.toString((qulonglong)entityEditFilters->getNumRulesFiltered()));
+    statsString += QString("Edits passed to filter scripts... %1\r\n").arg(locale.toString((qulonglong)entityEditFilters->getNumScriptsFiltered()));
+    statsString += QString("Filter scripts timed out... %1\r\n").arg(locale.toString((qulonglong)entityEditFilters->getNumScriptsTimedOut()));
+    statsString += "\r\n\r\n";
+
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
     statsString += "----- Viewer Node ID -----------------    ----- Entity ID ----------------------    "
                    "---------- Last Sent To ----------    ---------- Last Edited -----------\r\n";
@@ -23,6 +23,7 @@
 #include <SimpleEntitySimulation.h>
 
 #include "EntityServerConsts.h"
+#include "SharedEntityTraversals.h"
 
 /// Handles assignments of type EntityServer - sending entities to various clients.
 
@@ -61,6 +62,12 @@ public:
 
     virtual void aboutToFinish() override;
 
+    SharedEntityTraversals& getSharedTraversals() { return _sharedTraversals; }
+
+    // trained once the tree is loaded, before any viewer is sent to, and not changed after
+    const QByteArray& getCompressionDictionary() const { return _compressionDictionary; }
+    uint32_t getCompressionDictionaryChecksum() const { return _compressionDictionaryChecksum; }
+
 public slots:
     virtual void nodeAdded(SharedNodePointer node) override;
     virtual void nodeKilled(SharedNodePointer node) override;
@@ -81,6 +88,12 @@ private:
 
     QReadWriteLock _viewerSendingStatsLock;
     QMap<QUuid, QMap<QUuid, ViewerSendingStats>> _viewerSendingStats;
+
+    SharedEntityTraversals _sharedTraversals;
+
+    bool _wantCompressionDictionary { true };
+    QByteArray _compressionDictionary;
+    uint32_t _compressionDictionaryChecksum { 0 };
 };
 
 #endif  // hifi_EntityServer_h
@@ -11,28 +11,69 @@
 
 #include "EntityTreeSendThread.h"
 
+#include <algorithm>
+
 #include <EntityNodeData.h>
 #include <EntityTypes.h>
 #include <OctreeUtils.h>
 
 #include "EntityServer.h"
 
+// how long the blob versions sent in unreliable packets are taken to be known by the viewer
+static const uint64_t KNOWN_BLOB_VERSIONS_LIFETIME_USECS = 5 * USECS_PER_SECOND;
+
 EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedNodePointer& node) :
     OctreeSendThread(myServer, node)
 {
-    connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::editingEntityPointer, this, &EntityTreeSendThread::editingEntityPointer, Qt::QueuedConnection);
-    connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::deletingEntityPointer, this, &EntityTreeSendThread::deletingEntityPointer, Qt::QueuedConnection);
+    // these are only queued up here and handled by our next send pass, which may run on a thread of the send pool
+    connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::editingEntityPointer, this, &EntityTreeSendThread::editingEntityPointer, Qt::DirectConnection);
+    connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::deletingEntityPointer, this, &EntityTreeSendThread::deletingEntityPointer, Qt::DirectConnection);
 
     // connect to connection ID change on EntityNodeData so we can clear state for this receiver
     auto nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
-    connect(nodeData, &EntityNodeData::incomingConnectionIDChanged, this, &EntityTreeSendThread::resetState);
+    connect(nodeData, &EntityNodeData::incomingConnectionIDChanged, this, &EntityTreeSendThread::resetState, Qt::DirectConnection);
 }
 
 void EntityTreeSendThread::resetState() {
-    qCDebug(entities) << "Clearing known EntityTreeSendThread state for" << _nodeUuid;
+    _shouldResetState = true;
+}
+
+void EntityTreeSendThread::processPendingChanges() {
+    if (_shouldResetState.exchange(false)) {
+        qCDebug(entities) << "Clearing known EntityTreeSendThread state for" << _nodeUuid;
+
+        _knownState.clear();
+        _knownBlobVersions.clear();
+        _traversal.reset();
+        _sharingTraversal.reset();
+        _sentCompressionDictionaryChecksum = 0;
+    }
+
+    std::vector<EntityItem*> deletedEntities;
+    std::vector<EntityItemPointer> editedEntities;
+    {
+        std::lock_guard<std::mutex> lock(_pendingChangesMutex);
+        deletedEntities.swap(_pendingDeletedEntities);
+        editedEntities.swap(_pendingEditedEntities);
+    }
+
+    for (EntityItem* entity : deletedEntities) {
+        _knownState.erase(entity);
+        _knownBlobVersions.erase(entity);
+    }
+    for (const auto& entity : editedEntities) {
+        if (!_sendQueue.contains(entity.get()) && _knownState.find(entity.get()) != _knownState.end()) {
+            const auto& view = _traversal.getCurrentView();
+            float priority = view.computePriority(entity);
 
-    _knownState.clear();
-    _traversal.reset();
+            // We can force a removal from _knownState if the current view is used and entity is out of view
+            if (priority == PrioritizedEntity::DO_NOT_SEND) {
+                _sendQueue.emplace(entity, PrioritizedEntity::FORCE_REMOVE, true);
+            } else if (priority == PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY) {
+                _sendQueue.emplace(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY, true);
+            }
+        }
+    }
 }
 
 void EntityTreeSendThread::preDistributionProcessing() {
@@ -101,6 +142,67 @@ void EntityTreeSendThread::preDistributionProcessing() {
 
 bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) {
+    quint64 lockWaitStart = usecTimestampNow();
+    _myServer->getOctree()->withReadLock([&] {
+        OctreeServer::trackTreeWaitTime((float)(usecTimestampNow() - lockWaitStart));
+        processPendingChanges();
+
+        // Once entity packets are unreliable, one that carried blob properties may have been lost. Forgetting the
+        // versions sent every so often has the next edit of each entity carry its blobs in full again.
+        uint64_t now = usecTimestampNow();
+        if (!nodeData->getPacket().isReliable() && now - _knownBlobVersionsStart > KNOWN_BLOB_VERSIONS_LIFETIME_USECS) {
+            _knownBlobVersions.clear();
+            _knownBlobVersionsStart = now;
+        }
+        traverseTree(nodeData, viewFrustumChanged, isFullScene);
+    });
+
+    updateCompressionDictionary(node, nodeData);
+
+    bool sendComplete = OctreeSendThread::traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
+
+    if (sendComplete && nodeData->wantReportInitialCompletion() && _traversal.finished()) {
+        // Dealt with all nearby entities.
+        nodeData->setReportInitialCompletion(false);
+        // initial stats and entity packets are reliable until the initial query is complete
+        // to guarantee all entity data is available for safe landing/physics start.  Afterwards
+        // the packets are unreliable for performance.
+        nodeData->stats.getStatsMessage().setReliable(false);
+        nodeData->getPacket().setReliable(false);
+
+        // Send EntityQueryInitialResultsComplete reliable packet ...
+        auto initialCompletion = NLPacket::create(PacketType::EntityQueryInitialResultsComplete,
+            sizeof(OCTREE_PACKET_SEQUENCE), true);
+        initialCompletion->writePrimitive(OCTREE_PACKET_SEQUENCE(nodeData->getSequenceNumber()));
+        DependencyManager::get<NodeList>()->sendPacket(std::move(initialCompletion), *node);
+    }
+
+    return sendComplete;
+}
+
+void EntityTreeSendThread::updateCompressionDictionary(const SharedNodePointer& node, OctreeQueryNode* nodeData) {
+    auto entityServer = static_cast<EntityServer*>(_myServer);
+    const QByteArray& dictionary = entityServer->getCompressionDictionary();
+    uint32_t checksum = entityServer->getCompressionDictionaryChecksum();
+    if (dictionary.isEmpty() || !nodeData->wantCompressionDictionary()) {
+        _packetData.setCompressionDictionary(QByteArray());
+        return;
+    }
+
+    if (_sentCompressionDictionaryChecksum != checksum) {
+        auto dictionaryPacketList = NLPacketList::create(PacketType::EntityCompressionDictionary, QByteArray(), true, true);
+        dictionaryPacketList->write(dictionary);
+        DependencyManager::get<NodeList>()->sendPacketList(std::move(dictionaryPacketList), *node);
+        _sentCompressionDictionaryChecksum = checksum;
+    }
+
+    // sections are only compressed with the dictionary once the viewer's query confirms it holds it
+    bool useDictionary = nodeData->getCompressionDictionaryChecksum() == checksum;
+    _packetData.setCompressionDictionary(useDictionary ? dictionary : QByteArray());
+}
+
+void EntityTreeSendThread::traverseTree(OctreeQueryNode* nodeData, bool viewFrustumChanged, bool isFullScene) {
+    // NOTE: assumes tree already read-locked
     if (viewFrustumChanged || _traversal.finished()) {
         EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
 
@@ -153,27 +255,12 @@ bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, O
         #endif
         _traversal.traverse(TIME_BUDGET);
         OctreeServer::trackTreeTraverseTime((float)(usecTimestampNow() - startTime));
-    }
 
-    bool sendComplete = OctreeSendThread::traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
-
-    if (sendComplete && nodeData->wantReportInitialCompletion() && _traversal.finished()) {
-        // Dealt with all nearby entities.
-        nodeData->setReportInitialCompletion(false);
-        // initial stats and entity packets are reliable until the initial query is complete
-        // to guarantee all entity data is available for safe landing/physics start.  Afterwards
-        // the packets are unreliable for performance.
-        nodeData->stats.getStatsMessage().setReliable(false);
-        nodeData->getPacket().setReliable(false);
-
-        // Send EntityQueryInitialResultsComplete reliable packet ...
-        auto initialCompletion = NLPacket::create(PacketType::EntityQueryInitialResultsComplete,
-            sizeof(OCTREE_PACKET_SEQUENCE), true);
-        initialCompletion->writePrimitive(OCTREE_PACKET_SEQUENCE(nodeData->getSequenceNumber()));
-        DependencyManager::get<NodeList>()->sendPacket(std::move(initialCompletion), *node);
+        if (_traversal.finished() && _sharingTraversal) {
+            static_cast<EntityServer*>(_myServer)->getSharedTraversals().insert(_sharingTraversal);
+            _sharingTraversal.reset();
+        }
     }
-
-    return sendComplete;
 }
 
 bool EntityTreeSendThread::addAncestorsToExtraFlaggedEntities(const QUuid& filteredEntityID,
@@ -229,6 +316,7 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
                                              bool forceFirstPass) {
 
     DiffTraversal::Type type = _traversal.prepareNewTraversal(view, root, forceFirstPass);
+    _sharingTraversal.reset();
     // there are three types of traversal:
     //
     //      (1) FirstTime = at login --> find everything in view
@@ -238,24 +326,52 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
     // The "scanCallback" we provide to the traversal depends on the type:
 
     switch (type) {
-        case DiffTraversal::First:
+        case DiffTraversal::First: {
             // When we get to a First traversal, clear the _knownState
             _knownState.clear();
+            _knownBlobVersions.clear();
+
+            // Viewers with a very similar view share a recent First traversal, rather than each repeating it;
+            // entities changed since it started are found by our next traversal
+            auto& sharedTraversals = static_cast<EntityServer*>(_myServer)->getSharedTraversals();
+            auto sharedTraversal = sharedTraversals.find(_traversal.getCurrentView());
+            if (sharedTraversal) {
+                for (const auto& sharedEntity : sharedTraversal->entities) {
+                    EntityItemPointer entity = sharedEntity.first.lock();
+                    if (entity && !_sendQueue.contains(entity.get())) {
+                        _sendQueue.emplace(entity, sharedEntity.second);
+                    }
+                }
+                _traversal.adoptCompletedView(sharedTraversal->view);
+                _traversal.setScanCallback(nullptr);
+                break;
+            }
+
+            _sharingTraversal = std::make_shared<SharedEntityTraversals::Result>();
+            _sharingTraversal->view = _traversal.getCurrentView();
             _traversal.setScanCallback([this](DiffTraversal::VisibleElement& next) {
                 next.element->forEachEntity([&](EntityItemPointer entity) {
-                    // Bail early if we've already checked this entity this frame
-                    if (_sendQueue.contains(entity.get())) {
+                    // Bail early if we've already checked this entity this frame,
+                    // unless the traversal is shared, which needs all entities in view
+                    bool queued = _sendQueue.contains(entity.get());
+                    if (queued && !_sharingTraversal) {
                         return;
                     }
                     const auto& view = _traversal.getCurrentView();
                     float priority = view.computePriority(entity);
 
                     if (priority != PrioritizedEntity::DO_NOT_SEND) {
-                        _sendQueue.emplace(entity, priority);
+                        if (_sharingTraversal) {
+                            _sharingTraversal->entities.emplace_back(entity, priority);
+                        }
+                        if (!queued) {
+                            _sendQueue.emplace(entity, priority);
+                        }
                     }
                 });
             });
             break;
+        }
         case DiffTraversal::Repeat:
             _traversal.setScanCallback([this](DiffTraversal::VisibleElement& next) {
                 uint64_t startOfCompletedTraversal = _traversal.getStartOfCompletedTraversal();
@@ -317,6 +433,34 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
     }
 }
 
+void EntityTreeSendThread::omitKnownBlobProperties(const EntityItemPointer& entity,
+                                                   const EntityItem::PropertyVersions& blobVersions,
+                                                   EncodeBitstreamParams& params) {
+    auto knownVersions = _knownBlobVersions.find(entity.get());
+    if (knownVersions == _knownBlobVersions.end()) {
+        return;
+    }
+
+    EntityPropertyFlags knownProperties;
+    for (const auto& version : blobVersions) {
+        if (std::find(knownVersions->second.begin(), knownVersions->second.end(), version) != knownVersions->second.end()) {
+            knownProperties += version.first;
+        }
+    }
+    if (knownProperties.isEmpty()) {
+        return;
+    }
+
+    // appendEntityData() takes the properties to append from _extraEncodeData as they are,
+    // so leave out what it would not send over the wire either
+    EntityPropertyFlags requestedProperties = entity->getEntityProperties(params);
+    requestedProperties -= PROP_ENTITY_HOST_TYPE;
+    requestedProperties -= PROP_OWNING_AVATAR_ID;
+    requestedProperties -= PROP_VISIBLE_IN_SECONDARY_CAMERA;
+    requestedProperties -= knownProperties;
+    _extraEncodeData->entities.insert(entity->getEntityItemID(), requestedProperties);
+}
+
 bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) {
     if (_sendQueue.empty()) {
         params.stopReason = EncodeBitstreamParams::FINISHED;
@@ -377,6 +521,14 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
                     // Record explicitly filtered-in entity so that extra entities can be flagged.
                     entityNodeData->insertSentFilteredEntity(entityID);
                 }
+                // a continued entity may have sent some blob properties as of an older version, so don't track those
+                bool isContinued = _extraEncodeData->entities.contains(entity->getEntityItemID());
+                EntityItem::PropertyVersions blobVersions;
+                entity->getBlobPropertyVersions(blobVersions);
+                if (!isContinued) {
+                    omitKnownBlobProperties(entity, blobVersions, params);
+                }
+
                 OctreeElement::AppendState appendEntityState = entity->appendEntityData(&_packetData, params, _extraEncodeData, entityNode->getCanGetAndSetPrivateUserData());
 
                 if (appendEntityState != OctreeElement::COMPLETED) {
@@ -386,6 +538,12 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
                     params.stopReason = EncodeBitstreamParams::DIDNT_FIT;
                     break;
                 }
+                _extraEncodeData->entities.remove(entity->getEntityItemID());
+                if (isContinued) {
+                    _knownBlobVersions.erase(entity.get());
+                } else {
+                    _knownBlobVersions[entity.get()] = std::move(blobVersions);
+                }
 
                 if (entityPreviouslyMatchedFilter && !entityMatchesFilters) {
                     entityNodeData->removeSentFilteredEntity(entityID);
@@ -420,20 +578,12 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
 
 void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity) {
     if (entity) {
-        if (!_sendQueue.contains(entity.get()) && _knownState.find(entity.get()) != _knownState.end()) {
-            const auto& view = _traversal.getCurrentView();
-            float priority = view.computePriority(entity);
-
-            // We can force a removal from _knownState if the current view is used and entity is out of view
-            if (priority == PrioritizedEntity::DO_NOT_SEND) {
-                _sendQueue.emplace(entity, PrioritizedEntity::FORCE_REMOVE, true);
-            } else if (priority == PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY) {
-                _sendQueue.emplace(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY, true);
-            }
-        }
+        std::lock_guard<std::mutex> lock(_pendingChangesMutex);
+        _pendingEditedEntities.push_back(entity);
     }
 }
 
 void EntityTreeSendThread::deletingEntityPointer(EntityItem* entity) {
-    _knownState.erase(entity);
+    std::lock_guard<std::mutex> lock(_pendingChangesMutex);
+    _pendingDeletedEntities.push_back(entity);
 }
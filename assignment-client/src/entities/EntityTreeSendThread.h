@@ -12,7 +12,10 @@
 #ifndef hifi_EntityTreeSendThread_h
 #define hifi_EntityTreeSendThread_h
 
+#include <atomic>
+#include <mutex>
 #include <unordered_set>
+#include <vector>
 
 #include "../octree/OctreeSendThread.h"
 
@@ -20,6 +23,8 @@
 #include <EntityPriorityQueue.h>
 #include <shared/ConicalViewFrustum.h>
 
+#include "SharedEntityTraversals.h"
+
 
 class EntityNodeData;
 class EntityItem;
@@ -35,28 +40,44 @@ protected:
             bool viewFrustumChanged, bool isFullScene) override;
 
 private slots:
-    void resetState(); // clears our known state forcing entities to appear unsent
+    void resetState(); // clears our known state forcing entities to appear unsent, on our next send pass
 
 private:
     // the following two methods return booleans to indicate if any extra flagged entities were new additions to set
     bool addAncestorsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
     bool addDescendantsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
 
+    void processPendingChanges();
+    void updateCompressionDictionary(const SharedNodePointer& node, OctreeQueryNode* nodeData);
+    void traverseTree(OctreeQueryNode* nodeData, bool viewFrustumChanged, bool isFullScene);
     void startNewTraversal(const DiffTraversal::View& viewFrustum, EntityTreeElementPointer root, bool forceFirstPass = false);
     bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) override;
+    void omitKnownBlobProperties(const EntityItemPointer& entity, const EntityItem::PropertyVersions& blobVersions,
+                                 EncodeBitstreamParams& params);
 
     void preDistributionProcessing() override;
     bool hasSomethingToSend(OctreeQueryNode* nodeData) override { return !_sendQueue.empty(); }
     bool shouldStartNewTraversal(OctreeQueryNode* nodeData, bool viewFrustumChanged) override { return viewFrustumChanged || _traversal.finished(); }
 
     DiffTraversal _traversal;
+    std::shared_ptr<SharedEntityTraversals::Result> _sharingTraversal; // the First traversal in progress, to share once complete
     EntityPriorityQueue _sendQueue;
     std::unordered_map<EntityItem*, uint64_t> _knownState;
+    // versions of the blob properties last sent in full, which the viewer keeps even once the entity is out of view
+    std::unordered_map<EntityItem*, EntityItem::PropertyVersions> _knownBlobVersions;
+    uint64_t _knownBlobVersionsStart { 0 }; // when _knownBlobVersions were last forgotten
 
     // packet construction stuff
     EntityTreeElementExtraEncodeDataPointer _extraEncodeData { new EntityTreeElementExtraEncodeData() };
     int32_t _numEntitiesOffset { 0 };
     uint16_t _numEntities { 0 };
+    uint32_t _sentCompressionDictionaryChecksum { 0 }; // of the compression dictionary sent to the viewer, 0 for none
+
+    // changes signaled by the tree and the node data, from their threads
+    std::mutex _pendingChangesMutex;
+    std::vector<EntityItemPointer> _pendingEditedEntities;
+    std::vector<EntityItem*> _pendingDeletedEntities;
+    std::atomic<bool> _shouldResetState { false };
 
 private slots:
     void editingEntityPointer(const EntityItemPointer& entity);
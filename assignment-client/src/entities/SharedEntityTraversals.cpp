@@ -0,0 +1,58 @@
+//
+//  SharedEntityTraversals.cpp
+//  assignment-client/src/entities
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "SharedEntityTraversals.h"
+
+#include <algorithm>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+// an older result is still correct, as the adopting viewer catches up from its start, but has more to catch up on
+static const uint64_t MAX_SHARED_TRAVERSAL_AGE = 2 * USECS_PER_SECOND;
+static const size_t MAX_SHARED_TRAVERSALS = 32;
+
+void SharedEntityTraversals::pruneExpired(uint64_t now) {
+    _results.erase(std::remove_if(_results.begin(), _results.end(), [&](const ResultPointer& result) {
+        return result->view.startTime + MAX_SHARED_TRAVERSAL_AGE < now;
+    }), _results.end());
+}
+
+SharedEntityTraversals::ResultPointer SharedEntityTraversals::find(const DiffTraversal::View& view) {
+    QMutexLocker locker(&_lock);
+    pruneExpired(usecTimestampNow());
+    for (const auto& result : _results) {
+        if (result->view.isVerySimilar(view)) {
+            ++_numHits;
+            return result;
+        }
+    }
+    ++_numMisses;
+    return nullptr;
+}
+
+void SharedEntityTraversals::insert(const ResultPointer& result) {
+    QMutexLocker locker(&_lock);
+    pruneExpired(usecTimestampNow());
+    auto similar = std::find_if(_results.begin(), _results.end(), [&](const ResultPointer& other) {
+        return other->view.isVerySimilar(result->view);
+    });
+    if (similar != _results.end()) {
+        *similar = result;
+    } else {
+        if (_results.size() >= MAX_SHARED_TRAVERSALS) {
+            _results.erase(std::min_element(_results.begin(), _results.end(), [](const ResultPointer& a, const ResultPointer& b) {
+                return a->view.startTime < b->view.startTime;
+            }));
+        }
+        _results.push_back(result);
+    }
+}
@@ -0,0 +1,53 @@
+//
+//  SharedEntityTraversals.h
+//  assignment-client/src/entities
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_SharedEntityTraversals_h
+#define overte_SharedEntityTraversals_h
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QMutex>
+
+#include <DiffTraversal.h>
+#include <EntityItem.h>
+
+// Recent First traversals of the entity tree, shared between the send threads of viewers with very similar views,
+// such as the viewers standing at a spawn point. A viewer that finds one adopts its entities and view as its own
+// completed traversal, and its next traversal catches up on what changed since that traversal started.
+class SharedEntityTraversals {
+public:
+    class Result {
+    public:
+        DiffTraversal::View view; // startTime is when the traversal started
+        std::vector<std::pair<EntityItemWeakPointer, float>> entities; // with their priority for view
+    };
+    using ResultPointer = std::shared_ptr<const Result>;
+
+    ResultPointer find(const DiffTraversal::View& view);
+    void insert(const ResultPointer& result);
+
+    uint64_t getNumHits() const { return _numHits; }
+    uint64_t getNumMisses() const { return _numMisses; }
+
+private:
+    void pruneExpired(uint64_t now);
+
+    QMutex _lock;
+    std::vector<ResultPointer> _results;
+
+    std::atomic<uint64_t> _numHits { 0 };
+    std::atomic<uint64_t> _numMisses { 0 };
+};
+
+#endif // overte_SharedEntityTraversals_h
@@ -0,0 +1,33 @@
+//
+//  MessagesFanOutTask.cpp
+//  assignment-client/src/messages
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "MessagesFanOutTask.h"
+
+#include <NLPacketList.h>
+#include <NodeList.h>
+#include <udt/PacketHeaders.h>
+
+MessagesFanOutTask::MessagesFanOutTask(const QByteArray& payload, const QVector<SharedNodePointer>& recipients) :
+    _payload(payload),
+    _recipients(recipients)
+{
+}
+
+void MessagesFanOutTask::run() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    for (const auto& node : _recipients) {
+        // each node needs a packet list of its own, as the sequence numbers are per connection, but the payload is only
+        // copied into it rather than encoded again
+        auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+        packetList->write(_payload);
+        nodeList->sendPacketList(std::move(packetList), *node);
+    }
+}
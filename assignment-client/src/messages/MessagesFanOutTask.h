@@ -0,0 +1,33 @@
+//
+//  MessagesFanOutTask.h
+//  assignment-client/src/messages
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_MessagesFanOutTask_h
+#define overte_MessagesFanOutTask_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QRunnable>
+#include <QtCore/QVector>
+
+#include <Node.h>
+
+/// Sends the payload of a MessagesData packet, as it was received, to the subscribers of its channel
+class MessagesFanOutTask : public QRunnable {
+public:
+    MessagesFanOutTask(const QByteArray& payload, const QVector<SharedNodePointer>& recipients);
+
+    void run() override;
+
+private:
+    QByteArray _payload;
+    QVector<SharedNodePointer> _recipients;
+};
+
+#endif // overte_MessagesFanOutTask_h
@@ -11,16 +11,24 @@
 
 #include "MessagesMixer.h"
 
+#include <algorithm>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QJsonObject>
+#include <QtCore/QThread>
 #include <QBuffer>
 #include <LogHandler.h>
 #include <MessagesClient.h>
 #include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 #include <udt/PacketHeaders.h>
 
+#include "MessagesFanOutTask.h"
+
 const QString MESSAGES_MIXER_LOGGING_NAME = "messages-mixer";
 const int MESSAGES_MIXER_RATE_LIMITER_INTERVAL = 1000; // 1 second
+const int MAX_MESSAGES_FAN_OUT_THREADS = 4;
 
 MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(message)
 {
@@ -32,58 +40,87 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
         PacketReceiver::makeSourcedListenerReference<MessagesMixer>(this, &MessagesMixer::handleMessagesSubscribe));
     packetReceiver.registerListener(PacketType::MessagesUnsubscribe,
         PacketReceiver::makeSourcedListenerReference<MessagesMixer>(this, &MessagesMixer::handleMessagesUnsubscribe));
+
+    // leave a core for the thread that receives the messages
+    int numFanOutThreads = std::max(1, std::min(QThread::idealThreadCount() - 1, MAX_MESSAGES_FAN_OUT_THREADS));
+    for (int i = 0; i < numFanOutThreads; i++) {
+        auto pool = std::unique_ptr<QThreadPool>(new QThreadPool());
+        pool->setMaxThreadCount(1);
+        _fanOutPools.push_back(std::move(pool));
+    }
+    _lastStatsTime = usecTimestampNow();
 }
 
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
-    for (auto& channel : _channelSubscribers) {
-        channel.remove(killedNode->getUUID());
-    }
+    _channelSubscribers.removeSubscriber(killedNode->getUUID());
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
-    QString channel, message;
-    QByteArray data;
-    QUuid senderID;
+    // only the channel is decoded, the payload is forwarded as it was received
+    quint16 channelLength;
+    receivedMessage->readPrimitive(&channelLength);
+    QString channel = QString::fromUtf8(receivedMessage->read(channelLength));
     bool isText;
-    auto senderUUID = senderNode->getUUID();
-    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
+    receivedMessage->readPrimitive(&isText);
+    quint32 messageLength;
+    receivedMessage->readPrimitive(&messageLength);
+    qint64 payloadSize = receivedMessage->getPosition() + messageLength + NUM_BYTES_RFC4122_UUID;
+    if (receivedMessage->getSize() < payloadSize) {
+        qDebug() << "Dropping a malformed message on channel" << channel << "from" << senderNode->getUUID();
+        return;
+    }
 
-    auto nodeList = DependencyManager::get<NodeList>();
+    auto& stats = _channelStats[channel];
+    stats.messages++;
+    stats.inboundBytes += payloadSize;
 
+    auto senderUUID = senderNode->getUUID();
     auto itr = _allSubscribers.find(senderUUID);
     if (itr == _allSubscribers.end()) {
         _allSubscribers[senderUUID] = 1;
     } else if (*itr >= _maxMessagesPerSecond) {
+        stats.droppedMessages++;
         return;
     } else {
         *itr += 1;
     }
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
-        nodeList->sendPacketList(std::move(packetList), *node);
-    });
+    QSet<QUuid> subscribers = _channelSubscribers.match(channel);
+    if (subscribers.isEmpty()) {
+        return;
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    std::vector<QVector<SharedNodePointer>> recipients(_fanOutPools.size());
+    for (const auto& subscriberID : subscribers) {
+        auto node = nodeList->nodeWithUUID(subscriberID);
+        if (node && node->getActiveSocket()) {
+            recipients[node->getLocalID() % _fanOutPools.size()].push_back(node);
+        }
+    }
+
+    QByteArray payload = receivedMessage->getMessage().left(payloadSize);
+    for (size_t i = 0; i < recipients.size(); i++) {
+        if (!recipients[i].isEmpty()) {
+            stats.deliveries += recipients[i].size();
+            stats.outboundBytes += payloadSize * recipients[i].size();
+            _fanOutPools[i]->start(new MessagesFanOutTask(payload, recipients[i]));
+        }
+    }
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto senderUUID = senderNode->getUUID();
     QString channel = QString::fromUtf8(message->getMessage());
 
-    _channelSubscribers[channel] << senderUUID;
+    _channelSubscribers.subscribe(channel, senderUUID);
 }
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto senderUUID = senderNode->getUUID();
     QString channel = QString::fromUtf8(message->getMessage());
 
-    if (_channelSubscribers.contains(channel)) {
-        _channelSubscribers[channel].remove(senderUUID);
-    }
+    _channelSubscribers.unsubscribe(channel, senderUUID);
 }
 
 void MessagesMixer::sendStatsPacket() {
@@ -99,6 +136,26 @@ void MessagesMixer::sendStatsPacket() {
     });
 
     statsObject["messages"] = messagesMixerObject;
+
+    // add the throughput of each channel since the last stats packet
+    quint64 now = usecTimestampNow();
+    float elapsedSeconds = std::max((float)(now - _lastStatsTime) / USECS_PER_SECOND, 1.0f / USECS_PER_SECOND);
+    _lastStatsTime = now;
+
+    QJsonObject channelsObject;
+    for (auto itr = _channelStats.constBegin(); itr != _channelStats.constEnd(); ++itr) {
+        const ChannelStats& stats = itr.value();
+        QJsonObject channelStats;
+        channelStats["subscribers"] = _channelSubscribers.match(itr.key()).size();
+        channelStats["messages_per_second"] = stats.messages / elapsedSeconds;
+        channelStats["dropped_messages_per_second"] = stats.droppedMessages / elapsedSeconds;
+        channelStats["deliveries_per_second"] = stats.deliveries / elapsedSeconds;
+        channelStats["inbound_kbps"] = stats.inboundBytes * BITS_IN_BYTE / elapsedSeconds / BYTES_PER_KILOBYTE;
+        channelStats["outbound_kbps"] = stats.outboundBytes * BITS_IN_BYTE / elapsedSeconds / BYTES_PER_KILOBYTE;
+        channelsObject[itr.key()] = channelStats;
+    }
+    _channelStats.clear();
+    statsObject["channels"] = channelsObject;
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
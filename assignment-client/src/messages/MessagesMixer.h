@@ -15,10 +15,16 @@
 #ifndef hifi_MessagesMixer_h
 #define hifi_MessagesMixer_h
 
+#include <memory>
+#include <vector>
+
 #include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
 
 #include <ThreadedAssignment.h>
 
+#include "MessagesSubscriptionTrie.h"
+
 /// Handles assignments of type MessagesMixer - distribution of avatar data to various clients
 class MessagesMixer : public ThreadedAssignment {
     Q_OBJECT
@@ -42,9 +48,25 @@ private slots:
     void processMaxMessagesContainer();
 
 private:
-    QHash<QString, QSet<QUuid>> _channelSubscribers;
+    struct ChannelStats {
+        quint64 messages { 0 };
+        quint64 droppedMessages { 0 };
+        quint64 inboundBytes { 0 };
+        quint64 deliveries { 0 };
+        quint64 outboundBytes { 0 };
+    };
+
+    MessagesSubscriptionTrie _channelSubscribers;
     QHash<QUuid, int> _allSubscribers;
 
+    // The messages are sent to their subscribers from these pools, of one thread each so that the messages reach a node in
+    // the order that they were received.  Each node is always sent to from the same pool.
+    std::vector<std::unique_ptr<QThreadPool>> _fanOutPools;
+
+    // reset with every stats packet
+    QHash<QString, ChannelStats> _channelStats;
+    quint64 _lastStatsTime { 0 };
+
     const int DEFAULT_NODE_MESSAGES_PER_SECOND = 1000;
     int _maxMessagesPerSecond { 0 };
 
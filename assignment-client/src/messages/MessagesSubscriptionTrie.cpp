@@ -0,0 +1,90 @@
+//
+//  MessagesSubscriptionTrie.cpp
+//  assignment-client/src/messages
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "MessagesSubscriptionTrie.h"
+
+const QChar MessagesSubscriptionTrie::WILDCARD = '*';
+
+void MessagesSubscriptionTrie::subscribe(const QString& channel, const QUuid& subscriber) {
+    bool isPrefix = channel.endsWith(WILDCARD);
+    QString path = isPrefix ? channel.left(channel.length() - 1) : channel;
+
+    Node* node = &_root;
+    for (QChar c : path) {
+        auto& child = node->children[c.unicode()];
+        if (!child) {
+            child.reset(new Node());
+        }
+        node = child.get();
+    }
+    if (isPrefix) {
+        node->prefixSubscribers.insert(subscriber);
+    } else {
+        node->subscribers.insert(subscriber);
+    }
+    _subscriptions[subscriber].insert(channel);
+}
+
+bool MessagesSubscriptionTrie::remove(Node& node, const QString& path, int index, const QUuid& subscriber, bool isPrefix) {
+    if (index == path.length()) {
+        if (isPrefix) {
+            node.prefixSubscribers.remove(subscriber);
+        } else {
+            node.subscribers.remove(subscriber);
+        }
+    } else {
+        auto itr = node.children.find(path[index].unicode());
+        if (itr == node.children.end()) {
+            return false;
+        }
+        if (remove(*itr->second, path, index + 1, subscriber, isPrefix)) {
+            node.children.erase(itr);
+        }
+    }
+    return node.isEmpty();
+}
+
+void MessagesSubscriptionTrie::unsubscribe(const QString& channel, const QUuid& subscriber) {
+    auto itr = _subscriptions.find(subscriber);
+    if (itr == _subscriptions.end() || !itr->remove(channel)) {
+        return;
+    }
+    if (itr->isEmpty()) {
+        _subscriptions.erase(itr);
+    }
+
+    bool isPrefix = channel.endsWith(WILDCARD);
+    QString path = isPrefix ? channel.left(channel.length() - 1) : channel;
+    // the root is never removed
+    remove(_root, path, 0, subscriber, isPrefix);
+}
+
+void MessagesSubscriptionTrie::removeSubscriber(const QUuid& subscriber) {
+    QSet<QString> channels = _subscriptions.value(subscriber);
+    for (const auto& channel : channels) {
+        unsubscribe(channel, subscriber);
+    }
+}
+
+QSet<QUuid> MessagesSubscriptionTrie::match(const QString& channel) const {
+    QSet<QUuid> result = _root.prefixSubscribers;
+    const Node* node = &_root;
+    for (QChar c : channel) {
+        auto itr = node->children.find(c.unicode());
+        if (itr == node->children.end()) {
+            return result;
+        }
+        node = itr->second.get();
+        result.unite(node->prefixSubscribers);
+    }
+    result.unite(node->subscribers);
+    return result;
+}
@@ -0,0 +1,55 @@
+//
+//  MessagesSubscriptionTrie.h
+//  assignment-client/src/messages
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_MessagesSubscriptionTrie_h
+#define overte_MessagesSubscriptionTrie_h
+
+#include <memory>
+#include <unordered_map>
+
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QUuid>
+
+/// The channel subscriptions of the nodes, in a trie of the channel names.  A subscription to a channel that ends with '*'
+/// is a subscription to every channel that starts with what comes before it, so the subscribers of a channel are found by
+/// walking its name once, whatever the number of subscriptions.
+class MessagesSubscriptionTrie {
+public:
+    static const QChar WILDCARD;
+
+    void subscribe(const QString& channel, const QUuid& subscriber);
+    void unsubscribe(const QString& channel, const QUuid& subscriber);
+    /// Removes all the subscriptions of a subscriber
+    void removeSubscriber(const QUuid& subscriber);
+
+    /// Returns the subscribers of a channel, those of the channel itself and those of the wildcards that match it
+    QSet<QUuid> match(const QString& channel) const;
+
+private:
+    struct Node {
+        std::unordered_map<ushort, std::unique_ptr<Node>> children;
+        QSet<QUuid> subscribers;
+        QSet<QUuid> prefixSubscribers;
+
+        bool isEmpty() const { return children.empty() && subscribers.isEmpty() && prefixSubscribers.isEmpty(); }
+    };
+
+    // Removes the subscription from the trie below node, returns true if node is left empty
+    bool remove(Node& node, const QString& path, int index, const QUuid& subscriber, bool isPrefix);
+
+    Node _root;
+    // the channels that each subscriber is subscribed to, as they were given to subscribe()
+    QHash<QUuid, QSet<QString>> _subscriptions;
+};
+
+#endif // overte_MessagesSubscriptionTrie_h
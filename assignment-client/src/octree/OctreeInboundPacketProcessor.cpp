@@ -22,6 +22,8 @@
 
 static QUuid DEFAULT_NODE_ID_REF;
 const quint64 TOO_LONG_SINCE_LAST_NACK = 1 * USECS_PER_SECOND;
+// a batch of edits releases the tree's write lock at least this often, so send threads can read the tree
+const quint64 MAX_EDIT_BATCH_USECS = 10 * USECS_PER_MSEC;
 
 OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServer) :
     _myServer(myServer),
@@ -42,6 +44,7 @@ void OctreeInboundPacketProcessor::resetStats() {
     _totalLockWaitTime = 0;
     _totalElementsInPacket = 0;
     _totalPackets = 0;
+    _totalEditBatches = 0;
     _lastNackTime = usecTimestampNow();
 
     QWriteLocker locker(&_senderStatsLock);
@@ -74,6 +77,32 @@ void OctreeInboundPacketProcessor::midProcess() {
         _lastNackTime = now;
         sendNackPackets();
     }
+
+    if (_isEditBatching && now - _editBatchStartedAt >= MAX_EDIT_BATCH_USECS) {
+        endEditBatch();
+    }
+}
+
+void OctreeInboundPacketProcessor::postProcess() {
+    endEditBatch();
+}
+
+void OctreeInboundPacketProcessor::beginEditBatch() {
+    if (!_isEditBatching) {
+        _myServer->getOctree()->getLock().lockForWrite();
+        _myServer->getOctree()->beginEditBatch();
+        _isEditBatching = true;
+        _editBatchStartedAt = usecTimestampNow();
+        _totalEditBatches++;
+    }
+}
+
+void OctreeInboundPacketProcessor::endEditBatch() {
+    if (_isEditBatching) {
+        _myServer->getOctree()->endEditBatch();
+        _myServer->getOctree()->getLock().unlock();
+        _isEditBatching = false;
+    }
 }
 
 void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
@@ -158,13 +187,11 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
                         message->getPosition(), maxSize);
             }
 
-            quint64 startProcess, startLock = usecTimestampNow();
-            int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
-                startProcess = usecTimestampNow();
-                editDataBytesRead =
-                    _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
-            });
+            quint64 startLock = usecTimestampNow();
+            beginEditBatch();
+            quint64 startProcess = usecTimestampNow();
+            int editDataBytesRead =
+                _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
             quint64 endProcess = usecTimestampNow();
 
             if (debugProcessPacket) {
@@ -177,6 +204,7 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
             quint64 thisLockWaitTime = startProcess - startLock;
             processTime += thisProcessTime;
             lockWaitTime += thisLockWaitTime;
+            OctreeServer::trackProcessWaitTime((float)thisLockWaitTime);
 
             // skip to next edit record in the packet
             message->seek(message->getPosition() + editDataBytesRead);
@@ -71,6 +71,7 @@ public:
                 { return _totalElementsInPacket == 0 ? 0 : _totalProcessTime / _totalElementsInPacket; }
     quint64 getAverageLockWaitTimePerElement() const
                 { return _totalElementsInPacket == 0 ? 0 : _totalLockWaitTime / _totalElementsInPacket; }
+    quint64 getTotalEditBatches() const { return _totalEditBatches; }
 
     void resetStats();
 
@@ -85,10 +86,17 @@ protected:
     virtual uint32_t getMaxWait() const override;
     virtual void preProcess() override;
     virtual void midProcess() override;
+    virtual void postProcess() override;
 
 private:
     int sendNackPackets();
 
+    // the edits of a processing cycle are applied in a batch, under one acquisition of the tree's write lock
+    void beginEditBatch();
+    void endEditBatch();
+    bool _isEditBatching { false };
+    quint64 _editBatchStartedAt { 0 };
+
 private:
     void trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int elementsInPacket, quint64 processTime, quint64 lockWaitTime);
@@ -101,6 +109,7 @@ private:
     std::atomic<uint64_t> _totalLockWaitTime;
     std::atomic<uint64_t> _totalElementsInPacket;
     std::atomic<uint64_t> _totalPackets;
+    std::atomic<uint64_t> _totalEditBatches { 0 };
     
     NodeToSenderStatsMap _singleSenderStats;
     QReadWriteLock _senderStatsLock;
@@ -0,0 +1,109 @@
+//
+//  OctreeSendPool.cpp
+//  assignment-client/src/octree
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "OctreeSendPool.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <SharedUtil.h>
+#include <ThreadHelpers.h>
+
+#include "OctreeSendThread.h"
+#include "OctreeServerConsts.h"
+
+OctreeSendPool::OctreeSendPool(int numThreads) {
+    _threads.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back([this, i] {
+            setThreadName("Octree Send Pool " + std::to_string(i));
+            run();
+        });
+    }
+}
+
+OctreeSendPool::~OctreeSendPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _condition.notify_all();
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+int OctreeSendPool::getNumSenders() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (int)_senders.size();
+}
+
+void OctreeSendPool::add(OctreeSendThread* sender) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_senders.insert(sender).second) {
+            return;
+        }
+        _tasks.push_back({ usecTimestampNow(), sender });
+        std::push_heap(_tasks.begin(), _tasks.end());
+    }
+    _condition.notify_all();
+}
+
+void OctreeSendPool::remove(OctreeSendThread* sender) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_senders.erase(sender) > 0) {
+        auto task = std::find_if(_tasks.begin(), _tasks.end(), [&](const Task& task) { return task.sender == sender; });
+        if (task != _tasks.end()) {
+            _tasks.erase(task);
+            std::make_heap(_tasks.begin(), _tasks.end());
+        }
+    }
+    _condition.wait(lock, [&] { return _running.find(sender) == _running.end(); });
+}
+
+void OctreeSendPool::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_stopping) {
+        if (_tasks.empty()) {
+            _condition.wait(lock);
+            continue;
+        }
+        quint64 now = usecTimestampNow();
+        if (_tasks.front().deadline > now) {
+            _condition.wait_for(lock, std::chrono::microseconds(_tasks.front().deadline - now));
+            continue;
+        }
+
+        std::pop_heap(_tasks.begin(), _tasks.end());
+        OctreeSendThread* sender = _tasks.back().sender;
+        _tasks.pop_back();
+        _running.insert(sender);
+        lock.unlock();
+
+        quint64 start = usecTimestampNow();
+        bool keepSending = sender->processPass();
+        if (!keepSending) {
+            // still marked as running, so the sender can't be removed and destroyed before this is delivered
+            emit sender->finished();
+        }
+
+        lock.lock();
+        _running.erase(sender);
+        if (keepSending && _senders.find(sender) != _senders.end()) {
+            _tasks.push_back({ start + OCTREE_SEND_INTERVAL_USECS, sender });
+            std::push_heap(_tasks.begin(), _tasks.end());
+        } else {
+            _senders.erase(sender);
+        }
+        _condition.notify_all();
+    }
+}
@@ -0,0 +1,63 @@
+//
+//  OctreeSendPool.h
+//  assignment-client/src/octree
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_OctreeSendPool_h
+#define overte_OctreeSendPool_h
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+class OctreeSendThread;
+
+/// Fixed set of worker threads running the send passes of non-threaded OctreeSendThreads.
+/// Each sender is a task due once per send interval; due tasks run earliest deadline first, so with more viewers than
+/// workers every viewer falls behind by the same amount rather than some starving.
+class OctreeSendPool {
+public:
+    OctreeSendPool(int numThreads);
+    ~OctreeSendPool();
+
+    int getNumThreads() const { return (int)_threads.size(); }
+    int getNumSenders() const;
+
+    /// Schedules the sender's send passes until one returns false, when the pool emits its finished() signal
+    void add(OctreeSendThread* sender);
+
+    /// Stops scheduling the sender, waiting for a pass in progress to end
+    void remove(OctreeSendThread* sender);
+
+private:
+    class Task {
+    public:
+        quint64 deadline;
+        OctreeSendThread* sender;
+
+        bool operator<(const Task& other) const { return deadline > other.deadline; } // earliest on top of the heap
+    };
+
+    void run();
+
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    std::vector<Task> _tasks; // heap
+    std::unordered_set<OctreeSendThread*> _senders;
+    std::unordered_set<OctreeSendThread*> _running;
+    bool _stopping { false };
+
+    std::vector<std::thread> _threads;
+};
+
+#endif // overte_OctreeSendPool_h
@@ -67,14 +67,40 @@ void OctreeSendThread::setIsShuttingDown() {
 
 
 bool OctreeSendThread::process() {
+    quint64  start = usecTimestampNow();
+
+    if (!processPass()) {
+        return false; // exit early if we're shutting down
+    }
+
+    // Only sleep if we're still running and we got the lock last time we tried, otherwise try to get the lock asap
+    if (isStillRunning()) {
+        // dynamically sleep until we need to fire off the next set of octree elements
+        int elapsed = (usecTimestampNow() - start);
+        int usecToSleep =  OCTREE_SEND_INTERVAL_USECS - elapsed;
+
+        if (usecToSleep <= 0) {
+            const int MIN_USEC_TO_SLEEP = 1;
+            usecToSleep = MIN_USEC_TO_SLEEP;
+        }
+
+        {
+            PerformanceWarning warn(false,"OctreeSendThread... usleep()",false,&_usleepTime,&_usleepCalls);
+            std::this_thread::sleep_for(std::chrono::microseconds(usecToSleep));
+        }
+
+    }
+
+    return isStillRunning();  // keep running till they terminate us
+}
+
+bool OctreeSendThread::processPass() {
     if (_isShuttingDown) {
         return false; // exit early if we're shutting down
     }
 
     OctreeServer::didProcess(this);
 
-    quint64  start = usecTimestampNow();
-
     // we'd better have a server at this point, or we're in trouble
     assert(_myServer);
 
@@ -97,29 +123,7 @@ bool OctreeSendThread::process() {
         }
     }
 
-    if (_isShuttingDown) {
-        return false; // exit early if we're shutting down
-    }
-
-    // Only sleep if we're still running and we got the lock last time we tried, otherwise try to get the lock asap
-    if (isStillRunning()) {
-        // dynamically sleep until we need to fire off the next set of octree elements
-        int elapsed = (usecTimestampNow() - start);
-        int usecToSleep =  OCTREE_SEND_INTERVAL_USECS - elapsed;
-
-        if (usecToSleep <= 0) {
-            const int MIN_USEC_TO_SLEEP = 1;
-            usecToSleep = MIN_USEC_TO_SLEEP;
-        }
-
-        {
-            PerformanceWarning warn(false,"OctreeSendThread... usleep()",false,&_usleepTime,&_usleepCalls);
-            std::this_thread::sleep_for(std::chrono::microseconds(usecToSleep));
-        }
-
-    }
-
-    return isStillRunning();  // keep running till they terminate us
+    return !_isShuttingDown;
 }
 
 AtomicUIntStat OctreeSendThread::_usleepTime { 0 };
@@ -363,9 +367,8 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
 
     quint64 start = usecTimestampNow();
 
-    _myServer->getOctree()->withReadLock([&]{
-        traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
-    });
+    // the tree is only read locked while reading it, not while packets are compressed and sent
+    traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
 
     // Here's where we can/should allow the server to send other data...
     // send the environment packet
@@ -450,7 +453,11 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
         bool lastNodeDidntFit = false; // assume each node fits
         params.stopReason = EncodeBitstreamParams::UNKNOWN; // reset params.stopReason before traversal
 
-        somethingToSend = traverseTreeAndBuildNextPacketPayload(params, nodeData->getJSONParameters());
+        quint64 lockWaitStart = usecTimestampNow();
+        _myServer->getOctree()->withReadLock([&] {
+            OctreeServer::trackTreeWaitTime((float)(usecTimestampNow() - lockWaitStart));
+            somethingToSend = traverseTreeAndBuildNextPacketPayload(params, nodeData->getJSONParameters());
+        });
 
         if (params.stopReason == EncodeBitstreamParams::DIDNT_FIT) {
             lastNodeDidntFit = true;
@@ -465,7 +472,11 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
             if (_packetData.hasContent()) {
                 // yes, more data to send
                 quint64 compressAndWriteStart = usecTimestampNow();
-                unsigned int additionalSize = _packetData.getFinalizedSize() + sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE);
+                int finalizedSize = _packetData.getFinalizedSize();
+                nodeData->stats.sectionCompressed(_packetData.getUncompressedSize(), finalizedSize,
+                    usecTimestampNow() - compressAndWriteStart, !_packetData.getCompressionDictionary().isEmpty());
+
+                unsigned int additionalSize = finalizedSize + sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE);
                 if (additionalSize > nodeData->getAvailable()) {
                     // no room --> flush what we've got
                     _packetsSentThisInterval += handlePacketSend(node, nodeData);
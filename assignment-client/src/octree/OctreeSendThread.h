@@ -38,6 +38,10 @@ public:
 
     QUuid getNodeUuid() const { return _nodeUuid; }
 
+    /// Runs one send pass without sleeping, returns false once the thread should exit
+    /// In non-threaded mode, OctreeSendPool calls this once per send interval
+    bool processPass();
+
     static AtomicUIntStat _totalBytes;
     static AtomicUIntStat _totalWastedBytes;
     static AtomicUIntStat _totalPackets;
@@ -73,7 +77,7 @@ private:
     int _truePacketsSent { 0 }; // available for debug stats
     int _trueBytesSent { 0 }; // available for debug stats
     int _packetsSentThisInterval { 0 }; // used for bandwidth throttle condition
-    bool _isShuttingDown { false };
+    std::atomic<bool> _isShuttingDown { false };
 };
 
 #endif // hifi_OctreeSendThread_h
@@ -34,6 +34,7 @@
 #include <QtCore/QDir>
 
 #include <OctreeDataUtils.h>
+#include <OctreeSnapshot.h>
 #include <ThreadHelpers.h>
 
 Q_LOGGING_CATEGORY(octree_server, "hifi.octree-server")
@@ -255,6 +256,8 @@ OctreeServer::OctreeServer(ReceivedMessage& message) :
 
 OctreeServer::~OctreeServer() {
     qDebug() << qPrintable(_safeServerName) << "server shutting down... [" << this << "]";
+    // no send passes run past this point
+    _sendPool.reset();
     if (_parsedArgV) {
         for (int i = 0; i < _argc; i++) {
             delete[] _parsedArgV[i];
@@ -428,6 +431,10 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
 
         statsString += QString("          Total Clients Connected: %1 clients\r\n")
             .arg(locale.toString((uint)getCurrentClientCount()).rightJustified(COLUMN_WIDTH, ' '));
+        if (_sendPool) {
+            statsString += QString("                Send Pool Threads: %1 threads\r\n")
+                .arg(locale.toString((uint)_sendPool->getNumThreads()).rightJustified(COLUMN_WIDTH, ' '));
+        }
 
         quint64 oneSecondAgo = usecTimestampNow() - USECS_PER_SECOND;
 
@@ -686,6 +693,8 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         quint64 averageCreateTime = _tree->getAverageCreateTime();
         quint64 averageLoggingTime = _tree->getAverageLoggingTime();
         quint64 averageFilterTime = _tree->getAverageFilterTime();
+        quint64 totalEditBatches = _octreeInboundPacketProcessor->getTotalEditBatches();
+        quint64 totalSupersededEdits = _tree->getTotalSupersededEdits();
 
         int FLOAT_PRECISION = 3;
 
@@ -704,6 +713,10 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             .arg(locale.toString((uint)totalElementsProcessed).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString(" Average Inbound Elements/Packet: %f elements/packet\r\n")
                                .arg((double)averageElementsPerPacket);
+        statsString += QString("              Total Edit Batches: %1 batches\r\n")
+            .arg(locale.toString((uint)totalEditBatches).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("          Total Superseded Edits: %1 elements\r\n")
+            .arg(locale.toString((uint)totalSupersededEdits).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString("     Average Transit Time/Packet: %1 usecs\r\n")
             .arg(locale.toString((uint)averageTransitTimePerPacket).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString("     Average Process Time/Packet: %1 usecs\r\n")
@@ -905,17 +918,33 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
     auto sendThread = newSendThread(node);
 
     // we want to be notified when the thread finishes
-    connect(sendThread.get(), &GenericThread::finished, this, &OctreeServer::removeSendThread);
-    sendThread->initialize(true);
+    connect(sendThread.get(), &GenericThread::finished, this, &OctreeServer::removeSendThread, Qt::QueuedConnection);
+    if (_sendPool) {
+        sendThread->initialize(false);
+        _sendPool->add(sendThread.get());
+    } else {
+        sendThread->initialize(true);
+    }
 
     return sendThread;
 }
 
+void OctreeServer::eraseSendThread(SendThreads::iterator it) {
+    if (_sendPool) {
+        // wait for a send pass in progress before destroying it
+        _sendPool->remove(it->second.get());
+    }
+    // This deletes the unique_ptr, so the send thread is destructed after that line
+    _sendThreads.erase(it);
+}
+
 void OctreeServer::removeSendThread() {
     // If the object has been deleted since the event was queued, sender() will return nullptr
     if (auto sendThread = qobject_cast<OctreeSendThread*>(sender())) {
-        // This deletes the unique_ptr, so sendThread is destructed after that line
-        _sendThreads.erase(sendThread->getNodeUuid());
+        auto it = _sendThreads.find(sendThread->getNodeUuid());
+        if (it != _sendThreads.end() && it->second.get() == sendThread) {
+            eraseSendThread(it);
+        }
     }
 }
 
@@ -930,7 +959,7 @@ void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> messa
         if (it == _sendThreads.end()) {
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
         } else if (it->second->isShuttingDown()) {
-            _sendThreads.erase(it); // Remove right away and wait on thread to be
+            eraseSendThread(it); // Remove right away and wait on thread to be
 
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
         }
@@ -1077,7 +1106,16 @@ void OctreeServer::readConfiguration() {
         qDebug() << "persistFilePath=" << _persistFilePath;
         qDebug() << "persisAbsoluteFilePath=" << _persistAbsoluteFilePath;
 
-        _persistAsFileType = "json.gz";
+        // the binary snapshot loads and persists faster than json.gz, which remains the format sent to the DS
+        bool persistBinarySnapshot = false;
+        readOptionBool(QString("persistBinarySnapshot"), settingsSectionObject, persistBinarySnapshot);
+        _persistAsFileType = persistBinarySnapshot ? OctreeSnapshot::EXTENSION : "json.gz";
+        qDebug() << "persistAsFileType=" << _persistAsFileType;
+
+        // journal edits between full persists, which then only happen as compactions of the journal
+        _persistJournal = false;
+        readOptionBool(QString("persistJournal"), settingsSectionObject, _persistJournal);
+        qDebug() << "persistJournal=" << _persistJournal;
 
         _persistInterval = OctreePersistThread::DEFAULT_PERSIST_INTERVAL;
         int result { -1 };
@@ -1126,6 +1164,14 @@ void OctreeServer::readConfiguration() {
     qDebug("packetsPerSecondTotalMax=%d _packetsTotalPerInterval=%d",
                     packetsPerSecondTotalMax, _packetsTotalPerInterval);
 
+    // send to all viewers from a pool of a thread per core, 0 sends to each viewer from a thread of its own
+    int sendThreadPoolSize = QThread::idealThreadCount();
+    readOptionInt(QString("sendThreadPoolSize"), settingsSectionObject, sendThreadPoolSize);
+    if (sendThreadPoolSize > 0 && !_sendPool) {
+        _sendPool = std::make_unique<OctreeSendPool>(sendThreadPoolSize);
+    }
+    qDebug("sendThreadPoolSize=%d", sendThreadPoolSize);
+
 
     readAdditionalConfiguration(settingsSectionObject);
 }
@@ -1218,7 +1264,7 @@ void OctreeServer::domainSettingsRequestComplete() {
 
         // now set up PersistThread
         _persistManager = new OctreePersistThread(_tree, _persistAbsoluteFilePath, _persistInterval, _debugTimestampNow,
-                                                 _persistAsFileType);
+                                                 _persistAsFileType, _persistJournal);
         _persistManager->moveToThread(&_persistThread);
         connect(&_persistThread, &QThread::finished, _persistManager, &QObject::deleteLater);
         connect(&_persistThread, &QThread::started, _persistManager, [this] {
@@ -1327,6 +1373,9 @@ void OctreeServer::aboutToFinish() {
     for (auto& it : _sendThreads) {
         auto& sendThread = *it.second;
         sendThread.setIsShuttingDown();
+        if (_sendPool) {
+            _sendPool->remove(&sendThread);
+        }
         sendThread.terminate();
     }
 
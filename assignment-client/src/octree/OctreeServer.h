@@ -24,6 +24,7 @@
 #include <ThreadedAssignment.h>
 
 #include "OctreePersistThread.h"
+#include "OctreeSendPool.h"
 #include "OctreeSendThread.h"
 #include "OctreeServerConsts.h"
 #include "OctreeInboundPacketProcessor.h"
@@ -168,6 +169,7 @@ protected:
     void beginRunning();
     
     UniqueSendThread createSendThread(const SharedNodePointer& node);
+    void eraseSendThread(SendThreads::iterator it);
     virtual UniqueSendThread newSendThread(const SharedNodePointer& node) = 0;
 
     int _argc;
@@ -184,6 +186,7 @@ protected:
     QString _persistFilePath;
     QString _persistAbsoluteFilePath;
     QString _persistAsFileType;
+    bool _persistJournal { false };
     int _packetsPerClientPerInterval;
     int _packetsTotalPerInterval;
     OctreePointer _tree; // this IS a reaveraging tree
@@ -204,6 +207,7 @@ protected:
     quint64 _startedUSecs;
     QString _safeServerName;
     
+    std::unique_ptr<OctreeSendPool> _sendPool; // null when each send thread runs on a thread of its own
     SendThreads _sendThreads;
 
     static int _clientCount;
@@ -15,6 +15,8 @@
 
 #include <mutex>
 
+#include <QtCore/QThread>
+
 #include <AudioConstants.h>
 #include <AudioScriptingInterface.h>
 #include <AudioInjectorManager.h>
@@ -44,8 +46,34 @@
 using Mutex = std::mutex;
 using Lock = std::lock_guard<Mutex>;
 
+// Routes the calls into the entity scripts to the engine that runs them, which queues them on its own thread
+class ShardedEntitiesScriptEngine : public EntitiesScriptEngineProvider {
+public:
+    using Shard = std::function<ScriptManagerPointer(const EntityItemID&)>;
+    ShardedEntitiesScriptEngine(const Shard& shard) : _shard(shard) {}
+
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const QStringList& params, const QUuid& remoteCallerID) override {
+        auto manager = _shard(entityID);
+        if (manager) {
+            manager->callEntityScriptMethod(entityID, methodName, params, remoteCallerID);
+        }
+    }
+
+    QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override {
+        auto manager = _shard(entityID);
+        if (manager) {
+            return manager->getLocalEntityScriptDetails(entityID);
+        }
+        return QFuture<QVariant>();
+    }
+
+private:
+    const Shard _shard;
+};
+
 void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message) {
-    auto logMessage = LogHandler::getInstance().printMessage((LogMsgType) type, context, message);
+    LogHandler::getInstance().queueMessage((LogMsgType) type, context, message);
 }
 
 int EntityScriptServer::_entitiesScriptEngineCount = 0;
@@ -126,10 +154,21 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptManager->getEntityScriptDetails(entityID, details)) {
+        auto scriptManager = getEntitiesScriptManager(entityID);
+        if (scriptManager && scriptManager->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
+            replyPacketList->writePrimitive(details.cpuTime);
+            replyPacketList->writePrimitive(details.threadCPUTime);
+            replyPacketList->writePrimitive(details.callCount);
+            // the engine may be running other entity scripts too
+            ScriptEngineProfilingStatistics engineStatistics = scriptManager->engine()->getProfilingStatistics();
+            replyPacketList->writePrimitive((quint64)engineStatistics.usedHeapSize);
+            replyPacketList->writePrimitive(engineStatistics.gcCount);
+            replyPacketList->writePrimitive(engineStatistics.gcPauseTime);
+            replyPacketList->writePrimitive((qint32)scriptManager->getNumTimers());
+            replyPacketList->writePrimitive((qint32)engineStatistics.numSignalConnections);
         } else {
             replyPacketList->writePrimitive(false);
         }
@@ -171,10 +210,37 @@ void EntityScriptServer::handleSettings() {
 
     qDebug() << QString("Received entity script server settings, Max Entity PPS: %1, Entity PPS Per Entity Script: %2")
                 .arg(_maxEntityPPS).arg(_entityPPSPerScript);
+
+    // the number of engines the entity scripts are spread over, 0 for one per core
+    static const QString SCRIPT_ENGINES_OPTION = "script_engines";
+    if (entityScriptServerSettings.contains(SCRIPT_ENGINES_OPTION)) {
+        int numEngines = entityScriptServerSettings[SCRIPT_ENGINES_OPTION].toInt();
+        if (numEngines <= 0) {
+            numEngines = QThread::idealThreadCount();
+        }
+        numEngines = std::max(1, numEngines);
+        if (numEngines != _numEntitiesScriptEngines) {
+            _numEntitiesScriptEngines = numEngines;
+            qDebug() << "Entity scripts will run in" << _numEntitiesScriptEngines << "script engines";
+
+            // the scripts stay in the engine they were loaded in, the engines are only replaced while none is loaded
+            int numScripts = 0;
+            for (const auto& manager : _entitiesScriptManagers) {
+                numScripts += manager->getNumRunningEntityScripts();
+            }
+            if (numScripts == 0 && !_entitiesScriptManagers.empty() && !_shuttingDown) {
+                stopEntitiesScriptEngines();
+                resetEntitiesScriptEngines();
+            }
+        }
+    }
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptManager->getNumRunningEntityScripts();
+    int numRunningScripts = 0;
+    for (const auto& manager : _entitiesScriptManagers) {
+        numRunningScripts += manager->getNumRunningEntityScripts();
+    }
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplication would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -246,7 +312,7 @@ void EntityScriptServer::addLogEntry(const QString& message, const QString& file
 
 void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
 
-    if (_entitiesScriptManager && _entityViewer.getTree() && !_shuttingDown) {
+    if (!_entitiesScriptManagers.empty() && _entityViewer.getTree() && !_shuttingDown) {
         auto entityID = QUuid::fromRfc4122(receivedMessage->read(NUM_BYTES_RFC4122_UUID));
 
         auto method = receivedMessage->readString();
@@ -260,7 +326,7 @@ void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<Recei
             params << paramString;
         }
 
-        _entitiesScriptManager->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
+        getEntitiesScriptManager(entityID)->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
     }
 }
 
@@ -291,8 +357,8 @@ void EntityScriptServer::run() {
         NodeType::EntityServer, NodeType::MessagesMixer, NodeType::AssetServer
     });
 
-    // Setup Script Engine
-    resetEntitiesScriptEngine();
+    // Setup Script Engines
+    resetEntitiesScriptEngines();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     entityScriptingInterface->init();
@@ -454,7 +520,7 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
+ScriptManagerPointer EntityScriptServer::createEntitiesScriptEngine() {
     auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
     auto newManager = scriptManagerFactory(ScriptManager::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
     auto newEngine = newManager->engine();
@@ -495,50 +561,81 @@ void EntityScriptServer::resetEntitiesScriptEngine() {
                 addLogEntry(message, fileName, lineNumber, entityID, ScriptMessage::Severity::SEVERITY_WARNING);
             });
 
-    connect(newManager.get(), &ScriptManager::update, this, [this] {
+    scriptEngines->runScriptInitializers(newManager);
+    newManager->runInThread();
+
+    connect(newManager.get(), &ScriptManager::entityScriptDetailsUpdated,
+            this, &EntityScriptServer::updateEntityPPS);
+    return newManager;
+}
+
+void EntityScriptServer::resetEntitiesScriptEngines() {
+    for (const auto& manager : _entitiesScriptManagers) {
+        disconnect(manager.get(), &ScriptManager::entityScriptDetailsUpdated,
+                   this, &EntityScriptServer::updateEntityPPS);
+    }
+
+    std::vector<ScriptManagerPointer> newManagers;
+    for (int i = 0; i < _numEntitiesScriptEngines; i++) {
+        newManagers.push_back(createEntitiesScriptEngine());
+    }
+
+    // the tree is updated once per frame, by the first engine
+    connect(newManagers.front().get(), &ScriptManager::update, this, [this] {
         _entityViewer.queryOctree();
         _entityViewer.getTree()->preUpdate();
         _entityViewer.getTree()->update();
     });
 
-    scriptEngines->runScriptInitializers(newManager);
-    newManager->runInThread();
-    std::shared_ptr<EntitiesScriptEngineProvider> newEngineSP = newManager;
+    std::shared_ptr<EntitiesScriptEngineProvider> newEngineSP;
+    if (newManagers.size() == 1) {
+        newEngineSP = newManagers.front();
+    } else {
+        newEngineSP = std::make_shared<ShardedEntitiesScriptEngine>([managers = newManagers](const EntityItemID& entityID) {
+            return managers[qHash(entityID) % managers.size()];
+        });
+    }
     // On the entity script server, these are the same
     DependencyManager::get<EntityScriptingInterface>()->setPersistentEntitiesScriptEngine(newEngineSP);
     DependencyManager::get<EntityScriptingInterface>()->setNonPersistentEntitiesScriptEngine(newEngineSP);
 
-    if (_entitiesScriptManager) {
-        disconnect(_entitiesScriptManager.get(), &ScriptManager::entityScriptDetailsUpdated,
-                   this, &EntityScriptServer::updateEntityPPS);
+    _entitiesScriptManagers.swap(newManagers);
+}
+
+ScriptManagerPointer EntityScriptServer::getEntitiesScriptManager(const EntityItemID& entityID) const {
+    if (_entitiesScriptManagers.empty()) {
+        return nullptr;
     }
+    return _entitiesScriptManagers[qHash(entityID) % _entitiesScriptManagers.size()];
+}
 
-    _entitiesScriptManager.swap(newManager);
-    connect(_entitiesScriptManager.get(), &ScriptManager::entityScriptDetailsUpdated,
-            this, &EntityScriptServer::updateEntityPPS);
+void EntityScriptServer::stopEntitiesScriptEngines() {
+    // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
+    for (const auto& manager : _entitiesScriptManagers) {
+        manager->unloadAllEntityScripts();
+        manager->stop();
+    }
+    for (const auto& manager : _entitiesScriptManagers) {
+        manager->waitTillDoneRunning();
+    }
 }
 
 
 void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptManager) {
-        // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptManager->unloadAllEntityScripts();
-        _entitiesScriptManager->stop();
-        _entitiesScriptManager->waitTillDoneRunning();
-    }
+    // unload and stop the engines
+    stopEntitiesScriptEngines();
 
     _entityViewer.clear();
 
-    // reset the engine
+    // reset the engines
     if (!_shuttingDown) {
-        resetEntitiesScriptEngine();
+        resetEntitiesScriptEngines();
     }
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptManager) {
-        _entitiesScriptManager->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    for (const auto& manager : _entitiesScriptManagers) {
+        manager->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
     }
     _shuttingDown = true;
 
@@ -547,7 +644,7 @@ void EntityScriptServer::shutdownScriptEngine() {
     auto scriptEngines = DependencyManager::get<ScriptEngines>();
     scriptEngines->shutdownScripting();
 
-    _entitiesScriptManager.reset();
+    _entitiesScriptManagers.clear();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
@@ -565,8 +662,9 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptManager) {
-        _entitiesScriptManager->unloadEntityScript(entityID, true);
+    auto scriptManager = getEntitiesScriptManager(entityID);
+    if (_entityViewer.getTree() && !_shuttingDown && scriptManager) {
+        scriptManager->unloadEntityScript(entityID, true);
     }
 }
 
@@ -577,20 +675,21 @@ void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, bool forceRedownload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptManager) {
+    auto scriptManager = getEntitiesScriptManager(entityID);
+    if (_entityViewer.getTree() && !_shuttingDown && scriptManager) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool isRunning = _entitiesScriptManager->getEntityScriptDetails(entityID, details);
+        bool isRunning = scriptManager->getEntityScriptDetails(entityID, details);
         if (entity && (forceRedownload || !isRunning || details.scriptText != entity->getServerScripts())) {
             if (isRunning) {
-                _entitiesScriptManager->unloadEntityScript(entityID, true);
+                scriptManager->unloadEntityScript(entityID, true);
             }
 
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = DependencyManager::get<ResourceManager>()->normalizeURL(scriptUrl);
-                _entitiesScriptManager->loadEntityScript(entityID, scriptUrl, forceRedownload);
+                scriptManager->loadEntityScript(entityID, scriptUrl, forceRedownload);
             }
         }
     }
@@ -607,11 +706,28 @@ void EntityScriptServer::sendStatsPacket() {
 
     QJsonObject scriptEngineStats;
     int numberRunningScripts = 0;
-    const auto scriptManager = _entitiesScriptManager;
-    if (scriptManager) {
-        numberRunningScripts = scriptManager->getNumRunningEntityScripts();
+    QJsonArray enginesStats;
+    const auto scriptManagers = _entitiesScriptManagers;
+    for (const auto& scriptManager : scriptManagers) {
+        QJsonObject engineStats;
+        int numberEngineScripts = scriptManager->getNumRunningEntityScripts();
+        engineStats["number_running_scripts"] = numberEngineScripts;
+        engineStats["script_time_ms"] = (double)scriptManager->getEntityScriptsCPUTime() / USECS_PER_MSEC;
+        engineStats["number_timers"] = scriptManager->getNumTimers();
+        engineStats["timer_time_ms"] = (double)scriptManager->getTimerDispatchTime() / USECS_PER_MSEC;
+        ScriptEngineProfilingStatistics engineStatistics = scriptManager->engine()->getProfilingStatistics();
+        engineStats["heap_used_bytes"] = (double)engineStatistics.usedHeapSize;
+        engineStats["heap_total_bytes"] = (double)engineStatistics.totalHeapSize;
+        engineStats["gc_count"] = (double)engineStatistics.gcCount;
+        engineStats["gc_pause_ms"] = (double)engineStatistics.gcPauseTime / USECS_PER_MSEC;
+        engineStats["number_signal_connections"] = engineStatistics.numSignalConnections;
+        engineStats["signal_calls"] = (double)engineStatistics.signalCallCount;
+        engineStats["signal_time_ms"] = (double)engineStatistics.signalCallTime / USECS_PER_MSEC;
+        enginesStats.append(engineStats);
+        numberRunningScripts += numberEngineScripts;
     }
     scriptEngineStats["number_running_scripts"] = numberRunningScripts;
+    scriptEngineStats["engines"] = enginesStats;
     statsObject["script_engine_stats"] = scriptEngineStats;
 
 
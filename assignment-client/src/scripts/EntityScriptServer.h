@@ -90,7 +90,11 @@ private:
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
 
-    void resetEntitiesScriptEngine();
+    void resetEntitiesScriptEngines();
+    ScriptManagerPointer createEntitiesScriptEngine();
+    void stopEntitiesScriptEngines();
+    // the engine that runs the script of an entity, or nullptr
+    ScriptManagerPointer getEntitiesScriptManager(const EntityItemID& entityID) const;
     void clear();
     void shutdownScriptEngine();
 
@@ -104,7 +108,9 @@ private:
     bool _shuttingDown { false };
 
     static int _entitiesScriptEngineCount;
-    ScriptManagerPointer _entitiesScriptManager;
+    // The entity scripts are spread over the engines by their entity ID, each engine runs on its own thread
+    std::vector<ScriptManagerPointer> _entitiesScriptManagers;
+    int _numEntitiesScriptEngines { 1 };
     SimpleEntitySimulationPointer _entitySimulation;
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
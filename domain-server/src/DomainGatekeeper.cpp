@@ -13,27 +13,32 @@
 
 #include "DomainGatekeeper.h"
 
-#include <openssl/err.h>
-#include <openssl/rsa.h>
-#include <openssl/x509.h>
+#include <algorithm>
 #include <random>
 
 #include <QtCore/QDataStream>
 #include <QtCore/QMetaMethod>
+#include <QtCore/QThread>
 
 #include <AccountManager.h>
 #include <Assignment.h>
+#include <PortableHighResolutionClock.h>
 
 #include "DomainServer.h"
 #include "DomainServerNodeData.h"
-#include "WarningsSuppression.h"
 
 using SharedAssignmentPointer = QSharedPointer<Assignment>;
 
+// a public key that's younger than this isn't requested again when its user connects, it's only requested again if a
+// signature doesn't verify with it
+const quint64 USER_PUBLIC_KEY_TTL_USECS = 10 * 60 * USECS_PER_SECOND;
+
 DomainGatekeeper::DomainGatekeeper(DomainServer* server) :
     _server(server)
 {
     initLocalIDManagement();
+
+    _signatureVerificationPool.setMaxThreadCount(std::max(QThread::idealThreadCount() - 1, 1));
 }
 
 void DomainGatekeeper::addPendingAssignedNode(const QUuid& nodeUUID, const QUuid& assignmentUUID, const QString& nodeVersion) {
@@ -124,7 +129,7 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
             }
         }
 
-        node = processAgentConnectRequest(nodeConnection, username, usernameSignature,
+        node = processAgentConnectRequest(message, nodeConnection, username, usernameSignature,
                                           domainUsername, domainTokens.value(0), domainTokens.value(1));
     }
 
@@ -152,9 +157,15 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
             << "previous connection uptime" << nodeConnection.previousConnectionUpTime/USECS_PER_MSEC << "msec"
             << "sysinfo" << nodeConnection.SystemInfo;
 
+        qint64 now = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
+        _admissionLatency.record(std::max(now - message->getFirstPacketReceiveTime(), (qint64)0));
+
         // signal that we just connected a node so the DomainServer can get it a list
         // and broadcast its presence right away
         emit connectedNode(node, message->getFirstPacketReceiveTime());
+    } else if (isSignatureVerificationPending(username)) {
+        qDebug() << "Delaying connection from node at" << message->getSenderSockAddr()
+            << "until the username signature of" << username << "is verified";
     } else {
         qDebug() << "Refusing connection from node at" << message->getSenderSockAddr()
             << "with hardware address" << nodeConnection.hardwareAddress
@@ -378,7 +389,12 @@ void DomainGatekeeper::updateNodePermissions() {
                                               connectingAddr.getAddress(), hardwareAddress, machineFingerprint);
         }
 
+        bool permissionsChanged = node->getPermissions().permissions != userPerms.permissions;
         node->setPermissions(userPerms);
+        if (permissionsChanged) {
+            // the nodes that check in next hear about the new permissions in their deltas
+            _server->markNodeListChanged(node);
+        }
 
         if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
             qDebug() << "node" << node->getUUID() << "no longer has permission to connect.";
@@ -459,7 +475,8 @@ const QString AUTHENTICATION_PLUGIN_CLIENT_ID = "authentication.plugin_client_id
 const QString MAXIMUM_USER_CAPACITY = "security.maximum_user_capacity";
 const QString MAXIMUM_USER_CAPACITY_REDIRECT_LOCATION = "security.maximum_user_capacity_redirect_location";
 
-SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnectionData& nodeConnection,
+SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const QSharedPointer<ReceivedMessage>& message,
+                                                               const NodeConnectionData& nodeConnection,
                                                                const QString& username,
                                                                const QByteArray& usernameSignature,
                                                                const QString& domainUsername,
@@ -494,18 +511,25 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
             if (!domainHasLogin() || domainUsername.isEmpty()) {
                 return SharedNodePointer();
             }
-        } else if (verifyUserSignature(username, usernameSignature, nodeConnection.senderSockAddr)) {
-            // they sent us a username and the signature verifies it
-            getGroupMemberships(username);
-            verifiedUsername = username.toLower();
         } else {
-            // they sent us a username, but it didn't check out
-            requestUserPublicKey(username);
+            auto signatureCheck = verifyUserSignature(username, usernameSignature, nodeConnection.senderSockAddr, message);
+
+            if (signatureCheck == SignatureCheck::Verified) {
+                // they sent us a username and the signature verifies it
+                getGroupMemberships(username);
+                verifiedUsername = username.toLower();
+            } else if (signatureCheck == SignatureCheck::Pending) {
+                // the request comes back here once the signature has been verified on the pool
+                return SharedNodePointer();
+            } else {
+                // they sent us a username, but it didn't check out
+                requestUserPublicKey(username);
 #ifdef WANT_DEBUG
-            qDebug() << "stalling login because signature verification failed:" << username;
+                qDebug() << "stalling login because signature verification failed:" << username;
 #endif
-            if (!domainHasLogin() || domainUsername.isEmpty()) {
-                return SharedNodePointer();
+                if (!domainHasLogin() || domainUsername.isEmpty()) {
+                    return SharedNodePointer();
+                }
             }
         }
     }
@@ -686,68 +710,57 @@ void DomainGatekeeper::cleanupICEPeerForNode(const QUuid& nodeID) {
     }
 }
 
-bool DomainGatekeeper::verifyUserSignature(const QString& username,
-                                           const QByteArray& usernameSignature,
-                                           const SockAddr& senderSockAddr) {
+DomainGatekeeper::SignatureCheck DomainGatekeeper::verifyUserSignature(const QString& username,
+                                                                       const QByteArray& usernameSignature,
+                                                                       const SockAddr& senderSockAddr,
+                                                                       const QSharedPointer<ReceivedMessage>& message) {
     // it's possible this user can be allowed to connect, but we need to check their username signature
     auto lowerUsername = username.toLower();
-    KeyFlagPair publicKeyPair = _userPublicKeys.value(lowerUsername);
-
-    QByteArray publicKeyArray = publicKeyPair.first;
-    bool isOptimisticKey = publicKeyPair.second;
+    UserPublicKey publicKey = _userPublicKeys.value(lowerUsername);
 
     const QUuid& connectionToken = _connectionTokenHash.value(lowerUsername);
 
-    if (!publicKeyArray.isEmpty() && !connectionToken.isNull()) {
+    if (!publicKey.key.isEmpty() && !connectionToken.isNull()) {
         // if we do have a public key for the user, check for a signature match
 
-        const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(publicKeyArray.constData());
-
-        OVERTE_IGNORE_DEPRECATED_BEGIN
-
-        // first load up the public key into an RSA struct
-        RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, publicKeyArray.size());
+        auto verification = _signatureVerifications.find(lowerUsername);
+        if (verification == _signatureVerifications.end() || verification->publicKey != publicKey.key
+                || verification->signature != usernameSignature || verification->connectionToken != connectionToken) {
+            // the RSA verification happens on the pool, this request is processed again once it's done
+            startSignatureVerification(lowerUsername, publicKey.key, usernameSignature, connectionToken, message);
+            return SignatureCheck::Pending;
+        }
 
-        QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
-        QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
-                                                                QCryptographicHash::Sha256);
+        if (verification->isPending) {
+            // the client sent its request again in the meantime, the latest one is processed once it's verified
+            verification->message = message;
+            return SignatureCheck::Pending;
+        }
 
-        if (rsaPublicKey) {
-            int decryptResult = RSA_verify(NID_sha256,
-                                           reinterpret_cast<const unsigned char*>(usernameWithToken.constData()),
-                                           usernameWithToken.size(),
-                                           reinterpret_cast<const unsigned char*>(usernameSignature.constData()),
-                                           usernameSignature.size(),
-                                           rsaPublicKey);
+        auto result = verification->result;
+        _signatureVerifications.erase(verification);
 
-            if (decryptResult == 1) {
-                qDebug() << "Username signature matches for" << username;
+        if (result == SignatureVerificationTask::Result::Verified) {
+            qDebug() << "Username signature matches for" << username;
 
-                // free up the public key and remove connection token before we return
-                RSA_free(rsaPublicKey);
-                _connectionTokenHash.remove(username);
+            // remove connection token before we return
+            _connectionTokenHash.remove(username);
 
-                return true;
+            return SignatureCheck::Verified;
 
-            } else {
-                // we only send back a LoginErrorMetaverse if this wasn't an "optimistic" key
-                // (a key that we hoped would work but is probably stale)
-
-                if (!senderSockAddr.isNull() && !isOptimisticKey) {
-                    qDebug() << "Error decrypting directory services username signature for" << username << "- denying connection.";
-                    sendConnectionDeniedPacket("Error decrypting username signature.", senderSockAddr,
-                        DomainHandler::ConnectionRefusedReason::LoginErrorMetaverse);
-                } else if (!senderSockAddr.isNull()) {
-                    qDebug() << "Error decrypting directory services username signature for" << username << "with optimistic key -"
-                        << "re-requesting public key and delaying connection";
-                }
+        } else if (result == SignatureVerificationTask::Result::SignatureMismatch) {
+            // we only send back a LoginErrorMetaverse if this wasn't an "optimistic" key
+            // (a key that we hoped would work but is probably stale)
 
-                // free up the public key, we don't need it anymore
-                RSA_free(rsaPublicKey);
+            if (!senderSockAddr.isNull() && !publicKey.isOptimistic) {
+                qDebug() << "Error decrypting directory services username signature for" << username << "- denying connection.";
+                sendConnectionDeniedPacket("Error decrypting username signature.", senderSockAddr,
+                    DomainHandler::ConnectionRefusedReason::LoginErrorMetaverse);
+            } else if (!senderSockAddr.isNull()) {
+                qDebug() << "Error decrypting directory services username signature for" << username << "with optimistic key -"
+                    << "re-requesting public key and delaying connection";
             }
 
-            OVERTE_IGNORE_DEPRECATED_END
-
         } else {
 
             // we can't let this user in since we couldn't convert their public key to an RSA key we could use
@@ -764,7 +777,77 @@ bool DomainGatekeeper::verifyUserSignature(const QString& username,
     }
 
     requestUserPublicKey(username); // no joy.  maybe next time?
-    return false;
+    return SignatureCheck::Failed;
+}
+
+void DomainGatekeeper::startSignatureVerification(const QString& lowerUsername, const QByteArray& publicKey,
+                                                  const QByteArray& usernameSignature, const QUuid& connectionToken,
+                                                  const QSharedPointer<ReceivedMessage>& message) {
+    QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
+    QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
+                                                            QCryptographicHash::Sha256);
+
+    // a verification that's still running for an older signature or key is superseded, its result is ignored
+    quint32 verificationID = _nextSignatureVerificationID++;
+    SignatureVerification& verification = _signatureVerifications[lowerUsername];
+    verification = SignatureVerification();
+    verification.id = verificationID;
+    verification.publicKey = publicKey;
+    verification.signature = usernameSignature;
+    verification.connectionToken = connectionToken;
+    verification.message = message;
+
+    auto task = new SignatureVerificationTask(publicKey, usernameWithToken, usernameSignature,
+        [this, lowerUsername, verificationID](SignatureVerificationTask::Result result, quint64 verificationUsecs) {
+            QMetaObject::invokeMethod(this, [=] {
+                finishSignatureVerification(lowerUsername, verificationID, result, verificationUsecs);
+            }, Qt::QueuedConnection);
+        });
+    _signatureVerificationPool.start(task);
+}
+
+void DomainGatekeeper::finishSignatureVerification(const QString& lowerUsername, quint32 verificationID,
+                                                   SignatureVerificationTask::Result result, quint64 verificationUsecs) {
+    _signatureVerificationTime.record(verificationUsecs);
+
+    auto verification = _signatureVerifications.find(lowerUsername);
+    if (verification == _signatureVerifications.end() || verification->id != verificationID) {
+        return;
+    }
+
+    verification->isPending = false;
+    verification->result = result;
+
+    // the connect request now goes through with the result of the verification
+    auto message = verification->message;
+    verification->message.clear();
+    if (message) {
+        processConnectRequestPacket(message);
+    }
+}
+
+bool DomainGatekeeper::isSignatureVerificationPending(const QString& username) const {
+    auto verification = _signatureVerifications.find(username.toLower());
+    return verification != _signatureVerifications.end() && verification->isPending;
+}
+
+QJsonObject DomainGatekeeper::getAdmissionStats() const {
+    int pendingVerifications = 0;
+    for (const auto& verification : _signatureVerifications) {
+        if (verification.isPending) {
+            ++pendingVerifications;
+        }
+    }
+
+    QJsonObject stats;
+    stats["latency_usecs"] = _admissionLatency.toJson();
+    stats["signature_verification_usecs"] = _signatureVerificationTime.toJson();
+    stats["pending_signature_verifications"] = pendingVerifications;
+    stats["cached_public_keys"] = _userPublicKeys.size();
+    stats["public_key_cache_hits"] = (double)_publicKeyCacheHits;
+    stats["public_key_requests"] = (double)_publicKeyRequests;
+    stats["public_key_requests_in_flight"] = _inFlightPublicKeyRequests.size();
+    return stats;
 }
 
 
@@ -817,9 +900,22 @@ void DomainGatekeeper::requestUserPublicKey(const QString& username, bool isOpti
         // public-key request for this username is already flight, not rerequesting
         return;
     }
+
+    if (isOptimistic) {
+        // a key that we got recently is kept until a signature fails to verify with it.  It's used as an optimistic key,
+        // the user may have uploaded a new one since.
+        auto publicKey = _userPublicKeys.find(lowerUsername);
+        if (publicKey != _userPublicKeys.end() && usecTimestampNow() - publicKey->receivedTime < USER_PUBLIC_KEY_TTL_USECS) {
+            publicKey->isOptimistic = true;
+            ++_publicKeyCacheHits;
+            return;
+        }
+    }
+
     _inFlightPublicKeyRequests.insert(lowerUsername, isOptimistic);
+    ++_publicKeyRequests;
 
-    // even if we have a public key for them right now, request a new one in case it has just changed
+    // even if we have an older public key for them right now, request a new one in case it has just changed
     JSONCallbackParameters callbackParams;
     callbackParams.callbackReceiver = this;
     callbackParams.jsonCallbackMethod = "publicKeyJSONCallback";
@@ -859,11 +955,10 @@ void DomainGatekeeper::publicKeyJSONCallback(QNetworkReply* requestReply) {
 
         qDebug().nospace() << "Extracted " << (isOptimisticKey ? "optimistic " : " ") << "public key for " << username.toLower();
 
-        _userPublicKeys[username.toLower()] =
-            {
-                QByteArray::fromBase64(jsonObject[JSON_DATA_KEY].toObject()[JSON_PUBLIC_KEY_KEY].toString().toUtf8()),
-                isOptimisticKey
-            };
+        UserPublicKey& publicKey = _userPublicKeys[username.toLower()];
+        publicKey.key = QByteArray::fromBase64(jsonObject[JSON_DATA_KEY].toObject()[JSON_PUBLIC_KEY_KEY].toString().toUtf8());
+        publicKey.isOptimistic = isOptimisticKey;
+        publicKey.receivedTime = usecTimestampNow();
     }
 }
 
@@ -18,18 +18,22 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include <QtCore/QJsonObject>
 #include <QtCore/QObject>
 #include <QtNetwork/QNetworkReply>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
 
 #include <DomainHandler.h>
 
 #include <NLPacket.h>
 #include <Node.h>
+#include <PacketTrafficStats.h>
 #include <UUIDHasher.h>
 
 #include "NodeConnectionData.h"
 #include "PendingAssignedNodeData.h"
+#include "SignatureVerificationTask.h"
 
 const QString DOMAIN_GROUP_CHAR = "@";
 
@@ -48,6 +52,9 @@ public:
     Node::LocalID findOrCreateLocalID(const QUuid& uuid);
 
     static void sendProtocolMismatchConnectionDenial(const SockAddr& senderSockAddr);
+
+    /// Returns the latencies of the connect requests and their signature verifications, and the public key cache counts
+    QJsonObject getAdmissionStats() const;
 public slots:
     void processConnectRequestPacket(QSharedPointer<ReceivedMessage> message);
     void processICEPingPacket(QSharedPointer<ReceivedMessage> message);
@@ -81,7 +88,8 @@ private slots:
 private:
     SharedNodePointer processAssignmentConnectRequest(const NodeConnectionData& nodeConnection,
                                                       const PendingAssignedNodeData& pendingAssignment);
-    SharedNodePointer processAgentConnectRequest(const NodeConnectionData& nodeConnection,
+    SharedNodePointer processAgentConnectRequest(const QSharedPointer<ReceivedMessage>& message,
+                                                 const NodeConnectionData& nodeConnection,
                                                  const QString& username,
                                                  const QByteArray& usernameSignature,
                                                  const QString& domainUsername,
@@ -89,8 +97,20 @@ private:
                                                  const QString& domainRefreshToken);
     SharedNodePointer addVerifiedNodeFromConnectRequest(const NodeConnectionData& nodeConnection);
     
-    bool verifyUserSignature(const QString& username, const QByteArray& usernameSignature,
-                             const SockAddr& senderSockAddr);
+    enum class SignatureCheck {
+        Verified,
+        Failed,
+        // the signature is being verified on the pool, the connect request is processed again once it is
+        Pending
+    };
+    SignatureCheck verifyUserSignature(const QString& username, const QByteArray& usernameSignature,
+                                       const SockAddr& senderSockAddr, const QSharedPointer<ReceivedMessage>& message);
+    void startSignatureVerification(const QString& lowerUsername, const QByteArray& publicKey,
+                                    const QByteArray& usernameSignature, const QUuid& connectionToken,
+                                    const QSharedPointer<ReceivedMessage>& message);
+    void finishSignatureVerification(const QString& lowerUsername, quint32 verificationID,
+                                     SignatureVerificationTask::Result result, quint64 verificationUsecs);
+    bool isSignatureVerificationPending(const QString& username) const;
     
     bool needToVerifyDomainUserIdentity(const QString& username, const QString& accessToken, const QString& refreshToken);
     bool verifyDomainUserIdentity(const QString& username, const QString& accessToken, const QString& refreshToken,
@@ -128,9 +148,13 @@ private:
     // we don't send back user signature decryption errors for those keys so that there isn't a thrasing of key re-generation
     // and connection refusal
 
-    using KeyFlagPair = QPair<QByteArray, bool>;
+    struct UserPublicKey {
+        QByteArray key;
+        bool isOptimistic { false };
+        quint64 receivedTime { 0 };
+    };
 
-    QHash<QString, KeyFlagPair> _userPublicKeys; // keep track of keys and flag them as optimistic or not
+    QHash<QString, UserPublicKey> _userPublicKeys; // keep track of keys and flag them as optimistic or not
     QHash<QString, bool> _inFlightPublicKeyRequests; // keep track of keys we've asked for (and if it was optimistic)
     QSet<QString> _domainOwnerFriends; // keep track of friends of the domain owner
     QSet<QString> _inFlightGroupMembershipsRequests; // keep track of which we've already asked for
@@ -161,6 +185,28 @@ private:
     DomainUserIdentities _verifiedDomainUserIdentities;  // Verified domain users.
 
     QHash<QString, QStringList> _domainGroupMemberships;  // <domainUserName, [domainGroupName]>
+
+    struct SignatureVerification {
+        quint32 id;
+        QByteArray publicKey;
+        QByteArray signature;
+        QUuid connectionToken;
+        bool isPending { true };
+        SignatureVerificationTask::Result result { SignatureVerificationTask::Result::InvalidKey };
+        // the latest connect request that waits on the verification
+        QSharedPointer<ReceivedMessage> message;
+    };
+    QHash<QString, SignatureVerification> _signatureVerifications; // <lowerUsername, verification>
+    quint32 _nextSignatureVerificationID { 0 };
+
+    // from the first packet of a connect request to its node being added, including the verification of its signature
+    PacketTrafficStats::Histogram _admissionLatency;
+    PacketTrafficStats::Histogram _signatureVerificationTime;
+    quint64 _publicKeyCacheHits { 0 };
+    quint64 _publicKeyRequests { 0 };
+
+    // last, so that its verifications are done before the rest of the gatekeeper goes away
+    QThreadPool _signatureVerificationPool;
 };
 
 
@@ -50,6 +50,7 @@
 #include <PathUtils.h>
 #include <NumericalConstants.h>
 #include <Trace.h>
+#include <TraceRecorder.h>
 #include <StatTracker.h>
 
 #include "AssetsBackupHandler.h"
@@ -58,7 +59,6 @@
 #include "EntitiesBackupHandler.h"
 #include "NodeConnectionData.h"
 
-#include <Gzip.h>
 
 #include <OctreeDataUtils.h>
 #include <ThreadHelpers.h>
@@ -199,6 +199,7 @@ bool DomainServer::forwardMetaverseAPIRequest(HTTPConnection* connection,
 DomainServer::DomainServer(int argc, char* argv[]) :
     QCoreApplication(argc, argv),
     _gatekeeper(this),
+    _exporter(_gatekeeper),
     _httpManager(QHostAddress::AnyIPv4, DOMAIN_SERVER_HTTP_PORT,
         QString("%1/resources/web/").arg(QCoreApplication::applicationDirPath()), this)
 {
@@ -386,7 +387,7 @@ DomainServer::DomainServer(int argc, char* argv[]) :
     _contentManager.reset(new DomainContentBackupManager(getContentBackupDir(), _settingsManager));
 
     connect(_contentManager.get(), &DomainContentBackupManager::started, _contentManager.get(), [this](){
-        _contentManager->addBackupHandler(BackupHandlerPointer(new EntitiesBackupHandler(getEntitiesFilePath(), getEntitiesReplacementFilePath())));
+        _contentManager->addBackupHandler(BackupHandlerPointer(new EntitiesBackupHandler(getEntitiesFilePath(), getEntitiesReplacementFilePath(), getContentBackupDir())));
         _contentManager->addBackupHandler(BackupHandlerPointer(new AssetsBackupHandler(getContentBackupDir(), isAssetServerEnabled())));
         _contentManager->addBackupHandler(BackupHandlerPointer(new ContentSettingsBackupHandler(_settingsManager)));
     });
@@ -400,6 +401,13 @@ DomainServer::DomainServer(int argc, char* argv[]) :
     connect(_nodePingMonitorTimer, &QTimer::timeout, this, &DomainServer::nodePingMonitor);
     _nodePingMonitorTimer->start(NODE_PING_MONITOR_INTERVAL_MSECS);
 
+    // the nodes that connect together, as they do at the start of an event, are broadcast together
+    static const int ADDED_NODES_BROADCAST_INTERVAL_MSECS = 50;
+    _addedNodesBroadcastTimer = new QTimer{ this };
+    _addedNodesBroadcastTimer->setSingleShot(true);
+    _addedNodesBroadcastTimer->setInterval(ADDED_NODES_BROADCAST_INTERVAL_MSECS);
+    connect(_addedNodesBroadcastTimer, &QTimer::timeout, this, &DomainServer::broadcastNewNodes);
+
     initializeExporter();
     initializeMetadataExporter();
 }
@@ -1263,9 +1271,19 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     QDataStream packetStream(message->getMessage());
     NodeConnectionData nodeRequestData = NodeConnectionData::fromDataStream(packetStream, message->getSenderSockAddr(), false);
 
+    // the version of the domain list the node last heard about, 0 if it needs the full list
+    quint32 knownListVersion = 0;
+    if (!packetStream.atEnd()) {
+        packetStream >> knownListVersion;
+    }
+
     // update this node's sockets in case they have changed
-    sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
-    sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+    if (sendingNode->getPublicSocket() != nodeRequestData.publicSockAddr
+            || sendingNode->getLocalSocket() != nodeRequestData.localSockAddr) {
+        sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
+        sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+        markNodeListChanged(sendingNode);
+    }
 
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
 
@@ -1282,8 +1300,11 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
         safeInterestSet.remove(NodeType::Agent);
     }
 
-    // update the NodeInterestSet in case there have been any changes
-    nodeData->setNodeInterestSet(safeInterestSet);
+    // update the NodeInterestSet in case there have been any changes, the nodes of the new types are all sent
+    if (nodeData->getNodeInterestSet() != safeInterestSet) {
+        nodeData->setNodeInterestSet(safeInterestSet);
+        knownListVersion = 0;
+    }
 
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
@@ -1291,7 +1312,8 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // client-side send time of last connect/domain list request
     nodeData->setLastDomainCheckinTimestamp(nodeRequestData.lastPingTimestamp);
 
-    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false);
+    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false,
+                         knownListVersion);
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -1356,6 +1378,14 @@ QUrl DomainServer::oauthAuthorizationURL(const QUuid& stateUUID) {
 void DomainServer::handleConnectedNode(SharedNodePointer newNode, quint64 requestReceiveTime) {
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(newNode->getLinkedData());
 
+    if (shouldReplicateNode(*newNode)) {
+        qDebug() << "Setting node to replicated: " << newNode->getUUID();
+        newNode->setIsReplicated(true);
+    }
+
+    // the nodes that check in next hear about this one in their deltas
+    markNodeListChanged(newNode);
+
     // reply back to the user with a PacketType::DomainList
     sendDomainListToNode(newNode, requestReceiveTime, nodeData->getSendingSockAddr(), true);
 
@@ -1364,18 +1394,21 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode, quint64 reques
         emit userConnected();
     }
 
-    if (shouldReplicateNode(*newNode)) {
-        qDebug() << "Setting node to replicated: " << newNode->getUUID();
-        newNode->setIsReplicated(true);
-    }
-
     // send out this node to our other connected nodes
-    broadcastNewNode(newNode);
+    queueNewNodeBroadcast(newNode);
+}
+
+void DomainServer::markNodeListChanged(const SharedNodePointer& node) {
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    if (nodeData) {
+        nodeData->setListVersion(++_domainListVersion);
+    }
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr &senderSockAddr, bool newConnection) {
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr &senderSockAddr,
+                                        bool newConnection, quint32 knownListVersion) {
     const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID +
-        NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 4;
+        NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 4 + sizeof(quint32);
 
     // setup the extended header for the domain list packets
     // this data is at the beginning of each of the domain list packets
@@ -1394,6 +1427,8 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
     extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
     extendedHeaderStream << newConnection;
+    // the version isn't sent to the nodes that aren't sent the list, so that they ask for the full one once they are
+    extendedHeaderStream << (nodeData->isAuthenticated() ? _domainListVersion : 0);
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
     // always send the node their own UUID back
@@ -1406,8 +1441,19 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
 
         // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
         if (nodeData->isAuthenticated()) {
+            // a node that knows a version of the list is only sent the nodes that were added or changed since, the removed
+            // ones are sent in their own reliable packets
+            bool sendDelta = !newConnection && knownListVersion != 0 && knownListVersion <= _domainListVersion;
+
             // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([this, node, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
+            limitedNodeList->eachNode([this, node, sendDelta, knownListVersion, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
+                if (sendDelta) {
+                    auto otherNodeData = static_cast<DomainServerNodeData*>(otherNode->getLinkedData());
+                    if (!otherNodeData || otherNodeData->getListVersion() <= knownListVersion) {
+                        return;
+                    }
+                }
+
                 if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
                     // since we're about to add a node to the packet we start a segment
                     domainListPackets->startSegment();
@@ -1453,40 +1499,57 @@ QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, con
     return QUuid();
 }
 
-void DomainServer::broadcastNewNode(const SharedNodePointer& addedNode) {
+void DomainServer::queueNewNodeBroadcast(const SharedNodePointer& node) {
+    _pendingAddedNodes.push_back(node->getUUID());
+    if (!_addedNodesBroadcastTimer->isActive()) {
+        _addedNodesBroadcastTimer->start();
+    }
+}
 
+void DomainServer::broadcastNewNodes() {
     auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
-    QWeakPointer<LimitedNodeList> limitedNodeListWeak = limitedNodeList;
 
-    auto addNodePacket = NLPacket::create(PacketType::DomainServerAddedNode);
-
-    // setup the add packet for this new node
-    QDataStream addNodeStream(addNodePacket.get());
-
-    addNodeStream << *addedNode.data();
+    // skip the nodes that were killed before their broadcast
+    std::vector<SharedNodePointer> addedNodes;
+    for (const QUuid& nodeUUID : _pendingAddedNodes) {
+        auto addedNode = limitedNodeList->nodeWithUUID(nodeUUID);
+        if (addedNode) {
+            addedNodes.push_back(addedNode);
+        }
+    }
+    _pendingAddedNodes.clear();
 
-    int connectionSecretIndex = addNodePacket->pos();
+    if (addedNodes.empty()) {
+        return;
+    }
 
     limitedNodeList->eachMatchingNode(
-        [this, addedNode](const SharedNodePointer& node)->bool {
-            // is the added Node in this node's interest list?
-            return node->getLinkedData()
-                && node->getActiveSocket()
-                && node != addedNode
-                && isInInterestSet(node, addedNode);
+        [](const SharedNodePointer& node)->bool {
+            return node->getLinkedData() && node->getActiveSocket();
         },
-        [this, &addNodePacket, connectionSecretIndex, addedNode, limitedNodeListWeak](const SharedNodePointer& node) {
-            // send off this packet to the node
-            auto limitedNodeList = limitedNodeListWeak.lock();
-            if (limitedNodeList) {
-                addNodePacket->seek(connectionSecretIndex);
+        [this, &addedNodes, &limitedNodeList](const SharedNodePointer& node) {
+            // each node is sent the added nodes it's interested in, packed together
+            std::unique_ptr<NLPacketList> addedNodesPackets;
+            for (const auto& addedNode : addedNodes) {
+                if (node == addedNode || !isInInterestSet(node, addedNode)) {
+                    continue;
+                }
 
-                QByteArray rfcConnectionSecret = connectionSecretForNodes(node, addedNode).toRfc4122();
+                if (!addedNodesPackets) {
+                    addedNodesPackets = NLPacketList::create(PacketType::DomainServerAddedNode);
+                }
+                QDataStream addedNodesStream(addedNodesPackets.get());
+
+                addedNodesPackets->startSegment();
+                addedNodesStream << *addedNode.data();
 
-                // replace the bytes at the end of the packet for the connection secret between these nodes
-                addNodePacket->write(rfcConnectionSecret);
+                // pack the secret that these two nodes will use to communicate with each other
+                addedNodesStream << connectionSecretForNodes(node, addedNode);
+                addedNodesPackets->endSegment();
+            }
 
-                limitedNodeList->sendUnreliablePacket(*addNodePacket, *node);
+            if (addedNodesPackets) {
+                limitedNodeList->sendPacketList(std::move(addedNodesPackets), *node);
             }
         }
     );
@@ -1984,8 +2047,8 @@ void DomainServer::processOctreeDataRequestMessage(QSharedPointer<ReceivedMessag
 
 void DomainServer::processNodeJSONStatsPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode) {
     auto nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
-    if (nodeData) {
-        nodeData->updateJSONStats(packetList->getMessage());
+    if (nodeData && !nodeData->updateStats(packetList->getMessage())) {
+        qCDebug(domain_server) << "Failed to decode the stats of" << sendingNode->getUUID();
     }
 }
 
@@ -2082,6 +2145,7 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
     const QString URI_SETTINGS = "/settings";
     const QString URI_CONTENT_UPLOAD = "/content/upload";
     const QString URI_RESTART = "/restart";
+    const QString URI_TRACE = "/trace.json";
     const QString URI_API_METAVERSE_INFO = "/api/metaverse_info";
     const QString URI_API_PLACES = "/api/places";
     const QString URI_API_DOMAINS = "/api/domains";
@@ -2195,6 +2259,17 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         }
     }
 
+    if (connection->requestOperation() == QNetworkAccessManager::GetOperation && url.path() == URI_TRACE) {
+        // the last events of the trace recorder of the domain server, in the Chrome trace format
+        if (!tracing::TraceRecorder::isEnabled()) {
+            connection->respond(HTTPConnection::StatusCode404, "The trace recorder is not enabled.");
+            return true;
+        }
+        connection->respond(HTTPConnection::StatusCode200, tracing::TraceRecorder::getInstance().toChromeTrace(),
+                            JSON_MIME_TYPE.toUtf8());
+        return true;
+    }
+
     if (connection->requestOperation() == QNetworkAccessManager::GetOperation) {
         if (url.path() == "/assignments.json") {
             // user is asking for json list of assignments
@@ -2360,6 +2435,27 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
 
                 return false;
             }
+
+            // check if this is for the history of a stat of a node, e.g. /nodes/<uuid>/history.json?path=io_stats.inbound_kbps
+            const QString NODE_HISTORY_REGEX_STRING = QString("\\%1\\/(%2)\\/history.json\\/?$").arg(URI_NODES).arg(UUID_REGEX_STRING);
+            QRegExp nodeHistoryRegex(NODE_HISTORY_REGEX_STRING);
+
+            if (nodeHistoryRegex.indexIn(url.path()) != -1) {
+                SharedNodePointer matchingNode = nodeList->nodeWithUUID(QUuid(nodeHistoryRegex.cap(1)));
+                if (matchingNode) {
+                    QString path = QUrlQuery(url).queryItemValue("path");
+                    QJsonObject historyObject {
+                        { "path", path },
+                        { "samples", static_cast<DomainServerNodeData*>(matchingNode->getLinkedData())->getStatsHistory(path) }
+                    };
+
+                    connection->respond(HTTPConnection::StatusCode200, QJsonDocument(historyObject).toJson(),
+                                        qPrintable(JSON_MIME_TYPE));
+                    return true;
+                }
+
+                return false;
+            }
         }
     } else if (connection->requestOperation() == QNetworkAccessManager::PostOperation) {
         if (url.path() == URI_ASSIGNMENT) {
@@ -3255,7 +3351,10 @@ void DomainServer::updateReplicatedNodes() {
                 qDebug() << "Setting node to replicated:"
                     << otherNode->getPermissions().getVerifiedUserName() << otherNode->getUUID();
             }
-            otherNode->setIsReplicated(shouldReplicate);
+            if (isReplicated != shouldReplicate) {
+                otherNode->setIsReplicated(shouldReplicate);
+                markNodeListChanged(otherNode);
+            }
         }
     );
 }
@@ -3701,14 +3800,13 @@ void DomainServer::maybeHandleReplacementEntityFile() {
             qCWarning(domain_server) << "Unable to remove replacement file, bailing";
         } else {
             data.resetIdAndVersion();
-            auto gzippedData = data.toGzippedByteArray();
 
             QFile currentFile(getEntitiesFilePath());
             if (!currentFile.open(QIODevice::WriteOnly)) {
                 qCWarning(domain_server)
                     << "Failed to update entities data file with replacement file, unable to open entities file for writing";
             } else {
-                currentFile.write(gzippedData);
+                data.writeGzipped(currentFile);
             }
         }
     }
@@ -3719,13 +3817,10 @@ bool DomainServer::handleOctreeFileReplacement(QByteArray octreeFile, QString so
     if (data.readOctreeDataInfoFromData(octreeFile)) {
         data.resetIdAndVersion();
 
-        QByteArray compressedOctree;
-        gzip(data.toByteArray(), compressedOctree);
-
         // write the compressed octree data to a special file
         auto replacementFilePath = getEntitiesReplacementFilePath();
         QFile replacementFile(replacementFilePath);
-        if (replacementFile.open(QIODevice::WriteOnly) && replacementFile.write(compressedOctree) != -1) {
+        if (replacementFile.open(QIODevice::WriteOnly) && data.writeGzipped(replacementFile)) {
             // we've now written our replacement file, time to take the server down so it can
             // process it when it comes back up
             qInfo() << "Wrote octree replacement file to" << replacementFilePath << "- stopping server";
@@ -194,12 +194,15 @@ private:
     void handleKillNode(SharedNodePointer nodeToKill);
     void broadcastNodeDisconnect(const SharedNodePointer& disconnnectedNode);
 
-    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr& senderSockAddr, bool newConnection);
+    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr& senderSockAddr,
+                              bool newConnection, quint32 knownListVersion = 0);
+    void markNodeListChanged(const SharedNodePointer& node);
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
 
     QUuid connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
-    void broadcastNewNode(const SharedNodePointer& node);
+    void queueNewNodeBroadcast(const SharedNodePointer& node);
+    void broadcastNewNodes();
 
     void parseAssignmentConfigs(QSet<Assignment::Type>& excludedTypes);
     void addStaticAssignmentToAssignmentHash(Assignment* newAssignment);
@@ -299,6 +302,14 @@ private:
     int _iceAddressLookupID { INVALID_ICE_LOOKUP_ID };
     int _noReplyICEHeartbeats { 0 };
     int _numHeartbeatDenials { 0 };
+
+    // bumped whenever a node is added or changes, so that the nodes checking in are only sent what changed since the
+    // version they last heard about
+    quint32 _domainListVersion { 0 };
+
+    // the nodes that connected since the last broadcast, which are sent out together on the next tick
+    QList<QUuid> _pendingAddedNodes;
+    QTimer* _addedNodesBroadcastTimer { nullptr };
     bool _connectedToICEServer { false };
 
     DomainType _type { DomainType::NonMetaverse };
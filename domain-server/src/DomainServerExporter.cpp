@@ -19,6 +19,9 @@
 //
 // Look into what appears in Audio Mixer -> z_listeners -> jitter -> injectors, so far it's been an empty list.
 
+#include <algorithm>
+#include <limits>
+
 #include <QLoggingCategory>
 #include <QUrl>
 #include <QJsonObject>
@@ -30,6 +33,7 @@
 #include "DependencyManager.h"
 #include "LimitedNodeList.h"
 #include "HTTPConnection.h"
+#include "DomainGatekeeper.h"
 #include "DomainServerNodeData.h"
 
 Q_LOGGING_CATEGORY(domain_server_exporter, "hifi.domain_server.prometheus_exporter")
@@ -202,6 +206,11 @@ static const QMap<QString, DomainServerExporter::MetricType> TYPE_MAP {
     { "entity_script_server_octree_stats_internal_element_count"                                  , DomainServerExporter::MetricType::Gauge },
     { "entity_script_server_octree_stats_leaf_element_count"                                      , DomainServerExporter::MetricType::Gauge },
     { "entity_script_server_script_engine_stats_number_running_scripts"                           , DomainServerExporter::MetricType::Gauge },
+    { "domain_server_admission_cached_public_keys"                                                , DomainServerExporter::MetricType::Gauge },
+    { "domain_server_admission_pending_signature_verifications"                                   , DomainServerExporter::MetricType::Gauge },
+    { "domain_server_admission_public_key_cache_hits"                                             , DomainServerExporter::MetricType::Counter },
+    { "domain_server_admission_public_key_requests"                                               , DomainServerExporter::MetricType::Counter },
+    { "domain_server_admission_public_key_requests_in_flight"                                     , DomainServerExporter::MetricType::Gauge },
     { "entity_server_assignment_stats_num_queued_check_ins"                                       , DomainServerExporter::MetricType::Gauge },
     { "entity_server_entity_server_inbound_data_packet_queue"                                     , DomainServerExporter::MetricType::Gauge },
     { "entity_server_entity_server_inbound_data_total_elements"                                   , DomainServerExporter::MetricType::Gauge },
@@ -285,7 +294,42 @@ static const QSet<QString> BLACKLIST = {
     "messages_mixer_messages_username"                          // Username
 };
 
-DomainServerExporter::DomainServerExporter() {
+// Metrics found under every node type, by the end of their name
+static const QMap<QString, DomainServerExporter::MetricType> SUFFIX_TYPE_MAP {
+    { "packet_traffic_types_packets"                                                              , DomainServerExporter::MetricType::Counter },
+    { "packet_traffic_types_bytes"                                                                , DomainServerExporter::MetricType::Counter },
+    { "packet_traffic_types_packets_per_sec"                                                      , DomainServerExporter::MetricType::Gauge },
+    { "packet_traffic_types_bytes_per_sec"                                                        , DomainServerExporter::MetricType::Gauge },
+    { "packet_traffic_node_types_packets"                                                         , DomainServerExporter::MetricType::Counter },
+    { "packet_traffic_node_types_bytes"                                                           , DomainServerExporter::MetricType::Counter },
+    { "packet_traffic_node_types_packets_per_sec"                                                 , DomainServerExporter::MetricType::Gauge },
+    { "packet_traffic_node_types_bytes_per_sec"                                                   , DomainServerExporter::MetricType::Gauge }
+};
+
+// Objects whose keys are the values of a label rather than part of the metric names, by the end of their name. Each
+// key holds the same set of metrics, which are output as one family with a sample per key.
+static const QMap<QString, QString> LABEL_GROUPS {
+    { "packet_traffic_types"      , "packet_type" },
+    { "packet_traffic_node_types" , "source_node_type" }
+};
+
+static QString findBySuffix(const QMap<QString, QString>& map, const QString& name) {
+    for (auto iter = map.constBegin(); iter != map.constEnd(); ++iter) {
+        if (name.endsWith("_" + iter.key())) {
+            return iter.value();
+        }
+    }
+    return QString();
+}
+
+// Histograms in the stats, like PacketTrafficStats' - a count, a sum, and cumulative counts keyed by bucket bound
+static bool isHistogram(const QJsonObject& obj) {
+    return obj.contains("count") && obj.contains("sum") && obj.value("buckets").isObject();
+}
+
+DomainServerExporter::DomainServerExporter(const DomainGatekeeper& gatekeeper) :
+    _gatekeeper(gatekeeper)
+{
 }
 
 bool DomainServerExporter::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
@@ -299,6 +343,7 @@ bool DomainServerExporter::handleHTTPRequest(HTTPConnection* connection, const Q
         QString output = "";
         QTextStream outStream(&output);
 
+        generateMetricsForDomainServer(outStream);
         nodeList->eachNode([this, &outStream](const SharedNodePointer& node) { generateMetricsForNode(outStream, node); });
 
         connection->respond(HTTPConnection::StatusCode200, output.toUtf8(), qPrintable(EXPORTER_MIME_TYPE));
@@ -342,6 +387,17 @@ QString DomainServerExporter::escapeName(const QString& name) {
     return result;
 }
 
+void DomainServerExporter::generateMetricsForDomainServer(QTextStream& stream) {
+    QJsonObject statsObject;
+    statsObject["admission"] = _gatekeeper.getAdmissionStats();
+
+    stream << "###############################################################\n";
+    stream << "# DomainServer\n";
+    stream << "###############################################################\n";
+
+    generateMetricsFromJson(stream, "DomainServer", "domain_server", QHash<QString, QString>(), statsObject);
+}
+
 void DomainServerExporter::generateMetricsForNode(QTextStream& stream, const SharedNodePointer& node) {
     QJsonObject statsObject = static_cast<DomainServerNodeData*>(node->getLinkedData())->getStatsJSONObject();
     QString nodeType = NodeType::getNodeTypeName(static_cast<NodeType_t>(node->getType()));
@@ -366,6 +422,18 @@ void DomainServerExporter::generateMetricsFromJson(QTextStream& stream,
         auto origMetricName = originalPath + " -> " + iter.key();
 
         if (metricValue.isObject()) {
+            QString labelName = findBySuffix(LABEL_GROUPS, metricName);
+            if (!labelName.isEmpty()) {
+                generateLabeledMetrics(stream, origMetricName, metricName, labels, labelName, metricValue.toObject());
+                continue;
+            }
+
+            if (isHistogram(metricValue.toObject())) {
+                writeHelpAndType(stream, metricName, originalPath, iter.key(), MetricType::Histogram);
+                writeHistogramSamples(stream, metricName, labels, metricValue.toObject());
+                continue;
+            }
+
             QUuid possible_uuid = QUuid::fromString(iter.key());
 
             if (possible_uuid.isNull()) {
@@ -399,59 +467,17 @@ void DomainServerExporter::generateMetricsFromJson(QTextStream& stream,
             }
         }
 
-        stream << QString("\n# HELP %1 %2 -> %3\n").arg(metricName).arg(originalPath).arg(iter.key());
-
-        if (TYPE_MAP.contains(metricName)) {
-            stream << "# TYPE " << metricName << " ";
-            switch (TYPE_MAP[metricName]) {
-                case DomainServerExporter::MetricType::Untyped:
-                    stream << "untyped";
-                    break;
-                case DomainServerExporter::MetricType::Counter:
-                    stream << "counter";
-                    break;
-                case DomainServerExporter::MetricType::Gauge:
-                    stream << "gauge";
-                    break;
-                case DomainServerExporter::MetricType::Histogram:
-                    stream << "histogram";
-                    break;
-                case DomainServerExporter::MetricType::Summary:
-                    stream << "summary";
-                    break;
-            }
-            stream << "\n";
+        MetricType type = MetricType::Untyped;
+        if (findType(metricName, type)) {
+            writeHelpAndType(stream, metricName, originalPath, iter.key(), type);
         } else {
+            stream << QString("\n# HELP %1 %2 -> %3\n").arg(metricName).arg(originalPath).arg(iter.key());
             qCWarning(domain_server_exporter)
                 << "Type for metric " << origMetricName << " (" << metricName << ") not known.";
         }
 
         stream << path << "_" << escapedKey;
-        if (!labels.isEmpty()) {
-            stream << "{";
-
-            bool isFirst = true;
-            QHashIterator<QString, QString> iter(labels);
-
-            while (iter.hasNext()) {
-                iter.next();
-
-                if (!isFirst) {
-                    stream << ",";
-                }
-
-                QString escapedValue = iter.value();
-                escapedValue.replace("\\", "\\\\");
-                escapedValue.replace("\"", "\\\"");
-                escapedValue.replace("\n", "\\\n");
-
-                stream << iter.key() << "=\"" << escapedValue << "\"";
-
-                isFirst = false;
-            }
-            stream << "}";
-        }
-
+        writeLabels(stream, labels);
         stream << " ";
 
         if (metricValue.isBool()) {
@@ -469,3 +495,156 @@ void DomainServerExporter::generateMetricsFromJson(QTextStream& stream,
         stream << "\n";
     }
 }
+
+bool DomainServerExporter::findType(const QString& metricName, MetricType& type) {
+    if (TYPE_MAP.contains(metricName)) {
+        type = TYPE_MAP[metricName];
+        return true;
+    }
+
+    for (auto iter = SUFFIX_TYPE_MAP.constBegin(); iter != SUFFIX_TYPE_MAP.constEnd(); ++iter) {
+        if (metricName.endsWith("_" + iter.key())) {
+            type = iter.value();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void DomainServerExporter::writeHelpAndType(QTextStream& stream, const QString& metricName, const QString& originalPath,
+                                            const QString& key, MetricType type) {
+    stream << QString("\n# HELP %1 %2 -> %3\n").arg(metricName).arg(originalPath).arg(key);
+
+    stream << "# TYPE " << metricName << " ";
+    switch (type) {
+        case DomainServerExporter::MetricType::Untyped:
+            stream << "untyped";
+            break;
+        case DomainServerExporter::MetricType::Counter:
+            stream << "counter";
+            break;
+        case DomainServerExporter::MetricType::Gauge:
+            stream << "gauge";
+            break;
+        case DomainServerExporter::MetricType::Histogram:
+            stream << "histogram";
+            break;
+        case DomainServerExporter::MetricType::Summary:
+            stream << "summary";
+            break;
+    }
+    stream << "\n";
+}
+
+void DomainServerExporter::writeLabels(QTextStream& stream, const QHash<QString, QString>& labels,
+                                       const QString& extraName, const QString& extraValue) {
+    QHash<QString, QString> allLabels = labels;
+    if (!extraName.isEmpty()) {
+        allLabels.insert(extraName, extraValue);
+    }
+
+    if (allLabels.isEmpty()) {
+        return;
+    }
+
+    stream << "{";
+
+    bool isFirst = true;
+    QHashIterator<QString, QString> iter(allLabels);
+
+    while (iter.hasNext()) {
+        iter.next();
+
+        if (!isFirst) {
+            stream << ",";
+        }
+
+        QString escapedValue = iter.value();
+        escapedValue.replace("\\", "\\\\");
+        escapedValue.replace("\"", "\\\"");
+        escapedValue.replace("\n", "\\\n");
+
+        stream << iter.key() << "=\"" << escapedValue << "\"";
+
+        isFirst = false;
+    }
+    stream << "}";
+}
+
+void DomainServerExporter::writeHistogramSamples(QTextStream& stream, const QString& metricName,
+                                                 const QHash<QString, QString>& labels, const QJsonObject& histogram) {
+    QJsonObject buckets = histogram.value("buckets").toObject();
+
+    // the keys sort as strings, the buckets go out in the order of their bounds
+    QStringList bounds = buckets.keys();
+    std::sort(bounds.begin(), bounds.end(), [](const QString& a, const QString& b) {
+        return (a == "+Inf" ? std::numeric_limits<double>::infinity() : a.toDouble())
+            < (b == "+Inf" ? std::numeric_limits<double>::infinity() : b.toDouble());
+    });
+
+    for (const auto& bound : bounds) {
+        stream << metricName << "_bucket";
+        writeLabels(stream, labels, "le", bound);
+        stream << " " << buckets.value(bound).toDouble() << "\n";
+    }
+
+    stream << metricName << "_sum";
+    writeLabels(stream, labels);
+    stream << " " << histogram.value("sum").toDouble() << "\n";
+
+    stream << metricName << "_count";
+    writeLabels(stream, labels);
+    stream << " " << histogram.value("count").toDouble() << "\n";
+}
+
+void DomainServerExporter::generateLabeledMetrics(QTextStream& stream,
+                                                  const QString& originalPath,
+                                                  const QString& path,
+                                                  const QHash<QString, QString>& labels,
+                                                  const QString& labelName,
+                                                  const QJsonObject& groups) {
+    // every metric found in any of the groups, each output once with a sample per group
+    QStringList keys;
+    for (auto group = groups.constBegin(); group != groups.constEnd(); ++group) {
+        for (const auto& key : group.value().toObject().keys()) {
+            if (!keys.contains(key)) {
+                keys.append(key);
+            }
+        }
+    }
+
+    for (const auto& key : keys) {
+        auto metricName = path + "_" + escapeName(key);
+        bool isFirst = true;
+
+        for (auto group = groups.constBegin(); group != groups.constEnd(); ++group) {
+            auto value = group.value().toObject().value(key);
+            QHash<QString, QString> groupLabels = labels;
+            groupLabels.insert(labelName, group.key());
+
+            if (value.isObject() && isHistogram(value.toObject())) {
+                if (isFirst) {
+                    writeHelpAndType(stream, metricName, originalPath + " -> *", key, MetricType::Histogram);
+                }
+                writeHistogramSamples(stream, metricName, groupLabels, value.toObject());
+            } else if (value.isDouble() || value.isBool()) {
+                if (isFirst) {
+                    MetricType type = MetricType::Untyped;
+                    if (!findType(metricName, type)) {
+                        qCWarning(domain_server_exporter)
+                            << "Type for metric " << originalPath << " -> * -> " << key << " (" << metricName << ") not known.";
+                    }
+                    writeHelpAndType(stream, metricName, originalPath + " -> *", key, type);
+                }
+                stream << metricName;
+                writeLabels(stream, groupLabels);
+                stream << " " << (value.isBool() ? (value.toBool() ? 1.0 : 0.0) : value.toDouble()) << "\n";
+            } else {
+                continue;
+            }
+
+            isFirst = false;
+        }
+    }
+}
@@ -22,6 +22,7 @@
 #include <QRegularExpression>
 #include <QHash>
 
+class DomainGatekeeper;
 
 
 /**
@@ -42,14 +43,27 @@ public:
         Summary
     } MetricType;
 
-    DomainServerExporter();
+    DomainServerExporter(const DomainGatekeeper& gatekeeper);
     ~DomainServerExporter() = default;
     bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
 
 private:
     QString escapeName(const QString &name);
+    void generateMetricsForDomainServer(QTextStream& stream);
     void generateMetricsForNode(QTextStream& stream, const SharedNodePointer& node);
     void generateMetricsFromJson(QTextStream& stream, QString originalPath, QString path, QHash<QString, QString> labels, const QJsonObject& obj);
+    void generateLabeledMetrics(QTextStream& stream, const QString& originalPath, const QString& path,
+                                const QHash<QString, QString>& labels, const QString& labelName, const QJsonObject& groups);
+
+    bool findType(const QString& metricName, MetricType& type);
+    void writeHelpAndType(QTextStream& stream, const QString& metricName, const QString& originalPath, const QString& key,
+                          MetricType type);
+    void writeLabels(QTextStream& stream, const QHash<QString, QString>& labels, const QString& extraName = QString(),
+                     const QString& extraValue = QString());
+    void writeHistogramSamples(QTextStream& stream, const QString& metricName, const QHash<QString, QString>& labels,
+                               const QJsonObject& histogram);
+
+    const DomainGatekeeper& _gatekeeper;
 };
 
 #endif // DOMAINSERVEREXPORTER_H
@@ -12,13 +12,12 @@
 #include "DomainServerNodeData.h"
 
 #include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
 #include <QtCore/QJsonArray>
-#include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QVariant>
 
 #include <udt/PacketHeaders.h>
-#include "WarningsSuppression.h"
 
 
 DomainServerNodeData::StringPairHash DomainServerNodeData::_overrideHash;
@@ -27,47 +26,51 @@ DomainServerNodeData::DomainServerNodeData() {
     _paymentIntervalTimer.start();
 }
 
-void DomainServerNodeData::updateJSONStats(QByteArray statsByteArray) {
-    OVERTE_IGNORE_DEPRECATED_BEGIN
-    auto document = QJsonDocument::fromBinaryData(statsByteArray);
-    Q_ASSERT(document.isObject());
-    _statsJSONObject = overrideValuesIfNeeded(document.object());
-    OVERTE_IGNORE_DEPRECATED_END
-}
+bool DomainServerNodeData::updateStats(const QByteArray& statsByteArray) {
+    auto stats = std::make_shared<NodeStats>();
+    if (!stats->decode(statsByteArray)) {
+        return false;
+    }
 
-QJsonObject DomainServerNodeData::overrideValuesIfNeeded(const QJsonObject& newStats) {
-    QJsonObject result;
-    for (auto it = newStats.constBegin(); it != newStats.constEnd(); ++it) {
-        const auto& key = it.key();
-        const auto& value = it.value();
+    _statsHistory[_statsHistoryEnd] = { QDateTime::currentMSecsSinceEpoch(), stats };
+    _statsHistoryEnd = (_statsHistoryEnd + 1) % STATS_HISTORY_SIZE;
+    if (_numStatsSamples < STATS_HISTORY_SIZE) {
+        ++_numStatsSamples;
+    }
+    _isStatsJSONObjectValid = false;
+    return true;
+}
 
-        auto overrideIt = value.isString() ? _overrideHash.find({key, value.toString()}) : _overrideHash.end();
-        if (overrideIt != _overrideHash.end()) {
-            // We have a match, override the value
-            result[key] = *overrideIt;
-        } else if (value.isObject()) {
-            result[key] = overrideValuesIfNeeded(value.toObject());
-        } else if (value.isArray()) {
-            result[key] = overrideValuesIfNeeded(value.toArray());
-        } else {
-            result[key] = newStats[key];
-        }
+const QJsonObject& DomainServerNodeData::getStatsJSONObject() const {
+    if (!_isStatsJSONObjectValid) {
+        const auto& latest = _statsHistory[(_statsHistoryEnd + STATS_HISTORY_SIZE - 1) % STATS_HISTORY_SIZE];
+        _statsJSONObject = latest.stats->toJson([](const QString& name, const QString& value, QString& overrideValue) {
+            auto overrideIt = _overrideHash.find({ name, value });
+            if (overrideIt != _overrideHash.end()) {
+                overrideValue = *overrideIt;
+                return true;
+            }
+            return false;
+        });
+        _isStatsJSONObjectValid = true;
     }
-    return result;
+    return _statsJSONObject;
 }
 
-QJsonArray DomainServerNodeData::overrideValuesIfNeeded(const QJsonArray& newStats) {
-    QJsonArray result;
-    for (const auto& value : newStats) {
-        if (value.isObject()) {
-            result.push_back(overrideValuesIfNeeded(value.toObject()));
-        } else if (value.isArray()) {
-            result.push_back(overrideValuesIfNeeded(value.toArray()));
-        } else {
-            result.push_back(value);
+QJsonArray DomainServerNodeData::getStatsHistory(const QString& path) const {
+    QJsonArray history;
+    for (int i = 0; i < _numStatsSamples; ++i) {
+        const auto& sample = _statsHistory[(_statsHistoryEnd + STATS_HISTORY_SIZE - _numStatsSamples + i) % STATS_HISTORY_SIZE];
+        int entryIndex = sample.stats->findEntry(path);
+        if (entryIndex == -1) {
+            continue;
+        }
+        const auto& entry = sample.stats->getEntries()[entryIndex];
+        if (entry.type == NodeStats::ValueType::Integer || entry.type == NodeStats::ValueType::Double) {
+            history.push_back(QJsonArray { sample.timestamp, entry.number });
         }
     }
-    return result;
+    return history;
 }
 
 void DomainServerNodeData::addOverrideForKey(const QString& key, const QString& value,
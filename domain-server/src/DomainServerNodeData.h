@@ -13,23 +13,33 @@
 #ifndef hifi_DomainServerNodeData_h
 #define hifi_DomainServerNodeData_h
 
+#include <array>
+#include <memory>
+
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QHash>
 #include <QtCore/QUuid>
+#include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
 
 #include <SockAddr.h>
 #include <NLPacket.h>
 #include <NodeData.h>
+#include <NodeStats.h>
 #include <NodeType.h>
 
 class DomainServerNodeData : public NodeData {
 public:
     DomainServerNodeData();
 
-    const QJsonObject& getStatsJSONObject() const { return _statsJSONObject; }
+    /// The last stats of the node, which are only rebuilt as JSON when they're asked for
+    const QJsonObject& getStatsJSONObject() const;
+
+    /// Decodes and stores the stats last sent by the node, returns false if they couldn't be decoded
+    bool updateStats(const QByteArray& statsByteArray);
 
-    void updateJSONStats(QByteArray statsByteArray);
+    /// The values of the number at path in the stats stored, oldest first, as [msecs since epoch, value] pairs
+    QJsonArray getStatsHistory(const QString& path) const;
 
     void setAssignmentUUID(const QUuid& assignmentUUID) { _assignmentUUID = assignmentUUID; }
     const QUuid& getAssignmentUUID() const { return _assignmentUUID; }
@@ -73,19 +83,33 @@ public:
 
     bool hasCheckedIn() const { return _hasCheckedIn; }
     void setHasCheckedIn(bool hasCheckedIn) { _hasCheckedIn = hasCheckedIn; }
+
+    // the version of the domain list in which this node was added or last changed
+    void setListVersion(quint32 listVersion) { _listVersion = listVersion; }
+    quint32 getListVersion() const { return _listVersion; }
     
 private:
-    QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
-    QJsonArray overrideValuesIfNeeded(const QJsonArray& newStats);
-    
+    // about a minute of the stats, which the assignments send every second
+    static const int STATS_HISTORY_SIZE = 60;
+
+    struct StatsSample {
+        qint64 timestamp { 0 };
+        std::shared_ptr<const NodeStats> stats;
+    };
+
     QHash<QUuid, QUuid> _sessionSecretHash;
     QUuid _assignmentUUID;
     QString _username;
     QElapsedTimer _paymentIntervalTimer;
     
     using StringPairHash = QHash<QPair<QString, QString>, QString>;
-    QJsonObject _statsJSONObject;
     static StringPairHash _overrideHash;
+
+    std::array<StatsSample, STATS_HISTORY_SIZE> _statsHistory;
+    int _statsHistoryEnd { 0 };
+    int _numStatsSamples { 0 };
+    mutable QJsonObject _statsJSONObject;
+    mutable bool _isStatsJSONObjectValid { true };
     
     SockAddr _sendingSockAddr;
     bool _isAuthenticated = true;
@@ -99,6 +123,8 @@ private:
     bool _wasAssigned { false };
 
     bool _hasCheckedIn { false };
+
+    quint32 _listVersion { 0 };
 };
 
 #endif // hifi_DomainServerNodeData_h
@@ -11,7 +11,13 @@
 
 #include "EntitiesBackupHandler.h"
 
+#include <algorithm>
+
+#include <QCryptographicHash>
 #include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
 
 #if !defined(__clang__) && defined(__GNUC__)
 #pragma GCC diagnostic push
@@ -27,54 +33,110 @@
 
 #include <OctreeDataUtils.h>
 
-EntitiesBackupHandler::EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath) :
+static const QString ENTITIES_DIR { "/entities/" };
+static const QString ENTITIES_BACKUP_FILENAME = "models.json.gz";
+static const QString ENTITIES_REFERENCE_FILENAME = "models.json.gz.sha256";
+
+EntitiesBackupHandler::EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath,
+                                             const QString& backupDirectory) :
     _entitiesFilePath(entitiesFilePath),
-    _entitiesReplacementFilePath(entitiesReplacementFilePath)
+    _entitiesReplacementFilePath(entitiesReplacementFilePath),
+    _entitiesDirectory(backupDirectory + ENTITIES_DIR)
 {
+    // Make sure the entities directory exists.
+    QDir(_entitiesDirectory).mkpath(".");
 }
 
-static const QString ENTITIES_BACKUP_FILENAME = "models.json.gz";
+void EntitiesBackupHandler::loadBackup(const QString& backupName, QuaZip& zip) {
+    if (!zip.setCurrentFile(ENTITIES_REFERENCE_FILENAME)) {
+        // a backup that holds its entities file
+        return;
+    }
+    QuaZipFile zipFile { &zip };
+    if (!zipFile.open(QIODevice::ReadOnly)) {
+        qCritical().nospace() << "Failed to open " << ENTITIES_REFERENCE_FILENAME << " in backup " << backupName;
+        return;
+    }
+    _backups[backupName] = QString::fromLatin1(zipFile.readAll()).trimmed();
+    zipFile.close();
+}
 
 void EntitiesBackupHandler::createBackup(const QString& backupName, QuaZip& zip) {
     QFile entitiesFile { _entitiesFilePath };
 
     if (entitiesFile.open(QIODevice::ReadOnly)) {
+        auto entityData = entitiesFile.readAll();
+        QString hash = QCryptographicHash::hash(entityData, QCryptographicHash::Sha256).toHex();
+
+        // the entities are only written when they've changed since the backups that have them already
+        QString storedFilePath = _entitiesDirectory + hash;
+        if (!QFile::exists(storedFilePath)) {
+            QSaveFile storedFile { storedFilePath };
+            if (!storedFile.open(QIODevice::WriteOnly) || storedFile.write(entityData) != entityData.size() ||
+                !storedFile.commit()) {
+                qCritical() << "Failed to write entities file to backup";
+                return;
+            }
+        }
+
         QuaZipFile zipFile { &zip };
-        if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME, _entitiesFilePath))) {
-            qCritical().nospace() << "Failed to open " << ENTITIES_BACKUP_FILENAME << " for writing in zip";
+        if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_REFERENCE_FILENAME, _entitiesFilePath))) {
+            qCritical().nospace() << "Failed to open " << ENTITIES_REFERENCE_FILENAME << " for writing in zip";
             return;
         }
-        auto entityData = entitiesFile.readAll();
-        if (zipFile.write(entityData) != entityData.size()) {
-            qCritical() << "Failed to write entities file to backup";
-            zipFile.close();
+        zipFile.write(hash.toLatin1());
+        zipFile.close();
+        if (zipFile.getZipError() != UNZ_OK) {
+            qCritical().nospace() << "Failed to zip " << ENTITIES_REFERENCE_FILENAME << ": " << zipFile.getZipError();
             return;
         }
+        _backups[backupName] = hash;
+    }
+}
+
+bool EntitiesBackupHandler::readEntities(QuaZip& zip, QByteArray& entityData, QString& errorStr) {
+    if (zip.setCurrentFile(ENTITIES_BACKUP_FILENAME)) {
+        QuaZipFile zipFile { &zip };
+        if (!zipFile.open(QIODevice::ReadOnly)) {
+            errorStr = "Failed to open " + ENTITIES_BACKUP_FILENAME + " in backup";
+            return false;
+        }
+        entityData = zipFile.readAll();
+
         zipFile.close();
+
         if (zipFile.getZipError() != UNZ_OK) {
-            qCritical().nospace() << "Failed to zip " << ENTITIES_BACKUP_FILENAME << ": " << zipFile.getZipError();
+            errorStr = "Failed to unzip " + ENTITIES_BACKUP_FILENAME + ": " + zipFile.getZipError();
+            return false;
         }
+        return true;
     }
-}
 
-std::pair<bool, QString> EntitiesBackupHandler::recoverBackup(const QString& backupName, QuaZip& zip, const QString& username, const QString& sourceFilename) {
-    if (!zip.setCurrentFile(ENTITIES_BACKUP_FILENAME)) {
-        QString errorStr("Failed to find " + ENTITIES_BACKUP_FILENAME + " while recovering backup");
-        qWarning() << errorStr;
-        return { false, errorStr };
+    if (!zip.setCurrentFile(ENTITIES_REFERENCE_FILENAME)) {
+        errorStr = "Failed to find " + ENTITIES_BACKUP_FILENAME + " while recovering backup";
+        return false;
     }
     QuaZipFile zipFile { &zip };
     if (!zipFile.open(QIODevice::ReadOnly)) {
-        QString errorStr("Failed to open " + ENTITIES_BACKUP_FILENAME + " in backup");
-        qCritical() << errorStr;
-        return { false, errorStr };
+        errorStr = "Failed to open " + ENTITIES_REFERENCE_FILENAME + " in backup";
+        return false;
     }
-    auto rawData = zipFile.readAll();
-
+    QString hash = QString::fromLatin1(zipFile.readAll()).trimmed();
     zipFile.close();
 
-    if (zipFile.getZipError() != UNZ_OK) {
-        QString errorStr("Failed to unzip " + ENTITIES_BACKUP_FILENAME + ": " + zipFile.getZipError());
+    QFile storedFile { _entitiesDirectory + hash };
+    if (!storedFile.open(QIODevice::ReadOnly)) {
+        errorStr = "Failed to find the entities " + hash + " of the backup";
+        return false;
+    }
+    entityData = storedFile.readAll();
+    return true;
+}
+
+std::pair<bool, QString> EntitiesBackupHandler::recoverBackup(const QString& backupName, QuaZip& zip, const QString& username, const QString& sourceFilename) {
+    QByteArray rawData;
+    QString errorStr;
+    if (!readEntities(zip, rawData, errorStr)) {
         qCritical() << errorStr;
         return { false, errorStr };
     }
@@ -91,7 +153,53 @@ std::pair<bool, QString> EntitiesBackupHandler::recoverBackup(const QString& bac
     QFile entitiesFile { _entitiesReplacementFilePath };
 
     if (entitiesFile.open(QIODevice::WriteOnly)) {
-        entitiesFile.write(data.toGzippedByteArray());
+        data.writeGzipped(entitiesFile);
     }
     return { true, QString() };
 }
+
+void EntitiesBackupHandler::deleteBackup(const QString& backupName) {
+    auto it = _backups.find(backupName);
+    if (it == _backups.end()) {
+        return;
+    }
+    QString hash = it->second;
+    _backups.erase(it);
+
+    auto isReferenced = std::any_of(_backups.begin(), _backups.end(), [&](const std::pair<const QString, QString>& backup) {
+        return backup.second == hash;
+    });
+    if (!isReferenced && !QFile::remove(_entitiesDirectory + hash)) {
+        qWarning() << "Could not delete the entities" << hash << "of deleted backups";
+    }
+}
+
+void EntitiesBackupHandler::consolidateBackup(const QString& backupName, QuaZip& zip) {
+    auto it = _backups.find(backupName);
+    if (it == _backups.end()) {
+        // the backup holds its entities file already
+        return;
+    }
+
+    QFile storedFile { _entitiesDirectory + it->second };
+    if (!storedFile.open(QIODevice::ReadOnly)) {
+        qCritical() << "Could not open entities file" << storedFile.fileName();
+        return;
+    }
+
+    QuaZipFile zipFile { &zip };
+    if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME, storedFile.fileName()))) {
+        qCritical().nospace() << "Failed to open " << ENTITIES_BACKUP_FILENAME << " for writing in zip";
+        return;
+    }
+    zipFile.write(storedFile.readAll());
+    zipFile.close();
+    if (zipFile.getZipError() != UNZ_OK) {
+        qCritical().nospace() << "Failed to zip " << ENTITIES_BACKUP_FILENAME << ": " << zipFile.getZipError();
+    }
+}
+
+bool EntitiesBackupHandler::isCorruptedBackup(const QString& backupName) {
+    auto it = _backups.find(backupName);
+    return it != _backups.end() && !QFile::exists(_entitiesDirectory + it->second);
+}
@@ -12,16 +12,23 @@
 #ifndef hifi_EntitiesBackupHandler_h
 #define hifi_EntitiesBackupHandler_h
 
+#include <map>
+
+#include <QString>
+
 #include "BackupHandler.h"
 
+// The entities of a backup are kept once per version of the entities file, in the entities directory of the backups
+// under their SHA-256, and the backup archive only references them.  Backups taken while the entities don't change share
+// the same file.  Consolidated archives, as well as the backups made before this, hold the entities file itself.
 class EntitiesBackupHandler : public BackupHandlerInterface {
 public:
-    EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath);
+    EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath, const QString& backupDirectory);
 
     std::pair<bool, float> isAvailable(const QString& backupName) override { return { true, 1.0f }; }
     std::pair<bool, float> getRecoveryStatus() override { return { false, 1.0f }; }
 
-    void loadBackup(const QString& backupName, QuaZip& zip) override {}
+    void loadBackup(const QString& backupName, QuaZip& zip) override;
 
     void loadingComplete() override {}
 
@@ -32,16 +39,22 @@ public:
     std::pair<bool, QString> recoverBackup(const QString& backupName, QuaZip& zip, const QString& username, const QString& sourceFilename) override;
 
     // Delete a skeleton backup
-    void deleteBackup(const QString& backupName) override {}
+    void deleteBackup(const QString& backupName) override;
 
     // Create a full backup
-    void consolidateBackup(const QString& backupName, QuaZip& zip) override {}
+    void consolidateBackup(const QString& backupName, QuaZip& zip) override;
 
-    bool isCorruptedBackup(const QString& backupName) override { return false; }
+    bool isCorruptedBackup(const QString& backupName) override;
 
 private:
+    bool readEntities(QuaZip& zip, QByteArray& entityData, QString& errorStr);
+
     QString _entitiesFilePath;
     QString _entitiesReplacementFilePath;
+    QString _entitiesDirectory;
+
+    // the hash of the entities of each backup that references them
+    std::map<QString, QString> _backups;
 };
 
 #endif /* hifi_EntitiesBackupHandler_h */
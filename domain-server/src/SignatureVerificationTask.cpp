@@ -0,0 +1,57 @@
+//
+//  SignatureVerificationTask.cpp
+//  domain-server/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "SignatureVerificationTask.h"
+
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+
+#include <SharedUtil.h>
+
+#include "WarningsSuppression.h"
+
+SignatureVerificationTask::SignatureVerificationTask(const QByteArray& publicKey, const QByteArray& signedHash,
+                                                     const QByteArray& signature, Callback callback) :
+    _publicKey(publicKey),
+    _signedHash(signedHash),
+    _signature(signature),
+    _callback(callback)
+{
+}
+
+void SignatureVerificationTask::run() {
+    quint64 startTime = usecTimestampNow();
+    Result result = Result::InvalidKey;
+
+    const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(_publicKey.constData());
+
+    OVERTE_IGNORE_DEPRECATED_BEGIN
+
+    // first load up the public key into an RSA struct
+    RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, _publicKey.size());
+
+    if (rsaPublicKey) {
+        int decryptResult = RSA_verify(NID_sha256,
+                                       reinterpret_cast<const unsigned char*>(_signedHash.constData()),
+                                       _signedHash.size(),
+                                       reinterpret_cast<const unsigned char*>(_signature.constData()),
+                                       _signature.size(),
+                                       rsaPublicKey);
+
+        result = decryptResult == 1 ? Result::Verified : Result::SignatureMismatch;
+
+        RSA_free(rsaPublicKey);
+    }
+
+    OVERTE_IGNORE_DEPRECATED_END
+
+    _callback(result, usecTimestampNow() - startTime);
+}
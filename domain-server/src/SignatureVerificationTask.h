@@ -0,0 +1,44 @@
+//
+//  SignatureVerificationTask.h
+//  domain-server/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_SignatureVerificationTask_h
+#define overte_SignatureVerificationTask_h
+
+#include <functional>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QRunnable>
+
+/// Checks the username signature of a connecting user against their public key on a thread of the DomainGatekeeper's
+/// pool, so that the RSA verifications of many connect requests don't hold up the domain-server's thread.
+class SignatureVerificationTask : public QRunnable {
+public:
+    enum class Result {
+        Verified,
+        SignatureMismatch,
+        InvalidKey
+    };
+    // called on the pool's thread
+    using Callback = std::function<void(Result result, quint64 verificationUsecs)>;
+
+    SignatureVerificationTask(const QByteArray& publicKey, const QByteArray& signedHash, const QByteArray& signature,
+                              Callback callback);
+
+    void run() override;
+
+private:
+    QByteArray _publicKey;
+    QByteArray _signedHash;
+    QByteArray _signature;
+    Callback _callback;
+};
+
+#endif // overte_SignatureVerificationTask_h
@@ -13,11 +13,14 @@
 
 #include "IceServer.h"
 
+#include <algorithm>
+
 #include <openssl/x509.h>
 
 #include <QtCore/QDataStream>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
 #include <QtNetwork/QNetworkReply>
 #include <QtNetwork/QNetworkRequest>
@@ -27,6 +30,7 @@
 #include <LimitedNodeList.h>
 #include <NetworkAccessManager.h>
 #include <NetworkingConstants.h>
+#include <NumericalConstants.h>
 #include <MetaverseAPI.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
@@ -36,11 +40,27 @@
 const int CLEAR_INACTIVE_PEERS_INTERVAL_MSECS = 1 * 1000;
 const int PEER_SILENCE_THRESHOLD_MSECS = 5 * 1000;
 
+// the public key of a domain is kept for this long after its last heartbeat, so that a domain that comes back after a
+// restart or a network outage doesn't need its key requested again
+const quint64 DOMAIN_PUBLIC_KEY_TTL_USECS = 60 * 60 * USECS_PER_SECOND;
+// a key that fails to verify a heartbeat is requested again at most this often
+const quint64 PUBLIC_KEY_REREQUEST_INTERVAL_USECS = 10 * USECS_PER_SECOND;
+
+// a batch goes to the pool once it has this many packets, or at the end of the current read
+const size_t MAX_PACKETS_PER_BATCH = 64;
+
+class PacketBatchTask : public QRunnable {
+public:
+    PacketBatchTask(std::function<void()> function) : _function(function) {}
+    void run() override { _function(); }
+private:
+    std::function<void()> _function;
+};
+
 IceServer::IceServer(int argc, char* argv[]) :
     QCoreApplication(argc, argv),
     _id(QUuid::createUuid()),
-    _serverSocket(0, false),
-    _activePeers()
+    _serverSocket(0, false)
 {
     // parse command-line
     QCommandLineParser parser;
@@ -96,8 +116,13 @@ IceServer::IceServer(int argc, char* argv[]) :
     _serverSocket.bind(SocketType::UDP, address, port);
     qDebug() << "ice-server socket is listening on address: " << address.toString() << ":" << port;
 
-    // set processPacket as the verified packet callback for the udt::Socket
-    _serverSocket.setPacketHandler([this](std::unique_ptr<udt::Packet> packet) { processPacket(std::move(packet));  });
+    // the replies are written from the threads of the packet processing pool, they're collected and written in batches
+    // when the platform supports it.  Otherwise the packets are processed on this thread, which owns the UDP socket.
+    _serverSocket.setSendBatchingEnabled(true);
+    _packetProcessingPool.setMaxThreadCount(std::max(QThread::idealThreadCount() - 1, 1));
+
+    // set queuePacket as the verified packet callback for the udt::Socket
+    _serverSocket.setPacketHandler([this](std::unique_ptr<udt::Packet> packet) { queuePacket(std::move(packet));  });
 
     // set packetVersionMatch as the verify packet operator for the udt::Socket
     using std::placeholders::_1;
@@ -124,6 +149,40 @@ bool IceServer::packetVersionMatch(const udt::Packet& packet) {
     }
 }
 
+void IceServer::queuePacket(std::unique_ptr<udt::Packet> packet) {
+    if (!_serverSocket.isSendBatchingEnabled()) {
+        processPacket(std::move(packet));
+        return;
+    }
+
+    _pendingPackets.push_back(std::move(packet));
+
+    if (_pendingPackets.size() >= MAX_PACKETS_PER_BATCH) {
+        dispatchPendingPackets();
+    } else if (!_isDispatchScheduled) {
+        // the rest of the packets of this read go out once the socket is done reading
+        _isDispatchScheduled = true;
+        QTimer::singleShot(0, this, &IceServer::dispatchPendingPackets);
+    }
+}
+
+void IceServer::dispatchPendingPackets() {
+    _isDispatchScheduled = false;
+    if (_pendingPackets.empty()) {
+        return;
+    }
+
+    auto batch = std::make_shared<std::vector<std::unique_ptr<udt::Packet>>>(std::move(_pendingPackets));
+    _pendingPackets.clear();
+
+    _packetProcessingPool.start(new PacketBatchTask([this, batch] {
+        for (auto& packet : *batch) {
+            processPacket(std::move(packet));
+        }
+        _serverSocket.flushSendBatch();
+    }));
+}
+
 void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
 
     auto nlPacket = NLPacket::fromBase(std::move(packet));
@@ -132,18 +191,15 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
     if (nlPacket->getPayloadSize() >= NLPacket::localHeaderSize(PacketType::ICEServerHeartbeat)) {
 
         if (nlPacket->getType() == PacketType::ICEServerHeartbeat) {
-            SharedNetworkPeer peer = addOrUpdateHeartbeatingPeer(*nlPacket);
-            if (peer) {
-                // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
-                peer->activateMatchingOrNewSymmetricSocket(nlPacket->getSenderSockAddr());
-
+            // the replies aren't shared between the threads, writing a packet sets its sequence number
+            if (addOrUpdateHeartbeatingPeer(*nlPacket)) {
                 // we have an active and verified heartbeating peer
                 // send them an ACK packet so they know that they are being heard and ready for ICE
-                static auto ackPacket = NLPacket::create(PacketType::ICEServerHeartbeatACK);
+                auto ackPacket = NLPacket::create(PacketType::ICEServerHeartbeatACK);
                 _serverSocket.writePacket(*ackPacket, nlPacket->getSenderSockAddr());
             } else {
                 // we couldn't verify this peer - respond back to them so they know they may need to perform keypair re-generation
-                static auto deniedPacket = NLPacket::create(PacketType::ICEServerHeartbeatDenied);
+                auto deniedPacket = NLPacket::create(PacketType::ICEServerHeartbeatDenied);
                 _serverSocket.writePacket(*deniedPacket, nlPacket->getSenderSockAddr());
             }
         } else if (nlPacket->getType() == PacketType::ICEServerQuery) {
@@ -161,20 +217,31 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
             QUuid connectRequestID;
             heartbeatStream >> connectRequestID;
 
-            SharedNetworkPeer matchingPeer = _activePeers.value(connectRequestID);
+            // the peer is only read under the lock of its shard, as its heartbeats may be updating it
+            QByteArray matchingPeerInformation;
+            SockAddr matchingPeerSocket;
+            {
+                auto& shard = shardForID(connectRequestID);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                SharedNetworkPeer matchingPeer = shard.activePeers.value(connectRequestID);
+                if (matchingPeer && matchingPeer->getActiveSocket()) {
+                    matchingPeerInformation = matchingPeer->toByteArray();
+                    matchingPeerSocket = *matchingPeer->getActiveSocket();
+                }
+            }
 
-            if (matchingPeer) {
+            if (!matchingPeerInformation.isEmpty()) {
 
                 qDebug() << "Sending information for peer" << connectRequestID << "to peer" << senderUUID;
 
                 // we have the peer they want to connect to - send them pack the information for that peer
-                sendPeerInformationPacket(*matchingPeer, &nlPacket->getSenderSockAddr());
+                sendPeerInformationPacket(matchingPeerInformation, nlPacket->getSenderSockAddr());
 
                 // we also need to send them to the active peer they are hoping to connect to
                 // create a dummy peer object we can pass to sendPeerInformationPacket
 
                 NetworkPeer dummyPeer(senderUUID, publicSocket, localSocket);
-                sendPeerInformationPacket(dummyPeer, matchingPeer->getActiveSocket());
+                sendPeerInformationPacket(dummyPeer.toByteArray(), matchingPeerSocket);
             } else {
                 qDebug() << "Peer" << senderUUID << "asked for" << connectRequestID << "but no matching peer found";
             }
@@ -182,7 +249,7 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
     }
 }
 
-SharedNetworkPeer IceServer::addOrUpdateHeartbeatingPeer(NLPacket& packet) {
+bool IceServer::addOrUpdateHeartbeatingPeer(NLPacket& packet) {
 
     // pull the UUID, public and private sock addrs for this peer
     QUuid senderUUID;
@@ -197,13 +264,16 @@ SharedNetworkPeer IceServer::addOrUpdateHeartbeatingPeer(NLPacket& packet) {
 
     // make sure this is a verified heartbeat before performing any more processing
     if (isVerifiedHeartbeat(senderUUID, signedPlaintext, signature)) {
+        auto& shard = shardForID(senderUUID);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
         // make sure we have this sender in our peer hash
-        SharedNetworkPeer matchingPeer = _activePeers.value(senderUUID);
+        SharedNetworkPeer matchingPeer = shard.activePeers.value(senderUUID);
 
         if (!matchingPeer) {
             // if we don't have this sender we need to create them now
             matchingPeer = QSharedPointer<NetworkPeer>::create(senderUUID, publicSocket, localSocket);
-            _activePeers.insert(senderUUID, matchingPeer);
+            shard.activePeers.insert(senderUUID, matchingPeer);
 
             qDebug() << "Added a new network peer" << *matchingPeer;
         } else {
@@ -215,54 +285,84 @@ SharedNetworkPeer IceServer::addOrUpdateHeartbeatingPeer(NLPacket& packet) {
         // update our last heard microstamp for this network peer to now
         matchingPeer->setLastHeardMicrostamp(usecTimestampNow());
 
-        return matchingPeer;
+        // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
+        matchingPeer->activateMatchingOrNewSymmetricSocket(packet.getSenderSockAddr());
+
+        return true;
     } else {
-        // not verified, return the empty peer object
-        return SharedNetworkPeer();
+        // not verified
+        return false;
     }
 }
 
 bool IceServer::isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature) {
-    // make sure we're not already waiting for a public key for this domain-server
-    if (!_pendingPublicKeyRequests.contains(domainID)) {
-        // check if we have a public key for this domain ID - if we do not then fire off the request for it
-        auto it = _domainPublicKeys.find(domainID);
-        if (it != _domainPublicKeys.end()) {
+    auto& shard = shardForID(domainID);
+    RSASharedPtr rsaPublicKey;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-            // attempt to verify the signature for this heartbeat
-            const auto rsaPublicKey = it->second.get();
+        auto& publicKey = shard.domainPublicKeys[domainID];
+        publicKey.lastUsedTime = usecTimestampNow();
 
-            if (rsaPublicKey) {
-                OVERTE_IGNORE_DEPRECATED_BEGIN
-
-                auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
-                int verificationResult = RSA_verify(NID_sha256,
-                                                    reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
-                                                    hashedPlaintext.size(),
-                                                    reinterpret_cast<const unsigned char*>(signature.constData()),
-                                                    signature.size(),
-                                                    rsaPublicKey);
+        // make sure we're not already waiting for a public key for this domain-server
+        if (publicKey.isRequestPending) {
+            return false;
+        }
 
-                OVERTE_IGNORE_DEPRECATED_END
-                if (verificationResult == 1) {
-                    // this is the only success case - we return true here to indicate that the heartbeat is verified
-                    return true;
-                } else {
-                    qDebug() << "Failed to verify heartbeat for" << domainID << "- re-requesting public key from API.";
-                }
+        // a domain's heartbeats are the same until its sockets change, and so are their signatures
+        if (publicKey.key && !publicKey.verifiedSignature.isEmpty()
+                && publicKey.verifiedSignature == signature && publicKey.verifiedPlaintext == plaintext) {
+            return true;
+        }
+        rsaPublicKey = publicKey.key;
+    }
 
-            } else {
-                // we can't let this user in since we couldn't convert their public key to an RSA key we could use
-                qWarning() << "Public key for" << domainID << "is not a usable RSA* public key.";
-                qWarning() << "Re-requesting public key from API";
+    // check if we have a public key for this domain ID - if we do not then fire off the request for it
+    if (rsaPublicKey) {
+        // attempt to verify the signature for this heartbeat, outside of the lock as it's the costly part
+
+        OVERTE_IGNORE_DEPRECATED_BEGIN
+
+        auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
+        int verificationResult = RSA_verify(NID_sha256,
+                                            reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
+                                            hashedPlaintext.size(),
+                                            reinterpret_cast<const unsigned char*>(signature.constData()),
+                                            signature.size(),
+                                            rsaPublicKey.get());
+
+        OVERTE_IGNORE_DEPRECATED_END
+        if (verificationResult == 1) {
+            // this is the only success case - we return true here to indicate that the heartbeat is verified
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto& publicKey = shard.domainPublicKeys[domainID];
+            if (publicKey.key == rsaPublicKey) {
+                publicKey.verifiedPlaintext = plaintext;
+                publicKey.verifiedSignature = signature;
             }
+            return true;
+        } else {
+            qDebug() << "Failed to verify heartbeat for" << domainID << "- re-requesting public key from API.";
         }
+    }
 
-        // we could not verify this heartbeat (missing public key, could not load public key, bad actor)
-        // ask the directory services API for the right public key and return false to indicate that this is not verified
-        requestDomainPublicKey(domainID);
+    // we could not verify this heartbeat (missing public key, bad actor)
+    // ask the directory services API for the right public key and return false to indicate that this is not verified
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto& publicKey = shard.domainPublicKeys[domainID];
+        auto now = usecTimestampNow();
+        if (publicKey.isRequestPending
+                || (publicKey.key && now - publicKey.lastRequestTime < PUBLIC_KEY_REREQUEST_INTERVAL_USECS)) {
+            return false;
+        }
+        publicKey.isRequestPending = true;
+        publicKey.lastRequestTime = now;
     }
 
+    // the network access manager is used on the thread of the ice-server
+    QMetaObject::invokeMethod(this, [this, domainID] { requestDomainPublicKey(domainID); });
+
     return false;
 }
 
@@ -287,9 +387,6 @@ void IceServer::requestDomainPublicKey(const QUuid& domainID) {
 
     qDebug() << "Requesting public key for domain with ID" << domainID;
 
-    // add this to the set of pending public key requests
-    _pendingPublicKeyRequests.insert(domainID);
-
     networkAccessManager.get(publicKeyRequest);
 }
 
@@ -323,7 +420,12 @@ void IceServer::publicKeyReplyFinished(QNetworkReply* reply) {
                 RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, apiPublicKey.size());
 
                 if (rsaPublicKey) {
-                    _domainPublicKeys[domainID] = { rsaPublicKey, RSA_free };
+                    auto& shard = shardForID(domainID);
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    auto& publicKey = shard.domainPublicKeys[domainID];
+                    publicKey.key = RSASharedPtr(rsaPublicKey, RSA_free);
+                    publicKey.verifiedPlaintext.clear();
+                    publicKey.verifiedSignature.clear();
                 } else {
                     qWarning() << "Could not convert in-memory public key for" << domainID << "to usable RSA public key.";
                     qWarning() << "Public key will be re-requested on next heartbeat.";
@@ -344,39 +446,58 @@ void IceServer::publicKeyReplyFinished(QNetworkReply* reply) {
         qWarning() << "Error retreiving public key for domain with ID" << domainID << "-" <<  reply->errorString();
     }
 
-    // remove this domain ID from the list of pending public key requests
-    _pendingPublicKeyRequests.remove(domainID);
+    // the domain's public key request is no longer pending
+    {
+        auto& shard = shardForID(domainID);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto publicKey = shard.domainPublicKeys.find(domainID);
+        if (publicKey != shard.domainPublicKeys.end()) {
+            publicKey->second.isRequestPending = false;
+        }
+    }
 
     reply->deleteLater();
 }
 
-void IceServer::sendPeerInformationPacket(const NetworkPeer& peer, const SockAddr* destinationSockAddr) {
+void IceServer::sendPeerInformationPacket(const QByteArray& peerInformation, const SockAddr& destinationSockAddr) {
     auto peerPacket = NLPacket::create(PacketType::ICEServerPeerInformation);
 
-    // get the byte array for this peer
-    peerPacket->write(peer.toByteArray());
+    // write the byte array for this peer
+    peerPacket->write(peerInformation);
 
     // write the current packet
-    _serverSocket.writePacket(*peerPacket, *destinationSockAddr);
+    _serverSocket.writePacket(*peerPacket, destinationSockAddr);
 }
 
 void IceServer::clearInactivePeers() {
-    NetworkPeerHash::iterator peerItem = _activePeers.begin();
+    auto now = usecTimestampNow();
 
-    while (peerItem != _activePeers.end()) {
-        SharedNetworkPeer peer = peerItem.value();
+    for (auto& shard : _peerShards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-        if ((usecTimestampNow() - peer->getLastHeardMicrostamp()) > (PEER_SILENCE_THRESHOLD_MSECS * 1000)) {
-            qDebug() << "Removing peer from memory for inactivity -" << *peer;
+        NetworkPeerHash::iterator peerItem = shard.activePeers.begin();
 
-            // if we had a public key for this domain, remove it now
-            _domainPublicKeys.erase(peer->getUUID());
+        while (peerItem != shard.activePeers.end()) {
+            SharedNetworkPeer peer = peerItem.value();
 
-            // remove the peer object
-            peerItem = _activePeers.erase(peerItem);
-        } else {
-            // we didn't kill this peer, push the iterator forwards
-            ++peerItem;
+            if ((now - peer->getLastHeardMicrostamp()) > (PEER_SILENCE_THRESHOLD_MSECS * 1000)) {
+                qDebug() << "Removing peer from memory for inactivity -" << *peer;
+
+                // remove the peer object, its domain's public key is kept for a while in case it comes back
+                peerItem = shard.activePeers.erase(peerItem);
+            } else {
+                // we didn't kill this peer, push the iterator forwards
+                ++peerItem;
+            }
+        }
+
+        auto publicKey = shard.domainPublicKeys.begin();
+        while (publicKey != shard.domainPublicKeys.end()) {
+            if (!publicKey->second.isRequestPending && now - publicKey->second.lastUsedTime > DOMAIN_PUBLIC_KEY_TTL_USECS) {
+                publicKey = shard.domainPublicKeys.erase(publicKey);
+            } else {
+                ++publicKey;
+            }
         }
     }
 }
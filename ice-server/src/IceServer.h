@@ -13,7 +13,13 @@
 #ifndef hifi_IceServer_h
 #define hifi_IceServer_h
 
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <QtCore/QCoreApplication>
+#include <QtCore/QThreadPool>
 #include <QUdpSocket>
 
 #include <openssl/rsa.h>
@@ -35,12 +41,15 @@ public:
 private slots:
     void clearInactivePeers();
     void publicKeyReplyFinished(QNetworkReply* reply);
+    void dispatchPendingPackets();
 private:
     bool packetVersionMatch(const udt::Packet& packet);
+    void queuePacket(std::unique_ptr<udt::Packet> packet);
+    // called on the threads of the packet processing pool
     void processPacket(std::unique_ptr<udt::Packet> packet);
     
-    SharedNetworkPeer addOrUpdateHeartbeatingPeer(NLPacket& incomingPacket);
-    void sendPeerInformationPacket(const NetworkPeer& peer, const SockAddr* destinationSockAddr);
+    bool addOrUpdateHeartbeatingPeer(NLPacket& incomingPacket);
+    void sendPeerInformationPacket(const QByteArray& peerInformation, const SockAddr& destinationSockAddr);
 
     bool isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature);
     void requestDomainPublicKey(const QUuid& domainID);
@@ -49,13 +58,34 @@ private:
     udt::Socket _serverSocket;
 
     using NetworkPeerHash = QHash<QUuid, SharedNetworkPeer>;
-    NetworkPeerHash _activePeers;
 
-    using RSAUniquePtr = std::unique_ptr<RSA, std::function<void(RSA*)>>;
-    using DomainPublicKeyHash = std::unordered_map<QUuid, RSAUniquePtr>;
-    DomainPublicKeyHash _domainPublicKeys;
+    using RSASharedPtr = std::shared_ptr<RSA>;
+    struct DomainPublicKey {
+        RSASharedPtr key;
+        // the last heartbeat verified with the key, the same heartbeat again is verified without RSA
+        QByteArray verifiedPlaintext;
+        QByteArray verifiedSignature;
+        quint64 lastUsedTime { 0 };
+        quint64 lastRequestTime { 0 };
+        bool isRequestPending { false };
+    };
+    using DomainPublicKeyHash = std::unordered_map<QUuid, DomainPublicKey>;
+
+    // the peers and the public keys of their domains are split by ID over shards, each with its lock, so that the
+    // packets of different domains are processed in parallel
+    struct PeerShard {
+        std::mutex mutex;
+        NetworkPeerHash activePeers;
+        DomainPublicKeyHash domainPublicKeys;
+    };
+    static const int NUM_PEER_SHARDS = 16;
+    PeerShard& shardForID(const QUuid& id) { return _peerShards[qHash(id) % NUM_PEER_SHARDS]; }
+    std::array<PeerShard, NUM_PEER_SHARDS> _peerShards;
 
-    QSet<QUuid> _pendingPublicKeyRequests;
+    // the packets read since the last dispatch, they go to the pool in batches
+    std::vector<std::unique_ptr<udt::Packet>> _pendingPackets;
+    bool _isDispatchScheduled { false };
+    QThreadPool _packetProcessingPool;
 };
 
 #endif // hifi_IceServer_h
@@ -92,6 +92,7 @@
 #include <FramebufferCache.h>
 #include <gpu/Batch.h>
 #include <gpu/Context.h>
+#include <HTTPResourceRequest.h>
 #include <InfoView.h>
 #include <input-plugins/InputPlugin.h>
 #include <controllers/UserInputMapper.h>
@@ -134,6 +135,7 @@
 #include <render/EngineStats.h>
 #include <SecondaryCamera.h>
 #include <ResourceCache.h>
+#include <ResourcePrefetcher.h>
 #include <ResourceRequest.h>
 #include <SandboxUtils.h>
 #include <SceneScriptingInterface.h>
@@ -339,6 +341,7 @@ static const float INITIAL_QUERY_RADIUS = 10.0f;  // priority radius for entitie
 static const QString DESKTOP_LOCATION = QStandardPaths::writableLocation(QStandardPaths::DesktopLocation);
 
 Setting::Handle<int> maxOctreePacketsPerSecond{"maxOctreePPS", DEFAULT_MAX_OCTREE_PPS};
+Setting::Handle<int> maxAvatarReceiveKbps{ "maxAvatarReceiveKbps", 0 }; // 0 leaves it to the avatar mixer
 
 Setting::Handle<bool> loginDialogPoppedUp{"loginDialogPoppedUp", false};
 
@@ -577,10 +580,13 @@ public:
 };
 
 void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message) {
+#ifndef Q_OS_ANDROID
+    // the message is formatted and written by the log thread, which passes it on to the log file through the sink
+    LogHandler::getInstance().queueMessage((LogMsgType) type, context, message);
+#else
     QString logMessage = LogHandler::getInstance().printMessage((LogMsgType) type, context, message);
 
     if (!logMessage.isEmpty()) {
-#ifdef Q_OS_ANDROID
         const char * local=logMessage.toStdString().c_str();
         switch (type) {
             case QtDebugMsg:
@@ -600,10 +606,8 @@ void messageHandler(QtMsgType type, const QMessageLogContext& context, const QSt
                 __android_log_write(ANDROID_LOG_FATAL,"Interface",local);
                 abort();
         }
-#else
-        qApp->getLogger()->addMessage(qPrintable(logMessage));
-#endif
     }
+#endif
 }
 
 
@@ -845,6 +849,7 @@ bool setupEssentials(const QCommandLineParser& parser, bool runningMarkerExisted
     DependencyManager::set<StandAloneJSConsole>();
     DependencyManager::set<DialogsManager>();
     DependencyManager::set<ResourceCacheSharedItems>();
+    DependencyManager::set<ResourcePrefetcher>();
     DependencyManager::set<DesktopScriptingInterface>();
     DependencyManager::set<EntityScriptingInterface>(true);
     DependencyManager::set<GraphicsScriptingInterface>();
@@ -1038,6 +1043,11 @@ Application::Application(
 
     LogHandler::getInstance().moveToThread(thread());
     LogHandler::getInstance().setupRepeatedMessageFlusher();
+#ifndef Q_OS_ANDROID
+    LogHandler::getInstance().setMessageSink([](LogMsgType, const QString& logMessage) {
+        qApp->getLogger()->addMessage(qPrintable(logMessage));
+    });
+#endif
     qInstallMessageHandler(messageHandler);
 
     DependencyManager::set<PathUtils>();
@@ -1082,9 +1092,11 @@ void Application::initializePluginManager(const QCommandLineParser& parser) {
 }
 
 void Application::initialize(const QCommandLineParser &parser) {
+    markStartup("initialize");
 
     //qCDebug(interfaceapp) << "Setting up essentials";
     setupEssentials(parser, _previousSessionCrashed);
+    markStartup("essentials");
     qCDebug(interfaceapp) << "Initializing application";
 
     _entitySimulation = std::make_shared<PhysicalEntitySimulation>();
@@ -1099,6 +1111,7 @@ void Application::initialize(const QCommandLineParser &parser) {
 
     auto steamClient = PluginManager::getInstance()->getSteamClientPlugin();
     setProperty(hifi::properties::STEAM, (steamClient && steamClient->isRunning()));
+    markStartup("runtime plugins");
 
 
     {
@@ -1188,6 +1201,9 @@ void Application::initialize(const QCommandLineParser &parser) {
     nodeList->startThread();
     nodeList->setFlagTimeForConnectionStep(true);
 
+    // ask the mixers for parity on their unreliable streams when the link from them is lossy
+    nodeList->setForwardErrorCorrectionRequestsEnabled(true);
+
     // move the AddressManager to the NodeList thread so that domain resets due to domain changes always occur
     // before we tell MyAvatar to go to a new location in the new domain
     auto addressManager = DependencyManager::get<AddressManager>();
@@ -1414,6 +1430,11 @@ void Application::initialize(const QCommandLineParser &parser) {
     connect(addressManager.data(), &AddressManager::hostChanged, this, &Application::updateWindowTitle);
     connect(this, &QCoreApplication::aboutToQuit, addressManager.data(), &AddressManager::storeCurrentAddress);
 
+    // warm the resource caches with what the domain needed on earlier visits as soon as we start going there
+    auto resourcePrefetcher = DependencyManager::get<ResourcePrefetcher>();
+    connect(addressManager.data(), &AddressManager::hostChanged, resourcePrefetcher.data(), &ResourcePrefetcher::beginDomain);
+    connect(this, &QCoreApplication::aboutToQuit, resourcePrefetcher.data(), &ResourcePrefetcher::saveManifests);
+
     connect(this, &Application::activeDisplayPluginChanged, this, &Application::updateThreadPoolCount);
     if (parser.isSet("system-cursor")) {
         _preferredCursor.set(Cursor::Manager::getIconName(Cursor::Icon::SYSTEM));
@@ -1522,6 +1543,14 @@ void Application::initialize(const QCommandLineParser &parser) {
         ResourceCache::setRequestLimit(concurrentDownloads);
     }
 
+    if (parser.isSet("concurrent-downloads-per-host")) {
+        bool success;
+        int concurrentDownloadsPerHost = parser.value("concurrent-downloads-per-host").toInt(&success);
+        if (success) {
+            HTTPResourceRequest::setMaxRequestsPerHost(concurrentDownloadsPerHost);
+        }
+    }
+
     // perhaps override the avatar url.  Since we will test later for validity
     // we don't need to do so here.
     if (parser.isSet("avatarURL")) {
@@ -1560,10 +1589,12 @@ void Application::initialize(const QCommandLineParser &parser) {
     // Create the main thread context, the GPU backend
     initializeGL();
     qCDebug(interfaceapp, "Initialized GL");
+    markStartup("GL");
 
     // Initialize the display plugin architecture
     initializeDisplayPlugins();
     qCDebug(interfaceapp, "Initialized Display");
+    markStartup("display plugins");
 
     if (_displayPlugin && !_displayPlugin->isHmd()) {
         showCursor(Cursor::Manager::lookupIcon(_preferredCursor.get()));
@@ -1598,6 +1629,7 @@ void Application::initialize(const QCommandLineParser &parser) {
     // GPU pipeline creation.
     initializeRenderEngine();
     qCDebug(interfaceapp, "Initialized Render Engine.");
+    markStartup("render engine");
 
     // Overlays need to exist before we set the ContextOverlayInterface dependency
     _overlays.init(); // do this before scripts load
@@ -1635,9 +1667,11 @@ void Application::initialize(const QCommandLineParser &parser) {
     // Initialize the user interface and menu system
     // Needs to happen AFTER the render engine initialization to access its configuration
     initializeUi();
+    markStartup("UI");
 
     init();
     qCDebug(interfaceapp, "init() complete.");
+    markStartup("init");
 
     // create thread for parsing of octree data independent of the main network and rendering threads
     _octreeProcessor->initialize(_enableProcessOctreeThread);
@@ -1708,8 +1742,6 @@ void Application::initialize(const QCommandLineParser &parser) {
         // sessionRunTime will be reset soon by loadSettings. Grab it now to get previous session value.
         // The value will be 0 if the user blew away settings this session, which is both a feature and a bug.
         static const QString TESTER = "HIFI_TESTER";
-        auto gpuIdent = GPUIdent::getInstance();
-        auto glContextData = gl::ContextInfo::get();
         QJsonObject properties = {
             { "version", applicationVersion() },
             { "tester", QProcessEnvironment::systemEnvironment().contains(TESTER) || isTester },
@@ -1723,14 +1755,6 @@ void Application::initialize(const QCommandLineParser &parser) {
             { "kernel_version", QSysInfo::kernelVersion() },
             { "os_type", QSysInfo::productType() },
             { "os_version", QSysInfo::productVersion() },
-            { "gpu_name", gpuIdent->getName() },
-            { "gpu_driver", gpuIdent->getDriver() },
-            { "gpu_memory", static_cast<qint64>(gpuIdent->getMemory()) },
-            { "gl_version_int", glVersionToInteger(glContextData.version.c_str()) },
-            { "gl_version", glContextData.version.c_str() },
-            { "gl_vender", glContextData.vendor.c_str() },
-            { "gl_sl_version", glContextData.shadingLanguageVersion.c_str() },
-            { "gl_renderer", glContextData.renderer.c_str() },
             { "ideal_thread_count", QThread::idealThreadCount() }
         };
         auto macVersion = QSysInfo::macVersion();
@@ -1742,22 +1766,37 @@ void Application::initialize(const QCommandLineParser &parser) {
             properties["os_win_version"] = QSysInfo::windowsVersion();
         }
 
-        ProcessorInfo procInfo;
-        if (getProcessorInfo(procInfo)) {
-            properties["processor_core_count"] = procInfo.numProcessorCores;
-            properties["logical_processor_count"] = procInfo.numLogicalProcessors;
-            properties["processor_l1_cache_count"] = procInfo.numProcessorCachesL1;
-            properties["processor_l2_cache_count"] = procInfo.numProcessorCachesL2;
-            properties["processor_l3_cache_count"] = procInfo.numProcessorCachesL3;
-        }
-
         properties["first_run"] = _firstRun.get();
 
-        // add the user's machine ID to the launch event
-        QString machineFingerPrint = uuidStringWithoutCurlyBraces(FingerprintUtils::getMachineFingerprint());
-        properties["machine_fingerprint"] = machineFingerPrint;
+        // Identifying the GPU, the processor and the machine can be slow, so the rest of the launch event
+        // is filled in and sent once the first frame is up.
+        runAfterFirstFrame([properties]() mutable {
+            auto gpuIdent = GPUIdent::getInstance();
+            auto glContextData = gl::ContextInfo::get();
+            properties["gpu_name"] = gpuIdent->getName();
+            properties["gpu_driver"] = gpuIdent->getDriver();
+            properties["gpu_memory"] = static_cast<qint64>(gpuIdent->getMemory());
+            properties["gl_version_int"] = glVersionToInteger(glContextData.version.c_str());
+            properties["gl_version"] = glContextData.version.c_str();
+            properties["gl_vender"] = glContextData.vendor.c_str();
+            properties["gl_sl_version"] = glContextData.shadingLanguageVersion.c_str();
+            properties["gl_renderer"] = glContextData.renderer.c_str();
+
+            ProcessorInfo procInfo;
+            if (getProcessorInfo(procInfo)) {
+                properties["processor_core_count"] = procInfo.numProcessorCores;
+                properties["logical_processor_count"] = procInfo.numLogicalProcessors;
+                properties["processor_l1_cache_count"] = procInfo.numProcessorCachesL1;
+                properties["processor_l2_cache_count"] = procInfo.numProcessorCachesL2;
+                properties["processor_l3_cache_count"] = procInfo.numProcessorCachesL3;
+            }
+
+            // add the user's machine ID to the launch event
+            QString machineFingerPrint = uuidStringWithoutCurlyBraces(FingerprintUtils::getMachineFingerprint());
+            properties["machine_fingerprint"] = machineFingerPrint;
 
-        userActivityLogger.logAction("launch", properties);
+            UserActivityLogger::getInstance().logAction("launch", properties);
+        });
     }
 
     _entityEditSender->setMyAvatar(myAvatar.get());
@@ -2051,7 +2090,8 @@ void Application::initialize(const QCommandLineParser &parser) {
         applicationUpdater->setInstallerType(type);
         applicationUpdater->setInstallerCampaign(installerCampaign);
         connect(applicationUpdater.data(), &AutoUpdater::newVersionIsAvailable, dialogsManager.data(), &DialogsManager::showUpdateDialog);
-        applicationUpdater->checkForUpdate();
+        // the update check goes out to the network, which the first frame doesn't need to wait for
+        runAfterFirstFrame([applicationUpdater] { applicationUpdater->checkForUpdate(); });
     }
 
     Menu::getInstance()->setIsOptionChecked(MenuOption::ActionMotorControl, true);
@@ -2444,7 +2484,9 @@ void Application::initialize(const QCommandLineParser &parser) {
         return entityServerNode && !isPhysicsEnabled();
     });
 
-    _snapshotSound = DependencyManager::get<SoundCache>()->getSound(PathUtils::resourcesUrl("sounds/snapshot/snap.wav"));
+    runAfterFirstFrame([this] {
+        _snapshotSound = DependencyManager::get<SoundCache>()->getSound(PathUtils::resourcesUrl("sounds/snapshot/snap.wav"));
+    });
 
     // Monitor model assets (e.g., from Clara.io) added to the world that may need resizing.
     static const int ADD_ASSET_TO_WORLD_TIMER_INTERVAL_MS = 1000;
@@ -2619,7 +2661,7 @@ void Application::initialize(const QCommandLineParser &parser) {
 
     // Preload Tablet sounds
     DependencyManager::get<EntityScriptingInterface>()->setEntityTree(qApp->getEntities()->getTree());
-    DependencyManager::get<TabletScriptingInterface>()->preloadSounds();
+    runAfterFirstFrame([] { DependencyManager::get<TabletScriptingInterface>()->preloadSounds(); });
     DependencyManager::get<Keyboard>()->createKeyboard();
 
     // Initialize Discord rich presence
@@ -2646,6 +2688,40 @@ void Application::initialize(const QCommandLineParser &parser) {
     AndroidHelper::instance().notifyLoadComplete();
 #endif
     pauseUntilLoginDetermined();
+    markStartup("initialized");
+}
+
+void Application::markStartup(const char* name) {
+    _startupTimeline.emplace_back(name, _sessionRunTimer.elapsed());
+}
+
+void Application::runAfterFirstFrame(std::function<void()> function) {
+    if (_firstFrameRendered) {
+        function();
+    } else {
+        _afterFirstFrame.push_back(std::move(function));
+    }
+}
+
+void Application::firstFrameRendered() {
+    if (_firstFrameRendered) {
+        return;
+    }
+    _firstFrameRendered = true;
+    markStartup("first frame");
+
+    qCDebug(interfaceapp) << "Startup timeline:";
+    qint64 previous = 0;
+    for (const auto& mark : _startupTimeline) {
+        qCDebug(interfaceapp, "  %-16s %7lld ms  (+%lld ms)", mark.first, (long long)mark.second, (long long)(mark.second - previous));
+        previous = mark.second;
+    }
+
+    auto afterFirstFrame = std::move(_afterFirstFrame);
+    _afterFirstFrame.clear();
+    for (const auto& function : afterFirstFrame) {
+        function();
+    }
 }
 
 void Application::setFailedToConnectToEntityServer() {
@@ -2849,6 +2925,8 @@ void Application::cleanupBeforeQuit() {
         tracer->serialize(outputFile);
     }
 
+    _performanceManager.getTelemetry().finishSession();
+
     // Stop third party processes so that they're not left running in the event of a subsequent shutdown crash.
     AnimDebugDraw::getInstance().shutdown();
 
@@ -3002,6 +3080,7 @@ Application::~Application() {
 
     DependencyManager::destroy<SoundCacheScriptingInterface>();
 
+    DependencyManager::destroy<ResourcePrefetcher>(); // holds resources of the caches below
     DependencyManager::destroy<AudioInjectorManager>();
     DependencyManager::destroy<AvatarManager>();
     DependencyManager::destroy<AnimationCacheScriptingInterface>();
@@ -3048,6 +3127,8 @@ Application::~Application() {
 
     // Can't log to file past this point, FileLogger about to be deleted
     qInstallMessageHandler(LogHandler::verboseMessageHandler);
+    LogHandler::getInstance().flush();
+    LogHandler::getInstance().setMessageSink(nullptr);
 
 #ifdef Q_OS_MAC
     // 26 Feb 2021 - Tried re-enabling this call but OSX still crashes on exit.
@@ -4206,9 +4287,23 @@ bool Application::importImage(const QString& urlString) {
 
 // thread-safe
 void Application::onPresent(quint32 frameCount) {
+    uint64_t now = usecTimestampNow();
+    uint64_t idleDelay = _performanceManager.getFramePacer().presented(now);
     bool expected = false;
     if (_pendingIdleEvent.compare_exchange_strong(expected, true)) {
-        postEvent(this, new QEvent((QEvent::Type)ApplicationEvent::Idle), Qt::HighEventPriority);
+        if (idleDelay == 0) {
+            postEvent(this, new QEvent((QEvent::Type)ApplicationEvent::Idle), Qt::HighEventPriority);
+        } else {
+            // start the game loop late enough that the head pose it samples is fresh when the frame is presented
+            uint64_t idleTime = now + idleDelay;
+            postLambdaEvent([this, idleTime] {
+                uint64_t now = usecTimestampNow();
+                int msecs = idleTime > now ? (int)((idleTime - now) / USECS_PER_MSEC) : 0;
+                QTimer::singleShot(msecs, Qt::PreciseTimer, this, [this] {
+                    postEvent(this, new QEvent((QEvent::Type)ApplicationEvent::Idle), Qt::HighEventPriority);
+                });
+            });
+        }
     }
     expected = false;
     if (_graphicsEngine->checkPendingRenderEvent() && !isAboutToQuit()) {
@@ -4324,8 +4419,10 @@ bool Application::event(QEvent* event) {
 
         // Explicit idle keeps the idle running at a lower interval, but without any rendering
         // see (windowMinimizedChanged)
-        case ApplicationEvent::Idle:
+        case ApplicationEvent::Idle: {
+            uint64_t idleStart = usecTimestampNow();
             idle();
+            _performanceManager.getFramePacer().setUpdateTime(usecTimestampNow() - idleStart);
 
 #ifdef DEBUG_EVENT_QUEUE_DEPTH
             // The event queue may very well grow beyond 400, so
@@ -4341,6 +4438,7 @@ bool Application::event(QEvent* event) {
             _pendingIdleEvent.store(false);
 
             return true;
+        }
 
         case QEvent::MouseMove:
             mouseMoveEvent(static_cast<QMouseEvent*>(event));
@@ -5390,7 +5488,13 @@ void Application::idle() {
         PerformanceTimer perfTimer("update");
         PerformanceWarning warn(showWarnings, "Application::idle()... update()");
         static const float BIGGEST_DELTA_TIME_SECS = 0.25f;
+        auto updateStart = std::chrono::high_resolution_clock::now();
         update(glm::clamp(secondsSinceLastUpdate, 0.0f, BIGGEST_DELTA_TIME_SECS));
+        float gameLoopTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - updateStart).count();
+        _performanceManager.getFrameBudget().setCost(FrameBudget::GAME_LOOP, gameLoopTime);
+        auto& telemetry = _performanceManager.getTelemetry();
+        telemetry.addSample(PerformanceTelemetry::FRAME, secondsSinceLastUpdate * (float)MSECS_PER_SECOND);
+        telemetry.addSample(PerformanceTelemetry::GAME_LOOP, gameLoopTime);
     }
 
     { // Update keyboard focus highlight
@@ -5613,6 +5717,7 @@ void Application::loadSettings(const QCommandLineParser& parser) {
     // Setup the PerformanceManager which will enforce the several settings to match the Preset
     // On the first run, the Preset is evaluated from the
     getPerformanceManager().setupPerformancePresetSettings(_firstRun.get());
+    getPerformanceManager().getTelemetry().sendPendingSummaries();
 
     // finish initializing the camera, based on everything we checked above. Third person camera will be used if no settings
     // dictated that we should be in first person
@@ -5743,6 +5848,10 @@ void Application::init() {
         return atan2(maxSize, distance);
     });
 
+    // the BVHs of the static meshes are kept on disk, so the meshes collide as soon as they're loaded again
+    auto shapeCache = std::make_shared<ShapeCache>();
+    shapeCache->initialize();
+    _shapeManager.setShapeCache(shapeCache);
     ObjectMotionState::setShapeManager(&_shapeManager);
     _physicsEngine->init();
 
@@ -6348,7 +6457,14 @@ void Application::updateSecondaryCameraViewFrustum() {
     // which is not what we want here.
     secondaryViewFrustum.calculate();
 
-    _conicalViews.push_back(secondaryViewFrustum);
+    // The entity server sends what the secondary camera sees after what the main camera does, at a coarser LOD, and
+    // follows its changes less often.
+    static const float SECONDARY_VIEW_PRIORITY_WEIGHT = 0.25f;
+    static const float SECONDARY_VIEW_LOD_SCALE = 2.0f;
+    ConicalViewFrustum secondaryView(secondaryViewFrustum);
+    secondaryView.setPriorityWeight(SECONDARY_VIEW_PRIORITY_WEIGHT);
+    secondaryView.setLODScale(SECONDARY_VIEW_LOD_SCALE);
+    _conicalViews.push_back(secondaryView);
 }
 
 static bool domainLoadingInProgress = false;
@@ -6724,6 +6840,19 @@ void Application::update(float deltaTime) {
                     timings[3] = t4 - t3; // postPhysics
                     timings[4] = t5 - t4; // non-physical kinematics
                     timings[5] = workload::Timing_ns((int32_t)(NSECS_PER_SECOND * deltaTime)); // game loop duration
+                    auto& frameBudget = _performanceManager.getFrameBudget();
+                    frameBudget.setCost(FrameBudget::PHYSICS, std::chrono::duration<float, std::milli>(t4 - t2).count());
+                    frameBudget.setCost(FrameBudget::KINEMATICS, std::chrono::duration<float, std::milli>(t5 - t4).count());
+                    auto& telemetry = _performanceManager.getTelemetry();
+                    telemetry.addSample(PerformanceTelemetry::PHYSICS, std::chrono::duration<float, std::milli>(t4 - t2).count());
+                    telemetry.addSample(PerformanceTelemetry::ENTITIES,
+                        std::chrono::duration<float, std::milli>((t1 - t0) + (t5 - t4)).count());
+                    if (frameBudget.isEnabled()) {
+                        timings.push_back(std::chrono::duration_cast<workload::Timing_ns>(
+                            std::chrono::duration<float, std::milli>(frameBudget.getBudget(FrameBudget::PHYSICS)))); // physics budget
+                        timings.push_back(std::chrono::duration_cast<workload::Timing_ns>(
+                            std::chrono::duration<float, std::milli>(frameBudget.getBudget(FrameBudget::KINEMATICS)))); // kinematics budget
+                    }
                     _gameWorkload.updateSimulationTimings(timings);
                 }
             }
@@ -6739,6 +6868,7 @@ void Application::update(float deltaTime) {
 
     // AvatarManager update
     {
+        auto avatarsStart = std::chrono::high_resolution_clock::now();
         {
             PROFILE_RANGE(simulation, "OtherAvatars");
             PerformanceTimer perfTimer("otherAvatars");
@@ -6751,11 +6881,42 @@ void Application::update(float deltaTime) {
             qApp->updateMyAvatarLookAtPosition(deltaTime);
             avatarManager->updateMyAvatar(deltaTime);
         }
+        float animationTime =
+            std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - avatarsStart).count();
+        _performanceManager.getFrameBudget().setCost(FrameBudget::ANIMATION, animationTime);
+        _performanceManager.getTelemetry().addSample(PerformanceTelemetry::ANIMATION, animationTime);
     }
 
     bool showWarnings = Menu::getInstance()->isOptionChecked(MenuOption::PipelineWarnings);
     PerformanceWarning warn(showWarnings, "Application::update()");
 
+    {
+        auto lodManager = DependencyManager::get<LODManager>();
+        auto& frameBudget = _performanceManager.getFrameBudget();
+        frameBudget.setCost(FrameBudget::RENDER, lodManager->getSmoothRenderTime());
+
+        auto& telemetry = _performanceManager.getTelemetry();
+        if (telemetry.isEnabled()) {
+            telemetry.addSample(PerformanceTelemetry::RENDER_CPU, lodManager->getEngineRunTime() + lodManager->getBatchTime());
+            telemetry.addSample(PerformanceTelemetry::RENDER_GPU, lodManager->getGPUTime());
+            // the scripts run on their own threads, so it's the time they took since the last game loop
+            static quint64 lastScriptTime = ScriptManager::getTotalScriptTime();
+            quint64 scriptTime = ScriptManager::getTotalScriptTime();
+            telemetry.addSample(PerformanceTelemetry::SCRIPTS, (float)(scriptTime - lastScriptTime) / (float)USECS_PER_MSEC);
+            lastScriptTime = scriptTime;
+        }
+        frameBudget.update(lodManager->getLODTargetFPS(), deltaTime);
+        lodManager->setBudgetTargetFPS(frameBudget.getRenderTargetFPS());
+
+        // the desktop displays don't wait for the vsync to present, only the HMDs can be paced
+        _performanceManager.getFramePacer().setActive(isHMDMode() && !isThrottleRendering());
+
+        auto& dynamicResolution = _performanceManager.getDynamicResolution();
+        if (!isThrottleRendering() && dynamicResolution.update((float)getGPUContext()->getFrameTimerGPUAverage(),
+                lodManager->getLODTargetFPS(), deltaTime)) {
+            RenderScriptingInterface::getInstance()->setDynamicResolutionScale(dynamicResolution.getScale());
+        }
+    }
     updateLOD(deltaTime);
 
     if (!_loginDialogID.isNull()) {
@@ -6788,6 +6949,7 @@ void Application::update(float deltaTime) {
     }
 
     quint64 now = usecTimestampNow();
+    auto networkStart = std::chrono::high_resolution_clock::now();
 
     // Update my voxel servers with my current voxel query...
     {
@@ -6806,7 +6968,10 @@ void Application::update(float deltaTime) {
         } else {
             viewIsDifferentEnough = true;
         }
-
+        if (viewIsDifferentEnough) {
+            // the owners of the pending downloads may rank them differently from here
+            ResourceCache::reprioritizeRequests();
+        }
 
         // if it's been a while since our last query or the view has significantly changed then send a query, otherwise suppress it
         static const std::chrono::seconds MIN_PERIOD_BETWEEN_QUERIES { 3 };
@@ -6841,6 +7006,8 @@ void Application::update(float deltaTime) {
             QMetaObject::invokeMethod(DependencyManager::get<AudioClient>().data(), "sendDownstreamAudioStatsPacket", Qt::QueuedConnection);
         }
     }
+    _performanceManager.getTelemetry().addSample(PerformanceTelemetry::NETWORK,
+        std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - networkStart).count());
 
     {
         PerformanceTimer perfTimer("avatarManager/postUpdate");
@@ -6887,6 +7054,7 @@ void Application::updateRenderArgs(float deltaTime) {
     _graphicsEngine->editRenderArgs([this, deltaTime](AppRenderArgs& appRenderArgs) {
         PerformanceTimer perfTimer("editRenderArgs");
         appRenderArgs._headPose = getHMDSensorPose();
+        appRenderArgs._headPoseTimestamp = usecTimestampNow();
 
         auto myAvatar = getMyAvatar();
 
@@ -7028,6 +7196,15 @@ void Application::queryAvatars() {
             destinationBuffer += view.serialize(destinationBuffer);
         }
 
+        // let the mixer send us no more avatar updates than we can render
+        uint8_t maxUpdateRate = (uint8_t)glm::clamp((int)ceilf(getRenderLoopRate()), 0, (int)UINT8_MAX);
+        memcpy(destinationBuffer, &maxUpdateRate, sizeof(maxUpdateRate));
+        destinationBuffer += sizeof(maxUpdateRate);
+
+        uint16_t maxReceiveKbps = (uint16_t)glm::clamp(maxAvatarReceiveKbps.get(), 0, (int)UINT16_MAX);
+        memcpy(destinationBuffer, &maxReceiveKbps, sizeof(maxReceiveKbps));
+        destinationBuffer += sizeof(maxReceiveKbps);
+
         avatarPacket->setPayloadSize(destinationBuffer - bufferStart);
 
         DependencyManager::get<NodeList>()->broadcastToNodes(std::move(avatarPacket), NodeSet() << NodeType::AvatarMixer);
@@ -7124,6 +7301,8 @@ void Application::queryOctree(NodeType_t serverType, PacketType packetType) {
         _octreeQuery.setBoundaryLevelAdjust(lodManager->getBoundaryLevelAdjust());
     }
     _octreeQuery.setReportInitialCompletion(isModifiedQuery);
+    _octreeQuery.setWantCompressionDictionary(true);
+    _octreeQuery.setCompressionDictionaryChecksum(getEntities()->getCompressionDictionaryChecksum());
 
 
     auto nodeList = DependencyManager::get<NodeList>();
@@ -8757,7 +8936,8 @@ void Application::shareSnapshot(const QString& path, const QUrl& href) {
 }
 
 float Application::getRenderResolutionScale() const {
-    return RenderScriptingInterface::getInstance()->getViewportResolutionScale();
+    return RenderScriptingInterface::getInstance()->getViewportResolutionScale() *
+        _performanceManager.getDynamicResolution().getScale();
 }
 
 void Application::notifyPacketVersionMismatch() {
@@ -9549,6 +9729,19 @@ void Application::saveNextPhysicsStats(QString filename) {
     _physicsEngine->saveNextPhysicsStats(filename);
 }
 
+// the recording is started and stopped between two steps
+void Application::startPhysicsRecording(QString filename) {
+    QMetaObject::invokeMethod(this, [this, filename] {
+        _physicsEngine->startRecording(filename);
+    });
+}
+
+void Application::stopPhysicsRecording() {
+    QMetaObject::invokeMethod(this, [this] {
+        _physicsEngine->stopRecording();
+    });
+}
+
 void Application::copyToClipboard(const QString& text) {
     if (QThread::currentThread() != qApp->thread()) {
         QMetaObject::invokeMethod(this, "copyToClipboard");
@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include <QtCore/QCommandLineParser>
 #include <QtCore/QHash>
@@ -239,6 +240,7 @@ public:
     size_t getRenderFrameCount() const { return _graphicsEngine->getRenderFrameCount(); }
     float getRenderLoopRate() const { return _graphicsEngine->getRenderLoopRate(); }
     float getNumCollisionObjects() const;
+    const PhysicalEntitySimulationPointer& getEntitySimulation() const { return _entitySimulation; }
     float getTargetRenderFrameRate() const; // frames/second
 
     static void setupQmlSurface(QQmlContext* surfaceContext, bool setAdditionalContextProperties);
@@ -295,6 +297,12 @@ public:
 
     qint64 getCurrentSessionRuntime() const { return _sessionRunTimer.elapsed(); }
 
+    // Marks a point of the startup timeline, which is written to the log once the first frame has been rendered
+    void markStartup(const char* name);
+
+    // Runs the given function after the first frame has been rendered, for startup work that shouldn't hold it back
+    void runAfterFirstFrame(std::function<void()> function);
+
     bool isAboutToQuit() const { return _aboutToQuit; }
     bool isPhysicsEnabled() const { return _physicsEnabled; }
     PhysicsEnginePointer getPhysicsEngine() { return _physicsEngine; }
@@ -346,6 +354,8 @@ public:
     QUrl getAvatarOverrideUrl() { return _avatarOverrideUrl; }
     bool getSaveAvatarOverrideUrl() { return _saveAvatarOverrideUrl; }
     void saveNextPhysicsStats(QString filename);
+    void startPhysicsRecording(QString filename);
+    void stopPhysicsRecording();
 
     bool isServerlessMode() const;
     bool isInterstitialMode() const { return _interstitialMode; }
@@ -581,6 +591,8 @@ private slots:
 
     void setShowTrackedObjects(bool value);
 
+    void firstFrameRendered();
+
 private:
     void init();
     bool initMenu();
@@ -654,6 +666,9 @@ private:
     // initializers. Fixes a deadlock issue with recent Qt versions.
     bool _isMenuInitialized;
     QElapsedTimer& _sessionRunTimer;
+    std::vector<std::pair<const char*, qint64>> _startupTimeline;
+    std::vector<std::function<void()>> _afterFirstFrame;
+    bool _firstFrameRendered { false };
 
     bool _aboutToQuit { false };
 
@@ -0,0 +1,124 @@
+//
+//  DynamicResolution.cpp
+//  interface/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "DynamicResolution.h"
+
+#include <glm/glm.hpp>
+
+#include <NumericalConstants.h>
+
+static const float DEFAULT_TARGET_SHARE = 0.9f;
+static const float MIN_TARGET_SHARE = 0.5f;
+static const float MAX_TARGET_SHARE = 1.0f;
+static const float DEFAULT_MIN_SCALE = 0.5f;
+static const float LOWEST_MIN_SCALE = 0.25f;
+static const float MAX_SCALE = 1.0f;
+
+// the gains of the controller, per msec that the GPU is over its target: the integral lowers the scale by about SCALE_GAIN
+// a second, the proportional and derivative terms make it react faster to a sudden increase of the load
+static const float PROPORTIONAL_GAIN = 0.02f;
+static const float SCALE_GAIN = 0.05f;
+static const float DERIVATIVE_GAIN = 0.002f;
+
+// every change of the scale rebuilds the framebuffers of the view, so it changes in steps, quickly when the frames are
+// late and slowly when there's time to spare
+static const float SCALE_STEP = 0.05f;
+static const float MIN_TIME_BETWEEN_DECREASES = 0.5f; // sec
+static const float MIN_TIME_BETWEEN_INCREASES = 2.0f; // sec
+
+DynamicResolution::DynamicResolution() :
+    _targetShare(DEFAULT_TARGET_SHARE),
+    _minScale(DEFAULT_MIN_SCALE)
+{
+}
+
+bool DynamicResolution::update(float gpuTime, float targetFPS, float realTimeDelta) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _gpuTime = gpuTime;
+    if (!_enabled || targetFPS <= 0.0f || gpuTime <= 0.0f || realTimeDelta <= 0.0f) {
+        return false;
+    }
+    _targetGPUTime = _targetShare * (float)MSECS_PER_SECOND / targetFPS;
+    _timeSinceChange += realTimeDelta;
+
+    // the error is positive when the GPU is over its target, the integral is kept in the range of the reductions so that
+    // it doesn't wind up while the scale is at one of its limits
+    float maxReduction = MAX_SCALE - _minScale;
+    float error = gpuTime - _targetGPUTime;
+    _integral = glm::clamp(_integral + error * realTimeDelta, 0.0f, maxReduction / SCALE_GAIN);
+    float derivative = (error - _lastError) / realTimeDelta;
+    _lastError = error;
+    float reduction = PROPORTIONAL_GAIN * error + SCALE_GAIN * _integral + DERIVATIVE_GAIN * derivative;
+    _controlledScale = MAX_SCALE - glm::clamp(reduction, 0.0f, maxReduction);
+
+    float scale = _scale;
+    if (_controlledScale <= _scale - SCALE_STEP && _timeSinceChange >= MIN_TIME_BETWEEN_DECREASES) {
+        scale = _scale - SCALE_STEP * glm::floor((_scale - _controlledScale) / SCALE_STEP);
+    } else if (_controlledScale >= _scale + SCALE_STEP && _timeSinceChange >= MIN_TIME_BETWEEN_INCREASES) {
+        scale = _scale + SCALE_STEP;
+    }
+    scale = glm::clamp(scale, _minScale, MAX_SCALE);
+    if (scale == _scale) {
+        return false;
+    }
+    _scale = scale;
+    _timeSinceChange = 0.0f;
+    return true;
+}
+
+void DynamicResolution::setEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    // start again from the full scale
+    _integral = 0.0f;
+    _lastError = 0.0f;
+    _timeSinceChange = 0.0f;
+    _scale = MAX_SCALE;
+    _controlledScale = MAX_SCALE;
+    _enabled = enabled;
+}
+
+float DynamicResolution::getScale() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _enabled ? _scale : MAX_SCALE;
+}
+
+float DynamicResolution::getTargetShare() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _targetShare;
+}
+
+void DynamicResolution::setTargetShare(float share) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _targetShare = glm::clamp(share, MIN_TARGET_SHARE, MAX_TARGET_SHARE);
+}
+
+float DynamicResolution::getMinScale() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _minScale;
+}
+
+void DynamicResolution::setMinScale(float scale) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _minScale = glm::clamp(scale, LOWEST_MIN_SCALE, MAX_SCALE);
+}
+
+QVariantMap DynamicResolution::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    QVariantMap stats;
+    stats["enabled"] = _enabled.load();
+    stats["scale"] = _enabled ? _scale : MAX_SCALE;
+    stats["controlledScale"] = _controlledScale;
+    stats["minScale"] = _minScale;
+    stats["targetShare"] = _targetShare;
+    stats["targetGPUTime"] = _targetGPUTime;
+    stats["gpuTime"] = _gpuTime;
+    return stats;
+}
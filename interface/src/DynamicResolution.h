@@ -0,0 +1,62 @@
+//
+//  DynamicResolution.h
+//  interface/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_DynamicResolution_h
+#define overte_DynamicResolution_h
+
+#include <atomic>
+#include <mutex>
+
+#include <QtCore/QVariantMap>
+
+/// Scales the resolution of the main view down when the GPU can't render it at the target frame rate, and back up when it
+/// can, with a PID controller on the GPU frame time.  The scale is applied on top of the viewport resolution scale of the
+/// render settings, in steps and no more often than the framebuffers can be rebuilt without being noticed.
+class DynamicResolution {
+public:
+    DynamicResolution();
+
+    /// Updates the scale from the GPU time of the last frames, in msec, for a frame rate of targetFPS.  Returns true if the
+    /// scale changed.
+    bool update(float gpuTime, float targetFPS, float realTimeDelta);
+
+    bool isEnabled() const { return _enabled; }
+    void setEnabled(bool enabled);
+
+    /// The scale to apply to the viewport resolution scale, 1 when the dynamic resolution is disabled
+    float getScale() const;
+
+    /// The share of the frame that the GPU is given, in the range 0.5 - 1
+    float getTargetShare() const;
+    void setTargetShare(float share);
+
+    float getMinScale() const;
+    void setMinScale(float scale);
+
+    QVariantMap getStats() const;
+
+private:
+    // the settings and stats are read by scripts from their own threads
+    mutable std::mutex _mutex;
+    // the state of the controller, whose output is how much the scale is reduced
+    float _integral { 0.0f };
+    float _lastError { 0.0f };
+    float _targetShare;
+    float _minScale;
+    float _targetGPUTime { 0.0f };
+    float _gpuTime { 0.0f };
+    float _controlledScale { 1.0f };
+    float _scale { 1.0f };
+    float _timeSinceChange { 0.0f };
+    std::atomic<bool> _enabled { false };
+};
+
+#endif // overte_DynamicResolution_h
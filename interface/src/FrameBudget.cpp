@@ -0,0 +1,124 @@
+//
+//  FrameBudget.cpp
+//  interface/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "FrameBudget.h"
+
+#include <algorithm>
+
+#include <glm/glm.hpp>
+
+#include <NumericalConstants.h>
+
+// the costs are averaged over about this long, as the workload regulators average their timings
+static const float COST_TIMESCALE = 0.5f; // sec
+
+static const float DEFAULT_PHYSICS_SHARE = 0.15f;
+static const float DEFAULT_KINEMATICS_SHARE = 0.10f;
+static const float MIN_PHYSICS_BUDGET = 1.0f; // msec
+static const float MAX_PHYSICS_BUDGET = 8.0f; // msec
+static const float MIN_KINEMATICS_BUDGET = 0.5f; // msec
+static const float MAX_KINEMATICS_BUDGET = 4.0f; // msec
+// the budgets the workload regulators had before they were shared
+static const float UNSHARED_BUDGET = 2.0f; // msec
+
+static const char* SUBSYSTEM_NAMES[FrameBudget::NUM_SUBSYSTEMS] = { "physics", "kinematics", "animation", "gameLoop", "render" };
+
+FrameBudget::FrameBudget() {
+    _shares[PHYSICS] = DEFAULT_PHYSICS_SHARE;
+    _shares[KINEMATICS] = DEFAULT_KINEMATICS_SHARE;
+    _budgets[PHYSICS] = UNSHARED_BUDGET;
+    _budgets[KINEMATICS] = UNSHARED_BUDGET;
+}
+
+void FrameBudget::setCost(Subsystem subsystem, float cost) {
+    _frameCosts[subsystem] = std::max(0.0f, std::min(cost, (float)MSECS_PER_SECOND));
+}
+
+void FrameBudget::update(float targetFPS, float realTimeDelta) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    float blend = _initialized ? std::min(std::max(realTimeDelta, 0.0f) / COST_TIMESCALE, 1.0f) : 1.0f;
+    _initialized = true;
+    for (int i = 0; i < NUM_SUBSYSTEMS; ++i) {
+        _costs[i] = (1.0f - blend) * _costs[i] + blend * _frameCosts[i];
+    }
+    if (targetFPS <= 0.0f) {
+        return;
+    }
+    _targetFrameTime = (float)MSECS_PER_SECOND / targetFPS;
+
+    // the animation isn't regulated, the regulated subsystems share what it leaves of the frame
+    float available = std::max(0.0f, _targetFrameTime - _costs[ANIMATION]);
+    _budgets[PHYSICS] = glm::clamp(_shares[PHYSICS] * available, MIN_PHYSICS_BUDGET, MAX_PHYSICS_BUDGET);
+    _budgets[KINEMATICS] = glm::clamp(_shares[KINEMATICS] * available, MIN_KINEMATICS_BUDGET, MAX_KINEMATICS_BUDGET);
+
+    // when the game loop can't keep up with the target the frames come out at its rate whatever the LOD, so the LOD aims
+    // for that rate instead of lowering the detail for frames that won't come
+    float gameLoopTime = _costs[GAME_LOOP];
+    _renderTargetFPS = gameLoopTime > _targetFrameTime ? (float)MSECS_PER_SECOND / gameLoopTime : 0.0f;
+}
+
+void FrameBudget::setEnabled(bool enabled) {
+    _enabled = enabled;
+}
+
+float FrameBudget::getShare(Subsystem subsystem) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _shares[subsystem];
+}
+
+void FrameBudget::setShare(Subsystem subsystem, float share) {
+    if (subsystem != PHYSICS && subsystem != KINEMATICS) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _shares[subsystem] = glm::clamp(share, 0.0f, 1.0f);
+}
+
+float FrameBudget::getCost(Subsystem subsystem) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _costs[subsystem];
+}
+
+float FrameBudget::getBudget(Subsystem subsystem) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_enabled && (subsystem == PHYSICS || subsystem == KINEMATICS)) {
+        return UNSHARED_BUDGET;
+    }
+    return _budgets[subsystem];
+}
+
+float FrameBudget::getRenderTargetFPS() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _enabled ? _renderTargetFPS : 0.0f;
+}
+
+QVariantMap FrameBudget::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    QVariantMap costs;
+    for (int i = 0; i < NUM_SUBSYSTEMS; ++i) {
+        costs[SUBSYSTEM_NAMES[i]] = _costs[i];
+    }
+    QVariantMap budgets;
+    budgets[SUBSYSTEM_NAMES[PHYSICS]] = _enabled ? _budgets[PHYSICS] : UNSHARED_BUDGET;
+    budgets[SUBSYSTEM_NAMES[KINEMATICS]] = _enabled ? _budgets[KINEMATICS] : UNSHARED_BUDGET;
+    QVariantMap shares;
+    shares[SUBSYSTEM_NAMES[PHYSICS]] = _shares[PHYSICS];
+    shares[SUBSYSTEM_NAMES[KINEMATICS]] = _shares[KINEMATICS];
+
+    QVariantMap stats;
+    stats["enabled"] = _enabled.load();
+    stats["targetFrameTime"] = _targetFrameTime;
+    stats["renderTargetFPS"] = _enabled ? _renderTargetFPS : 0.0f;
+    stats["costs"] = costs;
+    stats["budgets"] = budgets;
+    stats["shares"] = shares;
+    return stats;
+}
@@ -0,0 +1,70 @@
+//
+//  FrameBudget.h
+//  interface/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_FrameBudget_h
+#define overte_FrameBudget_h
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+#include <QtCore/QVariantMap>
+
+/// Shares the time of a frame between the subsystems that regulate their own cost, so that they don't fight over it: the
+/// workload regions are given physics and kinematics budgets out of what's left of the frame after the animation, and the
+/// render LOD aims for the frame rate that the game loop can actually deliver rather than one it never will.
+class FrameBudget {
+public:
+    enum Subsystem : uint8_t {
+        PHYSICS = 0, // stepPhysics and postPhysics, regulated by the R1 and R2 ranges
+        KINEMATICS,  // non-physical entity motion, regulated by the R3 range
+        ANIMATION,   // avatar updates, not regulated
+        GAME_LOOP,   // all of Application::update(), which includes the above
+        RENDER,      // the worst of the render CPU and GPU times, regulated by the LOD
+        NUM_SUBSYSTEMS
+    };
+
+    FrameBudget();
+
+    /// Sets the cost of subsystem in the last frame, in msec
+    void setCost(Subsystem subsystem, float cost);
+    /// Smooths the costs and recomputes the budgets for a frame rate of targetFPS
+    void update(float targetFPS, float realTimeDelta);
+
+    bool isEnabled() const { return _enabled; }
+    void setEnabled(bool enabled);
+
+    /// The share of what's left of the frame after the animation that subsystem is given, for PHYSICS and KINEMATICS
+    float getShare(Subsystem subsystem) const;
+    void setShare(Subsystem subsystem, float share);
+
+    float getCost(Subsystem subsystem) const;
+    /// The budget of subsystem in msec, for PHYSICS and KINEMATICS
+    float getBudget(Subsystem subsystem) const;
+    /// The frame rate the render LOD should aim for, or 0 to leave it its own target
+    float getRenderTargetFPS() const;
+
+    QVariantMap getStats() const;
+
+private:
+    // the budgets are read by scripts from their own threads
+    mutable std::mutex _mutex;
+    std::array<float, NUM_SUBSYSTEMS> _frameCosts {};
+    std::array<float, NUM_SUBSYSTEMS> _costs {};
+    std::array<float, NUM_SUBSYSTEMS> _budgets {};
+    std::array<float, NUM_SUBSYSTEMS> _shares {};
+    float _targetFrameTime { 0.0f };
+    float _renderTargetFPS { 0.0f };
+    std::atomic<bool> _enabled { true };
+    bool _initialized { false };
+};
+
+#endif // overte_FrameBudget_h
@@ -0,0 +1,71 @@
+//
+//  FramePacer.cpp
+//  interface/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <NumericalConstants.h>
+
+static const float BLEND = 0.1f;
+// the intervals longer than this are hitches or pauses, and aren't the refresh rate of the display
+static const uint64_t MAX_PRESENT_INTERVAL = 100 * USECS_PER_MSEC;
+// the game loop is given its average time and this many deviations, plus the margin, to finish before the next present
+static const float UPDATE_DEVIATIONS = 3.0f;
+static const float UPDATE_MARGIN = 1.5f * USECS_PER_MSEC;
+// the timers of the main thread aren't more precise than a msec, and it is never delayed more than half of the frame
+static const float MIN_DELAY = 1.0f * USECS_PER_MSEC;
+static const float MAX_DELAY_SHARE = 0.5f;
+
+uint64_t FramePacer::presented(uint64_t presentTime) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    uint64_t interval = presentTime - _lastPresentTime;
+    if (_lastPresentTime != 0 && interval > 0 && interval < MAX_PRESENT_INTERVAL) {
+        _presentInterval = _presentInterval > 0.0f ? (1.0f - BLEND) * _presentInterval + BLEND * (float)interval : (float)interval;
+    }
+    _lastPresentTime = presentTime;
+
+    float delay = 0.0f;
+    if (_enabled && _active && _presentInterval > 0.0f) {
+        float slack = _presentInterval - (_updateTime + UPDATE_DEVIATIONS * _updateDeviation) - UPDATE_MARGIN;
+        delay = std::min(slack, MAX_DELAY_SHARE * _presentInterval);
+        if (delay < MIN_DELAY) {
+            delay = 0.0f;
+        }
+    }
+    _delay = (1.0f - BLEND) * _delay + BLEND * delay;
+    return (uint64_t)delay;
+}
+
+void FramePacer::setUpdateTime(uint64_t updateTime) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    float time = (float)std::min(updateTime, MAX_PRESENT_INTERVAL);
+    _updateDeviation = (1.0f - BLEND) * _updateDeviation + BLEND * std::abs(time - _updateTime);
+    _updateTime = (1.0f - BLEND) * _updateTime + BLEND * time;
+}
+
+float FramePacer::getDelay() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _delay / (float)USECS_PER_MSEC;
+}
+
+QVariantMap FramePacer::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    QVariantMap stats;
+    stats["enabled"] = _enabled.load();
+    stats["active"] = _active.load();
+    stats["presentInterval"] = _presentInterval / (float)USECS_PER_MSEC;
+    stats["updateTime"] = _updateTime / (float)USECS_PER_MSEC;
+    stats["updateDeviation"] = _updateDeviation / (float)USECS_PER_MSEC;
+    stats["delay"] = _delay / (float)USECS_PER_MSEC;
+    return stats;
+}
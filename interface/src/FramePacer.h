@@ -0,0 +1,55 @@
+//
+//  FramePacer.h
+//  interface/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_FramePacer_h
+#define overte_FramePacer_h
+
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
+
+#include <QtCore/QVariantMap>
+
+/// Delays the start of the game loop after a present so that it ends just before the next one, when the display locks the
+/// presents to its refresh rate.  The head pose is sampled at the end of the game loop and drawn at the next present, so
+/// the time that the game loop is delayed is taken off the latency of the pose.
+class FramePacer {
+public:
+    /// Records a present at presentTime, in usec, and returns how long to wait before the next game loop, in usec
+    uint64_t presented(uint64_t presentTime);
+
+    /// Records the time of the last game loop, in usec
+    void setUpdateTime(uint64_t updateTime);
+
+    /// The frames are only paced on the displays that present at their refresh rate, the HMDs
+    void setActive(bool active) { _active = active; }
+
+    bool isEnabled() const { return _enabled; }
+    void setEnabled(bool enabled) { _enabled = enabled; }
+
+    /// The average delay of the game loops, in msec
+    float getDelay() const;
+
+    QVariantMap getStats() const;
+
+private:
+    // the presents are recorded on the present thread, the game loops on the main thread
+    mutable std::mutex _mutex;
+    uint64_t _lastPresentTime { 0 };
+    float _presentInterval { 0.0f }; // usec
+    float _updateTime { 0.0f }; // usec
+    float _updateDeviation { 0.0f }; // usec
+    float _delay { 0.0f }; // usec
+    std::atomic<bool> _active { false };
+    std::atomic<bool> _enabled { true };
+};
+
+#endif // overte_FramePacer_h
@@ -10,6 +10,8 @@
 
 #include <TextureCache.h>
 
+#include "Application.h"
+
 void FrameTimingsScriptingInterface::start() {
     _values.clear();
     DependencyManager::get<TextureCache>()->setUnusedResourceCacheSize(0);
@@ -51,3 +53,12 @@ QVariantList FrameTimingsScriptingInterface::getValues() const {
     }
     return result;
 }
+
+float FrameTimingsScriptingInterface::getPoseLatency() const {
+    auto displayPlugin = qApp->getActiveDisplayPlugin();
+    return displayPlugin ? displayPlugin->getAveragePoseLatency() : 0.0f;
+}
+
+float FrameTimingsScriptingInterface::getPacingDelay() const {
+    return qApp->getPerformanceManager().getFramePacer().getDelay();
+}
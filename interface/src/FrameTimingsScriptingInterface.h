@@ -16,6 +16,8 @@ class FrameTimingsScriptingInterface : public QObject {
     Q_PROPERTY(float max READ getMax CONSTANT)
     Q_PROPERTY(float min READ getMin CONSTANT)
     Q_PROPERTY(float standardDeviation READ getStandardDeviation CONSTANT)
+    Q_PROPERTY(float poseLatency READ getPoseLatency)
+    Q_PROPERTY(float pacingDelay READ getPacingDelay)
 public:
     Q_INVOKABLE void start();
     Q_INVOKABLE void addValue(uint64_t value);
@@ -28,6 +30,11 @@ public:
     float getStandardDeviation() const { return _stdDev; }
     float getMean() const { return _mean; }
 
+    // The average time from the sample of the head pose to the present of the frames rendered with it, in msec
+    float getPoseLatency() const;
+    // The average time that the game loop is delayed by the frame pacing, in msec
+    float getPacingDelay() const;
+
 protected:
     std::vector<uint64_t> _values;
     bool _active { false };
@@ -107,7 +107,12 @@ void LODManager::autoAdjustLOD(float realTimeDelta) {
     float oldLODAngle = getLODAngleDeg();
 
     // Target fps is slightly overshooted by 5hz
-    float targetFPS = getLODTargetFPS() + LOD_OFFSET_FPS;
+    // and no higher than what the game loop delivers, the frames beyond it won't come whatever the detail
+    float targetFPS = getLODTargetFPS();
+    if (_budgetTargetFPS > 0.0f) {
+        targetFPS = std::min(targetFPS, _budgetTargetFPS);
+    }
+    targetFPS += LOD_OFFSET_FPS;
 
     // Current fps based on latest measurments
     float currentNowFPS = (float)MSECS_PER_SECOND / _nowRenderTime;
@@ -285,6 +285,8 @@ public:
 
     static bool shouldRender(const RenderArgs* args, const AABox& bounds);
     void setRenderTimes(float presentTime, float engineRunTime, float batchTime, float gpuTime);
+    // caps the frame rate the automatic LOD aims for, 0 for no cap, see FrameBudget::getRenderTargetFPS()
+    void setBudgetTargetFPS(float fps) { _budgetTargetFPS = fps; }
     void autoAdjustLOD(float realTimeDelta);
 
     void loadSettings();
@@ -391,6 +393,7 @@ private:
     float _engineRunTime{ 0.0f }; // msec
     float _batchTime{ 0.0f }; // msec
     float _gpuTime{ 0.0f }; // msec
+    float _budgetTargetFPS{ 0.0f };
 
     float _farDistance{ 200.0f };
     float _nearDistance{ 4.0f };
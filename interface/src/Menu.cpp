@@ -537,12 +537,29 @@ Menu::Menu() {
 
     addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::ComputeBlendshapes, 0, true,
         DependencyManager::get<ModelBlender>().data(), SLOT(setComputeBlendshapes(bool)));
+    addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::BlendshapesOnGPU, 0, true,
+        DependencyManager::get<ModelBlender>().data(), SLOT(setBlendOnGPU(bool)));
 
     action = addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::MaterialProceduralShaders, 0, false);
     connect(action, &QAction::triggered, [action] {
         ModelMeshPartPayload::enableMaterialProceduralShaders = action->isChecked();
     });
 
+    action = addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::InstanceModels, 0, true);
+    connect(action, &QAction::triggered, [action] {
+        ModelMeshPartPayload::enableInstancing = action->isChecked();
+    });
+
+    action = addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::SimplifyDistantMeshes, 0, true);
+    connect(action, &QAction::triggered, [action] {
+        ModelMeshPartPayload::enableMeshLODs = action->isChecked();
+    });
+
+    action = addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::SkinOncePerFrame, 0, false);
+    connect(action, &QAction::triggered, [action] {
+        ModelMeshPartPayload::enableSkinningPrepass = action->isChecked();
+    });
+
     {
         auto drawStatusConfig = qApp->getRenderEngine()->getConfiguration()->getConfig<render::DrawStatus>("RenderMainView.DrawStatus");
         addCheckableActionToQMenuAndActionHash(renderOptionsMenu, MenuOption::HighlightTransitions, 0, false,
@@ -126,6 +126,7 @@ namespace MenuOption {
     const QString Help = "Help...";
     const QString HomeLocation = "Home ";
     const QString IncreaseAvatarSize = "Increase Avatar Size";
+    const QString InstanceModels = "Instance Repeated Models";
     const QString ActionMotorControl = "Enable Default Motor Control";
     const QString LastLocation = "Last Location";
     const QString LoadScript = "Open and Run Script File...";
@@ -206,6 +207,8 @@ namespace MenuOption {
     const QString EnableLookAtSnapping = "Enable LookAt Snapping";
     const QString ShowRealtimeEntityStats = "Show Realtime Entity Stats";
     const QString SimulateEyeTracking = "Simulate";
+    const QString SimplifyDistantMeshes = "Simplify Distant Meshes";
+    const QString SkinOncePerFrame = "Skin Once Per Frame";
     const QString SMIEyeTracking = "SMI Eye Tracking";
     const QString SparseTextureManagement = "Enable Sparse Texture Management";
     const QString StartUpLocation = "Start-Up Location";
@@ -235,6 +238,7 @@ namespace MenuOption {
     const QString NotificationSoundsTablet = "play_notification_sounds_tablet";
     const QString ForceCoarsePicking = "Force Coarse Picking";
     const QString ComputeBlendshapes = "Compute Blendshapes";
+    const QString BlendshapesOnGPU = "Blend Blendshapes On GPU";
     const QString HighlightTransitions = "Highlight Transitions";
     const QString MaterialProceduralShaders = "Enable Procedural Materials";
 }
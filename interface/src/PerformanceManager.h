@@ -17,6 +17,11 @@
 #include <SettingHandle.h>
 #include <shared/ReadWriteLockable.h>
 
+#include "DynamicResolution.h"
+#include "FrameBudget.h"
+#include "FramePacer.h"
+#include "PerformanceTelemetry.h"
+
 class PerformanceManager {
 public:
     enum PerformancePreset {
@@ -40,10 +45,31 @@ public:
     void setPerformancePreset(PerformancePreset performancePreset);
     PerformancePreset getPerformancePreset() const;
 
+    // The budget controller that shares the frame between the workload regions and the render LOD
+    FrameBudget& getFrameBudget() { return _frameBudget; }
+    const FrameBudget& getFrameBudget() const { return _frameBudget; }
+
+    // The controller that scales the resolution of the main view to the GPU time
+    DynamicResolution& getDynamicResolution() { return _dynamicResolution; }
+    const DynamicResolution& getDynamicResolution() const { return _dynamicResolution; }
+
+    // The scheduler that starts the game loop as late as the next present allows
+    FramePacer& getFramePacer() { return _framePacer; }
+    const FramePacer& getFramePacer() const { return _framePacer; }
+
+    // The opt-in recorder of the frame time and subsystem costs over the session
+    PerformanceTelemetry& getTelemetry() { return _telemetry; }
+    const PerformanceTelemetry& getTelemetry() const { return _telemetry; }
+
 private:
     mutable ReadWriteLockable _performancePresetSettingLock;
     Setting::Handle<int> _performancePresetSetting { "performancePreset", PerformanceManager::PerformancePreset::UNKNOWN };
 
+    FrameBudget _frameBudget;
+    DynamicResolution _dynamicResolution;
+    FramePacer _framePacer;
+    PerformanceTelemetry _telemetry;
+
     // The concrete performance preset changes
     void applyPerformancePreset(PerformanceManager::PerformancePreset performancePreset);
 };
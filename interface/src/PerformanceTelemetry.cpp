@@ -0,0 +1,185 @@
+//
+//  PerformanceTelemetry.cpp
+//  interface/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "PerformanceTelemetry.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QNetworkRequest>
+
+#include <BuildInfo.h>
+#include <NetworkAccessManager.h>
+#include <NumericalConstants.h>
+#include <PathUtils.h>
+#include <SharedUtil.h>
+
+#include "InterfaceLogging.h"
+
+// the first bin holds the samples under MIN_VALUE, the others are spaced logarithmically up to MAX_VALUE, which gives the
+// percentiles a precision of about 8%
+static const float MIN_VALUE = 0.05f; // msec
+static const float MAX_VALUE = 1000.0f; // msec
+
+static const char* METRIC_NAMES[PerformanceTelemetry::NUM_METRICS] = {
+    "frame", "gameLoop", "renderCPU", "renderGPU", "physics", "animation", "scripts", "entities", "network"
+};
+
+static const int NUM_PERCENTILES = 4;
+static const float PERCENTILES[NUM_PERCENTILES] = { 0.5f, 0.9f, 0.95f, 0.99f };
+static const char* PERCENTILE_NAMES[NUM_PERCENTILES] = { "p50", "p90", "p95", "p99" };
+
+static float logRatio(int numBins) {
+    return std::log(MAX_VALUE / MIN_VALUE) / (float)(numBins - 1);
+}
+
+PerformanceTelemetry::PerformanceTelemetry() :
+    _enabled(_enabledSetting.get()),
+    _sessionStart(usecTimestampNow())
+{
+}
+
+void PerformanceTelemetry::setEnabled(bool enabled) {
+    _enabledSetting.set(enabled);
+    _enabled = enabled;
+}
+
+QString PerformanceTelemetry::getEndpoint() const {
+    return _endpointSetting.get();
+}
+
+void PerformanceTelemetry::setEndpoint(const QString& endpoint) {
+    _endpointSetting.set(endpoint);
+}
+
+void PerformanceTelemetry::addSample(Metric metric, float msecs) {
+    if (!_enabled || !(msecs >= 0.0f)) {
+        return;
+    }
+    int bin = 0;
+    if (msecs >= MIN_VALUE) {
+        bin = 1 + (int)(std::log(msecs / MIN_VALUE) / logRatio(NUM_BINS));
+        if (bin > NUM_BINS - 1) {
+            bin = NUM_BINS - 1;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    Histogram& histogram = _histograms[metric];
+    ++histogram.bins[bin];
+    ++histogram.count;
+    histogram.total += msecs;
+    if (msecs > histogram.max) {
+        histogram.max = msecs;
+    }
+}
+
+// rounded to 0.01 msec, so that the summaries stay compact
+static double roundTime(float msecs) {
+    return std::round(msecs * 100.0f) / 100.0;
+}
+
+QJsonObject PerformanceTelemetry::getSummary() const {
+    QJsonObject metrics;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (int i = 0; i < NUM_METRICS; ++i) {
+            const Histogram& histogram = _histograms[i];
+            if (histogram.count == 0) {
+                continue;
+            }
+            QJsonObject metric;
+            metric["count"] = (qint64)histogram.count;
+            metric["mean"] = roundTime((float)(histogram.total / histogram.count));
+            metric["max"] = roundTime(histogram.max);
+
+            // each percentile is the middle of the bin it falls in
+            int percentile = 0;
+            uint64_t cumulativeCount = 0;
+            for (int bin = 0; bin < NUM_BINS && percentile < NUM_PERCENTILES; ++bin) {
+                cumulativeCount += histogram.bins[bin];
+                while (percentile < NUM_PERCENTILES &&
+                        cumulativeCount >= PERCENTILES[percentile] * histogram.count) {
+                    float value = bin == 0 ? 0.5f * MIN_VALUE : MIN_VALUE * std::exp(((float)bin - 0.5f) * logRatio(NUM_BINS));
+                    metric[PERCENTILE_NAMES[percentile]] = roundTime(std::min(value, histogram.max));
+                    ++percentile;
+                }
+            }
+            metrics[METRIC_NAMES[i]] = metric;
+        }
+    }
+
+    QJsonObject summary;
+    summary["version"] = BuildInfo::VERSION;
+    summary["duration"] = (qint64)((usecTimestampNow() - _sessionStart) / USECS_PER_SECOND);
+    summary["metrics"] = metrics;
+    return summary;
+}
+
+QString PerformanceTelemetry::getTelemetryDirectory() {
+    return PathUtils::getAppLocalDataPath() + "telemetry/";
+}
+
+void PerformanceTelemetry::finishSession() {
+    if (!_enabled) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_histograms[FRAME].count == 0) {
+            return;
+        }
+    }
+
+    QDir().mkpath(getTelemetryDirectory());
+    QString filename = getTelemetryDirectory() + "session-" + QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss") +
+        ".json";
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(interfaceapp) << "PerformanceTelemetry failed to write" << filename;
+        return;
+    }
+    file.write(QJsonDocument(getSummary()).toJson(QJsonDocument::Compact));
+}
+
+void PerformanceTelemetry::sendPendingSummaries() {
+    QUrl endpoint(getEndpoint());
+    if (!_enabled || !endpoint.isValid() || endpoint.isEmpty()) {
+        return;
+    }
+
+    QDir directory(getTelemetryDirectory());
+    for (const QString& name : directory.entryList({ "session-*.json" }, QDir::Files)) {
+        QString filename = directory.filePath(name);
+        QFile file(filename);
+        if (!file.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+
+        QNetworkRequest request(endpoint);
+        request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+        QNetworkReply* reply = NetworkAccessManager::getInstance().post(request, file.readAll());
+        QObject::connect(reply, &QNetworkReply::finished, [reply, filename] {
+            // the summaries that weren't accepted are sent again with the next session's
+            if (reply->error() == QNetworkReply::NoError) {
+                QFile::remove(filename);
+            } else {
+                qCDebug(interfaceapp) << "PerformanceTelemetry failed to send" << filename << "-" << reply->errorString();
+            }
+            reply->deleteLater();
+        });
+    }
+}
@@ -0,0 +1,84 @@
+//
+//  PerformanceTelemetry.h
+//  interface/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_PerformanceTelemetry_h
+#define overte_PerformanceTelemetry_h
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+#include <SettingHandle.h>
+
+/// Records, when the user opts in, the distributions of the frame time and of the costs of the subsystems over a session,
+/// in log-spaced histograms that take no allocation per sample.  The session ends in a compact summary of percentiles
+/// that is written to the telemetry directory, and sent to the configured endpoint at the start of the next session.
+class PerformanceTelemetry {
+public:
+    enum Metric : uint8_t {
+        FRAME = 0,   // the time between two game loops
+        GAME_LOOP,   // all of Application::update()
+        RENDER_CPU,  // the render engine and the batches
+        RENDER_GPU,
+        PHYSICS,
+        ANIMATION,
+        SCRIPTS,     // the updates and timers of all the scripts, which run on their own threads, per game loop
+        ENTITIES,    // the entity simulation and the non-physical kinematics
+        NETWORK,     // the queries and packets sent from the game loop
+        NUM_METRICS
+    };
+
+    PerformanceTelemetry();
+
+    bool isEnabled() const { return _enabled; }
+    void setEnabled(bool enabled);
+
+    /// The URL the summaries are posted to, the summaries are only written locally if it's empty
+    QString getEndpoint() const;
+    void setEndpoint(const QString& endpoint);
+
+    /// Adds a sample of metric, in msec
+    void addSample(Metric metric, float msecs);
+
+    /// The summary of the session so far
+    QJsonObject getSummary() const;
+
+    /// Writes the summary of the session to the telemetry directory
+    void finishSession();
+    /// Posts the summaries of the previous sessions to the endpoint, and removes the ones that were accepted
+    void sendPendingSummaries();
+
+private:
+    static const int NUM_BINS = 128;
+
+    struct Histogram {
+        std::array<uint32_t, NUM_BINS> bins {};
+        uint32_t count { 0 };
+        double total { 0.0 };
+        float max { 0.0f };
+    };
+
+    static QString getTelemetryDirectory();
+
+    Setting::Handle<bool> _enabledSetting { "telemetry/enabled", false };
+    Setting::Handle<QString> _endpointSetting { "telemetry/endpoint", QString() };
+    std::atomic<bool> _enabled { false };
+
+    // the summary is read by scripts from their own threads
+    mutable std::mutex _mutex;
+    std::array<Histogram, NUM_METRICS> _histograms;
+    quint64 _sessionStart;
+};
+
+#endif // overte_PerformanceTelemetry_h
@@ -13,6 +13,7 @@
 
 #include "AvatarManager.h"
 
+#include <cfloat>
 #include <string>
 
 #include <ScriptEngine.h>
@@ -38,6 +39,7 @@
 #include <RegisteredMetaTypes.h>
 #include <Rig.h>
 #include <SettingHandle.h>
+#include <TBBHelpers.h>
 #include <UsersScriptingInterface.h>
 #include <UUID.h>
 #include <shared/ConicalViewFrustum.h>
@@ -45,6 +47,7 @@
 
 #include "Application.h"
 #include "InterfaceLogging.h"
+#include "LODManager.h"
 #include "Menu.h"
 #include "MyAvatar.h"
 #include "DebugDraw.h"
@@ -219,7 +222,32 @@ float AvatarManager::getAvatarSimulationRate(const QUuid& sessionID, const QStri
     return avatar ? avatar->getSimulationRate(rateName) : 0.0f;
 }
 
+// Avatars that look smaller than the LOD angle get their pose frozen, and those within this many times of it get
+// their pose updated every few frames; as the LODManager widens the angle to hold the frame rate, crowds get cheaper.
+static const float REDUCED_RENDER_LOD_ANGLE_SCALE = 4.0f;
+
+static OtherAvatar::RenderLOD computeRenderLOD(const OtherAvatar& avatar, const ConicalViewFrustums& views,
+                                               float lodHalfAngleTan) {
+    if (views.empty() || avatar.getHasPriority()) {
+        return OtherAvatar::RenderLOD::Full;
+    }
+    float minDistance = FLT_MAX;
+    for (const auto& view : views) {
+        minDistance = std::min(minDistance, glm::distance(view.getPosition(), avatar.getWorldPosition()));
+    }
+    float halfAngleTan = avatar.getBoundingRadius() / std::max(minDistance, EPSILON);
+    if (halfAngleTan < lodHalfAngleTan) {
+        return OtherAvatar::RenderLOD::Frozen;
+    } else if (halfAngleTan < lodHalfAngleTan * REDUCED_RENDER_LOD_ANGLE_SCALE) {
+        return OtherAvatar::RenderLOD::Reduced;
+    }
+    return OtherAvatar::RenderLOD::Full;
+}
+
 void AvatarManager::updateOtherAvatars(float deltaTime) {
+    // the avatar data packets received since the last update
+    _avatarParseTime = (float)takeAvatarDataParseUsecs() / (float)USECS_PER_MSEC;
+
     {
         // lock the hash for read to check the size
         QReadLocker lock(&_hashLock);
@@ -295,9 +323,14 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     int numHerosUpdated = 0;
     int numAvatarsUpdated = 0;
     int numAvatarsNotUpdated = 0;
+    int numAvatarsReduced = 0;
+    int numAvatarsFrozen = 0;
 
     render::Transaction renderTransaction;
     workload::Transaction workloadTransaction;
+    std::vector<ModelPointer> simulatedModels;
+
+    const float lodHalfAngleTan = DependencyManager::get<LODManager>()->getLODFarHalfAngleTan();
 
     for (int p = kHero; p < NumVariants; p++) {
         auto& priorityQueue = avatarPriorityQueues[p];
@@ -306,6 +339,14 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
         auto passExpiry = updatePriorityExpiries[p];
 
+        // the avatars' joints are computed in parallel, before they're simulated one by one on this thread
+        tbb::parallel_for((size_t)0, sortedAvatarVector.size(), [&](size_t i) {
+            const SortableAvatar& sortData = sortedAvatarVector[i];
+            const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
+            avatar->setRenderLOD(computeRenderLOD(*avatar, views, lodHalfAngleTan));
+            avatar->computeJointsAhead(sortData.getPriority() > OUT_OF_VIEW_THRESHOLD);
+        });
+
         for (auto it = sortedAvatarVector.begin(); it != sortedAvatarVector.end(); ++it) {
             const SortableAvatar& sortData = *it;
             const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
@@ -343,7 +384,14 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                     avatar->_transit.reset();
                     avatar->setIsNewAvatar(false);
                 }
+                auto renderLOD = avatar->getRenderLOD();
+                if (renderLOD == OtherAvatar::RenderLOD::Reduced) {
+                    numAvatarsReduced++;
+                } else if (renderLOD == OtherAvatar::RenderLOD::Frozen) {
+                    numAvatarsFrozen++;
+                }
                 avatar->simulate(deltaTime, inView);
+                simulatedModels.push_back(avatar->getSkeletonModel());
                 if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
                     _myAvatar->addAvatarHandsToFlow(avatar);
                 }
@@ -389,6 +437,9 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         }
     }
 
+    // the cluster matrices of the avatars are all computed at once, rather than one after the other by their render updates
+    Model::updateClusterMatrices(simulatedModels);
+
     if (_shouldRender) {
         qApp->getMain3DScene()->enqueueTransaction(renderTransaction);
     }
@@ -397,6 +448,8 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
     _numAvatarsUpdated = numAvatarsUpdated;
     _numAvatarsNotUpdated = numAvatarsNotUpdated;
+    _numAvatarsReduced = numAvatarsReduced;
+    _numAvatarsFrozen = numAvatarsFrozen;
     _numHeroAvatarsUpdated = numHerosUpdated;
 
     _avatarSimulationTime = (float)(usecTimestampNow() - startTime) / (float)USECS_PER_MSEC;
@@ -248,6 +248,33 @@ void OtherAvatar::setCollisionWithOtherAvatarsFlags() {
     }
 }
 
+// frames between pose updates of an avatar at RenderLOD::Reduced
+static const int REDUCED_RENDER_LOD_UPDATE_INTERVAL = 3;
+
+bool OtherAvatar::isPoseUpdateFrame(bool inView, int framesSinceJointUpdate) const {
+    if (!inView || _renderLOD == RenderLOD::Frozen) {
+        return false;
+    }
+    return _renderLOD != RenderLOD::Reduced || framesSinceJointUpdate >= REDUCED_RENDER_LOD_UPDATE_INTERVAL;
+}
+
+void OtherAvatar::computeJoints() {
+    _skeletonModel->getRig().copyJointsFromJointData(_jointData);
+    glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+    _skeletonModel->getRig().computeExternalPoses(rootTransform);
+}
+
+void OtherAvatar::computeJointsAhead(bool inView) {
+    // an avatar left over by a pass that ran out of time is computed again, its joint data may have changed since
+    _jointsComputedAhead = false;
+    // the frame count simulate will have once it has counted this frame
+    int framesSinceJointUpdate = (inView && _renderLOD == RenderLOD::Reduced) ? _framesSinceJointUpdate + 1 : _framesSinceJointUpdate;
+    if (isPoseUpdateFrame(inView, framesSinceJointUpdate) && (_hasNewJointData || _transit.isActive())) {
+        computeJoints();
+        _jointsComputedAhead = true;
+    }
+}
+
 void OtherAvatar::simulate(float deltaTime, bool inView) {
     PROFILE_RANGE(simulation, "simulate");
 
@@ -264,16 +291,27 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
     PerformanceTimer perfTimer("simulate");
     {
         PROFILE_RANGE(simulation, "updateJoints");
-        if (inView) {
+        bool isReduced = inView && _renderLOD == RenderLOD::Reduced;
+        if (isReduced) {
+            // new joint data stays pending until the next update frame
+            _framesSinceJointUpdate++;
+        }
+        bool updatePose = isPoseUpdateFrame(inView, _framesSinceJointUpdate);
+        // an avatar updated every few frames animates its head over the frames it skipped, so it keeps its pace
+        _timeSinceJointUpdate = isReduced ? _timeSinceJointUpdate + deltaTime : deltaTime;
+        if (updatePose) {
+            float poseDeltaTime = _timeSinceJointUpdate;
+            _framesSinceJointUpdate = 0;
+            _timeSinceJointUpdate = 0.0f;
             Head* head = getHead();
             if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
+                if (!_jointsComputedAhead) {
+                    computeJoints();
+                }
                 _jointDataSimulationRate.increment();
 
-                head->simulate(deltaTime);
-                _skeletonModel->simulate(deltaTime, true);
+                head->simulate(poseDeltaTime);
+                _skeletonModel->simulate(poseDeltaTime, true);
 
                 locationChanged(); // joints changed, so if there are any children, update them.
                 _hasNewJointData = false;
@@ -284,8 +322,8 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
                 }
                 head->setPosition(headPosition);
             } else {
-                head->simulate(deltaTime);
-                _skeletonModel->simulate(deltaTime, false);
+                head->simulate(poseDeltaTime);
+                _skeletonModel->simulate(poseDeltaTime, false);
             }
             head->setScale(getModelScale());
             relayJointDataToChildren();
@@ -294,6 +332,7 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
             _skeletonModel->simulate(deltaTime, false);
         }
         _skeletonModelSimulationRate.increment();
+        _jointsComputedAhead = false;
     }
 
     // update animation for display name fade in/out
@@ -32,6 +32,13 @@ public:
         MultiSphereHigh // All joints
     };
 
+    // How much of the pose is simulated, picked each frame from the avatar's size on screen
+    enum class RenderLOD {
+        Full = 0, // joints, skinning and head every frame
+        Reduced,  // joints, skinning and head every few frames
+        Frozen    // pose held, only the transform and bounds follow the avatar
+    };
+
     virtual void instantiableAvatar() override { };
     virtual void createOrb() override;
     virtual void indicateLoadingStatus(LoadingStatus loadingStatus) override;
@@ -58,11 +65,17 @@ public:
     BodyLOD getBodyLOD() { return _bodyLOD; }
     void computeShapeLOD();
 
+    void setRenderLOD(RenderLOD renderLOD) { _renderLOD = renderLOD; }
+    RenderLOD getRenderLOD() const { return _renderLOD; }
+
     void updateCollisionGroup(bool myAvatarCollide);
     bool getCollideWithOtherAvatars() const { return _collideWithOtherAvatars; } 
 
     void setCollisionWithOtherAvatarsFlags() override;
 
+    /// Copies the joint data into the rig if simulate would this frame.  It only touches this avatar's own rig, so the
+    /// AvatarManager runs it for all the avatars in parallel before simulating them one by one.
+    void computeJointsAhead(bool inView);
     void simulate(float deltaTime, bool inView) override;
     void debugJointData() const;
     friend AvatarManager;
@@ -72,6 +85,8 @@ protected:
     void updateAttachedAvatarEntities();
     void onAddAttachedAvatarEntity(const QUuid& id);
     void onRemoveAttachedAvatarEntity(const QUuid& id);
+    bool isPoseUpdateFrame(bool inView, int framesSinceJointUpdate) const;
+    void computeJoints();
 
     class AvatarEntityDataHash {
     public:
@@ -90,6 +105,10 @@ protected:
     int32_t _spaceIndex { -1 };
     uint8_t _workloadRegion { workload::Region::INVALID };
     BodyLOD _bodyLOD { BodyLOD::Sphere };
+    RenderLOD _renderLOD { RenderLOD::Full };
+    int _framesSinceJointUpdate { 0 };
+    float _timeSinceJointUpdate { 0.0f };
+    bool _jointsComputedAhead { false };
     bool _needsDetailedRebuild { false };
 };
 
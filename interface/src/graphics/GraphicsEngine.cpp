@@ -19,6 +19,7 @@
 #include <GeometryCache.h>
 #include <TextureCache.h>
 #include <FramebufferCache.h>
+#include <Model.h>
 #include <UpdateSceneTask.h>
 #include <RenderViewTask.h>
 #include <SecondaryCamera.h>
@@ -65,6 +66,8 @@ void GraphicsEngine::initializeGPU(GLWidget* glwidget) {
 #endif
 
     DependencyManager::get<TextureCache>()->setGPUContext(_gpuContext);
+    // the blendshape shaders read their coefficients from a storage buffer, only the GL45 backend has them
+    DependencyManager::get<ModelBlender>()->setGPUBlendingSupported(_gpuContext->getBackendVersion() == "GL45");
 }
 
 void GraphicsEngine::initializeRender() {
@@ -199,6 +202,7 @@ void GraphicsEngine::render_performFrame() {
 
     RenderArgs renderArgs;
     glm::mat4  HMDSensorPose;
+    uint64_t HMDSensorPoseTimestamp { 0 };
     glm::mat4  eyeToWorld;
     glm::mat4  sensorToWorld;
     ViewFrustum viewFrustum;
@@ -217,6 +221,7 @@ void GraphicsEngine::render_performFrame() {
         }
 
         HMDSensorPose = _appRenderArgs._headPose;
+        HMDSensorPoseTimestamp = _appRenderArgs._headPoseTimestamp;
         eyeToWorld = _appRenderArgs._eyeToWorld;
         sensorToWorld = _appRenderArgs._sensorToWorld;
         isStereo = _appRenderArgs._isStereo;
@@ -291,6 +296,7 @@ void GraphicsEngine::render_performFrame() {
 
     auto frame = getGPUContext()->endFrame();
     frame->frameIndex = _renderFrameCount;
+    frame->poseTimestamp = HMDSensorPoseTimestamp;
     frame->framebuffer = finalFramebuffer;
     frame->framebufferRecycler = [](const gpu::FramebufferPointer& framebuffer) {
         auto frameBufferCache = DependencyManager::get<FramebufferCache>();
@@ -307,6 +313,11 @@ void GraphicsEngine::render_performFrame() {
         displayPlugin->submitFrame(frame);
     }
 
+    if (!_hasSubmittedFrame) {
+        _hasSubmittedFrame = true;
+        QMetaObject::invokeMethod(qApp, "firstFrameRendered");
+    }
+
     // Reset the framebuffer and stereo state
     renderArgs._blitFramebuffer.reset();
     renderArgs._context->enableStereo(false);
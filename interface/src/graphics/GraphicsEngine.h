@@ -30,6 +30,7 @@ struct AppRenderArgs {
     glm::mat4 _eyeOffsets[2];
     glm::mat4 _eyeProjections[2];
     glm::mat4 _headPose;
+    uint64_t _headPoseTimestamp { 0 };
     glm::mat4 _sensorToWorld;
     float _sensorToWorldScale{ 1.0f };
     bool _isStereo{ false };
@@ -75,6 +76,7 @@ protected:
     RateCounter<500> _renderLoopCounter;
 
     uint32_t _renderFrameCount{ 0 };
+    bool _hasSubmittedFrame { false };
     render::ScenePointer _renderScene{ new render::Scene(glm::vec3(-0.5f * (float)TREE_SCALE), (float)TREE_SCALE) };
     render::EnginePointer _renderEngine{ new render::RenderEngine() };
 
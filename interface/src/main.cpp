@@ -176,6 +176,11 @@ int main(int argc, const char* argv[]) {
         "Maximum concurrent resource downloads. Default is 16, except for Android where it is 4.",
         "integer"
     );
+    QCommandLineOption concurrentDownloadsPerHostOption(
+        "concurrent-downloads-per-host",
+        "Maximum concurrent HTTP resource downloads from one host. Default is 16.",
+        "integer"
+    );
     QCommandLineOption avatarURLOption(
         "avatarURL",
         "Override the avatar U.R.L.",
@@ -301,6 +306,7 @@ int main(int argc, const char* argv[]) {
     parser.addOption(disableWatchdogOption);
     parser.addOption(systemCursorOption);
     parser.addOption(concurrentDownloadsOption);
+    parser.addOption(concurrentDownloadsPerHostOption);
     parser.addOption(avatarURLOption);
     parser.addOption(replaceAvatarURLOption);
     parser.addOption(setBookmarkOption);
@@ -685,6 +691,9 @@ int main(int argc, const char* argv[]) {
     }
 #endif
 
+    // Nothing below exits early anymore, so start loading the plugin libraries while the rest starts up
+    PluginManager::getInstance()->preloadPlugins();
+
     int exitCode;
     {
         RunningMarker runningMarker(RUNNING_MARKER_FILENAME);
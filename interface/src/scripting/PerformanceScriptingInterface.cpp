@@ -14,6 +14,7 @@
 #include <ScriptEngineCast.h>
 
 #include "../Application.h"
+#include "RenderScriptingInterface.h"
 
 STATIC_SCRIPT_TYPES_INITIALIZER((+[](ScriptManager* manager){
     auto scriptEngine = manager->engine().get();
@@ -86,3 +87,73 @@ RefreshRateManager::UXMode PerformanceScriptingInterface::getUXMode() const {
 RefreshRateManager::RefreshRateRegime PerformanceScriptingInterface::getRefreshRateRegime() const {
     return qApp->getRefreshRateManager().getRefreshRateRegime();
 }
+
+void PerformanceScriptingInterface::setFrameBudgetEnabled(bool enabled) {
+    qApp->getPerformanceManager().getFrameBudget().setEnabled(enabled);
+}
+
+bool PerformanceScriptingInterface::isFrameBudgetEnabled() const {
+    return qApp->getPerformanceManager().getFrameBudget().isEnabled();
+}
+
+void PerformanceScriptingInterface::setFrameBudgetShares(float physics, float kinematics) {
+    auto& frameBudget = qApp->getPerformanceManager().getFrameBudget();
+    frameBudget.setShare(FrameBudget::PHYSICS, physics);
+    frameBudget.setShare(FrameBudget::KINEMATICS, kinematics);
+}
+
+QVariantMap PerformanceScriptingInterface::getFrameBudgetStats() const {
+    return qApp->getPerformanceManager().getFrameBudget().getStats();
+}
+
+void PerformanceScriptingInterface::setDynamicResolutionEnabled(bool enabled) {
+    auto& dynamicResolution = qApp->getPerformanceManager().getDynamicResolution();
+    dynamicResolution.setEnabled(enabled);
+    RenderScriptingInterface::getInstance()->setDynamicResolutionScale(dynamicResolution.getScale());
+}
+
+bool PerformanceScriptingInterface::isDynamicResolutionEnabled() const {
+    return qApp->getPerformanceManager().getDynamicResolution().isEnabled();
+}
+
+void PerformanceScriptingInterface::setDynamicResolutionTargets(float gpuShare, float minScale) {
+    auto& dynamicResolution = qApp->getPerformanceManager().getDynamicResolution();
+    dynamicResolution.setTargetShare(gpuShare);
+    dynamicResolution.setMinScale(minScale);
+}
+
+QVariantMap PerformanceScriptingInterface::getDynamicResolutionStats() const {
+    return qApp->getPerformanceManager().getDynamicResolution().getStats();
+}
+
+void PerformanceScriptingInterface::setFramePacingEnabled(bool enabled) {
+    qApp->getPerformanceManager().getFramePacer().setEnabled(enabled);
+}
+
+bool PerformanceScriptingInterface::isFramePacingEnabled() const {
+    return qApp->getPerformanceManager().getFramePacer().isEnabled();
+}
+
+QVariantMap PerformanceScriptingInterface::getFramePacingStats() const {
+    return qApp->getPerformanceManager().getFramePacer().getStats();
+}
+
+void PerformanceScriptingInterface::setTelemetryEnabled(bool enabled) {
+    qApp->getPerformanceManager().getTelemetry().setEnabled(enabled);
+}
+
+bool PerformanceScriptingInterface::isTelemetryEnabled() const {
+    return qApp->getPerformanceManager().getTelemetry().isEnabled();
+}
+
+void PerformanceScriptingInterface::setTelemetryEndpoint(const QString& url) {
+    qApp->getPerformanceManager().getTelemetry().setEndpoint(url);
+}
+
+QString PerformanceScriptingInterface::getTelemetryEndpoint() const {
+    return qApp->getPerformanceManager().getTelemetry().getEndpoint();
+}
+
+QVariantMap PerformanceScriptingInterface::getTelemetrySummary() const {
+    return qApp->getPerformanceManager().getTelemetry().getSummary().toVariantMap();
+}
@@ -181,6 +181,181 @@ public slots:
      */
     RefreshRateManager::RefreshRateRegime getRefreshRateRegime() const;
 
+    /*@jsdoc
+     * Enables or disables the frame budget, which shares the frame time between the physics and kinematics of the workload 
+     * regions, and caps the frame rate that the automatic LOD aims for at the rate the game loop delivers.
+     * @function Performance.setFrameBudgetEnabled
+     * @param {boolean} enabled - <code>true</code> to share the frame time, <code>false</code> to give the workload regions 
+     *     fixed budgets and leave the LOD its own target.
+     */
+    void setFrameBudgetEnabled(bool enabled);
+
+    /*@jsdoc
+     * Gets whether the frame budget is enabled.
+     * @function Performance.isFrameBudgetEnabled
+     * @returns {boolean} <code>true</code> if the frame budget is enabled, <code>false</code> if it isn't.
+     */
+    bool isFrameBudgetEnabled() const;
+
+    /*@jsdoc
+     * Sets the shares of the frame time, after the avatar animation, that the physics and the non-physical kinematics are 
+     * budgeted.
+     * @function Performance.setFrameBudgetShares
+     * @param {number} physics - The share of the physics, in the range <code>0.0</code> &ndash; <code>1.0</code>. The 
+     *     default is <code>0.15</code>.
+     * @param {number} kinematics - The share of the kinematics, in the range <code>0.0</code> &ndash; <code>1.0</code>. The 
+     *     default is <code>0.1</code>.
+     */
+    void setFrameBudgetShares(float physics, float kinematics);
+
+    /*@jsdoc
+     * The costs and budgets of the subsystems that share the frame time.
+     * @typedef {object} Performance.FrameBudgetStats
+     * @property {boolean} enabled - <code>true</code> if the frame budget is enabled, <code>false</code> if it isn't.
+     * @property {number} targetFrameTime - The time of a frame at the target refresh rate, in ms.
+     * @property {number} renderTargetFPS - The frame rate the automatic LOD aims for if the game loop can't keep up with the 
+     *     target, <code>0</code> if it can.
+     * @property {object} costs - The average costs of <code>physics</code>, <code>kinematics</code>, <code>animation</code>, 
+     *     <code>gameLoop</code> and <code>render</code>, in ms.
+     * @property {object} budgets - The budgets of <code>physics</code> and <code>kinematics</code>, in ms.
+     * @property {object} shares - The shares of <code>physics</code> and <code>kinematics</code>.
+     */
+    /*@jsdoc
+     * Gets the costs and budgets of the subsystems that share the frame time.
+     * @function Performance.getFrameBudgetStats
+     * @returns {Performance.FrameBudgetStats} The costs and budgets of the subsystems.
+     */
+    QVariantMap getFrameBudgetStats() const;
+
+    /*@jsdoc
+     * Enables or disables the dynamic resolution, which scales the resolution of the main view down when the GPU can't 
+     * render it at the target refresh rate, and back up when it can. The scale is applied on top of 
+     * {@link Render|Render.viewportResolutionScale}.
+     * @function Performance.setDynamicResolutionEnabled
+     * @param {boolean} enabled - <code>true</code> to scale the resolution to the GPU time, <code>false</code> to render at 
+     *     the viewport resolution scale.
+     */
+    void setDynamicResolutionEnabled(bool enabled);
+
+    /*@jsdoc
+     * Gets whether the dynamic resolution is enabled.
+     * @function Performance.isDynamicResolutionEnabled
+     * @returns {boolean} <code>true</code> if the dynamic resolution is enabled, <code>false</code> if it isn't.
+     */
+    bool isDynamicResolutionEnabled() const;
+
+    /*@jsdoc
+     * Sets the targets of the dynamic resolution.
+     * @function Performance.setDynamicResolutionTargets
+     * @param {number} gpuShare - The share of the frame time at the target refresh rate that the GPU aims for, in the range 
+     *     <code>0.5</code> &ndash; <code>1.0</code>. The default is <code>0.9</code>.
+     * @param {number} minScale - The lowest scale of the resolution, in the range <code>0.25</code> &ndash; 
+     *     <code>1.0</code>. The default is <code>0.5</code>.
+     */
+    void setDynamicResolutionTargets(float gpuShare, float minScale);
+
+    /*@jsdoc
+     * The state of the dynamic resolution.
+     * @typedef {object} Performance.DynamicResolutionStats
+     * @property {boolean} enabled - <code>true</code> if the dynamic resolution is enabled, <code>false</code> if it isn't.
+     * @property {number} scale - The scale applied to the viewport resolution scale.
+     * @property {number} controlledScale - The scale that the controller aims for, which the scale follows in steps.
+     * @property {number} minScale - The lowest scale.
+     * @property {number} targetShare - The share of the frame time that the GPU aims for.
+     * @property {number} targetGPUTime - The GPU time aimed for, in ms.
+     * @property {number} gpuTime - The average GPU time of the last frames, in ms.
+     */
+    /*@jsdoc
+     * Gets the state of the dynamic resolution.
+     * @function Performance.getDynamicResolutionStats
+     * @returns {Performance.DynamicResolutionStats} The state of the dynamic resolution.
+     */
+    QVariantMap getDynamicResolutionStats() const;
+
+    /*@jsdoc
+     * Enables or disables the frame pacing, which starts the game loop as late as the next present allows in HMDs, so 
+     * that the head pose that the frames are rendered with is sampled closer to their display. See 
+     * {@link FrameTimings} for the latency of the pose.
+     * @function Performance.setFramePacingEnabled
+     * @param {boolean} enabled - <code>true</code> to pace the frames, <code>false</code> to start the game loop right 
+     *     after each present.
+     */
+    void setFramePacingEnabled(bool enabled);
+
+    /*@jsdoc
+     * Gets whether the frame pacing is enabled.
+     * @function Performance.isFramePacingEnabled
+     * @returns {boolean} <code>true</code> if the frame pacing is enabled, <code>false</code> if it isn't.
+     */
+    bool isFramePacingEnabled() const;
+
+    /*@jsdoc
+     * The state of the frame pacing.
+     * @typedef {object} Performance.FramePacingStats
+     * @property {boolean} enabled - <code>true</code> if the frame pacing is enabled, <code>false</code> if it isn't.
+     * @property {boolean} active - <code>true</code> if the display presents at its refresh rate, so that the frames are 
+     *     paced, <code>false</code> if it doesn't.
+     * @property {number} presentInterval - The average time between two presents, in ms.
+     * @property {number} updateTime - The average time of the game loop, in ms.
+     * @property {number} updateDeviation - The average deviation of the time of the game loop, in ms.
+     * @property {number} delay - The average delay of the game loop after a present, in ms.
+     */
+    /*@jsdoc
+     * Gets the state of the frame pacing.
+     * @function Performance.getFramePacingStats
+     * @returns {Performance.FramePacingStats} The state of the frame pacing.
+     */
+    QVariantMap getFramePacingStats() const;
+
+    /*@jsdoc
+     * Opts in or out of the performance telemetry, which records the distributions of the frame time and of the costs of 
+     * the subsystems over each session. The summary of a session is written to the <code>telemetry</code> directory of the 
+     * application data when Interface quits, and posted to the telemetry endpoint, if there's one, when it next starts. 
+     * The summaries don't contain anything that identifies the user or the domains visited.
+     * @function Performance.setTelemetryEnabled
+     * @param {boolean} enabled - <code>true</code> to record the telemetry, <code>false</code> not to. The default is 
+     *     <code>false</code>.
+     */
+    void setTelemetryEnabled(bool enabled);
+
+    /*@jsdoc
+     * Gets whether the performance telemetry is recorded.
+     * @function Performance.isTelemetryEnabled
+     * @returns {boolean} <code>true</code> if the telemetry is recorded, <code>false</code> if it isn't.
+     */
+    bool isTelemetryEnabled() const;
+
+    /*@jsdoc
+     * Sets the URL that the summaries of the performance telemetry are posted to.
+     * @function Performance.setTelemetryEndpoint
+     * @param {string} url - The URL, or <code>""</code> to only write the summaries locally.
+     */
+    void setTelemetryEndpoint(const QString& url);
+
+    /*@jsdoc
+     * Gets the URL that the summaries of the performance telemetry are posted to.
+     * @function Performance.getTelemetryEndpoint
+     * @returns {string} The URL, <code>""</code> if the summaries are only written locally.
+     */
+    QString getTelemetryEndpoint() const;
+
+    /*@jsdoc
+     * The summary of the performance telemetry of a session.
+     * @typedef {object} Performance.TelemetrySummary
+     * @property {string} version - The version of Interface.
+     * @property {number} duration - The duration of the session, in s.
+     * @property {object} metrics - The <code>count</code>, <code>mean</code>, <code>max</code>, <code>p50</code>, 
+     *     <code>p90</code>, <code>p95</code> and <code>p99</code>, in ms, of <code>frame</code>, <code>gameLoop</code>, 
+     *     <code>renderCPU</code>, <code>renderGPU</code>, <code>physics</code>, <code>animation</code>, <code>scripts</code>, 
+     *     <code>entities</code> and <code>network</code>.
+     */
+    /*@jsdoc
+     * Gets the summary of the performance telemetry of the session so far.
+     * @function Performance.getTelemetrySummary
+     * @returns {Performance.TelemetrySummary} The summary of the session.
+     */
+    QVariantMap getTelemetrySummary() const;
+
 signals:
 
     /*@jsdoc
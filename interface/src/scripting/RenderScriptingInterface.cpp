@@ -223,6 +223,22 @@ void RenderScriptingInterface::setViewportResolutionScale(float scale) {
     }
 }
 
+void RenderScriptingInterface::setDynamicResolutionScale(float scale) {
+    if (scale <= 0.f) {
+        return;
+    }
+    bool changed = _renderSettingLock.resultWithWriteLock<bool>([&] {
+        if (_dynamicResolutionScale == scale) {
+            return false;
+        }
+        _dynamicResolutionScale = scale;
+        return true;
+    });
+    if (changed) {
+        forceViewportResolutionScale(getViewportResolutionScale());
+    }
+}
+
 void RenderScriptingInterface::setVerticalFieldOfView(float fieldOfView) {
     if (getViewportResolutionScale() != fieldOfView) {
         qApp->setFieldOfView(fieldOfView);
@@ -273,18 +289,19 @@ void RenderScriptingInterface::forceViewportResolutionScale(float scale) {
     _renderSettingLock.withWriteLock([&] {
         _viewportResolutionScale = (scale);
         _viewportResolutionScaleSetting.set(scale);
+        float resolutionScale = _viewportResolutionScale * _dynamicResolutionScale;
 
         auto renderConfig = qApp->getRenderEngine()->getConfiguration();
         assert(renderConfig);
         auto deferredView = renderConfig->getConfig("RenderMainView.RenderDeferredTask");
         // mainView can be null if we're rendering in forward mode
         if (deferredView) {
-            deferredView->setProperty("resolutionScale", _viewportResolutionScale);
+            deferredView->setProperty("resolutionScale", resolutionScale);
         }
         auto forwardView = renderConfig->getConfig("RenderMainView.RenderForwardTask");
         // mainView can be null if we're rendering in forward mode
         if (forwardView) {
-            forwardView->setProperty("resolutionScale", _viewportResolutionScale);
+            forwardView->setProperty("resolutionScale", resolutionScale);
         }
     });
 }
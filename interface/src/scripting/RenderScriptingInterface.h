@@ -48,6 +48,9 @@ public:
 
     static RenderScriptingInterface* getInstance();
 
+    // The scale of the dynamic resolution, applied on top of the viewport resolution scale but not saved with it
+    void setDynamicResolutionScale(float scale);
+
     /*@jsdoc
      * <p>The rendering method is specified by the following values:</p>
      * <table>
@@ -238,6 +241,7 @@ private:
     bool _ambientOcclusionEnabled{ false };
     AntialiasingConfig::Mode _antialiasingMode{ AntialiasingConfig::Mode::NONE };
     float _viewportResolutionScale{ 1.0f };
+    float _dynamicResolutionScale{ 1.0f };
     QString _fullScreenScreen;
 
 
@@ -156,6 +156,19 @@ void TestScriptingInterface::savePhysicsSimulationStats(QString originalPath) {
     qApp->saveNextPhysicsStats(path);
 }
 
+void TestScriptingInterface::startPhysicsRecording(QString originalPath) {
+    QString path = FileUtils::replaceDateTimeTokens(originalPath);
+    path = FileUtils::computeDocumentPath(path);
+    if (!FileUtils::canCreateFile(path)) {
+        return;
+    }
+    qApp->startPhysicsRecording(path);
+}
+
+void TestScriptingInterface::stopPhysicsRecording() {
+    qApp->stopPhysicsRecording();
+}
+
 void TestScriptingInterface::profileRange(const QString& name, const ScriptValue& fn) {
     PROFILE_RANGE(script, name);
     fn.call();
@@ -122,6 +122,19 @@ public slots:
      */
     void savePhysicsSimulationStats(QString filename);
 
+    /*@jsdoc
+     * Starts recording the physics simulation to filename, for the physics-player tool to replay it
+     * @function Test.startPhysicsRecording
+     * @param {string} filename - Name of file to record to
+     */
+    void startPhysicsRecording(QString filename);
+
+    /*@jsdoc
+     * Stops recording the physics simulation
+     * @function Test.stopPhysicsRecording
+     */
+    void stopPhysicsRecording();
+
     /*@jsdoc
     * Profiles a specific function
     * @function Test.savePhysicsSimulationStats
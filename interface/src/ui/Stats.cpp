@@ -27,6 +27,8 @@
 #include <PerfStat.h>
 #include <plugins/DisplayPlugin.h>
 #include <PickManager.h>
+#include <RenderableWebEntityItem.h>
+#include <ResourcePrefetcher.h>
 
 #include <gl/Context.h>
 
@@ -127,9 +129,15 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(avatarCount, avatarManager->size() - 1);
     STAT_UPDATE(heroAvatarCount, avatarManager->getNumHeroAvatars());
     STAT_UPDATE(physicsObjectCount, qApp->getNumCollisionObjects());
+    if (auto entitySimulation = qApp->getEntitySimulation()) {
+        STAT_UPDATE(physicsParkedObjectCount, (int)entitySimulation->getNumParkedEntities());
+        STAT_UPDATE(physicsChurnCount, (int)(entitySimulation->getNumAddedToPhysics() + entitySimulation->getNumRemovedFromPhysics()));
+    }
     STAT_UPDATE(updatedAvatarCount, avatarManager->getNumAvatarsUpdated());
     STAT_UPDATE(updatedHeroAvatarCount, avatarManager->getNumHeroAvatarsUpdated());
     STAT_UPDATE(notUpdatedAvatarCount, avatarManager->getNumAvatarsNotUpdated());
+    STAT_UPDATE(reducedAvatarCount, avatarManager->getNumAvatarsReduced());
+    STAT_UPDATE(frozenAvatarCount, avatarManager->getNumAvatarsFrozen());
     STAT_UPDATE(serverCount, (int)nodeList->size());
     STAT_UPDATE_FLOAT(renderrate, qApp->getRenderLoopRate(), 0.1f);
     RefreshRateManager& refreshRateManager = qApp->getRefreshRateManager();
@@ -293,6 +301,9 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(downloads, loadingRequests.size());
         STAT_UPDATE(downloadLimit, (int)ResourceCache::getRequestLimit())
         STAT_UPDATE(downloadsPending, (int)ResourceCache::getPendingRequestCount());
+        auto resourcePrefetcher = DependencyManager::get<ResourcePrefetcher>();
+        STAT_UPDATE(prefetched, resourcePrefetcher->getNumPrefetched());
+        STAT_UPDATE(prefetchHitRate, resourcePrefetcher->getHitRate());
         STAT_UPDATE(processing, DependencyManager::get<StatTracker>()->getStat("Processing").toInt());
         STAT_UPDATE(processingPending, DependencyManager::get<StatTracker>()->getStat("PendingProcessing").toInt());
 
@@ -389,6 +400,7 @@ void Stats::updateStats(bool force) {
     auto config = qApp->getRenderEngine()->getConfiguration().get();
     STAT_UPDATE(engineFrameTime, (float) config->getCPURunTime());
     STAT_UPDATE(avatarSimulationTime, (float)avatarManager->getAvatarSimulationTime());
+    STAT_UPDATE(avatarParseTime, (float)avatarManager->getAvatarParseTime());
 
     if (_expanded) {
         STAT_UPDATE(gpuBuffers, (int)gpu::Context::getBufferGPUCount());
@@ -398,6 +410,17 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(glContextSwapchainMemory, (int)BYTES_TO_MB(gl::Context::getSwapchainMemoryUsage()));
 
         STAT_UPDATE(qmlTextureMemory, (int)BYTES_TO_MB(OffscreenQmlSurface::getUsedTextureMemory()));
+        {
+            auto webSurfaceStats = render::entities::WebEntityRenderer::getWebSurfaceStats();
+            int suspended = 0;
+            for (const auto& surfaceStats : webSurfaceStats) {
+                if (surfaceStats.toMap()["suspended"].toBool()) {
+                    ++suspended;
+                }
+            }
+            STAT_UPDATE(webSurfaces, webSurfaceStats.size());
+            STAT_UPDATE(webSurfacesSuspended, suspended);
+        }
         STAT_UPDATE(texturePendingTransfers, (int)BYTES_TO_MB(gpu::Context::getTexturePendingGPUTransferMemSize()));
         STAT_UPDATE(gpuTextureMemory, (int)BYTES_TO_MB(gpu::Context::getTextureGPUMemSize()));
         STAT_UPDATE(gpuTextureResidentMemory, (int)BYTES_TO_MB(gpu::Context::getTextureResidentGPUMemSize()));
@@ -460,6 +483,18 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(lodStatus, "You can see " + DependencyManager::get<LODManager>()->getLODFeedbackText());
         STAT_UPDATE(numEntityUpdates, DependencyManager::get<EntityTreeRenderer>()->getPrevNumEntityUpdates());
         STAT_UPDATE(numNeededEntityUpdates, DependencyManager::get<EntityTreeRenderer>()->getPrevTotalNeededEntityUpdates());
+        {
+            auto entityTreeRenderer = DependencyManager::get<EntityTreeRenderer>();
+            QStringList entityUpdateCosts;
+            for (int type = EntityTypes::Unknown + 1; type < EntityTypes::NUM_TYPES; ++type) {
+                float cost = entityTreeRenderer->getAverageEntityUpdateCost((EntityTypes::EntityType)type);
+                if (cost > 0.0f) {
+                    entityUpdateCosts << QString("%1: %2").arg(EntityTypes::getEntityTypeName((EntityTypes::EntityType)type))
+                        .arg((int)cost);
+                }
+            }
+            STAT_UPDATE(entityUpdateCosts, entityUpdateCosts.join(", "));
+        }
     }
 
 
@@ -577,6 +612,7 @@ void Stats::updateStats(bool force) {
 void Stats::setRenderDetails(const render::RenderDetails& details) {
     STAT_UPDATE(triangles, details._trianglesRendered);
     STAT_UPDATE(materialSwitches, details._materialSwitches);
+    STAT_UPDATE(drawcallsSavedByInstancing, details._drawcallsSavedByInstancing);
     if (_expanded) {
         STAT_UPDATE(itemConsidered, details._item._considered);
         STAT_UPDATE(itemOutOfView, details._item._outOfView);
@@ -87,6 +87,12 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} physicsObjectCount - The number of objects that have collisions enabled.
  *     <em>Read-only.</em>
+ * @property {number} physicsParkedObjectCount - The number of objects that have left the physics simulation region but
+ *     are kept, disabled, in the physics engine in case they come back.
+ *     <em>Read-only.</em>
+ * @property {number} physicsChurnCount - The number of objects added to or removed from the physics engine in the most
+ *     recent game loop.
+ *     <em>Read-only.</em>
  * @property {number} updatedAvatarCount - The number of avatars in the domain, other than the client's, that were updated in 
  *     the most recent game loop.
  *     <em>Read-only.</em>
@@ -96,6 +102,12 @@ private: \
  * @property {number} notUpdatedAvatarCount - The number of avatars in the domain, other than the client's, that weren't able 
  *     to be updated in the most recent game loop because there wasn't enough time to.
  *     <em>Read-only.</em>
+ * @property {number} reducedAvatarCount - The number of avatars in the domain, other than the client's, that are small enough
+ *     on screen that their pose is updated only every few game loops.
+ *     <em>Read-only.</em>
+ * @property {number} frozenAvatarCount - The number of avatars in the domain, other than the client's, that are small enough
+ *     on screen that their pose is held.
+ *     <em>Read-only.</em>
  * @property {number} packetInCount - The number of packets being received from the domain server, in packets per second.
  *     <em>Read-only.</em>
  * @property {number} packetOutCount - The number of packets being sent to the domain server, in packets per second.
@@ -209,6 +221,11 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} downloadsPending - The number of downloads pending.
  *     <em>Read-only.</em>
+ * @property {number} prefetched - The number of resources prefetched for the current domain.
+ *     <em>Read-only.</em>
+ * @property {number} prefetchHitRate - The fraction of the resources requested since arriving in the current domain that
+ *     had been prefetched.
+ *     <em>Read-only.</em>
  * @property {string[]} downloadUrls - The download URLs.
  *     <em>Read-only.</em>
  *     <p><strong>Note:</strong> Property not available in the API.</p>
@@ -222,6 +239,9 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} materialSwitches - The number of material switches performed for the rendered scene.
  *     <em>Read-only.</em>
+ * @property {number} drawcallsSavedByInstancing - The number of model mesh part draw calls saved by drawing repeated
+ *     parts as instances for the rendered scene.
+ *     <em>Read-only.</em>
  * @property {number} itemConsidered - The number of item considerations made for rendering.
  *     <em>Read-only.</em>
  * @property {number} itemOutOfView - The number of items out of view.
@@ -252,6 +272,9 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} numNeededEntityUpdates - The total number of entity updates scheduled for last frame.
  *     <em>Read-only.</em>
+ * @property {string} entityUpdateCosts - The average time (&mu;s) an entity update takes, for each entity type that has
+ *     been updated.
+ *     <em>Read-only.</em>
  * @property {string} timingStats - Details of the average time (ms) spent in and number of calls made to different parts of 
  *     the code. Provided only if <code>timingExpanded</code> is <code>true</code>. Only the top 10 items are provided if 
  *     Developer &gt; Timing &gt; Performance Timer &gt; Only Display Top 10 is enabled.
@@ -292,6 +315,9 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} qmlTextureMemory - The memory size of textures managed by the offscreen QML surface, in MB.
  *     <em>Read-only.</em>
+ * @property {number} webSurfaces - The number of surfaces of web entities. <em>Read-only.</em>
+ * @property {number} webSurfacesSuspended - The number of surfaces of web entities that are paused because the entities
+ *     are off-screen or far. <em>Read-only.</em>
  * @property {number} texturePendingTransfers - The memory size of textures pending transfer to the GPU, in MB.
  *     <em>Read-only.</em>
  * @property {number} gpuTextureResidentMemory - The memory size of the "strict" textures that always have their full 
@@ -337,6 +363,8 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} avatarSimulationTime - The time being spent simulating avatars each frame, in ms.
  *     <em>Read-only.</em>
+ * @property {number} avatarParseTime - The time being spent parsing received avatar data each frame, in ms.
+ *     <em>Read-only.</em>
  *
  * @property {number} stylusPicksCount - The number of stylus picks currently in effect.
  *     <em>Read-only.</em>
@@ -485,9 +513,13 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(QString, uxMode, QString())
     STATS_PROPERTY(int, heroAvatarCount, 0)
     STATS_PROPERTY(int, physicsObjectCount, 0)
+    STATS_PROPERTY(int, physicsParkedObjectCount, 0)
+    STATS_PROPERTY(int, physicsChurnCount, 0)
     STATS_PROPERTY(int, updatedAvatarCount, 0)
     STATS_PROPERTY(int, updatedHeroAvatarCount, 0)
     STATS_PROPERTY(int, notUpdatedAvatarCount, 0)
+    STATS_PROPERTY(int, reducedAvatarCount, 0)
+    STATS_PROPERTY(int, frozenAvatarCount, 0)
     STATS_PROPERTY(int, packetInCount, 0)
     STATS_PROPERTY(int, packetOutCount, 0)
     STATS_PROPERTY(float, mbpsIn, 0)
@@ -528,12 +560,15 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, downloads, 0)
     STATS_PROPERTY(int, downloadLimit, 0)
     STATS_PROPERTY(int, downloadsPending, 0)
+    STATS_PROPERTY(int, prefetched, 0)
+    STATS_PROPERTY(float, prefetchHitRate, 0)
     Q_PROPERTY(QStringList downloadUrls READ downloadUrls NOTIFY downloadUrlsChanged)
     STATS_PROPERTY(int, processing, 0)
     STATS_PROPERTY(int, processingPending, 0)
     STATS_PROPERTY(int, triangles, 0)
     STATS_PROPERTY(quint32 , drawcalls, 0)
     STATS_PROPERTY(int, materialSwitches, 0)
+    STATS_PROPERTY(int, drawcallsSavedByInstancing, 0)
     STATS_PROPERTY(int, itemConsidered, 0)
     STATS_PROPERTY(int, itemOutOfView, 0)
     STATS_PROPERTY(int, itemTooSmall, 0)
@@ -549,6 +584,7 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(QString, lodStatus, QString())
     STATS_PROPERTY(quint64, numEntityUpdates, 0)
     STATS_PROPERTY(quint64, numNeededEntityUpdates, 0)
+    STATS_PROPERTY(QString, entityUpdateCosts, QString())
     STATS_PROPERTY(QString, timingStats, QString())
     STATS_PROPERTY(QString, gameUpdateStats, QString())
     STATS_PROPERTY(int, serverElements, 0)
@@ -565,6 +601,8 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, gpuTextures, 0)
     STATS_PROPERTY(int, glContextSwapchainMemory, 0)
     STATS_PROPERTY(int, qmlTextureMemory, 0)
+    STATS_PROPERTY(int, webSurfaces, 0)
+    STATS_PROPERTY(int, webSurfacesSuspended, 0)
     STATS_PROPERTY(int, texturePendingTransfers, 0)
     STATS_PROPERTY(int, gpuTextureMemory, 0)
     STATS_PROPERTY(int, gpuTextureResidentMemory, 0)
@@ -581,6 +619,7 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(float, batchFrameTime, 0)
     STATS_PROPERTY(float, engineFrameTime, 0)
     STATS_PROPERTY(float, avatarSimulationTime, 0)
+    STATS_PROPERTY(float, avatarParseTime, 0)
 
     STATS_PROPERTY(int, stylusPicksCount, 0)
     STATS_PROPERTY(int, rayPicksCount, 0)
@@ -795,6 +834,20 @@ signals:
      */
     void physicsObjectCountChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>physicsParkedObjectCount</code> property changes.
+     * @function Stats.physicsParkedObjectCountChanged
+     * @returns {Signal}
+     */
+    void physicsParkedObjectCountChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>physicsChurnCount</code> property changes.
+     * @function Stats.physicsChurnCountChanged
+     * @returns {Signal}
+     */
+    void physicsChurnCountChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>updatedAvatarCount</code> property changes.
      * @function Stats.updatedAvatarCountChanged
@@ -816,6 +869,20 @@ signals:
      */
     void notUpdatedAvatarCountChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>reducedAvatarCount</code> property changes.
+     * @function Stats.reducedAvatarCountChanged
+     * @returns {Signal}
+     */
+    void reducedAvatarCountChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>frozenAvatarCount</code> property changes.
+     * @function Stats.frozenAvatarCountChanged
+     * @returns {Signal}
+     */
+    void frozenAvatarCountChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>packetInCount</code> property changes.
      * @function Stats.packetInCountChanged
@@ -1084,6 +1151,20 @@ signals:
      */
     void downloadsPendingChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>prefetched</code> property changes.
+     * @function Stats.prefetchedChanged
+     * @returns {Signal}
+     */
+    void prefetchedChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>prefetchHitRate</code> property changes.
+     * @function Stats.prefetchHitRateChanged
+     * @returns {Signal}
+     */
+    void prefetchHitRateChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>downloadUrls</code> property changes.
      * @function Stats.downloadUrlsChanged
@@ -1126,6 +1207,13 @@ signals:
      */
     void materialSwitchesChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>drawcallsSavedByInstancing</code> property changes.
+     * @function Stats.drawcallsSavedByInstancingChanged
+     * @returns {Signal}
+     */
+    void drawcallsSavedByInstancingChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>itemConsidered</code> property changes.
      * @function Stats.itemConsideredChanged
@@ -1231,6 +1319,13 @@ signals:
      */
     void numNeededEntityUpdatesChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>entityUpdateCosts</code> property changes.
+     * @function Stats.entityUpdateCostsChanged
+     * @returns {Signal}
+     */
+    void entityUpdateCostsChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>timingStats</code> property changes.
      * @function Stats.timingStatsChanged
@@ -1336,6 +1431,20 @@ signals:
      */
     void qmlTextureMemoryChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>webSurfaces</code> property changes.
+     * @function Stats.webSurfacesChanged
+     * @returns {Signal}
+     */
+    void webSurfacesChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>webSurfacesSuspended</code> property changes.
+     * @function Stats.webSurfacesSuspendedChanged
+     * @returns {Signal}
+     */
+    void webSurfacesSuspendedChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>texturePendingTransfers</code> property changes.
      * @function Stats.texturePendingTransfersChanged
@@ -1448,6 +1557,13 @@ signals:
      */
     void avatarSimulationTimeChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>avatarParseTime</code> property changes.
+     * @function Stats.avatarParseTimeChanged
+     * @returns {Signal}
+     */
+    void avatarParseTimeChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>stylusPicksCount</code> property changes.
      * @function Stats.stylusPicksCountChanged
@@ -46,7 +46,7 @@ protected:
     float _alpha;
     AnimBlendType _blendType;
 
-    QString _alphaVar;
+    AnimVarKey _alphaVar;
 
     // no copies
     AnimBlendLinear(const AnimBlendLinear&) = delete;
@@ -41,7 +41,7 @@ public:
 
     virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) override;
 
-    void setAlphaVar(const QString& alphaVar) { _alphaVar = alphaVar; }
+    void setAlphaVar(const QString& alphaVar);
     void setDesiredSpeedVar(const QString& desiredSpeedVar) { _desiredSpeedVar = desiredSpeedVar; }
 
 protected:
@@ -64,8 +64,9 @@ protected:
 
     float _phase = 0.0f;
 
-    QString _alphaVar;
-    QString _desiredSpeedVar;
+    AnimVarKey _alphaVar;
+    AnimVarKey _desiredSpeedVar;
+    AnimVarKey _speedVar { "moveForwardSpeed" };  // chosen from the name of _alphaVar
 
     std::vector<float> _characteristicSpeeds;
 
@@ -12,6 +12,8 @@
 
 #include <assert.h>
 
+#include <QtCore/QCryptographicHash>
+
 #include "GLMHelpers.h"
 #include "AnimationLogging.h"
 #include "AnimUtil.h"
@@ -264,47 +266,37 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
     if (_blendType == AnimBlendType_Normal) {
         if (_networkAnim && _networkAnim->isLoaded() && _skeleton) {
             // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
+            loadClipData();
 
             // we no longer need the actual animation resource anymore.
             _networkAnim.reset();
 
             // mirrorAnim will be re-built on demand, if needed.
-            _mirrorAnim.clear();
+            _mirrorClipData.reset();
 
             _poses.resize(_skeleton->getNumJoints());
         }
     } else {
         // an additive blend type
         if (_networkAnim && _networkAnim->isLoaded() && _baseNetworkAnim && _baseNetworkAnim->isLoaded() && _skeleton) {
-            // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
+            // loading is complete, copy & retarget animation, and bake it relative to baseAnim.
+            loadClipData();
 
             // we no longer need the actual animation resource anymore.
             _networkAnim.reset();
 
             // mirrorAnim will be re-built on demand, if needed.
             // TODO: handle mirrored relative animations.
-            _mirrorAnim.clear();
+            _mirrorClipData.reset();
 
             _poses.resize(_skeleton->getNumJoints());
-
-            // copy & retarget baseAnim!
-            auto baseAnim = copyAndRetargetFromNetworkAnim(_baseNetworkAnim, _skeleton);
-
-            if (_blendType == AnimBlendType_AddAbsolute) {
-                bakeAbsoluteDeltaAnim(_anim, baseAnim[(int)_baseFrame], _skeleton);
-            } else {
-                // AnimBlendType_AddRelative
-                bakeRelativeDeltaAnim(_anim, baseAnim[(int)_baseFrame]);
-            }
         }
     }
 
-    if (_anim.size()) {
+    if (_clipData && _clipData->getNumFrames() > 0 && _clipData->getNumJoints() == (int)_poses.size()) {
 
         // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
+        if (_mirrorFlag && !_mirrorClipData) {
             buildMirrorAnim();
         }
 
@@ -318,15 +310,14 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = _clipData->getNumFrames();
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
+        const AnimClipData& clipData = _mirrorFlag ? *_mirrorClipData : *_clipData;
         float alpha = glm::fract(_frame);
 
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        clipData.sample(prevIndex, nextIndex, alpha, &_poses[0]);
     }
 
     processOutputJoints(triggersOut);
@@ -341,15 +332,52 @@ void AnimClip::setCurrentFrameInternal(float frame) {
     _frame = ::accumulateTime(_startFrame, _endFrame, _timeScale, frame + _startFrame, dt, _loopFlag, _id, triggers);
 }
 
-void AnimClip::buildMirrorAnim() {
+void AnimClip::loadClipData() {
     assert(_skeleton);
 
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
+    // the clips retargeted to skeletons with the same joints and default poses are the same
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    for (int i = 0; i < _skeleton->getNumJoints(); i++) {
+        hash.addData(_skeleton->getJointName(i).toUtf8());
+        int parentIndex = _skeleton->getParentIndex(i);
+        hash.addData((const char*)&parentIndex, sizeof(parentIndex));
+        const AnimPose& pose = _skeleton->getRelativeDefaultPose(i);
+        hash.addData((const char*)&pose.scale(), sizeof(glm::vec3));
+        hash.addData((const char*)&pose.rot(), sizeof(glm::quat));
+        hash.addData((const char*)&pose.trans(), sizeof(glm::vec3));
+    }
+    QString key = _url + "|" + hash.result().toHex();
+    if (_blendType != AnimBlendType_Normal) {
+        key += "|" + QString::number(_blendType) + "|" + _baseURL + "|" + QString::number((int)_baseFrame);
+    }
+
+    auto animCache = DependencyManager::get<AnimationCache>();
+    _clipData = animCache->getClipData(key);
+    if (_clipData) {
+        return;
     }
+
+    auto anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
+    if (_blendType != AnimBlendType_Normal) {
+        // copy & retarget baseAnim!
+        auto baseAnim = copyAndRetargetFromNetworkAnim(_baseNetworkAnim, _skeleton);
+
+        if (_blendType == AnimBlendType_AddAbsolute) {
+            bakeAbsoluteDeltaAnim(anim, baseAnim[(int)_baseFrame], _skeleton);
+        } else {
+            // AnimBlendType_AddRelative
+            bakeRelativeDeltaAnim(anim, baseAnim[(int)_baseFrame]);
+        }
+    }
+    _clipData = std::make_shared<AnimClipData>(anim);
+    animCache->addClipData(key, _clipData);
+}
+
+void AnimClip::buildMirrorAnim() {
+    assert(_skeleton);
+
+    // built once for all the clips sharing _clipData
+    _mirrorClipData = _clipData->getMirror(*_skeleton);
 }
 
 const AnimPoseVec& AnimClip::getPosesInternal() const {
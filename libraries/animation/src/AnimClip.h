@@ -13,6 +13,7 @@
 
 #include <string>
 #include "AnimationCache.h"
+#include "AnimClipData.h"
 #include "AnimNode.h"
 
 // Playback a single animation timeline.
@@ -61,6 +62,7 @@ protected:
 
     virtual void setCurrentFrameInternal(float frame) override;
 
+    void loadClipData();
     void buildMirrorAnim();
 
     // for AnimDebugDraw rendering
@@ -71,9 +73,9 @@ protected:
 
     AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    // the frames retargeted to _skeleton, shared with the other clips playing them on skeletons like it
+    AnimClipData::ConstPointer _clipData;
+    AnimClipData::ConstPointer _mirrorClipData;
 
     QString _url;
     float _startFrame;
@@ -86,12 +88,12 @@ protected:
     QString _baseURL;
     float _baseFrame;
 
-    QString _startFrameVar;
-    QString _endFrameVar;
-    QString _timeScaleVar;
-    QString _loopFlagVar;
-    QString _mirrorFlagVar;
-    QString _frameVar;
+    AnimVarKey _startFrameVar;
+    AnimVarKey _endFrameVar;
+    AnimVarKey _timeScaleVar;
+    AnimVarKey _loopFlagVar;
+    AnimVarKey _mirrorFlagVar;
+    AnimVarKey _frameVar;
 
     // no copies
     AnimClip(const AnimClip&) = delete;
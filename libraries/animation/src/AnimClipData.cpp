@@ -0,0 +1,139 @@
+//
+//  AnimClipData.cpp
+//  libraries/animation/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AnimClipData.h"
+
+#include <algorithm>
+
+#include "AnimSkeleton.h"
+#include "AnimUtil.h"
+
+static const float QUANTIZED_ONE = 32767.0f;
+// translations and scales closer than this to the first frame are considered unchanged
+static const float CONSTANT_EPSILON = 1.0e-5f;
+
+static void quantizeRotation(const glm::quat& rotation, int16_t* quantized) {
+    // the quaternion and its opposite are the same rotation, w is kept positive so that they quantize the same
+    glm::quat q = rotation.w < 0.0f ? -rotation : rotation;
+    quantized[0] = (int16_t)glm::round(glm::clamp(q.x, -1.0f, 1.0f) * QUANTIZED_ONE);
+    quantized[1] = (int16_t)glm::round(glm::clamp(q.y, -1.0f, 1.0f) * QUANTIZED_ONE);
+    quantized[2] = (int16_t)glm::round(glm::clamp(q.z, -1.0f, 1.0f) * QUANTIZED_ONE);
+    quantized[3] = (int16_t)glm::round(glm::clamp(q.w, -1.0f, 1.0f) * QUANTIZED_ONE);
+}
+
+// not normalized, safeLerp normalizes the result
+static glm::quat dequantizeRotation(const int16_t* quantized) {
+    return glm::quat((float)quantized[3], (float)quantized[0], (float)quantized[1], (float)quantized[2]) * (1.0f / QUANTIZED_ONE);
+}
+
+static bool isNear(const glm::vec3& a, const glm::vec3& b) {
+    return glm::all(glm::lessThanEqual(glm::abs(a - b), glm::vec3(CONSTANT_EPSILON)));
+}
+
+AnimClipData::AnimClipData(const std::vector<AnimPoseVec>& frames) {
+    _numFrames = (int)frames.size();
+    if (_numFrames == 0) {
+        return;
+    }
+    _constantPoses = frames[0];
+    const int numJoints = (int)_constantPoses.size();
+
+    for (int i = 0; i < numJoints; i++) {
+        int16_t firstRotation[4];
+        quantizeRotation(_constantPoses[i].rot(), firstRotation);
+        bool isRotationConstant = true;
+        bool isTranslationConstant = true;
+        bool isScaleConstant = true;
+        for (int frame = 1; frame < _numFrames; frame++) {
+            const AnimPose& pose = frames[frame][i];
+            int16_t rotation[4];
+            quantizeRotation(pose.rot(), rotation);
+            isRotationConstant = isRotationConstant && std::equal(rotation, rotation + 4, firstRotation);
+            isTranslationConstant = isTranslationConstant && isNear(pose.trans(), _constantPoses[i].trans());
+            isScaleConstant = isScaleConstant && isNear(pose.scale(), _constantPoses[i].scale());
+        }
+        if (!isRotationConstant) {
+            _rotationJoints.push_back(i);
+        }
+        if (!isTranslationConstant) {
+            _translationJoints.push_back(i);
+        }
+        if (!isScaleConstant) {
+            _scaleJoints.push_back(i);
+        }
+    }
+
+    _rotations.resize(_numFrames * _rotationJoints.size() * 4);
+    _translations.reserve(_numFrames * _translationJoints.size());
+    _scales.reserve(_numFrames * _scaleJoints.size());
+    int16_t* rotation = _rotations.data();
+    for (int frame = 0; frame < _numFrames; frame++) {
+        const AnimPoseVec& poses = frames[frame];
+        for (int joint : _rotationJoints) {
+            quantizeRotation(poses[joint].rot(), rotation);
+            rotation += 4;
+        }
+        for (int joint : _translationJoints) {
+            _translations.push_back(poses[joint].trans());
+        }
+        for (int joint : _scaleJoints) {
+            _scales.push_back(poses[joint].scale());
+        }
+    }
+}
+
+size_t AnimClipData::getMemorySize() const {
+    return _constantPoses.size() * sizeof(AnimPose) + _rotations.size() * sizeof(int16_t) +
+        _translations.size() * sizeof(glm::vec3) + _scales.size() * sizeof(glm::vec3) +
+        (_rotationJoints.size() + _translationJoints.size() + _scaleJoints.size()) * sizeof(int);
+}
+
+void AnimClipData::sample(int prevFrame, int nextFrame, float alpha, AnimPose* poses) const {
+    std::copy(_constantPoses.begin(), _constantPoses.end(), poses);
+
+    const size_t numRotations = _rotationJoints.size();
+    const int16_t* prevRotations = _rotations.data() + prevFrame * numRotations * 4;
+    const int16_t* nextRotations = _rotations.data() + nextFrame * numRotations * 4;
+    for (size_t i = 0; i < numRotations; i++) {
+        poses[_rotationJoints[i]].rot() = safeLerp(dequantizeRotation(prevRotations + i * 4), dequantizeRotation(nextRotations + i * 4), alpha);
+    }
+
+    const size_t numTranslations = _translationJoints.size();
+    const glm::vec3* prevTranslations = _translations.data() + prevFrame * numTranslations;
+    const glm::vec3* nextTranslations = _translations.data() + nextFrame * numTranslations;
+    for (size_t i = 0; i < numTranslations; i++) {
+        poses[_translationJoints[i]].trans() = glm::mix(prevTranslations[i], nextTranslations[i], alpha);
+    }
+
+    const size_t numScales = _scaleJoints.size();
+    const glm::vec3* prevScales = _scales.data() + prevFrame * numScales;
+    const glm::vec3* nextScales = _scales.data() + nextFrame * numScales;
+    for (size_t i = 0; i < numScales; i++) {
+        poses[_scaleJoints[i]].scale() = glm::mix(prevScales[i], nextScales[i], alpha);
+    }
+}
+
+void AnimClipData::decodeFrame(int frame, AnimPoseVec& poses) const {
+    poses.resize(_constantPoses.size());
+    sample(frame, frame, 0.0f, poses.data());
+}
+
+AnimClipData::ConstPointer AnimClipData::getMirror(const AnimSkeleton& skeleton) const {
+    std::call_once(_mirrorFlag, [&] {
+        std::vector<AnimPoseVec> frames(_numFrames);
+        for (int frame = 0; frame < _numFrames; frame++) {
+            decodeFrame(frame, frames[frame]);
+            skeleton.mirrorRelativePoses(frames[frame]);
+        }
+        _mirror = std::make_shared<AnimClipData>(frames);
+    });
+    return _mirror;
+}
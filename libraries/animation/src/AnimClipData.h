@@ -0,0 +1,65 @@
+//
+//  AnimClipData.h
+//  libraries/animation/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_AnimClipData_h
+#define overte_AnimClipData_h
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "AnimPose.h"
+
+class AnimSkeleton;
+
+/// The frames of an animation retargeted to a skeleton, compressed for playback.  The joints whose rotation, translation
+/// or scale doesn't change over the clip keep a single value, and the rotations that change are quantized to 16 bits per
+/// component.  The clips are immutable once built, so the AnimClips playing the same animation on the same skeleton
+/// share them through the AnimationCache.
+class AnimClipData {
+public:
+    using Pointer = std::shared_ptr<AnimClipData>;
+    using ConstPointer = std::shared_ptr<const AnimClipData>;
+
+    // frames[frame][joint]
+    explicit AnimClipData(const std::vector<AnimPoseVec>& frames);
+
+    int getNumFrames() const { return _numFrames; }
+    int getNumJoints() const { return (int)_constantPoses.size(); }
+    /// Returns the number of bytes taken by the frames
+    size_t getMemorySize() const;
+
+    /// Blends the poses of frames prevFrame and nextFrame into poses, as ::blend would the uncompressed frames
+    void sample(int prevFrame, int nextFrame, float alpha, AnimPose* poses) const;
+    void decodeFrame(int frame, AnimPoseVec& poses) const;
+
+    /// Returns this clip mirrored by skeleton, built the first time it's asked for
+    ConstPointer getMirror(const AnimSkeleton& skeleton) const;
+
+private:
+    int _numFrames { 0 };
+    // the value of each joint in the first frame, kept for the channels that don't change
+    AnimPoseVec _constantPoses;
+
+    // the joints with animated channels, and their values by frame then joint
+    std::vector<int> _rotationJoints;
+    std::vector<int16_t> _rotations;
+    std::vector<int> _translationJoints;
+    std::vector<glm::vec3> _translations;
+    std::vector<int> _scaleJoints;
+    std::vector<glm::vec3> _scales;
+
+    mutable std::once_flag _mirrorFlag;
+    mutable ConstPointer _mirror;
+};
+
+#endif // overte_AnimClipData_h
@@ -235,7 +235,7 @@ float AnimInverseKinematics::getInterpolationAlpha(float timer) {
 
 void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<IKTarget>& targets, float dt, JointChainInfoVec& jointChainInfoVec) {
     // compute absolute poses that correspond to relative target poses
-    AnimPoseVec absolutePoses;
+    AnimPoseVec& absolutePoses = _absolutePoses;
     absolutePoses.resize(_relativePoses.size());
     computeAbsolutePoses(absolutePoses);
 
@@ -248,8 +248,22 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
     }
 
     std::map<int, int> targetToChainMap;
+    for (size_t i = 0; i < _prevJointChainInfoVec.size(); i++) {
+        targetToChainMap.insert(std::pair<int, int>(_prevJointChainInfoVec[i].target.getIndex(), (int)i));
+    }
+
+    // the chains blending from their previous type and the debug draw are done on the last loop,
+    // the solve can stop early only when there are none
+    bool canStopEarly = !context.getEnableDebugDrawIKChains();
+    for (const auto& prevJointChainInfo : _prevJointChainInfoVec) {
+        if (prevJointChainInfo.timer > 0.0f) {
+            canStopEarly = false;
+            break;
+        }
+    }
 
     float maxError = 0.0f;
+    float prevMaxError = FLT_MAX;
     int numLoops = 0;
     const int MAX_IK_LOOPS = 16;
     while (numLoops < MAX_IK_LOOPS) {
@@ -274,7 +288,6 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
         // on last iteration, interpolate jointChains, if necessary
         if (numLoops == MAX_IK_LOOPS) {
             for (size_t i = 0; i < _prevJointChainInfoVec.size(); i++) {
-                targetToChainMap.insert(std::pair<int, int>(_prevJointChainInfoVec[i].target.getIndex(), (int)i));
                 if (_prevJointChainInfoVec[i].timer > 0.0f) {
                     float alpha = getInterpolationAlpha(_prevJointChainInfoVec[i].timer);
                     size_t chainSize = std::min(_prevJointChainInfoVec[i].jointInfoVec.size(), jointChainInfoVec[i].jointInfoVec.size());
@@ -347,6 +360,16 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
                 }
             }
         }
+
+        // stop once the targets are reached, or once the solve no longer gets closer to them
+        const float MIN_IK_ERROR = 1.0e-4f;
+        const float MIN_IK_IMPROVEMENT = 1.0e-3f;
+        const int MIN_IK_LOOPS = 2;
+        if (canStopEarly && numLoops >= MIN_IK_LOOPS &&
+            (maxError < MIN_IK_ERROR || prevMaxError - maxError < MIN_IK_IMPROVEMENT * prevMaxError)) {
+            break;
+        }
+        prevMaxError = maxError;
     }
     _maxErrorOnLastSolve = maxError;
 
@@ -1487,6 +1510,26 @@ void AnimInverseKinematics::setSkeletonInternal(AnimSkeleton::ConstPointer skele
 
         _leftHandIndex = _skeleton->nameToJointIndex("LeftHand");
         _rightHandIndex = _skeleton->nameToJointIndex("RightHand");
+
+        // the limbs preconditioned before the CCD solve, tip, mid and base
+        const int NUM_LIMBS = 4;
+        const char* limbNames[NUM_LIMBS][3] = {
+            { "LeftHand", "LeftForeArm", "LeftArm" },
+            { "RightHand", "RightForeArm", "RightArm" },
+            { "LeftFoot", "LeftLeg", "LeftUpLeg" },
+            { "RightFoot", "RightLeg", "RightUpLeg" }
+        };
+        _limbs.clear();
+        for (int i = 0; i < NUM_LIMBS; i++) {
+            Limb limb;
+            limb.tipIndex = _skeleton->nameToJointIndex(limbNames[i][0]);
+            limb.midIndex = _skeleton->nameToJointIndex(limbNames[i][1]);
+            limb.baseIndex = _skeleton->nameToJointIndex(limbNames[i][2]);
+            if (limb.tipIndex != AnimSkeleton::INVALID_JOINT_INDEX && limb.baseIndex != AnimSkeleton::INVALID_JOINT_INDEX &&
+                _skeleton->getParentIndex(limb.baseIndex) != AnimSkeleton::INVALID_JOINT_INDEX) {
+                _limbs.push_back(limb);
+            }
+        }
     } else {
         clearConstraints();
         _headIndex = AnimSkeleton::INVALID_JOINT_INDEX;
@@ -1494,6 +1537,7 @@ void AnimInverseKinematics::setSkeletonInternal(AnimSkeleton::ConstPointer skele
         _hipsParentIndex = AnimSkeleton::INVALID_JOINT_INDEX;
         _leftHandIndex = AnimSkeleton::INVALID_JOINT_INDEX;
         _rightHandIndex = AnimSkeleton::INVALID_JOINT_INDEX;
+        _limbs.clear();
     }
 }
 
@@ -1725,27 +1769,54 @@ void AnimInverseKinematics::blendToPoses(const AnimPoseVec& targetPoses, const A
 }
 
 void AnimInverseKinematics::preconditionRelativePosesToAvoidLimbLock(const AnimContext& context, const std::vector<IKTarget>& targets) {
-    const int NUM_LIMBS = 4;
-    std::pair<int, int> limbs[NUM_LIMBS] = {
-        {_skeleton->nameToJointIndex("LeftHand"), _skeleton->nameToJointIndex("LeftArm")},
-        {_skeleton->nameToJointIndex("RightHand"), _skeleton->nameToJointIndex("RightArm")},
-        {_skeleton->nameToJointIndex("LeftFoot"), _skeleton->nameToJointIndex("LeftUpLeg")},
-        {_skeleton->nameToJointIndex("RightFoot"), _skeleton->nameToJointIndex("RightUpLeg")}
-    };
     const float MIN_AXIS_LENGTH = 1.0e-4f;
 
     for (auto& target : targets) {
         if (target.getIndex() != AnimSkeleton::INVALID_JOINT_INDEX && target.getType() == IKTarget::Type::RotationAndPosition) {
-            for (int i = 0; i < NUM_LIMBS; i++) {
-                if (limbs[i].first == target.getIndex()) {
-                    int tipIndex = limbs[i].first;
-                    int baseIndex = limbs[i].second;
+            for (const auto& limb : _limbs) {
+                if (limb.tipIndex == target.getIndex()) {
+                    int tipIndex = limb.tipIndex;
+                    int midIndex = limb.midIndex;
+                    int baseIndex = limb.baseIndex;
 
                     // TODO: as an optimization, these poses can be computed in one pass down the chain, instead of three.
                     AnimPose tipPose = _skeleton->getAbsolutePose(tipIndex, _relativePoses);
                     AnimPose basePose = _skeleton->getAbsolutePose(baseIndex, _relativePoses);
                     AnimPose baseParentPose = _skeleton->getAbsolutePose(_skeleton->getParentIndex(baseIndex), _relativePoses);
 
+                    // bend the elbow or knee so that the limb is as long as the distance to the target, as a two bone IK
+                    // would, then the CCD solver only has to refine it.  A straight limb has no bend plane and is left as is.
+                    if (midIndex != AnimSkeleton::INVALID_JOINT_INDEX && _skeleton->getParentIndex(tipIndex) == midIndex &&
+                        _skeleton->getParentIndex(midIndex) == baseIndex) {
+                        AnimPose midPose = basePose * _relativePoses[midIndex];
+                        glm::vec3 upperArm = basePose.trans() - midPose.trans();
+                        glm::vec3 lowerArm = tipPose.trans() - midPose.trans();
+                        float upperLength = glm::length(upperArm);
+                        float lowerLength = glm::length(lowerArm);
+                        glm::vec3 bendAxis = glm::cross(upperArm, lowerArm);
+                        float bendAxisLength = glm::length(bendAxis);
+                        const float MIN_BEND_SINE = 0.01f;
+                        if (bendAxisLength > MIN_BEND_SINE * upperLength * lowerLength) {
+                            bendAxis /= bendAxisLength;
+                            const float MIN_LIMB_REACH = 0.01f;
+                            float minReach = fabsf(upperLength - lowerLength) + MIN_LIMB_REACH * (upperLength + lowerLength);
+                            float maxReach = (1.0f - MIN_LIMB_REACH) * (upperLength + lowerLength);
+                            float reach = glm::clamp(glm::length(target.getTranslation() - basePose.trans()), minReach, maxReach);
+                            float cosBend = (upperLength * upperLength + lowerLength * lowerLength - reach * reach) / (2.0f * upperLength * lowerLength);
+                            float bendAngle = acosf(glm::clamp(cosBend, -1.0f, 1.0f));
+                            float currentBendAngle = acosf(glm::clamp(glm::dot(upperArm, lowerArm) / (upperLength * lowerLength), -1.0f, 1.0f));
+
+                            glm::quat newMidRelativeRotation = glm::inverse(basePose.rot()) *
+                                glm::angleAxis(bendAngle - currentBendAngle, bendAxis) * midPose.rot();
+                            RotationConstraint* constraint = getConstraint(midIndex);
+                            if (constraint) {
+                                constraint->apply(newMidRelativeRotation);
+                            }
+                            _relativePoses[midIndex].rot() = newMidRelativeRotation;
+                            tipPose = basePose * _relativePoses[midIndex] * _relativePoses[tipIndex];
+                        }
+                    }
+
                     // to help reduce limb locking, and to help the CCD solver converge faster
                     // rotate the limbs leverArm over the targetLine.
                     glm::vec3 targetLine = target.getTranslation() - basePose.trans();
@@ -165,19 +165,26 @@ protected:
         AnimInverseKinematics::IKTargetVar& operator=(const AnimInverseKinematics::IKTargetVar&) = default;
 
         QString jointName;
-        QString positionVar;
-        QString rotationVar;
-        QString typeVar;
-        QString weightVar;
-        QString poleVectorEnabledVar;
-        QString poleReferenceVectorVar;
-        QString poleVectorVar;
+        AnimVarKey positionVar;
+        AnimVarKey rotationVar;
+        AnimVarKey typeVar;
+        AnimVarKey weightVar;
+        AnimVarKey poleVectorEnabledVar;
+        AnimVarKey poleReferenceVectorVar;
+        AnimVarKey poleVectorVar;
         float weight;
         float flexCoefficients[MAX_FLEX_COEFFICIENTS];
         size_t numFlexCoefficients;
         int jointIndex; // cached joint index
     };
 
+    // an arm or a leg, with the elbow or knee at midIndex
+    struct Limb {
+        int tipIndex;
+        int midIndex;
+        int baseIndex;
+    };
+
     std::map<int, RotationConstraint*> _constraints;
     std::vector<RotationAccumulator> _rotationAccumulators;
     std::vector<TranslationAccumulator> _translationAccumulators;
@@ -185,6 +192,7 @@ protected:
     AnimPoseVec _defaultRelativePoses; // poses of the relaxed state
     AnimPoseVec _relativePoses; // current relative poses
     AnimPoseVec _limitCenterPoses;  // relative
+    AnimPoseVec _absolutePoses; // of the solve, kept to reuse its buffer every frame
     std::map<int, glm::quat> _rotationOnlyIKRotations;
 
     std::map<int, AnimPose> _secondaryTargetsInRigFrame;
@@ -197,11 +205,12 @@ protected:
     int _hipsTargetIndex { -1 };
     int _leftHandIndex { -1 };
     int _rightHandIndex { -1 };
+    std::vector<Limb> _limbs;
 
     float _maxErrorOnLastSolve { FLT_MAX };
     bool _previousEnableDebugIKTargets { false };
     SolutionSource _solutionSource { SolutionSource::RelaxToUnderPoses };
-    QString _solutionSourceVar;
+    AnimVarKey _solutionSourceVar;
 
     JointChainInfoVec _prevJointChainInfoVec;
 };
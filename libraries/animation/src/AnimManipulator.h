@@ -42,8 +42,8 @@ public:
         QString jointName = "";
         Type rotationType = Type::Absolute;
         Type translationType = Type::Absolute;
-        QString rotationVar = "";
-        QString translationVar = "";
+        AnimVarKey rotationVar;
+        AnimVarKey translationVar;
 
         int jointIndex = -1;
         bool hasPerformedJointLookup = false;
@@ -62,7 +62,7 @@ protected:
 
     AnimPoseVec _poses;
     float _alpha;
-    QString _alphaVar;
+    AnimVarKey _alphaVar;
 
     std::vector<JointVar> _jointVars;
 
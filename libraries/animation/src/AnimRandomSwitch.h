@@ -71,7 +71,7 @@ protected:
             friend AnimRandomSwitch;
             Transition(const QString& var, RandomSwitchState::Pointer randomState) : _var(var), _randomSwitchState(randomState) {}
         protected:
-            QString _var;
+            AnimVarKey _var;
             RandomSwitchState::Pointer _randomSwitchState;
         };
 
@@ -113,9 +113,9 @@ protected:
         float _priority {0.0f};
         bool _resume {false};
 
-        QString _interpTargetVar;
-        QString _interpDurationVar;
-        QString _interpTypeVar;
+        AnimVarKey _interpTargetVar;
+        AnimVarKey _interpDurationVar;
+        AnimVarKey _interpTypeVar;
 
         std::vector<Transition> _transitions;
 
@@ -167,9 +167,9 @@ protected:
     RandomSwitchState::Pointer _previousState;
     std::vector<RandomSwitchState::Pointer> _randomStates;
 
-    QString _currentStateVar;
-    QString _triggerRandomSwitchVar;
-    QString _transitionVar;
+    AnimVarKey _currentStateVar;
+    AnimVarKey _triggerRandomSwitchVar;
+    AnimVarKey _transitionVar;
     float _triggerTimeMin { 10.0f };
     float _triggerTimeMax { 20.0f };
     float _triggerTime { 0.0f };
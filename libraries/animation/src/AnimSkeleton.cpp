@@ -54,6 +54,62 @@ AnimSkeleton::AnimSkeleton(const HFMModel& hfmModel) {
             dummyClustersList.push_back(localCluster);
         }
         _clusterBindMatrixOriginalValues.push_back(dummyClustersList);
+
+        ClusterBindings bindings;
+        for (const auto& cluster : dummyClustersList) {
+            bindings.jointIndices.push_back(cluster.jointIndex);
+            bindings.inverseBindMatrices.push_back(cluster.inverseBindMatrix);
+            bindings.inverseBindScales.push_back(cluster.inverseBindTransform.getScale());
+            bindings.inverseBindRotations.push_back(cluster.inverseBindTransform.getRotation());
+            bindings.inverseBindTranslations.push_back(cluster.inverseBindTransform.getTranslation());
+        }
+        _clusterBindings.push_back(std::move(bindings));
+    }
+}
+
+void AnimSkeleton::computePoseMatrices(size_t numPoses, const AnimPose* poses, glm::mat4* matrices) {
+    for (size_t i = 0; i < numPoses; i++) {
+        matrices[i] = poses[i];
+    }
+}
+
+void AnimSkeleton::computeClusterMatrices(int meshIndex, size_t numJoints, const glm::mat4* jointMatrices,
+                                          glm::mat4* clusterMatrices) const {
+    static const glm::mat4 IDENTITY;
+    const ClusterBindings& bindings = _clusterBindings[meshIndex];
+    const int* jointIndices = bindings.jointIndices.data();
+    const glm::mat4* inverseBindMatrices = bindings.inverseBindMatrices.data();
+    for (size_t i = 0, numClusters = bindings.jointIndices.size(); i < numClusters; i++) {
+        int jointIndex = jointIndices[i];
+        const glm::mat4& jointMatrix = (jointIndex >= 0 && (size_t)jointIndex < numJoints) ? jointMatrices[jointIndex] : IDENTITY;
+        glm_mat4u_mul(jointMatrix, inverseBindMatrices[i], clusterMatrices[i]);
+    }
+}
+
+void AnimSkeleton::computeClusterPoses(int meshIndex, size_t numJoints, const AnimPose* jointPoses, AnimPose* clusterPoses) const {
+    const ClusterBindings& bindings = _clusterBindings[meshIndex];
+    for (size_t i = 0, numClusters = bindings.jointIndices.size(); i < numClusters; i++) {
+        int jointIndex = bindings.jointIndices[i];
+        const AnimPose& jointPose = (jointIndex >= 0 && (size_t)jointIndex < numJoints) ? jointPoses[jointIndex] : AnimPose::identity;
+        glm::vec3 jointScale = jointPose.scale();
+        if (jointScale.x != jointScale.y || jointScale.x != jointScale.z) {
+            // Transform::mult decomposes the rotations of the non-uniform scales
+            Transform jointTransform(jointPose.rot(), jointScale, jointPose.trans());
+            Transform clusterTransform;
+            Transform::mult(clusterTransform, jointTransform, _clusterBindMatrixOriginalValues[meshIndex][i].inverseBindTransform);
+            clusterPoses[i] = AnimPose(clusterTransform.getScale(), clusterTransform.getRotation(), clusterTransform.getTranslation());
+            continue;
+        }
+
+        // a uniform scale commutes with the rotations, so the product is that of Transform::mult without its decomposition
+        if (jointScale.x == 0.0f) {
+            jointScale = glm::vec3(1.0f);
+        }
+        const glm::vec3& inverseBindScale = bindings.inverseBindScales[i];
+        bool isValidInverseBindScale = inverseBindScale.x != 0.0f && inverseBindScale.y != 0.0f && inverseBindScale.z != 0.0f;
+        clusterPoses[i] = AnimPose(isValidInverseBindScale ? jointScale * inverseBindScale : jointScale,
+                                   jointPose.rot() * bindings.inverseBindRotations[i],
+                                   jointPose.trans() + jointPose.rot() * (jointScale * bindings.inverseBindTranslations[i]));
     }
 }
 
@@ -70,7 +70,23 @@ public:
     void dump(const AnimPoseVec& poses) const;
 
     std::vector<int> lookUpJointIndices(const std::vector<QString>& jointNames) const;
-    const HFMCluster getClusterBindMatricesOriginalValues(const int meshIndex, const int clusterIndex) const { return _clusterBindMatrixOriginalValues[meshIndex][clusterIndex]; }
+    const HFMCluster& getClusterBindMatricesOriginalValues(const int meshIndex, const int clusterIndex) const { return _clusterBindMatrixOriginalValues[meshIndex][clusterIndex]; }
+
+    // the clusters of a mesh, by field, for the cluster matrices of all the clusters to be computed in one pass
+    struct ClusterBindings {
+        std::vector<int> jointIndices;
+        std::vector<glm::mat4> inverseBindMatrices;
+        std::vector<glm::vec3> inverseBindScales;
+        std::vector<glm::quat> inverseBindRotations;
+        std::vector<glm::vec3> inverseBindTranslations;
+    };
+    const ClusterBindings& getClusterBindings(int meshIndex) const { return _clusterBindings[meshIndex]; }
+
+    static void computePoseMatrices(size_t numPoses, const AnimPose* poses, glm::mat4* matrices);
+    // the matrices of the clusters of a mesh, the matrices of their joints by their inverse bind matrices
+    void computeClusterMatrices(int meshIndex, size_t numJoints, const glm::mat4* jointMatrices, glm::mat4* clusterMatrices) const;
+    // the poses of the clusters of a mesh, the poses of their joints by their inverse bind transforms, as Transform::mult
+    void computeClusterPoses(int meshIndex, size_t numJoints, const AnimPose* jointPoses, AnimPose* clusterPoses) const;
 
 protected:
     void buildSkeletonFromJoints(const std::vector<HFMJoint>& joints, const QMap<int, glm::quat> jointOffsets);
@@ -87,6 +103,7 @@ protected:
     std::vector<int> _mirrorMap;
     QHash<QString, int> _jointIndicesByName;
     std::vector<std::vector<HFMCluster>> _clusterBindMatrixOriginalValues;
+    std::vector<ClusterBindings> _clusterBindings;
     glm::mat4 _geometryOffset;
 
     // no copies
@@ -119,17 +119,20 @@ const AnimPoseVec& AnimTwoBoneIK::evaluate(const AnimVariantMap& animVars, const
 
     // Look up end effector from animVars, make sure to convert into geom space.
     // First look in the triggers then look in the animVars, so we can follow output joints underneath us in the anim graph
+    // the names are interned once here rather than by each lookup
+    AnimVarKey endEffectorRotationKey(endEffectorRotationVar);
+    AnimVarKey endEffectorPositionKey(endEffectorPositionVar);
     AnimPose targetPose(tipPose);
-    if (triggersOut.hasKey(endEffectorRotationVar)) {
-        targetPose.rot() = triggersOut.lookupRigToGeometry(endEffectorRotationVar, tipPose.rot());
-    } else if (animVars.hasKey(endEffectorRotationVar)) {
-        targetPose.rot() = animVars.lookupRigToGeometry(endEffectorRotationVar, tipPose.rot());
+    if (triggersOut.hasKey(endEffectorRotationKey)) {
+        targetPose.rot() = triggersOut.lookupRigToGeometry(endEffectorRotationKey, tipPose.rot());
+    } else if (animVars.hasKey(endEffectorRotationKey)) {
+        targetPose.rot() = animVars.lookupRigToGeometry(endEffectorRotationKey, tipPose.rot());
     }
 
-    if (triggersOut.hasKey(endEffectorPositionVar)) {
-        targetPose.trans() = triggersOut.lookupRigToGeometry(endEffectorPositionVar, tipPose.trans());
-    } else if (animVars.hasKey(endEffectorPositionVar)) {
-        targetPose.trans() = animVars.lookupRigToGeometry(endEffectorPositionVar, tipPose.trans());
+    if (triggersOut.hasKey(endEffectorPositionKey)) {
+        targetPose.trans() = triggersOut.lookupRigToGeometry(endEffectorPositionKey, tipPose.trans());
+    } else if (animVars.hasKey(endEffectorPositionKey)) {
+        targetPose.trans() = animVars.lookupRigToGeometry(endEffectorPositionKey, tipPose.trans());
     }
 
     _prevEndEffectorRotationVar = endEffectorRotationVar;
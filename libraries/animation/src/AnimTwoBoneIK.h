@@ -59,10 +59,10 @@ protected:
     int _midJointIndex { -1 };
     int _tipJointIndex { -1 };
 
-    QString _alphaVar;  // float - (0, 1) 0 means underPoses only, 1 means IK only.
-    QString _enabledVar;  // bool
-    QString _endEffectorRotationVarVar; // string
-    QString _endEffectorPositionVarVar; // string
+    AnimVarKey _alphaVar;  // float - (0, 1) 0 means underPoses only, 1 means IK only.
+    AnimVarKey _enabledVar;  // bool
+    AnimVarKey _endEffectorRotationVarVar; // string
+    AnimVarKey _endEffectorPositionVarVar; // string
 
     QString _prevEndEffectorRotationVar;
     QString _prevEndEffectorPositionVar;
@@ -14,12 +14,60 @@
 #include "AnimVariant.h" // which has AnimVariant/AnimVariantMap
 
 #include <ScriptEngine.h>
+#include <QHash>
+#include <QReadWriteLock>
 #include <QThread>
 #include <ScriptValueIterator.h>
 #include <ScriptValueUtils.h>
 
 const AnimVariant AnimVariant::False = AnimVariant();
 
+namespace {
+
+// the names interned so far, the empty name first
+struct AnimVarKeys {
+    QReadWriteLock lock;
+    QHash<QString, int> indices;
+    std::vector<QString> names { QString() };
+};
+
+AnimVarKeys& getAnimVarKeys() {
+    static AnimVarKeys keys;
+    return keys;
+}
+
+}
+
+int AnimVarKey::intern(const QString& name) {
+    if (name.isEmpty()) {
+        return EMPTY_INDEX;
+    }
+    auto& keys = getAnimVarKeys();
+    {
+        QReadLocker locker(&keys.lock);
+        auto iter = keys.indices.constFind(name);
+        if (iter != keys.indices.constEnd()) {
+            return iter.value();
+        }
+    }
+    QWriteLocker locker(&keys.lock);
+    // another thread may have interned it in between
+    auto iter = keys.indices.constFind(name);
+    if (iter != keys.indices.constEnd()) {
+        return iter.value();
+    }
+    int index = (int)keys.names.size();
+    keys.names.push_back(name);
+    keys.indices.insert(name, index);
+    return index;
+}
+
+QString AnimVarKey::getName(int index) {
+    auto& keys = getAnimVarKeys();
+    QReadLocker locker(&keys.lock);
+    return index >= 0 && index < (int)keys.names.size() ? keys.names[index] : QString();
+}
+
 ScriptValue AnimVariantMap::animVariantMapToScriptValue(ScriptEngine* engine, const QStringList& names, bool useNames) const {
     if (QThread::currentThread() != engine->thread()) {
         qCWarning(animation) << "Cannot create Javacript object from non-script thread" << QThread::currentThread();
@@ -54,25 +102,23 @@ ScriptValue AnimVariantMap::animVariantMapToScriptValue(ScriptEngine* engine, co
     };
     if (useNames) { // copy only the requested names
         for (const QString& name : names) {
-            auto search = _map.find(name);
-            if (search != _map.end()) {
-                setOne(name, search->second);
-            } else if (_triggers.count(name) == 1) {
-                target.setProperty(name, true);
+            auto value = find(name);
+            if (value) {
+                setOne(name, *value);
             } // scripts are allowed to request names that do not exist
         }
 
     } else {  // copy all of them
-        for (auto& pair : _map) {
-            setOne(pair.first, pair.second);
-        }
+        forEach(setOne);
     }
     return target;
 }
 
 void AnimVariantMap::copyVariantsFrom(const AnimVariantMap& other) {
-    for (auto& pair : other._map) {
-        _map[pair.first] = pair.second;
+    for (int i = 0; i < (int)other._isSet.size(); i++) {
+        if (other._isSet[i]) {
+            setVariant(i, other._values[i]);
+        }
     }
 }
 
@@ -131,44 +177,44 @@ void AnimVariantMap::animVariantMapFromScriptValue(const ScriptValue& source) {
 
 std::map<QString, QString> AnimVariantMap::toDebugMap() const {
     std::map<QString, QString> result;
-    for (auto& pair : _map) {
-        switch (pair.second.getType()) {
+    forEach([&](const QString& name, const AnimVariant& value) {
+        switch (value.getType()) {
         case AnimVariant::Type::Bool:
-            result[pair.first] = QString("%1").arg(pair.second.getBool());
+            result[name] = QString("%1").arg(value.getBool());
             break;
         case AnimVariant::Type::Int:
-            result[pair.first] = QString("%1").arg(pair.second.getInt());
+            result[name] = QString("%1").arg(value.getInt());
             break;
         case AnimVariant::Type::Float:
-            result[pair.first] = QString::number(pair.second.getFloat(), 'f', 3);
+            result[name] = QString::number(value.getFloat(), 'f', 3);
             break;
         case AnimVariant::Type::Vec3: {
             // To prevent filling up debug stats, don't show vec3 values
-            glm::vec3 value = pair.second.getVec3();
-            result[pair.first] = QString("(%1, %2, %3)").
-                arg(QString::number(value.x, 'f', 3)).
-                arg(QString::number(value.y, 'f', 3)).
-                arg(QString::number(value.z, 'f', 3));
+            glm::vec3 vec3 = value.getVec3();
+            result[name] = QString("(%1, %2, %3)").
+                arg(QString::number(vec3.x, 'f', 3)).
+                arg(QString::number(vec3.y, 'f', 3)).
+                arg(QString::number(vec3.z, 'f', 3));
             break;
         }
         case AnimVariant::Type::Quat: {
             // To prevent filling up the anim stats, don't show quat values
-            glm::quat value = pair.second.getQuat();
-            result[pair.first] = QString("(%1, %2, %3, %4)").
-                arg(QString::number(value.x, 'f', 3)).
-                arg(QString::number(value.y, 'f', 3)).
-                arg(QString::number(value.z, 'f', 3)).
-                arg(QString::number(value.w, 'f', 3));
+            glm::quat quat = value.getQuat();
+            result[name] = QString("(%1, %2, %3, %4)").
+                arg(QString::number(quat.x, 'f', 3)).
+                arg(QString::number(quat.y, 'f', 3)).
+                arg(QString::number(quat.z, 'f', 3)).
+                arg(QString::number(quat.w, 'f', 3));
             break;
         }
         case AnimVariant::Type::String:
             // To prevent filling up anim stats, don't show string values
-            result[pair.first] = pair.second.getString();
+            result[name] = value.getString();
             break;
         default:
             // invalid AnimVariant::Type
             assert(false);
         }
-    }
+    });
     return result;
 }
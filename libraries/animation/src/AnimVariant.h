@@ -18,7 +18,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <map>
-#include <set>
+#include <vector>
 #include <StreamUtils.h>
 #include <GLMHelpers.h>
 #include "AnimationLogging.h"
@@ -118,118 +118,145 @@ protected:
     } _val;
 };
 
+/// The name of an anim var, interned once to an index by which the AnimVariantMaps keep their values.  The nodes
+/// intern the names of the vars they read as they're loaded, rather than the maps hashing them on every lookup.
+/// The names stay interned for the lifetime of the process.
+class AnimVarKey {
+public:
+    AnimVarKey() {}
+    AnimVarKey(const QString& name) : _index(intern(name)) {}
+    AnimVarKey(const char* name) : _index(intern(QString(name))) {}
+
+    bool isEmpty() const { return _index == EMPTY_INDEX; }
+    int getIndex() const { return _index; }
+    QString getName() const { return getName(_index); }
+
+    bool operator==(const AnimVarKey& other) const { return _index == other._index; }
+    bool operator!=(const AnimVarKey& other) const { return _index != other._index; }
+
+    static QString getName(int index);
+
+private:
+    // the empty name is interned first
+    static const int EMPTY_INDEX = 0;
+
+    static int intern(const QString& name);
+
+    int _index { EMPTY_INDEX };
+};
+
 class AnimVariantMap {
 public:
 
-    bool lookup(const QString& key, bool defaultValue) const {
-        // check triggers first, then map
+    bool lookup(const AnimVarKey& key, bool defaultValue) const {
         if (key.isEmpty()) {
             return defaultValue;
-        } else if (_triggers.find(key) != _triggers.end()) {
-            return true;
         } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getBool() : defaultValue;
+            auto value = find(key);
+            return value ? value->getBool() : defaultValue;
         }
     }
 
-    int lookup(const QString& key, int defaultValue) const {
+    int lookup(const AnimVarKey& key, int defaultValue) const {
         if (key.isEmpty()) {
             return defaultValue;
         } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getInt() : defaultValue;
+            auto value = find(key);
+            return value ? value->getInt() : defaultValue;
         }
     }
 
-    float lookup(const QString& key, float defaultValue) const {
+    float lookup(const AnimVarKey& key, float defaultValue) const {
         if (key.isEmpty()) {
             return defaultValue;
         } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getFloat() : defaultValue;
+            auto value = find(key);
+            return value ? value->getFloat() : defaultValue;
         }
     }
 
-    const glm::vec3& lookupRaw(const QString& key, const glm::vec3& defaultValue) const {
+    const glm::vec3& lookupRaw(const AnimVarKey& key, const glm::vec3& defaultValue) const {
         if (key.isEmpty()) {
             return defaultValue;
         } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getVec3() : defaultValue;
+            auto value = find(key);
+            return value ? value->getVec3() : defaultValue;
         }
     }
 
-    glm::vec3 lookupRigToGeometry(const QString& key, const glm::vec3& defaultValue) const {
+    glm::vec3 lookupRigToGeometry(const AnimVarKey& key, const glm::vec3& defaultValue) const {
         if (key.isEmpty()) {
             return defaultValue;
         } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? transformPoint(_rigToGeometryMat, iter->second.getVec3()) : defaultValue;
+            auto value = find(key);
+            return value ? transformPoint(_rigToGeometryMat, value->getVec3()) : defaultValue;
         }
     }
 
-    glm::vec3 lookupRigToGeometryVector(const QString& key, const glm::vec3& defaultValue) const {
+    glm::vec3 lookupRigToGeometryVector(const AnimVarKey& key, const glm::vec3& defaultValue) const {
         if (key.isEmpty()) {
             return defaultValue;
         } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? transformVectorFast(_rigToGeometryMat, iter->second.getVec3()) : defaultValue;
+            auto value = find(key);
+            return value ? transformVectorFast(_rigToGeometryMat, value->getVec3()) : defaultValue;
         }
     }
 
-    const glm::quat& lookupRaw(const QString& key, const glm::quat& defaultValue) const {
+    const glm::quat& lookupRaw(const AnimVarKey& key, const glm::quat& defaultValue) const {
         if (key.isEmpty()) {
             return defaultValue;
         } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getQuat() : defaultValue;
+            auto value = find(key);
+            return value ? value->getQuat() : defaultValue;
         }
     }
 
-    glm::quat lookupRigToGeometry(const QString& key, const glm::quat& defaultValue) const {
+    glm::quat lookupRigToGeometry(const AnimVarKey& key, const glm::quat& defaultValue) const {
         if (key.isEmpty()) {
             return defaultValue;
         } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? _rigToGeometryRot * iter->second.getQuat() : defaultValue;
+            auto value = find(key);
+            return value ? _rigToGeometryRot * value->getQuat() : defaultValue;
         }
     }
 
-    const QString& lookup(const QString& key, const QString& defaultValue) const {
+    const QString& lookup(const AnimVarKey& key, const QString& defaultValue) const {
         if (key.isEmpty()) {
             return defaultValue;
         } else {
-            auto iter = _map.find(key);
-            return iter != _map.end() ? iter->second.getString() : defaultValue;
+            auto value = find(key);
+            return value ? value->getString() : defaultValue;
         }
     }
 
-    void set(const QString& key, bool value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, int value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, float value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const glm::vec3& value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const glm::quat& value) { _map[key] = AnimVariant(value); }
-    void set(const QString& key, const QString& value) { _map[key] = AnimVariant(value); }
-    void unset(const QString& key) { _map.erase(key); }
+    void set(const AnimVarKey& key, bool value) { setVariant(key.getIndex(), AnimVariant(value)); }
+    void set(const AnimVarKey& key, int value) { setVariant(key.getIndex(), AnimVariant(value)); }
+    void set(const AnimVarKey& key, float value) { setVariant(key.getIndex(), AnimVariant(value)); }
+    void set(const AnimVarKey& key, const glm::vec3& value) { setVariant(key.getIndex(), AnimVariant(value)); }
+    void set(const AnimVarKey& key, const glm::quat& value) { setVariant(key.getIndex(), AnimVariant(value)); }
+    void set(const AnimVarKey& key, const QString& value) { setVariant(key.getIndex(), AnimVariant(value)); }
+    void unset(const AnimVarKey& key) {
+        int index = key.getIndex();
+        if (index < (int)_isSet.size() && _isSet[index]) {
+            _isSet[index] = false;
+            _values[index] = AnimVariant();
+            _numSet--;
+        }
+    }
 
-    void setTrigger(const QString& key) { _map[key] = AnimVariant(true); }
+    void setTrigger(const AnimVarKey& key) { setVariant(key.getIndex(), AnimVariant(true)); }
 
     void setRigToGeometryTransform(const glm::mat4& rigToGeometry) {
         _rigToGeometryMat = rigToGeometry;
         _rigToGeometryRot = glmExtractRotation(rigToGeometry);
     }
 
-    void clearMap() { _map.clear(); _triggers.clear(); }
-    bool hasKey(const QString& key) const { return _map.find(key) != _map.end(); }
+    void clearMap() { _values.clear(); _isSet.clear(); _numSet = 0; }
+    bool hasKey(const AnimVarKey& key) const { return find(key) != nullptr; }
 
-    const AnimVariant& get(const QString& key) const {
-        auto iter = _map.find(key);
-        if (iter != _map.end()) {
-            return iter->second;
-        } else {
-            return AnimVariant::False;
-        }
+    const AnimVariant& get(const AnimVarKey& key) const {
+        auto value = find(key);
+        return value ? *value : AnimVariant::False;
     }
 
     // Answer a Plain Old Javascript Object (for the given engine) all of our values set as properties.
@@ -241,39 +268,70 @@ public:
     // For stat debugging.
     std::map<QString, QString> toDebugMap() const;
 
+    int size() const { return _numSet; }
+
+    // Calls f with the name and value of every var set, in the order their names were interned
+    template <typename F>
+    void forEach(F f) const {
+        for (int i = 0; i < (int)_isSet.size(); i++) {
+            if (_isSet[i]) {
+                f(AnimVarKey::getName(i), _values[i]);
+            }
+        }
+    }
+
 #ifndef NDEBUG
     void dump() const {
         qCDebug(animation) << "AnimVariantMap =";
-        for (auto& pair : _map) {
-            switch (pair.second.getType()) {
+        forEach([](const QString& name, const AnimVariant& value) {
+            switch (value.getType()) {
             case AnimVariant::Type::Bool:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getBool();
+                qCDebug(animation) << "    " << name << "=" << value.getBool();
                 break;
             case AnimVariant::Type::Int:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getInt();
+                qCDebug(animation) << "    " << name << "=" << value.getInt();
                 break;
             case AnimVariant::Type::Float:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getFloat();
+                qCDebug(animation) << "    " << name << "=" << value.getFloat();
                 break;
             case AnimVariant::Type::Vec3:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getVec3();
+                qCDebug(animation) << "    " << name << "=" << value.getVec3();
                 break;
             case AnimVariant::Type::Quat:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getQuat();
+                qCDebug(animation) << "    " << name << "=" << value.getQuat();
                 break;
             case AnimVariant::Type::String:
-                qCDebug(animation) << "    " << pair.first << "=" << pair.second.getString();
+                qCDebug(animation) << "    " << name << "=" << value.getString();
                 break;
             default:
                 assert(false);
             }
-        }
+        });
     }
 #endif
 
 protected:
-    std::map<QString, AnimVariant> _map;
-    std::set<QString> _triggers;
+    const AnimVariant* find(const AnimVarKey& key) const {
+        int index = key.getIndex();
+        return index < (int)_isSet.size() && _isSet[index] ? &_values[index] : nullptr;
+    }
+
+    void setVariant(int index, const AnimVariant& value) {
+        if (index >= (int)_isSet.size()) {
+            _values.resize(index + 1);
+            _isSet.resize(index + 1, false);
+        }
+        if (!_isSet[index]) {
+            _isSet[index] = true;
+            _numSet++;
+        }
+        _values[index] = value;
+    }
+
+    // indexed by the keys, dense as there are few names interned
+    std::vector<AnimVariant> _values;
+    std::vector<bool> _isSet;
+    int _numSet { 0 };
     glm::mat4 _rigToGeometryMat;
     glm::quat _rigToGeometryRot;
 };
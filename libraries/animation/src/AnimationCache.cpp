@@ -36,6 +36,24 @@ AnimationPointer AnimationCache::getAnimation(const QUrl& url) {
     return getResource(url).staticCast<Animation>();
 }
 
+std::shared_ptr<const AnimClipData> AnimationCache::getClipData(const QString& key) {
+    QMutexLocker locker(&_clipDataMutex);
+    return _clipData.value(key).lock();
+}
+
+void AnimationCache::addClipData(const QString& key, const std::shared_ptr<const AnimClipData>& clipData) {
+    QMutexLocker locker(&_clipDataMutex);
+    // forget the clips no AnimClip plays anymore
+    for (auto it = _clipData.begin(); it != _clipData.end();) {
+        if (it.value().expired()) {
+            it = _clipData.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    _clipData[key] = clipData;
+}
+
 QSharedPointer<Resource> AnimationCache::createResource(const QUrl& url) {
     return QSharedPointer<Animation>(new Animation(url), &Resource::deleter);
 }
@@ -14,6 +14,10 @@
 #ifndef hifi_AnimationCache_h
 #define hifi_AnimationCache_h
 
+#include <memory>
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
 #include <QtCore/QRunnable>
 #include <QtCore/QSharedPointer>
 
@@ -22,6 +26,7 @@
 #include <ResourceCache.h>
 
 class Animation;
+class AnimClipData;
 
 using AnimationPointer = QSharedPointer<Animation>;
 
@@ -34,6 +39,11 @@ public:
     Q_INVOKABLE AnimationPointer getAnimation(const QString& url) { return getAnimation(QUrl(url)); }
     Q_INVOKABLE AnimationPointer getAnimation(const QUrl& url);
 
+    /// Returns the retargeted clip added under key, if an AnimClip still plays it.  The clips are keyed by their animation
+    /// and the skeleton they're retargeted to, so all the avatars with the same skeleton share them.
+    std::shared_ptr<const AnimClipData> getClipData(const QString& key);
+    void addClipData(const QString& key, const std::shared_ptr<const AnimClipData>& clipData);
+
 protected:
     virtual QSharedPointer<Resource> createResource(const QUrl& url) override;
     QSharedPointer<Resource> createResourceCopy(const QSharedPointer<Resource>& resource) override;
@@ -42,6 +52,8 @@ private:
     explicit AnimationCache(QObject* parent = NULL);
     virtual ~AnimationCache() { }
 
+    QMutex _clipDataMutex;
+    QHash<QString, std::weak_ptr<const AnimClipData>> _clipData;
 };
 
 Q_DECLARE_METATYPE(AnimationPointer)
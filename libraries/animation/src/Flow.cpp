@@ -118,54 +118,87 @@ void FlowCollisionSystem::setScale(float scale) {
     }
 };
 
-std::vector<FlowCollisionResult> FlowCollisionSystem::checkFlowThreadCollisions(FlowThread* flowThread) {
-    std::vector<std::vector<FlowCollisionResult>> FlowThreadResults;
-    FlowThreadResults.resize(flowThread->_joints.size());
-    for (size_t j = 0; j < _allCollisions.size(); j++) {
+void FlowCollisionSystem::addCollision(size_t jointIndex, const FlowCollisionResult& collision, std::vector<FlowCollisionResult>& results) {
+    FlowCollisionResult& sum = _collisionSums[jointIndex];
+    if (sum._count == 0) {
+        // a joint with a single collision takes it as is
+        results[jointIndex] = collision;
+    }
+    sum._count++;
+    sum._offset += collision._offset;
+    sum._normal = sum._normal + collision._normal * collision._distance;
+    sum._position = sum._position + collision._position;
+    sum._radius += collision._radius;
+    sum._distance += collision._distance;
+}
+
+void FlowCollisionSystem::checkFlowThreadCollisions(const FlowThread& flowThread, std::vector<FlowCollisionResult>& results) {
+    const size_t numJoints = flowThread._joints.size();
+    results.assign(numJoints, FlowCollisionResult());
+    _collisionSums.assign(numJoints, FlowCollisionResult());
+
+    // the spheres farther from the root than the length of the thread can't touch it
+    const size_t numSpheres = _allCollisions.size();
+    const glm::vec3 root = flowThread._positions[0];
+    for (size_t j = 0; j < numSpheres; j++) {
+        float x = _sphereX[j] - root.x;
+        float y = _sphereY[j] - root.y;
+        float z = _sphereZ[j] - root.z;
+        _sphereDistances2[j] = x * x + y * y + z * z;
+    }
+
+    for (size_t j = 0; j < numSpheres; j++) {
+        float reach = flowThread._length + flowThread._radius + _sphereReach[j];
+        if (_sphereDistances2[j] > reach * reach) {
+            continue;
+        }
         FlowCollisionSphere &sphere = _allCollisions[j];
-        FlowCollisionResult rootCollision = sphere.computeSphereCollision(flowThread->_positions[0], flowThread->_radius);
-        std::vector<FlowCollisionResult> collisionData = { rootCollision };
-        bool tooFar = rootCollision._distance >(flowThread->_length + rootCollision._radius);
-        FlowCollisionResult nextCollision;
-        if (!tooFar) {
-            if (sphere._isTouch) {
-                for (size_t i = 1; i < flowThread->_joints.size(); i++) {
-                    auto prevCollision = collisionData[i - 1];
-                    nextCollision = _allCollisions[j].computeSphereCollision(flowThread->_positions[i], flowThread->_radius);
-                    collisionData.push_back(nextCollision);
-                    if (prevCollision._offset > 0.0f) {
-                        if (i == 1) {
-                            FlowThreadResults[i - 1].push_back(prevCollision);
-                        }
-                    } else if (nextCollision._offset > 0.0f) {
-                        FlowThreadResults[i].push_back(nextCollision);
-                    } else {
-                        FlowCollisionResult segmentCollision = _allCollisions[j].checkSegmentCollision(flowThread->_positions[i - 1], flowThread->_positions[i], prevCollision, nextCollision);
-                        if (segmentCollision._offset > 0) {
-                            FlowThreadResults[i - 1].push_back(segmentCollision);
-                            FlowThreadResults[i].push_back(segmentCollision);
-                        }
+        FlowCollisionResult rootCollision = sphere.computeSphereCollision(flowThread._positions[0], flowThread._radius);
+        if (sphere._isTouch) {
+            FlowCollisionResult prevCollision = rootCollision;
+            for (size_t i = 1; i < numJoints; i++) {
+                FlowCollisionResult nextCollision = sphere.computeSphereCollision(flowThread._positions[i], flowThread._radius);
+                if (prevCollision._offset > 0.0f) {
+                    if (i == 1) {
+                        addCollision(i - 1, prevCollision, results);
                     }
-                }
-            } else {
-                if (rootCollision._offset > 0.0f) {
-                    FlowThreadResults[0].push_back(rootCollision);
-                }
-                for (size_t i = 1; i < flowThread->_joints.size(); i++) {
-                    nextCollision = _allCollisions[j].computeSphereCollision(flowThread->_positions[i], flowThread->_radius);
-                    if (nextCollision._offset > 0.0f) {
-                        FlowThreadResults[i].push_back(nextCollision);
+                } else if (nextCollision._offset > 0.0f) {
+                    addCollision(i, nextCollision, results);
+                } else {
+                    FlowCollisionResult segmentCollision = sphere.checkSegmentCollision(flowThread._positions[i - 1], flowThread._positions[i], prevCollision, nextCollision);
+                    if (segmentCollision._offset > 0) {
+                        addCollision(i - 1, segmentCollision, results);
+                        addCollision(i, segmentCollision, results);
                     }
                 }
+                prevCollision = nextCollision;
+            }
+        } else {
+            if (rootCollision._offset > 0.0f) {
+                addCollision(0, rootCollision, results);
+            }
+            for (size_t i = 1; i < numJoints; i++) {
+                FlowCollisionResult nextCollision = sphere.computeSphereCollision(flowThread._positions[i], flowThread._radius);
+                if (nextCollision._offset > 0.0f) {
+                    addCollision(i, nextCollision, results);
+                }
             }
         }
     }
 
-    std::vector<FlowCollisionResult> results;
-    for (size_t i = 0; i < flowThread->_joints.size(); i++) {
-        results.push_back(computeCollision(FlowThreadResults[i]));
+    // the joints with several collisions take their average, as computeCollision
+    for (size_t i = 0; i < numJoints; i++) {
+        const FlowCollisionResult& sum = _collisionSums[i];
+        if (sum._count > 1) {
+            FlowCollisionResult& result = results[i];
+            result._offset = sum._offset / sum._count;
+            result._radius = 0.5f * glm::length(sum._normal);
+            result._normal = glm::normalize(sum._normal);
+            result._position = sum._position / (float)sum._count;
+            result._distance = sum._distance / sum._count;
+        }
+        results[i]._count = sum._count;
     }
-    return results;
 };
 
 FlowCollisionSettings FlowCollisionSystem::getCollisionSettingsByJoint(int jointIndex) {
@@ -192,6 +225,20 @@ void FlowCollisionSystem::prepareCollisions() {
     _allCollisions.insert(_allCollisions.end(), _othersCollisions.begin(), _othersCollisions.end());
     _allCollisions.insert(_allCollisions.end(), _selfTouchCollisions.begin(), _selfTouchCollisions.end());
     _othersCollisions.clear();
+
+    const size_t numSpheres = _allCollisions.size();
+    _sphereX.resize(numSpheres);
+    _sphereY.resize(numSpheres);
+    _sphereZ.resize(numSpheres);
+    _sphereReach.resize(numSpheres);
+    _sphereDistances2.resize(numSpheres);
+    for (size_t j = 0; j < numSpheres; j++) {
+        const FlowCollisionSphere& sphere = _allCollisions[j];
+        _sphereX[j] = sphere._position.x;
+        _sphereY[j] = sphere._position.y;
+        _sphereZ[j] = sphere._position.z;
+        _sphereReach[j] = sphere._radius;
+    }
 }
 
 FlowNode::FlowNode(const glm::vec3& initialPosition, FlowPhysicsSettings settings) {
@@ -360,40 +407,40 @@ void FlowThread::computeFlowThread(int rootIndex) {
 };
 
 void FlowThread::computeRecovery() {
-    int parentIndex = _joints[0];
-    auto parentJoint = _jointsPointer->at(parentIndex);
-    _jointsPointer->at(parentIndex)._recoveryPosition = parentJoint._recoveryPosition = parentJoint._currentPosition;
+    FlowJoint* parentJoint = _jointPointers[0];
+    parentJoint->_recoveryPosition = parentJoint->_currentPosition;
     for (size_t i = 1; i < _joints.size(); i++) {
-        glm::quat parentRotation = parentJoint._parentWorldRotation * parentJoint._initialRotation;
-        auto joint = _jointsPointer->at(_joints[i]);
-        _jointsPointer->at(_joints[i])._recoveryPosition = joint._recoveryPosition = parentJoint._recoveryPosition + (parentRotation * (joint._initialTranslation * _rigScale));
+        glm::quat parentRotation = parentJoint->_parentWorldRotation * parentJoint->_initialRotation;
+        FlowJoint* joint = _jointPointers[i];
+        joint->_recoveryPosition = parentJoint->_recoveryPosition + (parentRotation * (joint->_initialTranslation * _rigScale));
         parentJoint = joint;
     }
 };
 
 void FlowThread::update(float deltaTime) {
-    _positions.clear();
-    auto &firstJoint = _jointsPointer->at(_joints[0]);
-    _radius = firstJoint._settings._radius;
+    _jointPointers.resize(_joints.size());
+    for (size_t i = 0; i < _joints.size(); i++) {
+        _jointPointers[i] = &_jointsPointer->at(_joints[i]);
+    }
+    _positions.resize(_joints.size());
+    _radius = _jointPointers[0]->_settings._radius;
     computeRecovery();
     for (size_t i = 0; i < _joints.size(); i++) {
-        auto &joint = _jointsPointer->at(_joints[i]);
+        auto &joint = *_jointPointers[i];
         joint.update(deltaTime);
-        _positions.push_back(joint._currentPosition);
+        _positions[i] = joint._currentPosition;
     }
 };
 
 void FlowThread::solve(FlowCollisionSystem& collisionSystem) {
     if (collisionSystem.getActive()) {
-        auto bodyCollisions = collisionSystem.checkFlowThreadCollisions(this);
+        collisionSystem.checkFlowThreadCollisions(*this, _collisionResults);
         for (size_t i = 0; i < _joints.size(); i++) {
-            int index = _joints[i];
-            _jointsPointer->at(index).solve(bodyCollisions[i]);
+            _jointPointers[i]->solve(_collisionResults[i]);
         }
     } else {
         for (size_t i = 0; i < _joints.size(); i++) {
-            int index = _joints[i];
-            _jointsPointer->at(index).solve(FlowCollisionResult());
+            _jointPointers[i]->solve(FlowCollisionResult());
         }
     }
 };
@@ -403,33 +450,35 @@ void FlowThread::computeJointRotations() {
     auto pos0 = _rootFramePositions[0];
     auto pos1 = _rootFramePositions[1];
 
-    auto joint0 = _jointsPointer->at(_joints[0]);
-    auto joint1 = _jointsPointer->at(_joints[1]);
+    FlowJoint* joint0 = _jointPointers[0];
+    FlowJoint* joint1 = _jointPointers[1];
 
-    auto initial_pos1 = pos0 + (joint0._initialRotation * (joint1._initialTranslation * _rigScale));
+    auto initial_pos1 = pos0 + (joint0->_initialRotation * (joint1->_initialTranslation * _rigScale));
 
     auto vec0 = initial_pos1 - pos0;
     auto vec1 = pos1 - pos0;
 
     auto delta = rotationBetween(vec0, vec1);
 
-    joint0._currentRotation = _jointsPointer->at(_joints[0])._currentRotation = delta * joint0._initialRotation;
+    joint0->_currentRotation = delta * joint0->_initialRotation;
     
     for (size_t i = 1; i < _joints.size() - 1; i++) {
-        auto nextJoint = _jointsPointer->at(_joints[i + 1]);
+        FlowJoint* nextJoint = _jointPointers[i + 1];
+        glm::quat inverseRotation = glm::inverse(joint0->_currentRotation);
+        glm::vec3 translation = joint0->_initialTranslation * _rigScale;
         for (size_t j = i; j < _joints.size(); j++) {
-            _rootFramePositions[j] = glm::inverse(joint0._currentRotation) * _rootFramePositions[j] - (joint0._initialTranslation * _rigScale);
+            _rootFramePositions[j] = inverseRotation * _rootFramePositions[j] - translation;
         }
         pos0 = _rootFramePositions[i];
         pos1 = _rootFramePositions[i + 1];
-        initial_pos1 = pos0 + joint1._initialRotation * (nextJoint._initialTranslation * _rigScale);
+        initial_pos1 = pos0 + joint1->_initialRotation * (nextJoint->_initialTranslation * _rigScale);
 
         vec0 = initial_pos1 - pos0;
         vec1 = pos1 - pos0;
 
         delta = rotationBetween(vec0, vec1);
 
-        joint1._currentRotation = _jointsPointer->at(joint1._index)._currentRotation = delta * joint1._initialRotation;
+        joint1->_currentRotation = delta * joint1->_initialRotation;
         joint0 = joint1;
         joint1 = nextJoint;
     }
@@ -137,7 +137,8 @@ public:
     void addCollisionSphere(int jointIndex, const FlowCollisionSettings& settings, const glm::vec3& position = { 0.0f, 0.0f, 0.0f }, bool isSelfCollision = true, bool isTouch = false);
     FlowCollisionResult computeCollision(const std::vector<FlowCollisionResult> collisions);
 
-    std::vector<FlowCollisionResult> checkFlowThreadCollisions(FlowThread* flowThread);
+    // fills results with the collision of each joint of flowThread, reusing the buffers of the previous threads
+    void checkFlowThreadCollisions(const FlowThread& flowThread, std::vector<FlowCollisionResult>& results);
 
     std::vector<FlowCollisionSphere>& getSelfCollisions() { return _selfCollisions; };
     std::vector<FlowCollisionSphere>& getSelfTouchCollisions() { return _selfTouchCollisions; };
@@ -153,10 +154,20 @@ public:
     const std::vector<FlowCollisionSphere>& getCollisions() const { return _selfCollisions; }
     void clearSelfCollisions() { _selfCollisions.clear(); }
 protected:
+    void addCollision(size_t jointIndex, const FlowCollisionResult& collision, std::vector<FlowCollisionResult>& results);
+
     std::vector<FlowCollisionSphere> _selfCollisions;
     std::vector<FlowCollisionSphere> _othersCollisions;
     std::vector<FlowCollisionSphere> _selfTouchCollisions;
     std::vector<FlowCollisionSphere> _allCollisions;
+    // the centers and radii of _allCollisions by component, so that a thread culls them all in one vectorized loop
+    std::vector<float> _sphereX;
+    std::vector<float> _sphereY;
+    std::vector<float> _sphereZ;
+    std::vector<float> _sphereReach;
+    std::vector<float> _sphereDistances2;
+    // the sums of the collisions of each joint of the thread being checked
+    std::vector<FlowCollisionResult> _collisionSums;
     float _scale { 1.0f };
     bool _active { false };
 };
@@ -282,6 +293,11 @@ public:
     float _rigScale { 100.0f };
     std::map<int, FlowJoint>* _jointsPointer;
     std::vector<glm::vec3> _rootFramePositions;
+
+private:
+    // the joints of _joints, looked up once per update for solve and computeJointRotations
+    std::vector<FlowJoint*> _jointPointers;
+    std::vector<FlowCollisionResult> _collisionResults;
 };
 
 class Flow : public QObject{
@@ -1697,7 +1697,7 @@ void Rig::updateAnimationStateHandlers() { // called on avatar update thread (wh
         // Note: the behavior is undefined if a handler (re-)sets a trigger. Scripts should not be doing that.
 
         // V8TODO: This causes a deadlock right now, and in any case will cause stutters. Probably should be done on script thread instead
-        _animVars.copyVariantsFrom(value.results); // If multiple handlers write the same anim var, the last registered wins. (_map preserves order).
+        _animVars.copyVariantsFrom(value.results); // If multiple handlers write the same anim var, the last registered wins. (copyVariantsFrom applies them in order).
     }
 }
 
@@ -69,6 +69,8 @@ static const int CHECK_INPUT_READS_MSECS = 2000;
 static const int MIN_READS_TO_CONSIDER_INPUT_ALIVE = 10;
 #endif
 
+static const float MIN_INPUT_BUFFER_MSECS = 2.5f;
+
 const AudioClient::AudioPositionGetter  AudioClient::DEFAULT_POSITION_GETTER = []{ return Vectors::ZERO; };
 const AudioClient::AudioOrientationGetter AudioClient::DEFAULT_ORIENTATION_GETTER = [] { return Quaternions::IDENTITY; };
 
@@ -76,6 +78,8 @@ Setting::Handle<bool> dynamicJitterBufferEnabled("dynamicJitterBuffersEnabled",
     InboundAudioStream::DEFAULT_DYNAMIC_JITTER_BUFFER_ENABLED);
 Setting::Handle<int> staticJitterBufferFrames("staticJitterBufferFrames",
     InboundAudioStream::DEFAULT_STATIC_JITTER_FRAMES);
+Setting::Handle<float> jitterLateLossPercent("jitterLateLossPercent",
+    InboundAudioStream::DEFAULT_JITTER_LATE_LOSS_TARGET * 100.0f);
 
 // protect the Qt internal device list
 using Mutex = std::mutex;
@@ -316,7 +320,7 @@ static inline float convertToFloat(int16_t sample) {
 AudioClient::AudioClient() {
 
     // avoid putting a lock in the device callback
-    assert(_localSamplesAvailable.is_lock_free());
+    assert(LocalInjectorsStream::isLockFree());
 
     // deprecate legacy settings
     {
@@ -1407,14 +1411,17 @@ void AudioClient::handleAudioInput(QByteArray& audioBuffer) {
         audioTransform.setTranslation(_positionGetter());
         audioTransform.setRotation(_orientationGetter());
 
-        QByteArray encodedBuffer;
+        const char* encodedData = audioBuffer.constData();
+        int encodedSize = audioBuffer.size();
         if (_encoder) {
-            _encoder->encode(audioBuffer, encodedBuffer);
-        } else {
-            encodedBuffer = audioBuffer;
+            // no codec needs more than the uncompressed frame
+            _encodedAudioBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+            encodedSize = std::max(_encoder->encodeInto(audioBuffer.constData(), audioBuffer.size(),
+                                                        _encodedAudioBuffer.data(), _encodedAudioBuffer.size()), 0);
+            encodedData = _encodedAudioBuffer.constData();
         }
 
-        emitAudioPacket(encodedBuffer.data(), encodedBuffer.size(), _outgoingAvatarAudioSequenceNumber, _isStereoInput,
+        emitAudioPacket(encodedData, encodedSize, _outgoingAvatarAudioSequenceNumber, _isStereoInput,
                         audioTransform, avatarBoundingBoxCorner, avatarBoundingBoxScale,
                         packetType, _selectedCodecName);
         _stats.sentPacket();
@@ -1435,14 +1442,24 @@ void AudioClient::handleMicAudioInput() {
                                       _inputToNetworkResampler->getMinInput(AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL) :
                                       AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL) * _inputFormat.channelCount();
 
-    const auto inputAudioSamples = std::unique_ptr<int16_t[]>(new int16_t[inputSamplesRequired]);
-    QByteArray inputByteArray = _inputDevice->readAll();
+    quint64 now = usecTimestampNow();
+    checkInputDropouts(now);
+    _lastInputCallbackUsecs = now;
+
+    // the buffers were reserved in allocateInputBuffers(), so resizing within them doesn't allocate
+    _inputAudioSamples.resize(inputSamplesRequired);
+    qint64 bytesAvailable = std::max(_inputDevice->bytesAvailable(), (qint64)_inputReadBuffer.capacity());
+    _inputReadBuffer.resize((int)bytesAvailable);
+    qint64 bytesRead = _inputDevice->read(_inputReadBuffer.data(), bytesAvailable);
+    _inputReadBuffer.resize((int)std::max(bytesRead, (qint64)0));
+    QByteArray& inputByteArray = _inputReadBuffer;
 
     handleLocalEchoAndReverb(inputByteArray);
 
     _inputRingBuffer.writeData(inputByteArray.data(), inputByteArray.size());
 
-    float audioInputMsecsRead = inputByteArray.size() / (float)(_inputFormat.bytesForDuration(USECS_PER_MSEC));
+    const float bytesPerMsec = (float)_inputFormat.bytesForDuration(USECS_PER_MSEC);
+    float audioInputMsecsRead = inputByteArray.size() / bytesPerMsec;
     _stats.updateInputMsRead(audioInputMsecsRead);
 
     const int numNetworkBytes = _isStereoInput
@@ -1452,14 +1469,14 @@ void AudioClient::handleMicAudioInput() {
         ? AudioConstants::NETWORK_FRAME_SAMPLES_STEREO
         : AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
 
-    static int16_t networkAudioSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    _networkAudioBuffer.resize(numNetworkBytes);
 
     while (_inputRingBuffer.samplesAvailable() >= inputSamplesRequired) {
-
-        _inputRingBuffer.readSamples(inputAudioSamples.get(), inputSamplesRequired);
+        int16_t* inputAudioSamples = _inputAudioSamples.data();
+        _inputRingBuffer.readSamples(inputAudioSamples, inputSamplesRequired);
 
         // detect clipping on the raw input
-        bool isClipping = detectClipping(inputAudioSamples.get(), inputSamplesRequired, _inputFormat.channelCount());
+        bool isClipping = detectClipping(inputAudioSamples, inputSamplesRequired, _inputFormat.channelCount());
         if (isClipping) {
             _timeSinceLastClip = 0.0f;
         } else if (_timeSinceLastClip >= 0.0f) {
@@ -1469,12 +1486,12 @@ void AudioClient::handleMicAudioInput() {
 
 #if defined(WEBRTC_AUDIO)
         if (_isAECEnabled) {
-            processWebrtcNearEnd(inputAudioSamples.get(), inputSamplesRequired / _inputFormat.channelCount(),
+            processWebrtcNearEnd(inputAudioSamples, inputSamplesRequired / _inputFormat.channelCount(),
                                  _inputFormat.channelCount(), _inputFormat.sampleRate());
         }
 #endif
 
-        float loudness = computeLoudness(inputAudioSamples.get(), inputSamplesRequired);
+        float loudness = computeLoudness(inputAudioSamples, inputSamplesRequired);
         _lastRawInputLoudness = loudness;
 
         // envelope detection
@@ -1485,20 +1502,119 @@ void AudioClient::handleMicAudioInput() {
         emit inputLoudnessChanged(_lastSmoothedRawInputLoudness, isClipping);
 
         if (!_isMuted) {
+            // a frame still shared with an inputReceived() listener detaches here
+            int16_t* networkAudioSamples = reinterpret_cast<int16_t*>(_networkAudioBuffer.data());
             possibleResampling(_inputToNetworkResampler,
-                inputAudioSamples.get(), networkAudioSamples,
+                inputAudioSamples, networkAudioSamples,
                 inputSamplesRequired, numNetworkSamples,
                 _inputFormat.channelCount(), _desiredInputFormat.channelCount());
         }
         int bytesInInputRingBuffer = _inputRingBuffer.samplesAvailable() * AudioConstants::SAMPLE_SIZE;
-        float msecsInInputRingBuffer = bytesInInputRingBuffer / (float)(_inputFormat.bytesForDuration(USECS_PER_MSEC));
+        float msecsInInputRingBuffer = bytesInInputRingBuffer / bytesPerMsec;
         _stats.updateInputMsUnplayed(msecsInInputRingBuffer);
 
-        QByteArray audioBuffer(reinterpret_cast<char*>(networkAudioSamples), numNetworkBytes);
-        handleAudioInput(audioBuffer);
+        // the oldest sample in this frame waited in the device buffer, then behind the rest of the frame
+        // and the samples still in the ring buffer
+        float msecsInInputBuffer = _inputBufferBytes / bytesPerMsec;
+        _stats.updateInputLatencyMs(msecsInInputBuffer + msecsInInputRingBuffer + AudioConstants::NETWORK_FRAME_MSECS);
+
+        handleAudioInput(_networkAudioBuffer);
+    }
+}
+
+void AudioClient::allocateInputBuffers() {
+    // enough for a few callbacks, in case this thread was held up
+    const int CALLBACKS_PER_READ = 4;
+    _inputReadBuffer.clear();
+    _inputReadBuffer.reserve(std::max(_numInputCallbackBytes, (int)AudioConstants::NETWORK_FRAME_BYTES_STEREO) * CALLBACKS_PER_READ);
+
+    const int maxInputSamplesRequired = (_inputToNetworkResampler ?
+        _inputToNetworkResampler->getMinInput(AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL) :
+        AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL) * _inputFormat.channelCount();
+    _inputAudioSamples.clear();
+    _inputAudioSamples.reserve(maxInputSamplesRequired);
+
+    _networkAudioBuffer.fill(0, AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+    _encodedAudioBuffer.reserve(AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+
+    _inputBufferBytes = _numInputCallbackBytes;
+    _minInputBufferBytes = std::min(_numInputCallbackBytes,
+                                    _inputFormat.bytesForDuration((qint64)(MIN_INPUT_BUFFER_MSECS * USECS_PER_MSEC)));
+    _lastInputCallbackUsecs = 0;
+    _inputDropoutDetectionStartTimeMsec = usecTimestampNow() / 1000;
+    _inputDropoutDetectionCount = 0;
+}
+
+void AudioClient::checkInputDropouts(quint64 now) {
+    if (_lastInputCallbackUsecs == 0 || _inputBufferBytes == 0) {
+        return;
+    }
+
+    // a callback later than the device buffer could hold means that it overwrote audio
+    quint64 gap = now - _lastInputCallbackUsecs;
+    if (gap > (quint64)_inputFormat.durationForBytes(_inputBufferBytes)) {
+        _inputDropoutDetectionCount++;
+        _stats.inputDropout();
+    }
+
+    quint64 nowMsec = now / 1000;
+    int dt = (int)(nowMsec - _inputDropoutDetectionStartTimeMsec);
+    if (_inputDropoutDetectionCount > INPUT_DROPOUT_THRESHOLD) {
+        if (_inputBufferBytes < _numInputCallbackBytes) {
+            int newInputBufferBytes = std::min(_inputBufferBytes * 2, _numInputCallbackBytes);
+            qCDebug(audioclient, "Input dropout threshold surpassed (%d dropouts in %d ms), input buffer raised to %d bytes",
+                    _inputDropoutDetectionCount, dt, newInputBufferBytes);
+
+            // don't come back down to the size that dropped out
+            _minInputBufferBytes = newInputBufferBytes;
+            setInputBufferSize(newInputBufferBytes);
+        }
+        _inputDropoutDetectionStartTimeMsec = nowMsec;
+        _inputDropoutDetectionCount = 0;
+    } else if (dt > INPUT_DROPOUT_PERIOD) {
+        if (_inputDropoutDetectionCount == 0 && _inputBufferBytes > _minInputBufferBytes) {
+            int newInputBufferBytes = std::max(_inputBufferBytes / 2, _minInputBufferBytes);
+            qCDebug(audioclient, "No input dropouts in %d ms, input buffer lowered to %d bytes", dt, newInputBufferBytes);
+            setInputBufferSize(newInputBufferBytes);
+        }
+        _inputDropoutDetectionStartTimeMsec = nowMsec;
+        _inputDropoutDetectionCount = 0;
     }
 }
 
+void AudioClient::setInputBufferSize(int numBytes) {
+    // keep a whole number of sample frames
+    numBytes -= numBytes % _inputFormat.bytesPerFrame();
+    _inputBufferBytes = numBytes;
+
+    // restarting the device destroys _inputDevice, which is sending the signal we are handling now
+    QMetaObject::invokeMethod(this, [this, numBytes] {
+        if (!_audioInput || !_inputDevice || _inputBufferBytes != numBytes) {
+            return;
+        }
+
+#if defined(Q_OS_ANDROID)
+        _shouldRestartInputSetup = false;  // avoid a double call to _audioInput->start() from audioInputStateChanged
+#endif
+        Lock lock(_deviceMutex);
+        _audioInput->stop();
+        _inputDevice = nullptr;
+        _audioInput->setBufferSize(numBytes);
+        _inputDevice = _audioInput->start();
+        lock.unlock();
+#if defined(Q_OS_ANDROID)
+        _shouldRestartInputSetup = true;
+#endif
+
+        if (_inputDevice) {
+            connect(_inputDevice, SIGNAL(readyRead()), this, SLOT(handleMicAudioInput()));
+        } else {
+            qCDebug(audioclient) << "Error restarting audio input -" << _audioInput->error();
+        }
+        _lastInputCallbackUsecs = 0;
+    }, Qt::QueuedConnection);
+}
+
 void AudioClient::handleDummyAudioInput() {
     const int numNetworkBytes = _isStereoInput
         ? AudioConstants::NETWORK_FRAME_BYTES_STEREO
@@ -1527,12 +1643,11 @@ void AudioClient::prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLoc
             localAudioLock->lock();
         }
 
-        // in case of a device switch, consider bufferCapacity volatile across iterations
+        // in case of a device switch, consider the buffer capacity volatile across iterations
         if (_outputPeriod == 0) {
             return;
         }
 
-        int bufferCapacity = _localInjectorsStream.getSampleCapacity();
         int maxOutputSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * AudioConstants::STEREO;
         if (_localToOutputResampler) {
             maxOutputSamples =
@@ -1540,7 +1655,7 @@ void AudioClient::prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLoc
                 AudioConstants::STEREO;
         }
 
-        samplesNeeded = bufferCapacity - _localSamplesAvailable.load(std::memory_order_relaxed);
+        samplesNeeded = _localInjectorsStream.samplesFree();
         if (samplesNeeded < maxOutputSamples) {
             // avoid overwriting the buffer to prevent losing frames
             break;
@@ -1573,7 +1688,6 @@ void AudioClient::prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLoc
                 AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
         }
 
-        _localSamplesAvailable.fetch_add(samples, std::memory_order_release);
         samplesNeeded -= samples;
     }
 }
@@ -1892,6 +2006,7 @@ bool AudioClient::switchInputToAudioDevice(const HifiAudioDeviceInfo inputDevice
         _audioInput->deleteLater();
         _audioInput = NULL;
         _numInputCallbackBytes = 0;
+        _inputBufferBytes = 0;
 
         _inputDeviceInfo.setDevice(QAudioDeviceInfo());
     }
@@ -1958,6 +2073,7 @@ bool AudioClient::switchInputToAudioDevice(const HifiAudioDeviceInfo inputDevice
                 _audioInput = new QAudioInput(_inputDeviceInfo.getDevice(), _inputFormat, this);
                 _numInputCallbackBytes = calculateNumberOfInputCallbackBytes(_inputFormat);
                 _audioInput->setBufferSize(_numInputCallbackBytes);
+                allocateInputBuffers();
                 // different audio input devices may have different volumes
                 emit inputVolumeChanged(_audioInput->volume());
 
@@ -2113,8 +2229,6 @@ bool AudioClient::switchOutputToAudioDevice(const HifiAudioDeviceInfo outputDevi
     // NOTE: device start() uses the Qt internal device list
     Lock lock(_deviceMutex);
 
-    _localSamplesAvailable.exchange(0, std::memory_order_release);
-
     //wait on local injectors prep to finish running
     if ( !_localPrepInjectorFuture.isFinished()) {
         _localPrepInjectorFuture.waitForFinished();
@@ -2232,7 +2346,7 @@ bool AudioClient::switchOutputToAudioDevice(const HifiAudioDeviceInfo outputDevi
             // round up to an exact multiple of networkPeriod
             localPeriod = ((localPeriod + networkPeriod - 1) / networkPeriod) * networkPeriod;
             // this ensures lowest latency without stutter from underrun
-            _localInjectorsStream.resizeForFrameSize(localPeriod);
+            _localInjectorsStream.resize(localPeriod);
 
             _audioOutputInitialized = true;
 
@@ -2377,12 +2491,9 @@ qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
     int injectorSamplesPopped = 0;
     {
         bool append = networkSamplesPopped > 0;
-        // check the samples we have available locklessly; this is possible because only two functions add to the count:
-        // - prepareLocalAudioInjectors will only increase samples count
-        // - switchOutputToAudioDevice will zero samples count,
-        //   stop the device - so that readData will exhaust the existing buffer or see a zeroed samples count,
-        //   and start the device - which can then only see a zeroed samples count
-        int samplesAvailable = _audio->_localSamplesAvailable.load(std::memory_order_acquire);
+        // the callback is the only consumer of the local injectors stream, so its count is exact here;
+        // switchOutputToAudioDevice only resizes it after stopping the device and the injector prep
+        int samplesAvailable = _localInjectorsStream.samplesAvailable();
 
         // if we do not have enough samples buffered despite having injectors, buffer them synchronously
         if (samplesAvailable < samplesRequested && _audio->_localInjectorsAvailable.load(std::memory_order_acquire)) {
@@ -2390,13 +2501,12 @@ qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
             std::unique_ptr<Lock> localAudioLock(new Lock(_audio->_localAudioMutex, std::try_to_lock));
             if (localAudioLock->owns_lock()) {
                 _audio->prepareLocalAudioInjectors(std::move(localAudioLock));
-                samplesAvailable = _audio->_localSamplesAvailable.load(std::memory_order_acquire);
+                samplesAvailable = _localInjectorsStream.samplesAvailable();
             }
         }
 
         samplesRequested = std::min(samplesRequested, samplesAvailable);
         if ((injectorSamplesPopped = _localInjectorsStream.appendSamples(mixBuffer, samplesRequested, append)) > 0) {
-            _audio->_localSamplesAvailable.fetch_sub(injectorSamplesPopped, std::memory_order_release);
             qCDebug(audiostream, "Read %d samples from injectors (%d available, %d requested)", injectorSamplesPopped, _localInjectorsStream.samplesAvailable(), samplesRequested);
         }
     }
@@ -2478,6 +2588,7 @@ void AudioClient::stopRecording() {
 void AudioClient::loadSettings() {
     _receivedAudioStream.setDynamicJitterBufferEnabled(dynamicJitterBufferEnabled.get());
     _receivedAudioStream.setStaticJitterBufferFrames(staticJitterBufferFrames.get());
+    _receivedAudioStream.setJitterLateLossTarget(jitterLateLossPercent.get() / 100.0f);
 
     qCDebug(audioclient) << "---- Initializing Audio Client ----";
     const auto& codecPlugins = PluginManager::getInstance()->getCodecPlugins();
@@ -2490,6 +2601,7 @@ void AudioClient::loadSettings() {
 void AudioClient::saveSettings() {
     dynamicJitterBufferEnabled.set(_receivedAudioStream.dynamicJitterBufferEnabled());
     staticJitterBufferFrames.set(_receivedAudioStream.getStaticJitterBufferFrames());
+    jitterLateLossPercent.set(_receivedAudioStream.getJitterLateLossTarget() * 100.0f);
 }
 
 void AudioClient::setAvatarBoundingBoxParameters(glm::vec3 corner, glm::vec3 scale) {
@@ -47,6 +47,7 @@
 #include <AudioInjector.h>
 #include <AudioReverb.h>
 #include <AudioLimiter.h>
+#include <AudioSPSCRingBuffer.h>
 #include <AudioConstants.h>
 #include <AudioGate.h>
 
@@ -96,7 +97,7 @@ class AudioClient : public AbstractAudioInterface, public Dependency {
     Q_OBJECT
     SINGLETON_DEPENDENCY
 
-    using LocalInjectorsStream = AudioMixRingBuffer;
+    using LocalInjectorsStream = AudioSPSCMixRingBuffer;
 public:
     static const int MIN_BUFFER_FRAMES;
     static const int MAX_BUFFER_FRAMES;
@@ -319,6 +320,8 @@ private:
     static const int OUTPUT_CHANNEL_COUNT{ 2 };
     static const int STARVE_DETECTION_THRESHOLD{ 3 };
     static const int STARVE_DETECTION_PERIOD{ 10 * 1000 }; // 10 Seconds
+    static const int INPUT_DROPOUT_THRESHOLD{ 3 };
+    static const int INPUT_DROPOUT_PERIOD{ 10 * 1000 }; // 10 Seconds
 
     static const AudioPositionGetter DEFAULT_POSITION_GETTER;
     static const AudioOrientationGetter DEFAULT_ORIENTATION_GETTER;
@@ -334,6 +337,9 @@ private:
 
     void outputFormatChanged();
     void handleAudioInput(QByteArray& audioBuffer);
+    void allocateInputBuffers();
+    void checkInputDropouts(quint64 now);
+    void setInputBufferSize(int numBytes);
     void prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLock = nullptr);
     bool mixLocalAudioInjectors(float* mixBuffer);
     float azimuthForSource(const glm::vec3& relativePosition);
@@ -378,6 +384,21 @@ private:
     QAudioFormat _inputFormat;
     QIODevice* _inputDevice{ nullptr };
     int _numInputCallbackBytes{ 0 };
+
+    // The device buffer starts at _numInputCallbackBytes and is halved after every period without dropouts, down to
+    // _minInputBufferBytes. A dropout is a callback that came later than the buffer could hold, so that the device
+    // overwrote audio; more than INPUT_DROPOUT_THRESHOLD of them in a period double it again and raise the floor.
+    int _inputBufferBytes{ 0 };
+    int _minInputBufferBytes{ 0 };
+    quint64 _lastInputCallbackUsecs{ 0 };
+    quint64 _inputDropoutDetectionStartTimeMsec{ 0 };
+    int _inputDropoutDetectionCount{ 0 };
+
+    // allocated with the input device, so that the capture path doesn't allocate per callback
+    QByteArray _inputReadBuffer;
+    std::vector<int16_t> _inputAudioSamples;
+    QByteArray _networkAudioBuffer;
+    QByteArray _encodedAudioBuffer;
     QAudioOutput* _audioOutput{ nullptr };
     std::atomic<bool> _audioOutputInitialized { false };
     QAudioFormat _desiredOutputFormat;
@@ -387,10 +408,8 @@ private:
     QAudioOutput* _loopbackAudioOutput{ nullptr };
     QIODevice* _loopbackOutputDevice{ nullptr };
     AudioRingBuffer _inputRingBuffer{ 0 };
-    LocalInjectorsStream _localInjectorsStream{ 0 , 1 };
-    // In order to use _localInjectorsStream as a lock-free pipe,
-    // use it with a single producer/consumer, and track available samples and injectors
-    std::atomic<int> _localSamplesAvailable { 0 };
+    // wait-free pipe from prepareLocalAudioInjectors (serialized by _localAudioMutex) to the device callback
+    LocalInjectorsStream _localInjectorsStream;
     std::atomic<bool> _localInjectorsAvailable { false };
     MixedProcessedAudioStream _receivedAudioStream{ RECEIVED_AUDIO_STREAM_CAPACITY_FRAMES };
     bool _isStereoInput{ false };
@@ -21,6 +21,7 @@
 // This is called 1x/sec (see AudioClient) and we want it to log the last 5s
 static const int INPUT_READS_WINDOW = 5;
 static const int INPUT_UNPLAYED_WINDOW = 5;
+static const int INPUT_LATENCY_WINDOW = 5;
 static const int OUTPUT_UNPLAYED_WINDOW = 5;
 
 static const int APPROXIMATELY_30_SECONDS_OF_AUDIO_PACKETS = (int)(30.0f * 1000.0f / AudioConstants::NETWORK_FRAME_MSECS);
@@ -30,6 +31,7 @@ AudioIOStats::AudioIOStats(MixedProcessedAudioStream* receivedAudioStream) :
     _interface(new AudioStatsInterface(this)),
     _inputMsRead(1, INPUT_READS_WINDOW),
     _inputMsUnplayed(1, INPUT_UNPLAYED_WINDOW),
+    _inputLatencyMs(1, INPUT_LATENCY_WINDOW),
     _outputMsUnplayed(1, OUTPUT_UNPLAYED_WINDOW),
     _lastSentPacketTime(0),
     _packetTimegaps(1, APPROXIMATELY_30_SECONDS_OF_AUDIO_PACKETS),
@@ -43,10 +45,13 @@ void AudioIOStats::reset() {
 
     _inputMsRead.reset();
     _inputMsUnplayed.reset();
+    _inputLatencyMs.reset();
+    _inputDropouts = 0;
     _outputMsUnplayed.reset();
     _packetTimegaps.reset();
 
-    _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsUnplayed, _packetTimegaps);
+    _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _inputLatencyMs, _inputDropouts,
+                                   _outputMsUnplayed, _packetTimegaps);
     _interface->updateMixerStream(AudioStreamStats());
     _interface->updateClientStream(AudioStreamStats());
     _interface->updateInjectorStreams(QHash<QUuid, AudioStreamStats>());
@@ -109,7 +114,8 @@ void AudioIOStats::publish() {
     AudioStreamStats stats = _receivedAudioStream->getAudioStreamStats();
 
     // update the interface
-    _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsUnplayed, _packetTimegaps);
+    _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _inputLatencyMs, _inputDropouts,
+                                   _outputMsUnplayed, _packetTimegaps);
     _interface->updateClientStream(stats);
 
     // prepare a packet to the mixer
@@ -164,6 +170,8 @@ AudioStatsInterface::AudioStatsInterface(QObject* parent) :
 
 void AudioStatsInterface::updateLocalBuffers(const MovingMinMaxAvg<float>& inputMsRead,
     const MovingMinMaxAvg<float>& inputMsUnplayed,
+    const MovingMinMaxAvg<float>& inputLatencyMs,
+    int inputDropouts,
     const MovingMinMaxAvg<float>& outputMsUnplayed,
     const MovingMinMaxAvg<quint64>& timegaps) {
     if (SharedNodePointer audioNode = DependencyManager::get<NodeList>()->soloNodeOfType(NodeType::AudioMixer)) {
@@ -172,6 +180,8 @@ void AudioStatsInterface::updateLocalBuffers(const MovingMinMaxAvg<float>& input
 
     inputReadMsMax(inputMsRead.getWindowMax());
     inputUnplayedMsMax(inputMsUnplayed.getWindowMax());
+    inputLatencyMsMax(inputLatencyMs.getWindowMax());
+    inputDropoutCount(inputDropouts);
     outputUnplayedMsMax(outputMsUnplayed.getWindowMax());
 
     sentTimegapMsMax(timegaps.getMax() / USECS_PER_MSEC);
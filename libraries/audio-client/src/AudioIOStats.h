@@ -250,6 +250,12 @@ class AudioStatsInterface : public QObject {
      * @property {number} inputUnplayedMsMax - The maximum duration of microphone audio recently in the input buffer waiting to 
      *     be played, in ms.
      *     <em>Read-only.</em>
+     * @property {number} inputLatencyMsMax - The maximum recent estimate of the time from microphone audio being captured to 
+     *     it being sent to the audio mixer, in ms.
+     *     <em>Read-only.</em>
+     * @property {number} inputDropoutCount - The number of times that the microphone audio wasn't read before the device 
+     *     buffer overflowed.
+     *     <em>Read-only.</em>
      * @property {AudioStats.AudioStreamStats} mixerStream - Statistics of the audio mixer's stream.
      *     <em>Read-only.</em>
      * @property {number} outputUnplayedMsMax - The maximum duration of output audio recently in the output buffer waiting to 
@@ -295,6 +301,25 @@ class AudioStatsInterface : public QObject {
      */
     AUDIO_PROPERTY(float, inputUnplayedMsMax);
 
+    /*@jsdoc
+     * Triggered when the maximum recent estimate of the time from microphone audio being captured to it being sent to the 
+     * audio mixer changes.
+     * @function AudioStats.inputLatencyMsMaxChanged
+     * @param {number} inputLatencyMsMax - The maximum recent estimate of the time from microphone audio being captured to it 
+     *     being sent to the audio mixer, in ms.
+     * @returns {Signal} 
+     */
+    AUDIO_PROPERTY(float, inputLatencyMsMax);
+
+    /*@jsdoc
+     * Triggered when the number of times that the microphone audio wasn't read before the device buffer overflowed changes.
+     * @function AudioStats.inputDropoutCountChanged
+     * @param {number} inputDropoutCount - The number of times that the microphone audio wasn't read before the device buffer 
+     *     overflowed.
+     * @returns {Signal} 
+     */
+    AUDIO_PROPERTY(int, inputDropoutCount);
+
     /*@jsdoc
      * Triggered when the maximum duration of output audio recently in the output buffer waiting to be played changes.
      * @function AudioStats.outputUnplayedMsMaxChanged
@@ -351,6 +376,8 @@ public:
 
     void updateLocalBuffers(const MovingMinMaxAvg<float>& inputMsRead,
                             const MovingMinMaxAvg<float>& inputMsUnplayed,
+                            const MovingMinMaxAvg<float>& inputLatencyMs,
+                            int inputDropouts,
                             const MovingMinMaxAvg<float>& outputMsUnplayed,
                             const MovingMinMaxAvg<quint64>& timegaps);
     void updateMixerStream(const AudioStreamStats& stats) { _mixer->updateStream(stats); emit mixerStreamChanged(); }
@@ -400,6 +427,8 @@ public:
 
     void updateInputMsRead(float ms) const { _inputMsRead.update(ms); }
     void updateInputMsUnplayed(float ms) const { _inputMsUnplayed.update(ms); }
+    void updateInputLatencyMs(float ms) const { _inputLatencyMs.update(ms); }
+    void inputDropout() const { _inputDropouts++; }
     void updateOutputMsUnplayed(float ms) const { _outputMsUnplayed.update(ms); }
     void sentPacket() const;
 
@@ -413,6 +442,8 @@ private:
 
     mutable MovingMinMaxAvg<float> _inputMsRead;
     mutable MovingMinMaxAvg<float> _inputMsUnplayed;
+    mutable MovingMinMaxAvg<float> _inputLatencyMs;
+    mutable int _inputDropouts { 0 };
     mutable MovingMinMaxAvg<float> _outputMsUnplayed;
 
     mutable quint64 _lastSentPacketTime;
@@ -882,6 +882,36 @@ static void convertInput_ref(int16_t* src, float *dst[4], float gain, int numFra
 
 #endif
 
+#ifdef FOA_INPUT_FUMA   // input is FuMa (B-format) channel order and normalization
+
+// convert float to deinterleaved float (B-format)
+static void convertFloatInput(const float* src, float *dst[4], float gain, int numFrames) {
+
+    for (int i = 0; i < numFrames; i++) {
+        dst[0][i] = src[4*i+0] * gain;  // W
+        dst[1][i] = src[4*i+1] * gain;  // X
+        dst[2][i] = src[4*i+2] * gain;  // Y
+        dst[3][i] = src[4*i+3] * gain;  // Z
+    }
+}
+
+#else   // input is ambiX (ACN/SN3D) channel order and normalization
+
+// convert float to deinterleaved float (B-format)
+static void convertFloatInput(const float* src, float *dst[4], float gain, int numFrames) {
+
+    const float gainW = gain * SQRT1_2; // -3dB
+
+    for (int i = 0; i < numFrames; i++) {
+        dst[0][i] = src[4*i+0] * gainW; // W
+        dst[2][i] = src[4*i+1] * gain;  // Y
+        dst[3][i] = src[4*i+2] * gain;  // Z
+        dst[1][i] = src[4*i+3] * gain;  // X
+    }
+}
+
+#endif
+
 // in-place rotation and scaling of the soundfield
 // crossfade between old and new matrix, to prevent artifacts
 static void rotate_4x4_ref(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames) {
@@ -940,6 +970,8 @@ void rifft512_AVX2(float buf[512]);
 void rfft512_cmadd_1X2_AVX2(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]);
 void convertInput_AVX2(int16_t* src, float *dst[4], float gain, int numFrames);
 void rotate_4x4_AVX2(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames);
+void rfft512_cmadd_1X2_AVX512(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]);
+void rotate_4x4_AVX512(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames);
 
 static void rfft512(float buf[512]) {
     static auto f = cpuSupportsAVX2() ? rfft512_AVX2 : rfft512_ref;
@@ -952,7 +984,12 @@ static void rifft512(float buf[512]) {
 }
 
 static void rfft512_cmadd_1X2(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]) {
+#ifndef STACK_PROTECTOR
+    static auto f = cpuSupportsAVX512() ? rfft512_cmadd_1X2_AVX512 :
+                    (cpuSupportsAVX2() ? rfft512_cmadd_1X2_AVX2 : rfft512_cmadd_1X2_ref);
+#else
     static auto f = cpuSupportsAVX2() ? rfft512_cmadd_1X2_AVX2 : rfft512_cmadd_1X2_ref;
+#endif
     (*f)(src, coef0, coef1, dst0, dst1);    // dispatch
 }
 
@@ -962,10 +999,144 @@ static void convertInput(int16_t* src, float *dst[4], float gain, int numFrames)
 }
 
 static void rotate_4x4(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames) {
+#ifndef STACK_PROTECTOR
+    static auto f = cpuSupportsAVX512() ? rotate_4x4_AVX512 : (cpuSupportsAVX2() ? rotate_4x4_AVX2 : rotate_4x4_ref);
+#else
     static auto f = cpuSupportsAVX2() ? rotate_4x4_AVX2 : rotate_4x4_ref;
+#endif
     (*f)(buf, m0, m1, win, numFrames);  // dispatch
 }
 
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#include <arm_neon.h>
+
+// the FFT passes are left to the compiler, the reference code is already written as 4-wide vectors
+static auto& rfft512 = rfft512_ref;
+static auto& rifft512 = rifft512_ref;
+
+// fft-domain complex multiply-add, for packed complex-conjugate symmetric
+// 1 channel input, 2 channel output
+static void rfft512_cmadd_1X2(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]) {
+
+    // NOTE: x[n/2].re is packed into x[0].im
+    float t00 = dst0[0] + src[0] * coef0[0];    // first bin is real
+    float t01 = dst0[1] + src[1] * coef0[1];    // last bin is real
+
+    float t10 = dst1[0] + src[0] * coef1[0];    // first bin is real
+    float t11 = dst1[1] + src[1] * coef1[1];    // last bin is real
+
+    for (int i = 0; i < 512; i += 8) {
+
+        // deinterleave re and im
+        float32x4x2_t a = vld2q_f32(&src[i]);
+        float32x4x2_t b = vld2q_f32(&coef0[i]);
+        float32x4x2_t c = vld2q_f32(&coef1[i]);
+        float32x4x2_t y0 = vld2q_f32(&dst0[i]);
+        float32x4x2_t y1 = vld2q_f32(&dst1[i]);
+
+        y0.val[0] = vmlsq_f32(vmlaq_f32(y0.val[0], a.val[0], b.val[0]), a.val[1], b.val[1]);  // re
+        y0.val[1] = vmlaq_f32(vmlaq_f32(y0.val[1], a.val[0], b.val[1]), a.val[1], b.val[0]);  // im
+
+        y1.val[0] = vmlsq_f32(vmlaq_f32(y1.val[0], a.val[0], c.val[0]), a.val[1], c.val[1]);  // re
+        y1.val[1] = vmlaq_f32(vmlaq_f32(y1.val[1], a.val[0], c.val[1]), a.val[1], c.val[0]);  // im
+
+        vst2q_f32(&dst0[i], y0);
+        vst2q_f32(&dst1[i], y1);
+    }
+
+    // fix the real values
+    dst0[0] = t00;
+    dst0[1] = t01;
+
+    dst1[0] = t10;
+    dst1[1] = t11;
+}
+
+// convert to deinterleaved float (B-format)
+static void convertInput(int16_t* src, float *dst[4], float gain, int numFrames) {
+
+#ifdef FOA_INPUT_FUMA   // input is FuMa (B-format) channel order and normalization
+    float* out[4] = { dst[0], dst[1], dst[2], dst[3] };     // W, X, Y, Z
+    const float32x4_t scaleW = vdupq_n_f32(gain * (1/32768.0f));
+#else   // input is ambiX (ACN/SN3D) channel order and normalization
+    float* out[4] = { dst[0], dst[2], dst[3], dst[1] };     // W, Y, Z, X
+    const float32x4_t scaleW = vdupq_n_f32(gain * (1/32768.0f) * SQRT1_2);  // -3dB
+#endif
+    const float32x4_t scale = vdupq_n_f32(gain * (1/32768.0f));
+
+    assert(numFrames % 8 == 0);
+
+    for (int i = 0; i < numFrames; i += 8) {
+
+        // deinterleave
+        int16x8x4_t a = vld4q_s16(&src[4*i]);
+
+        for (int ch = 0; ch < 4; ch++) {
+
+            // sign-extend
+            float32x4_t x0 = vcvtq_f32_s32(vmovl_s16(vget_low_s16(a.val[ch])));
+            float32x4_t x1 = vcvtq_f32_s32(vmovl_s16(vget_high_s16(a.val[ch])));
+
+            // scale
+            float32x4_t s = (ch == 0) ? scaleW : scale;
+            vst1q_f32(&out[ch][i+0], vmulq_f32(x0, s));
+            vst1q_f32(&out[ch][i+4], vmulq_f32(x1, s));
+        }
+    }
+}
+
+// in-place rotation and scaling of the soundfield
+// crossfade between old and new matrix, to prevent artifacts
+static void rotate_4x4(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames) {
+
+    // matrix difference
+    const float md[4][4] = {
+        { m0[0][0] - m1[0][0], m0[0][1] - m1[0][1], m0[0][2] - m1[0][2], m0[0][3] - m1[0][3] },
+        { m0[1][0] - m1[1][0], m0[1][1] - m1[1][1], m0[1][2] - m1[1][2], m0[1][3] - m1[1][3] },
+        { m0[2][0] - m1[2][0], m0[2][1] - m1[2][1], m0[2][2] - m1[2][2], m0[2][3] - m1[2][3] },
+        { m0[3][0] - m1[3][0], m0[3][1] - m1[3][1], m0[3][2] - m1[3][2], m0[3][3] - m1[3][3] },
+    };
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4_t frac = vld1q_f32(&win[i]);
+
+        // interpolate the matrix
+        float32x4_t m00 = vmlaq_n_f32(vdupq_n_f32(m1[0][0]), frac, md[0][0]);
+
+        float32x4_t m11 = vmlaq_n_f32(vdupq_n_f32(m1[1][1]), frac, md[1][1]);
+        float32x4_t m21 = vmlaq_n_f32(vdupq_n_f32(m1[2][1]), frac, md[2][1]);
+        float32x4_t m31 = vmlaq_n_f32(vdupq_n_f32(m1[3][1]), frac, md[3][1]);
+
+        float32x4_t m12 = vmlaq_n_f32(vdupq_n_f32(m1[1][2]), frac, md[1][2]);
+        float32x4_t m22 = vmlaq_n_f32(vdupq_n_f32(m1[2][2]), frac, md[2][2]);
+        float32x4_t m32 = vmlaq_n_f32(vdupq_n_f32(m1[3][2]), frac, md[3][2]);
+
+        float32x4_t m13 = vmlaq_n_f32(vdupq_n_f32(m1[1][3]), frac, md[1][3]);
+        float32x4_t m23 = vmlaq_n_f32(vdupq_n_f32(m1[2][3]), frac, md[2][3]);
+        float32x4_t m33 = vmlaq_n_f32(vdupq_n_f32(m1[3][3]), frac, md[3][3]);
+
+        float32x4_t b1 = vld1q_f32(&buf[1][i]);
+        float32x4_t b2 = vld1q_f32(&buf[2][i]);
+        float32x4_t b3 = vld1q_f32(&buf[3][i]);
+
+        // matrix multiply
+        float32x4_t w = vmulq_f32(m00, vld1q_f32(&buf[0][i]));
+
+        float32x4_t x = vmlaq_f32(vmlaq_f32(vmulq_f32(m11, b1), m12, b2), m13, b3);
+        float32x4_t y = vmlaq_f32(vmlaq_f32(vmulq_f32(m21, b1), m22, b2), m23, b3);
+        float32x4_t z = vmlaq_f32(vmlaq_f32(vmulq_f32(m31, b1), m32, b2), m33, b3);
+
+        vst1q_f32(&buf[0][i], w);
+        vst1q_f32(&buf[1][i], x);
+        vst1q_f32(&buf[2][i], y);
+        vst1q_f32(&buf[3][i], z);
+    }
+}
+
 #else   // portable reference code
 
 static auto& rfft512 = rfft512_ref;
@@ -1061,20 +1232,42 @@ static void scaleMatrix_4x4(float scale, float m[4][4]) {
 // Ambisonic to binaural render
 void AudioFOA::render(int16_t* input, float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames) {
 
-    assert(index >= 0);
-    assert(index < FOA_TABLES);
     assert(numFrames == FOA_BLOCK);
 
-    ALIGN32 float fftBuffer[FOA_NFFT];          // in-place FFT buffer
-    ALIGN32 float accBuffer[2][FOA_NFFT] = {};  // binaural accumulation buffers
     ALIGN32 float inBuffer[4][FOA_BLOCK];       // deinterleaved input buffers
 
     float* in[4] = { inBuffer[0], inBuffer[1], inBuffer[2], inBuffer[3] };
-    float rotation[4][4];
 
     // convert input to deinterleaved float
     convertInput(input, in, FOA_GAIN, FOA_BLOCK);
 
+    render(in, output, index, qw, qx, qy, qz, gain);
+}
+
+void AudioFOA::render(const float* input, float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames) {
+
+    assert(numFrames == FOA_BLOCK);
+
+    ALIGN32 float inBuffer[4][FOA_BLOCK];       // deinterleaved input buffers
+
+    float* in[4] = { inBuffer[0], inBuffer[1], inBuffer[2], inBuffer[3] };
+
+    // convert input to deinterleaved float
+    convertFloatInput(input, in, FOA_GAIN, FOA_BLOCK);
+
+    render(in, output, index, qw, qx, qy, qz, gain);
+}
+
+void AudioFOA::render(float* in[4], float* output, int index, float qw, float qx, float qy, float qz, float gain) {
+
+    assert(index >= 0);
+    assert(index < FOA_TABLES);
+
+    ALIGN32 float fftBuffer[FOA_NFFT];          // in-place FFT buffer
+    ALIGN32 float accBuffer[2][FOA_NFFT] = {};  // binaural accumulation buffers
+
+    float rotation[4][4];
+
     // convert quaternion to 4x4 rotation
     quatToMatrix_4x4(qw, qx, qy, qz, rotation);
 
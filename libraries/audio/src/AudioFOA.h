@@ -13,6 +13,7 @@
 #define hifi_AudioFOA_h
 
 #include <stdint.h>
+#include <string.h>
 
 static const int FOA_TAPS = 273;    // FIR coefs
 static const int FOA_NFFT = 512;    // FFT length
@@ -40,7 +41,23 @@ public:
     //
     void render(int16_t* input, float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames);
 
+    //
+    // input: interleaved First-Order Ambisonic source, in the same channel order and normalization at full scale 1.0
+    // (otherwise as above)
+    //
+    void render(const float* input, float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames);
+
+    //
+    // Discard the input and orientation history, for a source that restarts
+    //
+    void reset() {
+        memset(_fftState, 0, sizeof(_fftState));
+        _resetState = true;
+    }
+
 private:
+    void render(float* in[4], float* output, int index, float qw, float qx, float qy, float qz, float gain);
+
     AudioFOA(const AudioFOA&) = delete;
     AudioFOA& operator=(const AudioFOA&) = delete;
 
@@ -174,6 +174,65 @@ bool AudioInjectorManager::threadInjector(const AudioInjectorPointer& injector)
     return true;
 }
 
+// resampled copies of recently pitched sounds, so that a sound replayed at the same pitch is only resampled once
+static const size_t MAX_PITCHED_CACHE_BYTES = 16 * 1024 * 1024;
+
+AudioDataPointer AudioInjectorManager::getPitchedAudioData(const AudioDataPointer& audioData, float pitch) {
+    using AudioConstants::AudioSample;
+    using AudioConstants::SAMPLE_RATE;
+    const int standardRate = SAMPLE_RATE;
+    // limit pitch to 4 octaves
+    pitch = glm::clamp(pitch, 1 / 16.0f, 16.0f);
+    const int resampledRate = glm::round(SAMPLE_RATE / pitch);
+
+    {
+        Lock lock(_pitchedCacheMutex);
+        for (auto it = _pitchedCache.begin(); it != _pitchedCache.end(); ++it) {
+            if (it->resampledRate == resampledRate && it->source.lock() == audioData) {
+                // move to the front, so the least recently played entry is evicted first
+                _pitchedCache.splice(_pitchedCache.begin(), _pitchedCache, it);
+                return it->resampled;
+            }
+        }
+    }
+
+    auto numChannels = audioData->getNumChannels();
+    auto numFrames = audioData->getNumFrames();
+
+    AudioSRC resampler(standardRate, resampledRate, numChannels);
+
+    // create a resampled buffer that is guaranteed to be large enough
+    const int maxOutputFrames = resampler.getMaxOutput(numFrames);
+    const int maxOutputSize = maxOutputFrames * numChannels * sizeof(AudioSample);
+    QByteArray resampledBuffer(maxOutputSize, '\0');
+    auto bufferPtr = reinterpret_cast<AudioSample*>(resampledBuffer.data());
+
+    resampler.render(audioData->data(), bufferPtr, numFrames);
+
+    int numSamples = maxOutputFrames * numChannels;
+    auto newAudioData = AudioData::make(numSamples, numChannels, bufferPtr);
+
+    Lock lock(_pitchedCacheMutex);
+
+    // drop entries whose sound has been released, then the least recently played until the new entry fits
+    _pitchedCacheBytes += newAudioData->getNumBytes();
+    _pitchedCache.push_front({ audioData, resampledRate, newAudioData });
+    for (auto it = std::next(_pitchedCache.begin()); it != _pitchedCache.end();) {
+        if (it->source.expired()) {
+            _pitchedCacheBytes -= it->resampled->getNumBytes();
+            it = _pitchedCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    while (_pitchedCacheBytes > MAX_PITCHED_CACHE_BYTES && _pitchedCache.size() > 1) {
+        _pitchedCacheBytes -= _pitchedCache.back().resampled->getNumBytes();
+        _pitchedCache.pop_back();
+    }
+
+    return newAudioData;
+}
+
 AudioInjectorPointer AudioInjectorManager::playSound(const SharedSoundPointer& sound, const AudioInjectorOptions& options, bool setPendingDelete) {
     if (_shouldStop) {
         qCDebug(audio) << "AudioInjectorManager::threadInjector asked to thread injector but is shutting down.";
@@ -185,30 +244,7 @@ AudioInjectorPointer AudioInjectorManager::playSound(const SharedSoundPointer& s
         if (options.pitch == 1.0f) {
             injector = QSharedPointer<AudioInjector>(new AudioInjector(sound, options), &AudioInjector::deleteLater);
         } else {
-            using AudioConstants::AudioSample;
-            using AudioConstants::SAMPLE_RATE;
-            const int standardRate = SAMPLE_RATE;
-            // limit pitch to 4 octaves
-            const float pitch = glm::clamp(options.pitch, 1 / 16.0f, 16.0f);
-            const int resampledRate = glm::round(SAMPLE_RATE / pitch);
-
-            auto audioData = sound->getAudioData();
-            auto numChannels = audioData->getNumChannels();
-            auto numFrames = audioData->getNumFrames();
-
-            AudioSRC resampler(standardRate, resampledRate, numChannels);
-
-            // create a resampled buffer that is guaranteed to be large enough
-            const int maxOutputFrames = resampler.getMaxOutput(numFrames);
-            const int maxOutputSize = maxOutputFrames * numChannels * sizeof(AudioSample);
-            QByteArray resampledBuffer(maxOutputSize, '\0');
-            auto bufferPtr = reinterpret_cast<AudioSample*>(resampledBuffer.data());
-
-            resampler.render(audioData->data(), bufferPtr, numFrames);
-
-            int numSamples = maxOutputFrames * numChannels;
-            auto newAudioData = AudioData::make(numSamples, numChannels, bufferPtr);
-
+            auto newAudioData = getPitchedAudioData(sound->getAudioData(), options.pitch);
             injector = QSharedPointer<AudioInjector>(new AudioInjector(newAudioData, options), &AudioInjector::deleteLater);
         }
     }
@@ -237,29 +273,7 @@ AudioInjectorPointer AudioInjectorManager::playSound(const AudioDataPointer& aud
     if (options.pitch == 1.0f) {
         injector = QSharedPointer<AudioInjector>(new AudioInjector(audioData, options), &AudioInjector::deleteLater);
     } else {
-        using AudioConstants::AudioSample;
-        using AudioConstants::SAMPLE_RATE;
-        const int standardRate = SAMPLE_RATE;
-        // limit pitch to 4 octaves
-        const float pitch = glm::clamp(options.pitch, 1 / 16.0f, 16.0f);
-        const int resampledRate = glm::round(SAMPLE_RATE / pitch);
-
-        auto numChannels = audioData->getNumChannels();
-        auto numFrames = audioData->getNumFrames();
-
-        AudioSRC resampler(standardRate, resampledRate, numChannels);
-
-        // create a resampled buffer that is guaranteed to be large enough
-        const int maxOutputFrames = resampler.getMaxOutput(numFrames);
-        const int maxOutputSize = maxOutputFrames * numChannels * sizeof(AudioSample);
-        QByteArray resampledBuffer(maxOutputSize, '\0');
-        auto bufferPtr = reinterpret_cast<AudioSample*>(resampledBuffer.data());
-
-        resampler.render(audioData->data(), bufferPtr, numFrames);
-
-        int numSamples = maxOutputFrames * numChannels;
-        auto newAudioData = AudioData::make(numSamples, numChannels, bufferPtr);
-
+        auto newAudioData = getPitchedAudioData(audioData, options.pitch);
         injector = QSharedPointer<AudioInjector>(new AudioInjector(newAudioData, options), &AudioInjector::deleteLater);
     }
 
@@ -15,6 +15,7 @@
 #define hifi_AudioInjectorManager_h
 
 #include <condition_variable>
+#include <list>
 #include <queue>
 #include <mutex>
 
@@ -71,6 +72,8 @@ private:
     void notifyInjectorReadyCondition() { _injectorReady.notify_one(); }
     bool wouldExceedLimits();
 
+    AudioDataPointer getPitchedAudioData(const AudioDataPointer& audioData, float pitch);
+
     AudioInjectorManager() { createThread(); }
     Q_DISABLE_COPY(AudioInjectorManager)
 
@@ -82,6 +85,15 @@ private:
     Mutex _injectorsMutex;
     std::condition_variable _injectorReady;
 
+    struct PitchedAudioData {
+        std::weak_ptr<const AudioData> source;
+        int resampledRate;
+        AudioDataPointer resampled;
+    };
+    std::list<PitchedAudioData> _pitchedCache;
+    size_t _pitchedCacheBytes { 0 };
+    Mutex _pitchedCacheMutex;
+
     friend class AudioInjector;
 };
 
@@ -47,7 +47,7 @@ public:
 
     // Reading and writing to the buffer uses minimal shared data, such that
     // in cases that avoid overwriting the buffer, a single producer/consumer
-    // may use this as a lock-free pipe (see audio-client/src/AudioClient.cpp).
+    // may use this as a lock-free pipe. Prefer AudioSPSCRingBufferTemplate for new cross-thread pipes.
     // IMPORTANT: Avoid changes to the implementation that touch shared data unless you can
     // maintain this behavior.
 
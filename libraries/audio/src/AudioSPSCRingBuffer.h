@@ -0,0 +1,175 @@
+//
+//  AudioSPSCRingBuffer.h
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_AudioSPSCRingBuffer_h
+#define overte_AudioSPSCRingBuffer_h
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+// Wait-free ring buffer for exactly one producer thread and one consumer thread.
+//
+// Unlike AudioRingBufferTemplate, a full buffer never overwrites unread samples: writes are truncated instead,
+// so the consumer can never observe a partially overwritten region. Each index is written by one side only,
+// and lives on its own cache line together with that side's cached copy of the other index.
+//
+// resize() and reset() are not thread-safe; both sides must be idle when they are called.
+template <class T>
+class AudioSPSCRingBufferTemplate {
+    using Sample = T;
+    static const int SampleSize = sizeof(Sample);
+
+    // alignment within the object (not of the object itself) keeps the two sides on separate lines
+    static const size_t CACHE_LINE_SIZE = 64;
+
+public:
+    AudioSPSCRingBufferTemplate(int sampleCapacity = 0) { resize(sampleCapacity); }
+
+    // disallow copying
+    AudioSPSCRingBufferTemplate(const AudioSPSCRingBufferTemplate&) = delete;
+    AudioSPSCRingBufferTemplate(AudioSPSCRingBufferTemplate&&) = delete;
+    AudioSPSCRingBufferTemplate& operator=(const AudioSPSCRingBufferTemplate&) = delete;
+
+    /// Reallocate for sampleCapacity samples, discarding any data in the buffer
+    void resize(int sampleCapacity) {
+        _sampleCapacity = std::max(sampleCapacity, 0);
+        _bufferLength = _sampleCapacity + 1;
+        _buffer.reset(new Sample[_bufferLength]);
+        reset();
+    }
+
+    /// Discard any data in the buffer
+    void reset() {
+        _writeIndex.store(0, std::memory_order_relaxed);
+        _readIndex.store(0, std::memory_order_relaxed);
+        _producer.cachedReadIndex = 0;
+        _consumer.cachedWriteIndex = 0;
+    }
+
+    int getSampleCapacity() const { return _sampleCapacity; }
+
+    /// Samples ready to read; exact on the consumer side, a lower bound on the producer side
+    int samplesAvailable() const {
+        return distance(_readIndex.load(std::memory_order_acquire), _writeIndex.load(std::memory_order_acquire));
+    }
+
+    /// Samples that may be written; exact on the producer side, a lower bound on the consumer side
+    int samplesFree() const { return _sampleCapacity - samplesAvailable(); }
+
+    static bool isLockFree() { return ATOMIC_INT_LOCK_FREE == 2; }
+
+    // producer
+
+    /// Write up to maxSamples from source (will only write up to samplesFree())
+    /// Returns number of written samples
+    int writeSamples(const Sample* source, int maxSamples) {
+        int writeIndex = _writeIndex.load(std::memory_order_relaxed);
+
+        int numSamples = _sampleCapacity - distance(_producer.cachedReadIndex, writeIndex);
+        if (numSamples < maxSamples) {
+            // only touch the consumer's line when the cached index is not enough
+            _producer.cachedReadIndex = _readIndex.load(std::memory_order_acquire);
+            numSamples = _sampleCapacity - distance(_producer.cachedReadIndex, writeIndex);
+        }
+        numSamples = std::min(numSamples, maxSamples);
+        if (numSamples <= 0) {
+            return 0;
+        }
+
+        int firstSamples = std::min(numSamples, _bufferLength - writeIndex);
+        memcpy(&_buffer[writeIndex], source, firstSamples * SampleSize);
+        memcpy(&_buffer[0], source + firstSamples, (numSamples - firstSamples) * SampleSize);
+
+        _writeIndex.store(advance(writeIndex, numSamples), std::memory_order_release);
+        return numSamples;
+    }
+
+    // consumer
+
+    /// Read up to maxSamples into destination (will only read up to samplesAvailable())
+    /// Returns number of read samples
+    int readSamples(Sample* destination, int maxSamples) {
+        return appendSamples(destination, maxSamples, false);
+    }
+
+    /// Append up to maxSamples into destination (will only read up to samplesAvailable())
+    /// If append == false, behaves as readSamples
+    /// Returns number of appended samples
+    int appendSamples(Sample* destination, int maxSamples, bool append = true) {
+        int readIndex = _readIndex.load(std::memory_order_relaxed);
+
+        int numSamples = distance(readIndex, _consumer.cachedWriteIndex);
+        if (numSamples < maxSamples) {
+            // only touch the producer's line when the cached index is not enough
+            _consumer.cachedWriteIndex = _writeIndex.load(std::memory_order_acquire);
+            numSamples = distance(readIndex, _consumer.cachedWriteIndex);
+        }
+        numSamples = std::min(numSamples, maxSamples);
+        if (numSamples <= 0) {
+            return 0;
+        }
+
+        int firstSamples = std::min(numSamples, _bufferLength - readIndex);
+        if (append) {
+            addSamples(destination, &_buffer[readIndex], firstSamples);
+            addSamples(destination + firstSamples, &_buffer[0], numSamples - firstSamples);
+        } else {
+            memcpy(destination, &_buffer[readIndex], firstSamples * SampleSize);
+            memcpy(destination + firstSamples, &_buffer[0], (numSamples - firstSamples) * SampleSize);
+        }
+
+        _readIndex.store(advance(readIndex, numSamples), std::memory_order_release);
+        return numSamples;
+    }
+
+private:
+    int distance(int from, int to) const {
+        int d = to - from;
+        return (d < 0) ? d + _bufferLength : d;
+    }
+
+    int advance(int index, int numSamples) const {
+        index += numSamples;
+        return (index >= _bufferLength) ? index - _bufferLength : index;
+    }
+
+    static void addSamples(Sample* destination, const Sample* source, int numSamples) {
+        for (int i = 0; i < numSamples; i++) {
+            destination[i] += source[i];
+        }
+    }
+
+    // written by the producer
+    alignas(CACHE_LINE_SIZE) std::atomic<int> _writeIndex { 0 };
+    struct {
+        int cachedReadIndex { 0 };
+    } _producer;
+
+    // written by the consumer
+    alignas(CACHE_LINE_SIZE) std::atomic<int> _readIndex { 0 };
+    struct {
+        int cachedWriteIndex { 0 };
+    } _consumer;
+
+    // read-only while both sides are running
+    alignas(CACHE_LINE_SIZE) int _sampleCapacity { 0 };
+    int _bufferLength { 1 };
+    std::unique_ptr<Sample[]> _buffer;
+};
+
+using AudioSPSCRingBuffer = AudioSPSCRingBufferTemplate<int16_t>;
+using AudioSPSCMixRingBuffer = AudioSPSCRingBufferTemplate<float>;
+
+#endif // overte_AudioSPSCRingBuffer_h
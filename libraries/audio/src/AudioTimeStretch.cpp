@@ -0,0 +1,92 @@
+//
+//  AudioTimeStretch.cpp
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AudioTimeStretch.h"
+
+#include <string.h>
+#include <algorithm>
+
+// stretch by 1/32 (about half a semitone) while the buffer is adjusting
+static const int STRETCH_DIVISOR = 32;
+
+// frames to crossfade when switching between the direct and resampled paths
+static const int CROSSFADE_FRAMES = 32;
+
+void AudioTimeStretch::setFormat(int sampleRate, int numChannels) {
+    if (sampleRate == _sampleRate && numChannels == _numChannels) {
+        return;
+    }
+    _sampleRate = sampleRate;
+    _numChannels = numChannels;
+
+    int delta = sampleRate / STRETCH_DIVISOR;
+    _grow.reset(new AudioSRC(sampleRate, sampleRate + delta, numChannels));
+    _shrink.reset(new AudioSRC(sampleRate, sampleRate - delta, numChannels));
+
+    _direction = NONE;
+    _lastInput.clear();
+}
+
+int AudioTimeStretch::getMaxOutput(int inputFrames) const {
+    return _grow ? std::max(_grow->getMaxOutput(inputFrames), inputFrames) : inputFrames;
+}
+
+int AudioTimeStretch::renderPath(Direction direction, const int16_t* input, int16_t* output, int inputFrames) {
+    switch (direction) {
+        case GROW:
+            return _grow->render(input, output, inputFrames);
+        case SHRINK:
+            return _shrink->render(input, output, inputFrames);
+        default:
+            memcpy(output, input, inputFrames * _numChannels * sizeof(int16_t));
+            return inputFrames;
+    }
+}
+
+int AudioTimeStretch::render(const int16_t* input, int16_t* output, int inputFrames, Direction direction) {
+    if (!isFormatSet()) {
+        direction = NONE;
+    }
+
+    int outputFrames;
+
+    if (direction == _direction) {
+        outputFrames = renderPath(direction, input, output, inputFrames);
+
+    } else {
+        // a resampler that was idle still holds stale history, so prime it with the previous input
+        if (direction != NONE && !_lastInput.empty()) {
+            _scratch.resize(getMaxOutput((int)_lastInput.size() / _numChannels) * _numChannels);
+            renderPath(direction, _lastInput.data(), _scratch.data(), (int)_lastInput.size() / _numChannels);
+        }
+
+        // render both paths, and crossfade from the old one to the new one
+        _scratch.resize(getMaxOutput(inputFrames) * _numChannels);
+        int oldFrames = renderPath(_direction, input, _scratch.data(), inputFrames);
+        outputFrames = renderPath(direction, input, output, inputFrames);
+
+        int fadeFrames = std::min(CROSSFADE_FRAMES, std::min(oldFrames, outputFrames));
+        for (int i = 0; i < fadeFrames; i++) {
+            float frac = (i + 1) / (float)(fadeFrames + 1);
+            for (int j = 0; j < _numChannels; j++) {
+                int k = i * _numChannels + j;
+                output[k] = (int16_t)(_scratch[k] + frac * (output[k] - _scratch[k]));
+            }
+        }
+
+        _direction = direction;
+    }
+
+    if (isFormatSet()) {
+        _lastInput.assign(input, input + inputFrames * _numChannels);
+    }
+    return outputFrames;
+}
@@ -0,0 +1,58 @@
+//
+//  AudioTimeStretch.h
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_AudioTimeStretch_h
+#define overte_AudioTimeStretch_h
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "AudioSRC.h"
+
+// Slightly resamples interleaved audio to grow or shrink a jitter buffer without inserting silence or dropping frames.
+// Switching between directions crossfades the old and new paths, to avoid a click.
+class AudioTimeStretch {
+public:
+    enum Direction {
+        SHRINK = -1,
+        NONE = 0,
+        GROW = 1
+    };
+
+    AudioTimeStretch() = default;
+
+    void setFormat(int sampleRate, int numChannels);
+    bool isFormatSet() const { return _numChannels > 0; }
+
+    Direction getDirection() const { return _direction; }
+
+    int getMaxOutput(int inputFrames) const;
+
+    // interleaved int16_t input/output; returns number of output frames
+    int render(const int16_t* input, int16_t* output, int inputFrames, Direction direction);
+
+private:
+    int renderPath(Direction direction, const int16_t* input, int16_t* output, int inputFrames);
+
+    std::unique_ptr<AudioSRC> _grow;
+    std::unique_ptr<AudioSRC> _shrink;
+
+    int _sampleRate { 0 };
+    int _numChannels { 0 };
+    Direction _direction { NONE };
+
+    std::vector<int16_t> _lastInput;
+    std::vector<int16_t> _scratch;
+};
+
+#endif // overte_AudioTimeStretch_h
@@ -22,6 +22,7 @@
 
 const bool InboundAudioStream::DEFAULT_DYNAMIC_JITTER_BUFFER_ENABLED = true;
 const int InboundAudioStream::DEFAULT_STATIC_JITTER_FRAMES = 1;
+const float InboundAudioStream::DEFAULT_JITTER_LATE_LOSS_TARGET = 0.0f;
 const int InboundAudioStream::MAX_FRAMES_OVER_DESIRED = 10;
 const int InboundAudioStream::WINDOW_STARVE_THRESHOLD = 3;
 const int InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES = 50;
@@ -48,6 +49,12 @@ static const int STATS_FOR_STATS_PACKET_WINDOW_SECONDS = 30;
 // _currentJitterBufferFrames is updated with the time-weighted avg and the running time-weighted avg is reset.
 static const quint64 FRAMES_AVAILABLE_STAT_WINDOW_USECS = 10 * USECS_PER_SECOND;
 
+// the late-loss target is a ratio of packets; anything beyond this is not a jitter buffer
+static const float MAX_JITTER_LATE_LOSS_TARGET = 0.5f;
+
+// smoothing of the frames available to arriving packets, so that a single burst does not start a time-stretch
+static const float STRETCH_LEVEL_SMOOTHING = 1.0f / 16.0f;
+
 // When the audio codec is switched, temporary codec mismatch is expected due to packets in-flight.
 // A SelectedAudioFormat packet is not sent until this threshold is exceeded.
 static const int MAX_MISMATCHED_AUDIO_CODEC_COUNT = 10;
@@ -60,6 +67,7 @@ InboundAudioStream::InboundAudioStream(int numChannels, int numFrames, int numBl
     _desiredJitterBufferFrames(_dynamicJitterBufferEnabled ? 1 : _staticJitterBufferFrames),
     _incomingSequenceNumberStats(STATS_FOR_STATS_PACKET_WINDOW_SECONDS),
     _starveHistory(STARVE_HISTORY_CAPACITY),
+    _stretchNumChannels(numChannels),
     _unplayedMs(0, UNPLAYED_MS_WINDOW_SECS),
     _timeGapStatsForStatsPacket(0, STATS_FOR_STATS_PACKET_WINDOW_SECONDS) {}
 
@@ -92,6 +100,9 @@ void InboundAudioStream::resetStats() {
     _timeGapStatsForDesiredCalcOnTooManyStarves.reset();
     _timeGapStatsForDesiredReduction.reset();
     _starveHistory.clear();
+    _delayHistogram.reset();
+    _filteredFramesAvailable = 0.0f;
+    _stretchedFrames = 0;
     _framesAvailableStat.reset();
     _currentJitterBufferFrames = 0;
     _timeGapStatsForStatsPacket.reset();
@@ -127,6 +138,7 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
     QString codecInPacket = message.readString();
 
     packetReceivedUpdateTimingStats();
+    packetReceivedUpdateDelayHistogram(arrivalInfo);
 
     int networkFrames;
 
@@ -176,7 +188,7 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
                     if (packetPCM) {
                         // If there are PCM packets in-flight after the codec is changed, use them.
                         auto afterProperties = message.readWithoutCopy(message.getBytesLeftToRead());
-                        _ringBuffer.writeData(afterProperties.data(), afterProperties.size());
+                        writeStretchedData(afterProperties.data(), afterProperties.size());
                     } else {
                         // Since the data in the stream is using a codec that we aren't prepared for,
                         // we need to let the codec know that we don't have data for it, this will
@@ -245,8 +257,6 @@ int InboundAudioStream::parseStreamProperties(PacketType type, const QByteArray&
 }
 
 int InboundAudioStream::lostAudioData(int numPackets) {
-    QByteArray decodedBuffer;
-
     while (numPackets--) {
         MutexTryLocker lock(_decoderMutex);
         if (!lock.isLocked()) {
@@ -257,31 +267,79 @@ int InboundAudioStream::lostAudioData(int numPackets) {
             return 0;
         }
         if (_decoder) {
-            _decoder->lostFrame(decodedBuffer);
+            int decodedSize = _decoder->lostFrameInto(_decodedBuffer.data(), _decodedBuffer.size());
+            if (decodedSize < 0) {
+                decodedSize = _decodedBuffer.size();
+                memset(_decodedBuffer.data(), 0, decodedSize);
+            }
+            _ringBuffer.writeData(_decodedBuffer.constData(), decodedSize);
         } else {
-            decodedBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * _numChannels);
-            memset(decodedBuffer.data(), 0, decodedBuffer.size());
+            QByteArray decodedBuffer(AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * _numChannels, 0);
+            _ringBuffer.writeData(decodedBuffer.data(), decodedBuffer.size());
         }
-        _ringBuffer.writeData(decodedBuffer.data(), decodedBuffer.size());
     }
     return 0;
 }
 
 int InboundAudioStream::parseAudioData(const QByteArray& packetAfterStreamProperties) {
-    QByteArray decodedBuffer;
-
     // may block on the real-time thread, which is acceptible as 
     // parseAudioData is only called by the packet processing
     // thread which, while high performance, is not as sensitive to
     // delays as the real-time thread.
     QMutexLocker lock(&_decoderMutex);
     if (_decoder) {
-        _decoder->decode(packetAfterStreamProperties, decodedBuffer);
-    } else {
-        decodedBuffer = packetAfterStreamProperties;
+        // decoded into the same buffer every time, rather than a new one per packet
+        int decodedSize = _decoder->decodeInto(packetAfterStreamProperties.constData(), packetAfterStreamProperties.size(),
+            _decodedBuffer.data(), _decodedBuffer.size());
+        if (decodedSize < 0) {
+            qCWarning(audiostream) << "Decoded audio doesn't fit in a frame of" << _decodedBuffer.size() << "bytes, dropped";
+            return 0;
+        }
+        return writeStretchedData(_decodedBuffer.constData(), decodedSize);
+    }
+    return writeStretchedData(packetAfterStreamProperties.constData(), packetAfterStreamProperties.size());
+}
+
+int InboundAudioStream::writeStretchedData(const char* data, int numBytes) {
+    if (!histogramJitterBufferEnabled()) {
+        return _ringBuffer.writeData(data, numBytes);
+    }
+
+    if (!_timeStretch.isFormatSet()) {
+        _timeStretch.setFormat(_stretchSampleRate, _stretchNumChannels);
+    }
+
+    _filteredFramesAvailable += STRETCH_LEVEL_SMOOTHING * (_ringBuffer.framesAvailable() - _filteredFramesAvailable);
+
+    // grow below the desired frames, shrink more than a frame above it, and stop either once past the middle
+    AudioTimeStretch::Direction direction = _timeStretch.getDirection();
+    float error = _filteredFramesAvailable - (_desiredJitterBufferFrames + 0.5f);
+    if (error < -0.5f) {
+        direction = AudioTimeStretch::GROW;
+    } else if (error > 0.5f) {
+        direction = AudioTimeStretch::SHRINK;
+    } else if ((direction == AudioTimeStretch::GROW && error >= 0.0f) ||
+               (direction == AudioTimeStretch::SHRINK && error <= 0.0f)) {
+        direction = AudioTimeStretch::NONE;
+    }
+
+    int inputFrames = numBytes / (_stretchNumChannels * AudioConstants::SAMPLE_SIZE);
+    _stretchBuffer.resize(_timeStretch.getMaxOutput(inputFrames) * _stretchNumChannels);
+
+    int outputFrames = _timeStretch.render(reinterpret_cast<const int16_t*>(data), _stretchBuffer.data(),
+                                           inputFrames, direction);
+    _stretchedFrames += std::abs(outputFrames - inputFrames);
+
+    return _ringBuffer.writeData(reinterpret_cast<const char*>(_stretchBuffer.data()),
+                                 outputFrames * _stretchNumChannels * AudioConstants::SAMPLE_SIZE);
+}
+
+void InboundAudioStream::setStretchFormat(int sampleRate, int numChannels) {
+    _stretchSampleRate = sampleRate;
+    _stretchNumChannels = numChannels;
+    if (_timeStretch.isFormatSet()) {
+        _timeStretch.setFormat(sampleRate, numChannels);
     }
-    auto actualSize = decodedBuffer.size();
-    return _ringBuffer.writeData(decodedBuffer.data(), actualSize);
 }
 
 int InboundAudioStream::writeDroppableSilentFrames(int silentFrames) {
@@ -431,7 +489,7 @@ void InboundAudioStream::setToStarved() {
     quint64 now = usecTimestampNow();
     _starveHistory.insert(now);
 
-    if (_dynamicJitterBufferEnabled) {
+    if (_dynamicJitterBufferEnabled && !histogramJitterBufferEnabled()) {
         // dynamic jitter buffers are enabled. check if this starve put us over the window
         // starve threshold
         quint64 windowEnd = now - WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES * USECS_PER_SECOND;
@@ -484,6 +542,10 @@ void InboundAudioStream::setStaticJitterBufferFrames(int staticJitterBufferFrame
     }
 }
 
+void InboundAudioStream::setJitterLateLossTarget(float lateLossRatio) {
+    _jitterLateLossTarget = glm::clamp(lateLossRatio, 0.0f, MAX_JITTER_LATE_LOSS_TARGET);
+}
+
 void InboundAudioStream::packetReceivedUpdateTimingStats() {
     
     // update our timegap stats and desired jitter buffer frames if necessary
@@ -504,7 +566,7 @@ void InboundAudioStream::packetReceivedUpdateTimingStats() {
             _timeGapStatsForDesiredCalcOnTooManyStarves.clearNewStatsAvailableFlag();
         }
 
-        if (_dynamicJitterBufferEnabled) {
+        if (_dynamicJitterBufferEnabled && !histogramJitterBufferEnabled()) {
             // if the max gap in window B (_timeGapStatsForDesiredReduction) corresponds to a smaller number of frames than _desiredJitterBufferFrames,
             // then reduce _desiredJitterBufferFrames to that number of frames.
             if (_timeGapStatsForDesiredReduction.getNewStatsAvailableFlag() && _timeGapStatsForDesiredReduction.isWindowFilled()) {
@@ -522,6 +584,34 @@ void InboundAudioStream::packetReceivedUpdateTimingStats() {
     _lastPacketReceivedTime = now;
 }
 
+void InboundAudioStream::packetReceivedUpdateDelayHistogram(const SequenceNumberStats::ArrivalInfo& arrivalInfo) {
+    if (!histogramJitterBufferEnabled()) {
+        return;
+    }
+
+    // sequence slots since the newest packet; reordered packets look back, and count as late
+    int seqOffset;
+    switch (arrivalInfo._status) {
+        case SequenceNumberStats::OnTime:
+            seqOffset = 1;
+            break;
+        case SequenceNumberStats::Early:
+        case SequenceNumberStats::Recovered:
+            seqOffset = arrivalInfo._seqDiffFromExpected + 1;
+            break;
+        default:
+            return;
+    }
+    _delayHistogram.packetArrived(_lastPacketReceivedTime, seqOffset);
+
+    int calculatedJitterBufferFrames = _delayHistogram.getTargetFrames(_jitterLateLossTarget);
+    calculatedJitterBufferFrames = std::max(std::min(calculatedJitterBufferFrames, _ringBuffer.getFrameCapacity() / 2), 1);
+    if (calculatedJitterBufferFrames != _desiredJitterBufferFrames) {
+        _desiredJitterBufferFrames = calculatedJitterBufferFrames;
+        qCDebug(audiostream, "Set desired jitter frames to %d (histogram)", _desiredJitterBufferFrames);
+    }
+}
+
 AudioStreamStats InboundAudioStream::getAudioStreamStats() const {
     AudioStreamStats streamStats;
 
@@ -574,6 +664,7 @@ void InboundAudioStream::setupCodec(CodecPluginPointer codec, const QString& cod
     if (_codec) {
         QMutexLocker lock(&_decoderMutex);
         _decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, numChannels);
+        _decodedBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * numChannels);
     }
 }
 
@@ -22,7 +22,9 @@
 #include <plugins/CodecPlugin.h>
 
 #include "AudioRingBuffer.h"
+#include "AudioTimeStretch.h"
 #include "MovingMinMaxAvg.h"
+#include "PacketDelayHistogram.h"
 #include "SequenceNumberStats.h"
 #include "AudioStreamStats.h"
 #include "TimeWeightedAvg.h"
@@ -39,6 +41,7 @@ public:
     // settings
     static const bool DEFAULT_DYNAMIC_JITTER_BUFFER_ENABLED;
     static const int DEFAULT_STATIC_JITTER_FRAMES;
+    static const float DEFAULT_JITTER_LATE_LOSS_TARGET;
     // legacy (now static) settings
     static const int MAX_FRAMES_OVER_DESIRED;
     static const int WINDOW_STARVE_THRESHOLD;
@@ -71,6 +74,10 @@ public:
     void setDynamicJitterBufferEnabled(bool enable);
     void setStaticJitterBufferFrames(int staticJitterBufferFrames);
 
+    /// With dynamic jitter buffers, a late-loss target above zero sizes the buffer to play all but
+    /// that ratio of packets in time, from a histogram of packet delays, and time-stretches to reach it
+    void setJitterLateLossTarget(float lateLossRatio);
+
     virtual AudioStreamStats getAudioStreamStats() const;
 
     /// returns the desired number of jitter buffer frames under the dyanmic jitter buffers scheme
@@ -80,6 +87,13 @@ public:
     int getStaticJitterBufferFrames() { return _staticJitterBufferFrames; }
     int getDesiredJitterBufferFrames() { return _desiredJitterBufferFrames; }
 
+    bool histogramJitterBufferEnabled() const { return _dynamicJitterBufferEnabled && _jitterLateLossTarget > 0.0f; }
+    float getJitterLateLossTarget() const { return _jitterLateLossTarget; }
+    /// returns the ratio of recent packets that arrived too late for the desired jitter buffer frames
+    float getLateLossRatio() const { return _delayHistogram.getLateLossRatio(_desiredJitterBufferFrames); }
+    /// returns the audio time added or removed by time-stretching
+    float getStretchedMsecs() const { return _stretchedFrames * (float)MSECS_PER_SECOND / _stretchSampleRate; }
+
     int getNumFrameSamples() const { return _ringBuffer.getNumFrameSamples(); }
     int getFrameCapacity() const { return _ringBuffer.getFrameCapacity(); }
     int getFramesAvailable() const { return _ringBuffer.framesAvailable(); }
@@ -116,6 +130,7 @@ public slots:
 
 private:
     void packetReceivedUpdateTimingStats();
+    void packetReceivedUpdateDelayHistogram(const SequenceNumberStats::ArrivalInfo& arrivalInfo);
 
     void popSamplesNoCheck(int samples);
     void framesAvailableChanged();
@@ -139,6 +154,12 @@ protected:
 
     /// writes silent frames to the buffer that may be dropped to reduce latency caused by the buffer
     virtual int writeDroppableSilentFrames(int silentFrames);
+
+    /// writes decoded audio to the buffer, time-stretched toward the desired frames under the histogram scheme
+    int writeStretchedData(const char* data, int numBytes);
+
+    /// sets the format that writeStretchedData receives, if it differs from the network format
+    void setStretchFormat(int sampleRate, int numChannels);
     
 protected:
 
@@ -171,6 +192,15 @@ protected:
 
     RingBufferHistory<quint64> _starveHistory;
 
+    float _jitterLateLossTarget { DEFAULT_JITTER_LATE_LOSS_TARGET };
+    PacketDelayHistogram _delayHistogram;
+    AudioTimeStretch _timeStretch;
+    int _stretchSampleRate { AudioConstants::SAMPLE_RATE };
+    int _stretchNumChannels;
+    std::vector<int16_t> _stretchBuffer;
+    float _filteredFramesAvailable { 0.0f };
+    int _stretchedFrames { 0 };
+
     TimeWeightedAvg<int> _framesAvailableStat;
     MovingMinMaxAvg<float> _unplayedMs;
 
@@ -189,6 +219,7 @@ protected:
     QString _selectedCodecName;
     QMutex _decoderMutex;
     Decoder* _decoder { nullptr };
+    QByteArray _decodedBuffer; // one frame, decoded into for each packet; guarded by _decoderMutex too
     int _mismatchedAudioCodecCount { 0 };
 };
 
@@ -23,6 +23,7 @@ void MixedProcessedAudioStream::outputFormatChanged(int sampleRate, int channelC
     int deviceOutputFrameFrames = networkToDeviceFrames(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO / AudioConstants::STEREO);
     int deviceOutputFrameSamples = deviceOutputFrameFrames * AudioConstants::STEREO;
     _ringBuffer.resizeForFrameSize(deviceOutputFrameSamples);
+    setStretchFormat(sampleRate, channelCount);
 }
 
 int MixedProcessedAudioStream::writeDroppableSilentFrames(int silentFrames) {
@@ -80,7 +81,7 @@ int MixedProcessedAudioStream::parseAudioData(const QByteArray& packetAfterStrea
     QByteArray outputBuffer;
     emit processSamples(decodedBuffer, outputBuffer);
 
-    _ringBuffer.writeData(outputBuffer.data(), outputBuffer.size());
+    writeStretchedData(outputBuffer.data(), outputBuffer.size());
     qCDebug(audiostream, "Wrote %d samples to buffer (%d available)", outputBuffer.size() / (int)sizeof(int16_t), getSamplesAvailable());
 
     return packetAfterStreamProperties.size();
@@ -0,0 +1,93 @@
+//
+//  PacketDelayHistogram.cpp
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "PacketDelayHistogram.h"
+
+#include <algorithm>
+
+#include "AudioConstants.h"
+
+// per-packet forgetting factor, a time constant of about 20s at 100 packets per second
+static const float HISTOGRAM_FORGET = 0.9995f;
+
+// the reference creeps later by up to this much per packet, so that clock drift between sender
+// and receiver (200ppm of a frame) does not accumulate into the measured delays
+static const int64_t REFERENCE_DRIFT_USECS = 2;
+
+void PacketDelayHistogram::reset() {
+    std::fill(_buckets, _buckets + NUM_BUCKETS, 0.0f);
+    _total = 0.0f;
+    _hasReference = false;
+    _reference = 0;
+    _lastDelayFrames = 0;
+}
+
+void PacketDelayHistogram::packetArrived(uint64_t arrivalUsecs, int seqOffset) {
+    int64_t now = (int64_t)arrivalUsecs;
+
+    if (!_hasReference) {
+        _hasReference = true;
+        _reference = now;
+        seqOffset = 0;
+    }
+
+    // advance the reference for a new newest slot, or look back for a reordered one
+    int64_t expected = _reference + (int64_t)seqOffset * AudioConstants::NETWORK_FRAME_USECS;
+    if (seqOffset > 0) {
+        _reference = expected;
+    }
+
+    int64_t delay = now - expected;
+    if (delay < 0) {
+        // faster than any recent packet, so it becomes the new reference
+        _reference += delay;
+        delay = 0;
+    } else if (seqOffset > 0) {
+        _reference += std::min(delay, REFERENCE_DRIFT_USECS);
+    }
+
+    _lastDelayFrames = (int)std::min(delay / AudioConstants::NETWORK_FRAME_USECS, (int64_t)NUM_BUCKETS - 1);
+
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        _buckets[i] *= HISTOGRAM_FORGET;
+    }
+    _buckets[_lastDelayFrames] += 1.0f;
+    _total = _total * HISTOGRAM_FORGET + 1.0f;
+}
+
+int PacketDelayHistogram::getTargetFrames(float lateLossRatio) const {
+    if (_total <= 0.0f) {
+        return 1;
+    }
+
+    // a packet in bucket i, delayed by i to i+1 frames, needs i+1 frames buffered
+    float threshold = (1.0f - lateLossRatio) * _total;
+    float sum = 0.0f;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        sum += _buckets[i];
+        if (sum >= threshold) {
+            return i + 1;
+        }
+    }
+    return NUM_BUCKETS;
+}
+
+float PacketDelayHistogram::getLateLossRatio(int bufferFrames) const {
+    if (_total <= 0.0f) {
+        return 0.0f;
+    }
+
+    float late = 0.0f;
+    for (int i = std::max(bufferFrames, 0); i < NUM_BUCKETS; i++) {
+        late += _buckets[i];
+    }
+    return late / _total;
+}
@@ -0,0 +1,48 @@
+//
+//  PacketDelayHistogram.h
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_PacketDelayHistogram_h
+#define overte_PacketDelayHistogram_h
+
+#include <stdint.h>
+
+// Histogram of how late each audio packet arrives, in network frames, relative to the fastest recent packet.
+// Older arrivals are exponentially forgotten, so the histogram follows changing network conditions.
+class PacketDelayHistogram {
+public:
+    static const int NUM_BUCKETS = 64;  // 640ms
+
+    PacketDelayHistogram() { reset(); }
+
+    void reset();
+
+    /// Records a packet arriving at arrivalUsecs; seqOffset counts sequence slots since the newest packet
+    /// (1 when on time, more after losses, zero or less when reordered)
+    void packetArrived(uint64_t arrivalUsecs, int seqOffset);
+
+    /// The smallest buffer, in frames, that would have played all but lateLossRatio of the packets
+    int getTargetFrames(float lateLossRatio) const;
+
+    /// The ratio of packets that a buffer of bufferFrames would have played late
+    float getLateLossRatio(int bufferFrames) const;
+
+    int getLastDelayFrames() const { return _lastDelayFrames; }
+
+private:
+    float _buckets[NUM_BUCKETS];
+    float _total;
+
+    bool _hasReference;
+    int64_t _reference;     // expected arrival of the newest slot, for a packet with no delay
+    int _lastDelayFrames;
+};
+
+#endif // overte_PacketDelayHistogram_h
@@ -12,6 +12,7 @@
 #include "PositionalAudioStream.h"
 #include "SharedUtil.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include <QtCore/QDataStream>
@@ -42,6 +43,8 @@ PositionalAudioStream::PositionalAudioStream(PositionalAudioStream::Type type, b
 void PositionalAudioStream::resetStats() {
     _lastPopOutputTrailingLoudness = 0.0f;
     _lastPopOutputLoudness = 0.0f;
+    _voiceQuietFrames = 0;
+    _noiseFloorLoudness = 0.0f;
 }
 
 void PositionalAudioStream::updateLastPopOutputLoudnessAndTrailingLoudness() {
@@ -71,6 +74,28 @@ void PositionalAudioStream::updateLastPopOutputLoudnessAndTrailingLoudness() {
     if (_lastPopOutputLoudness < _quietestTrailingFrameLoudness) {
         _quietestTrailingFrameLoudness = _lastPopOutputLoudness;
     }
+
+    if (_voiceHangoverFrames > 0) {
+        updateVoiceActivity();
+    }
+}
+
+void PositionalAudioStream::updateVoiceActivity() {
+    // the noise floor follows quieter frames at once, and louder ones slowly (about 0.5dB/s),
+    // so that speech does not raise it but a change of room or microphone eventually does
+    const float NOISE_FLOOR_RISE = 1.0006f;
+    // voice must be 12dB above the noise floor, and above the loudness of a few LSBs of dither
+    const float VOICE_OVER_NOISE_FLOOR = 4.0f;
+    const float MIN_VOICE_LOUDNESS = 4.0f / AudioConstants::MAX_SAMPLE_VALUE;
+
+    if (_noiseFloorLoudness <= 0.0f || _lastPopOutputLoudness < _noiseFloorLoudness) {
+        _noiseFloorLoudness = std::max(_lastPopOutputLoudness, MIN_VOICE_LOUDNESS / VOICE_OVER_NOISE_FLOOR);
+    } else {
+        _noiseFloorLoudness *= NOISE_FLOOR_RISE;
+    }
+
+    bool isVoice = _lastPopOutputLoudness > _noiseFloorLoudness * VOICE_OVER_NOISE_FLOOR;
+    _voiceQuietFrames = isVoice ? 0 : std::min(_voiceQuietFrames + 1, _voiceHangoverFrames);
 }
 
 int PositionalAudioStream::parsePositionalData(const QByteArray& positionalByteArray) {
@@ -59,6 +59,11 @@ public:
     float getLastPopOutputLoudness() const { return _lastPopOutputLoudness; }
     float getQuietestFrameLoudness() const { return _quietestFrameLoudness; }
 
+    /// A stream is voice inactive after hangoverFrames in a row that are not clearly above its noise floor
+    /// (0 disables voice activity detection)
+    void setVoiceActivityHangover(int hangoverFrames) { _voiceHangoverFrames = hangoverFrames; }
+    bool isVoiceActive() const { return _voiceHangoverFrames == 0 || _voiceQuietFrames < _voiceHangoverFrames; }
+
     bool shouldLoopbackForNode() const { return _shouldLoopbackForNode; }
     bool isStereo() const { return _isStereo; }
 
@@ -88,6 +93,7 @@ protected:
 
 protected:
     void calculateIgnoreBox();
+    void updateVoiceActivity();
 
     Type _type;
     glm::vec3 _position;
@@ -107,6 +113,10 @@ protected:
     float _quietestFrameLoudness;
     int _frameCounter;
 
+    int _voiceHangoverFrames { 0 };
+    int _voiceQuietFrames { 0 };
+    float _noiseFloorLoudness { 0.0f };
+
     bool _isIgnoreBoxEnabled { false };
     IgnoreBox _ignoreBox;
 };
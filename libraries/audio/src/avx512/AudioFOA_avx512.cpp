@@ -0,0 +1,120 @@
+//
+//  AudioFOA_avx512.cpp
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifdef __AVX512F__
+
+#include <stdint.h>
+#include <assert.h>
+#include <immintrin.h>
+
+// fft-domain complex multiply-add, for packed complex-conjugate symmetric
+// 1 channel input, 2 channel output
+void rfft512_cmadd_1X2_AVX512(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]) {
+
+    // NOTE: x[n/2].re is packed into x[0].im
+    float t00 = dst0[0] + src[0] * coef0[0];    // first bin is real
+    float t01 = dst0[1] + src[1] * coef0[1];    // last bin is real
+
+    float t10 = dst1[0] + src[0] * coef1[0];    // first bin is real
+    float t11 = dst1[1] + src[1] * coef1[1];    // last bin is real
+
+    for (int i = 0; i < 512; i += 16) {
+
+        __m512 arr = _mm512_moveldup_ps(_mm512_loadu_ps(&src[i]));          // [ .. ar1 ar1 ar0 ar0 ]
+        __m512 aii = _mm512_movehdup_ps(_mm512_loadu_ps(&src[i]));          // [ .. ai1 ai1 ai0 ai0 ]
+
+        __m512 bri = _mm512_loadu_ps(&coef0[i]);                            // [ .. bi1 br1 bi0 br0 ]
+        __m512 bir = _mm512_permute_ps(bri, _MM_SHUFFLE(2,3,0,1));          // [ .. br1 bi1 br0 bi0 ]
+
+        __m512 cri = _mm512_loadu_ps(&coef1[i]);                            // [ .. ci1 cr1 ci0 cr0 ]
+        __m512 cir = _mm512_permute_ps(cri, _MM_SHUFFLE(2,3,0,1));          // [ .. cr1 ci1 cr0 ci0 ]
+
+        __m512 t0 = _mm512_mul_ps(aii, bir);
+        __m512 t1 = _mm512_mul_ps(aii, cir);
+
+        t0 = _mm512_fmaddsub_ps(arr, bri, t0);
+        t1 = _mm512_fmaddsub_ps(arr, cri, t1);
+
+        t0 = _mm512_add_ps(t0, _mm512_loadu_ps(&dst0[i]));
+        t1 = _mm512_add_ps(t1, _mm512_loadu_ps(&dst1[i]));
+
+        _mm512_storeu_ps(&dst0[i], t0);
+        _mm512_storeu_ps(&dst1[i], t1);
+    }
+
+    // fix the real values
+    dst0[0] = t00;
+    dst0[1] = t01;
+
+    dst1[0] = t10;
+    dst1[1] = t11;
+
+    _mm256_zeroupper();
+}
+
+// in-place rotation and scaling of the soundfield
+// crossfade between old and new matrix, to prevent artifacts
+void rotate_4x4_AVX512(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames) {
+
+    // matrix difference
+    const float md[4][4] = {
+        { m0[0][0] - m1[0][0], m0[0][1] - m1[0][1], m0[0][2] - m1[0][2], m0[0][3] - m1[0][3] },
+        { m0[1][0] - m1[1][0], m0[1][1] - m1[1][1], m0[1][2] - m1[1][2], m0[1][3] - m1[1][3] },
+        { m0[2][0] - m1[2][0], m0[2][1] - m1[2][1], m0[2][2] - m1[2][2], m0[2][3] - m1[2][3] },
+        { m0[3][0] - m1[3][0], m0[3][1] - m1[3][1], m0[3][2] - m1[3][2], m0[3][3] - m1[3][3] },
+    };
+
+    assert(numFrames % 16 == 0);
+
+    for (int i = 0; i < numFrames; i += 16) {
+
+        __m512 frac = _mm512_loadu_ps(&win[i]);
+
+        // interpolate the matrix
+        __m512 m00 = _mm512_fmadd_ps(frac, _mm512_set1_ps(md[0][0]), _mm512_set1_ps(m1[0][0]));
+
+        __m512 m11 = _mm512_fmadd_ps(frac, _mm512_set1_ps(md[1][1]), _mm512_set1_ps(m1[1][1]));
+        __m512 m21 = _mm512_fmadd_ps(frac, _mm512_set1_ps(md[2][1]), _mm512_set1_ps(m1[2][1]));
+        __m512 m31 = _mm512_fmadd_ps(frac, _mm512_set1_ps(md[3][1]), _mm512_set1_ps(m1[3][1]));
+
+        __m512 m12 = _mm512_fmadd_ps(frac, _mm512_set1_ps(md[1][2]), _mm512_set1_ps(m1[1][2]));
+        __m512 m22 = _mm512_fmadd_ps(frac, _mm512_set1_ps(md[2][2]), _mm512_set1_ps(m1[2][2]));
+        __m512 m32 = _mm512_fmadd_ps(frac, _mm512_set1_ps(md[3][2]), _mm512_set1_ps(m1[3][2]));
+
+        __m512 m13 = _mm512_fmadd_ps(frac, _mm512_set1_ps(md[1][3]), _mm512_set1_ps(m1[1][3]));
+        __m512 m23 = _mm512_fmadd_ps(frac, _mm512_set1_ps(md[2][3]), _mm512_set1_ps(m1[2][3]));
+        __m512 m33 = _mm512_fmadd_ps(frac, _mm512_set1_ps(md[3][3]), _mm512_set1_ps(m1[3][3]));
+
+        // matrix multiply
+        __m512 w = _mm512_mul_ps(m00, _mm512_loadu_ps(&buf[0][i]));
+
+        __m512 x = _mm512_mul_ps(m11, _mm512_loadu_ps(&buf[1][i]));
+        __m512 y = _mm512_mul_ps(m21, _mm512_loadu_ps(&buf[1][i]));
+        __m512 z = _mm512_mul_ps(m31, _mm512_loadu_ps(&buf[1][i]));
+
+        x = _mm512_fmadd_ps(m12, _mm512_loadu_ps(&buf[2][i]), x);
+        y = _mm512_fmadd_ps(m22, _mm512_loadu_ps(&buf[2][i]), y);
+        z = _mm512_fmadd_ps(m32, _mm512_loadu_ps(&buf[2][i]), z);
+
+        x = _mm512_fmadd_ps(m13, _mm512_loadu_ps(&buf[3][i]), x);
+        y = _mm512_fmadd_ps(m23, _mm512_loadu_ps(&buf[3][i]), y);
+        z = _mm512_fmadd_ps(m33, _mm512_loadu_ps(&buf[3][i]), z);
+
+        _mm512_storeu_ps(&buf[0][i], w);
+        _mm512_storeu_ps(&buf[1][i], x);
+        _mm512_storeu_ps(&buf[2][i], y);
+        _mm512_storeu_ps(&buf[3][i], z);
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
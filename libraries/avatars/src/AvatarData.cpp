@@ -65,6 +65,7 @@ const QString AvatarData::FRAME_NAME = "com.highfidelity.recording.AvatarData";
 static const int TRANSLATION_COMPRESSION_RADIX = 14;
 static const int HAND_CONTROLLER_COMPRESSION_RADIX = 12;
 static const int SENSOR_TO_WORLD_SCALE_RADIX = 10;
+static const int MAX_JOINTS_PER_PACKET = 255; // the joint count is sent in one byte
 static const float AUDIO_LOUDNESS_SCALE = 1024.0f;
 static const float DEFAULT_AVATAR_DENSITY = 1000.0f; // density of water
 
@@ -126,6 +127,94 @@ size_t AvatarDataPacket::maxJointDefaultPoseFlagsSize(size_t numJoints) {
     return totalSize;
 }
 
+// count the set bits among the first numBits, the way parseDataFromBuffer reads validity bits
+static int countValidityBits(const unsigned char* bits, int numBits) {
+    int numSet = 0;
+    for (int i = 0; i < numBits; i++) {
+        numSet += (bits[i / BITS_IN_BYTE] >> (i % BITS_IN_BYTE)) & 1;
+    }
+    return numSet;
+}
+
+int AvatarDataPacket::getRecordSize(const unsigned char* buffer, int size) {
+    const unsigned char* sourceBuffer = buffer;
+    const unsigned char* endPosition = buffer + size;
+
+    auto skip = [&](size_t numBytes) {
+        if (endPosition - sourceBuffer < (ptrdiff_t)numBytes) {
+            return false;
+        }
+        sourceBuffer += numBytes;
+        return true;
+    };
+
+    HasFlags flags;
+    if (!skip(sizeof(flags))) {
+        return -1;
+    }
+    memcpy(&flags, buffer, sizeof(flags));
+
+    // the fixed size sections, in the order parseDataFromBuffer reads them
+    if (((flags & PACKET_HAS_AVATAR_GLOBAL_POSITION) && !skip(AVATAR_GLOBAL_POSITION_SIZE)) ||
+        ((flags & PACKET_HAS_AVATAR_BOUNDING_BOX) && !skip(AVATAR_BOUNDING_BOX_SIZE)) ||
+        ((flags & PACKET_HAS_AVATAR_ORIENTATION) && !skip(AVATAR_ORIENTATION_SIZE)) ||
+        ((flags & PACKET_HAS_AVATAR_SCALE) && !skip(AVATAR_SCALE_SIZE)) ||
+        ((flags & PACKET_HAS_LOOK_AT_POSITION) && !skip(LOOK_AT_POSITION_SIZE)) ||
+        ((flags & PACKET_HAS_AUDIO_LOUDNESS) && !skip(AUDIO_LOUDNESS_SIZE)) ||
+        ((flags & PACKET_HAS_SENSOR_TO_WORLD_MATRIX) && !skip(SENSOR_TO_WORLD_SIZE)) ||
+        ((flags & PACKET_HAS_ADDITIONAL_FLAGS) && !skip(ADDITIONAL_FLAGS_SIZE)) ||
+        ((flags & PACKET_HAS_PARENT_INFO) && !skip(PARENT_INFO_SIZE)) ||
+        ((flags & PACKET_HAS_AVATAR_LOCAL_POSITION) && !skip(AVATAR_LOCAL_POSITION_SIZE)) ||
+        ((flags & PACKET_HAS_HAND_CONTROLLERS) && !skip(HAND_CONTROLLERS_SIZE))) {
+        return -1;
+    }
+
+    if (flags & PACKET_HAS_FACE_TRACKER_INFO) {
+        const unsigned char* faceTrackerInfo = sourceBuffer;
+        if (!skip(FACE_TRACKER_INFO_SIZE)) {
+            return -1;
+        }
+        int numCoefficients = reinterpret_cast<const FaceTrackerInfo*>(faceTrackerInfo)->numBlendshapeCoefficients;
+        if (!skip(numCoefficients * sizeof(float))) {
+            return -1;
+        }
+    }
+
+    if (flags & PACKET_HAS_JOINT_DATA) {
+        if (!skip(sizeof(uint8_t))) {
+            return -1;
+        }
+        int numJoints = sourceBuffer[-1];
+        const size_t bytesOfValidity = calcBitVectorSize(numJoints);
+
+        const unsigned char* rotationValidity = sourceBuffer;
+        if (!skip(bytesOfValidity) || !skip(countValidityBits(rotationValidity, numJoints) * sizeof(SixByteQuat))) {
+            return -1;
+        }
+        const unsigned char* translationValidity = sourceBuffer;
+        if (!skip(bytesOfValidity) || !skip(sizeof(float)) ||
+            !skip(countValidityBits(translationValidity, numJoints) * sizeof(SixByteTrans))) {
+            return -1;
+        }
+
+        if ((flags & PACKET_HAS_GRAB_JOINTS) && !skip(FAR_GRAB_JOINTS_SIZE)) {
+            return -1;
+        }
+    }
+
+    if (flags & PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS) {
+        if (!skip(sizeof(uint8_t))) {
+            return -1;
+        }
+        int numJoints = sourceBuffer[-1];
+        if (!skip(2 * calcBitVectorSize(numJoints))) {
+            return -1;
+        }
+    }
+
+    return (int)(sourceBuffer - buffer);
+}
+
 AvatarData::AvatarData() :
     SpatiallyNestable(NestableType::Avatar, QUuid()),
     _handPosition(0.0f),
@@ -295,6 +384,20 @@ float AvatarData::getDistanceBasedMinTranslationDistance(glm::vec3 viewerPositio
 
 
 // we want to track outbound data in this case...
+AvatarDataPacket::HasFlags AvatarData::getChangedSinceFlags(quint64 lastSentTime) const {
+    return (rotationChangedSince(lastSentTime) ? AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION : 0)
+        | (avatarBoundingBoxChangedSince(lastSentTime) ? AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX : 0)
+        | (avatarScaleChangedSince(lastSentTime) ? AvatarDataPacket::PACKET_HAS_AVATAR_SCALE : 0)
+        | (lookAtPositionChangedSince(lastSentTime) ? AvatarDataPacket::PACKET_HAS_LOOK_AT_POSITION : 0)
+        | (audioLoudnessChangedSince(lastSentTime) ? AvatarDataPacket::PACKET_HAS_AUDIO_LOUDNESS : 0)
+        | (sensorToWorldMatrixChangedSince(lastSentTime) ? AvatarDataPacket::PACKET_HAS_SENSOR_TO_WORLD_MATRIX : 0)
+        | (additionalFlagsChangedSince(lastSentTime) ? AvatarDataPacket::PACKET_HAS_ADDITIONAL_FLAGS : 0)
+        | (parentInfoChangedSince(lastSentTime) ? AvatarDataPacket::PACKET_HAS_PARENT_INFO : 0)
+        | (tranlationChangedSince(lastSentTime) || parentInfoChangedSince(lastSentTime) ?
+            AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION : 0)
+        | (faceTrackerInfoChangedSince(lastSentTime) ? AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO : 0);
+}
+
 QByteArray AvatarData::toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking) {
     auto lastSentTime = _lastToByteArray;
     _lastToByteArray = usecTimestampNow();
@@ -386,20 +489,19 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         if (sendPALMinimum) {
             hasAudioLoudness = true;
         } else {
-            hasAvatarOrientation = sendAll || rotationChangedSince(lastSentTime);
-            hasAvatarBoundingBox = sendAll || avatarBoundingBoxChangedSince(lastSentTime);
-            hasAvatarScale = sendAll || avatarScaleChangedSince(lastSentTime);
-            hasLookAtPosition = sendAll || lookAtPositionChangedSince(lastSentTime);
-            hasAudioLoudness = sendAll || audioLoudnessChangedSince(lastSentTime);
-            hasSensorToWorldMatrix = sendAll || sensorToWorldMatrixChangedSince(lastSentTime);
-            hasAdditionalFlags = sendAll || additionalFlagsChangedSince(lastSentTime);
-            hasParentInfo = sendAll || parentInfoChangedSince(lastSentTime);
-            hasAvatarLocalPosition = hasParent() && (sendAll ||
-                tranlationChangedSince(lastSentTime) ||
-                parentInfoChangedSince(lastSentTime));
+            AvatarDataPacket::HasFlags changedFlags = sendAll ? (AvatarDataPacket::HasFlags)~0 : getChangedSinceFlags(lastSentTime);
+            hasAvatarOrientation = changedFlags & AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION;
+            hasAvatarBoundingBox = changedFlags & AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX;
+            hasAvatarScale = changedFlags & AvatarDataPacket::PACKET_HAS_AVATAR_SCALE;
+            hasLookAtPosition = changedFlags & AvatarDataPacket::PACKET_HAS_LOOK_AT_POSITION;
+            hasAudioLoudness = changedFlags & AvatarDataPacket::PACKET_HAS_AUDIO_LOUDNESS;
+            hasSensorToWorldMatrix = changedFlags & AvatarDataPacket::PACKET_HAS_SENSOR_TO_WORLD_MATRIX;
+            hasAdditionalFlags = changedFlags & AvatarDataPacket::PACKET_HAS_ADDITIONAL_FLAGS;
+            hasParentInfo = changedFlags & AvatarDataPacket::PACKET_HAS_PARENT_INFO;
+            hasAvatarLocalPosition = hasParent() && (changedFlags & AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION);
             hasHandControllers = _controllerLeftHandMatrixCache.isValid() || _controllerRightHandMatrixCache.isValid();
             hasFaceTrackerInfo = !dropFaceTracking && (getHasScriptedBlendshapes() || _headData->_hasInputDrivenBlendshapes) &&
-                (sendAll || faceTrackerInfoChangedSince(lastSentTime));
+                (changedFlags & AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO);
             hasJointData = !sendMinimum;
             hasJointDefaultPoseFlags = hasJointData;
         }
@@ -750,6 +852,11 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         float minRotationDOT = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinRotationDOT(viewerPosition) : AVATAR_MIN_ROTATION_DOT;
 
+        // the rotations to send are gathered here and packed together once the loop has picked them
+        glm::quat rotationsToPack[MAX_JOINTS_PER_PACKET];
+        int numRotationsToPack = 0;
+        unsigned char* rotationsPosition = destinationBuffer;
+
         int i = sendStatus.rotationsSent;
         for (; i < numJoints; ++i) {
             const JointData& data = joints[i];
@@ -765,7 +872,8 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 #ifdef WANT_DEBUG
                         rotationSentCount++;
 #endif
-                        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+                        rotationsToPack[numRotationsToPack++] = data.rotation;
+                        destinationBuffer += sizeof(AvatarDataPacket::SixByteQuat);
 
                         if (sentJoints) {
                             sentJoints[i].rotation = data.rotation;
@@ -782,6 +890,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         }
         sendStatus.rotationsSent = i;
+        packOrientationQuatsToSixBytes(rotationsPosition, rotationsToPack, numRotationsToPack);
 
         // joint translation data
         validityPosition = destinationBuffer;
@@ -799,6 +908,10 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         float minTranslation = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinTranslationDistance(viewerPosition) : AVATAR_MIN_TRANSLATION;
 
+        glm::vec3 translationsToPack[MAX_JOINTS_PER_PACKET];
+        int numTranslationsToPack = 0;
+        unsigned char* translationsPosition = destinationBuffer;
+
         i = sendStatus.translationsSent;
         for (; i < numJoints; ++i) {
             const JointData& data = joints[i];
@@ -813,8 +926,8 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 #ifdef WANT_DEBUG
                         translationSentCount++;
 #endif
-                        destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation / maxTranslationDimension,
-                                                                               TRANSLATION_COMPRESSION_RADIX);
+                        translationsToPack[numTranslationsToPack++] = data.translation / maxTranslationDimension;
+                        destinationBuffer += sizeof(AvatarDataPacket::SixByteTrans);
 
                         if (sentJoints) {
                             sentJoints[i].translation = data.translation;
@@ -831,6 +944,8 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         }
         sendStatus.translationsSent = i;
+        packFloatVec3sToSignedTwoByteFixed(translationsPosition, translationsToPack, numTranslationsToPack,
+                                           TRANSLATION_COMPRESSION_RADIX);
 
         IF_AVATAR_SPACE(PACKET_HAS_GRAB_JOINTS, sizeof (AvatarDataPacket::FarGrabJoints)) {
             // the far-grab joints may range further than 3 meters, so we can't use packFloatVec3ToSignedTwoByteFixed etc
@@ -1375,10 +1490,14 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
 
         const int COMPRESSED_QUATERNION_SIZE = 6;
         PACKET_READ_CHECK(JointRotations, numValidJointRotations * COMPRESSED_QUATERNION_SIZE);
-        for (int i = 0; i < numJoints; i++) {
+
+        // unpack all the rotations together, then scatter them to their joints
+        glm::quat unpackedRotations[MAX_JOINTS_PER_PACKET];
+        sourceBuffer += unpackOrientationQuatsFromSixBytes(sourceBuffer, unpackedRotations, numValidJointRotations);
+        for (int i = 0, j = 0; i < numJoints; i++) {
             JointData& data = _jointData[i];
             if (validRotations[i]) {
-                sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
+                data.rotation = unpackedRotations[j++];
                 _hasNewJointData = true;
                 data.rotationIsDefaultPose = false;
             }
@@ -1416,11 +1535,13 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
         const int COMPRESSED_TRANSLATION_SIZE = 6;
         PACKET_READ_CHECK(JointTranslation, numValidJointTranslations * COMPRESSED_TRANSLATION_SIZE);
 
-        for (int i = 0; i < numJoints; i++) {
+        glm::vec3 unpackedTranslations[MAX_JOINTS_PER_PACKET];
+        sourceBuffer += unpackFloatVec3sFromSignedTwoByteFixed(sourceBuffer, unpackedTranslations, numValidJointTranslations,
+                                                               TRANSLATION_COMPRESSION_RADIX);
+        for (int i = 0, j = 0; i < numJoints; i++) {
             JointData& data = _jointData[i];
             if (validTranslations[i]) {
-                sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
-                data.translation *= maxTranslationDimension;
+                data.translation = unpackedTranslations[j++] * maxTranslationDimension;
                 _hasNewJointData = true;
                 data.translationIsDefaultPose = false;
             }
@@ -2665,6 +2786,7 @@ void AvatarData::clearRecordingBasis() {
 static const QString JSON_AVATAR_BASIS = QStringLiteral("basisTransform");
 static const QString JSON_AVATAR_RELATIVE = QStringLiteral("relativeTransform");
 static const QString JSON_AVATAR_JOINT_ARRAY = QStringLiteral("jointArray");
+static const QString JSON_AVATAR_JOINT_DATA = QStringLiteral("jointData");
 static const QString JSON_AVATAR_HEAD = QStringLiteral("head");
 static const QString JSON_AVATAR_HEAD_MODEL = QStringLiteral("headModel");
 static const QString JSON_AVATAR_BODY_MODEL = QStringLiteral("bodyModel");
@@ -2680,7 +2802,8 @@ enum class JsonAvatarFrameVersion : int {
     JointRotationsInAbsoluteFrame,
     JointDefaultPoseBits,
     JointUnscaledTranslations,
-    ARKitBlendshapes
+    ARKitBlendshapes,
+    QuantizedJoints
 };
 
 QJsonValue toJsonValue(const JointData& joint) {
@@ -2718,6 +2841,103 @@ JointData jointDataFromJsonValue(int version, const QJsonValue& json) {
     return result;
 }
 
+// The joints of the recorded frames are packed as the avatar data packets pack them: their count, the bits of the
+// rotations and of the translations that aren't at their default pose, the rotations in six bytes each, then the scale
+// of the translations and the translations in six bytes each.  The joints at their default pose only take their bits.
+static QByteArray packRecordedJoints(const QVector<JointData>& joints) {
+    const int numJoints = joints.size();
+    const int bitVectorSize = calcBitVectorSize(numJoints);
+
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> translations;
+    QByteArray rotationBits(bitVectorSize, 0);
+    QByteArray translationBits(bitVectorSize, 0);
+    float maxTranslationDimension = 0.001f;
+    for (int i = 0; i < numJoints; i++) {
+        const JointData& joint = joints[i];
+        if (!joint.rotationIsDefaultPose) {
+            rotationBits[i / BITS_IN_BYTE] = rotationBits[i / BITS_IN_BYTE] | (1 << (i % BITS_IN_BYTE));
+            rotations.push_back(joint.rotation);
+        }
+        if (!joint.translationIsDefaultPose) {
+            translationBits[i / BITS_IN_BYTE] = translationBits[i / BITS_IN_BYTE] | (1 << (i % BITS_IN_BYTE));
+            translations.push_back(joint.translation);
+            maxTranslationDimension = glm::max(fabsf(joint.translation.x), maxTranslationDimension);
+            maxTranslationDimension = glm::max(fabsf(joint.translation.y), maxTranslationDimension);
+            maxTranslationDimension = glm::max(fabsf(joint.translation.z), maxTranslationDimension);
+        }
+    }
+    for (auto& translation : translations) {
+        translation /= maxTranslationDimension;
+    }
+
+    const int COMPRESSED_SIZE = 6;
+    QByteArray result((int)(sizeof(uint16_t) + 2 * bitVectorSize + COMPRESSED_SIZE * rotations.size() + sizeof(float) +
+                            COMPRESSED_SIZE * translations.size()), 0);
+    unsigned char* destinationBuffer = reinterpret_cast<unsigned char*>(result.data());
+    uint16_t count = (uint16_t)numJoints;
+    memcpy(destinationBuffer, &count, sizeof(uint16_t));
+    destinationBuffer += sizeof(uint16_t);
+    memcpy(destinationBuffer, rotationBits.constData(), bitVectorSize);
+    destinationBuffer += bitVectorSize;
+    memcpy(destinationBuffer, translationBits.constData(), bitVectorSize);
+    destinationBuffer += bitVectorSize;
+    destinationBuffer += packOrientationQuatsToSixBytes(destinationBuffer, rotations.data(), (int)rotations.size());
+    memcpy(destinationBuffer, &maxTranslationDimension, sizeof(float));
+    destinationBuffer += sizeof(float);
+    packFloatVec3sToSignedTwoByteFixed(destinationBuffer, translations.data(), (int)translations.size(), TRANSLATION_COMPRESSION_RADIX);
+    return result;
+}
+
+static bool unpackRecordedJoints(const QByteArray& data, QVector<JointData>& joints) {
+    const unsigned char* sourceBuffer = reinterpret_cast<const unsigned char*>(data.constData());
+    const unsigned char* end = sourceBuffer + data.size();
+    uint16_t numJoints;
+    if (end - sourceBuffer < (ptrdiff_t)sizeof(uint16_t)) {
+        return false;
+    }
+    memcpy(&numJoints, sourceBuffer, sizeof(uint16_t));
+    sourceBuffer += sizeof(uint16_t);
+
+    const int bitVectorSize = calcBitVectorSize(numJoints);
+    if (end - sourceBuffer < 2 * bitVectorSize) {
+        return false;
+    }
+    const unsigned char* rotationBits = sourceBuffer;
+    const unsigned char* translationBits = sourceBuffer + bitVectorSize;
+    sourceBuffer += 2 * bitVectorSize;
+
+    joints.resize(numJoints);
+    int numRotations = 0;
+    int numTranslations = 0;
+    for (int i = 0; i < numJoints; i++) {
+        JointData& joint = joints[i];
+        joint.rotationIsDefaultPose = !(rotationBits[i / BITS_IN_BYTE] & (1 << (i % BITS_IN_BYTE)));
+        joint.translationIsDefaultPose = !(translationBits[i / BITS_IN_BYTE] & (1 << (i % BITS_IN_BYTE)));
+        numRotations += joint.rotationIsDefaultPose ? 0 : 1;
+        numTranslations += joint.translationIsDefaultPose ? 0 : 1;
+    }
+
+    const int COMPRESSED_SIZE = 6;
+    if (end - sourceBuffer < (ptrdiff_t)(COMPRESSED_SIZE * (numRotations + numTranslations) + sizeof(float))) {
+        return false;
+    }
+    std::vector<glm::quat> rotations(numRotations);
+    sourceBuffer += unpackOrientationQuatsFromSixBytes(sourceBuffer, rotations.data(), numRotations);
+    float maxTranslationDimension;
+    memcpy(&maxTranslationDimension, sourceBuffer, sizeof(float));
+    sourceBuffer += sizeof(float);
+    std::vector<glm::vec3> translations(numTranslations);
+    unpackFloatVec3sFromSignedTwoByteFixed(sourceBuffer, translations.data(), numTranslations, TRANSLATION_COMPRESSION_RADIX);
+
+    for (int i = 0, j = 0, k = 0; i < numJoints; i++) {
+        JointData& joint = joints[i];
+        joint.rotation = joint.rotationIsDefaultPose ? glm::quat() : rotations[j++];
+        joint.translation = joint.translationIsDefaultPose ? glm::vec3(0.0f) : translations[k++] * maxTranslationDimension;
+    }
+    return true;
+}
+
 void AvatarData::avatarEntityDataToJson(QJsonObject& root) const {
     // overridden where needed
 }
@@ -2725,7 +2945,7 @@ void AvatarData::avatarEntityDataToJson(QJsonObject& root) const {
 QJsonObject AvatarData::toJson() const {
     QJsonObject root;
 
-    root[JSON_AVATAR_VERSION] = (int)JsonAvatarFrameVersion::ARKitBlendshapes;
+    root[JSON_AVATAR_VERSION] = (int)JsonAvatarFrameVersion::QuantizedJoints;
 
     if (!getSkeletonModelURL().isEmpty()) {
         root[JSON_AVATAR_BODY_MODEL] = getSkeletonModelURL().toString();
@@ -2759,12 +2979,8 @@ QJsonObject AvatarData::toJson() const {
         root[JSON_AVATAR_SCALE] = scale;
     }
 
-    // Skeleton pose
-    QJsonArray jointArray;
-    for (const auto& joint : getRawJointData()) {
-        jointArray.push_back(toJsonValue(joint));
-    }
-    root[JSON_AVATAR_JOINT_ARRAY] = jointArray;
+    // Skeleton pose, quantized rather than as an array of numbers for each joint
+    root[JSON_AVATAR_JOINT_DATA] = QString::fromLatin1(packRecordedJoints(getRawJointData()).toBase64());
 
     const HeadData* head = getHeadData();
     if (head) {
@@ -2863,7 +3079,17 @@ void AvatarData::fromJson(const QJsonObject& json, bool useFrameSkeleton) {
         }
     }
 
-    if (json.contains(JSON_AVATAR_JOINT_ARRAY)) {
+    if (json.contains(JSON_AVATAR_JOINT_DATA)) {
+        QVector<JointData> jointArray;
+        if (unpackRecordedJoints(QByteArray::fromBase64(json[JSON_AVATAR_JOINT_DATA].toString().toLatin1()), jointArray)) {
+            setRawJointData(jointArray);
+        } else {
+            quint64 now = usecTimestampNow();
+            if (shouldLogError(now)) {
+                qCWarning(avatars) << "Invalid joint data in avatar recording";
+            }
+        }
+    } else if (json.contains(JSON_AVATAR_JOINT_ARRAY)) {
         if (version == (int)JsonAvatarFrameVersion::JointRotationsInRelativeFrame) {
             // because we don't have the full joint hierarchy skeleton of the model,
             // we can't properly convert from relative rotations into absolute rotations.
@@ -367,6 +367,10 @@ namespace AvatarDataPacket {
     */
     size_t maxJointDefaultPoseFlagsSize(size_t numJoints);
 
+    // Size of the avatar data record at the start of buffer, found from its flags and validity bits without decoding it,
+    // or -1 if the record is truncated
+    int getRecordSize(const unsigned char* buffer, int size);
+
     PACKED_BEGIN struct FarGrabJoints {
         float leftFarGrabPosition[3]; // left controller far-grab joint position
         float leftFarGrabRotation[4]; // left controller far-grab joint rotation
@@ -636,6 +640,10 @@ public:
 
     virtual void doneEncoding(bool cullSmallChanges);
 
+    // The sections that have changed since lastSentTime. For MinimumData and PALMinimum, which carry no joint deltas,
+    // these flags and the detail level fully determine what toByteArray() encodes, whoever the viewer is.
+    AvatarDataPacket::HasFlags getChangedSinceFlags(quint64 lastSentTime) const;
+
     /// \return true if an error should be logged
     bool shouldLogError(const quint64& now);
 
@@ -13,10 +13,15 @@
 
 #include <QtCore/QDataStream>
 
+#include <unordered_set>
+
+#include <tbb/parallel_for.h>
+
 #include <NodeList.h>
 #include <udt/PacketHeaders.h>
 #include <PerfStat.h>
 #include <SharedUtil.h>
+#include <UUIDHasher.h>
 
 #include "AvatarLogging.h"
 #include "AvatarTraits.h"
@@ -242,14 +247,87 @@ AvatarSharedPointer AvatarHashMap::findAvatar(const QUuid& sessionUUID) const {
     return nullptr;
 }
 
+// below this many avatars in a packet, parsing them in parallel costs more than it saves
+static const size_t MIN_AVATAR_RECORDS_TO_PARSE_IN_PARALLEL = 8;
+
 void AvatarHashMap::processAvatarDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     DETAILED_PROFILE_RANGE(network, __FUNCTION__);
     PerformanceTimer perfTimer("receiveAvatar");
-    // enumerate over all of the avatars in this packet
+    auto start = usecTimestampNow();
+
+    // Split the packet into its avatar records, finding or creating each avatar here as before,
+    // then have the avatars parse their records in parallel. Every record belongs to a different avatar.
+    struct AvatarRecord {
+        QUuid sessionUUID;
+        AvatarSharedPointer avatar;
+        QByteArray data;
+    };
+    std::vector<AvatarRecord> records;
+    std::unordered_set<QUuid> recordUUIDs;
+    bool hasRepeatedAvatar = false;
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    while (message->getBytesLeftToRead()) {
+        int positionBeforeUUID = message->getPosition();
+        QUuid sessionUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+
+        int positionBeforeRead = message->getPosition();
+        QByteArray byteArray = message->readWithoutCopy(message->getBytesLeftToRead());
+        int recordSize = AvatarDataPacket::getRecordSize(reinterpret_cast<const unsigned char*>(byteArray.constData()),
+                                                         byteArray.size());
+        if (recordSize < 0) {
+            // a truncated record, leave it and the rest of the packet to the serial parse and its error handling
+            message->seek(positionBeforeUUID);
+            break;
+        }
+        message->seek(positionBeforeRead + recordSize);
+
+        if (sessionUUID != _lastOwnerSessionUUID && (!nodeList->isIgnoringNode(sessionUUID) || nodeList->getRequestsDomainListData())) {
+            bool isNewAvatar;
+            auto avatar = newOrExistingAvatar(sessionUUID, sendingNode, isNewAvatar);
+            if (isNewAvatar) {
+                QWriteLocker locker(&_hashLock);
+                avatar->setIsNewAvatar(true);
+                auto replicaIDs = _replicas.getReplicaIDs(sessionUUID);
+                for (auto replicaID : replicaIDs) {
+                    auto replicaAvatar = addAvatar(replicaID, sendingNode);
+                    replicaAvatar->setIsNewAvatar(true);
+                    _replicas.addReplica(sessionUUID, replicaAvatar);
+                }
+            }
+            // the message outlives the records, so they can share its bytes
+            records.push_back({ sessionUUID, avatar, QByteArray::fromRawData(byteArray.constData(), recordSize) });
+            hasRepeatedAvatar |= !recordUUIDs.insert(sessionUUID).second;
+        } else {
+            // Shouldn't happen if mixer functioning correctly - debugging for BUGZ-781:
+            qCDebug(avatars) << "Discarding received avatar data" << sessionUUID << (sessionUUID == _lastOwnerSessionUUID ? "(is self)" : "")
+                << "isIgnoringNode = " << nodeList->isIgnoringNode(sessionUUID);
+        }
+    }
+
+    auto parseRecord = [this](const AvatarRecord& record) {
+        record.avatar->parseDataFromBuffer(record.data);
+        _replicas.parseDataFromBuffer(record.sessionUUID, record.data);
+    };
+    if (records.size() >= MIN_AVATAR_RECORDS_TO_PARSE_IN_PARALLEL && !hasRepeatedAvatar) {
+        tbb::parallel_for((size_t)0, records.size(), [&](size_t i) { parseRecord(records[i]); });
+    } else {
+        for (const auto& record : records) {
+            parseRecord(record);
+        }
+    }
+
+    // enumerate over any avatars left in this packet
     // only add them if mixerWeakPointer points to something (meaning that mixer is still around)
     while (message->getBytesLeftToRead()) {
         parseAvatarData(message, sendingNode);
     }
+
+    _avatarDataParseUsecs += usecTimestampNow() - start;
+}
+
+quint64 AvatarHashMap::takeAvatarDataParseUsecs() {
+    return _avatarDataParseUsecs.exchange(0);
 }
 
 AvatarSharedPointer AvatarHashMap::parseAvatarData(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
@@ -438,19 +516,41 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
                     return;
                 }
 
-                auto& processedInstanceVersion = lastProcessedVersions.getInstanceValueRef(traitType, traitInstanceID);
-                if (packetTraitVersion > processedInstanceVersion) {
-                    if (traitBinarySize == AvatarTraits::DELETED_TRAIT_SIZE) {
-                        avatar->processDeletedTraitInstance(traitType, traitInstanceID);
-                        _replicas.processDeletedTraitInstance(avatarID, traitType, traitInstanceID);
+                if (traitType == AvatarTraits::AvatarEntityDelta) {
+                    // a delta is versioned as the avatar entity it changes, and applies to the version we have of it
+                    auto& processedInstanceVersion =
+                        lastProcessedVersions.getInstanceValueRef(AvatarTraits::AvatarEntity, traitInstanceID);
+                    if (packetTraitVersion > processedInstanceVersion && traitBinarySize > 0) {
+                        auto delta = message->read(traitBinarySize);
+                        QByteArray traitData;
+                        if (AvatarTraits::getAvatarEntityDeltaBase(delta) == processedInstanceVersion &&
+                            AvatarTraits::patchAvatarEntityData(
+                                avatar->packTraitInstance(AvatarTraits::AvatarEntity, traitInstanceID), delta, traitData)) {
+                            avatar->processTraitInstance(AvatarTraits::AvatarEntity, traitInstanceID, traitData);
+                            _replicas.processTraitInstance(avatarID, AvatarTraits::AvatarEntity, traitInstanceID, traitData);
+                            processedInstanceVersion = packetTraitVersion;
+                        } else {
+                            qCDebug(avatars) << "Dropping avatar entity delta for" << traitInstanceID
+                                             << "that doesn't apply to version" << processedInstanceVersion;
+                        }
                     } else {
-                        auto traitData = message->read(traitBinarySize);
-                        avatar->processTraitInstance(traitType, traitInstanceID, traitData);
-                        _replicas.processTraitInstance(avatarID, traitType, traitInstanceID, traitData);
+                        skipBinaryTrait = true;
                     }
-                    processedInstanceVersion = packetTraitVersion;
                 } else {
-                    skipBinaryTrait = true;
+                    auto& processedInstanceVersion = lastProcessedVersions.getInstanceValueRef(traitType, traitInstanceID);
+                    if (packetTraitVersion > processedInstanceVersion) {
+                        if (traitBinarySize == AvatarTraits::DELETED_TRAIT_SIZE) {
+                            avatar->processDeletedTraitInstance(traitType, traitInstanceID);
+                            _replicas.processDeletedTraitInstance(avatarID, traitType, traitInstanceID);
+                        } else {
+                            auto traitData = message->read(traitBinarySize);
+                            avatar->processTraitInstance(traitType, traitInstanceID, traitData);
+                            _replicas.processTraitInstance(avatarID, traitType, traitInstanceID, traitData);
+                        }
+                        processedInstanceVersion = packetTraitVersion;
+                    } else {
+                        skipBinaryTrait = true;
+                    }
                 }
             }
 
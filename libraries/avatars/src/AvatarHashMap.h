@@ -17,6 +17,7 @@
 #include <QtCore/QSharedPointer>
 #include <QtCore/QUuid>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <chrono>
@@ -242,8 +243,12 @@ protected:
     std::unordered_map<QUuid, AvatarTraits::TraitVersions> _processedTraitVersions;
     AvatarReplicas _replicas;
 
+    // returns, and resets, the time spent parsing avatar data packets since the last call
+    quint64 takeAvatarDataParseUsecs();
+
 private:
     QUuid _lastOwnerSessionUUID;
+    std::atomic<quint64> _avatarDataParseUsecs { 0 };
 };
 
 #endif // hifi_AvatarHashMap_h
@@ -64,8 +64,12 @@ namespace AvatarTraits {
                              ExtendedIODevice& destination, AvatarData& avatar) {
         // Call packer function
         auto traitBinaryData = avatar.packTraitInstance(traitType, traitInstanceID);
-        auto traitBinaryDataSize = traitBinaryData.size();
+        return packTraitInstance(traitType, traitInstanceID, destination, traitBinaryData);
+    }
 
+    qint64 packTraitInstance(TraitType traitType, TraitInstanceID traitInstanceID,
+                             ExtendedIODevice& destination, const QByteArray& traitBinaryData) {
+        auto traitBinaryDataSize = traitBinaryData.size();
 
         // Verify packed data
         if (traitBinaryDataSize > AvatarTraits::MAXIMUM_TRAIT_SIZE) {
@@ -94,8 +98,13 @@ namespace AvatarTraits {
                                       AvatarData& avatar) {
         // Call packer function
         auto traitBinaryData = avatar.packTraitInstance(traitType, traitInstanceID);
-        auto traitBinaryDataSize = traitBinaryData.size();
+        return packVersionedTraitInstance(traitType, traitInstanceID, destination, traitVersion, traitBinaryData);
+    }
 
+    qint64 packVersionedTraitInstance(TraitType traitType, TraitInstanceID traitInstanceID,
+                                      ExtendedIODevice& destination, TraitVersion traitVersion,
+                                      const QByteArray& traitBinaryData) {
+        auto traitBinaryDataSize = traitBinaryData.size();
 
         // Verify packed data
         if (traitBinaryDataSize > AvatarTraits::MAXIMUM_TRAIT_SIZE) {
@@ -132,4 +141,110 @@ namespace AvatarTraits {
         bytesWritten += destination.writePrimitive(DELETED_TRAIT_SIZE);
         return bytesWritten;
     }
+
+    // a span is the offset and length of the bytes of the base it replaces and the length of the bytes replacing them,
+    // which follow it
+    using SpanSize = uint16_t;
+    const int SPAN_HEADER_SIZE = 3 * sizeof(SpanSize);
+
+    static void appendSpan(QByteArray& delta, int offset, int removedSize, const char* inserted, int insertedSize) {
+        SpanSize header[] = { (SpanSize)offset, (SpanSize)removedSize, (SpanSize)insertedSize };
+        delta.append(reinterpret_cast<const char*>(header), SPAN_HEADER_SIZE);
+        delta.append(inserted, insertedSize);
+    }
+
+    QByteArray diffAvatarEntityData(TraitVersion baseVersion, const QByteArray& base, const QByteArray& data) {
+        if (base.size() > MAXIMUM_TRAIT_SIZE || data.size() > MAXIMUM_TRAIT_SIZE) {
+            return QByteArray();
+        }
+
+        QByteArray delta;
+        delta.append(reinterpret_cast<const char*>(&baseVersion), sizeof(TraitVersion));
+
+        const int baseSize = base.size();
+        const int dataSize = data.size();
+        const int commonSize = std::min(baseSize, dataSize);
+        int prefixSize = 0;
+        while (prefixSize < commonSize && base[prefixSize] == data[prefixSize]) {
+            prefixSize++;
+        }
+        int suffixSize = 0;
+        while (suffixSize < commonSize - prefixSize && base[baseSize - 1 - suffixSize] == data[dataSize - 1 - suffixSize]) {
+            suffixSize++;
+        }
+        const int baseEnd = baseSize - suffixSize;
+        const int dataEnd = dataSize - suffixSize;
+
+        if (baseSize == dataSize) {
+            // the layout is unchanged, so each run of changed bytes is a span, joined with the next when the bytes between
+            // them are fewer than a span header
+            int offset = prefixSize;
+            while (offset < baseEnd) {
+                if (base[offset] == data[offset]) {
+                    offset++;
+                    continue;
+                }
+                int end = offset + 1;
+                for (int i = end; i < baseEnd && i - end < SPAN_HEADER_SIZE; i++) {
+                    if (base[i] != data[i]) {
+                        end = i + 1;
+                    }
+                }
+                appendSpan(delta, offset, end - offset, data.constData() + offset, end - offset);
+                offset = end;
+            }
+        } else {
+            // a property changed size, everything between the unchanged ends is replaced
+            appendSpan(delta, prefixSize, baseEnd - prefixSize, data.constData() + prefixSize, dataEnd - prefixSize);
+        }
+
+        if (delta.size() > dataSize / 2) {
+            return QByteArray();
+        }
+        return delta;
+    }
+
+    TraitVersion getAvatarEntityDeltaBase(const QByteArray& delta) {
+        if (delta.size() < (int)sizeof(TraitVersion)) {
+            return NULL_TRAIT_VERSION;
+        }
+        TraitVersion baseVersion;
+        memcpy(&baseVersion, delta.constData(), sizeof(TraitVersion));
+        return baseVersion;
+    }
+
+    bool patchAvatarEntityData(const QByteArray& base, const QByteArray& delta, QByteArray& data) {
+        if (delta.size() < (int)sizeof(TraitVersion)) {
+            return false;
+        }
+
+        data.clear();
+        data.reserve(base.size());
+
+        int position = sizeof(TraitVersion);
+        int baseOffset = 0;
+        while (position < delta.size()) {
+            if (delta.size() - position < SPAN_HEADER_SIZE) {
+                return false;
+            }
+            SpanSize header[3];
+            memcpy(header, delta.constData() + position, SPAN_HEADER_SIZE);
+            position += SPAN_HEADER_SIZE;
+
+            int offset = header[0];
+            int removedSize = header[1];
+            int insertedSize = header[2];
+            if (offset < baseOffset || offset + removedSize > base.size() || insertedSize > delta.size() - position) {
+                return false;
+            }
+
+            data.append(base.constData() + baseOffset, offset - baseOffset);
+            data.append(delta.constData() + position, insertedSize);
+            position += insertedSize;
+            baseOffset = offset + removedSize;
+        }
+        data.append(base.constData() + baseOffset, base.size() - baseOffset);
+
+        return data.size() <= MAXIMUM_TRAIT_SIZE;
+    }
 };
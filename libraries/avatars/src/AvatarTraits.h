@@ -17,6 +17,7 @@
 #include <array>
 #include <vector>
 
+#include <QtCore/QByteArray>
 #include <QtCore/QUuid>
 
 class ExtendedIODevice;
@@ -36,7 +37,11 @@ namespace AvatarTraits {
         Grab,
 
         // Traits count
-        TotalTraitTypes
+        TotalTraitTypes,
+
+        // Sent in place of an AvatarEntity instance when only part of its data changed, and versioned as that instance.
+        // It isn't a trait of its own, so it is left out of the count.
+        AvatarEntityDelta = TotalTraitTypes
     };
 
     const int NUM_SIMPLE_TRAITS = (int)FirstInstancedTrait;
@@ -67,13 +72,31 @@ namespace AvatarTraits {
 
     qint64 packTraitInstance(TraitType traitType, TraitInstanceID traitInstanceID,
                              ExtendedIODevice& destination, AvatarData& avatar);
+    qint64 packTraitInstance(TraitType traitType, TraitInstanceID traitInstanceID,
+                             ExtendedIODevice& destination, const QByteArray& traitBinaryData);
     qint64 packVersionedTraitInstance(TraitType traitType, TraitInstanceID traitInstanceID,
                                       ExtendedIODevice& destination, TraitVersion traitVersion,
                                       AvatarData& avatar);
+    qint64 packVersionedTraitInstance(TraitType traitType, TraitInstanceID traitInstanceID,
+                                      ExtendedIODevice& destination, TraitVersion traitVersion,
+                                      const QByteArray& traitBinaryData);
 
     qint64 packInstancedTraitDelete(TraitType traitType, TraitInstanceID instanceID, ExtendedIODevice& destination,
                                            TraitVersion traitVersion = NULL_TRAIT_VERSION);
 
+    // An AvatarEntityDelta is the version of the instance it applies to, followed by the spans of that instance's data
+    // that it replaces. An entity's properties are packed in a fixed order, so when only fixed size properties change,
+    // like the transform of a moving entity, the spans are just those properties.
+
+    // Returns a null QByteArray when the spans wouldn't be much smaller than the data itself
+    QByteArray diffAvatarEntityData(TraitVersion baseVersion, const QByteArray& base, const QByteArray& data);
+    // NULL_TRAIT_VERSION if the delta is malformed
+    TraitVersion getAvatarEntityDeltaBase(const QByteArray& delta);
+    bool patchAvatarEntityData(const QByteArray& base, const QByteArray& delta, QByteArray& data);
+
+    // the number of deltas sent in a row before the whole data is sent again, so that a peer that couldn't apply one catches up
+    const int MAX_AVATAR_ENTITY_DELTAS = 16;
+
 };
 
 #endif // hifi_AvatarTraits_h
@@ -15,9 +15,13 @@
 
 #include <NodeList.h>
 #include <NLPacketList.h>
+#include <SharedUtil.h>
 
 #include "AvatarData.h"
 
+// changes made within this window after a send (e.g. an avatar entity being dragged) go out together in the next one
+static const quint64 MIN_TRAITS_SEND_INTERVAL_USECS = 100 * USECS_PER_MSEC;
+
 ClientTraitsHandler::ClientTraitsHandler(AvatarData* owningAvatar) :
     _owningAvatar(owningAvatar)
 {
@@ -62,6 +66,9 @@ void ClientTraitsHandler::resetForNewMixer() {
     // reset the trait statuses
     _traitStatuses.reset();
 
+    // the new mixer has none of our avatar entities to apply deltas to
+    _sentAvatarEntities.clear();
+
     // pre-fill the instanced statuses that we will need to send next frame
     _owningAvatar->prepareResetTraitInstances();
 }
@@ -70,7 +77,10 @@ int ClientTraitsHandler::sendChangedTraitsToMixer() {
     std::unique_lock<Mutex> lock(_traitLock);
     int bytesWritten = 0;
 
-    if (hasChangedTraits() || _shouldPerformInitialSend) {
+    auto now = usecTimestampNow();
+    bool shouldCoalesce = !_shouldPerformInitialSend && now - _lastTraitsSendTime < MIN_TRAITS_SEND_INTERVAL_USECS;
+
+    if ((hasChangedTraits() && !shouldCoalesce) || _shouldPerformInitialSend) {
         // we have at least one changed trait to send
 
         auto nodeList = DependencyManager::get<NodeList>();
@@ -86,6 +96,7 @@ int ClientTraitsHandler::sendChangedTraitsToMixer() {
         // bump and write the current trait version to an extended header
         // the trait version is the same for all traits in this packet list
         traitsPacketList->writePrimitive(++_currentTraitVersion);
+        auto traitVersion = _currentTraitVersion;
 
         // take a copy of the set of changed traits and clear the stored set
         auto traitStatusesCopy { _traitStatuses };
@@ -95,6 +106,7 @@ int ClientTraitsHandler::sendChangedTraitsToMixer() {
         // if this was an initial send of all traits, consider it completed
         bool initialSend = _shouldPerformInitialSend;
         _shouldPerformInitialSend = false;
+        _lastTraitsSendTime = now;
 
         // we can release the lock here since we've taken a copy of statuses
         // and will setup the packet using the information in the copy
@@ -125,13 +137,22 @@ int ClientTraitsHandler::sendChangedTraitsToMixer() {
                     || instanceIDValuePair.value == Updated) {
                     // this is a changed trait we need to send or we haven't send out trait information yet
                     // ask the owning avatar to pack it
-                    bytesWritten += AvatarTraits::packTraitInstance(instancedIt->traitType, instanceIDValuePair.id,
-                                                                    *traitsPacketList, *_owningAvatar);
+                    if (instancedIt->traitType == AvatarTraits::AvatarEntity) {
+                        bytesWritten += packAvatarEntity(instanceIDValuePair.id, *traitsPacketList, traitVersion,
+                                                         initialSend);
+                    } else {
+                        bytesWritten += AvatarTraits::packTraitInstance(instancedIt->traitType, instanceIDValuePair.id,
+                                                                        *traitsPacketList, *_owningAvatar);
+                    }
 
                 } else if (!initialSend && instanceIDValuePair.value == Deleted) {
                     // pack delete for this trait instance
                     bytesWritten += AvatarTraits::packInstancedTraitDelete(instancedIt->traitType, instanceIDValuePair.id,
                                                            *traitsPacketList);
+                    if (instancedIt->traitType == AvatarTraits::AvatarEntity) {
+                        Lock lock(_traitLock);
+                        _sentAvatarEntities.erase(instanceIDValuePair.id);
+                    }
                 }
             }
 
@@ -144,6 +165,54 @@ int ClientTraitsHandler::sendChangedTraitsToMixer() {
     return bytesWritten;
 }
 
+qint64 ClientTraitsHandler::packAvatarEntity(AvatarTraits::TraitInstanceID instanceID, ExtendedIODevice& destination,
+                                             AvatarTraits::TraitVersion traitVersion, bool initialSend) {
+    auto data = _owningAvatar->packTraitInstance(AvatarTraits::AvatarEntity, instanceID);
+
+    Lock lock(_traitLock);
+    auto sentIt = _sentAvatarEntities.find(instanceID);
+    if (data.isNull()) {
+        // removed since it was marked, which packs as a delete
+        if (sentIt != _sentAvatarEntities.end()) {
+            _sentAvatarEntities.erase(sentIt);
+        }
+        return AvatarTraits::packTraitInstance(AvatarTraits::AvatarEntity, instanceID, destination, data);
+    }
+
+    if (!initialSend && sentIt != _sentAvatarEntities.end()) {
+        auto& sent = sentIt->second;
+        if (data == sent.data) {
+            return 0;
+        }
+
+        // most changes, like the transform of a held or animated entity, touch a few properties, so only those go out
+        if (sent.numDeltas < AvatarTraits::MAX_AVATAR_ENTITY_DELTAS) {
+            auto delta = AvatarTraits::diffAvatarEntityData(sent.version, sent.data, data);
+            if (!delta.isNull()) {
+                qint64 bytesWritten = AvatarTraits::packTraitInstance(AvatarTraits::AvatarEntityDelta, instanceID,
+                                                                      destination, delta);
+                if (bytesWritten > 0) {
+                    sent.data = data;
+                    sent.version = traitVersion;
+                    sent.numDeltas++;
+                    return bytesWritten;
+                }
+            }
+        }
+    }
+
+    qint64 bytesWritten = AvatarTraits::packTraitInstance(AvatarTraits::AvatarEntity, instanceID, destination, data);
+    if (bytesWritten > 0) {
+        auto& sent = _sentAvatarEntities[instanceID];
+        sent.data = data;
+        sent.version = traitVersion;
+        sent.numDeltas = 0;
+    } else if (sentIt != _sentAvatarEntities.end()) {
+        _sentAvatarEntities.erase(sentIt);
+    }
+    return bytesWritten;
+}
+
 void ClientTraitsHandler::processTraitOverride(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     if (sendingNode->getType() == NodeType::AvatarMixer) {
         Lock lock(_traitLock);
@@ -12,9 +12,12 @@
 #ifndef hifi_ClientTraitsHandler_h
 #define hifi_ClientTraitsHandler_h
 
+#include <unordered_map>
+
 #include <QtCore/QSharedPointer>
 
 #include <ReceivedMessage.h>
+#include <UUIDHasher.h>
 
 #include "AssociatedTraitValues.h"
 #include "Node.h"
@@ -49,6 +52,9 @@ private:
         Deleted
     };
 
+    qint64 packAvatarEntity(AvatarTraits::TraitInstanceID instanceID, ExtendedIODevice& destination,
+                            AvatarTraits::TraitVersion traitVersion, bool initialSend);
+
     AvatarData* const _owningAvatar;
 
     Mutex _traitLock;
@@ -59,6 +65,17 @@ private:
     
     bool _shouldPerformInitialSend { false };
     bool _hasChangedTraits { false };
+
+    // time of the last traits packet list sent, used to coalesce rapid changes into one send
+    quint64 _lastTraitsSendTime { 0 };
+
+    // the avatar entity data last sent to the mixer, that the next change to each entity is sent as a delta to
+    struct SentAvatarEntity {
+        QByteArray data;
+        AvatarTraits::TraitVersion version { AvatarTraits::DEFAULT_TRAIT_VERSION };
+        int numDeltas { 0 };
+    };
+    std::unordered_map<AvatarTraits::TraitInstanceID, SentAvatarEntity> _sentAvatarEntities;
 };
 
 #endif // hifi_ClientTraitsHandler_h
@@ -22,7 +22,9 @@
 #include <FBXSerializer.h>
 
 #include <model-baker/Baker.h>
+#include <model-baker/BuildMeshLODsTask.h>
 #include <model-baker/PrepareJointsTask.h>
+#include <model-networking/BakedModelCache.h>
 
 #include <FBXWriter.h>
 #include <FSTReader.h>
@@ -240,6 +242,9 @@ void ModelBaker::bakeSourceCopy() {
             _rootNode = fbxSerializer->_rootNode;
         }
 
+        // the preview is built from the meshes as they were read, the baker changes them
+        auto previewModel = loadedModel ? baker::buildPreviewModel(*loadedModel) : nullptr;
+
         baker::Baker baker(loadedModel, serializerMapping, _mappingURL);
         auto config = baker.getConfiguration();
         // Enable compressed draco mesh generation
@@ -260,6 +265,10 @@ void ModelBaker::bakeSourceCopy() {
         _materialMapping = baker.getMaterialMapping();
         dracoMeshes = baker.getDracoMeshes();
         dracoMaterialLists = baker.getDracoMaterialLists();
+
+        if (previewModel) {
+            bakePreviewModel(previewModel, serializerMapping);
+        }
     }
 
     // Do format-specific baking
@@ -282,6 +291,36 @@ void ModelBaker::bakeSourceCopy() {
     }
 }
 
+void ModelBaker::bakePreviewModel(const hfm::Model::Pointer& previewModel, const hifi::VariantHash& mapping) {
+    baker::Baker baker(previewModel, mapping, _mappingURL);
+    auto config = baker.getConfiguration();
+    ((PrepareJointsConfig*)config->getJobConfig("PrepareJoints"))->passthrough = true;
+    baker.run();
+
+    auto bakedPreview = baker.getHFMModel();
+    if (!BakedModelCache::canSerialize(*bakedPreview)) {
+        handleWarning("The materials of model " + _modelURL.toString() + " can't be stored in a preview");
+        return;
+    }
+
+    QString previewFilename = _bakedModelURL.fileName();
+    auto extensionStart = previewFilename.indexOf(".");
+    if (extensionStart != -1) {
+        previewFilename.resize(extensionStart);
+    }
+    previewFilename += BakedModelCache::PREVIEW_EXTENSION;
+    QString previewPath = _bakedOutputDir + "/" + previewFilename;
+
+    QFile previewFile { previewPath };
+    if (!previewFile.open(QIODevice::WriteOnly) || previewFile.write(BakedModelCache::serialize(*bakedPreview)) == -1) {
+        // the model loads without its preview, only later
+        handleWarning("Failed to write the preview of model " + _modelURL.toString() + " to " + previewPath);
+        return;
+    }
+    _outputFiles.push_back(previewPath);
+    _previewModelFilename = previewFilename;
+}
+
 void ModelBaker::handleFinishedMaterialBaker() {
     auto baker = qobject_cast<MaterialBaker*>(sender());
 
@@ -413,6 +452,9 @@ void ModelBaker::outputBakedFST() {
     auto outputMapping = _mapping;
     outputMapping[FST_VERSION_FIELD] = FST_VERSION;
     outputMapping[FILENAME_FIELD] = _bakedModelURL.fileName();
+    if (!_previewModelFilename.isEmpty()) {
+        outputMapping[PREVIEW_FILENAME_FIELD] = _previewModelFilename;
+    }
     outputMapping.remove(TEXDIR_FIELD);
     outputMapping.remove(COMMENT_FIELD);
     if (!_materialMappingJSON.isEmpty()) {
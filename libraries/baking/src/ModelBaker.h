@@ -90,6 +90,8 @@ private:
     void outputUnbakedFST();
     void outputBakedFST();
     void bakeMaterialMap();
+    // Writes the coarse model drawn while the baked model loads
+    void bakePreviewModel(const hfm::Model::Pointer& previewModel, const hifi::VariantHash& mapping);
 
     bool _hasBeenBaked { false };
 
@@ -98,6 +100,7 @@ private:
     int _materialMapIndex { 0 };
     QJsonArray _materialMappingJSON;
     QSharedPointer<MaterialBaker> _materialBaker;
+    QString _previewModelFilename;
 };
 
 #endif // hifi_ModelBaker_h
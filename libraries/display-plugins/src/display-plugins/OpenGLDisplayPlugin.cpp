@@ -703,11 +703,13 @@ void OpenGLDisplayPlugin::present(const std::shared_ptr<RefreshRateController>&
         auto correction = getViewCorrection();
         getGLBackend()->setCameraCorrection(correction, _prevRenderView);
         _prevRenderView = correction * _currentFrame->view;
+        bool newFrame = false;
         {
             withPresentThreadLock([&] {
                 _renderRate.increment();
                 if (_currentFrame.get() != _lastFrame) {
                     _newFrameRate.increment();
+                    newFrame = true;
                 }
                 _lastFrame = _currentFrame.get();
             });
@@ -741,6 +743,9 @@ void OpenGLDisplayPlugin::present(const std::shared_ptr<RefreshRateController>&
             PROFILE_RANGE_EX(render, "internalPresent", 0xff00ffff, frameId)
             internalPresent();
         }
+        if (newFrame && _currentFrame->poseTimestamp != 0) {
+            _movingAveragePoseLatency.addSample((float)(usecTimestampNow() - _currentFrame->poseTimestamp));
+        }
 
         gpu::Backend::freeGPUMemSize.set(gpu::gl::getFreeDedicatedMemory());
     } else if (alwaysPresent()) {
@@ -322,6 +322,14 @@ void EntityTreeRenderer::clearDomainAndNonOwnedEntities() {
     _renderablesToUpdate = savedRenderables;
     _entitiesInScene = savedEntities;
 
+    _enterLeaveIndex.clear();
+    for (const auto& entry : _entitiesInScene) {
+        const EntityItemPointer& entityItem = entry.second->getEntity();
+        if (entityItem) {
+            _enterLeaveIndex.update(entityItem);
+        }
+    }
+
     if (_layeredZones.clearDomainAndNonOwnedZones()) {
         applyLayeredZones();
     }
@@ -384,6 +392,8 @@ void EntityTreeRenderer::clear() {
     _entitiesInScene.clear();
     _renderablesToUpdate.clear();
 
+    _enterLeaveIndex.clear();
+
     // reset the zone to the default (while we load the next scene)
     _layeredZones.clear();
     if (!_shuttingDown) {
@@ -513,24 +523,31 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
         }
     }
 
-    float expectedUpdateCost = _avgRenderableUpdateCost * _renderablesToUpdate.size();
+    // update a renderable and blend its cost into the average cost of its entity type
+    auto updateRenderable = [&](const EntityRendererPointer& renderable) {
+        uint64_t start = usecTimestampNow();
+        renderable->updateInScene(scene, transaction);
+        float cost = (float)(usecTimestampNow() - start);
+        float& avgCost = _avgEntityUpdateCosts[renderable->getEntity()->getType()];
+        const float BLEND = 0.1f;
+        avgCost = (1.0f - BLEND) * avgCost + BLEND * cost;
+    };
+
+    // a few models can cost more than many shapes, so the expected cost is summed from the costs of their types
+    float expectedUpdateCost = 0.0f;
+    for (const auto& renderable : _renderablesToUpdate) {
+        expectedUpdateCost += _avgEntityUpdateCosts[renderable->getEntity()->getType()];
+    }
     _prevTotalNeededEntityUpdates = _renderablesToUpdate.size();
     if (expectedUpdateCost < MAX_UPDATE_RENDERABLES_TIME_BUDGET) {
         // we expect to update all renderables within available time budget
         PROFILE_RANGE_EX(simulation_physics, "UpdateRenderables", 0xffff00ff, (uint64_t)_renderablesToUpdate.size());
-        uint64_t updateStart = usecTimestampNow();
         for (const auto& renderable : _renderablesToUpdate) {
             assert(renderable); // only valid renderables are added to _renderablesToUpdate
-            renderable->updateInScene(scene, transaction);
+            updateRenderable(renderable);
         }
         _prevNumEntityUpdates = _renderablesToUpdate.size();
-        size_t numRenderables = _prevNumEntityUpdates + 1; // add one to avoid divide by zero
         _renderablesToUpdate.clear();
-
-        // compute average per-renderable update cost
-        float cost = (float)(usecTimestampNow() - updateStart) / (float)(numRenderables);
-        const float BLEND = 0.1f;
-        _avgRenderableUpdateCost = (1.0f - BLEND) * _avgRenderableUpdateCost + BLEND * cost;
     } else {
         // we expect the cost to updating all renderables to exceed available time budget
         // so we first sort by priority and update in order until out of time
@@ -580,16 +597,11 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
                     break;
                 }
                 const auto& renderable = sortedRenderable.getRenderer();
-                renderable->updateInScene(scene, transaction);
+                updateRenderable(renderable);
                 _renderablesToUpdate.erase(renderable);
             }
 
-            // compute average per-renderable update cost
             _prevNumEntityUpdates = sortedRenderables.size() - _renderablesToUpdate.size();
-            size_t numUpdated = _prevNumEntityUpdates + 1; // add one to avoid divide by zero
-            float cost = (float)(usecTimestampNow() - updateStart) / (float)(numUpdated);
-            const float BLEND = 0.1f;
-            _avgRenderableUpdateCost = (1.0f - BLEND) * _avgRenderableUpdateCost + BLEND * cost;
         }
     }
 }
@@ -665,40 +677,33 @@ void EntityTreeRenderer::handleSpaceUpdate(std::pair<int32_t, glm::vec4> proxyUp
 
 void EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(QSet<EntityItemID>& entitiesContainingAvatar) {
     float radius = 0.01f; // for now, assume 0.01 meter radius, because we actually check the point inside later
-    QVector<QUuid> entityIDs;
+    std::vector<EntityItemPointer> entities;
+    uint64_t now = usecTimestampNow();
 
     // find the entities near us
     // don't let someone else change our tree while we search
     _tree->withReadLock([&] {
-        auto entityTree = std::static_pointer_cast<EntityTree>(_tree);
-
-        // FIXME - if EntityTree had a findEntitiesContainingPoint() this could theoretically be a little faster
-        entityTree->evalEntitiesInSphere(_avatarPosition, radius, PickFilter(), entityIDs);
+        // Only the zones and the entities with scripts are indexed, all other entities can be ignored because they
+        // can't have events fired on them.
+        // FIXME - this could be optimized further by determining if the script is loaded
+        // and if it has either an enterEntity or leaveEntity method
+        _enterLeaveIndex.findCandidates(_avatarPosition, radius, entities);
 
         LayeredZones oldLayeredZones(_layeredZones);
         _layeredZones.clear();
 
         // create a list of entities that actually contain the avatar's position
-        for (auto& entityID : entityIDs) {
-            auto entity = entityTree->findEntityByID(entityID);
-            if (!entity) {
-                continue;
-            }
-
+        for (auto& entity : entities) {
             auto isZone = entity->getType() == EntityTypes::Zone;
             auto hasScript = !entity->getScript().isEmpty();
 
-            // only consider entities that are zones or have scripts, all other entities can
-            // be ignored because they can't have events fired on them.
-            // FIXME - this could be optimized further by determining if the script is loaded
-            // and if it has either an enterEntity or leaveEntity method
-            //
-            // also, don't flag a scripted entity as containing the avatar until the script is loaded,
+            // don't flag a scripted entity as containing the avatar until the script is loaded,
             // so that the script is awake in time to receive the "entityEntity" call (even if the entity is a zone).
             bool contains = false;
             bool scriptHasLoaded = hasScript && entity->isScriptPreloadFinished();
             if (isZone || scriptHasLoaded) {
-                contains = entity->contains(_avatarPosition);
+                // the answers for zone shapes the avatar hasn't moved within are kept by the index
+                contains = _enterLeaveIndex.contains(entity, _avatarPosition, now);
             }
 
             if (contains) {
@@ -732,7 +737,7 @@ void EntityTreeRenderer::checkEnterLeaveEntities() {
         // if some amount of time has elapsed since we last checked. We check the time
         // elapsed because zones or entities might have been created "around us" while we've
         // been stationary
-        auto movedEnough = glm::distance(avatarPosition, _avatarPosition) > ZONE_CHECK_DISTANCE;
+        auto movedEnough = glm::distance(avatarPosition, _avatarPosition) > EnterLeaveIndex::ZONE_CHECK_DISTANCE;
         auto enoughTimeElapsed = (now - _lastZoneCheck) > ZONE_CHECK_INTERVAL;
         
         if (_forceRecheckEntities || movedEnough || enoughTimeElapsed) {
@@ -1098,6 +1103,7 @@ void EntityTreeRenderer::mouseMoveEvent(QMouseEvent* event) {
 void EntityTreeRenderer::deletingEntity(const EntityItemID& entityID) {
     // If it's in a pending queue, remove it
     _entitiesToAdd.erase(entityID);
+    _enterLeaveIndex.remove(entityID);
 
     auto itr = _entitiesInScene.find(entityID);
     if (_entitiesInScene.end() == itr) {
@@ -1138,11 +1144,19 @@ void EntityTreeRenderer::addingEntity(const EntityItemID& entityID) {
     auto entity = std::static_pointer_cast<EntityTree>(_tree)->findEntityByID(entityID);
     if (entity) {
         _entitiesToAdd.insert({ entity->getEntityItemID(),  entity });
+        _enterLeaveIndex.update(entity);
     }
 }
 
 void EntityTreeRenderer::entityScriptChanging(const EntityItemID& entityID, bool reload) {
     checkAndCallPreload(entityID, reload, true);
+    if (_tree) {
+        // an entity that gains or loses its script becomes or stops being something the avatar can enter
+        auto entity = std::static_pointer_cast<EntityTree>(_tree)->findEntityByID(entityID);
+        if (entity) {
+            _enterLeaveIndex.update(entity);
+        }
+    }
     // Force "re-checking" entities so that the logic inside `checkEnterLeaveEntities()` is run.
     // This will ensure that the `enterEntity()` signal is emitted on clients whose avatars
     // are inside an entity when the script is reloaded.
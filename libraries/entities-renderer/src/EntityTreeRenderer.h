@@ -14,6 +14,7 @@
 #ifndef hifi_EntityTreeRenderer_h
 #define hifi_EntityTreeRenderer_h
 
+#include <array>
 #include <memory>
 
 #include <QtCore/QSet>
@@ -22,6 +23,7 @@
 #include <QtCore/QSharedPointer>
 
 #include <AudioInjectorManager.h>
+#include <EnterLeaveIndex.h>
 #include <EntityScriptingInterface.h> // for RayToEntityIntersectionResult
 #include <EntityTree.h>
 #include <PointerEvent.h>
@@ -147,6 +149,7 @@ public:
 
     size_t getPrevNumEntityUpdates() const { return _prevNumEntityUpdates; }
     size_t getPrevTotalNeededEntityUpdates() const { return _prevTotalNeededEntityUpdates; }
+    float getAverageEntityUpdateCost(EntityTypes::EntityType type) const { return _avgEntityUpdateCosts[type]; }
 
 signals:
     void enterEntity(const EntityItemID& entityItemID);
@@ -256,9 +259,10 @@ private:
     LayeredZones _layeredZones;
     uint64_t _lastZoneCheck { 0 };
     const uint64_t ZONE_CHECK_INTERVAL = USECS_PER_MSEC * 100; // ~10hz
-    const float ZONE_CHECK_DISTANCE = 0.001f;
+    EnterLeaveIndex _enterLeaveIndex;
 
-    float _avgRenderableUpdateCost { 0.0f };
+    // average updateInScene cost of a renderable of each entity type, in usecs
+    std::array<float, EntityTypes::NUM_TYPES> _avgEntityUpdateCosts {};
 
     ReadWriteLockable _changedEntitiesGuard;
     std::unordered_set<EntityItemID> _changedEntities;
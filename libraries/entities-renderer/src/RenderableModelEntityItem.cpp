@@ -339,7 +339,8 @@ bool RenderableModelEntityItem::isReadyToComputeShape() const {
 
         return false;
     } else if (shapeType >= SHAPE_TYPE_SIMPLE_HULL && shapeType <= SHAPE_TYPE_STATIC_MESH) {
-        return model && model->isLoaded() && _dimensionsInitialized;
+        // the shape is computed from the meshes of the model, not those of its preview
+        return model && model->isLoaded() && !model->isShowingPreview() && _dimensionsInitialized;
     }
     return true;
 }
@@ -1303,6 +1304,8 @@ void ModelEntityRenderer::doRenderUpdateAsynchronousTyped(const TypedEntityPoint
 
     // Nothing else to do unless the model is loaded
     if (!model->isLoaded()) {
+        // rank the pending download by where we are now
+        model->setLoadingPriority(EntityTreeRenderer::getEntityLoadingPriority(*entity));
         return;
     }
 
@@ -1320,19 +1323,22 @@ void ModelEntityRenderer::doRenderUpdateAsynchronousTyped(const TypedEntityPoint
             Qt::QueuedConnection, Q_ARG(QUuid, entity->getEntityItemID()), Q_ARG(EntityItemProperties, properties));
     }
 
-    if (!entity->_originalTexturesRead) {
-        // Default to _originalTextures to avoid remapping immediately and lagging on load
-        entity->_originalTextures = model->getTextures();
-        entity->_originalTexturesRead = true;
-    }
+    // the preview of the model has no textures, they're known once the model replaces it
+    if (!model->isShowingPreview()) {
+        if (!entity->_originalTexturesRead) {
+            // Default to _originalTextures to avoid remapping immediately and lagging on load
+            entity->_originalTextures = model->getTextures();
+            entity->_originalTexturesRead = true;
+        }
 
-    auto textures = entity->getTextures();
-    if (_textures != textures) {
-        QVariantMap newTextures;
-        _texturesLoaded = false;
-        _textures = textures;
-        newTextures = parseTexturesToMap(_textures, entity->_originalTextures);
-        model->setTextures(newTextures);
+        auto textures = entity->getTextures();
+        if (_textures != textures) {
+            QVariantMap newTextures;
+            _texturesLoaded = false;
+            _textures = textures;
+            newTextures = parseTexturesToMap(_textures, entity->_originalTextures);
+            model->setTextures(newTextures);
+        }
     }
 
     if (entity->_needsJointSimulation) {
@@ -1374,7 +1380,7 @@ void ModelEntityRenderer::doRenderUpdateAsynchronousTyped(const TypedEntityPoint
     }
 
     bool needsUpdate = false;
-    if (!_texturesLoaded && model->getGeometry() && model->getGeometry()->areTexturesLoaded()) {
+    if (!_texturesLoaded && !model->isShowingPreview() && model->getGeometry() && model->getGeometry()->areTexturesLoaded()) {
         _texturesLoaded = true;
         needsUpdate = true;
     } else if (!_texturesLoaded) {
@@ -65,13 +65,30 @@ static ShapePipelinePointer shapePipelineFactory(const ShapePlumber& plumber, co
         args->_renderMode == Args::RenderMode::SHADOW_RENDER_MODE, key.isWireframe())], nullptr, nullptr, nullptr);
 }
 
-struct GpuParticle {
-    GpuParticle(const glm::vec3& xyzIn, const glm::vec2& uvIn) : xyz(xyzIn), uv(uvIn) {}
-    glm::vec3 xyz; // Position
-    glm::vec2 uv; // Lifetime + seed
+// Emission times are sent as float seconds since an epoch, which is moved up before they lose precision
+static const uint64_t MAX_SIMULATION_EPOCH_AGE = 10 * 60 * USECS_PER_SECOND;
+
+enum ParticleChannel : gpu::Stream::Slot {
+    POSITION_CHANNEL = 0,
+    TIME_AND_SEED_CHANNEL,
+    BASE_POSITION_CHANNEL,
+    VELOCITY_CHANNEL,
+    ACCELERATION_CHANNEL,
 };
 
-using GpuParticles = std::vector<GpuParticle>;
+template <typename T>
+static void uploadAll(const gpu::BufferPointer& buffer, const std::vector<T>& array) {
+    size_t numBytes = sizeof(T) * array.size();
+    buffer->resize(numBytes);
+    if (numBytes != 0) {
+        buffer->setData(numBytes, (const gpu::Byte*)array.data());
+    }
+}
+
+template <typename T>
+static void uploadRange(const gpu::BufferPointer& buffer, const std::vector<T>& array, size_t first, size_t count) {
+    buffer->setSubData(sizeof(T) * first, sizeof(T) * count, (const gpu::Byte*)(array.data() + first));
+}
 
 ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPointer& entity) : Parent(entity) {
     ParticleUniforms uniforms;
@@ -82,10 +99,12 @@ ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPoint
         // As we create the first ParticuleSystem entity, let s register its special shapePIpeline factory:
         CUSTOM_PIPELINE_NUMBER = render::ShapePipeline::registerCustomShapePipelineFactory(shapePipelineFactory);
         _vertexFormat = std::make_shared<Format>();
-        _vertexFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element::VEC3F_XYZ,
-            offsetof(GpuParticle, xyz), gpu::Stream::PER_INSTANCE);
-        _vertexFormat->setAttribute(gpu::Stream::COLOR, 0, gpu::Element::VEC2F_UV,
-            offsetof(GpuParticle, uv), gpu::Stream::PER_INSTANCE);
+        // one channel per array of the ParticleRing
+        _vertexFormat->setAttribute(gpu::Stream::POSITION, POSITION_CHANNEL, gpu::Element::VEC3F_XYZ, 0, gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::COLOR, TIME_AND_SEED_CHANNEL, gpu::Element::VEC2F_UV, 0, gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::TEXCOORD, BASE_POSITION_CHANNEL, gpu::Element::VEC3F_XYZ, 0, gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::NORMAL, VELOCITY_CHANNEL, gpu::Element::VEC3F_XYZ, 0, gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::TANGENT, ACCELERATION_CHANNEL, gpu::Element::VEC3F_XYZ, 0, gpu::Stream::PER_INSTANCE);
     });
 }
 
@@ -212,10 +231,16 @@ float importanceSample3DDimension(float startDim) {
     return dimension;
 }
 
-ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createParticle(const Transform& baseTransform, const particle::Properties& particleProperties,
-                                                                                       const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
-                                                                                       const TriangleInfo& triangleInfo) {
-    CpuParticle particle;
+void ParticleEffectEntityRenderer::createParticle(ParticleRing& particles, uint64_t simulationTime, uint64_t simulationEpoch,
+                                                  const Transform& baseTransform, const particle::Properties& particleProperties,
+                                                  const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
+                                                  const TriangleInfo& triangleInfo) {
+    size_t slot = particles.push(simulationTime + (uint64_t)(particleProperties.lifespan * USECS_PER_SECOND));
+    if (slot == (size_t)-1) {
+        return;
+    }
+    glm::vec3& position = particles.positions[slot];
+    glm::vec2& timeAndSeed = particles.timesAndSeeds[slot];
 
     const auto& accelerationSpread = particleProperties.emission.acceleration.spread;
     const auto& azimuthStart = particleProperties.azimuth.start;
@@ -229,11 +254,11 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
     const auto& polarStart = particleProperties.polar.start;
     const auto& polarFinish = particleProperties.polar.finish;
 
-    particle.seed = randFloatInRange(-1.0f, 1.0f);
-    particle.expiration = (uint64_t)(particleProperties.lifespan * USECS_PER_SECOND);
+    timeAndSeed.x = (float)(simulationTime - simulationEpoch) / (float)USECS_PER_SECOND;
+    timeAndSeed.y = randFloatInRange(-1.0f, 1.0f);
 
-    particle.relativePosition = glm::vec3(0.0f);
-    particle.basePosition = baseTransform.getTranslation();
+    position = glm::vec3(0.0f);
+    particles.basePositions[slot] = baseTransform.getTranslation();
 
     // Position, velocity, and acceleration
     glm::vec3 emitDirection;
@@ -376,17 +401,17 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                 }
             }
 
-            particle.relativePosition += emitOrientation * emitPosition;
+            position += emitOrientation * emitPosition;
         }
     }
-    particle.velocity = (emitSpeed + randFloatInRange(-1.0f, 1.0f) * speedSpread) * (emitOrientation * emitDirection);
-    particle.acceleration = emitAcceleration +
+    particles.velocities[slot] = (emitSpeed + randFloatInRange(-1.0f, 1.0f) * speedSpread) * (emitOrientation * emitDirection);
+    particles.accelerations[slot] = emitAcceleration +
         glm::vec3(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f)) * accelerationSpread;
-
-    return particle;
 }
 
 void ParticleEffectEntityRenderer::stepSimulation() {
+    PROFILE_RANGE_EX(render, __FUNCTION__, 0xffff00ff, (uint64_t)_particles.getSize());
+
     if (_lastSimulated == 0) {
         _lastSimulated = usecTimestampNow();
         return;
@@ -396,6 +421,13 @@ void ParticleEffectEntityRenderer::stepSimulation() {
     const auto interval = std::min<uint64_t>(USECS_PER_SECOND / 60, now - _lastSimulated);
     _lastSimulated = now;
 
+    if (_particles.getCapacity() != (size_t)_particleProperties.maxParticles) {
+        _particles.setCapacity(_particleProperties.maxParticles);
+        _particleBuffersDirty = true;
+    }
+
+    // the ring drops its oldest particles when full, which keeps the particles within maxParticles
+    size_t numEmitted = 0;
     const auto& modelTransform = getModelTransform();
     if (_emitting && _particleProperties.emitting() &&
         (_shapeType != SHAPE_TYPE_COMPOUND || (_geometryResource && _geometryResource->isLoaded()))) {
@@ -407,7 +439,9 @@ void ParticleEffectEntityRenderer::stepSimulation() {
                     computeTriangles(_geometryResource->getHFMModel());
                 }
                 // emit particle
-                _cpuParticles.push_back(createParticle(modelTransform, _particleProperties, _shapeType, _geometryResource, _triangleInfo));
+                createParticle(_particles, _simulationTime, _simulationEpoch, modelTransform, _particleProperties,
+                               _shapeType, _geometryResource, _triangleInfo);
+                ++numEmitted;
                 _timeUntilNextEmit = emitInterval;
                 if (emitInterval < timeRemaining) {
                     timeRemaining -= emitInterval;
@@ -418,49 +452,83 @@ void ParticleEffectEntityRenderer::stepSimulation() {
         }
     }
 
-    // Kill any particles that have expired or are over the max size
-    while (_cpuParticles.size() > _particleProperties.maxParticles || (!_cpuParticles.empty() && _cpuParticles.front().expiration == 0)) {
-        _cpuParticles.pop_front();
+    // Kill any particles that have expired
+    _particles.cull(_simulationTime);
+    numEmitted = std::min(numEmitted, _particles.getSize());
+
+    // the particles move in the vertex shader, only their emission state changes here
+    _simulationTime += interval;
+
+    bool timesDirty = false;
+    if (_simulationTime - _simulationEpoch > MAX_SIMULATION_EPOCH_AGE) {
+        _particles.shiftEmissionTimes((float)(_simulationTime - _simulationEpoch) / (float)USECS_PER_SECOND);
+        _simulationEpoch = _simulationTime;
+        timesDirty = true;
     }
 
-    const float deltaTime = (float)interval / (float)USECS_PER_SECOND;
-    // update the particles
-    for (auto& particle : _cpuParticles) {
-        if (_prevEmitterShouldTrail != _particleProperties.emission.shouldTrail) {
-            if (_prevEmitterShouldTrail) {
-                particle.relativePosition = particle.relativePosition + particle.basePosition - modelTransform.getTranslation();
-            }
-            particle.basePosition = modelTransform.getTranslation();
+    bool positionsDirty = false;
+    if (_prevEmitterShouldTrail != _particleProperties.emission.shouldTrail) {
+        _particles.rebase(modelTransform.getTranslation(), _prevEmitterShouldTrail);
+        _prevEmitterShouldTrail = _particleProperties.emission.shouldTrail;
+        positionsDirty = true;
+    }
+
+    // Update particle buffers
+    if (_particleBuffersDirty) {
+        _particleBuffersDirty = false;
+        uploadAll(_positionBuffer, _particles.positions);
+        uploadAll(_timeAndSeedBuffer, _particles.timesAndSeeds);
+        uploadAll(_basePositionBuffer, _particles.basePositions);
+        uploadAll(_velocityBuffer, _particles.velocities);
+        uploadAll(_accelerationBuffer, _particles.accelerations);
+    } else {
+        if (timesDirty) {
+            uploadAll(_timeAndSeedBuffer, _particles.timesAndSeeds);
         }
-        particle.expiration = particle.expiration >= interval ? particle.expiration - interval : 0;
-        particle.integrate(deltaTime);
+        if (positionsDirty) {
+            uploadAll(_positionBuffer, _particles.positions);
+            uploadAll(_basePositionBuffer, _particles.basePositions);
+        }
+        uploadParticles(_particles.getSize() - numEmitted, numEmitted);
     }
-    _prevEmitterShouldTrail = _particleProperties.emission.shouldTrail;
-
-    // Build particle primitives
-    static GpuParticles gpuParticles;
-    gpuParticles.clear();
-    gpuParticles.reserve(_cpuParticles.size()); // Reserve space
-    std::transform(_cpuParticles.begin(), _cpuParticles.end(), std::back_inserter(gpuParticles), [this, &modelTransform] (const CpuParticle& particle) {
-        glm::vec3 position = particle.relativePosition + (_particleProperties.emission.shouldTrail ? particle.basePosition : modelTransform.getTranslation());
-        return GpuParticle(position, glm::vec2(particle.lifetime, particle.seed));
-    });
 
-    // Update particle buffer
-    auto& particleBuffer = _particleBuffer;
-    size_t numBytes = sizeof(GpuParticle) * gpuParticles.size();
-    particleBuffer->resize(numBytes);
-    if (numBytes != 0) {
-        particleBuffer->setData(numBytes, (const gpu::Byte*)gpuParticles.data());
+    auto& particleUniforms = _uniformBuffer.edit<ParticleUniforms>();
+    particleUniforms.time = (float)(_simulationTime - _simulationEpoch) / (float)USECS_PER_SECOND;
+    particleUniforms.origin = modelTransform.getTranslation();
+    particleUniforms.shouldTrail = _particleProperties.emission.shouldTrail ? 1 : 0;
+}
+
+void ParticleEffectEntityRenderer::uploadParticles(size_t first, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    // the particles wrap around the end of the ring at most once
+    size_t slot = _particles.slot(first);
+    size_t numBeforeWrap = std::min(count, _particles.getCapacity() - slot);
+    uploadRange(_positionBuffer, _particles.positions, slot, numBeforeWrap);
+    uploadRange(_timeAndSeedBuffer, _particles.timesAndSeeds, slot, numBeforeWrap);
+    uploadRange(_basePositionBuffer, _particles.basePositions, slot, numBeforeWrap);
+    uploadRange(_velocityBuffer, _particles.velocities, slot, numBeforeWrap);
+    uploadRange(_accelerationBuffer, _particles.accelerations, slot, numBeforeWrap);
+    if (numBeforeWrap < count) {
+        uploadParticles(first + numBeforeWrap, count - numBeforeWrap);
     }
 }
 
+void ParticleEffectEntityRenderer::setInputBuffers(gpu::Batch& batch, size_t start) const {
+    batch.setInputBuffer(POSITION_CHANNEL, _positionBuffer, sizeof(glm::vec3) * start, sizeof(glm::vec3));
+    batch.setInputBuffer(TIME_AND_SEED_CHANNEL, _timeAndSeedBuffer, sizeof(glm::vec2) * start, sizeof(glm::vec2));
+    batch.setInputBuffer(BASE_POSITION_CHANNEL, _basePositionBuffer, sizeof(glm::vec3) * start, sizeof(glm::vec3));
+    batch.setInputBuffer(VELOCITY_CHANNEL, _velocityBuffer, sizeof(glm::vec3) * start, sizeof(glm::vec3));
+    batch.setInputBuffer(ACCELERATION_CHANNEL, _accelerationBuffer, sizeof(glm::vec3) * start, sizeof(glm::vec3));
+}
+
 void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
     if (!_visible || !(_networkTexture && _networkTexture->isLoaded())) {
         return;
     }
 
-    // FIXME migrate simulation to a compute stage
     stepSimulation();
 
     gpu::Batch& batch = *args->_batch;
@@ -483,11 +551,19 @@ void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
 
     batch.setUniformBuffer(0, _uniformBuffer);
     batch.setInputFormat(_vertexFormat);
-    batch.setInputBuffer(0, _particleBuffer, 0, sizeof(GpuParticle));
 
-    auto numParticles = _particleBuffer->getSize() / sizeof(GpuParticle);
+    // the live particles wrap around the end of the ring at most once
     static const size_t VERTEX_PER_PARTICLE = 4;
-    batch.drawInstanced((gpu::uint32)numParticles, gpu::TRIANGLE_STRIP, (gpu::uint32)VERTEX_PER_PARTICLE);
+    size_t numParticles = _particles.getSize();
+    size_t numBeforeWrap = std::min(numParticles, _particles.getCapacity() - _particles.getStart());
+    if (numBeforeWrap > 0) {
+        setInputBuffers(batch, _particles.getStart());
+        batch.drawInstanced((gpu::uint32)numBeforeWrap, gpu::TRIANGLE_STRIP, (gpu::uint32)VERTEX_PER_PARTICLE);
+    }
+    if (numBeforeWrap < numParticles) {
+        setInputBuffers(batch, 0);
+        batch.drawInstanced((gpu::uint32)(numParticles - numBeforeWrap), gpu::TRIANGLE_STRIP, (gpu::uint32)VERTEX_PER_PARTICLE);
+    }
 }
 
 void ParticleEffectEntityRenderer::fetchGeometryResource() {
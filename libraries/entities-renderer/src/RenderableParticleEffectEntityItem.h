@@ -13,6 +13,7 @@
 
 #include "RenderableEntityItem.h"
 #include <ParticleEffectEntityItem.h>
+#include <ParticleRing.h>
 #include <TextureCache.h>
 
 namespace render { namespace entities {
@@ -41,25 +42,6 @@ private:
     using Buffer = gpu::Buffer;
     using BufferView = gpu::BufferView;
 
-    // CPU particles
-    // FIXME either switch to GPU compute particles or switch to simd updating of the particles
-    struct CpuParticle {
-        float seed { 0.0f };
-        uint64_t expiration { 0 };
-        float lifetime { 0.0f };
-        glm::vec3 basePosition;
-        glm::vec3 relativePosition;
-        glm::vec3 velocity;
-        glm::vec3 acceleration;
-
-        void integrate(float deltaTime) {
-            glm::vec3 atSquared = (0.5f * deltaTime * deltaTime) * acceleration;
-            relativePosition += velocity * deltaTime + atSquared;
-            velocity += acceleration * deltaTime;
-            lifetime += deltaTime;
-        }
-    };
-    using CpuParticles = std::deque<CpuParticle>;
 
 
     template<typename T>
@@ -76,7 +58,10 @@ private:
         InterpolationData<float> spin;
         float lifespan;
         int rotateWithEntity;
-        glm::vec2 spare;
+        int shouldTrail;
+        float spare;
+        glm::vec3 origin;
+        float time;
     };
 
     void computeTriangles(const hfm::Model& hfmModel);
@@ -88,20 +73,31 @@ private:
         glm::mat4 transform;
     } _triangleInfo;
 
-    static CpuParticle createParticle(const Transform& baseTransform, const particle::Properties& particleProperties,
-                                      const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
-                                      const TriangleInfo& triangleInfo);
+    static void createParticle(ParticleRing& particles, uint64_t simulationTime, uint64_t simulationEpoch,
+                               const Transform& baseTransform, const particle::Properties& particleProperties,
+                               const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
+                               const TriangleInfo& triangleInfo);
     void stepSimulation();
+    void uploadParticles(size_t first, size_t count);
+    void setInputBuffers(gpu::Batch& batch, size_t start) const;
 
     particle::Properties _particleProperties;
     bool _prevEmitterShouldTrail;
     bool _prevEmitterShouldTrailInitialized { false };
-    CpuParticles _cpuParticles;
+    // The particles move in textured_particle.slv, from their emission state in the per-instance buffers
+    ParticleRing _particles;
     bool _emitting { false };
     uint64_t _timeUntilNextEmit { 0 };
-    BufferPointer _particleBuffer { std::make_shared<Buffer>() };
+    BufferPointer _positionBuffer { std::make_shared<Buffer>() };
+    BufferPointer _timeAndSeedBuffer { std::make_shared<Buffer>() };
+    BufferPointer _basePositionBuffer { std::make_shared<Buffer>() };
+    BufferPointer _velocityBuffer { std::make_shared<Buffer>() };
+    BufferPointer _accelerationBuffer { std::make_shared<Buffer>() };
+    bool _particleBuffersDirty { true };
     BufferView _uniformBuffer;
     quint64 _lastSimulated { 0 };
+    uint64_t _simulationTime { 0 };
+    uint64_t _simulationEpoch { 0 };
 
     PulsePropertyGroup _pulseProperties;
     ShapeType _shapeType;
@@ -19,8 +19,6 @@
 #include <PerfStat.h>
 #include <shaders/Shaders.h>
 
-#include "paintStroke_Shared.slh"
-
 using namespace render;
 using namespace render::entities;
 
@@ -28,6 +26,20 @@ std::map<std::pair<render::Args::RenderMethod, bool>, gpu::PipelinePointer> Poly
 
 static const QUrl DEFAULT_POLYLINE_TEXTURE = PathUtils::resourcesUrl("images/paintStroke.png");
 
+// whether the first count values are unchanged, those past the end of the vectors being the defaults
+template <typename T>
+static bool isPrefixUnchanged(const QVector<T>& oldValues, const QVector<T>& newValues, int count, const T& oldDefault,
+                              const T& newDefault) {
+    for (int i = 0; i < count; i++) {
+        const T& oldValue = i < oldValues.size() ? oldValues[i] : oldDefault;
+        const T& newValue = i < newValues.size() ? newValues[i] : newDefault;
+        if (oldValue != newValue) {
+            return false;
+        }
+    }
+    return true;
+}
+
 PolyLineEntityRenderer::PolyLineEntityRenderer(const EntityItemPointer& entity) : Parent(entity) {
     _texture = DependencyManager::get<TextureCache>()->getTexture(DEFAULT_POLYLINE_TEXTURE);
 
@@ -183,31 +195,44 @@ void PolyLineEntityRenderer::doRenderUpdateAsynchronousTyped(const TypedEntityPo
     }
 
     // Geometry
+    // whether the points the geometry was built from, but the last, are unchanged
+    bool canAppend = _checkpoint.pointIndex >= 0;
     if (pointsChanged) {
-        _points = entity->getLinePoints();
+        auto points = entity->getLinePoints();
+        canAppend = canAppend && isPrefixUnchanged(_points, points, _checkpoint.pointIndex + 1, glm::vec3(), glm::vec3());
+        _points = points;
     }
     if (widthsChanged) {
-        _widths = entity->getStrokeWidths();
+        auto widths = entity->getStrokeWidths();
+        canAppend = canAppend && isPrefixUnchanged(_widths, widths, _checkpoint.pointIndex,
+            PolyLineEntityItem::DEFAULT_LINE_WIDTH, PolyLineEntityItem::DEFAULT_LINE_WIDTH);
+        _widths = widths;
     }
     if (normalsChanged) {
-        _normals = entity->getNormals();
+        auto normals = entity->getNormals();
+        canAppend = canAppend && isPrefixUnchanged(_normals, normals, _checkpoint.pointIndex, glm::vec3(), glm::vec3());
+        _normals = normals;
     }
     if (colorsChanged) {
-        _colors = entity->getStrokeColors();
-        _color = toGlm(entity->getColor());
+        auto colors = entity->getStrokeColors();
+        auto color = toGlm(entity->getColor());
+        canAppend = canAppend && isPrefixUnchanged(_colors, colors, _checkpoint.pointIndex, _color, color);
+        _colors = colors;
+        _color = color;
     }
 
     bool uvModeStretchChanged = _isUVModeStretch != isUVModeStretch;
     _isUVModeStretch = isUVModeStretch;
 
     if (uvModeStretchChanged || pointsChanged || widthsChanged || normalsChanged || colorsChanged || textureChanged || faceCameraChanged) {
-        updateGeometry();
+        updateGeometry(canAppend && !uvModeStretchChanged && !textureChanged && !faceCameraChanged);
     }
 }
 
-void PolyLineEntityRenderer::updateGeometry() {
+void PolyLineEntityRenderer::updateGeometry(bool canAppend) {
     int maxNumVertices = std::min(_points.length(), _normals.length());
     if (maxNumVertices < 1) {
+        _checkpoint = GeometryCheckpoint();
         return;
     }
     bool doesStrokeWidthVary = false;
@@ -226,16 +251,36 @@ void PolyLineEntityRenderer::updateGeometry() {
         }
     }
 
+    // the stretched texture coordinates depend on the number of points, and the others on whether the width varies
+    canAppend = canAppend && !_isUVModeStretch && doesStrokeWidthVary == _doesStrokeWidthVary &&
+        maxNumVertices > _checkpoint.pointIndex;
+    _doesStrokeWidthVary = doesStrokeWidthVary;
+
     float uCoordInc = 1.0f / maxNumVertices;
     float uCoord = 0.0f;
     float accumulatedDistance = 0.0f;
     float accumulatedStrokeWidth = 0.0f;
     glm::vec3 binormal;
 
+    int firstPoint = 0;
+    size_t firstVertex = 0;
+    if (canAppend) {
+        firstPoint = _checkpoint.pointIndex;
+        firstVertex = _checkpoint.numVertices;
+        uCoord = _checkpoint.uCoord;
+        accumulatedDistance = _checkpoint.accumulatedDistance;
+        accumulatedStrokeWidth = _checkpoint.accumulatedStrokeWidth;
+        binormal = _checkpoint.binormal;
+    }
+
     std::vector<PolylineVertex> vertices;
-    vertices.reserve(maxNumVertices);
+    vertices.reserve(maxNumVertices - firstPoint);
+
+    for (int i = firstPoint; i < maxNumVertices; i++) {
+        if (i == maxNumVertices - 1) {
+            _checkpoint = { i, firstVertex + vertices.size(), uCoord, accumulatedDistance, accumulatedStrokeWidth, binormal };
+        }
 
-    for (int i = 0; i < maxNumVertices; i++) {
         // Position
         glm::vec3 point = _points[i];
         // uCoord
@@ -294,8 +339,24 @@ void PolyLineEntityRenderer::updateGeometry() {
         vertices.push_back(vertex);
     }
 
-    _numVertices = vertices.size();
-    _polylineGeometryBuffer->setData(vertices.size() * sizeof(PolylineVertex), (const gpu::Byte*) vertices.data());
+    _numVertices = firstVertex + vertices.size();
+    uploadVertices(firstVertex, vertices);
+}
+
+void PolyLineEntityRenderer::uploadVertices(size_t firstVertex, const std::vector<PolylineVertex>& vertices) {
+    // only the pages of the buffer that are written to are uploaded again
+    gpu::Size end = (firstVertex + vertices.size()) * sizeof(PolylineVertex);
+    gpu::Size size = _polylineGeometryBuffer->getSize();
+    if (end > size) {
+        // with room to grow, so that the strokes being drawn don't reallocate the buffer with every point
+        _polylineGeometryBuffer->resize(std::max(end, 2 * size));
+    } else if (firstVertex == 0 && end < size / 4) {
+        _polylineGeometryBuffer->resize(end);
+    }
+    if (!vertices.empty()) {
+        _polylineGeometryBuffer->setSubData(firstVertex * sizeof(PolylineVertex), vertices.size() * sizeof(PolylineVertex),
+            (const gpu::Byte*)vertices.data());
+    }
 }
 
 void PolyLineEntityRenderer::updateData() {
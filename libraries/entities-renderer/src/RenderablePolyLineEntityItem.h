@@ -16,6 +16,8 @@
 #include <PolyLineEntityItem.h>
 #include <TextureCache.h>
 
+#include "paintStroke_Shared.slh"
+
 namespace render { namespace entities {
 
 class PolyLineEntityRenderer : public TypedEntityRenderer<PolyLineEntityItem> {
@@ -39,7 +41,8 @@ protected:
     virtual void doRender(RenderArgs* args) override;
 
     static void buildPipelines();
-    void updateGeometry();
+    void updateGeometry(bool canAppend);
+    void uploadVertices(size_t firstVertex, const std::vector<PolylineVertex>& vertices);
     void updateData();
 
     QVector<glm::vec3> _points;
@@ -57,6 +60,20 @@ protected:
     bool _glow { false };
 
     size_t _numVertices { 0 };
+
+    // The running sums of the geometry before its last point, which is rebuilt with the points added after it. Drawing
+    // apps add points to the end of their strokes many times a second, and those only build and upload the new vertices.
+    struct GeometryCheckpoint {
+        int pointIndex { -1 };
+        size_t numVertices { 0 };
+        float uCoord { 0.0f };
+        float accumulatedDistance { 0.0f };
+        float accumulatedStrokeWidth { 0.0f };
+        glm::vec3 binormal { 0.0f };
+    };
+    GeometryCheckpoint _checkpoint;
+    bool _doesStrokeWidthVary { false };
+
     gpu::BufferPointer _polylineDataBuffer;
     gpu::BufferPointer _polylineGeometryBuffer;
     static std::map<std::pair<render::Args::RenderMethod, bool>, gpu::PipelinePointer> _pipelines;
@@ -22,6 +22,8 @@
 #include <QByteArray>
 #include <QtConcurrent/QtConcurrentRun>
 
+#include <tbb/parallel_for.h>
+
 #include <model-networking/SimpleMeshProxy.h>
 #include "ModelScriptingInterface.h"
 #include <EntityEditPacketSender.h>
@@ -164,6 +166,244 @@ void loop3(const T& start, const T& end, F f) {
     }
 }
 
+// The volume is meshed in chunks of POLYVOX_CHUNK_SIZE^3 voxels, so that an edit only re-extracts the mesh and the
+// collision hulls of the chunks around it.  An edited voxel changes the normals of marching-cubes cells up to two
+// voxels away, so chunks within that margin are re-extracted too.
+static const int POLYVOX_CHUNK_SIZE = 16;
+static const int POLYVOX_CHUNK_MARGIN = 2;
+
+struct PolyVoxChunk {
+    std::vector<PolyVox::PositionMaterialNormal> vertices; // in voxel-volume coords
+    std::vector<uint32_t> indices;
+    ShapeInfo::PointCollection hulls; // in voxel-volume coords
+};
+
+struct RenderablePolyVoxEntityItem::PolyVoxChunks {
+    PolyVoxChunks(const ivec3& volumeSizeIn) :
+        volumeSize(volumeSizeIn),
+        numChunks((volumeSizeIn + POLYVOX_CHUNK_SIZE - 1) / POLYVOX_CHUNK_SIZE),
+        chunks(numChunks.x * numChunks.y * numChunks.z),
+        meshDirty(chunks.size(), 1),
+        shapeDirty(chunks.size(), 1) {}
+
+    ivec3 lowCorner(size_t index) const {
+        int i = (int)index;
+        return ivec3(i % numChunks.x, (i / numChunks.x) % numChunks.y, i / (numChunks.x * numChunks.y)) * POLYVOX_CHUNK_SIZE;
+    }
+
+    // exclusive, voxels in [lowCorner, highCorner) belong to the chunk
+    ivec3 highCorner(size_t index) const { return glm::min(lowCorner(index) + POLYVOX_CHUNK_SIZE, volumeSize); }
+
+    void markDirty(const ivec3& v) {
+        ivec3 low = glm::max(v - POLYVOX_CHUNK_MARGIN, ivec3(0)) / POLYVOX_CHUNK_SIZE;
+        ivec3 high = glm::min(v + POLYVOX_CHUNK_MARGIN, volumeSize - 1) / POLYVOX_CHUNK_SIZE;
+        loop3(low, high + 1, [&](const ivec3& c) {
+            size_t index = c.x + numChunks.x * (c.y + numChunks.y * c.z);
+            meshDirty[index] = shapeDirty[index] = 1;
+        });
+    }
+
+    void markAllDirty() {
+        std::fill(meshDirty.begin(), meshDirty.end(), 1);
+        std::fill(shapeDirty.begin(), shapeDirty.end(), 1);
+    }
+
+    // returns the dirty chunks and clears their flags, this assumes that the caller has write-locked the entity
+    std::vector<size_t> takeDirty(std::vector<uint8_t>& dirty) {
+        std::vector<size_t> indices;
+        for (size_t i = 0; i < dirty.size(); ++i) {
+            if (dirty[i]) {
+                dirty[i] = 0;
+                indices.push_back(i);
+            }
+        }
+        return indices;
+    }
+
+    ivec3 volumeSize; // of _volData
+    ivec3 numChunks;
+    std::vector<PolyVoxChunk> chunks; // written by the worker threads, one bake at a time
+    std::vector<uint8_t> meshDirty; // guarded by the entity's lock
+    std::vector<uint8_t> shapeDirty; // guarded by the entity's lock
+};
+
+static void extractMarchingCubesChunk(PolyVox::SimpleVolume<uint8_t>* volData, const ivec3& low, const ivec3& high,
+                                      PolyVoxChunk& chunk) {
+    PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+        (volData, PolyVox::Region(PolyVox::Vector3DInt32(low.x, low.y, low.z), PolyVox::Vector3DInt32(high.x, high.y, high.z)),
+         &polyVoxMesh);
+    surfaceExtractor.execute();
+
+    // the extractor places vertices relative to the lower corner of its region
+    PolyVox::Vector3DFloat offset((float)low.x, (float)low.y, (float)low.z);
+    chunk.vertices = polyVoxMesh.getRawVertexData();
+    for (auto& vertex : chunk.vertices) {
+        vertex.setPosition(vertex.getPosition() + offset);
+    }
+    chunk.indices = polyVoxMesh.getIndices();
+}
+
+// Greedy meshing of the faces between solid and empty voxels: faces in a slice that share a direction and a material
+// are merged into rectangles, so flat walls and floors take two triangles instead of two per voxel.  Faces lie
+// halfway between voxels as with the CubicSurfaceExtractor, and get the material of their solid voxel.
+static void extractCubicChunk(PolyVox::SimpleVolume<uint8_t>* volData, const ivec3& low, const ivec3& high,
+                              PolyVoxChunk& chunk) {
+    chunk.vertices.clear();
+    chunk.indices.clear();
+
+    ivec3 size = high - low;
+    for (int d = 0; d < 3; ++d) {
+        int u = (d + 1) % 3;
+        int v = (d + 2) % 3;
+
+        // +material for a face toward +d, -material for a face toward -d
+        std::vector<int> mask(size[u] * size[v]);
+        for (int s = low[d]; s < high[d]; ++s) {
+            for (int j = 0; j < size[v]; ++j) {
+                for (int i = 0; i < size[u]; ++i) {
+                    ivec3 back;
+                    back[d] = s;
+                    back[u] = low[u] + i;
+                    back[v] = low[v] + j;
+                    ivec3 front = back;
+                    front[d] += 1;
+                    int backValue = volData->getVoxelAt(back.x, back.y, back.z);
+                    int frontValue = volData->getVoxelAt(front.x, front.y, front.z);
+                    int& face = mask[i + j * size[u]];
+                    if (backValue > 0 && frontValue == 0) {
+                        face = backValue;
+                    } else if (frontValue > 0 && backValue == 0) {
+                        face = -frontValue;
+                    } else {
+                        face = 0;
+                    }
+                }
+            }
+
+            for (int j = 0; j < size[v]; ++j) {
+                for (int i = 0; i < size[u];) {
+                    int face = mask[i + j * size[u]];
+                    if (face == 0) {
+                        ++i;
+                        continue;
+                    }
+
+                    int width = 1;
+                    while (i + width < size[u] && mask[i + width + j * size[u]] == face) {
+                        ++width;
+                    }
+                    int height = 1;
+                    for (; j + height < size[v]; ++height) {
+                        int* row = &mask[i + (j + height) * size[u]];
+                        if (std::any_of(row, row + width, [&](int other) { return other != face; })) {
+                            break;
+                        }
+                    }
+                    for (int k = 0; k < height; ++k) {
+                        std::fill_n(&mask[i + (j + k) * size[u]], width, 0);
+                    }
+
+                    glm::vec3 corner(0.0f);
+                    corner[d] = (float)s + 0.5f;
+                    corner[u] = (float)(low[u] + i) - 0.5f;
+                    corner[v] = (float)(low[v] + j) - 0.5f;
+                    glm::vec3 du(0.0f);
+                    du[u] = (float)width;
+                    glm::vec3 dv(0.0f);
+                    dv[v] = (float)height;
+                    glm::vec3 normal(0.0f);
+                    normal[d] = face > 0 ? 1.0f : -1.0f;
+                    float material = (float)std::abs(face);
+
+                    uint32_t first = (uint32_t)chunk.vertices.size();
+                    for (const auto& position : { corner, corner + du, corner + du + dv, corner + dv }) {
+                        chunk.vertices.emplace_back(PolyVox::Vector3DFloat(position.x, position.y, position.z),
+                                                    PolyVox::Vector3DFloat(normal.x, normal.y, normal.z), material);
+                    }
+                    // u x v is d, so the corners wind counter-clockwise seen from +d
+                    if (face > 0) {
+                        chunk.indices.insert(chunk.indices.end(), { first, first + 1, first + 2, first, first + 2, first + 3 });
+                    } else {
+                        chunk.indices.insert(chunk.indices.end(), { first, first + 2, first + 1, first, first + 3, first + 2 });
+                    }
+                    i += width;
+                }
+            }
+        }
+    }
+}
+
+// one hull per triangle of the chunk's mesh, extruded into the surface
+static void computeMarchingCubesChunkHulls(PolyVoxChunk& chunk) {
+    chunk.hulls.clear();
+    for (size_t i = 0; i + 2 < chunk.indices.size(); i += 3) {
+        const auto& v0 = chunk.vertices[chunk.indices[i]].getPosition();
+        const auto& v1 = chunk.vertices[chunk.indices[i + 1]].getPosition();
+        const auto& v2 = chunk.vertices[chunk.indices[i + 2]].getPosition();
+        glm::vec3 p0(v0.getX(), v0.getY(), v0.getZ());
+        glm::vec3 p1(v1.getX(), v1.getY(), v1.getZ());
+        glm::vec3 p2(v2.getX(), v2.getY(), v2.getZ());
+
+        glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
+        glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+        glm::vec3 p3 = av - normal * MARCHING_CUBE_COLLISION_HULL_OFFSET;
+
+        QVector<glm::vec3> pointsInPart;
+        pointsInPart << p0 << p1 << p2 << p3;
+        chunk.hulls << pointsInPart;
+    }
+}
+
+// one box hull per run of solid voxels along x, unless every voxel of the run is enclosed by solid voxels
+static void computeCubicChunkHulls(PolyVox::SimpleVolume<uint8_t>* volData, const ivec3& userLow, const ivec3& userHigh,
+                                   const ivec3& low, const ivec3& high, PolyVoxChunk& chunk) {
+    chunk.hulls.clear();
+    ivec3 runLow = glm::max(low, userLow);
+    ivec3 runHigh = glm::min(high, userHigh);
+
+    auto isSolid = [&](int x, int y, int z) {
+        return volData->getVoxelAt(x, y, z) > 0;
+    };
+    auto isEnclosed = [&](int x, int y, int z) {
+        ivec3 v(x, y, z);
+        return glm::all(glm::greaterThan(v, userLow)) && glm::all(glm::lessThan(v, userHigh - 1)) &&
+            isSolid(x - 1, y, z) && isSolid(x, y - 1, z) && isSolid(x, y, z - 1) &&
+            isSolid(x + 1, y, z) && isSolid(x, y + 1, z) && isSolid(x, y, z + 1);
+    };
+
+    for (int z = runLow.z; z < runHigh.z; ++z) {
+        for (int y = runLow.y; y < runHigh.y; ++y) {
+            for (int x = runLow.x; x < runHigh.x;) {
+                if (!isSolid(x, y, z)) {
+                    ++x;
+                    continue;
+                }
+                int runStart = x;
+                bool enclosed = true;
+                for (; x < runHigh.x && isSolid(x, y, z); ++x) {
+                    enclosed = enclosed && isEnclosed(x, y, z);
+                }
+                if (enclosed) {
+                    // this run has neighbors in every cardinal direction, so there's no need
+                    // to include it in the collision hull.
+                    continue;
+                }
+
+                glm::vec3 boxLow((float)runStart - 0.5f, (float)y - 0.5f, (float)z - 0.5f);
+                glm::vec3 boxHigh((float)x - 0.5f, (float)y + 0.5f, (float)z + 0.5f);
+                QVector<glm::vec3> pointsInPart;
+                for (int corner = 0; corner < 8; ++corner) {
+                    pointsInPart << glm::vec3((corner & 4) ? boxHigh.x : boxLow.x,
+                                              (corner & 2) ? boxHigh.y : boxLow.y,
+                                              (corner & 1) ? boxHigh.z : boxLow.z);
+                }
+                chunk.hulls << pointsInPart;
+            }
+        }
+    }
+}
+
 EntityItemPointer RenderablePolyVoxEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
     std::shared_ptr<RenderablePolyVoxEntityItem> entity(new RenderablePolyVoxEntityItem(entityID),
                                                         [](RenderablePolyVoxEntityItem* ptr) { ptr->deleteLater(); });
@@ -232,6 +472,9 @@ void RenderablePolyVoxEntityItem::setVoxelSurfaceStyle(PolyVoxSurfaceStyle voxel
             volSizeChanged = true;
         }
         _voxelSurfaceStyle = voxelSurfaceStyle;
+        if (_chunks) {
+            _chunks->markAllDirty();
+        }
         startUpdates();
     });
 
@@ -916,6 +1159,7 @@ void RenderablePolyVoxEntityItem::setVoxelVolumeSize(const glm::vec3& voxelVolum
         _volData.reset(new PolyVox::SimpleVolume<uint8_t>(PolyVox::Region(lowCorner, highCorner)));
         // having the "outside of voxel-space" value be 255 has helped me notice some problems.
         _volData->setBorderValue(255);
+        _chunks = std::make_shared<PolyVoxChunks>(ivec3(_volData->getWidth(), _volData->getHeight(), _volData->getDepth()));
     });
 
     tellNeighborsToRecopyEdges(true);
@@ -968,6 +1212,7 @@ uint8_t RenderablePolyVoxEntityItem::getVoxelInternal(const ivec3& v) const {
 
 void RenderablePolyVoxEntityItem::setVoxelMarkNeighbors(int x, int y, int z, uint8_t toValue) {
     _volData->setVoxelAt(x, y, z, toValue);
+    _chunks->markDirty({ x, y, z });
     if (x == 0) {
         _neighborXNeedsUpdate = true;
         startUpdates();
@@ -1232,6 +1477,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            _chunks->markDirty({ x, y, z });
                             _volDataDirty = true;
                         }
                     }
@@ -1252,6 +1498,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            _chunks->markDirty({ x, y, z });
                             _volDataDirty = true;
                         }
                     }
@@ -1272,6 +1519,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            _chunks->markDirty({ x, y, z });
                             _volDataDirty = true;
                         }
                     }
@@ -1314,47 +1562,80 @@ void RenderablePolyVoxEntityItem::tellNeighborsToRecopyEdges(bool force) {
 void RenderablePolyVoxEntityItem::recomputeMesh() {
     // use _volData to make a renderable mesh
     PolyVoxSurfaceStyle voxelSurfaceStyle;
-    withReadLock([&] {
+    std::shared_ptr<PolyVoxChunks> chunks;
+    std::vector<size_t> dirtyChunks;
+    withWriteLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
+        chunks = _chunks;
+        if (chunks) {
+            dirtyChunks = chunks->takeDirty(chunks->meshDirty);
+        }
     });
 
     auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
-    QtConcurrent::run([entity, voxelSurfaceStyle] {
+    QtConcurrent::run([entity, voxelSurfaceStyle, chunks, dirtyChunks] {
         graphics::MeshPointer mesh(std::make_shared<graphics::Mesh>());
 
-        // A mesh object to hold the result of surface extraction
-        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
-
-        entity->withReadLock([&] {
-            PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
-            switch (voxelSurfaceStyle) {
-                case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
-                case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+        std::vector<PolyVox::PositionMaterialNormal> vecVertices;
+        std::vector<uint32_t> vecIndices;
+        if (chunks) {
+            entity->withReadLock([&] {
+                PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
+                if (!volData) {
+                    return;
                 }
-                case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
-                case PolyVoxEntityItem::SURFACE_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+                // only the dirty chunks are extracted, in parallel
+                tbb::parallel_for((size_t)0, dirtyChunks.size(), [&](size_t i) {
+                    size_t index = dirtyChunks[i];
+                    ivec3 low = chunks->lowCorner(index);
+                    // cells span two voxels, so the last voxel of the volume only closes the cells before it
+                    ivec3 high = glm::min(chunks->highCorner(index), chunks->volumeSize - 1);
+                    PolyVoxChunk& chunk = chunks->chunks[index];
+                    if (glm::any(glm::lessThanEqual(high, low))) {
+                        chunk.vertices.clear();
+                        chunk.indices.clear();
+                        return;
+                    }
+                    switch (voxelSurfaceStyle) {
+                        case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
+                        case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
+                            extractMarchingCubesChunk(volData, low, high, chunk);
+                            break;
+                        }
+                        case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
+                        case PolyVoxEntityItem::SURFACE_CUBIC: {
+                            extractCubicChunk(volData, low, high, chunk);
+                            break;
+                        }
+                    }
+                });
+            });
+
+            size_t numVertices = 0;
+            size_t numIndices = 0;
+            for (const auto& chunk : chunks->chunks) {
+                numVertices += chunk.vertices.size();
+                numIndices += chunk.indices.size();
+            }
+            vecVertices.reserve(numVertices);
+            vecIndices.reserve(numIndices);
+            for (const auto& chunk : chunks->chunks) {
+                uint32_t baseVertex = (uint32_t)vecVertices.size();
+                vecVertices.insert(vecVertices.end(), chunk.vertices.begin(), chunk.vertices.end());
+                for (uint32_t index : chunk.indices) {
+                    vecIndices.push_back(baseVertex + index);
                 }
             }
-        });
+        }
 
         // convert PolyVox mesh to a Sam mesh
-        const std::vector<uint32_t>& vecIndices = polyVoxMesh.getIndices();
         auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
                                                          (gpu::Byte*)vecIndices.data());
         auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
         gpu::BufferView indexBufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::INDEX));
         mesh->setIndexBuffer(indexBufferView);
 
-        const std::vector<PolyVox::PositionMaterialNormal>& vecVertices = polyVoxMesh.getRawVertexData();
         auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
                                                           (gpu::Byte*)vecVertices.data());
         auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
@@ -1405,134 +1686,70 @@ void RenderablePolyVoxEntityItem::setMesh(graphics::MeshPointer mesh) {
 
 void RenderablePolyVoxEntityItem::computeShapeInfoWorker() {
     // this creates a collision-shape for the physics engine.  The shape comes from
-    // _volData for cubic extractors and from _mesh for marching-cube extractors
+    // _volData for cubic extractors and from the chunks' meshes for marching-cube extractors.  Only the
+    // hulls of the chunks that changed since the last shape are recomputed.
 
-    EntityItemPointer entity = getThisPointer();
+    auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
     PolyVoxSurfaceStyle voxelSurfaceStyle;
     glm::vec3 voxelVolumeSize;
-    graphics::MeshPointer mesh;
+    std::shared_ptr<PolyVoxChunks> chunks;
+    std::vector<size_t> dirtyChunks;
 
-    withReadLock([&] {
+    withWriteLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
         voxelVolumeSize = _voxelVolumeSize;
-        mesh = _mesh;
+        chunks = _chunks;
+        if (chunks) {
+            dirtyChunks = chunks->takeDirty(chunks->shapeDirty);
+        }
     });
 
-    QtConcurrent::run([entity, voxelSurfaceStyle, voxelVolumeSize, mesh] {
-        auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
+    QtConcurrent::run([entity, voxelSurfaceStyle, voxelVolumeSize, chunks, dirtyChunks] {
         QVector<QVector<glm::vec3>> pointCollection;
         AABox box;
-        glm::mat4 vtoM = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity)->voxelToLocalMatrix();
-
-        if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_MARCHING_CUBES ||
-            voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES) {
-            // pull each triangle in the mesh into a polyhedron which can be collided with
-            unsigned int i = 0;
-
-            const gpu::BufferView& vertexBufferView = mesh->getVertexBuffer();
-            const gpu::BufferView& indexBufferView = mesh->getIndexBuffer();
-
-            gpu::BufferView::Iterator<const uint32_t> it = indexBufferView.cbegin<uint32_t>();
-            while (it != indexBufferView.cend<uint32_t>()) {
-                uint32_t p0Index = *(it++);
-                uint32_t p1Index = *(it++);
-                uint32_t p2Index = *(it++);
-
-                const glm::vec3& p0 = vertexBufferView.get<const glm::vec3>(p0Index);
-                const glm::vec3& p1 = vertexBufferView.get<const glm::vec3>(p1Index);
-                const glm::vec3& p2 = vertexBufferView.get<const glm::vec3>(p2Index);
-
-                glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
-                glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
-                glm::vec3 p3 = av - normal * MARCHING_CUBE_COLLISION_HULL_OFFSET;
-
-                glm::vec3 p0Model = glm::vec3(vtoM * glm::vec4(p0, 1.0f));
-                glm::vec3 p1Model = glm::vec3(vtoM * glm::vec4(p1, 1.0f));
-                glm::vec3 p2Model = glm::vec3(vtoM * glm::vec4(p2, 1.0f));
-                glm::vec3 p3Model = glm::vec3(vtoM * glm::vec4(p3, 1.0f));
-
-                box += p0Model;
-                box += p1Model;
-                box += p2Model;
-                box += p3Model;
-
-                QVector<glm::vec3> pointsInPart;
-                pointsInPart << p0Model;
-                pointsInPart << p1Model;
-                pointsInPart << p2Model;
-                pointsInPart << p3Model;
-                // add next convex hull
-                QVector<glm::vec3> newMeshPoints;
-                pointCollection << newMeshPoints;
-                // add points to the new convex hull
-                pointCollection[i++] << pointsInPart;
-            }
-        } else {
-            unsigned int i = 0;
-            polyVoxEntity->forEachVoxelValue(voxelVolumeSize, [&](const ivec3& v, uint8_t value) {
-                if (value > 0) {
-                    const auto& x = v.x;
-                    const auto& y = v.y;
-                    const auto& z = v.z;
-                    if (glm::all(glm::greaterThan(v, ivec3(0))) &&
-                        glm::all(glm::lessThan(v, ivec3(voxelVolumeSize) - 1)) &&
-                        (polyVoxEntity->getVoxelInternal({ x - 1, y, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y - 1, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y, z - 1 }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x + 1, y, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y + 1, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y, z + 1 }) > 0)) {
-                        // this voxel has neighbors in every cardinal direction, so there's no need
-                        // to include it in the collision hull.
-                        return;
+        glm::mat4 vtoM = entity->voxelToLocalMatrix();
+
+        if (chunks) {
+            bool marchingCubes = voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_MARCHING_CUBES ||
+                voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES;
+            // the user's voxels, in voxel-volume coords
+            ivec3 userLow(PolyVoxEntityItem::isEdged(voxelSurfaceStyle) ? 1 : 0);
+            ivec3 userHigh = userLow + ivec3(voxelVolumeSize);
+
+            entity->withReadLock([&] {
+                PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
+                if (!volData && !marchingCubes) {
+                    return;
+                }
+                tbb::parallel_for((size_t)0, dirtyChunks.size(), [&](size_t i) {
+                    size_t index = dirtyChunks[i];
+                    PolyVoxChunk& chunk = chunks->chunks[index];
+                    if (marchingCubes) {
+                        // pull each triangle in the mesh into a polyhedron which can be collided with
+                        computeMarchingCubesChunkHulls(chunk);
+                    } else {
+                        computeCubicChunkHulls(volData, userLow, userHigh, chunks->lowCorner(index),
+                                               chunks->highCorner(index), chunk);
                     }
+                });
+            });
 
+            for (const auto& chunk : chunks->chunks) {
+                for (const auto& hull : chunk.hulls) {
                     QVector<glm::vec3> pointsInPart;
-
-                    float offL = -0.5f;
-                    float offH = 0.5f;
-                    if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_CUBIC) {
-                        offL += 1.0f;
-                        offH += 1.0f;
+                    pointsInPart.reserve(hull.size());
+                    for (const auto& point : hull) {
+                        glm::vec3 pointModel = glm::vec3(vtoM * glm::vec4(point, 1.0f));
+                        box += pointModel;
+                        pointsInPart << pointModel;
                     }
-
-                    glm::vec3 p000 = glm::vec3(vtoM * glm::vec4(x + offL, y + offL, z + offL, 1.0f));
-                    glm::vec3 p001 = glm::vec3(vtoM * glm::vec4(x + offL, y + offL, z + offH, 1.0f));
-                    glm::vec3 p010 = glm::vec3(vtoM * glm::vec4(x + offL, y + offH, z + offL, 1.0f));
-                    glm::vec3 p011 = glm::vec3(vtoM * glm::vec4(x + offL, y + offH, z + offH, 1.0f));
-                    glm::vec3 p100 = glm::vec3(vtoM * glm::vec4(x + offH, y + offL, z + offL, 1.0f));
-                    glm::vec3 p101 = glm::vec3(vtoM * glm::vec4(x + offH, y + offL, z + offH, 1.0f));
-                    glm::vec3 p110 = glm::vec3(vtoM * glm::vec4(x + offH, y + offH, z + offL, 1.0f));
-                    glm::vec3 p111 = glm::vec3(vtoM * glm::vec4(x + offH, y + offH, z + offH, 1.0f));
-
-                    box += p000;
-                    box += p001;
-                    box += p010;
-                    box += p011;
-                    box += p100;
-                    box += p101;
-                    box += p110;
-                    box += p111;
-
-                    pointsInPart << p000;
-                    pointsInPart << p001;
-                    pointsInPart << p010;
-                    pointsInPart << p011;
-                    pointsInPart << p100;
-                    pointsInPart << p101;
-                    pointsInPart << p110;
-                    pointsInPart << p111;
-
                     // add next convex hull
-                    QVector<glm::vec3> newMeshPoints;
-                    pointCollection << newMeshPoints;
-                    // add points to the new convex hull
-                    pointCollection[i++] << pointsInPart;
+                    pointCollection << pointsInPart;
                 }
-            });
+            }
         }
-        polyVoxEntity->setCollisionPoints(pointCollection, box);
+        entity->setCollisionPoints(pointCollection, box);
     });
 }
 
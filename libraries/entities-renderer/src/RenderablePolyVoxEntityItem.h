@@ -168,6 +168,10 @@ private:
 
     graphics::MeshPointer _mesh;
 
+    // the meshes and collision hulls of the chunks of _volData, replaced along with _volData
+    struct PolyVoxChunks;
+    std::shared_ptr<PolyVoxChunks> _chunks;
+
     ShapeInfo _shapeInfo;
 
     std::shared_ptr<PolyVox::SimpleVolume<uint8_t>> _volData;
@@ -83,6 +83,52 @@ Item::Bound ShapeEntityRenderer::getBound(RenderArgs* args) {
     return Parent::getMaterialBound(args);
 }
 
+bool ShapeEntityRenderer::getOccluder(AABox& occluder) const {
+    if (_primitiveMode == PrimitiveMode::LINES || _billboardMode != BillboardMode::NONE || isTransparent()) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_materialsLock);
+        auto materials = _materials.find("0");
+        if (materials != _materials.cend() && getPipelineType(materials->second) == Pipeline::PROCEDURAL) {
+            // procedural shaders can move or discard the surface
+            return false;
+        }
+    }
+
+    entity::Shape shape;
+    Transform transform;
+    withReadLock([&] {
+        shape = _shape;
+        transform = _renderTransform;
+    });
+    if (shape != entity::Cube) {
+        return false;
+    }
+
+    // the largest box with the proportions of the cube's world bound that fits in the cube, which is the cube
+    // itself when it is axis aligned
+    glm::mat3 axes = glm::mat3_cast(transform.getRotation());
+    glm::vec3 halfExtents = 0.5f * glm::abs(transform.getScale());
+    glm::vec3 boundHalfExtents(0.0f);
+    for (int i = 0; i < 3; ++i) {
+        boundHalfExtents += glm::abs(axes[i]) * halfExtents[i];
+    }
+    float fit = FLT_MAX;
+    for (int i = 0; i < 3; ++i) {
+        float projectedExtent = glm::dot(glm::abs(axes[i]), boundHalfExtents);
+        if (projectedExtent > 0.0f) {
+            fit = std::min(fit, halfExtents[i] / projectedExtent);
+        }
+    }
+    if (fit == FLT_MAX) {
+        return false;
+    }
+    glm::vec3 occluderHalfExtents = fit * boundHalfExtents;
+    occluder = AABox(transform.getTranslation() - occluderHalfExtents, 2.0f * occluderHalfExtents);
+    return true;
+}
+
 ShapeKey ShapeEntityRenderer::getShapeKey() {
     ShapeKey::Builder builder;
     updateShapeKeyBuilderFromMaterials(builder);
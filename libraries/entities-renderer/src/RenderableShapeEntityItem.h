@@ -27,6 +27,7 @@ public:
 protected:
     ShapeKey getShapeKey() override;
     Item::Bound getBound(RenderArgs* args) override;
+    bool getOccluder(AABox& occluder) const override;
 
 private:
     virtual bool needsRenderUpdate() const override;
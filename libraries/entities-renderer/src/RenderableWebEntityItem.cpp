@@ -9,6 +9,8 @@
 
 #include "RenderableWebEntityItem.h"
 #include <atomic>
+#include <mutex>
+#include <unordered_set>
 
 #include <QtCore/QTimer>
 #include <QtGui/QOpenGLContext>
@@ -17,6 +19,8 @@
 #include <QtQuick/QQuickWindow>
 #include <QtQml/QQmlContext>
 
+#include <glm/gtx/component_wise.hpp>
+
 
 #include <GeometryCache.h>
 #include <PathUtils.h>
@@ -51,12 +55,25 @@ static float OPAQUE_ALPHA_THRESHOLD = 0.99f;
 // If a web-view hasn't been rendered for 30 seconds, de-allocate the framebuffer
 static uint64_t MAX_NO_RENDER_INTERVAL = 30 * USECS_PER_SECOND;
 
+// If a web-view hasn't been rendered for a couple of seconds it is off-screen, pause it until it is seen again
+static uint64_t MAX_NO_RENDER_SUSPEND_INTERVAL = 2 * USECS_PER_SECOND;
+
+// The size of a web entity over its distance to the view below which it is updated at a lower rate, and below which it
+// is frozen on its last frame
+static const float FULL_RATE_APPARENT_SIZE = 0.1f;
+static const float SNAPSHOT_APPARENT_SIZE = 0.02f;
+static const uint8_t FAR_FPS_DIVIDER = 4;
+
 static uint8_t YOUTUBE_MAX_FPS = 30;
 
 // Don't allow more than 20 concurrent web views
 static std::atomic<uint32_t> _currentWebCount(0);
 static const uint32_t MAX_CONCURRENT_WEB_VIEWS = 20;
 
+// The web entity renderers, to evict the surface of the one that was rendered the least recently when there are too many
+static std::mutex _renderersMutex;
+static std::unordered_set<WebEntityRenderer*> _renderers;
+
 static QTouchDevice _touchDevice;
 
 WebEntityRenderer::ContentType WebEntityRenderer::getContentType(const QString& urlString) {
@@ -96,9 +113,17 @@ WebEntityRenderer::WebEntityRenderer(const EntityItemPointer& entity) : Parent(e
 
     _timer.setInterval(MSECS_PER_SECOND);
     connect(&_timer, &QTimer::timeout, this, &WebEntityRenderer::onTimeout);
+    _timer.start();
+
+    std::lock_guard<std::mutex> lock(_renderersMutex);
+    _renderers.insert(this);
 }
 
 WebEntityRenderer::~WebEntityRenderer() {
+    {
+        std::lock_guard<std::mutex> lock(_renderersMutex);
+        _renderers.erase(this);
+    }
     destroyWebSurface();
 
     auto geometryCache = DependencyManager::get<GeometryCache>();
@@ -139,8 +164,46 @@ void WebEntityRenderer::onTimeout() {
         return;
     }
 
-    if (usecTimestampNow() - lastRenderTime > MAX_NO_RENDER_INTERVAL) {
-        destroyWebSurface();
+    uint64_t noRenderInterval = usecTimestampNow() - lastRenderTime;
+    if (noRenderInterval > MAX_NO_RENDER_INTERVAL) {
+        evictWebSurface();
+        return;
+    }
+
+    // A paused surface keeps showing its last frame, which is all that a far entity needs
+    withWriteLock([&] {
+        if (!_webSurface) {
+            return;
+        }
+        bool suspend = noRenderInterval > MAX_NO_RENDER_SUSPEND_INTERVAL || _apparentSize < SNAPSHOT_APPARENT_SIZE;
+        if (suspend != _suspended) {
+            if (suspend) {
+                _webSurface->pause();
+            } else {
+                _webSurface->resume();
+            }
+            _suspended = suspend;
+        }
+        if (!_suspended) {
+            setSurfaceFPS(getTargetFPS());
+        }
+    });
+}
+
+uint8_t WebEntityRenderer::getTargetFPS() const {
+    // We special case YouTube URLs since we know they are videos that we should play with at least 30 FPS.
+    // FIXME this doesn't handle redirects or shortened URLs, consider using a signaling method from the web entity
+    uint8_t fps = QUrl(_sourceURL).host().endsWith("youtube.com", Qt::CaseInsensitive) ? YOUTUBE_MAX_FPS : _maxFPS;
+    if (_apparentSize < FULL_RATE_APPARENT_SIZE) {
+        fps = std::max<uint8_t>(fps / FAR_FPS_DIVIDER, 1);
+    }
+    return fps;
+}
+
+void WebEntityRenderer::setSurfaceFPS(uint8_t fps) {
+    if (_surfaceFPS != fps) {
+        _webSurface->setMaxFps(fps);
+        _surfaceFPS = fps;
     }
 }
 
@@ -182,6 +245,10 @@ void WebEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene
         // This work must be done on the main thread
         bool localSafeContext = entity->getLocalSafeContext();
         if (!_webSurface) {
+            // an evicted surface is built again once the entity is seen
+            if (_evicted && !_rebuildRequested) {
+                return;
+            }
             if (localSafeContext) {
                 ::hifi::scripting::setLocalAccessSafeThread(true);
             }
@@ -200,9 +267,9 @@ void WebEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene
                     _webSurface->getRootItem()->setProperty(USE_BACKGROUND_PROPERTY, _useBackground);
                     _webSurface->getRootItem()->setProperty(USER_AGENT_PROPERTY, _userAgent);
                     _webSurface->getSurfaceContext()->setContextProperty(GLOBAL_POSITION_PROPERTY, vec3toVariant(_contextPosition));
-                    _webSurface->setMaxFps((QUrl(newSourceURL).host().endsWith("youtube.com", Qt::CaseInsensitive)) ? YOUTUBE_MAX_FPS : _maxFPS);
                     ::hifi::scripting::setLocalAccessSafeThread(false);
                     _sourceURL = newSourceURL;
+                    setSurfaceFPS(getTargetFPS());
                 } else if (_contentType != ContentType::HtmlContent) {
                     _sourceURL = newSourceURL;
                 }
@@ -218,14 +285,8 @@ void WebEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene
                 {
                     auto maxFPS = entity->getMaxFPS();
                     if (_maxFPS != maxFPS) {
-                        // We special case YouTube URLs since we know they are videos that we should play with at least 30 FPS.
-                        // FIXME this doesn't handle redirects or shortened URLs, consider using a signaling method from the web entity
-                        if (QUrl(_sourceURL).host().endsWith("youtube.com", Qt::CaseInsensitive)) {
-                            _webSurface->setMaxFps(YOUTUBE_MAX_FPS);
-                        } else {
-                            _webSurface->setMaxFps(maxFPS);
-                        }
                         _maxFPS = maxFPS;
+                        setSurfaceFPS(getTargetFPS());
                     }
                 }
 
@@ -272,9 +333,21 @@ void WebEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene
 
 void WebEntityRenderer::doRender(RenderArgs* args) {
     PerformanceTimer perfTimer("WebEntityRenderer::render");
-    withWriteLock([&] {
-        _lastRenderTime = usecTimestampNow();
-    });
+    // The shadows don't make the entity seen
+    if (args->_renderMode != RenderArgs::RenderMode::SHADOW_RENDER_MODE) {
+        bool rebuild = false;
+        withWriteLock([&] {
+            _lastRenderTime = usecTimestampNow();
+            float distance = glm::distance(args->getViewFrustum().getPosition(), _renderTransform.getTranslation());
+            _apparentSize = distance > 0.0f ? glm::compMax(glm::vec2(_renderTransform.getScale())) / distance : 1.0f;
+            rebuild = _evicted && !_rebuildRequested;
+            _rebuildRequested = _rebuildRequested || rebuild;
+        });
+        // The surface was destroyed while the entity wasn't seen, build it again
+        if (rebuild) {
+            emit requestRenderUpdate();
+        }
+    }
 
     // Try to update the texture
     OffscreenQmlSurface::TextureAndFence newTextureAndFence;
@@ -333,7 +406,7 @@ void WebEntityRenderer::doRender(RenderArgs* args) {
 }
 
 void WebEntityRenderer::buildWebSurface(const EntityItemPointer& entity, const QString& newSourceURL) {
-    if (_currentWebCount >= MAX_CONCURRENT_WEB_VIEWS) {
+    if (_currentWebCount >= MAX_CONCURRENT_WEB_VIEWS && !evictLeastRecentlyRendered(this)) {
         qWarning() << "Too many concurrent web views to create new view";
         return;
     }
@@ -345,6 +418,10 @@ void WebEntityRenderer::buildWebSurface(const EntityItemPointer& entity, const Q
     WebEntityRenderer::acquireWebSurface(newSourceURL, isHTML, _webSurface, _cachedWebSurface);
     _fadeStartTime = usecTimestampNow();
     _webSurface->resume();
+    _suspended = false;
+    _evicted = false;
+    _rebuildRequested = false;
+    _surfaceFPS = 0;
 
     _connections.push_back(QObject::connect(this, &WebEntityRenderer::scriptEventReceived, _webSurface.data(), &OffscreenQmlSurface::emitScriptEvent));
     _connections.push_back(QObject::connect(_webSurface.data(), &OffscreenQmlSurface::webEventReceived, this, &WebEntityRenderer::webEventReceived));
@@ -369,9 +446,69 @@ void WebEntityRenderer::destroyWebSurface() {
         }
 
         _contentType = ContentType::NoContent;
+        _suspended = false;
     });
 }
 
+void WebEntityRenderer::evictWebSurface() {
+    destroyWebSurface();
+    withWriteLock([&] {
+        // so that the next update builds the surface again, with all its properties
+        _tryingToBuildURL = QString();
+        _sourceURL = QString();
+        _evicted = true;
+        _rebuildRequested = false;
+    });
+}
+
+bool WebEntityRenderer::evictLeastRecentlyRendered(const WebEntityRenderer* except) {
+    std::lock_guard<std::mutex> lock(_renderersMutex);
+    WebEntityRenderer* leastRecentlyRendered = nullptr;
+    uint64_t leastRecentRenderTime = usecTimestampNow() - MAX_NO_RENDER_SUSPEND_INTERVAL;
+    for (auto renderer : _renderers) {
+        if (renderer == except) {
+            continue;
+        }
+        // only the surfaces that aren't seen, and that count towards the limit, are evicted
+        renderer->withReadLock([&] {
+            if (renderer->_webSurface && renderer->_contentType == ContentType::HtmlContent &&
+                renderer->_lastRenderTime < leastRecentRenderTime) {
+                leastRecentlyRendered = renderer;
+                leastRecentRenderTime = renderer->_lastRenderTime;
+            }
+        });
+    }
+    if (!leastRecentlyRendered) {
+        return false;
+    }
+    leastRecentlyRendered->evictWebSurface();
+    return true;
+}
+
+QVariantList WebEntityRenderer::getWebSurfaceStats() {
+    std::lock_guard<std::mutex> lock(_renderersMutex);
+    QVariantList stats;
+    uint64_t now = usecTimestampNow();
+    for (auto renderer : _renderers) {
+        renderer->withReadLock([&] {
+            if (!renderer->_webSurface) {
+                return;
+            }
+            QVariantMap surfaceStats;
+            surfaceStats["url"] = renderer->_sourceURL;
+            surfaceStats["html"] = renderer->_contentType == ContentType::HtmlContent;
+            surfaceStats["width"] = renderer->_webSurface->size().width();
+            surfaceStats["height"] = renderer->_webSurface->size().height();
+            surfaceStats["maxFPS"] = renderer->_surfaceFPS;
+            surfaceStats["suspended"] = renderer->_suspended;
+            surfaceStats["msecsSinceRendered"] = renderer->_lastRenderTime != 0 ?
+                (qint64)((now - renderer->_lastRenderTime) / USECS_PER_MSEC) : -1;
+            stats.push_back(surfaceStats);
+        });
+    }
+    return stats;
+}
+
 glm::vec2 WebEntityRenderer::getWindowSize(const TypedEntityPointer& entity) const {
     glm::vec2 dims = glm::vec2(entity->getScaledDimensions());
     dims *= METERS_TO_INCHES * _dpi;
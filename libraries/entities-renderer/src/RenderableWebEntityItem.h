@@ -13,6 +13,7 @@
 #define hifi_RenderableWebEntityItem_h
 
 #include <QtCore/QSharedPointer>
+#include <QtCore/QVariantList>
 #include <WebEntityItem.h>
 #include "RenderableEntityItem.h"
 
@@ -60,6 +61,10 @@ public:
 
     gpu::TexturePointer getTexture() override { return _texture; }
 
+    /// The state of the surfaces of the web entities, one map per surface with its url, rate, size and whether it is
+    /// suspended, for the stats.  This must be called on the main thread.
+    static QVariantList getWebSurfaceStats();
+
 protected:
     virtual bool needsRenderUpdateFromTypedEntity(const TypedEntityPointer& entity) const override;
     virtual void doRenderUpdateSynchronousTyped(const ScenePointer& scene, Transaction& transaction, const TypedEntityPointer& entity) override;
@@ -76,6 +81,12 @@ private:
     void onTimeout();
     void buildWebSurface(const EntityItemPointer& entity, const QString& newSourceURL);
     void destroyWebSurface();
+    // Destroys the surface of an entity that isn't seen, which is built again the next time that the entity is rendered
+    void evictWebSurface();
+    static bool evictLeastRecentlyRendered(const WebEntityRenderer* except);
+    // The rate of the content, lowered when the entity is far, must be called with the lock held
+    uint8_t getTargetFPS() const;
+    void setSurfaceFPS(uint8_t fps);
     glm::vec2 getWindowSize(const TypedEntityPointer& entity) const;
 
     int _geometryId{ 0 };
@@ -108,6 +119,12 @@ private:
 
     QTimer _timer;
     uint64_t _lastRenderTime { 0 };
+    // the size of the entity over its distance to the view when it was last rendered
+    float _apparentSize { 1.0f };
+    uint8_t _surfaceFPS { 0 };
+    bool _suspended { false };
+    bool _evicted { false };
+    bool _rebuildRequested { false };
 
     std::vector<QMetaObject::Connection> _connections;
 
@@ -150,12 +150,12 @@ float DiffTraversal::View::computePriority(const EntityItemPointer& entity) cons
         // pops to the next higher cell. So we want to check to see that the entity is large enough to be seen
         // before we consider including it.
         float angularSize = frustum.getAngularSize(distance, radius);
-        if (angularSize > lodScaleFactor * MIN_ENTITY_ANGULAR_DIAMETER &&
+        if (angularSize > lodScaleFactor * frustum.getLODScale() * MIN_ENTITY_ANGULAR_DIAMETER &&
             frustum.intersects(position, distance, radius)) {
 
-            // use the angular size as priority
+            // use the angular size, weighted by the importance of the view, as priority
             // we compute the max priority for all frustums
-            priority = std::max(priority, angularSize);
+            priority = std::max(priority, frustum.getPriorityWeight() * angularSize);
         }
     }
 
@@ -183,7 +183,7 @@ bool DiffTraversal::View::shouldTraverseElement(const EntityTreeElement& element
         // before we consider including it.
         float angularSize = frustum.getAngularSize(distance, radius);
 
-        return angularSize > lodScaleFactor * MIN_ELEMENT_ANGULAR_DIAMETER &&
+        return angularSize > lodScaleFactor * frustum.getLODScale() * MIN_ELEMENT_ANGULAR_DIAMETER &&
                frustum.intersects(position, distance, radius);
     });
 }
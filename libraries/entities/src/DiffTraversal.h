@@ -73,6 +73,9 @@ public:
 
     void reset() { _path.clear(); _completedView.startTime = 0; } // resets our state to force a new "First" traversal
 
+    // ends the current traversal as if it had completed with view, for results of a traversal of a very similar view
+    void adoptCompletedView(const View& view) { _path.clear(); _currentView = view; _completedView = view; }
+
 private:
     void getNextVisibleElement(VisibleElement& next);
 
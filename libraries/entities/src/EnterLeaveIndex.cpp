@@ -0,0 +1,232 @@
+//
+//  EnterLeaveIndex.cpp
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EnterLeaveIndex.h"
+
+#include <algorithm>
+
+const float EnterLeaveIndex::ZONE_CHECK_DISTANCE = 0.001f;
+const uint64_t EnterLeaveIndex::CONTAINMENT_LIFETIME = USECS_PER_SECOND;
+
+// leaves hold up to this many entries, testing them is cheaper than descending further
+static const uint32_t MAX_LEAF_ENTRIES = 4;
+
+bool EnterLeaveIndex::isCandidate(const EntityItemPointer& entity) {
+    // only zones and entities with scripts can have events fired on them
+    return entity->getType() == EntityTypes::Zone || !entity->getScript().isEmpty();
+}
+
+void EnterLeaveIndex::clear() {
+    _entries.clear();
+    _indices.clear();
+    _nodes.clear();
+    _order.clear();
+    _needsRebuild = false;
+}
+
+void EnterLeaveIndex::update(const EntityItemPointer& entity) {
+    if (!isCandidate(entity)) {
+        remove(entity->getEntityItemID());
+        return;
+    }
+
+    bool success;
+    AABox box = entity->getAABox(success);
+    auto itr = _indices.find(entity->getEntityItemID());
+    if (itr != _indices.end()) {
+        Entry& entry = _entries[itr->second];
+        entry.entity = entity;
+        entry.hasContainment = false;
+        if (success && !(entry.box == box)) {
+            entry.box = box;
+            _needsRebuild = true;
+        }
+        return;
+    }
+
+    Entry entry;
+    entry.entity = entity;
+    entry.id = entity->getEntityItemID();
+    // an entity whose parent hasn't arrived yet is placed once refit() finds its box
+    entry.box = success ? box : AABox();
+    _indices[entry.id] = _entries.size();
+    _entries.push_back(entry);
+    _needsRebuild = true;
+}
+
+void EnterLeaveIndex::remove(const EntityItemID& id) {
+    auto itr = _indices.find(id);
+    if (itr == _indices.end()) {
+        return;
+    }
+    size_t index = itr->second;
+    _indices.erase(itr);
+    if (index != _entries.size() - 1) {
+        _entries[index] = std::move(_entries.back());
+        _indices[_entries[index].id] = index;
+    }
+    _entries.pop_back();
+    _needsRebuild = true;
+}
+
+bool EnterLeaveIndex::refit() {
+    // Candidates are added and removed as the tree tells us, but they move without telling, so their boxes are taken
+    // again. Those are cached by the entities, and there are far fewer candidates than entities.
+    bool moved = false;
+    for (size_t i = 0; i < _entries.size();) {
+        Entry& entry = _entries[i];
+        EntityItemPointer entity = entry.entity.lock();
+        if (!entity || entity->isDead()) {
+            EntityItemID id = entry.id;
+            remove(id);
+            continue;
+        }
+        bool success;
+        AABox box = entity->getAABox(success);
+        if (!success) {
+            box = AABox();
+        }
+        if (!(box == entry.box)) {
+            entry.box = box;
+            entry.hasContainment = false;
+            moved = true;
+        }
+        i++;
+    }
+    return moved;
+}
+
+void EnterLeaveIndex::rebuild() {
+    _nodes.clear();
+    _order.clear();
+    _order.reserve(_entries.size());
+    for (uint32_t i = 0; i < (uint32_t)_entries.size(); i++) {
+        if (!_entries[i].box.isInvalid()) {
+            _order.push_back(i);
+        }
+    }
+    if (!_order.empty()) {
+        _nodes.reserve(2 * _order.size() / MAX_LEAF_ENTRIES + 1);
+        buildNode(0, (uint32_t)_order.size());
+    }
+    _needsRebuild = false;
+}
+
+uint32_t EnterLeaveIndex::buildNode(uint32_t first, uint32_t count) {
+    uint32_t index = (uint32_t)_nodes.size();
+    _nodes.emplace_back();
+
+    AABox box;
+    for (uint32_t i = first; i < first + count; i++) {
+        box += _entries[_order[i]].box;
+    }
+    _nodes[index].box = box;
+
+    if (count <= MAX_LEAF_ENTRIES) {
+        _nodes[index].first = first;
+        _nodes[index].count = count;
+        return index;
+    }
+
+    // split at the median of the box centers along the longest side
+    glm::vec3 dimensions = box.getDimensions();
+    int axis = (dimensions.x >= dimensions.y && dimensions.x >= dimensions.z) ? 0 : (dimensions.y >= dimensions.z ? 1 : 2);
+    uint32_t half = count / 2;
+    std::nth_element(_order.begin() + first, _order.begin() + first + half, _order.begin() + first + count,
+        [&](uint32_t left, uint32_t right) {
+            return _entries[left].box.calcCenter()[axis] < _entries[right].box.calcCenter()[axis];
+        });
+
+    buildNode(first, half);
+    uint32_t right = buildNode(first + half, count - half);
+    _nodes[index].first = right;
+    return index;
+}
+
+AABox EnterLeaveIndex::fitNode(uint32_t index) {
+    Node& node = _nodes[index];
+    AABox box;
+    if (node.count > 0) {
+        for (uint32_t i = node.first; i < node.first + node.count; i++) {
+            box += _entries[_order[i]].box;
+        }
+    } else {
+        box += fitNode(index + 1);
+        box += fitNode(node.first);
+    }
+    _nodes[index].box = box;
+    return box;
+}
+
+void EnterLeaveIndex::findCandidates(const glm::vec3& point, float radius, std::vector<EntityItemPointer>& candidates) {
+    bool moved = refit();
+    if (_needsRebuild) {
+        rebuild();
+    } else if (moved) {
+        // a candidate found its box or lost it, which changes the entries of the leaves, so it needs a rebuild too
+        bool placementChanged = _order.size() != (size_t)std::count_if(_entries.begin(), _entries.end(),
+            [](const Entry& entry) { return !entry.box.isInvalid(); });
+        if (placementChanged) {
+            rebuild();
+        } else if (!_nodes.empty()) {
+            fitNode(0);
+        }
+    }
+
+    if (_nodes.empty()) {
+        return;
+    }
+    std::vector<uint32_t> stack;
+    stack.push_back(0);
+    while (!stack.empty()) {
+        uint32_t index = stack.back();
+        stack.pop_back();
+        const Node& node = _nodes[index];
+        if (!node.box.touchesSphere(point, radius)) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                const Entry& entry = _entries[_order[i]];
+                if (entry.box.touchesSphere(point, radius)) {
+                    EntityItemPointer entity = entry.entity.lock();
+                    if (entity) {
+                        candidates.push_back(entity);
+                    }
+                }
+            }
+        } else {
+            stack.push_back(node.first);
+            stack.push_back(index + 1);
+        }
+    }
+}
+
+bool EnterLeaveIndex::contains(const EntityItemPointer& entity, const glm::vec3& point, uint64_t now) {
+    auto itr = _indices.find(entity->getEntityItemID());
+    if (itr == _indices.end()) {
+        return entity->contains(point);
+    }
+
+    Entry& entry = _entries[itr->second];
+    quint64 lastEdited = entity->getLastEdited();
+    if (entry.hasContainment && entry.testedLastEdited == lastEdited && now - entry.testedTime < CONTAINMENT_LIFETIME &&
+            glm::distance(entry.testedPoint, point) <= ZONE_CHECK_DISTANCE) {
+        return entry.contains;
+    }
+
+    entry.contains = entity->contains(point);
+    entry.hasContainment = true;
+    entry.testedPoint = point;
+    entry.testedTime = now;
+    entry.testedLastEdited = lastEdited;
+    return entry.contains;
+}
@@ -0,0 +1,81 @@
+//
+//  EnterLeaveIndex.h
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_EnterLeaveIndex_h
+#define overte_EnterLeaveIndex_h
+
+#include <unordered_map>
+#include <vector>
+
+#include <AABox.h>
+
+#include "EntityItem.h"
+
+/// A bounding volume hierarchy over the entities that the avatar can enter and leave, the zones and the entities with
+/// scripts, so that finding those around the avatar doesn't search the whole entity tree, and a cache of their
+/// containment tests, so that the shapes of the zones the avatar stands in aren't tested again until it moves.
+class EnterLeaveIndex {
+public:
+    static bool isCandidate(const EntityItemPointer& entity);
+
+    void clear();
+    size_t size() const { return _entries.size(); }
+
+    /// Adds the entity if it is a candidate, or removes it if it no longer is
+    void update(const EntityItemPointer& entity);
+    void remove(const EntityItemID& id);
+
+    /// Finds the candidates whose boxes are within radius of the point. The hierarchy is refitted to the candidates that
+    /// moved, and rebuilt if candidates were added or removed, first.
+    void findCandidates(const glm::vec3& point, float radius, std::vector<EntityItemPointer>& candidates);
+
+    /// EntityItem::contains(), answered from the last test of the entity while it hasn't changed, the point is within
+    /// ZONE_CHECK_DISTANCE of the one tested and the answer isn't older than CONTAINMENT_LIFETIME
+    bool contains(const EntityItemPointer& entity, const glm::vec3& point, uint64_t now);
+
+    static const float ZONE_CHECK_DISTANCE;
+    // some answers change without an edit, like those of a zone whose shape model was loading
+    static const uint64_t CONTAINMENT_LIFETIME;
+
+private:
+    struct Entry {
+        EntityItemWeakPointer entity;
+        EntityItemID id;
+        AABox box;
+
+        bool hasContainment { false };
+        bool contains { false };
+        glm::vec3 testedPoint;
+        uint64_t testedTime { 0 };
+        quint64 testedLastEdited { 0 };
+    };
+
+    // the nodes are stored depth first, so an inner node's left child follows it
+    struct Node {
+        AABox box;
+        uint32_t first { 0 };   // the first of its entries in _order if it is a leaf, its right child otherwise
+        uint32_t count { 0 };   // 0 for the inner nodes
+    };
+
+    bool refit();
+    void rebuild();
+    uint32_t buildNode(uint32_t first, uint32_t count);
+    AABox fitNode(uint32_t index);
+
+    std::vector<Entry> _entries;
+    std::unordered_map<EntityItemID, size_t> _indices;
+
+    std::vector<Node> _nodes;
+    std::vector<uint32_t> _order;
+    bool _needsRebuild { false };
+};
+
+#endif // overte_EnterLeaveIndex_h
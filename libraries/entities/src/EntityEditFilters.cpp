@@ -13,6 +13,13 @@
 
 #include "EntityEditFilters.h"
 
+#include <float.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include <QUrl>
 
 #include <ResourceManager.h>
@@ -20,6 +27,100 @@
 #include <ScriptEngine.h>
 #include <ScriptManager.h>
 #include <ScriptProgram.h>
+#include <ScriptValueUtils.h>
+
+// Aborts a filter function that runs past its time budget. It runs on a thread of its own, as the edit
+// processing thread is the one stuck in the filter. Edits are filtered one at a time, so one watchdog serves all filters.
+class FilterWatchdog {
+public:
+    FilterWatchdog() : _thread([this] { run(); }) {}
+    ~FilterWatchdog() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _quit = true;
+        }
+        _condition.notify_one();
+        _thread.join();
+    }
+
+    void arm(ScriptEngine* engine, int budgetMsecs) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _engine = engine;
+        _deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(budgetMsecs);
+        _timedOut = false;
+        _condition.notify_one();
+    }
+
+    // returns whether the filter function was aborted
+    bool disarm() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _engine = nullptr;
+        return _timedOut;
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (!_quit) {
+            if (!_engine) {
+                _condition.wait(lock);
+            } else {
+                _condition.wait_until(lock, _deadline);
+                if (_engine && std::chrono::steady_clock::now() >= _deadline) {
+                    _engine->abortEvaluation();
+                    _timedOut = true;
+                    _engine = nullptr;
+                }
+            }
+        }
+    }
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    ScriptEngine* _engine { nullptr };
+    std::chrono::steady_clock::time_point _deadline;
+    bool _timedOut { false };
+    bool _quit { false };
+    std::thread _thread;
+};
+
+static FilterWatchdog& getFilterWatchdog() {
+    static FilterWatchdog watchdog;
+    return watchdog;
+}
+
+// the vector properties filter.rules can give ranges for
+struct RangeProperty {
+    const char* name;
+    EntityPropertyList property;
+    bool (EntityItemProperties::*changed)() const;
+    const glm::vec3& (EntityItemProperties::*get)() const;
+    void (EntityItemProperties::*set)(const glm::vec3& value);
+};
+
+static const RangeProperty RANGE_PROPERTIES[] = {
+    { "position", PROP_POSITION, &EntityItemProperties::positionChanged,
+      &EntityItemProperties::getPosition, &EntityItemProperties::setPosition },
+    { "dimensions", PROP_DIMENSIONS, &EntityItemProperties::dimensionsChanged,
+      &EntityItemProperties::getDimensions, &EntityItemProperties::setDimensions },
+    { "velocity", PROP_VELOCITY, &EntityItemProperties::velocityChanged,
+      &EntityItemProperties::getVelocity, &EntityItemProperties::setVelocity },
+    { "angularVelocity", PROP_ANGULAR_VELOCITY, &EntityItemProperties::angularVelocityChanged,
+      &EntityItemProperties::getAngularVelocity, &EntityItemProperties::setAngularVelocity },
+    { "gravity", PROP_GRAVITY, &EntityItemProperties::gravityChanged,
+      &EntityItemProperties::getGravity, &EntityItemProperties::setGravity },
+    { "acceleration", PROP_ACCELERATION, &EntityItemProperties::accelerationChanged,
+      &EntityItemProperties::getAcceleration, &EntityItemProperties::setAcceleration }
+};
+
+static const RangeProperty* findRangeProperty(EntityPropertyList property) {
+    for (const auto& rangeProperty : RANGE_PROPERTIES) {
+        if (rangeProperty.property == property) {
+            return &rangeProperty;
+        }
+    }
+    return nullptr;
+}
 
 QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
     QList<EntityItemID> zones;
@@ -78,6 +179,16 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                 return true; // accept the message
             }
 
+            if (filterData.hasRules) {
+                ++_numRulesFiltered;
+                if (!filterByRules(filterData, propertiesIn, propertiesOut, wasChanged)) {
+                    return false;
+                }
+                if (!filterData.filterFn.isFunction()) {
+                    continue; // the rules are all there is to this filter
+                }
+            }
+
             auto oldProperties = propertiesIn.getDesiredProperties();
             auto specifiedProperties = propertiesIn.getChangedProperties();
             propertiesIn.setDesiredProperties(specifiedProperties);
@@ -134,7 +245,18 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                 }
             }
 
+            ++_numScriptsFiltered;
+            int budgetMsecs = _filterTimeBudgetMsecs;
+            if (budgetMsecs > 0) {
+                getFilterWatchdog().arm(filterData.engine.get(), budgetMsecs);
+            }
             ScriptValue result = filterData.filterFn.call(_nullObjectForFilter, args);
+            if (budgetMsecs > 0 && getFilterWatchdog().disarm()) {
+                ++_numScriptsTimedOut;
+                qWarning() << "Entity edit filter" << id << "ran past its time budget of" << budgetMsecs << "ms, rejecting the edit";
+                filterData.engine->clearExceptions();
+                return false;
+            }
 
             if (filterData.uncaughtExceptions()) {
                 return false;
@@ -169,6 +291,83 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
     return true;
 }
 
+bool EntityEditFilters::filterByRules(const FilterData& filterData, EntityItemProperties& propertiesIn,
+                                      EntityItemProperties& propertiesOut, bool& wasChanged) {
+    EntityPropertyFlags changedProperties = propertiesIn.getChangedProperties();
+    for (int flag = (int)changedProperties.firstFlag(); flag <= (int)changedProperties.lastFlag(); flag++) {
+        EntityPropertyList property = (EntityPropertyList)flag;
+        if (!changedProperties.getHasProperty(property)) {
+            continue;
+        }
+        if (filterData.rejectedProperties.getHasProperty(property) ||
+            (!filterData.allowedProperties.isEmpty() && !filterData.allowedProperties.getHasProperty(property))) {
+            return false;
+        }
+    }
+
+    for (const auto& range : filterData.ranges) {
+        const RangeProperty* rangeProperty = findRangeProperty(range.property);
+        if (!rangeProperty || !(propertiesIn.*rangeProperty->changed)()) {
+            continue;
+        }
+        glm::vec3 value = (propertiesIn.*rangeProperty->get)();
+        glm::vec3 clamped = glm::clamp(value, range.minimum, range.maximum);
+        if (clamped != value) {
+            if (!range.clamp) {
+                return false;
+            }
+            (propertiesIn.*rangeProperty->set)(clamped);
+            (propertiesOut.*rangeProperty->set)(clamped);
+            wasChanged = true;
+        }
+    }
+    return true;
+}
+
+// filter.rules = {
+//     allowedProperties: [ "position", ... ], // edits of any other property are rejected
+//     rejectedProperties: [ "script", ... ],
+//     ranges: { position: { min: { x, y, z }, max: { x, y, z }, clamp: true }, ... }
+// }
+void EntityEditFilters::readRules(const ScriptValue& rulesValue, FilterData& filterData) {
+    if (!rulesValue.isObject()) {
+        return;
+    }
+    filterData.hasRules = true;
+
+    ScriptValue allowedValue = rulesValue.property("allowedProperties");
+    if (allowedValue.isArray() || allowedValue.isString()) {
+        EntityPropertyFlagsFromScriptValue(allowedValue, filterData.allowedProperties);
+    }
+    ScriptValue rejectedValue = rulesValue.property("rejectedProperties");
+    if (rejectedValue.isArray() || rejectedValue.isString()) {
+        EntityPropertyFlagsFromScriptValue(rejectedValue, filterData.rejectedProperties);
+    }
+
+    ScriptValue rangesValue = rulesValue.property("ranges");
+    if (rangesValue.isObject()) {
+        for (const auto& rangeProperty : RANGE_PROPERTIES) {
+            ScriptValue rangeValue = rangesValue.property(rangeProperty.name);
+            if (!rangeValue.isObject()) {
+                continue;
+            }
+            FilterData::Range range;
+            range.property = rangeProperty.property;
+            range.minimum = glm::vec3(-FLT_MAX);
+            range.maximum = glm::vec3(FLT_MAX);
+            if (rangeValue.property("min").isObject()) {
+                vec3FromScriptValue(rangeValue.property("min"), range.minimum);
+            }
+            if (rangeValue.property("max").isObject()) {
+                vec3FromScriptValue(rangeValue.property("max"), range.maximum);
+            }
+            ScriptValue clampValue = rangeValue.property("clamp");
+            range.clamp = clampValue.isBool() && clampValue.toBool();
+            filterData.ranges.push_back(range);
+        }
+    }
+}
+
 void EntityEditFilters::removeFilter(EntityItemID entityID) {
     QWriteLocker writeLock(&_lock);
     _filterDataMap.remove(entityID);
@@ -277,7 +476,8 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
                 entitiesObject.setProperty("DELETE_FILTER_TYPE", EntityTree::FilterType::Delete);
                 global.setProperty("Entities", entitiesObject);
                 filterData.filterFn = global.property("filter");
-                if (!filterData.filterFn.isFunction()) {
+                readRules(filterData.filterFn.property("rules"), filterData);
+                if (!filterData.filterFn.isFunction() && !filterData.hasRules) {
                     qDebug() << "Filter function specified but not found. Will reject all edits for those without lock rights.";
                     engine.reset();
                     filterData.rejectAll=true;
@@ -17,7 +17,9 @@
 #include <QMap>
 #include <glm/glm.hpp>
 
+#include <atomic>
 #include <functional>
+#include <vector>
 
 #include <ScriptValue.h>
 
@@ -44,14 +46,29 @@ public:
         EntityPropertyFlags includedZoneProperties;
         bool wantsZoneBoundingBox { false };
 
+        // checks compiled from filter.rules, run natively before the filter function, or instead of it if there is none
+        struct Range {
+            EntityPropertyList property;
+            glm::vec3 minimum;
+            glm::vec3 maximum;
+            bool clamp { false }; // clamp values outside the range, rather than rejecting the edit
+        };
+        bool hasRules { false };
+        EntityPropertyFlags allowedProperties; // when not empty, edits of any other property are rejected
+        EntityPropertyFlags rejectedProperties;
+        std::vector<Range> ranges;
+
         std::function<bool()> uncaughtExceptions;
         ScriptEnginePointer engine;
         bool rejectAll;
         
         FilterData(): rejectAll(false) {};
-        bool valid() { return (rejectAll || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
+        bool valid() { return (rejectAll || (hasRules && !filterFn.isFunction()) ||
+                               (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
     };
 
+    static const int DEFAULT_FILTER_TIME_BUDGET_MSECS = 100;
+
     EntityEditFilters() {};
     EntityEditFilters(EntityTreePointer tree ): _tree(tree) {};
 
@@ -61,6 +78,13 @@ public:
     bool filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, 
                 EntityTree::FilterType filterType, EntityItemID& entityID, const EntityItemPointer& existingEntity);
 
+    // a filter function still running after this long is aborted and the edit rejected, 0 for no limit
+    void setFilterTimeBudget(int msecs) { _filterTimeBudgetMsecs = msecs; }
+
+    uint64_t getNumRulesFiltered() const { return _numRulesFiltered; }
+    uint64_t getNumScriptsFiltered() const { return _numScriptsFiltered; }
+    uint64_t getNumScriptsTimedOut() const { return _numScriptsTimedOut; }
+
 signals:
     void filterAdded(EntityItemID id, bool success);
 
@@ -69,10 +93,18 @@ private slots:
     
 private:
     QList<EntityItemID> getZonesByPosition(glm::vec3& position);
+    static bool filterByRules(const FilterData& filterData, EntityItemProperties& propertiesIn,
+                              EntityItemProperties& propertiesOut, bool& wasChanged);
+    static void readRules(const ScriptValue& rulesValue, FilterData& filterData);
 
     EntityTreePointer _tree {};
     bool _rejectAll {false};
     ScriptValue _nullObjectForFilter{};
+
+    std::atomic<int> _filterTimeBudgetMsecs { DEFAULT_FILTER_TIME_BUDGET_MSECS };
+    std::atomic<uint64_t> _numRulesFiltered { 0 };
+    std::atomic<uint64_t> _numScriptsFiltered { 0 };
+    std::atomic<uint64_t> _numScriptsTimedOut { 0 };
     
     QReadWriteLock _lock;
     QMap<EntityItemID, FilterData> _filterDataMap;
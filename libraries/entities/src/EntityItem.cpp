@@ -31,6 +31,7 @@
 #include <Profile.h>
 #include <RegisteredMetaTypes.h>
 #include <SharedUtil.h> // usecTimestampNow()
+#include <StringPool.h>
 #include <LogHandler.h>
 #include <Extents.h>
 #include <QVariantGLM.h>
@@ -1085,7 +1086,7 @@ void EntityItem::setHref(QString value) {
     // be handled by `AddressManager::handleLookupString()`. That function will return `false` and not do
     // anything if the value of this property isn't something that function can handle.
     withWriteLock([&] {
-        _href = value;
+        _href = StringPool::instance().intern(value);
     });
 }
 
@@ -1093,7 +1094,7 @@ void EntityItem::setCollisionSoundURL(const QString& value) {
     bool modified = false;
     withWriteLock([&] {
         if (_collisionSoundURL != value) {
-            _collisionSoundURL = value;
+            _collisionSoundURL = StringPool::instance().intern(value);
             modified = true;
         }
     });
@@ -2765,6 +2766,10 @@ void EntityItem::requiresRecalcBoxes() {
         _recalcMinAACube = true;
         _recalcMaxAACube = true;
     });
+    EntityTreeElementPointer element = _element; // use local copy of _element for logic below
+    if (element) {
+        element->entityBoundsChanged();
+    }
 }
 
 QString EntityItem::getHref() const {
@@ -2785,7 +2790,7 @@ QString EntityItem::getDescription() const {
 
 void EntityItem::setDescription(const QString& value) {
     withWriteLock([&] {
-        _description = value;
+        _description = StringPool::instance().intern(value);
     });
 }
 
@@ -2862,7 +2867,10 @@ QString EntityItem::getScript() const {
 
 void EntityItem::setScript(const QString& value) {
     withWriteLock([&] {
-        _script = value;
+        if (_script != value) {
+            ++_scriptVersion;
+            _script = StringPool::instance().intern(value);
+        }
     });
 }
 
@@ -2890,7 +2898,10 @@ QString EntityItem::getServerScripts() const {
 
 void EntityItem::setServerScripts(const QString& serverScripts) {
     withWriteLock([&] {
-        _serverScripts = serverScripts;
+        if (_serverScripts != serverScripts) {
+            ++_serverScriptsVersion;
+            _serverScripts = StringPool::instance().intern(serverScripts);
+        }
         _serverScriptsChangedTimestamp = usecTimestampNow();
     });
 }
@@ -2927,7 +2938,7 @@ QString EntityItem::getName() const {
 
 void EntityItem::setName(const QString& value) {
     withWriteLock([&] {
-        _name = value;
+        _name = StringPool::instance().intern(value);
     });
 }
 
@@ -3121,7 +3132,10 @@ QString EntityItem::getUserData() const {
 
 void EntityItem::setUserData(const QString& value) {
     withWriteLock([&] {
-        _userData = value;
+        if (_userData != value) {
+            ++_userDataVersion;
+            _userData = StringPool::instance().intern(value);
+        }
     });
 }
 
@@ -3135,7 +3149,25 @@ QString EntityItem::getPrivateUserData() const {
 
 void EntityItem::setPrivateUserData(const QString& value) {
     withWriteLock([&] {
-        _privateUserData = value;
+        _privateUserData = StringPool::instance().intern(value);
+    });
+}
+
+void EntityItem::getBlobPropertyVersions(PropertyVersions& versions) const {
+    withReadLock([&] {
+        versions.emplace_back(PROP_USER_DATA, _userDataVersion);
+        versions.emplace_back(PROP_SCRIPT, _scriptVersion);
+        versions.emplace_back(PROP_SERVER_SCRIPTS, _serverScriptsVersion);
+    });
+}
+
+size_t EntityItem::getUnsharedStringBytes() const {
+    return resultWithReadLock<size_t>([&] {
+        return StringPool::getUnsharedBytes(_script) + StringPool::getUnsharedBytes(_loadedScript) +
+            StringPool::getUnsharedBytes(_serverScripts) + StringPool::getUnsharedBytes(_collisionSoundURL) +
+            StringPool::getUnsharedBytes(_userData) + StringPool::getUnsharedBytes(_privateUserData) +
+            StringPool::getUnsharedBytes(_name) + StringPool::getUnsharedBytes(_href) +
+            StringPool::getUnsharedBytes(_description);
     });
 }
 
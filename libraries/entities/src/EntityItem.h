@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <stdint.h>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -343,6 +344,14 @@ public:
     QString getPrivateUserData() const;
     void setPrivateUserData(const QString& value);
 
+    using PropertyVersions = std::vector<std::pair<EntityPropertyList, uint32_t>>;
+    /// Versions of the properties that commonly hold large blobs which rarely change, bumped when their value changes,
+    /// so that a sender can leave out the ones a receiver already has
+    virtual void getBlobPropertyVersions(PropertyVersions& versions) const;
+
+    /// The size of the strings of the entity that are neither interned nor shared with other entities, in bytes
+    virtual size_t getUnsharedStringBytes() const;
+
     // FIXME not thread safe?
     const SimulationOwner& getSimulationOwner() const { return _simulationOwner; }
     void setSimulationOwner(const QUuid& id, uint8_t priority);
@@ -636,6 +645,9 @@ protected:
     bool _locked { ENTITY_ITEM_DEFAULT_LOCKED };
     QString _userData { ENTITY_ITEM_DEFAULT_USER_DATA };
     QString _privateUserData{ ENTITY_ITEM_DEFAULT_PRIVATE_USER_DATA };
+    uint32_t _userDataVersion { 0 };
+    uint32_t _scriptVersion { 0 };
+    uint32_t _serverScriptsVersion { 0 };
     SimulationOwner _simulationOwner;
     bool _shouldHighlight { false };
     QString _name { ENTITY_ITEM_DEFAULT_NAME };
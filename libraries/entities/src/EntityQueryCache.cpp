@@ -0,0 +1,52 @@
+//
+//  EntityQueryCache.cpp
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EntityQueryCache.h"
+
+#include <algorithm>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+static const size_t MAX_CACHED_QUERIES = 64;
+static const quint64 MAX_CACHED_QUERY_AGE = USECS_PER_SECOND / 60;
+
+bool EntityQueryCache::find(const Key& key, uint64_t queryVersion, QVector<QUuid>& foundEntities) {
+    quint64 now = usecTimestampNow();
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& entry : _entries) {
+        if (entry.key == key && entry.queryVersion == queryVersion && entry.foundAt + MAX_CACHED_QUERY_AGE >= now) {
+            foundEntities = entry.foundEntities;
+            ++_numHits;
+            return true;
+        }
+    }
+    ++_numMisses;
+    return false;
+}
+
+void EntityQueryCache::insert(const Key& key, uint64_t queryVersion, const QVector<QUuid>& foundEntities) {
+    quint64 now = usecTimestampNow();
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // the results of older versions or ages can't be found again
+    _entries.erase(std::remove_if(_entries.begin(), _entries.end(), [&](const Entry& entry) {
+        return entry.queryVersion != queryVersion || entry.foundAt + MAX_CACHED_QUERY_AGE < now || entry.key == key;
+    }), _entries.end());
+
+    if (_entries.size() >= MAX_CACHED_QUERIES) {
+        auto oldest = std::min_element(_entries.begin(), _entries.end(), [](const Entry& a, const Entry& b) {
+            return a.foundAt < b.foundAt;
+        });
+        _entries.erase(oldest);
+    }
+    _entries.push_back({ key, queryVersion, now, foundEntities });
+}
@@ -0,0 +1,72 @@
+//
+//  EntityQueryCache.h
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_EntityQueryCache_h
+#define overte_EntityQueryCache_h
+
+#include <stdint.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <QtCore/QUuid>
+#include <QtCore/QVector>
+
+#include <PickFilter.h>
+
+// Results of the recent sphere and box queries of an entity tree, for scripts that repeat the same query.
+//
+// A result is valid while the tree's query version, bumped by the tree's changes, is the one it was found at.
+// Entities moved by their parent avatar do not change the tree, so a result is also only kept for about a frame.
+class EntityQueryCache {
+public:
+    enum Shape : uint8_t {
+        Sphere,
+        Box
+    };
+
+    struct Key {
+        Shape shape;
+        glm::vec3 position; // the center of a sphere or the corner of a box
+        glm::vec3 size; // the radius of a sphere or the dimensions of a box
+        PickFilter searchFilter;
+
+        bool operator==(const Key& other) const {
+            return shape == other.shape && position == other.position && size == other.size &&
+                searchFilter == other.searchFilter;
+        }
+    };
+
+    bool find(const Key& key, uint64_t queryVersion, QVector<QUuid>& foundEntities);
+    void insert(const Key& key, uint64_t queryVersion, const QVector<QUuid>& foundEntities);
+
+    uint64_t getNumHits() const { return _numHits; }
+    uint64_t getNumMisses() const { return _numMisses; }
+
+private:
+    struct Entry {
+        Key key;
+        uint64_t queryVersion;
+        quint64 foundAt;
+        QVector<QUuid> foundEntities;
+    };
+
+    std::mutex _mutex;
+    std::vector<Entry> _entries;
+
+    std::atomic<uint64_t> _numHits { 0 };
+    std::atomic<uint64_t> _numMisses { 0 };
+};
+
+#endif // overte_EntityQueryCache_h
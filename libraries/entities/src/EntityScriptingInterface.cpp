@@ -73,6 +73,7 @@ void staticEntityScriptInitializer(ScriptManager* manager) {
 
     scriptEngine->registerGlobalObject("Entities", entityScriptingInterface.data());
     scriptEngine->registerFunction("Entities", "getMultipleEntityProperties", EntityScriptingInterface::getMultipleEntityProperties);
+    scriptEngine->registerFunction("Entities", "editEntities", EntityScriptingInterface::editEntities);
 
     // "The return value of QObject::sender() is not valid when the slot is called via a Qt::DirectConnection from a thread
     // different from this object's thread. Do not use this function in this type of scenario."
@@ -1000,104 +1001,172 @@ ScriptValue EntityScriptingInterface::getMultipleEntityPropertiesInternal(Script
 }
 
 QUuid EntityScriptingInterface::editEntity(const QUuid& id, const EntityItemProperties& scriptSideProperties) {
+    return editEntitiesInternal({ id }, { scriptSideProperties }).at(0);
+}
+
+// Static method to make sure that we have the right script engine.
+// Using sender() or QtScriptable::engine() does not work for classes used by multiple threads (script-engines)
+ScriptValue EntityScriptingInterface::editEntities(ScriptContext* context, ScriptEngine* engine) {
+    const int ARGUMENT_ENTITY_IDS = 0;
+    const int ARGUMENT_PROPERTIES = 1;
+
+    auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
+    const auto entityIDs = scriptvalue_cast<QVector<QUuid>>(context->argument(ARGUMENT_ENTITY_IDS));
+    const ScriptValue propertiesValue = context->argument(ARGUMENT_PROPERTIES);
+
+    QVector<EntityItemProperties> properties;
+    if (propertiesValue.isArray()) {
+        // one set of properties for each entity
+        properties.reserve(entityIDs.size());
+        for (int i = 0; i < entityIDs.size(); i++) {
+            EntityItemProperties entityProperties;
+            EntityItemPropertiesFromScriptValueHonorReadOnly(propertiesValue.property(i), entityProperties);
+            properties.append(entityProperties);
+        }
+    } else {
+        // the same properties for all of them, converted once
+        EntityItemProperties sharedProperties;
+        EntityItemPropertiesFromScriptValueHonorReadOnly(propertiesValue, sharedProperties);
+        properties.fill(sharedProperties, entityIDs.size());
+    }
+    return engine->toScriptValue(entityScriptingInterface->editEntitiesInternal(entityIDs, properties));
+}
+
+QVector<QUuid> EntityScriptingInterface::editEntitiesInternal(const QVector<QUuid>& ids,
+                                                              const QVector<EntityItemProperties>& scriptSideProperties) {
     PROFILE_RANGE(script_entities, __FUNCTION__);
+    Q_ASSERT(ids.size() == scriptSideProperties.size());
 
-    _activityTracking.editedEntityCount++;
+    _activityTracking.editedEntityCount += ids.size();
 
     const auto sessionID = DependencyManager::get<NodeList>()->getSessionUUID();
 
-    EntityItemProperties properties = scriptSideProperties;
+    // the IDs of the edited entities, null for the edits that failed
+    QVector<QUuid> results = ids;
+    const int size = ids.size();
 
-    EntityItemID entityID(id);
     if (!_entityTree) {
-        properties.setLastEditedBy(sessionID);
-        queueEntityMessage(PacketType::EntityEdit, entityID, properties);
-        return id;
+        for (int i = 0; i < size; i++) {
+            EntityItemProperties properties = scriptSideProperties.at(i);
+            properties.setLastEditedBy(sessionID);
+            queueEntityMessage(PacketType::EntityEdit, EntityItemID(ids.at(i)), properties);
+        }
+        return results;
     }
 
-    EntityItemPointer entity(nullptr);
-    SimulationOwner simulationOwner;
-    _entityTree->withReadLock([&] {
-        // make a copy of entity for local logic outside of tree lock
-        entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (!entity) {
-            return;
-        }
+    struct Edit {
+        EntityItemID entityID;
+        EntityItemProperties properties;
+        EntityItemPointer entity;
+        SimulationOwner simulationOwner;
+        bool failed { false };
+    };
+    std::vector<Edit> edits(size);
+    for (int i = 0; i < size; i++) {
+        edits[i].entityID = ids.at(i);
+        edits[i].properties = scriptSideProperties.at(i);
+    }
 
-        if (entity->isAvatarEntity() && !entity->isMyAvatarEntity()) {
-            // don't edit other avatar's avatarEntities
-            properties = EntityItemProperties();
-            return;
-        }
-        // make a copy of simulationOwner for local logic outside of tree lock
-        simulationOwner = entity->getSimulationOwner();
-    });
+    // the tree is locked once for up to lockAmount entities in each pass, rather than several times for each entity
+    const int lockAmount = 500;
+    for (int start = 0; start < size; start += lockAmount) {
+        _entityTree->withReadLock([&] {
+            for (int i = start; i < size && i < start + lockAmount; i++) {
+                Edit& edit = edits[i];
+                // make a copy of entity for local logic outside of tree lock
+                edit.entity = _entityTree->findEntityByEntityItemID(edit.entityID);
+                if (!edit.entity) {
+                    continue;
+                }
 
-    QString previousUserdata;
-    if (entity) {
-        if (properties.hasTransformOrVelocityChanges() && entity->hasGrabs()) {
-            // if an entity is grabbed, the grab will override any position changes
-            properties.clearTransformOrVelocityChanges();
-        }
-        if (properties.hasSimulationRestrictedChanges()) {
-            if (_bidOnSimulationOwnership) {
-                // flag for simulation ownership, or upgrade existing ownership priority
-                // (actual bids for simulation ownership are sent by the PhysicalEntitySimulation)
-                entity->upgradeScriptSimulationPriority(properties.computeSimulationBidPriority());
-                if (entity->isLocalEntity() || entity->isMyAvatarEntity() || simulationOwner.getID() == sessionID) {
-                    // we own the simulation --> copy ALL restricted properties
-                    properties.copySimulationRestrictedProperties(entity);
-                } else {
-                    // we don't own the simulation but think we would like to
-
-                    uint8_t desiredPriority = entity->getScriptSimulationPriority();
-                    if (desiredPriority < simulationOwner.getPriority()) {
-                        // the priority at which we'd like to own it is not high enough
-                        // --> assume failure and clear all restricted property changes
-                        properties.clearSimulationRestrictedProperties();
-                    } else {
-                        // the priority at which we'd like to own it is high enough to win.
-                        // --> assume success and copy ALL restricted properties
+                if (edit.entity->isAvatarEntity() && !edit.entity->isMyAvatarEntity()) {
+                    // don't edit other avatar's avatarEntities
+                    edit.properties = EntityItemProperties();
+                    continue;
+                }
+                // make a copy of simulationOwner for local logic outside of tree lock
+                edit.simulationOwner = edit.entity->getSimulationOwner();
+            }
+        });
+    }
+
+    for (int i = 0; i < size; i++) {
+        Edit& edit = edits[i];
+        EntityItemProperties& properties = edit.properties;
+        const EntityItemPointer& entity = edit.entity;
+        QString previousUserdata;
+        if (entity) {
+            if (properties.hasTransformOrVelocityChanges() && entity->hasGrabs()) {
+                // if an entity is grabbed, the grab will override any position changes
+                properties.clearTransformOrVelocityChanges();
+            }
+            if (properties.hasSimulationRestrictedChanges()) {
+                if (_bidOnSimulationOwnership) {
+                    // flag for simulation ownership, or upgrade existing ownership priority
+                    // (actual bids for simulation ownership are sent by the PhysicalEntitySimulation)
+                    entity->upgradeScriptSimulationPriority(properties.computeSimulationBidPriority());
+                    if (entity->isLocalEntity() || entity->isMyAvatarEntity() || edit.simulationOwner.getID() == sessionID) {
+                        // we own the simulation --> copy ALL restricted properties
                         properties.copySimulationRestrictedProperties(entity);
+                    } else {
+                        // we don't own the simulation but think we would like to
+
+                        uint8_t desiredPriority = entity->getScriptSimulationPriority();
+                        if (desiredPriority < edit.simulationOwner.getPriority()) {
+                            // the priority at which we'd like to own it is not high enough
+                            // --> assume failure and clear all restricted property changes
+                            properties.clearSimulationRestrictedProperties();
+                        } else {
+                            // the priority at which we'd like to own it is high enough to win.
+                            // --> assume success and copy ALL restricted properties
+                            properties.copySimulationRestrictedProperties(entity);
+                        }
                     }
+                } else if (!edit.simulationOwner.getID().isNull()) {
+                    // someone owns this but not us
+                    // clear restricted properties
+                    properties.clearSimulationRestrictedProperties();
                 }
-            } else if (!simulationOwner.getID().isNull()) {
-                // someone owns this but not us
-                // clear restricted properties
-                properties.clearSimulationRestrictedProperties();
+                // clear the cached simulationPriority level
+                entity->upgradeScriptSimulationPriority(0);
             }
-            // clear the cached simulationPriority level
-            entity->upgradeScriptSimulationPriority(0);
-        }
 
-        // set these to make EntityItemProperties::getScalesWithParent() work correctly
-        entity::HostType entityHostType = entity->getEntityHostType();
-        properties.setEntityHostType(entityHostType);
-        if (entityHostType == entity::HostType::LOCAL) {
-            properties.setCollisionless(true);
-        }
-        properties.setOwningAvatarID(entity->getOwningAvatarID());
+            // set these to make EntityItemProperties::getScalesWithParent() work correctly
+            entity::HostType entityHostType = entity->getEntityHostType();
+            properties.setEntityHostType(entityHostType);
+            if (entityHostType == entity::HostType::LOCAL) {
+                properties.setCollisionless(true);
+            }
+            properties.setOwningAvatarID(entity->getOwningAvatarID());
 
-        // make sure the properties has a type, so that the encode can know which properties to include
-        properties.setType(entity->getType());
+            // make sure the properties has a type, so that the encode can know which properties to include
+            properties.setType(entity->getType());
 
-        previousUserdata = entity->getUserData();
-    } else if (_bidOnSimulationOwnership) {
-        // bail when simulation participants don't know about entity
-        return QUuid();
-    }
-    // TODO: it is possible there is no remaining useful changes in properties and we should bail early.
-    // How to check for this cheaply?
+            previousUserdata = entity->getUserData();
+        } else if (_bidOnSimulationOwnership) {
+            // bail when simulation participants don't know about entity
+            edit.failed = true;
+            results[i] = QUuid();
+            continue;
+        }
+        // TODO: it is possible there is no remaining useful changes in properties and we should bail early.
+        // How to check for this cheaply?
 
-    properties = convertPropertiesFromScriptSemantics(properties, properties.getScalesWithParent());
-    synchronizeEditedGrabProperties(properties, previousUserdata);
-    properties.setLastEditedBy(sessionID);
+        properties = convertPropertiesFromScriptSemantics(properties, properties.getScalesWithParent());
+        synchronizeEditedGrabProperties(properties, previousUserdata);
+        properties.setLastEditedBy(sessionID);
+    }
 
     // done reading and modifying properties --> start write
-    bool updatedEntity = false;
-    _entityTree->withWriteLock([&] {
-        updatedEntity = _entityTree->updateEntity(entityID, properties);
-    });
+    for (int start = 0; start < size; start += lockAmount) {
+        _entityTree->withWriteLock([&] {
+            for (int i = start; i < size && i < start + lockAmount; i++) {
+                if (!edits[i].failed) {
+                    _entityTree->updateEntity(edits[i].entityID, edits[i].properties);
+                }
+            }
+        });
+    }
 
     // FIXME: We need to figure out a better way to handle this. Allowing these edits to go through potentially
     // breaks entities that are parented.
@@ -1108,80 +1177,97 @@ QUuid EntityScriptingInterface::editEntity(const QUuid& id, const EntityItemProp
     //     return QUuid();
     // }
 
-    bool hasQueryAACubeRelatedChanges = properties.queryAACubeRelatedPropertyChanged();
     // done writing, send update
-    _entityTree->withReadLock([&] {
-        // find the entity again: maybe it was removed since we last found it
-        entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (entity) {
-            uint64_t now = usecTimestampNow();
-            entity->setLastBroadcast(now);
-
-            if (hasQueryAACubeRelatedChanges) {
-                properties.setQueryAACube(entity->getQueryAACube());
-
-                // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
-                // if they've changed.
-                entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
-                    if (descendant->getNestableType() == NestableType::Entity) {
-                        if (descendant->updateQueryAACube()) {
-                            EntityItemPointer entityDescendant = std::static_pointer_cast<EntityItem>(descendant);
-                            EntityItemProperties newQueryCubeProperties;
-                            newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
-                            newQueryCubeProperties.setLastEdited(properties.getLastEdited());
-                            queueEntityMessage(PacketType::EntityEdit, descendant->getID(), newQueryCubeProperties);
-                            entityDescendant->setLastBroadcast(now);
-                        }
+    for (int start = 0; start < size; start += lockAmount) {
+        _entityTree->withReadLock([&] {
+            for (int i = start; i < size && i < start + lockAmount; i++) {
+                Edit& edit = edits[i];
+                if (edit.failed) {
+                    continue;
+                }
+                EntityItemProperties& properties = edit.properties;
+                // find the entity again: maybe it was removed since we last found it
+                edit.entity = _entityTree->findEntityByEntityItemID(edit.entityID);
+                if (edit.entity) {
+                    uint64_t now = usecTimestampNow();
+                    edit.entity->setLastBroadcast(now);
+
+                    if (properties.queryAACubeRelatedPropertyChanged()) {
+                        properties.setQueryAACube(edit.entity->getQueryAACube());
+
+                        // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
+                        // if they've changed.
+                        edit.entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
+                            if (descendant->getNestableType() == NestableType::Entity) {
+                                if (descendant->updateQueryAACube()) {
+                                    EntityItemPointer entityDescendant = std::static_pointer_cast<EntityItem>(descendant);
+                                    EntityItemProperties newQueryCubeProperties;
+                                    newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
+                                    newQueryCubeProperties.setLastEdited(properties.getLastEdited());
+                                    queueEntityMessage(PacketType::EntityEdit, descendant->getID(), newQueryCubeProperties);
+                                    entityDescendant->setLastBroadcast(now);
+                                }
+                            }
+                        });
                     }
-                });
-            }
-        }
-    });
-    if (!entity) {
-        if (hasQueryAACubeRelatedChanges) {
-            // Sometimes ESS don't have the entity they are trying to edit in their local tree.  In this case,
-            // convertPropertiesFromScriptSemantics doesn't get called and local* edits will get dropped.
-            // This is because, on the script side, "position" is in world frame, but in the network
-            // protocol and in the internal data-structures, "position" is "relative to parent".
-            // Compensate here.  The local* versions will get ignored during the edit-packet encoding.
-            if (properties.localPositionChanged()) {
-                properties.setPosition(properties.getLocalPosition());
-            }
-            if (properties.localRotationChanged()) {
-                properties.setRotation(properties.getLocalRotation());
-            }
-            if (properties.localVelocityChanged()) {
-                properties.setVelocity(properties.getLocalVelocity());
-            }
-            if (properties.localAngularVelocityChanged()) {
-                properties.setAngularVelocity(properties.getLocalAngularVelocity());
+                }
             }
-            if (properties.localDimensionsChanged()) {
-                properties.setDimensions(properties.getLocalDimensions());
+        });
+    }
+
+    for (int i = 0; i < size; i++) {
+        Edit& edit = edits[i];
+        if (edit.failed) {
+            continue;
+        }
+        EntityItemProperties& properties = edit.properties;
+        if (!edit.entity) {
+            if (properties.queryAACubeRelatedPropertyChanged()) {
+                // Sometimes ESS don't have the entity they are trying to edit in their local tree.  In this case,
+                // convertPropertiesFromScriptSemantics doesn't get called and local* edits will get dropped.
+                // This is because, on the script side, "position" is in world frame, but in the network
+                // protocol and in the internal data-structures, "position" is "relative to parent".
+                // Compensate here.  The local* versions will get ignored during the edit-packet encoding.
+                if (properties.localPositionChanged()) {
+                    properties.setPosition(properties.getLocalPosition());
+                }
+                if (properties.localRotationChanged()) {
+                    properties.setRotation(properties.getLocalRotation());
+                }
+                if (properties.localVelocityChanged()) {
+                    properties.setVelocity(properties.getLocalVelocity());
+                }
+                if (properties.localAngularVelocityChanged()) {
+                    properties.setAngularVelocity(properties.getLocalAngularVelocity());
+                }
+                if (properties.localDimensionsChanged()) {
+                    properties.setDimensions(properties.getLocalDimensions());
+                }
             }
-        }
-        // we've made an edit to an entity we don't know about, or to a non-entity.  If it's a known non-entity,
-        // print a warning and don't send an edit packet to the entity-server.
-        QSharedPointer<SpatialParentFinder> parentFinder = DependencyManager::get<SpatialParentFinder>();
-        if (parentFinder) {
-            bool success;
-            auto nestableWP = parentFinder->find(id, success, static_cast<SpatialParentTree*>(_entityTree.get()));
-            if (success) {
-                auto nestable = nestableWP.lock();
-                if (nestable) {
-                    NestableType nestableType = nestable->getNestableType();
-                    if (nestableType == NestableType::Avatar) {
-                        qCWarning(entities) << "attempted edit on non-entity: " << id << nestable->getName();
-                        return QUuid(); // null script value to indicate failure
+            // we've made an edit to an entity we don't know about, or to a non-entity.  If it's a known non-entity,
+            // print a warning and don't send an edit packet to the entity-server.
+            QSharedPointer<SpatialParentFinder> parentFinder = DependencyManager::get<SpatialParentFinder>();
+            if (parentFinder) {
+                bool success;
+                auto nestableWP = parentFinder->find(ids.at(i), success, static_cast<SpatialParentTree*>(_entityTree.get()));
+                if (success) {
+                    auto nestable = nestableWP.lock();
+                    if (nestable) {
+                        NestableType nestableType = nestable->getNestableType();
+                        if (nestableType == NestableType::Avatar) {
+                            qCWarning(entities) << "attempted edit on non-entity: " << ids.at(i) << nestable->getName();
+                            results[i] = QUuid(); // null script value to indicate failure
+                            continue;
+                        }
                     }
                 }
             }
         }
+        // we queue edit packets even if we don't know about the entity.  This is to allow AC agents
+        // to edit entities they know only by ID.
+        queueEntityMessage(PacketType::EntityEdit, edit.entityID, properties);
     }
-    // we queue edit packets even if we don't know about the entity.  This is to allow AC agents
-    // to edit entities they know only by ID.
-    queueEntityMessage(PacketType::EntityEdit, entityID, properties);
-    return id;
+    return results;
 }
 
 void EntityScriptingInterface::deleteEntity(const QUuid& id) {
@@ -1401,6 +1487,45 @@ QVector<QUuid> EntityScriptingInterface::findEntitiesInBox(const glm::vec3& corn
     return result;
 }
 
+QVariantList EntityScriptingInterface::findEntitiesInBatch(const QVariantList& queries) const {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    std::vector<EntityTree::SpatialQuery> spatialQueries;
+    spatialQueries.reserve(queries.size());
+    for (const auto& query : queries) {
+        QVariantMap queryMap = query.toMap();
+        EntityTree::SpatialQuery spatialQuery;
+        if (queryMap.contains("corner")) {
+            spatialQuery.shape = EntityTree::SpatialQuery::Box;
+            spatialQuery.box = AABox(qMapToVec3(queryMap["corner"]), qMapToVec3(queryMap["dimensions"]));
+        } else {
+            spatialQuery.shape = EntityTree::SpatialQuery::Sphere;
+            spatialQuery.center = qMapToVec3(queryMap["center"]);
+            spatialQuery.radius = queryMap["radius"].toFloat();
+        }
+        spatialQueries.push_back(spatialQuery);
+    }
+
+    if (_entityTree) {
+        unsigned int searchFilter = PickFilter::getBitMask(PickFilter::FlagBit::DOMAIN_ENTITIES) | PickFilter::getBitMask(PickFilter::FlagBit::AVATAR_ENTITIES);
+        _entityTree->withReadLock([&] {
+            _entityTree->evalEntitiesInBatch(spatialQueries, PickFilter(searchFilter));
+        });
+    }
+
+    QVariantList result;
+    result.reserve(queries.size());
+    for (const auto& spatialQuery : spatialQueries) {
+        QVariantList entityIDs;
+        entityIDs.reserve(spatialQuery.foundEntities.size());
+        for (const auto& entityID : spatialQuery.foundEntities) {
+            entityIDs.push_back(entityID);
+        }
+        result.push_back(entityIDs);
+    }
+    return result;
+}
+
 QVector<QUuid> EntityScriptingInterface::findEntitiesInFrustum(QVariantMap frustum) const {
     PROFILE_RANGE(script_entities, __FUNCTION__);
 
@@ -1681,7 +1806,17 @@ bool EntityScriptingInterface::getServerScriptStatus(const QUuid& entityID, Scri
         Q_ASSERT(QThread::currentThread() == engine->thread());
         Q_ASSERT(QThread::currentThread() == engine->manager()->thread());
         QString statusString = EntityScriptStatus_::valueToKey(request->getStatus());
-        ScriptValueList args { engine->newValue(request->getResponseReceived()), engine->newValue(request->getIsRunning()), engine->newValue(statusString.toLower()), engine->newValue(request->getErrorInfo()) };
+        const EntityScriptProfile& profile = request->getProfile();
+        ScriptValue profileValue = engine->newObject();
+        profileValue.setProperty("threadCPUTime", (double)profile.threadCPUTime / USECS_PER_MSEC);
+        profileValue.setProperty("callCount", (double)profile.callCount);
+        profileValue.setProperty("heapUsed", (double)profile.usedHeapSize);
+        profileValue.setProperty("gcCount", (double)profile.gcCount);
+        profileValue.setProperty("gcTime", (double)profile.gcPauseTime / USECS_PER_MSEC);
+        profileValue.setProperty("numTimers", profile.numTimers);
+        profileValue.setProperty("numSignalConnections", profile.numSignalConnections);
+        ScriptValueList args { engine->newValue(request->getResponseReceived()), engine->newValue(request->getIsRunning()), engine->newValue(statusString.toLower()), engine->newValue(request->getErrorInfo()),
+                               engine->newValue((double)profile.cpuTime / USECS_PER_MSEC), profileValue };
         callback.call(ScriptValue(), args);
         request->deleteLater();
         // This causes ScriptValueProxy to be released, and thus its destructor is called on script engine thread and not main thread
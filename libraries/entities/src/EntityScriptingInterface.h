@@ -220,6 +220,24 @@ public:
     static ScriptValue getMultipleEntityProperties(ScriptContext* context, ScriptEngine* engine);
     ScriptValue getMultipleEntityPropertiesInternal(ScriptEngine* engine, QVector<QUuid> entityIDs, const ScriptValue& extendedDesiredProperties);
 
+    /*@jsdoc
+     * Edits multiple entities, changing one or more of their property values. This is the same as calling 
+     * {@link Entities.editEntity|editEntity} for each of them, but the entity tree is locked once for the batch rather 
+     * than several times for each entity, and properties that are the same for all the entities are only converted once.
+     * @function Entities.editEntities
+     * @param {Uuid[]} entityIDs - The IDs of the entities to edit.
+     * @param {Entities.EntityProperties|Entities.EntityProperties[]} properties - The new property values, either the same 
+     *     for all the entities or an array with the new property values of each entity.
+     * @returns {Uuid[]} The ID of each entity if its edit was successful, otherwise <code>null</code> or 
+     *     {@link Uuid|Uuid.NULL}.
+     * @example <caption>Turn the nearby boxes red.</caption>
+     * var SEARCH_RADIUS = 10; // meters
+     * var entityIDs = Entities.findEntitiesByType("Box", MyAvatar.position, SEARCH_RADIUS);
+     * Entities.editEntities(entityIDs, { color: { red: 255, green: 0, blue: 0 } });
+    */
+    static ScriptValue editEntities(ScriptContext* context, ScriptEngine* engine);
+    QVector<QUuid> editEntitiesInternal(const QVector<QUuid>& entityIDs, const QVector<EntityItemProperties>& properties);
+
     QUuid addEntityInternal(const EntityItemProperties& properties, entity::HostType entityHostType);
 
 public slots:
@@ -762,6 +780,26 @@ public slots:
     /// this function will not find any models in script engine contexts which don't have access to models
     Q_INVOKABLE QVector<QUuid> findEntitiesInBox(const glm::vec3& corner, const glm::vec3& dimensions) const;
 
+    /*@jsdoc
+     * Finds all domain and avatar entities that intersect each of a batch of search spheres and axis-aligned boxes, in
+     * one search of the tree. This is quicker than calling {@link Entities.findEntities|findEntities} and
+     * {@link Entities.findEntitiesInBox|findEntitiesInBox} for each of them.
+     * <p><strong>Note:</strong> Server entity scripts only find entities that have a server entity script
+     * running in them or a parent entity. You can apply a dummy script to entities that you want found in a search.</p>
+     * @function Entities.findEntitiesInBatch
+     * @param {Array.<{center: Vec3, radius: number}|{corner: Vec3, dimensions: Vec3}>} queries - The search spheres and
+     *     AA boxes.
+     * @returns {Array.<Uuid[]>} An array of entity IDs for each of the queries, in the same order.
+     * @example <caption>Report how many entities are near each hand of your avatar.</caption>
+     * var found = Entities.findEntitiesInBatch([
+     *     { center: MyAvatar.getLeftPalmPosition(), radius: 0.5 },
+     *     { center: MyAvatar.getRightPalmPosition(), radius: 0.5 }
+     * ]);
+     * print("Entities near left hand: " + found[0].length + ", right hand: " + found[1].length);
+     */
+    /// this function will not find any models in script engine contexts which don't have access to models
+    Q_INVOKABLE QVariantList findEntitiesInBatch(const QVariantList& queries) const;
+
     /*@jsdoc
      * Finds all domain and avatar entities whose axis-aligned boxes intersect a search frustum.
      * <p><strong>Note:</strong> Server entity scripts only find entities that have a server entity script
@@ -879,6 +917,23 @@ public slots:
      * @param {string} status - <code>"running"</code> if there is a server entity script running, otherwise an error string.
      * @param {string} errorInfo - <code>""</code> if there is a server entity script running, otherwise it may contain extra 
      *     information on the error.
+     * @param {number} cpuTime - The time that the server entity script has spent running since it was loaded, in ms.
+     *     <code>0</code> if the server doesn't report it.
+     * @param {Entities.ServerScriptProfile} profile - More details on the work that the server entity script does. The
+     *     values are <code>0</code> if the server doesn't report them.
+     */
+    /*@jsdoc
+     * Details on the work that a server entity script does, as reported by {@link Entities.getServerScriptStatus}.  The 
+     * heap, garbage collection, timer and signal values are for the script engine that runs the script, which may be 
+     * running other server entity scripts too.
+     * @typedef {object} Entities.ServerScriptProfile
+     * @property {number} threadCPUTime - The CPU time that the script has used since it was loaded, in ms.
+     * @property {number} callCount - The number of calls into the script since it was loaded.
+     * @property {number} heapUsed - The size of the engine's heap after its last garbage collection, in bytes.
+     * @property {number} gcCount - The number of garbage collections of the engine's heap.
+     * @property {number} gcTime - The time that the garbage collections have paused the engine for, in ms.
+     * @property {number} numTimers - The number of the engine's timers that are waiting to fire.
+     * @property {number} numSignalConnections - The number of the engine's functions that are connected to signals.
      */
     //Q_INVOKABLE bool getServerScriptStatus(const QUuid& entityID, const ScriptValue& callback);
     Q_INVOKABLE bool getServerScriptStatus(const QUuid& entityID, ScriptValue callback);
@@ -11,6 +11,12 @@
 
 #include "EntitySimulation.h"
 
+#include <algorithm>
+#include <functional>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <AACube.h>
 #include <Profile.h>
 
@@ -24,6 +30,7 @@ void EntitySimulation::setEntityTree(EntityTreePointer tree) {
         _changedEntities.clear();
         _entitiesToUpdate.clear();
         _mortalEntities.clear();
+        _expiries.clear();
         _nextExpiry = std::numeric_limits<uint64_t>::max();
     }
     _entityTree = tree;
@@ -49,7 +56,8 @@ void EntitySimulation::removeEntityFromInternalLists(EntityItemPointer entity) {
     _simpleKinematicEntities.remove(entity);
     _allEntities.remove(entity);
     _entitiesToUpdate.remove(entity);
-    _mortalEntities.remove(entity);
+    // its entry in _expiries is skipped when it comes up
+    _mortalEntities.erase(entity);
     entity->setSimulated(false);
 }
 
@@ -70,31 +78,56 @@ void EntitySimulation::prepareEntityForDelete(EntityItemPointer entity) {
 void EntitySimulation::expireMortalEntities(uint64_t now) {
     if (now > _nextExpiry) {
         PROFILE_RANGE_EX(simulation_physics, "ExpireMortals", 0xffff00ff, (uint64_t)_mortalEntities.size());
-        // only search for expired entities if we expect to find one
-        _nextExpiry = std::numeric_limits<uint64_t>::max();
         QMutexLocker lock(&_mutex);
-        SetOfEntities::iterator itemItr = _mortalEntities.begin();
-        while (itemItr != _mortalEntities.end()) {
-            EntityItemPointer entity = *itemItr;
-            uint64_t expiry = entity->getExpiry();
-            if (expiry < now) {
-                itemItr = _mortalEntities.erase(itemItr);
+        while (!_expiries.empty() && _expiries.front().time < now) {
+            std::pop_heap(_expiries.begin(), _expiries.end(), std::greater<Expiry>());
+            Expiry expiry = _expiries.back();
+            _expiries.pop_back();
+
+            EntityItemPointer entity = expiry.entity.lock();
+            if (!entity) {
+                continue;
+            }
+            auto itr = _mortalEntities.find(entity);
+            if (itr == _mortalEntities.end() || itr->second != expiry.time) {
+                // removed or rescheduled since this entry was pushed
+                continue;
+            }
+            if (entity->getExpiry() < now) {
+                _mortalEntities.erase(itr);
                 entity->die();
                 prepareEntityForDelete(entity);
             } else {
-                if (expiry < _nextExpiry) {
-                    // remember the smallest _nextExpiry so we know when to start the next search
-                    _nextExpiry = expiry;
-                }
-                ++itemItr;
+                // its lifetime was extended without the entity telling us
+                scheduleExpiry(entity);
             }
         }
-        if (_mortalEntities.size() < 1) {
-            _nextExpiry = -1;
-        }
+        _nextExpiry = _expiries.empty() ? std::numeric_limits<uint64_t>::max() : _expiries.front().time;
     }
 }
 
+void EntitySimulation::scheduleExpiry(const EntityItemPointer& entity) {
+    // protected: _mutex lock is guaranteed
+    uint64_t expiry = entity->getExpiry();
+    _mortalEntities[entity] = expiry;
+    _expiries.push_back({ expiry, entity });
+    std::push_heap(_expiries.begin(), _expiries.end(), std::greater<Expiry>());
+    if (_expiries.size() > 2 * _mortalEntities.size() + 64) {
+        // drop the entries left behind by entities that keep changing their lifetimes
+        rebuildExpiries();
+    }
+    _nextExpiry = _expiries.front().time;
+}
+
+void EntitySimulation::rebuildExpiries() {
+    _expiries.clear();
+    _expiries.reserve(_mortalEntities.size());
+    for (const auto& mortal : _mortalEntities) {
+        _expiries.push_back({ mortal.second, mortal.first });
+    }
+    std::make_heap(_expiries.begin(), _expiries.end(), std::greater<Expiry>());
+}
+
 // protected
 void EntitySimulation::callUpdateOnEntitiesThatNeedIt(uint64_t now) {
     PerformanceTimer perfTimer("updatingEntities");
@@ -147,11 +180,7 @@ void EntitySimulation::sortEntitiesThatMoved() {
 void EntitySimulation::addEntityToInternalLists(EntityItemPointer entity) {
     // protected: _mutex lock is guaranteed
     if (entity->isMortal()) {
-        _mortalEntities.insert(entity);
-        uint64_t expiry = entity->getExpiry();
-        if (expiry < _nextExpiry) {
-            _nextExpiry = expiry;
-        }
+        scheduleExpiry(entity);
     }
     if (entity->needsToCallUpdate()) {
         _entitiesToUpdate.insert(entity);
@@ -193,13 +222,9 @@ void EntitySimulation::processChangedEntity(const EntityItemPointer& entity) {
     if (dirtyFlags & (Simulation::DIRTY_LIFETIME | Simulation::DIRTY_UPDATEABLE)) {
         if (dirtyFlags & Simulation::DIRTY_LIFETIME) {
             if (entity->isMortal()) {
-                _mortalEntities.insert(entity);
-                uint64_t expiry = entity->getExpiry();
-                if (expiry < _nextExpiry) {
-                    _nextExpiry = expiry;
-                }
+                scheduleExpiry(entity);
             } else {
-                _mortalEntities.remove(entity);
+                _mortalEntities.erase(entity);
             }
         }
         if (dirtyFlags & Simulation::DIRTY_UPDATEABLE) {
@@ -222,14 +247,29 @@ void EntitySimulation::clearEntities() {
     _deadEntitiesToRemoveFromTree.clear();
     _entitiesToUpdate.clear();
     _mortalEntities.clear();
+    _expiries.clear();
     _nextExpiry = std::numeric_limits<uint64_t>::max();
 }
 
+// fewer simple kinematic entities than this are moved serially, a parallel pass would cost more than it saves
+static const size_t MIN_PARALLEL_SIMPLE_KINEMATICS = 256;
+static const size_t SIMPLE_KINEMATICS_GRAIN_SIZE = 64;
+
 void EntitySimulation::moveSimpleKinematics(uint64_t now) {
     PROFILE_RANGE_EX(simulation_physics, "MoveSimples", 0xffff00ff, (uint64_t)_simpleKinematicEntities.size());
-    SetOfEntities::iterator itemItr = _simpleKinematicEntities.begin();
-    while (itemItr != _simpleKinematicEntities.end()) {
-        EntityItemPointer entity = *itemItr;
+    enum Outcome : uint8_t {
+        MOVED,
+        STOPPED,    // no longer moving, its query cube is brought up to date one last time
+        DROPPED     // the entity is no longer non-physical-kinematic
+    };
+
+    std::vector<EntityItemPointer> entities(_simpleKinematicEntities.begin(), _simpleKinematicEntities.end());
+    std::vector<Outcome> outcomes(entities.size());
+
+    // Each entity only steps its own transform, so they can be stepped in parallel. Their query cubes take in their
+    // parents' and children's, so they are updated afterwards, with the lists.
+    auto step = [&](size_t i) {
+        const EntityItemPointer& entity = entities[i];
 
         // The entity-server doesn't know where avatars are, so don't attempt to do simple extrapolation for
         // children of avatars.  See related code in EntityMotionState::remoteSimulationOutOfSync.
@@ -240,20 +280,37 @@ void EntitySimulation::moveSimpleKinematics(uint64_t now) {
         bool isMoving = entity->isMovingRelativeToParent();
         if (isMoving && !entity->getPhysicsInfo() && ancestryIsKnown && !hasAvatarAncestor) {
             entity->simulate(now);
-            if (ancestryIsKnown && !hasAvatarAncestor) {
-                entity->updateQueryAACube();
-            }
-            _entitiesToSort.insert(entity);
-            ++itemItr;
+            outcomes[i] = MOVED;
+        } else if (!isMoving && ancestryIsKnown && !hasAvatarAncestor) {
+            outcomes[i] = STOPPED;
         } else {
-            if (!isMoving && ancestryIsKnown && !hasAvatarAncestor) {
-                // HACK: This catches most cases where the entity's QueryAACube (and spatial sorting in the EntityTree)
-                // would otherwise be out of date at conclusion of its "unowned" simpleKinematicMotion.
-                entity->updateQueryAACube();
-                _entitiesToSort.insert(entity);
-            }
-            // the entity is no longer non-physical-kinematic
-            itemItr = _simpleKinematicEntities.erase(itemItr);
+            outcomes[i] = DROPPED;
+        }
+    };
+    if (entities.size() < MIN_PARALLEL_SIMPLE_KINEMATICS) {
+        for (size_t i = 0; i < entities.size(); i++) {
+            step(i);
+        }
+    } else {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, entities.size(), SIMPLE_KINEMATICS_GRAIN_SIZE),
+            [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i != range.end(); i++) {
+                    step(i);
+                }
+            });
+    }
+
+    _entitiesToSort.reserve(_entitiesToSort.size() + (int)entities.size());
+    for (size_t i = 0; i < entities.size(); i++) {
+        const EntityItemPointer& entity = entities[i];
+        if (outcomes[i] != DROPPED) {
+            // HACK: for STOPPED, this catches most cases where the entity's QueryAACube (and spatial sorting in the
+            // EntityTree) would otherwise be out of date at conclusion of its "unowned" simpleKinematicMotion.
+            entity->updateQueryAACube();
+            _entitiesToSort.insert(entity);
+        }
+        if (outcomes[i] != MOVED) {
+            _simpleKinematicEntities.remove(entity);
         }
     }
 }
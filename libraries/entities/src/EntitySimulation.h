@@ -13,7 +13,9 @@
 #define hifi_EntitySimulation_h
 
 #include <limits>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <QtCore/QObject>
 #include <QVector>
@@ -99,12 +101,24 @@ protected:
 private:
     void moveSimpleKinematics();
 
+    void scheduleExpiry(const EntityItemPointer& entity);
+    void rebuildExpiries();
+
     // We maintain multiple lists, each for its distinct purpose.
     // An entity may be in more than one list.
     std::unordered_set<EntityItemPointer> _changedEntities; // all changes this frame
     SetOfEntities _allEntities; // tracks all entities added the simulation
     SetOfEntities _entitiesToUpdate; // entities that need to call EntityItem::update()
-    SetOfEntities _mortalEntities; // entities that have an expiry
+    std::unordered_map<EntityItemPointer, uint64_t> _mortalEntities; // entities that have an expiry, and when it was scheduled
+
+    // A min-heap of the scheduled expiries, so that the mortal entities aren't all checked whenever one expires. Entries
+    // are left behind when an entity is removed or rescheduled, and skipped when their time no longer matches.
+    struct Expiry {
+        uint64_t time;
+        EntityItemWeakPointer entity;
+        bool operator>(const Expiry& other) const { return time > other.time; }
+    };
+    std::vector<Expiry> _expiries;
     uint64_t _nextExpiry;
 
     // back pointer to EntityTree structure
@@ -13,8 +13,15 @@
 //
 
 #include "EntityTree.h"
+
+#include <atomic>
+#include <functional>
+
 #include <QtCore/QDateTime>
 #include <QtCore/QQueue>
+
+#include <tbb/parallel_for.h>
+
 #include <openssl/err.h>
 #include <openssl/pem.h>
 #include <openssl/x509.h>
@@ -26,6 +33,8 @@
 #include <QJsonArray>
 
 #include <Extents.h>
+#include <OctreeCompressionDictionary.h>
+#include <OctreeSnapshot.h>
 #include <PerfStat.h>
 #include <Profile.h>
 #include <AddressManager.h>
@@ -82,6 +91,7 @@ OctreeElementPointer EntityTree::createNewElement(unsigned char* octalCode) {
 
 void EntityTree::eraseDomainAndNonOwnedEntities() {
     emit clearingEntities();
+    bumpQueryVersion();
 
     if (_simulation) {
         // local-entities are not in the simulation, so we clear ALL
@@ -133,6 +143,7 @@ void EntityTree::eraseDomainAndNonOwnedEntities() {
 
 void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     emit clearingEntities();
+    bumpQueryVersion();
 
     if (_simulation) {
         _simulation->clearEntities();
@@ -169,6 +180,7 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
 void EntityTree::readBitstreamToTree(const unsigned char* bitstream,
             uint64_t bufferSizeBytes, ReadBitstreamToTreeParams& args) {
     Octree::readBitstreamToTree(bitstream, bufferSizeBytes, args);
+    bumpQueryVersion();
 
     // add entities
     QHash<EntityItemID, EntityItemPointer>::const_iterator itr;
@@ -288,6 +300,7 @@ bool EntityTree::handlesEditPacketType(PacketType packetType) const {
 /// Adds a new entity item to the tree
 void EntityTree::postAddEntity(EntityItemPointer entity) {
     assert(entity);
+    bumpQueryVersion();
 
     // check to see if we need to simulate this entity..
     if (_simulation) {
@@ -299,6 +312,9 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     }
 
     _isDirty = true;
+    if (_isJournaling) {
+        trackJournalChange(entity->getEntityItemID());
+    }
 
     // find and hook up any entities with this entity as a (previously) missing parent
     fixupNeedsParentFixups();
@@ -325,6 +341,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
     if (!containingElement) {
         return false;
     }
+    bumpQueryVersion();
 
     EntityItemProperties properties = origProperties;
 
@@ -365,6 +382,9 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
                     emit editingEntityPointer(entity);
                 }
                 _isDirty = true;
+                if (_isJournaling) {
+                    trackJournalChange(entity->getEntityItemID());
+                }
             }
         }
     } else {
@@ -500,6 +520,9 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
         }
 
         _isDirty = true;
+        if (_isJournaling) {
+            trackJournalChange(entity->getEntityItemID());
+        }
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
         if (newFlags) {
@@ -752,6 +775,7 @@ void EntityTree::deleteEntitiesByPointer(const std::vector<EntityItemPointer>& e
 
 void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator) {
     // NOTE: assume tree already write-locked because this method only called in deleteEntitiesByPointer()
+    bumpQueryVersion();
     quint64 deletedAt = usecTimestampNow();
     const RemovedEntities& entities = theOperator.getEntities();
     foreach(const EntityToDeleteDetails& details, entities) {
@@ -760,6 +784,9 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
             // set up the deleted entities ID
             QWriteLocker recentlyDeletedEntitiesLocker(&_recentlyDeletedEntitiesLock);
             _recentlyDeletedEntityItemIDs.insert(deletedAt, theEntity->getEntityItemID());
+            if (_isJournaling) {
+                trackJournalErase(theEntity->getEntityItemID());
+            }
         } else {
             theEntity->forEachDescendant([&](SpatiallyNestablePointer child) {
                 if (child->getNestableType() == NestableType::Avatar) {
@@ -805,17 +832,16 @@ public:
 
 bool evalRayIntersectionOp(const OctreeElementPointer& element, void* extraData) {
     RayArgs* args = static_cast<RayArgs*>(extraData);
-    bool keepSearching = true;
     EntityTreeElementPointer entityTreeElementPointer = std::static_pointer_cast<EntityTreeElement>(element);
     EntityItemID entityID = entityTreeElementPointer->evalRayIntersection(args->origin, args->direction, args->viewFrustumPos,
         args->element, args->distance, args->face, args->surfaceNormal, args->entityIdsToInclude,
         args->entityIdsToDiscard, args->searchFilter, args->extraInfo);
     if (!entityID.isNull()) {
         args->entityID = entityID;
-        // We recurse OctreeElements in order, so if we hit something, we can stop immediately
-        keepSearching = false;
     }
-    return keepSearching;
+    // An entity of a nearer element can still be behind one of a farther element that overlaps it, so keep going until
+    // the elements left are all farther than the hit, which evalRayIntersectionSortingOp tells the recursion
+    return true;
 }
 
 float evalRayIntersectionSortingOp(const OctreeElementPointer& element, void* extraData) {
@@ -856,7 +882,7 @@ EntityItemID EntityTree::evalRayIntersection(const glm::vec3& origin, const glm:
 
     bool requireLock = lockType == Octree::Lock;
     bool lockResult = withReadLock([&]{
-        recurseTreeWithOperationSorted(evalRayIntersectionOp, evalRayIntersectionSortingOp, &args);
+        recurseTreeWithOperationNearestFirst(evalRayIntersectionOp, evalRayIntersectionSortingOp, &args);
     }, requireLock);
 
     if (accurateResult) {
@@ -1005,194 +1031,197 @@ QUuid EntityTree::evalClosestEntity(const glm::vec3& position, float targetRadiu
     return args.closestEntity;
 }
 
-class FindEntitiesInSphereArgs {
-public:
-    // Inputs
-    glm::vec3 position;
-    float targetRadius;
-    PickFilter searchFilter;
+// queries spanning fewer subtrees than this are evaluated serially, a parallel pass would cost more than it saves
+static const size_t MIN_PARALLEL_QUERY_SUBTREES = 16;
 
-    // Outputs
-    QVector<QUuid> entities;
-};
+// operation evaluates the entities of an element into foundEntities and returns whether to descend into its children
+using SpatialQueryOperation = std::function<bool(const EntityTreeElementPointer& element, QVector<QUuid>& foundEntities)>;
 
-bool evalInSphereOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInSphereArgs* args = static_cast<FindEntitiesInSphereArgs*>(extraData);
-    glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
+static void evalSubtree(const OctreeElementPointer& element, const SpatialQueryOperation& operation, QVector<QUuid>& foundEntities) {
+    if (operation(std::static_pointer_cast<EntityTreeElement>(element), foundEntities)) {
+        for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+            OctreeElementPointer child = element->getChildAtIndex(i);
+            if (child) {
+                evalSubtree(child, operation, foundEntities);
+            }
+        }
+    }
+}
 
-    // If this element contains the point, then search it...
-    if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInSphere(args->position, args->targetRadius, args->searchFilter, args->entities);
-        return true; // keep searching in case children have closer entities
+// NOTE: assumes caller has handled locking, the subtrees are only read
+static void evalSubtreesInParallel(const OctreeElementPointer& root, const SpatialQueryOperation& operation,
+                                   QVector<QUuid>& foundEntities) {
+    // evaluate the top of the tree level by level, until the query spans enough subtrees to evaluate them in parallel
+    std::vector<OctreeElementPointer> frontier;
+    if (root) {
+        frontier.push_back(root);
+    }
+    while (!frontier.empty() && frontier.size() < MIN_PARALLEL_QUERY_SUBTREES) {
+        std::vector<OctreeElementPointer> children;
+        for (const auto& element : frontier) {
+            if (operation(std::static_pointer_cast<EntityTreeElement>(element), foundEntities)) {
+                for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+                    OctreeElementPointer child = element->getChildAtIndex(i);
+                    if (child) {
+                        children.push_back(child);
+                    }
+                }
+            }
+        }
+        frontier.swap(children);
+    }
+    if (frontier.empty()) {
+        return;
     }
 
-    // if this element doesn't contain the point, then none of it's children can contain the point, so stop searching
-    return false;
+    std::vector<QVector<QUuid>> subtreeEntities(frontier.size());
+    tbb::parallel_for((size_t)0, frontier.size(), [&](size_t i) {
+        evalSubtree(frontier[i], operation, subtreeEntities[i]);
+    });
+    for (const auto& entities : subtreeEntities) {
+        foundEntities += entities;
+    }
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphere(const glm::vec3& center, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInSphereArgs args = { center, radius, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereOperation, &args);
-    foundEntities.swap(args.entities);
-}
-
-class FindEntitiesInSphereWithTypeArgs {
-public:
-    // Inputs
-    glm::vec3 position;
-    float targetRadius;
-    EntityTypes::EntityType type;
-    PickFilter searchFilter;
+    EntityQueryCache::Key key { EntityQueryCache::Sphere, center, glm::vec3(radius), searchFilter };
+    uint64_t queryVersion = _queryVersion;
+    if (_queryCache.find(key, queryVersion, foundEntities)) {
+        return;
+    }
 
-    // Outputs
     QVector<QUuid> entities;
-};
-
-bool evalInSphereWithTypeOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInSphereWithTypeArgs* args = static_cast<FindEntitiesInSphereWithTypeArgs*>(extraData);
-    glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
-
-    // If this element contains the point, then search it...
-    if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInSphereWithType(args->position, args->targetRadius, args->type, args->searchFilter, args->entities);
-        return true; // keep searching in case children have closer entities
-    }
+    evalSubtreesInParallel(_rootElement, [&](const EntityTreeElementPointer& element, QVector<QUuid>& elementEntities) {
+        glm::vec3 penetration;
+        // if this element doesn't intersect the sphere, then none of its children can
+        if (!element->getAACube().findSpherePenetration(center, radius, penetration)) {
+            return false;
+        }
+        element->evalEntitiesInSphere(center, radius, searchFilter, elementEntities);
+        return true;
+    }, entities);
 
-    // if this element doesn't contain the point, then none of it's children can contain the point, so stop searching
-    return false;
+    _queryCache.insert(key, queryVersion, entities);
+    foundEntities.swap(entities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithType(const glm::vec3& center, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInSphereWithTypeArgs args = { center, radius, type, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithTypeOperation, &args);
-    foundEntities.swap(args.entities);
-}
-
-class FindEntitiesInSphereWithNameArgs {
-public:
-    // Inputs
-    glm::vec3 position;
-    float targetRadius;
-    QString name;
-    bool caseSensitive;
-    PickFilter searchFilter;
-
-    // Outputs
     QVector<QUuid> entities;
-};
-
-bool evalInSphereWithNameOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInSphereWithNameArgs* args = static_cast<FindEntitiesInSphereWithNameArgs*>(extraData);
-    glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
-
-    // If this element contains the point, then search it...
-    if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInSphereWithName(args->position, args->targetRadius, args->name, args->caseSensitive, args->searchFilter, args->entities);
-        return true; // keep searching in case children have closer entities
-    }
-
-    // if this element doesn't contain the point, then none of it's children can contain the point, so stop searching
-    return false;
+    evalSubtreesInParallel(_rootElement, [&](const EntityTreeElementPointer& element, QVector<QUuid>& elementEntities) {
+        glm::vec3 penetration;
+        if (!element->getAACube().findSpherePenetration(center, radius, penetration)) {
+            return false;
+        }
+        element->evalEntitiesInSphereWithType(center, radius, type, searchFilter, elementEntities);
+        return true;
+    }, entities);
+    foundEntities.swap(entities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithName(const glm::vec3& center, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInSphereWithNameArgs args = { center, radius, name, caseSensitive, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithNameOperation, &args);
-    foundEntities.swap(args.entities);
-}
-
-class FindEntitiesInCubeArgs {
-public:
-    // Inputs
-    AACube cube;
-    PickFilter searchFilter;
-
-    // Outputs
     QVector<QUuid> entities;
-};
-
-bool findInCubeOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInCubeArgs* args = static_cast<FindEntitiesInCubeArgs*>(extraData);
-    if (element->getAACube().touches(args->cube)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInCube(args->cube, args->searchFilter, args->entities);
+    evalSubtreesInParallel(_rootElement, [&](const EntityTreeElementPointer& element, QVector<QUuid>& elementEntities) {
+        glm::vec3 penetration;
+        if (!element->getAACube().findSpherePenetration(center, radius, penetration)) {
+            return false;
+        }
+        element->evalEntitiesInSphereWithName(center, radius, name, caseSensitive, searchFilter, elementEntities);
         return true;
-    }
-    return false;
+    }, entities);
+    foundEntities.swap(entities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInCube(const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInCubeArgs args { cube, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(findInCubeOperation, &args);
-    foundEntities.swap(args.entities);
-}
-
-class FindEntitiesInBoxArgs {
-public:
-    // Inputs
-    AABox box;
-    PickFilter searchFilter;
-
-    // Outputs
     QVector<QUuid> entities;
-};
-
-bool findInBoxOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInBoxArgs* args = static_cast<FindEntitiesInBoxArgs*>(extraData);
-    if (element->getAACube().touches(args->box)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInBox(args->box, args->searchFilter, args->entities);
+    evalSubtreesInParallel(_rootElement, [&](const EntityTreeElementPointer& element, QVector<QUuid>& elementEntities) {
+        if (!element->getAACube().touches(cube)) {
+            return false;
+        }
+        element->evalEntitiesInCube(cube, searchFilter, elementEntities);
         return true;
-    }
-    return false;
+    }, entities);
+    foundEntities.swap(entities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInBoxArgs args { box, searchFilter, QVector<QUuid>() };
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInBoxOperation, &args);
-    // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args.entities);
-}
-
-class FindEntitiesInFrustumArgs {
-public:
-    // Inputs
-    ViewFrustum frustum;
-    PickFilter searchFilter;
+    EntityQueryCache::Key key { EntityQueryCache::Box, box.getCorner(), box.getScale(), searchFilter };
+    uint64_t queryVersion = _queryVersion;
+    if (_queryCache.find(key, queryVersion, foundEntities)) {
+        return;
+    }
 
-    // Outputs
     QVector<QUuid> entities;
-};
-
-bool findInFrustumOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInFrustumArgs* args = static_cast<FindEntitiesInFrustumArgs*>(extraData);
-    if (element->isInView(args->frustum)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->evalEntitiesInFrustum(args->frustum, args->searchFilter, args->entities);
+    evalSubtreesInParallel(_rootElement, [&](const EntityTreeElementPointer& element, QVector<QUuid>& elementEntities) {
+        if (!element->getAACube().touches(box)) {
+            return false;
+        }
+        element->evalEntitiesInBox(box, searchFilter, elementEntities);
         return true;
-    }
-    return false;
+    }, entities);
+
+    _queryCache.insert(key, queryVersion, entities);
+    foundEntities.swap(entities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInFrustumArgs args = { frustum, searchFilter, QVector<QUuid>() };
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInFrustumOperation, &args);
-    // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args.entities);
+    QVector<QUuid> entities;
+    evalSubtreesInParallel(_rootElement, [&](const EntityTreeElementPointer& element, QVector<QUuid>& elementEntities) {
+        if (!element->isInView(frustum)) {
+            return false;
+        }
+        element->evalEntitiesInFrustum(frustum, searchFilter, elementEntities);
+        return true;
+    }, entities);
+    foundEntities.swap(entities);
+}
+
+// NOTE: assumes caller has handled locking
+void EntityTree::evalEntitiesInBatch(std::vector<SpatialQuery>& queries, PickFilter searchFilter) {
+    // one traversal for all of the queries, each element is only visited for the queries that touch it
+    std::function<void(const OctreeElementPointer&, const std::vector<size_t>&)> evalElement;
+    evalElement = [&](const OctreeElementPointer& element, const std::vector<size_t>& candidates) {
+        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+        const AACube& cube = element->getAACube();
+        std::vector<size_t> touching;
+        touching.reserve(candidates.size());
+        for (size_t index : candidates) {
+            SpatialQuery& query = queries[index];
+            glm::vec3 penetration;
+            if (query.shape == SpatialQuery::Sphere) {
+                if (cube.findSpherePenetration(query.center, query.radius, penetration)) {
+                    entityTreeElement->evalEntitiesInSphere(query.center, query.radius, searchFilter, query.foundEntities);
+                    touching.push_back(index);
+                }
+            } else if (cube.touches(query.box)) {
+                entityTreeElement->evalEntitiesInBox(query.box, searchFilter, query.foundEntities);
+                touching.push_back(index);
+            }
+        }
+        if (touching.empty()) {
+            return;
+        }
+        for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+            OctreeElementPointer child = element->getChildAtIndex(i);
+            if (child) {
+                evalElement(child, touching);
+            }
+        }
+    };
+
+    std::vector<size_t> all(queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        all[i] = i;
+        queries[i].foundEntities.clear();
+    }
+    if (_rootElement && !all.empty()) {
+        evalElement(_rootElement, all);
+    }
 }
 
 EntityItemPointer EntityTree::findEntityByID(const QUuid& id) const {
@@ -1443,6 +1472,8 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
     // we handle these types of "edit" packets
     switch (message.getType()) {
         case PacketType::EntityErase: {
+            // the batched edits of erased entities apply first
+            applyBatchedEdits();
             QByteArray dataByteArray = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
             processedBytes = processEraseMessageDetails(dataByteArray, senderNode);
             break;
@@ -1458,15 +1489,6 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
         case PacketType::EntityEdit: {
             quint64 startDecode = 0, endDecode = 0;
             quint64 startLookup = 0, endLookup = 0;
-            quint64 startUpdate = 0, endUpdate = 0;
-            quint64 startCreate = 0, endCreate = 0;
-            quint64 startFilter = 0, endFilter = 0;
-            quint64 startLogging = 0, endLogging = 0;
-
-            bool suppressDisallowedClientScript = false;
-            bool suppressDisallowedServerScript = false;
-            bool suppressDisallowedPrivateUserData = false;
-            bool isPhysics = message.getType() == PacketType::EntityPhysics;
 
             _totalEditMessages++;
 
@@ -1481,6 +1503,7 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                 QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
                 validEditPacket = EntityItemProperties::decodeCloneEntityMessage(buffer, processedBytes, entityIDToClone, entityItemID);
                 if (validEditPacket) {
+                    applyBatchedEdit(entityIDToClone);
                     entityToClone = findEntityByEntityItemID(entityIDToClone);
                     if (entityToClone) {
                         properties = entityToClone->getProperties();
@@ -1504,62 +1527,57 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                 }
             }
 
-            if (validEditPacket && !_entityScriptSourceWhitelist.isEmpty()) {
+            _totalDecodeTime += endDecode - startDecode;
+            _totalLookupTime += endLookup - startLookup;
 
-                bool wasDeletedBecauseOfClientScript = false;
+            if (_isEditBatching && validEditPacket) {
+                if (message.getType() == PacketType::EntityEdit) {
+                    batchEdit(entityItemID, properties, senderNode);
+                    break;
+                }
+                // any other edit of the entity applies after the edits batched before it
+                applyBatchedEdit(entityItemID);
+            }
+            applyEdit(message.getType(), entityItemID, properties, senderNode, existingEntity,
+                      entityIDToClone, entityToClone, validEditPacket);
+            break;
+        }
 
-                // check the client entity script to make sure its URL is in the whitelist
-                if (!properties.getScript().isEmpty()) {
-                    bool clientScriptPassedWhitelist = isScriptInWhitelist(properties.getScript());
+        default:
+            processedBytes = 0;
+            break;
+    }
+    return processedBytes;
+}
 
-                    if (!clientScriptPassedWhitelist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set entity script not on whitelist, edit rejected";
-                        }
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                            validEditPacket = false;
-                            wasDeletedBecauseOfClientScript = true;
-                        } else {
-                            suppressDisallowedClientScript = true;
-                        }
-                    }
-                }
+void EntityTree::applyEdit(PacketType packetType, const EntityItemID& entityItemID, EntityItemProperties& properties,
+                           const SharedNodePointer& senderNode, const EntityItemPointer& existingEntity,
+                           const EntityItemID& entityIDToClone, const EntityItemPointer& entityToClone, bool validEditPacket) {
+    quint64 startUpdate = 0, endUpdate = 0;
+    quint64 startCreate = 0, endCreate = 0;
+    quint64 startFilter = 0, endFilter = 0;
+    quint64 startLogging = 0, endLogging = 0;
 
-                // check all server entity scripts to make sure their URLs are in the whitelist
-                if (!properties.getServerScripts().isEmpty()) {
-                    bool serverScriptPassedWhitelist = isScriptInWhitelist(properties.getServerScripts());
+    bool suppressDisallowedClientScript = false;
+    bool suppressDisallowedServerScript = false;
+    bool suppressDisallowedPrivateUserData = false;
+    bool isClone = packetType == PacketType::EntityClone;
+    bool isAdd = isClone || packetType == PacketType::EntityAdd;
+    bool isPhysics = packetType == PacketType::EntityPhysics;
 
-                    if (!serverScriptPassedWhitelist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set server entity script not on whitelist, edit rejected";
-                        }
+    if (validEditPacket && !_entityScriptSourceWhitelist.isEmpty()) {
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            // Make sure we didn't already need to send back a delete because the client script failed
-                            // the whitelist check
-                            if (!wasDeletedBecauseOfClientScript) {
-                                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                                validEditPacket = false;
-                            }
-                        } else {
-                            suppressDisallowedServerScript = true;
-                        }
-                    }
-                }
-            }
+        bool wasDeletedBecauseOfClientScript = false;
+
+        // check the client entity script to make sure its URL is in the whitelist
+        if (!properties.getScript().isEmpty()) {
+            bool clientScriptPassedWhitelist = isScriptInWhitelist(properties.getScript());
 
-            if (!properties.getPrivateUserData().isEmpty() && validEditPacket && !senderNode->getCanGetAndSetPrivateUserData()) {
+            if (!clientScriptPassedWhitelist) {
                 if (wantEditLogging()) {
                     qCDebug(entities) << "User [" << senderNode->getUUID()
-                        << "] is attempting to set private user data but user isn't allowed; edit rejected...";
+                        << "] attempting to set entity script not on whitelist, edit rejected";
                 }
 
                 // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
@@ -1567,175 +1585,269 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                     QWriteLocker locker(&_recentlyDeletedEntitiesLock);
                     _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
                     validEditPacket = false;
+                    wasDeletedBecauseOfClientScript = true;
                 } else {
-                    suppressDisallowedPrivateUserData = true;
+                    suppressDisallowedClientScript = true;
                 }
             }
+        }
 
-            if (!isClone) {
-                if ((isAdd || properties.lifetimeChanged()) &&
-                    ((!senderNode->getCanRez() && senderNode->getCanRezTmp()))) {
-                    // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
-                    if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
-                        properties.getLifetime() > _maxTmpEntityLifetime) {
-                        properties.setLifetime(_maxTmpEntityLifetime);
-                        bumpTimestamp(properties);
-                    }
+        // check all server entity scripts to make sure their URLs are in the whitelist
+        if (!properties.getServerScripts().isEmpty()) {
+            bool serverScriptPassedWhitelist = isScriptInWhitelist(properties.getServerScripts());
+
+            if (!serverScriptPassedWhitelist) {
+                if (wantEditLogging()) {
+                    qCDebug(entities) << "User [" << senderNode->getUUID()
+                        << "] attempting to set server entity script not on whitelist, edit rejected";
                 }
 
-                if (isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
-                    // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
-                    // clear the locked property and allow the unlocked entity to be created.
-                    properties.setLocked(false);
-                    bumpTimestamp(properties);
+                // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+                if (isAdd) {
+                    // Make sure we didn't already need to send back a delete because the client script failed
+                    // the whitelist check
+                    if (!wasDeletedBecauseOfClientScript) {
+                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+                        validEditPacket = false;
+                    }
+                } else {
+                    suppressDisallowedServerScript = true;
                 }
             }
+        }
+    }
 
-            // If we got a valid edit packet, then it could be a new entity or it could be an update to
-            // an existing entity... handle appropriately
-            if (validEditPacket) {
-                startFilter = usecTimestampNow();
-                bool wasChanged = false;
-                // Having (un)lock rights bypasses the filter, unless it's a physics result.
-                FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
-                bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
-                if (!allowed) {
-                    // the update failed and we need to convey that fact to the sender
-                    // our method is to re-assert the current properties and bump the lastEdited timestamp
-                    auto timestamp = properties.getLastEdited();
-                    properties = EntityItemProperties();
-                    properties.setLastEdited(timestamp);
-                }
-                if (!allowed || wasChanged) {
-                    bumpTimestamp(properties);
-                    // For now, free ownership on any modification.
-                    properties.clearSimulationOwner();
-                }
-                endFilter = usecTimestampNow();
+    if (!properties.getPrivateUserData().isEmpty() && validEditPacket && !senderNode->getCanGetAndSetPrivateUserData()) {
+        if (wantEditLogging()) {
+            qCDebug(entities) << "User [" << senderNode->getUUID()
+                << "] is attempting to set private user data but user isn't allowed; edit rejected...";
+        }
 
-                if (existingEntity && !isAdd) {
+        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+        if (isAdd) {
+            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+            validEditPacket = false;
+        } else {
+            suppressDisallowedPrivateUserData = true;
+        }
+    }
 
-                    if (suppressDisallowedClientScript) {
-                        bumpTimestamp(properties);
-                        properties.setScript(existingEntity->getScript());
-                    }
+    if (!isClone) {
+        if ((isAdd || properties.lifetimeChanged()) &&
+            ((!senderNode->getCanRez() && senderNode->getCanRezTmp()))) {
+            // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
+            if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
+                properties.getLifetime() > _maxTmpEntityLifetime) {
+                properties.setLifetime(_maxTmpEntityLifetime);
+                bumpTimestamp(properties);
+            }
+        }
 
-                    if (suppressDisallowedServerScript) {
-                        bumpTimestamp(properties);
-                        properties.setServerScripts(existingEntity->getServerScripts());
-                    }
+        if (isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
+            // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
+            // clear the locked property and allow the unlocked entity to be created.
+            properties.setLocked(false);
+            bumpTimestamp(properties);
+        }
+    }
 
-                    if (suppressDisallowedPrivateUserData) {
-                        bumpTimestamp(properties);
-                        properties.setPrivateUserData(existingEntity->getPrivateUserData());
-                    }
+    // If we got a valid edit packet, then it could be a new entity or it could be an update to
+    // an existing entity... handle appropriately
+    if (validEditPacket) {
+        startFilter = usecTimestampNow();
+        bool wasChanged = false;
+        // Having (un)lock rights bypasses the filter, unless it's a physics result.
+        FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
+        bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
+        if (!allowed) {
+            // the update failed and we need to convey that fact to the sender
+            // our method is to re-assert the current properties and bump the lastEdited timestamp
+            auto timestamp = properties.getLastEdited();
+            properties = EntityItemProperties();
+            properties.setLastEdited(timestamp);
+        }
+        if (!allowed || wasChanged) {
+            bumpTimestamp(properties);
+            // For now, free ownership on any modification.
+            properties.clearSimulationOwner();
+        }
+        endFilter = usecTimestampNow();
+
+        if (existingEntity && !isAdd) {
+
+            if (suppressDisallowedClientScript) {
+                bumpTimestamp(properties);
+                properties.setScript(existingEntity->getScript());
+            }
+
+            if (suppressDisallowedServerScript) {
+                bumpTimestamp(properties);
+                properties.setServerScripts(existingEntity->getServerScripts());
+            }
+
+            if (suppressDisallowedPrivateUserData) {
+                bumpTimestamp(properties);
+                properties.setPrivateUserData(existingEntity->getPrivateUserData());
+            }
+
+            // if the EntityItem exists, then update it
+            startLogging = usecTimestampNow();
+            if (wantEditLogging()) {
+                qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                qCDebug(entities) << "   properties:" << properties;
+            }
+            if (wantTerseEditLogging()) {
+                QList<QString> changedProperties = properties.listChangedProperties();
+                fixupTerseEditLogging(properties, changedProperties);
+                qCDebug(entities) << senderNode->getUUID() << "edit" <<
+                    existingEntity->getDebugName() << changedProperties;
+            }
+            endLogging = usecTimestampNow();
+
+            startUpdate = usecTimestampNow();
+            if (!isPhysics) {
+                properties.setLastEditedBy(senderNode->getUUID());
+            }
+            updateEntity(existingEntity, properties, senderNode);
+            existingEntity->markAsChangedOnServer();
+            endUpdate = usecTimestampNow();
+            _totalUpdates++;
+        } else if (isAdd) {
+            bool failedAdd = !allowed;
+            bool isCloneable = properties.getCloneable();
+            int cloneLimit = properties.getCloneLimit();
+            if (!allowed) {
+                qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
+            } else if (!isClone && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
+                failedAdd = true;
+                qCDebug(entities) << "User without 'rez rights' [" << senderNode->getUUID()
+                    << "] attempted to add an entity with ID:" << entityItemID;
+            } else if (isClone && !isCloneable) {
+                failedAdd = true;
+                qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
+            } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
+                failedAdd = true;
+                qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
+            } else {
+                if (isClone) {
+                    properties.convertToCloneProperties(entityIDToClone);
+                }
+
+                // this is a new entity... assign a new entityID
+                properties.setLastEditedBy(senderNode->getUUID());
+                startCreate = usecTimestampNow();
+                EntityItemPointer newEntity = addEntity(entityItemID, properties);
+                endCreate = usecTimestampNow();
+                _totalCreates++;
 
-                    // if the EntityItem exists, then update it
+                if (newEntity && isClone) {
+                    entityToClone->addCloneID(newEntity->getEntityItemID());
+                    newEntity->setCloneOriginID(entityIDToClone);
+                }
+
+                if (newEntity) {
+                    newEntity->markAsChangedOnServer();
+                    notifyNewlyCreatedEntity(*newEntity, senderNode);
+                    
                     startLogging = usecTimestampNow();
                     if (wantEditLogging()) {
-                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
+                                          << newEntity->getEntityItemID();
                         qCDebug(entities) << "   properties:" << properties;
                     }
                     if (wantTerseEditLogging()) {
                         QList<QString> changedProperties = properties.listChangedProperties();
                         fixupTerseEditLogging(properties, changedProperties);
-                        qCDebug(entities) << senderNode->getUUID() << "edit" <<
-                            existingEntity->getDebugName() << changedProperties;
+                        qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
                     }
                     endLogging = usecTimestampNow();
 
-                    startUpdate = usecTimestampNow();
-                    if (!isPhysics) {
-                        properties.setLastEditedBy(senderNode->getUUID());
-                    }
-                    updateEntity(existingEntity, properties, senderNode);
-                    existingEntity->markAsChangedOnServer();
-                    endUpdate = usecTimestampNow();
-                    _totalUpdates++;
-                } else if (isAdd) {
-                    bool failedAdd = !allowed;
-                    bool isCloneable = properties.getCloneable();
-                    int cloneLimit = properties.getCloneLimit();
-                    if (!allowed) {
-                        qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
-                    } else if (!isClone && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add an entity with ID:" << entityItemID;
-                    } else if (isClone && !isCloneable) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
-                    } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
-                    } else {
-                        if (isClone) {
-                            properties.convertToCloneProperties(entityIDToClone);
-                        }
-
-                        // this is a new entity... assign a new entityID
-                        properties.setLastEditedBy(senderNode->getUUID());
-                        startCreate = usecTimestampNow();
-                        EntityItemPointer newEntity = addEntity(entityItemID, properties);
-                        endCreate = usecTimestampNow();
-                        _totalCreates++;
-
-                        if (newEntity && isClone) {
-                            entityToClone->addCloneID(newEntity->getEntityItemID());
-                            newEntity->setCloneOriginID(entityIDToClone);
-                        }
-
-                        if (newEntity) {
-                            newEntity->markAsChangedOnServer();
-                            notifyNewlyCreatedEntity(*newEntity, senderNode);
-                            
-                            startLogging = usecTimestampNow();
-                            if (wantEditLogging()) {
-                                qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
-                                                  << newEntity->getEntityItemID();
-                                qCDebug(entities) << "   properties:" << properties;
-                            }
-                            if (wantTerseEditLogging()) {
-                                QList<QString> changedProperties = properties.listChangedProperties();
-                                fixupTerseEditLogging(properties, changedProperties);
-                                qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
-                            }
-                            endLogging = usecTimestampNow();
-
-                        } else {
-                            failedAdd = true;
-                            qCDebug(entities) << "Add entity failed ID:" << entityItemID;
-                        }
-                    }
-                    if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
-                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                    }
                 } else {
-                    HIFI_FCDEBUG(entities(), "Edit failed. [" << message.getType() <<"] " <<
-                            "entity id:" << entityItemID << 
-                            "existingEntity pointer:" << existingEntity.get());
+                    failedAdd = true;
+                    qCDebug(entities) << "Add entity failed ID:" << entityItemID;
                 }
             }
+            if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
+                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+            }
+        } else {
+            HIFI_FCDEBUG(entities(), "Edit failed. [" << packetType <<"] " <<
+                    "entity id:" << entityItemID << 
+                    "existingEntity pointer:" << existingEntity.get());
+        }
+    }
 
+    _totalUpdateTime += endUpdate - startUpdate;
+    _totalCreateTime += endCreate - startCreate;
+    _totalLoggingTime += endLogging - startLogging;
+    _totalFilterTime += endFilter - startFilter;
+}
 
-            _totalDecodeTime += endDecode - startDecode;
-            _totalLookupTime += endLookup - startLookup;
-            _totalUpdateTime += endUpdate - startUpdate;
-            _totalCreateTime += endCreate - startCreate;
-            _totalLoggingTime += endLogging - startLogging;
-            _totalFilterTime += endFilter - startFilter;
+// whether applying later leaves nothing of earlier, so that earlier need not be applied at all
+static bool supersedesEdit(const EntityItemProperties& later, const EntityItemProperties& earlier) {
+    EntityPropertyFlags laterProperties = later.getChangedProperties();
+    EntityPropertyFlags earlierProperties = earlier.getChangedProperties();
+    for (int flag = (int)earlierProperties.firstFlag(); flag <= (int)earlierProperties.lastFlag(); flag++) {
+        if (earlierProperties.getHasProperty((EntityPropertyList)flag) && !laterProperties.getHasProperty((EntityPropertyList)flag)) {
+            return false;
+        }
+    }
+    return true;
+}
 
-            break;
+void EntityTree::beginEditBatch() {
+    _isEditBatching = true;
+}
+
+void EntityTree::endEditBatch() {
+    applyBatchedEdits();
+    _isEditBatching = false;
+}
+
+void EntityTree::batchEdit(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode) {
+    auto index = _batchedEditIndices.find(entityID);
+    if (index != _batchedEditIndices.end()) {
+        BatchedEdit& batched = _batchedEdits[index.value()];
+        if (batched.senderNode == senderNode && supersedesEdit(properties, batched.properties)) {
+            // last writer wins
+            batched.properties = properties;
+            _totalSupersededEdits++;
+            return;
         }
+        applyBatchedEdit(entityID);
+    }
+    _batchedEditIndices[entityID] = _batchedEdits.size();
+    _batchedEdits.push_back({ entityID, properties, senderNode, false });
+}
 
-        default:
-            processedBytes = 0;
-            break;
+void EntityTree::applyBatchedEdit(const EntityItemID& entityID) {
+    auto index = _batchedEditIndices.find(entityID);
+    if (index == _batchedEditIndices.end()) {
+        return;
     }
-    return processedBytes;
+    BatchedEdit& batched = _batchedEdits[index.value()];
+    _batchedEditIndices.erase(index);
+    batched.applied = true;
+
+    EntityItemPointer existingEntity = findEntityByEntityItemID(entityID);
+    applyEdit(PacketType::EntityEdit, entityID, batched.properties, batched.senderNode, existingEntity,
+              EntityItemID(), EntityItemPointer(), (bool)existingEntity);
 }
 
+void EntityTree::applyBatchedEdits() {
+    for (auto& batched : _batchedEdits) {
+        if (!batched.applied) {
+            EntityItemPointer existingEntity = findEntityByEntityItemID(batched.entityID);
+            applyEdit(PacketType::EntityEdit, batched.entityID, batched.properties, batched.senderNode, existingEntity,
+                      EntityItemID(), EntityItemPointer(), (bool)existingEntity);
+        }
+    }
+    _batchedEdits.clear();
+    _batchedEditIndices.clear();
+}
 
 void EntityTree::notifyNewlyCreatedEntity(const EntityItem& newEntity, const SharedNodePointer& senderNode) {
     _newlyCreatedHooksLock.lockForRead();
@@ -1768,6 +1880,7 @@ void EntityTree::releaseSceneEncodeData(OctreeElementExtraEncodeData* extraEncod
 }
 
 void EntityTree::entityChanged(EntityItemPointer entity) {
+    bumpQueryVersion();
     if (entity->isSimulated()) {
         _simulation->changeEntity(entity);
     }
@@ -1876,6 +1989,7 @@ void EntityTree::fixupNeedsParentFixups() {
     if (moveOperator.hasMovingEntities()) {
         PerformanceTimer perfTimer("recurseTreeWithOperator");
         recurseTreeWithOperator(&moveOperator);
+        bumpQueryVersion();
     }
 
     {
@@ -1943,6 +2057,8 @@ void EntityTree::update(bool simulate) {
         withWriteLock([&] {
             _simulation->updateEntities();
         });
+        // simulated entities may have moved
+        bumpQueryVersion();
     }
 }
 
@@ -2204,6 +2320,22 @@ bool ContentsDimensionOperator::preRecursion(const OctreeElementPointer& element
     return true;
 }
 
+std::vector<EntityTree::EntityMemoryStats> EntityTree::getMemoryStats() const {
+    std::vector<EntityMemoryStats> stats(EntityTypes::NUM_TYPES);
+    QReadLocker locker(&_entityMapLock);
+    foreach(EntityItemPointer entity, _entityMap) {
+        auto type = entity->getType();
+        if (type < 0 || type >= EntityTypes::NUM_TYPES) {
+            continue;
+        }
+        auto& typeStats = stats[type];
+        ++typeStats.numEntities;
+        typeStats.objectBytes += EntityTypes::getEntityTypeSize(type);
+        typeStats.unsharedStringBytes += entity->getUnsharedStringBytes();
+    }
+    return stats;
+}
+
 glm::vec3 EntityTree::getContentsDimensions() {
     ContentsDimensionOperator theOperator;
     recurseTreeWithOperator(&theOperator);
@@ -2888,6 +3020,318 @@ bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& el
     return true;
 }
 
+static const size_t ENTITIES_PER_SNAPSHOT_CHUNK = 1024;
+static const int INITIAL_SNAPSHOT_RECORD_SIZE = 64 * 1024;
+static const int MAX_SNAPSHOT_RECORD_SIZE = 64 * 1024 * 1024;
+
+// Leaves the wire encoding of the whole entity in packetData, growing it until the entity fits, as a record is never split
+static bool encodeEntityRecord(OctreePacketData& packetData, const EntityItemPointer& entity,
+                               bool includePrivateUserData = true) {
+    EncodeBitstreamParams params;
+    for (;;) {
+        auto extraEncodeData = std::make_shared<EntityTreeElementExtraEncodeData>();
+        packetData.reset();
+        if (entity->appendEntityData(&packetData, params, extraEncodeData, includePrivateUserData) == OctreeElement::COMPLETED) {
+            return true;
+        }
+        if ((int)packetData.getTargetSize() >= MAX_SNAPSHOT_RECORD_SIZE) {
+            qCWarning(entities) << "EntityTree: entity too large to persist" << entity->getEntityItemID();
+            return false;
+        }
+        packetData.changeSettings(false, packetData.getTargetSize() * 2);
+    }
+}
+
+static EntityItemPointer decodeEntityRecord(const unsigned char* data, uint32_t size, ReadBitstreamToTreeParams& args) {
+    EntityItemPointer entity = EntityTypes::constructEntityItem(data, size);
+    if (entity && entity->readEntityDataFromBuffer(data, size, args) > 0) {
+        return entity;
+    }
+    return nullptr;
+}
+
+void EntityTree::addDecodedEntity(const EntityItemPointer& entity) {
+    AddEntityOperator theOperator(getThisPointer(), entity);
+    recurseTreeWithOperator(&theOperator);
+    postAddEntity(entity);
+}
+
+bool EntityTree::writeToSnapshot(QByteArray& snapshot) {
+    std::vector<EntityItemPointer> entities;
+    std::vector<QByteArray> chunkData;
+    std::atomic<bool> success { true };
+
+    // encode under the read lock so the snapshot is consistent, but spread the encoding over the chunks
+    withReadLock([&] {
+        {
+            QReadLocker locker(&_entityMapLock);
+            entities.reserve(_entityMap.size());
+            for (const auto& entity : _entityMap) {
+                entities.push_back(entity);
+            }
+        }
+
+        size_t numChunks = (entities.size() + ENTITIES_PER_SNAPSHOT_CHUNK - 1) / ENTITIES_PER_SNAPSHOT_CHUNK;
+        chunkData.resize(numChunks);
+        tbb::parallel_for((size_t)0, numChunks, [&](size_t chunkIndex) {
+            OctreePacketData packetData(false, INITIAL_SNAPSHOT_RECORD_SIZE);
+            QByteArray& chunk = chunkData[chunkIndex];
+
+            size_t end = std::min(entities.size(), (chunkIndex + 1) * ENTITIES_PER_SNAPSHOT_CHUNK);
+            for (size_t i = chunkIndex * ENTITIES_PER_SNAPSHOT_CHUNK; i < end; ++i) {
+                if (!encodeEntityRecord(packetData, entities[i])) {
+                    success = false;
+                    return;
+                }
+
+                uint32_t recordSize = packetData.getUncompressedSize();
+                chunk.append(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+                chunk.append(reinterpret_cast<const char*>(packetData.getUncompressedData()), recordSize);
+            }
+        });
+    });
+
+    if (!success) {
+        return false;
+    }
+
+    OctreeSnapshot::Header header;
+    memcpy(header.magic, OctreeSnapshot::MAGIC, sizeof(header.magic));
+    header.formatVersion = OctreeSnapshot::FORMAT_VERSION;
+    header.bitstreamVersion = expectedVersion();
+    header.dataVersion = _persistDataVersion;
+    memcpy(header.id, _persistID.toRfc4122().constData(), sizeof(header.id));
+    header.numItems = (uint32_t)entities.size();
+    header.numChunks = (uint32_t)chunkData.size();
+
+    std::vector<OctreeSnapshot::Chunk> index(chunkData.size());
+    uint64_t offset = sizeof(header);
+    for (size_t i = 0; i < chunkData.size(); ++i) {
+        index[i].offset = offset;
+        index[i].size = (uint32_t)chunkData[i].size();
+        index[i].numItems = (uint32_t)(std::min(entities.size(), (i + 1) * ENTITIES_PER_SNAPSHOT_CHUNK) - i * ENTITIES_PER_SNAPSHOT_CHUNK);
+        offset += chunkData[i].size();
+    }
+    header.indexOffset = offset;
+
+    snapshot.clear();
+    snapshot.reserve((int)(offset + index.size() * sizeof(OctreeSnapshot::Chunk)));
+    snapshot.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const auto& chunk : chunkData) {
+        snapshot.append(chunk);
+    }
+    snapshot.append(reinterpret_cast<const char*>(index.data()), (int)(index.size() * sizeof(OctreeSnapshot::Chunk)));
+    return true;
+}
+
+bool EntityTree::readFromSnapshot(const char* data, qint64 size) {
+    const OctreeSnapshot::Header* header = OctreeSnapshot::readHeader(data, size);
+    if (!header) {
+        qCWarning(entities) << "EntityTree::readFromSnapshot: not an entity snapshot";
+        return false;
+    }
+    if (header->bitstreamVersion != expectedVersion()) {
+        qCWarning(entities) << "EntityTree::readFromSnapshot: snapshot is of version" << header->bitstreamVersion
+                            << "expected" << expectedVersion();
+        return false;
+    }
+    const OctreeSnapshot::Chunk* chunks = OctreeSnapshot::readChunks(data, size, *header);
+    if (!chunks) {
+        qCWarning(entities) << "EntityTree::readFromSnapshot: snapshot is truncated";
+        return false;
+    }
+
+    // decode every chunk in parallel, only adding to the tree is serial
+    std::vector<std::vector<EntityItemPointer>> decoded(header->numChunks);
+    std::atomic<bool> success { true };
+    tbb::parallel_for((uint32_t)0, header->numChunks, [&](uint32_t chunkIndex) {
+        const OctreeSnapshot::Chunk& chunk = chunks[chunkIndex];
+        const unsigned char* dataAt = reinterpret_cast<const unsigned char*>(data + chunk.offset);
+        const unsigned char* dataEnd = dataAt + chunk.size;
+        std::vector<EntityItemPointer>& chunkEntities = decoded[chunkIndex];
+        chunkEntities.reserve(chunk.numItems);
+
+        ReadBitstreamToTreeParams args;
+        while (dataEnd - dataAt >= (ptrdiff_t)sizeof(uint32_t)) {
+            uint32_t recordSize;
+            memcpy(&recordSize, dataAt, sizeof(recordSize));
+            dataAt += sizeof(recordSize);
+            if (recordSize > (uint32_t)(dataEnd - dataAt)) {
+                success = false;
+                return;
+            }
+
+            EntityItemPointer entity = decodeEntityRecord(dataAt, recordSize, args);
+            if (entity) {
+                chunkEntities.push_back(entity);
+            } else {
+                success = false;
+            }
+            dataAt += recordSize;
+        }
+    });
+
+    if (!success) {
+        qCWarning(entities) << "EntityTree::readFromSnapshot: failed to decode entities";
+        return false;
+    }
+
+    _persistID = QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(header->id), sizeof(header->id)));
+    _persistDataVersion = header->dataVersion;
+
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
+    for (const auto& chunkEntities : decoded) {
+        for (const auto& entity : chunkEntities) {
+            if (getContainingElement(entity->getEntityItemID())) {
+                qCWarning(entities) << "EntityTree::readFromSnapshot: duplicate entity" << entity->getEntityItemID();
+                continue;
+            }
+            addDecodedEntity(entity);
+
+            const QUuid& cloneOriginID = entity->getCloneOriginID();
+            if (!cloneOriginID.isNull()) {
+                cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+            }
+        }
+    }
+
+    for (const auto& entityID : cloneIDs.keys()) {
+        auto entity = findEntityByID(entityID);
+        if (entity) {
+            entity->setCloneIDs(cloneIDs.value(entityID));
+        }
+    }
+
+    return true;
+}
+
+void EntityTree::trackJournalChange(const EntityItemID& entityID) {
+    QMutexLocker locker(&_journalLock);
+    _journalErasedEntities.remove(entityID);
+    _journalChangedEntities.insert(entityID);
+}
+
+void EntityTree::trackJournalErase(const EntityItemID& entityID) {
+    QMutexLocker locker(&_journalLock);
+    _journalChangedEntities.remove(entityID);
+    _journalErasedEntities.insert(entityID);
+}
+
+bool EntityTree::writeJournalRecords(QByteArray& records) {
+    QSet<EntityItemID> changedEntities;
+    QSet<EntityItemID> erasedEntities;
+    {
+        QMutexLocker locker(&_journalLock);
+        changedEntities.swap(_journalChangedEntities);
+        erasedEntities.swap(_journalErasedEntities);
+    }
+
+    bool success = true;
+    if (!changedEntities.isEmpty()) {
+        OctreePacketData packetData(false, INITIAL_SNAPSHOT_RECORD_SIZE);
+        withReadLock([&] {
+            for (const auto& entityID : changedEntities) {
+                EntityItemPointer entity = findEntityByEntityItemID(entityID);
+                if (!entity) {
+                    continue; // erased since, and tracked as such
+                }
+                if (encodeEntityRecord(packetData, entity)) {
+                    OctreeJournal::appendRecord(records, OctreeJournal::Upsert,
+                                                reinterpret_cast<const char*>(packetData.getUncompressedData()),
+                                                packetData.getUncompressedSize());
+                } else {
+                    success = false;
+                }
+            }
+        });
+    }
+    for (const auto& entityID : erasedEntities) {
+        QByteArray encodedID = entityID.toRfc4122();
+        OctreeJournal::appendRecord(records, OctreeJournal::Erase, encodedID.constData(), encodedID.size());
+    }
+    return success;
+}
+
+bool EntityTree::readJournalRecord(OctreeJournal::RecordType type, const char* data, uint32_t size) {
+    // NOTE: assume tree already write-locked, the journal is replayed with the persist it follows
+    if (type == OctreeJournal::Erase) {
+        if (size != NUM_BYTES_RFC4122_UUID) {
+            return false;
+        }
+        EntityItemPointer entity = findEntityByID(QUuid::fromRfc4122(QByteArray::fromRawData(data, size)));
+        if (entity) {
+            // each descendant erased with it has its own record
+            deleteEntitiesByPointer({ entity });
+        }
+        return true;
+    }
+    if (type != OctreeJournal::Upsert) {
+        return false;
+    }
+
+    const unsigned char* record = reinterpret_cast<const unsigned char*>(data);
+    ReadBitstreamToTreeParams args;
+    EntityItemPointer decoded = decodeEntityRecord(record, size, args);
+    if (!decoded) {
+        return false;
+    }
+
+    EntityItemPointer existing = findEntityByEntityItemID(decoded->getEntityItemID());
+    if (!existing) {
+        addDecodedEntity(decoded);
+        const QUuid& cloneOriginID = decoded->getCloneOriginID();
+        EntityItemPointer cloneOrigin = cloneOriginID.isNull() ? nullptr : findEntityByID(cloneOriginID);
+        if (cloneOrigin) {
+            cloneOrigin->addCloneID(decoded->getEntityItemID());
+        }
+        return true;
+    }
+
+    // move the entity to where the record puts it, then apply the record the way clients apply full updates
+    QUuid parentIDBefore = existing->getParentID();
+    EntityTreeElementPointer containingElement = existing->getElement();
+    if (containingElement) {
+        UpdateEntityOperator theOperator(getThisPointer(), containingElement, existing, decoded->getQueryAACube());
+        recurseTreeWithOperator(&theOperator);
+    }
+    bumpQueryVersion();
+    existing->readEntityDataFromBuffer(record, size, args);
+    if (existing->getDirtyFlags()) {
+        entityChanged(existing);
+    }
+    if (existing->getParentID() != parentIDBefore) {
+        addToNeedsParentFixupList(existing);
+    }
+    _isDirty = true;
+    return true;
+}
+
+QByteArray EntityTree::trainCompressionDictionary() {
+    // enough samples for the byte strings that recur across the entities of a domain, and few enough to train quickly
+    const size_t MAX_DICTIONARY_SAMPLES = 1024;
+
+    std::vector<QByteArray> samples;
+    withReadLock([&] {
+        QReadLocker locker(&_entityMapLock);
+        size_t stride = std::max((size_t)1, (size_t)_entityMap.size() / MAX_DICTIONARY_SAMPLES);
+        samples.reserve(std::min((size_t)_entityMap.size(), MAX_DICTIONARY_SAMPLES));
+
+        OctreePacketData packetData(false, INITIAL_SNAPSHOT_RECORD_SIZE);
+        size_t index = 0;
+        for (const auto& entity : _entityMap) {
+            if (index++ % stride != 0 || samples.size() >= MAX_DICTIONARY_SAMPLES) {
+                continue;
+            }
+            // the dictionary is sent to every viewer, so it leaves out what only some may see
+            if (encodeEntityRecord(packetData, entity, false)) {
+                samples.emplace_back(reinterpret_cast<const char*>(packetData.getUncompressedData()),
+                                     packetData.getUncompressedSize());
+            }
+        }
+    });
+    return OctreeCompressionDictionary::train(samples);
+}
+
 void EntityTree::resetClientEditStats() {
     _treeResetTime = usecTimestampNow();
     _maxEditDelta = 0;
@@ -3046,5 +3490,6 @@ void EntityTree::updateEntityQueryAACube(SpatiallyNestablePointer object, Entity
     if (moveOperator.hasMovingEntities()) {
         PerformanceTimer perfTimer("recurseTreeWithOperator");
         recurseTreeWithOperator(&moveOperator);
+        bumpQueryVersion();
     }
 }
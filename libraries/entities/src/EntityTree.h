@@ -12,6 +12,7 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <QMutex>
 #include <QSet>
 #include <QVector>
 
@@ -22,6 +23,7 @@
 #include "AddEntityOperator.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
+#include "EntityQueryCache.h"
 #include "MovingEntitiesOperator.h"
 
 class EntityTree;
@@ -91,6 +93,8 @@ public:
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
+    virtual void beginEditBatch() override;
+    virtual void endEditBatch() override;
 
     virtual EntityItemID evalRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
         QVector<EntityItemID> entityIdsToInclude, QVector<EntityItemID> entityIdsToDiscard,
@@ -143,6 +147,20 @@ public:
     void evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities);
     void evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities);
 
+    // a sphere or box query of a batch, evaluated together in one traversal of the tree
+    struct SpatialQuery {
+        enum Shape : uint8_t {
+            Sphere,
+            Box
+        };
+        Shape shape { Sphere };
+        glm::vec3 center;
+        float radius { 0.0f };
+        AABox box;
+        QVector<QUuid> foundEntities;
+    };
+    void evalEntitiesInBatch(std::vector<SpatialQuery>& queries, PickFilter searchFilter);
+
     void addNewlyCreatedHook(NewlyCreatedEntityHook* hook);
     void removeNewlyCreatedHook(NewlyCreatedEntityHook* hook);
 
@@ -196,11 +214,26 @@ public:
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) override;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) override;
+    virtual bool writeToSnapshot(QByteArray& snapshot) override;
+    virtual bool readFromSnapshot(const char* data, qint64 size) override;
+    virtual bool writeJournalRecords(QByteArray& records) override;
+    virtual bool readJournalRecord(OctreeJournal::RecordType type, const char* data, uint32_t size) override;
+
+    // trains a dictionary for the compression of entity data packets from a sample of the entities
+    QByteArray trainCompressionDictionary();
 
 
     glm::vec3 getContentsDimensions();
     float getContentsLargestDimension();
 
+    struct EntityMemoryStats {
+        int numEntities { 0 };
+        size_t objectBytes { 0 };
+        size_t unsharedStringBytes { 0 };
+    };
+    // the memory used by the entities of each type, indexed by EntityTypes::EntityType
+    std::vector<EntityMemoryStats> getMemoryStats() const;
+
     virtual void resetEditStats() override {
         _totalEditMessages = 0;
         _totalUpdates = 0;
@@ -210,6 +243,7 @@ public:
         _totalUpdateTime = 0;
         _totalCreateTime = 0;
         _totalLoggingTime = 0;
+        _totalSupersededEdits = 0;
     }
 
     virtual quint64 getAverageDecodeTime() const override { return _totalEditMessages == 0 ? 0 : _totalDecodeTime / _totalEditMessages; }
@@ -218,6 +252,7 @@ public:
     virtual quint64 getAverageCreateTime() const override { return _totalCreates == 0 ? 0 : _totalCreateTime / _totalCreates; }
     virtual quint64 getAverageLoggingTime() const override { return _totalEditMessages == 0 ? 0 : _totalLoggingTime / _totalEditMessages; }
     virtual quint64 getAverageFilterTime() const override { return _totalEditMessages == 0 ? 0 : _totalFilterTime / _totalEditMessages; }
+    virtual quint64 getTotalSupersededEdits() const override { return _totalSupersededEdits; }
 
     void trackIncomingEntityLastEdited(quint64 lastEditedTime, int bytesRead);
     quint64 getAverageEditDeltas() const
@@ -296,6 +331,25 @@ protected:
     bool updateEntity(EntityItemPointer entity, const EntityItemProperties& properties,
             const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
     static bool sendEntitiesOperation(const OctreeElementPointer& element, void* extraData);
+
+    void applyEdit(PacketType packetType, const EntityItemID& entityItemID, EntityItemProperties& properties,
+                   const SharedNodePointer& senderNode, const EntityItemPointer& existingEntity,
+                   const EntityItemID& entityIDToClone, const EntityItemPointer& entityToClone, bool validEditPacket);
+
+    // while edit batching, plain edits are held back until the end of the batch, and an edit setting all
+    // of the properties of a held back edit from the same sender replaces it
+    struct BatchedEdit {
+        EntityItemID entityID;
+        EntityItemProperties properties;
+        SharedNodePointer senderNode;
+        bool applied;
+    };
+    void batchEdit(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode);
+    void applyBatchedEdit(const EntityItemID& entityID);
+    void applyBatchedEdits();
+    bool _isEditBatching { false };
+    std::vector<BatchedEdit> _batchedEdits;
+    QHash<EntityItemID, size_t> _batchedEditIndices;
     static void bumpTimestamp(EntityItemProperties& properties);
 
     void notifyNewlyCreatedEntity(const EntityItem& newEntity, const SharedNodePointer& senderNode);
@@ -324,6 +378,20 @@ protected:
     mutable QReadWriteLock _entityMapLock;
     QHash<EntityItemID, EntityItemPointer> _entityMap;
 
+    // bumped by each change of the tree, so cached query results of an older version are not found
+    void bumpQueryVersion() { ++_queryVersion; }
+    std::atomic<uint64_t> _queryVersion { 0 };
+    EntityQueryCache _queryCache;
+
+    void addDecodedEntity(const EntityItemPointer& entity);
+
+    // entities changed and erased since the last writeJournalRecords(), while journaling
+    void trackJournalChange(const EntityItemID& entityID);
+    void trackJournalErase(const EntityItemID& entityID);
+    QMutex _journalLock;
+    QSet<EntityItemID> _journalChangedEntities;
+    QSet<EntityItemID> _journalErasedEntities;
+
     EntitySimulationPointer _simulation;
 
     bool _wantEditLogging = false;
@@ -340,6 +408,7 @@ protected:
     mutable quint64 _totalCreateTime = 0;
     mutable quint64 _totalLoggingTime = 0;
     mutable quint64 _totalFilterTime = 0;
+    quint64 _totalSupersededEdits = 0;
 
     // these performance statistics are only used in the client
     void resetClientEditStats();
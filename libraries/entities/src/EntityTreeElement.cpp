@@ -11,6 +11,8 @@
 
 #include "EntityTreeElement.h"
 
+#include <algorithm>
+
 #include <glm/gtx/transform.hpp>
 
 #include <GeometryUtil.h>
@@ -189,32 +191,109 @@ EntityItemID EntityTreeElement::evalRayIntersection(const glm::vec3& origin, con
     return result;
 }
 
+std::shared_ptr<const EntityTreeElement::EntityBoundsSnapshot> EntityTreeElement::getEntityBounds() const {
+    // Taken before the bounds, so that a change made while they are read leaves the snapshot out of date
+    uint32_t version = _entityBoundsVersion;
+    auto snapshot = std::atomic_load(&_entityBounds);
+    if (snapshot && snapshot->version == version) {
+        return snapshot;
+    }
+
+    auto newSnapshot = std::make_shared<EntityBoundsSnapshot>();
+    newSnapshot->version = version;
+    withReadLock([&] {
+        newSnapshot->bounds.reserve(_entityItems.size());
+        foreach(EntityItemPointer entity, _entityItems) {
+            bool success;
+            AABox box = entity->getAABox(success);
+            // entities whose parents haven't arrived have no bounds yet, and can't be picked until they do
+            if (success) {
+                newSnapshot->bounds.push_back({ box, entity });
+            }
+        }
+    });
+    std::atomic_store(&_entityBounds, std::shared_ptr<const EntityBoundsSnapshot>(newSnapshot));
+    return newSnapshot;
+}
+
+// the distance along the ray at which it enters the box, 0 if it starts inside the box, or false if it misses it
+static bool findRayAABoxEntryDistance(const glm::vec3& origin, const glm::vec3& direction, const AABox& box, float& entry) {
+    const glm::vec3& minimum = box.getMinimumPoint();
+    glm::vec3 maximum = box.getMaximumPoint();
+    float entryDistance = 0.0f;
+    float exitDistance = FLT_MAX;
+    for (int i = 0; i < 3; i++) {
+        if (direction[i] == 0.0f) {
+            if (origin[i] < minimum[i] || origin[i] > maximum[i]) {
+                return false;
+            }
+            continue;
+        }
+        float inverse = 1.0f / direction[i];
+        float t1 = (minimum[i] - origin[i]) * inverse;
+        float t2 = (maximum[i] - origin[i]) * inverse;
+        entryDistance = glm::max(entryDistance, glm::min(t1, t2));
+        exitDistance = glm::min(exitDistance, glm::max(t1, t2));
+        if (entryDistance > exitDistance) {
+            return false;
+        }
+    }
+    entry = entryDistance;
+    return true;
+}
+
 EntityItemID EntityTreeElement::evalDetailedRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& viewFrustumPos,
                                     OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
                                     const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIDsToDiscard,
                                     PickFilter searchFilter, QVariantMap& extraInfo) {
 
-    // only called if we do intersect our bounding cube, but find if we actually intersect with entities...
-    EntityItemID entityID;
-    forEachEntity([&](EntityItemPointer entity) {
+    // Only called if we do intersect our bounding cube. Each entity's world box is tested first, as the box is cached and the
+    // ray will hit nothing of the entity nearer than it, then the entities left are tested nearest first, so that once one
+    // is hit, those whose boxes are farther than the hit are never transformed into.
+    struct Candidate {
+        float entry;
+        const EntityBounds* bounds;
+    };
+    std::vector<Candidate> candidates;
+
+    auto snapshot = getEntityBounds();
+    candidates.reserve(snapshot->bounds.size());
+    for (const EntityBounds& bounds : snapshot->bounds) {
+        const EntityItemPointer& entity = bounds.entity;
         if (entity->getIgnorePickIntersection() && !searchFilter.bypassIgnore()) {
-            return;
+            continue;
         }
 
-        // use simple line-sphere for broadphase check
-        // (this is faster and more likely to cull results than the filter check below so we do it first)
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-        if (!success || !entityBox.rayHitsBoundingSphere(origin, direction)) {
-            return;
+        float entry = 0.0f;
+        if (entity->getBillboardMode() != BillboardMode::NONE) {
+            // billboards are picked facing the camera, so their world box doesn't hold them, but its bounding sphere does
+            if (!bounds.box.rayHitsBoundingSphere(origin, direction)) {
+                continue;
+            }
+        } else if (!findRayAABoxEntryDistance(origin, direction, bounds.box, entry) || entry >= distance) {
+            continue;
         }
 
         if (!checkFilterSettings(entity, searchFilter) ||
             (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID())) ||
             (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID())) ) {
-            return;
+            continue;
         }
 
+        candidates.push_back({ entry, &bounds });
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& left, const Candidate& right) {
+        return left.entry < right.entry;
+    });
+
+    EntityItemID entityID;
+    for (const Candidate& candidate : candidates) {
+        if (candidate.entry >= distance) {
+            break;
+        }
+        const EntityItemPointer& entity = candidate.bounds->entity;
+
         // extents is the entity relative, scaled, centered extents of the entity
         glm::vec3 position = entity->getWorldPosition();
         glm::mat4 translation = glm::translate(position);
@@ -268,7 +347,7 @@ EntityItemID EntityTreeElement::evalDetailedRayIntersection(const glm::vec3& ori
                 }
             }
         }
-    });
+    }
     return entityID;
 }
 
@@ -716,6 +795,7 @@ void EntityTreeElement::cleanupDomainAndNonOwnedEntities() {
         _entityItems = savedEntities;
     });
     bumpChangedContent();
+    entityBoundsChanged();
 }
 
 void EntityTreeElement::cleanupEntities() {
@@ -731,6 +811,7 @@ void EntityTreeElement::cleanupEntities() {
         _entityItems.clear();
     });
     bumpChangedContent();
+    entityBoundsChanged();
 }
 
 bool EntityTreeElement::removeEntityItem(EntityItemPointer entity, bool deletion) {
@@ -746,6 +827,7 @@ bool EntityTreeElement::removeEntityItem(EntityItemPointer entity, bool deletion
         assert(entity->_element.get() == this);
         entity->_element = NULL;
         bumpChangedContent();
+        entityBoundsChanged();
         return true;
     }
     return false;
@@ -764,6 +846,7 @@ void EntityTreeElement::addEntityItem(EntityItemPointer entity) {
         _entityItems.push_back(entity);
     });
     bumpChangedContent();
+    entityBoundsChanged();
     entity->_element = getThisPointer();
 }
 
@@ -12,7 +12,9 @@
 #ifndef hifi_EntityTreeElement_h
 #define hifi_EntityTreeElement_h
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
 #include <OctreeElement.h>
 #include <QList>
@@ -156,6 +158,9 @@ public:
         float& parabolicDistance, BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
         const QVector<EntityItemID>& entityIdsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo);
 
+    /// Called when an entity of this element is added, removed, moved or resized, so that the next pick rebuilds the bounds
+    void entityBoundsChanged() { _entityBoundsVersion++; }
+
     template <typename F>
     void forEachEntity(F f) const {
         withReadLock([&] {
@@ -229,6 +234,21 @@ protected:
     virtual void init(unsigned char * octalCode) override;
     EntityTreePointer _myTree;
     EntityItems _entityItems;
+
+    // The world boxes of the entities, kept between picks so that a ray can cull the entities it misses without locking
+    // each of them. A pick takes the latest snapshot, and builds another if the entities have changed since.
+    struct EntityBounds {
+        AABox box;
+        EntityItemPointer entity;
+    };
+    struct EntityBoundsSnapshot {
+        uint32_t version { 0 };
+        std::vector<EntityBounds> bounds;
+    };
+    std::shared_ptr<const EntityBoundsSnapshot> getEntityBounds() const;
+
+    mutable std::shared_ptr<const EntityBoundsSnapshot> _entityBounds;
+    std::atomic<uint32_t> _entityBoundsVersion { 0 };
 };
 
 #endif // hifi_EntityTreeElement_h
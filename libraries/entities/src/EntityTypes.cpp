@@ -97,6 +97,43 @@ bool EntityTypes::registerEntityType(EntityType entityType, const char* name, En
     return false;
 }
 
+size_t EntityTypes::getEntityTypeSize(EntityType entityType) {
+    switch (entityType) {
+        case Box:
+        case Sphere:
+        case Shape:
+            return sizeof(ShapeEntityItem);
+        case Model:
+            return sizeof(ModelEntityItem);
+        case Text:
+            return sizeof(TextEntityItem);
+        case Image:
+            return sizeof(ImageEntityItem);
+        case Web:
+            return sizeof(WebEntityItem);
+        case ParticleEffect:
+            return sizeof(ParticleEffectEntityItem);
+        case Line:
+            return sizeof(LineEntityItem);
+        case PolyLine:
+            return sizeof(PolyLineEntityItem);
+        case PolyVox:
+            return sizeof(PolyVoxEntityItem);
+        case Grid:
+            return sizeof(GridEntityItem);
+        case Gizmo:
+            return sizeof(GizmoEntityItem);
+        case Light:
+            return sizeof(LightEntityItem);
+        case Zone:
+            return sizeof(ZoneEntityItem);
+        case Material:
+            return sizeof(MaterialEntityItem);
+        default:
+            return sizeof(EntityItem);
+    }
+}
+
 EntityItemPointer EntityTypes::constructEntityItem(EntityType entityType, const EntityItemID& entityID,
                                                     const EntityItemProperties& properties) {
     EntityItemPointer newEntityItem = NULL;
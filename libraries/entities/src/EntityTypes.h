@@ -115,6 +115,8 @@ public:
     static const QString& getEntityTypeName(EntityType entityType);
     static EntityTypes::EntityType getEntityTypeFromName(const QString& name);
     static bool registerEntityType(EntityType entityType, const char* name, EntityTypeFactory factoryMethod);
+    /// The size of the entity items of the type, without what they allocate, in bytes
+    static size_t getEntityTypeSize(EntityType entityType);
     static void extractEntityTypeAndID(const unsigned char* data, int dataLength, EntityTypes::EntityType& typeOut, QUuid& idOut);
     static EntityItemPointer constructEntityItem(EntityType entityType, const EntityItemID& entityID, const EntityItemProperties& properties);
     static EntityItemPointer constructEntityItem(const unsigned char* data, int bytesToRead);
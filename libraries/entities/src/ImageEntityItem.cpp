@@ -8,6 +8,8 @@
 
 #include "ImageEntityItem.h"
 
+#include <StringPool.h>
+
 #include "EntityItemProperties.h"
 
 EntityItemPointer ImageEntityItem::factory(const EntityItemID& entityID, const EntityItemProperties& properties) {
@@ -138,8 +140,16 @@ QString ImageEntityItem::getImageURL() const {
 
 void ImageEntityItem::setImageURL(const QString& url) {
     withWriteLock([&] {
-        _needsRenderUpdate |= _imageURL != url;
-        _imageURL = url;
+        if (_imageURL != url) {
+            _needsRenderUpdate = true;
+            _imageURL = StringPool::instance().intern(url);
+        }
+    });
+}
+
+size_t ImageEntityItem::getUnsharedStringBytes() const {
+    return EntityItem::getUnsharedStringBytes() + resultWithReadLock<size_t>([&] {
+        return StringPool::getUnsharedBytes(_imageURL);
     });
 }
 
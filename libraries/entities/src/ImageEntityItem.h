@@ -46,6 +46,8 @@ public:
     void setImageURL(const QString& imageUrl);
     QString getImageURL() const;
 
+    virtual size_t getUnsharedStringBytes() const override;
+
     void setEmissive(bool emissive);
     bool getEmissive() const;
 
@@ -8,6 +8,8 @@
 
 #include "MaterialEntityItem.h"
 
+#include <StringPool.h>
+
 #include "EntityItemProperties.h"
 
 #include "QJsonDocument"
@@ -144,8 +146,10 @@ QString MaterialEntityItem::getMaterialURL() const {
 
 void MaterialEntityItem::setMaterialURL(const QString& materialURL) {
     withWriteLock([&] {
-        _needsRenderUpdate |= _materialURL != materialURL;
-        _materialURL = materialURL;
+        if (_materialURL != materialURL) {
+            _needsRenderUpdate = true;
+            _materialURL = StringPool::instance().intern(materialURL);
+        }
     });
 }
 
@@ -157,8 +161,24 @@ QString MaterialEntityItem::getMaterialData() const {
 
 void MaterialEntityItem::setMaterialData(const QString& materialData) {
     withWriteLock([&] {
-        _needsRenderUpdate |= _materialData != materialData;
-        _materialData = materialData;
+        if (_materialData != materialData) {
+            _needsRenderUpdate = true;
+            ++_materialDataVersion;
+            _materialData = StringPool::instance().intern(materialData);
+        }
+    });
+}
+
+size_t MaterialEntityItem::getUnsharedStringBytes() const {
+    return EntityItem::getUnsharedStringBytes() + resultWithReadLock<size_t>([&] {
+        return StringPool::getUnsharedBytes(_materialURL) + StringPool::getUnsharedBytes(_materialData);
+    });
+}
+
+void MaterialEntityItem::getBlobPropertyVersions(PropertyVersions& versions) const {
+    EntityItem::getBlobPropertyVersions(versions);
+    withReadLock([&] {
+        versions.emplace_back(PROP_MATERIAL_DATA, _materialDataVersion);
     });
 }
 
@@ -51,6 +51,8 @@ public:
 
     QString getMaterialData() const;
     void setMaterialData(const QString& materialData);
+    virtual void getBlobPropertyVersions(PropertyVersions& versions) const override;
+    virtual size_t getUnsharedStringBytes() const override;
 
     MaterialMappingMode getMaterialMappingMode() const;
     void setMaterialMappingMode(MaterialMappingMode mode);
@@ -111,6 +113,7 @@ private:
     // How much to rotate this material within its parent's UV-space (degrees)
     float _materialMappingRot { 0 };
     QString _materialData;
+    uint32_t _materialDataVersion { 0 };
 
     bool _hasVertexShader { false };
 
@@ -17,6 +17,7 @@
 
 #include <ByteCountCoding.h>
 #include <GLMHelpers.h>
+#include <StringPool.h>
 
 #include "EntitiesLogging.h"
 #include "EntityItemProperties.h"
@@ -51,8 +52,16 @@ const QString ModelEntityItem::getTextures() const {
 
 void ModelEntityItem::setTextures(const QString& textures) {
     withWriteLock([&] {
-        _needsRenderUpdate |= _textures != textures;
-        _textures = textures;
+        if (_textures != textures) {
+            _needsRenderUpdate = true;
+            _textures = StringPool::instance().intern(textures);
+        }
+    });
+}
+
+size_t ModelEntityItem::getUnsharedStringBytes() const {
+    return EntityItem::getUnsharedStringBytes() + resultWithReadLock<size_t>([&] {
+        return StringPool::getUnsharedBytes(_modelURL) + StringPool::getUnsharedBytes(_textures);
     });
 }
 
@@ -299,7 +308,7 @@ ShapeType ModelEntityItem::getShapeType() const {
 void ModelEntityItem::setModelURL(const QString& url) {
     withWriteLock([&] {
         if (_modelURL != url) {
-            _modelURL = url;
+            _modelURL = StringPool::instance().intern(url);
             _needsRenderUpdate = true;
         }
     });
@@ -688,9 +697,15 @@ glm::vec3 ModelEntityItem::getModelScale() const {
 }
 
 void ModelEntityItem::setModelScale(const glm::vec3& modelScale) {
+    bool changed = false;
     withWriteLock([&] {
+        changed = _modelScale != modelScale;
         _modelScale = modelScale;
     });
+    if (changed) {
+        // the model scale is part of the world transform that the children are relative to
+        invalidateDescendantTransforms();
+    }
 }
 
 QString ModelEntityItem::getBlendshapeCoefficients() const {
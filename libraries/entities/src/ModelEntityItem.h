@@ -100,6 +100,8 @@ public:
     const QString getTextures() const;
     void setTextures(const QString& textures);
 
+    virtual size_t getUnsharedStringBytes() const override;
+
     virtual void setJointRotations(const QVector<glm::quat>& rotations);
     virtual void setJointRotationsSet(const QVector<bool>& rotationsSet);
     virtual void setJointTranslations(const QVector<glm::vec3>& translations);
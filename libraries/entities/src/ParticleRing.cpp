@@ -0,0 +1,92 @@
+//
+//  ParticleRing.cpp
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ParticleRing.h"
+
+#include <algorithm>
+
+template <typename T>
+static void reflow(std::vector<T>& array, size_t first, size_t count, size_t capacity) {
+    std::vector<T> reflowed(capacity);
+    size_t oldCapacity = array.size();
+    for (size_t i = 0; i < count; ++i) {
+        reflowed[i] = array[(first + i) % oldCapacity];
+    }
+    array.swap(reflowed);
+}
+
+void ParticleRing::setCapacity(size_t capacity) {
+    if (capacity == getCapacity()) {
+        return;
+    }
+
+    size_t count = std::min(_size, capacity);
+    size_t first = _size - count;
+    if (getCapacity() > 0) {
+        first = slot(first);
+    }
+    reflow(positions, first, count, capacity);
+    reflow(timesAndSeeds, first, count, capacity);
+    reflow(basePositions, first, count, capacity);
+    reflow(velocities, first, count, capacity);
+    reflow(accelerations, first, count, capacity);
+    reflow(_expirations, first, count, capacity);
+    _start = 0;
+    _size = count;
+}
+
+size_t ParticleRing::push(uint64_t expiration) {
+    size_t capacity = getCapacity();
+    if (capacity == 0) {
+        return (size_t)-1;
+    }
+
+    if (_size == capacity) {
+        _start = (_start + 1) % capacity;
+        --_size;
+    }
+    size_t index = slot(_size);
+    _expirations[index] = expiration;
+    ++_size;
+    return index;
+}
+
+size_t ParticleRing::cull(uint64_t time) {
+    size_t numCulled = 0;
+    while (_size > 0 && _expirations[_start] <= time) {
+        _start = (_start + 1) % getCapacity();
+        --_size;
+        ++numCulled;
+    }
+    return numCulled;
+}
+
+void ParticleRing::shiftEmissionTimes(float shift) {
+    // dead slots are shifted too, which keeps the loop free of the ring's wrap
+    glm::vec2* timesAndSeedsData = timesAndSeeds.data();
+    for (size_t i = 0, capacity = getCapacity(); i < capacity; ++i) {
+        timesAndSeedsData[i].x -= shift;
+    }
+}
+
+void ParticleRing::rebase(const glm::vec3& basePosition, bool keepWorldPositions) {
+    glm::vec3* positionsData = positions.data();
+    glm::vec3* basePositionsData = basePositions.data();
+    size_t capacity = getCapacity();
+    if (keepWorldPositions) {
+        for (size_t i = 0; i < capacity; ++i) {
+            positionsData[i] += basePositionsData[i] - basePosition;
+        }
+    }
+    for (size_t i = 0; i < capacity; ++i) {
+        basePositionsData[i] = basePosition;
+    }
+}
@@ -0,0 +1,65 @@
+//
+//  ParticleRing.h
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ParticleRing_h
+#define overte_ParticleRing_h
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Emission state of the live particles of an emitter, as one array per property.
+//
+// The particles of an emitter share one lifespan, so they expire oldest first and are kept in a ring: particle i,
+// counted from the oldest, lives at slot (start + i) % capacity of every array. The arrays are laid out the way
+// the renderer's per-instance buffers are, so new slots upload with a copy and the kernels over the whole ring
+// (moving the time epoch, rebasing positions) are plain loops over contiguous floats.
+class ParticleRing {
+public:
+    size_t getCapacity() const { return _expirations.size(); }
+    size_t getSize() const { return _size; }
+    size_t getStart() const { return _start; }
+    bool isEmpty() const { return _size == 0; }
+
+    /// Returns the slot of the particle i particles after the oldest
+    size_t slot(size_t i) const { return (_start + i) % getCapacity(); }
+
+    /// Resizes the ring, keeping the newest particles that fit and moving the oldest to slot 0
+    void setCapacity(size_t capacity);
+
+    /// Adds a particle that expires at expiration, dropping the oldest particle if the ring is full, and returns
+    /// its slot, or (size_t)-1 if the ring has no capacity
+    size_t push(uint64_t expiration);
+
+    /// Drops the oldest particles that expire at or before time, and returns how many were dropped
+    size_t cull(uint64_t time);
+
+    /// Moves the emission times of all particles shift seconds earlier
+    void shiftEmissionTimes(float shift);
+
+    /// Moves all particles to basePosition, keeping their world positions if they were relative to their own base
+    void rebase(const glm::vec3& basePosition, bool keepWorldPositions);
+
+    std::vector<glm::vec3> positions; // Emission point, relative to the base position
+    std::vector<glm::vec2> timesAndSeeds; // Emission time + seed
+    std::vector<glm::vec3> basePositions;
+    std::vector<glm::vec3> velocities;
+    std::vector<glm::vec3> accelerations;
+
+private:
+    std::vector<uint64_t> _expirations;
+    size_t _start { 0 };
+    size_t _size { 0 };
+};
+
+#endif // overte_ParticleRing_h
@@ -466,6 +466,7 @@ PulsePropertyGroup ShapeEntityItem::getPulseProperties() const {
 void ShapeEntityItem::setUserData(const QString& value) {
     withWriteLock([&] {
         _needsRenderUpdate |= _userData != value;
+        _userDataVersion += _userData != value;
         _userData = value;
     });
 }
\ No newline at end of file
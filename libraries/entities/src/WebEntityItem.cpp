@@ -18,6 +18,7 @@
 #include <GeometryUtil.h>
 #include <shared/LocalFileAccessGate.h>
 #include <NetworkingConstants.h>
+#include <StringPool.h>
 
 #include "EntitiesLogging.h"
 #include "EntityItemProperties.h"
@@ -197,8 +198,16 @@ float WebEntityItem::getAlpha() const {
 
 void WebEntityItem::setSourceUrl(const QString& value) {
     withWriteLock([&] {
-        _needsRenderUpdate |= _sourceUrl != value;
-        _sourceUrl = value;
+        if (_sourceUrl != value) {
+            _needsRenderUpdate = true;
+            _sourceUrl = StringPool::instance().intern(value);
+        }
+    });
+}
+
+size_t WebEntityItem::getUnsharedStringBytes() const {
+    return EntityItem::getUnsharedStringBytes() + resultWithReadLock<size_t>([&] {
+        return StringPool::getUnsharedBytes(_sourceUrl);
     });
 }
 
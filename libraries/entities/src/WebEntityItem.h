@@ -57,6 +57,8 @@ public:
     void setSourceUrl(const QString& value);
     QString getSourceUrl() const;
 
+    virtual size_t getUnsharedStringBytes() const override;
+
     void setDPI(uint16_t value);
     uint16_t getDPI() const;
 
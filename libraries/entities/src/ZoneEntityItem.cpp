@@ -456,6 +456,7 @@ uint32_t ZoneEntityItem::getSkyboxMode() const {
 void ZoneEntityItem::setUserData(const QString& value) {
     withWriteLock([&] {
         _needsRenderUpdate |= _userData != value;
+        _userDataVersion += _userData != value;
         _userData = value;
     });
 }
@@ -269,11 +269,13 @@ bool GLBackend::availableMemoryKnown() {
 GLBackend::GLBackend(bool syncCache) {
     _pipeline._cameraCorrectionBuffer._buffer->flush();
     initShaderBinaryCache();
+    initParallelShaderCompile();
 }
 
 GLBackend::GLBackend() {
     _pipeline._cameraCorrectionBuffer._buffer->flush();
     initShaderBinaryCache();
+    initParallelShaderCompile();
 }
 
 GLBackend::~GLBackend() {}
@@ -396,6 +398,9 @@ void GLBackend::renderPassDraw(const Batch& batch) {
 #endif 
                 // updates for draw calls
                 ++_currentDraw;
+                if (_pipeline._isLinking) {
+                    break;
+                }
                 updateInput();
                 updateTransform(batch);
                 updatePipeline();
@@ -990,6 +995,7 @@ void GLBackend::setCameraCorrection(const Mat4& correction, const Mat4& prevRend
     _pipeline._cameraCorrectionBuffer._buffer->flush();
 }
 
-void GLBackend::syncProgram(const gpu::ShaderPointer& program) {
-    gpu::gl::GLShader::sync(*this, *program);
+bool GLBackend::syncProgram(const gpu::ShaderPointer& program) {
+    auto object = gpu::gl::GLShader::sync(*this, *program);
+    return !object || !object->isPending();
 }
@@ -130,7 +130,7 @@ public:
     // Let's try to avoid to do that as much as possible!
     void syncCache() final override;
 
-    void syncProgram(const gpu::ShaderPointer& program) override;
+    bool syncProgram(const gpu::ShaderPointer& program) override;
 
     // This is the ugly "download the pixels to sysmem for taking a snapshot"
     // Just avoid using it, it's ugly and will break performances
@@ -376,7 +376,7 @@ protected:
     } _input;
 
     virtual void initTransform() = 0;
-    void killTransform();
+    virtual void killTransform();
     // Synchronize the state cache of this Backend with the actual real state of the GL Context
     void syncTransformStateCache();
     virtual void updateTransform(const Batch& batch) = 0;
@@ -422,6 +422,9 @@ protected:
         GLuint _drawCallInfoBuffer{ 0 };
         GLuint _objectBufferTexture{ 0 };
         size_t _cameraUboSize{ 0 };
+        // The buffer and base offset the backend streamed the cameras of the batch to, if not the camera buffer
+        mutable GLuint _streamedCameraBuffer{ 0 };
+        mutable size_t _streamedCameraOffset{ 0 };
         bool _viewIsCamera{ false };
         bool _skybox{ false };
         Transform _view;
@@ -521,6 +524,8 @@ protected:
         bool _cameraCorrection{ false };
         GLShader* _programShader{ nullptr };
         bool _invalidProgram{ false };
+        // the program of the current pipeline is linking in the background, its draws are skipped
+        bool _isLinking{ false };
 
         BufferView _cameraCorrectionBuffer{ gpu::BufferView(std::make_shared<gpu::Buffer>(sizeof(CameraCorrection), nullptr)) };
         BufferView _cameraCorrectionBufferIdentity{ gpu::BufferView(
@@ -543,6 +548,10 @@ protected:
     virtual void postLinkProgram(ShaderObject& programObject, const Shader& program) const;
     virtual GLShader* compileBackendProgram(const Shader& program, const Shader::CompilationHandler& handler);
     virtual GLShader* compileBackendShader(const Shader& shader, const Shader::CompilationHandler& handler);
+    // With KHR_parallel_shader_compile, the programs are compiled and linked by the driver in the background: the program
+    // object is pending until finishBackendProgram finds it linked, and returns null if it failed to
+    GLShader* startBackendProgram(const Shader& program);
+    GLShader* finishBackendProgram(GLShader& object, const Shader& program);
 
     // For a program, this will return a string containing all the source files (without any 
     // backend headers or defines).  For a vertex, fragment or geometry shader, this will 
@@ -591,6 +600,9 @@ protected:
     virtual void initShaderBinaryCache();
     virtual void killShaderBinaryCache();
 
+    void initParallelShaderCompile();
+    bool _parallelShaderCompile { false };
+
     struct TextureManagementStageState {
         bool _sparseCapable{ false };
         GLTextureTransferEnginePointer _transferEngine;
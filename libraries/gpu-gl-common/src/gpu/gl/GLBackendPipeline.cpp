@@ -43,11 +43,16 @@ void GLBackend::do_setPipeline(const Batch& batch, size_t paramOffset) {
 
         _pipeline._state = nullptr;
         _pipeline._invalidState = true;
+        _pipeline._isLinking = false;
     } else {
         auto pipelineObject = GLPipeline::sync(*this, *pipeline);
         if (!pipelineObject) {
+            // Nothing is drawn with a pipeline whose program is linking in the background, rather than drawing with the
+            // previous pipeline, and it's synced again the next time it's set
+            _pipeline._isLinking = !pipeline->getProgram()->compilationHasFailed();
             return;
         }
+        _pipeline._isLinking = false;
 
             // check the program cache
             // pick the program version
@@ -134,6 +139,7 @@ void GLBackend::resetPipelineStage() {
     _pipeline._invalidProgram = false;
     _pipeline._program = 0;
     _pipeline._programShader = nullptr;
+    _pipeline._isLinking = false;
     reset(_pipeline._pipeline);
     glUseProgram(0);
 }
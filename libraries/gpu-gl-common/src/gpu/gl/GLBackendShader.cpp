@@ -6,7 +6,13 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 #include "GLBackend.h"
+
+#include <algorithm>
+
+#include <SharedUtil.h>
+
 #include "GLShader.h"
+#include <gl/GLHelpers.h>
 #include <gl/GLShaders.h>
 
 using namespace gpu;
@@ -88,11 +94,30 @@ GLShader* GLBackend::compileBackendShader(const Shader& shader, const Shader::Co
 
 std::atomic<size_t> gpuBinaryShadersLoaded;
 
+// From KHR_parallel_shader_compile, which glad doesn't load: the completion status is all that's needed, the driver picks
+// how many threads compile the shaders as long as the application doesn't set it
+static const GLenum COMPLETION_STATUS_KHR = 0x91B1;
+
+void GLBackend::initParallelShaderCompile() {
+    ::gl::ContextInfo contextInfo;
+    contextInfo.init();
+    const auto& extensions = contextInfo.extensions;
+    _parallelShaderCompile =
+        std::find(extensions.begin(), extensions.end(), "GL_KHR_parallel_shader_compile") != extensions.end() ||
+        std::find(extensions.begin(), extensions.end(), "GL_ARB_parallel_shader_compile") != extensions.end();
+}
+
 GLShader* GLBackend::compileBackendProgram(const Shader& program, const Shader::CompilationHandler& handler) {
     if (!program.isProgram()) {
         return nullptr;
     }
 
+    // The handlers change the sources of the shaders that fail to compile, so they are compiled synchronously
+    if (_parallelShaderCompile && !handler) {
+        return startBackendProgram(program);
+    }
+
+    auto compilationStart = usecTimestampNow();
     GLShader::ShaderObjects programObjects;
     program.incrementCompilationAttempt();
     const auto& variants = shader::allVariants();
@@ -174,6 +199,7 @@ GLShader* GLBackend::compileBackendProgram(const Shader& program, const Shader::
     }
     // Compilation feedback
     program.setCompilationLogs(compilationLogs);
+    program.setCompiled(usecTimestampNow() - compilationStart);
 
     // So far so good, the program versions have all been created successfully
     GLShader* object = new GLShader(this->shared_from_this());
@@ -181,6 +207,138 @@ GLShader* GLBackend::compileBackendProgram(const Shader& program, const Shader::
     return object;
 }
 
+GLShader* GLBackend::startBackendProgram(const Shader& program) {
+    program.incrementCompilationAttempt();
+    const auto& variants = shader::allVariants();
+
+    GLShader* object = new GLShader(this->shared_from_this());
+    object->_compilationStart = usecTimestampNow();
+    for (const auto& variant : variants) {
+        auto index = static_cast<uint32_t>(variant);
+        auto& programObject = object->_shaderObjects[index];
+        auto& pendingProgram = object->_pendingPrograms[index];
+        pendingProgram.source = getShaderSource(program, variant);
+        pendingProgram.hash = ::gl::getShaderHash(pendingProgram.source);
+
+        CachedShader cachedBinary;
+        {
+            Lock shaderCacheLock{ _shaderBinaryCache._mutex };
+            auto itr = _shaderBinaryCache._binaries.find(pendingProgram.hash);
+            if (itr != _shaderBinaryCache._binaries.end()) {
+                cachedBinary = itr->second;
+            }
+        }
+        if (cachedBinary) {
+            programObject.glprogram = ::gl::buildProgram(cachedBinary);
+            if (0 != programObject.glprogram) {
+                ++gpuBinaryShadersLoaded;
+                postLinkProgram(programObject, program);
+                continue;
+            }
+            Lock shaderCacheLock{ _shaderBinaryCache._mutex };
+            _shaderBinaryCache._binaries.erase(pendingProgram.hash);
+        }
+
+        // The shaders that aren't compiled yet are compiled for this program only, so that nothing waits for them
+        std::vector<GLuint> shaderGLObjects;
+        shaderGLObjects.reserve(program.getShaders().size());
+        for (const auto& subShader : program.getShaders()) {
+            GLShader* subObject = Backend::getGPUObject<GLShader>(*subShader);
+            if (subObject) {
+                shaderGLObjects.push_back(subObject->_shaderObjects[index].glshader);
+                continue;
+            }
+            GLuint glshader = glCreateShader(SHADER_DOMAINS[subShader->getType()]);
+            auto shaderSource = getShaderSource(*subShader, variant);
+            const GLchar* shaderSourceString = shaderSource.c_str();
+            glShaderSource(glshader, 1, &shaderSourceString, nullptr);
+            glCompileShader(glshader);
+            pendingProgram.shaders.push_back(glshader);
+            shaderGLObjects.push_back(glshader);
+        }
+
+        programObject.glprogram = ::gl::buildProgram(shaderGLObjects);
+        if (0 == programObject.glprogram) {
+            delete object;
+            return nullptr;
+        }
+        glLinkProgram(programObject.glprogram);
+        pendingProgram.linking = true;
+        object->_isPending = true;
+    }
+
+    if (!object->_isPending) {
+        // all the variants were in the binary cache
+        Shader::CompilationLogs compilationLogs(variants.size());
+        for (auto& compilationLog : compilationLogs) {
+            compilationLog.compiled = true;
+        }
+        program.setCompilationLogs(compilationLogs);
+        program.setCompiled(usecTimestampNow() - object->_compilationStart);
+    }
+    return object;
+}
+
+GLShader* GLBackend::finishBackendProgram(GLShader& object, const Shader& program) {
+    for (uint32_t index = 0; index < shader::NUM_VARIANTS; index++) {
+        if (object._pendingPrograms[index].linking) {
+            GLint completed = 0;
+            glGetProgramiv(object._shaderObjects[index].glprogram, COMPLETION_STATUS_KHR, &completed);
+            if (!completed) {
+                return &object;
+            }
+        }
+    }
+
+    PROFILE_RANGE(render, "/GLBackend::finishBackendProgram");
+    Shader::CompilationLogs compilationLogs(shader::NUM_VARIANTS);
+    bool linked = true;
+    for (uint32_t index = 0; index < shader::NUM_VARIANTS; index++) {
+        auto& programObject = object._shaderObjects[index];
+        auto& pendingProgram = object._pendingPrograms[index];
+        auto& compilationLog = compilationLogs[index];
+        compilationLog.compiled = true;
+        if (pendingProgram.linking) {
+            pendingProgram.linking = false;
+            GLint status = 0;
+            glGetProgramiv(programObject.glprogram, GL_LINK_STATUS, &status);
+            ::gl::getProgramInfoLog(programObject.glprogram, compilationLog.message);
+            if (!status) {
+                // the shaders that failed to compile say why
+                for (auto glshader : pendingProgram.shaders) {
+                    std::string shaderMessage;
+                    ::gl::getShaderInfoLog(glshader, shaderMessage);
+                    compilationLog.message += shaderMessage;
+                }
+                qCWarning(gpugllogging) << "GLBackend::finishBackendProgram - Program didn't link:\n" << compilationLog.message.c_str();
+                compilationLog.compiled = false;
+                linked = false;
+            } else {
+                CachedShader cachedBinary;
+                ::gl::getProgramBinary(programObject.glprogram, cachedBinary);
+                cachedBinary.source = pendingProgram.source;
+                {
+                    Lock shaderCacheLock{ _shaderBinaryCache._mutex };
+                    _shaderBinaryCache._binaries[pendingProgram.hash] = cachedBinary;
+                }
+                postLinkProgram(programObject, program);
+            }
+        }
+        for (auto glshader : pendingProgram.shaders) {
+            releaseShader(glshader);
+        }
+        pendingProgram = GLShader::PendingProgram();
+    }
+    object._isPending = false;
+    program.setCompilationLogs(compilationLogs);
+    if (linked) {
+        // the time until the program was found to be linked, which is how long its users waited for it
+        program.setCompiled(usecTimestampNow() - object._compilationStart);
+    }
+
+    return linked ? &object : nullptr;
+}
+
 static const GLint INVALID_UNIFORM_INDEX = -1;
 
 GLint GLBackend::getRealUniformLocation(GLint location) const {
@@ -36,6 +36,10 @@ GLPipeline* GLPipeline::sync(GLBackend& backend, const Pipeline& pipeline) {
         shader->setCompilationHasFailed(true);
         return nullptr;
     }
+    // The pipeline object is made once the program is linked
+    if (programObject->isPending()) {
+        return nullptr;
+    }
 
     const auto& state = pipeline.getState();
     GLState* stateObject = GLState::sync(*state);
@@ -17,8 +17,8 @@ GLShader::GLShader(const std::weak_ptr<GLBackend>& backend) : _backend(backend)
 }
 
 GLShader::~GLShader() {
+    auto backend = _backend.lock();
     for (auto& so : _shaderObjects) {
-        auto backend = _backend.lock();
         if (backend) {
             if (so.glshader != 0) {
                 backend->releaseShader(so.glshader);
@@ -28,13 +28,26 @@ GLShader::~GLShader() {
             }
         }
     }
+    for (auto& pendingProgram : _pendingPrograms) {
+        if (backend) {
+            for (auto glshader : pendingProgram.shaders) {
+                backend->releaseShader(glshader);
+            }
+        }
+    }
 }
 
 GLShader* GLShader::sync(GLBackend& backend, const Shader& shader, const Shader::CompilationHandler& handler) {
     GLShader* object = Backend::getGPUObject<GLShader>(shader);
 
-    // If GPU object already created then good
+    // If GPU object already created then good, unless it's a program that is still linking
     if (object) {
+        if (object->isPending()) {
+            object = backend.finishBackendProgram(*object, shader);
+            if (!object) {
+                Backend::setGPUObject(shader, object);
+            }
+        }
         return object;
     }
     PROFILE_RANGE(render, "/GLShader::sync");
@@ -53,7 +66,10 @@ GLShader* GLShader::sync(GLBackend& backend, const Shader& shader, const Shader:
         }
     }
 
-    glFinish();
+    // the programs that are linking in the background don't hold up the frame
+    if (!object || !object->isPending()) {
+        glFinish();
+    }
     return object;
 }
 
@@ -46,6 +46,22 @@ public:
 
     ShaderObjects _shaderObjects;
 
+    // The state of the variants of a program that the driver compiles and links in the background
+    struct PendingProgram {
+        // the shaders that were compiled for this program only, released once it's linked
+        std::vector<GLuint> shaders;
+        std::string hash;
+        std::string source;
+        bool linking { false };
+    };
+    using PendingPrograms = std::array<PendingProgram, shader::NUM_VARIANTS>;
+    PendingPrograms _pendingPrograms;
+    bool _isPending { false };
+    uint64_t _compilationStart { 0 };
+
+    // true while the program is linking, and can't be used yet
+    bool isPending() const { return _isPending; }
+
     GLuint getProgram(shader::Variant version = shader::Variant::Mono) const {
         return _shaderObjects[static_cast<uint32_t>(version)].glprogram;
     }
@@ -213,12 +213,42 @@ void GLVariableAllocationSupport::decrementPopulatedSize(Size delta) const {
     }
 }
 
+void GLVariableAllocationSupport::updateScreenSize(const Texture& texture) {
+    // decay slowly so a texture keeps its detail while it is briefly hidden
+    static const float SCREEN_SIZE_DECAY = 0.98f;
+    _screenSize = std::max((float)texture.takeScreenSize(), _screenSize * SCREEN_SIZE_DECAY);
+    if (_screenSize < 1.0f) {
+        _screenSize = 0.0f;
+        _desiredMip = _maxAllocatedMip;
+        return;
+    }
+    float maxDimension = (float)std::max(texture.getWidth(), texture.getHeight());
+    float mip = floorf(log2f(std::max(maxDimension / _screenSize, 1.0f)));
+    _desiredMip = (uint16)glm::clamp((int)mip, (int)_minAllocatedMip, (int)_maxAllocatedMip);
+}
+
 void GLVariableAllocationSupport::sanityCheck() const {
     if (_populatedMip < _allocatedMip) {
         qCWarning(gpugllogging) << "Invalid mip levels";
     }
 }
 
+// Mip data mapped from the KTX cache is paged in on first access, so touch each page while buffering to keep the
+// disk reads off the thread that uploads it
+static void pageInMipData(const storage::StoragePointer& mipData) {
+    static const size_t PAGE_SIZE = 4096;
+    const volatile uint8_t* bytes = mipData->data();
+    size_t size = mipData->size();
+    uint8_t sum = 0;
+    for (size_t offset = 0; offset < size; offset += PAGE_SIZE) {
+        sum += bytes[offset];
+    }
+    if (size > 0) {
+        sum += bytes[size - 1];
+    }
+    (void)sum;
+}
+
 TransferJob::TransferJob(const Texture& texture,
     uint16_t sourceMip,
     uint16_t targetMip,
@@ -255,6 +285,9 @@ TransferJob::TransferJob(const Texture& texture,
         auto mipStorage = texture->accessStoredMipFace(sourceMip, face);
         if (mipStorage) {
             _mipData = mipStorage->createView(_transferSize, _transferOffset);
+            if (_mipData) {
+                pageInMipData(_mipData);
+            }
         } else {
             qCWarning(gpugllogging) << "Buffering failed because mip could not be retrieved from texture "
                 << texture->source().c_str();
@@ -102,6 +102,12 @@ public:
 
     void sanityCheck() const;
     uint16 populatedMip() const { return _populatedMip; }
+    uint16 allocatedMip() const { return _allocatedMip; }
+    // The mip that matches the largest screen size the texture was drawn at recently
+    uint16 desiredMip() const { return _desiredMip; }
+    bool isOnScreen() const { return _screenSize > 0.0f; }
+    // Folds in the screen size reported by the renderer since the last call, and updates the desired mip
+    void updateScreenSize(const Texture& texture);
     bool canPromote() const { return _allocatedMip > _minAllocatedMip; }
     bool canDemote() const { return _allocatedMip < _maxAllocatedMip; }
     bool hasPendingTransfers() const { return _populatedMip > _allocatedMip; }
@@ -136,6 +142,9 @@ protected:
     // The lowest (highest resolution) mip that we will support, relative to the number
     // of mips in the gpu::Texture object
     uint16 _minAllocatedMip { 0 };
+    // The largest screen size in pixels the texture was drawn at, decaying every frame it is not drawn larger
+    float _screenSize { 0.0f };
+    uint16 _desiredMip { 0 };
 };
 
 class GLTexture : public GLObject<Texture> {
@@ -8,6 +8,8 @@
 
 #include "GLTexture.h"
 
+#include <algorithm>
+
 #include <QObject>
 #include <QtCore/QThread>
 #include <NumericalConstants.h>
@@ -54,6 +56,12 @@ using ImmediateWorkQueue = std::priority_queue<ImmediateQueuePair, std::vector<I
 // A map of weak texture pointers to queues of work to be done to transfer their data from the backing store to the GPU
 using TransferMap = std::map<TextureWeakPointer, TransferQueue, std::owner_less<TextureWeakPointer>>;
 
+// Promote the textures furthest from the detail their screen size calls for first, then the smallest
+static float evalPromotePriority(const GLTexture* gltexture, const GLVariableAllocationSupport* vartexture) {
+    float mipDeficit = (float)vartexture->allocatedMip() - (float)vartexture->desiredMip();
+    return mipDeficit + 1.0f / (1.0f + (float)gltexture->size());
+}
+
 class GLTextureTransferEngineDefault : public GLTextureTransferEngine {
     using Parent = GLTextureTransferEngine;
 
@@ -216,10 +224,15 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
     bool canDemote = false;
     bool canPromote = false;
     bool hasTransfers = false;
+    size_t underDetailedCount = 0;
     for (const auto& texture : strongTextures) {
         GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
         GLVariableAllocationSupport* vartexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
         vartexture->sanityCheck();
+        vartexture->updateScreenSize(*texture);
+        if (vartexture->isOnScreen() && vartexture->populatedMip() > vartexture->desiredMip()) {
+            ++underDetailedCount;
+        }
 
         // Track how much the texture thinks it should be using
         idealMemoryAllocation += texture->evalTotalSize();
@@ -237,6 +250,7 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
     }
 
     Backend::textureResourceIdealGPUMemSize.set(idealMemoryAllocation);
+    Backend::textureResourceUnderDetailedCount.set(underDetailedCount);
     size_t unallocated = idealMemoryAllocation - totalVariableMemoryAllocation;
     float pressure = 0;
 
@@ -290,8 +304,7 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
             GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
             GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
             if (MemoryPressureState::Undersubscribed == _memoryPressureState && vargltexture->canPromote()) {
-                // Promote smallest first
-                _promoteQueue.push({ texture, 1.0f / (float)gltexture->size() });
+                _promoteQueue.push({ texture, evalPromotePriority(gltexture, vargltexture) });
             } else if (MemoryPressureState::Transfer == _memoryPressureState && vargltexture->hasPendingTransfers()) {
                 populateTransferQueue(texture);
             }
@@ -366,9 +379,13 @@ void GLTextureTransferEngineDefault::populateActiveBufferQueue() {
     ActiveTransferQueue newBufferJobs;
     size_t newTransferSize{ 0 };
 
+    // Buffer for the textures furthest from the detail their screen size calls for first
+    using PendingTransfer = std::pair<TexturePointer, TransferMap::iterator>;
+    std::vector<std::pair<PendingTransfer, int>> pendingTransfers;
+    pendingTransfers.reserve(_pendingTransfersMap.size());
     for (auto itr = _pendingTransfersMap.begin(); itr != _pendingTransfersMap.end();) {
         const auto& weakTexture = itr->first;
-        const auto texture = weakTexture.lock();
+        auto texture = weakTexture.lock();
 
         // Texture no longer exists, remove from the transfer map and move on
         if (!texture) {
@@ -376,6 +393,19 @@ void GLTextureTransferEngineDefault::populateActiveBufferQueue() {
             continue;
         }
 
+        GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
+        GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
+        int mipDeficit = (int)vargltexture->populatedMip() - (int)vargltexture->desiredMip();
+        pendingTransfers.push_back({ { texture, itr }, mipDeficit });
+        ++itr;
+    }
+    std::stable_sort(pendingTransfers.begin(), pendingTransfers.end(), [](const std::pair<PendingTransfer, int>& a, const std::pair<PendingTransfer, int>& b) {
+        return a.second > b.second;
+    });
+
+    for (const auto& pendingTransfer : pendingTransfers) {
+        const auto& texture = pendingTransfer.first.first;
+        auto itr = pendingTransfer.first.second;
         GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
         GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
 
@@ -385,7 +415,7 @@ void GLTextureTransferEngineDefault::populateActiveBufferQueue() {
             if (vargltexture->hasPendingTransfers()) {
                 // qWarning(gpugllogging) << "Texture " << gltexture->_id << "(" << texture->source().c_str() << ") has no transfer jobs, but has pending transfers" ;
             }
-            itr = _pendingTransfersMap.erase(itr);
+            _pendingTransfersMap.erase(itr);
             continue;
         }
 
@@ -402,7 +432,6 @@ void GLTextureTransferEngineDefault::populateActiveBufferQueue() {
         Q_ASSERT(newTransferSize <= MAX_BUFFER_SIZE);
         newBufferJobs.emplace_back(texture, transferJob);
         textureTransferQueue.pop();
-        ++itr;
     }
 
     {
@@ -484,8 +513,7 @@ void GLTextureTransferEngineDefault::processPromotes() {
         vartexture->promote();
         auto allocationDelta = gltexture->size() - originalSize;
         if (vartexture->canPromote()) {
-            // Promote smallest first
-            _promoteQueue.push({ texture, 1.0f / (float)gltexture->size() });
+            _promoteQueue.push({ texture, evalPromotePriority(gltexture, vartexture) });
         }
         allocatedBytes += allocationDelta;
         if (++allocations >= MAX_ALLOCATIONS_PER_FRAME) {
@@ -504,16 +532,26 @@ void GLTextureTransferEngineDefault::processPromotes() {
 }
 
 void GLTextureTransferEngineDefault::processDemotes(size_t reliefRequired, const std::vector<TexturePointer>& strongTextures) {
-    // Demote largest first
-    ImmediateWorkQueue demoteQueue;
+    std::vector<TexturePointer> candidates;
+    Size largestSize = 0;
     for (const auto& texture : strongTextures) {
         GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
         GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
         if (!gltexture->_gpuObject.getImportant() && vargltexture->canDemote()) {
-            demoteQueue.push({ texture, (float)gltexture->size() });
+            candidates.push_back(texture);
+            largestSize = std::max(largestSize, gltexture->size());
         }
     }
 
+    // Demote the textures with the most detail their screen size doesn't need first, then the largest
+    ImmediateWorkQueue demoteQueue;
+    for (const auto& texture : candidates) {
+        GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
+        GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
+        float mipSurplus = (float)vargltexture->desiredMip() - (float)vargltexture->allocatedMip();
+        demoteQueue.push({ texture, mipSurplus + (float)gltexture->size() / (float)(largestSize + 1) });
+    }
+
     size_t relieved = 0;
     while (!demoteQueue.empty() && relieved < reliefRequired) {
         {
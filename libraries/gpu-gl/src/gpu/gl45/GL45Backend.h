@@ -263,8 +263,44 @@ protected:
     // Synchronize the state cache of this Backend with the actual real state of the GL Context
     void transferTransformState(const Batch& batch) const override;
     void initTransform() override;
+    void killTransform() override;
     void updateTransform(const Batch& batch) override;
 
+    // The per frame transform data, cameras, objects and draw call infos, are written to a persistently and
+    // coherently mapped buffer split in one region per frame in flight. A region is fenced when its frame is
+    // recycled and waited on before it is written again, so streaming needs no driver copy nor orphaning.
+    class TransformStreamRing {
+    public:
+        static const int NUM_FRAMES { 3 };
+        static const GLsizeiptr INITIAL_FRAME_SIZE { 2 * 1024 * 1024 };
+        static const GLintptr INVALID_OFFSET { -1 };
+
+        void allocate(GLsizeiptr frameSize, GLintptr alignment);
+        void release();
+
+        // Copies size bytes of data to the region of the frame and returns their offset in the buffer, or
+        // INVALID_OFFSET if the region is full and the data must be uploaded otherwise this frame
+        GLintptr write(const void* data, GLsizeiptr size);
+
+        // Fences the region of the frame and moves to the next one, growing the ring if the frame overflowed
+        void endFrame();
+
+        GLuint getBuffer() const { return _buffer; }
+
+    private:
+        GLuint _buffer { 0 };
+        uint8_t* _mapped { nullptr };
+        GLsizeiptr _frameSize { 0 };
+        GLintptr _alignment { 1 };
+        GLsync _fences[NUM_FRAMES] { 0, 0, 0 };
+        int _frame { 0 };
+        GLintptr _head { 0 };
+        GLsizeiptr _requested { 0 };
+        bool _regionReady { false };
+    };
+    mutable TransformStreamRing _transformRing;
+    mutable GLuint _drawCallInfoStreamBuffer { 0 };
+
     // Resource Stage
     bool bindResourceBuffer(uint32_t slot, const BufferPointer& buffer) override;
     void releaseResourceBuffer(uint32_t slot) override;
@@ -10,15 +10,103 @@
 //
 #include "GL45Backend.h"
 
+#include <string.h>
+
+#include <algorithm>
+
 using namespace gpu;
 using namespace gpu::gl45;
 
+void GL45Backend::TransformStreamRing::allocate(GLsizeiptr frameSize, GLintptr alignment) {
+    release();
+    _alignment = alignment;
+    _frameSize = ((frameSize + alignment - 1) / alignment) * alignment;
+    _frame = 0;
+    _head = 0;
+    _requested = 0;
+    _regionReady = false;
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glCreateBuffers(1, &_buffer);
+    glNamedBufferStorage(_buffer, _frameSize * NUM_FRAMES, nullptr, flags);
+    _mapped = (uint8_t*)glMapNamedBufferRange(_buffer, 0, _frameSize * NUM_FRAMES, flags);
+    if (!_mapped) {
+        qCWarning(gpugl45logging) << "Failed to map the transform stream ring, transforms are uploaded per batch";
+        glDeleteBuffers(1, &_buffer);
+        _buffer = 0;
+    }
+    (void)CHECK_GL_ERROR();
+}
+
+void GL45Backend::TransformStreamRing::release() {
+    for (auto& fence : _fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = 0;
+        }
+    }
+    if (_buffer) {
+        // the frames in flight may still read the buffer, the driver keeps it alive until they are done
+        glUnmapNamedBuffer(_buffer);
+        glDeleteBuffers(1, &_buffer);
+        _buffer = 0;
+    }
+    _mapped = nullptr;
+}
+
+GLintptr GL45Backend::TransformStreamRing::write(const void* data, GLsizeiptr size) {
+    GLsizeiptr alignedSize = ((size + _alignment - 1) / _alignment) * _alignment;
+    _requested += alignedSize;
+    if (!_mapped || _head + size > _frameSize) {
+        return INVALID_OFFSET;
+    }
+
+    if (!_regionReady) {
+        // the region was last written NUM_FRAMES frames ago, which the GPU has most likely consumed already
+        auto& fence = _fences[_frame];
+        if (fence) {
+            static const GLuint64 WAIT_TIMEOUT_NS = 1000000;
+            GLenum result;
+            do {
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, WAIT_TIMEOUT_NS);
+            } while (result == GL_TIMEOUT_EXPIRED);
+            glDeleteSync(fence);
+            fence = 0;
+        }
+        _regionReady = true;
+    }
+
+    GLintptr offset = _frame * _frameSize + _head;
+    memcpy(_mapped + offset, data, size);
+    _head += alignedSize;
+    return offset;
+}
+
+void GL45Backend::TransformStreamRing::endFrame() {
+    if (!_buffer) {
+        return;
+    }
+
+    if (_regionReady) {
+        _fences[_frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    if (_requested > _frameSize) {
+        allocate(std::max(_requested, 2 * _frameSize), _alignment);
+        return;
+    }
+    _frame = (_frame + 1) % NUM_FRAMES;
+    _head = 0;
+    _requested = 0;
+    _regionReady = false;
+}
+
 void GL45Backend::initTransform() {
     GLuint transformBuffers[3];
     glCreateBuffers(3, transformBuffers);
     _transform._objectBuffer = transformBuffers[0];
     _transform._cameraBuffer = transformBuffers[1];
     _transform._drawCallInfoBuffer = transformBuffers[2];
+    _drawCallInfoStreamBuffer = _transform._drawCallInfoBuffer;
 #ifdef GPU_SSBO_TRANSFORM_OBJECT
 #else
     glCreateTextures(GL_TEXTURE_BUFFER, 1, &_transform._objectBufferTexture);
@@ -27,21 +115,50 @@ void GL45Backend::initTransform() {
     while (_transform._cameraUboSize < cameraSize) {
         _transform._cameraUboSize += UNIFORM_BUFFER_OFFSET_ALIGNMENT;
     }
+
+    // the ring holds every kind of transform data, so its offsets satisfy all of their alignments
+    GLint storageAlignment = 1;
+    GLint textureAlignment = 1;
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+    glGetIntegerv(GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT, &textureAlignment);
+    GLint alignment = std::max({ UNIFORM_BUFFER_OFFSET_ALIGNMENT, storageAlignment, textureAlignment, 1 });
+    _transformRing.allocate(TransformStreamRing::INITIAL_FRAME_SIZE, alignment);
+}
+
+void GL45Backend::killTransform() {
+    _transformRing.release();
+    Parent::killTransform();
 }
 
 void GL45Backend::transferTransformState(const Batch& batch) const {
     // FIXME not thread safe
     static std::vector<uint8_t> bufferData;
+    _transform._streamedCameraBuffer = 0;
     if (!_transform._cameras.empty()) {
         bufferData.resize(_transform._cameraUboSize * _transform._cameras.size());
         for (size_t i = 0; i < _transform._cameras.size(); ++i) {
             memcpy(bufferData.data() + (_transform._cameraUboSize * i), &_transform._cameras[i], sizeof(TransformStageState::CameraBufferElement));
         }
-        glNamedBufferData(_transform._cameraBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
+        GLintptr offset = _transformRing.write(bufferData.data(), bufferData.size());
+        if (offset != TransformStreamRing::INVALID_OFFSET) {
+            _transform._streamedCameraBuffer = _transformRing.getBuffer();
+            _transform._streamedCameraOffset = offset;
+        } else {
+            glNamedBufferData(_transform._cameraBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
+        }
     }
 
-    if (!batch._objects.empty()) {
-        glNamedBufferData(_transform._objectBuffer, batch._objects.size() * sizeof(Batch::TransformObject), batch._objects.data(), GL_STREAM_DRAW);
+    GLuint objectBuffer = _transform._objectBuffer;
+    GLintptr objectOffset = 0;
+    GLsizeiptr objectSize = batch._objects.size() * sizeof(Batch::TransformObject);
+    if (objectSize > 0) {
+        GLintptr offset = _transformRing.write(batch._objects.data(), objectSize);
+        if (offset != TransformStreamRing::INVALID_OFFSET) {
+            objectBuffer = _transformRing.getBuffer();
+            objectOffset = offset;
+        } else {
+            glNamedBufferData(_transform._objectBuffer, objectSize, batch._objects.data(), GL_STREAM_DRAW);
+        }
     }
 
     if (!batch._namedData.empty()) {
@@ -53,15 +170,33 @@ void GL45Backend::transferTransformState(const Batch& batch) const {
             memcpy(bufferData.data() + currentSize, data.second.drawCallInfos.data(), bytesToCopy);
             _transform._drawCallInfoOffsets[data.first] = (GLvoid*)currentSize;
         }
-        glNamedBufferData(_transform._drawCallInfoBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
+        GLintptr offset = _transformRing.write(bufferData.data(), bufferData.size());
+        if (offset != TransformStreamRing::INVALID_OFFSET) {
+            _drawCallInfoStreamBuffer = _transformRing.getBuffer();
+            for (auto& data : batch._namedData) {
+                auto& drawCallInfoOffset = _transform._drawCallInfoOffsets[data.first];
+                drawCallInfoOffset = (GLvoid*)((GLintptr)drawCallInfoOffset + offset);
+            }
+        } else {
+            _drawCallInfoStreamBuffer = _transform._drawCallInfoBuffer;
+            glNamedBufferData(_transform._drawCallInfoBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
+        }
     }
 
 #ifdef GPU_SSBO_TRANSFORM_OBJECT
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, slot::storage::ObjectTransforms, _transform._objectBuffer);
+    if (objectSize > 0) {
+        glBindBufferRange(GL_SHADER_STORAGE_BUFFER, slot::storage::ObjectTransforms, objectBuffer, objectOffset, objectSize);
+    } else {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, slot::storage::ObjectTransforms, _transform._objectBuffer);
+    }
 #else
     glActiveTexture(GL_TEXTURE0 + slot::texture::ObjectTransforms);
     glBindTexture(GL_TEXTURE_BUFFER, _transform._objectBufferTexture);
-    glTextureBuffer(_transform._objectBufferTexture, GL_RGBA32F, _transform._objectBuffer);
+    if (objectSize > 0) {
+        glTextureBufferRange(_transform._objectBufferTexture, GL_RGBA32F, objectBuffer, objectOffset, objectSize);
+    } else {
+        glTextureBuffer(_transform._objectBufferTexture, GL_RGBA32F, _transform._objectBuffer);
+    }
 #endif
 
     CHECK_GL_ERROR();
@@ -97,7 +232,7 @@ void GL45Backend::updateTransform(const Batch& batch) {
         // NOTE: A stride of zero in BindVertexBuffer signifies that all elements are sourced from the same location,
         //       so we must provide a stride.
         //       This is in contrast to VertexAttrib*Pointer, where a zero signifies tightly-packed elements.
-        glBindVertexBuffer(gpu::Stream::DRAW_CALL_INFO, _transform._drawCallInfoBuffer, (GLintptr)_transform._drawCallInfoOffsets[batch._currentNamedCall], 2 * sizeof(GLushort));
+        glBindVertexBuffer(gpu::Stream::DRAW_CALL_INFO, _drawCallInfoStreamBuffer, (GLintptr)_transform._drawCallInfoOffsets[batch._currentNamedCall], 2 * sizeof(GLushort));
     }
 
     (void)CHECK_GL_ERROR();
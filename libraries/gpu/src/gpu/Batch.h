@@ -11,6 +11,7 @@
 #ifndef hifi_gpu_Batch_h
 #define hifi_gpu_Batch_h
 
+#include <atomic>
 #include <vector>
 #include <mutex>
 #include <functional>
@@ -79,7 +80,7 @@ public:
     using NamedBatchDataMap = std::map<std::string, NamedBatchData>;
 
     DrawCallInfoBuffer _drawCallInfos;
-    static size_t _drawCallInfosMax;
+    static std::atomic<size_t> _drawCallInfosMax;
 
     mutable std::string _currentNamedCall;
 
@@ -403,7 +404,7 @@ public:
         typedef T Data;
         Data _data;
         Cache(const Data& data) : _data(data) {}
-        static size_t _max;
+        static std::atomic<size_t> _max;
 
         class Vector {
         public:
@@ -414,7 +415,7 @@ public:
             }
 
             ~Vector() {
-                _max = std::max(_items.size(), _max);
+                updateMax(_max, _items.size());
             }
 
 
@@ -436,6 +437,13 @@ public:
         };
     };
 
+    // The high water marks sized by every batch, batches are recorded and released on several threads
+    static void updateMax(std::atomic<size_t>& max, size_t size) {
+        size_t current = max.load(std::memory_order_relaxed);
+        while (size > current && !max.compare_exchange_weak(current, size, std::memory_order_relaxed)) {
+        }
+    }
+
     using CommandHandler = std::function<void(Command, const Param*)>;
 
     void forEachCommand(const CommandHandler& handler) const {
@@ -480,16 +488,16 @@ public:
     }
 
     Commands _commands;
-    static size_t _commandsMax;
+    static std::atomic<size_t> _commandsMax;
 
     CommandOffsets _commandOffsets;
-    static size_t _commandOffsetsMax;
+    static std::atomic<size_t> _commandOffsetsMax;
 
     Params _params;
-    static size_t _paramsMax;
+    static std::atomic<size_t> _paramsMax;
 
     Bytes _data;
-    static size_t _dataMax;
+    static std::atomic<size_t> _dataMax;
 
     // SSBO class... layout MUST match the layout in Transform.slh
     class TransformObject {
@@ -502,7 +510,7 @@ public:
     bool _invalidModel { true };
     Transform _currentModel;
     TransformObjects _objects;
-    static size_t _objectsMax;
+    static std::atomic<size_t> _objectsMax;
 
     BufferCaches _buffers;
     TextureCaches _textures;
@@ -550,7 +558,7 @@ protected:
 };
 
 template <typename T>
-size_t Batch::Cache<T>::_max = BATCH_PREALLOCATE_MIN;
+std::atomic<size_t> Batch::Cache<T>::_max { BATCH_PREALLOCATE_MIN };
 
 }
 
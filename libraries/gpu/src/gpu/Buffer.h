@@ -123,6 +123,9 @@ public:
     // Main thread operation to say that the buffer is ready to be used as a frame
     Update getUpdate() const;
 
+    // Incremented every time the dirty data is taken for a frame, so that data written before can be replaced safely
+    size_t getUpdateCount() const { return _getUpdateCount; }
+
 protected:
     // For use by the render thread to avoid the intermediate step of getUpdate/applyUpdate
     void flush() const;
@@ -8,6 +8,7 @@
 //  Distributed under the Apache License, Version 2.0.
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
+#include <algorithm>
 #include <limits>
 #include "Context.h"
 
@@ -85,6 +86,7 @@ void Context::beginFrame(const glm::mat4& renderView, const glm::mat4& renderPos
 }
 
 void Context::appendFrameBatch(const BatchPointer& batch) {
+    Lock lock(_frameBatchesMutex);
     if (!_frameActive) {
         qWarning() << "Batch executed outside of frame boundaries";
         return;
@@ -95,9 +97,13 @@ void Context::appendFrameBatch(const BatchPointer& batch) {
 FramePointer Context::endFrame() {
     PROFILE_RANGE(render_gpu, __FUNCTION__);
     assert(_frameActive);
-    auto result = _currentFrame;
-    _currentFrame.reset();
-    _frameActive = false;
+    FramePointer result;
+    {
+        Lock lock(_frameBatchesMutex);
+        result = _currentFrame;
+        _currentFrame.reset();
+        _frameActive = false;
+    }
 
     result->stereoState = _stereo;
     result->finish();
@@ -284,6 +290,7 @@ ContextMetricSize  Backend::texturePendingGPUTransferMemSize;
 
 ContextMetricSize  Backend::textureResourcePopulatedGPUMemSize;
 ContextMetricSize  Backend::textureResourceIdealGPUMemSize;
+ContextMetricCount Backend::textureResourceUnderDetailedCount;
 
 Size Context::getFreeGPUMemSize() {
     return Backend::freeGPUMemSize.getValue();
@@ -359,6 +366,10 @@ Size Context::getTextureResourceIdealGPUMemSize() {
     return Backend::textureResourceIdealGPUMemSize.getValue();
 }
 
+uint32_t Context::getTextureResourceUnderDetailedCount() {
+    return Backend::textureResourceUnderDetailedCount.getValue();
+}
+
 void Context::pushProgramsToSync(const std::vector<uint32_t>& programIDs, std::function<void()> callback, size_t rate) {
     std::vector<gpu::ShaderPointer> programs;
     for (auto programID : programIDs) {
@@ -377,15 +388,20 @@ void Context::processProgramsToSync() {
         Lock lock(_programsToSyncMutex);
         ProgramsToSync programsToSync = _programsToSyncQueue.front();
         size_t numSynced = 0;
+        // the programs that the backend compiles in the background are checked again until they are ready
+        _pendingPrograms.erase(std::remove_if(_pendingPrograms.begin(), _pendingPrograms.end(),
+            [&](const gpu::ShaderPointer& program) { return _backend->syncProgram(program); }), _pendingPrograms.end());
         while (_nextProgramToSyncIndex < programsToSync.programs.size() && numSynced < programsToSync.rate) {
             auto nextProgram = programsToSync.programs.at(_nextProgramToSyncIndex);
-            _backend->syncProgram(nextProgram);
+            if (!_backend->syncProgram(nextProgram)) {
+                _pendingPrograms.push_back(nextProgram);
+            }
             _syncedPrograms.push_back(nextProgram);
             _nextProgramToSyncIndex++;
             numSynced++;
         }
 
-        if (_nextProgramToSyncIndex == programsToSync.programs.size()) {
+        if (_nextProgramToSyncIndex == programsToSync.programs.size() && _pendingPrograms.empty()) {
             programsToSync.callback();
             _nextProgramToSyncIndex = 0;
             _programsToSyncQueue.pop();
@@ -394,9 +410,26 @@ void Context::processProgramsToSync() {
 }
 
 std::mutex Context::_batchPoolMutex;
-std::list<Batch*> Context::_batchPool;
+std::vector<Batch*> Context::_batchPool;
+
+// The batches a thread takes from the pool at once
+static const size_t BATCH_STASH_SIZE = 8;
+
+namespace {
+    // The recycled batches at hand for the thread, deleted with it
+    struct BatchStash {
+        std::vector<Batch*> batches;
+
+        ~BatchStash() {
+            for (auto batch : batches) {
+                delete batch;
+            }
+        }
+    };
+}
 
 void Context::clearBatches() {
+    Lock lock(_batchPoolMutex);
     for (auto batch : _batchPool) {
         delete batch;
     }
@@ -404,15 +437,20 @@ void Context::clearBatches() {
 }
 
 BatchPointer Context::acquireBatch(const char* name) {
-    Batch* rawBatch = nullptr;
-    {
+    // batches are mostly released on the present thread, so a thread refills its stash from the pool
+    static thread_local BatchStash stash;
+    if (stash.batches.empty()) {
         Lock lock(_batchPoolMutex);
-        if (!_batchPool.empty()) {
-            rawBatch = _batchPool.front();
-            _batchPool.pop_front();
-        }
+        size_t count = std::min(BATCH_STASH_SIZE, _batchPool.size());
+        stash.batches.insert(stash.batches.end(), _batchPool.end() - count, _batchPool.end());
+        _batchPool.resize(_batchPool.size() - count);
     }
-    if (!rawBatch) {
+
+    Batch* rawBatch = nullptr;
+    if (!stash.batches.empty()) {
+        rawBatch = stash.batches.back();
+        stash.batches.pop_back();
+    } else {
         rawBatch = new Batch();
     }
     if (name) {
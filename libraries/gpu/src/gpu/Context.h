@@ -63,7 +63,8 @@ public:
 
     virtual void render(const Batch& batch) = 0;
     virtual void syncCache() = 0;
-    virtual void syncProgram(const gpu::ShaderPointer& program) = 0;
+    // Returns false while the program is still compiling in the background
+    virtual bool syncProgram(const gpu::ShaderPointer& program) = 0;
     virtual void recycle() const = 0;
     virtual void downloadFramebuffer(const FramebufferPointer& srcFramebuffer, const Vec4i& region, QImage& destImage) = 0;
     virtual void setCameraCorrection(const Mat4& correction, const Mat4& prevRenderView, bool reset = false) {}
@@ -117,6 +118,7 @@ public:
     static ContextMetricSize texturePendingGPUTransferMemSize;
     static ContextMetricSize textureResourcePopulatedGPUMemSize;
     static ContextMetricSize textureResourceIdealGPUMemSize;
+    static ContextMetricCount textureResourceUnderDetailedCount;
 
     virtual bool isStereo() const {
         return _stereo.isStereo();
@@ -161,9 +163,12 @@ public:
     const std::string& getBackendVersion() const;
 
     void beginFrame(const glm::mat4& renderView = glm::mat4(), const glm::mat4& renderPose = glm::mat4());
+    // May be called from any thread, the batches execute in the order they are appended
     void appendFrameBatch(const BatchPointer& batch);
     FramePointer endFrame();
 
+    // Batches are recycled with their capacity, and each thread keeps a few at hand so that recording on
+    // several threads does not contend on the pool
     static BatchPointer acquireBatch(const char* name = nullptr);
     static void releaseBatch(Batch* batch);
 
@@ -255,6 +260,8 @@ public:
 
     static Size getTextureResourcePopulatedGPUMemSize();
     static Size getTextureResourceIdealGPUMemSize();
+    // The number of textures on screen with less detail populated than their screen size needs
+    static uint32_t getTextureResourceUnderDetailedCount();
 
     struct ProgramsToSync {
         ProgramsToSync(const std::vector<gpu::ShaderPointer>& programs, std::function<void()> callback, size_t rate) :
@@ -275,6 +282,7 @@ protected:
 
     std::shared_ptr<Backend> _backend;
     bool _frameActive{ false };
+    std::mutex _frameBatchesMutex;
     FramePointer _currentFrame;
     RangeTimerPointer _frameRangeTimer;
     StereoState _stereo;
@@ -282,6 +290,8 @@ protected:
     std::mutex _programsToSyncMutex;
     std::queue<ProgramsToSync> _programsToSyncQueue;
     gpu::Shaders _syncedPrograms;
+    // the programs of the front of the queue that were synced but aren't ready yet
+    gpu::Shaders _pendingPrograms;
     size_t _nextProgramToSyncIndex { 0 };
 
     // Sampled at the end of every frame, the stats of all the counters
@@ -293,7 +303,7 @@ protected:
     // Should probably move this functionality to Batch
     static void clearBatches();
     static std::mutex _batchPoolMutex;
-    static std::list<Batch*> _batchPool;
+    static std::vector<Batch*> _batchPool;
 
     friend class Shader;
     friend class Backend;
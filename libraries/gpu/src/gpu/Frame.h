@@ -33,6 +33,8 @@ namespace gpu {
         Mat4 view;
         /// The sensor pose used for rendering the frame, only applicable for HMDs
         Mat4 pose;
+        /// When the pose was sampled, in usec, to measure its latency
+        uint64_t poseTimestamp { 0 };
         /// The collection of batches which make up the frame
         Batches batches;
         /// The main thread updates to buffers that are applicable for this frame.
@@ -155,6 +155,11 @@ void Shader::incrementCompilationAttempt() const {
     _numCompilationAttempts++;
 }
 
+void Shader::setCompiled(uint64_t compilationTime) const {
+    _compilationTime = compilationTime;
+    _isCompiled = true;
+}
+
 Shader::Pointer Shader::createVertex(const Source& source) {
     return Pointer(new Shader(VERTEX, source, true));
 }
@@ -12,6 +12,7 @@
 #define hifi_gpu_Shader_h
 
 #include "Resource.h"
+#include <atomic>
 #include <string>
 #include <memory>
 #include <set>
@@ -107,11 +108,16 @@ public:
     bool compilationHasFailed() const { return _compilationHasFailed; }
     const CompilationLogs& getCompilationLogs() const { return _compilationLogs; }
     uint32_t getNumCompilationAttempts() const { return _numCompilationAttempts; }
+    // Whether the backend finished compiling the program, which it can do in the background
+    bool isCompiled() const { return _isCompiled; }
+    // The time from the start of the compilation of the program to when it could be used, in usecs
+    uint64_t getCompilationTime() const { return _compilationTime; }
 
     // Set COmpilation logs can only be called by the Backend layers
     void setCompilationHasFailed(bool compilationHasFailed) { _compilationHasFailed = compilationHasFailed; }
     void setCompilationLogs(const CompilationLogs& logs) const;
     void incrementCompilationAttempt() const;
+    void setCompiled(uint64_t compilationTime) const;
 
     const GPUObjectPointer gpuObject{};
 
@@ -137,6 +143,10 @@ protected:
     // Whether or not the shader compilation failed
     bool _compilationHasFailed{ false };
 
+    // Set by the render thread and read by the users of the program
+    mutable std::atomic<bool> _isCompiled{ false };
+    mutable std::atomic<uint64_t> _compilationTime{ 0 };
+
     // Global maps of the shaders
     // Unique shader ID
     //static std::atomic<ID> _nextShaderID;
@@ -229,6 +229,12 @@ Texture::Texture(TextureUsageType usageType) :
     _textureCPUCount.increment();
 }
 
+void Texture::reportScreenSize(uint32 pixels) const {
+    uint32 current = _screenSize.load(std::memory_order_relaxed);
+    while (pixels > current && !_screenSize.compare_exchange_weak(current, pixels, std::memory_order_relaxed)) {
+    }
+}
+
 Texture::~Texture() {
     _textureCPUCount.decrement();
     if (_usageType == TextureUsageType::EXTERNAL) {
@@ -12,6 +12,7 @@
 #define hifi_gpu_Texture_h
 
 #include <algorithm> //min max and more
+#include <atomic>
 #include <bitset>
 
 #include <QMetaType>
@@ -579,6 +580,11 @@ public:
     bool getImportant() const { return _important; }
     void setImportant(bool important) { _important = important; }
 
+    // Screen space feedback for the texture streaming: renderers report the size in pixels the texture is drawn
+    // at, and the backend takes the largest size reported since it last looked
+    void reportScreenSize(uint32 pixels) const;
+    uint32 takeScreenSize() const { return _screenSize.exchange(0, std::memory_order_relaxed); }
+
     const GPUObjectPointer gpuObject {};
 
     ExternalUpdates getUpdates() const;
@@ -643,6 +649,7 @@ protected:
     bool _isIrradianceValid = false;
     bool _defined = false;
     bool _important = false;
+    mutable std::atomic<uint32> _screenSize { 0 };
    
     static TexturePointer create(TextureUsageType usageType, Type type, const Element& texelFormat, uint16 width, uint16 height, uint16 depth, uint16 numSamples, uint16 numSlices, uint16 numMips, const Sampler& sampler);
 
@@ -16,6 +16,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include <ktx/KTX.h>
+#include <ktx/KTX2.h>
 
 #include "GPULogging.h"
 
@@ -275,7 +276,9 @@ PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
         qWarning() << "Failed to get a valid storageView for faceSize=" << faceSize << "  faceOffset=" << faceOffset
                     << "out of valid file " << QString::fromStdString(_filename);
     }
-    return storageView->toMemoryStorage();
+    // The view keeps the file mapped until the upload is done with it. assignMipData only writes levels that
+    // aren't available yet, so the mapped bytes of an available level never change under it.
+    return storageView;
 }
 
 Size KtxStorage::getMipFaceSize(uint16 level, uint8 face) const {
@@ -578,8 +581,21 @@ std::pair<TexturePointer, glm::ivec2> Texture::build(const ktx::KTXDescriptor& d
     return { texture, gpuktxKeyValue._originalSize };
 }
 
+// KTX2 files carry Basis Universal or otherwise supercompressed levels that need a transcoder before upload
+static bool rejectKtx2(const storage::StoragePointer& storage, const std::string& source) {
+    if (!storage || !(*storage) || !ktx::KTX2::checkIdentifier(storage->size(), storage->data())) {
+        return false;
+    }
+    qCWarning(gpulogging) << "Cannot load KTX2 texture" << QString::fromStdString(source) << ", no transcoder is available";
+    return true;
+}
+
 std::pair<TexturePointer, glm::ivec2> Texture::unserialize(const cache::FilePointer& cacheEntry, const std::string& source) {
-    std::unique_ptr<ktx::KTX> ktxPointer = ktx::KTX::create(std::make_shared<storage::FileStorage>(cacheEntry->getFilepath().c_str()));
+    auto storage = std::make_shared<storage::FileStorage>(cacheEntry->getFilepath().c_str());
+    if (rejectKtx2(storage, source)) {
+        return { nullptr, { 0, 0 } };
+    }
+    std::unique_ptr<ktx::KTX> ktxPointer = ktx::KTX::create(storage);
     if (!ktxPointer) {
         return { nullptr, { 0, 0 } };
     }
@@ -596,7 +612,11 @@ std::pair<TexturePointer, glm::ivec2> Texture::unserialize(const cache::FilePoin
 }
 
 std::pair<TexturePointer, glm::ivec2> Texture::unserialize(const std::string& ktxfile) {
-    std::unique_ptr<ktx::KTX> ktxPointer = ktx::KTX::create(std::make_shared<storage::FileStorage>(ktxfile.c_str()));
+    auto storage = std::make_shared<storage::FileStorage>(ktxfile.c_str());
+    if (rejectKtx2(storage, ktxfile)) {
+        return { nullptr, { 0, 0 } };
+    }
+    std::unique_ptr<ktx::KTX> ktxPointer = ktx::KTX::create(storage);
     if (!ktxPointer) {
         return { nullptr, { 0, 0 } };
     }
@@ -43,7 +43,7 @@ public:
     // Let's try to avoid to do that as much as possible!
     void syncCache() final { }
 
-    void syncProgram(const gpu::ShaderPointer& program) final {}
+    bool syncProgram(const gpu::ShaderPointer& program) final { return true; }
 
     // This is the ugly "download the pixels to sysmem for taking a snapshot"
     // Just avoid using it, it's ugly and will break performances
@@ -123,6 +123,32 @@ public:
     // the returned box is the bounding box of ALL the evaluated parts bound.
     Box evalPartsBound(int partStart, int partEnd) const;
 
+    // A cluster of nearby triangles of a part, at most MAX_MESHLET_VERTICES vertices and MAX_MESHLET_TRIANGLES triangles
+    class Meshlet {
+    public:
+        static const int MAX_MESHLET_VERTICES { 64 };
+        static const int MAX_MESHLET_TRIANGLES { 124 };
+
+        Index _startIndex { 0 };
+        Index _numIndices { 0 };
+        glm::vec3 _center { 0.0f };
+        float _radius { 0.0f };
+    };
+
+    // A simplified version of the mesh, drawn from the same vertices with indices that follow the full mesh ones in the
+    // index buffer.  It has the same parts as the part buffer, their triangles ordered meshlet by meshlet.
+    class LOD {
+    public:
+        float _error { 0.0f }; // how far, in mesh units, the simplified surface may be from the full one
+        std::vector<Part> _parts;
+        std::vector<Meshlet> _meshlets;
+    };
+    using LODs = std::vector<LOD>;
+
+    // the simplified versions of the mesh, from the most detailed to the least
+    void setLODs(const LODs& lods) { _lods = lods; }
+    const LODs& getLODs() const { return _lods; }
+
     static gpu::Primitive topologyToPrimitive(Topology topo) { return static_cast<gpu::Primitive>(topo); }
 
     // create a copy of this mesh after passing its vertices, normals, and indexes though the provided functions
@@ -155,6 +181,7 @@ protected:
     BufferView _indexBuffer;
 
     BufferView _partBuffer;
+    LODs _lods;
 
     gpu::BufferPointer _colorBuffer { std::make_shared<gpu::Buffer>() };
 
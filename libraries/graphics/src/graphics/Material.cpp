@@ -325,6 +325,15 @@ bool MultiMaterial::anyReferenceMaterialsOrTexturesChanged() const {
     return false;
 }
 
+size_t MultiMaterial::getLayersHash() const {
+    size_t hash = c.size();
+    for (const auto& layer : c) {
+        hash = hash * 31 + std::hash<MaterialPointer>()(layer.material);
+        hash = hash * 31 + layer.priority;
+    }
+    return hash;
+}
+
 void MultiMaterial::setisMToon(bool isMToon) {
     if (isMToon != _isMToon) {
         if (isMToon) {
@@ -338,6 +347,19 @@ void MultiMaterial::setisMToon(bool isMToon) {
     _isMToon = isMToon;
 }
 
+void MultiMaterial::updateMaterialTable() {
+    static_assert(sizeof(Schema) <= MaterialTable::SLOT_SIZE && sizeof(MToonSchema) <= MaterialTable::SLOT_SIZE,
+                  "MaterialTable slots are too small for the schemas");
+    if (!_materialSlot) {
+        _materialSlot = MaterialTable::getInstance().allocate();
+    }
+    if (_isMToon) {
+        _materialSlot->update(&_schemaBuffer.get<MToonSchema>(), sizeof(MToonSchema));
+    } else {
+        _materialSlot->update(&_schemaBuffer.get<Schema>(), sizeof(Schema));
+    }
+}
+
 void MultiMaterial::setMToonTime() {
     assert(_isMToon);
 
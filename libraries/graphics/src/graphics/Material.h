@@ -24,6 +24,7 @@
 #include <gpu/TextureTable.h>
 
 #include "MaterialMappingMode.h"
+#include "MaterialTable.h"
 
 class Transform;
 
@@ -641,6 +642,11 @@ public:
     }
     const gpu::TextureTablePointer& getTextureTable() const { return _textureTable; }
 
+    // The schema is bound from this material's slot of the MaterialTable, which is updated from the schema buffer
+    void updateMaterialTable();
+    MaterialTable::ID getMaterialID() const { return _materialSlot ? _materialSlot->getID() : MaterialTable::INVALID_ID; }
+    const gpu::BufferView& getMaterialTableView() const { return _materialSlot->getView(); }
+
     void setCullFaceMode(graphics::MaterialKey::CullFaceMode cullFaceMode) { _cullFaceMode = cullFaceMode; }
     graphics::MaterialKey::CullFaceMode getCullFaceMode() const { return _cullFaceMode; }
 
@@ -650,6 +656,9 @@ public:
 
     bool shouldUpdate() const { return !_initialized || _needsUpdate || _texturesLoading || anyReferenceMaterialsOrTexturesChanged(); }
 
+    // Multi materials with the same layers hash draw the same, so their shapes can share an instanced draw
+    size_t getLayersHash() const;
+
     int getTextureCount() const { calculateMaterialInfo(); return _textureCount; }
     size_t getTextureSize()  const { calculateMaterialInfo(); return _textureSize; }
     bool hasTextureInfo() const { return _hasCalculatedTextureInfo; }
@@ -672,6 +681,7 @@ public:
 
 private:
     gpu::BufferView _schemaBuffer;
+    MaterialTable::SlotPointer _materialSlot;
     graphics::MaterialKey::CullFaceMode _cullFaceMode { graphics::Material::DEFAULT_CULL_FACE_MODE };
     gpu::TextureTablePointer _textureTable { std::make_shared<gpu::TextureTable>() };
     bool _needsUpdate { false };
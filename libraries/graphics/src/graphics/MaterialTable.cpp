@@ -0,0 +1,84 @@
+//
+//  MaterialTable.cpp
+//  libraries/graphics/src/graphics
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "MaterialTable.h"
+
+using namespace graphics;
+
+const MaterialTable::ID MaterialTable::INVALID_ID { (ID)-1 };
+const size_t MaterialTable::SLOT_SIZE;
+const size_t MaterialTable::SLOTS_PER_BUFFER;
+
+void MaterialTable::Slot::update(const void* data, size_t size) {
+    assert(size <= SLOT_SIZE);
+    _view._buffer->setSubData(_view._offset, size, reinterpret_cast<const gpu::Byte*>(data));
+}
+
+MaterialTable& MaterialTable::getInstance() {
+    // never destroyed, the multi materials of other statics release their slots to it on exit
+    static MaterialTable* instance = new MaterialTable();
+    return *instance;
+}
+
+MaterialTable::SlotPointer MaterialTable::allocate() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_freeIDs.empty()) {
+        recycle();
+    }
+
+    ID id;
+    if (!_freeIDs.empty()) {
+        id = _freeIDs.back();
+        _freeIDs.pop_back();
+    } else {
+        id = _numIDs++;
+        if (id / SLOTS_PER_BUFFER >= _buffers.size()) {
+            // only whole slots are marked dirty, and the buffers never grow so that the views into them stay valid
+            auto buffer = std::make_shared<gpu::Buffer>(SLOT_SIZE);
+            buffer->resize(SLOT_SIZE * SLOTS_PER_BUFFER);
+            _buffers.push_back(buffer);
+        }
+    }
+
+    gpu::BufferView view(_buffers[id / SLOTS_PER_BUFFER], (id % SLOTS_PER_BUFFER) * SLOT_SIZE, SLOT_SIZE);
+    return std::make_shared<Slot>(*this, id, view);
+}
+
+size_t MaterialTable::getNumAllocated() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _numIDs - _freeIDs.size() - _releases.size();
+}
+
+size_t MaterialTable::getNumBuffers() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _buffers.size();
+}
+
+void MaterialTable::release(ID id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _releases.push_back({ id, _buffers[id / SLOTS_PER_BUFFER]->getUpdateCount() });
+}
+
+void MaterialTable::recycle() {
+    // The buffers in use have their data taken at the end of every frame, so the oldest releases are usually free. One whose
+    // buffer isn't drawn any more goes to the back rather than hold up the others.
+    const int MAX_RELEASES_CHECKED = 8;
+    for (int i = 0; i < MAX_RELEASES_CHECKED && !_releases.empty(); i++) {
+        Release release = _releases.front();
+        _releases.pop_front();
+        if (_buffers[release.id / SLOTS_PER_BUFFER]->getUpdateCount() != release.updateCount) {
+            _freeIDs.push_back(release.id);
+        } else {
+            _releases.push_back(release);
+        }
+    }
+}
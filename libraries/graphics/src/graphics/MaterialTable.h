@@ -0,0 +1,81 @@
+//
+//  MaterialTable.h
+//  libraries/graphics/src/graphics
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_graphics_MaterialTable_h
+#define overte_graphics_MaterialTable_h
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <gpu/Buffer.h>
+
+namespace graphics {
+
+// The schemas of the multi materials, packed into the slots of a few large uniform buffers instead of one small buffer
+// each, so that a frame syncs a handful of buffers however many materials it draws. A slot's index is the material ID.
+class MaterialTable {
+public:
+    using ID = uint32_t;
+    static const ID INVALID_ID;
+
+    // the largest uniform buffer offset alignment that GL implementations require, and room for either schema
+    static const size_t SLOT_SIZE { 256 };
+    static const size_t SLOTS_PER_BUFFER { 256 };
+
+    // Slots are shared by the copies of a multi material, like its schema buffer, and go back to the table with the
+    // last of them
+    class Slot {
+    public:
+        Slot(MaterialTable& table, ID id, const gpu::BufferView& view) : _table(table), _id(id), _view(view) {}
+        ~Slot() { _table.release(_id); }
+
+        ID getID() const { return _id; }
+        const gpu::BufferView& getView() const { return _view; }
+
+        void update(const void* data, size_t size);
+
+    private:
+        MaterialTable& _table;
+        const ID _id;
+        const gpu::BufferView _view;
+    };
+    using SlotPointer = std::shared_ptr<Slot>;
+
+    static MaterialTable& getInstance();
+
+    SlotPointer allocate();
+
+    size_t getNumAllocated() const;
+    size_t getNumBuffers() const;
+
+private:
+    void release(ID id);
+    void recycle();
+
+    mutable std::mutex _mutex;
+    std::vector<gpu::BufferPointer> _buffers;
+    std::vector<ID> _freeIDs;
+
+    // A released slot may still be bound in a batch of the frame being recorded, so it is only reused once its
+    // buffer's data have been taken for a frame since
+    struct Release {
+        ID id;
+        size_t updateCount;
+    };
+    std::deque<Release> _releases;
+    ID _numIDs { 0 };
+};
+
+}
+
+#endif // overte_graphics_MaterialTable_h
@@ -11,6 +11,8 @@
 
 #include "TextureProcessing.h"
 
+#include <mutex>
+
 #include <glm/gtc/packing.hpp>
 
 #include <QtCore/QtGlobal>
@@ -19,6 +21,8 @@
 #include <QBuffer>
 #include <QImageReader>
 
+#include <tbb/parallel_for.h>
+
 #include <Finally.h>
 #include <Profile.h>
 #include <StatTracker.h>
@@ -420,6 +424,13 @@ Image processSourceImage(Image&& srcImage, bool cubemap, BackendTarget target) {
     return localCopy;
 }
 
+// The mips and faces of a texture are converted in parallel, and its storage is assigned under one of these locks
+static std::mutex& getTextureAssignMutex(const gpu::Texture* texture) {
+    static const size_t NUM_ASSIGN_MUTEXES = 16;
+    static std::mutex assignMutexes[NUM_ASSIGN_MUTEXES];
+    return assignMutexes[(reinterpret_cast<uintptr_t>(texture) / sizeof(void*)) % NUM_ASSIGN_MUTEXES];
+}
+
 #if defined(NVTT_API)
 struct OutputHandler : public nvtt::OutputHandler {
     OutputHandler(gpu::Texture* texture, int face) : _texture(texture), _face(face) {}
@@ -440,10 +451,13 @@ struct OutputHandler : public nvtt::OutputHandler {
     }
 
     virtual void endImage() override {
-        if (_face >= 0) {
-            _texture->assignStoredMipFace(_miplevel, _face, _size, static_cast<const gpu::Byte*>(_data));
-        } else {
-            _texture->assignStoredMip(_miplevel, _size, static_cast<const gpu::Byte*>(_data));
+        {
+            std::lock_guard<std::mutex> lock(getTextureAssignMutex(_texture));
+            if (_face >= 0) {
+                _texture->assignStoredMipFace(_miplevel, _face, _size, static_cast<const gpu::Byte*>(_data));
+            } else {
+                _texture->assignStoredMip(_miplevel, _size, static_cast<const gpu::Byte*>(_data));
+            }
         }
         free(_data);
         _data = nullptr;
@@ -501,23 +515,57 @@ struct MyErrorHandler : public nvtt::ErrorHandler {
 };
 
 #if defined(NVTT_API)
-class SequentialTaskDispatcher : public nvtt::TaskDispatcher {
+// Runs the block compression tasks of a surface concurrently
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
 public:
-    SequentialTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
     }
 
     const std::atomic<bool>& _abortProcessing;
 
     void dispatch(nvtt::Task* task, void* context, int count) override {
-        for (int i = 0; i < count; i++) {
+        tbb::parallel_for(0, count, [&](int i) {
             if (!_abortProcessing.load()) {
                 task(context, i);
-            } else {
-                break;
             }
-        }
+        });
     }
 };
+
+// Builds the mip chain of surface, then compresses its levels concurrently, each through its own output handler
+template <typename F>
+void compressSurfaceWithMips(const nvtt::Surface& surface, int face, int baseMipLevel, bool buildMips,
+                             const nvtt::CompressionOptions& compressionOptions, F makeOutputHandler,
+                             const std::atomic<bool>& abortProcessing) {
+    std::vector<nvtt::Surface> levels { surface };
+    if (buildMips) {
+        while (levels.back().canMakeNextMipmap() && !abortProcessing.load()) {
+            nvtt::Surface nextLevel = levels.back();
+            nextLevel.buildNextMipmap(nvtt::MipmapFilter_Box);
+            levels.push_back(nextLevel);
+        }
+    }
+
+    ParallelTaskDispatcher dispatcher(abortProcessing);
+    tbb::parallel_for(0, (int)levels.size(), [&](int level) {
+        if (abortProcessing.load()) {
+            return;
+        }
+        std::unique_ptr<nvtt::OutputHandler> outputHandler { makeOutputHandler() };
+        if (!outputHandler) {
+            return;
+        }
+        nvtt::OutputOptions outputOptions;
+        outputOptions.setOutputHeader(false);
+        outputOptions.setOutputHandler(outputHandler.get());
+        MyErrorHandler errorHandler;
+        outputOptions.setErrorHandler(&errorHandler);
+
+        nvtt::Context context;
+        context.setTaskDispatcher(&dispatcher);
+        context.compress(levels[level], face, baseMipLevel + level, compressionOptions, outputOptions);
+    });
+}
 #endif
 
 void convertToFloatFromPacked(const unsigned char* source, int width, int height, size_t srcLineByteStride, gpu::Element sourceFormat,
@@ -604,35 +652,22 @@ void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     const int width = localCopy.getWidth();
     const int height = localCopy.getHeight();
 
-    nvtt::OutputOptions outputOptions;
-    outputOptions.setOutputHeader(false);
-
     nvtt::CompressionOptions compressionOptions;
     std::unique_ptr<nvtt::OutputHandler> outputHandler{ getNVTTCompressionOutputHandler(texture, face, compressionOptions) };
-
-    MyErrorHandler errorHandler;
-    outputOptions.setErrorHandler(&errorHandler);
-    nvtt::Context context;
-    int mipLevel = baseMipLevel;
-
-    outputOptions.setOutputHandler(outputHandler.get());
+    if (!outputHandler) {
+        return;
+    }
 
     nvtt::Surface surface;
     surface.setImage(nvtt::InputFormat_RGBA_32F, width, height, 1, localCopy.getBits());
     surface.setAlphaMode(nvtt::AlphaMode_None);
     surface.setWrapMode(nvtt::WrapMode_Mirror);
+    localCopy = Image();
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
-    nvtt::Compressor compressor;
-    context.setTaskDispatcher(&dispatcher);
-
-    context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-    if (buildMips) {
-        while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-            surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-            context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-        }
-    }
+    compressSurfaceWithMips(surface, face, baseMipLevel, buildMips, compressionOptions, [texture, face] {
+        nvtt::CompressionOptions levelCompressionOptions;
+        return getNVTTCompressionOutputHandler(texture, face, levelCompressionOptions);
+    }, abortProcessing);
 }
 
 void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarget target, int baseMipLevel, bool buildMips, const std::atomic<bool>& abortProcessing, int face) {
@@ -752,23 +787,9 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
             return;
         }
 
-        nvtt::OutputOptions outputOptions;
-        outputOptions.setOutputHeader(false);
-        OutputHandler outputHandler(texture, face);
-        outputOptions.setOutputHandler(&outputHandler);
-        MyErrorHandler errorHandler;
-        outputOptions.setErrorHandler(&errorHandler);
-
-        SequentialTaskDispatcher dispatcher(abortProcessing);
-        nvtt::Compressor context;
-
-        context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-        if (buildMips) {
-            while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-                surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-                context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-            }
-        }
+        compressSurfaceWithMips(surface, face, mipLevel, buildMips, compressionOptions, [texture, face] {
+            return new OutputHandler(texture, face);
+        }, abortProcessing);
     } else {
         int numMips = 1;
     
@@ -822,6 +843,7 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
             mipMaps, &encodingTime
         );
 
+        std::lock_guard<std::mutex> lock(getTextureAssignMutex(texture));
         for (int i = 0; i < numMips; i++) {
             if (mipMaps[i].paucEncodingBits.get()) {
                 if (face >= 0) {
@@ -1552,11 +1574,13 @@ void convolveForGGX(const std::vector<Image>& faces, gpu::Texture* texture, Back
         output.applyGamma(1.0f/2.2f);
     }
 
-    for (int face = 0; face < 6; face++) {
-        for (gpu::uint16 mipLevel = 0; mipLevel < output.getMipCount(); mipLevel++) {
-            convertToTexture(texture, output.getFaceImage(mipLevel, face), target, abortProcessing, face, mipLevel);
-        }
-    }
+    const int NUM_FACES = 6;
+    int mipCount = output.getMipCount();
+    tbb::parallel_for(0, NUM_FACES * mipCount, [&](int index) {
+        int face = index / mipCount;
+        gpu::uint16 mipLevel = (gpu::uint16)(index % mipCount);
+        convertToTexture(texture, output.getFaceImage(mipLevel, face), target, abortProcessing, face, mipLevel);
+    });
 }
 
 gpu::TexturePointer TextureUsage::processCubeTextureColorFromImage(Image&& srcImage, const std::string& srcImageName,
@@ -1661,11 +1685,10 @@ gpu::TexturePointer TextureUsage::processCubeTextureColorFromImage(Image&& srcIm
             // Performs and convolution AND mip map generation
             convolveForGGX(faces, theTexture.get(), target, abortProcessing);
         } else {
-            // Create mip maps and compress to final format in one go
-            for (uint8 face = 0; face < faces.size(); ++face) {
-                // Force building the mip maps right now on CPU if we are convolving for GGX later on
+            // Create mip maps and compress to final format in one go, one face per task
+            tbb::parallel_for(0, (int)faces.size(), [&](int face) {
                 convertToTextureWithMips(theTexture.get(), std::move(faces[face]), target, abortProcessing, face);
-            }
+            });
         }
     }
 
@@ -0,0 +1,213 @@
+//
+//  KTX2.cpp
+//  ktx/src/ktx
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "KTX2.h"
+
+#include <QtCore/QDebug>
+
+using namespace ktx;
+
+const KTX2Header::Identifier ktx::KTX2Header::IDENTIFIER {{
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+}};
+
+// Offsets within the data format descriptor, which starts with its total size followed by the first block
+static const size_t DFD_COLOR_MODEL_OFFSET { 12 };
+static const size_t DFD_BYTES_PLANE0_OFFSET { 20 };
+static const uint32_t SGD_ALIGNMENT { sizeof(uint64_t) };
+
+template <typename T>
+static inline T alignTo(T value, T alignment) {
+    return ((value + alignment - 1) / alignment) * alignment;
+}
+
+static uint32_t evalLeastCommonMultiple(uint32_t a, uint32_t b) {
+    uint32_t x = a;
+    uint32_t y = b;
+    while (y != 0) {
+        uint32_t remainder = x % y;
+        x = y;
+        y = remainder;
+    }
+    return (a / x) * b;
+}
+
+KTX2Header::KTX2Header() {
+    memcpy(identifier, IDENTIFIER.data(), IDENTIFIER_LENGTH);
+}
+
+bool KTX2::checkIdentifier(size_t srcSize, const Byte* srcBytes) {
+    return srcSize >= KTX2Header::IDENTIFIER_LENGTH &&
+        0 == memcmp(srcBytes, KTX2Header::IDENTIFIER.data(), KTX2Header::IDENTIFIER_LENGTH);
+}
+
+static bool checkRange(uint64_t offset, uint64_t length, size_t srcSize) {
+    return offset <= srcSize && length <= srcSize - offset;
+}
+
+std::unique_ptr<KTX2> KTX2::create(const StoragePointer& src) {
+    if (!src || !(*src)) {
+        return nullptr;
+    }
+
+    size_t srcSize = src->size();
+    const Byte* srcBytes = src->data();
+    if (srcSize < KTX2_HEADER_SIZE || !checkIdentifier(srcSize, srcBytes)) {
+        qWarning() << "KTX2 deserialization error: identifier field invalid";
+        return nullptr;
+    }
+
+    std::unique_ptr<KTX2> result(new KTX2());
+    memcpy(&result->_header, srcBytes, KTX2_HEADER_SIZE);
+    const auto& header = result->_header;
+
+    uint32_t numLevels = header.getNumberOfLevels();
+    if (!checkRange(KTX2_HEADER_SIZE, (uint64_t)numLevels * KTX2_LEVEL_SIZE, srcSize)) {
+        qWarning() << "KTX2 deserialization error: length is too short for level index";
+        return nullptr;
+    }
+    if (!checkRange(header.dfdByteOffset, header.dfdByteLength, srcSize) ||
+        !checkRange(header.kvdByteOffset, header.kvdByteLength, srcSize) ||
+        !checkRange(header.sgdByteOffset, header.sgdByteLength, srcSize)) {
+        qWarning() << "KTX2 deserialization error: length is too short for metadata";
+        return nullptr;
+    }
+
+    result->_levels.resize(numLevels);
+    memcpy(result->_levels.data(), srcBytes + KTX2_HEADER_SIZE, numLevels * KTX2_LEVEL_SIZE);
+    for (const auto& level : result->_levels) {
+        if (!checkRange(level.byteOffset, level.byteLength, srcSize)) {
+            qWarning() << "KTX2 deserialization error: length is too short for data";
+            return nullptr;
+        }
+    }
+
+    if (header.kvdByteLength > 0) {
+        result->_keyValues = KTX::parseKeyValues(header.kvdByteLength, srcBytes + header.kvdByteOffset);
+    }
+    result->_storage = src;
+    return result;
+}
+
+std::unique_ptr<KTX2> KTX2::create(const KTX2Header& header, const Bytes& dataFormatDescriptor, const LevelBytes& levels,
+                                   const KeyValues& keyValues, const Bytes& supercompressionGlobalData) {
+    if (levels.empty()) {
+        return nullptr;
+    }
+
+    KTX2Header layout = header;
+    memcpy(layout.identifier, KTX2Header::IDENTIFIER.data(), KTX2Header::IDENTIFIER_LENGTH);
+    layout.levelCount = (uint32_t)levels.size();
+
+    size_t offset = KTX2_HEADER_SIZE + levels.size() * KTX2_LEVEL_SIZE;
+    layout.dfdByteOffset = (uint32_t)offset;
+    layout.dfdByteLength = (uint32_t)dataFormatDescriptor.size();
+    offset += dataFormatDescriptor.size();
+
+    offset = evalPaddedSize(offset);
+    layout.kvdByteLength = KeyValue::serializedKeyValuesByteSize(keyValues);
+    layout.kvdByteOffset = layout.kvdByteLength > 0 ? (uint32_t)offset : 0;
+    offset += layout.kvdByteLength;
+
+    layout.sgdByteLength = supercompressionGlobalData.size();
+    if (layout.sgdByteLength > 0) {
+        offset = alignTo<size_t>(offset, SGD_ALIGNMENT);
+        layout.sgdByteOffset = offset;
+        offset += supercompressionGlobalData.size();
+    } else {
+        layout.sgdByteOffset = 0;
+    }
+
+    // Supercompressed levels are byte aligned, the others are aligned to both their texel blocks and 4 bytes
+    bool supercompressed = layout.getSupercompressionScheme() != SupercompressionScheme::NONE;
+    uint32_t texelBlockByteSize = ALIGNMENT;
+    if (dataFormatDescriptor.size() > DFD_BYTES_PLANE0_OFFSET && dataFormatDescriptor[DFD_BYTES_PLANE0_OFFSET] > 0) {
+        texelBlockByteSize = dataFormatDescriptor[DFD_BYTES_PLANE0_OFFSET];
+    }
+    size_t levelAlignment = supercompressed ? 1 : evalLeastCommonMultiple(texelBlockByteSize, ALIGNMENT);
+
+    std::vector<KTX2Level> levelIndex(levels.size());
+    for (size_t i = levels.size(); i-- > 0;) {
+        offset = alignTo(offset, levelAlignment);
+        levelIndex[i].byteOffset = offset;
+        levelIndex[i].byteLength = levels[i].size();
+        // The uncompressed size of a supercompressed level is only known to its encoder
+        levelIndex[i].uncompressedByteLength = supercompressed ? 0 : levels[i].size();
+        offset += levels[i].size();
+    }
+
+    StoragePointer storagePointer;
+    {
+        auto memoryStorage = new storage::MemoryStorage(offset);
+        Byte* destBytes = memoryStorage->data();
+        memset(destBytes, 0, offset);
+        memcpy(destBytes, &layout, KTX2_HEADER_SIZE);
+        memcpy(destBytes + KTX2_HEADER_SIZE, levelIndex.data(), levelIndex.size() * KTX2_LEVEL_SIZE);
+        if (!dataFormatDescriptor.empty()) {
+            memcpy(destBytes + layout.dfdByteOffset, dataFormatDescriptor.data(), dataFormatDescriptor.size());
+        }
+        if (layout.kvdByteLength > 0) {
+            KTX::writeKeyValues(destBytes + layout.kvdByteOffset, layout.kvdByteLength, keyValues);
+        }
+        if (layout.sgdByteLength > 0) {
+            memcpy(destBytes + layout.sgdByteOffset, supercompressionGlobalData.data(), supercompressionGlobalData.size());
+        }
+        for (size_t i = 0; i < levels.size(); ++i) {
+            if (!levels[i].empty()) {
+                memcpy(destBytes + levelIndex[i].byteOffset, levels[i].data(), levels[i].size());
+            }
+        }
+        storagePointer.reset(memoryStorage);
+    }
+    return create(storagePointer);
+}
+
+storage::StoragePointer KTX2::getDataFormatDescriptor() const {
+    return _storage->createView(_header.dfdByteLength, _header.dfdByteOffset);
+}
+
+storage::StoragePointer KTX2::getSupercompressionGlobalData() const {
+    return _storage->createView((size_t)_header.sgdByteLength, (size_t)_header.sgdByteOffset);
+}
+
+storage::StoragePointer KTX2::getLevelData(uint32_t level) const {
+    if (level >= _levels.size()) {
+        return nullptr;
+    }
+    const auto& entry = _levels[level];
+    return _storage->createView((size_t)entry.byteLength, (size_t)entry.byteOffset);
+}
+
+ColorModel KTX2::getColorModel() const {
+    if (_header.dfdByteLength <= DFD_COLOR_MODEL_OFFSET) {
+        return ColorModel::UNSPECIFIED;
+    }
+    return (ColorModel)_storage->data()[_header.dfdByteOffset + DFD_COLOR_MODEL_OFFSET];
+}
+
+uint32_t KTX2::getTexelBlockByteSize() const {
+    if (_header.dfdByteLength <= DFD_BYTES_PLANE0_OFFSET) {
+        return 0;
+    }
+    return _storage->data()[_header.dfdByteOffset + DFD_BYTES_PLANE0_OFFSET];
+}
+
+bool KTX2::isBasisUniversal() const {
+    if (_header.getSupercompressionScheme() == SupercompressionScheme::BASIS_LZ) {
+        return true;
+    }
+    auto colorModel = getColorModel();
+    return colorModel == ColorModel::ETC1S || colorModel == ColorModel::UASTC;
+}
+
+bool KTX2::requiresTranscoding() const {
+    return _header.getSupercompressionScheme() != SupercompressionScheme::NONE || _header.vkFormat == VK_FORMAT_UNDEFINED;
+}
@@ -0,0 +1,168 @@
+//
+//  KTX2.h
+//  ktx/src/ktx
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ktx_KTX2_h
+#define overte_ktx_KTX2_h
+
+#include "KTX.h"
+
+/*
+
+KTX 2.0 Specification: https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+
+**** A KTX2 file is laid out as follows
+
+Byte[12] identifier
+UInt32 vkFormat
+UInt32 typeSize
+UInt32 pixelWidth
+UInt32 pixelHeight
+UInt32 pixelDepth
+UInt32 layerCount
+UInt32 faceCount
+UInt32 levelCount
+UInt32 supercompressionScheme
+
+UInt32 dfdByteOffset
+UInt32 dfdByteLength
+UInt32 kvdByteOffset
+UInt32 kvdByteLength
+UInt64 sgdByteOffset
+UInt64 sgdByteLength
+
+for each mip_level in levelCount*
+    UInt64 byteOffset
+    UInt64 byteLength
+    UInt64 uncompressedByteLength
+end
+
+Data format descriptor, 4 byte aligned
+Key value pairs, laid out as in KTX 1, 4 byte aligned
+Supercompression global data, 8 byte aligned
+
+for each mip_level in levelCount*, smallest first
+    Byte mipPadding[...]
+    Byte levelImages[byteLength]
+end
+
+* Replace with 1 if this field is 0.
+
+Unlike KTX 1 the levels are stored smallest first, so a partial download holds the low resolution levels, and
+each level may be supercompressed, in which case its data has to be transcoded before it can be uploaded.
+*/
+
+namespace ktx {
+
+    enum class SupercompressionScheme : uint32_t {
+        NONE = 0,
+        BASIS_LZ = 1,
+        ZSTANDARD = 2,
+        ZLIB = 3,
+    };
+
+    // The data format descriptor color models of the Basis Universal formats
+    enum class ColorModel : uint8_t {
+        UNSPECIFIED = 0,
+        ETC1S = 163,
+        UASTC = 166,
+    };
+
+    static const uint32_t VK_FORMAT_UNDEFINED { 0 };
+
+    struct KTX2Header {
+        static const size_t IDENTIFIER_LENGTH { 12 };
+        using Identifier = std::array<uint8_t, IDENTIFIER_LENGTH>;
+        static const Identifier IDENTIFIER;
+
+        KTX2Header();
+
+        Byte identifier[IDENTIFIER_LENGTH];
+        uint32_t vkFormat { VK_FORMAT_UNDEFINED };
+        uint32_t typeSize { 1 };
+        uint32_t pixelWidth { 1 };
+        uint32_t pixelHeight { 0 };
+        uint32_t pixelDepth { 0 };
+        uint32_t layerCount { 0 };
+        uint32_t faceCount { 1 };
+        uint32_t levelCount { 1 };
+        uint32_t supercompressionScheme { (uint32_t)SupercompressionScheme::NONE };
+
+        uint32_t dfdByteOffset { 0 };
+        uint32_t dfdByteLength { 0 };
+        uint32_t kvdByteOffset { 0 };
+        uint32_t kvdByteLength { 0 };
+        uint64_t sgdByteOffset { 0 };
+        uint64_t sgdByteLength { 0 };
+
+        uint32_t getPixelWidth() const { return (pixelWidth ? pixelWidth : 1); }
+        uint32_t getPixelHeight() const { return (pixelHeight ? pixelHeight : 1); }
+        uint32_t getNumberOfLevels() const { return (levelCount ? levelCount : 1); }
+        SupercompressionScheme getSupercompressionScheme() const { return (SupercompressionScheme)supercompressionScheme; }
+    };
+
+    // Size as specified by the KTX2 specification
+    static const size_t KTX2_HEADER_SIZE { 80 };
+    static_assert(sizeof(KTX2Header) == KTX2_HEADER_SIZE, "KTX2 Header size is static and should not change from the spec");
+
+    struct KTX2Level {
+        // The byte offset from the start of the file
+        uint64_t byteOffset { 0 };
+        uint64_t byteLength { 0 };
+        uint64_t uncompressedByteLength { 0 };
+    };
+    static const size_t KTX2_LEVEL_SIZE { 24 };
+    static_assert(sizeof(KTX2Level) == KTX2_LEVEL_SIZE, "KTX2 level index entry size is static and should not change from the spec");
+
+    class KTX2 {
+        KTX2() {}
+    public:
+        using Bytes = std::vector<Byte>;
+        // The data of each level, level 0 (the largest) first
+        using LevelBytes = std::vector<Bytes>;
+
+        // Returns true if src starts with the KTX2 identifier, unlike checkIdentifier this doesn't throw
+        static bool checkIdentifier(size_t srcSize, const Byte* srcBytes);
+
+        // Parse a block of memory and create a KTX2 object from it, or nullptr if it isn't a valid KTX2 file
+        static std::unique_ptr<KTX2> create(const StoragePointer& src);
+
+        // Lay out a KTX2 file from its parts, the offsets and lengths of the header are filled in here
+        static std::unique_ptr<KTX2> create(const KTX2Header& header, const Bytes& dataFormatDescriptor, const LevelBytes& levels,
+                                            const KeyValues& keyValues = KeyValues(), const Bytes& supercompressionGlobalData = Bytes());
+
+        const KTX2Header& getHeader() const { return _header; }
+        const std::vector<KTX2Level>& getLevels() const { return _levels; }
+        const KeyValues& getKeyValues() const { return _keyValues; }
+        const StoragePointer& getStorage() const { return _storage; }
+
+        storage::StoragePointer getDataFormatDescriptor() const;
+        storage::StoragePointer getSupercompressionGlobalData() const;
+        storage::StoragePointer getLevelData(uint32_t level) const;
+
+        // The color model of the first data format descriptor block, ETC1S or UASTC for the Basis Universal formats
+        ColorModel getColorModel() const;
+        // The byte size of a texel block, from the data format descriptor
+        uint32_t getTexelBlockByteSize() const;
+
+        bool isBasisUniversal() const;
+        // Returns true if the level data must be decompressed or transcoded before it can be uploaded
+        bool requiresTranscoding() const;
+
+    private:
+        KTX2Header _header;
+        StoragePointer _storage;
+        std::vector<KTX2Level> _levels;
+        KeyValues _keyValues;
+    };
+
+}
+
+#endif // overte_ktx_KTX2_h
@@ -24,7 +24,10 @@ const int KTXCache::INVALID_VERSION = 0x00;
 const char* KTXCache::SETTING_VERSION_NAME = "hifi.ktx.cache_version";
 
 KTXCache::KTXCache(const std::string& dir, const std::string& ext) :
-    FileCache(dir, ext) { }
+    FileCache(dir, ext) {
+    // the textures share their disk space with the downloads they were made from
+    setSharedBudget(cache::getResourceBudget());
+}
 
 void KTXCache::initialize() {
     FileCache::initialize();
@@ -254,9 +254,12 @@ NetworkTexturePointer TextureCache::getTexture(const QUrl& url, image::TextureUs
     if (url.scheme() == RESOURCE_SCHEME) {
         return getResourceTexture(url);
     }
-    QString decodedURL = QUrl::fromPercentEncoding(url.toEncoded());
-    if (decodedURL.startsWith("{")) {
-        return getTextureByUUID(decodedURL);
+    // the entity IDs have no scheme, checking that first saves decoding the URLs of every other texture
+    if (url.scheme().isEmpty()) {
+        QString decodedURL = QUrl::fromPercentEncoding(url.toEncoded());
+        if (decodedURL.startsWith("{")) {
+            return getTextureByUUID(decodedURL);
+        }
     }
     auto modifiedUrl = url;
     if (type == image::TextureUsage::SKY_TEXTURE) {
@@ -20,6 +20,8 @@
 #include "CalculateBlendshapeTangentsTask.h"
 #include "PrepareJointsTask.h"
 #include "BuildDracoMeshTask.h"
+#include "BuildMeshLODsTask.h"
+#include "ReorderMeshesTask.h"
 #include "ParseFlowDataTask.h"
 
 namespace baker {
@@ -47,7 +49,7 @@ namespace baker {
 
     class BuildBlendshapesTask {
     public:
-        using Input = VaryingSet3<BlendshapesPerMesh, std::vector<NormalsPerBlendshape>, std::vector<TangentsPerBlendshape>>;
+        using Input = VaryingSet4<BlendshapesPerMesh, std::vector<NormalsPerBlendshape>, std::vector<TangentsPerBlendshape>, std::vector<hfm::Mesh>>;
         using Output = BlendshapesPerMesh;
         using JobModel = Job::ModelIO<BuildBlendshapesTask, Input, Output>;
 
@@ -55,6 +57,7 @@ namespace baker {
             const auto& blendshapesPerMeshIn = input.get0();
             const auto& normalsPerBlendshapePerMesh = input.get1();
             const auto& tangentsPerBlendshapePerMesh = input.get2();
+            const auto& meshes = input.get3();
             auto& blendshapesPerMeshOut = output;
 
             blendshapesPerMeshOut = blendshapesPerMeshIn;
@@ -69,6 +72,7 @@ namespace baker {
                     auto& blendshape = blendshapesOut[j];
                     blendshape.normals = QVector<glm::vec3>(normals.begin(), normals.end());
                     blendshape.tangents = QVector<glm::vec3>(tangents.begin(), tangents.end());
+                    sortBlendshape(blendshape, safeGet(meshes, i).vertices.size());
                 }
             }
         }
@@ -136,12 +140,18 @@ namespace baker {
 
             // Split up the inputs from hfm::Model
             const auto modelPartsIn = model.addJob<GetModelPartsTask>("GetModelParts", hfmModelIn);
-            const auto meshesIn = modelPartsIn.getN<GetModelPartsTask::Output>(0);
+            const auto meshesParsed = modelPartsIn.getN<GetModelPartsTask::Output>(0);
             const auto url = modelPartsIn.getN<GetModelPartsTask::Output>(1);
             const auto meshIndicesToModelNames = modelPartsIn.getN<GetModelPartsTask::Output>(2);
-            const auto blendshapesPerMeshIn = modelPartsIn.getN<GetModelPartsTask::Output>(3);
+            const auto blendshapesPerMeshParsed = modelPartsIn.getN<GetModelPartsTask::Output>(3);
             const auto jointsIn = modelPartsIn.getN<GetModelPartsTask::Output>(4);
 
+            // Reorder the triangles and vertices of the meshes for the GPU, before anything is computed per vertex
+            const auto reorderMeshesInputs = ReorderMeshesTask::Input(meshesParsed, blendshapesPerMeshParsed).asVarying();
+            const auto reorderMeshesOutputs = model.addJob<ReorderMeshesTask>("ReorderMeshes", reorderMeshesInputs);
+            const auto meshesIn = reorderMeshesOutputs.getN<ReorderMeshesTask::Output>(0);
+            const auto blendshapesPerMeshIn = reorderMeshesOutputs.getN<ReorderMeshesTask::Output>(1);
+
             // Calculate normals and tangents for meshes and blendshapes if they do not exist
             // Note: Normals are never calculated here for OBJ models. OBJ files optionally define normals on a per-face basis, so for consistency normals are calculated beforehand in OBJSerializer.
             const auto normalsPerMesh = model.addJob<CalculateMeshNormalsTask>("CalculateMeshNormals", meshesIn);
@@ -152,8 +162,11 @@ namespace baker {
             const auto calculateBlendshapeTangentsInputs = CalculateBlendshapeTangentsTask::Input(normalsPerBlendshapePerMesh, blendshapesPerMeshIn, meshesIn).asVarying();
             const auto tangentsPerBlendshapePerMesh = model.addJob<CalculateBlendshapeTangentsTask>("CalculateBlendshapeTangents", calculateBlendshapeTangentsInputs);
 
+            // Simplify the large meshes, for the graphics meshes to draw them with fewer triangles from a distance
+            const auto lodsPerMesh = model.addJob<BuildMeshLODsTask>("BuildMeshLODs", meshesIn);
+
             // Build the graphics::MeshPointer for each hfm::Mesh
-            const auto buildGraphicsMeshInputs = BuildGraphicsMeshTask::Input(meshesIn, url, meshIndicesToModelNames, normalsPerMesh, tangentsPerMesh).asVarying();
+            const auto buildGraphicsMeshInputs = BuildGraphicsMeshTask::Input(meshesIn, url, meshIndicesToModelNames, normalsPerMesh, tangentsPerMesh, lodsPerMesh).asVarying();
             const auto graphicsMeshes = model.addJob<BuildGraphicsMeshTask>("BuildGraphicsMesh", buildGraphicsMeshInputs);
 
             // Prepare joint information
@@ -182,7 +195,7 @@ namespace baker {
             const auto flowData = model.addJob<ParseFlowDataTask>("ParseFlowData", mapping);
 
             // Combine the outputs into a new hfm::Model
-            const auto buildBlendshapesInputs = BuildBlendshapesTask::Input(blendshapesPerMeshIn, normalsPerBlendshapePerMesh, tangentsPerBlendshapePerMesh).asVarying();
+            const auto buildBlendshapesInputs = BuildBlendshapesTask::Input(blendshapesPerMeshIn, normalsPerBlendshapePerMesh, tangentsPerBlendshapePerMesh, meshesIn).asVarying();
             const auto blendshapesPerMeshOut = model.addJob<BuildBlendshapesTask>("BuildBlendshapes", buildBlendshapesInputs);
             const auto buildMeshesInputs = BuildMeshesTask::Input(meshesIn, graphicsMeshes, normalsPerMesh, tangentsPerMesh, blendshapesPerMeshOut).asVarying();
             const auto meshesOut = model.addJob<BuildMeshesTask>("BuildMeshes", buildMeshesInputs);
@@ -36,6 +36,16 @@ namespace baker {
     using TangentsPerBlendshape = std::vector<std::vector<glm::vec3>>;
 
     using MeshIndicesToModelNames = QHash<int, QString>;
+
+    // A simplified version of a mesh, with the triangles of each of its parts ordered meshlet by meshlet
+    struct MeshLOD {
+        float error { 0.0f };
+        std::vector<MeshIndices> partIndices;
+        // the start indices count from the first index of the first part
+        std::vector<graphics::Mesh::Meshlet> meshlets;
+    };
+    using MeshLODs = std::vector<MeshLOD>;
+    using LODsPerMesh = std::vector<MeshLODs>;
 };
 
 #endif // hifi_BakerTypes_h
@@ -14,6 +14,7 @@
 #include <glm/gtc/packing.hpp>
 
 #include <LogHandler.h>
+#include <TBBHelpers.h>
 #include "ModelBakerLogging.h"
 #include "ModelMath.h"
 
@@ -27,7 +28,7 @@ glm::vec3 normalizeDirForPacking(const glm::vec3& dir) {
     return dir;
 }
 
-void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphicsMeshPointer, const baker::MeshNormals& meshNormals, const baker::MeshTangents& meshTangentsIn) {
+void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphicsMeshPointer, const baker::MeshNormals& meshNormals, const baker::MeshTangents& meshTangentsIn, const baker::MeshLODs& meshLODs) {
     auto graphicsMesh = std::make_shared<graphics::Mesh>();
 
     // Fill tangents with a dummy value to force tangents to be present if there are normals
@@ -319,8 +320,16 @@ void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphics
         return;
     }
 
+    // The LODs follow the full mesh in the index buffer
+    unsigned int totalLODIndices = 0;
+    for (const auto& meshLOD : meshLODs) {
+        for (const auto& partIndices : meshLOD.partIndices) {
+            totalLODIndices += (unsigned int)partIndices.size();
+        }
+    }
+
     auto indexBuffer = std::make_shared<gpu::Buffer>();
-    indexBuffer->resize(totalIndices * sizeof(int));
+    indexBuffer->resize((totalIndices + totalLODIndices) * sizeof(int));
 
     int indexNum = 0;
     int offset = 0;
@@ -353,6 +362,30 @@ void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphics
         parts.push_back(modelPart);
     }
 
+    graphics::Mesh::LODs lods;
+    for (const auto& meshLOD : meshLODs) {
+        if (meshLOD.partIndices.size() != parts.size()) {
+            continue;
+        }
+        graphics::Mesh::LOD lod;
+        lod._error = meshLOD.error;
+        int lodStartIndex = indexNum;
+        for (const auto& partIndices : meshLOD.partIndices) {
+            lod._parts.emplace_back(indexNum, (graphics::Index)partIndices.size(), 0, graphics::Mesh::TRIANGLES);
+            if (!partIndices.empty()) {
+                indexBuffer->setSubData(offset, partIndices.size() * sizeof(int), (gpu::Byte*) partIndices.data());
+                offset += (int)partIndices.size() * sizeof(int);
+                indexNum += (int)partIndices.size();
+            }
+        }
+        for (auto meshlet : meshLOD.meshlets) {
+            meshlet._startIndex += lodStartIndex;
+            lod._meshlets.push_back(meshlet);
+        }
+        lods.push_back(lod);
+    }
+    graphicsMesh->setLODs(lods);
+
     gpu::BufferView indexBufferView(indexBuffer, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::XYZ));
     graphicsMesh->setIndexBuffer(indexBufferView);
 
@@ -377,23 +410,25 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
     const auto& meshIndicesToModelNames = input.get2();
     const auto& normalsPerMesh = input.get3();
     const auto& tangentsPerMesh = input.get4();
+    const auto& lodsPerMesh = input.get5();
 
     auto& graphicsMeshes = output;
 
-    int n = (int)meshes.size();
-    for (int i = 0; i < n; i++) {
-        graphicsMeshes.emplace_back();
+    // the meshes are built independently of each other
+    graphicsMeshes.resize(meshes.size());
+    tbb::parallel_for((size_t)0, meshes.size(), [&](size_t i) {
         auto& graphicsMesh = graphicsMeshes[i];
-        
+
+
         // Try to create the graphics::Mesh
-        buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i));
+        buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i), baker::safeGet(lodsPerMesh, i));
 
         // Choose a name for the mesh
         if (graphicsMesh) {
             graphicsMesh->displayName = url.toString().toStdString() + "#/mesh/" + std::to_string(i);
-            if (meshIndicesToModelNames.find(i) != meshIndicesToModelNames.cend()) {
-                graphicsMesh->modelName = meshIndicesToModelNames[i].toStdString();
+            if (meshIndicesToModelNames.find((int)i) != meshIndicesToModelNames.cend()) {
+                graphicsMesh->modelName = meshIndicesToModelNames[(int)i].toStdString();
             }
         }
-    }
+    });
 }
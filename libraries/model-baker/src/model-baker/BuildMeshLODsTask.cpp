@@ -0,0 +1,557 @@
+//
+//  BuildMeshLODsTask.cpp
+//  model-baker/src/model-baker
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BuildMeshLODsTask.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <queue>
+#include <unordered_map>
+
+#include <TBBHelpers.h>
+
+namespace {
+
+// each level has about this fraction of the triangles of the one before
+const float LOD_TRIANGLES_RATIO = 0.5f;
+// the chain stops before a level would have fewer triangles
+const int MIN_LOD_TRIANGLES = 128;
+const int MAX_LODS = 6;
+
+// The weighted sum of the squared distances to a set of planes, as a symmetric 4x4 matrix
+struct Quadric {
+    double a2 { 0.0 }, ab { 0.0 }, ac { 0.0 }, ad { 0.0 };
+    double b2 { 0.0 }, bc { 0.0 }, bd { 0.0 };
+    double c2 { 0.0 }, cd { 0.0 };
+    double d2 { 0.0 };
+    double weight { 0.0 };
+
+    void addPlane(const glm::dvec3& n, double d, double w) {
+        a2 += w * n.x * n.x; ab += w * n.x * n.y; ac += w * n.x * n.z; ad += w * n.x * d;
+        b2 += w * n.y * n.y; bc += w * n.y * n.z; bd += w * n.y * d;
+        c2 += w * n.z * n.z; cd += w * n.z * d;
+        d2 += w * d * d;
+        weight += w;
+    }
+
+    void add(const Quadric& other) {
+        a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+        b2 += other.b2; bc += other.bc; bd += other.bd;
+        c2 += other.c2; cd += other.cd;
+        d2 += other.d2;
+        weight += other.weight;
+    }
+
+    // the mean squared distance of p to the planes
+    double evaluate(const glm::dvec3& p) const {
+        double sum = a2 * p.x * p.x + 2.0 * ab * p.x * p.y + 2.0 * ac * p.x * p.z + 2.0 * ad * p.x +
+            b2 * p.y * p.y + 2.0 * bc * p.y * p.z + 2.0 * bd * p.y +
+            c2 * p.z * p.z + 2.0 * cd * p.z + d2;
+        return weight > 0.0 ? std::max(0.0, sum / weight) : 0.0;
+    }
+};
+
+struct Triangle {
+    int vertices[3];
+    int part;
+    bool alive { true };
+
+    bool contains(int vertex) const {
+        return vertices[0] == vertex || vertices[1] == vertex || vertices[2] == vertex;
+    }
+};
+
+// Moving vertex from onto vertex to, the cost is evaluated with the versions of both vertices it was pushed with
+struct Collapse {
+    double cost;
+    int from;
+    int to;
+    uint32_t fromVersion;
+    uint32_t toVersion;
+
+    bool operator<(const Collapse& other) const { return cost > other.cost; }
+};
+
+class MeshSimplifier {
+public:
+    MeshSimplifier(const hfm::Mesh& mesh);
+
+    bool isValid() const { return _numAliveTriangles > 0; }
+    baker::MeshLODs build();
+
+private:
+    glm::dvec3 getPosition(int vertex) const { return glm::dvec3(_positions[vertex]); }
+    void lockBoundaries();
+    void pushCollapses(int vertex, bool towardVertex);
+    void pushCollapse(int from, int to);
+    bool canCollapse(int from, int to) const;
+    void collapse(int from, int to);
+    baker::MeshLOD takeLevel(float error) const;
+
+    const QVector<glm::vec3>& _positions;
+    int _numParts;
+    std::vector<Triangle> _triangles;
+    int _numAliveTriangles { 0 };
+    std::vector<std::vector<int>> _vertexTriangles;
+    std::vector<Quadric> _quadrics;
+    std::vector<uint32_t> _versions;
+    std::vector<bool> _locked;
+    std::vector<bool> _removed;
+    std::priority_queue<Collapse> _collapses;
+    std::vector<int> _neighbors;
+};
+
+MeshSimplifier::MeshSimplifier(const hfm::Mesh& mesh) :
+    _positions(mesh.vertices),
+    _numParts(mesh.parts.size())
+{
+    // the triangles in the order the graphics mesh draws them
+    int numVertices = _positions.size();
+    for (int partIndex = 0; partIndex < _numParts; partIndex++) {
+        const auto& part = mesh.parts[partIndex];
+        for (const auto* indices : { &part.quadTrianglesIndices, &part.triangleIndices }) {
+            for (int i = 0; i + 2 < indices->size(); i += 3) {
+                Triangle triangle;
+                triangle.part = partIndex;
+                for (int j = 0; j < 3; j++) {
+                    int vertex = (*indices)[i + j];
+                    if (vertex < 0 || vertex >= numVertices) {
+                        _triangles.clear();
+                        return;
+                    }
+                    triangle.vertices[j] = vertex;
+                }
+                _triangles.push_back(triangle);
+            }
+        }
+    }
+    _numAliveTriangles = (int)_triangles.size();
+
+    _vertexTriangles.resize(numVertices);
+    _quadrics.resize(numVertices);
+    _versions.resize(numVertices, 0);
+    _locked.resize(numVertices, false);
+    _removed.resize(numVertices, false);
+    for (int t = 0; t < (int)_triangles.size(); t++) {
+        const auto& triangle = _triangles[t];
+        glm::dvec3 a = getPosition(triangle.vertices[0]);
+        glm::dvec3 normal = glm::cross(getPosition(triangle.vertices[1]) - a, getPosition(triangle.vertices[2]) - a);
+        double length = glm::length(normal);
+        for (int vertex : triangle.vertices) {
+            _vertexTriangles[vertex].push_back(t);
+            if (length > 0.0) {
+                glm::dvec3 n = normal / length;
+                // weighted by area, so the error doesn't depend on how finely the surface was tessellated
+                _quadrics[vertex].addPlane(n, -glm::dot(n, a), 0.5 * length);
+            }
+        }
+    }
+    lockBoundaries();
+}
+
+void MeshSimplifier::lockBoundaries() {
+    // the seams, where vertices share a position to split their attributes, would tear if one side moved without the other
+    std::vector<int> byPosition(_positions.size());
+    for (int i = 0; i < (int)byPosition.size(); i++) {
+        byPosition[i] = i;
+    }
+    auto lessPosition = [this](int a, int b) {
+        const auto& pa = _positions[a];
+        const auto& pb = _positions[b];
+        return pa.x != pb.x ? pa.x < pb.x : (pa.y != pb.y ? pa.y < pb.y : pa.z < pb.z);
+    };
+    std::sort(byPosition.begin(), byPosition.end(), lessPosition);
+    for (int i = 1; i < (int)byPosition.size(); i++) {
+        if (_positions[byPosition[i]] == _positions[byPosition[i - 1]]) {
+            _locked[byPosition[i]] = true;
+            _locked[byPosition[i - 1]] = true;
+        }
+    }
+
+    // so would the borders and any non-manifold edge, the edges that don't have exactly two triangles
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(_triangles.size() * 3);
+    for (const auto& triangle : _triangles) {
+        for (int j = 0; j < 3; j++) {
+            int a = triangle.vertices[j];
+            int b = triangle.vertices[(j + 1) % 3];
+            edges.emplace_back(std::min(a, b), std::max(a, b));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    for (size_t i = 0; i < edges.size();) {
+        size_t j = i + 1;
+        while (j < edges.size() && edges[j] == edges[i]) {
+            j++;
+        }
+        if (j - i != 2) {
+            _locked[edges[i].first] = true;
+            _locked[edges[i].second] = true;
+        }
+        i = j;
+    }
+
+    // and the vertices between parts, the materials would bleed
+    for (int vertex = 0; vertex < (int)_vertexTriangles.size(); vertex++) {
+        const auto& triangles = _vertexTriangles[vertex];
+        for (int t : triangles) {
+            if (_triangles[t].part != _triangles[triangles.front()].part) {
+                _locked[vertex] = true;
+                break;
+            }
+        }
+    }
+}
+
+void MeshSimplifier::pushCollapse(int from, int to) {
+    if (_locked[from]) {
+        return;
+    }
+    Quadric quadric = _quadrics[from];
+    quadric.add(_quadrics[to]);
+    double cost = quadric.evaluate(getPosition(to));
+    _collapses.push({ cost, from, to, _versions[from], _versions[to] });
+}
+
+void MeshSimplifier::pushCollapses(int vertex, bool towardVertex) {
+    // drop the triangles collapsed away first, the list is walked at every change around the vertex
+    auto& triangles = _vertexTriangles[vertex];
+    triangles.erase(std::remove_if(triangles.begin(), triangles.end(), [this](int t) { return !_triangles[t].alive; }),
+                    triangles.end());
+
+    _neighbors.clear();
+    for (int t : triangles) {
+        for (int neighbor : _triangles[t].vertices) {
+            if (neighbor != vertex) {
+                _neighbors.push_back(neighbor);
+            }
+        }
+    }
+    std::sort(_neighbors.begin(), _neighbors.end());
+    _neighbors.erase(std::unique(_neighbors.begin(), _neighbors.end()), _neighbors.end());
+    for (int neighbor : _neighbors) {
+        pushCollapse(vertex, neighbor);
+        if (towardVertex) {
+            pushCollapse(neighbor, vertex);
+        }
+    }
+}
+
+bool MeshSimplifier::canCollapse(int from, int to) const {
+    // reject the collapses that would fold a triangle over
+    glm::dvec3 target = getPosition(to);
+    for (int t : _vertexTriangles[from]) {
+        const auto& triangle = _triangles[t];
+        if (!triangle.alive || triangle.contains(to)) {
+            continue;
+        }
+        glm::dvec3 before[3];
+        glm::dvec3 after[3];
+        for (int j = 0; j < 3; j++) {
+            before[j] = getPosition(triangle.vertices[j]);
+            after[j] = triangle.vertices[j] == from ? target : before[j];
+        }
+        glm::dvec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+        glm::dvec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+        if (glm::dot(normalBefore, normalAfter) <= 0.0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MeshSimplifier::collapse(int from, int to) {
+    for (int t : _vertexTriangles[from]) {
+        auto& triangle = _triangles[t];
+        if (!triangle.alive) {
+            continue;
+        }
+        if (triangle.contains(to)) {
+            triangle.alive = false;
+            _numAliveTriangles--;
+        } else {
+            for (int& vertex : triangle.vertices) {
+                if (vertex == from) {
+                    vertex = to;
+                }
+            }
+            _vertexTriangles[to].push_back(t);
+        }
+    }
+    _vertexTriangles[from].clear();
+    _removed[from] = true;
+    _quadrics[to].add(_quadrics[from]);
+    _versions[to]++;
+}
+
+baker::MeshLOD MeshSimplifier::takeLevel(float error) const {
+    baker::MeshLOD level;
+    level.error = error;
+    level.partIndices.resize(_numParts);
+    for (const auto& triangle : _triangles) {
+        if (triangle.alive) {
+            auto& indices = level.partIndices[triangle.part];
+            indices.insert(indices.end(), triangle.vertices, triangle.vertices + 3);
+        }
+    }
+    graphics::Index startIndex = 0;
+    for (auto& indices : level.partIndices) {
+        auto meshlets = baker::buildMeshlets(_positions, indices, startIndex);
+        level.meshlets.insert(level.meshlets.end(), meshlets.begin(), meshlets.end());
+        startIndex += (graphics::Index)indices.size();
+    }
+    return level;
+}
+
+baker::MeshLODs MeshSimplifier::build() {
+    baker::MeshLODs levels;
+    // every edge, in both directions
+    for (int vertex = 0; vertex < (int)_vertexTriangles.size(); vertex++) {
+        pushCollapses(vertex, false);
+    }
+
+    int previousTriangles = _numAliveTriangles;
+    int targetTriangles = (int)(previousTriangles * LOD_TRIANGLES_RATIO);
+    double maxCost = 0.0;
+    while ((int)levels.size() < MAX_LODS && targetTriangles >= MIN_LOD_TRIANGLES) {
+        bool exhausted = _collapses.empty();
+        if (!exhausted) {
+            auto next = _collapses.top();
+            _collapses.pop();
+            if (_removed[next.from] || _removed[next.to] || next.fromVersion != _versions[next.from] ||
+                next.toVersion != _versions[next.to] || !canCollapse(next.from, next.to)) {
+                continue;
+            }
+            collapse(next.from, next.to);
+            maxCost = std::max(maxCost, next.cost);
+            // the costs of the edges around the vertex collapsed onto changed with its quadric
+            pushCollapses(next.to, true);
+        }
+
+        if (_numAliveTriangles <= targetTriangles || exhausted) {
+            // the last level, when nothing else can collapse, is only kept if it saves enough to be worth drawing
+            const float MIN_EXHAUSTED_RATIO = 0.9f;
+            if (!exhausted || _numAliveTriangles < previousTriangles * MIN_EXHAUSTED_RATIO) {
+                // the quadrics hold squared distances to the planes of the full mesh triangles
+                levels.push_back(takeLevel((float)sqrt(maxCost)));
+                previousTriangles = _numAliveTriangles;
+            }
+            if (exhausted) {
+                break;
+            }
+            targetTriangles = (int)(previousTriangles * LOD_TRIANGLES_RATIO);
+        }
+    }
+    return levels;
+}
+
+}
+
+baker::MeshLODs baker::buildMeshLODs(const hfm::Mesh& mesh) {
+    int numTriangles = 0;
+    for (const auto& part : mesh.parts) {
+        numTriangles += (part.quadTrianglesIndices.size() + part.triangleIndices.size()) / 3;
+    }
+    if (numTriangles < MIN_LOD_MESH_TRIANGLES) {
+        return MeshLODs();
+    }
+
+    MeshSimplifier simplifier(mesh);
+    if (!simplifier.isValid()) {
+        return MeshLODs();
+    }
+    return simplifier.build();
+}
+
+std::vector<graphics::Mesh::Meshlet> baker::buildMeshlets(const QVector<glm::vec3>& positions, MeshIndices& indices,
+                                                          graphics::Index startIndex) {
+    using Meshlet = graphics::Mesh::Meshlet;
+    std::vector<Meshlet> meshlets;
+    int numTriangles = (int)indices.size() / 3;
+    if (numTriangles == 0) {
+        return meshlets;
+    }
+
+    // the triangles around each vertex, numbered in the order they're first used
+    std::unordered_map<int, int> localVertices;
+    std::vector<std::vector<int>> vertexTriangles;
+    std::vector<int> triangleVertices(numTriangles * 3);
+    for (int i = 0; i < numTriangles * 3; i++) {
+        auto inserted = localVertices.emplace(indices[i], (int)localVertices.size());
+        if (inserted.second) {
+            vertexTriangles.emplace_back();
+        }
+        triangleVertices[i] = inserted.first->second;
+        vertexTriangles[inserted.first->second].push_back(i / 3);
+    }
+
+    MeshIndices ordered;
+    ordered.reserve(indices.size());
+    std::vector<bool> used(numTriangles, false);
+    // the last meshlet each vertex was added to
+    std::vector<int> vertexMeshlet(vertexTriangles.size(), -1);
+    std::vector<int> meshletVertices;
+    std::deque<int> candidates;
+    for (int seed = 0; seed < numTriangles; seed++) {
+        if (used[seed]) {
+            continue;
+        }
+        int meshletID = (int)meshlets.size();
+        Meshlet meshlet;
+        meshlet._startIndex = startIndex + (graphics::Index)ordered.size();
+        meshletVertices.clear();
+
+        // grow the meshlet across the edges of its triangles, the ones that would take too many vertices are left for the next
+        int numMeshletTriangles = 0;
+        candidates.clear();
+        candidates.push_back(seed);
+        while (!candidates.empty() && numMeshletTriangles < Meshlet::MAX_MESHLET_TRIANGLES) {
+            int t = candidates.front();
+            candidates.pop_front();
+            if (used[t]) {
+                continue;
+            }
+            int newVertices = 0;
+            for (int j = 0; j < 3; j++) {
+                newVertices += vertexMeshlet[triangleVertices[t * 3 + j]] != meshletID ? 1 : 0;
+            }
+            if ((int)meshletVertices.size() + newVertices > Meshlet::MAX_MESHLET_VERTICES) {
+                continue;
+            }
+
+            used[t] = true;
+            numMeshletTriangles++;
+            for (int j = 0; j < 3; j++) {
+                int vertex = triangleVertices[t * 3 + j];
+                ordered.push_back(indices[t * 3 + j]);
+                if (vertexMeshlet[vertex] != meshletID) {
+                    vertexMeshlet[vertex] = meshletID;
+                    meshletVertices.push_back(indices[t * 3 + j]);
+                    for (int neighbor : vertexTriangles[vertex]) {
+                        if (!used[neighbor]) {
+                            candidates.push_back(neighbor);
+                        }
+                    }
+                }
+            }
+        }
+
+        meshlet._numIndices = (graphics::Index)(numMeshletTriangles * 3);
+        glm::vec3 minimum = positions[meshletVertices.front()];
+        glm::vec3 maximum = minimum;
+        for (int vertex : meshletVertices) {
+            minimum = glm::min(minimum, positions[vertex]);
+            maximum = glm::max(maximum, positions[vertex]);
+        }
+        meshlet._center = 0.5f * (minimum + maximum);
+        for (int vertex : meshletVertices) {
+            meshlet._radius = std::max(meshlet._radius, glm::distance(meshlet._center, positions[vertex]));
+        }
+        meshlets.push_back(meshlet);
+    }
+
+    indices.swap(ordered);
+    return meshlets;
+}
+
+void BuildMeshLODsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
+    const auto& meshes = input;
+    auto& lodsPerMesh = output;
+
+    lodsPerMesh.resize(meshes.size());
+    tbb::parallel_for((size_t)0, meshes.size(), [&](size_t i) {
+        lodsPerMesh[i] = baker::buildMeshLODs(meshes[i]);
+    });
+}
+
+// Moves the values of a per vertex attribute of the used vertices to their new indices
+template <typename T>
+static void remapVertexAttribute(QVector<T>& attribute, const std::vector<int>& remap, int numUsedVertices) {
+    const int numVertices = (int)remap.size();
+    if (attribute.isEmpty() || attribute.size() % numVertices != 0) {
+        return;
+    }
+    const int valuesPerVertex = attribute.size() / numVertices;
+    QVector<T> remapped(numUsedVertices * valuesPerVertex);
+    for (int i = 0; i < numVertices; i++) {
+        if (remap[i] != -1) {
+            std::copy(attribute.constBegin() + i * valuesPerVertex, attribute.constBegin() + (i + 1) * valuesPerVertex,
+                      remapped.begin() + remap[i] * valuesPerVertex);
+        }
+    }
+    attribute.swap(remapped);
+}
+
+// Replaces the triangles of mesh with those of its coarsest LOD, and drops the vertices they don't use anymore
+static void reduceToCoarsestLOD(hfm::Mesh& mesh) {
+    auto lods = baker::buildMeshLODs(mesh);
+    if (lods.empty() || lods.back().partIndices.size() != (size_t)mesh.parts.size()) {
+        return;
+    }
+
+    const int numVertices = mesh.vertices.size();
+    std::vector<int> remap(numVertices, -1);
+    int numUsedVertices = 0;
+    const auto& coarsest = lods.back();
+    for (int i = 0; i < mesh.parts.size(); i++) {
+        auto& part = mesh.parts[i];
+        part.quadIndices.clear();
+        part.quadTrianglesIndices.clear();
+        part.triangleIndices.clear();
+        part.triangleIndices.reserve((int)coarsest.partIndices[i].size());
+        for (int index : coarsest.partIndices[i]) {
+            if (remap[index] == -1) {
+                remap[index] = numUsedVertices++;
+            }
+            part.triangleIndices.push_back(remap[index]);
+        }
+    }
+
+    remapVertexAttribute(mesh.vertices, remap, numUsedVertices);
+    remapVertexAttribute(mesh.normals, remap, numUsedVertices);
+    remapVertexAttribute(mesh.tangents, remap, numUsedVertices);
+    remapVertexAttribute(mesh.colors, remap, numUsedVertices);
+    remapVertexAttribute(mesh.texCoords, remap, numUsedVertices);
+    remapVertexAttribute(mesh.texCoords1, remap, numUsedVertices);
+    remapVertexAttribute(mesh.clusterIndices, remap, numUsedVertices);
+    remapVertexAttribute(mesh.clusterWeights, remap, numUsedVertices);
+    remapVertexAttribute(mesh.originalIndices, remap, numUsedVertices);
+}
+
+hfm::Model::Pointer baker::buildPreviewModel(const hfm::Model& model) {
+    for (const auto& mesh : model.meshes) {
+        // the skinned and blended vertices of the model would not match those of its preview
+        if (mesh.clusters.size() > 1 || !mesh.blendshapes.empty()) {
+            return nullptr;
+        }
+    }
+
+    // the extents are kept from the model, so that the preview has its dimensions
+    auto preview = std::make_shared<hfm::Model>(model);
+    // detached once here, rather than by each thread
+    hfm::Mesh* meshes = preview->meshes.data();
+    tbb::parallel_for(0, preview->meshes.size(), [&](int i) {
+        reduceToCoarsestLOD(meshes[i]);
+        meshes[i]._mesh.reset();
+    });
+
+    // the textures are loaded with the model
+    for (auto& material : preview->materials) {
+        for (auto* texture : { &material.normalTexture, &material.albedoTexture, &material.opacityTexture,
+                               &material.glossTexture, &material.roughnessTexture, &material.specularTexture,
+                               &material.metallicTexture, &material.emissiveTexture, &material.occlusionTexture,
+                               &material.scatteringTexture, &material.lightmapTexture }) {
+            *texture = hfm::Texture();
+        }
+    }
+    return preview;
+}
@@ -0,0 +1,45 @@
+//
+//  BuildMeshLODsTask.h
+//  model-baker/src/model-baker
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_BuildMeshLODsTask_h
+#define overte_BuildMeshLODsTask_h
+
+#include <hfm/HFM.h>
+
+#include "Engine.h"
+#include "BakerTypes.h"
+
+// Simplify the large meshes into a chain of LODs, by quadric error edge collapses onto their own vertices
+class BuildMeshLODsTask {
+public:
+    using Input = std::vector<hfm::Mesh>;
+    using Output = baker::LODsPerMesh;
+    using JobModel = baker::Job::ModelIO<BuildMeshLODsTask, Input, Output>;
+
+    void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
+};
+
+namespace baker {
+    // meshes with fewer triangles are drawn at full detail
+    const int MIN_LOD_MESH_TRIANGLES = 1024;
+
+    MeshLODs buildMeshLODs(const hfm::Mesh& mesh);
+
+    // Returns a copy of model with its meshes reduced to their coarsest LOD and its materials without textures, drawn
+    // while the model itself loads, or nullptr if the model is skinned or has blendshapes
+    hfm::Model::Pointer buildPreviewModel(const hfm::Model& model);
+
+    // Reorders the triangles of indices meshlet by meshlet, and returns the meshlets, their start indices offset by startIndex
+    std::vector<graphics::Mesh::Meshlet> buildMeshlets(const QVector<glm::vec3>& positions, MeshIndices& indices,
+                                                       graphics::Index startIndex);
+};
+
+#endif // overte_BuildMeshLODsTask_h
@@ -11,6 +11,8 @@
 
 #include "CalculateBlendshapeNormalsTask.h"
 
+#include <TBBHelpers.h>
+
 #include "ModelMath.h"
 
 void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
@@ -18,12 +20,11 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
     const auto& meshes = input.get1();
     auto& normalsPerBlendshapePerMeshOut = output;
 
-    normalsPerBlendshapePerMeshOut.reserve(blendshapesPerMesh.size());
-    for (size_t i = 0; i < blendshapesPerMesh.size(); i++) {
+    normalsPerBlendshapePerMeshOut.resize(blendshapesPerMesh.size());
+    tbb::parallel_for((size_t)0, blendshapesPerMesh.size(), [&](size_t i) {
         const auto& mesh = meshes[i];
         const auto& blendshapes = blendshapesPerMesh[i];
-        normalsPerBlendshapePerMeshOut.emplace_back();
-        auto& normalsPerBlendshapeOut = normalsPerBlendshapePerMeshOut[normalsPerBlendshapePerMeshOut.size()-1];
+        auto& normalsPerBlendshapeOut = normalsPerBlendshapePerMeshOut[i];
 
         normalsPerBlendshapeOut.reserve(blendshapes.size());
         for (size_t j = 0; j < blendshapes.size(); j++) {
@@ -66,5 +67,5 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
                     });
             }
         }
-    }
+    });
 }
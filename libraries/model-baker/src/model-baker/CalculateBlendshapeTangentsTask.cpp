@@ -13,6 +13,8 @@
 
 #include <set>
 
+#include <TBBHelpers.h>
+
 #include "ModelMath.h"
 
 void CalculateBlendshapeTangentsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
@@ -21,13 +23,12 @@ void CalculateBlendshapeTangentsTask::run(const baker::BakeContextPointer& conte
     const auto& meshes = input.get2();
     auto& tangentsPerBlendshapePerMeshOut = output;
 
-    tangentsPerBlendshapePerMeshOut.reserve(normalsPerBlendshapePerMesh.size());
-    for (size_t i = 0; i < blendshapesPerMesh.size(); i++) {
+    tangentsPerBlendshapePerMeshOut.resize(blendshapesPerMesh.size());
+    tbb::parallel_for((size_t)0, blendshapesPerMesh.size(), [&](size_t i) {
         const auto& normalsPerBlendshape = baker::safeGet(normalsPerBlendshapePerMesh, i);
         const auto& blendshapes = blendshapesPerMesh[i];
         const auto& mesh = meshes[i];
-        tangentsPerBlendshapePerMeshOut.emplace_back();
-        auto& tangentsPerBlendshapeOut = tangentsPerBlendshapePerMeshOut[tangentsPerBlendshapePerMeshOut.size()-1];
+        auto& tangentsPerBlendshapeOut = tangentsPerBlendshapePerMeshOut[i];
 
         for (size_t j = 0; j < blendshapes.size(); j++) {
             const auto& blendshape = blendshapes[j];
@@ -80,5 +81,5 @@ void CalculateBlendshapeTangentsTask::run(const baker::BakeContextPointer& conte
                 }
             });
         }
-    }
+    });
 }
@@ -11,6 +11,8 @@
 
 #include "CalculateMeshTangentsTask.h"
 
+#include <TBBHelpers.h>
+
 #include "ModelMath.h"
 
 void CalculateMeshTangentsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
@@ -18,13 +20,12 @@ void CalculateMeshTangentsTask::run(const baker::BakeContextPointer& context, co
     const std::vector<hfm::Mesh>& meshes = input.get1();
     auto& tangentsPerMeshOut = output;
 
-    tangentsPerMeshOut.reserve(meshes.size());
-    for (int i = 0; i < (int)meshes.size(); i++) {
+    tangentsPerMeshOut.resize(meshes.size());
+    tbb::parallel_for((size_t)0, meshes.size(), [&](size_t i) {
         const auto& mesh = meshes[i];
         const auto& tangentsIn = mesh.tangents;
         const auto& normals = baker::safeGet(normalsPerMesh, i);
-        tangentsPerMeshOut.emplace_back();
-        auto& tangentsOut = tangentsPerMeshOut[tangentsPerMeshOut.size()-1];
+        auto& tangentsOut = tangentsPerMeshOut[i];
 
         // Check if we already have tangents and therefore do not need to do any calculation
         // Otherwise confirm if we have the normals and texcoords needed
@@ -42,5 +43,5 @@ void CalculateMeshTangentsTask::run(const baker::BakeContextPointer& context, co
                 return &(tangentsOut[firstIndex]);
             });
         }
-    }
+    });
 }
@@ -11,6 +11,8 @@
 
 #include "ModelMath.h"
 
+#include <algorithm>
+
 #include <LogHandler.h>
 #include "ModelBakerLogging.h"
 
@@ -117,5 +119,38 @@ namespace baker {
             }
         }
     }
-}
 
+    void sortBlendshape(hfm::Blendshape& blendshape, int numVertices) {
+        const glm::vec3 ZERO(0.0f);
+        bool hasTangents = !blendshape.tangents.empty();
+        std::vector<int> order;
+        order.reserve(blendshape.indices.size());
+        for (int i = 0; i < blendshape.indices.size() && i < blendshape.vertices.size(); i++) {
+            int index = blendshape.indices[i];
+            if (index < 0 || index >= numVertices) {
+                continue;
+            }
+            if (blendshape.vertices[i] == ZERO && safeGet(blendshape.normals, i) == ZERO && safeGet(blendshape.tangents, i) == ZERO) {
+                continue;
+            }
+            order.push_back(i);
+        }
+        std::stable_sort(order.begin(), order.end(), [&blendshape](int a, int b) {
+            return blendshape.indices[a] < blendshape.indices[b];
+        });
+
+        hfm::Blendshape sorted;
+        sorted.indices.reserve((int)order.size());
+        sorted.vertices.reserve((int)order.size());
+        sorted.normals.reserve((int)order.size());
+        for (int i : order) {
+            sorted.indices.push_back(blendshape.indices[i]);
+            sorted.vertices.push_back(blendshape.vertices[i]);
+            sorted.normals.push_back(safeGet(blendshape.normals, i));
+            if (hasTangents) {
+                sorted.tangents.push_back(safeGet(blendshape.tangents, i));
+            }
+        }
+        blendshape = sorted;
+    }
+}
@@ -53,4 +53,9 @@ namespace baker {
     using IndexAccessor = std::function<glm::vec3*(int firstIndex, int secondIndex, glm::vec3* outVertices, glm::vec2* outTexCoords, glm::vec3& outNormal)>;
 
     void calculateTangents(const hfm::Mesh& mesh, IndexAccessor accessor);
+
+    // Sorts the offsets of a blendshape by vertex and drops those that move nothing or name a vertex the mesh doesn't
+    // have, so that blending walks the vertices in order and only touches the ones the blendshape moves.
+    // The normals, and the tangents if there are any, are padded to one per offset.
+    void sortBlendshape(hfm::Blendshape& blendshape, int numVertices);
 };
@@ -27,6 +27,9 @@ public:
     using JobModel = baker::Job::ModelIO<ParseMaterialMappingTask, Input, Output>;
 
     void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
+
+    // Also used on its own by the models loaded already baked, the material mapping isn't stored with them
+    static MaterialMapping parseMaterialMapping(const hifi::VariantHash& mapping, const hifi::URL& url);
 };
 
 #endif // hifi_ParseMaterialMappingTask_h
\ No newline at end of file
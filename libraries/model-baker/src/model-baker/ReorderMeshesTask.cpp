@@ -0,0 +1,424 @@
+//
+//  ReorderMeshesTask.cpp
+//  model-baker/src/model-baker
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ReorderMeshesTask.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include <TBBHelpers.h>
+
+#include "ModelBakerLogging.h"
+
+namespace {
+
+// the size of the LRU cache the triangles are scored with, larger than the caches of most GPUs
+// so the order stays good on all of them
+const int VERTEX_CACHE_SIZE = 32;
+const float CACHE_DECAY_POWER = 1.5f;
+const float LAST_TRIANGLE_SCORE = 0.75f;
+const float VALENCE_BOOST_SCALE = 2.0f;
+const float VALENCE_BOOST_POWER = 0.5f;
+
+// the clusters sorted for overdraw are at least this large, so the vertex cache order is mostly kept
+const int MIN_OVERDRAW_CLUSTER_TRIANGLES = 64;
+
+float vertexScore(int cachePosition, int remainingValence) {
+    if (remainingValence == 0) {
+        // no triangle left to use it
+        return -1.0f;
+    }
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // used by the last triangle, the same score whichever way it's entered
+            score = LAST_TRIANGLE_SCORE;
+        } else {
+            const float scale = 1.0f / (VERTEX_CACHE_SIZE - 3);
+            score = powf(1.0f - (cachePosition - 3) * scale, CACHE_DECAY_POWER);
+        }
+    }
+
+    // favor the vertices with few triangles left, so they don't get stranded
+    score += VALENCE_BOOST_SCALE * powf((float)remainingValence, -VALENCE_BOOST_POWER);
+    return score;
+}
+
+bool areIndicesValid(const QVector<int>& indices, int numVertices) {
+    for (int index : indices) {
+        if (index < 0 || index >= numVertices) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+void remapVertices(QVector<T>& values, const std::vector<int>& newToOld) {
+    const int numVertices = (int)newToOld.size();
+    if (numVertices == 0 || values.size() % numVertices != 0) {
+        return;
+    }
+    // the per vertex attributes with several values per vertex, like the cluster indices, are moved by blocks
+    const int blockSize = values.size() / numVertices;
+    QVector<T> remapped;
+    remapped.resize(values.size());
+    for (int i = 0; i < numVertices; i++) {
+        std::copy_n(values.constBegin() + newToOld[i] * blockSize, blockSize, remapped.begin() + i * blockSize);
+    }
+    values = remapped;
+}
+
+void remapIndices(QVector<int>& indices, const std::vector<int>& oldToNew) {
+    for (auto& index : indices) {
+        if (index >= 0 && index < (int)oldToNew.size()) {
+            index = oldToNew[index];
+        }
+    }
+}
+
+}
+
+float baker::computeACMR(const MeshIndices& indices, int numVertices, int cacheSize) {
+    const int numTriangles = (int)indices.size() / 3;
+    if (numTriangles == 0) {
+        return 0.0f;
+    }
+
+    // a vertex is in the cache while fewer than cacheSize misses happened since it was loaded
+    std::vector<int> loadedAt(numVertices, -cacheSize - 1);
+    int misses = 0;
+    for (int i = 0; i < numTriangles * 3; i++) {
+        int index = indices[i];
+        if (index < 0 || index >= numVertices) {
+            continue;
+        }
+        if (misses - loadedAt[index] > cacheSize) {
+            loadedAt[index] = misses;
+            misses++;
+        }
+    }
+    return (float)misses / (float)numTriangles;
+}
+
+baker::MeshIndices baker::optimizeVertexCache(const MeshIndices& indices, int numVertices) {
+    const int numTriangles = (int)indices.size() / 3;
+    const int numIndices = numTriangles * 3;
+
+    // the triangles using each vertex, the ones still to be emitted are kept in front
+    std::vector<int> remainingValence(numVertices, 0);
+    for (int i = 0; i < numIndices; i++) {
+        remainingValence[indices[i]]++;
+    }
+    std::vector<int> triangleOffsets(numVertices + 1, 0);
+    std::partial_sum(remainingValence.begin(), remainingValence.end(), triangleOffsets.begin() + 1);
+    std::vector<int> vertexTriangles(numIndices);
+    {
+        std::vector<int> fill(triangleOffsets.begin(), triangleOffsets.end() - 1);
+        for (int i = 0; i < numIndices; i++) {
+            vertexTriangles[fill[indices[i]]++] = i / 3;
+        }
+    }
+
+    std::vector<int> cachePositions(numVertices, -1);
+    std::vector<float> vertexScores(numVertices);
+    for (int v = 0; v < numVertices; v++) {
+        vertexScores[v] = vertexScore(-1, remainingValence[v]);
+    }
+
+    std::vector<float> triangleScores(numTriangles);
+    std::vector<bool> emitted(numTriangles, false);
+    int bestTriangle = -1;
+    float bestScore = -1.0f;
+    for (int t = 0; t < numTriangles; t++) {
+        triangleScores[t] = vertexScores[indices[3 * t]] + vertexScores[indices[3 * t + 1]] + vertexScores[indices[3 * t + 2]];
+        if (triangleScores[t] > bestScore) {
+            bestScore = triangleScores[t];
+            bestTriangle = t;
+        }
+    }
+
+    MeshIndices result;
+    result.reserve(numIndices);
+    std::vector<int> cache;
+    std::vector<int> newCache;
+    cache.reserve(VERTEX_CACHE_SIZE + 3);
+    newCache.reserve(VERTEX_CACHE_SIZE + 3);
+    int nextTriangle = 0;
+    while ((int)result.size() < numIndices) {
+        if (bestTriangle < 0) {
+            // nothing left around the cache, start over from the first triangle not emitted
+            while (emitted[nextTriangle]) {
+                nextTriangle++;
+            }
+            bestTriangle = nextTriangle;
+        }
+
+        emitted[bestTriangle] = true;
+        newCache.clear();
+        for (int k = 0; k < 3; k++) {
+            int v = indices[3 * bestTriangle + k];
+            result.push_back(v);
+
+            auto begin = vertexTriangles.begin() + triangleOffsets[v];
+            auto end = begin + remainingValence[v];
+            auto found = std::find(begin, end, bestTriangle);
+            if (found != end) {
+                std::iter_swap(found, end - 1);
+                remainingValence[v]--;
+            }
+            if (std::find(newCache.begin(), newCache.end(), v) == newCache.end()) {
+                newCache.push_back(v);
+            }
+        }
+        for (int v : cache) {
+            if (std::find(newCache.begin(), newCache.end(), v) == newCache.end()) {
+                newCache.push_back(v);
+            }
+        }
+
+        // the vertices past the end of the cache are evicted, but their triangles are still rescored
+        for (int i = 0; i < (int)newCache.size(); i++) {
+            int v = newCache[i];
+            cachePositions[v] = i < VERTEX_CACHE_SIZE ? i : -1;
+            vertexScores[v] = vertexScore(cachePositions[v], remainingValence[v]);
+        }
+
+        bestTriangle = -1;
+        bestScore = -1.0f;
+        for (int v : newCache) {
+            auto begin = vertexTriangles.begin() + triangleOffsets[v];
+            auto end = begin + remainingValence[v];
+            for (auto itr = begin; itr != end; ++itr) {
+                int t = *itr;
+                triangleScores[t] = vertexScores[indices[3 * t]] + vertexScores[indices[3 * t + 1]] + vertexScores[indices[3 * t + 2]];
+                if (triangleScores[t] > bestScore) {
+                    bestScore = triangleScores[t];
+                    bestTriangle = t;
+                }
+            }
+        }
+
+        if ((int)newCache.size() > VERTEX_CACHE_SIZE) {
+            newCache.resize(VERTEX_CACHE_SIZE);
+        }
+        std::swap(cache, newCache);
+    }
+    return result;
+}
+
+baker::MeshIndices baker::optimizeOverdraw(const QVector<glm::vec3>& positions, const MeshIndices& indices) {
+    const int numTriangles = (int)indices.size() / 3;
+    const int numVertices = positions.size();
+
+    // start a new cluster where a triangle misses all of its vertices, where the cache order already starts over
+    std::vector<int> clusterStarts;
+    {
+        std::vector<int> loadedAt(numVertices, -ACMR_CACHE_SIZE - 1);
+        int misses = 0;
+        int clusterTriangles = 0;
+        for (int t = 0; t < numTriangles; t++) {
+            int triangleMisses = 0;
+            for (int k = 0; k < 3; k++) {
+                int v = indices[3 * t + k];
+                if (misses - loadedAt[v] > ACMR_CACHE_SIZE) {
+                    loadedAt[v] = misses;
+                    misses++;
+                    triangleMisses++;
+                }
+            }
+            if (clusterStarts.empty() || (triangleMisses == 3 && clusterTriangles >= MIN_OVERDRAW_CLUSTER_TRIANGLES)) {
+                clusterStarts.push_back(t);
+                clusterTriangles = 0;
+            }
+            clusterTriangles++;
+        }
+    }
+    if (clusterStarts.size() < 2) {
+        return indices;
+    }
+    clusterStarts.push_back(numTriangles);
+    const int numClusters = (int)clusterStarts.size() - 1;
+
+    // the area weighted centroids and normals of the clusters and of the whole part
+    std::vector<glm::vec3> clusterCentroids(numClusters, glm::vec3(0.0f));
+    std::vector<glm::vec3> clusterNormals(numClusters, glm::vec3(0.0f));
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (int c = 0; c < numClusters; c++) {
+        float clusterArea = 0.0f;
+        for (int t = clusterStarts[c]; t < clusterStarts[c + 1]; t++) {
+            const auto& p0 = positions[indices[3 * t]];
+            const auto& p1 = positions[indices[3 * t + 1]];
+            const auto& p2 = positions[indices[3 * t + 2]];
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            float area = glm::length(normal);
+            glm::vec3 center = (p0 + p1 + p2) / 3.0f;
+            clusterCentroids[c] += center * area;
+            clusterNormals[c] += normal;
+            clusterArea += area;
+        }
+        meshCentroid += clusterCentroids[c];
+        meshArea += clusterArea;
+        clusterCentroids[c] = clusterArea > 0.0f ? clusterCentroids[c] / clusterArea : positions[indices[3 * clusterStarts[c]]];
+    }
+    if (meshArea <= 0.0f) {
+        return indices;
+    }
+    meshCentroid /= meshArea;
+
+    std::vector<float> clusterSortKeys(numClusters, 0.0f);
+    for (int c = 0; c < numClusters; c++) {
+        float normalLength = glm::length(clusterNormals[c]);
+        if (normalLength > 0.0f) {
+            clusterSortKeys[c] = glm::dot(clusterCentroids[c] - meshCentroid, clusterNormals[c] / normalLength);
+        }
+    }
+
+    std::vector<int> clusterOrder(numClusters);
+    std::iota(clusterOrder.begin(), clusterOrder.end(), 0);
+    std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&](int a, int b) {
+        return clusterSortKeys[a] > clusterSortKeys[b];
+    });
+
+    MeshIndices result;
+    result.reserve(indices.size());
+    for (int c : clusterOrder) {
+        result.insert(result.end(), indices.begin() + 3 * clusterStarts[c], indices.begin() + 3 * clusterStarts[c + 1]);
+    }
+    return result;
+}
+
+void baker::reorderMesh(hfm::Mesh& mesh, std::vector<hfm::Blendshape>& blendshapes) {
+    const int numVertices = mesh.vertices.size();
+
+    bool valid = true;
+    for (auto& part : mesh.parts) {
+        // drawn together anyway, merged so they can be reordered together
+        if (!part.quadTrianglesIndices.empty() && part.quadTrianglesIndices.size() % 3 == 0) {
+            part.triangleIndices = part.quadTrianglesIndices + part.triangleIndices;
+            part.quadTrianglesIndices.clear();
+        }
+        valid = valid && areIndicesValid(part.triangleIndices, numVertices) && areIndicesValid(part.quadIndices, numVertices);
+    }
+    if (!valid || numVertices == 0) {
+        return;
+    }
+
+    for (auto& part : mesh.parts) {
+        const int numIndices = part.triangleIndices.size() - part.triangleIndices.size() % 3;
+        if (numIndices < 3) {
+            continue;
+        }
+        MeshIndices indices(part.triangleIndices.begin(), part.triangleIndices.begin() + numIndices);
+        indices = optimizeVertexCache(indices, numVertices);
+        indices = optimizeOverdraw(mesh.vertices, indices);
+        std::copy(indices.begin(), indices.end(), part.triangleIndices.begin());
+    }
+
+    // number the vertices in the order the triangles first use them, the unused ones last
+    std::vector<int> oldToNew(numVertices, -1);
+    std::vector<int> newToOld;
+    newToOld.reserve(numVertices);
+    for (const auto& part : mesh.parts) {
+        for (int index : part.triangleIndices) {
+            if (oldToNew[index] < 0) {
+                oldToNew[index] = (int)newToOld.size();
+                newToOld.push_back(index);
+            }
+        }
+    }
+    for (int v = 0; v < numVertices; v++) {
+        if (oldToNew[v] < 0) {
+            oldToNew[v] = (int)newToOld.size();
+            newToOld.push_back(v);
+        }
+    }
+
+    remapVertices(mesh.vertices, newToOld);
+    // the attributes a mesh doesn't have for every vertex are left as they are
+    if (mesh.normals.size() == numVertices) {
+        remapVertices(mesh.normals, newToOld);
+    }
+    if (mesh.tangents.size() == numVertices) {
+        remapVertices(mesh.tangents, newToOld);
+    }
+    if (mesh.colors.size() == numVertices) {
+        remapVertices(mesh.colors, newToOld);
+    }
+    if (mesh.texCoords.size() == numVertices) {
+        remapVertices(mesh.texCoords, newToOld);
+    }
+    if (mesh.texCoords1.size() == numVertices) {
+        remapVertices(mesh.texCoords1, newToOld);
+    }
+    if (mesh.originalIndices.size() == numVertices) {
+        remapVertices(mesh.originalIndices, newToOld);
+    }
+    if (mesh.clusterIndices.size() == mesh.clusterWeights.size()) {
+        remapVertices(mesh.clusterIndices, newToOld);
+        remapVertices(mesh.clusterWeights, newToOld);
+    }
+
+    for (auto& part : mesh.parts) {
+        remapIndices(part.triangleIndices, oldToNew);
+        remapIndices(part.quadIndices, oldToNew);
+    }
+    for (auto& blendshape : mesh.blendshapes) {
+        remapIndices(blendshape.indices, oldToNew);
+    }
+    for (auto& blendshape : blendshapes) {
+        remapIndices(blendshape.indices, oldToNew);
+    }
+}
+
+void ReorderMeshesTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
+    const auto& meshesIn = input.get0();
+    const auto& blendshapesPerMeshIn = input.get1();
+    auto& meshesOut = output.edit0();
+    auto& blendshapesPerMeshOut = output.edit1();
+
+    meshesOut = meshesIn;
+    blendshapesPerMeshOut = blendshapesPerMeshIn;
+    blendshapesPerMeshOut.resize(meshesOut.size());
+
+    std::vector<float> missesBefore(meshesOut.size(), 0.0f);
+    std::vector<float> missesAfter(meshesOut.size(), 0.0f);
+    std::vector<int> trianglesPerMesh(meshesOut.size(), 0);
+    tbb::parallel_for((size_t)0, meshesOut.size(), [&](size_t i) {
+        auto& mesh = meshesOut[i];
+        const int numVertices = mesh.vertices.size();
+        auto measure = [&](std::vector<float>& misses) {
+            for (const auto& part : mesh.parts) {
+                for (const auto* partIndices : { &part.quadTrianglesIndices, &part.triangleIndices }) {
+                    baker::MeshIndices indices(partIndices->begin(), partIndices->end());
+                    misses[i] += baker::computeACMR(indices, numVertices) * (float)(indices.size() / 3);
+                }
+            }
+        };
+
+        measure(missesBefore);
+        baker::reorderMesh(mesh, blendshapesPerMeshOut[i]);
+        measure(missesAfter);
+        for (const auto& part : mesh.parts) {
+            trianglesPerMesh[i] += (part.quadTrianglesIndices.size() + part.triangleIndices.size()) / 3;
+        }
+    });
+
+    int numTriangles = std::accumulate(trianglesPerMesh.begin(), trianglesPerMesh.end(), 0);
+    if (numTriangles > 0) {
+        float before = std::accumulate(missesBefore.begin(), missesBefore.end(), 0.0f) / numTriangles;
+        float after = std::accumulate(missesAfter.begin(), missesAfter.end(), 0.0f) / numTriangles;
+        qCDebug(model_baker) << "ReorderMeshes: ACMR of" << numTriangles << "triangles went from" << before << "to" << after;
+    }
+}
@@ -0,0 +1,51 @@
+//
+//  ReorderMeshesTask.h
+//  model-baker/src/model-baker
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ReorderMeshesTask_h
+#define overte_ReorderMeshesTask_h
+
+#include <hfm/HFM.h>
+
+#include "Engine.h"
+#include "BakerTypes.h"
+
+// Reorder the triangles of each mesh part for the post-transform vertex cache and for overdraw, then the vertices of
+// each mesh in the order the triangles first use them
+class ReorderMeshesTask {
+public:
+    using Input = baker::VaryingSet2<std::vector<hfm::Mesh>, baker::BlendshapesPerMesh>;
+    using Output = baker::VaryingSet2<std::vector<hfm::Mesh>, baker::BlendshapesPerMesh>;
+    using JobModel = baker::Job::ModelIO<ReorderMeshesTask, Input, Output>;
+
+    void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
+};
+
+namespace baker {
+    // the size of the FIFO cache the average cache miss ratio is measured with
+    const int ACMR_CACHE_SIZE = 16;
+
+    // Returns the average number of vertices transformed per triangle of indices, through a FIFO cache of cacheSize
+    float computeACMR(const MeshIndices& indices, int numVertices, int cacheSize = ACMR_CACHE_SIZE);
+
+    // Reorders the triangles of indices by their score in a simulated LRU cache, after Tom Forsyth's
+    // "Linear-Speed Vertex Cache Optimisation"
+    MeshIndices optimizeVertexCache(const MeshIndices& indices, int numVertices);
+
+    // Splits the triangles of indices into clusters where the vertex cache starts over, and draws the clusters facing
+    // outwards from the center of the mesh first, so that they occlude the rest
+    MeshIndices optimizeOverdraw(const QVector<glm::vec3>& positions, const MeshIndices& indices);
+
+    // Merges the quad triangles of the parts into their triangles and reorders them, then reorders the vertices of mesh
+    // and of its blendshapes by first use
+    void reorderMesh(hfm::Mesh& mesh, std::vector<hfm::Blendshape>& blendshapes);
+};
+
+#endif // overte_ReorderMeshesTask_h
@@ -0,0 +1,736 @@
+//
+//  BakedModelCache.cpp
+//  libraries/model-networking/src/model-networking
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BakedModelCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+
+#include <graphics/Geometry.h>
+#include <graphics/Material.h>
+
+#include "ModelNetworkingLogging.h"
+
+const quint32 BakedModelCache::CURRENT_VERSION = 3;
+const std::string BakedModelCache::DIRNAME = "baked_models";
+const std::string BakedModelCache::EXT = "hfm";
+const QString BakedModelCache::PREVIEW_EXTENSION = ".preview.hfm";
+
+static const quint32 BAKED_MODEL_MAGIC = 0x48464D42; // "HFMB"
+
+namespace {
+
+// Restores the flags of a material, which its setters don't derive from the values alone
+class CachedMaterial : public graphics::Material {
+public:
+    void setKey(const graphics::MaterialKey& key) { _key = key; }
+};
+
+template <typename T>
+void writeRaw(QDataStream& out, const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain values can be written raw");
+    out.writeRawData(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void readRaw(QDataStream& in, T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain values can be read raw");
+    if (in.readRawData(reinterpret_cast<char*>(&value), sizeof(T)) != sizeof(T)) {
+        in.setStatus(QDataStream::ReadPastEnd);
+    }
+}
+
+template <typename T>
+void writeArray(QDataStream& out, const T* data, size_t count) {
+    static_assert(std::is_trivially_copyable<T>::value, "only arrays of plain values can be written raw");
+    out << (quint32)count;
+    out.writeRawData(reinterpret_cast<const char*>(data), (int)(count * sizeof(T)));
+}
+
+// Reads the size of an array of elements of elementSize bytes, failing the stream if the rest of it can't hold them
+bool readArraySize(QDataStream& in, size_t elementSize, quint32& count) {
+    in >> count;
+    if (in.status() != QDataStream::Ok || (qint64)count * (qint64)elementSize > in.device()->bytesAvailable()) {
+        in.setStatus(QDataStream::ReadCorruptData);
+        return false;
+    }
+    return true;
+}
+
+template <typename T>
+void writeVector(QDataStream& out, const QVector<T>& vector) {
+    writeArray(out, vector.constData(), vector.size());
+}
+
+template <typename T>
+void writeVector(QDataStream& out, const std::vector<T>& vector) {
+    writeArray(out, vector.data(), vector.size());
+}
+
+template <typename T>
+void readVector(QDataStream& in, QVector<T>& vector) {
+    quint32 count;
+    if (readArraySize(in, sizeof(T), count)) {
+        vector.resize(count);
+        in.readRawData(reinterpret_cast<char*>(vector.data()), (int)(count * sizeof(T)));
+    }
+}
+
+template <typename T>
+void readVector(QDataStream& in, std::vector<T>& vector) {
+    quint32 count;
+    if (readArraySize(in, sizeof(T), count)) {
+        vector.resize(count);
+        in.readRawData(reinterpret_cast<char*>(vector.data()), (int)(count * sizeof(T)));
+    }
+}
+
+// Lists of structures, each element written by the write and read overloads below
+template <typename T, typename Write>
+void writeList(QDataStream& out, const QVector<T>& list, Write write) {
+    out << (quint32)list.size();
+    for (const auto& element : list) {
+        write(out, element);
+    }
+}
+
+template <typename T, typename Read>
+void readList(QDataStream& in, QVector<T>& list, Read read) {
+    // every element takes at least a byte
+    quint32 count;
+    if (!readArraySize(in, 1, count)) {
+        return;
+    }
+    list.resize(count);
+    for (auto& element : list) {
+        read(in, element);
+        if (in.status() != QDataStream::Ok) {
+            return;
+        }
+    }
+}
+
+void writeTransform(QDataStream& out, const Transform& transform) {
+    writeRaw(out, transform.getTranslation());
+    writeRaw(out, transform.getRotation());
+    writeRaw(out, transform.getScale());
+}
+
+void readTransform(QDataStream& in, Transform& transform) {
+    glm::vec3 translation;
+    glm::quat rotation;
+    glm::vec3 scale;
+    readRaw(in, translation);
+    readRaw(in, rotation);
+    readRaw(in, scale);
+    transform = Transform(rotation, scale, translation);
+}
+
+void writeExtents(QDataStream& out, const Extents& extents) {
+    writeRaw(out, extents.minimum);
+    writeRaw(out, extents.maximum);
+}
+
+void readExtents(QDataStream& in, Extents& extents) {
+    readRaw(in, extents.minimum);
+    readRaw(in, extents.maximum);
+}
+
+void writeJoint(QDataStream& out, const hfm::Joint& joint) {
+    writeRaw(out, joint.shapeInfo.avgPoint);
+    writeVector(out, joint.shapeInfo.dots);
+    writeVector(out, joint.shapeInfo.points);
+    writeVector(out, joint.shapeInfo.debugLines);
+    out << joint.parentIndex << joint.distanceToParent;
+    writeRaw(out, joint.translation);
+    writeRaw(out, joint.preTransform);
+    writeRaw(out, joint.preRotation);
+    writeRaw(out, joint.rotation);
+    writeRaw(out, joint.postRotation);
+    writeRaw(out, joint.postTransform);
+    writeRaw(out, joint.transform);
+    writeRaw(out, joint.rotationMin);
+    writeRaw(out, joint.rotationMax);
+    writeRaw(out, joint.inverseDefaultRotation);
+    writeRaw(out, joint.inverseBindRotation);
+    writeRaw(out, joint.bindTransform);
+    out << joint.name << joint.isSkeletonJoint << joint.bindTransformFoundInCluster << joint.hasGeometricOffset;
+    writeRaw(out, joint.geometricTranslation);
+    writeRaw(out, joint.geometricRotation);
+    writeRaw(out, joint.geometricScaling);
+}
+
+void readJoint(QDataStream& in, hfm::Joint& joint) {
+    readRaw(in, joint.shapeInfo.avgPoint);
+    readVector(in, joint.shapeInfo.dots);
+    readVector(in, joint.shapeInfo.points);
+    readVector(in, joint.shapeInfo.debugLines);
+    in >> joint.parentIndex >> joint.distanceToParent;
+    readRaw(in, joint.translation);
+    readRaw(in, joint.preTransform);
+    readRaw(in, joint.preRotation);
+    readRaw(in, joint.rotation);
+    readRaw(in, joint.postRotation);
+    readRaw(in, joint.postTransform);
+    readRaw(in, joint.transform);
+    readRaw(in, joint.rotationMin);
+    readRaw(in, joint.rotationMax);
+    readRaw(in, joint.inverseDefaultRotation);
+    readRaw(in, joint.inverseBindRotation);
+    readRaw(in, joint.bindTransform);
+    in >> joint.name >> joint.isSkeletonJoint >> joint.bindTransformFoundInCluster >> joint.hasGeometricOffset;
+    readRaw(in, joint.geometricTranslation);
+    readRaw(in, joint.geometricRotation);
+    readRaw(in, joint.geometricScaling);
+}
+
+void writeTexture(QDataStream& out, const hfm::Texture& texture) {
+    out << texture.id << texture.name << texture.filename << texture.content << (qint32)texture.sourceChannel;
+    writeTransform(out, texture.transform);
+    out << texture.maxNumPixels << texture.texcoordSet << texture.texcoordSetName << texture.isBumpmap;
+}
+
+void readTexture(QDataStream& in, hfm::Texture& texture) {
+    qint32 sourceChannel;
+    in >> texture.id >> texture.name >> texture.filename >> texture.content >> sourceChannel;
+    texture.sourceChannel = (image::ColorChannel)sourceChannel;
+    readTransform(in, texture.transform);
+    in >> texture.maxNumPixels >> texture.texcoordSet >> texture.texcoordSetName >> texture.isBumpmap;
+}
+
+void writeGraphicsMaterial(QDataStream& out, const graphics::MaterialPointer& material) {
+    out << (bool)material;
+    if (!material) {
+        return;
+    }
+    out << QString::fromStdString(material->getName()) << QString::fromStdString(material->getModel());
+    out << (quint64)material->getKey()._flags.to_ullong();
+    writeRaw(out, material->getEmissive(false));
+    out << material->getOpacity() << material->getOpacityCutoff() << (qint32)material->getCullFaceMode();
+    writeRaw(out, material->getAlbedo(false));
+    out << material->getMetallic() << material->getRoughness() << material->getScattering();
+    for (int i = 0; i < graphics::Material::NUM_TEXCOORD_TRANSFORMS; i++) {
+        writeRaw(out, material->getTexCoordTransform(i));
+    }
+    out << material->getDefaultFallthrough();
+}
+
+void readGraphicsMaterial(QDataStream& in, graphics::MaterialPointer& material) {
+    bool hasMaterial;
+    in >> hasMaterial;
+    if (!hasMaterial) {
+        material.reset();
+        return;
+    }
+    QString name;
+    QString model;
+    quint64 flags;
+    glm::vec3 emissive;
+    glm::vec3 albedo;
+    float opacity, opacityCutoff, metallic, roughness, scattering;
+    qint32 cullFaceMode;
+    bool defaultFallthrough;
+    in >> name >> model >> flags;
+    readRaw(in, emissive);
+    in >> opacity >> opacityCutoff >> cullFaceMode;
+    readRaw(in, albedo);
+    in >> metallic >> roughness >> scattering;
+
+    auto cached = std::make_shared<CachedMaterial>();
+    for (int i = 0; i < graphics::Material::NUM_TEXCOORD_TRANSFORMS; i++) {
+        glm::mat4 texCoordTransform;
+        readRaw(in, texCoordTransform);
+        cached->setTexCoordTransform(i, texCoordTransform);
+    }
+    in >> defaultFallthrough;
+
+    cached->setName(name.toStdString());
+    cached->setModel(model.toStdString());
+    cached->setEmissive(emissive, false);
+    cached->setOpacity(opacity);
+    cached->setOpacityCutoff(opacityCutoff);
+    cached->setCullFaceMode((graphics::MaterialKey::CullFaceMode)cullFaceMode);
+    cached->setAlbedo(albedo, false);
+    cached->setMetallic(metallic);
+    cached->setRoughness(roughness);
+    cached->setScattering(scattering);
+    cached->setDefaultFallthrough(defaultFallthrough);
+    // last, the setters above change the flags
+    cached->setKey(graphics::MaterialKey(graphics::MaterialKey::Flags(flags)));
+    material = cached;
+}
+
+void writeMaterial(QDataStream& out, const hfm::Material& material) {
+    writeRaw(out, material.diffuseColor);
+    out << material.diffuseFactor;
+    writeRaw(out, material.specularColor);
+    out << material.specularFactor;
+    writeRaw(out, material.emissiveColor);
+    out << material.emissiveFactor << material.shininess << material.opacity << material.metallic << material.roughness
+        << material.emissiveIntensity << material.ambientFactor << material.bumpMultiplier << (qint32)material.alphaMode
+        << material.alphaCutoff << material.materialID << material.name << material.shadingModel;
+    writeGraphicsMaterial(out, material._material);
+    for (const auto* texture : { &material.normalTexture, &material.albedoTexture, &material.opacityTexture,
+                                 &material.glossTexture, &material.roughnessTexture, &material.specularTexture,
+                                 &material.metallicTexture, &material.emissiveTexture, &material.occlusionTexture,
+                                 &material.scatteringTexture, &material.lightmapTexture }) {
+        writeTexture(out, *texture);
+    }
+    writeRaw(out, material.lightmapParams);
+    out << material.isPBSMaterial << material.useNormalMap << material.useAlbedoMap << material.useOpacityMap
+        << material.useRoughnessMap << material.useSpecularMap << material.useMetallicMap << material.useEmissiveMap
+        << material.useOcclusionMap << material.isMToonMaterial;
+}
+
+void readMaterial(QDataStream& in, hfm::Material& material) {
+    qint32 alphaMode;
+    readRaw(in, material.diffuseColor);
+    in >> material.diffuseFactor;
+    readRaw(in, material.specularColor);
+    in >> material.specularFactor;
+    readRaw(in, material.emissiveColor);
+    in >> material.emissiveFactor >> material.shininess >> material.opacity >> material.metallic >> material.roughness
+       >> material.emissiveIntensity >> material.ambientFactor >> material.bumpMultiplier >> alphaMode
+       >> material.alphaCutoff >> material.materialID >> material.name >> material.shadingModel;
+    material.alphaMode = (graphics::MaterialKey::OpacityMapMode)alphaMode;
+    readGraphicsMaterial(in, material._material);
+    for (auto* texture : { &material.normalTexture, &material.albedoTexture, &material.opacityTexture,
+                           &material.glossTexture, &material.roughnessTexture, &material.specularTexture,
+                           &material.metallicTexture, &material.emissiveTexture, &material.occlusionTexture,
+                           &material.scatteringTexture, &material.lightmapTexture }) {
+        readTexture(in, *texture);
+    }
+    readRaw(in, material.lightmapParams);
+    in >> material.isPBSMaterial >> material.useNormalMap >> material.useAlbedoMap >> material.useOpacityMap
+       >> material.useRoughnessMap >> material.useSpecularMap >> material.useMetallicMap >> material.useEmissiveMap
+       >> material.useOcclusionMap >> material.isMToonMaterial;
+}
+
+void writeBuffer(QDataStream& out, const gpu::BufferPointer& buffer) {
+    if (!buffer) {
+        writeArray<gpu::Byte>(out, nullptr, 0);
+        return;
+    }
+    writeArray(out, buffer->getData(), buffer->getSize());
+}
+
+gpu::BufferPointer readBuffer(QDataStream& in) {
+    quint32 size;
+    if (!readArraySize(in, 1, size)) {
+        return nullptr;
+    }
+    // the only copy of the data, from the mapping of the cache file to the buffer the gpu uploads from
+    auto buffer = std::make_shared<gpu::Buffer>();
+    buffer->resize(size);
+    if (size > 0) {
+        auto data = buffer->editData();
+        in.readRawData(reinterpret_cast<char*>(data), (int)size);
+    }
+    return buffer;
+}
+
+void writeElement(QDataStream& out, const gpu::Element& element) {
+    out << (quint16)element.getRaw();
+}
+
+void readElement(QDataStream& in, gpu::Element& element) {
+    static_assert(sizeof(gpu::Element) == sizeof(quint16), "gpu::Element is no longer 16 bits");
+    quint16 raw;
+    in >> raw;
+    memcpy(&element, &raw, sizeof(raw));
+}
+
+void writeBufferView(QDataStream& out, const gpu::BufferView& view) {
+    writeElement(out, view._element);
+    out << (quint64)view._offset << (quint64)view._size << (quint16)view._stride;
+    writeBuffer(out, view._buffer);
+}
+
+gpu::BufferView readBufferView(QDataStream& in) {
+    gpu::Element element;
+    quint64 offset, size;
+    quint16 stride;
+    readElement(in, element);
+    in >> offset >> size >> stride;
+    auto buffer = readBuffer(in);
+    if (!buffer || offset + size > buffer->getSize()) {
+        in.setStatus(QDataStream::ReadCorruptData);
+        return gpu::BufferView(element);
+    }
+    return gpu::BufferView(buffer, (gpu::Size)offset, (gpu::Size)size, stride, element);
+}
+
+bool isImplicitColor(const gpu::Stream::Attribute& attribute) {
+    // graphics::Mesh adds a white color of its own to the meshes that don't have one
+    return attribute._slot == gpu::Stream::COLOR && attribute._frequency == gpu::Stream::PER_INSTANCE;
+}
+
+void writeGraphicsMesh(QDataStream& out, const graphics::MeshPointer& mesh) {
+    out << (bool)mesh;
+    if (!mesh) {
+        return;
+    }
+    out << QString::fromStdString(mesh->modelName) << QString::fromStdString(mesh->displayName);
+
+    const auto& format = mesh->getVertexFormat();
+    const auto& stream = mesh->getVertexStream();
+    std::vector<gpu::Stream::Attribute> attributes;
+    size_t numBuffers = stream.getNumBuffers();
+    for (const auto& attribute : format->getAttributes()) {
+        if (isImplicitColor(attribute.second)) {
+            // it's always the last channel
+            numBuffers = std::min<size_t>(numBuffers, attribute.second._channel);
+        } else {
+            attributes.push_back(attribute.second);
+        }
+    }
+
+    out << (quint32)attributes.size();
+    for (const auto& attribute : attributes) {
+        out << (quint8)attribute._slot << (quint8)attribute._channel;
+        writeElement(out, attribute._element);
+        out << (quint64)attribute._offset << (quint32)attribute._frequency;
+    }
+    out << (quint32)numBuffers;
+    for (size_t i = 0; i < numBuffers; i++) {
+        out << (quint64)stream.getOffsets()[i] << (quint64)stream.getStrides()[i];
+        writeBuffer(out, stream.getBuffers()[i]);
+    }
+    writeBufferView(out, mesh->getIndexBuffer());
+    writeBufferView(out, mesh->getPartBuffer());
+
+    out << (quint32)mesh->getLODs().size();
+    for (const auto& lod : mesh->getLODs()) {
+        out << lod._error;
+        writeVector(out, lod._parts);
+        writeVector(out, lod._meshlets);
+    }
+}
+
+void readGraphicsMesh(QDataStream& in, graphics::MeshPointer& mesh) {
+    bool hasMesh;
+    in >> hasMesh;
+    if (!hasMesh) {
+        mesh.reset();
+        return;
+    }
+    auto graphicsMesh = std::make_shared<graphics::Mesh>();
+    QString modelName;
+    QString displayName;
+    in >> modelName >> displayName;
+    graphicsMesh->modelName = modelName.toStdString();
+    graphicsMesh->displayName = displayName.toStdString();
+
+    auto format = std::make_shared<gpu::Stream::Format>();
+    quint32 numAttributes;
+    if (!readArraySize(in, 1, numAttributes)) {
+        return;
+    }
+    quint8 positionChannel = 0xFF;
+    for (quint32 i = 0; i < numAttributes; i++) {
+        quint8 slot, channel;
+        gpu::Element element;
+        quint64 offset;
+        quint32 frequency;
+        in >> slot >> channel;
+        readElement(in, element);
+        in >> offset >> frequency;
+        format->setAttribute(slot, channel, element, (gpu::Offset)offset, (gpu::Stream::Frequency)frequency);
+        if (slot == gpu::Stream::POSITION) {
+            positionChannel = channel;
+        }
+    }
+
+    auto stream = std::make_shared<gpu::BufferStream>();
+    quint32 numBuffers;
+    if (!readArraySize(in, 1, numBuffers)) {
+        return;
+    }
+    for (quint32 i = 0; i < numBuffers; i++) {
+        quint64 offset, stride;
+        in >> offset >> stride;
+        auto buffer = readBuffer(in);
+        if (!buffer) {
+            return;
+        }
+        stream->addBuffer(buffer, (gpu::Offset)offset, (gpu::Offset)stride);
+    }
+    if (positionChannel >= numBuffers) {
+        in.setStatus(QDataStream::ReadCorruptData);
+        return;
+    }
+    graphicsMesh->setVertexFormatAndStream(format, stream);
+    graphicsMesh->setIndexBuffer(readBufferView(in));
+    graphicsMesh->setPartBuffer(readBufferView(in));
+
+    quint32 numLODs;
+    if (!readArraySize(in, 1, numLODs)) {
+        return;
+    }
+    graphics::Mesh::LODs lods(numLODs);
+    for (auto& lod : lods) {
+        in >> lod._error;
+        readVector(in, lod._parts);
+        readVector(in, lod._meshlets);
+    }
+    graphicsMesh->setLODs(lods);
+    mesh = graphicsMesh;
+}
+
+void writeMesh(QDataStream& out, const hfm::Mesh& mesh) {
+    writeList(out, mesh.parts, [](QDataStream& out, const hfm::MeshPart& part) {
+        writeVector(out, part.quadIndices);
+        writeVector(out, part.quadTrianglesIndices);
+        writeVector(out, part.triangleIndices);
+        out << part.materialID;
+    });
+    writeVector(out, mesh.vertices);
+    writeVector(out, mesh.normals);
+    writeVector(out, mesh.tangents);
+    writeVector(out, mesh.colors);
+    writeVector(out, mesh.texCoords);
+    writeVector(out, mesh.texCoords1);
+    writeVector(out, mesh.clusterIndices);
+    writeVector(out, mesh.clusterWeights);
+    writeVector(out, mesh.originalIndices);
+    writeList(out, mesh.clusters, [](QDataStream& out, const hfm::Cluster& cluster) {
+        out << cluster.jointIndex;
+        writeRaw(out, cluster.inverseBindMatrix);
+        writeTransform(out, cluster.inverseBindTransform);
+    });
+    writeExtents(out, mesh.meshExtents);
+    writeRaw(out, mesh.modelTransform);
+    writeList(out, mesh.blendshapes, [](QDataStream& out, const hfm::Blendshape& blendshape) {
+        writeVector(out, blendshape.indices);
+        writeVector(out, blendshape.vertices);
+        writeVector(out, blendshape.normals);
+        writeVector(out, blendshape.tangents);
+    });
+    out << mesh.meshIndex << mesh.wasCompressed;
+    writeGraphicsMesh(out, mesh._mesh);
+}
+
+void readMesh(QDataStream& in, hfm::Mesh& mesh) {
+    readList(in, mesh.parts, [](QDataStream& in, hfm::MeshPart& part) {
+        readVector(in, part.quadIndices);
+        readVector(in, part.quadTrianglesIndices);
+        readVector(in, part.triangleIndices);
+        in >> part.materialID;
+    });
+    readVector(in, mesh.vertices);
+    readVector(in, mesh.normals);
+    readVector(in, mesh.tangents);
+    readVector(in, mesh.colors);
+    readVector(in, mesh.texCoords);
+    readVector(in, mesh.texCoords1);
+    readVector(in, mesh.clusterIndices);
+    readVector(in, mesh.clusterWeights);
+    readVector(in, mesh.originalIndices);
+    readList(in, mesh.clusters, [](QDataStream& in, hfm::Cluster& cluster) {
+        in >> cluster.jointIndex;
+        readRaw(in, cluster.inverseBindMatrix);
+        readTransform(in, cluster.inverseBindTransform);
+    });
+    readExtents(in, mesh.meshExtents);
+    readRaw(in, mesh.modelTransform);
+    readList(in, mesh.blendshapes, [](QDataStream& in, hfm::Blendshape& blendshape) {
+        readVector(in, blendshape.indices);
+        readVector(in, blendshape.vertices);
+        readVector(in, blendshape.normals);
+        readVector(in, blendshape.tangents);
+    });
+    in >> mesh.meshIndex >> mesh.wasCompressed;
+    readGraphicsMesh(in, mesh._mesh);
+}
+
+}
+
+BakedModelCache::BakedModelCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) {
+    // the baked models share their disk space with the downloads they were baked from
+    setSharedBudget(cache::getResourceBudget());
+}
+
+std::string BakedModelCache::getKey(const QByteArray& data, const QUrl& url, const QUrl& mappingURL,
+                                    const QVariantHash& mapping, bool combineParts) {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(data);
+
+    // everything else the bake depends on, the mapping is written in key order so that equal mappings hash the same
+    QByteArray parameters;
+    {
+        QDataStream stream(&parameters, QIODevice::WriteOnly);
+        stream << CURRENT_VERSION << url << mappingURL << combineParts;
+        auto keys = mapping.keys();
+        std::sort(keys.begin(), keys.end());
+        for (const auto& key : keys) {
+            stream << key << mapping.values(key);
+        }
+    }
+    hash.addData(parameters);
+    return hash.result().toHex().toStdString();
+}
+
+bool BakedModelCache::canSerialize(const HFMModel& hfmModel) {
+    for (const auto& material : hfmModel.materials) {
+        // the MToon parameters live in a graphics::Material subclass that isn't stored
+        if (material.isMToonMaterial || (material._material && material._material->isMToon())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QByteArray BakedModelCache::serialize(const HFMModel& hfmModel) {
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    out << BAKED_MODEL_MAGIC << CURRENT_VERSION;
+
+    out << hfmModel.originalURL << hfmModel.author << hfmModel.applicationName;
+    writeList(out, hfmModel.joints, writeJoint);
+    out << hfmModel.jointIndices << hfmModel.hasSkeletonJoints;
+    writeList(out, hfmModel.meshes, writeMesh);
+    out << hfmModel.scripts;
+
+    out << (quint32)hfmModel.materials.size();
+    for (auto itr = hfmModel.materials.cbegin(); itr != hfmModel.materials.cend(); ++itr) {
+        out << itr.key();
+        writeMaterial(out, itr.value());
+    }
+
+    writeRaw(out, hfmModel.offset);
+    writeRaw(out, hfmModel.neckPivot);
+    writeExtents(out, hfmModel.bindExtents);
+    writeExtents(out, hfmModel.meshExtents);
+    writeList(out, hfmModel.animationFrames, [](QDataStream& out, const hfm::AnimationFrame& frame) {
+        writeVector(out, frame.rotations);
+        writeVector(out, frame.translations);
+    });
+    out << hfmModel.meshIndicesToModelNames << hfmModel.blendshapeChannelNames;
+
+    out << (quint32)hfmModel.jointRotationOffsets.size();
+    for (auto itr = hfmModel.jointRotationOffsets.cbegin(); itr != hfmModel.jointRotationOffsets.cend(); ++itr) {
+        out << itr.key();
+        writeRaw(out, itr.value());
+    }
+    out << (quint32)hfmModel.shapeVertices.size();
+    for (const auto& shapeVertices : hfmModel.shapeVertices) {
+        writeVector(out, shapeVertices);
+    }
+    out << hfmModel.flowData._physicsConfig << hfmModel.flowData._collisionsConfig;
+    out << hfmModel.loadWarningCount << hfmModel.loadErrorCount;
+    return data;
+}
+
+HFMModel::Pointer BakedModelCache::deserialize(const QByteArray& data) {
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    QDataStream in(&buffer);
+    in.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint32 magic, version;
+    in >> magic >> version;
+    if (magic != BAKED_MODEL_MAGIC || version != CURRENT_VERSION) {
+        return nullptr;
+    }
+
+    auto hfmModel = std::make_shared<HFMModel>();
+    in >> hfmModel->originalURL >> hfmModel->author >> hfmModel->applicationName;
+    readList(in, hfmModel->joints, readJoint);
+    in >> hfmModel->jointIndices >> hfmModel->hasSkeletonJoints;
+    readList(in, hfmModel->meshes, readMesh);
+    in >> hfmModel->scripts;
+
+    quint32 numMaterials;
+    if (!readArraySize(in, 1, numMaterials)) {
+        return nullptr;
+    }
+    for (quint32 i = 0; i < numMaterials && in.status() == QDataStream::Ok; i++) {
+        QString materialID;
+        in >> materialID;
+        readMaterial(in, hfmModel->materials[materialID]);
+    }
+
+    readRaw(in, hfmModel->offset);
+    readRaw(in, hfmModel->neckPivot);
+    readExtents(in, hfmModel->bindExtents);
+    readExtents(in, hfmModel->meshExtents);
+    readList(in, hfmModel->animationFrames, [](QDataStream& in, hfm::AnimationFrame& frame) {
+        readVector(in, frame.rotations);
+        readVector(in, frame.translations);
+    });
+    in >> hfmModel->meshIndicesToModelNames >> hfmModel->blendshapeChannelNames;
+
+    quint32 numRotationOffsets;
+    if (!readArraySize(in, 1, numRotationOffsets)) {
+        return nullptr;
+    }
+    for (quint32 i = 0; i < numRotationOffsets && in.status() == QDataStream::Ok; i++) {
+        int jointIndex;
+        glm::quat rotationOffset;
+        in >> jointIndex;
+        readRaw(in, rotationOffset);
+        hfmModel->jointRotationOffsets.insert(jointIndex, rotationOffset);
+    }
+    quint32 numShapes;
+    if (!readArraySize(in, 1, numShapes)) {
+        return nullptr;
+    }
+    hfmModel->shapeVertices.resize(numShapes);
+    for (auto& shapeVertices : hfmModel->shapeVertices) {
+        readVector(in, shapeVertices);
+    }
+    in >> hfmModel->flowData._physicsConfig >> hfmModel->flowData._collisionsConfig;
+    in >> hfmModel->loadWarningCount >> hfmModel->loadErrorCount;
+
+    if (in.status() != QDataStream::Ok) {
+        return nullptr;
+    }
+    return hfmModel;
+}
+
+HFMModel::Pointer BakedModelCache::readModel(const std::string& key) {
+    // the cache entry can't be ejected while it's held
+    auto file = getFile(key);
+    if (!file) {
+        return nullptr;
+    }
+
+    QFile mappedFile(QString::fromStdString(file->getFilepath()));
+    if (!mappedFile.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    qint64 size = mappedFile.size();
+    uchar* mapped = mappedFile.map(0, size);
+    QByteArray data = mapped ? QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), (int)size) : mappedFile.readAll();
+
+    auto hfmModel = deserialize(data);
+    if (!hfmModel) {
+        qCWarning(modelnetworking) << "Unable to read the baked model" << key.c_str();
+    }
+    return hfmModel;
+}
+
+bool BakedModelCache::writeModel(const std::string& key, const HFMModel& hfmModel) {
+    if (!canSerialize(hfmModel)) {
+        return false;
+    }
+    auto data = serialize(hfmModel);
+    return (bool)writeFile(data.constData(), Metadata(key, data.size()));
+}
@@ -0,0 +1,56 @@
+//
+//  BakedModelCache.h
+//  libraries/model-networking/src/model-networking
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_BakedModelCache_h
+#define overte_BakedModelCache_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QUrl>
+#include <QtCore/QVariantHash>
+
+#include <hfm/HFM.h>
+#include <shared/FileCache.h>
+
+/// Keeps the models as the baker left them, so that loading one again maps its meshes and buffers back in rather
+/// than parsing and baking it.  The entries are keyed by the hash of the model data and of everything else the bake
+/// depends on, and they share their disk space with the downloads.
+class BakedModelCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to the serialized format of the baked models,
+    // this value should be incremented so that the entries of the previous format are no longer found
+    static const quint32 CURRENT_VERSION;
+    static const std::string DIRNAME;
+    static const std::string EXT;
+    // The oven writes the preview of a model, drawn while the model loads, in this format to a file with this extension.
+    // A preview written in a previous format isn't read, the model is then only drawn once it's loaded
+    static const QString PREVIEW_EXTENSION;
+
+    BakedModelCache(const std::string& dir = DIRNAME, const std::string& ext = EXT);
+
+    /// Returns the key of the model baked from data, as downloaded from url with the given mapping
+    static std::string getKey(const QByteArray& data, const QUrl& url, const QUrl& mappingURL, const QVariantHash& mapping,
+                              bool combineParts);
+
+    /// Returns the model stored under key, or nullptr if there isn't one or it can't be read
+    HFMModel::Pointer readModel(const std::string& key);
+
+    /// Stores hfmModel under key, returns false if the model can't be stored
+    bool writeModel(const std::string& key, const HFMModel& hfmModel);
+
+    /// Returns false if hfmModel uses something the format can't store, such as an MToon material
+    static bool canSerialize(const HFMModel& hfmModel);
+    static QByteArray serialize(const HFMModel& hfmModel);
+    static HFMModel::Pointer deserialize(const QByteArray& data);
+};
+
+#endif // overte_BakedModelCache_h
@@ -28,6 +28,9 @@
 #include <OBJSerializer.h>
 #include <GLTFSerializer.h>
 #include <model-baker/Baker.h>
+#include <model-baker/ParseMaterialMappingTask.h>
+
+#include "BakedModelCache.h"
 
 Q_LOGGING_CATEGORY(trace_resource_parse_geometry, "trace.resource.parse.geometry")
 
@@ -87,9 +90,10 @@ namespace std {
 
 class GeometryReader : public QRunnable {
 public:
-    GeometryReader(const ModelLoader& modelLoader, QWeakPointer<Resource>& resource, const QUrl& url, const GeometryMappingPair& mapping,
-                   const QByteArray& data, bool combineParts, const QString& webMediaType) :
-        _modelLoader(modelLoader), _resource(resource), _url(url), _mapping(mapping), _data(data), _combineParts(combineParts), _webMediaType(webMediaType) {
+    GeometryReader(const ModelLoader& modelLoader, const std::shared_ptr<BakedModelCache>& bakedModelCache, QWeakPointer<Resource>& resource,
+                   const QUrl& url, const GeometryMappingPair& mapping, const QByteArray& data, bool combineParts, const QString& webMediaType) :
+        _modelLoader(modelLoader), _bakedModelCache(bakedModelCache), _resource(resource), _url(url), _mapping(mapping), _data(data),
+        _combineParts(combineParts), _webMediaType(webMediaType) {
 
         DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
     }
@@ -98,6 +102,7 @@ public:
 
 private:
     ModelLoader _modelLoader;
+    std::shared_ptr<BakedModelCache> _bakedModelCache;
     QWeakPointer<Resource> _resource;
     QUrl _url;
     GeometryMappingPair _mapping;
@@ -139,6 +144,31 @@ void GeometryReader::run() {
             throw QString("url is invalid");
         }
 
+        // The previews the oven writes alongside the models it bakes are stored baked already
+        if (_url.path().endsWith(BakedModelCache::PREVIEW_EXTENSION)) {
+            auto previewModel = BakedModelCache::deserialize(_data);
+            if (!previewModel) {
+                throw QString("unreadable preview, possibly baked by another version");
+            }
+            auto materialMapping = ParseMaterialMappingTask::parseMaterialMapping(_mapping.second, _mapping.first);
+            QMetaObject::invokeMethod(resource.data(), "setGeometryDefinition",
+                    Q_ARG(HFMModel::Pointer, previewModel), Q_ARG(MaterialMapping, materialMapping));
+            return;
+        }
+
+        // A model baked before from the same data and mapping is read back instead of being parsed and baked again
+        std::string bakedModelKey;
+        if (_bakedModelCache) {
+            bakedModelKey = BakedModelCache::getKey(_data, _url, _mapping.first, _mapping.second, _combineParts);
+            auto bakedModel = _bakedModelCache->readModel(bakedModelKey);
+            if (bakedModel) {
+                auto materialMapping = ParseMaterialMappingTask::parseMaterialMapping(_mapping.second, _mapping.first);
+                QMetaObject::invokeMethod(resource.data(), "setGeometryDefinition",
+                        Q_ARG(HFMModel::Pointer, bakedModel), Q_ARG(MaterialMapping, materialMapping));
+                return;
+            }
+        }
+
         HFMModel::Pointer hfmModel;
         QMultiHash<QString, QVariant> serializerMapping = _mapping.second;
         serializerMapping.replace("combineParts",_combineParts);
@@ -181,6 +211,10 @@ void GeometryReader::run() {
         auto processedHFMModel = modelBaker.getHFMModel();
         auto materialMapping = modelBaker.getMaterialMapping();
 
+        if (_bakedModelCache) {
+            _bakedModelCache->writeModel(bakedModelKey, *processedHFMModel);
+        }
+
         QMetaObject::invokeMethod(resource.data(), "setGeometryDefinition",
                 Q_ARG(HFMModel::Pointer, processedHFMModel), Q_ARG(MaterialMapping, materialMapping));
     } catch (const std::exception&) {
@@ -267,6 +301,14 @@ void GeometryResource::downloadFinished(const QByteArray& data) {
             auto modelCache = DependencyManager::get<ModelCache>();
             GeometryExtra extra { GeometryMappingPair(base, _mapping), _textureBaseURL, false };
 
+            // The coarse preview baked with the model is requested first, to be drawn until the model loads
+            QString previewFilename = _mapping.value(PREVIEW_FILENAME_FIELD).toString();
+            if (!previewFilename.isEmpty()) {
+                _previewResource = modelCache->getResource(base.resolved(previewFilename), QUrl(), &extra,
+                                                           std::hash<GeometryExtra>()(extra)).staticCast<GeometryResource>();
+                _previewResource->_isCacheable = false;
+            }
+
             // Get the raw GeometryResource
             _geometryResource = modelCache->getResource(url, QUrl(), &extra, std::hash<GeometryExtra>()(extra)).staticCast<GeometryResource>();
             // Avoid caching nested resources - their references will be held by the parent
@@ -280,6 +322,14 @@ void GeometryResource::downloadFinished(const QByteArray& data) {
                 }
 
                 _connection = connect(_geometryResource.data(), &Resource::finished, this, &GeometryResource::onGeometryMappingLoaded);
+
+                if (_previewResource) {
+                    if (_previewResource->isLoaded()) {
+                        onPreviewLoaded(!_previewResource->getURL().isEmpty());
+                    } else {
+                        _previewConnection = connect(_previewResource.data(), &Resource::finished, this, &GeometryResource::onPreviewLoaded);
+                    }
+                }
             }
         }
     } else {
@@ -287,11 +337,33 @@ void GeometryResource::downloadFinished(const QByteArray& data) {
             _url = _effectiveBaseURL;
             _textureBaseURL = _effectiveBaseURL;
         }
-        QThreadPool::globalInstance()->start(new GeometryReader(_modelLoader, _self, _effectiveBaseURL, _mappingPair, data, _combineParts, _request->getWebMediaType()));
+        QThreadPool::globalInstance()->start(new GeometryReader(_modelLoader, DependencyManager::get<ModelCache>()->_bakedModelCache, _self, _effectiveBaseURL, _mappingPair, data, _combineParts, _request->getWebMediaType()));
+    }
+}
+
+void GeometryResource::onPreviewLoaded(bool success) {
+    // the model may have loaded first
+    if (success && _previewResource && !isLoaded()) {
+        _hfmModel = _previewResource->_hfmModel;
+        _materialMapping = _previewResource->_materialMapping;
+        _meshParts = _previewResource->_meshParts;
+        _meshes = _previewResource->_meshes;
+        _materials = _previewResource->_materials;
+        _isPreviewLoaded = true;
+        emit previewLoaded();
+    } else if (!success) {
+        qCDebug(modelnetworking) << "Unable to load the preview of" << _url;
     }
 }
 
 void GeometryResource::onGeometryMappingLoaded(bool success) {
+    // the model replaces its preview, or it failed and the preview is all there is to draw
+    _isPreviewLoaded = false;
+    if (_previewResource) {
+        _previewResource.reset();
+        disconnect(_previewConnection);
+    }
+
     if (success && _geometryResource) {
         _hfmModel = _geometryResource->_hfmModel;
         _materialMapping = _geometryResource->_materialMapping;
@@ -386,6 +458,9 @@ ModelCache::ModelCache() {
     modelFormatRegistry->addFormat(FBXSerializer());
     modelFormatRegistry->addFormat(OBJSerializer());
     modelFormatRegistry->addFormat(GLTFSerializer());
+
+    _bakedModelCache = std::make_shared<BakedModelCache>();
+    _bakedModelCache->initialize();
 }
 
 QSharedPointer<Resource> ModelCache::createResource(const QUrl& url) {
@@ -533,14 +608,18 @@ const std::shared_ptr<NetworkMaterial> Geometry::getShapeMaterial(int partID) co
 void GeometryResourceWatcher::startWatching() {
     connect(_resource.data(), &Resource::finished, this, &GeometryResourceWatcher::resourceFinished);
     connect(_resource.data(), &Resource::onRefresh, this, &GeometryResourceWatcher::resourceRefreshed);
+    connect(_resource.data(), &GeometryResource::previewLoaded, this, &GeometryResourceWatcher::resourcePreviewLoaded);
     if (_resource->isLoaded()) {
         resourceFinished(!_resource->getURL().isEmpty());
+    } else if (_resource->isPreviewLoaded()) {
+        resourcePreviewLoaded();
     }
 }
 
 void GeometryResourceWatcher::stopWatching() {
     disconnect(_resource.data(), &Resource::finished, this, &GeometryResourceWatcher::resourceFinished);
     disconnect(_resource.data(), &Resource::onRefresh, this, &GeometryResourceWatcher::resourceRefreshed);
+    disconnect(_resource.data(), &GeometryResource::previewLoaded, this, &GeometryResourceWatcher::resourcePreviewLoaded);
 }
 
 void GeometryResourceWatcher::setResource(GeometryResource::Pointer resource) {
@@ -564,6 +643,11 @@ void GeometryResourceWatcher::resourceFinished(bool success) {
     emit finished(success);
 }
 
+void GeometryResourceWatcher::resourcePreviewLoaded() {
+    _geometryRef = std::make_shared<Geometry>(*_resource);
+    emit previewLoaded();
+}
+
 void GeometryResourceWatcher::resourceRefreshed() {
     // FIXME: Model is not set up to handle a refresh
     // _instance.reset();
@@ -25,6 +25,7 @@
 #include "ModelLoader.h"
 
 class MeshPart;
+class BakedModelCache;
 
 using GeometryMappingPair = std::pair<QUrl, QVariantHash>;
 Q_DECLARE_METATYPE(GeometryMappingPair)
@@ -95,8 +96,15 @@ public:
 
     virtual bool areTexturesLoaded() const override { return isLoaded() && Geometry::areTexturesLoaded(); }
 
+    /// Returns true while the geometry is the coarse preview baked with the model, and the model itself is loading
+    bool isPreviewLoaded() const { return _isPreviewLoaded; }
+
+signals:
+    void previewLoaded();
+
 private slots:
     void onGeometryMappingLoaded(bool success);
+    void onPreviewLoaded(bool success);
 
 protected:
     friend class ModelCache;
@@ -119,6 +127,9 @@ private:
 
     GeometryResource::Pointer _geometryResource;
     QMetaObject::Connection _connection;
+    GeometryResource::Pointer _previewResource;
+    QMetaObject::Connection _previewConnection;
+    bool _isPreviewLoaded { false };
 
     bool _isCacheable{ true };
 };
@@ -133,6 +144,7 @@ public:
 
     void setResource(GeometryResource::Pointer resource);
 
+    const GeometryResource::Pointer& getResource() const { return _resource; }
     QUrl getURL() const { return (bool)_resource ? _resource->getURL() : QUrl(); }
     int getResourceDownloadAttempts() { return _resource ? _resource->getDownloadAttempts() : 0; }
     int getResourceDownloadAttemptsRemaining() { return _resource ? _resource->getDownloadAttemptsRemaining() : 0; }
@@ -143,9 +155,12 @@ private:
 
 signals:
     void finished(bool success);
+    // the geometry is the preview of the model, until finished
+    void previewLoaded();
 
 private slots:
     void resourceFinished(bool success);
+    void resourcePreviewLoaded();
     void resourceRefreshed();
 
 private:
@@ -180,6 +195,7 @@ private:
     ModelCache();
     virtual ~ModelCache() = default;
     ModelLoader _modelLoader;
+    std::shared_ptr<BakedModelCache> _bakedModelCache;
 };
 
 class MeshPart {
@@ -12,6 +12,9 @@
 
 #include "FBXSerializer.h"
 
+#include <atomic>
+#include <thread>
+
 #include <QBuffer>
 #include <QRegularExpression>
 
@@ -394,6 +397,33 @@ hifi::ByteArray fileOnUrl(const hifi::ByteArray& filepath, const QString& url) {
     return filepath.mid(filepath.lastIndexOf('/') + 1);
 }
 
+void FBXSerializer::extractMeshes(const std::vector<PendingMesh>& pendingMeshes, bool deduplicate,
+                                  QMap<QString, ExtractedMesh>& meshes) {
+    // the meshes don't depend on each other, so each worker takes the next one until there are none left
+    std::vector<ExtractedMesh> extractedMeshes(pendingMeshes.size());
+    std::atomic<size_t> nextMesh { 0 };
+    auto extract = [&] {
+        for (size_t i = nextMesh++; i < pendingMeshes.size(); i = nextMesh++) {
+            unsigned int meshIndex = pendingMeshes[i].meshIndex;
+            extractedMeshes[i] = extractMesh(*pendingMeshes[i].object, meshIndex, deduplicate);
+        }
+    };
+
+    size_t numThreads = std::min<size_t>(pendingMeshes.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < numThreads; i++) {
+        workers.emplace_back(extract);
+    }
+    extract();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (size_t i = 0; i < pendingMeshes.size(); i++) {
+        meshes.insert(pendingMeshes[i].id, extractedMeshes[i]);
+    }
+}
+
 HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const QString& url) {
     const FBXNode& node = _rootNode;
     bool deduplicateIndices = mapping["deduplicateIndices"].toBool();
@@ -531,10 +561,12 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
                 }
             }
         } else if (child.name == "Objects") {
+            std::vector<PendingMesh> pendingMeshes;
             foreach (const FBXNode& object, child.children) {
                 if (object.name == "Geometry") {
                     if (object.properties.at(2) == "Mesh") {
-                        meshes.insert(getID(object.properties), extractMesh(object, meshIndex, deduplicateIndices));
+                        // extracted once all the objects are read, nothing in between needs these meshes
+                        pendingMeshes.push_back({ getID(object.properties), &object, meshIndex++ });
                     } else { // object.properties.at(2) == "Shape"
                         ExtractedBlendshape extracted = { getID(object.properties), extractBlendshape(object) };
                         blendshapes.append(extracted);
@@ -1133,6 +1165,7 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
                 }
 #endif
             }
+            extractMeshes(pendingMeshes, deduplicateIndices, meshes);
         } else if (child.name == "Connections") {
             static const QVariant OO = hifi::ByteArray("OO");
             static const QVariant OP = hifi::ByteArray("OP");
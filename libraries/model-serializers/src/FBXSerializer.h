@@ -12,7 +12,10 @@
 #ifndef hifi_FBXSerializer_h
 #define hifi_FBXSerializer_h
 
+#include <vector>
+
 #include <QtGlobal>
+#include <QMap>
 #include <QMetaType>
 #include <QSet>
 #include <QVector>
@@ -120,6 +123,14 @@ public:
     HFMModel* extractHFMModel(const hifi::VariantHash& mapping, const QString& url);
 
     static ExtractedMesh extractMesh(const FBXNode& object, unsigned int& meshIndex, bool deduplicate);
+
+    struct PendingMesh {
+        QString id;
+        const FBXNode* object;
+        unsigned int meshIndex;
+    };
+    /// Extracts the meshes on as many threads as there are cores, inserting them in the order they were read
+    static void extractMeshes(const std::vector<PendingMesh>& pendingMeshes, bool deduplicate, QMap<QString, ExtractedMesh>& meshes);
     QHash<QString, ExtractedMesh> meshes;
 
     HFMTexture getTexture(const QString& textureID, const QString& materialID);
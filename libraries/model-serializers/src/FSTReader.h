@@ -21,6 +21,7 @@ static const QString FST_VERSION_FIELD = "version";
 static const QString NAME_FIELD = "name";
 static const QString TYPE_FIELD = "type";
 static const QString FILENAME_FIELD = "filename";
+static const QString PREVIEW_FILENAME_FIELD = "previewFilename";
 static const QString TEXDIR_FIELD = "texdir";
 static const QString LOD_FIELD = "lod";
 static const QString JOINT_INDEX_FIELD = "jointIndex";
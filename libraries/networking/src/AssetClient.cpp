@@ -18,7 +18,6 @@
 #include <QtCore/QBuffer>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QThread>
-#include <QtNetwork/QNetworkDiskCache>
 
 #include <shared/GlobalAppProperties.h>
 #include <shared/MiniPromises.h>
@@ -26,6 +25,7 @@
 #include "AssetRequest.h"
 #include "AssetUpload.h"
 #include "AssetUtils.h"
+#include "ContentCache.h"
 #include "MappingRequest.h"
 #include "NetworkAccessManager.h"
 #include "NetworkLogging.h"
@@ -35,6 +35,9 @@
 
 MessageID AssetClient::_currentID = 0;
 
+// the uploads that are at least this large check whether the asset-server already has the asset before sending it
+static const int MIN_SIZE_TO_CHECK_FOR_EXISTING_ASSET = 1024 * 1024;
+
 AssetClient::AssetClient() {
     _cacheDir = qApp->property(hifi::properties::APP_LOCAL_DATA_PATH).toString();
     setCustomDeleter([](Dependency* dependency){
@@ -72,17 +75,14 @@ void AssetClient::initCaching() {
 #endif
             _cacheDir = !cachePath.isEmpty() ? cachePath : "interfaceCache";
         }
-        QNetworkDiskCache* cache = new QNetworkDiskCache();
-        cache->setMaximumCacheSize(MAXIMUM_CACHE_SIZE);
-        cache->setCacheDirectory(_cacheDir);
-        networkAccessManager.setCache(cache);
+        networkAccessManager.setCache(new ContentCache(_cacheDir, MAXIMUM_CACHE_SIZE));
         qInfo() << "ResourceManager disk cache setup at" << _cacheDir
                  << "(size:" << MAXIMUM_CACHE_SIZE / BYTES_PER_GIGABYTES << "GB)";
     } else {
-        auto cache = qobject_cast<QNetworkDiskCache*>(networkAccessManager.cache());
+        auto cache = qobject_cast<ContentCache*>(networkAccessManager.cache());
         if (cache) {
-            qInfo() << "ResourceManager disk cache already setup at" << cache->cacheDirectory()
-                    << "(size:" << cache->maximumCacheSize() / BYTES_PER_GIGABYTES << "GB)";
+            qInfo() << "ResourceManager disk cache already setup at" << cache->getCacheDirectory()
+                    << "(size:" << cache->getMaximumCacheSize() / BYTES_PER_GIGABYTES << "GB)";
         }
     }
 
@@ -106,12 +106,12 @@ MiniPromise::Promise AssetClient::cacheInfoRequestAsync(MiniPromise::Promise def
     if (QThread::currentThread() != thread()) {
         QMetaObject::invokeMethod(this, "cacheInfoRequestAsync", Q_ARG(MiniPromise::Promise, deferred));
     } else {
-        auto cache = qobject_cast<QNetworkDiskCache*>(NetworkAccessManager::getInstance().cache());
+        auto cache = qobject_cast<ContentCache*>(NetworkAccessManager::getInstance().cache());
         if (cache) {
             deferred->resolve({
-                { "cacheDirectory", cache->cacheDirectory() },
+                { "cacheDirectory", cache->getCacheDirectory() },
                 { "cacheSize", cache->cacheSize() },
-                { "maximumCacheSize", cache->maximumCacheSize() },
+                { "maximumCacheSize", cache->getMaximumCacheSize() },
             });
         } else {
             deferred->reject(CACHE_ERROR_MESSAGE.arg(__FUNCTION__).arg("cache unavailable"));
@@ -298,11 +298,11 @@ void AssetClient::cacheInfoRequest(QObject* reciever, QString slot) {
         return;
     }
 
-    if (auto* cache = qobject_cast<QNetworkDiskCache*>(NetworkAccessManager::getInstance().cache())) {
+    if (auto* cache = qobject_cast<ContentCache*>(NetworkAccessManager::getInstance().cache())) {
         QMetaObject::invokeMethod(reciever, slot.toStdString().data(), Qt::QueuedConnection,
-                                  Q_ARG(QString, cache->cacheDirectory()),
+                                  Q_ARG(QString, cache->getCacheDirectory()),
                                   Q_ARG(qint64, cache->cacheSize()),
-                                  Q_ARG(qint64, cache->maximumCacheSize()));
+                                  Q_ARG(qint64, cache->getMaximumCacheSize()));
     } else {
         qCWarning(asset_client) << "No disk cache to get info from.";
     }
@@ -380,6 +380,15 @@ GetAllMappingsRequest* AssetClient::createGetAllMappingsRequest() {
     return request;
 }
 
+GetAllMappingsRequest* AssetClient::createGetMappingsPageRequest(const AssetUtils::AssetPath& prefix,
+                                                                 const AssetUtils::AssetPath& startAfter, uint32_t pageSize) {
+    auto request = new GetAllMappingsRequest(prefix, startAfter, pageSize);
+
+    request->moveToThread(thread());
+
+    return request;
+}
+
 DeleteMappingsRequest* AssetClient::createDeleteMappingsRequest(const AssetUtils::AssetPathList& paths) {
     auto request = new DeleteMappingsRequest(paths);
 
@@ -703,7 +712,8 @@ MessageID AssetClient::getAssetMapping(const AssetUtils::AssetPath& path, Mappin
     return INVALID_MESSAGE_ID;
 }
 
-MessageID AssetClient::getAllAssetMappings(MappingOperationCallback callback) {
+MessageID AssetClient::getAllAssetMappings(const AssetUtils::AssetPath& prefix, const AssetUtils::AssetPath& startAfter,
+                                           uint32_t pageSize, MappingOperationCallback callback) {
     Q_ASSERT(QThread::currentThread() == thread());
 
     auto nodeList = DependencyManager::get<LimitedNodeList>();
@@ -717,6 +727,13 @@ MessageID AssetClient::getAllAssetMappings(MappingOperationCallback callback) {
 
         packetList->writePrimitive(AssetUtils::AssetMappingOperationType::GetAll);
 
+        if (pageSize > 0) {
+            // the asset servers that don't page the mappings ignore this and reply with all of them
+            packetList->writeString(prefix);
+            packetList->writeString(startAfter);
+            packetList->writePrimitive(pageSize);
+        }
+
         if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
             _pendingMappingRequests[assetServer][messageID] = callback;
 
@@ -907,16 +924,47 @@ MessageID AssetClient::uploadAsset(const QByteArray& data, UploadResultCallback
     SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
 
     if (assetServer) {
-        auto packetList = NLPacketList::create(PacketType::AssetUpload, QByteArray(), true, true);
-
         auto messageID = ++_currentID;
-        packetList->writePrimitive(messageID);
 
-        uint64_t size = data.length();
-        packetList->writePrimitive(size);
-        packetList->write(data.constData(), size);
+        // a large asset that the server already has isn't sent again, it's asked about first.  This is only done when we
+        // can write to the server, otherwise the upload is sent so that its reply has the permission error.
+        if (data.length() >= MIN_SIZE_TO_CHECK_FOR_EXISTING_ASSET && nodeList->getThisNodeCanWriteAssets()) {
+            auto hash = AssetUtils::hashData(data);
+            _pendingUploads[assetServer][messageID] = callback;
 
-        if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
+            QWeakPointer<Node> weakAssetServer = assetServer;
+            getAssetInfo(hash.toHex(), [this, weakAssetServer, messageID, data](bool responseReceived,
+                                                                                 AssetUtils::AssetServerError error,
+                                                                                 AssetInfo info) {
+                auto assetServer = weakAssetServer.lock();
+                if (!assetServer) {
+                    // the upload was failed when the server went away
+                    return;
+                }
+                auto& messageCallbackMap = _pendingUploads[assetServer];
+                auto requestIt = messageCallbackMap.find(messageID);
+                if (requestIt == messageCallbackMap.end()) {
+                    // the upload was cancelled or failed in the meantime
+                    return;
+                }
+
+                if (responseReceived && error == AssetUtils::AssetServerError::NoError && info.size == data.length()) {
+                    qCDebug(asset_client) << "Asset-server already has asset with SHA256 hash" << info.hash
+                                          << "- not uploading it again";
+                    auto callback = requestIt->second;
+                    messageCallbackMap.erase(requestIt);
+                    callback(true, AssetUtils::AssetServerError::NoError, info.hash);
+                } else if (!sendUploadPacketList(assetServer, messageID, data)) {
+                    auto callback = requestIt->second;
+                    messageCallbackMap.erase(requestIt);
+                    callback(false, AssetUtils::AssetServerError::NoError, QString());
+                }
+            });
+
+            return messageID;
+        }
+
+        if (sendUploadPacketList(assetServer, messageID, data)) {
             _pendingUploads[assetServer][messageID] = callback;
 
             return messageID;
@@ -927,6 +975,19 @@ MessageID AssetClient::uploadAsset(const QByteArray& data, UploadResultCallback
     return INVALID_MESSAGE_ID;
 }
 
+bool AssetClient::sendUploadPacketList(const SharedNodePointer& assetServer, MessageID messageID, const QByteArray& data) {
+    auto packetList = NLPacketList::create(PacketType::AssetUpload, QByteArray(), true, true);
+
+    packetList->writePrimitive(messageID);
+
+    uint64_t size = data.length();
+    packetList->writePrimitive(size);
+    packetList->write(data.constData(), size);
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    return nodeList->sendPacketList(std::move(packetList), *assetServer) != -1;
+}
+
 void AssetClient::handleAssetUploadReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -56,6 +56,8 @@ public:
 
     Q_INVOKABLE GetMappingRequest* createGetMappingRequest(const AssetUtils::AssetPath& path);
     Q_INVOKABLE GetAllMappingsRequest* createGetAllMappingsRequest();
+    Q_INVOKABLE GetAllMappingsRequest* createGetMappingsPageRequest(const AssetUtils::AssetPath& prefix,
+                                                                   const AssetUtils::AssetPath& startAfter, uint32_t pageSize);
     Q_INVOKABLE DeleteMappingsRequest* createDeleteMappingsRequest(const AssetUtils::AssetPathList& paths);
     Q_INVOKABLE SetMappingRequest* createSetMappingRequest(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash);
     Q_INVOKABLE RenameMappingRequest* createRenameMappingRequest(const AssetUtils::AssetPath& oldPath, const AssetUtils::AssetPath& newPath);
@@ -85,7 +87,8 @@ private slots:
 
 private:
     MessageID getAssetMapping(const AssetUtils::AssetHash& hash, MappingOperationCallback callback);
-    MessageID getAllAssetMappings(MappingOperationCallback callback);
+    MessageID getAllAssetMappings(const AssetUtils::AssetPath& prefix, const AssetUtils::AssetPath& startAfter,
+                                  uint32_t pageSize, MappingOperationCallback callback);
     MessageID setAssetMapping(const QString& path, const AssetUtils::AssetHash& hash, MappingOperationCallback callback);
     MessageID deleteAssetMappings(const AssetUtils::AssetPathList& paths, MappingOperationCallback callback);
     MessageID renameAssetMapping(const AssetUtils::AssetPath& oldPath, const AssetUtils::AssetPath& newPath, MappingOperationCallback callback);
@@ -105,6 +108,7 @@ private:
     void handleCompleteCallback(const QWeakPointer<Node>& node, MessageID messageID, AssetUtils::DataOffset length);
 
     void forceFailureOfPendingRequests(SharedNodePointer node);
+    bool sendUploadPacketList(const SharedNodePointer& assetServer, MessageID messageID, const QByteArray& data);
 
     struct GetAssetRequestData {
         QSharedPointer<ReceivedMessage> message;
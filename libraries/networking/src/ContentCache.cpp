@@ -0,0 +1,328 @@
+//
+//  ContentCache.cpp
+//  libraries/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ContentCache.h"
+
+#include <functional>
+
+#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QRunnable>
+#include <QtCore/QSaveFile>
+
+#include "AssetUtils.h"
+#include "NetworkLogging.h"
+
+const QString ContentCache::CONTENT_DIRNAME = "content";
+
+static const QString INDEX_DIRNAME = "index";
+static const QString INDEX_EXT = ".meta";
+static const std::string CONTENT_EXT = "blob";
+static const quint32 INDEX_VERSION = 1;
+
+// The directories of the QNetworkDiskCache this cache replaced
+static const QStringList LEGACY_DIRNAMES = { "data8", "data9", "prepared" };
+
+namespace {
+
+class WriteTask : public QRunnable {
+public:
+    WriteTask(std::function<void()> write) : _write(write) {}
+    void run() override { _write(); }
+
+private:
+    std::function<void()> _write;
+};
+
+// Reads a cached file through a mapping of it, the file is kept from being ejected while the device is open
+class MappedContent : public QBuffer {
+public:
+    MappedContent(const cache::FilePointer& file) : _file(file), _mappedFile(QString::fromStdString(file->getFilepath())) {}
+    ~MappedContent() { close(); }
+
+    bool open() {
+        if (!_mappedFile.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+        qint64 size = _mappedFile.size();
+        uchar* mapped = _mappedFile.map(0, size);
+        if (mapped) {
+            setData(QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), (int)size));
+        } else {
+            setData(_mappedFile.readAll());
+        }
+        return QBuffer::open(QIODevice::ReadOnly);
+    }
+
+private:
+    cache::FilePointer _file;
+    QFile _mappedFile;
+};
+
+}
+
+ContentCache::ContentCache(const QString& cacheDirectory, qint64 maximumSize, QObject* parent) :
+    QAbstractNetworkCache(parent),
+    _cacheDirectory(cacheDirectory),
+    _maximumCacheSize(maximumSize)
+{
+    // the entries left by the QNetworkDiskCache this replaced are stored by URL and can't be found by content
+    QDir directory(_cacheDirectory);
+    for (const auto& dirname : LEGACY_DIRNAMES) {
+        if (directory.exists(dirname)) {
+            qCDebug(networking) << "Removing the previous disk cache" << directory.filePath(dirname);
+            QDir(directory.filePath(dirname)).removeRecursively();
+        }
+    }
+
+    QString contentDirectory = directory.filePath(CONTENT_DIRNAME);
+    _indexDirectory = QDir(contentDirectory).filePath(INDEX_DIRNAME);
+    QDir().mkpath(_indexDirectory);
+
+    _contents = std::make_shared<cache::FileCache>(contentDirectory.toStdString(), CONTENT_EXT);
+    _contents->setSharedBudget(cache::getResourceBudget());
+    _contents->initialize();
+    _contents->setMaxSize((size_t)maximumSize);
+
+    _writer.setMaxThreadCount(1);
+}
+
+ContentCache::~ContentCache() {
+    flush();
+    qDeleteAll(_preparedDevices.keys());
+}
+
+QString ContentCache::getIndexPath(const QUrl& url) const {
+    auto name = QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Sha1).toHex();
+    return QDir(_indexDirectory).filePath(QString(name) + INDEX_EXT);
+}
+
+bool ContentCache::findEntry(const QUrl& url, Entry& entry) {
+    QMutexLocker locker(&_mutex);
+    auto itr = _entries.find(url);
+    if (itr == _entries.end()) {
+        // not used since startup, read its index file
+        QFile file(getIndexPath(url));
+        if (!file.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+        QDataStream stream(&file);
+        quint32 version;
+        QUrl storedUrl;
+        Entry stored;
+        stream >> version;
+        if (version != INDEX_VERSION) {
+            return false;
+        }
+        stream >> storedUrl >> stored.hash >> stored.metaData;
+        if (stream.status() != QDataStream::Ok || storedUrl != url || stored.hash.isEmpty()) {
+            return false;
+        }
+        itr = _entries.insert(url, stored);
+    }
+
+    entry = itr.value();
+    if (_pendingContents.contains(entry.hash) || _contents->getFile(entry.hash.toStdString())) {
+        return true;
+    }
+
+    // the content was ejected, by this cache or by another one sharing its budget
+    _entries.erase(itr);
+    locker.unlock();
+    removeEntry(url);
+    return false;
+}
+
+void ContentCache::writeEntry(const QUrl& url, const Entry& entry) {
+    {
+        QMutexLocker locker(&_mutex);
+        _entries[url] = entry;
+    }
+
+    QString path = getIndexPath(url);
+    _writer.start(new WriteTask([path, url, entry] {
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly)) {
+            qCWarning(networking) << "Unable to write the disk cache index" << path;
+            return;
+        }
+        QDataStream stream(&file);
+        stream << INDEX_VERSION << url << entry.hash << entry.metaData;
+        file.commit();
+    }));
+}
+
+void ContentCache::removeEntry(const QUrl& url) {
+    {
+        QMutexLocker locker(&_mutex);
+        _entries.remove(url);
+    }
+
+    // removed on the writer thread so it can't be recreated by an index write still pending
+    QString path = getIndexPath(url);
+    _writer.start(new WriteTask([path] {
+        QFile::remove(path);
+    }));
+}
+
+QNetworkCacheMetaData ContentCache::metaData(const QUrl& url) {
+    Entry entry;
+    if (!findEntry(url, entry)) {
+        return QNetworkCacheMetaData();
+    }
+    return entry.metaData;
+}
+
+void ContentCache::updateMetaData(const QNetworkCacheMetaData& metaData) {
+    Entry entry;
+    if (findEntry(metaData.url(), entry)) {
+        entry.metaData = metaData;
+        writeEntry(metaData.url(), entry);
+    }
+}
+
+QIODevice* ContentCache::data(const QUrl& url) {
+    Entry entry;
+    if (!findEntry(url, entry)) {
+        return nullptr;
+    }
+
+    {
+        QMutexLocker locker(&_mutex);
+        auto pending = _pendingContents.find(entry.hash);
+        if (pending != _pendingContents.end()) {
+            auto buffer = new QBuffer();
+            buffer->setData(pending.value());
+            buffer->open(QIODevice::ReadOnly);
+            return buffer;
+        }
+    }
+
+    auto file = _contents->getFile(entry.hash.toStdString());
+    if (!file) {
+        return nullptr;
+    }
+    auto device = new MappedContent(file);
+    if (!device->open()) {
+        qCWarning(networking) << "Unable to read the disk cache content of" << url;
+        delete device;
+        return nullptr;
+    }
+    return device;
+}
+
+bool ContentCache::remove(const QUrl& url) {
+    bool removed = false;
+    {
+        QMutexLocker locker(&_mutex);
+        for (auto itr = _preparedDevices.begin(); itr != _preparedDevices.end();) {
+            if (itr.value().url() == url) {
+                delete itr.key();
+                itr = _preparedDevices.erase(itr);
+                removed = true;
+            } else {
+                ++itr;
+            }
+        }
+    }
+
+    // the content itself is left to the budget, other URLs may share it
+    Entry entry;
+    if (findEntry(url, entry)) {
+        removeEntry(url);
+        removed = true;
+    }
+    return removed;
+}
+
+qint64 ContentCache::cacheSize() const {
+    return (qint64)_contents->getSizeTotalFiles();
+}
+
+QIODevice* ContentCache::prepare(const QNetworkCacheMetaData& metaData) {
+    if (!metaData.isValid() || !metaData.url().isValid() || !metaData.saveToDisk()) {
+        return nullptr;
+    }
+
+    auto buffer = new QBuffer();
+    buffer->open(QIODevice::ReadWrite);
+    QMutexLocker locker(&_mutex);
+    _preparedDevices.insert(buffer, metaData);
+    return buffer;
+}
+
+void ContentCache::insert(QIODevice* device) {
+    QNetworkCacheMetaData metaData;
+    {
+        QMutexLocker locker(&_mutex);
+        auto itr = _preparedDevices.find(device);
+        if (itr == _preparedDevices.end()) {
+            qCWarning(networking) << "ContentCache::insert called with a device it didn't prepare";
+            return;
+        }
+        metaData = itr.value();
+        _preparedDevices.erase(itr);
+    }
+
+    auto buffer = qobject_cast<QBuffer*>(device);
+    QByteArray content = buffer ? buffer->data() : QByteArray();
+    delete device;
+    if (content.isEmpty()) {
+        return;
+    }
+
+    Entry entry;
+    entry.hash = AssetUtils::hashData(content).toHex();
+    entry.metaData = metaData;
+
+    {
+        QMutexLocker locker(&_mutex);
+        _pendingContents.insert(entry.hash, content);
+    }
+
+    // the content is written before the index that refers to it, the writer runs one task at a time
+    QByteArray hash = entry.hash;
+    _writer.start(new WriteTask([this, hash, content] {
+        std::string key = hash.toStdString();
+        if (!_contents->getFile(key)) {
+            _contents->writeFile(content.data(), cache::FileCache::Metadata(key, content.size()));
+        }
+        QMutexLocker locker(&_mutex);
+        _pendingContents.remove(hash);
+    }));
+    writeEntry(metaData.url(), entry);
+}
+
+QByteArray ContentCache::getContentHash(const QUrl& url) {
+    Entry entry;
+    if (!findEntry(url, entry)) {
+        return QByteArray();
+    }
+    return entry.hash;
+}
+
+void ContentCache::flush() {
+    _writer.waitForDone();
+}
+
+void ContentCache::clear() {
+    flush();
+    {
+        QMutexLocker locker(&_mutex);
+        _entries.clear();
+    }
+    _contents->wipe();
+    QDir(_indexDirectory).removeRecursively();
+    QDir().mkpath(_indexDirectory);
+}
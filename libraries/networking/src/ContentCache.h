@@ -0,0 +1,82 @@
+//
+//  ContentCache.h
+//  libraries/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ContentCache_h
+#define overte_ContentCache_h
+
+#include <memory>
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QThreadPool>
+#include <QtNetwork/QAbstractNetworkCache>
+
+#include <shared/FileCache.h>
+
+/// The disk cache of the HTTP and ATP downloads.  The contents are stored by their hash, the same hash ATP assets are
+/// named by, so bytes shared by several URLs, or by an ATP asset and an HTTP mirror of it, are stored once.  They're kept
+/// in a FileCache that shares its budget with the KTX cache, written on a dedicated thread and read through a file
+/// mapping.
+class ContentCache : public QAbstractNetworkCache {
+    Q_OBJECT
+
+public:
+    static const QString CONTENT_DIRNAME;
+
+    ContentCache(const QString& cacheDirectory, qint64 maximumSize, QObject* parent = nullptr);
+    ~ContentCache();
+
+    const QString& getCacheDirectory() const { return _cacheDirectory; }
+    qint64 getMaximumCacheSize() const { return _maximumCacheSize; }
+
+    QNetworkCacheMetaData metaData(const QUrl& url) override;
+    void updateMetaData(const QNetworkCacheMetaData& metaData) override;
+    QIODevice* data(const QUrl& url) override;
+    bool remove(const QUrl& url) override;
+    qint64 cacheSize() const override;
+    QIODevice* prepare(const QNetworkCacheMetaData& metaData) override;
+    void insert(QIODevice* device) override;
+
+    /// Returns the hash the content of url is stored by, or an empty hash if it isn't cached
+    QByteArray getContentHash(const QUrl& url);
+
+    /// Waits for the pending writes to reach the disk
+    void flush();
+
+public slots:
+    void clear() override;
+
+private:
+    struct Entry {
+        QByteArray hash;
+        QNetworkCacheMetaData metaData;
+    };
+
+    QString getIndexPath(const QUrl& url) const;
+    bool findEntry(const QUrl& url, Entry& entry);
+    void writeEntry(const QUrl& url, const Entry& entry);
+    void removeEntry(const QUrl& url);
+
+    const QString _cacheDirectory;
+    const qint64 _maximumCacheSize;
+    std::shared_ptr<cache::FileCache> _contents;
+    QString _indexDirectory;
+    // a single thread, so the writes happen in order
+    QThreadPool _writer;
+
+    QMutex _mutex;
+    QHash<QUrl, Entry> _entries;
+    // the contents being written, served from memory until they're on disk
+    QHash<QByteArray, QByteArray> _pendingContents;
+    QHash<QIODevice*, QNetworkCacheMetaData> _preparedDevices;
+};
+
+#endif // overte_ContentCache_h
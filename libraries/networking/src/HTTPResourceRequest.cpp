@@ -12,11 +12,17 @@
 
 #include "HTTPResourceRequest.h"
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+
 #include <QFile>
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QMetaEnum>
 
+#include <ResourceRequestObserver.h>
 #include <SharedUtil.h>
 #include <StatTracker.h>
 
@@ -24,12 +30,96 @@
 #include "NetworkLogging.h"
 #include "NetworkingConstants.h"
 
+// The requests in flight to each host, and the ones waiting for them to finish
+struct HostRequests {
+    int active { 0 };
+    std::deque<HTTPResourceRequest*> waiting;
+};
+static std::mutex hostRequestsMutex;
+static QHash<QString, HostRequests> hostRequests;
+static std::atomic<int> maxRequestsPerHost { HTTPResourceRequest::DEFAULT_MAX_REQUESTS_PER_HOST };
+
 HTTPResourceRequest::~HTTPResourceRequest() {
     if (_reply) {
         _reply->disconnect(this);
         _reply->deleteLater();
         _reply = nullptr;
     }
+    releaseHostSlot();
+}
+
+void HTTPResourceRequest::setMaxRequestsPerHost(int maxRequests) {
+    maxRequestsPerHost = std::max(maxRequests, 1);
+
+    // start the requests the new limit lets through
+    std::lock_guard<std::mutex> lock(hostRequestsMutex);
+    for (auto& host : hostRequests) {
+        while (host.active < maxRequestsPerHost && !host.waiting.empty()) {
+            auto next = host.waiting.front();
+            host.waiting.pop_front();
+            next->_holdsHostSlot = true;
+            host.active++;
+            QMetaObject::invokeMethod(next, "startRequest", Qt::QueuedConnection);
+        }
+    }
+}
+
+int HTTPResourceRequest::getMaxRequestsPerHost() {
+    return maxRequestsPerHost;
+}
+
+QString HTTPResourceRequest::getHostKey() const {
+    return _url.scheme() + "://" + _url.authority();
+}
+
+bool HTTPResourceRequest::acquireHostSlot() {
+    std::lock_guard<std::mutex> lock(hostRequestsMutex);
+    auto& host = hostRequests[getHostKey()];
+    if (host.active < maxRequestsPerHost) {
+        host.active++;
+        _holdsHostSlot = true;
+        return true;
+    }
+    host.waiting.push_back(this);
+    return false;
+}
+
+void HTTPResourceRequest::releaseHostSlot() {
+    std::lock_guard<std::mutex> lock(hostRequestsMutex);
+    auto itr = hostRequests.find(getHostKey());
+    if (itr == hostRequests.end()) {
+        return;
+    }
+    auto& host = itr.value();
+    if (!_holdsHostSlot) {
+        // a request destroyed while waiting just leaves the queue
+        host.waiting.erase(std::remove(host.waiting.begin(), host.waiting.end(), this), host.waiting.end());
+        return;
+    }
+
+    _holdsHostSlot = false;
+    host.active--;
+    if (!host.waiting.empty()) {
+        // the slot goes straight to the next request, which is started on its own thread
+        auto next = host.waiting.front();
+        host.waiting.pop_front();
+        next->_holdsHostSlot = true;
+        host.active++;
+        QMetaObject::invokeMethod(next, "startRequest", Qt::QueuedConnection);
+    } else if (host.active == 0) {
+        hostRequests.erase(itr);
+    }
+}
+
+void HTTPResourceRequest::recordTiming(bool multiplexed) {
+    auto observer = DependencyManager::get<ResourceRequestObserver>();
+    if (!observer || _sentUsecs == 0) {
+        return;
+    }
+    quint64 now = usecTimestampNow();
+    quint64 firstByteUsecs = _firstByteUsecs > 0 ? _firstByteUsecs : now;
+    observer->recordTiming(_url, _sentUsecs - _queuedUsecs, firstByteUsecs - _queuedUsecs, now - _queuedUsecs,
+                           _data.size(), multiplexed);
 }
 
 void HTTPResourceRequest::setupTimer() {
@@ -54,6 +144,19 @@ void HTTPResourceRequest::cleanupTimer() {
 void HTTPResourceRequest::doSend() {
     DependencyManager::get<StatTracker>()->incrementStat(STAT_HTTP_REQUEST_STARTED);
 
+    _queuedUsecs = usecTimestampNow();
+    if (acquireHostSlot()) {
+        startRequest();
+    }
+}
+
+void HTTPResourceRequest::startRequest() {
+    if (_state != InProgress) {
+        releaseHostSlot();
+        return;
+    }
+    _sentUsecs = usecTimestampNow();
+
     QNetworkRequest networkRequest(_url);
     networkRequest.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
     networkRequest.setHeader(QNetworkRequest::UserAgentHeader, NetworkingConstants::OVERTE_USER_AGENT);
@@ -75,6 +178,8 @@ void HTTPResourceRequest::doSend() {
         networkRequest.setRawHeader("Range", byteRange.toLatin1());
     }
     networkRequest.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, false);
+    // HTTP/2 multiplexes the requests to a host over one kept alive connection, the byte ranges of KTX mips included
+    networkRequest.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
 
     _reply = NetworkAccessManager::getInstance().get(networkRequest);
     
@@ -89,6 +194,7 @@ void HTTPResourceRequest::onRequestFinished() {
     Q_ASSERT(_reply);
 
     cleanupTimer();
+    releaseHostSlot();
 
     // Content-Range headers have the form: 
     //
@@ -198,10 +304,13 @@ void HTTPResourceRequest::onRequestFinished() {
             _result = Error;
             break;
     }
+    bool multiplexed = _reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool();
     _reply->disconnect(this);
     _reply->deleteLater();
     _reply = nullptr;
-    
+
+    recordTiming(multiplexed);
+
     _state = Finished;
     emit finished();
 
@@ -222,6 +331,9 @@ void HTTPResourceRequest::onDownloadProgress(qint64 bytesReceived, qint64 bytesT
     
     // We've received data, so reset the timer
     _sendTimer->start();
+    if (_firstByteUsecs == 0 && bytesReceived > 0) {
+        _firstByteUsecs = usecTimestampNow();
+    }
 
     emit progress(bytesReceived, bytesTotal);
 
@@ -237,7 +349,9 @@ void HTTPResourceRequest::onTimeout() {
     _reply = nullptr;
 
     cleanupTimer();
-    
+    releaseHostSlot();
+    recordTiming(false);
+
     _result = Timeout;
     _state = Finished;
     emit finished();
@@ -29,10 +29,17 @@ public:
     ) : ResourceRequest(url, isObservable, callerId) { }
     ~HTTPResourceRequest();
 
+    static const int DEFAULT_MAX_REQUESTS_PER_HOST { 16 };
+
+    /// Sets how many requests may be in flight to one host, the others wait for one of them to finish
+    static void setMaxRequestsPerHost(int maxRequests);
+    static int getMaxRequestsPerHost();
+
 protected:
     virtual void doSend() override;
 
 private slots:
+    void startRequest();
     void onTimeout();
     void onDownloadProgress(qint64 bytesReceived, qint64 bytesTotal);
     void onRequestFinished();
@@ -41,8 +48,18 @@ private:
     void setupTimer();
     void cleanupTimer();
 
+    QString getHostKey() const;
+    bool acquireHostSlot();
+    void releaseHostSlot();
+    void recordTiming(bool multiplexed);
+
     QTimer* _sendTimer { nullptr };
     QNetworkReply* _reply { nullptr };
+    bool _holdsHostSlot { false };
+
+    quint64 _queuedUsecs { 0 };
+    quint64 _sentUsecs { 0 };
+    quint64 _firstByteUsecs { 0 };
 };
 
 #endif
@@ -12,6 +12,7 @@
 
 #include "LimitedNodeList.h"
 
+#include <algorithm>
 #include <cstring>
 #include <cstdlib>
 #include <cstdio>
@@ -36,6 +37,7 @@
 #include "Assignment.h"
 #include "SockAddr.h"
 #include "NetworkLogging.h"
+#include "PacketTrafficStats.h"
 #include "udt/Packet.h"
 #include "HMACAuth.h"
 
@@ -321,6 +323,7 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
             });
 
             if (sendingNodeType != NodeType::Unassigned) {
+                _packetReceiver->getTrafficStats().recordReceived(headerType, sendingNodeType, packet.getDataSize());
                 return true;
             } else {
                 HIFI_FCDEBUG(networking(), "Replicated packet of type" << headerType
@@ -329,6 +332,7 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
                 return false;
             }
         } else {
+            _packetReceiver->getTrafficStats().recordReceived(headerType, NodeType::Unassigned, packet.getDataSize());
             return true;
         }
     } else {
@@ -351,6 +355,7 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
             packet.getSenderSockAddr() == getDomainSockAddr() &&
             PacketTypeEnum::getDomainSourcedPackets().contains(headerType)) {
             // This is a packet sourced by the domain server
+            _packetReceiver->getTrafficStats().recordReceived(headerType, NodeType::DomainServer, packet.getDataSize());
             return true;
         }
 
@@ -388,6 +393,7 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
             // from this sending node
             sourceNode->setLastHeardMicrostamp(usecTimestampNow());
 
+            _packetReceiver->getTrafficStats().recordReceived(headerType, sourceNode->getType(), packet.getDataSize());
             return true;
 
         } else if (!isDelayedNode(sourceID)){
@@ -622,6 +628,7 @@ void LimitedNodeList::eraseAllNodes(QString reason) {
         }
         _localIDMap.clear();
         _nodeHash.clear();
+        rebuildNodeSnapshot();
     }
 
     foreach(const SharedNodePointer& killedNode, killedNodes) {
@@ -647,6 +654,7 @@ bool LimitedNodeList::killNodeWithUUID(const QUuid& nodeUUID, ConnectionID newCo
             QWriteLocker writeLocker(&_nodeMutex);
             _localIDMap.unsafe_erase(matchingNode->getLocalID());
             _nodeHash.unsafe_erase(matchingNode->getUUID());
+            rebuildNodeSnapshot();
         }
 
         handleNodeKill(matchingNode, newConnectionID);
@@ -684,6 +692,18 @@ void LimitedNodeList::handleNodeKill(const SharedNodePointer& node, ConnectionID
     }
 }
 
+void LimitedNodeList::rebuildNodeSnapshot() {
+    std::lock_guard<std::mutex> lock(_nodeSnapshotMutex);
+
+    auto nodes = std::make_shared<NodeSnapshot>();
+    nodes->reserve(_nodeHash.size());
+    std::transform(_nodeHash.cbegin(), _nodeHash.cend(), std::back_inserter(*nodes), [](const NodeHash::value_type& it) {
+        return it.second;
+    });
+
+    std::atomic_store(&_nodeSnapshot, NodeSnapshotPointer(std::move(nodes)));
+}
+
 SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t nodeType,
                                                    const SockAddr& publicSocket, const SockAddr& localSocket,
                                                    Node::LocalID localID, bool isReplicated, bool isUpstream,
@@ -707,6 +727,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
                 QWriteLocker writeLocker(&_nodeMutex);
                 _localIDMap.unsafe_erase(node->getLocalID());
                 _nodeHash.unsafe_erase(node->getUUID());
+                rebuildNodeSnapshot();
             }
             handleNodeKill(node);
         }
@@ -751,6 +772,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         // insert the new node and release our read lock
         _nodeHash.insert({ newNode->getUUID(), newNodePointer });
         _localIDMap.insert({ localID, newNodePointer });
+        rebuildNodeSnapshot();
     }
 
     qCDebug(networking) << "Added" << *newNode;
@@ -1368,6 +1390,35 @@ bool LimitedNodeList::getLocalServerPortFromSharedMemory(const QString key, quin
     }
 }
 
+bool LimitedNodeList::setConnectionCongestionControl(const QString& name) {
+    auto ccFactory = udt::createCongestionControlFactory(name);
+    if (!ccFactory) {
+        qCWarning(networking) << "Unknown congestion control" << name << "- expected one of"
+            << udt::getCongestionControlNames();
+        return false;
+    }
+
+    qCDebug(networking) << "Using" << name << "congestion control for new connections";
+    _nodeSocket.setCongestionControlFactory(std::move(ccFactory));
+    return true;
+}
+
+bool LimitedNodeList::setConnectionCongestionControl(const SockAddr& destination, const QString& name) {
+    auto ccFactory = udt::createCongestionControlFactory(name);
+    if (!ccFactory) {
+        qCWarning(networking) << "Unknown congestion control" << name << "- expected one of"
+            << udt::getCongestionControlNames();
+        return false;
+    }
+
+    _nodeSocket.setCongestionControlFactory(destination, std::move(ccFactory));
+    return true;
+}
+
+QJsonObject LimitedNodeList::sampleTrafficStats() {
+    return _packetReceiver->getTrafficStats().sample();
+}
+
 void LimitedNodeList::flagTimeForConnectionStep(ConnectionStep connectionStep) {
     QMetaObject::invokeMethod(this, "flagTimeForConnectionStep",
                               Q_ARG(ConnectionStep, connectionStep),
@@ -17,6 +17,7 @@
 #include <stdint.h>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 
@@ -211,44 +212,39 @@ public:
     using value_type = SharedNodePointer;
     using const_iterator = std::vector<value_type>::const_iterator;
 
-    // Cede control of iteration under a single read lock (e.g. for use by thread pools)
+    // An immutable copy of the node list, rebuilt whenever a node is added or removed. Holding it keeps its nodes
+    // alive, and it can be iterated without the node lock.
+    using NodeSnapshot = std::vector<SharedNodePointer>;
+    using NodeSnapshotPointer = std::shared_ptr<const NodeSnapshot>;
+    NodeSnapshotPointer getNodeSnapshot() const { return std::atomic_load(&_nodeSnapshot); }
+
+    // Cede control of iteration over the current node snapshot (e.g. for use by thread pools)
     // Use this for nested loops instead of taking nested read locks!
-    //   This allows multiple threads (i.e. a thread pool) to share a lock
-    //   without deadlocking when a dying node attempts to acquire a write lock
+    //   This allows multiple threads (i.e. a thread pool) to share one list of nodes
+    //   without taking the node lock at all, so a dying node never waits on a frame
     template<typename NestedNodeLambda>
     void nestedEach(NestedNodeLambda functor,
                     int* lockWaitOut = nullptr,
                     int* nodeTransformOut = nullptr,
                     int* functorOut = nullptr) {
-        quint64 start, endTransform, endFunctor;
+        quint64 start, endSnapshot, endFunctor;
 
         start = usecTimestampNow();
-        std::vector<SharedNodePointer> nodes;
-        {
-            QReadLocker readLock(&_nodeMutex);
-            auto endLock = usecTimestampNow();
-            if (lockWaitOut) {
-                *lockWaitOut = (endLock - start);
-            }
+        auto nodes = getNodeSnapshot();
 
-            // Size of _nodeHash could change at any time,
-            // so reserve enough memory for the current size
-            // and then back insert all the nodes found
-            nodes.reserve(_nodeHash.size());
-            std::transform(_nodeHash.cbegin(), _nodeHash.cend(), std::back_inserter(nodes), [&](const NodeHash::value_type& it) {
-                return it.second;
-            });
-
-            endTransform = usecTimestampNow();
-            if (nodeTransformOut) {
-                *nodeTransformOut = (endTransform - endLock);
-            }
+        endSnapshot = usecTimestampNow();
+        if (lockWaitOut) {
+            *lockWaitOut = (endSnapshot - start);
+        }
+        if (nodeTransformOut) {
+            // there is nothing to copy anymore
+            *nodeTransformOut = 0;
         }
 
-        functor(nodes.cbegin(), nodes.cend());
+        functor(nodes->cbegin(), nodes->cend());
         endFunctor = usecTimestampNow();
         if (functorOut) {
-            *functorOut = (endFunctor - endTransform);
+            *functorOut = (endFunctor - endSnapshot);
         }
     }
 
@@ -296,13 +292,13 @@ public:
         return SharedNodePointer();
     }
 
-    // This is unsafe because it does not take a lock
-    // Must only be called when you know that a read lock on the node mutex is held
-    // and will be held for the duration of your iteration
+    // This does not take a lock, it iterates the current node snapshot
+    // Nodes added or removed during the iteration are not seen
     template<typename NodeLambda>
     void unsafeEachNode(NodeLambda functor) {
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
+        auto nodes = getNodeSnapshot();
+        for (const auto& node : *nodes) {
+            functor(node);
         }
     }
 
@@ -317,6 +313,25 @@ public:
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
 
+    // pick the congestion control for new connections, overall or to one destination, by one of
+    // udt::getCongestionControlNames() - returns false for an unknown name
+    bool setConnectionCongestionControl(const QString& name);
+    bool setConnectionCongestionControl(const SockAddr& destination, const QString& name);
+
+    void setSendBatchingEnabled(bool enabled) { _nodeSocket.setSendBatchingEnabled(enabled); }
+    int flushSendBatch() { return _nodeSocket.flushSendBatch(); }
+    udt::DatagramBatchWriter::Stats sampleSendBatchStats() { return _nodeSocket.sampleSendBatchStats(); }
+
+    // packets and bytes received per packet type and source node type, with histograms of how long messages waited
+    // for their listener and how long it took - see PacketTrafficStats
+    QJsonObject sampleTrafficStats();
+
+    // parity for unreliable packets, sent for these types to nodes that ask for it and asked of nodes when loss is high
+    void setForwardErrorCorrectionTypes(const QSet<PacketType>& packetTypes)
+        { _nodeSocket.setForwardErrorCorrectionTypes(packetTypes); }
+    void setForwardErrorCorrectionRequestsEnabled(bool enabled)
+        { _nodeSocket.setForwardErrorCorrectionRequestsEnabled(enabled); }
+
     void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
     bool packetVersionMatch(const udt::Packet& packet);
 
@@ -441,8 +456,13 @@ protected:
     void removeDelayedAdd(QUuid nodeUUID);
     bool isDelayedNode(QUuid nodeUUID);
 
+    // Must be called with _nodeMutex held, after every change to _nodeHash
+    void rebuildNodeSnapshot();
+
     NodeHash _nodeHash;
     mutable QReadWriteLock _nodeMutex { QReadWriteLock::Recursive };
+    std::mutex _nodeSnapshotMutex; // inserts only take a read lock, so rebuilds can still race each other
+    NodeSnapshotPointer _nodeSnapshot { std::make_shared<const NodeSnapshot>() };
     udt::Socket _nodeSocket;
     QUdpSocket* _dtlsSocket { nullptr };
     SockAddr _localSockAddr;
@@ -470,10 +490,15 @@ protected:
     void eachNodeHashIterator(IteratorLambda functor) {
         QWriteLocker writeLock(&_nodeMutex);
         NodeHash::iterator it = _nodeHash.begin();
+        auto previousSize = _nodeHash.size();
 
         while (it != _nodeHash.end()) {
             functor(it);
         }
+
+        if (_nodeHash.size() != previousSize) {
+            rebuildNodeSnapshot();
+        }
     }
 
     std::unordered_map<QUuid, ConnectionID> _connectionIDs;
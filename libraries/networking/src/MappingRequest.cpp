@@ -104,9 +104,17 @@ void GetMappingRequest::doStart() {
     });
 };
 
+GetAllMappingsRequest::GetAllMappingsRequest(const AssetUtils::AssetPath& prefix, const AssetUtils::AssetPath& startAfter,
+                                             uint32_t pageSize) :
+    _prefix(prefix),
+    _startAfter(startAfter),
+    _pageSize(pageSize)
+{
+}
+
 void GetAllMappingsRequest::doStart() {
     auto assetClient = DependencyManager::get<AssetClient>();
-    _mappingRequestID = assetClient->getAllAssetMappings(
+    _mappingRequestID = assetClient->getAllAssetMappings(_prefix, _startAfter, _pageSize,
             [this, assetClient](bool responseReceived, AssetUtils::AssetServerError error, QSharedPointer<ReceivedMessage> message) {
 
         _mappingRequestID = INVALID_MESSAGE_ID;
@@ -139,6 +147,11 @@ void GetAllMappingsRequest::doStart() {
                 }
                 _mappings[path] = { hash, status, lastBakeErrors };
             }
+            // the asset servers that don't page the mappings reply with all of them
+            _hasMore = false;
+            if (_pageSize > 0 && message->getBytesLeftToRead() > 0) {
+                message->readPrimitive(&_hasMore);
+            }
         }
         emit finished(this);
     });
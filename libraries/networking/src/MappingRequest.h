@@ -120,7 +120,13 @@ private:
 class GetAllMappingsRequest : public MappingRequest {
     Q_OBJECT
 public:
+    GetAllMappingsRequest() = default;
+    // Requests a page of at most pageSize of the mappings whose paths start with prefix, from the first path after
+    // startAfter on.  The next page starts after the last path of this one, while hasMore() is true.
+    GetAllMappingsRequest(const AssetUtils::AssetPath& prefix, const AssetUtils::AssetPath& startAfter, uint32_t pageSize);
+
     AssetUtils::AssetMappings getMappings() const { return _mappings;  }
+    bool hasMore() const { return _hasMore; }
 
 signals:
     void finished(GetAllMappingsRequest* thisRequest);
@@ -128,7 +134,12 @@ signals:
 private:
     virtual void doStart() override;
 
+    AssetUtils::AssetPath _prefix;
+    AssetUtils::AssetPath _startAfter;
+    uint32_t _pageSize { 0 };
+
     AssetUtils::AssetMappings _mappings;
+    bool _hasMore { false };
 };
 
 class SetBakingEnabledRequest : public MappingRequest {
@@ -150,15 +150,24 @@ public:
      * Subscribes the scripting environment &mdash; Interface, the entity script server, or assignment client instance &mdash; 
      * to receive messages on a specific channel. This means, for example, that if there are two Interface scripts that 
      * subscribe to different channels, both scripts will receive messages on both channels.
+     * <p>A channel name that ends with <code>"*"</code> subscribes to all the channels whose names start with what comes
+     * before it.</p>
      * @function Messages.subscribe
      * @param {string} channel - The channel to subscribe to.
+     * @example <caption>Subscribe to the channels of all the rooms of a game.</caption>
+     * Messages.subscribe("org.overte.example.game.room.*");
+     * Messages.messageReceived.connect(function (channel, message, senderID, localOnly) {
+     *     print("Message received on " + channel + ": " + message);
+     * });
      */
     Q_INVOKABLE void subscribe(QString channel);
 
     /*@jsdoc
      * Unsubscribes the scripting environment from receiving messages on a specific channel.
      * @function Messages.unsubscribe
-     * @param {string} channel - The channel to unsubscribe from.
+     * @param {string} channel - The channel to unsubscribe from, as it was subscribed to. A wildcard channel such as
+     *     <code>"game.room.*"</code> has to be unsubscribed from with the same name, not with the names of the channels it
+     *     matches.
      */
     Q_INVOKABLE void unsubscribe(QString channel);
 
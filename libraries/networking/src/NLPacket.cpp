@@ -91,7 +91,7 @@ NLPacket::NLPacket(const NLPacket& other) : Packet(other) {
 }
 
 NLPacket::NLPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr) :
-    Packet(std::move(data), size, senderSockAddr)
+    Packet(udt::PacketBufferPool::adopt(std::move(data)), size, senderSockAddr)
 {    
     // sanity check before we decrease the payloadSize with the payloadCapacity
     Q_ASSERT(_payloadSize == _payloadCapacity);
@@ -39,11 +39,11 @@
 #include "FingerprintUtils.h"
 
 #include "NetworkLogging.h"
+#include "NodeStats.h"
 #include "udt/PacketHeaders.h"
 #include "SharedUtil.h"
 #include <Trace.h>
 #include <ModerationFlags.h>
-#include "WarningsSuppression.h"
 
 using namespace std::chrono;
 
@@ -187,12 +187,7 @@ qint64 NodeList::sendStats(QJsonObject statsObject, SockAddr destination) {
 
     auto statsPacketList = NLPacketList::create(PacketType::NodeJsonStats, QByteArray(), true, true);
 
-    QJsonDocument jsonDocument(statsObject);
-
-    OVERTE_IGNORE_DEPRECATED_BEGIN
-    // Can't use CBOR yet, will break protocol.
-    statsPacketList->write(jsonDocument.toBinaryData());
-    OVERTE_IGNORE_DEPRECATED_END
+    statsPacketList->write(NodeStats::encode(statsObject));
 
     sendPacketList(std::move(statsPacketList), destination);
     return 0;
@@ -319,6 +314,9 @@ void NodeList::reset(QString reason, bool skipDomainHandlerReset) {
         _domainHandler.softReset(reason);
     }
 
+    // the next domain list is a full one
+    _domainListVersion = 0;
+
     // refresh the owner UUID to the NULL UUID
     setSessionUUID(QUuid());
     setSessionLocalID(Node::NULL_LOCAL_ID);
@@ -527,6 +525,16 @@ void NodeList::sendDomainServerCheckIn() {
                 }
             }
 
+        } else {
+            // ask for the nodes that changed since the last domain list, and for the full list every so often so that the
+            // nodes missed in lost packets are caught up with
+            static const int CHECK_INS_PER_FULL_DOMAIN_LIST = 10;
+            if (++_checkInsSinceFullDomainList >= CHECK_INS_PER_FULL_DOMAIN_LIST) {
+                _checkInsSinceFullDomainList = 0;
+                packetStream << quint32(0);
+            } else {
+                packetStream << _domainListVersion;
+            }
         }
 
         flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SendDSCheckIn);
@@ -766,6 +774,9 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
     bool newConnection;
     packetStream >> newConnection;
 
+    quint32 domainListVersion;
+    packetStream >> domainListVersion;
+
     if (newConnection) {
         _nodeConnectTimestamp = usecTimestampNow();
         _connectReason = Connect;
@@ -866,14 +877,19 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
     while (packetStream.device()->pos() < message->getSize()) {
         parseNodeFromPacketStream(packetStream);
     }
+
+    // the list is either the full one or the nodes that changed since the version we asked about
+    _domainListVersion = domainListVersion;
 }
 
 void NodeList::processDomainServerAddedNode(QSharedPointer<ReceivedMessage> message) {
     // setup a QDataStream
     QDataStream packetStream(message->getMessage());
 
-    // use our shared method to pull out the new node
-    parseNodeFromPacketStream(packetStream);
+    // use our shared method to pull out each new node, the nodes that connect together are sent together
+    while (packetStream.device()->pos() < message->getSize()) {
+        parseNodeFromPacketStream(packetStream);
+    }
 }
 
 void NodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> message) {
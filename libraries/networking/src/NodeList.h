@@ -183,6 +183,10 @@ private:
     QTimer _keepAlivePingTimer;
     bool _requestsDomainListData { false };
 
+    // the version of the domain list last heard about, the domain-server only sends the changes since then
+    quint32 _domainListVersion { 0 };
+    int _checkInsSinceFullDomainList { 0 };
+
     bool _sendDomainServerCheckInEnabled { true };
     bool _domainPortAutoDiscovery { true };
 
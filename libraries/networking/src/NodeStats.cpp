@@ -0,0 +1,351 @@
+//
+//  NodeStats.cpp
+//  libraries/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "NodeStats.h"
+
+#include <cmath>
+#include <cstring>
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QStringList>
+#include <QtCore/QtEndian>
+
+// deeper stats are dropped rather than recursed into, so that malformed packets can't exhaust the stack
+static const int MAX_DEPTH = 32;
+
+// the integers above this can't all be represented by doubles
+static const double MAX_INTEGER = 9007199254740992.0; // 2^53
+
+static void writeVarInt(QByteArray& out, quint64 value) {
+    while (value >= 0x80) {
+        out.append((char)((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.append((char)value);
+}
+
+static bool readVarInt(const char*& data, const char* end, quint64& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && data < end; shift += 7) {
+        quint8 byte = (quint8)*data++;
+        value |= (quint64)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+namespace {
+
+class Encoder {
+public:
+    int indexOf(const QString& string) {
+        auto it = _stringIndices.find(string);
+        if (it == _stringIndices.end()) {
+            it = _stringIndices.insert(string, _strings.size());
+            _strings.push_back(string);
+        }
+        return it.value();
+    }
+
+    void writeObject(const QJsonObject& object, int depth) {
+        writeVarInt(body, depth < MAX_DEPTH ? object.size() : 0);
+        if (depth >= MAX_DEPTH) {
+            return;
+        }
+        for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+            writeVarInt(body, indexOf(it.key()));
+            writeValue(it.value(), depth + 1);
+        }
+    }
+
+    void writeValue(const QJsonValue& value, int depth) {
+        switch (value.type()) {
+            case QJsonValue::Bool:
+                body.append((char)(value.toBool() ? NodeStats::ValueType::True : NodeStats::ValueType::False));
+                break;
+            case QJsonValue::Double: {
+                double number = value.toDouble();
+                if (number == std::floor(number) && std::fabs(number) < MAX_INTEGER) {
+                    // zig-zag encoded, so that the small negative integers stay short too
+                    qint64 integer = (qint64)number;
+                    body.append((char)NodeStats::ValueType::Integer);
+                    writeVarInt(body, ((quint64)integer << 1) ^ (quint64)(integer >> 63));
+                } else {
+                    quint64 bits;
+                    memcpy(&bits, &number, sizeof(bits));
+                    bits = qToLittleEndian(bits);
+                    body.append((char)NodeStats::ValueType::Double);
+                    body.append((const char*)&bits, sizeof(bits));
+                }
+                break;
+            }
+            case QJsonValue::String:
+                body.append((char)NodeStats::ValueType::String);
+                writeVarInt(body, indexOf(value.toString()));
+                break;
+            case QJsonValue::Object:
+                body.append((char)NodeStats::ValueType::Object);
+                writeObject(value.toObject(), depth);
+                break;
+            case QJsonValue::Array: {
+                QJsonArray array = value.toArray();
+                body.append((char)NodeStats::ValueType::Array);
+                writeVarInt(body, depth < MAX_DEPTH ? array.size() : 0);
+                if (depth < MAX_DEPTH) {
+                    for (const auto& element : array) {
+                        writeValue(element, depth + 1);
+                    }
+                }
+                break;
+            }
+            default:
+                body.append((char)NodeStats::ValueType::Null);
+                break;
+        }
+    }
+
+    QByteArray finish() {
+        QByteArray out;
+        out.append((char)NodeStats::SCHEMA_VERSION);
+        writeVarInt(out, _strings.size());
+        for (const auto& string : _strings) {
+            QByteArray utf8 = string.toUtf8();
+            writeVarInt(out, utf8.size());
+            out.append(utf8);
+        }
+        out.append(body);
+        return out;
+    }
+
+    QByteArray body;
+
+private:
+    QHash<QString, int> _stringIndices;
+    QVector<QString> _strings;
+};
+
+class Decoder {
+public:
+    Decoder(const char* data, const char* end, std::vector<NodeStats::Entry>& entries, int numStrings) :
+        _data(data), _end(end), _entries(entries), _numStrings(numStrings) {}
+
+    bool readMembers(int parent, bool isArray, int depth) {
+        quint64 numMembers;
+        if (!readVarInt(_data, _end, numMembers) || depth > MAX_DEPTH || numMembers > (quint64)(_end - _data)) {
+            return false;
+        }
+        if (parent != NodeStats::NO_PARENT) {
+            _entries[parent].numChildren = (int)numMembers;
+        }
+        for (quint64 i = 0; i < numMembers; ++i) {
+            int name = (int)i;
+            if (!isArray) {
+                quint64 nameIndex;
+                if (!readVarInt(_data, _end, nameIndex) || nameIndex >= (quint64)_numStrings) {
+                    return false;
+                }
+                name = (int)nameIndex;
+            }
+            if (!readValue(parent, name, depth)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool readValue(int parent, int name, int depth) {
+        if (_data >= _end) {
+            return false;
+        }
+        NodeStats::Entry entry { parent, name, (NodeStats::ValueType)*_data++, 0, 0.0, -1 };
+        switch (entry.type) {
+            case NodeStats::ValueType::Null:
+            case NodeStats::ValueType::False:
+            case NodeStats::ValueType::True:
+                break;
+            case NodeStats::ValueType::Integer: {
+                quint64 zigZag;
+                if (!readVarInt(_data, _end, zigZag)) {
+                    return false;
+                }
+                entry.number = (double)(qint64)((zigZag >> 1) ^ (~(zigZag & 1) + 1));
+                break;
+            }
+            case NodeStats::ValueType::Double: {
+                quint64 bits;
+                if (_end - _data < (qint64)sizeof(bits)) {
+                    return false;
+                }
+                bits = qFromLittleEndian<quint64>((const uchar*)_data);
+                _data += sizeof(bits);
+                memcpy(&entry.number, &bits, sizeof(bits));
+                break;
+            }
+            case NodeStats::ValueType::String: {
+                quint64 string;
+                if (!readVarInt(_data, _end, string) || string >= (quint64)_numStrings) {
+                    return false;
+                }
+                entry.string = (int)string;
+                break;
+            }
+            case NodeStats::ValueType::Object:
+            case NodeStats::ValueType::Array: {
+                int index = (int)_entries.size();
+                _entries.push_back(entry);
+                return readMembers(index, entry.type == NodeStats::ValueType::Array, depth + 1);
+            }
+            default:
+                return false;
+        }
+        _entries.push_back(entry);
+        return true;
+    }
+
+    const char* _data;
+
+private:
+    const char* _end;
+    std::vector<NodeStats::Entry>& _entries;
+    int _numStrings;
+};
+
+}
+
+QByteArray NodeStats::encode(const QJsonObject& stats) {
+    Encoder encoder;
+    encoder.writeObject(stats, 0);
+    return encoder.finish();
+}
+
+bool NodeStats::decode(const QByteArray& data) {
+    _entries.clear();
+    _strings.clear();
+
+    const char* position = data.constData();
+    const char* end = position + data.size();
+    if (position == end || (quint8)*position++ != SCHEMA_VERSION) {
+        return false;
+    }
+
+    quint64 numStrings;
+    if (!readVarInt(position, end, numStrings) || numStrings > (quint64)(end - position)) {
+        return false;
+    }
+    _strings.reserve((int)numStrings);
+    for (quint64 i = 0; i < numStrings; ++i) {
+        quint64 length;
+        if (!readVarInt(position, end, length) || length > (quint64)(end - position)) {
+            _strings.clear();
+            return false;
+        }
+        _strings.push_back(QString::fromUtf8(position, (int)length));
+        position += length;
+    }
+
+    Decoder decoder(position, end, _entries, _strings.size());
+    if (!decoder.readMembers(NO_PARENT, false, 0) || decoder._data != end) {
+        _entries.clear();
+        _strings.clear();
+        return false;
+    }
+    return true;
+}
+
+QString NodeStats::getPath(int entryIndex) const {
+    QStringList names;
+    while (entryIndex != NO_PARENT) {
+        const Entry& entry = _entries[entryIndex];
+        bool isInArray = entry.parent != NO_PARENT && _entries[entry.parent].type == ValueType::Array;
+        names.push_front(isInArray ? QString::number(entry.name) : _strings[entry.name]);
+        entryIndex = entry.parent;
+    }
+    return names.join('.');
+}
+
+int NodeStats::findEntry(const QString& path) const {
+    QString name = path.mid(path.lastIndexOf('.') + 1);
+    for (int i = 0; i < (int)_entries.size(); ++i) {
+        const Entry& entry = _entries[i];
+        if ((entry.name < _strings.size() && _strings[entry.name] == name) || QString::number(entry.name) == name) {
+            if (getPath(i) == path) {
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
+int NodeStats::buildJson(int entryIndex, QJsonValue& value, const StringOverride& stringOverride) const {
+    const Entry& entry = _entries[entryIndex];
+    switch (entry.type) {
+        case ValueType::False:
+        case ValueType::True:
+            value = entry.type == ValueType::True;
+            return entryIndex + 1;
+        case ValueType::Integer:
+        case ValueType::Double:
+            value = entry.number;
+            return entryIndex + 1;
+        case ValueType::String: {
+            const QString& string = _strings[entry.string];
+            QString overrideValue;
+            bool isInArray = entry.parent != NO_PARENT && _entries[entry.parent].type == ValueType::Array;
+            if (stringOverride && !isInArray && stringOverride(_strings[entry.name], string, overrideValue)) {
+                value = overrideValue;
+            } else {
+                value = string;
+            }
+            return entryIndex + 1;
+        }
+        case ValueType::Object: {
+            QJsonObject object;
+            int next = entryIndex + 1;
+            for (int i = 0; i < entry.numChildren; ++i) {
+                QJsonValue member;
+                const QString& name = _strings[_entries[next].name];
+                next = buildJson(next, member, stringOverride);
+                object.insert(name, member);
+            }
+            value = object;
+            return next;
+        }
+        case ValueType::Array: {
+            QJsonArray array;
+            int next = entryIndex + 1;
+            for (int i = 0; i < entry.numChildren; ++i) {
+                QJsonValue element;
+                next = buildJson(next, element, stringOverride);
+                array.push_back(element);
+            }
+            value = array;
+            return next;
+        }
+        default:
+            value = QJsonValue();
+            return entryIndex + 1;
+    }
+}
+
+QJsonObject NodeStats::toJson(const StringOverride& stringOverride) const {
+    QJsonObject root;
+    int next = 0;
+    while (next < (int)_entries.size()) {
+        QJsonValue member;
+        const QString& name = _strings[_entries[next].name];
+        next = buildJson(next, member, stringOverride);
+        root.insert(name, member);
+    }
+    return root;
+}
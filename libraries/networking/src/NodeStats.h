@@ -0,0 +1,77 @@
+//
+//  NodeStats.h
+//  libraries/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_NodeStats_h
+#define overte_NodeStats_h
+
+#include <functional>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+/// The stats that a node sends the domain-server, in a compact binary form that is decoded without building a JSON
+/// document.  The tree of the stats is flattened in pre-order, with its names and its string values in a table so that
+/// the ones repeated across objects, like the names of the stats of each listener of a mixer, are only sent once.  The
+/// integers, which most of the counters are, are sent as variable length integers.
+class NodeStats {
+public:
+    static const quint8 SCHEMA_VERSION = 1;
+    static const int NO_PARENT = -1;
+
+    enum class ValueType : quint8 {
+        Null = 0,
+        False,
+        True,
+        Integer,
+        Double,
+        String,
+        Object,
+        Array
+    };
+
+    struct Entry {
+        int parent;          // the index of the object or the array the entry is in, NO_PARENT for the root's members
+        int name;            // the index of the name in the strings, or the index in the array
+        ValueType type;
+        int numChildren;     // the number of members of objects and arrays, which follow them
+        double number;       // the value of numbers
+        int string;          // the index of the value of strings in the strings
+    };
+
+    static QByteArray encode(const QJsonObject& stats);
+
+    /// Returns false, and leaves the stats empty, if the data is malformed or of a newer schema
+    bool decode(const QByteArray& data);
+
+    const std::vector<Entry>& getEntries() const { return _entries; }
+    const QVector<QString>& getStrings() const { return _strings; }
+
+    /// The names of the entry and of the objects it is in, joined by dots
+    QString getPath(int entryIndex) const;
+    /// The index of the entry at path, or -1
+    int findEntry(const QString& path) const;
+
+    /// Rebuilds the stats as JSON, for the views that need it, replacing the string values for which the given function
+    /// returns true
+    using StringOverride = std::function<bool(const QString& name, const QString& value, QString& overrideValue)>;
+    QJsonObject toJson(const StringOverride& stringOverride = nullptr) const;
+
+private:
+    int buildJson(int entryIndex, QJsonValue& value, const StringOverride& stringOverride) const;
+
+    std::vector<Entry> _entries;
+    QVector<QString> _strings;
+};
+
+#endif // overte_NodeStats_h
@@ -0,0 +1,163 @@
+//
+//  PacketDispatchQueue.cpp
+//  libraries/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "PacketDispatchQueue.h"
+
+#include <thread>
+
+#include <QtCore/QMetaEnum>
+#include <QtCore/QRunnable>
+
+#include "ReceivedMessage.h"
+
+// drains return to the pool after this many deliveries, so a busy listener doesn't monopolize a shared pool thread
+static const int MAX_DELIVERIES_PER_DRAIN = 64;
+
+template <typename T>
+static void updateMax(std::atomic<T>& maximum, T value) {
+    T current = maximum.load();
+    while (value > current && !maximum.compare_exchange_weak(current, value)) {
+    }
+}
+
+void PacketDispatchStats::recordLockHold(PacketType type, quint64 usecs) {
+    auto& stats = _types[(uint8_t)type];
+    ++stats.dispatched;
+    stats.lockHoldUsecs += usecs;
+    updateMax<uint64_t>(stats.maxLockHoldUsecs, usecs);
+}
+
+void PacketDispatchStats::recordQueued(PacketType type) {
+    auto& stats = _types[(uint8_t)type];
+    updateMax(stats.maxQueueDepth, ++stats.queueDepth);
+}
+
+void PacketDispatchStats::recordDequeued(PacketType type) {
+    --_types[(uint8_t)type].queueDepth;
+}
+
+QJsonObject PacketDispatchStats::sample() {
+    QMetaObject metaObject = PacketTypeEnum::staticMetaObject;
+    QMetaEnum metaEnum = metaObject.enumerator(metaObject.enumeratorOffset());
+
+    QJsonObject result;
+    for (size_t i = 0; i < _types.size(); ++i) {
+        auto& stats = _types[i];
+        auto dispatched = stats.dispatched.exchange(0);
+        auto maxQueueDepth = stats.maxQueueDepth.exchange(stats.queueDepth);
+        if (dispatched == 0 && maxQueueDepth == 0) {
+            continue;
+        }
+
+        auto lockHoldUsecs = stats.lockHoldUsecs.exchange(0);
+
+        QJsonObject typeStats;
+        typeStats["dispatched"] = (qint64)dispatched;
+        typeStats["avg_lock_hold_usecs"] = dispatched > 0 ? (double)lockHoldUsecs / dispatched : 0.0;
+        typeStats["max_lock_hold_usecs"] = (qint64)stats.maxLockHoldUsecs.exchange(0);
+        typeStats["queue_depth"] = stats.queueDepth.load();
+        typeStats["max_queue_depth"] = maxQueueDepth;
+
+        QString typeName = metaEnum.valueToKey((int)i);
+        result[typeName.isEmpty() ? QString::number(i) : typeName] = typeStats;
+    }
+    return result;
+}
+
+class DrainRunnable : public QRunnable {
+public:
+    DrainRunnable(std::shared_ptr<PacketDispatchQueue> queue) : _queue(std::move(queue)) {}
+    void run() override { _queue->drain(); }
+
+private:
+    std::shared_ptr<PacketDispatchQueue> _queue;
+};
+
+PacketDispatchQueue::PacketDispatchQueue(const PacketReceiver::ListenerReferencePointer& listener,
+                                         std::shared_ptr<PacketDispatchStats> stats,
+                                         std::shared_ptr<PacketTrafficStats> trafficStats, QThreadPool* sharedPool) :
+    _listener(listener),
+    _stats(std::move(stats)),
+    _trafficStats(std::move(trafficStats)),
+    _pool(sharedPool)
+{
+    if (!_pool) {
+        _dedicatedPool.reset(new QThreadPool());
+        _dedicatedPool->setMaxThreadCount(1);
+        _dedicatedPool->setExpiryTimeout(-1);
+        _pool = _dedicatedPool.get();
+    }
+}
+
+bool PacketDispatchQueue::enqueue(const QSharedPointer<ReceivedMessage>& message, const QSharedPointer<Node>& sourceNode) {
+    if (_isClosed) {
+        return false;
+    }
+
+    _stats->recordQueued(message->getType());
+    _deliveries.push({ message, sourceNode });
+    schedule();
+    return true;
+}
+
+void PacketDispatchQueue::schedule() {
+    if (!_isScheduled.exchange(true)) {
+        _pool->start(new DrainRunnable(shared_from_this()));
+    }
+}
+
+void PacketDispatchQueue::drain() {
+    Delivery delivery;
+    for (int i = 0; i < MAX_DELIVERIES_PER_DRAIN && _deliveries.try_pop(delivery); ++i) {
+        {
+            std::lock_guard<std::mutex> deliveryLock(_deliveryMutex);
+            if (!_isClosed) {
+                _deliveringThread = QThread::currentThread();
+                _listener->invokeAndRecord(delivery.message, delivery.sourceNode, *_trafficStats);
+                _deliveringThread = nullptr;
+            }
+        }
+        _stats->recordDequeued(delivery.message->getType());
+        delivery = Delivery();
+    }
+
+    _isScheduled = false;
+
+    // pick up anything queued after our last pop, or left over from a full drain
+    if (!_isClosed && !_deliveries.empty()) {
+        schedule();
+    }
+}
+
+bool PacketDispatchQueue::close() {
+    _isClosed = true;
+
+    Delivery delivery;
+    while (_deliveries.try_pop(delivery)) {
+        _stats->recordDequeued(delivery.message->getType());
+    }
+
+    if (_deliveringThread == QThread::currentThread()) {
+        return false;
+    }
+
+    // wait out a delivery in progress, then claim the drain flag for good so that no drain can be started after us
+    { std::lock_guard<std::mutex> deliveryLock(_deliveryMutex); }
+    while (_isScheduled.exchange(true)) {
+        std::this_thread::yield();
+    }
+
+    // and let a dedicated thread finish returning from its last drain
+    if (_dedicatedPool) {
+        _dedicatedPool->waitForDone();
+    }
+    return true;
+}
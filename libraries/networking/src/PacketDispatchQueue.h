@@ -0,0 +1,112 @@
+//
+//  PacketDispatchQueue.h
+//  libraries/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#ifndef overte_PacketDispatchQueue_h
+#define overte_PacketDispatchQueue_h
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+
+#include <TBBHelpers.h>
+
+#include "PacketReceiver.h"
+#include "PacketTrafficStats.h"
+
+/// @addtogroup Networking
+/// @{
+
+/// @brief Per packet type dispatch counters for a PacketReceiver, shared with its dispatch queues.
+class PacketDispatchStats {
+public:
+    void recordLockHold(PacketType type, quint64 usecs);
+    void recordQueued(PacketType type);
+    void recordDequeued(PacketType type);
+
+    /// @brief Returns the counters for every packet type seen since the last sample, keyed by packet type name, and
+    /// resets them. Queue depths are current values and aren't reset.
+    QJsonObject sample();
+
+private:
+    struct TypeStats {
+        std::atomic<uint64_t> dispatched { 0 };
+        std::atomic<uint64_t> lockHoldUsecs { 0 };
+        std::atomic<uint64_t> maxLockHoldUsecs { 0 };
+        std::atomic<int> queueDepth { 0 };
+        std::atomic<int> maxQueueDepth { 0 };
+    };
+
+    std::array<TypeStats, 256> _types;
+};
+
+/// @brief Serial queue of messages for one listener, drained on a thread pool.
+/// @details Messages are pushed onto a lock-free queue by the network thread and delivered in order, one at a time,
+/// by whichever pool thread picks up the drain. A dedicated queue has a single-thread pool of its own; shared queues
+/// are drained by the PacketReceiver's dispatch pool, so listeners on it only wait for each other when the pool is
+/// busy.
+class PacketDispatchQueue : public std::enable_shared_from_this<PacketDispatchQueue> {
+public:
+    /// @brief Constructs a queue.
+    /// @param sharedPool The pool to drain on, or <code>nullptr</code> to drain on a dedicated thread.
+    PacketDispatchQueue(const PacketReceiver::ListenerReferencePointer& listener,
+                        std::shared_ptr<PacketDispatchStats> stats, std::shared_ptr<PacketTrafficStats> trafficStats,
+                        QThreadPool* sharedPool = nullptr);
+
+    const PacketReceiver::ListenerReferencePointer& getListener() const { return _listener; }
+
+    /// @brief Queues a message for the listener. Thread-safe.
+    /// @return <code>false</code> if the queue has been closed.
+    bool enqueue(const QSharedPointer<ReceivedMessage>& message, const QSharedPointer<Node>& sourceNode);
+
+    /// @brief Drops any undelivered messages and waits for the one being delivered, if any. Nothing is delivered
+    /// after this returns.
+    /// @return <code>false</code> if called by the listener from inside a delivery, in which case the queue couldn't
+    /// wait for its thread and must be kept alive until the PacketReceiver is destroyed.
+    bool close();
+
+private:
+    struct Delivery {
+        QSharedPointer<ReceivedMessage> message;
+        QSharedPointer<Node> sourceNode;
+    };
+
+    friend class DrainRunnable;
+
+    void schedule();
+    void drain();
+
+    PacketReceiver::ListenerReferencePointer _listener;
+    std::shared_ptr<PacketDispatchStats> _stats;
+    std::shared_ptr<PacketTrafficStats> _trafficStats;
+
+    std::unique_ptr<QThreadPool> _dedicatedPool;
+    QThreadPool* _pool { nullptr };
+
+    tbb::concurrent_queue<Delivery> _deliveries;
+    std::atomic<bool> _isScheduled { false };
+    std::atomic<bool> _isClosed { false };
+
+    // held while delivering, so that close() can wait out a listener that is mid-delivery
+    std::mutex _deliveryMutex;
+    std::atomic<QThread*> _deliveringThread { nullptr };
+};
+
+/// @}
+
+#endif // overte_PacketDispatchQueue_h
@@ -13,27 +13,94 @@
 
 #include "PacketReceiver.h"
 
+#include <algorithm>
+
 #include <QtCore/QMetaObject>
 #include <QtCore/QMutexLocker>
+#include <QtCore/QThreadPool>
+
+#include <PortableHighResolutionClock.h>
 
 #include "DependencyManager.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
+#include "PacketDispatchQueue.h"
+#include "PacketTrafficStats.h"
 #include "SharedUtil.h"
 
-PacketReceiver::PacketReceiver(QObject* parent) : QObject(parent) {
+// holds the listener lock and records how long it was held for in the dispatch stats
+class ListenerLockTimer {
+public:
+    ListenerLockTimer(QMutex* mutex, PacketDispatchStats& stats, PacketType type) :
+        _locker(mutex), _stats(stats), _type(type), _start(p_high_resolution_clock::now()) {}
+    ~ListenerLockTimer() { unlock(); }
+
+    void unlock() {
+        if (_isLocked) {
+            auto held = p_high_resolution_clock::now() - _start;
+            _locker.unlock();
+            _isLocked = false;
+            _stats.recordLockHold(_type, std::chrono::duration_cast<std::chrono::microseconds>(held).count());
+        }
+    }
+
+private:
+    QMutexLocker _locker;
+    PacketDispatchStats& _stats;
+    PacketType _type;
+    p_high_resolution_clock::time_point _start;
+    bool _isLocked { true };
+};
+
+PacketReceiver::PacketReceiver(QObject* parent) :
+    QObject(parent),
+    _dispatchStats(std::make_shared<PacketDispatchStats>()),
+    _trafficStats(std::make_shared<PacketTrafficStats>())
+{
     qRegisterMetaType<QSharedPointer<NLPacket>>();
     qRegisterMetaType<QSharedPointer<NLPacketList>>();
     qRegisterMetaType<QSharedPointer<ReceivedMessage>>();
 }
 
-bool PacketReceiver::ListenerReference::invokeWithQt(const QSharedPointer<ReceivedMessage>& receivedMessagePointer, const QSharedPointer<Node>& sourceNode) {
+PacketReceiver::~PacketReceiver() {
+    QHash<QObject*, std::shared_ptr<PacketDispatchQueue>> dispatchQueues;
+    {
+        QMutexLocker locker(&_packetListenerLock);
+        dispatchQueues.swap(_dispatchQueues);
+    }
+
+    for (auto& queue : dispatchQueues) {
+        queue->close();
+    }
+}
+
+bool PacketReceiver::ListenerReference::invokeWithQt(const QSharedPointer<ReceivedMessage>& receivedMessagePointer, const QSharedPointer<Node>& sourceNode,
+                                                     std::shared_ptr<PacketTrafficStats> trafficStats) {
     ListenerReferencePointer thisPointer = sharedFromThis();
     return QMetaObject::invokeMethod(getObject(), [=]() {
-        thisPointer->invokeDirectly(receivedMessagePointer, sourceNode);
+        thisPointer->invokeAndRecord(receivedMessagePointer, sourceNode, *trafficStats);
     });
 }
 
+bool PacketReceiver::ListenerReference::invokeAndRecord(const QSharedPointer<ReceivedMessage>& receivedMessagePointer,
+                                                        const QSharedPointer<Node>& sourceNode,
+                                                        PacketTrafficStats& trafficStats) {
+    using namespace std::chrono;
+
+    auto start = p_high_resolution_clock::now();
+    bool success = invokeDirectly(receivedMessagePointer, sourceNode);
+    auto end = p_high_resolution_clock::now();
+
+    // messages that weren't received, like replicated ones, have no receive time to wait from
+    quint64 receiveTime = receivedMessagePointer->getLastPacketReceiveTime();
+    quint64 startTime = duration_cast<microseconds>(start.time_since_epoch()).count();
+    quint64 waitUsecs = receiveTime > 0 && startTime > receiveTime ? startTime - receiveTime : 0;
+
+    trafficStats.recordDelivery(receivedMessagePointer->getType(), waitUsecs,
+                                duration_cast<microseconds>(end - start).count());
+    return success;
+}
+
 bool PacketReceiver::registerListenerForTypes(PacketTypeList types, const ListenerReferencePointer& listener) {
     Q_ASSERT_X(!types.empty(), "PacketReceiver::registerListenerForTypes", "No types to register");
     Q_ASSERT_X(listener, "PacketReceiver::registerListenerForTypes", "No listener to register");
@@ -70,6 +137,43 @@ void PacketReceiver::registerDirectListenerForTypes(PacketTypeList types, const
     }
 }
 
+bool PacketReceiver::registerListenerForTypes(PacketTypeList types, const ListenerReferencePointer& listener,
+                                              Executor executor) {
+    Q_ASSERT_X(!types.empty(), "PacketReceiver::registerListenerForTypes", "No types to register");
+    Q_ASSERT_X(listener, "PacketReceiver::registerListenerForTypes", "No listener to register");
+
+    if (executor == Executor::Direct) {
+        registerDirectListenerForTypes(std::move(types), listener);
+        return true;
+    }
+
+    std::for_each(std::begin(types), std::end(types), [this, &listener, executor](PacketType type) {
+        registerVerifiedListener(type, listener, false, executor);
+    });
+
+    return true;
+}
+
+bool PacketReceiver::registerListener(PacketType type, const ListenerReferencePointer& listener, Executor executor,
+                                      bool deliverPending) {
+    Q_ASSERT_X(listener, "PacketReceiver::registerListener", "No listener to register");
+
+    if (!matchingMethodForListener(type, listener)) {
+        qCWarning(networking) << "FAILED to Register a packet listener for packet list type" << type;
+        return false;
+    }
+
+    qCDebug(networking) << "Registering a packet listener for packet list type" << type;
+    registerVerifiedListener(type, listener, deliverPending, executor);
+
+    if (executor == Executor::Direct) {
+        QMutexLocker locker(&_directConnectSetMutex);
+        _directlyConnectedObjects.insert(listener->getObject());
+    }
+
+    return true;
+}
+
 bool PacketReceiver::registerListener(PacketType type, const ListenerReferencePointer& listener,  bool deliverPending) {
     Q_ASSERT_X(listener, "PacketReceiver::registerListener", "No listener to register");
 
@@ -100,7 +204,8 @@ bool PacketReceiver::matchingMethodForListener(PacketType type, const ListenerRe
     return true;
 }
 
-void PacketReceiver::registerVerifiedListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending) {
+void PacketReceiver::registerVerifiedListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending,
+                                              Executor executor) {
     Q_ASSERT_X(listener, "PacketReceiver::registerVerifiedListener", "No listener to register");
     QMutexLocker locker(&_packetListenerLock);
 
@@ -110,14 +215,47 @@ void PacketReceiver::registerVerifiedListener(PacketType type, const ListenerRef
     }
     
     // add the mapping
-    _messageListenerMap[type] = { listener, deliverPending };
+    _messageListenerMap[type] = { listener, deliverPending, dispatchQueueForListener(listener, executor) };
+}
+
+std::shared_ptr<PacketDispatchQueue> PacketReceiver::dispatchQueueForListener(const ListenerReferencePointer& listener,
+                                                                              Executor executor) {
+    if (executor != Executor::DedicatedThread && executor != Executor::SharedPool) {
+        return std::shared_ptr<PacketDispatchQueue>();
+    }
+
+    // every type a listener object registers for goes through the same queue, so its messages stay in order
+    auto it = _dispatchQueues.find(listener->getObject());
+    if (it != _dispatchQueues.end()) {
+        return it.value();
+    }
+
+    QThreadPool* pool = nullptr;
+    if (executor == Executor::SharedPool) {
+        if (!_sharedDispatchPool) {
+            _sharedDispatchPool.reset(new QThreadPool());
+            _sharedDispatchPool->setMaxThreadCount(std::max(2, QThread::idealThreadCount() / 2));
+        }
+        pool = _sharedDispatchPool.get();
+    }
+
+    auto queue = std::make_shared<PacketDispatchQueue>(listener, _dispatchStats, _trafficStats, pool);
+    _dispatchQueues.insert(listener->getObject(), queue);
+    return queue;
 }
 
 void PacketReceiver::unregisterListener(QObject* listener) {
     Q_ASSERT_X(listener, "PacketReceiver::unregisterListener", "No listener to unregister");
-    
+
+    std::shared_ptr<PacketDispatchQueue> dispatchQueue;
     {
         QMutexLocker packetListenerLocker(&_packetListenerLock);
+
+        auto queueIt = _dispatchQueues.find(listener);
+        if (queueIt != _dispatchQueues.end()) {
+            dispatchQueue = queueIt.value();
+            _dispatchQueues.erase(queueIt);
+        }
         
         // clear any registrations for this listener in _messageListenerMap
         auto it = _messageListenerMap.begin();
@@ -131,10 +269,20 @@ void PacketReceiver::unregisterListener(QObject* listener) {
         }
     }
     
+    // close outside of the listener lock, the delivery we wait for may be registering listeners of its own
+    if (dispatchQueue && !dispatchQueue->close()) {
+        QMutexLocker packetListenerLocker(&_packetListenerLock);
+        _retiredDispatchQueues.push_back(dispatchQueue);
+    }
+
     QMutexLocker directConnectSetLocker(&_directConnectSetMutex);
     _directlyConnectedObjects.remove(listener);
 }
 
+QJsonObject PacketReceiver::sampleDispatchStats() {
+    return _dispatchStats->sample();
+}
+
 void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
     // if we're supposed to drop this packet then break out here
     if (_shouldDropPackets) {
@@ -143,7 +291,7 @@ void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
 
     // setup an NLPacket from the packet we were passed
     auto nlPacket = NLPacket::fromBase(std::move(packet));
-    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(*nlPacket);
+    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
 
     handleVerifiedMessage(receivedMessage, true);
 }
@@ -157,14 +305,14 @@ void PacketReceiver::handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> pa
 
     if (it == _pendingMessages.end()) {
         // Create message
-        message = QSharedPointer<ReceivedMessage>::create(*nlPacket);
+        message = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
         if (!message->isComplete()) {
             _pendingMessages[key] = message;
         }
         handleVerifiedMessage(message, true);  // Handler may handle first message packet immediately when it arrives.
     } else {
         message = it->second;
-        message->appendPacket(*nlPacket);
+        message->appendPacket(std::move(nlPacket));
 
         if (message->isComplete()) {
             _pendingMessages.erase(it);
@@ -191,7 +339,7 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
     if (receivedMessage->getSourceID() != Node::NULL_LOCAL_ID) {
         matchingNode = nodeList->nodeWithLocalID(receivedMessage->getSourceID());
     }
-    QMutexLocker packetListenerLocker(&_packetListenerLock);
+    ListenerLockTimer packetListenerLocker(&_packetListenerLock, *_dispatchStats, receivedMessage->getType());
     
     auto it = _messageListenerMap.find(receivedMessage->getType());
     if (it != _messageListenerMap.end() && !it->listener.isNull()) {
@@ -201,6 +349,16 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
         if ((listener.deliverPending && !justReceived) || (!listener.deliverPending && !receivedMessage->isComplete())) {
             return;
         }
+
+        if (listener.queue) {
+            // hand off to the listener's executor, the lock isn't needed for that
+            packetListenerLocker.unlock();
+            if (!listener.queue->enqueue(receivedMessage, matchingNode)) {
+                qCDebug(networking).nospace() << "Error delivering packet " << receivedMessage->getType()
+                    << " to unregistered listener";
+            }
+            return;
+        }
             
         bool success = false;
 
@@ -214,9 +372,9 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
         // one final check on the QPointer before we go to invoke
         if (listener.listener->getObject()) {
             if (isDirectConnect) {
-                success = listener.listener->invokeDirectly(receivedMessage, matchingNode);
+                success = listener.listener->invokeAndRecord(receivedMessage, matchingNode, *_trafficStats);
             } else {
-                success = listener.listener->invokeWithQt(receivedMessage, matchingNode);
+                success = listener.listener->invokeWithQt(receivedMessage, matchingNode, _trafficStats);
             }
         } else {
             qCDebug(networking).nospace() << "Listener for packet " << receivedMessage->getType()
@@ -14,9 +14,11 @@
 #ifndef hifi_PacketReceiver_h
 #define hifi_PacketReceiver_h
 
+#include <memory>
 #include <vector>
 #include <unordered_map>
 
+#include <QtCore/QJsonObject>
 #include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QPointer>
@@ -32,6 +34,10 @@
 class EntityEditPacketSender;
 class Node;
 class OctreePacketProcessor;
+class PacketDispatchQueue;
+class PacketDispatchStats;
+class PacketTrafficStats;
+class QThreadPool;
 
 namespace std {
     template <>
@@ -48,7 +54,11 @@ public:
     class ListenerReference : public QEnableSharedFromThis<ListenerReference> {
     public:
         virtual bool invokeDirectly(const QSharedPointer<ReceivedMessage>& receivedMessagePointer, const QSharedPointer<Node>& sourceNode) = 0;
-        bool invokeWithQt(const QSharedPointer<ReceivedMessage>& receivedMessagePointer, const QSharedPointer<Node>& sourceNode);
+        bool invokeWithQt(const QSharedPointer<ReceivedMessage>& receivedMessagePointer, const QSharedPointer<Node>& sourceNode,
+                          std::shared_ptr<PacketTrafficStats> trafficStats);
+        // invokes directly, recording how long the message waited for its listener and how long the listener took
+        bool invokeAndRecord(const QSharedPointer<ReceivedMessage>& receivedMessagePointer, const QSharedPointer<Node>& sourceNode,
+                             PacketTrafficStats& trafficStats);
         virtual bool isSourced() const = 0;
         virtual QObject* getObject() const = 0;
     };
@@ -62,9 +72,25 @@ public:
 
 public:
     using PacketTypeList = std::vector<PacketType>;
+
+    // Where a listener's messages are delivered.
+    // Default: queued to the listener object's thread through Qt.
+    // Direct: called on the thread that received the packet, normally the node list thread.
+    // DedicatedThread: called in order on a thread of the listener's own.
+    // SharedPool: called in order on the receiver's dispatch thread pool, shared by all listeners that ask for it.
+    // Listeners on a DedicatedThread or the SharedPool must be thread-safe, and must be unregistered before they are
+    // destroyed. Their messages are handed over without holding the listener lock, so a slow one doesn't hold up
+    // dispatch of other packet types.
+    enum class Executor {
+        Default,
+        Direct,
+        DedicatedThread,
+        SharedPool
+    };
     
     PacketReceiver(QObject* parent = 0);
     PacketReceiver(const PacketReceiver&) = delete;
+    ~PacketReceiver();
 
     PacketReceiver& operator=(const PacketReceiver&) = delete;
 
@@ -75,7 +101,18 @@ public:
     // for the message is received.
     bool registerListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending = false);
     bool registerListenerForTypes(PacketTypeList types, const ListenerReferencePointer& listener);
+    bool registerListener(PacketType type, const ListenerReferencePointer& listener, Executor executor,
+                          bool deliverPending = false);
+    bool registerListenerForTypes(PacketTypeList types, const ListenerReferencePointer& listener, Executor executor);
     void unregisterListener(QObject* listener);
+
+    // Returns, and resets, listener lock hold times and dispatch queue depths for each packet type dispatched since the
+    // last sample.
+    QJsonObject sampleDispatchStats();
+
+    // Counts of received packets and timings of their delivery, per packet type. LimitedNodeList counts into these as
+    // it verifies packets.
+    PacketTrafficStats& getTrafficStats() { return *_trafficStats; }
     
     void handleVerifiedPacket(std::unique_ptr<udt::Packet> packet);
     void handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> message);
@@ -111,6 +148,7 @@ private:
     struct Listener {
         ListenerReferencePointer listener;
         bool deliverPending;
+        std::shared_ptr<PacketDispatchQueue> queue; // set for listeners on a worker executor
     };
 
     void handleVerifiedMessage(QSharedPointer<ReceivedMessage> message, bool justReceived);
@@ -121,10 +159,18 @@ private:
     void registerDirectListener(PacketType type, const ListenerReferencePointer& listener);
 
     bool matchingMethodForListener(PacketType type, const ListenerReferencePointer& listener) const;
-    void registerVerifiedListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending = false);
+    void registerVerifiedListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending = false,
+                                  Executor executor = Executor::Default);
+    std::shared_ptr<PacketDispatchQueue> dispatchQueueForListener(const ListenerReferencePointer& listener,
+                                                                  Executor executor);
 
     QMutex _packetListenerLock;
     QHash<PacketType, Listener> _messageListenerMap;
+    QHash<QObject*, std::shared_ptr<PacketDispatchQueue>> _dispatchQueues; // one per listener object, for ordering
+    std::vector<std::shared_ptr<PacketDispatchQueue>> _retiredDispatchQueues; // closed from inside their own delivery
+    std::unique_ptr<QThreadPool> _sharedDispatchPool;
+    std::shared_ptr<PacketDispatchStats> _dispatchStats;
+    std::shared_ptr<PacketTrafficStats> _trafficStats;
 
     bool _shouldDropPackets = false;
     QMutex _directConnectSetMutex;
@@ -0,0 +1,121 @@
+//
+//  PacketTrafficStats.cpp
+//  libraries/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "PacketTrafficStats.h"
+
+#include <QtCore/QMetaEnum>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+void PacketTrafficStats::Histogram::record(uint64_t usecs) {
+    int bucket = 0;
+    for (uint64_t bound = 1; usecs > bound && bucket < NUM_BUCKETS - 1; bound <<= 1) {
+        ++bucket;
+    }
+
+    ++_buckets[bucket];
+    _sum += usecs;
+}
+
+uint64_t PacketTrafficStats::Histogram::getCount() const {
+    uint64_t count = 0;
+    for (const auto& bucket : _buckets) {
+        count += bucket;
+    }
+    return count;
+}
+
+QJsonObject PacketTrafficStats::Histogram::toJson() const {
+    QJsonObject buckets;
+    uint64_t count = 0;
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        count += _buckets[i];
+        buckets[i < NUM_BUCKETS - 1 ? QString::number((uint64_t)1 << i) : QString("+Inf")] = (double)count;
+    }
+
+    QJsonObject result;
+    result["count"] = (double)count;
+    result["sum"] = (double)_sum;
+    result["buckets"] = buckets;
+    return result;
+}
+
+void PacketTrafficStats::recordReceived(PacketType type, NodeType_t sourceNodeType, qint64 bytes) {
+    auto& typeCounts = _types[(uint8_t)type].received;
+    ++typeCounts.packets;
+    typeCounts.bytes += bytes;
+
+    auto& nodeTypeCounts = _nodeTypes[sourceNodeType];
+    ++nodeTypeCounts.packets;
+    nodeTypeCounts.bytes += bytes;
+}
+
+void PacketTrafficStats::recordDelivery(PacketType type, uint64_t waitUsecs, uint64_t handlerUsecs) {
+    auto& stats = _types[(uint8_t)type];
+    stats.wait.record(waitUsecs);
+    stats.handler.record(handlerUsecs);
+}
+
+void PacketTrafficStats::addCounts(QJsonObject& result, ByteCounts& counts, double elapsedSeconds) {
+    uint64_t packets = counts.packets;
+    uint64_t bytes = counts.bytes;
+
+    result["packets"] = (double)packets;
+    result["bytes"] = (double)bytes;
+    result["packets_per_sec"] = elapsedSeconds > 0.0 ? (packets - counts.sampledPackets) / elapsedSeconds : 0.0;
+    result["bytes_per_sec"] = elapsedSeconds > 0.0 ? (bytes - counts.sampledBytes) / elapsedSeconds : 0.0;
+
+    counts.sampledPackets = packets;
+    counts.sampledBytes = bytes;
+}
+
+QJsonObject PacketTrafficStats::sample() {
+    QMetaObject metaObject = PacketTypeEnum::staticMetaObject;
+    QMetaEnum metaEnum = metaObject.enumerator(metaObject.enumeratorOffset());
+
+    quint64 now = usecTimestampNow();
+    double elapsedSeconds = _lastSampleTime > 0 ? (double)(now - _lastSampleTime) / USECS_PER_SECOND : 0.0;
+    _lastSampleTime = now;
+
+    QJsonObject types;
+    for (size_t i = 0; i < _types.size(); ++i) {
+        auto& stats = _types[i];
+        if (stats.received.packets == 0 && stats.wait.getCount() == 0) {
+            continue;
+        }
+
+        QJsonObject typeStats;
+        addCounts(typeStats, stats.received, elapsedSeconds);
+        typeStats["wait_usecs"] = stats.wait.toJson();
+        typeStats["handler_usecs"] = stats.handler.toJson();
+
+        QString typeName = metaEnum.valueToKey((int)i);
+        types[typeName.isEmpty() ? QString::number(i) : typeName] = typeStats;
+    }
+
+    QJsonObject nodeTypes;
+    for (size_t i = 0; i < _nodeTypes.size(); ++i) {
+        auto& counts = _nodeTypes[i];
+        if (counts.packets == 0) {
+            continue;
+        }
+
+        QJsonObject nodeTypeStats;
+        addCounts(nodeTypeStats, counts, elapsedSeconds);
+        nodeTypes[NodeType::getNodeTypeName((NodeType_t)i)] = nodeTypeStats;
+    }
+
+    QJsonObject result;
+    result["types"] = types;
+    result["node_types"] = nodeTypes;
+    return result;
+}
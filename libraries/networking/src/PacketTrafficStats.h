@@ -0,0 +1,84 @@
+//
+//  PacketTrafficStats.h
+//  libraries/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#ifndef overte_PacketTrafficStats_h
+#define overte_PacketTrafficStats_h
+
+#include <array>
+#include <atomic>
+
+#include <QtCore/QJsonObject>
+
+#include "NodeType.h"
+#include "udt/PacketHeaders.h"
+
+/// @addtogroup Networking
+/// @{
+
+/// @brief Always-on counters of the packets received and dispatched, per packet type and per source node type.
+/// @details LimitedNodeList counts the packets as it verifies them, PacketReceiver times the delivery of each message
+/// to its listener: how long it waited after the Socket received its last packet, and how long the listener took.
+/// Recording is lock-free and safe from any thread.
+class PacketTrafficStats {
+public:
+    /// @brief Counts of durations in power-of-two buckets of microseconds, cumulative since start.
+    class Histogram {
+    public:
+        // up to 1 usec, up to 2 usecs, ... up to 2^20 usecs (about a second), and longer
+        static const int NUM_BUCKETS = 22;
+
+        void record(uint64_t usecs);
+        uint64_t getCount() const;
+
+        /// @brief Returns <code>{ count, sum, buckets }</code>, where buckets are keyed by their upper bound in usecs
+        /// and count everything up to it, like a Prometheus histogram.
+        QJsonObject toJson() const;
+
+    private:
+        std::array<std::atomic<uint64_t>, NUM_BUCKETS> _buckets {};
+        std::atomic<uint64_t> _sum { 0 };
+    };
+
+    void recordReceived(PacketType type, NodeType_t sourceNodeType, qint64 bytes);
+    void recordDelivery(PacketType type, uint64_t waitUsecs, uint64_t handlerUsecs);
+
+    /// @brief Returns the totals and histograms of every packet and node type seen so far, with the rates since the
+    /// last sample. Not thread-safe with itself, it is meant to be called from one stats timer.
+    QJsonObject sample();
+
+private:
+    struct ByteCounts {
+        std::atomic<uint64_t> packets { 0 };
+        std::atomic<uint64_t> bytes { 0 };
+
+        // as of the last sample, for the rates
+        uint64_t sampledPackets { 0 };
+        uint64_t sampledBytes { 0 };
+    };
+
+    struct TypeStats {
+        ByteCounts received;
+        Histogram wait;
+        Histogram handler;
+    };
+
+    static void addCounts(QJsonObject& result, ByteCounts& counts, double elapsedSeconds);
+
+    std::array<TypeStats, 256> _types;
+    std::array<ByteCounts, 256> _nodeTypes;
+    quint64 _lastSampleTime { 0 };
+};
+
+/// @}
+
+#endif // overte_PacketTrafficStats_h
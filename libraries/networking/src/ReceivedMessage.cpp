@@ -21,6 +21,7 @@ int sharedPtrReceivedMessageMetaTypeId = qRegisterMetaType<QSharedPointer<Receiv
 static const int HEAD_DATA_SIZE = 512;
 
 using namespace std::chrono;
+using namespace udt;
 
 ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
     : _data(packetList.getMessage()),
@@ -31,7 +32,9 @@ ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
       _packetVersion(packetList.getVersion()),
       _senderSockAddr(packetList.getSenderSockAddr())
 {
+    _size = _data.size();
     _firstPacketReceiveTime = duration_cast<microseconds>(packetList.getFirstPacketReceiveTime().time_since_epoch()).count();
+    _lastPacketReceiveTime = _firstPacketReceiveTime.load();
 }
 
 ReceivedMessage::ReceivedMessage(NLPacket& packet)
@@ -44,7 +47,30 @@ ReceivedMessage::ReceivedMessage(NLPacket& packet)
       _senderSockAddr(packet.getSenderSockAddr()),
       _isComplete(packet.getPacketPosition() == NLPacket::ONLY)
 {
+    _size = _data.size();
     _firstPacketReceiveTime = duration_cast<microseconds>(packet.getReceiveTime().time_since_epoch()).count();
+    _lastPacketReceiveTime = _firstPacketReceiveTime.load();
+}
+
+ReceivedMessage::ReceivedMessage(std::unique_ptr<NLPacket> packet)
+    : _isContiguous(false),
+      _numPackets(1),
+      _sourceID(packet->getSourceID()),
+      _packetType(packet->getType()),
+      _packetVersion(packet->getVersion()),
+      _senderSockAddr(packet->getSenderSockAddr()),
+      _isComplete(packet->getPacketPosition() == NLPacket::ONLY)
+{
+    _firstPacketReceiveTime = duration_cast<microseconds>(packet->getReceiveTime().time_since_epoch()).count();
+    _lastPacketReceiveTime = _firstPacketReceiveTime.load();
+
+    const char* payload = packet->getPayload() + packet->pos();
+    qint64 size = packet->bytesLeftToRead();
+    _firstBuffer = packet->releaseData();
+
+    _chunks.push_back({ PacketBuffer(), payload, size, 0 });
+    _size = size;
+    _headData = QByteArray::fromRawData(payload, (int)std::min(size, (qint64)HEAD_DATA_SIZE));
 }
 
 ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
@@ -59,6 +85,22 @@ ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, Pa
     _senderSockAddr(senderSockAddr),
     _isComplete(true)
 {
+    _size = _data.size();
+}
+
+QByteArray ReceivedMessage::getMessage() const {
+    makeContiguous();
+    return _data;
+}
+
+const char* ReceivedMessage::getRawMessage() const {
+    if (!_isContiguous && _chunks.size() == 1) {
+        // a single packet's payload is already in one piece
+        return _chunks.front().data;
+    }
+
+    makeContiguous();
+    return _data.constData();
 }
 
 void ReceivedMessage::setFailed() {
@@ -71,12 +113,50 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
     Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket", 
                "We should not be appending to a complete message");
 
+    if (_isContiguous) {
+        appendPayload(packet.getPayload(), packet.getPayloadSize(), PacketBuffer());
+    } else {
+        // the packet isn't ours to keep
+        auto buffer = PacketBufferPool::allocate(packet.getPayloadSize());
+        memcpy(buffer.get(), packet.getPayload(), packet.getPayloadSize());
+        const char* payload = buffer.get();
+        appendPayload(payload, packet.getPayloadSize(), std::move(buffer));
+    }
+
+    finishAppend(packet);
+}
+
+void ReceivedMessage::appendPacket(std::unique_ptr<NLPacket> packet) {
+    Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket", 
+               "We should not be appending to a complete message");
+
+    const char* payload = packet->getPayload();
+    qint64 size = packet->getPayloadSize();
+
+    if (_isContiguous) {
+        appendPayload(payload, size, PacketBuffer());
+    } else {
+        appendPayload(payload, size, packet->releaseData());
+    }
+
+    finishAppend(*packet);
+}
+
+void ReceivedMessage::appendPayload(const char* data, qint64 size, PacketBuffer buffer) {
+    if (_isContiguous) {
+        _data.append(data, size);
+    } else {
+        _chunks.push_back({ std::move(buffer), data, size, _size });
+    }
+    _size += size;
+}
+
+void ReceivedMessage::finishAppend(const NLPacket& packet) {
     // Limit progress signal to every X packets
     const int EMIT_PROGRESS_EVERY_X_PACKETS = 50;
 
     ++_numPackets;
-
-    _data.append(packet.getPayload(), packet.getPayloadSize());
+    _lastPacketReceiveTime = duration_cast<microseconds>(packet.getReceiveTime().time_since_epoch()).count();
 
     if (_numPackets % EMIT_PROGRESS_EVERY_X_PACKETS == 0) {
         emit progress(getSize());
@@ -94,17 +174,71 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
     }
 }
 
+ReceivedMessage::Spans ReceivedMessage::getSpans(qint64 position, qint64 size) const {
+    Spans spans;
+
+    size = std::min(size, _size - position);
+    if (size <= 0 || position < 0) {
+        return spans;
+    }
+
+    if (_isContiguous) {
+        spans.push_back({ _data.constData() + position, size });
+        return spans;
+    }
+
+    // the last chunk starting at or before position
+    auto chunk = std::upper_bound(_chunks.cbegin(), _chunks.cend(), position, [](qint64 value, const Chunk& element) {
+        return value < element.offset;
+    }) - 1;
+
+    for (; size > 0 && chunk != _chunks.cend(); ++chunk) {
+        qint64 offset = position - chunk->offset;
+        qint64 spanSize = std::min(chunk->size - offset, size);
+        if (spanSize > 0) {
+            spans.push_back({ chunk->data + offset, spanSize });
+            position += spanSize;
+            size -= spanSize;
+        }
+    }
+
+    return spans;
+}
+
+qint64 ReceivedMessage::copy(char* data, qint64 position, qint64 size) const {
+    qint64 sizeCopied = 0;
+    for (const auto& span : getSpans(position, size)) {
+        memcpy(data + sizeCopied, span.data, span.size);
+        sizeCopied += span.size;
+    }
+    return sizeCopied;
+}
+
+void ReceivedMessage::makeContiguous() const {
+    if (_isContiguous) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_contiguousMutex);
+    if (_isContiguous) {
+        // another thread flattened it while we waited
+        return;
+    }
+
+    qint64 size = _size;
+    QByteArray data((int)size, Qt::Uninitialized);
+    copy(data.data(), 0, size);
+
+    _data = data;
+    _isContiguous = true;
+}
+
 qint64 ReceivedMessage::peek(char* data, qint64 size) {
-    size_t bytesLeft = _data.size() - _position;
-    size_t sizeRead = std::min((size_t)size, bytesLeft);
-    memcpy(data, _data.constData() + _position, sizeRead);
-    return sizeRead;
+    return copy(data, _position, size);
 }
 
 qint64 ReceivedMessage::read(char* data, qint64 size) {
-    size_t bytesLeft = _data.size() - _position;
-    size_t sizeRead = std::min((size_t)size, bytesLeft);
-    memcpy(data, _data.constData() + _position, sizeRead);
+    qint64 sizeRead = copy(data, _position, size);
     _position += sizeRead;
     return sizeRead;
 }
@@ -118,11 +252,23 @@ qint64 ReceivedMessage::readHead(char* data, qint64 size) {
 }
 
 QByteArray ReceivedMessage::peek(qint64 size) {
-    return _data.mid(_position, size);
+    if (_isContiguous) {
+        return _data.mid(_position, size);
+    }
+
+    qint64 position = _position;
+    if (size < 0 || size > _size - position) {
+        size = std::max(_size - position, (qint64)0);
+    }
+
+    // straight from the packets, in one copy
+    QByteArray data((int)size, Qt::Uninitialized);
+    copy(data.data(), position, size);
+    return data;
 }
 
 QByteArray ReceivedMessage::read(qint64 size) {
-    auto data = _data.mid(_position, size);
+    auto data = peek(size);
     _position += size;
     return data;
 }
@@ -141,17 +287,46 @@ QString ReceivedMessage::readString() {
     uint32_t size;
     readPrimitive(&size);
     //Q_ASSERT(size <= _size - _position);
-    auto string = QString::fromUtf8(_data.constData() + _position, size);
+    auto spans = peekSpans(size);
+    QString string;
+    if (spans.size() == 1) {
+        string = QString::fromUtf8(spans.front().data, spans.front().size);
+    } else if (!spans.empty()) {
+        // the string straddles packets
+        string = QString::fromUtf8(peek(size));
+    }
     _position += size;
     return string;
 }
 
 QByteArray ReceivedMessage::readWithoutCopy(qint64 size) {
-    QByteArray data { QByteArray::fromRawData(_data.constData() + _position, size) };
+    auto spans = peekSpans(size);
+    const char* rawData;
+    if (spans.size() == 1) {
+        rawData = spans.front().data;
+    } else {
+        // straddles packets, or is past the end
+        makeContiguous();
+        rawData = _data.constData() + _position;
+    }
+
+    QByteArray data { QByteArray::fromRawData(rawData, size) };
     _position += size;
     return data;
 }
 
+ReceivedMessage::Spans ReceivedMessage::peekSpans(qint64 size) const {
+    return getSpans(_position, size);
+}
+
+ReceivedMessage::Spans ReceivedMessage::readSpans(qint64 size) {
+    auto spans = peekSpans(size);
+    for (const auto& span : spans) {
+        _position += span.size;
+    }
+    return spans;
+}
+
 void ReceivedMessage::onComplete() {
     _isComplete = true;
     emit completed();
@@ -18,19 +18,33 @@
 #include <QtCore/QSharedPointer>
 
 #include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "NLPacketList.h"
 
 class ReceivedMessage : public QObject {
     Q_OBJECT
 public:
+    // A piece of the message, where it lies in the payload of the packet it arrived in
+    struct Span {
+        const char* data;
+        qint64 size;
+    };
+    using Spans = std::vector<Span>;
+
     ReceivedMessage(const NLPacketList& packetList);
     ReceivedMessage(NLPacket& packet);
+    // Keeps the packet's memory rather than copying its payload
+    ReceivedMessage(std::unique_ptr<NLPacket> packet);
     ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
                     const SockAddr& senderSockAddr, NLPacket::LocalID sourceID = NLPacket::NULL_LOCAL_ID);
 
-    QByteArray getMessage() const { return _data; }
-    const char* getRawMessage() const { return _data.constData(); }
+    // A message that arrived in several packets is copied into one buffer the first time either of these is called,
+    // prefer the read methods or readSpans to get at its data.
+    QByteArray getMessage() const;
+    const char* getRawMessage() const;
 
     PacketType getType() const { return _packetType; }
     PacketVersion getVersion() const { return _packetVersion; }
@@ -38,6 +52,7 @@ public:
     void setFailed();
 
     void appendPacket(NLPacket& packet);
+    void appendPacket(std::unique_ptr<NLPacket> packet);
 
     bool failed() const { return _failed; }
     bool isComplete() const { return _isComplete; }
@@ -52,9 +67,12 @@ public:
 
     qint64 getFirstPacketReceiveTime() const { return _firstPacketReceiveTime; }
 
-    qint64 getSize() const { return _data.size(); }
+    // When the Socket received the packet that completed the message, or the latest one while it is incomplete
+    qint64 getLastPacketReceiveTime() const { return _lastPacketReceiveTime; }
+
+    qint64 getSize() const { return _size; }
 
-    qint64 getBytesLeftToRead() const { return _data.size() -  _position; }
+    qint64 getBytesLeftToRead() const { return _size - _position; }
 
     void seek(qint64 position) { _position = position; }
 
@@ -78,6 +96,11 @@ public:
     // exceed that of the ReceivedMessage.
     QByteArray readWithoutCopy(qint64 size);
 
+    // Returns the next size bytes (or what is left of them) as the pieces of packet payload they lie in, without
+    // copying. The pieces stay valid for as long as the ReceivedMessage does.
+    Spans peekSpans(qint64 size) const;
+    Spans readSpans(qint64 size);
+
     template<typename T> qint64 peekPrimitive(T* data);
     template<typename T> qint64 readPrimitive(T* data);
 
@@ -91,12 +114,38 @@ private slots:
     void onComplete();
 
 private:
-    QByteArray _data;
+    struct Chunk {
+        udt::PacketBuffer buffer; // empty for the first packet's payload, which is kept in _firstBuffer
+        const char* data;
+        qint64 size;
+        qint64 offset; // where the chunk starts in the message
+    };
+
+    void appendPayload(const char* data, qint64 size, udt::PacketBuffer buffer);
+    void finishAppend(const NLPacket& packet);
+    Spans getSpans(qint64 position, qint64 size) const;
+    qint64 copy(char* data, qint64 position, qint64 size) const;
+    void makeContiguous() const;
+
+    // Messages built from packets keep the payloads where they arrived, in _chunks, until something needs the
+    // message in one piece. Messages built from a QByteArray, or flattened, are in _data. A shared message can be
+    // flattened from any of the threads reading it, so _data is only written under _contiguousMutex, before
+    // _isContiguous is set, and _chunks are kept so that spans handed out earlier stay valid.
+    mutable QByteArray _data;
+    mutable std::vector<Chunk> _chunks;
+    mutable std::atomic<bool> _isContiguous { true };
+    mutable std::mutex _contiguousMutex;
+    std::atomic<qint64> _size { 0 };
+
+    // The first packet's memory stays around for _headData to refer to, which must not move while it is read from
+    // other threads.
+    udt::PacketBuffer _firstBuffer;
     QByteArray _headData;
 
     std::atomic<qint64> _position { 0 };
     std::atomic<qint64> _numPackets { 0 };
     std::atomic<quint64> _firstPacketReceiveTime { 0 };
+    std::atomic<quint64> _lastPacketReceiveTime { 0 };
 
     NLPacket::LocalID _sourceID { NLPacket::NULL_LOCAL_ID };
     PacketType _packetType;
@@ -12,6 +12,7 @@
 #include "ResourceCache.h"
 #include "ResourceRequestObserver.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <assert.h>
@@ -29,15 +30,232 @@
 #include "NetworkAccessManager.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
+#include "ResourcePrefetcher.h"
+
+// the bytes charged against the byte limit for a download whose size isn't known yet
+static const qint64 DEFAULT_REQUEST_BYTES = BYTES_PER_MEGABYTES;
+
+// true if a should be loaded before b: local files first, then by priority, then the most recently queued
+static bool isHigherPriority(bool aIsFile, float aPriority, uint64_t aSequence,
+                             bool bIsFile, float bPriority, uint64_t bSequence) {
+    if (aIsFile != bIsFile) {
+        return aIsFile;
+    }
+    if (aPriority != bPriority) {
+        return aPriority > bPriority;
+    }
+    return aSequence > bSequence;
+}
+
+// requests for the same data from different resources share a key
+static QString getRequestKey(const QUrl& url, const ByteRange& byteRange) {
+    QString key = url.toString();
+    if (byteRange.isSet()) {
+        key += QString("#%1-%2").arg(byteRange.fromInclusive).arg(byteRange.toExclusive);
+    }
+    return key;
+}
+
+void ResourceCacheSharedItems::swapPending(int a, int b) {
+    std::swap(_pendingRequests[a], _pendingRequests[b]);
+    _pendingIndices[_pendingRequests[a].pointer] = a;
+    _pendingIndices[_pendingRequests[b].pointer] = b;
+}
+
+void ResourceCacheSharedItems::siftPendingUp(int index) {
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        const auto& request = _pendingRequests[index];
+        const auto& parentRequest = _pendingRequests[parent];
+        if (!isHigherPriority(request.isFile, request.priority, request.sequence,
+                              parentRequest.isFile, parentRequest.priority, parentRequest.sequence)) {
+            break;
+        }
+        swapPending(index, parent);
+        index = parent;
+    }
+}
+
+void ResourceCacheSharedItems::siftPendingDown(int index) {
+    int size = (int)_pendingRequests.size();
+    while (true) {
+        int highest = index;
+        for (int child = 2 * index + 1; child <= 2 * index + 2 && child < size; ++child) {
+            const auto& request = _pendingRequests[child];
+            const auto& highestRequest = _pendingRequests[highest];
+            if (isHigherPriority(request.isFile, request.priority, request.sequence,
+                                 highestRequest.isFile, highestRequest.priority, highestRequest.sequence)) {
+                highest = child;
+            }
+        }
+        if (highest == index) {
+            break;
+        }
+        swapPending(index, highest);
+        index = highest;
+    }
+}
+
+void ResourceCacheSharedItems::pushPending(const PendingRequest& request) {
+    _pendingRequests.push_back(request);
+    int index = (int)_pendingRequests.size() - 1;
+    _pendingIndices[request.pointer] = index;
+    siftPendingUp(index);
+}
+
+void ResourceCacheSharedItems::removePendingAt(int index) {
+    int last = (int)_pendingRequests.size() - 1;
+    if (index != last) {
+        swapPending(index, last);
+    }
+    _pendingIndices.remove(_pendingRequests[last].pointer);
+    _pendingRequests.pop_back();
+    if (index < last) {
+        siftPendingDown(index);
+        siftPendingUp(index);
+    }
+}
+
+int ResourceCacheSharedItems::findPending(const Resource* resource) {
+    auto itr = _pendingIndices.find(resource);
+    if (itr == _pendingIndices.end()) {
+        return -1;
+    }
+    int index = itr.value();
+    // the entry may belong to a freed resource that had the same address
+    if (_pendingRequests[index].resource.toStrongRef().data() != resource) {
+        removePendingAt(index);
+        return -1;
+    }
+    return index;
+}
+
+void ResourceCacheSharedItems::appendRequest(QWeakPointer<Resource> resource) {
+    auto locked = resource.lock();
+    if (!locked) {
+        return;
+    }
 
-bool ResourceCacheSharedItems::appendRequest(QWeakPointer<Resource> resource) {
     Lock lock(_mutex);
-    if ((uint32_t)_loadingRequests.size() < _requestLimit) {
-        _loadingRequests.append(resource);
-        return true;
-    } else {
-        _pendingRequests.append(resource);
-        return false;
+    int index = findPending(locked.data());
+    if (index >= 0) {
+        updateRequestPriority(locked.data());
+        return;
+    }
+
+    PendingRequest request;
+    request.resource = resource;
+    request.pointer = locked.data();
+    request.priority = locked->getLoadPriority();
+    request.isFile = locked->getURL().scheme() == HIFI_URL_SCHEME_FILE;
+    request.sequence = _nextSequence++;
+    request.queuedUsecs = usecTimestampNow();
+    pushPending(request);
+}
+
+void ResourceCacheSharedItems::updateRequestPriority(const Resource* resource) {
+    Lock lock(_mutex);
+    int index = findPending(resource);
+    if (index < 0) {
+        return;
+    }
+    auto& request = _pendingRequests[index];
+    float priority = const_cast<Resource*>(resource)->getLoadPriority();
+    if (priority != request.priority) {
+        request.priority = priority;
+        siftPendingUp(index);
+        siftPendingDown(_pendingIndices[resource]);
+    }
+}
+
+void ResourceCacheSharedItems::reprioritize() {
+    Lock lock(_mutex);
+    std::vector<PendingRequest> requests;
+    requests.swap(_pendingRequests);
+    _pendingIndices.clear();
+    for (auto& request : requests) {
+        auto resource = request.resource.lock();
+        if (resource) {
+            request.priority = resource->getLoadPriority();
+            pushPending(request);
+        }
+    }
+}
+
+QSharedPointer<Resource> ResourceCacheSharedItems::takeNextRequest() {
+    Lock lock(_mutex);
+    while (!_pendingRequests.empty() && (uint32_t)_loadingRequests.size() < _requestLimit) {
+        PendingRequest request = _pendingRequests.front();
+        auto resource = request.resource.lock();
+        if (!resource) {
+            // Clear any freed resources
+            removePendingAt(0);
+            continue;
+        }
+
+        QString key = getRequestKey(resource->_activeUrl, resource->_requestByteRange);
+        bool isDuplicate = std::any_of(_loadingRequests.begin(), _loadingRequests.end(), [&](const LoadingRequest& loading) {
+            return loading.key == key && loading.pointer != request.pointer;
+        });
+        if (isDuplicate) {
+            removePendingAt(0);
+            _coalescedRequests.insert(key, request);
+            continue;
+        }
+
+        qint64 bytes = 0;
+        if (!request.isFile) {
+            if (resource->_requestByteRange.isSet() && resource->_requestByteRange.size() > 0) {
+                bytes = resource->_requestByteRange.size();
+            } else if (resource->_bytesTotal > 0) {
+                bytes = resource->_bytesTotal;
+            } else {
+                bytes = DEFAULT_REQUEST_BYTES;
+            }
+            // always let one request through, however large
+            if (!_loadingRequests.empty() && _loadingBytes + bytes > _requestByteLimit) {
+                break;
+            }
+        }
+
+        removePendingAt(0);
+        LoadingRequest loading;
+        loading.resource = request.resource;
+        loading.pointer = request.pointer;
+        loading.key = key;
+        loading.isFile = request.isFile;
+        loading.bytes = bytes;
+        _loadingRequests.append(loading);
+        _loadingBytes += bytes;
+
+        uint64_t queuedUsecs = usecTimestampNow() - request.queuedUsecs;
+        auto& queueTime = _queueTimes[resource->getType()];
+        queueTime.count++;
+        queueTime.totalUsecs += queuedUsecs;
+        queueTime.maxUsecs = std::max(queueTime.maxUsecs, queuedUsecs);
+        return resource;
+    }
+    return QSharedPointer<Resource>();
+}
+
+void ResourceCacheSharedItems::updateLoadingBytes(const Resource* resource, qint64 bytes) {
+    Lock lock(_mutex);
+    for (auto& loading : _loadingRequests) {
+        if (loading.pointer == resource && !loading.isFile) {
+            _loadingBytes += bytes - loading.bytes;
+            loading.bytes = bytes;
+            break;
+        }
+    }
+}
+
+void ResourceCacheSharedItems::releaseCoalesced(const QString& key) {
+    auto itr = _coalescedRequests.find(key);
+    while (itr != _coalescedRequests.end() && itr.key() == key) {
+        if (findPending(itr.value().pointer) < 0 && itr.value().resource) {
+            pushPending(itr.value());
+        }
+        itr = _coalescedRequests.erase(itr);
     }
 }
 
@@ -51,12 +269,33 @@ uint32_t ResourceCacheSharedItems::getRequestLimit() const {
     return _requestLimit;
 }
 
+void ResourceCacheSharedItems::setRequestByteLimit(qint64 limit) {
+    Lock lock(_mutex);
+    _requestByteLimit = limit;
+}
+
+qint64 ResourceCacheSharedItems::getRequestByteLimit() const {
+    Lock lock(_mutex);
+    return _requestByteLimit;
+}
+
+qint64 ResourceCacheSharedItems::getLoadingBytes() const {
+    Lock lock(_mutex);
+    return _loadingBytes;
+}
+
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() const {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach (QWeakPointer<Resource> resource, _pendingRequests) {
-        auto locked = resource.lock();
+    for (const auto& request : _pendingRequests) {
+        auto locked = request.resource.lock();
+        if (locked) {
+            result.append(locked);
+        }
+    }
+    for (const auto& request : _coalescedRequests) {
+        auto locked = request.resource.lock();
         if (locked) {
             result.append(locked);
         }
@@ -67,15 +306,15 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() c
 
 uint32_t ResourceCacheSharedItems::getPendingRequestsCount() const {
     Lock lock(_mutex);
-    return _pendingRequests.size();
+    return (uint32_t)(_pendingRequests.size() + _coalescedRequests.size());
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getLoadingRequests() const {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QWeakPointer<Resource> resource, _loadingRequests) {
-        auto locked = resource.lock();
+    for (const auto& request : _loadingRequests) {
+        auto locked = request.resource.lock();
         if (locked) {
             result.append(locked);
         }
@@ -89,63 +328,39 @@ uint32_t ResourceCacheSharedItems::getLoadingRequestsCount() const {
     return _loadingRequests.size();
 }
 
+QHash<QString, ResourceCacheSharedItems::QueueTime> ResourceCacheSharedItems::getQueueTimes() const {
+    Lock lock(_mutex);
+    return _queueTimes;
+}
+
 void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     Lock lock(_mutex);
 
     // resource can only be removed if it still has a ref-count, as
     // QWeakPointer has no operator== implementation for two weak ptrs, so
     // manually loop in case resource has been freed.
+    auto doneResource = resource.toStrongRef();
     for (int i = 0; i < _loadingRequests.size();) {
         auto request = _loadingRequests.at(i);
         // Clear our resource and any freed resources
-        if (!request || request.toStrongRef().data() == resource.toStrongRef().data()) {
+        if (!request.resource || request.resource.toStrongRef().data() == doneResource.data()) {
+            _loadingBytes -= request.bytes;
             _loadingRequests.removeAt(i);
+            // the requests waiting for the same data can go now
+            releaseCoalesced(request.key);
             continue;
         }
         i++;
     }
 }
 
-QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
-    QSharedPointer<Resource> highestResource;
-    Lock lock(_mutex);
-
-    bool currentHighestIsFile = false;
-
-    for (int i = 0; i < _pendingRequests.size();) {
-        // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
-        if (!resource) {
-            _pendingRequests.removeAt(i);
-            continue;
-        }
-
-        // Check load priority
-        float priority = resource->getLoadPriority();
-        bool isFile = resource->getURL().scheme() == HIFI_URL_SCHEME_FILE;
-        if (priority >= highestPriority && (isFile || !currentHighestIsFile)) {
-            highestPriority = priority;
-            highestIndex = i;
-            highestResource = resource;
-            currentHighestIsFile = isFile;
-        }
-        i++;
-    }
-
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
-    }
-
-    return highestResource;
-}
-
 void ResourceCacheSharedItems::clear() {
     Lock lock(_mutex);
     _pendingRequests.clear();
+    _pendingIndices.clear();
+    _coalescedRequests.clear();
     _loadingRequests.clear();
+    _loadingBytes = 0;
 }
 
 ScriptableResourceCache::ScriptableResourceCache(QSharedPointer<ResourceCache> resourceCache) {
@@ -158,6 +373,10 @@ QVariantList ScriptableResourceCache::getResourceList() {
     return _resourceCache->getResourceList();
 }
 
+QVariantMap ScriptableResourceCache::getRequestQueueTimes() {
+    return ResourceCache::getRequestQueueTimes();
+}
+
 void ScriptableResourceCache::updateTotalSize(const qint64& deltaSize) {
     _resourceCache->updateTotalSize(deltaSize);
 }
@@ -269,10 +488,10 @@ ResourceCache::~ResourceCache() {
 void ResourceCache::clearATPAssets() {
     {
         QWriteLocker locker(&_resourcesLock);
-        QList<QUrl> urls = _resources.keys();
+        QList<InternedUrl> urls = _resources.keys();
         for (auto& url : urls) {
             // If this is an ATP resource
-            if (url.scheme() == URL_SCHEME_ATP) {
+            if (url.getUrl().scheme() == URL_SCHEME_ATP) {
                 auto resourcesWithExtraHash = _resources.take(url);
                 for (auto& resource : resourcesWithExtraHash) {
                     if (auto strongRef = resource.lock()) {
@@ -302,7 +521,7 @@ void ResourceCache::refreshAll() {
     clearUnusedResources();
     resetUnusedResourceCounter();
 
-    QHash<QUrl, QMultiHash<size_t, QWeakPointer<Resource>>> allResources;
+    QHash<InternedUrl, QMultiHash<size_t, QWeakPointer<Resource>>> allResources;
     {
         QReadLocker locker(&_resourcesLock);
         allResources = _resources;
@@ -327,14 +546,14 @@ QVariantList ResourceCache::getResourceList() {
         BLOCKING_INVOKE_METHOD(this, "getResourceList",
             Q_RETURN_ARG(QVariantList, list));
     } else {
-        QList<QUrl> resources;
+        QList<InternedUrl> resources;
         {
             QReadLocker locker(&_resourcesLock);
             resources = _resources.keys();
         }
         list.reserve(resources.size());
         for (auto& resource : resources) {
-            list << resource;
+            list << resource.getUrl();
         }
     }
 
@@ -346,12 +565,24 @@ void ResourceCache::setRequestLimit(uint32_t limit) {
     sharedItems->setRequestLimit(limit);
 
     // Now go fill any new request spots
-    while (sharedItems->getLoadingRequestsCount() < limit && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
-    }
+    startPendingRequests();
+}
+
+void ResourceCache::setRequestByteLimit(qint64 limit) {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    sharedItems->setRequestByteLimit(limit);
+    startPendingRequests();
+}
+
+void ResourceCache::reprioritizeRequests() {
+    DependencyManager::get<ResourceCacheSharedItems>()->reprioritize();
 }
 
 QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl& fallback, void* extra, size_t extraHash) {
+    return getResource(InternedUrl(url), fallback, extra, extraHash);
+}
+
+QSharedPointer<Resource> ResourceCache::getResource(const InternedUrl& url, const QUrl& fallback, void* extra, size_t extraHash) {
     QSharedPointer<Resource> resource;
     {
         QWriteLocker locker(&_resourcesLock);
@@ -380,12 +611,12 @@ QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl&
         removeUnusedResource(resource);
     }
 
-    if (!resource && (!url.isValid() || url.isEmpty()) && fallback.isValid()) {
+    if (!resource && (!url.getUrl().isValid() || url.isNull()) && fallback.isValid()) {
         resource = getResource(fallback, QUrl(), extra, extraHash);
     }
 
     if (!resource) {
-        resource = createResource(url);
+        resource = createResource(url.getUrl());
         resource->setExtra(extra);
         resource->setExtraHash(extraHash);
         resource->setSelf(resource);
@@ -401,6 +632,9 @@ QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl&
     }
 
     DependencyManager::get<ResourceRequestObserver>()->update(resource->getURL(), -1, "ResourceCache::getResource");
+    if (DependencyManager::isSet<ResourcePrefetcher>()) {
+        DependencyManager::get<ResourcePrefetcher>()->recordRequest(this, resource);
+    }
     return resource;
 }
 
@@ -414,7 +648,7 @@ void ResourceCache::addUnusedResource(const QSharedPointer<Resource>& resource)
     // If it doesn't fit or its size is unknown, remove it from the cache.
     if (resource->getBytes() == 0 || resource->getBytes() > _unusedResourcesMaxSize) {
         resource->setCache(nullptr);
-        removeResource(resource->getURL(), resource->getExtraHash(), resource->getBytes());
+        removeResource(resource->getInternedURL(), resource->getExtraHash(), resource->getBytes());
         resetTotalResourceCounter();
         return;
     }
@@ -453,7 +687,7 @@ void ResourceCache::reserveUnusedResource(qint64 resourceSize) {
         auto size = it.value()->getBytes();
 
         locker.unlock();
-        removeResource(it.value()->getURL(), it.value()->getExtraHash(), size);
+        removeResource(it.value()->getInternedURL(), it.value()->getExtraHash(), size);
         locker.relock();
 
         _unusedResourcesSize -= size;
@@ -499,7 +733,7 @@ void ResourceCache::resetResourceCounters() {
     emit dirty();
 }
 
-void ResourceCache::removeResource(const QUrl& url, size_t extraHash, qint64 size) {
+void ResourceCache::removeResource(const InternedUrl& url, size_t extraHash, qint64 size) {
     QWriteLocker locker(&_resourcesLock);
     auto& resources = _resources[url];
     resources.remove(extraHash);
@@ -523,6 +757,20 @@ QList<QSharedPointer<Resource>> ResourceCache::getLoadingRequests() {
     return DependencyManager::get<ResourceCacheSharedItems>()->getLoadingRequests();
 }
 
+QVariantMap ResourceCache::getRequestQueueTimes() {
+    QVariantMap result;
+    auto queueTimes = DependencyManager::get<ResourceCacheSharedItems>()->getQueueTimes();
+    for (auto itr = queueTimes.begin(); itr != queueTimes.end(); ++itr) {
+        const auto& queueTime = itr.value();
+        QVariantMap times;
+        times["count"] = (double)queueTime.count;
+        times["average"] = queueTime.count > 0 ? (double)queueTime.totalUsecs / (double)(queueTime.count * USECS_PER_MSEC) : 0.0;
+        times["max"] = (double)queueTime.maxUsecs / (double)USECS_PER_MSEC;
+        result[itr.key()] = times;
+    }
+    return result;
+}
+
 uint32_t ResourceCache::getPendingRequestCount() {
     return DependencyManager::get<ResourceCacheSharedItems>()->getPendingRequestsCount();
 }
@@ -535,11 +783,15 @@ bool ResourceCache::attemptRequest(QSharedPointer<Resource> resource) {
     Q_ASSERT(!resource.isNull());
 
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
-    if (sharedItems->appendRequest(resource)) {
-        resource->makeRequest();
-        return true;
+    sharedItems->appendRequest(resource);
+
+    // the new request only starts now if it's the highest priority one that fits
+    bool started = false;
+    while (auto next = sharedItems->takeNextRequest()) {
+        started = started || next == resource;
+        next->makeRequest();
     }
-    return false;
+    return started;
 }
 
 void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
@@ -548,15 +800,14 @@ void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
     sharedItems->removeRequest(resource);
 
     // Now go fill any new request spots
-    while (sharedItems->getLoadingRequestsCount() < sharedItems->getRequestLimit() && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
-    }
+    startPendingRequests();
 }
 
-bool ResourceCache::attemptHighestPriorityRequest() {
+void ResourceCache::startPendingRequests() {
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
-    auto resource = sharedItems->getHighestPendingRequest();
-    return (resource && attemptRequest(resource));
+    while (auto resource = sharedItems->takeNextRequest()) {
+        resource->makeRequest();
+    }
 }
 
 static int requestID = 0;
@@ -564,6 +815,7 @@ static int requestID = 0;
 Resource::Resource(const Resource& other) :
     QObject(),
     _url(other._url),
+    _internedUrl(other._internedUrl),
     _effectiveBaseURL(other._effectiveBaseURL),
     _activeUrl(other._activeUrl),
     _requestByteRange(other._requestByteRange),
@@ -584,6 +836,7 @@ Resource::Resource(const Resource& other) :
 
 Resource::Resource(const QUrl& url) :
     _url(url),
+    _internedUrl(url),
     _effectiveBaseURL(url),
     _activeUrl(url),
     _requestID(++requestID) {
@@ -608,6 +861,7 @@ void Resource::ensureLoading() {
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!_failedToLoad) {
         _loadPriorities.insert(owner, priority);
+        updateRequestPriority();
     }
 }
 
@@ -619,11 +873,20 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    updateRequestPriority();
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
     if (!_failedToLoad) {
         _loadPriorities.remove(owner);
+        updateRequestPriority();
+    }
+}
+
+void Resource::updateRequestPriority() {
+    // only a resource that has started loading can be queued
+    if (_startedLoading && !_request) {
+        DependencyManager::get<ResourceCacheSharedItems>()->updateRequestPriority(this);
     }
 }
 
@@ -679,7 +942,7 @@ void Resource::allReferencesCleared() {
     } else {
         if (_cache) {
             // remove from the cache
-            _cache->removeResource(getURL(), getExtraHash(), getBytes());
+            _cache->removeResource(getInternedURL(), getExtraHash(), getBytes());
             _cache->resetTotalResourceCounter();
         }
 
@@ -757,7 +1020,7 @@ void Resource::setSize(const qint64& bytes) {
 
 void Resource::reinsert() {
     QWriteLocker locker(&_cache->_resourcesLock);
-    _cache->_resources[_url].insert(_extraHash, _self);
+    _cache->_resources[_internedUrl].insert(_extraHash, _self);
 }
 
 
@@ -798,6 +1061,9 @@ void Resource::makeRequest() {
 void Resource::handleDownloadProgress(uint64_t bytesReceived, uint64_t bytesTotal) {
     _bytesReceived = bytesReceived;
     _bytesTotal = bytesTotal;
+    if (bytesTotal > 0) {
+        DependencyManager::get<ResourceCacheSharedItems>()->updateLoadingBytes(this, (qint64)(bytesTotal - bytesReceived));
+    }
 }
 
 void Resource::handleReplyFinished() {
@@ -16,6 +16,7 @@
 
 #include <atomic>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QHash>
 #include <QtCore/QList>
@@ -31,6 +32,7 @@
 #include <QtNetwork/QNetworkRequest>
 
 #include <DependencyManager.h>
+#include <InternedUrl.h>
 
 #include "ResourceManager.h"
 
@@ -66,25 +68,78 @@ class ResourceCacheSharedItems : public Dependency  {
     using Lock = std::unique_lock<Mutex>;
 
 public:
-    bool appendRequest(QWeakPointer<Resource> newRequest);
+    /// The time spent in the pending queue by the requests of one resource type
+    struct QueueTime {
+        uint64_t count { 0 };
+        uint64_t totalUsecs { 0 };
+        uint64_t maxUsecs { 0 };
+    };
+
+    /// Queues a request, or updates its priority if it's already pending
+    void appendRequest(QWeakPointer<Resource> newRequest);
     void removeRequest(QWeakPointer<Resource> doneRequest);
     void setRequestLimit(uint32_t limit);
     uint32_t getRequestLimit() const;
+    void setRequestByteLimit(qint64 limit);
+    qint64 getRequestByteLimit() const;
+    qint64 getLoadingBytes() const;
     QList<QSharedPointer<Resource>> getPendingRequests() const;
-    QSharedPointer<Resource> getHighestPendingRequest();
+    /// Moves the highest priority pending request that fits within the request and byte limits to the loading requests
+    QSharedPointer<Resource> takeNextRequest();
+    /// Re-reads the load priority of a pending resource
+    void updateRequestPriority(const Resource* resource);
+    /// Re-reads the load priorities of all the pending resources
+    void reprioritize();
+    /// Sets the number of bytes a loading resource has left to download
+    void updateLoadingBytes(const Resource* resource, qint64 bytes);
     uint32_t getPendingRequestsCount() const;
     QList<QSharedPointer<Resource>> getLoadingRequests() const;
     uint32_t getLoadingRequestsCount() const;
+    QHash<QString, QueueTime> getQueueTimes() const;
     void clear();
 
 private:
     ResourceCacheSharedItems() = default;
 
+    struct PendingRequest {
+        QWeakPointer<Resource> resource;
+        const Resource* pointer { nullptr };
+        float priority { 0.0f };
+        bool isFile { false };
+        uint64_t sequence { 0 };
+        quint64 queuedUsecs { 0 };
+    };
+
+    struct LoadingRequest {
+        QWeakPointer<Resource> resource;
+        const Resource* pointer { nullptr };
+        QString key;
+        bool isFile { false };
+        qint64 bytes { 0 };
+    };
+
+    // The pending requests are a binary heap with the highest priority first, indexed by resource
+    void pushPending(const PendingRequest& request);
+    void removePendingAt(int index);
+    void siftPendingUp(int index);
+    void siftPendingDown(int index);
+    void swapPending(int a, int b);
+    int findPending(const Resource* resource);
+    void releaseCoalesced(const QString& key);
+
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
-    QList<QWeakPointer<Resource>> _loadingRequests;
+    std::vector<PendingRequest> _pendingRequests;
+    QHash<const Resource*, int> _pendingIndices;
+    // Requests waiting for an identical request to finish, they're then served by the disk cache
+    QMultiHash<QString, PendingRequest> _coalescedRequests;
+    QList<LoadingRequest> _loadingRequests;
+    uint64_t _nextSequence { 0 };
+    qint64 _loadingBytes { 0 };
+    QHash<QString, QueueTime> _queueTimes;
     const uint32_t DEFAULT_REQUEST_LIMIT = 10;
     uint32_t _requestLimit { DEFAULT_REQUEST_LIMIT };
+    const qint64 DEFAULT_REQUEST_BYTE_LIMIT = 32 * BYTES_PER_MEGABYTES;
+    qint64 _requestByteLimit { DEFAULT_REQUEST_BYTE_LIMIT };
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -213,10 +268,18 @@ public:
     static void setRequestLimit(uint32_t limit);
     static uint32_t getRequestLimit() { return DependencyManager::get<ResourceCacheSharedItems>()->getRequestLimit(); }
 
+    static void setRequestByteLimit(qint64 limit);
+    static qint64 getRequestByteLimit() { return DependencyManager::get<ResourceCacheSharedItems>()->getRequestByteLimit(); }
+
+    /// Re-reads the load priorities of the pending requests, after the view has moved
+    static void reprioritizeRequests();
+
     void setUnusedResourceCacheSize(qint64 unusedResourcesMaxSize);
     qint64 getUnusedResourceCacheSize() const { return _unusedResourcesMaxSize; }
 
     static QList<QSharedPointer<Resource>> getLoadingRequests();
+    /// Returns the count, average and maximum milliseconds spent pending by the requests of each resource type
+    static QVariantMap getRequestQueueTimes();
     static uint32_t getPendingRequestCount();
     static uint32_t getLoadingRequestCount();
 
@@ -247,6 +310,8 @@ protected slots:
     // FIXME: std::numeric_limits<size_t>::max() could be a valid extraHash
     QSharedPointer<Resource> getResource(const QUrl& url, const QUrl& fallback = QUrl()) { return getResource(url, fallback, nullptr, std::numeric_limits<size_t>::max()); }
     QSharedPointer<Resource> getResource(const QUrl& url, const QUrl& fallback, void* extra, size_t extraHash);
+    /// Like getResource(const QUrl&, ...), for callers that keep the interned handles of their URLs
+    QSharedPointer<Resource> getResource(const InternedUrl& url, const QUrl& fallback, void* extra, size_t extraHash);
 
 private slots:
     void clearATPAssets();
@@ -270,21 +335,23 @@ protected:
     /// \return true if the resource began loading, otherwise false if the resource is in the pending queue
     static bool attemptRequest(QSharedPointer<Resource> resource);
     static void requestCompleted(QWeakPointer<Resource> resource);
-    static bool attemptHighestPriorityRequest();
+    /// Starts the pending requests that fit within the limits, highest priority first
+    static void startPendingRequests();
 
 private:
     friend class Resource;
+    friend class ResourcePrefetcher;
     friend class ScriptableResourceCache;
 
     void reserveUnusedResource(qint64 resourceSize);
-    void removeResource(const QUrl& url, size_t extraHash, qint64 size = 0);
+    void removeResource(const InternedUrl& url, size_t extraHash, qint64 size = 0);
 
     void resetTotalResourceCounter();
     void resetUnusedResourceCounter();
     void resetResourceCounters();
 
-    // Resources
-    QHash<QUrl, QMultiHash<size_t, QWeakPointer<Resource>>> _resources;
+    // Resources, by the interned handles of their URLs so that the lookups hash and compare pointers
+    QHash<InternedUrl, QMultiHash<size_t, QWeakPointer<Resource>>> _resources;
     QReadWriteLock _resourcesLock { QReadWriteLock::Recursive };
     int _lastLRUKey = 0;
 
@@ -342,6 +409,21 @@ public:
      */
     Q_INVOKABLE QVariantList getResourceList();
 
+    /*@jsdoc
+     * Gets how long the resource requests have waited to start downloading, by resource type, across all resource cache
+     * managers.
+     * @function ResourceCache.getRequestQueueTimes
+     * @returns {Object<string, ResourceCache.QueueTime>} The queue times of each resource type, e.g.,
+     *     <code>"NetworkTexture"</code>.
+     */
+    /*@jsdoc
+     * @typedef {object} ResourceCache.QueueTime
+     * @property {number} count - The number of requests that have started.
+     * @property {number} average - The average time the requests waited, in milliseconds.
+     * @property {number} max - The longest time a request waited, in milliseconds.
+     */
+    Q_INVOKABLE QVariantMap getRequestQueueTimes();
+
     /*@jsdoc
      * @function ResourceCache.updateTotalSize
      * @param {number} deltaSize - Delta size.
@@ -463,6 +545,7 @@ public:
     virtual void deleter() { allReferencesCleared(); }
 
     const QUrl& getURL() const { return _url; }
+    const InternedUrl& getInternedURL() const { return _internedUrl; }
 
     unsigned int getDownloadAttempts() { return _attempts; }
     unsigned int getDownloadAttemptsRemaining() { return _attemptsRemaining; }
@@ -525,6 +608,7 @@ protected:
     virtual bool handleFailedRequest(ResourceRequest::Result result);
 
     QUrl _url;
+    InternedUrl _internedUrl;
     QUrl _effectiveBaseURL { _url };
     QUrl _activeUrl;
     ByteRange _requestByteRange;
@@ -556,10 +640,13 @@ public slots:
 
 private:
     friend class ResourceCache;
+    friend class ResourceCacheSharedItems;
     friend class ScriptableResource;
 
     void setLRUKey(int lruKey) { _lruKey = lruKey; }
 
+    void updateRequestPriority();
+
     void retry();
     void reinsert();
 
@@ -0,0 +1,323 @@
+//
+//  ResourcePrefetcher.cpp
+//  libraries/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ResourcePrefetcher.h"
+
+#include <algorithm>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QTimer>
+
+#include <PathUtils.h>
+
+#include "NetworkLogging.h"
+#include "ResourceCache.h"
+
+const qint64 ResourcePrefetcher::MAX_PREFETCHED_BYTES = 512 * BYTES_PER_MEGABYTES;
+
+static const QString MANIFESTS_FILENAME = "prefetch.json";
+// prefetched resources are held this long for the entities to claim them, then left to the unused resource caches
+static const int PREFETCH_HOLD_MSECS = 2 * 60 * 1000;
+
+// set while the prefetcher requests resources itself, so they aren't recorded as requests of the visit
+static thread_local bool isPrefetching = false;
+
+static bool isBetterEntry(const PrefetchManifest::Entry& a, const PrefetchManifest::Entry& b) {
+    if (a.visits != b.visits) {
+        return a.visits > b.visits;
+    }
+    if (a.lastVisit != b.lastVisit) {
+        return a.lastVisit > b.lastVisit;
+    }
+    return a.order < b.order;
+}
+
+const PrefetchManifest::Entry* PrefetchManifest::getEntry(const QString& url) const {
+    auto itr = _entries.find(url);
+    return itr != _entries.end() ? &itr.value() : nullptr;
+}
+
+void PrefetchManifest::beginVisit() {
+    ++_numVisits;
+    _numRequests = 0;
+    _lastVisitTime = QDateTime::currentMSecsSinceEpoch();
+}
+
+bool PrefetchManifest::recordRequest(const QString& url, const QString& cache) {
+    auto& entry = _entries[url];
+    if (entry.visits > 0 && entry.lastVisit == _numVisits) {
+        return false;
+    }
+    entry.url = url;
+    entry.cache = cache;
+    entry.visits++;
+    entry.lastVisit = _numVisits;
+    entry.order = _numRequests++;
+    if (_entries.size() > MAX_ENTRIES) {
+        prune();
+    }
+    return true;
+}
+
+void PrefetchManifest::setSize(const QString& url, qint64 size) {
+    auto itr = _entries.find(url);
+    if (itr != _entries.end() && size > 0) {
+        itr.value().size = size;
+    }
+}
+
+std::vector<PrefetchManifest::Entry> PrefetchManifest::select(int maxCount, qint64 maxBytes) const {
+    std::vector<Entry> entries;
+    entries.reserve(_entries.size());
+    for (const auto& entry : _entries) {
+        entries.push_back(entry);
+    }
+    std::sort(entries.begin(), entries.end(), isBetterEntry);
+
+    std::vector<Entry> selected;
+    qint64 bytes = 0;
+    for (const auto& entry : entries) {
+        if ((int)selected.size() >= maxCount) {
+            break;
+        }
+        if (bytes + entry.size > maxBytes) {
+            continue;
+        }
+        bytes += entry.size;
+        selected.push_back(entry);
+    }
+    return selected;
+}
+
+void PrefetchManifest::prune() {
+    // keep the entries with the best ranking, dropping a tenth at a time so pruning isn't done on every request
+    std::vector<Entry> entries;
+    entries.reserve(_entries.size());
+    for (const auto& entry : _entries) {
+        entries.push_back(entry);
+    }
+    std::sort(entries.begin(), entries.end(), isBetterEntry);
+    size_t keep = (size_t)(MAX_ENTRIES - MAX_ENTRIES / 10);
+    for (size_t i = keep; i < entries.size(); ++i) {
+        _entries.remove(entries[i].url);
+    }
+}
+
+QJsonObject PrefetchManifest::toJson() const {
+    QJsonArray entries;
+    for (const auto& entry : _entries) {
+        QJsonObject object;
+        object["url"] = entry.url;
+        object["cache"] = entry.cache;
+        object["size"] = (double)entry.size;
+        object["visits"] = (int)entry.visits;
+        object["order"] = (int)entry.order;
+        object["lastVisit"] = (int)entry.lastVisit;
+        entries.append(object);
+    }
+    QJsonObject json;
+    json["visits"] = (int)_numVisits;
+    json["lastVisitTime"] = (double)_lastVisitTime;
+    json["entries"] = entries;
+    return json;
+}
+
+PrefetchManifest PrefetchManifest::fromJson(const QJsonObject& json) {
+    PrefetchManifest manifest;
+    manifest._numVisits = (uint32_t)json["visits"].toInt();
+    manifest._lastVisitTime = (qint64)json["lastVisitTime"].toDouble();
+    for (const auto& value : json["entries"].toArray()) {
+        auto object = value.toObject();
+        Entry entry;
+        entry.url = object["url"].toString();
+        entry.cache = object["cache"].toString();
+        entry.size = (qint64)object["size"].toDouble();
+        entry.visits = (uint32_t)object["visits"].toInt();
+        entry.order = (uint32_t)object["order"].toInt();
+        entry.lastVisit = (uint32_t)object["lastVisit"].toInt();
+        if (!entry.url.isEmpty() && !entry.cache.isEmpty()) {
+            manifest._entries.insert(entry.url, entry);
+        }
+    }
+    return manifest;
+}
+
+static QString getManifestsPath() {
+    return QDir(PathUtils::getAppLocalDataPath()).filePath(MANIFESTS_FILENAME);
+}
+
+ResourcePrefetcher::ResourcePrefetcher() {
+}
+
+void ResourcePrefetcher::recordRequest(ResourceCache* cache, const QSharedPointer<Resource>& resource) {
+    if (isPrefetching || !cache || !resource) {
+        return;
+    }
+
+    QString url = resource->getURL().toString();
+    QString cacheName = cache->metaObject()->className();
+    QMutexLocker locker(&_mutex);
+    _caches[cacheName] = cache;
+    if (_host.isEmpty()) {
+        return;
+    }
+
+    if (!_manifests[_host].recordRequest(url, cacheName)) {
+        return;
+    }
+    _visitResources[url] = resource;
+    if (_prefetchedUrls.remove(url)) {
+        ++_hits;
+    } else {
+        ++_misses;
+    }
+}
+
+float ResourcePrefetcher::getHitRate() const {
+    QMutexLocker locker(&_mutex);
+    int requests = _hits + _misses;
+    return requests > 0 ? (float)_hits / (float)requests : 0.0f;
+}
+
+int ResourcePrefetcher::getNumPrefetched() const {
+    QMutexLocker locker(&_mutex);
+    return _numPrefetched;
+}
+
+void ResourcePrefetcher::loadManifests() {
+    if (_manifestsLoaded) {
+        return;
+    }
+    _manifestsLoaded = true;
+
+    QFile file(getManifestsPath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    auto domains = QJsonDocument::fromJson(file.readAll()).object();
+    for (auto itr = domains.begin(); itr != domains.end(); ++itr) {
+        _manifests[itr.key()] = PrefetchManifest::fromJson(itr.value().toObject());
+    }
+}
+
+void ResourcePrefetcher::endVisit() {
+    if (_host.isEmpty()) {
+        return;
+    }
+    // the sizes are only known once the resources have loaded
+    auto& manifest = _manifests[_host];
+    for (auto itr = _visitResources.begin(); itr != _visitResources.end(); ++itr) {
+        auto resource = itr.value().lock();
+        if (resource) {
+            manifest.setSize(itr.key(), resource->getBytes());
+        }
+    }
+    _visitResources.clear();
+}
+
+void ResourcePrefetcher::beginDomain(const QString& host) {
+    std::vector<PrefetchManifest::Entry> entries;
+    QHash<QString, QPointer<ResourceCache>> caches;
+    {
+        QMutexLocker locker(&_mutex);
+        if (host == _host) {
+            return;
+        }
+        loadManifests();
+        endVisit();
+
+        _host = host;
+        _prefetchedUrls.clear();
+        _heldResources.clear();
+        _numPrefetched = 0;
+        _hits = 0;
+        _misses = 0;
+        if (_host.isEmpty()) {
+            return;
+        }
+        auto& manifest = _manifests[_host];
+        entries = manifest.select(MAX_PREFETCHED_RESOURCES, MAX_PREFETCHED_BYTES);
+        manifest.beginVisit();
+        caches = _caches;
+    }
+
+    // request outside of the lock, the caches record their own requests with the prefetcher
+    QList<QSharedPointer<Resource>> prefetched;
+    isPrefetching = true;
+    for (const auto& entry : entries) {
+        auto cache = caches.value(entry.cache);
+        if (!cache) {
+            continue;
+        }
+        auto resource = cache->getResource(QUrl(entry.url));
+        if (resource) {
+            prefetched.push_back(resource);
+        }
+    }
+    isPrefetching = false;
+
+    {
+        QMutexLocker locker(&_mutex);
+        if (host != _host) {
+            return;
+        }
+        for (const auto& resource : prefetched) {
+            _prefetchedUrls.insert(resource->getURL().toString());
+        }
+        _heldResources = prefetched;
+        _numPrefetched = prefetched.size();
+    }
+    if (!prefetched.isEmpty()) {
+        qCDebug(networking) << "Prefetching" << prefetched.size() << "resources for" << host;
+        QTimer::singleShot(PREFETCH_HOLD_MSECS, this, &ResourcePrefetcher::releasePrefetched);
+    }
+}
+
+void ResourcePrefetcher::releasePrefetched() {
+    QList<QSharedPointer<Resource>> released;
+    {
+        QMutexLocker locker(&_mutex);
+        released.swap(_heldResources);
+    }
+}
+
+void ResourcePrefetcher::saveManifests() {
+    QJsonObject domains;
+    {
+        QMutexLocker locker(&_mutex);
+        loadManifests();
+        endVisit();
+
+        // keep the most recently visited domains
+        QList<QString> hosts = _manifests.keys();
+        std::sort(hosts.begin(), hosts.end(), [&](const QString& a, const QString& b) {
+            return _manifests[a].getLastVisitTime() > _manifests[b].getLastVisitTime();
+        });
+        for (int i = 0; i < hosts.size(); ++i) {
+            if (i >= MAX_DOMAINS) {
+                _manifests.remove(hosts[i]);
+            } else if (_manifests[hosts[i]].getNumEntries() > 0) {
+                domains[hosts[i]] = _manifests[hosts[i]].toJson();
+            }
+        }
+    }
+
+    QFile file(getManifestsPath());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(networking) << "Unable to save resource prefetch manifests to" << file.fileName();
+        return;
+    }
+    file.write(QJsonDocument(domains).toJson(QJsonDocument::Compact));
+}
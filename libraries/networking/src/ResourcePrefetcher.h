@@ -0,0 +1,122 @@
+//
+//  ResourcePrefetcher.h
+//  libraries/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ResourcePrefetcher_h
+#define overte_ResourcePrefetcher_h
+
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QSet>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QUrl>
+
+#include <DependencyManager.h>
+
+class Resource;
+class ResourceCache;
+
+// The resources a domain needed on earlier visits, ranked by how many visits needed them and how early.
+class PrefetchManifest {
+public:
+    struct Entry {
+        QString url;
+        // The class name of the cache that loaded the resource
+        QString cache;
+        qint64 size { 0 };
+        // The number of visits that requested the resource
+        uint32_t visits { 0 };
+        // The position of the resource among the requests of the last visit that needed it
+        uint32_t order { 0 };
+        // The visit that last requested the resource
+        uint32_t lastVisit { 0 };
+    };
+
+    static const int MAX_ENTRIES { 1000 };
+
+    uint32_t getNumVisits() const { return _numVisits; }
+    qint64 getLastVisitTime() const { return _lastVisitTime; }
+    int getNumEntries() const { return _entries.size(); }
+    const Entry* getEntry(const QString& url) const;
+
+    /// Starts a new visit, the requests recorded from now on are numbered from 0
+    void beginVisit();
+
+    /// Records a request of the current visit, returns false if the visit already requested url
+    bool recordRequest(const QString& url, const QString& cache);
+    void setSize(const QString& url, qint64 size);
+
+    /// Returns the entries worth prefetching, best first, up to maxCount of them and maxBytes in total
+    std::vector<Entry> select(int maxCount, qint64 maxBytes) const;
+
+    QJsonObject toJson() const;
+    static PrefetchManifest fromJson(const QJsonObject& json);
+
+private:
+    void prune();
+
+    QHash<QString, Entry> _entries;
+    uint32_t _numVisits { 0 };
+    uint32_t _numRequests { 0 };
+    qint64 _lastVisitTime { 0 };
+};
+
+/// Warms the resource caches with the resources a domain needed on earlier visits as soon as navigation to it
+/// starts, before its entities arrive and request them.
+class ResourcePrefetcher : public QObject, public Dependency {
+    Q_OBJECT
+    SINGLETON_DEPENDENCY
+
+public:
+    static const int MAX_PREFETCHED_RESOURCES { 256 };
+    static const qint64 MAX_PREFETCHED_BYTES;
+    static const int MAX_DOMAINS { 64 };
+
+    ResourcePrefetcher();
+
+    /// Notes a request to cache, called by the caches for every resource they're asked for
+    void recordRequest(ResourceCache* cache, const QSharedPointer<Resource>& resource);
+
+    /// Returns the fraction of the resources requested since the last navigation that were prefetched
+    float getHitRate() const;
+    int getNumPrefetched() const;
+
+public slots:
+    /// Saves the manifest of the domain being left and prefetches the resources of host
+    void beginDomain(const QString& host);
+    void saveManifests();
+
+private slots:
+    void releasePrefetched();
+
+private:
+    void loadManifests();
+    void endVisit();
+
+    mutable QMutex _mutex;
+    QHash<QString, PrefetchManifest> _manifests;
+    QHash<QString, QPointer<ResourceCache>> _caches;
+    bool _manifestsLoaded { false };
+
+    QString _host;
+    QHash<QString, QWeakPointer<Resource>> _visitResources;
+    QSet<QString> _prefetchedUrls;
+    QList<QSharedPointer<Resource>> _heldResources;
+    int _numPrefetched { 0 };
+    int _hits { 0 };
+    int _misses { 0 };
+};
+
+#endif // overte_ResourcePrefetcher_h
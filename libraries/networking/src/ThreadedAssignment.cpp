@@ -120,9 +120,11 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
     ioStats["outbound_pps"] = nodeList->getOutboundPPS();
 
     statsObject["io_stats"] = ioStats;
+    statsObject["packet_traffic"] = nodeList->sampleTrafficStats();
 
     QJsonObject assignmentStats;
     assignmentStats["numQueuedCheckIns"] = _numQueuedCheckIns;
+    assignmentStats["assignmentClient"] = _assignmentClientStats;
 
     statsObject["assignmentStats"] = assignmentStats;
 
@@ -12,6 +12,7 @@
 #ifndef hifi_ThreadedAssignment_h
 #define hifi_ThreadedAssignment_h
 
+#include <QtCore/QJsonObject>
 #include <QtCore/QSharedPointer>
 
 #include "ReceivedMessage.h"
@@ -27,6 +28,10 @@ public:
     virtual void aboutToFinish() { };
     void addPacketStatsAndSendStatsPacket(QJsonObject statsObject);
 
+    /// How the assignment client got to run this assignment, like how long it was waiting for it, sent to the
+    /// domain-server with the stats
+    void setAssignmentClientStats(const QJsonObject& stats) { _assignmentClientStats = stats; }
+
 public slots:
     /// threaded run of assignment
     virtual void run() = 0;
@@ -48,6 +53,7 @@ protected:
     QTimer _domainServerTimer;
     QTimer _statsTimer;
     int _numQueuedCheckIns { 0 };
+    QJsonObject _assignmentClientStats;
 
 protected slots:
     void domainSettingsRequestFailed();
@@ -0,0 +1,308 @@
+//
+//  BBRCC.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BBRCC.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <QtCore/QtGlobal>
+
+using namespace udt;
+using namespace std::chrono;
+
+static const double USECS_PER_SECOND = 1000000.0;
+
+// 2/ln(2), the smallest gain that still doubles the delivery rate every round
+static const double STARTUP_GAIN = 2.885;
+static const double DRAIN_GAIN = 1.0 / STARTUP_GAIN;
+static const double PROBE_BANDWIDTH_CONGESTION_WINDOW_GAIN = 2.0;
+
+static const int NUM_GAIN_CYCLE_PHASES = 8;
+static const double PROBE_BANDWIDTH_GAIN_CYCLE[NUM_GAIN_CYCLE_PHASES] = { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+
+static const double FULL_BANDWIDTH_GROWTH = 1.25;
+static const int FULL_BANDWIDTH_ROUNDS = 3;
+
+static const microseconds MIN_RTT_WINDOW { 10000000 };
+static const microseconds PROBE_RTT_DURATION { 200000 };
+
+static const int MIN_CONGESTION_WINDOW_PACKETS = 4;
+static const int INITIAL_CONGESTION_WINDOW_PACKETS = 10;
+
+// extra packets of window on top of the BDP, so delayed and stretched ACKs don't starve the pipe
+static const int CONGESTION_WINDOW_HEADROOM_PACKETS = 3;
+
+static const int MAX_RTT_SAMPLE_MICROSECONDS = 10000000;
+
+BBRCC::BBRCC() :
+    _pacingGain(STARTUP_GAIN),
+    _congestionWindowGain(STARTUP_GAIN)
+{
+    _packetSendPeriod = 0.0;
+    _congestionWindowSize = INITIAL_CONGESTION_WINDOW_PACKETS;
+}
+
+void BBRCC::onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    if (_sentPacketDatas.empty()) {
+        // nothing is in flight, so the delivery rate interval restarts now rather than at the last ACK
+        _deliveredTime = timePoint;
+    }
+
+    _sentPacketDatas.push_back({ seqNum, timePoint, _delivered, _deliveredTime, false });
+}
+
+void BBRCC::onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    auto it = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [seqNum](SentPacketData& sentPacketData) {
+        return sentPacketData.sequenceNumber == seqNum;
+    });
+
+    // a re-sent packet can't be used for RTT or delivery rate samples, we wouldn't know which send its ACK is for
+    if (it != _sentPacketDatas.end()) {
+        it->wasResent = true;
+    }
+}
+
+bool BBRCC::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    if (ack == _lastACK) {
+        // same as Reno, the third duplicate ACK means the packet after it was lost
+        static const int FAST_RETRANSMIT_DUPLICATE_COUNT = 3;
+        if (++_duplicateACKCount == FAST_RETRANSMIT_DUPLICATE_COUNT) {
+            _duplicateACKCount = 0;
+            return true;
+        }
+        return false;
+    }
+
+    if (ack < _lastACK) {
+        // out of date ACK
+        return false;
+    }
+
+    _duplicateACKCount = 0;
+
+    int numACKed = seqoff(_lastACK, ack);
+    _lastACK = ack;
+
+    _delivered += numACKed;
+    _deliveredTime = receiveTime;
+
+    // pop everything this ACK covers, the newest of which gives us our samples
+    bool canBeUsedForSamples = true;
+    bool hasSample = false;
+    SentPacketData sample;
+    while (!_sentPacketDatas.empty() && _sentPacketDatas.front().sequenceNumber <= ack) {
+        sample = _sentPacketDatas.front();
+        canBeUsedForSamples = canBeUsedForSamples && !sample.wasResent;
+        hasSample = true;
+        _sentPacketDatas.pop_front();
+    }
+
+    bool isRoundStart = false;
+    if (hasSample && sample.delivered >= _nextRoundDelivered) {
+        _nextRoundDelivered = _delivered;
+        ++_roundCount;
+        isRoundStart = true;
+        _isProbeRTTRoundDone = _mode == Mode::ProbeRTT;
+    }
+
+    if (hasSample && canBeUsedForSamples) {
+        int rtt = (int)duration_cast<microseconds>(receiveTime - sample.sendTime).count();
+        updateRTT(std::min(std::max(rtt, 1), MAX_RTT_SAMPLE_MICROSECONDS), receiveTime);
+
+        auto interval = duration_cast<microseconds>(receiveTime - sample.deliveredTime).count();
+        if (interval > 0) {
+            updateBandwidth((_delivered - sample.delivered) * USECS_PER_SECOND / interval, isRoundStart);
+        }
+    } else if (isRoundStart) {
+        updateBandwidth(0.0, isRoundStart);
+    }
+
+    updateMode(receiveTime);
+    updateControlParameters(numACKed);
+
+    // ask for a fast re-transmit if the next packet has been out for longer than we'd expect an ACK for it to take
+    if (!_sentPacketDatas.empty() && _sentPacketDatas.front().sequenceNumber == ack + 1) {
+        auto sinceSend = duration_cast<microseconds>(p_high_resolution_clock::now() - _sentPacketDatas.front().sendTime);
+        return sinceSend.count() >= estimatedTimeout();
+    }
+
+    return false;
+}
+
+void BBRCC::onTimeout() {
+    // keep the model, but stop putting new packets on the wire until the next ACK tells us the path is alive
+    _isRecoveringFromTimeout = true;
+    _congestionWindowSize = MIN_CONGESTION_WINDOW_PACKETS;
+}
+
+int BBRCC::estimatedTimeout() const {
+    return _ewmaRTT == -1 ? DEFAULT_SYN_INTERVAL : _ewmaRTT + _rttVariance * 4;
+}
+
+void BBRCC::updateRTT(int rtt, p_high_resolution_clock::time_point now) {
+    // same smoothing as TCPVegasCC, for the retransmission timeout
+    if (_ewmaRTT == -1) {
+        _ewmaRTT = rtt;
+        _rttVariance = rtt / 2;
+    } else {
+        static const int RTT_ESTIMATION_ALPHA = 8;
+        static const int RTT_ESTIMATION_VARIANCE_ALPHA = 4;
+
+        _ewmaRTT = (_ewmaRTT * (RTT_ESTIMATION_ALPHA - 1) + rtt) / RTT_ESTIMATION_ALPHA;
+        _rttVariance = (_rttVariance * (RTT_ESTIMATION_VARIANCE_ALPHA - 1) + std::abs(rtt - _ewmaRTT))
+            / RTT_ESTIMATION_VARIANCE_ALPHA;
+    }
+
+    bool isMinRTTExpired = _minRTT != -1 && now - _minRTTTimestamp > MIN_RTT_WINDOW;
+    if (_minRTT == -1 || rtt <= _minRTT || isMinRTTExpired) {
+        _minRTT = rtt;
+        _minRTTTimestamp = now;
+    }
+
+    if (isMinRTTExpired && _mode != Mode::ProbeRTT) {
+        // the propagation delay hasn't been seen for a while, drain the queue so we can measure it again
+        _mode = Mode::ProbeRTT;
+        _pacingGain = 1.0;
+        _congestionWindowGain = 1.0;
+        _priorCongestionWindowSize = _congestionWindowSize;
+        _probeRTTDoneTimestamp = p_high_resolution_clock::time_point();
+    }
+}
+
+void BBRCC::updateBandwidth(double bandwidth, bool isRoundStart) {
+    auto& roundSample = _bandwidthSamples[_roundCount % BANDWIDTH_FILTER_ROUNDS];
+    if (isRoundStart) {
+        roundSample = 0.0;
+    }
+    roundSample = std::max(roundSample, bandwidth);
+
+    if (isRoundStart && !_isPipeFilled) {
+        double bottleneckBandwidth = getBandwidth();
+        if (bottleneckBandwidth >= _fullBandwidth * FULL_BANDWIDTH_GROWTH) {
+            _fullBandwidth = bottleneckBandwidth;
+            _fullBandwidthCount = 0;
+        } else if (++_fullBandwidthCount >= FULL_BANDWIDTH_ROUNDS) {
+            _isPipeFilled = true;
+        }
+    }
+}
+
+void BBRCC::updateMode(p_high_resolution_clock::time_point now) {
+    if (_mode == Mode::Startup && _isPipeFilled) {
+        _mode = Mode::Drain;
+        _pacingGain = DRAIN_GAIN;
+        _congestionWindowGain = STARTUP_GAIN;
+    }
+
+    if (_mode == Mode::Drain) {
+        if (getPacketsInFlight() <= getBDP(1.0)) {
+            enterProbeBandwidth(now);
+        }
+    } else if (_mode == Mode::ProbeBandwidth) {
+        bool isPhaseOver = _minRTT != -1 && now - _cycleTimestamp > microseconds(_minRTT);
+        if (PROBE_BANDWIDTH_GAIN_CYCLE[_cycleIndex] < 1.0 && getPacketsInFlight() <= getBDP(1.0)) {
+            // the queue we made probing upwards is already gone
+            isPhaseOver = true;
+        }
+
+        if (isPhaseOver) {
+            _cycleIndex = (_cycleIndex + 1) % NUM_GAIN_CYCLE_PHASES;
+            _cycleTimestamp = now;
+            _pacingGain = PROBE_BANDWIDTH_GAIN_CYCLE[_cycleIndex];
+        }
+    } else if (_mode == Mode::ProbeRTT) {
+        if (_probeRTTDoneTimestamp == p_high_resolution_clock::time_point()) {
+            if (getPacketsInFlight() <= MIN_CONGESTION_WINDOW_PACKETS) {
+                // in flight is down to the minimum, hold it there for a while and for at least a round
+                _probeRTTDoneTimestamp = now + PROBE_RTT_DURATION;
+                _isProbeRTTRoundDone = false;
+                _nextRoundDelivered = _delivered;
+            }
+        } else if (_isProbeRTTRoundDone && now > _probeRTTDoneTimestamp) {
+            _minRTTTimestamp = now;
+            _congestionWindowSize = std::max(_congestionWindowSize, _priorCongestionWindowSize);
+
+            if (_isPipeFilled) {
+                enterProbeBandwidth(now);
+            } else {
+                _mode = Mode::Startup;
+                _pacingGain = STARTUP_GAIN;
+                _congestionWindowGain = STARTUP_GAIN;
+            }
+        }
+    }
+}
+
+void BBRCC::enterProbeBandwidth(p_high_resolution_clock::time_point now) {
+    _mode = Mode::ProbeBandwidth;
+    _congestionWindowGain = PROBE_BANDWIDTH_CONGESTION_WINDOW_GAIN;
+
+    // start at a random phase other than the one that drains, so that flows sharing a bottleneck don't synchronize
+    static std::random_device randomDevice;
+    static std::mt19937 generator(randomDevice());
+    std::uniform_int_distribution<int> distribution(2, NUM_GAIN_CYCLE_PHASES);
+    _cycleIndex = distribution(generator) % NUM_GAIN_CYCLE_PHASES;
+    _cycleTimestamp = now;
+    _pacingGain = PROBE_BANDWIDTH_GAIN_CYCLE[_cycleIndex];
+}
+
+void BBRCC::updateControlParameters(int numACKed) {
+    double bandwidth = getBandwidth();
+
+    // pacing - before the first delivery rate sample, pace the initial window out over the first RTT
+    double pacingRate = bandwidth * _pacingGain;
+    if (pacingRate <= 0.0 && _ewmaRTT > 0) {
+        pacingRate = _congestionWindowSize * _pacingGain * USECS_PER_SECOND / _ewmaRTT;
+    }
+    if (pacingRate > 0.0) {
+        setPacketSendPeriod(USECS_PER_SECOND / pacingRate);
+    }
+
+    // congestion window
+    if (_mode == Mode::ProbeRTT) {
+        _congestionWindowSize = MIN_CONGESTION_WINDOW_PACKETS;
+        return;
+    }
+
+    int targetWindowSize = getBDP(_congestionWindowGain) + CONGESTION_WINDOW_HEADROOM_PACKETS;
+
+    if (_isRecoveringFromTimeout) {
+        // the ACK after a timeout, resume from the model rather than growing back from the minimum
+        _isRecoveringFromTimeout = false;
+        _congestionWindowSize = std::max(targetWindowSize, MIN_CONGESTION_WINDOW_PACKETS);
+    } else if (_isPipeFilled) {
+        _congestionWindowSize = std::min(_congestionWindowSize + numACKed, targetWindowSize);
+    } else if (_congestionWindowSize < targetWindowSize || _delivered < (uint64_t)INITIAL_CONGESTION_WINDOW_PACKETS) {
+        _congestionWindowSize += numACKed;
+    }
+
+    _congestionWindowSize = std::max(_congestionWindowSize, MIN_CONGESTION_WINDOW_PACKETS);
+    _congestionWindowSize = std::min(_congestionWindowSize, udt::MAX_PACKETS_IN_FLIGHT);
+}
+
+double BBRCC::getBandwidth() const {
+    return *std::max_element(_bandwidthSamples.begin(), _bandwidthSamples.end());
+}
+
+int BBRCC::getBDP(double gain) const {
+    if (_minRTT == -1) {
+        return INITIAL_CONGESTION_WINDOW_PACKETS;
+    }
+
+    double bdp = gain * getBandwidth() * _minRTT / USECS_PER_SECOND;
+    return (int)std::min(std::ceil(bdp), (double)udt::MAX_PACKETS_IN_FLIGHT);
+}
+
+int BBRCC::getPacketsInFlight() const {
+    return std::max(seqoff(_lastACK, _sendCurrSeqNum), 0);
+}
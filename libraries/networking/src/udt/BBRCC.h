@@ -0,0 +1,117 @@
+//
+//  BBRCC.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#ifndef overte_BBRCC_h
+#define overte_BBRCC_h
+
+#include <array>
+#include <deque>
+
+#include "CongestionControl.h"
+#include "Constants.h"
+
+namespace udt {
+
+/// @addtogroup Networking
+/// @{
+
+/// @brief Model-based congestion control in the style of BBR.
+/// @details Rather than reacting to loss or queueing delay, this keeps running estimates of the bottleneck bandwidth (the
+/// windowed max of per-ACK delivery rate samples) and the round-trip propagation delay (the windowed min RTT), paces
+/// packets out at the estimated bandwidth and caps packets in flight to a small multiple of the bandwidth-delay
+/// product. That keeps long, high-RTT links full where TCPVegasCC backs off.
+/// <p>See "BBR: Congestion-Based Congestion Control", Cardwell et al., ACM Queue 14(5), 2016.</p>
+class BBRCC : public CongestionControl {
+public:
+    BBRCC();
+
+    virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) override;
+    virtual void onTimeout() override;
+
+    virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+    virtual void onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+
+    virtual int estimatedTimeout() const override;
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override { _lastACK = seqNum - 1; }
+
+private:
+    enum class Mode {
+        Startup,        // doubling the sending rate every round until the bandwidth estimate stops growing
+        Drain,          // draining the queue built up during startup
+        ProbeBandwidth, // cycling the pacing gain around 1 to probe for more bandwidth
+        ProbeRTT        // briefly cutting packets in flight to re-measure the propagation delay
+    };
+
+    struct SentPacketData {
+        SequenceNumber sequenceNumber;
+        p_high_resolution_clock::time_point sendTime;
+        uint64_t delivered; // packets delivered when this packet was sent
+        p_high_resolution_clock::time_point deliveredTime; // time of that delivery count
+        bool wasResent { false };
+    };
+
+    void updateRTT(int rtt, p_high_resolution_clock::time_point now);
+    void updateBandwidth(double bandwidth, bool isRoundStart);
+    void updateMode(p_high_resolution_clock::time_point now);
+    void enterProbeBandwidth(p_high_resolution_clock::time_point now);
+    void updateControlParameters(int numACKed);
+
+    double getBandwidth() const; // bottleneck bandwidth estimate, in packets per second
+    int getBDP(double gain) const; // bandwidth-delay product, in packets
+    int getPacketsInFlight() const;
+
+    Mode _mode { Mode::Startup };
+    double _pacingGain;
+    double _congestionWindowGain;
+
+    std::deque<SentPacketData> _sentPacketDatas;
+    SequenceNumber _lastACK;
+    int _duplicateACKCount { 0 };
+
+    uint64_t _delivered { 0 }; // packets ACKed so far
+    p_high_resolution_clock::time_point _deliveredTime;
+
+    // round trips are counted in delivered packets, a round ends once a packet sent at its start is ACKed
+    uint64_t _roundCount { 0 };
+    uint64_t _nextRoundDelivered { 0 };
+
+    static const int BANDWIDTH_FILTER_ROUNDS = 10;
+    std::array<double, BANDWIDTH_FILTER_ROUNDS> _bandwidthSamples {}; // max delivery rate seen in each recent round
+
+    // startup is over once the bandwidth estimate stops growing for a few rounds
+    double _fullBandwidth { 0.0 };
+    int _fullBandwidthCount { 0 };
+    bool _isPipeFilled { false };
+
+    int _minRTT { -1 }; // in microseconds
+    p_high_resolution_clock::time_point _minRTTTimestamp;
+    int _ewmaRTT { -1 };
+    int _rttVariance { 0 };
+
+    int _cycleIndex { 0 };
+    p_high_resolution_clock::time_point _cycleTimestamp;
+
+    p_high_resolution_clock::time_point _probeRTTDoneTimestamp;
+    bool _isProbeRTTRoundDone { false };
+    int _priorCongestionWindowSize { 0 };
+
+    bool _isRecoveringFromTimeout { false };
+};
+
+/// @}
+
+}
+
+#endif // overte_BBRCC_h
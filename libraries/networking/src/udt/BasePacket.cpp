@@ -36,7 +36,7 @@ std::unique_ptr<BasePacket> BasePacket::create(qint64 size) {
     return packet;
 }
 
-std::unique_ptr<BasePacket> BasePacket::fromReceivedPacket(std::unique_ptr<char[]> data,
+std::unique_ptr<BasePacket> BasePacket::fromReceivedPacket(PacketBuffer data,
                                                            qint64 size, const SockAddr& senderSockAddr) {
     // Fail with invalid size
     Q_ASSERT(size >= 0);
@@ -61,13 +61,14 @@ BasePacket::BasePacket(qint64 size) {
     Q_ASSERT(size >= 0 && size <= maxPayload);
     
     _packetSize = size;
-    _packet.reset(new char[_packetSize]());
+    _packet = PacketBufferPool::allocate(_packetSize);
+    memset(_packet.get(), 0, _packetSize);
     _payloadCapacity = _packetSize;
     _payloadSize = 0;
     _payloadStart = _packet.get();
 }
 
-BasePacket::BasePacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr) :
+BasePacket::BasePacket(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr) :
     _packetSize(size),
     _packet(std::move(data)),
     _payloadStart(_packet.get()),
@@ -80,7 +81,7 @@ BasePacket::BasePacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr
 
 BasePacket& BasePacket::operator=(const BasePacket& other) {
     _packetSize = other._packetSize;
-    _packet = std::unique_ptr<char[]>(new char[_packetSize]);
+    _packet = PacketBufferPool::allocate(_packetSize);
     memcpy(_packet.get(), other._packet.get(), _packetSize);
     
     _payloadStart = _packet.get() + (other._payloadStart - other._packet.get());
@@ -163,6 +164,15 @@ QString BasePacket::readString() {
     return string;
 }
 
+PacketBuffer BasePacket::releaseData() {
+    _packetSize = 0;
+    _payloadStart = nullptr;
+    _payloadCapacity = 0;
+    _payloadSize = 0;
+
+    return std::move(_packet);
+}
+
 bool BasePacket::reset() {
     if (isWritable()) {
         _payloadSize = 0;
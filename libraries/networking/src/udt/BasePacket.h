@@ -21,6 +21,7 @@
 
 #include "../SockAddr.h"
 #include "Constants.h"
+#include "PacketBufferPool.h"
 #include "../ExtendedIODevice.h"
 
 namespace udt {
@@ -31,7 +32,7 @@ public:
     static const qint64 PACKET_WRITE_ERROR;
     
     static std::unique_ptr<BasePacket> create(qint64 size = -1);
-    static std::unique_ptr<BasePacket> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+    static std::unique_ptr<BasePacket> fromReceivedPacket(PacketBuffer data, qint64 size,
                                                           const SockAddr& senderSockAddr);
     
     // Current level's header size
@@ -83,12 +84,16 @@ public:
     qint64 writeString(const QString& string);
     QString readString();
 
+    // Takes the allocated memory off the packet, so that what was read from it can outlive it without a copy.
+    // The payload stays where getPayload() pointed before the call, the packet is empty afterwards.
+    PacketBuffer releaseData();
+
     void setReceiveTime(p_high_resolution_clock::time_point receiveTime) { _receiveTime = receiveTime; }
     p_high_resolution_clock::time_point getReceiveTime() const { return _receiveTime; }
     
 protected:
     BasePacket(qint64 size);
-    BasePacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr);
+    BasePacket(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr);
     BasePacket(const BasePacket& other) : ExtendedIODevice() { *this = other; }
     BasePacket& operator=(const BasePacket& other);
     BasePacket(BasePacket&& other);
@@ -101,7 +106,7 @@ protected:
     void adjustPayloadStartAndCapacity(qint64 headerSize, bool shouldDecreasePayloadSize = false);
     
     qint64 _packetSize = 0;        // Total size of the allocated memory
-    std::unique_ptr<char[]> _packet; // Allocated memory
+    PacketBuffer _packet; // Allocated memory, from the PacketBufferPool when it fits in a slab
     
     char* _payloadStart = nullptr; // Start of the payload
     qint64 _payloadCapacity = 0;          // Total capacity of the payload
@@ -13,7 +13,9 @@
 
 #include <random>
 
+#include "BBRCC.h"
 #include "Packet.h"
+#include "TCPVegasCC.h"
 
 using namespace udt;
 using namespace std::chrono;
@@ -39,3 +41,18 @@ void CongestionControl::setPacketSendPeriod(double newSendPeriod) {
         _packetSendPeriod = newSendPeriod;
     }
 }
+
+QStringList udt::getCongestionControlNames() {
+    return { VEGAS_CONGESTION_CONTROL_NAME, BBR_CONGESTION_CONTROL_NAME };
+}
+
+std::unique_ptr<CongestionControlVirtualFactory> udt::createCongestionControlFactory(const QString& name) {
+    auto lowerName = name.trimmed().toLower();
+    if (lowerName == VEGAS_CONGESTION_CONTROL_NAME) {
+        return std::unique_ptr<CongestionControlVirtualFactory>(new CongestionControlFactory<TCPVegasCC>());
+    } else if (lowerName == BBR_CONGESTION_CONTROL_NAME) {
+        return std::unique_ptr<CongestionControlVirtualFactory>(new CongestionControlFactory<BBRCC>());
+    } else {
+        return std::unique_ptr<CongestionControlVirtualFactory>();
+    }
+}
@@ -16,6 +16,9 @@
 #include <memory>
 #include <vector>
 
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
 #include <PortableHighResolutionClock.h>
 
 #include "LossList.h"
@@ -80,6 +83,15 @@ public:
     virtual ~CongestionControlFactory() {}
     virtual std::unique_ptr<CongestionControl> create() override { return std::unique_ptr<T>(new T()); }
 };
+
+// names for the built-in congestion controllers, as used in settings and on the command line
+static const QString VEGAS_CONGESTION_CONTROL_NAME = "vegas";
+static const QString BBR_CONGESTION_CONTROL_NAME = "bbr";
+
+QStringList getCongestionControlNames();
+
+// returns a factory for the named congestion controller, or nullptr if there is no controller by that name
+std::unique_ptr<CongestionControlVirtualFactory> createCongestionControlFactory(const QString& name);
     
 }
 
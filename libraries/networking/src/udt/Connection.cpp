@@ -209,6 +209,42 @@ void Connection::recordReceivedUnreliablePackets(int wireSize, int payloadSize)
     _stats.recordUnreliableReceivedPackets(payloadSize, wireSize);
 }
 
+std::unique_ptr<ControlPacket> Connection::protectUnreliablePacket(const Packet& packet) {
+    auto parityPacket = _fecEncoder.addPacket(packet, p_high_resolution_clock::now());
+    if (parityPacket) {
+        _stats.recordSentParityPacket(parityPacket->getWireSize());
+    }
+    return parityPacket;
+}
+
+bool Connection::processReceivedUnreliablePacket(const Packet& packet, bool wasRecovered) {
+    bool shouldProcess = _fecDecoder.processReceivedPacket(packet, wasRecovered);
+
+    if (wasRecovered) {
+        _stats.recordRecoveredPacket();
+    } else if (!shouldProcess) {
+        _stats.recordDuplicatePackets(packet.getPayloadSize(), packet.getWireSize());
+    }
+
+    if (_fecDecoder.updateRequestedGroupSize(p_high_resolution_clock::now())) {
+        sendFECRequest();
+    }
+
+    return shouldProcess;
+}
+
+FECDecoder::RecoveredDatagram Connection::recoverUnreliablePacket(ControlPacket& parityPacket) {
+    _stats.recordReceivedParityPacket(parityPacket.getWireSize());
+    return _fecDecoder.recoverPacket(parityPacket);
+}
+
+void Connection::sendFECRequest() {
+    auto requestPacket = ControlPacket::create(ControlPacket::FECRequest, sizeof(int32_t));
+    requestPacket->writePrimitive((int32_t)_fecDecoder.getRequestedGroupSize());
+
+    _parentSocket->writeBasePacket(*requestPacket, _destination);
+}
+
 void Connection::sendACK() {
     SequenceNumber nextACKNumber = nextACK();
 
@@ -315,6 +351,12 @@ void Connection::processControl(ControlPacketPointer controlPacket) {
                 stopSendQueue();
             }
             break;
+        case ControlPacket::FECParity:
+            // parity is turned into rebuilt packets by the Socket, see Socket::processDatagram
+            break;
+        case ControlPacket::FECRequest:
+            processFECRequest(move(controlPacket));
+            break;
     }
 }
 
@@ -404,6 +446,24 @@ void Connection::processHandshakeACK(ControlPacketPointer controlPacket) {
     }
 }
 
+void Connection::processFECRequest(ControlPacketPointer controlPacket) {
+    int32_t groupSize { 0 };
+    controlPacket->readPrimitive(&groupSize);
+
+    int previousGroupSize = _fecEncoder.getGroupSize();
+    _fecEncoder.setGroupSize(groupSize, p_high_resolution_clock::now());
+
+    int newGroupSize = _fecEncoder.getGroupSize();
+    if (newGroupSize != previousGroupSize) {
+        if (newGroupSize > 0) {
+            qCDebug(networking) << "Connection to" << _destination << "now sends parity every"
+                << newGroupSize << "unreliable packets";
+        } else {
+            qCDebug(networking) << "Connection to" << _destination << "stopped sending parity";
+        }
+    }
+}
+
 void Connection::resetReceiveState() {
     
     // reset all SequenceNumber member variables back to default
@@ -22,6 +22,7 @@
 
 #include "ConnectionStats.h"
 #include "Constants.h"
+#include "ForwardErrorCorrection.h"
 #include "LossList.h"
 #include "SendQueue.h"
 #include "../SockAddr.h"
@@ -76,6 +77,14 @@ public:
     
     void recordSentUnreliablePackets(int wireSize, int payloadSize);
     void recordReceivedUnreliablePackets(int wireSize, int payloadSize);
+    void recordReceiveBatch(int numPackets) { _stats.recordReceiveBatch(numPackets); }
+
+    // forward error correction for unreliable packets, see FECEncoder and FECDecoder
+    // returns the parity packet to send after this one, if it completes a group - thread-safe
+    std::unique_ptr<ControlPacket> protectUnreliablePacket(const Packet& packet);
+    // return indicates if this packet should be processed, a late original of a recovered packet should not
+    bool processReceivedUnreliablePacket(const Packet& packet, bool wasRecovered);
+    FECDecoder::RecoveredDatagram recoverUnreliablePacket(ControlPacket& parityPacket);
     void setDestinationAddress(const SockAddr& destination);
 
 signals:
@@ -96,6 +105,9 @@ private:
     void processACK(ControlPacketPointer controlPacket);
     void processHandshake(ControlPacketPointer controlPacket);
     void processHandshakeACK(ControlPacketPointer controlPacket);
+    void processFECRequest(ControlPacketPointer controlPacket);
+
+    void sendFECRequest();
     
     void resetReceiveState();
     
@@ -133,6 +145,9 @@ private:
     ControlPacketPointer _handshakeACK;
 
     ConnectionStats _stats;
+
+    FECEncoder _fecEncoder;
+    FECDecoder _fecDecoder;
 };
     
 }
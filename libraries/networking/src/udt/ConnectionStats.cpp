@@ -82,6 +82,25 @@ void ConnectionStats::recordUnreliableReceivedPackets(int payload, int total) {
     _currentSample.receivedUnreliableBytes += total;
 }
 
+void ConnectionStats::recordReceiveBatch(int numPackets) {
+    ++_currentSample.receiveBatches;
+    _currentSample.receivedBatchedPackets += numPackets;
+}
+
+void ConnectionStats::recordSentParityPacket(int total) {
+    ++_currentSample.sentParityPackets;
+    recordSentPackets(0, total);
+}
+
+void ConnectionStats::recordReceivedParityPacket(int total) {
+    ++_currentSample.receivedParityPackets;
+    recordReceivedPackets(0, total);
+}
+
+void ConnectionStats::recordRecoveredPacket() {
+    ++_currentSample.recoveredPackets;
+}
+
 void ConnectionStats::recordCongestionWindowSize(int sample) {
     _currentSample.congestionWindowSize = sample;
 }
@@ -106,6 +125,15 @@ QDebug& operator<<(QDebug&& debug, const udt::ConnectionStats::Stats& stats) {
     debug << "\n     Duplicate packets: " << stats.duplicatePackets;
     debug << "\n     Sent util bytes: " << stats.sentUtilBytes;
     debug << "\n     Sent bytes: " << stats.sentBytes;
-    debug << "\n     Received bytes: " << stats.receivedBytes << "\n";
+    debug << "\n     Received bytes: " << stats.receivedBytes;
+    if (stats.receiveBatches > 0) {
+        debug << "\n     Received packets per batch: " << (float)stats.receivedBatchedPackets / stats.receiveBatches;
+    }
+    if (stats.sentParityPackets > 0 || stats.receivedParityPackets > 0) {
+        debug << "\n     Sent parity packets: " << stats.sentParityPackets;
+        debug << "\n     Received parity packets: " << stats.receivedParityPackets;
+        debug << "\n     Recovered packets: " << stats.recoveredPackets;
+    }
+    debug << "\n";
     return debug;
 }
@@ -60,6 +60,16 @@ public:
         uint64_t receivedUnreliableUtilBytes { 0 };
         uint64_t sentUnreliableBytes { 0 };
         uint64_t receivedUnreliableBytes { 0 };
+
+        // batched receive - the number of recvmmsg calls that returned packets for this connection,
+        // and the number of packets those calls returned
+        uint32_t receiveBatches { 0 };
+        uint32_t receivedBatchedPackets { 0 };
+
+        // forward error correction - parity packets sent and received, and unreliable packets rebuilt from parity
+        uint32_t sentParityPackets { 0 };
+        uint32_t receivedParityPackets { 0 };
+        uint32_t recoveredPackets { 0 };
        
         // the following stats are trailing averages in the result, not totals
         int sendRate { 0 };
@@ -91,6 +101,12 @@ public:
     void recordUnreliableSentPackets(int payload, int total);
     void recordUnreliableReceivedPackets(int payload, int total);
 
+    void recordReceiveBatch(int numPackets);
+
+    void recordSentParityPacket(int total);
+    void recordReceivedParityPacket(int total);
+    void recordRecoveredPacket();
+
     void recordCongestionWindowSize(int sample);
     void recordPacketSendPeriod(int sample);
     
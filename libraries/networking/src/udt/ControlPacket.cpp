@@ -26,7 +26,7 @@ int ControlPacket::maxPayloadSize() {
     return BasePacket::maxPayloadSize() - ControlPacket::localHeaderSize();
 }
 
-std::unique_ptr<ControlPacket> ControlPacket::fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+std::unique_ptr<ControlPacket> ControlPacket::fromReceivedPacket(PacketBuffer data, qint64 size,
                                                                  const SockAddr &senderSockAddr) {
     // Fail with null data
     Q_ASSERT(data);
@@ -57,7 +57,7 @@ ControlPacket::ControlPacket(Type type, qint64 size) :
     writeType();
 }
 
-ControlPacket::ControlPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr) :
+ControlPacket::ControlPacket(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr) :
     BasePacket(std::move(data), size, senderSockAddr)
 {
     // sanity check before we decrease the payloadSize with the payloadCapacity
@@ -101,7 +101,7 @@ void ControlPacket::readType() {
     Q_ASSERT_X(bitAndType & CONTROL_BIT_MASK, "ControlPacket::readType()", "This should be a control packet");
     
     uint16_t packetType = (bitAndType & ~CONTROL_BIT_MASK) >> (8 * sizeof(Type));
-    Q_ASSERT_X(packetType <= ControlPacket::Type::HandshakeRequest, "ControlPacket::readType()",
+    Q_ASSERT_X(packetType <= ControlPacket::Type::FECRequest, "ControlPacket::readType()",
         "Received a control packet with invalid type");
     
     // read the type
@@ -31,11 +31,13 @@ public:
         ACK,
         Handshake,
         HandshakeACK,
-        HandshakeRequest
+        HandshakeRequest,
+        FECParity,
+        FECRequest
     };
     
     static std::unique_ptr<ControlPacket> create(Type type, qint64 size = -1);
-    static std::unique_ptr<ControlPacket> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+    static std::unique_ptr<ControlPacket> fromReceivedPacket(PacketBuffer data, qint64 size,
                                                              const SockAddr& senderSockAddr);
     // Current level's header size
     static int localHeaderSize();
@@ -50,7 +52,7 @@ public:
 private:
     Q_DISABLE_COPY(ControlPacket)
     ControlPacket(Type type, qint64 size = -1);
-    ControlPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr);
+    ControlPacket(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr);
     ControlPacket(ControlPacket&& other);
     
     ControlPacket& operator=(ControlPacket&& other);
@@ -0,0 +1,239 @@
+//
+//  DatagramBatchReader.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "DatagramBatchReader.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtNetwork/QHostAddress>
+
+#include "../NetworkLogging.h"
+#include "Constants.h"
+
+#if defined(UDT_BATCHED_RECEIVE)
+#include <cerrno>
+#include <netinet/udp.h>
+
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#endif
+
+using namespace udt;
+
+// a GRO slot must be able to hold the largest coalesced super-datagram the kernel will hand us
+static const int GRO_SLOT_SIZE = 65535;
+
+DatagramBatchReader::DatagramBatchReader(int batchSize, bool useGRO) :
+    _batchSize(std::max(batchSize, 1)),
+    _groRequested(useGRO)
+{
+}
+
+bool DatagramBatchReader::isSupported() {
+#if defined(UDT_BATCHED_RECEIVE)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void DatagramBatchReader::attach(qintptr socketDescriptor) {
+    detach();
+
+    if (!isSupported() || socketDescriptor < 0) {
+        return;
+    }
+
+    _socketDescriptor = socketDescriptor;
+
+#if defined(UDT_BATCHED_RECEIVE)
+    _groEnabled = false;
+    if (_groRequested) {
+        int enable = 1;
+        if (setsockopt((int)_socketDescriptor, SOL_UDP, UDP_GRO, &enable, sizeof(enable)) == 0) {
+            _groEnabled = true;
+        } else {
+            qCDebug(networking) << "DatagramBatchReader: UDP GRO not available on this kernel, using plain recvmmsg";
+        }
+    }
+
+    _slotSize = _groEnabled ? GRO_SLOT_SIZE : MAX_PACKET_SIZE;
+
+    _buffers.clear();
+    _buffers.reserve(_batchSize);
+    for (int i = 0; i < _batchSize; ++i) {
+        _buffers.push_back(PacketBufferPool::allocate(_slotSize));
+    }
+
+    _headers.assign(_batchSize, mmsghdr());
+    _iovecs.assign(_batchSize, iovec());
+    _addresses.assign(_batchSize, sockaddr_storage());
+    _controls.assign(_batchSize, {});
+#endif
+
+    qCDebug(networking) << "DatagramBatchReader attached with" << _batchSize << "slots of" << _slotSize << "bytes"
+        << (_groEnabled ? "(GRO enabled)" : "");
+}
+
+void DatagramBatchReader::detach() {
+    _socketDescriptor = -1;
+    _groEnabled = false;
+    _segments.clear();
+    _slotsFilled = 0;
+    _datagramCount = 0;
+    _nextDatagram = 0;
+}
+
+#if defined(UDT_BATCHED_RECEIVE)
+static int findSegmentSize(msghdr& header) {
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&header); cmsg; cmsg = CMSG_NXTHDR(&header, cmsg)) {
+        if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+            int gsoSize = 0;
+            std::memcpy(&gsoSize, CMSG_DATA(cmsg), sizeof(gsoSize));
+            return std::max(gsoSize, 0);
+        }
+    }
+    return 0;
+}
+#endif
+
+int DatagramBatchReader::receiveBatch() {
+    _segments.clear();
+    _slotsFilled = 0;
+    _datagramCount = 0;
+    _nextDatagram = 0;
+
+#if defined(UDT_BATCHED_RECEIVE)
+    if (!isAttached()) {
+        return 0;
+    }
+
+    for (int i = 0; i < _batchSize; ++i) {
+        if (!_buffers[i]) {
+            _buffers[i] = PacketBufferPool::allocate(_slotSize);
+        }
+
+        _iovecs[i].iov_base = _buffers[i].get();
+        _iovecs[i].iov_len = _slotSize;
+
+        std::memset(&_headers[i], 0, sizeof(mmsghdr));
+        auto& header = _headers[i].msg_hdr;
+        header.msg_name = &_addresses[i];
+        header.msg_namelen = sizeof(sockaddr_storage);
+        header.msg_iov = &_iovecs[i];
+        header.msg_iovlen = 1;
+        if (_groEnabled) {
+            header.msg_control = _controls[i].data();
+            header.msg_controllen = _controls[i].size();
+        }
+    }
+
+    int received = recvmmsg((int)_socketDescriptor, _headers.data(), _batchSize, MSG_DONTWAIT, nullptr);
+
+    if (received <= 0) {
+        if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            qCDebug(networking) << "DatagramBatchReader: recvmmsg failed with errno" << errno;
+        }
+        return 0;
+    }
+
+    _slotsFilled = received;
+    for (int i = 0; i < received; ++i) {
+        int size = (int)_headers[i].msg_len;
+        if (size <= 0) {
+            continue;
+        }
+
+        int segmentSize = size;
+        if (_groEnabled) {
+            int gsoSize = findSegmentSize(_headers[i].msg_hdr);
+            if (gsoSize > 0) {
+                segmentSize = gsoSize;
+            }
+        }
+
+        if (segmentSize >= size) {
+            _segments.push_back({ i, 0, size, true });
+        } else {
+            for (int offset = 0; offset < size; offset += segmentSize) {
+                _segments.push_back({ i, offset, std::min(segmentSize, size - offset), false });
+            }
+        }
+    }
+
+    _datagramCount = (int)_segments.size();
+#endif
+
+    return _datagramCount;
+}
+
+int DatagramBatchReader::peekSegmentSize() const {
+#if defined(UDT_BATCHED_RECEIVE)
+    if (!_groEnabled || !isAttached()) {
+        return 0;
+    }
+
+    // the datagram is left on the socket, only its control messages are wanted
+    char byte;
+    iovec vector { &byte, sizeof(byte) };
+    std::array<char, CMSG_SPACE(sizeof(int))> control {};
+    msghdr header;
+    std::memset(&header, 0, sizeof(header));
+    header.msg_iov = &vector;
+    header.msg_iovlen = 1;
+    header.msg_control = control.data();
+    header.msg_controllen = control.size();
+    if (recvmsg((int)_socketDescriptor, &header, MSG_PEEK | MSG_DONTWAIT) < 0) {
+        return 0;
+    }
+    return findSegmentSize(header);
+#else
+    return 0;
+#endif
+}
+
+DatagramBatchReader::Datagram DatagramBatchReader::takeDatagram() {
+    Datagram datagram;
+
+    if (!hasPendingDatagrams()) {
+        return datagram;
+    }
+
+    const auto& segment = _segments[_nextDatagram++];
+
+#if defined(UDT_BATCHED_RECEIVE)
+    const auto& address = _addresses[segment.slot];
+    quint16 port = 0;
+    if (address.ss_family == AF_INET6) {
+        port = ntohs(reinterpret_cast<const sockaddr_in6*>(&address)->sin6_port);
+    } else {
+        port = ntohs(reinterpret_cast<const sockaddr_in*>(&address)->sin_port);
+    }
+    datagram.sender = SockAddr(SocketType::UDP, QHostAddress(reinterpret_cast<const sockaddr*>(&address)), port);
+#endif
+
+    if (segment.wholeSlot && _slotSize <= PacketBufferPool::SLAB_SIZE) {
+        // hand the slot's slab off to the packet, receiveBatch will give the slot a fresh one
+        datagram.data = std::move(_buffers[segment.slot]);
+    } else {
+        // datagrams in large GRO slots are copied out so the slot can be re-used
+        datagram.data = PacketBufferPool::allocate(segment.size);
+        std::memcpy(datagram.data.get(), _buffers[segment.slot].get() + segment.offset, segment.size);
+    }
+    datagram.size = segment.size;
+
+    return datagram;
+}
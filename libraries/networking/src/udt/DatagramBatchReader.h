@@ -0,0 +1,126 @@
+//
+//  DatagramBatchReader.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#ifndef overte_DatagramBatchReader_h
+#define overte_DatagramBatchReader_h
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+#include "../SockAddr.h"
+#include "PacketBufferPool.h"
+
+#if defined(Q_OS_LINUX)
+#define UDT_BATCHED_RECEIVE
+#endif
+
+#if defined(UDT_BATCHED_RECEIVE)
+#include <sys/socket.h>
+#include <netinet/in.h>
+#endif
+
+namespace udt {
+
+/// @addtogroup Networking
+/// @{
+
+/// @brief Reads many UDP datagrams per system call into a ring of preallocated packet buffers.
+/// @details Built on <code>recvmmsg</code>, and on UDP GRO where the kernel supports it, in which case a single ring slot
+/// may hold several coalesced datagrams that are split apart again by <code>takeDatagram</code>.
+/// Only available on Linux - elsewhere <code>isSupported()</code> returns <code>false</code> and callers must use the
+/// regular one-datagram-at-a-time path.
+class DatagramBatchReader {
+public:
+    /// @brief A single datagram taken out of the most recent batch.
+    struct Datagram {
+        PacketBuffer data;
+        int size { 0 };
+        SockAddr sender;
+    };
+
+    static const int DEFAULT_BATCH_SIZE = 64;
+
+    /// @brief Constructs a reader with a ring of <code>batchSize</code> receive slots.
+    /// @param batchSize The maximum number of datagrams read per system call.
+    /// @param useGRO Whether to ask the kernel to coalesce datagrams (UDP GRO) when attaching to a socket.
+    DatagramBatchReader(int batchSize = DEFAULT_BATCH_SIZE, bool useGRO = false);
+
+    /// @brief Returns whether batched receive is available on this platform.
+    static bool isSupported();
+
+    /// @brief Prepares the socket for batched reads, enabling UDP GRO if the kernel has it.
+    /// @param socketDescriptor The native UDP socket descriptor.
+    void attach(qintptr socketDescriptor);
+
+    /// @brief Detaches from the current socket, e.g. before it is rebound.
+    void detach();
+
+    bool isAttached() const { return _socketDescriptor >= 0; }
+    bool isGROEnabled() const { return _groEnabled; }
+
+    /// @brief Performs a single non-blocking <code>recvmmsg</code> and splits any coalesced segments.
+    /// @return The number of datagrams now waiting to be taken, <code>0</code> if the socket had nothing to read.
+    int receiveBatch();
+
+    /// @brief Returns whether there are datagrams left in the most recent batch.
+    bool hasPendingDatagrams() const { return _nextDatagram < _datagramCount; }
+
+    /// @brief Takes the next datagram out of the most recent batch.
+    /// @details Whole slots are handed off without a copy and the slot is given a fresh slab from the PacketBufferPool;
+    /// coalesced segments are copied out of the slot buffer.
+    Datagram takeDatagram();
+
+    /// @brief Gets the size of the segments coalesced into the next datagram on the socket, without reading it.
+    /// @details For the reads that don't go through the reader, which get a GRO super-datagram whole, to split it.
+    /// @return The segment size if the next datagram is coalesced, otherwise <code>0</code>.
+    int peekSegmentSize() const;
+
+    /// @brief Returns whether the most recent receiveBatch() call filled every slot, i.e. more data may be queued.
+    bool wasLastBatchFull() const { return _slotsFilled == _batchSize; }
+
+private:
+    struct Segment {
+        int slot { 0 };
+        int offset { 0 };
+        int size { 0 };
+        bool wholeSlot { true };
+    };
+
+    int _batchSize;
+    int _slotSize { 0 };
+    qintptr _socketDescriptor { -1 };
+    bool _groRequested { false };
+    bool _groEnabled { false };
+
+    std::vector<PacketBuffer> _buffers;
+    std::vector<Segment> _segments;
+    int _slotsFilled { 0 };
+    int _datagramCount { 0 };
+    int _nextDatagram { 0 };
+
+#if defined(UDT_BATCHED_RECEIVE)
+    std::vector<mmsghdr> _headers;
+    std::vector<iovec> _iovecs;
+    std::vector<sockaddr_storage> _addresses;
+    std::vector<std::array<char, CMSG_SPACE(sizeof(int))>> _controls;
+#endif
+};
+
+/// @}
+
+} // namespace udt
+
+#endif // overte_DatagramBatchReader_h
@@ -0,0 +1,307 @@
+//
+//  DatagramBatchWriter.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "DatagramBatchWriter.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include <QtNetwork/QHostAddress>
+
+#include <LogHandler.h>
+
+#include "../NetworkLogging.h"
+
+#if defined(UDT_BATCHED_SEND)
+#include <cerrno>
+#include <netinet/udp.h>
+
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#endif
+
+using namespace udt;
+
+#if defined(UDT_BATCHED_SEND)
+static const int MAX_MESSAGES_PER_SYSCALL = 64;
+static const int MAX_GSO_SEGMENTS = 64;
+static const int MAX_GSO_BYTES = 65000;
+
+static bool isSameAddress(const sockaddr_in& lhs, const sockaddr_in& rhs) {
+    return lhs.sin_port == rhs.sin_port && lhs.sin_addr.s_addr == rhs.sin_addr.s_addr;
+}
+#endif
+
+DatagramBatchWriter::DatagramBatchWriter(bool useGSO) :
+    _gsoRequested(useGSO)
+{
+}
+
+bool DatagramBatchWriter::isSupported() {
+#if defined(UDT_BATCHED_SEND)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void DatagramBatchWriter::attach(qintptr socketDescriptor) {
+    flush();
+
+    if (!isSupported() || socketDescriptor < 0) {
+        detach();
+        return;
+    }
+
+    bool gsoEnabled = false;
+#if defined(UDT_BATCHED_SEND)
+    if (_gsoRequested) {
+        // probe for kernel support, the per-message segment size is passed as a control message on each send
+        int segmentSize = 0;
+        socklen_t optionLength = sizeof(segmentSize);
+        gsoEnabled = getsockopt((int)socketDescriptor, SOL_UDP, UDP_SEGMENT, &segmentSize, &optionLength) == 0;
+        if (!gsoEnabled) {
+            qCDebug(networking) << "DatagramBatchWriter: UDP GSO not available on this kernel, using plain sendmmsg";
+        }
+    }
+#endif
+
+    _gsoEnabled = gsoEnabled;
+    _socketDescriptor = socketDescriptor;
+}
+
+void DatagramBatchWriter::detach() {
+    std::lock_guard<std::mutex> flushLock(_flushMutex);
+    _socketDescriptor = -1;
+
+    std::lock_guard<std::mutex> queueLock(_queueMutex);
+    _droppedDatagrams += _entries.size();
+    _entries.clear();
+    _arena.clear();
+}
+
+bool DatagramBatchWriter::queueDatagram(const char* data, qint64 size, const SockAddr& sockAddr) {
+#if defined(UDT_BATCHED_SEND)
+    if (!isAttached() || size <= 0) {
+        return false;
+    }
+
+    bool isValidAddress = false;
+    quint32 ipv4Address = sockAddr.getAddress().toIPv4Address(&isValidAddress);
+    if (!isValidAddress) {
+        // the node socket is bound to an IPv4 address, let the regular path report anything else
+        return false;
+    }
+
+    Entry entry;
+    entry.size = (int)size;
+    std::memset(&entry.address, 0, sizeof(entry.address));
+    entry.address.sin_family = AF_INET;
+    entry.address.sin_port = htons(sockAddr.getPort());
+    entry.address.sin_addr.s_addr = htonl(ipv4Address);
+
+    bool shouldFlush = false;
+    {
+        std::lock_guard<std::mutex> queueLock(_queueMutex);
+        entry.offset = _arena.size();
+        _arena.insert(_arena.end(), data, data + size);
+        _entries.push_back(entry);
+        shouldFlush = _entries.size() >= (size_t)MAX_QUEUED_DATAGRAMS;
+    }
+
+    if (shouldFlush) {
+        flush();
+    }
+
+    return true;
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(size);
+    Q_UNUSED(sockAddr);
+    return false;
+#endif
+}
+
+int DatagramBatchWriter::flush() {
+    std::lock_guard<std::mutex> flushLock(_flushMutex);
+
+    {
+        std::lock_guard<std::mutex> queueLock(_queueMutex);
+        if (_entries.empty()) {
+            return 0;
+        }
+        _flushEntries.swap(_entries);
+        _flushArena.swap(_arena);
+    }
+
+    ++_flushes;
+    int sent = flushEntries(_flushEntries, _flushArena);
+
+    // keep the capacity around for the next frame's batch
+    _flushEntries.clear();
+    _flushArena.clear();
+
+    return sent;
+}
+
+int DatagramBatchWriter::flushEntries(const std::vector<Entry>& entries, std::vector<char>& arena) {
+#if defined(UDT_BATCHED_SEND)
+    int socketDescriptor = (int)_socketDescriptor;
+    if (socketDescriptor < 0) {
+        _droppedDatagrams += entries.size();
+        return 0;
+    }
+
+    const bool useGSO = _gsoEnabled;
+
+    std::vector<iovec> iovecs(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        iovecs[i].iov_base = arena.data() + entries[i].offset;
+        iovecs[i].iov_len = entries[i].size;
+    }
+
+    // group the entries into messages - with GSO a message is a run of equal-sized datagrams to the same destination,
+    // of which only the last may be shorter
+    struct Message {
+        size_t firstEntry;
+        int numEntries;
+    };
+    std::vector<Message> messages;
+    messages.reserve(entries.size());
+
+    for (size_t i = 0; i < entries.size();) {
+        int numEntries = 1;
+        int totalSize = entries[i].size;
+
+        if (useGSO) {
+            while (i + numEntries < entries.size() && numEntries < MAX_GSO_SEGMENTS) {
+                const auto& next = entries[i + numEntries];
+                if (!isSameAddress(next.address, entries[i].address) || next.size > entries[i].size
+                    || totalSize + next.size > MAX_GSO_BYTES) {
+                    break;
+                }
+
+                totalSize += next.size;
+                ++numEntries;
+
+                if (next.size < entries[i].size) {
+                    break;
+                }
+            }
+        }
+
+        messages.push_back({ i, numEntries });
+        i += numEntries;
+    }
+
+    using Control = std::array<char, CMSG_SPACE(sizeof(uint16_t))>;
+    std::vector<mmsghdr> headers(messages.size());
+    std::vector<Control> controls(messages.size());
+
+    for (size_t m = 0; m < messages.size(); ++m) {
+        const auto& message = messages[m];
+        const auto& first = entries[message.firstEntry];
+
+        std::memset(&headers[m], 0, sizeof(mmsghdr));
+        auto& header = headers[m].msg_hdr;
+        header.msg_name = const_cast<sockaddr_in*>(&first.address);
+        header.msg_namelen = sizeof(sockaddr_in);
+        header.msg_iov = &iovecs[message.firstEntry];
+        header.msg_iovlen = message.numEntries;
+
+        if (message.numEntries > 1) {
+            header.msg_control = controls[m].data();
+            header.msg_controllen = controls[m].size();
+
+            cmsghdr* cmsg = CMSG_FIRSTHDR(&header);
+            cmsg->cmsg_level = SOL_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            uint16_t segmentSize = (uint16_t)first.size;
+            std::memcpy(CMSG_DATA(cmsg), &segmentSize, sizeof(segmentSize));
+        }
+    }
+
+    int datagramsSent = 0;
+    size_t nextMessage = 0;
+    while (nextMessage < messages.size()) {
+        int numMessages = (int)std::min(messages.size() - nextMessage, (size_t)MAX_MESSAGES_PER_SYSCALL);
+        int result = sendmmsg(socketDescriptor, &headers[nextMessage], numMessages, 0);
+        ++_syscalls;
+
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (result <= 0) {
+            int error = errno;
+            size_t firstUnsent = messages[nextMessage].firstEntry;
+
+            if (useGSO && error == EIO) {
+                // the interface can't do checksum offload for segmented sends - disable GSO and re-send the rest
+                qCDebug(networking) << "DatagramBatchWriter: UDP GSO send failed, disabling GSO";
+                _gsoEnabled = false;
+                std::vector<Entry> remaining(entries.begin() + firstUnsent, entries.end());
+                return datagramsSent + flushEntries(remaining, arena);
+            }
+
+            // same as a failed QUdpSocket::writeDatagram - the rest of this batch is lost
+            _droppedDatagrams += entries.size() - firstUnsent;
+            HIFI_FCDEBUG(networking(), "DatagramBatchWriter: sendmmsg failed with errno" << error << "- dropped"
+                << (entries.size() - firstUnsent) << "datagrams");
+            break;
+        }
+
+        for (int m = 0; m < result; ++m) {
+            const auto& message = messages[nextMessage + m];
+            datagramsSent += message.numEntries;
+            if (message.numEntries > 1) {
+                _gsoDatagrams += message.numEntries;
+            }
+        }
+        nextMessage += result;
+    }
+
+    _datagrams += datagramsSent;
+    return datagramsSent;
+#else
+    Q_UNUSED(arena);
+    _droppedDatagrams += entries.size();
+    return 0;
+#endif
+}
+
+QJsonObject DatagramBatchWriter::Stats::toJson() const {
+    QJsonObject result;
+    result["flushes"] = (qint64)flushes;
+    result["syscalls"] = (qint64)syscalls;
+    result["datagrams"] = (qint64)datagrams;
+    result["gso_datagrams"] = (qint64)gsoDatagrams;
+    result["dropped_datagrams"] = (qint64)droppedDatagrams;
+    result["avg_datagrams_per_flush"] = flushes > 0 ? (double)datagrams / flushes : 0.0;
+    result["avg_datagrams_per_syscall"] = syscalls > 0 ? (double)datagrams / syscalls : 0.0;
+    return result;
+}
+
+DatagramBatchWriter::Stats DatagramBatchWriter::sampleStats() {
+    Stats sample;
+    sample.flushes = _flushes.exchange(0);
+    sample.syscalls = _syscalls.exchange(0);
+    sample.datagrams = _datagrams.exchange(0);
+    sample.gsoDatagrams = _gsoDatagrams.exchange(0);
+    sample.droppedDatagrams = _droppedDatagrams.exchange(0);
+    return sample;
+}
@@ -0,0 +1,123 @@
+//
+//  DatagramBatchWriter.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#ifndef overte_DatagramBatchWriter_h
+#define overte_DatagramBatchWriter_h
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QtGlobal>
+
+#include "../SockAddr.h"
+
+#if defined(Q_OS_LINUX)
+#define UDT_BATCHED_SEND
+#endif
+
+#if defined(UDT_BATCHED_SEND)
+#include <sys/socket.h>
+#include <netinet/in.h>
+#endif
+
+namespace udt {
+
+/// @addtogroup Networking
+/// @{
+
+/// @brief Collects outgoing UDP datagrams from any thread and writes them out with as few system calls as possible.
+/// @details Flushes use <code>sendmmsg</code>, and UDP GSO where the kernel supports it, in which case consecutive
+/// equal-sized datagrams to the same destination are handed to the kernel as a single super-datagram.
+/// Only available on Linux - elsewhere <code>isSupported()</code> returns <code>false</code> and callers must write
+/// datagrams directly.
+class DatagramBatchWriter {
+public:
+    /// @brief Cumulative writer counters, reset by <code>sampleStats()</code>.
+    struct Stats {
+        uint64_t flushes { 0 };
+        uint64_t syscalls { 0 };
+        uint64_t datagrams { 0 };
+        uint64_t gsoDatagrams { 0 };
+        uint64_t droppedDatagrams { 0 };
+
+        /// @brief Returns the counters, plus the average datagrams per flush and per syscall, for stats packets.
+        QJsonObject toJson() const;
+    };
+
+    // a batch this large is flushed straight away, so that a missed flush can't hold up traffic indefinitely
+    static const int MAX_QUEUED_DATAGRAMS = 1024;
+
+    /// @brief Constructs a writer.
+    /// @param useGSO Whether to use UDP GSO when the kernel supports it.
+    DatagramBatchWriter(bool useGSO = false);
+
+    /// @brief Returns whether batched send is available on this platform.
+    static bool isSupported();
+
+    /// @brief Starts writing to a socket, flushing anything still queued for the previous one.
+    /// @param socketDescriptor The native UDP socket descriptor.
+    void attach(qintptr socketDescriptor);
+
+    /// @brief Stops writing to the current socket, dropping anything still queued.
+    void detach();
+
+    bool isAttached() const { return _socketDescriptor >= 0; }
+
+    /// @brief Copies a datagram into the pending batch. Thread-safe.
+    /// @return <code>true</code> if the datagram was queued, <code>false</code> if it must be written directly.
+    bool queueDatagram(const char* data, qint64 size, const SockAddr& sockAddr);
+
+    /// @brief Writes every queued datagram out to the socket. Thread-safe.
+    /// @return The number of datagrams the kernel accepted.
+    int flush();
+
+    Stats sampleStats();
+
+private:
+    struct Entry {
+        size_t offset;
+        int size;
+#if defined(UDT_BATCHED_SEND)
+        sockaddr_in address;
+#endif
+    };
+
+    int flushEntries(const std::vector<Entry>& entries, std::vector<char>& arena);
+
+    std::atomic<qintptr> _socketDescriptor { -1 };
+    bool _gsoRequested { false };
+    std::atomic<bool> _gsoEnabled { false };
+
+    std::mutex _queueMutex;
+    std::vector<Entry> _entries;
+    std::vector<char> _arena;
+
+    // serializes flushes so that datagrams stay in order on the wire
+    std::mutex _flushMutex;
+    std::vector<Entry> _flushEntries;
+    std::vector<char> _flushArena;
+
+    std::atomic<uint64_t> _flushes { 0 };
+    std::atomic<uint64_t> _syscalls { 0 };
+    std::atomic<uint64_t> _datagrams { 0 };
+    std::atomic<uint64_t> _gsoDatagrams { 0 };
+    std::atomic<uint64_t> _droppedDatagrams { 0 };
+};
+
+/// @}
+
+} // namespace udt
+
+#endif // overte_DatagramBatchWriter_h
@@ -0,0 +1,304 @@
+//
+//  ForwardErrorCorrection.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ForwardErrorCorrection.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "ControlPacket.h"
+#include "Packet.h"
+
+using namespace udt;
+using namespace std::chrono;
+
+// a peer that stops asking for parity has gone away or lost its request to turn it off
+static const auto REQUEST_TIMEOUT = seconds(5);
+
+// how often the receiver re-evaluates the loss it measures, and re-sends its request while it wants parity
+static const auto UPDATE_INTERVAL = seconds(1);
+
+// too few packets in an interval to say anything about the loss rate
+static const quint32 MIN_PACKETS_PER_UPDATE = 50;
+
+// how far back the receiver keeps packets to rebuild from, a few groups' worth
+static const int RETAINED_SPAN = 4 * fec::MEMBER_MASK_SPAN;
+
+// loss rates at which the receiver asks for parity, and at which it lets it go again
+static const float ENABLE_LOSS_RATE = 0.005f;
+static const float DISABLE_LOSS_RATE = 0.002f;
+
+int fec::groupSizeForLossRate(float lossRate, int currentGroupSize) {
+    if (lossRate < (currentGroupSize > 0 ? DISABLE_LOSS_RATE : ENABLE_LOSS_RATE)) {
+        return 0;
+    }
+
+    // one parity packet repairs one loss per group, so the groups shrink as loss grows to keep two losses in the same
+    // group unlikely - this trades 1/8 of the bandwidth for light loss up to 1/2 for heavy loss
+    if (lossRate < 0.02f) {
+        return 8;
+    } else if (lossRate < 0.05f) {
+        return 4;
+    } else {
+        return 2;
+    }
+}
+
+void FECEncoder::setGroupSize(int groupSize, p_high_resolution_clock::time_point now) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // a group of one would just be a copy of the packet
+    groupSize = groupSize < 2 ? 0 : std::min(groupSize, fec::MAX_GROUP_SIZE);
+
+    _lastRequestTime = now;
+    if (groupSize != _groupSize) {
+        _groupSize = groupSize;
+        resetGroup();
+    }
+}
+
+bool FECEncoder::canProtect(const Packet& packet) {
+    return !packet.isReliable() && !packet.isPartOfMessage() && packet.getObfuscationLevel() == Packet::NoObfuscation
+        && packet.getDataSize() - Packet::localHeaderSize(false) <= fec::MAX_PROTECTED_BODY_SIZE;
+}
+
+std::unique_ptr<ControlPacket> FECEncoder::addPacket(const Packet& packet, p_high_resolution_clock::time_point now) {
+    if (_groupSize == 0 || !canProtect(packet)) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    int groupSize = _groupSize;
+    if (groupSize == 0) {
+        return nullptr;
+    }
+
+    if (now - _lastRequestTime > REQUEST_TIMEOUT) {
+        _groupSize = 0;
+        resetGroup();
+        return nullptr;
+    }
+
+    SequenceNumber sequenceNumber = packet.getSequenceNumber();
+    std::unique_ptr<ControlPacket> parityPacket;
+
+    if (_memberCount > 0) {
+        int offset = seqoff(_firstSequenceNumber, sequenceNumber);
+        if (offset <= 0 || offset >= fec::MEMBER_MASK_SPAN) {
+            // the mask can't name this packet, close the group early
+            if (_memberCount > 1) {
+                parityPacket = createParityPacket();
+            }
+            resetGroup();
+        }
+    }
+
+    if (_memberCount == 0) {
+        _firstSequenceNumber = sequenceNumber;
+    }
+
+    const char* body = packet.getData() + Packet::localHeaderSize(false);
+    int bodySize = (int)packet.getDataSize() - Packet::localHeaderSize(false);
+
+    for (int i = 0; i < bodySize; ++i) {
+        _parity[i] ^= body[i];
+    }
+    _parityLength = std::max(_parityLength, bodySize);
+    _lengthParity ^= (uint16_t)bodySize;
+    _memberMask |= (uint16_t)(1 << seqoff(_firstSequenceNumber, sequenceNumber));
+
+    if (++_memberCount >= groupSize) {
+        parityPacket = createParityPacket();
+        resetGroup();
+    }
+
+    return parityPacket;
+}
+
+std::unique_ptr<ControlPacket> FECEncoder::createParityPacket() {
+    auto parityPacket = ControlPacket::create(ControlPacket::FECParity, fec::PARITY_HEADER_SIZE + _parityLength);
+
+    parityPacket->writePrimitive(_firstSequenceNumber);
+    parityPacket->writePrimitive(_memberMask);
+    parityPacket->writePrimitive(_lengthParity);
+    parityPacket->write(_parity.data(), _parityLength);
+
+    return parityPacket;
+}
+
+void FECEncoder::resetGroup() {
+    std::memset(_parity.data(), 0, _parityLength);
+    _parityLength = 0;
+    _lengthParity = 0;
+    _memberMask = 0;
+    _memberCount = 0;
+}
+
+bool FECDecoder::processReceivedPacket(const Packet& packet, bool wasRecovered) {
+    if (!FECEncoder::canProtect(packet)) {
+        return true;
+    }
+
+    SequenceNumber sequenceNumber = packet.getSequenceNumber();
+
+    if (!wasRecovered) {
+        // only what actually arrived counts towards the loss we ask the peer to cover
+        _lossStats.sequenceNumberReceived((quint16)(SequenceNumber::UType)sequenceNumber);
+
+        auto receivedPacket = _receivedPackets.find(sequenceNumber);
+        if (receivedPacket && receivedPacket->wasRecovered) {
+            return false;
+        }
+    }
+
+    if (_requestedGroupSize == 0) {
+        return true;
+    }
+
+    if (_receivedPackets.empty()) {
+        _lastSequenceNumber = sequenceNumber;
+    }
+
+    int offset = seqoff(_lastSequenceNumber, sequenceNumber);
+    if (offset >= RETAINED_SPAN) {
+        // the peer jumped ahead, nothing we kept can be in the same group as what comes next
+        _receivedPackets.clear();
+        _lastSequenceNumber = sequenceNumber;
+    } else if (offset > 0) {
+        _lastSequenceNumber = sequenceNumber;
+    } else if (offset <= -RETAINED_SPAN) {
+        return true;
+    }
+
+    auto& receivedPacket = _receivedPackets[sequenceNumber];
+    receivedPacket.body = QByteArray(packet.getData() + Packet::localHeaderSize(false),
+                                     (int)packet.getDataSize() - Packet::localHeaderSize(false));
+    receivedPacket.wasRecovered = wasRecovered;
+
+    _receivedPackets.eraseUpTo(_lastSequenceNumber - RETAINED_SPAN);
+
+    return true;
+}
+
+FECDecoder::RecoveredDatagram FECDecoder::recoverPacket(ControlPacket& parityPacket) {
+    RecoveredDatagram recovered;
+
+    if (_requestedGroupSize == 0 || _receivedPackets.empty()
+        || parityPacket.bytesLeftToRead() < fec::PARITY_HEADER_SIZE) {
+        return recovered;
+    }
+
+    SequenceNumber firstSequenceNumber;
+    uint16_t memberMask;
+    uint16_t lengthParity;
+    parityPacket.readPrimitive(&firstSequenceNumber);
+    parityPacket.readPrimitive(&memberMask);
+    parityPacket.readPrimitive(&lengthParity);
+
+    int parityLength = (int)parityPacket.bytesLeftToRead();
+    const char* parity = parityPacket.getPayload() + parityPacket.pos();
+
+    SequenceNumber missingSequenceNumber;
+    int numMissing = 0;
+
+    for (int i = 0; i < fec::MEMBER_MASK_SPAN; ++i) {
+        if (!(memberMask & (1 << i))) {
+            continue;
+        }
+
+        SequenceNumber sequenceNumber = firstSequenceNumber + i;
+        if (seqoff(sequenceNumber, _lastSequenceNumber) >= RETAINED_SPAN) {
+            // we no longer know whether this one arrived
+            return recovered;
+        }
+
+        if (!_receivedPackets.contains(sequenceNumber)) {
+            missingSequenceNumber = sequenceNumber;
+            if (++numMissing > 1) {
+                // one parity packet can't rebuild two
+                return recovered;
+            }
+        }
+    }
+
+    if (numMissing != 1) {
+        return recovered;
+    }
+
+    static const int HEADER_SIZE = Packet::localHeaderSize(false);
+
+    auto data = PacketBufferPool::allocate(HEADER_SIZE + parityLength);
+    char* body = data.get() + HEADER_SIZE;
+    std::memcpy(body, parity, parityLength);
+
+    int length = lengthParity;
+    for (int i = 0; i < fec::MEMBER_MASK_SPAN; ++i) {
+        SequenceNumber sequenceNumber = firstSequenceNumber + i;
+        if (!(memberMask & (1 << i)) || sequenceNumber == missingSequenceNumber) {
+            continue;
+        }
+
+        const QByteArray& member = _receivedPackets.find(sequenceNumber)->body;
+        if (member.size() > parityLength) {
+            // this parity doesn't belong with what we received
+            return recovered;
+        }
+
+        const char* memberData = member.constData();
+        for (int j = 0; j < member.size(); ++j) {
+            body[j] ^= memberData[j];
+        }
+        length ^= member.size();
+    }
+
+    if (length <= 0 || length > parityLength) {
+        return recovered;
+    }
+
+    // protected packets are plain unreliable ones, so their header is just the sequence number
+    uint32_t header = (uint32_t)(SequenceNumber::UType)missingSequenceNumber;
+    std::memcpy(data.get(), &header, sizeof(header));
+
+    recovered.data = std::move(data);
+    recovered.size = HEADER_SIZE + length;
+    return recovered;
+}
+
+bool FECDecoder::updateRequestedGroupSize(p_high_resolution_clock::time_point now) {
+    if (now - _lastUpdateTime < UPDATE_INTERVAL) {
+        return false;
+    }
+    _lastUpdateTime = now;
+
+    auto stats = _lossStats.getStats();
+    if (stats._expectedReceived < _lastUpdateStats._expectedReceived) {
+        // the stats were reset after a jump in sequence numbers, start measuring again
+        _lastUpdateStats = stats;
+        return _requestedGroupSize > 0;
+    }
+
+    auto intervalStats = stats - _lastUpdateStats;
+    if (intervalStats._expectedReceived < MIN_PACKETS_PER_UPDATE) {
+        return _requestedGroupSize > 0;
+    }
+    _lastUpdateStats = stats;
+
+    int groupSize = fec::groupSizeForLossRate(intervalStats.getLostRate(), _requestedGroupSize);
+    bool didChange = groupSize != _requestedGroupSize;
+    _requestedGroupSize = groupSize;
+
+    if (groupSize == 0 && didChange) {
+        _receivedPackets.clear();
+    }
+
+    return didChange || groupSize > 0;
+}
@@ -0,0 +1,137 @@
+//
+//  ForwardErrorCorrection.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#ifndef overte_ForwardErrorCorrection_h
+#define overte_ForwardErrorCorrection_h
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QByteArray>
+
+#include <PortableHighResolutionClock.h>
+
+#include "../SequenceNumberStats.h"
+#include "Constants.h"
+#include "PacketBufferPool.h"
+#include "SequenceNumber.h"
+#include "SequenceNumberRing.h"
+
+namespace udt {
+
+class ControlPacket;
+class Packet;
+
+/// @addtogroup Networking
+/// @{
+
+/// @brief XOR parity for unreliable packets, so that the receiver can rebuild one lost packet per group without a
+/// retransmit.
+/// @details Every few unreliable packets of a protected type the sender follows up with a <code>FECParity</code>
+/// control packet that holds the XOR of the group's packets and of their lengths. The group's members are named by the
+/// first member's sequence number and a mask of the sequence numbers after it, since packets of unprotected types are
+/// interleaved with them.
+/// <p>Parity is only sent to peers that ask for it: a receiver measures the loss of unreliable packets from the peer and
+/// sends a <code>FECRequest</code> with the group size it wants, or 0 to turn parity off. Peers that never ask, like
+/// older clients, never see a parity packet.</p>
+namespace fec {
+    static const int MAX_GROUP_SIZE = 16;
+    static const int MEMBER_MASK_SPAN = 16; // a group's members lie within this many sequence numbers of the first
+
+    // first sequence number, member mask and the XOR of the member lengths
+    static const int PARITY_HEADER_SIZE = sizeof(SequenceNumber) + sizeof(uint16_t) + sizeof(uint16_t);
+
+    // packets too large for their parity to fit in a control packet are left unprotected
+    static const int MAX_PROTECTED_BODY_SIZE = MAX_PACKET_SIZE - (int)sizeof(uint32_t) - PARITY_HEADER_SIZE;
+
+    /// @brief The group size to ask a peer for, given the loss rate measured from it. 0 means no parity.
+    int groupSizeForLossRate(float lossRate, int currentGroupSize);
+}
+
+/// @brief Builds parity packets for the unreliable packets sent to one peer. Thread-safe, since unreliable packets are
+/// written from any thread.
+class FECEncoder {
+public:
+    /// @brief Changes the group size the peer asked for, 0 turns parity off. Drops the group being built.
+    void setGroupSize(int groupSize, p_high_resolution_clock::time_point now);
+    int getGroupSize() const { return _groupSize; }
+
+    /// @brief Whether a packet can be rebuilt from parity: unreliable, not part of a message and small enough.
+    static bool canProtect(const Packet& packet);
+
+    /// @brief Adds an unreliable packet that was just sent to the current group.
+    /// @return The group's parity packet, once the group is complete.
+    std::unique_ptr<ControlPacket> addPacket(const Packet& packet, p_high_resolution_clock::time_point now);
+
+private:
+    std::unique_ptr<ControlPacket> createParityPacket();
+    void resetGroup();
+
+    std::mutex _mutex;
+    std::atomic<int> _groupSize { 0 };
+    p_high_resolution_clock::time_point _lastRequestTime;
+
+    SequenceNumber _firstSequenceNumber;
+    uint16_t _memberMask { 0 };
+    int _memberCount { 0 };
+    uint16_t _lengthParity { 0 };
+    int _parityLength { 0 };
+    std::array<char, MAX_PACKET_SIZE> _parity {};
+};
+
+/// @brief Keeps the recent unreliable packets from one peer so that a lost one can be rebuilt from parity, and
+/// measures their loss to pick the group size to ask the peer for. Used on the Socket thread only.
+class FECDecoder {
+public:
+    struct RecoveredDatagram {
+        PacketBuffer data;
+        int size { 0 };
+    };
+
+    /// @brief Records an unreliable packet from the peer.
+    /// @param wasRecovered Whether the packet was rebuilt by recoverPacket() rather than received.
+    /// @return <code>false</code> if this is the original of a packet that was already recovered, which should be
+    /// dropped.
+    bool processReceivedPacket(const Packet& packet, bool wasRecovered);
+
+    /// @brief Rebuilds the packet missing from a parity packet's group, if exactly one is missing.
+    RecoveredDatagram recoverPacket(ControlPacket& parityPacket);
+
+    /// @brief Re-evaluates the measured loss once per update interval.
+    /// @return <code>true</code> if a request for getRequestedGroupSize() should be sent to the peer: when the group
+    /// size changes, and periodically while parity is wanted so that the peer doesn't time it out.
+    bool updateRequestedGroupSize(p_high_resolution_clock::time_point now);
+    int getRequestedGroupSize() const { return _requestedGroupSize; }
+
+private:
+    struct ReceivedPacket {
+        QByteArray body; // the datagram after its sequence number
+        bool wasRecovered { false };
+    };
+
+    SequenceNumberRing<ReceivedPacket> _receivedPackets;
+    SequenceNumber _lastSequenceNumber;
+
+    SequenceNumberStats _lossStats;
+    PacketStreamStats _lastUpdateStats;
+    p_high_resolution_clock::time_point _lastUpdateTime;
+    int _requestedGroupSize { 0 };
+};
+
+/// @}
+
+} // namespace udt
+
+#endif // overte_ForwardErrorCorrection_h
@@ -222,6 +222,19 @@ qint64 NetworkSocket::readDatagram(char* data, qint64 maxSize, SockAddr* sockAdd
 #endif
 }
 
+#if defined(WEBRTC_DATA_CHANNELS)
+bool NetworkSocket::takeWebRTCDatagram(udt::PacketBuffer& data, int& size, SockAddr& sender) {
+    if (_pendingDatagramSizeSocketType == SocketType::WebRTC) {
+        _pendingDatagramSizeSocketType = SocketType::Unknown;
+    }
+    if (_webrtcSocket.takeDatagram(data, size, sender)) {
+        _lastSocketTypeRead = SocketType::WebRTC;
+        return true;
+    }
+    return false;
+}
+#endif
+
 
 QAbstractSocket::SocketState NetworkSocket::state(SocketType socketType) const {
     switch (socketType) {
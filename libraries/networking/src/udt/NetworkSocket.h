@@ -102,6 +102,15 @@ public:
     /// @return The number of bytes if successfully read, otherwise <code>-1</code>.
     qint64 readDatagram(char* data, qint64 maxSize, SockAddr* sockAddr = nullptr);
 
+#if defined(WEBRTC_DATA_CHANNELS)
+    /// @brief Takes the next WebRTC datagram without copying it.
+    /// @param data The destination to put the datagram's buffer.
+    /// @param size The destination to put the number of bytes in the datagram.
+    /// @param sender The destination to put the source network address.
+    /// @return <code>true</code> if a datagram was taken, <code>false</code> if there was none to read.
+    bool takeWebRTCDatagram(udt::PacketBuffer& data, int& size, SockAddr& sender);
+#endif
+
     
     /// @brief Gets the state of the UDP or WebRTC socket.
     /// @param socketType The type of socket for which to get the state.
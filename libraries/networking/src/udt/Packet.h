@@ -70,7 +70,7 @@ public:
     };
 
     static std::unique_ptr<Packet> create(qint64 size = -1, bool isReliable = false, bool isPartOfMessage = false);
-    static std::unique_ptr<Packet> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr);
+    static std::unique_ptr<Packet> fromReceivedPacket(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr);
     
     // Provided for convenience, try to limit use
     static std::unique_ptr<Packet> createCopy(const Packet& other);
@@ -98,7 +98,7 @@ public:
 
 protected:
     Packet(qint64 size, bool isReliable = false, bool isPartOfMessage = false);
-    Packet(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr);
+    Packet(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr);
     
     Packet(const Packet& other);
     Packet(Packet&& other);
@@ -0,0 +1,151 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "PacketBufferPool.h"
+
+#include <atomic>
+#include <vector>
+
+#include <TBBHelpers.h>
+
+using namespace udt;
+
+#if !defined(UDT_DISABLE_PACKET_BUFFER_POOL)
+
+// enough for a thread to absorb a full receive batch or a mixer frame's worth of packets without touching shared state
+static const size_t MAX_THREAD_CACHED_SLABS = 256;
+
+// about 23MB of idle slabs, anything beyond that goes back to the heap
+static const int64_t MAX_SHARED_SLABS = 16384;
+
+static std::atomic<uint64_t> poolHits { 0 };
+static std::atomic<uint64_t> poolMisses { 0 };
+static std::atomic<uint64_t> poolOversized { 0 };
+static std::atomic<int64_t> poolOutstanding { 0 };
+static std::atomic<int64_t> poolHighWaterMark { 0 };
+static std::atomic<int64_t> sharedSlabCount { 0 };
+
+static tbb::concurrent_queue<char*>& sharedSlabs() {
+    // intentionally leaked, thread caches may still hand slabs back while the process is shutting down
+    static auto queue = new tbb::concurrent_queue<char*>();
+    return *queue;
+}
+
+static void releaseToShared(char* slab) {
+    if (sharedSlabCount.fetch_add(1) < MAX_SHARED_SLABS) {
+        sharedSlabs().push(slab);
+    } else {
+        --sharedSlabCount;
+        delete[] slab;
+    }
+}
+
+// packets can still be freed by other thread_local destructors after a thread's cache is gone
+static thread_local bool isThreadSlabCacheDestroyed { false };
+
+struct ThreadSlabCache {
+    ThreadSlabCache() { slabs.reserve(MAX_THREAD_CACHED_SLABS); }
+    ~ThreadSlabCache() {
+        isThreadSlabCacheDestroyed = true;
+        for (auto slab : slabs) {
+            releaseToShared(slab);
+        }
+    }
+
+    std::vector<char*> slabs;
+};
+
+static thread_local ThreadSlabCache threadSlabCache;
+
+#endif
+
+void PacketBufferDeleter::operator()(char* buffer) const {
+    if (isPooled) {
+        PacketBufferPool::release(buffer);
+    } else {
+        delete[] buffer;
+    }
+}
+
+bool PacketBufferPool::isEnabled() {
+#if !defined(UDT_DISABLE_PACKET_BUFFER_POOL)
+    return true;
+#else
+    return false;
+#endif
+}
+
+PacketBuffer PacketBufferPool::allocate(qint64 size) {
+#if !defined(UDT_DISABLE_PACKET_BUFFER_POOL)
+    if (size > SLAB_SIZE) {
+        ++poolOversized;
+        return PacketBuffer(new char[size]);
+    }
+
+    char* slab = nullptr;
+    if (!isThreadSlabCacheDestroyed && !threadSlabCache.slabs.empty()) {
+        slab = threadSlabCache.slabs.back();
+        threadSlabCache.slabs.pop_back();
+        ++poolHits;
+    } else if (sharedSlabs().try_pop(slab)) {
+        --sharedSlabCount;
+        ++poolHits;
+    } else {
+        slab = new char[SLAB_SIZE];
+        ++poolMisses;
+    }
+
+    auto outstanding = ++poolOutstanding;
+    auto highWaterMark = poolHighWaterMark.load();
+    while (outstanding > highWaterMark && !poolHighWaterMark.compare_exchange_weak(highWaterMark, outstanding)) {
+    }
+
+    return PacketBuffer(slab, PacketBufferDeleter(true));
+#else
+    return PacketBuffer(new char[size]);
+#endif
+}
+
+void PacketBufferPool::release(char* slab) {
+#if !defined(UDT_DISABLE_PACKET_BUFFER_POOL)
+    --poolOutstanding;
+
+    if (!isThreadSlabCacheDestroyed && threadSlabCache.slabs.size() < MAX_THREAD_CACHED_SLABS) {
+        threadSlabCache.slabs.push_back(slab);
+    } else {
+        releaseToShared(slab);
+    }
+#else
+    delete[] slab;
+#endif
+}
+
+PacketBufferPool::Stats PacketBufferPool::getStats() {
+    Stats stats;
+#if !defined(UDT_DISABLE_PACKET_BUFFER_POOL)
+    stats.hits = poolHits;
+    stats.misses = poolMisses;
+    stats.oversized = poolOversized;
+    stats.outstanding = poolOutstanding;
+    stats.highWaterMark = poolHighWaterMark;
+#endif
+    return stats;
+}
+
+QJsonObject PacketBufferPool::Stats::toJson() const {
+    QJsonObject result;
+    result["hits"] = (qint64)hits;
+    result["misses"] = (qint64)misses;
+    result["oversized"] = (qint64)oversized;
+    result["outstanding"] = (qint64)outstanding;
+    result["high_water_mark"] = (qint64)highWaterMark;
+    return result;
+}
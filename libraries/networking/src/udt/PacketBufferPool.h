@@ -0,0 +1,82 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#ifndef overte_PacketBufferPool_h
+#define overte_PacketBufferPool_h
+
+#include <cstdint>
+#include <memory>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QtGlobal>
+
+#include "Constants.h"
+
+namespace udt {
+
+/// @addtogroup Networking
+/// @{
+
+/// @brief Frees a packet buffer, handing MTU-sized slabs back to the PacketBufferPool they came from.
+struct PacketBufferDeleter {
+    PacketBufferDeleter() = default;
+    explicit PacketBufferDeleter(bool isPooled) : isPooled(isPooled) {}
+
+    void operator()(char* buffer) const;
+
+    bool isPooled { false };
+};
+
+/// @brief Owning pointer to packet storage, either a pooled slab or a plain heap allocation.
+using PacketBuffer = std::unique_ptr<char[], PacketBufferDeleter>;
+
+/// @brief Recycles fixed, MTU-sized packet buffers so that creating and receiving packets doesn't hit the allocator.
+/// @details Each thread keeps a small lock-free cache of free slabs. Slabs freed on a thread whose cache is full -
+/// typically a worker thread releasing packets the network thread received - go to a shared concurrent queue that
+/// other threads refill from. Define <code>UDT_DISABLE_PACKET_BUFFER_POOL</code> at build time to allocate every buffer
+/// from the heap instead.
+class PacketBufferPool {
+public:
+    static const int SLAB_SIZE = MAX_PACKET_SIZE;
+
+    struct Stats {
+        uint64_t hits { 0 };          // allocations served from a thread cache or the shared queue
+        uint64_t misses { 0 };        // pool-sized allocations that had to go to the heap
+        uint64_t oversized { 0 };     // allocations larger than a slab, always from the heap
+        int64_t outstanding { 0 };    // slabs currently owned by packets
+        int64_t highWaterMark { 0 };  // most slabs ever owned by packets at once
+
+        QJsonObject toJson() const;
+    };
+
+    /// @brief Returns whether the pool was compiled in.
+    static bool isEnabled();
+
+    /// @brief Allocates a buffer of at least <code>size</code> bytes, from the pool when it fits in a slab.
+    static PacketBuffer allocate(qint64 size);
+
+    /// @brief Takes ownership of a plain heap buffer, which is freed with <code>delete[]</code>.
+    static PacketBuffer adopt(std::unique_ptr<char[]> buffer) { return PacketBuffer(buffer.release()); }
+
+    static Stats getStats();
+
+private:
+    friend struct PacketBufferDeleter;
+    static void release(char* slab);
+};
+
+/// @}
+
+} // namespace udt
+
+#endif // overte_PacketBufferPool_h
@@ -27,7 +27,7 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::DomainConnectRequestPending: // keeping the old version to maintain the protocol hash
             return 17;
         case PacketType::DomainList:
-            return static_cast<PacketVersion>(DomainListVersion::SocketTypes);
+            return static_cast<PacketVersion>(DomainListVersion::ListVersions);
         case PacketType::EntityAdd:
         case PacketType::EntityClone:
         case PacketType::EntityEdit:
@@ -35,7 +35,7 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::EntityPhysics:
             return static_cast<PacketVersion>(EntityVersion::LAST_PACKET_TYPE);
         case PacketType::EntityQuery:
-            return static_cast<PacketVersion>(EntityQueryPacketVersion::ConicalFrustums);
+            return static_cast<PacketVersion>(EntityQueryPacketVersion::ViewPriorityWeights);
         case PacketType::AvatarIdentity:
         case PacketType::AvatarData:
             return static_cast<PacketVersion>(AvatarMixerPacketVersion::ARKitBlendshapes);
@@ -74,10 +74,13 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::DomainConnectRequest:
             return static_cast<PacketVersion>(DomainConnectRequestVersion::SocketTypes);
         case PacketType::DomainListRequest:
-            return static_cast<PacketVersion>(DomainListRequestVersion::SocketTypes);
+            return static_cast<PacketVersion>(DomainListRequestVersion::ListVersions);
+
+        case PacketType::NodeJsonStats:
+            return static_cast<PacketVersion>(NodeJsonStatsVersion::CompactBinaryStats);
 
         case PacketType::DomainServerAddedNode:
-            return static_cast<PacketVersion>(DomainServerAddedNodeVersion::SocketTypes);
+            return static_cast<PacketVersion>(DomainServerAddedNodeVersion::BatchedNodes);
 
         case PacketType::EntityScriptCallMethod:
             return static_cast<PacketVersion>(EntityScriptCallMethodVersion::ClientCallable);
@@ -89,18 +92,22 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::MicrophoneAudioWithEcho:
         case PacketType::AudioStreamStats:
         case PacketType::StopInjector:
-            return static_cast<PacketVersion>(AudioVersion::StopInjectors);
+            return static_cast<PacketVersion>(AudioVersion::UnreliableParity);
         case PacketType::DomainSettings:
             return 18;  // replace min_avatar_scale and max_avatar_scale with min_avatar_height and max_avatar_height
         case PacketType::Ping:
             return static_cast<PacketVersion>(PingVersion::IncludeConnectionID);
         case PacketType::AvatarQuery:
-            return static_cast<PacketVersion>(AvatarQueryVersion::ConicalFrustums);
+            return static_cast<PacketVersion>(AvatarQueryVersion::ClientRateLimits);
         case PacketType::EntityQueryInitialResultsComplete:
             return static_cast<PacketVersion>(EntityVersion::ParticleSpin);
+        case PacketType::OctreeStats:
+            return 23; // scene stats include the compression of the data sections
         case PacketType::BulkAvatarTraitsAck:
-        case PacketType::BulkAvatarTraits:
             return static_cast<PacketVersion>(AvatarMixerPacketVersion::AvatarTraitsAck);
+        case PacketType::SetAvatarTraits:
+        case PacketType::BulkAvatarTraits:
+            return static_cast<PacketVersion>(AvatarMixerPacketVersion::AvatarEntityDeltas);
         default:
             return 22;
     }
@@ -140,6 +140,7 @@ public:
         StopInjector,
         AvatarZonePresence,
         WebRTCSignaling,
+        EntityCompressionDictionary,
         NUM_PACKET_TYPE
     };
 
@@ -307,7 +308,9 @@ enum class EntityQueryPacketVersion: PacketVersion {
     ConnectionIdentifier = 20,
     RemovedJurisdictions = 21,
     MultiFrustumQuery = 22,
-    ConicalFrustums = 23
+    ConicalFrustums = 23,
+    CompressionDictionary = 24,
+    ViewPriorityWeights = 25
 };
 
 enum class AssetServerPacketVersion: PacketVersion {
@@ -355,7 +358,8 @@ enum class AvatarMixerPacketVersion : PacketVersion {
     FBXJointOrderChange,
     HandControllerSection,
     SendVerificationFailed,
-    ARKitBlendshapes
+    ARKitBlendshapes,
+    AvatarEntityDeltas
 };
 
 enum class DomainConnectRequestVersion : PacketVersion {
@@ -374,7 +378,8 @@ enum class DomainConnectRequestVersion : PacketVersion {
 
 enum class DomainListRequestVersion : PacketVersion {
     PreSocketTypes = 22,
-    SocketTypes
+    SocketTypes,
+    ListVersions
 };
 
 enum class DomainConnectionDeniedVersion : PacketVersion {
@@ -386,7 +391,8 @@ enum class DomainConnectionDeniedVersion : PacketVersion {
 enum class DomainServerAddedNodeVersion : PacketVersion {
     PrePermissionsGrid = 17,
     PermissionsGrid,
-    SocketTypes
+    SocketTypes,
+    BatchedNodes
 };
 
 enum class DomainListVersion : PacketVersion {
@@ -397,7 +403,8 @@ enum class DomainListVersion : PacketVersion {
     AuthenticationOptional,
     HasTimestamp,
     HasConnectReason,
-    SocketTypes
+    SocketTypes,
+    ListVersions
 };
 
 enum class AudioVersion : PacketVersion {
@@ -408,7 +415,8 @@ enum class AudioVersion : PacketVersion {
     SpaceBubbleChanges,
     HasPersonalMute,
     HighDynamicRangeVolume,
-    StopInjectors
+    StopInjectors,
+    UnreliableParity // FECParity / FECRequest control packets, older peers can't parse them
 };
 
 enum class MessageDataVersion : PacketVersion {
@@ -423,9 +431,15 @@ enum class PingVersion : PacketVersion {
     IncludeConnectionID = 18
 };
 
+enum class NodeJsonStatsVersion : PacketVersion {
+    BinaryJson = 22,
+    CompactBinaryStats
+};
+
 enum class AvatarQueryVersion : PacketVersion {
     SendMultipleFrustums = 21,
-    ConicalFrustums = 22
+    ConicalFrustums = 22,
+    ClientRateLimits
 };
 
 #endif // hifi_PacketHeaders_h
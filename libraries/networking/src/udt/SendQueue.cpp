@@ -153,9 +153,7 @@ void SendQueue::ack(SequenceNumber ack) {
     {
         // remove any ACKed packets from the map of sent packets
         QWriteLocker locker(&_sentLock);
-        for (auto seq = SequenceNumber { (uint32_t) _lastACKSequenceNumber }; seq <= ack; ++seq) {
-            _sentPackets.erase(seq);
-        }
+        _sentPackets.eraseUpTo(ack);
     }
     
     {   // remove any sequence numbers equal to or lower than this ACK in the loss list
@@ -305,8 +303,8 @@ void SendQueue::run() {
 
         if (_packetSendPeriod > 0) {
             // push the next packet timestamp forwards by the current packet send period
-            auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
-            nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
+            auto nextPacketDelta = std::chrono::nanoseconds((newPacketCount == 2 ? 2 : 1) * _packetSendPeriod);
+            nextPacketTimestamp += nextPacketDelta;
 
             // sleep as long as we need for next packet send, if we can
             auto now = p_high_resolution_clock::now();
@@ -316,11 +314,11 @@ void SendQueue::run() {
             // we use nextPacketTimestamp so that we don't fall behind, not to force long sleeps
             // we'll never allow nextPacketTimestamp to force us to sleep for more than nextPacketDelta
             // so cap it to that value
-            if (timeToSleep > std::chrono::microseconds(nextPacketDelta)) {
+            if (timeToSleep > nextPacketDelta) {
                 // reset the nextPacketTimestamp so that it is correct next time we come around
-                nextPacketTimestamp = now + std::chrono::microseconds(nextPacketDelta);
+                nextPacketTimestamp = now + nextPacketDelta;
 
-                timeToSleep = std::chrono::microseconds(nextPacketDelta);
+                timeToSleep = duration_cast<microseconds>(nextPacketDelta);
             }
 
             // we're seeing SendQueues sleep for a long period of time here,
@@ -331,7 +329,7 @@ void SendQueue::run() {
             if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
                 qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
                 qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
-                qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
+                qWarning() << "PSP:" << getPacketSendPeriod() << "NPD:" << duration_cast<microseconds>(nextPacketDelta).count()
                 << "NPT:" << nextPacketTimestamp.time_since_epoch().count()
                 << "NOW:" << now.time_since_epoch().count();
 
@@ -343,8 +341,8 @@ void SendQueue::run() {
                 // setup a json object with the details we want
                 QJsonObject longSleepObject;
                 longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
-                longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
-                longSleepObject["nextPacketDelta"] = nextPacketDelta;
+                longSleepObject["packetSendPeriod"] = getPacketSendPeriod();
+                longSleepObject["nextPacketDelta"] = qint64(duration_cast<microseconds>(nextPacketDelta).count());
                 longSleepObject["nextPacketTimestamp"] = qint64(nextPacketTimestamp.time_since_epoch().count());
                 longSleepObject["then"] = qint64(now.time_since_epoch().count());
 
@@ -399,11 +397,11 @@ bool SendQueue::maybeResendPacket() {
             QReadLocker sentLocker(&_sentLock);
             
             // see if we can find the packet to re-send
-            auto it = _sentPackets.find(resendNumber);
+            auto found = _sentPackets.find(resendNumber);
 
-            if (it != _sentPackets.end()) {
+            if (found) {
 
-                auto& entry = it->second;
+                auto& entry = *found;
                 // we found the packet - grab it
                 auto& resendPacket = *(entry.second);
                 ++entry.first; // Add 1 resend
@@ -412,7 +410,7 @@ bool SendQueue::maybeResendPacket() {
 
                 auto wireSize = resendPacket.getWireSize();
                 auto payloadSize = resendPacket.getPayloadSize();
-                auto sequenceNumber = it->first;
+                auto sequenceNumber = resendNumber;
 
                 if (level != Packet::NoObfuscation) {
 #ifdef UDT_CONNECTION_DEBUG
@@ -19,7 +19,6 @@
 #include <list>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 
 #include <QtCore/QObject>
 #include <QtCore/QReadWriteLock>
@@ -31,6 +30,7 @@
 #include "Constants.h"
 #include "PacketQueue.h"
 #include "SequenceNumber.h"
+#include "SequenceNumberRing.h"
 #include "LossList.h"
 
 namespace udt {
@@ -65,8 +65,9 @@ public:
     
     void setFlowWindowSize(int flowWindowSize) { _flowWindowSize = flowWindowSize; }
     
-    int getPacketSendPeriod() const { return _packetSendPeriod; }
-    void setPacketSendPeriod(int newPeriod) { _packetSendPeriod = newPeriod; }
+    int getPacketSendPeriod() const { return (int)(_packetSendPeriod / NSECS_PER_USEC); }
+    // kept at nanosecond precision, so that sub-microsecond rounding doesn't throw off pacing at high send rates
+    void setPacketSendPeriod(double newPeriod) { _packetSendPeriod = (int64_t)(newPeriod * NSECS_PER_USEC); }
     
     void setEstimatedTimeout(int estimatedTimeout) { _estimatedTimeout = estimatedTimeout; }
     
@@ -120,7 +121,8 @@ private:
     SequenceNumber _currentSequenceNumber { 0 }; // Last sequence number sent out
     std::atomic<uint32_t> _atomicCurrentSequenceNumber { 0 }; // Atomic for last sequence number sent out
     
-    std::atomic<int> _packetSendPeriod { 0 }; // Interval between two packet send event in microseconds, set from CC
+    static const int64_t NSECS_PER_USEC = 1000;
+    std::atomic<int64_t> _packetSendPeriod { 0 }; // Interval between two packet send event in nanoseconds, set from CC
     std::atomic<State> _state { State::NotStarted };
     
     std::atomic<int> _estimatedTimeout { 0 }; // Estimated timeout, set from CC
@@ -132,7 +134,7 @@ private:
     
     mutable QReadWriteLock _sentLock; // Protects the sent packet list
     using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
-    std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
+    SequenceNumberRing<PacketResendPair> _sentPackets; // Packets waiting for ACK.
     
     std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
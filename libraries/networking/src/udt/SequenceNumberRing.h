@@ -0,0 +1,217 @@
+//
+//  SequenceNumberRing.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#ifndef overte_SequenceNumberRing_h
+#define overte_SequenceNumberRing_h
+
+#include <algorithm>
+#include <vector>
+
+#include "SequenceNumber.h"
+
+namespace udt {
+
+/// @addtogroup Networking
+/// @{
+
+/// @brief Associative container keyed by a window of consecutive sequence numbers, stored in a contiguous ring.
+/// @details A value lives in the slot at its sequence number modulo the ring's capacity, so insertion, lookup and
+/// removal are O(1) and removing everything up to an ACK only touches the slots being removed. The capacity is a power
+/// of two, which divides the sequence number space evenly so the slot index stays consistent across rollover, and
+/// doubles whenever the span between the oldest and newest sequence numbers outgrows it.
+/// <p>Sequence numbers more than half the sequence number space behind the oldest one are treated as newer, the same as
+/// <code>seqoff</code>.</p>
+template <typename T>
+class SequenceNumberRing {
+public:
+    static const int DEFAULT_CAPACITY = 64;
+
+    SequenceNumberRing(int initialCapacity = DEFAULT_CAPACITY) {
+        int capacity = 1;
+        while (capacity < initialCapacity) {
+            capacity <<= 1;
+        }
+        _slots.resize(capacity);
+    }
+
+    bool empty() const { return _size == 0; }
+    int size() const { return _size; }
+    int capacity() const { return (int)_slots.size(); }
+
+    /// @brief The oldest sequence number in the ring. Only meaningful when the ring isn't empty.
+    SequenceNumber getFirstSequenceNumber() const { return _first; }
+
+    /// @brief Returns the value for a sequence number, default constructing it if it isn't in the ring yet.
+    T& operator[](SequenceNumber seq) {
+        if (_size == 0) {
+            _first = seq;
+            _span = 0;
+        }
+
+        Type offset = offsetOf(seq);
+        if (offset < 0) {
+            // older than anything we have, move the front of the window back
+            reserveSpan(_span - offset);
+            _first = seq;
+            _span -= offset;
+        } else if (offset >= _span) {
+            reserveSpan(offset + 1);
+            _span = offset + 1;
+        }
+
+        auto& slot = slotFor(seq);
+        if (!slot.isOccupied) {
+            slot.isOccupied = true;
+            ++_size;
+        }
+        return slot.value;
+    }
+
+    /// @brief Returns the value for a sequence number, or <code>nullptr</code> if it isn't in the ring.
+    T* find(SequenceNumber seq) {
+        if (!contains(seq)) {
+            return nullptr;
+        }
+        return &slotFor(seq).value;
+    }
+
+    const T* find(SequenceNumber seq) const {
+        if (!contains(seq)) {
+            return nullptr;
+        }
+        return &slotFor(seq).value;
+    }
+
+    bool contains(SequenceNumber seq) const {
+        Type offset = offsetOf(seq);
+        return _size > 0 && offset >= 0 && offset < _span && slotFor(seq).isOccupied;
+    }
+
+    /// @brief Removes a sequence number from the ring.
+    /// @return <code>true</code> if it was in the ring.
+    bool erase(SequenceNumber seq) {
+        if (!contains(seq)) {
+            return false;
+        }
+
+        clearSlot(slotFor(seq));
+        trimFront();
+        return true;
+    }
+
+    /// @brief Removes every sequence number from the oldest one up to and including <code>seq</code>.
+    /// @return The number of values removed.
+    int eraseUpTo(SequenceNumber seq) {
+        if (_size == 0) {
+            return 0;
+        }
+
+        Type offset = offsetOf(seq);
+        if (offset < 0) {
+            return 0;
+        }
+
+        int sizeBefore = _size;
+        Type count = std::min(offset + 1, _span);
+        for (Type i = 0; i < count; ++i) {
+            clearSlot(slotFor(_first));
+            ++_first;
+        }
+        _span -= count;
+        trimFront();
+
+        return sizeBefore - _size;
+    }
+
+    void clear() {
+        for (auto& slot : _slots) {
+            if (slot.isOccupied) {
+                clearSlot(slot);
+            }
+        }
+        _span = 0;
+    }
+
+private:
+    using Type = SequenceNumber::Type;
+    using UType = SequenceNumber::UType;
+
+    struct Slot {
+        bool isOccupied { false };
+        T value {};
+    };
+
+    // distance from the oldest sequence number, negative when seq is behind it
+    Type offsetOf(SequenceNumber seq) const {
+        Type offset = (Type)(((UType)seq - (UType)_first) & (UType)SequenceNumber::MAX);
+        return offset > SequenceNumber::THRESHOLD ? offset - (SequenceNumber::MAX + 1) : offset;
+    }
+
+    Slot& slotFor(SequenceNumber seq) { return _slots[(UType)seq & (UType)(_slots.size() - 1)]; }
+    const Slot& slotFor(SequenceNumber seq) const { return _slots[(UType)seq & (UType)(_slots.size() - 1)]; }
+
+    void clearSlot(Slot& slot) {
+        if (slot.isOccupied) {
+            slot.isOccupied = false;
+            slot.value = T {};
+            --_size;
+        }
+    }
+
+    // drop empty slots off the front so that _first is always the oldest value actually in the ring
+    void trimFront() {
+        if (_size == 0) {
+            _span = 0;
+            return;
+        }
+        while (_span > 0 && !slotFor(_first).isOccupied) {
+            ++_first;
+            --_span;
+        }
+    }
+
+    void reserveSpan(Type span) {
+        if (span <= (Type)_slots.size()) {
+            return;
+        }
+
+        size_t capacity = _slots.size();
+        while ((Type)capacity < span) {
+            capacity <<= 1;
+        }
+
+        // each occupied value moves to the slot for its sequence number under the new mask
+        std::vector<Slot> slots(capacity);
+        SequenceNumber seq = _first;
+        for (Type i = 0; i < _span; ++i, ++seq) {
+            auto& slot = slotFor(seq);
+            if (slot.isOccupied) {
+                auto& newSlot = slots[(UType)seq & (UType)(capacity - 1)];
+                newSlot.isOccupied = true;
+                newSlot.value = std::move(slot.value);
+            }
+        }
+        _slots.swap(slots);
+    }
+
+    std::vector<Slot> _slots;
+    SequenceNumber _first;
+    Type _span { 0 };  // number of slots from _first to the newest sequence number, inclusive
+    int _size { 0 };
+};
+
+/// @}
+
+} // namespace udt
+
+#endif // overte_SequenceNumberRing_h
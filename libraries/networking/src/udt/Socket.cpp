@@ -16,6 +16,9 @@
 #include <sys/socket.h>
 #endif
 
+#include <algorithm>
+
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 
 #include <shared/QtHelpers.h>
@@ -32,6 +35,20 @@
 
 using namespace udt;
 
+// batched receive is on by default where supported, GRO is opt-in since it needs much larger receive slots
+static const QString UDT_DISABLE_BATCHED_RECEIVE_ENV = "HIFI_UDT_DISABLE_BATCHED_RECEIVE";
+static const QString UDT_RECEIVE_GRO_ENV = "HIFI_UDT_RECEIVE_GRO";
+
+// batched send is only used once the owner opts in with setSendBatchingEnabled, these let operators override that
+static const QString UDT_DISABLE_BATCHED_SEND_ENV = "HIFI_UDT_DISABLE_BATCHED_SEND";
+static const QString UDT_SEND_GSO_ENV = "HIFI_UDT_SEND_GSO";
+
+// picks the default congestion control by name, e.g. "bbr", ahead of anything the owner sets from its settings
+static const QString UDT_CONGESTION_CONTROL_ENV = "HIFI_UDT_CONGESTION_CONTROL";
+
+// keeps this socket from sending or asking for parity, whatever the owner sets up with the forward error correction calls
+static const QString UDT_DISABLE_FEC_ENV = "HIFI_UDT_DISABLE_FEC";
+
 #ifdef WIN32
 #include <winsock2.h>
 #include <WS2tcpip.h>
@@ -44,8 +61,28 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     QObject(parent),
     _networkSocket(parent),
     _readyReadBackupTimer(new QTimer(this)),
-    _shouldChangeSocketOptions(shouldChangeSocketOptions)
+    _shouldChangeSocketOptions(shouldChangeSocketOptions),
+    _batchReader(DatagramBatchReader::DEFAULT_BATCH_SIZE,
+                 QProcessEnvironment::systemEnvironment().contains(UDT_RECEIVE_GRO_ENV)),
+    _batchWriter(QProcessEnvironment::systemEnvironment().contains(UDT_SEND_GSO_ENV))
 {
+    _batchedReceiveEnabled = DatagramBatchReader::isSupported() &&
+        !QProcessEnvironment::systemEnvironment().contains(UDT_DISABLE_BATCHED_RECEIVE_ENV);
+
+    auto congestionControlName = QProcessEnvironment::systemEnvironment().value(UDT_CONGESTION_CONTROL_ENV);
+    if (!congestionControlName.isEmpty()) {
+        auto ccFactory = createCongestionControlFactory(congestionControlName);
+        if (ccFactory) {
+            qCDebug(networking) << "Using" << congestionControlName << "congestion control from"
+                << UDT_CONGESTION_CONTROL_ENV;
+            _ccFactory.swap(ccFactory);
+            _isCCFactoryFromEnvironment = true;
+        } else {
+            qCWarning(networking) << "Unknown congestion control" << congestionControlName << "in"
+                << UDT_CONGESTION_CONTROL_ENV << "- expected one of" << getCongestionControlNames();
+        }
+    }
+
     connect(&_networkSocket, &NetworkSocket::readyRead, this, &Socket::readPendingDatagrams);
 
     // make sure we hear about errors and state changes from the underlying socket
@@ -61,6 +98,13 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
 void Socket::bind(SocketType socketType, const QHostAddress& address, quint16 port) {
     _networkSocket.bind(socketType, address, port);
 
+    if (socketType == SocketType::UDP && _batchedReceiveEnabled) {
+        _batchReader.attach(_networkSocket.socketDescriptor(socketType));
+    }
+    if (socketType == SocketType::UDP && DatagramBatchWriter::isSupported()) {
+        _batchWriter.attach(_networkSocket.socketDescriptor(socketType));
+    }
+
     if (_shouldChangeSocketOptions) {
         setSystemBufferSizes(socketType);
         if (socketType == SocketType::WebRTC) {
@@ -87,6 +131,11 @@ void Socket::rebind(SocketType socketType) {
 }
 
 void Socket::rebind(SocketType socketType, quint16 localPort) {
+    if (socketType == SocketType::UDP) {
+        _batchReader.detach();
+        _batchWriter.flush();
+        _batchWriter.detach();
+    }
     _networkSocket.abort(socketType);
     bind(socketType, QHostAddress::AnyIPv4, localPort);
 }
@@ -143,6 +192,22 @@ qint64 Socket::writeBasePacket(const udt::BasePacket& packet, const SockAddr &so
     return writeDatagram(packet.getData(), packet.getDataSize(), sockAddr);
 }
 
+// pings and domain / ICE traffic measure or negotiate the link, so they never wait for a send batch flush
+static bool isBatchablePacketType(PacketType packetType) {
+    static const std::bitset<256> UNBATCHED_PACKET_TYPES = [] {
+        std::bitset<256> packetTypes;
+        for (auto nonSourcedType : PacketTypeEnum::getNonSourcedPackets()) {
+            packetTypes.set((uint8_t)nonSourcedType);
+        }
+        packetTypes.set((uint8_t)PacketType::Ping);
+        packetTypes.set((uint8_t)PacketType::PingReply);
+        packetTypes.set((uint8_t)PacketType::DomainListRequest);
+        packetTypes.set((uint8_t)PacketType::DomainDisconnectRequest);
+        return packetTypes;
+    }();
+    return !UNBATCHED_PACKET_TYPES.test((uint8_t)packetType);
+}
+
 qint64 Socket::writePacket(const Packet& packet, const SockAddr& sockAddr) {
     Q_ASSERT_X(!packet.isReliable(), "Socket::writePacket", "Cannot send a reliable packet unreliably");
 
@@ -161,7 +226,22 @@ qint64 Socket::writePacket(const Packet& packet, const SockAddr& sockAddr) {
     // write the correct sequence number to the Packet here
     packet.writeSequenceNumber(sequenceNumber);
 
-    return writeDatagram(packet.getData(), packet.getDataSize(), sockAddr);
+    qint64 bytesWritten;
+    if (isBatchablePacketType(NLPacket::typeInHeader(packet))) {
+        bytesWritten = writeBatchableDatagram(packet.getData(), packet.getDataSize(), sockAddr);
+    } else {
+        bytesWritten = writeDatagram(packet.getData(), packet.getDataSize(), sockAddr);
+    }
+
+    if (connection && _fecPacketTypes.test((uint8_t)NLPacket::typeInHeader(packet))) {
+        // the parity goes out after the packet that completes its group
+        auto parityPacket = connection->protectUnreliablePacket(packet);
+        if (parityPacket) {
+            writeBasePacket(*parityPacket, sockAddr);
+        }
+    }
+
+    return bytesWritten;
 }
 
 qint64 Socket::writePacket(std::unique_ptr<Packet> packet, const SockAddr& sockAddr) {
@@ -244,6 +324,16 @@ qint64 Socket::writeDatagram(const char* data, qint64 size, const SockAddr& sock
     return writeDatagram(QByteArray::fromRawData(data, size), sockAddr);
 }
 
+qint64 Socket::writeBatchableDatagram(const char* data, qint64 size, const SockAddr& sockAddr) {
+    if (_sendBatchingEnabled && sockAddr.getType() == SocketType::UDP
+        && _batchWriter.queueDatagram(data, size, sockAddr)) {
+        // the datagram goes out with the next flushSendBatch(), send errors are only reported in the batch stats
+        return size;
+    }
+
+    return writeDatagram(data, size, sockAddr);
+}
+
 qint64 Socket::writeDatagram(const QByteArray& datagram, const SockAddr& sockAddr) {
     auto socketType = sockAddr.getType();
 
@@ -297,7 +387,9 @@ Connection* Socket::findOrCreateConnection(const SockAddr& sockAddr, bool filter
 #endif // UDT_CONNECTION_DEBUG
             return nullptr;
         } else {
-            auto congestionControl = _ccFactory->create();
+            auto ccFactoryIt = _destinationCCFactories.find(sockAddr);
+            auto congestionControl = ccFactoryIt != _destinationCCFactories.end() ? ccFactoryIt->second->create()
+                                                                                  : _ccFactory->create();
             congestionControl->setMaxBandwidth(_maxBandwidth);
             auto connection = std::unique_ptr<Connection>(new Connection(this, sockAddr, std::move(congestionControl)));
             if (QThread::currentThread() != thread()) {
@@ -383,6 +475,10 @@ void Socket::readPendingDatagrams() {
     const auto abortTime = system_clock::now() + MAX_PROCESS_TIME;
     int packetSizeWithHeader = -1;
 
+#if defined(WEBRTC_DATA_CHANNELS)
+    readPendingWebRTCDatagrams(abortTime);
+#endif
+
     while (_networkSocket.hasPendingDatagrams() &&
            (packetSizeWithHeader = _networkSocket.pendingDatagramSize()) != -1) {
         if (system_clock::now() > abortTime) {
@@ -392,6 +488,10 @@ void Socket::readPendingDatagrams() {
             int nodeListQueueSize = ::hifi::qt::getEventQueueSize(thread());
             qCDebug(networking) << "Overran timebox by" << duration_cast<milliseconds>(system_clock::now() - abortTime).count()
                 << "ms; NodeList thread event queue size =" << nodeListQueueSize;
+#endif
+#if defined(WEBRTC_DATA_CHANNELS)
+            // WebRTC data channels signal readyRead once per batch of messages, so come back for the rest of it.
+            QTimer::singleShot(0, this, &Socket::readPendingDatagrams);
 #endif
             break;
         }
@@ -406,7 +506,10 @@ void Socket::readPendingDatagrams() {
         SockAddr senderSockAddr;
 
         // setup a buffer to read the packet into
-        auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+        auto buffer = PacketBufferPool::allocate(packetSizeWithHeader);
+
+        // with GRO on, QUdpSocket may hand over several coalesced datagrams at once, to be split by their segment size
+        int segmentSize = _batchReader.isGROEnabled() ? _batchReader.peekSegmentSize() : 0;
 
         // pull the datagram
         auto sizeRead = _networkSocket.readDatagram(buffer.get(), packetSizeWithHeader, &senderSockAddr);
@@ -421,76 +524,221 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
-
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this SockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
+        if (senderSockAddr.getType() == SocketType::UDP && segmentSize > 0 && segmentSize < sizeRead) {
+            for (int offset = 0; offset < sizeRead; offset += segmentSize) {
+                int size = std::min(segmentSize, (int)sizeRead - offset);
+                auto segment = PacketBufferPool::allocate(size);
+                memcpy(segment.get(), buffer.get() + offset, size);
+                processDatagram(std::move(segment), size, senderSockAddr, receiveTime);
             }
+        } else {
+            processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+        }
 
-            continue;
+        // The datagram above went through QUdpSocket, which re-armed its read notifier. Whatever else is queued on the
+        // UDP socket can now be drained in batches without Qt losing track of the socket's readability.
+        if (senderSockAddr.getType() == SocketType::UDP && _batchReader.isAttached()) {
+            readPendingDatagramBatches(abortTime);
         }
+    }
+}
+
+#if defined(WEBRTC_DATA_CHANNELS)
+void Socket::readPendingWebRTCDatagrams(std::chrono::system_clock::time_point abortTime) {
+    // The data channels hand over their pooled buffers, so these datagrams aren't copied again on the way in.
+    PacketBuffer buffer;
+    int size = 0;
+    SockAddr senderSockAddr;
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+    while (_networkSocket.takeWebRTCDatagram(buffer, size, senderSockAddr)) {
+        _readyReadBackupTimer->start();
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+        _lastPacketSizeRead = size;
+        _lastPacketSockAddr = senderSockAddr;
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr, true);
+        processDatagram(std::move(buffer), size, senderSockAddr, p_high_resolution_clock::now());
 
+        if (std::chrono::system_clock::now() > abortTime) {
+            // readPendingDatagrams() reschedules itself for the rest
+            break;
+        }
+    }
+}
+#endif
+
+void Socket::readPendingDatagramBatches(std::chrono::system_clock::time_point abortTime) {
+    std::vector<std::pair<Connection*, int>> batchConnections;
+
+    while (std::chrono::system_clock::now() <= abortTime && _batchReader.receiveBatch() > 0) {
+        _readyReadBackupTimer->start();
+
+        auto receiveTime = p_high_resolution_clock::now();
+        batchConnections.clear();
+
+        while (_batchReader.hasPendingDatagrams()) {
+            auto datagram = _batchReader.takeDatagram();
+
+            _lastPacketSizeRead = datagram.size;
+            _lastPacketSockAddr = datagram.sender;
+
+            auto connection = processDatagram(std::move(datagram.data), datagram.size, datagram.sender, receiveTime);
             if (connection) {
-                connection->processControl(move(controlPacket));
+                auto it = std::find_if(batchConnections.begin(), batchConnections.end(),
+                                       [connection](const std::pair<Connection*, int>& entry) {
+                                           return entry.first == connection;
+                                       });
+                if (it != batchConnections.end()) {
+                    ++it->second;
+                } else {
+                    batchConnections.emplace_back(connection, 1);
+                }
             }
+        }
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
+        for (const auto& entry : batchConnections) {
+            entry.first->recordReceiveBatch(entry.second);
+        }
+
+        if (!_batchReader.wasLastBatchFull()) {
+            // a short batch means the socket receive queue is empty, skip the extra syscall
+            break;
+        }
+    }
+}
 
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
+Connection* Socket::processDatagram(PacketBuffer buffer, int packetSizeWithHeader,
+                                    const SockAddr& senderSockAddr, p_high_resolution_clock::time_point receiveTime,
+                                    bool wasRecovered) {
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this SockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
+        }
 
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                auto connection = findOrCreateConnection(senderSockAddr, true);
+        return nullptr;
+    }
 
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
 
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
-#ifdef UDT_CONNECTION_DEBUG
-                        qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
-                            << ", type" << NLPacket::typeInHeader(*packet);
-#endif
-                        continue;
-                    }
-                } else if (connection) {
-                    connection->recordReceivedUnreliablePackets(packet->getWireSize(),
-                                                                packet->getPayloadSize());
-                }
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
+
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr, true);
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr, true);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
+        if (connection && controlPacket->getType() == ControlPacket::FECParity) {
+            if (_fecRequestsEnabled) {
+                // a packet rebuilt from parity goes through the same checks as one that arrived
+                auto recovered = connection->recoverUnreliablePacket(*controlPacket);
+                if (recovered.data) {
+                    processDatagram(std::move(recovered.data), recovered.size, senderSockAddr, receiveTime, true);
                 }
             }
+        } else if (connection) {
+            connection->processControl(move(controlPacket));
         }
+
+        return connection;
+    }
+
+    // setup a Packet from the data we just read
+    auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+    packet->setReceiveTime(receiveTime);
+
+    // save the sequence number in case this is the packet that sticks readyRead
+    _lastReceivedSequenceNumber = packet->getSequenceNumber();
+
+    // call our verification operator to see if this packet is verified
+    if (_packetFilterOperator && !_packetFilterOperator(*packet)) {
+        return nullptr;
+    }
+
+    auto connection = findOrCreateConnection(senderSockAddr, true);
+
+    if (packet->isReliable()) {
+        // if this was a reliable packet then signal the matching connection with the sequence number
+
+        if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                      packet->getDataSize(),
+                                                                      packet->getPayloadSize())) {
+            // the connection could not be created or indicated that we should not continue processing this packet
+#ifdef UDT_CONNECTION_DEBUG
+            qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
+                << ", type" << NLPacket::typeInHeader(*packet);
+#endif
+            return connection;
+        }
+    } else if (connection) {
+        if (!wasRecovered) {
+            connection->recordReceivedUnreliablePackets(packet->getWireSize(),
+                                                        packet->getPayloadSize());
+        }
+
+        if (_fecRequestsEnabled && !connection->processReceivedUnreliablePacket(*packet, wasRecovered)) {
+            // this packet was already rebuilt from parity and handled then
+            return connection;
+        }
+    }
+
+    if (packet->isPartOfMessage()) {
+        if (connection) {
+            connection->queueReceivedMessagePacket(std::move(packet));
+        }
+    } else if (_packetHandler) {
+        // call the verified packet callback to let it handle this packet
+        _packetHandler(std::move(packet));
+    }
+
+    return connection;
+}
+
+void Socket::setForwardErrorCorrectionTypes(const QSet<PacketType>& packetTypes) {
+    if (!packetTypes.isEmpty() && QProcessEnvironment::systemEnvironment().contains(UDT_DISABLE_FEC_ENV)) {
+        return;
+    }
+
+    _fecPacketTypes.reset();
+    for (auto packetType : packetTypes) {
+        _fecPacketTypes.set((uint8_t)packetType);
+    }
+}
+
+void Socket::setForwardErrorCorrectionRequestsEnabled(bool enabled) {
+    if (enabled && QProcessEnvironment::systemEnvironment().contains(UDT_DISABLE_FEC_ENV)) {
+        return;
     }
+
+    _fecRequestsEnabled = enabled;
+}
+
+void Socket::setSendBatchingEnabled(bool enabled) {
+    if (enabled && QProcessEnvironment::systemEnvironment().contains(UDT_DISABLE_BATCHED_SEND_ENV)) {
+        return;
+    }
+
+    if (enabled && !DatagramBatchWriter::isSupported()) {
+        qCDebug(networking) << "Batched send is not supported on this platform, datagrams will be written directly";
+        return;
+    }
+
+    bool wasEnabled = _sendBatchingEnabled.exchange(enabled);
+    if (wasEnabled && !enabled) {
+        _batchWriter.flush();
+    }
+}
+
+int Socket::flushSendBatch() {
+    if (!_sendBatchingEnabled) {
+        return 0;
+    }
+    return _batchWriter.flush();
 }
 
 void Socket::connectToSendSignal(const SockAddr& destinationAddr, QObject* receiver, const char* slot) {
@@ -502,10 +750,25 @@ void Socket::connectToSendSignal(const SockAddr& destinationAddr, QObject* recei
 }
 
 void Socket::setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory) {
+    if (_isCCFactoryFromEnvironment) {
+        qCDebug(networking) << "Keeping congestion control from" << UDT_CONGESTION_CONTROL_ENV;
+        return;
+    }
+
     // swap the current unique_ptr for the new factory
     _ccFactory.swap(ccFactory);
 }
 
+void Socket::setCongestionControlFactory(const SockAddr& destination,
+                                         std::unique_ptr<CongestionControlVirtualFactory> ccFactory) {
+    Lock connectionsLock(_connectionsHashMutex);
+    if (ccFactory) {
+        _destinationCCFactories[destination] = std::move(ccFactory);
+    } else {
+        _destinationCCFactories.erase(destination);
+    }
+}
+
 
 void Socket::setConnectionMaxBandwidth(int maxBandwidth) {
     qInfo() << "Setting socket's maximum bandwith to" << maxBandwidth << "bps. ("
@@ -15,18 +15,25 @@
 #ifndef hifi_Socket_h
 #define hifi_Socket_h
 
+#include <atomic>
+#include <bitset>
+#include <chrono>
 #include <functional>
 #include <unordered_map>
 #include <mutex>
 #include <list>
 
 #include <QtCore/QObject>
+#include <QtCore/QSet>
 #include <QtCore/QTimer>
 
 #include "../SockAddr.h"
 #include "TCPVegasCC.h"
 #include "Connection.h"
+#include "DatagramBatchReader.h"
+#include "DatagramBatchWriter.h"
 #include "NetworkSocket.h"
+#include "PacketHeaders.h"
 
 //#define UDT_CONNECTION_DEBUG
 
@@ -83,6 +90,9 @@ public:
         { _unfilteredHandlers[senderSockAddr] = handler; }
     
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
+    // overrides the congestion control for connections to one destination, pass nullptr to go back to the default
+    // only affects connections created after the call
+    void setCongestionControlFactory(const SockAddr& destination, std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
     void setConnectionMaxBandwidth(int maxBandwidth);
 
     void messageReceived(std::unique_ptr<Packet> packet);
@@ -90,6 +100,25 @@ public:
     
     StatsVector sampleStatsForAllConnections();
 
+    /// @brief Makes unreliable UDP data packets from any thread collect into a batch rather than being written straight
+    /// away. The owner must then call flushSendBatch() regularly, typically once per mixer frame. Control packets,
+    /// reliable packets, pings and domain traffic are always written directly. Disabling flushes the pending batch.
+    void setSendBatchingEnabled(bool enabled);
+    bool isSendBatchingEnabled() const { return _sendBatchingEnabled; }
+
+    /// @brief Writes out every datagram collected since the last flush. Thread-safe.
+    /// @return The number of datagrams written.
+    int flushSendBatch();
+    DatagramBatchWriter::Stats sampleSendBatchStats() { return _batchWriter.sampleStats(); }
+
+    /// @brief Follows every few unreliable packets of these types with a parity packet, for each peer that asks for
+    /// parity, so that the peer can rebuild a lost one without a retransmit. Call before sending packets.
+    void setForwardErrorCorrectionTypes(const QSet<PacketType>& packetTypes);
+
+    /// @brief Measures the loss of unreliable packets from each peer and asks the peer for parity when the loss is
+    /// high enough for it to help.
+    void setForwardErrorCorrectionRequestsEnabled(bool enabled);
+
 #if defined(WEBRTC_DATA_CHANNELS)
     const WebRTCSocket* getWebRTCSocket();
 #endif
@@ -115,7 +144,15 @@ private slots:
 
 private:
     void setSystemBufferSizes(SocketType socketType);
+    void readPendingDatagramBatches(std::chrono::system_clock::time_point abortTime);
+#if defined(WEBRTC_DATA_CHANNELS)
+    void readPendingWebRTCDatagrams(std::chrono::system_clock::time_point abortTime);
+#endif
+    Connection* processDatagram(PacketBuffer buffer, int packetSizeWithHeader,
+                                const SockAddr& senderSockAddr, p_high_resolution_clock::time_point receiveTime,
+                                bool wasRecovered = false);
     Connection* findOrCreateConnection(const SockAddr& sockAddr, bool filterCreation = false);
+    qint64 writeBatchableDatagram(const char* data, qint64 size, const SockAddr& sockAddr);
    
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
     ConnectionStats::Stats sampleStatsForConnection(const SockAddr& destination);
@@ -145,9 +182,20 @@ private:
     int _maxBandwidth { -1 };
 
     std::unique_ptr<CongestionControlVirtualFactory> _ccFactory { new CongestionControlFactory<TCPVegasCC>() };
+    bool _isCCFactoryFromEnvironment { false };
+    std::unordered_map<SockAddr, std::unique_ptr<CongestionControlVirtualFactory>> _destinationCCFactories;
 
     bool _shouldChangeSocketOptions { true };
 
+    DatagramBatchReader _batchReader;
+    bool _batchedReceiveEnabled { false };
+
+    DatagramBatchWriter _batchWriter;
+    std::atomic<bool> _sendBatchingEnabled { false };
+
+    std::bitset<256> _fecPacketTypes; // unreliable packet types followed by parity
+    std::atomic<bool> _fecRequestsEnabled { false };
+
     int _lastPacketSizeRead { 0 };
     SequenceNumber _lastReceivedSequenceNumber;
     SockAddr _lastPacketSockAddr;
@@ -164,15 +164,16 @@ void WDCPeerConnectionObserver::OnConnectionChange(PeerConnectionInterface::Peer
 }
 
 
-WDCDataChannelObserver::WDCDataChannelObserver(WDCConnection* parent) :
-    _parent(parent)
+WDCDataChannelObserver::WDCDataChannelObserver(WDCConnection* parent, bool isUnordered) :
+    _parent(parent),
+    _isUnordered(isUnordered)
 { }
 
 void WDCDataChannelObserver::OnStateChange() {
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "WDCDataChannelObserver::OnStateChange()";
 #endif
-    _parent->onDataChannelStateChanged();
+    _parent->onDataChannelStateChanged(_isUnordered);
 }
 
 void WDCDataChannelObserver::OnMessage(const DataBuffer& buffer) {
@@ -182,6 +183,10 @@ void WDCDataChannelObserver::OnMessage(const DataBuffer& buffer) {
     _parent->onDataChannelMessageReceived(buffer);
 }
 
+void WDCDataChannelObserver::OnBufferedAmountChange(uint64_t sentDataSize) {
+    _parent->onBufferedAmountChanged();
+}
+
 
 WDCConnection::WDCConnection(WebRTCDataChannels* parent, const QString& dataChannelID) :
     _parent(parent),
@@ -191,6 +196,14 @@ WDCConnection::WDCConnection(WebRTCDataChannels* parent, const QString& dataChan
     qCDebug(networking_webrtc) << "WDCConnection::WDCConnection() :" << dataChannelID;
 #endif
 
+    // The ID is validated by WebRTCDataChannels::onSignalingMessage().
+    auto addressParts = dataChannelID.split(":");
+    if (addressParts.length() == 2) {
+        _address = SockAddr(SocketType::WebRTC, QHostAddress(addressParts[0]), addressParts[1].toInt());
+    } else {
+        qCWarning(networking_webrtc) << "Invalid dataChannelID:" << dataChannelID;
+    }
+
     // Create observers.
     _setSessionDescriptionObserver = new rtc::RefCountedObject<WDCSetSessionDescriptionObserver>();
     _createSessionDescriptionObserver = new rtc::RefCountedObject<WDCCreateSessionDescriptionObserver>(this);
@@ -339,6 +352,18 @@ void WDCConnection::onDataChannelOpened(rtc::scoped_refptr<DataChannelInterface>
         << dataChannel->maxRetransmitsOpt().value_or(-1);
 #endif
 
+    bool isUnordered = !dataChannel->ordered() || dataChannel->maxRetransmitsOpt().has_value()
+        || dataChannel->maxPacketLifeTime().has_value();
+    if (_dataChannel && isUnordered && !_unorderedDataChannel) {
+#ifdef WEBRTC_DEBUG
+        qCDebug(networking_webrtc) << "WDCConnection::onDataChannelOpened() : unordered channel for:" << _dataChannelID;
+#endif
+        _unorderedDataChannel = dataChannel;
+        _unorderedDataChannelObserver = std::make_shared<WDCDataChannelObserver>(this, true);
+        _unorderedDataChannel->RegisterObserver(_unorderedDataChannelObserver.get());
+        return;
+    }
+
     _dataChannel = dataChannel;
     _dataChannel->RegisterObserver(_dataChannelObserver.get());
 
@@ -348,7 +373,16 @@ void WDCConnection::onDataChannelOpened(rtc::scoped_refptr<DataChannelInterface>
     _parent->onDataChannelOpened(this, _dataChannelID);
 }
 
-void WDCConnection::onDataChannelStateChanged() {
+void WDCConnection::onDataChannelStateChanged(bool isUnordered) {
+    if (isUnordered) {
+        // Messages fall back to the main data channel.
+        if (_unorderedDataChannel->state() == DataChannelInterface::kClosed) {
+            _unorderedDataChannel->UnregisterObserver();
+            _unorderedDataChannelObserver = nullptr;
+        }
+        return;
+    }
+
     auto state = _dataChannel->state();
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "WDCConnection::onDataChannelStateChanged() :" << (int)state
@@ -370,53 +404,58 @@ void WDCConnection::onDataChannelMessageReceived(const DataBuffer& buffer) {
     qCDebug(networking_webrtc) << "WDCConnection::onDataChannelMessageReceived()";
 #endif
 
-    auto byteArray = QByteArray(buffer.data.data<char>(), (int)buffer.data.size());
+    auto data = buffer.data.data<char>();
+    auto size = (int)buffer.data.size();
 
     // Echo message back to sender.
-    if (byteArray.startsWith("echo:")) {
+    const char ECHO_PREFIX[] = "echo:";
+    const int ECHO_PREFIX_LENGTH = sizeof(ECHO_PREFIX) - 1;
+    if (size >= ECHO_PREFIX_LENGTH && memcmp(data, ECHO_PREFIX, ECHO_PREFIX_LENGTH) == 0) {
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "Echo message back";
 #endif
-        auto addressParts = _dataChannelID.split(":");
-        if (addressParts.length() != 2) {
-            qCWarning(networking_webrtc) << "Invalid dataChannelID:" << _dataChannelID;
-            return;
-        }
-        auto address = SockAddr(SocketType::WebRTC, QHostAddress(addressParts[0]), addressParts[1].toInt());
-        _parent->sendDataMessage(address, byteArray);  // Use parent method to exercise the code stack.
+        _parent->sendDataMessage(_address, QByteArray(data, size));  // Use parent method to exercise the code stack.
         return;
     }
 
-    _parent->emitDataMessage(_dataChannelID, byteArray);
+    _parent->queueDataMessage(_address, data, size);
 }
 
-qint64 WDCConnection::getBufferedAmount() const {
-#ifdef WEBRTC_DEBUG
-    qCDebug(networking_webrtc) << "WDCConnection::getBufferedAmount()";
-#endif
-    return _dataChannel && _dataChannel->state() != DataChannelInterface::kClosing
-            && _dataChannel->state() != DataChannelInterface::kClosed
-        ? _dataChannel->buffered_amount() : 0;
+static bool isDataChannelOpen(const rtc::scoped_refptr<DataChannelInterface>& dataChannel) {
+    return dataChannel && dataChannel->state() != DataChannelInterface::kClosing
+        && dataChannel->state() != DataChannelInterface::kClosed;
+}
+
+void WDCConnection::onBufferedAmountChanged() {
+    qint64 bufferedAmount = 0;
+    if (isDataChannelOpen(_dataChannel)) {
+        bufferedAmount += _dataChannel->buffered_amount();
+    }
+    if (isDataChannelOpen(_unorderedDataChannel)) {
+        bufferedAmount += _unorderedDataChannel->buffered_amount();
+    }
+    _bufferedAmount = bufferedAmount;
 }
 
-bool WDCConnection::sendDataMessage(const DataBuffer& buffer) {
+bool WDCConnection::sendDataMessage(const DataBuffer& buffer, bool isUnordered) {
+    auto& dataChannel = isUnordered && isDataChannelOpen(_unorderedDataChannel) ? _unorderedDataChannel : _dataChannel;
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "WDCConnection::sendDataMessage()";
-    if (!_dataChannel || _dataChannel->state() == DataChannelInterface::kClosing
-        || _dataChannel->state() == DataChannelInterface::kClosed) {
+    if (!isDataChannelOpen(dataChannel)) {
         qCDebug(networking_webrtc) << "No data channel to send on";
     }
 #endif
-    if (!_dataChannel || _dataChannel->state() == DataChannelInterface::kClosing
-            || _dataChannel->state() == DataChannelInterface::kClosed) {
+    if (!isDataChannelOpen(dataChannel)) {
         // Data channel may have been closed while message to send was being prepared.
         return false;
-    } else if (_dataChannel->buffered_amount() + buffer.size() > MAX_WEBRTC_BUFFER_SIZE) {
+    } else if (dataChannel->buffered_amount() + buffer.size() > MAX_WEBRTC_BUFFER_SIZE) {
         // Don't send, otherwise the data channel will be closed.
         qCDebug(networking_webrtc) << "WebRTC send buffer overflow";
         return false;
     }
-    return _dataChannel->Send(buffer);
+    bool isSent = dataChannel->Send(buffer);
+    onBufferedAmountChanged();
+    return isSent;
 }
 
 void WDCConnection::closePeerConnection() {
@@ -482,18 +521,23 @@ void WebRTCDataChannels::reset() {
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "WebRTCDataChannels::reset() :" << _connectionsByID.count();
 #endif
-    QHashIterator<QString, WDCConnection*> i(_connectionsByID);
+    QHash<QString, WDCConnection*> connectionsByID;
+    {
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+        connectionsByID.swap(_connectionsByID);
+    }
+    QHashIterator<QString, WDCConnection*> i(connectionsByID);
     while (i.hasNext()) {
         i.next();
         delete i.value();
     }
-    _connectionsByID.clear();
 }
 
 void WebRTCDataChannels::onDataChannelOpened(WDCConnection* connection, const QString& dataChannelID) {
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "WebRTCDataChannels::onDataChannelOpened() :" << dataChannelID;
 #endif
+    std::lock_guard<std::mutex> lock(_connectionsMutex);
     _connectionsByID.insert(dataChannelID, connection);
 }
 
@@ -519,11 +563,15 @@ void WebRTCDataChannels::onSignalingMessage(const QJsonObject& message) {
     _nodeType = to;
 
     // Find or create a connection.
+    // Creating one waits on the WebRTC signaling thread, so is done without the lock.
     WDCConnection* connection;
-    if (_connectionsByID.contains(from)) {
-        connection = _connectionsByID.value(from);
-    } else {
+    {
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+        connection = _connectionsByID.value(from, nullptr);
+    }
+    if (!connection) {
         connection = new WDCConnection(this, from);
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
         _connectionsByID.insert(from, connection);
     }
 
@@ -554,38 +602,81 @@ void WebRTCDataChannels::sendSignalingMessage(const QJsonObject& message) {
     emit signalingMessage(message);
 }
 
-void WebRTCDataChannels::emitDataMessage(const QString& dataChannelID, const QByteArray& byteArray) {
+void WebRTCDataChannels::queueDataMessage(const SockAddr& address, const char* data, int size) {
 #ifdef WEBRTC_DEBUG
-    qCDebug(networking_webrtc) << "WebRTCDataChannels::emitDataMessage() :" << dataChannelID << byteArray.toHex()
-        << byteArray.length();
+    qCDebug(networking_webrtc) << "WebRTCDataChannels::queueDataMessage() :" << address << size;
 #endif
-    auto addressParts = dataChannelID.split(":");
-    if (addressParts.length() != 2) {
-        qCWarning(networking_webrtc) << "Invalid dataChannelID:" << dataChannelID;
-        return;
+    ReceivedDataMessage message;
+    message.address = address;
+    message.data = udt::PacketBufferPool::allocate(size);
+    message.size = size;
+    memcpy(message.data.get(), data, size);
+    _receivedMessages.push(std::move(message));
+
+    if (!_isDataMessagesReadyPending.exchange(true)) {
+        emit dataMessagesReady();
+    }
+}
+
+bool WebRTCDataChannels::takeDataMessage(ReceivedDataMessage& message) {
+    if (_receivedMessages.try_pop(message)) {
+        return true;
     }
-    auto address = SockAddr(SocketType::WebRTC, QHostAddress(addressParts[0]), addressParts[1].toInt());
-    emit dataMessage(address, byteArray);
+
+    // A message queued before the flag was cleared didn't signal, so look again.
+    _isDataMessagesReadyPending = false;
+    return _receivedMessages.try_pop(message);
 }
 
 bool WebRTCDataChannels::sendDataMessage(const SockAddr& destination, const QByteArray& byteArray) {
+    return sendDataMessage(destination, byteArray.constData(), byteArray.length(), false);
+}
+
+bool WebRTCDataChannels::sendDataMessage(const SockAddr& destination, const char* data, qint64 size, bool isUnordered) {
     auto dataChannelID = destination.toShortString();
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "WebRTCDataChannels::sendDataMessage() :" << dataChannelID;
 #endif
 
-    if (!_connectionsByID.contains(dataChannelID)) {
-        qCWarning(networking_webrtc) << "Could not find WebRTC data channel to send message on!";
-        return false;
+    {
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+        if (!_connectionsByID.contains(dataChannelID)) {
+            qCWarning(networking_webrtc) << "Could not find WebRTC data channel to send message on!";
+            return false;
+        }
     }
 
-    auto connection = _connectionsByID.value(dataChannelID);
-    DataBuffer buffer(byteArray.toStdString(), true);
-    return connection->sendDataMessage(buffer);
+    _pendingMessages.push({ dataChannelID, rtc::CopyOnWriteBuffer(data, (size_t)size), isUnordered });
+
+    if (!_isSendPending.exchange(true)) {
+        _rtcSignalingThread->PostTask(RTC_FROM_HERE, [this] { sendPendingDataMessages(); });
+    }
+    return true;
+}
+
+void WebRTCDataChannels::sendPendingDataMessages() {
+    // Cleared first so that a message queued from here on posts another send.
+    _isSendPending = false;
+
+    std::lock_guard<std::mutex> lock(_connectionsMutex);
+    PendingDataMessage message;
+    QString dataChannelID;
+    WDCConnection* connection = nullptr;
+    while (_pendingMessages.try_pop(message)) {
+        // Consecutive messages are usually to the same client.
+        if (!connection || message.dataChannelID != dataChannelID) {
+            dataChannelID = message.dataChannelID;
+            connection = _connectionsByID.value(dataChannelID, nullptr);
+        }
+        if (connection) {
+            connection->sendDataMessage(DataBuffer(message.data, true), message.isUnordered);
+        }
+    }
 }
 
 qint64 WebRTCDataChannels::getBufferedAmount(const SockAddr& address) const {
     auto dataChannelID = address.toShortString();
+    std::lock_guard<std::mutex> lock(_connectionsMutex);
     if (!_connectionsByID.contains(dataChannelID)) {
 #ifdef WEBRTC_DEBUG
         qCDebug(networking_webrtc) << "WebRTCDataChannels::getBufferedAmount() : Channel doesn't exist:" << dataChannelID;
@@ -636,6 +727,12 @@ void WebRTCDataChannels::closePeerConnectionNow(WDCConnection* connection) {
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "WebRTCDataChannels::closePeerConnectionNow()";
 #endif
+    // Stop sending on the connection. Closing it waits on the WebRTC signaling thread, so is done without the lock.
+    {
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+        _connectionsByID.remove(connection->getDataChannelID());
+    }
+
     // Close the peer connection.
     connection->closePeerConnection();
 
@@ -643,7 +740,6 @@ void WebRTCDataChannels::closePeerConnectionNow(WDCConnection* connection) {
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "Dispose of connection for channel:" << connection->getDataChannelID();
 #endif
-    _connectionsByID.remove(connection->getDataChannelID());
     delete connection;
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "Disposed of connection";
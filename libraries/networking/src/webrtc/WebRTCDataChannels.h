@@ -14,15 +14,21 @@
 #if defined(WEBRTC_DATA_CHANNELS)
 
 
+#include <atomic>
+#include <mutex>
+
 #include <QObject>
 #include <QHash>
 
+#include <TBBHelpers.h>
+
 #undef emit  // Avoid conflict between Qt signals/slots and the WebRTC library's.
 #include <api/peer_connection_interface.h>
 #define emit
 
 #include "../NodeType.h"
 #include "../SockAddr.h"
+#include "../udt/PacketBufferPool.h"
 
 class WebRTCDataChannels;
 class WDCConnection;
@@ -115,7 +121,8 @@ public:
 
     /// @brief Constructs a data channel observer.
     /// @param parent The parent connection object.
-    WDCDataChannelObserver(WDCConnection* parent);
+    /// @param isUnordered Whether the observer is for the connection's unordered data channel.
+    WDCDataChannelObserver(WDCConnection* parent, bool isUnordered = false);
 
     /// @brief The data channel state changed.
     void OnStateChange() override;
@@ -124,8 +131,13 @@ public:
     /// @param The message received.
     void OnMessage(const webrtc::DataBuffer& buffer) override;
 
+    /// @brief The number of bytes waiting to be sent on the data channel changed.
+    /// @param sentDataSize The number of bytes sent.
+    void OnBufferedAmountChange(uint64_t sentDataSize) override;
+
 private:
     WDCConnection* _parent;
+    bool _isUnordered;
 };
 
 
@@ -144,6 +156,10 @@ public:
     /// @return The data channel ID.
     QString getDataChannelID() const { return _dataChannelID; }
 
+    /// @brief Gets the data channel's address, per its ID.
+    /// @return The data channel's address.
+    const SockAddr& getAddress() const { return _address; }
+
 
     /// @brief Sets the remote session description received from the remote client via the signaling channel.
     /// @param description The remote session description.
@@ -172,27 +188,36 @@ public:
     /// @param state The new peer connection state.
     void onPeerConnectionStateChanged(webrtc::PeerConnectionInterface::PeerConnectionState state);
 
-    /// @brief Handles the WebRTC data channel being opened.
+    /// @brief Handles a WebRTC data channel being opened.
+    /// @details The first data channel the client opens carries all messages. If the client then opens one that is
+    /// unordered or doesn't retransmit, the messages that the Overte protocol doesn't need delivered are sent on that.
     /// @param dataChannel The WebRTC data channel.
     void onDataChannelOpened(rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel);
 
-    /// @brief Handles a change in the state of the WebRTC data channel.
-    void onDataChannelStateChanged();
+    /// @brief Handles a change in the state of a WebRTC data channel.
+    /// @param isUnordered Whether the change is to the unordered data channel.
+    void onDataChannelStateChanged(bool isUnordered);
 
 
     /// @brief Handles a message being received on the WebRTC data channel.
     /// @param buffer The message received.
     void onDataChannelMessageReceived(const webrtc::DataBuffer& buffer);
 
-    /// @brief Gets the number of bytes waiting to be sent on the WebRTC data channel.
-    /// @return The number of bytes waiting to be sent on the WebRTC data channel.
-    qint64 getBufferedAmount() const;
+    /// @brief Updates the number of bytes waiting to be sent on the WebRTC data channels.
+    void onBufferedAmountChanged();
+
+    /// @brief Gets the number of bytes waiting to be sent on the WebRTC data channels.
+    /// @details Thread-safe. The amount is as of the last send or the last change reported by WebRTC.
+    /// @return The number of bytes waiting to be sent on the WebRTC data channels.
+    qint64 getBufferedAmount() const { return _bufferedAmount; }
 
 
-    /// @brief Sends a message on the WebRTC data channel.
+    /// @brief Sends a message on a WebRTC data channel.
+    /// @details Must be called on the WebRTC signaling thread.
     /// @param buffer The message to send.
+    /// @param isUnordered Whether to send the message on the unordered data channel, if the client opened one.
     /// @return `true` if the message was sent, otherwise `false`.
-    bool sendDataMessage(const webrtc::DataBuffer& buffer);
+    bool sendDataMessage(const webrtc::DataBuffer& buffer, bool isUnordered = false);
 
     /// @brief Closes the WebRTC peer connection.
     void closePeerConnection();
@@ -200,6 +225,7 @@ public:
 private:
     WebRTCDataChannels* _parent;
     QString _dataChannelID;
+    SockAddr _address;
 
     rtc::scoped_refptr<WDCSetSessionDescriptionObserver> _setSessionDescriptionObserver { nullptr };
     rtc::scoped_refptr<WDCCreateSessionDescriptionObserver> _createSessionDescriptionObserver { nullptr };
@@ -207,6 +233,11 @@ private:
     std::shared_ptr<WDCDataChannelObserver> _dataChannelObserver { nullptr };
     rtc::scoped_refptr<webrtc::DataChannelInterface> _dataChannel { nullptr };
 
+    std::shared_ptr<WDCDataChannelObserver> _unorderedDataChannelObserver { nullptr };
+    rtc::scoped_refptr<webrtc::DataChannelInterface> _unorderedDataChannel { nullptr };
+
+    std::atomic<qint64> _bufferedAmount { 0 };
+
     std::shared_ptr<WDCPeerConnectionObserver> _peerConnectionObserver { nullptr };
     rtc::scoped_refptr<webrtc::PeerConnectionInterface> _peerConnection { nullptr };
 };
@@ -223,6 +254,10 @@ private:
 ///
 /// Additionally, for debugging purposes, instead of containing a Overte protocol payload, a WebRTC message may be an echo
 /// request. This is bounced back to the client.
+///
+/// Messages are received and sent on the WebRTC signaling thread, which the data channels run on, so that no message waits
+/// on a call to another thread. Received messages are queued for the socket's thread to take, with one dataMessagesReady
+/// signal for all those queued until it takes the last, and messages to send are queued and sent in batches.
 /// 
 /// A WebRTC data channel is identified by the IP address and port of the client WebSocket that was used when opening the data
 /// channel - this is considered to be the WebRTC data channel's address. The IP address and port of the actual WebRTC
@@ -232,6 +267,13 @@ class WebRTCDataChannels : public QObject {
 
 public:
 
+    /// @brief A data message received from an Interface client.
+    struct ReceivedDataMessage {
+        SockAddr address;
+        udt::PacketBuffer data;
+        int size { 0 };
+    };
+
     /// @brief Constructs a new WebRTCDataChannels object.
     /// @param parent The parent Qt object.
     WebRTCDataChannels(QObject* parent);
@@ -257,17 +299,39 @@ public:
     /// @param message The WebRTC signaling message to send.
     void sendSignalingMessage(const QJsonObject& message);
 
-    /// @brief Emits a dataMessage received from the Interface client.
-    /// @param dataChannelID The IP address and port of the signaling WebSocket that the client used to connect, `"n.n.n.n:n"`.
-    /// @param byteArray The data message received.
-    void emitDataMessage(const QString& dataChannelID, const QByteArray& byteArray);
+    /// @brief Queues a data message received from an Interface client, emitting dataMessagesReady if none was waiting.
+    /// @details Called on the WebRTC signaling thread.
+    /// @param address The address of the signaling WebSocket that the client used to connect.
+    /// @param data The data message received.
+    /// @param size The size of the data message.
+    void queueDataMessage(const SockAddr& address, const char* data, int size);
+
+    /// @brief Gets whether there are received data messages waiting to be taken.
+    /// @return <code>true</code> if there are data messages waiting, <code>false</code> if there aren't.
+    bool hasDataMessages() const { return !_receivedMessages.empty(); }
+
+    /// @brief Takes the next received data message.
+    /// @details Once there are none left, the next message received emits dataMessagesReady again.
+    /// @param message The destination to move the data message into.
+    /// @return <code>true</code> if a data message was taken, <code>false</code> if there were none.
+    bool takeDataMessage(ReceivedDataMessage& message);
 
     /// @brief Sends a data message to an Interface client.
-    /// @param dataChannelID The IP address and port of the signaling WebSocket that the client used to connect, `"n.n.n.n:n"`.
+    /// @param destination The address of the signaling WebSocket that the client used to connect.
     /// @param message The data message to send.
     /// @return `true` if the data message was sent, otherwise `false`.
     bool sendDataMessage(const SockAddr& destination, const QByteArray& message);
 
+    /// @brief Queues a data message to be sent to an Interface client.
+    /// @details Thread-safe. The messages queued are sent together on the WebRTC signaling thread, and one that would
+    /// overflow its data channel's buffer when its turn comes is dropped there.
+    /// @param destination The address of the signaling WebSocket that the client used to connect.
+    /// @param data The data message to send.
+    /// @param size The size of the data message.
+    /// @param isUnordered Whether the message may be sent on the client's unordered data channel.
+    /// @return `true` if the data message was queued, `false` if there's no data channel to the destination.
+    bool sendDataMessage(const SockAddr& destination, const char* data, qint64 size, bool isUnordered);
+
     /// @brief Gets the number of bytes waiting to be sent on a data channel.
     /// @param address The address of the signaling WebSocket that the client used to connect.
     /// @return The number of bytes waiting to be sent on the data channel.
@@ -304,11 +368,10 @@ signals:
     /// @param message The WebRTC signaling message to send.
     void signalingMessage(const QJsonObject& message);
 
-    /// @brief A WebRTC data message received from the Interface client.
-    /// @details This message is for handling at a higher level in the Overte protocol.
-    /// @param address The address of the signaling WebSocket that the client used to connect.
-    /// @param byteArray The Overte protocol message.
-    void dataMessage(const SockAddr& address, const QByteArray& byteArray);
+    /// @brief WebRTC data messages have been received from Interface clients.
+    /// @details The messages are for handling at a higher level in the Overte protocol, and are taken with
+    /// {@link WebRTCDataChannels.takeDataMessage}.
+    void dataMessagesReady();
 
     /// @brief Signals that the peer connection for a WebRTC data channel should be closed.
     /// @details Used by {@link WebRTCDataChannels.closePeerConnection}.
@@ -317,6 +380,14 @@ signals:
 
 private:
 
+    struct PendingDataMessage {
+        QString dataChannelID;
+        rtc::CopyOnWriteBuffer data;
+        bool isUnordered { false };
+    };
+
+    void sendPendingDataMessages();
+
     QObject* _parent;
 
     NodeType_t _nodeType { NodeType::Unassigned };
@@ -330,6 +401,15 @@ private:
     QHash<QString, WDCConnection*> _connectionsByID;  // <client data channel ID, WDCConnection>
     // The client's WebSocket IP and port is used as the data channel ID to uniquely identify each.
     // The WebSocket IP address and port is formatted as "n.n.n.n:n", the same as used in WebRTCSignalingServer.
+    // Guards _connectionsByID, which the socket's thread and the WebRTC signaling thread both use. It is never held while
+    // waiting on the signaling thread.
+    mutable std::mutex _connectionsMutex;
+
+    tbb::concurrent_queue<ReceivedDataMessage> _receivedMessages;
+    std::atomic<bool> _isDataMessagesReadyPending { false };
+
+    tbb::concurrent_queue<PendingDataMessage> _pendingMessages;
+    std::atomic<bool> _isSendPending { false };
 };
 
 
@@ -14,6 +14,7 @@
 
 #include "../NetworkLogging.h"
 #include "../udt/Constants.h"
+#include "../udt/Packet.h"
 
 
 WebRTCSocket::WebRTCSocket(QObject* parent) :
@@ -25,7 +26,7 @@ WebRTCSocket::WebRTCSocket(QObject* parent) :
     connect(&_dataChannels, &WebRTCDataChannels::signalingMessage, this, &WebRTCSocket::sendSignalingMessage);
 
     // Route received data channel messages.
-    connect(&_dataChannels, &WebRTCDataChannels::dataMessage, this, &WebRTCSocket::onDataChannelReceivedMessage);
+    connect(&_dataChannels, &WebRTCDataChannels::dataMessagesReady, this, &WebRTCSocket::readyRead);
 }
 
 void WebRTCSocket::setSocketOption(QAbstractSocket::SocketOption option, const QVariant& value) {
@@ -79,9 +80,22 @@ void WebRTCSocket::abort() {
 
 
 qint64 WebRTCSocket::writeDatagram(const QByteArray& datagram, const SockAddr& destination) {
+    return writeDatagram(datagram.constData(), datagram.length(), destination);
+}
+
+qint64 WebRTCSocket::writeDatagram(const char* data, qint64 size, const SockAddr& destination) {
     clearError();
-    if (_dataChannels.sendDataMessage(destination, datagram)) {
-        return datagram.length();
+
+    // Data packets that are neither reliable nor part of a message don't need to arrive in order, or at all.
+    bool isUnordered = false;
+    udt::Packet::SequenceNumberAndBitField bitField;
+    if (size >= (qint64)sizeof(bitField)) {
+        memcpy(&bitField, data, sizeof(bitField));
+        isUnordered = (bitField & (udt::CONTROL_BIT_MASK | udt::RELIABILITY_BIT_MASK | udt::MESSAGE_BIT_MASK)) == 0;
+    }
+
+    if (_dataChannels.sendDataMessage(destination, data, size, isUnordered)) {
+        return size;
     }
     setError(QAbstractSocket::SocketError::UnknownSocketError, "Failed to write datagram");
     return -1;
@@ -93,40 +107,59 @@ qint64 WebRTCSocket::bytesToWrite(const SockAddr& destination) const {
 
 
 bool WebRTCSocket::hasPendingDatagrams() const {
-    return _receivedQueue.length() > 0;
+    return _hasPendingDatagram || _dataChannels.hasDataMessages();
 }
 
-qint64 WebRTCSocket::pendingDatagramSize() const {
-    if (_receivedQueue.length() > 0) {
-        return _receivedQueue.head().second.length();
+bool WebRTCSocket::fillPendingDatagram() {
+    if (!_hasPendingDatagram) {
+        _hasPendingDatagram = _dataChannels.takeDataMessage(_pendingDatagram);
+    }
+    return _hasPendingDatagram;
+}
+
+qint64 WebRTCSocket::pendingDatagramSize() {
+    if (fillPendingDatagram()) {
+        return _pendingDatagram.size;
     }
     return -1;
 }
 
 qint64 WebRTCSocket::readDatagram(char* data, qint64 maxSize, QHostAddress* address, quint16* port) {
     clearError();
-    if (_receivedQueue.length() > 0) {
-        auto datagram = _receivedQueue.dequeue();
-        auto length = std::min((qint64)datagram.second.length(), maxSize);
+    if (fillPendingDatagram()) {
+        _hasPendingDatagram = false;
+        auto length = std::min((qint64)_pendingDatagram.size, maxSize);
 
         if (data) {
-            memcpy(data, datagram.second.constData(), length);
+            memcpy(data, _pendingDatagram.data.get(), length);
         }
 
         if (address) {
-            *address = datagram.first.getAddress();
+            *address = _pendingDatagram.address.getAddress();
         }
 
         if (port) {
-            *port = datagram.first.getPort();
+            *port = _pendingDatagram.address.getPort();
         }
 
+        _pendingDatagram.data.reset();
         return length;
     }
     setError(QAbstractSocket::SocketError::UnknownSocketError, "Failed to read datagram");
     return -1;
 }
 
+bool WebRTCSocket::takeDatagram(udt::PacketBuffer& data, int& size, SockAddr& sender) {
+    if (!fillPendingDatagram()) {
+        return false;
+    }
+    _hasPendingDatagram = false;
+    data = std::move(_pendingDatagram.data);
+    size = _pendingDatagram.size;
+    sender = _pendingDatagram.address;
+    return true;
+}
+
 
 QAbstractSocket::SocketError WebRTCSocket::error() const {
     return _lastErrorType;
@@ -147,9 +180,4 @@ void WebRTCSocket::clearError() {
 }
 
 
-void WebRTCSocket::onDataChannelReceivedMessage(const SockAddr& source, const QByteArray& message) {
-    _receivedQueue.enqueue(QPair<SockAddr, QByteArray>(source, message));
-    emit readyRead();
-}
-
 #endif // WEBRTC_DATA_CHANNELS
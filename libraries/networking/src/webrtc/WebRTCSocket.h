@@ -15,7 +15,6 @@
 
 #include <QAbstractSocket>
 #include <QObject>
-#include <QQueue>
 
 #include "WebRTCDataChannels.h"
 
@@ -91,6 +90,14 @@ public:
     /// @return The number of bytes if successfully sent, otherwise <code>-1</code>.
     qint64 writeDatagram(const QByteArray& datagram, const SockAddr& destination);
 
+    /// @brief Sends a datagram.
+    /// @details Unreliable, unordered datagrams are sent on the client's unordered data channel if it has opened one.
+    /// @param data The datagram to send.
+    /// @param size The number of bytes in the datagram.
+    /// @param destination The destination WebRTC data channel address.
+    /// @return The number of bytes if successfully queued to send, otherwise <code>-1</code>.
+    qint64 writeDatagram(const char* data, qint64 size, const SockAddr& destination);
+
     /// @brief Gets the number of bytes waiting to be written.
     /// @param destination The destination WebRTC data channel address.
     /// @return The number of bytes waiting to be written.
@@ -102,7 +109,7 @@ public:
 
     /// @brief Gets the size of the first pending datagram.
     /// @return the size of the first pending datagram; <code>-1</code> if there is no pending datagram.
-    qint64 pendingDatagramSize() const;
+    qint64 pendingDatagramSize();
 
     /// @brief Reads the next datagram, up to a maximum number of bytes.
     /// @details Any remaining data in the datagram is lost.
@@ -113,6 +120,13 @@ public:
     /// @return The number of bytes read on success; <code>-1</code> if reading unsuccessful.
     qint64 readDatagram(char* data, qint64 maxSize, QHostAddress* address = nullptr, quint16* port = nullptr);
 
+    /// @brief Takes the next datagram without copying it.
+    /// @param data The destination to put the datagram's buffer.
+    /// @param size The destination to put the number of bytes in the datagram.
+    /// @param sender The destination to put the WebRTC data channel's address.
+    /// @return <code>true</code> if a datagram was taken, <code>false</code> if there was none to read.
+    bool takeDatagram(udt::PacketBuffer& data, int& size, SockAddr& sender);
+
 
     /// @brief Gets the type of error that last occurred.
     /// @return The type of error that last occurred.
@@ -122,14 +136,6 @@ public:
     /// @return The description of the error that last occurred.
     QString errorString() const;
 
-public slots:
-
-    /// @brief Handles the WebRTC data channel receiving a message.
-    /// @details Queues the message to be read via readDatagram.
-    /// @param source The WebRTC data channel that the message was received on.
-    /// @param message The message that was received.
-    void onDataChannelReceivedMessage(const SockAddr& source, const QByteArray& message);
-
 signals:
 
     /// @brief Emitted when the state of the socket changes.
@@ -153,11 +159,15 @@ private:
     void setError(QAbstractSocket::SocketError errorType, QString errorString);
     void clearError();
 
+    bool fillPendingDatagram();
+
     WebRTCDataChannels _dataChannels;
 
     bool _isBound { false };
 
-    QQueue<QPair<SockAddr, QByteArray>> _receivedQueue;  // Messages received are queued for reading from the "socket".
+    // The message taken from the data channels' queue by pendingDatagramSize(), to be read next.
+    WebRTCDataChannels::ReceivedDataMessage _pendingDatagram;
+    bool _hasPendingDatagram { false };
 
     QAbstractSocket::SocketError _lastErrorType { QAbstractSocket::UnknownSocketError };
     QString _lastErrorString;
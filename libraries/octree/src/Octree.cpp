@@ -15,7 +15,9 @@
 #include <cstdio>
 #include <cmath>
 #include <fstream> // to load voxels from file
+#include <queue>
 
+#include <QBuffer>
 #include <QDataStream>
 #include <QDebug>
 #include <QEventLoop>
@@ -51,8 +53,9 @@
 #include "OctreeQueryNode.h"
 #include "OctreeUtils.h"
 #include "OctreeEntitiesFileParser.h"
+#include "OctreeSnapshot.h"
 
-QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz"};
+QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz", OctreeSnapshot::EXTENSION};
 
 Octree::Octree(bool shouldReaverage) :
     _rootElement(NULL),
@@ -135,6 +138,37 @@ bool Octree::recurseElementWithOperationSorted(const OctreeElementPointer& eleme
     return keepSearching;
 }
 
+void Octree::recurseTreeWithOperationNearestFirst(const RecurseOctreeOperation& operation,
+                                                  const RecurseOctreeSortingOperation& sortingOperation, void* extraData) {
+    // Unlike recurseTreeWithOperationSorted, which only orders the children of each element, this visits the nearest
+    // element of the whole tree next, so the search can stop as soon as nothing left can be nearer than what was found
+    static auto comparator = [](const SortedChild& left, const SortedChild& right) { return left.first > right.first; };
+    std::priority_queue<SortedChild, std::vector<SortedChild>, decltype(comparator)> queue(comparator);
+
+    float rootPriority = sortingOperation(_rootElement, extraData);
+    if (rootPriority < FLT_MAX) {
+        queue.emplace(rootPriority, _rootElement);
+    }
+
+    while (!queue.empty()) {
+        OctreeElementPointer element = queue.top().second;
+        queue.pop();
+        // the operation may have narrowed the search since this element was queued
+        if (sortingOperation(element, extraData) == FLT_MAX || !operation(element, extraData)) {
+            break;
+        }
+        for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+            OctreeElementPointer child = element->getChildAtIndex(i);
+            if (child) {
+                float priority = sortingOperation(child, extraData);
+                if (priority < FLT_MAX) {
+                    queue.emplace(priority, child);
+                }
+            }
+        }
+    }
+}
+
 void Octree::recurseTreeWithOperator(RecurseOctreeOperator* operatorObject) {
     recurseElementWithOperator(_rootElement, operatorObject);
 }
@@ -675,6 +709,9 @@ bool Octree::readFromFile(const char* fileName) {
     if (qFileName.endsWith(".json.gz")) {
         return readJSONFromGzippedFile(qFileName);
     }
+    if (qFileName.endsWith("." + OctreeSnapshot::EXTENSION)) {
+        return readFromSnapshotFile(qFileName);
+    }
 
     QFile file(qFileName);
 
@@ -700,13 +737,15 @@ bool Octree::readJSONFromGzippedFile(QString qFileName) {
         qCritical() << "Cannot open gzipped json file for reading: " << qFileName;
         return false;
     }
-    QByteArray compressedJsonData = file.readAll();
     QByteArray jsonData;
+    QBuffer jsonBuffer(&jsonData);
+    jsonBuffer.open(QIODevice::WriteOnly);
 
-    if (!gunzip(compressedJsonData, jsonData)) {
+    if (!gunzip(file, jsonBuffer)) {
         qCritical() << "json File not in gzip format: " << qFileName;
         return false;
     }
+    jsonBuffer.close();
 
     QDataStream jsonStream(jsonData);
     QUrl relativeURL = QUrl::fromLocalFile(qFileName).adjusted(QUrl::RemoveFilename);
@@ -714,6 +753,26 @@ bool Octree::readJSONFromGzippedFile(QString qFileName) {
     return readJSONFromStream(-1, jsonStream, false, relativeURL);
 }
 
+bool Octree::readFromSnapshotFile(const QString& fileName) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Cannot open snapshot file for reading: " << fileName;
+        return false;
+    }
+
+    qint64 size = file.size();
+    const char* data = reinterpret_cast<const char*>(file.map(0, size));
+    if (!data) {
+        qCritical() << "Cannot map snapshot file: " << fileName << file.errorString();
+        return false;
+    }
+
+    qCDebug(octree) << "Reading from snapshot file length:" << size;
+    bool success = readFromSnapshot(data, size);
+    file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(data)));
+    return success;
+}
+
 bool Octree::readFromURL(
     const QString& urlString,
     const bool isObservable,
@@ -848,6 +907,8 @@ bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& eleme
         success = writeToJSONFile(cFileName, element);
     } else if (persistAsFileType == "json.gz") {
         success = writeToJSONFile(cFileName, element, true);
+    } else if (persistAsFileType == OctreeSnapshot::EXTENSION && !element) {
+        success = writeToSnapshotFile(cFileName);
     } else {
         qCDebug(octree) << "unable to write octree to file of type" << persistAsFileType;
     }
@@ -930,15 +991,24 @@ bool Octree::toJSON(QByteArray* data, const OctreeElementPointer& element, bool
 bool Octree::writeToJSONFile(const char* fileName, const OctreeElementPointer& element, bool doGzip) {
     qCDebug(octree, "Saving JSON SVO to file %s...", fileName);
 
+    // the json is compressed straight into the file rather than into another copy of it
     QByteArray jsonDataForFile;
-    if (!toJSON(&jsonDataForFile, element, doGzip)) {
+    if (!toJSON(&jsonDataForFile, element, false)) {
         return false;
     }
 
     QSaveFile persistFile(fileName);
     bool success = false;
     if (persistFile.open(QIODevice::WriteOnly)) {
-        if (persistFile.write(jsonDataForFile) != -1) {
+        bool written;
+        if (doGzip) {
+            QBuffer jsonBuffer(&jsonDataForFile);
+            jsonBuffer.open(QIODevice::ReadOnly);
+            written = gzip(jsonBuffer, persistFile, -1);
+        } else {
+            written = persistFile.write(jsonDataForFile) != -1;
+        }
+        if (written) {
             success = persistFile.commit();
             if (!success) {
                 qCritical() << "Failed to commit to JSON save file:" << persistFile.errorString();
@@ -953,6 +1023,33 @@ bool Octree::writeToJSONFile(const char* fileName, const OctreeElementPointer& e
     return success;
 }
 
+bool Octree::writeToSnapshotFile(const char* fileName) {
+    qCDebug(octree, "Saving snapshot to file %s...", fileName);
+
+    QByteArray snapshot;
+    if (!writeToSnapshot(snapshot)) {
+        qCritical("Failed to write the octree to a snapshot.");
+        return false;
+    }
+
+    QSaveFile persistFile(fileName);
+    bool success = false;
+    if (persistFile.open(QIODevice::WriteOnly)) {
+        if (persistFile.write(snapshot) != -1) {
+            success = persistFile.commit();
+            if (!success) {
+                qCritical() << "Failed to commit to snapshot save file:" << persistFile.errorString();
+            }
+        } else {
+            qCritical("Failed to write to snapshot file.");
+        }
+    } else {
+        qCritical("Failed to open snapshot file for writing.");
+    }
+
+    return success;
+}
+
 uint64_t Octree::getOctreeElementsCount() {
     uint64_t nodeCount = 0;
     recurseTreeWithOperation(countOctreeElementsOperation, &nodeCount);
@@ -26,6 +26,7 @@
 
 #include "OctreeElement.h"
 #include "OctreeElementBag.h"
+#include "OctreeJournal.h"
 #include "OctreePacketData.h"
 #include "OctreeSceneStats.h"
 #include "OctreeUtils.h"
@@ -139,6 +140,11 @@ public:
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
 
+    // The edits processed between these are applied under one write lock, so a tree may hold back edits
+    // that later edits of the batch make redundant. Callers must hold the write lock for all of the batch.
+    virtual void beginEditBatch() { }
+    virtual void endEditBatch() { }
+
     virtual bool rootElementHasData() const { return false; }
     virtual void releaseSceneEncodeData(OctreeElementExtraEncodeData* extraEncodeData) const { }
 
@@ -168,6 +174,10 @@ public:
 
     void recurseTreeWithOperation(const RecurseOctreeOperation& operation, void* extraData = NULL);
     void recurseTreeWithOperationSorted(const RecurseOctreeOperation& operation, const RecurseOctreeSortingOperation& sortingOperation, void* extraData = NULL);
+    /// Calls operation on the elements across the whole tree in order of the priority that sortingOperation gives them,
+    /// lowest first, and stops when the priority of the next one, taken again, is FLT_MAX or operation returns false. The
+    /// priority must be a lower bound of those of the element's descendants, such as the distance to its cube.
+    void recurseTreeWithOperationNearestFirst(const RecurseOctreeOperation& operation, const RecurseOctreeSortingOperation& sortingOperation, void* extraData = NULL);
 
     void recurseTreeWithOperator(RecurseOctreeOperator* operatorObject);
 
@@ -210,6 +220,9 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) = 0;
+    bool writeToSnapshotFile(const char* filename);
+    // Implement these to support the binary persist format, see OctreeSnapshot.h
+    virtual bool writeToSnapshot(QByteArray& snapshot) { return false; }
 
     // Octree importers
     bool readFromFile(const char* filename);
@@ -219,6 +232,15 @@ public:
     bool readJSONFromStream(uint64_t streamLength, QDataStream& inputStream, const bool isImport = false, const QUrl& urlString = QUrl());
     bool readJSONFromGzippedFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) = 0;
+    bool readFromSnapshotFile(const QString& fileName);
+    virtual bool readFromSnapshot(const char* data, qint64 size) { return false; }
+
+    // Implement these to support the edit journal between full persists, see OctreeJournal.h
+    // While journaling, the tree tracks the items changed since the last call to writeJournalRecords
+    void setIsJournaling(bool isJournaling) { _isJournaling = isJournaling; }
+    bool getIsJournaling() const { return _isJournaling; }
+    virtual bool writeJournalRecords(QByteArray& records) { return false; }
+    virtual bool readJournalRecord(OctreeJournal::RecordType type, const char* data, uint32_t size) { return false; }
 
     uint64_t getOctreeElementsCount();
 
@@ -243,6 +265,8 @@ public:
     virtual void dumpTree() { }
     virtual void pruneTree() { }
 
+    const QUuid& getPersistID() const { return _persistID; }
+
     void setOctreeVersionInfo(QUuid id, int64_t dataVersion) {
         _persistID = id;
         _persistDataVersion = dataVersion;
@@ -255,6 +279,7 @@ public:
     virtual quint64 getAverageCreateTime() const { return 0;  }
     virtual quint64 getAverageLoggingTime() const { return 0;  }
     virtual quint64 getAverageFilterTime() const { return 0; }
+    virtual quint64 getTotalSupersededEdits() const { return 0; }
 
     void incrementPersistDataVersion() { _persistDataVersion++; }
 
@@ -279,6 +304,7 @@ protected:
 
     bool _isViewing;
     bool _isServer;
+    bool _isJournaling { false };
 };
 
 #endif // hifi_Octree_h
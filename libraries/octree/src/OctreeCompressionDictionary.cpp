@@ -0,0 +1,113 @@
+//
+//  OctreeCompressionDictionary.cpp
+//  libraries/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "OctreeCompressionDictionary.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <zlib.h>
+
+// strings shorter than a k-mer are not worth a back reference
+static const int KMER_SIZE = sizeof(uint64_t);
+static const int SEGMENT_SIZE = 64;
+static const int SEGMENT_STEP = 16;
+
+struct Segment {
+    const QByteArray* sample;
+    int offset;
+    int size;
+    uint64_t score;
+};
+
+static uint64_t kmerAt(const char* data) {
+    uint64_t kmer;
+    memcpy(&kmer, data, sizeof(kmer));
+    return kmer;
+}
+
+QByteArray OctreeCompressionDictionary::train(const std::vector<QByteArray>& samples, int maxSize) {
+    // count the samples each k-mer occurs in, a k-mer repeated within one sample is already matched by zlib
+    std::unordered_map<uint64_t, uint32_t> frequencies;
+    for (const auto& sample : samples) {
+        std::unordered_set<uint64_t> sampleKmers;
+        for (int i = 0; i + KMER_SIZE <= sample.size(); ++i) {
+            uint64_t kmer = kmerAt(sample.constData() + i);
+            if (sampleKmers.insert(kmer).second) {
+                ++frequencies[kmer];
+            }
+        }
+    }
+
+    // score segments of the samples by how many other samples share their k-mers
+    auto scoreSegment = [&](const Segment& segment, const std::unordered_set<uint64_t>* covered) {
+        uint64_t score = 0;
+        const char* data = segment.sample->constData() + segment.offset;
+        for (int i = 0; i + KMER_SIZE <= segment.size; ++i) {
+            uint64_t kmer = kmerAt(data + i);
+            if (!covered || covered->find(kmer) == covered->end()) {
+                score += frequencies[kmer] - 1;
+            }
+        }
+        return score;
+    };
+
+    std::vector<Segment> segments;
+    for (const auto& sample : samples) {
+        for (int offset = 0; offset + KMER_SIZE <= sample.size(); offset += SEGMENT_STEP) {
+            Segment segment { &sample, offset, std::min(SEGMENT_SIZE, sample.size() - offset), 0 };
+            segment.score = scoreSegment(segment, nullptr);
+            if (segment.score > 0) {
+                segments.push_back(segment);
+            }
+        }
+    }
+    std::sort(segments.begin(), segments.end(), [](const Segment& a, const Segment& b) {
+        return a.score > b.score;
+    });
+
+    // take the best segments, skipping those that mostly repeat k-mers the dictionary already holds
+    std::unordered_set<uint64_t> covered;
+    std::vector<const Segment*> chosen;
+    int dictionarySize = 0;
+    for (const auto& segment : segments) {
+        if (dictionarySize + segment.size > maxSize) {
+            continue;
+        }
+        if (scoreSegment(segment, &covered) * 2 < segment.score) {
+            continue;
+        }
+        const char* data = segment.sample->constData() + segment.offset;
+        for (int i = 0; i + KMER_SIZE <= segment.size; ++i) {
+            covered.insert(kmerAt(data + i));
+        }
+        chosen.push_back(&segment);
+        dictionarySize += segment.size;
+    }
+
+    QByteArray dictionary;
+    dictionary.reserve(dictionarySize);
+    for (auto it = chosen.rbegin(); it != chosen.rend(); ++it) {
+        dictionary.append((*it)->sample->constData() + (*it)->offset, (*it)->size);
+    }
+    return dictionary;
+}
+
+uint32_t OctreeCompressionDictionary::checksum(const QByteArray& dictionary) {
+    if (dictionary.isEmpty()) {
+        return 0;
+    }
+    uLong adler = adler32(0L, Z_NULL, 0);
+    return (uint32_t)adler32(adler, reinterpret_cast<const Bytef*>(dictionary.constData()), (uInt)dictionary.size());
+}
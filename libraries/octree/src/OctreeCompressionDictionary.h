@@ -0,0 +1,39 @@
+//
+//  OctreeCompressionDictionary.h
+//  libraries/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_OctreeCompressionDictionary_h
+#define overte_OctreeCompressionDictionary_h
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+// Preset dictionary for the zlib compression of octree data packets.
+//
+// A server trains its dictionary from the wire encodings of items of its tree, so the byte strings items share
+// (property headers, URLs, userData templates) compress to back references from the first packet on. A viewer
+// that holds the dictionary echoes its checksum in its query, and only then is it sent packets compressed with it.
+namespace OctreeCompressionDictionary {
+
+// zlib only references the last 32KB of a dictionary
+const int MAX_SIZE = 32 * 1024;
+
+/// Returns a dictionary of the byte strings that recur across samples, the most common last as zlib prefers
+QByteArray train(const std::vector<QByteArray>& samples, int maxSize = MAX_SIZE);
+
+/// Returns the adler32 of the dictionary, which zlib also records in the streams compressed with it
+uint32_t checksum(const QByteArray& dictionary);
+
+}
+
+#endif // overte_OctreeCompressionDictionary_h
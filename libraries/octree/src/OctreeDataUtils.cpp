@@ -14,6 +14,7 @@
 #include <Gzip.h>
 #include <udt/PacketHeaders.h>
 
+#include <QBuffer>
 #include <QDebug>
 #include <QJsonObject>
 #include <QJsonDocument>
@@ -84,6 +85,18 @@ QByteArray OctreeUtils::RawOctreeData::toGzippedByteArray() {
     return gzData;
 }
 
+bool OctreeUtils::RawOctreeData::writeGzipped(QIODevice& destination) {
+    auto data = toByteArray();
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+
+    if (!gzip(buffer, destination, -1)) {
+        qCritical("Unable to gzip data while writing json.");
+        return false;
+    }
+    return true;
+}
+
 PacketType OctreeUtils::RawOctreeData::dataPacketType() const {
     Q_ASSERT(false);
     qCritical() << "Attemping to read packet type for incomplete base type 'RawOctreeData'";
@@ -13,6 +13,7 @@
 
 #include <udt/PacketHeaders.h>
 
+#include <QIODevice>
 #include <QJsonObject>
 #include <QUuid>
 #include <QJsonArray>
@@ -39,6 +40,8 @@ public:
     void resetIdAndVersion();
     QByteArray toByteArray();
     QByteArray toGzippedByteArray();
+    // compresses the json into the destination as it is written
+    bool writeGzipped(QIODevice& destination);
 
     bool readOctreeDataInfoFromData(QByteArray data);
     bool readOctreeDataInfoFromFile(QString path);
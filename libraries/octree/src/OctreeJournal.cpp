@@ -0,0 +1,133 @@
+//
+//  OctreeJournal.cpp
+//  libraries/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "OctreeJournal.h"
+
+#include <string.h>
+
+#include <QtCore/QFileInfo>
+
+#include <Packed.h>
+
+#include "OctreeLogging.h"
+
+static const char JOURNAL_MAGIC[4] = { 'O', 'V', 'J', 'L' };
+static const uint32_t JOURNAL_FORMAT_VERSION = 1;
+
+PACKED_BEGIN struct JournalHeader {
+    char magic[4];
+    uint32_t formatVersion;
+    uint32_t bitstreamVersion;
+    uint8_t id[16];
+} PACKED_END;
+
+PACKED_BEGIN struct RecordHeader {
+    uint8_t type;
+    uint32_t size;
+} PACKED_END;
+
+qint64 OctreeJournal::getSize() const {
+    return QFileInfo(_filename).size();
+}
+
+void OctreeJournal::appendRecord(QByteArray& records, RecordType type, const char* data, uint32_t size) {
+    RecordHeader header { type, size };
+    records.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    records.append(data, size);
+}
+
+bool OctreeJournal::reset(const QUuid& id, uint32_t bitstreamVersion) {
+    _file.close();
+    _file.setFileName(_filename);
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(octree) << "Failed to start journal" << _filename << _file.errorString();
+        return false;
+    }
+
+    JournalHeader header;
+    memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.formatVersion = JOURNAL_FORMAT_VERSION;
+    header.bitstreamVersion = bitstreamVersion;
+    memcpy(header.id, id.toRfc4122().constData(), sizeof(header.id));
+    if (_file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header) || !_file.flush()) {
+        qCWarning(octree) << "Failed to write journal" << _filename << _file.errorString();
+        _file.close();
+        return false;
+    }
+    return true;
+}
+
+bool OctreeJournal::append(const QByteArray& records) {
+    if (records.isEmpty()) {
+        return true;
+    }
+    if (!_file.isOpen()) {
+        _file.setFileName(_filename);
+        if (!_file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            qCWarning(octree) << "Failed to open journal" << _filename << _file.errorString();
+            return false;
+        }
+    }
+    if (_file.write(records) != records.size() || !_file.flush()) {
+        qCWarning(octree) << "Failed to append to journal" << _filename << _file.errorString();
+        return false;
+    }
+    return true;
+}
+
+int OctreeJournal::replay(const QUuid& id, uint32_t bitstreamVersion, const RecordHandler& handler) {
+    _file.close();
+
+    QFile file(_filename);
+    if (!file.open(QIODevice::ReadWrite)) {
+        return 0;
+    }
+
+    qint64 size = file.size();
+    const char* data = size > 0 ? reinterpret_cast<const char*>(file.map(0, size)) : nullptr;
+    if (!data || size < (qint64)sizeof(JournalHeader)) {
+        return 0;
+    }
+
+    auto header = reinterpret_cast<const JournalHeader*>(data);
+    if (memcmp(header->magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0 || header->formatVersion != JOURNAL_FORMAT_VERSION) {
+        qCWarning(octree) << "Ignoring journal" << _filename << "of an unknown format";
+        file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(data)));
+        return 0;
+    }
+    if (header->bitstreamVersion != bitstreamVersion || memcmp(header->id, id.toRfc4122().constData(), sizeof(header->id)) != 0) {
+        qCWarning(octree) << "Ignoring journal" << _filename << "of another tree or version";
+        file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(data)));
+        return 0;
+    }
+
+    int numRecords = 0;
+    qint64 offset = sizeof(JournalHeader);
+    while (size - offset >= (qint64)sizeof(RecordHeader)) {
+        RecordHeader record;
+        memcpy(&record, data + offset, sizeof(record));
+        if (size - offset - (qint64)sizeof(RecordHeader) < (qint64)record.size) {
+            break;
+        }
+        if (!handler((RecordType)record.type, data + offset + sizeof(RecordHeader), record.size)) {
+            qCWarning(octree) << "Failed to replay a record of journal" << _filename;
+        }
+        offset += sizeof(RecordHeader) + record.size;
+        ++numRecords;
+    }
+    file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(data)));
+
+    if (offset < size) {
+        qCWarning(octree) << "Cut" << (size - offset) << "bytes of a torn record from journal" << _filename;
+        file.resize(offset);
+    }
+    return numRecords;
+}
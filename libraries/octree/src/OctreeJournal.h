@@ -0,0 +1,60 @@
+//
+//  OctreeJournal.h
+//  libraries/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_OctreeJournal_h
+#define overte_OctreeJournal_h
+
+#include <stdint.h>
+
+#include <functional>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+#include <QtCore/QUuid>
+
+// Append-only log of the items of an octree changed since its last full persist.
+//
+// Each record holds the whole current state of an item, or its erasure, so replaying a journal on top of a persist
+// that already includes some of its records is harmless. The journal is bound to the tree ID and bitstream version
+// it was started for, and is only replayed onto the same tree.
+class OctreeJournal {
+public:
+    enum RecordType : uint8_t {
+        Upsert = 1,
+        Erase = 2
+    };
+    using RecordHandler = std::function<bool(RecordType type, const char* data, uint32_t size)>;
+
+    OctreeJournal(const QString& filename) : _filename(filename) { }
+
+    const QString& getFilename() const { return _filename; }
+    qint64 getSize() const;
+
+    static void appendRecord(QByteArray& records, RecordType type, const char* data, uint32_t size);
+
+    /// Starts a new, empty journal, replacing any previous one
+    bool reset(const QUuid& id, uint32_t bitstreamVersion);
+
+    /// Appends records framed by appendRecord and flushes them to the file
+    bool append(const QByteArray& records);
+
+    /// Calls handler for each record of a journal started for this id and version
+    /// A record torn by a crash mid-append ends the replay, and is cut from the file
+    /// Returns the number of records replayed
+    int replay(const QUuid& id, uint32_t bitstreamVersion, const RecordHandler& handler);
+
+private:
+    QString _filename;
+    QFile _file;
+};
+
+#endif // overte_OctreeJournal_h
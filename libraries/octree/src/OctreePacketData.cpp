@@ -11,6 +11,10 @@
 
 #include "OctreePacketData.h"
 
+#include <zlib.h>
+
+#include <QtCore/QtEndian>
+
 #include <GLMHelpers.h>
 #include <PerfStat.h>
 
@@ -605,6 +609,81 @@ bool OctreePacketData::appendRawData(QByteArray data) {
 AtomicUIntStat OctreePacketData::_compressContentTime { 0 };
 AtomicUIntStat OctreePacketData::_compressContentCalls { 0 };
 
+// sections compressed with a preset dictionary keep the framing of qCompress(),
+// the uncompressed size as a big-endian uint32_t followed by the zlib stream
+static const int COMPRESSED_SIZE_BYTES = sizeof(quint32);
+
+// a corrupt size must not have us allocate without bound
+static const quint32 MAX_UNCOMPRESSED_SECTION_SIZE = 1024 * 1024;
+
+static QByteArray compressWithDictionary(const uchar* data, int size, const QByteArray& dictionary, int level) {
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (deflateInit(&stream, level) != Z_OK) {
+        return QByteArray();
+    }
+
+    QByteArray compressed;
+    int result = deflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(dictionary.constData()), (uInt)dictionary.size());
+    if (result == Z_OK) {
+        compressed.resize(COMPRESSED_SIZE_BYTES + (int)deflateBound(&stream, size));
+        qToBigEndian<quint32>(size, reinterpret_cast<uchar*>(compressed.data()));
+
+        stream.next_in = const_cast<Bytef*>(data);
+        stream.avail_in = size;
+        stream.next_out = reinterpret_cast<Bytef*>(compressed.data()) + COMPRESSED_SIZE_BYTES;
+        stream.avail_out = compressed.size() - COMPRESSED_SIZE_BYTES;
+        result = deflate(&stream, Z_FINISH);
+    }
+    deflateEnd(&stream);
+
+    if (result != Z_STREAM_END) {
+        return QByteArray();
+    }
+    compressed.resize(COMPRESSED_SIZE_BYTES + (int)stream.total_out);
+    return compressed;
+}
+
+// also inflates sections compressed without a dictionary, as sent before the viewer confirmed it holds the dictionary
+static QByteArray uncompressWithDictionary(const uchar* data, int size, const QByteArray& dictionary) {
+    if (size <= COMPRESSED_SIZE_BYTES) {
+        return QByteArray();
+    }
+    quint32 uncompressedSize = qFromBigEndian<quint32>(data);
+    if (uncompressedSize > MAX_UNCOMPRESSED_SECTION_SIZE) {
+        return QByteArray();
+    }
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (inflateInit(&stream) != Z_OK) {
+        return QByteArray();
+    }
+
+    QByteArray uncompressed;
+    uncompressed.resize(uncompressedSize);
+    stream.next_in = const_cast<Bytef*>(data) + COMPRESSED_SIZE_BYTES;
+    stream.avail_in = size - COMPRESSED_SIZE_BYTES;
+    stream.next_out = reinterpret_cast<Bytef*>(uncompressed.data());
+    stream.avail_out = uncompressedSize;
+
+    int result = inflate(&stream, Z_FINISH);
+    if (result == Z_NEED_DICT) {
+        // fails if the stream was compressed with another dictionary
+        result = inflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(dictionary.constData()), (uInt)dictionary.size());
+        if (result == Z_OK) {
+            result = inflate(&stream, Z_FINISH);
+        }
+    }
+    inflateEnd(&stream);
+
+    if (result != Z_STREAM_END) {
+        return QByteArray();
+    }
+    uncompressed.resize((int)stream.total_out);
+    return uncompressed;
+}
+
 bool OctreePacketData::compressContent() {
     PerformanceWarning warn(false, "OctreePacketData::compressContent()", false, &_compressContentTime, &_compressContentCalls);
     assert(_dirty);
@@ -619,9 +698,11 @@ bool OctreePacketData::compressContent() {
     const uchar* uncompressedData = &_uncompressed[0];
     int uncompressedSize = _bytesInUse;
 
-    QByteArray compressedData = qCompress(uncompressedData, uncompressedSize, MAX_COMPRESSION);
+    QByteArray compressedData = _compressionDictionary.isEmpty() ?
+        qCompress(uncompressedData, uncompressedSize, MAX_COMPRESSION) :
+        compressWithDictionary(uncompressedData, uncompressedSize, _compressionDictionary, MAX_COMPRESSION);
 
-    if (compressedData.size() < _compressedByteArray.size()) {
+    if (!compressedData.isEmpty() && compressedData.size() < _compressedByteArray.size()) {
         _compressedBytes = compressedData.size();
         memcpy(_compressed, compressedData.constData(), _compressedBytes);
         _dirty = false;
@@ -643,11 +724,19 @@ void OctreePacketData::loadFinalizedContent(const unsigned char* data, int lengt
             _compressedBytes = length;
             memcpy(_compressed, data, _compressedBytes);
 
-            QByteArray compressedData;
-            compressedData.resize(_compressedBytes);
-            memcpy(compressedData.data(), data, _compressedBytes);
-
-            QByteArray uncompressedData = qUncompress(compressedData);
+            QByteArray uncompressedData;
+            if (_compressionDictionary.isEmpty()) {
+                QByteArray compressedData;
+                compressedData.resize(_compressedBytes);
+                memcpy(compressedData.data(), data, _compressedBytes);
+
+                uncompressedData = qUncompress(compressedData);
+            } else {
+                uncompressedData = uncompressWithDictionary(data, length, _compressionDictionary);
+                if (uncompressedData.isEmpty()) {
+                    qCWarning(octree) << "OctreePacketData::loadFinalizedContent -- failed to uncompress with the dictionary";
+                }
+            }
             if (uncompressedData.size() > _bytesAvailable) {
                 int moreNeeded = uncompressedData.size() - _bytesAvailable;
                 _uncompressedByteArray.resize(_uncompressedByteArray.size() + moreNeeded);
@@ -244,6 +244,11 @@ public:
     
     /// returns whether or not zlib compression enabled on finalization
     bool isCompressed() const { return _enableCompression; }
+
+    /// sets the preset dictionary compression and loading use, both ends must use the same one
+    /// the dictionary is kept across changeSettings() and reset(), an empty one compresses without a dictionary
+    void setCompressionDictionary(const QByteArray& dictionary) { _compressionDictionary = dictionary; }
+    const QByteArray& getCompressionDictionary() const { return _compressionDictionary; }
     
     /// returns the target uncompressed size
     unsigned int getTargetSize() const { return _targetSize; }
@@ -317,6 +322,7 @@ private:
     QByteArray _compressedByteArray;
     unsigned char* _compressed { nullptr };
     int _compressedBytes;
+    QByteArray _compressionDictionary;
     int _bytesInUseLastCheck;
     bool _dirty;
 
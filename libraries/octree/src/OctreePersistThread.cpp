@@ -36,15 +36,20 @@
 #include "OctreeLogging.h"
 #include "OctreeUtils.h"
 #include "OctreeDataUtils.h"
+#include "OctreeSnapshot.h"
 
 constexpr std::chrono::seconds OctreePersistThread::DEFAULT_PERSIST_INTERVAL { 30 };
 constexpr std::chrono::milliseconds TIME_BETWEEN_PROCESSING { 10 };
 
+constexpr std::chrono::seconds JOURNAL_FLUSH_INTERVAL { 1 };
+constexpr std::chrono::hours MAX_TIME_BETWEEN_JOURNAL_COMPACTIONS { 1 };
+constexpr int64_t MAX_JOURNAL_SIZE_BYTES { 16 * 1000 * 1000 };
+
 constexpr int MAX_OCTREE_REPLACEMENT_BACKUP_FILES_COUNT { 20 };
 constexpr int64_t MAX_OCTREE_REPLACEMENT_BACKUP_FILES_SIZE_BYTES { 50 * 1000 * 1000 };
 
 OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& filename, std::chrono::milliseconds persistInterval,
-                                         bool debugTimestampNow, QString persistAsFileType) :
+                                         bool debugTimestampNow, QString persistAsFileType, bool wantJournal) :
     _tree(tree),
     _filename(filename),
     _persistInterval(persistInterval),
@@ -58,6 +63,10 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     // in case the persist filename has an extension that doesn't match the file type
     QString sansExt = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS);
     _filename = sansExt + "." + _persistAsFileType;
+
+    if (wantJournal) {
+        _journal = std::make_unique<OctreeJournal>(sansExt + ".journal");
+    }
 }
 
 void OctreePersistThread::start() {
@@ -76,22 +85,42 @@ void OctreePersistThread::start() {
     qCDebug(octree) << "Reading octree data from" << _filename;
     QFile file(_filename);
     if (file.open(QIODevice::ReadOnly)) {
-        QByteArray jsonData(file.readAll());
-        file.close();
-        if (!gunzip(jsonData, _cachedJSONData)) {
-            _cachedJSONData = jsonData;
-        }
-
-        if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
-            qCDebug(octree) << "Current octree data: ID(" << data.id << ") DataVersion(" << data.dataVersion << ")";
-            packet->writePrimitive(true);
-            auto id = data.id.toRfc4122();
-            packet->write(id);
-            packet->writePrimitive(data.dataVersion);
+        QByteArray snapshotHeaderData = file.peek(sizeof(OctreeSnapshot::Header));
+        auto snapshotHeader = OctreeSnapshot::readHeader(snapshotHeaderData.constData(), snapshotHeaderData.size());
+        if (snapshotHeader) {
+            // the snapshot is mapped and read at load time, only its header is needed here
+            file.close();
+            if (snapshotHeader->bitstreamVersion == _tree->expectedVersion()) {
+                _loadedFromSnapshot = true;
+                data.id = QUuid::fromRfc4122(QByteArray((const char*)snapshotHeader->id, sizeof(snapshotHeader->id)));
+                data.dataVersion = snapshotHeader->dataVersion;
+                qCDebug(octree) << "Current octree snapshot: ID(" << data.id << ") DataVersion(" << data.dataVersion << ")";
+                packet->writePrimitive(true);
+                auto id = data.id.toRfc4122();
+                packet->write(id);
+                packet->writePrimitive(data.dataVersion);
+            } else {
+                qCWarning(octree) << "Octree snapshot is of version" << snapshotHeader->bitstreamVersion << "- can't read it";
+                packet->writePrimitive(false);
+            }
         } else {
-            _cachedJSONData.clear();
-            qCWarning(octree) << "No octree data found";
-            packet->writePrimitive(false);
+            QByteArray jsonData(file.readAll());
+            file.close();
+            if (!gunzip(jsonData, _cachedJSONData)) {
+                _cachedJSONData = jsonData;
+            }
+
+            if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
+                qCDebug(octree) << "Current octree data: ID(" << data.id << ") DataVersion(" << data.dataVersion << ")";
+                packet->writePrimitive(true);
+                auto id = data.id.toRfc4122();
+                packet->write(id);
+                packet->writePrimitive(data.dataVersion);
+            } else {
+                _cachedJSONData.clear();
+                qCWarning(octree) << "No octree data found";
+                packet->writePrimitive(false);
+            }
         }
     } else {
         qCWarning(octree) << "Couldn't access file" << _filename << file.errorString();
@@ -115,9 +144,16 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     bool hasValidOctreeData { false };
     if (includesNewData) {
         _cachedJSONData.clear();
+        _loadedFromSnapshot = false;
         replacementData = message->readAll();
         replaceData(replacementData);
         hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
+        if (_persistAsFileType == OctreeSnapshot::EXTENSION) {
+            // the replacement is json, load it from memory rather than as a snapshot file
+            if (!gunzip(replacementData, _cachedJSONData)) {
+                _cachedJSONData = replacementData;
+            }
+        }
         qDebug() << "Got OctreeDataFileReply, new data sent";
     } else {
         qDebug() << "Got OctreeDataFileReply, current entity data is sufficient";
@@ -132,8 +168,7 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 
                 QFile file(_filename);
                 if (file.open(QIODevice::WriteOnly)) {
-                    auto entityData = data.toGzippedByteArray();
-                    file.write(entityData);
+                    data.writeGzipped(file);
                     file.close();
                 } else {
                     qCDebug(octree) << "Failed to update octree data";
@@ -161,13 +196,38 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
             persistentFileRead = _tree->readFromStream(-1, jsonStream);
         }
         _tree->pruneTree();
+
+        if (_journal) {
+            int numReplayed = 0;
+            if (replacementData.isNull() && persistentFileRead) {
+                numReplayed = _journal->replay(_tree->getPersistID(), _tree->expectedVersion(),
+                    [&](OctreeJournal::RecordType type, const char* data, uint32_t size) {
+                        return _tree->readJournalRecord(type, data, size);
+                    });
+            }
+            if (numReplayed > 0) {
+                // keep appending to the replayed journal until the next persist compacts it
+                qCDebug(octree) << "Replayed" << numReplayed << "journal records from" << _journal->getFilename();
+                _journalNeedsCompaction = true;
+            } else {
+                _journal->reset(_tree->getPersistID(), _tree->expectedVersion());
+            }
+            _tree->setIsJournaling(true);
+        }
     });
 
     _cachedJSONData.clear();
     quint64 loadDone = usecTimestampNow();
     _loadTimeUSecs = loadDone - loadStarted;
 
-    _tree->clearDirtyBit(); // the tree is clean since we just loaded it
+    if (_persistAsFileType == OctreeSnapshot::EXTENSION && persistentFileRead && !_loadedFromSnapshot) {
+        // leave the tree dirty, so the next persist converts the json data we loaded to a snapshot
+        _journalNeedsCompaction = true;
+    } else if (_journalNeedsCompaction) {
+        // leave the tree dirty with the replayed journal, so the next persist compacts it
+    } else {
+        _tree->clearDirtyBit(); // the tree is clean since we just loaded it
+    }
 
     unsigned long nodeCount = OctreeElement::getNodeCount();
     unsigned long internalNodeCount = OctreeElement::getInternalNodeCount();
@@ -191,6 +251,8 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 
     // Since we just loaded the persistent file, we can consider ourselves as having just persisted
     _lastPersistCheck = std::chrono::steady_clock::now();
+    _lastJournalFlush = _lastPersistCheck;
+    _lastJournalCompaction = _lastPersistCheck;
 
     if (replacementData.isNull()) {
         sendLatestEntityDataToDS();
@@ -205,7 +267,7 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 QString OctreePersistThread::getPersistFileMimeType() const {
     if (_persistAsFileType == "json") {
         return "application/json";
-    } if (_persistAsFileType == "json.gz") {
+    } if (_persistAsFileType == "json.gz" || _persistAsFileType == OctreeSnapshot::EXTENSION) {
         return "application/zip";
     }
     return "";
@@ -251,7 +313,11 @@ void OctreePersistThread::process() {
 
     if (timeSinceLastPersist > _persistInterval) {
         _lastPersistCheck = now;
+        _lastJournalFlush = now;
         persist();
+    } else if (_journal && now - _lastJournalFlush > JOURNAL_FLUSH_INTERVAL) {
+        _lastJournalFlush = now;
+        flushJournal();
     }
 
     QTimer::singleShot(TIME_BETWEEN_PROCESSING.count(), this, &OctreePersistThread::process);
@@ -259,12 +325,18 @@ void OctreePersistThread::process() {
 
 void OctreePersistThread::aboutToFinish() {
     qCDebug(octree) << "Persist thread about to finish...";
+    _journalNeedsCompaction = true;
     persist();
     qCDebug(octree) << "Persist thread done with about to finish...";
 }
 
 QByteArray OctreePersistThread::getPersistFileContents() const {
     QByteArray fileContents;
+    if (_persistAsFileType == OctreeSnapshot::EXTENSION) {
+        // snapshots are not portable across versions, downloads stay json.gz
+        _tree->toJSON(&fileContents, nullptr, true);
+        return fileContents;
+    }
     QFile file(_filename);
     if (file.open(QIODevice::ReadOnly)) {
         fileContents = file.readAll();
@@ -302,8 +374,31 @@ void OctreePersistThread::cleanupOldReplacementBackups() {
     qDebug() << "Found" << count << "backups";
 }
 
+void OctreePersistThread::flushJournal() {
+    QByteArray records;
+    if (!_tree->writeJournalRecords(records)) {
+        // the journal misses an edit, only a full persist has it
+        _journalNeedsCompaction = true;
+    }
+    if (!_journal->append(records)) {
+        _journalNeedsCompaction = true;
+    }
+}
+
+bool OctreePersistThread::journalNeedsCompaction() const {
+    return _journalNeedsCompaction || _journal->getSize() > MAX_JOURNAL_SIZE_BYTES ||
+        std::chrono::steady_clock::now() - _lastJournalCompaction > MAX_TIME_BETWEEN_JOURNAL_COMPACTIONS;
+}
+
 void OctreePersistThread::persist() {
     if (_tree->isDirty() && _initialLoadComplete) {
+        if (_journal) {
+            flushJournal();
+            if (!journalNeedsCompaction()) {
+                // the journal holds the edits since the last full persist, which stays as it is
+                return;
+            }
+        }
 
         _tree->withWriteLock([&] {
             qCDebug(octree) << "pruning Octree before saving...";
@@ -317,6 +412,12 @@ void OctreePersistThread::persist() {
         if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
             _tree->clearDirtyBit(); // tree is clean after saving
             qCDebug(octree) << "DONE persisting Octree data to" << _filename;
+            if (_journal) {
+                // edits made while saving are still tracked, and go to the new journal
+                _journal->reset(_tree->getPersistID(), _tree->expectedVersion());
+                _lastJournalCompaction = std::chrono::steady_clock::now();
+                _journalNeedsCompaction = false;
+            }
         } else {
             qCWarning(octree) << "Failed to persist Octree data to" << _filename;
         }
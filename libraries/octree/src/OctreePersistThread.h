@@ -14,6 +14,8 @@
 #ifndef hifi_OctreePersistThread_h
 #define hifi_OctreePersistThread_h
 
+#include <memory>
+
 #include <QString>
 #include <QtCore/QSharedPointer>
 #include <GenericThread.h>
@@ -37,7 +39,8 @@ public:
                         const QString& filename,
                         std::chrono::milliseconds persistInterval = DEFAULT_PERSIST_INTERVAL,
                         bool debugTimestampNow = false,
-                        QString persistAsFileType = "json.gz");
+                        QString persistAsFileType = "json.gz",
+                        bool wantJournal = false);
 
     bool isInitialLoadComplete() const { return _initialLoadComplete; }
     quint64 getLoadElapsedTime() const { return _loadTimeUSecs; }
@@ -60,6 +63,8 @@ protected slots:
 
 protected:
     void persist();
+    void flushJournal();
+    bool journalNeedsCompaction() const;
     bool backupCurrentFile();
     void cleanupOldReplacementBackups();
 
@@ -80,6 +85,12 @@ private:
 
     QString _persistAsFileType;
     QByteArray _cachedJSONData;
+    bool _loadedFromSnapshot { false };
+
+    std::unique_ptr<OctreeJournal> _journal;
+    std::chrono::steady_clock::time_point _lastJournalFlush;
+    std::chrono::steady_clock::time_point _lastJournalCompaction;
+    bool _journalNeedsCompaction { false };
 };
 
 #endif // hifi_OctreePersistThread_h
@@ -18,6 +18,7 @@
 #include <PerfStat.h>
 #include <SharedUtil.h>
 
+#include "OctreeCompressionDictionary.h"
 #include "OctreeLogging.h"
 
 void OctreeProcessor::init() {
@@ -112,20 +113,35 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
                 sectionLength = message.getBytesLeftToRead();
             }
 
+            if (sectionLength > message.getBytesLeftToRead()) {
+                sectionLength = 0;
+                error = true;
+            }
+
             if (sectionLength) {
                 // ask the VoxelTree to read the bitstream into the tree
                 ReadBitstreamToTreeParams args(WANT_EXISTS_BITS, NULL,
                                                sourceUUID, sourceNode);
                 quint64 startUncompress, startLock = usecTimestampNow();
                 quint64 startReadBitsteam, endReadBitsteam;
+
+                // the section is read where it lies in the packets, only one that straddles packets is gathered
+                auto sectionSpans = message.peekSpans(sectionLength);
+                QByteArray gatheredSection;
+                const char* sectionData = sectionSpans.front().data;
+                if (sectionSpans.size() > 1) {
+                    gatheredSection = message.peek(sectionLength);
+                    sectionData = gatheredSection.constData();
+                }
+
                 // FIXME STUTTER - there may be an opportunity to bump this lock outside of the
                 // loop to reduce the amount of locking/unlocking we're doing
                 _tree->withWriteLock([&] {
                     startUncompress = usecTimestampNow();
 
                     OctreePacketData packetData(packetIsCompressed);
-                    packetData.loadFinalizedContent(reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition()),
-                        sectionLength);
+                    packetData.setCompressionDictionary(_compressionDictionary);
+                    packetData.loadFinalizedContent(reinterpret_cast<const unsigned char*>(sectionData), sectionLength);
                     if (extraDebugging) {
                         qCDebug(octree) << "OctreeProcessor::processDatagram() ... "
                             "Got Packet Section color:" << packetIsColored <<
@@ -197,6 +213,18 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
     }
 }
 
+void OctreeProcessor::processCompressionDictionaryMessage(ReceivedMessage& message) {
+    QByteArray dictionary = message.readAll();
+    if (dictionary.size() > OctreeCompressionDictionary::MAX_SIZE) {
+        qCWarning(octree) << "Ignoring a compression dictionary of" << dictionary.size() << "bytes";
+        return;
+    }
+
+    // packets compressed with it only follow our next query echoing its checksum
+    _compressionDictionary = dictionary;
+    _compressionDictionaryChecksum = OctreeCompressionDictionary::checksum(dictionary);
+}
+
 
 void OctreeProcessor::clearDomainAndNonOwnedEntities() {
     if (_tree) {
@@ -59,6 +59,10 @@ public:
 
     OCTREE_PACKET_SEQUENCE getLastOctreeMessageSequence() const { return _lastOctreeMessageSequence; }
 
+    /// the server's dictionary for the compression of data packets, set on the thread that processes them
+    void processCompressionDictionaryMessage(ReceivedMessage& message);
+    uint32_t getCompressionDictionaryChecksum() const { return _compressionDictionaryChecksum; }
+
 protected:
     virtual OctreePointer createTree() = 0;
 
@@ -82,6 +86,9 @@ protected:
     int _entitiesInLastWindow = 0;
     std::atomic<OCTREE_PACKET_SEQUENCE> _lastOctreeMessageSequence;
 
+    QByteArray _compressionDictionary;
+    std::atomic<uint32_t> _compressionDictionaryChecksum { 0 }; // echoed in our queries from their thread
+
 };
 
 #endif // hifi_OctreeProcessor_h
@@ -11,6 +11,7 @@
 
 #include "OctreeQuery.h"
 
+#include <cmath>
 #include <random>
 
 #include <QtCore/QJsonDocument>
@@ -87,9 +88,27 @@ int OctreeQuery::getBroadcastData(unsigned char* destinationBuffer) {
 
     OctreeQueryFlags queryFlags { NoFlags };
     queryFlags |= (_reportInitialCompletion ? OctreeQuery::WantInitialCompletion : 0);
+    queryFlags |= (_wantCompressionDictionary ? OctreeQuery::WantCompressionDictionary : 0);
     memcpy(destinationBuffer, &queryFlags, sizeof(queryFlags));
     destinationBuffer += sizeof(queryFlags);
 
+    // checksum of the compression dictionary we hold
+    memcpy(destinationBuffer, &_compressionDictionaryChecksum, sizeof(_compressionDictionaryChecksum));
+    destinationBuffer += sizeof(_compressionDictionaryChecksum);
+
+    {
+        // the priority weight and LOD scale of each view, in the order the views were packed
+        QMutexLocker lock(&_conicalViewsLock);
+        for (const auto& view : _conicalViews) {
+            float priorityWeight = view.getPriorityWeight();
+            memcpy(destinationBuffer, &priorityWeight, sizeof(priorityWeight));
+            destinationBuffer += sizeof(priorityWeight);
+            float lodScale = view.getLODScale();
+            memcpy(destinationBuffer, &lodScale, sizeof(lodScale));
+            destinationBuffer += sizeof(lodScale);
+        }
+    }
+
     return destinationBuffer - bufferStart;
 }
 
@@ -171,6 +190,28 @@ int OctreeQuery::parseData(ReceivedMessage& message) {
     sourceBuffer += sizeof(queryFlags);
 
     _reportInitialCompletion = bool(queryFlags & OctreeQueryFlags::WantInitialCompletion);
+    _wantCompressionDictionary = bool(queryFlags & OctreeQueryFlags::WantCompressionDictionary);
+
+    memcpy(&_compressionDictionaryChecksum, sourceBuffer, sizeof(_compressionDictionaryChecksum));
+    sourceBuffer += sizeof(_compressionDictionaryChecksum);
+
+    {
+        // a view can be made less important than the main view, but not more, nor seen at a finer LOD
+        QMutexLocker lock(&_conicalViewsLock);
+        for (auto& view : _conicalViews) {
+            float priorityWeight;
+            memcpy(&priorityWeight, sourceBuffer, sizeof(priorityWeight));
+            sourceBuffer += sizeof(priorityWeight);
+            float lodScale;
+            memcpy(&lodScale, sourceBuffer, sizeof(lodScale));
+            sourceBuffer += sizeof(lodScale);
+
+            view.setPriorityWeight(std::isnan(priorityWeight) ? DEFAULT_VIEW_PRIORITY_WEIGHT :
+                glm::clamp(priorityWeight, MIN_VIEW_PRIORITY_WEIGHT, DEFAULT_VIEW_PRIORITY_WEIGHT));
+            view.setLODScale(std::isnan(lodScale) ? DEFAULT_VIEW_LOD_SCALE :
+                glm::clamp(lodScale, DEFAULT_VIEW_LOD_SCALE, MAX_VIEW_LOD_SCALE));
+        }
+    }
 
     return sourceBuffer - startPosition;
 }
@@ -20,6 +20,10 @@
 
 #include "OctreeConstants.h"
 
+// the bounds of the priority weights and LOD scales of the views in a query
+const float MIN_VIEW_PRIORITY_WEIGHT = 0.01f;
+const float MAX_VIEW_LOD_SCALE = 16.0f;
+
 class OctreeQuery : public NodeData {
     Q_OBJECT
 
@@ -34,6 +38,7 @@ public:
     int parseData(ReceivedMessage& message) override;
 
     bool hasConicalViews() const { QMutexLocker lock(&_conicalViewsLock); return !_conicalViews.empty(); }
+    ConicalViewFrustums getConicalViews() const { QMutexLocker lock(&_conicalViewsLock); return _conicalViews; }
     void setConicalViews(ConicalViewFrustums views)
         { QMutexLocker lock(&_conicalViewsLock); _conicalViews = views; }
     void clearConicalViews() { QMutexLocker lock(&_conicalViewsLock); _conicalViews.clear(); }
@@ -56,6 +61,12 @@ public:
     bool wantReportInitialCompletion() const { return _reportInitialCompletion; }
     void setReportInitialCompletion(bool reportInitialCompletion) { _reportInitialCompletion = reportInitialCompletion; }
 
+    // Want the server's compression dictionary, and packets compressed with it once the checksum of the one held matches.
+    bool wantCompressionDictionary() const { return _wantCompressionDictionary; }
+    void setWantCompressionDictionary(bool wantCompressionDictionary) { _wantCompressionDictionary = wantCompressionDictionary; }
+    uint32_t getCompressionDictionaryChecksum() const { return _compressionDictionaryChecksum; }
+    void setCompressionDictionaryChecksum(uint32_t checksum) { _compressionDictionaryChecksum = checksum; }
+
 signals:
     void incomingConnectionIDChanged();
 
@@ -78,11 +89,13 @@ protected:
     QJsonObject _jsonParameters;
     QReadWriteLock _jsonParametersLock;
     
-    enum OctreeQueryFlags : uint16_t { NoFlags = 0x0, WantInitialCompletion = 0x1 };
+    enum OctreeQueryFlags : uint16_t { NoFlags = 0x0, WantInitialCompletion = 0x1, WantCompressionDictionary = 0x2 };
     friend OctreeQuery::OctreeQueryFlags operator|=(OctreeQuery::OctreeQueryFlags& lhs, const int rhs);
 
     bool _hasReceivedFirstQuery { false };
     bool _reportInitialCompletion { false };
+    bool _wantCompressionDictionary { false };
+    uint32_t _compressionDictionaryChecksum { 0 }; // of the compression dictionary held, 0 for none
 };
 
 #endif // hifi_OctreeQuery_h
@@ -18,6 +18,9 @@
 #include <SharedUtil.h>
 #include <UUID.h>
 
+// how often a change to only the reduced-priority views, like a spectator camera's, restarts the traversal of the tree
+static const quint64 REDUCED_PRIORITY_VIEWS_UPDATE_USECS = 250 * USECS_PER_MSEC;
+
 void OctreeQueryNode::nodeKilled() {
     _isShuttingDown = true;
 }
@@ -156,16 +159,30 @@ bool OctreeQueryNode::updateCurrentViewFrustum() {
         QMutexLocker lock(&_conicalViewsLock);
 
         if (_conicalViews.size() == _currentConicalViews.size()) {
-            for (size_t i = 0; i < _conicalViews.size(); ++i) {
+            bool primaryViewsChanged = false;
+            bool reducedPriorityViewsChanged = false;
+            for (size_t i = 0; i < _conicalViews.size() && !primaryViewsChanged; ++i) {
                 if (!_conicalViews[i].isVerySimilar(_currentConicalViews[i])) {
-                    _currentConicalViews = _conicalViews;
-                    currentViewFrustumChanged = true;
-                    break;
+                    if (_conicalViews[i].getPriorityWeight() < DEFAULT_VIEW_PRIORITY_WEIGHT) {
+                        reducedPriorityViewsChanged = true;
+                    } else {
+                        primaryViewsChanged = true;
+                    }
                 }
             }
+
+            // the reduced-priority views are followed at a lower rate, and are brought up to date with the primary ones
+            quint64 now = usecTimestampNow();
+            if (primaryViewsChanged ||
+                (reducedPriorityViewsChanged && now - _lastViewsChange >= REDUCED_PRIORITY_VIEWS_UPDATE_USECS)) {
+                _currentConicalViews = _conicalViews;
+                currentViewFrustumChanged = true;
+                _lastViewsChange = now;
+            }
         } else {
             _currentConicalViews = _conicalViews;
             currentViewFrustumChanged = true;
+            _lastViewsChange = usecTimestampNow();
         }
     }
 
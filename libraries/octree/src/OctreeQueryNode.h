@@ -96,6 +96,7 @@ private:
     quint64 _firstSuppressedPacket { usecTimestampNow() };
 
     ConicalViewFrustums _currentConicalViews;
+    quint64 _lastViewsChange { 0 }; // when _currentConicalViews were last updated
     bool _viewFrustumChanging { false };
     bool _viewFrustumJustStoppedChanging { true };
 
@@ -66,6 +66,11 @@ void OctreeSceneStats::copyFromOther(const OctreeSceneStats& other) {
     _bytes = other._bytes;
     _passes = other._passes;
 
+    _uncompressedBytes = other._uncompressedBytes;
+    _compressedBytes = other._compressedBytes;
+    _totalCompressTime = other._totalCompressTime;
+    _compressedWithDictionary = other._compressedWithDictionary;
+
     _totalElements = other._totalElements;
     _totalInternal = other._totalInternal;
     _totalLeaves = other._totalLeaves;
@@ -165,6 +170,11 @@ void OctreeSceneStats::reset() {
     _bytes = 0;
     _passes = 0;
 
+    _uncompressedBytes = 0;
+    _compressedBytes = 0;
+    _totalCompressTime = 0;
+    _compressedWithDictionary = false;
+
     _totalElements = 0;
     _totalInternal = 0;
     _totalLeaves = 0;
@@ -212,6 +222,13 @@ void OctreeSceneStats::packetSent(int bytes) {
     _bytes += bytes;
 }
 
+void OctreeSceneStats::sectionCompressed(int uncompressedBytes, int compressedBytes, quint64 usecs, bool withDictionary) {
+    _uncompressedBytes += uncompressedBytes;
+    _compressedBytes += compressedBytes;
+    _totalCompressTime += usecs;
+    _compressedWithDictionary = withDictionary;
+}
+
 void OctreeSceneStats::traversed(const OctreeElementPointer& element) {
     _traversed++;
     if (element->isLeaf()) {
@@ -335,6 +352,10 @@ int OctreeSceneStats::packIntoPacket() {
     _statsPacket->writePrimitive(_existsBitsWritten);
     _statsPacket->writePrimitive(_existsInPacketBitsWritten);
     _statsPacket->writePrimitive(_treesRemoved);
+    _statsPacket->writePrimitive(_uncompressedBytes);
+    _statsPacket->writePrimitive(_compressedBytes);
+    _statsPacket->writePrimitive(_totalCompressTime);
+    _statsPacket->writePrimitive(_compressedWithDictionary);
 
     return _statsPacket->getPayloadSize();
 }
@@ -397,6 +418,10 @@ int OctreeSceneStats::unpackFromPacket(ReceivedMessage& packet) {
     packet.readPrimitive(&_existsBitsWritten);
     packet.readPrimitive(&_existsInPacketBitsWritten);
     packet.readPrimitive(&_treesRemoved);
+    packet.readPrimitive(&_uncompressedBytes);
+    packet.readPrimitive(&_compressedBytes);
+    packet.readPrimitive(&_totalCompressTime);
+    packet.readPrimitive(&_compressedWithDictionary);
 
     // running averages
     _elapsedAverage.updateAverage((float)_elapsed);
@@ -454,6 +479,11 @@ void OctreeSceneStats::printDebugDetails() {
     qCDebug(octree) << "exists bits: " << _existsBitsWritten;
     qCDebug(octree) << "in packet bit: " << _existsInPacketBitsWritten;
     qCDebug(octree) << "trees removed: " << _treesRemoved;
+    qCDebug(octree);
+    qCDebug(octree) << "uncompressed bytes: " << _uncompressedBytes;
+    qCDebug(octree) << "compressed bytes: " << _compressedBytes;
+    qCDebug(octree) << "compress time: " << _totalCompressTime;
+    qCDebug(octree) << "with dictionary: " << debug::valueOf(_compressedWithDictionary);
 }
 
 OctreeSceneStats::ItemInfo OctreeSceneStats::_ITEMS[] = {
@@ -473,6 +503,7 @@ OctreeSceneStats::ItemInfo OctreeSceneStats::_ITEMS[] = {
     { "Skipped - Occluded", YELLOWISH, 3, "Total,Internal,Leaves" },
     { "Didn't fit in packet", GREYISH, 4, "Total,Internal,Leaves,Removed" },
     { "Mode", GREENISH, 4, "Moving,Stationary,Partial,Full" },
+    { "Compression", YELLOWISH, 3, "Ratio,usecs/Packet,Dictionary" },
 };
 
 const char* OctreeSceneStats::getItemValue(Item item) {
@@ -596,6 +627,14 @@ const char* OctreeSceneStats::getItemValue(Item item) {
                     (_isMoving ? "Moving" : "Stationary"));
             break;
         }
+        case ITEM_COMPRESSION: {
+            float ratio = _compressedBytes == 0 ? 0.0f : (float)_uncompressedBytes / (float)_compressedBytes;
+            float usecsPerPacket = _packets == 0 ? 0.0f : (float)_totalCompressTime / (float)_packets;
+            sprintf(_itemValueBuffer, "%.2f:1 (%lu to %lu bytes) %.0f usecs/packet - %s",
+                    (double)ratio, (long unsigned int)_uncompressedBytes, (long unsigned int)_compressedBytes,
+                    (double)usecsPerPacket, (_compressedWithDictionary ? "Dictionary" : "No Dictionary"));
+            break;
+        }
         default:
             break;
     }
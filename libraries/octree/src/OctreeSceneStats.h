@@ -49,6 +49,9 @@ public:
     /// Track that a packet was sent as part of the scene.
     void packetSent(int bytes);
 
+    /// Track that a data section of the scene was compressed from uncompressedBytes to compressedBytes in usecs
+    void sectionCompressed(int uncompressedBytes, int compressedBytes, quint64 usecs, bool withDictionary);
+
     /// Tracks the beginning of an encode pass during scene calculation.
     void encodeStarted();
 
@@ -120,6 +123,7 @@ public:
         ITEM_SKIPPED_OCCLUDED,
         ITEM_DIDNT_FIT,
         ITEM_MODE,
+        ITEM_COMPRESSION,
         ITEM_COUNT
     };
 
@@ -250,6 +254,12 @@ private:
     quint64 _bytes;
     quint32  _passes;
 
+    // compression of the data sections
+    quint64 _uncompressedBytes;
+    quint64 _compressedBytes;
+    quint64 _totalCompressTime;
+    bool _compressedWithDictionary;
+
     // incoming packets stats
     quint32 _incomingPacket;
     quint64 _incomingBytes;
@@ -0,0 +1,89 @@
+//
+//  OctreeSnapshot.h
+//  libraries/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_OctreeSnapshot_h
+#define overte_OctreeSnapshot_h
+
+#include <stdint.h>
+#include <string.h>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include <Packed.h>
+
+// Binary persist format for octrees, read in place from a memory mapped file.
+//
+//    Header
+//    chunk 0 .. chunk N-1   records of uint32_t length followed by the tree's wire encoding of one item
+//    Chunk[N]               index of the chunks, at Header::indexOffset
+//
+// Chunks are encoded and decoded independently of each other, so both can run in parallel.
+// The bitstream version is the one of the tree's data packet type: a snapshot written by another
+// version is not readable, and the json.gz persist remains the format for export and import.
+// All values are little-endian.
+namespace OctreeSnapshot {
+
+const QString EXTENSION = "bin";
+const char MAGIC[4] = { 'O', 'V', 'S', 'N' };
+const uint32_t FORMAT_VERSION = 1;
+
+PACKED_BEGIN struct Header {
+    char magic[4];
+    uint32_t formatVersion;
+    uint32_t bitstreamVersion;
+    int64_t dataVersion;
+    uint8_t id[16];
+    uint32_t numItems;
+    uint32_t numChunks;
+    uint64_t indexOffset;
+} PACKED_END;
+
+PACKED_BEGIN struct Chunk {
+    uint64_t offset;
+    uint32_t size;
+    uint32_t numItems;
+} PACKED_END;
+
+// Returns the header of the snapshot in data, or nullptr if data is not a snapshot of a format this build reads
+inline const Header* readHeader(const char* data, qint64 size) {
+    if (size < (qint64)sizeof(Header)) {
+        return nullptr;
+    }
+    auto header = reinterpret_cast<const Header*>(data);
+    if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->formatVersion != FORMAT_VERSION) {
+        return nullptr;
+    }
+    return header;
+}
+
+inline bool isSnapshot(const QByteArray& data) {
+    return readHeader(data.constData(), data.size()) != nullptr;
+}
+
+// Returns the chunk index of the snapshot, or nullptr if the index or any chunk lies outside of data
+inline const Chunk* readChunks(const char* data, qint64 size, const Header& header) {
+    uint64_t indexSize = (uint64_t)header.numChunks * sizeof(Chunk);
+    if (header.indexOffset < sizeof(Header) || header.indexOffset + indexSize > (uint64_t)size) {
+        return nullptr;
+    }
+    auto chunks = reinterpret_cast<const Chunk*>(data + header.indexOffset);
+    for (uint32_t i = 0; i < header.numChunks; ++i) {
+        if (chunks[i].offset < sizeof(Header) || chunks[i].offset + chunks[i].size > header.indexOffset) {
+            return nullptr;
+        }
+    }
+    return chunks;
+}
+
+}
+
+#endif // overte_OctreeSnapshot_h
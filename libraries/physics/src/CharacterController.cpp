@@ -11,6 +11,8 @@
 
 #include "CharacterController.h"
 
+#include <LinearMath/btQuickprof.h>
+
 #include <AvatarConstants.h>
 #include <NumericalConstants.h>
 #include <PhysicsCollisionGroups.h>
@@ -214,8 +216,19 @@ void CharacterController::addToWorld() {
 bool CharacterController::checkForSupport(btCollisionWorld* collisionWorld) {
     bool pushing = _targetVelocity.length2() > FLT_EPSILON;
 
-    btDispatcher* dispatcher = collisionWorld->getDispatcher();
-    int numManifolds = dispatcher->getNumManifolds();
+    BT_PROFILE("checkForSupport");
+    // the ghost overlaps everything the body can touch, so the manifolds of the body are found from the few pairs of the
+    // ghost rather than by walking all the manifolds of the world, which grow with the number of avatars and objects
+    if (!_ghost.getContactManifolds(_rigidBody, _supportManifolds)) {
+        btDispatcher* dispatcher = collisionWorld->getDispatcher();
+        int numManifolds = dispatcher->getNumManifolds();
+        for (int i = 0; i < numManifolds; i++) {
+            btPersistentManifold* contactManifold = dispatcher->getManifoldByIndexInternal(i);
+            if (_rigidBody == contactManifold->getBody1() || _rigidBody == contactManifold->getBody0()) {
+                _supportManifolds.push_back(contactManifold);
+            }
+        }
+    }
     bool hasFloor = false;
     bool probablyStuck = _isStuck && _appliedStuckRecoveryStrategy;
 
@@ -226,55 +239,53 @@ bool CharacterController::checkForSupport(btCollisionWorld* collisionWorld) {
     float strongestImpulse = 0.0f;
 
     _netCollisionImpulse = btVector3(0.0f, 0.0f, 0.0f);
-    for (int i = 0; i < numManifolds; i++) {
-        btPersistentManifold* contactManifold = dispatcher->getManifoldByIndexInternal(i);
-        if (_rigidBody == contactManifold->getBody1() || _rigidBody == contactManifold->getBody0()) {
-            bool characterIsFirst = _rigidBody == contactManifold->getBody0();
-            int numContacts = contactManifold->getNumContacts();
-            int stepContactIndex = -1;
-            bool stepValid = true;
-            float highestStep = _minStepHeight;
-            for (int j = 0; j < numContacts; j++) {
-                // check for "floor"
-                btManifoldPoint& contact = contactManifold->getContactPoint(j);
-                btVector3 pointOnCharacter = characterIsFirst ? contact.m_localPointA : contact.m_localPointB; // object-local-frame
-                btVector3 normal = characterIsFirst ? contact.m_normalWorldOnB : -contact.m_normalWorldOnB; // points toward character
-                btScalar hitHeight = _halfHeight + _radius + pointOnCharacter.dot(_currentUp);
-
-                float distance = contact.getDistance();
-                if (distance < deepestDistance) {
-                    deepestDistance = distance;
-                }
-                float impulse = contact.getAppliedImpulse();
-                _netCollisionImpulse += impulse * normal;
-                if (impulse > strongestImpulse) {
-                    strongestImpulse = impulse;
-                }
+    for (int i = 0; i < _supportManifolds.size(); i++) {
+        btPersistentManifold* contactManifold = _supportManifolds[i];
+        bool characterIsFirst = _rigidBody == contactManifold->getBody0();
+        int numContacts = contactManifold->getNumContacts();
+        int stepContactIndex = -1;
+        bool stepValid = true;
+        float highestStep = _minStepHeight;
+        for (int j = 0; j < numContacts; j++) {
+            // check for "floor"
+            btManifoldPoint& contact = contactManifold->getContactPoint(j);
+            btVector3 pointOnCharacter = characterIsFirst ? contact.m_localPointA : contact.m_localPointB; // object-local-frame
+            btVector3 normal = characterIsFirst ? contact.m_normalWorldOnB : -contact.m_normalWorldOnB; // points toward character
+            btScalar hitHeight = _halfHeight + _radius + pointOnCharacter.dot(_currentUp);
+
+            float distance = contact.getDistance();
+            if (distance < deepestDistance) {
+                deepestDistance = distance;
+            }
+            float impulse = contact.getAppliedImpulse();
+            _netCollisionImpulse += impulse * normal;
+            if (impulse > strongestImpulse) {
+                strongestImpulse = impulse;
+            }
 
-                if (hitHeight < _maxStepHeight && normal.dot(_currentUp) > _minFloorNormalDotUp) {
+            if (hitHeight < _maxStepHeight && normal.dot(_currentUp) > _minFloorNormalDotUp) {
+                hasFloor = true;
+            }
+            if (stepValid && pushing && _targetVelocity.dot(normal) < 0.0f) {
+                // remember highest step obstacle
+                if (!_stepUpEnabled || hitHeight > _maxStepHeight) {
+                    // this manifold is invalidated by point that is too high
+                    stepValid = false;
+                } else if (hitHeight > highestStep && normal.dot(_targetVelocity) < 0.0f ) {
+                    highestStep = hitHeight;
+                    stepContactIndex = j;
                     hasFloor = true;
                 }
-                if (stepValid && pushing && _targetVelocity.dot(normal) < 0.0f) {
-                    // remember highest step obstacle
-                    if (!_stepUpEnabled || hitHeight > _maxStepHeight) {
-                        // this manifold is invalidated by point that is too high
-                        stepValid = false;
-                    } else if (hitHeight > highestStep && normal.dot(_targetVelocity) < 0.0f ) {
-                        highestStep = hitHeight;
-                        stepContactIndex = j;
-                        hasFloor = true;
-                    }
-                }
-            }
-            if (stepValid && stepContactIndex > -1 && highestStep > _stepHeight) {
-                // remember step info for later
-                btManifoldPoint& contact = contactManifold->getContactPoint(stepContactIndex);
-                btVector3 pointOnCharacter = characterIsFirst ? contact.m_localPointA : contact.m_localPointB; // object-local-frame
-                _stepNormal = characterIsFirst ? contact.m_normalWorldOnB : -contact.m_normalWorldOnB; // points toward character
-                _stepHeight = highestStep;
-                _stepPoint = rotation * pointOnCharacter; // rotate into world-frame
             }
         }
+        if (stepValid && stepContactIndex > -1 && highestStep > _stepHeight) {
+            // remember step info for later
+            btManifoldPoint& contact = contactManifold->getContactPoint(stepContactIndex);
+            btVector3 pointOnCharacter = characterIsFirst ? contact.m_localPointA : contact.m_localPointB; // object-local-frame
+            _stepNormal = characterIsFirst ? contact.m_normalWorldOnB : -contact.m_normalWorldOnB; // points toward character
+            _stepHeight = highestStep;
+            _stepPoint = rotation * pointOnCharacter; // rotate into world-frame
+        }
     }
 
     // If there's deep penetration and big impulse we're probably stuck.
@@ -332,10 +343,16 @@ void CharacterController::preStep(btCollisionWorld* collisionWorld) {
     btScalar rayLength = _radius + FLOOR_PROXIMITY_THRESHOLD;
     btVector3 rayEnd = rayStart - rayLength * _currentUp;
 
-    // scan down for nearby floor
+    // scan down for nearby floor, the expanded Aabb of the ghost covers the ray so only the objects that overlap it are
+    // tested rather than the whole broadphase
+    BT_PROFILE("floorRayTest");
     ClosestNotMe rayCallback(_rigidBody);
     rayCallback.m_closestHitFraction = 1.0f;
-    collisionWorld->rayTest(rayStart, rayEnd, rayCallback);
+    if (_ghost.isInWorld()) {
+        _ghost.btGhostObject::rayTest(rayStart, rayEnd, rayCallback);
+    } else {
+        collisionWorld->rayTest(rayStart, rayEnd, rayCallback);
+    }
     if (rayCallback.hasHit()) {
         _floorDistance = rayLength * rayCallback.m_closestHitFraction - _radius;
     }
@@ -1083,6 +1100,8 @@ void CharacterController::preSimulation() {
     if (_rigidBody) {
         // slam body transform and remember velocity
         _rigidBody->setWorldTransform(btTransform(btTransform(_rotation, _position)));
+        // the overlaps of the ghost are found at its transform, it must follow the body when it's slammed
+        _ghost.setWorldTransform(_rigidBody->getWorldTransform());
         _preSimulationVelocity = _rigidBody->getLinearVelocity();
 
         updateState();
@@ -186,6 +186,7 @@ protected:
 
     std::vector<CharacterMotor> _motors;
     CharacterGhostObject _ghost;
+    btManifoldArray _supportManifolds; // kept between substeps so it doesn't reallocate
     btVector3 _currentUp;
     btVector3 _targetVelocity;
     btVector3 _parentVelocity;
@@ -30,9 +30,15 @@ CharacterGhostObject::~CharacterGhostObject() {
 }
 
 void CharacterGhostObject::setCollisionGroupAndMask(int32_t group, int32_t mask) {
-    _collisionFilterGroup = group;
-    _collisionFilterMask = mask;
-    // TODO: if this probe is in the world reset ghostObject overlap cache
+    if (group != _collisionFilterGroup || mask != _collisionFilterMask) {
+        _collisionFilterGroup = group;
+        _collisionFilterMask = mask;
+        // the overlaps are filtered by the broadphase, which only reads the group and mask when the ghost is added
+        if (_inWorld) {
+            removeFromWorld();
+            addToWorld();
+        }
+    }
 }
 
 void CharacterGhostObject::getCollisionGroupAndMask(int32_t& group, int32_t& mask) const {
@@ -82,6 +88,28 @@ void CharacterGhostObject::refreshOverlappingPairCache() {
     _world->getBroadphase()->setAabb(getBroadphaseHandle(), minAabb, maxAabb, _world->getDispatcher());
 }
 
+bool CharacterGhostObject::getContactManifolds(const btCollisionObject* body, btManifoldArray& manifolds) const {
+    manifolds.resize(0);
+    if (!_world || !_inWorld || !body->getBroadphaseHandle()) {
+        return false;
+    }
+    btOverlappingPairCache* pairCache = _world->getBroadphase()->getOverlappingPairCache();
+    btBroadphaseProxy* bodyProxy = const_cast<btBroadphaseProxy*>(body->getBroadphaseHandle());
+    const int numOverlaps = getNumOverlappingObjects();
+    for (int i = 0; i < numOverlaps; ++i) {
+        const btCollisionObject* other = getOverlappingObject(i);
+        if (other == body || !other->getBroadphaseHandle()) {
+            continue;
+        }
+        btBroadphasePair* pair = pairCache->findPair(bodyProxy, const_cast<btBroadphaseProxy*>(other->getBroadphaseHandle()));
+        if (pair && pair->m_algorithm) {
+            // appends to manifolds
+            pair->m_algorithm->getAllContactManifolds(manifolds);
+        }
+    }
+    return true;
+}
+
 void CharacterGhostObject::removeFromWorld() {
     if (_world && _inWorld) {
         _world->removeCollisionObject(this);
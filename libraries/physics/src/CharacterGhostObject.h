@@ -37,6 +37,7 @@ public:
     void setCharacterShape(btConvexHullShape* shape);
 
     void setCollisionWorld(btCollisionWorld* world);
+    bool isInWorld() const { return _inWorld; }
 
     bool rayTest(const btVector3& start,
             const btVector3& end,
@@ -44,6 +45,11 @@ public:
 
     void refreshOverlappingPairCache();
 
+    /// Collects the contact manifolds of body with the objects that overlap this ghost, from the pairs that the broadphase
+    /// already found, so that the character doesn't have to walk all the manifolds of the world.  Returns false if the
+    /// ghost isn't in the world, in which case manifolds is left empty.
+    bool getContactManifolds(const btCollisionObject* body, btManifoldArray& manifolds) const;
+
 protected:
     void removeFromWorld();
     void addToWorld();
@@ -0,0 +1,104 @@
+//
+//  ContactMap.cpp
+//  libraries/physics/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ContactMap.h"
+
+#include <cassert>
+
+static const uint32_t EMPTY_SLOT = UINT32_MAX;
+static const size_t MIN_NUM_SLOTS = 64;
+
+size_t ContactMap::getHomeSlot(const ContactKey& key) const {
+    // the pointers are aligned, their low bits don't tell them apart
+    uint64_t hash = (uint64_t)(uintptr_t)key._a * 0x9e3779b97f4a7c15ULL ^ (uint64_t)(uintptr_t)key._b * 0xc2b2ae3d27d4eb4fULL;
+    hash ^= hash >> 29;
+    return (size_t)hash & (_slots.size() - 1);
+}
+
+size_t ContactMap::findSlot(const ContactKey& key) const {
+    const size_t mask = _slots.size() - 1;
+    size_t slot = getHomeSlot(key);
+    while (_slots[slot] != EMPTY_SLOT && !(_entries[_slots[slot]].key == key)) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void ContactMap::rehash(size_t numSlots) {
+    _slots.assign(numSlots, EMPTY_SLOT);
+    const size_t mask = numSlots - 1;
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        size_t slot = getHomeSlot(_entries[i].key);
+        while (_slots[slot] != EMPTY_SLOT) {
+            slot = (slot + 1) & mask;
+        }
+        _slots[slot] = (uint32_t)i;
+    }
+}
+
+ContactInfo* ContactMap::find(const ContactKey& key) {
+    if (_entries.empty()) {
+        return nullptr;
+    }
+    uint32_t index = _slots[findSlot(key)];
+    return index == EMPTY_SLOT ? nullptr : &(_entries[index].info);
+}
+
+ContactInfo& ContactMap::operator[](const ContactKey& key) {
+    // the table is kept at most half full, so that the probes stay short
+    if (2 * (_entries.size() + 1) > _slots.size()) {
+        rehash(_slots.empty() ? MIN_NUM_SLOTS : 2 * _slots.size());
+    }
+    size_t slot = findSlot(key);
+    if (_slots[slot] == EMPTY_SLOT) {
+        _slots[slot] = (uint32_t)_entries.size();
+        _entries.emplace_back(key);
+    }
+    return _entries[_slots[slot]].info;
+}
+
+void ContactMap::eraseAt(size_t index) {
+    assert(index < _entries.size());
+    const size_t mask = _slots.size() - 1;
+
+    // shift back the contacts that follow in the probe sequence, so that no tombstone is left in the table
+    size_t hole = findSlot(_entries[index].key);
+    size_t slot = hole;
+    while (true) {
+        slot = (slot + 1) & mask;
+        if (_slots[slot] == EMPTY_SLOT) {
+            break;
+        }
+        // the contact stays if its home slot is cyclically in (hole, slot]
+        size_t home = getHomeSlot(_entries[_slots[slot]].key);
+        bool stays = hole <= slot ? (hole < home && home <= slot) : (hole < home || home <= slot);
+        if (!stays) {
+            _slots[hole] = _slots[slot];
+            hole = slot;
+        }
+    }
+    _slots[hole] = EMPTY_SLOT;
+
+    // move the last contact into the erased one
+    size_t last = _entries.size() - 1;
+    if (index != last) {
+        _slots[findSlot(_entries[last].key)] = (uint32_t)index;
+        _entries[index] = _entries[last];
+    }
+    _entries.pop_back();
+}
+
+void ContactMap::clear() {
+    _entries.clear();
+    if (!_slots.empty()) {
+        _slots.assign(_slots.size(), EMPTY_SLOT);
+    }
+}
@@ -0,0 +1,80 @@
+//
+//  ContactMap.h
+//  libraries/physics/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ContactMap_h
+#define overte_ContactMap_h
+
+#include <cstdint>
+#include <vector>
+
+#include "ContactInfo.h"
+
+// simple class for keeping track of contacts
+class ContactKey {
+public:
+    ContactKey() = delete;
+    ContactKey(void* a, void* b) : _a(a), _b(b) {}
+    bool operator<(const ContactKey& other) const { return _a < other._a || (_a == other._a && _b < other._b); }
+    bool operator==(const ContactKey& other) const { return _a == other._a && _b == other._b; }
+    void* _a; // ObjectMotionState pointer
+    void* _b; // ObjectMotionState pointer
+};
+
+/// The contacts between pairs of bodies, in a flat open addressing table.  The contacts are stored contiguously and
+/// looked up through a table of their indices by linear probing, so that updating them every step doesn't allocate once the
+/// table has grown to the number of contacts, and walking them is walking an array.  Erasing a contact moves the last one
+/// in its place, so the contacts can be erased while they're walked by index, without advancing past the erased one.
+class ContactMap {
+public:
+    struct Entry {
+        Entry(const ContactKey& k) : key(k) {}
+        ContactKey key;
+        ContactInfo info;
+    };
+
+    /// Returns the contact of key, added if it wasn't there
+    ContactInfo& operator[](const ContactKey& key);
+    /// Returns the contact of key, or nullptr
+    ContactInfo* find(const ContactKey& key);
+
+    size_t size() const { return _entries.size(); }
+    bool empty() const { return _entries.empty(); }
+    Entry& at(size_t index) { return _entries[index]; }
+    const Entry& at(size_t index) const { return _entries[index]; }
+
+    /// Erases the contact at index, replacing it with the last one
+    void eraseAt(size_t index);
+    void clear();
+
+    /// Erases the contacts for which predicate(entry) returns true
+    template <typename Predicate>
+    void eraseIf(Predicate predicate) {
+        size_t i = 0;
+        while (i < _entries.size()) {
+            if (predicate(_entries[i])) {
+                eraseAt(i);
+            } else {
+                ++i;
+            }
+        }
+    }
+
+private:
+    size_t getHomeSlot(const ContactKey& key) const;
+    size_t findSlot(const ContactKey& key) const;
+    void rehash(size_t numSlots);
+
+    std::vector<Entry> _entries;
+    // the index in _entries of the contact in each slot, or EMPTY_SLOT
+    std::vector<uint32_t> _slots;
+};
+
+#endif // overte_ContactMap_h
@@ -12,12 +12,38 @@
 
 #include "PhysicalEntitySimulation.h"
 
+#include <algorithm>
+
 #include <Profile.h>
 
 #include "PhysicsHelpers.h"
 #include "PhysicsLogging.h"
 #include "ShapeManager.h"
 
+// how long the entities that leave the physical regions are parked before they're removed from the PhysicsEngine
+static const uint64_t PARKED_ENTITY_TIMEOUT = 10 * USECS_PER_SECOND;
+// the physics updates and ownership bids sent to the entity server are capped at this rate, with bursts of at most
+// MAX_UPDATE_BURST, the owned entities that are due an update when the budget runs out wait for the next steps
+static const float MAX_UPDATES_PER_SECOND = 1000.0f;
+static const float MAX_UPDATE_BURST = 100.0f;
+
+// the priority of the update of an owned entity, that grows with the time since its last update and faster in the regions
+// nearer to the avatar, the entities that came to rest send their final transforms before the others
+static float computeUpdatePriority(const EntityMotionState* motionState, uint64_t now) {
+    const float REST_PRIORITY = 1.0e9f;
+    if (!motionState->isActive()) {
+        return REST_PRIORITY;
+    }
+    float age = (float)(now - glm::min(now, motionState->getEntity()->getLastBroadcast()));
+    switch (motionState->getRegion()) {
+        case workload::Region::R1:
+            return 4.0f * age;
+        case workload::Region::R2:
+            return 2.0f * age;
+        default:
+            return age;
+    }
+}
 
 PhysicalEntitySimulation::PhysicalEntitySimulation() {
 }
@@ -135,17 +161,25 @@ void PhysicalEntitySimulation::processChangedEntity(const EntityItemPointer& ent
                 motionState->sendUpdate(_entityPacketSender, _physicsEngine->getNumSubsteps());
             }
 
-            // remove from the physical simulation
+            // remove from the physical simulation, or park it there if it may come back
             _incomingChanges.remove(motionState);
             removeOwnershipData(motionState);
-            _entitiesToRemoveFromPhysics.insert(entity);
-            if (canBeKinematic && entity->isMovingRelativeToParent()) {
-                SetOfEntities::iterator itr = _simpleKinematicEntities.find(entity);
-                if (itr == _simpleKinematicEntities.end()) {
-                    _simpleKinematicEntities.insert(entity);
+            if (canPark(entity, motionState, region)) {
+                parkEntity(entity, motionState);
+            } else {
+                _parkedEntities.remove(entity);
+                _entitiesToRemoveFromPhysics.insert(entity);
+                if (canBeKinematic && entity->isMovingRelativeToParent()) {
+                    SetOfEntities::iterator itr = _simpleKinematicEntities.find(entity);
+                    if (itr == _simpleKinematicEntities.end()) {
+                        _simpleKinematicEntities.insert(entity);
+                    }
                 }
             }
         } else {
+            if (_parkedEntities.contains(entity)) {
+                unparkEntity(entity, motionState);
+            }
             _incomingChanges.insert(motionState);
         }
         motionState->setRegion(region);
@@ -224,6 +258,7 @@ void PhysicalEntitySimulation::clearEntities() {
     _physicalObjects.clear();
 
     // clear all other lists specific to this derived class
+    _parkedEntities.clear();
     _entitiesToRemoveFromPhysics.clear();
     _entitiesToAddToPhysics.clear();
     _incomingChanges.clear();
@@ -259,6 +294,34 @@ void PhysicalEntitySimulation::removeDeadEntities() {
 }
 // end EntitySimulation overrides
 
+bool PhysicalEntitySimulation::canPark(const EntityItemPointer& entity, EntityMotionState* motionState, uint8_t region) const {
+    // the entities that move are animated kinematically outside of the physical regions, and the pending changes
+    // can't be applied to a parked body, so these are removed as before
+    return region == workload::Region::R3 && entity->shouldBePhysical() && !entity->isMovingRelativeToParent() &&
+        motionState->getIncomingDirtyFlags() == 0;
+}
+
+void PhysicalEntitySimulation::parkEntity(const EntityItemPointer& entity, EntityMotionState* motionState) {
+    if (_parkedEntities.contains(entity)) {
+        return;
+    }
+    // a disabled body stays in the broadphase but isn't simulated and can't be woken by the bodies it touches
+    btRigidBody* body = motionState->getRigidBody();
+    if (body && !body->isStaticObject()) {
+        body->forceActivationState(DISABLE_SIMULATION);
+    }
+    _parkedEntities.insert(entity, usecTimestampNow() + PARKED_ENTITY_TIMEOUT);
+}
+
+void PhysicalEntitySimulation::unparkEntity(const EntityItemPointer& entity, EntityMotionState* motionState) {
+    _parkedEntities.remove(entity);
+    btRigidBody* body = motionState->getRigidBody();
+    if (body && !body->isStaticObject()) {
+        body->forceActivationState(ACTIVE_TAG);
+    }
+    ++_numUnparkedEntities;
+}
+
 void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
     // this lambda for when we decide to actually build the motionState
     auto buildMotionState = [&](btCollisionShape* shape, EntityItemPointer entity) {
@@ -393,8 +456,23 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
 
 void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transaction& transaction) {
     QMutexLocker lock(&_mutex);
+    // parked entities that didn't come back in time
+    if (!_parkedEntities.empty()) {
+        uint64_t now = usecTimestampNow();
+        auto parkedItr = _parkedEntities.begin();
+        while (parkedItr != _parkedEntities.end()) {
+            if (parkedItr.value() < now) {
+                _entitiesToRemoveFromPhysics.insert(parkedItr.key());
+                parkedItr = _parkedEntities.erase(parkedItr);
+            } else {
+                ++parkedItr;
+            }
+        }
+    }
+
     // entities being removed
     for (auto entity : _entitiesToRemoveFromPhysics) {
+        _parkedEntities.remove(entity);
         EntityMotionState* motionState = static_cast<EntityMotionState*>(entity->getPhysicsInfo());
         if (motionState) {
             transaction.objectsToRemove.push_back(motionState);
@@ -487,6 +565,9 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
         object->clearIncomingDirtyFlags(handledFlags);
     }
     _incomingChanges.clear();
+
+    _numAddedToPhysics = (uint32_t)transaction.objectsToAdd.size();
+    _numRemovedFromPhysics = (uint32_t)transaction.objectsToRemove.size();
 }
 
 void PhysicalEntitySimulation::handleProcessedPhysicsTransaction(PhysicsEngine::Transaction& transaction) {
@@ -494,6 +575,7 @@ void PhysicalEntitySimulation::handleProcessedPhysicsTransaction(PhysicsEngine::
     for (auto object : transaction.objectsToRemove) {
         EntityMotionState* entityState = static_cast<EntityMotionState*>(object);
         removeOwnershipData(entityState);
+        _parkedEntities.remove(entityState->getEntity());
         _physicalObjects.remove(object);
         delete object;
     }
@@ -566,8 +648,21 @@ void PhysicalEntitySimulation::handleChangedMotionStates(const VectorOfMotionSta
             clearOwnershipData();
         }
         // send updates before bids, because this simplifies the logic thasuccessful bids will immediately send an update when added to the 'owned' list
+        uint64_t now = usecTimestampNow();
+        if (_lastUpdateBudgetTime == 0) {
+            _updateBudget = MAX_UPDATE_BURST;
+        } else {
+            _updateBudget += MAX_UPDATES_PER_SECOND * (float)(now - _lastUpdateBudgetTime) / (float)USECS_PER_SECOND;
+            _updateBudget = glm::min(_updateBudget, MAX_UPDATE_BURST);
+        }
+        _lastUpdateBudgetTime = now;
+
         sendOwnedUpdates(numSubsteps);
         sendOwnershipBids(numSubsteps);
+
+        // the updates and bids of this step go to the entity server together, packed in as few packets as they fit in,
+        // rather than waiting for the packets to fill up or for a script to release them
+        _entityPacketSender->releaseQueuedMessages();
     }
 }
 
@@ -604,6 +699,7 @@ void PhysicalEntitySimulation::sendOwnershipBids(uint32_t numSubsteps) {
                 // "telling" the server rather than what we've been "hearing" from the server.
                 _bids[i]->slaveBidPriority();
                 _bids[i]->sendUpdate(_entityPacketSender, numSubsteps);
+                _updateBudget -= 1.0f;
 
                 addOwnership(_bids[i]);
                 removeBid = true;
@@ -616,6 +712,7 @@ void PhysicalEntitySimulation::sendOwnershipBids(uint32_t numSubsteps) {
             } else {
                 if (now > _bids[i]->getNextBidExpiry()) {
                     _bids[i]->sendBid(_entityPacketSender, numSubsteps);
+                    _updateBudget -= 1.0f;
                     _nextBidExpiry = glm::min(_nextBidExpiry, _bids[i]->getNextBidExpiry());
                 }
                 ++i;
@@ -629,6 +726,8 @@ void PhysicalEntitySimulation::sendOwnedUpdates(uint32_t numSubsteps) {
         return;
     }
     PROFILE_RANGE_EX(simulation_physics, "Update", 0x00000000, (uint64_t)_owned.size());
+    uint64_t now = usecTimestampNow();
+    _updatesToSend.clear();
     uint32_t i = 0;
     while (i < _owned.size()) {
         if (!_owned[i]->isLocallyOwned()) {
@@ -640,11 +739,25 @@ void PhysicalEntitySimulation::sendOwnedUpdates(uint32_t numSubsteps) {
             _owned.remove(i);
         } else {
             if (_owned[i]->shouldSendUpdate(numSubsteps)) {
-                _owned[i]->sendUpdate(_entityPacketSender, numSubsteps);
+                _updatesToSend.push_back({ computeUpdatePriority(_owned[i], now), _owned[i] });
             }
             ++i;
         }
     }
+
+    // the updates that don't fit in the budget are still due next step, where they'll have waited longer
+    size_t numToSend = std::min(_updatesToSend.size(), (size_t)glm::max(_updateBudget, 0.0f));
+    if (numToSend < _updatesToSend.size()) {
+        std::nth_element(_updatesToSend.begin(), _updatesToSend.begin() + numToSend, _updatesToSend.end(),
+            [](const std::pair<float, EntityMotionState*>& a, const std::pair<float, EntityMotionState*>& b) {
+                return a.first > b.first;
+            });
+    }
+    for (size_t j = 0; j < numToSend; ++j) {
+        _updatesToSend[j].second->sendUpdate(_entityPacketSender, numSubsteps);
+    }
+    _updateBudget -= (float)numToSend;
+    _numDeferredUpdates = (uint32_t)(_updatesToSend.size() - numToSend);
 }
 
 void PhysicalEntitySimulation::handleCollisionEvents(const CollisionEvents& collisionEvents) {
@@ -94,6 +94,15 @@ public:
 
     EntityEditPacketSender* getPacketSender() { return _entityPacketSender; }
 
+    uint32_t getNumParkedEntities() const { return (uint32_t)_parkedEntities.size(); }
+    // the numbers of entities added to and removed from the PhysicsEngine by the last transaction
+    uint32_t getNumAddedToPhysics() const { return _numAddedToPhysics; }
+    uint32_t getNumRemovedFromPhysics() const { return _numRemovedFromPhysics; }
+    // the number of parked entities that came back to the physical regions, rather than being added again, since the start
+    uint32_t getNumUnparkedEntities() const { return _numUnparkedEntities; }
+    // the number of owned entities that were due an update in the last step but were left for later by the send budget
+    uint32_t getNumDeferredUpdates() const { return _numDeferredUpdates; }
+
     void addOwnershipBid(EntityMotionState* motionState);
     void addOwnership(EntityMotionState* motionState);
     void sendOwnershipBids(uint32_t numSubsteps);
@@ -102,6 +111,10 @@ public:
 private:
     void buildMotionStatesForEntitiesThatNeedThem();
 
+    bool canPark(const EntityItemPointer& entity, EntityMotionState* motionState, uint8_t region) const;
+    void parkEntity(const EntityItemPointer& entity, EntityMotionState* motionState);
+    void unparkEntity(const EntityItemPointer& entity, EntityMotionState* motionState);
+
     class ShapeRequest {
     public:
         ShapeRequest() { }
@@ -115,6 +128,9 @@ private:
     SetOfEntities _entitiesToRemoveFromPhysics;
     SetOfEntityMotionStates _incomingChanges; // EntityMotionStates changed by external events
     SetOfMotionStates _physicalObjects; // MotionStates of entities in PhysicsEngine
+    // Entities at rest that left the physical regions, kept in the PhysicsEngine with their simulation disabled until
+    // they expire, so that crossing back and forth over the edge of R2 doesn't remove and add them every time
+    QHash<EntityItemPointer, uint64_t> _parkedEntities; // expiry in usecs
 
     using ShapeRequests = std::set<ShapeRequest>;
     ShapeRequests _shapeRequests;
@@ -124,6 +140,10 @@ private:
 
     VectorOfEntityMotionStates _owned;
     VectorOfEntityMotionStates _bids;
+    // the owned entities due an update this step, with their priorities, kept to not reallocate it every step
+    std::vector<std::pair<float, EntityMotionState*>> _updatesToSend;
+    float _updateBudget { 0.0f }; // the number of updates and bids that can be sent before the budget refills
+    uint64_t _lastUpdateBudgetTime { 0 };
     SetOfEntities _deadAvatarEntities; // to remove from Avatar's lists
     std::vector<EntityItemPointer> _entitiesToDeleteLater;
 
@@ -135,6 +155,10 @@ private:
     uint64_t _nextBidExpiry;
     uint32_t _lastStepSendPackets { 0 };
     uint32_t _lastWorkDeliveryCount { 0 };
+    uint32_t _numAddedToPhysics { 0 };
+    uint32_t _numRemovedFromPhysics { 0 };
+    uint32_t _numUnparkedEntities { 0 };
+    uint32_t _numDeferredUpdates { 0 };
 };
 
 
@@ -12,21 +12,29 @@
 #include "PhysicsEngine.h"
 
 #include <functional>
+#include <unordered_set>
 
 #include <QFile>
+#include <QProcessEnvironment>
 
 #include <PerfStat.h>
 #include <PhysicsCollisionGroups.h>
 #include <Profile.h>
 #include <BulletCollision/CollisionShapes/btTriangleShape.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
 
 #include "CharacterController.h"
 #include "ObjectMotionState.h"
 #include "PhysicsHelpers.h"
 #include "PhysicsDebugDraw.h"
+#include "PhysicsRecorder.h"
+#include "PhysicsTaskScheduler.h"
 #include "ThreadSafeDynamicsWorld.h"
 #include "PhysicsLogging.h"
 
+// set to step the simulation on the TBB worker threads
+static const QString PHYSICS_MULTITHREADED_ENV = "HIFI_PHYSICS_MULTITHREADED";
+
 PhysicsEngine::PhysicsEngine(const glm::vec3& offset) :
         _originOffset(offset),
         _myAvatarController(nullptr) {
@@ -38,17 +46,34 @@ PhysicsEngine::~PhysicsEngine() {
     delete _collisionDispatcher;
     delete _broadphaseFilter;
     delete _constraintSolver;
+    delete _constraintSolverMt;
     delete _dynamicsWorld;
     delete _ghostPairCallback;
+    if (_taskScheduler && btGetTaskScheduler() == _taskScheduler.get()) {
+        btSetTaskScheduler(btGetSequentialTaskScheduler());
+    }
 }
 
 void PhysicsEngine::init() {
     if (!_dynamicsWorld) {
         _collisionConfig = new btDefaultCollisionConfiguration();
+        // the narrowphase stays on this thread in either mode: gContactAddedCallback, see setContactAddedCallback,
+        // isn't thread safe
         _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
         _broadphaseFilter = new btDbvtBroadphase();
-        _constraintSolver = new btSequentialImpulseConstraintSolver;
-        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
+        static const bool isMultithreaded = QProcessEnvironment::systemEnvironment().contains(PHYSICS_MULTITHREADED_ENV);
+        if (isMultithreaded) {
+            // the islands are solved in parallel, and the integration and prediction of the bodies run in parallel loops
+            _taskScheduler.reset(new PhysicsTaskScheduler());
+            btSetTaskScheduler(_taskScheduler.get());
+            _constraintSolver = new btConstraintSolverPoolMt(_taskScheduler->getNumThreads());
+            _constraintSolverMt = new btSequentialImpulseConstraintSolverMt();
+            qCDebug(physics) << "Stepping the simulation on" << _taskScheduler->getNumThreads() << "threads";
+        } else {
+            _constraintSolver = new btConstraintSolverPoolMt(1);
+        }
+        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver,
+                                                     _constraintSolverMt, _collisionConfig);
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
         // hook up debug draw renderer
@@ -182,9 +207,7 @@ QList<EntityDynamicPointer> PhysicsEngine::removeDynamicsForBody(btRigidBody* bo
 
 void PhysicsEngine::removeObjects(const VectorOfMotionStates& objects) {
     // bump and prune contacts for all objects in the list
-    for (auto object : objects) {
-        bumpAndPruneContacts(object);
-    }
+    bumpAndPruneContacts(std::vector<ObjectMotionState*>(objects.begin(), objects.end()));
 
     if (_activeStaticBodies.size() > 0) {
         // _activeStaticBodies was not cleared last frame.
@@ -252,8 +275,8 @@ void PhysicsEngine::reinsertObject(ObjectMotionState* object) {
 
 void PhysicsEngine::processTransaction(PhysicsEngine::Transaction& transaction) {
     // removes
+    bumpAndPruneContacts(transaction.objectsToRemove);
     for (auto object : transaction.objectsToRemove) {
-        bumpAndPruneContacts(object);
         btRigidBody* body = object->getRigidBody();
         if (body) {
             if (body->isStaticObject() && _activeStaticBodies.size() > 0) {
@@ -278,8 +301,13 @@ void PhysicsEngine::processTransaction(PhysicsEngine::Transaction& transaction)
     }
 
     // reinserts
+    bumpAndPruneContacts(transaction.objectsToReinsert);
     for (auto object : transaction.objectsToReinsert) {
-        reinsertObject(object);
+        btRigidBody* body = object->getRigidBody();
+        if (body) {
+            _dynamicsWorld->removeRigidBody(body);
+            addObjectToDynamicsWorld(object);
+        }
     }
 
     for (auto object : transaction.activeStaticObjects) {
@@ -291,17 +319,19 @@ void PhysicsEngine::processTransaction(PhysicsEngine::Transaction& transaction)
 
 void PhysicsEngine::removeContacts(ObjectMotionState* motionState) {
     // trigger events for new/existing/old contacts
-    ContactMap::iterator contactItr = _contactMap.begin();
-    while (contactItr != _contactMap.end()) {
-        if (contactItr->first._a == motionState || contactItr->first._b == motionState) {
-            contactItr = _contactMap.erase(contactItr);
-        } else {
-            ++contactItr;
-        }
-    }
+    _contactMap.eraseIf([motionState](const ContactMap::Entry& entry) {
+        return entry.key._a == motionState || entry.key._b == motionState;
+    });
 }
 
 void PhysicsEngine::stepSimulation() {
+    const float MAX_TIMESTEP = (float)PHYSICS_ENGINE_MAX_NUM_SUBSTEPS * PHYSICS_ENGINE_FIXED_SUBSTEP;
+    float dt = 1.0e-6f * (float)(_clock.getTimeMicroseconds());
+    _clock.reset();
+    stepSimulation(btMin(dt, MAX_TIMESTEP));
+}
+
+void PhysicsEngine::stepSimulation(float timeStep) {
     CProfileManager::Reset();
     BT_PROFILE("stepSimulation");
     // NOTE: the grand order of operations is:
@@ -310,10 +340,9 @@ void PhysicsEngine::stepSimulation() {
     // (3) synchronize outgoing motion states
     // (4) send outgoing packets
 
-    const float MAX_TIMESTEP = (float)PHYSICS_ENGINE_MAX_NUM_SUBSTEPS * PHYSICS_ENGINE_FIXED_SUBSTEP;
-    float dt = 1.0e-6f * (float)(_clock.getTimeMicroseconds());
-    _clock.reset();
-    float timeStep = btMin(dt, MAX_TIMESTEP);
+    if (_recorder) {
+        _recorder->recordChanges(*_dynamicsWorld);
+    }
 
     auto onSubStep = [this]() {
         this->updateContactMap();
@@ -322,6 +351,9 @@ void PhysicsEngine::stepSimulation() {
 
     int numSubsteps = _dynamicsWorld->stepSimulationWithSubstepCallback(timeStep, PHYSICS_ENGINE_MAX_NUM_SUBSTEPS,
                                                                         PHYSICS_ENGINE_FIXED_SUBSTEP, onSubStep);
+    if (_recorder) {
+        _recorder->recordStep(*_dynamicsWorld, timeStep);
+    }
     if (numSubsteps > 0) {
         _hasOutgoingChanges = true;
         if (_physicsDebugDraw->getDebugMode()) {
@@ -550,17 +582,17 @@ const CollisionEvents& PhysicsEngine::getCollisionEvents() {
     _collisionEvents.clear();
 
     // scan known contacts and trigger events
-    ContactMap::iterator contactItr = _contactMap.begin();
-
-    while (contactItr != _contactMap.end()) {
-        ContactInfo& contact = contactItr->second;
+    size_t i = 0;
+    while (i < _contactMap.size()) {
+        ContactMap::Entry& entry = _contactMap.at(i);
+        ContactInfo& contact = entry.info;
         ContactEventType type = contact.computeType(_numContactFrames);
         const btScalar SIGNIFICANT_DEPTH = -0.002f; // penetrations have negative distance
         if (type != CONTACT_EVENT_TYPE_CONTINUE ||
                 (contact.distance < SIGNIFICANT_DEPTH &&
                  contact.readyForContinue(_numContactFrames))) {
-            ObjectMotionState* motionStateA = static_cast<ObjectMotionState*>(contactItr->first._a);
-            ObjectMotionState* motionStateB = static_cast<ObjectMotionState*>(contactItr->first._b);
+            ObjectMotionState* motionStateA = static_cast<ObjectMotionState*>(entry.key._a);
+            ObjectMotionState* motionStateB = static_cast<ObjectMotionState*>(entry.key._b);
 
             // NOTE: the MyAvatar RigidBody is the only object in the simulation that does NOT have a MotionState
             // which means should we ever want to report ALL collision events against the avatar we can
@@ -595,9 +627,10 @@ const CollisionEvents& PhysicsEngine::getCollisionEvents() {
         }
 
         if (type == CONTACT_EVENT_TYPE_END) {
-            contactItr = _contactMap.erase(contactItr);
+            // the last contact takes its place, and is looked at next
+            _contactMap.eraseAt(i);
         } else {
-            ++contactItr;
+            ++i;
         }
     }
     return _collisionEvents;
@@ -644,6 +677,17 @@ void PhysicsEngine::saveNextPhysicsStats(QString filename) {
     _statsFilename = filename;
 }
 
+void PhysicsEngine::startRecording(const QString& filename) {
+    _recorder = std::make_unique<PhysicsRecorder>(filename);
+    if (!_recorder->isValid()) {
+        _recorder.reset();
+    }
+}
+
+void PhysicsEngine::stopRecording() {
+    _recorder.reset();
+}
+
 // Bullet collision flags are as follows:
 // CF_STATIC_OBJECT= 1,
 // CF_KINEMATIC_OBJECT= 2,
@@ -654,38 +698,52 @@ void PhysicsEngine::saveNextPhysicsStats(QString filename) {
 // CF_DISABLE_SPU_COLLISION_PROCESSING = 64//disable parallel/SPU processing
 
 void PhysicsEngine::bumpAndPruneContacts(ObjectMotionState* motionState) {
-    // Find all objects that touch the object corresponding to motionState and flag the other objects
-    // for simulation ownership by the local simulation.
-
     assert(motionState);
-    btCollisionObject* object = motionState->getRigidBody();
-
+    bumpAndPruneContacts(std::vector<ObjectMotionState*>({ motionState }));
+}
+
+void PhysicsEngine::bumpAndPruneContacts(const std::vector<ObjectMotionState*>& motionStates) {
+    // Find all objects that touch the objects corresponding to motionStates and flag the other objects
+    // for simulation ownership by the local simulation.  The manifolds and the contacts are walked once for all of
+    // the objects, rather than once per object, so that many objects can leave the simulation in the same frame.
+    if (motionStates.empty()) {
+        return;
+    }
+    std::unordered_set<const btCollisionObject*> objects;
+    std::unordered_set<const void*> states;
+    for (auto motionState : motionStates) {
+        assert(motionState);
+        objects.insert(motionState->getRigidBody());
+        states.insert(motionState);
+    }
+
+    auto bump = [](const btCollisionObject* other) {
+        if (!other->isStaticOrKinematicObject()) {
+            ObjectMotionState* otherMotionState = static_cast<ObjectMotionState*>(other->getUserPointer());
+            if (otherMotionState) {
+                otherMotionState->bump(VOLUNTEER_SIMULATION_PRIORITY);
+                other->setActivationState(ACTIVE_TAG);
+            }
+        }
+    };
     int numManifolds = _collisionDispatcher->getNumManifolds();
     for (int i = 0; i < numManifolds; ++i) {
         btPersistentManifold* contactManifold =  _collisionDispatcher->getManifoldByIndexInternal(i);
         if (contactManifold->getNumContacts() > 0) {
             const btCollisionObject* objectA = static_cast<const btCollisionObject*>(contactManifold->getBody0());
             const btCollisionObject* objectB = static_cast<const btCollisionObject*>(contactManifold->getBody1());
-            if (objectB == object) {
-                if (!objectA->isStaticOrKinematicObject()) {
-                    ObjectMotionState* motionStateA = static_cast<ObjectMotionState*>(objectA->getUserPointer());
-                    if (motionStateA) {
-                        motionStateA->bump(VOLUNTEER_SIMULATION_PRIORITY);
-                        objectA->setActivationState(ACTIVE_TAG);
-                    }
-                }
-            } else if (objectA == object) {
-                if (!objectB->isStaticOrKinematicObject()) {
-                    ObjectMotionState* motionStateB = static_cast<ObjectMotionState*>(objectB->getUserPointer());
-                    if (motionStateB) {
-                        motionStateB->bump(VOLUNTEER_SIMULATION_PRIORITY);
-                        objectB->setActivationState(ACTIVE_TAG);
-                    }
-                }
+            if (objects.find(objectB) != objects.end()) {
+                bump(objectA);
+            }
+            if (objects.find(objectA) != objects.end()) {
+                bump(objectB);
             }
         }
     }
-    removeContacts(motionState);
+
+    _contactMap.eraseIf([&states](const ContactMap::Entry& entry) {
+        return states.find(entry.key._a) != states.end() || states.find(entry.key._b) != states.end();
+    });
 }
 
 void PhysicsEngine::setCharacterController(CharacterController* character) {
@@ -21,7 +21,7 @@
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 
 #include "BulletUtil.h"
-#include "ContactInfo.h"
+#include "ContactMap.h"
 #include "ObjectMotionState.h"
 #include "ThreadSafeDynamicsWorld.h"
 #include "ObjectAction.h"
@@ -31,17 +31,8 @@ const float HALF_SIMULATION_EXTENT = 512.0f; // meters
 
 class CharacterController;
 class PhysicsDebugDraw;
-
-// simple class for keeping track of contacts
-class ContactKey {
-public:
-    ContactKey() = delete;
-    ContactKey(void* a, void* b) : _a(a), _b(b) {}
-    bool operator<(const ContactKey& other) const { return _a < other._a || (_a == other._a && _b < other._b); }
-    bool operator==(const ContactKey& other) const { return _a == other._a && _b == other._b; }
-    void* _a; // ObjectMotionState pointer
-    void* _b; // ObjectMotionState pointer
-};
+class PhysicsRecorder;
+class PhysicsTaskScheduler;
 
 struct ContactTestResult {
     ContactTestResult() = delete;
@@ -69,7 +60,6 @@ struct ContactTestResult {
     glm::vec3 collisionNormal;
 };
 
-using ContactMap = std::map<ContactKey, ContactInfo>;
 using CollisionEvents = std::vector<Collision>;
 
 class PhysicsEngine {
@@ -109,6 +99,8 @@ public:
     void processTransaction(Transaction& transaction);
 
     void stepSimulation();
+    /// Steps the simulation by timeStep rather than by the time since the last step, to replay a recording
+    void stepSimulation(float timeStep);
     void harvestPerformanceStats();
     void printPerformanceStatsToFile(const QString& filename);
     void updateContactMap();
@@ -129,6 +121,11 @@ public:
     /// \brief saves timings for last frame in filename
     void saveNextPhysicsStats(QString filename);
 
+    /// \brief records the bodies and the steps of the simulation in filename, for the physics-player tool to replay them
+    void startRecording(const QString& filename);
+    void stopRecording();
+    bool isRecording() const { return (bool)_recorder; }
+
     /// \param offset position of simulation origin in domain-frame
     void setOriginOffset(const glm::vec3& offset) { _originOffset = offset; }
 
@@ -165,6 +162,7 @@ private:
 
     /// \brief bump any objects that touch this one, then remove contact info
     void bumpAndPruneContacts(ObjectMotionState* motionState);
+    void bumpAndPruneContacts(const std::vector<ObjectMotionState*>& motionStates);
 
     void doOwnershipInfection(const btCollisionObject* objectA, const btCollisionObject* objectB);
 
@@ -172,10 +170,13 @@ private:
     btDefaultCollisionConfiguration* _collisionConfig = NULL;
     btCollisionDispatcher* _collisionDispatcher = NULL;
     btBroadphaseInterface* _broadphaseFilter = NULL;
-    btSequentialImpulseConstraintSolver* _constraintSolver = NULL;
+    btConstraintSolverPoolMt* _constraintSolver = NULL;
+    btConstraintSolver* _constraintSolverMt = NULL;
+    std::unique_ptr<PhysicsTaskScheduler> _taskScheduler;
     ThreadSafeDynamicsWorld* _dynamicsWorld = NULL;
     btGhostPairCallback* _ghostPairCallback = NULL;
     std::unique_ptr<PhysicsDebugDraw> _physicsDebugDraw;
+    std::unique_ptr<PhysicsRecorder> _recorder;
 
     ContactMap _contactMap;
     CollisionEvents _collisionEvents;
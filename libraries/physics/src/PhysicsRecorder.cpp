@@ -0,0 +1,552 @@
+//
+//  PhysicsRecorder.cpp
+//  libraries/physics/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "PhysicsRecorder.h"
+
+#include <BulletCollision/CollisionShapes/btEmptyShape.h>
+#include <BulletCollision/CollisionShapes/btMultiSphereShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleMesh.h>
+
+#include "ObjectMotionState.h"
+#include "PhysicsLogging.h"
+
+const quint32 PhysicsRecorder::CURRENT_VERSION = 1;
+const quint32 PhysicsRecorder::MAGIC = 0x50485952; // "PHYR"
+
+static void writeVector(QDataStream& stream, const btVector3& vector) {
+    stream << (float)vector.getX() << (float)vector.getY() << (float)vector.getZ();
+}
+
+static btVector3 readVector(QDataStream& stream) {
+    float x, y, z;
+    stream >> x >> y >> z;
+    return btVector3(x, y, z);
+}
+
+static void writeTransform(QDataStream& stream, const btTransform& transform) {
+    writeVector(stream, transform.getOrigin());
+    btQuaternion rotation = transform.getRotation();
+    stream << (float)rotation.getX() << (float)rotation.getY() << (float)rotation.getZ() << (float)rotation.getW();
+}
+
+static btTransform readTransform(QDataStream& stream) {
+    btVector3 origin = readVector(stream);
+    float x, y, z, w;
+    stream >> x >> y >> z >> w;
+    return btTransform(btQuaternion(x, y, z, w), origin);
+}
+
+static void writeState(QDataStream& stream, const PhysicsRecorder::BodyState& state) {
+    writeTransform(stream, state.transform);
+    writeVector(stream, state.linearVelocity);
+    writeVector(stream, state.angularVelocity);
+    writeVector(stream, state.gravity);
+    stream << state.mass << state.friction << state.restitution << state.linearDamping << state.angularDamping;
+    stream << state.collisionFlags << state.activationState << state.group << state.mask;
+    stream << state.isKinematic << state.isOwned;
+}
+
+static PhysicsRecorder::BodyState readState(QDataStream& stream) {
+    PhysicsRecorder::BodyState state;
+    state.transform = readTransform(stream);
+    state.linearVelocity = readVector(stream);
+    state.angularVelocity = readVector(stream);
+    state.gravity = readVector(stream);
+    stream >> state.mass >> state.friction >> state.restitution >> state.linearDamping >> state.angularDamping;
+    stream >> state.collisionFlags >> state.activationState >> state.group >> state.mask;
+    stream >> state.isKinematic >> state.isOwned;
+    return state;
+}
+
+static void writeShape(QDataStream& stream, const btCollisionShape* shape) {
+    qint32 type = shape->getShapeType();
+    switch (type) {
+        case BOX_SHAPE_PROXYTYPE: {
+            auto box = static_cast<const btBoxShape*>(shape);
+            stream << type;
+            writeVector(stream, box->getHalfExtentsWithMargin());
+            stream << (float)box->getMargin();
+            break;
+        }
+        case SPHERE_SHAPE_PROXYTYPE: {
+            stream << type << (float)static_cast<const btSphereShape*>(shape)->getRadius();
+            break;
+        }
+        case CAPSULE_SHAPE_PROXYTYPE: {
+            auto capsule = static_cast<const btCapsuleShape*>(shape);
+            stream << type << (qint32)capsule->getUpAxis() << (float)capsule->getRadius() << (float)capsule->getHalfHeight();
+            break;
+        }
+        case CYLINDER_SHAPE_PROXYTYPE: {
+            auto cylinder = static_cast<const btCylinderShape*>(shape);
+            stream << type << (qint32)cylinder->getUpAxis();
+            writeVector(stream, cylinder->getHalfExtentsWithMargin());
+            stream << (float)cylinder->getMargin();
+            break;
+        }
+        case MULTI_SPHERE_SHAPE_PROXYTYPE: {
+            auto multiSphere = static_cast<const btMultiSphereShape*>(shape);
+            stream << type << (qint32)multiSphere->getSphereCount();
+            for (int i = 0; i < multiSphere->getSphereCount(); ++i) {
+                writeVector(stream, multiSphere->getSpherePosition(i));
+                stream << (float)multiSphere->getSphereRadius(i);
+            }
+            writeVector(stream, multiSphere->getLocalScaling());
+            break;
+        }
+        case CONVEX_HULL_SHAPE_PROXYTYPE: {
+            auto hull = static_cast<const btConvexHullShape*>(shape);
+            stream << type << (qint32)hull->getNumPoints();
+            for (int i = 0; i < hull->getNumPoints(); ++i) {
+                writeVector(stream, hull->getUnscaledPoints()[i]);
+            }
+            writeVector(stream, hull->getLocalScaling());
+            stream << (float)hull->getMargin();
+            break;
+        }
+        case COMPOUND_SHAPE_PROXYTYPE: {
+            // the transforms and the shapes of the children are already scaled
+            auto compound = static_cast<const btCompoundShape*>(shape);
+            stream << type << (qint32)compound->getNumChildShapes();
+            for (int i = 0; i < compound->getNumChildShapes(); ++i) {
+                writeTransform(stream, compound->getChildTransform(i));
+                writeShape(stream, compound->getChildShape(i));
+            }
+            break;
+        }
+        case TRIANGLE_MESH_SHAPE_PROXYTYPE: {
+            auto meshShape = static_cast<const btBvhTriangleMeshShape*>(shape);
+            // the local scaling of the shape is the scaling of its mesh, the vertices are written unscaled
+            const btStridingMeshInterface* mesh = meshShape->getMeshInterface();
+            stream << type << (qint32)mesh->getNumSubParts();
+            for (int part = 0; part < mesh->getNumSubParts(); ++part) {
+                const unsigned char* vertexBase;
+                const unsigned char* indexBase;
+                int numVertices, vertexStride, indexStride, numTriangles;
+                PHY_ScalarType vertexType, indexType;
+                mesh->getLockedReadOnlyVertexIndexBase(&vertexBase, numVertices, vertexType, vertexStride, &indexBase,
+                                                       indexStride, numTriangles, indexType, part);
+                stream << (qint32)numTriangles;
+                for (int i = 0; i < numTriangles; ++i) {
+                    const unsigned char* triangle = indexBase + i * indexStride;
+                    for (int j = 0; j < 3; ++j) {
+                        int index;
+                        if (indexType == PHY_SHORT) {
+                            index = ((const unsigned short*)triangle)[j];
+                        } else if (indexType == PHY_UCHAR) {
+                            index = triangle[j];
+                        } else {
+                            index = ((const int*)triangle)[j];
+                        }
+                        btVector3 vertex;
+                        if (vertexType == PHY_DOUBLE) {
+                            const double* v = (const double*)(vertexBase + index * vertexStride);
+                            vertex.setValue((btScalar)v[0], (btScalar)v[1], (btScalar)v[2]);
+                        } else {
+                            const float* v = (const float*)(vertexBase + index * vertexStride);
+                            vertex.setValue(v[0], v[1], v[2]);
+                        }
+                        writeVector(stream, vertex);
+                    }
+                }
+                mesh->unLockReadOnlyVertexBase(part);
+            }
+            writeVector(stream, meshShape->getLocalScaling());
+            break;
+        }
+        case EMPTY_SHAPE_PROXYTYPE:
+            stream << type;
+            break;
+        default:
+            qCWarning(physics) << "PhysicsRecorder: shapes of type" << type << "aren't recorded, they're replayed empty";
+            stream << (qint32)EMPTY_SHAPE_PROXYTYPE;
+            break;
+    }
+}
+
+PhysicsRecorder::BodyState PhysicsRecorder::BodyState::fromBody(const btRigidBody& body) {
+    BodyState state;
+    state.transform = body.getWorldTransform();
+    state.linearVelocity = body.getLinearVelocity();
+    state.angularVelocity = body.getAngularVelocity();
+    state.gravity = body.getGravity();
+    state.mass = body.getInvMass() > 0.0f ? 1.0f / body.getInvMass() : 0.0f;
+    state.friction = body.getFriction();
+    state.restitution = body.getRestitution();
+    state.linearDamping = body.getLinearDamping();
+    state.angularDamping = body.getAngularDamping();
+    state.collisionFlags = body.getCollisionFlags();
+    state.activationState = body.getActivationState();
+    const btBroadphaseProxy* proxy = body.getBroadphaseHandle();
+    if (proxy) {
+        state.group = proxy->m_collisionFilterGroup;
+        state.mask = proxy->m_collisionFilterMask;
+    }
+    // the body of the character controller has no motion state
+    auto motionState = static_cast<const ObjectMotionState*>(body.getMotionState());
+    state.isKinematic = body.isKinematicObject() || (!motionState && !body.isStaticObject());
+    state.isOwned = motionState && motionState->isLocallyOwnedOrShouldBe();
+    return state;
+}
+
+bool PhysicsRecorder::BodyState::operator==(const BodyState& other) const {
+    return transform == other.transform && linearVelocity == other.linearVelocity &&
+        angularVelocity == other.angularVelocity && gravity == other.gravity && mass == other.mass &&
+        friction == other.friction && restitution == other.restitution && linearDamping == other.linearDamping &&
+        angularDamping == other.angularDamping && collisionFlags == other.collisionFlags &&
+        activationState == other.activationState && group == other.group && mask == other.mask &&
+        isKinematic == other.isKinematic && isOwned == other.isOwned;
+}
+
+PhysicsRecorder::Shapes::~Shapes() {
+    for (auto shape : _shapes) {
+        delete shape;
+    }
+}
+
+btCollisionShape* PhysicsRecorder::Shapes::get(quint32 id) const {
+    auto itr = _shapesByID.find(id);
+    return itr != _shapesByID.end() ? itr->second : nullptr;
+}
+
+bool PhysicsRecorder::Shapes::read(QDataStream& stream) {
+    quint32 id;
+    stream >> id;
+    btCollisionShape* shape = readShape(stream);
+    if (stream.status() != QDataStream::Ok) {
+        return false;
+    }
+    _shapesByID[id] = shape;
+    return true;
+}
+
+btCollisionShape* PhysicsRecorder::Shapes::readShape(QDataStream& stream) {
+    qint32 type;
+    stream >> type;
+    btCollisionShape* shape = nullptr;
+    switch (type) {
+        case BOX_SHAPE_PROXYTYPE: {
+            btVector3 halfExtents = readVector(stream);
+            float margin;
+            stream >> margin;
+            shape = new btBoxShape(halfExtents);
+            shape->setMargin(margin);
+            break;
+        }
+        case SPHERE_SHAPE_PROXYTYPE: {
+            float radius;
+            stream >> radius;
+            shape = new btSphereShape(radius);
+            break;
+        }
+        case CAPSULE_SHAPE_PROXYTYPE: {
+            qint32 upAxis;
+            float radius, halfHeight;
+            stream >> upAxis >> radius >> halfHeight;
+            if (upAxis == 0) {
+                shape = new btCapsuleShapeX(radius, 2.0f * halfHeight);
+            } else if (upAxis == 2) {
+                shape = new btCapsuleShapeZ(radius, 2.0f * halfHeight);
+            } else {
+                shape = new btCapsuleShape(radius, 2.0f * halfHeight);
+            }
+            break;
+        }
+        case CYLINDER_SHAPE_PROXYTYPE: {
+            qint32 upAxis;
+            stream >> upAxis;
+            btVector3 halfExtents = readVector(stream);
+            float margin;
+            stream >> margin;
+            if (upAxis == 0) {
+                shape = new btCylinderShapeX(halfExtents);
+            } else if (upAxis == 2) {
+                shape = new btCylinderShapeZ(halfExtents);
+            } else {
+                shape = new btCylinderShape(halfExtents);
+            }
+            shape->setMargin(margin);
+            break;
+        }
+        case MULTI_SPHERE_SHAPE_PROXYTYPE: {
+            qint32 numSpheres;
+            stream >> numSpheres;
+            std::vector<btVector3> positions(numSpheres);
+            std::vector<btScalar> radii(numSpheres);
+            for (qint32 i = 0; i < numSpheres && stream.status() == QDataStream::Ok; ++i) {
+                positions[i] = readVector(stream);
+                float radius;
+                stream >> radius;
+                radii[i] = radius;
+            }
+            shape = new btMultiSphereShape(positions.data(), radii.data(), numSpheres);
+            shape->setLocalScaling(readVector(stream));
+            break;
+        }
+        case CONVEX_HULL_SHAPE_PROXYTYPE: {
+            qint32 numPoints;
+            stream >> numPoints;
+            auto hull = new btConvexHullShape();
+            for (qint32 i = 0; i < numPoints && stream.status() == QDataStream::Ok; ++i) {
+                hull->addPoint(readVector(stream), false);
+            }
+            hull->recalcLocalAabb();
+            hull->setLocalScaling(readVector(stream));
+            float margin;
+            stream >> margin;
+            hull->setMargin(margin);
+            shape = hull;
+            break;
+        }
+        case COMPOUND_SHAPE_PROXYTYPE: {
+            qint32 numChildren;
+            stream >> numChildren;
+            auto compound = new btCompoundShape();
+            for (qint32 i = 0; i < numChildren && stream.status() == QDataStream::Ok; ++i) {
+                btTransform transform = readTransform(stream);
+                compound->addChildShape(transform, readShape(stream));
+            }
+            shape = compound;
+            break;
+        }
+        case TRIANGLE_MESH_SHAPE_PROXYTYPE: {
+            qint32 numParts;
+            stream >> numParts;
+            auto mesh = std::make_unique<btTriangleMesh>();
+            for (qint32 part = 0; part < numParts && stream.status() == QDataStream::Ok; ++part) {
+                qint32 numTriangles;
+                stream >> numTriangles;
+                for (qint32 i = 0; i < numTriangles && stream.status() == QDataStream::Ok; ++i) {
+                    btVector3 a = readVector(stream);
+                    btVector3 b = readVector(stream);
+                    btVector3 c = readVector(stream);
+                    mesh->addTriangle(a, b, c);
+                }
+            }
+            btVector3 scaling = readVector(stream);
+            if (mesh->getNumTriangles() > 0) {
+                shape = new btBvhTriangleMeshShape(mesh.get(), true);
+                shape->setLocalScaling(scaling);
+                _meshes.push_back(std::move(mesh));
+            } else {
+                shape = new btEmptyShape();
+            }
+            break;
+        }
+        default:
+            shape = new btEmptyShape();
+            break;
+    }
+    _shapes.push_back(shape);
+    return shape;
+}
+
+bool PhysicsRecorder::readHeader(QDataStream& stream) {
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    quint32 magic, version;
+    stream >> magic >> version;
+    return stream.status() == QDataStream::Ok && magic == MAGIC && version == CURRENT_VERSION;
+}
+
+bool PhysicsRecorder::readFrame(QDataStream& stream, Frame& frame, Shapes& shapes) {
+    frame = Frame();
+    if (stream.atEnd()) {
+        return false;
+    }
+    stream >> frame.timeStep;
+
+    quint32 count;
+    stream >> count;
+    for (quint32 i = 0; i < count; ++i) {
+        if (!shapes.read(stream)) {
+            return false;
+        }
+    }
+
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        quint32 id;
+        stream >> id;
+        frame.removedBodies.push_back(id);
+    }
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        AddedBody body;
+        stream >> body.id >> body.shapeID;
+        body.state = readState(stream);
+        frame.addedBodies.push_back(body);
+    }
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        ChangedBody body;
+        stream >> body.id;
+        body.state = readState(stream);
+        frame.changedBodies.push_back(body);
+    }
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        MovedBody body;
+        stream >> body.id;
+        body.transform = readTransform(stream);
+        frame.movedBodies.push_back(body);
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+PhysicsRecorder::PhysicsRecorder(const QString& filename) : _file(filename) {
+    if (!_file.open(QIODevice::WriteOnly)) {
+        qCWarning(physics) << "PhysicsRecorder: unable to open" << filename;
+        return;
+    }
+    _stream.setDevice(&_file);
+    _stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    _stream << MAGIC << CURRENT_VERSION;
+}
+
+PhysicsRecorder::~PhysicsRecorder() {
+    if (_file.isOpen()) {
+        _file.close();
+    }
+}
+
+quint32 PhysicsRecorder::acquireShape(const btCollisionShape* shape) {
+    auto itr = _shapes.find(shape);
+    if (itr != _shapes.end()) {
+        ++itr->second.numReferences;
+        return itr->second.id;
+    }
+    Shape entry { _nextShapeID++, 1 };
+    _shapes[shape] = entry;
+    QDataStream stream(&_newShapes, QIODevice::WriteOnly | QIODevice::Append);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    stream << entry.id;
+    writeShape(stream, shape);
+    ++_numNewShapes;
+    return entry.id;
+}
+
+void PhysicsRecorder::releaseShape(const btCollisionShape* shape) {
+    // once no recorded body uses it a shape may be deleted, and another one created at the same address
+    auto itr = _shapes.find(shape);
+    if (itr != _shapes.end() && --itr->second.numReferences == 0) {
+        _shapes.erase(itr);
+    }
+}
+
+void PhysicsRecorder::removeBody(std::unordered_map<const btRigidBody*, Body>::iterator itr) {
+    _frame.removedBodies.push_back(itr->second.id);
+    releaseShape(itr->second.shape);
+    _bodies.erase(itr);
+}
+
+void PhysicsRecorder::recordChanges(const btDynamicsWorld& world) {
+    if (!isValid()) {
+        return;
+    }
+    ++_frameCount;
+    const btCollisionObjectArray& objects = world.getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); ++i) {
+        const btRigidBody* body = btRigidBody::upcast(objects[i]);
+        if (!body) {
+            continue;
+        }
+        BodyState state = BodyState::fromBody(*body);
+        auto itr = _bodies.find(body);
+        if (itr != _bodies.end()) {
+            // a body that was reinserted with another shape, motion type or collision group, or that was deleted and
+            // another one created at the same address, is replayed as removed then added again
+            const BodyState& recorded = itr->second.state;
+            if (itr->second.shape != body->getCollisionShape() || recorded.collisionFlags != state.collisionFlags ||
+                    recorded.group != state.group || recorded.mask != state.mask || recorded.isKinematic != state.isKinematic) {
+                removeBody(itr);
+                itr = _bodies.end();
+            }
+        }
+        if (itr == _bodies.end()) {
+            Body recorded { _nextBodyID++, body->getCollisionShape(), state, _frameCount };
+            _frame.addedBodies.push_back({ recorded.id, acquireShape(recorded.shape), state });
+            _bodies[body] = recorded;
+        } else {
+            itr->second.lastFrame = _frameCount;
+            // the kinematic bodies are only moved, to where they are after the step
+            if (!state.isKinematic && !(state == itr->second.state)) {
+                _frame.changedBodies.push_back({ itr->second.id, state });
+                itr->second.state = state;
+            }
+        }
+    }
+
+    auto itr = _bodies.begin();
+    while (itr != _bodies.end()) {
+        if (itr->second.lastFrame != _frameCount) {
+            auto next = std::next(itr);
+            removeBody(itr);
+            itr = next;
+        } else {
+            ++itr;
+        }
+    }
+}
+
+void PhysicsRecorder::recordStep(const btDynamicsWorld& world, float timeStep) {
+    if (!isValid()) {
+        return;
+    }
+    // the states after the step, to tell the changes made before the next one
+    const btCollisionObjectArray& objects = world.getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); ++i) {
+        const btRigidBody* body = btRigidBody::upcast(objects[i]);
+        auto itr = body ? _bodies.find(body) : _bodies.end();
+        if (itr == _bodies.end()) {
+            continue;
+        }
+        BodyState& recorded = itr->second.state;
+        if (recorded.isKinematic) {
+            if (!(body->getWorldTransform() == recorded.transform)) {
+                recorded.transform = body->getWorldTransform();
+                _frame.movedBodies.push_back({ itr->second.id, recorded.transform });
+            }
+        } else {
+            recorded = BodyState::fromBody(*body);
+        }
+    }
+
+    _stream << timeStep;
+    _stream << _numNewShapes;
+    _stream.writeRawData(_newShapes.constData(), _newShapes.size());
+    _stream << (quint32)_frame.removedBodies.size();
+    for (quint32 id : _frame.removedBodies) {
+        _stream << id;
+    }
+    _stream << (quint32)_frame.addedBodies.size();
+    for (const auto& body : _frame.addedBodies) {
+        _stream << body.id << body.shapeID;
+        writeState(_stream, body.state);
+    }
+    _stream << (quint32)_frame.changedBodies.size();
+    for (const auto& body : _frame.changedBodies) {
+        _stream << body.id;
+        writeState(_stream, body.state);
+    }
+    _stream << (quint32)_frame.movedBodies.size();
+    for (const auto& body : _frame.movedBodies) {
+        _stream << body.id;
+        writeTransform(_stream, body.transform);
+    }
+
+    _frame = Frame();
+    _newShapes.clear();
+    _numNewShapes = 0;
+    if (_stream.status() != QDataStream::Ok) {
+        qCWarning(physics) << "PhysicsRecorder: unable to write to" << _file.fileName() << ", the recording stops";
+        _file.close();
+    }
+}
@@ -0,0 +1,146 @@
+//
+//  PhysicsRecorder.h
+//  libraries/physics/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_PhysicsRecorder_h
+#define overte_PhysicsRecorder_h
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+
+#include <btBulletDynamicsCommon.h>
+
+/// Records the rigid bodies of a dynamics world step by step, for the physics-player tool to replay them: the bodies that
+/// were added and removed before each step, the ones that were changed from outside of the simulation, the time step, and
+/// the transforms that the kinematic bodies were moved to.  The body that the character controller drives is recorded as
+/// a kinematic body, it's replayed where the controller moved it.  The constraints and actions of the entities aren't
+/// recorded.
+class PhysicsRecorder {
+public:
+    // Whenever a change is made to the recorded format, this value should be incremented
+    static const quint32 CURRENT_VERSION;
+    static const quint32 MAGIC;
+
+    /// The properties of a body that are set from outside of the simulation
+    struct BodyState {
+        static BodyState fromBody(const btRigidBody& body);
+        bool operator==(const BodyState& other) const;
+
+        btTransform transform;
+        btVector3 linearVelocity;
+        btVector3 angularVelocity;
+        btVector3 gravity;
+        float mass { 0.0f };
+        float friction { 0.0f };
+        float restitution { 0.0f };
+        float linearDamping { 0.0f };
+        float angularDamping { 0.0f };
+        qint32 collisionFlags { 0 };
+        qint32 activationState { 0 };
+        qint32 group { 0 };
+        qint32 mask { 0 };
+        // replayed as a kinematic body, moved to the transforms it had after each step
+        bool isKinematic { false };
+        // the collision events of the body are reported
+        bool isOwned { false };
+    };
+
+    struct AddedBody {
+        quint32 id;
+        quint32 shapeID;
+        BodyState state;
+    };
+    struct ChangedBody {
+        quint32 id;
+        BodyState state;
+    };
+    struct MovedBody {
+        quint32 id;
+        btTransform transform;
+    };
+
+    /// The shapes of a recording, created as they're read
+    class Shapes {
+    public:
+        ~Shapes();
+        btCollisionShape* get(quint32 id) const;
+        /// Reads a shape and its id, returns false if it can't be read
+        bool read(QDataStream& stream);
+
+    private:
+        btCollisionShape* readShape(QDataStream& stream);
+
+        // compound shapes don't own their children, all the shapes are kept here
+        std::vector<btCollisionShape*> _shapes;
+        std::vector<std::unique_ptr<btTriangleMesh>> _meshes;
+        std::unordered_map<quint32, btCollisionShape*> _shapesByID;
+    };
+
+    /// What happened before and during one step
+    struct Frame {
+        float timeStep { 0.0f };
+        std::vector<quint32> removedBodies;
+        std::vector<AddedBody> addedBodies;
+        std::vector<ChangedBody> changedBodies;
+        std::vector<MovedBody> movedBodies;
+    };
+
+    /// Reads the next frame of a recording, with the new shapes that it uses, returns false at the end of the recording
+    static bool readFrame(QDataStream& stream, Frame& frame, Shapes& shapes);
+    /// Reads the header of a recording, returns false if it isn't one this version can read
+    static bool readHeader(QDataStream& stream);
+
+    explicit PhysicsRecorder(const QString& filename);
+    ~PhysicsRecorder();
+
+    bool isValid() const { return _file.isOpen(); }
+
+    /// Records the bodies of world that were added, removed or changed since the last step, before it's stepped
+    void recordChanges(const btDynamicsWorld& world);
+    /// Records the step and the kinematic bodies it moved, after world is stepped
+    void recordStep(const btDynamicsWorld& world, float timeStep);
+
+private:
+    struct Body {
+        quint32 id;
+        const btCollisionShape* shape;
+        BodyState state;
+        uint32_t lastFrame;
+    };
+    struct Shape {
+        quint32 id;
+        uint32_t numReferences;
+    };
+
+    quint32 acquireShape(const btCollisionShape* shape);
+    void releaseShape(const btCollisionShape* shape);
+    void removeBody(std::unordered_map<const btRigidBody*, Body>::iterator itr);
+
+    QFile _file;
+    QDataStream _stream;
+
+    std::unordered_map<const btRigidBody*, Body> _bodies;
+    std::unordered_map<const btCollisionShape*, Shape> _shapes;
+    quint32 _nextBodyID { 0 };
+    quint32 _nextShapeID { 0 };
+    uint32_t _frameCount { 0 };
+
+    // the frame being recorded, with its new shapes already serialized
+    Frame _frame;
+    QByteArray _newShapes;
+    quint32 _numNewShapes { 0 };
+};
+
+#endif // overte_PhysicsRecorder_h
@@ -0,0 +1,47 @@
+//
+//  PhysicsTaskScheduler.cpp
+//  libraries/physics/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "PhysicsTaskScheduler.h"
+
+#include <algorithm>
+#include <thread>
+
+#include <LinearMath/btQuickprof.h>
+
+#include <TBBHelpers.h>
+#include <tbb/parallel_reduce.h>
+
+PhysicsTaskScheduler::PhysicsTaskScheduler() : btITaskScheduler("TBB") {
+    setNumThreads((int)std::thread::hardware_concurrency());
+}
+
+void PhysicsTaskScheduler::setNumThreads(int numThreads) {
+    // Bullet gives each thread that runs its loops a slot of its own, there are only BT_MAX_THREAD_COUNT of them
+    _numThreads = std::max(1, std::min(numThreads, (int)BT_MAX_THREAD_COUNT));
+}
+
+void PhysicsTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) {
+    BT_PROFILE("parallelFor_TBB");
+    // Bullet picks the grain size of each loop, the simple partitioner keeps the ranges to it
+    tbb::parallel_for(tbb::blocked_range<int>(iBegin, iEnd, grainSize), [&](const tbb::blocked_range<int>& range) {
+        body.forLoop(range.begin(), range.end());
+    }, tbb::simple_partitioner());
+}
+
+btScalar PhysicsTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) {
+    BT_PROFILE("parallelSum_TBB");
+    return tbb::parallel_reduce(tbb::blocked_range<int>(iBegin, iEnd, grainSize), btScalar(0),
+        [&](const tbb::blocked_range<int>& range, btScalar sum) {
+            return sum + body.sumLoop(range.begin(), range.end());
+        }, [](btScalar a, btScalar b) {
+            return a + b;
+        }, tbb::simple_partitioner());
+}
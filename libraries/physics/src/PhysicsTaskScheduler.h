@@ -0,0 +1,34 @@
+//
+//  PhysicsTaskScheduler.h
+//  libraries/physics/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_PhysicsTaskScheduler_h
+#define overte_PhysicsTaskScheduler_h
+
+#include <LinearMath/btThreads.h>
+
+/// Runs the parallel loops of Bullet's multithreaded dynamics world on the TBB worker threads that the rest of the
+/// engine already uses, rather than on a thread pool of Bullet's own.
+class PhysicsTaskScheduler : public btITaskScheduler {
+public:
+    PhysicsTaskScheduler();
+
+    int getMaxNumThreads() const override { return BT_MAX_THREAD_COUNT; }
+    int getNumThreads() const override { return _numThreads; }
+    void setNumThreads(int numThreads) override;
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+
+private:
+    int _numThreads { 1 };
+};
+
+#endif // overte_PhysicsTaskScheduler_h
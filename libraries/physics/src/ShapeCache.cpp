@@ -0,0 +1,107 @@
+//
+//  ShapeCache.cpp
+//  libraries/physics/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ShapeCache.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+
+#include "PhysicsLogging.h"
+
+const quint32 ShapeCache::CURRENT_VERSION = 1;
+const std::string ShapeCache::DIRNAME = "shapes";
+const std::string ShapeCache::EXT = "bvh";
+
+static const quint32 SHAPE_CACHE_MAGIC = 0x48564253; // "SBVH"
+// Bullet places the BVH at the start of its buffer, which must be aligned to 16 bytes
+static const int BVH_ALIGNMENT = 16;
+
+struct Header {
+    quint32 magic;
+    quint32 version;
+    quint32 bvhSize;
+    // the serialized BVH is in the byte order and with the btScalar of the machine that built it
+    quint32 scalarSize;
+};
+
+ShapeCache::ShapeCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) {
+    // the shapes share their disk space with the downloads of the models they were made from
+    setSharedBudget(cache::getResourceBudget());
+}
+
+std::string ShapeCache::getKey(const ShapeInfo& info) {
+    // ShapeInfo::getHash only hashes the URL of the meshes, the triangles at a URL can change between sessions
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(reinterpret_cast<const char*>(&CURRENT_VERSION), sizeof(CURRENT_VERSION));
+    const auto& pointCollection = info.getPointCollection();
+    if (!pointCollection.empty()) {
+        // only the first point list is made into a mesh, see createStaticMeshArray
+        const auto& points = pointCollection[0];
+        hash.addData(reinterpret_cast<const char*>(points.constData()), points.size() * (int)sizeof(glm::vec3));
+    }
+    const auto& triangleIndices = info.getTriangleIndices();
+    hash.addData(reinterpret_cast<const char*>(triangleIndices.constData()), triangleIndices.size() * (int)sizeof(int32_t));
+    return hash.result().toHex().toStdString();
+}
+
+btOptimizedBvh* ShapeCache::readBvh(const std::string& key) {
+    // the cache entry can't be ejected while it's held
+    auto file = getFile(key);
+    if (!file) {
+        return nullptr;
+    }
+
+    QFile bvhFile(QString::fromStdString(file->getFilepath()));
+    if (!bvhFile.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    Header header;
+    if (bvhFile.read(reinterpret_cast<char*>(&header), sizeof(Header)) != (qint64)sizeof(Header) ||
+            header.magic != SHAPE_CACHE_MAGIC || header.version != CURRENT_VERSION || header.scalarSize != sizeof(btScalar) ||
+            bvhFile.size() != (qint64)(sizeof(Header) + header.bvhSize)) {
+        qCWarning(physics) << "Unable to read the cached shape" << key.c_str();
+        return nullptr;
+    }
+
+    // the BVH is deserialized in place, so the data is copied out of the file into an aligned buffer it then lives in
+    void* buffer = btAlignedAlloc(header.bvhSize, BVH_ALIGNMENT);
+    if (bvhFile.read(static_cast<char*>(buffer), header.bvhSize) != (qint64)header.bvhSize) {
+        btAlignedFree(buffer);
+        return nullptr;
+    }
+    btOptimizedBvh* bvh = btOptimizedBvh::deSerializeInPlace(buffer, header.bvhSize, false);
+    if (!bvh) {
+        qCWarning(physics) << "Unable to read the cached shape" << key.c_str();
+        btAlignedFree(buffer);
+        return nullptr;
+    }
+    return bvh;
+}
+
+bool ShapeCache::writeBvh(const std::string& key, const btOptimizedBvh& bvh) {
+    Header header;
+    header.magic = SHAPE_CACHE_MAGIC;
+    header.version = CURRENT_VERSION;
+    header.bvhSize = bvh.calculateSerializeBufferSize();
+    header.scalarSize = sizeof(btScalar);
+
+    // Bullet serializes into an aligned buffer, which is then written after the header
+    QByteArray data(reinterpret_cast<const char*>(&header), sizeof(Header));
+    void* buffer = btAlignedAlloc(header.bvhSize, BVH_ALIGNMENT);
+    bool serialized = bvh.serializeInPlace(buffer, header.bvhSize, false);
+    if (serialized) {
+        data.append(static_cast<const char*>(buffer), header.bvhSize);
+    }
+    btAlignedFree(buffer);
+
+    return serialized && (bool)writeFile(data.constData(), Metadata(key, data.size()));
+}
@@ -0,0 +1,46 @@
+//
+//  ShapeCache.h
+//  libraries/physics/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ShapeCache_h
+#define overte_ShapeCache_h
+
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+
+#include <ShapeInfo.h>
+#include <shared/FileCache.h>
+
+/// Keeps the BVHs of the static mesh shapes on disk, so that a mesh collides as soon as its shape is asked for again,
+/// in this session or a later one, rather than once its BVH is rebuilt.  The entries are keyed by the hash of the
+/// triangles, and they share their disk space with the downloads.
+class ShapeCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to the stored format, or to how the BVHs are built,
+    // this value should be incremented so that the entries of the previous format are no longer found
+    static const quint32 CURRENT_VERSION;
+    static const std::string DIRNAME;
+    static const std::string EXT;
+
+    ShapeCache(const std::string& dir = DIRNAME, const std::string& ext = EXT);
+
+    /// Returns the key of the BVH of the static mesh of info
+    static std::string getKey(const ShapeInfo& info);
+
+    /// Returns the BVH stored under key, deserialized in place at the start of a buffer that the caller frees with
+    /// btAlignedFree once the BVH is no longer used, or nullptr if there isn't one or it can't be read
+    btOptimizedBvh* readBvh(const std::string& key);
+
+    /// Stores bvh under key, returns false if it can't be stored
+    bool writeBvh(const std::string& key, const btOptimizedBvh& bvh);
+};
+
+#endif // overte_ShapeCache_h
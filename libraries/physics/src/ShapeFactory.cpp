@@ -16,6 +16,7 @@
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
 #include "BulletUtil.h"
+#include "ShapeCache.h"
 
 
 class StaticMeshShape : public btBvhTriangleMeshShape {
@@ -27,7 +28,20 @@ public:
         assert(_dataArray);
     }
 
+    // cachedBvh is the BVH of dataArray as read by ShapeCache::readBvh, the shape frees its buffer
+    StaticMeshShape(btTriangleIndexVertexArray* dataArray, btOptimizedBvh* cachedBvh)
+    :   btBvhTriangleMeshShape(dataArray, true, false), _dataArray(dataArray), _cachedBvh(cachedBvh) {
+        assert(_dataArray);
+        assert(_cachedBvh);
+        setOptimizedBvh(_cachedBvh);
+    }
+
     ~StaticMeshShape() {
+        if (_cachedBvh) {
+            // the BVH lives in the buffer it was read into, the base class doesn't own it
+            btAlignedFree(_cachedBvh);
+            _cachedBvh = nullptr;
+        }
         assert(_dataArray);
         IndexedMeshArray& meshes = _dataArray->getIndexedMeshArray();
         for (int32_t i = 0; i < meshes.size(); ++i) {
@@ -47,6 +61,7 @@ public:
 private:
     // the StaticMeshShape owns its vertex/index data
     btTriangleIndexVertexArray* _dataArray;
+    btOptimizedBvh* _cachedBvh { nullptr };
 };
 
 // the dataArray must be created before we create the StaticMeshShape
@@ -270,7 +285,22 @@ btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info) {
     return dataArray;
 }
 
-const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
+// util method
+StaticMeshShape* createStaticMeshShape(const ShapeInfo& info, btTriangleIndexVertexArray* dataArray, ShapeCache* cache) {
+    if (!cache) {
+        return new StaticMeshShape(dataArray);
+    }
+    std::string key = ShapeCache::getKey(info);
+    btOptimizedBvh* cachedBvh = cache->readBvh(key);
+    if (cachedBvh) {
+        return new StaticMeshShape(dataArray, cachedBvh);
+    }
+    StaticMeshShape* shape = new StaticMeshShape(dataArray);
+    cache->writeBvh(key, *shape->getOptimizedBvh());
+    return shape;
+}
+
+const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info, ShapeCache* cache) {
     btCollisionShape* shape = nullptr;
     int type = info.getType();
     switch(type) {
@@ -426,7 +456,7 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
         case SHAPE_TYPE_STATIC_MESH: {
             btTriangleIndexVertexArray* dataArray = createStaticMeshArray(info);
             if (dataArray) {
-                shape = new StaticMeshShape(dataArray);
+                shape = createStaticMeshShape(info, dataArray, cache);
             }
         }
         break;
@@ -484,6 +514,6 @@ void ShapeFactory::deleteShape(const btCollisionShape* shape) {
 }
 
 void ShapeFactory::Worker::run() {
-    shape = ShapeFactory::createShapeFromInfo(shapeInfo);
+    shape = ShapeFactory::createShapeFromInfo(shapeInfo, cache.get());
     emit submitWork(this);
 }
@@ -12,6 +12,8 @@
 #ifndef hifi_ShapeFactory_h
 #define hifi_ShapeFactory_h
 
+#include <memory>
+
 #include <btBulletDynamicsCommon.h>
 #include <glm/glm.hpp>
 #include <QObject>
@@ -19,10 +21,13 @@
 
 #include <ShapeInfo.h>
 
+class ShapeCache;
+
 // The ShapeFactory assembles and correctly disassembles btCollisionShapes.
 
 namespace ShapeFactory {
-    const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
+    // the BVHs of the static meshes are read from cache, or built and then written to it, when there's one
+    const btCollisionShape* createShapeFromInfo(const ShapeInfo& info, ShapeCache* cache = nullptr);
     void deleteShape(const btCollisionShape* shape);
 
     class Worker : public QObject, public QRunnable {
@@ -31,6 +36,7 @@ namespace ShapeFactory {
         Worker(const ShapeInfo& info) : shapeInfo(info), shape(nullptr) {}
         void run() override;
         ShapeInfo shapeInfo;
+        std::shared_ptr<ShapeCache> cache;
         const btCollisionShape* shape;
     signals:
         void submitWork(Worker*);
@@ -66,6 +66,7 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
                 worker->shapeInfo = info;
                 _deadWorker = nullptr;
             }
+            worker->cache = _shapeCache;
             // we will delete worker manually later
             worker->setAutoDelete(false);
             QObject::connect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
@@ -22,6 +22,7 @@
 
 #include <ShapeInfo.h>
 
+#include "ShapeCache.h"
 #include "ShapeFactory.h"
 #include "HashKey.h"
 
@@ -66,6 +67,9 @@ public:
     /// delete shapes that have zero references
     void collectGarbage();
 
+    /// Keep the BVHs of the static mesh shapes in cache, across sessions
+    void setShapeCache(const std::shared_ptr<ShapeCache>& cache) { _shapeCache = cache; }
+
     // validation methods
     int getNumShapes() const { return _shapeMap.size(); }
     int getNumReferences(const ShapeInfo& info) const;
@@ -103,6 +107,7 @@ private:
     std::vector<uint64_t> _pendingMeshShapes;
     std::vector<KeyExpiry> _orphans;
     ShapeFactory::Worker* _deadWorker { nullptr };
+    std::shared_ptr<ShapeCache> _shapeCache;
     TimePoint _nextOrphanExpiry;
     uint32_t _ringIndex { 0 };
     std::atomic_uint _workRequestCount { 0 };
@@ -24,9 +24,10 @@
 ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
         btDispatcher* dispatcher,
         btBroadphaseInterface* pairCache,
-        btConstraintSolver* constraintSolver,
+        btConstraintSolverPoolMt* solverPool,
+        btConstraintSolver* constraintSolverMt,
         btCollisionConfiguration* collisionConfiguration)
-    :   btDiscreteDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration) {
+    :   btDiscreteDynamicsWorldMt(dispatcher, pairCache, solverPool, constraintSolverMt, collisionConfiguration) {
 }
 
 int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps,
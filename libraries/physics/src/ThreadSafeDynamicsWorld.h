@@ -19,7 +19,7 @@
 #define hifi_ThreadSafeDynamicsWorld_h
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
-#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 
 #include "ObjectMotionState.h"
 
@@ -27,14 +27,18 @@
 
 using SubStepCallback = std::function<void()>;
 
-ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorld {
+// The islands are solved by the solvers of the pool, in parallel when a multithreaded btITaskScheduler is set,
+// and one at a time on the calling thread otherwise.  constraintSolverMt, if any, solves the islands too large
+// to be split across the threads by island.
+ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorldMt {
 public:
     BT_DECLARE_ALIGNED_ALLOCATOR();
 
     ThreadSafeDynamicsWorld(
             btDispatcher* dispatcher,
             btBroadphaseInterface* pairCache,
-            btConstraintSolver* constraintSolver,
+            btConstraintSolverPoolMt* solverPool,
+            btConstraintSolver* constraintSolverMt,
             btCollisionConfiguration* collisionConfiguration);
 
     int getNumSubsteps() const { return _numSubsteps; }
@@ -10,12 +10,36 @@
 //
 #pragma once
 
+#include <cstring>
+
 #include "Plugin.h"
 
+// copies a frame coded through the QByteArray interface into a caller's buffer, see Encoder::encodeInto
+inline int copyCodedFrame(const QByteArray& buffer, char* data, int maxSize) {
+    if (buffer.size() > maxSize) {
+        return -1;
+    }
+    memcpy(data, buffer.constData(), buffer.size());
+    return buffer.size();
+}
+
 class Encoder {
 public:
     virtual ~Encoder() { }
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) = 0;
+
+    // Encodes into a buffer owned by the caller, so that nothing is allocated per frame.
+    // Returns the encoded size, or -1 if encoding failed or the result didn't fit in maxEncodedSize.
+    // Codecs that don't override it go through encode() above.
+    virtual int encodeInto(const char* decodedData, int decodedSize, char* encodedData, int maxEncodedSize) {
+        QByteArray encodedBuffer;
+        encode(QByteArray::fromRawData(decodedData, decodedSize), encodedBuffer);
+        return copyCodedFrame(encodedBuffer, encodedData, maxEncodedSize);
+    }
+
+    // Hints for codecs that can trade quality for bandwidth or for CPU time, the others ignore them
+    virtual void setBitrate(int bitrate) { }
+    virtual void setComplexity(int complexity) { }
 };
 
 class Decoder {
@@ -24,6 +48,19 @@ public:
     virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) = 0;
 
     virtual void lostFrame(QByteArray& decodedBuffer) = 0;
+
+    // Decode into a buffer owned by the caller, like Encoder::encodeInto.
+    // Return the decoded size, or -1 if the result didn't fit in maxDecodedSize.
+    virtual int decodeInto(const char* encodedData, int encodedSize, char* decodedData, int maxDecodedSize) {
+        QByteArray decodedBuffer;
+        decode(QByteArray::fromRawData(encodedData, encodedSize), decodedBuffer);
+        return copyCodedFrame(decodedBuffer, decodedData, maxDecodedSize);
+    }
+    virtual int lostFrameInto(char* decodedData, int maxDecodedSize) {
+        QByteArray decodedBuffer;
+        lostFrame(decodedBuffer);
+        return copyCodedFrame(decodedBuffer, decodedData, maxDecodedSize);
+    }
 };
 
 class CodecPlugin : public Plugin {
@@ -205,6 +205,8 @@ public:
 
     void waitForPresent();
     float getAveragePresentTime() { return _movingAveragePresent.average / (float)USECS_PER_MSEC; }  // in msec
+    // from the sample of the pose that a frame was rendered with to the frame's present
+    float getAveragePoseLatency() { return _movingAveragePoseLatency.average / (float)USECS_PER_MSEC; }  // in msec
 
     static const QString& MENU_PATH();
 
@@ -230,6 +232,7 @@ protected:
     gpu::ContextPointer _gpuContext;
 
     MovingAverage<float, 10> _movingAveragePresent;
+    MovingAverage<float, 10> _movingAveragePoseLatency;
 
 private:
     QMutex _presentMutex;
@@ -7,6 +7,7 @@
 //
 #include "PluginManager.h"
 
+#include <future>
 #include <mutex>
 
 #include <QtCore/QCoreApplication>
@@ -22,7 +23,6 @@
 
 #include <DependencyManager.h>
 #include <UserActivityLogger.h>
-#include <QThreadPool>
 
 #include "RuntimePlugin.h"
 #include "CodecPlugin.h"
@@ -92,90 +92,116 @@ int PluginManager::instantiate() {
     return std::count_if(loaders.begin(), loaders.end(), [](const auto& loader) { return (bool)loader->instance(); });
 }
 
- auto PluginManager::getLoadedPlugins() const -> const LoaderList& {
-    static std::once_flag once;
-    static LoaderList loadedPlugins;
-    std::call_once(once, [&] {
+struct PluginCandidate {
+    QSharedPointer<QPluginLoader> loader;
+    PluginManager::PluginInfo info;
+};
+
+// The candidates are loaded in parallel, and their results merged back in directory order by getLoadedPlugins
+std::once_flag pluginLoadingStarted;
+std::vector<PluginCandidate> pluginCandidates;
+std::vector<std::future<void>> pluginLoads;
+
+void PluginManager::preloadPlugins() {
+    std::call_once(pluginLoadingStarted, [&] { startLoadingPlugins(); });
+}
+
+void PluginManager::startLoadingPlugins() const {
 #if defined(Q_OS_ANDROID)
-        QString pluginPath = QCoreApplication::applicationDirPath() + "/";
+    QString pluginPath = QCoreApplication::applicationDirPath() + "/";
 #elif defined(Q_OS_MAC)
-        QString pluginPath = QCoreApplication::applicationDirPath() + "/../PlugIns/";
+    QString pluginPath = QCoreApplication::applicationDirPath() + "/../PlugIns/";
 #else
-        QString pluginPath = QCoreApplication::applicationDirPath() + "/plugins/";
+    QString pluginPath = QCoreApplication::applicationDirPath() + "/plugins/";
 #endif
-        QDir pluginDir(pluginPath);
-        pluginDir.setSorting(QDir::Name);
-        pluginDir.setFilter(QDir::Files);
-        if (pluginDir.exists()) {
-            qInfo() << "Loading runtime plugins from " << pluginPath;
+    QDir pluginDir(pluginPath);
+    pluginDir.setSorting(QDir::Name);
+    pluginDir.setFilter(QDir::Files);
+    if (!pluginDir.exists()) {
+        qWarning() << "pluginPath does not exit..." << pluginDir;
+        return;
+    }
+
+    qInfo() << "Loading runtime plugins from " << pluginPath;
 #if defined(Q_OS_ANDROID)
-            // Can be a better filter and those libs may have a better name to destinguish them from qt plugins
-            pluginDir.setNameFilters(QStringList() << "libplugins_lib*.so");
+    // Can be a better filter and those libs may have a better name to destinguish them from qt plugins
+    pluginDir.setNameFilters(QStringList() << "libplugins_lib*.so");
 #endif
-            auto candidates = pluginDir.entryList();
-
-            if (_enableScriptingPlugins.get()) {
-                QDir scriptingPluginDir{ pluginDir };
-                scriptingPluginDir.cd("scripting");
-                qCDebug(plugins) << "Loading scripting plugins from " << scriptingPluginDir.path();
-                for (auto plugin : scriptingPluginDir.entryList()) {
-                    candidates << "scripting/" + plugin;
-                }
+    auto candidates = pluginDir.entryList();
+
+    if (_enableScriptingPlugins.get()) {
+        QDir scriptingPluginDir{ pluginDir };
+        scriptingPluginDir.cd("scripting");
+        qCDebug(plugins) << "Loading scripting plugins from " << scriptingPluginDir.path();
+        for (auto plugin : scriptingPluginDir.entryList()) {
+            candidates << "scripting/" + plugin;
+        }
+    }
+
+    // The loaders are created here so that they belong to this thread; only reading the metadata and loading the
+    // library happen on the workers, while plugin instances are still only created when something asks for them.
+    pluginCandidates.resize(candidates.size());
+    for (int i = 0; i < candidates.size(); ++i) {
+        pluginCandidates[i].loader = QSharedPointer<QPluginLoader>::create(pluginPath + candidates[i]);
+        pluginCandidates[i].info.name = candidates[i];
+    }
+
+    auto pluginFilter = _pluginFilter;
+    pluginLoads.reserve(pluginCandidates.size());
+    for (auto& candidate : pluginCandidates) {
+        pluginLoads.push_back(std::async(std::launch::async, [&candidate, pluginFilter] {
+            auto& info = candidate.info;
+            info.metaData = candidate.loader->metaData();
+            if (isDisabled(info.metaData)) {
+                info.disabled = true;
+            } else if (!pluginFilter(info.metaData)) {
+                info.filteredOut = true;
+            } else if (getPluginInterfaceVersionFromMetaData(info.metaData) != HIFI_PLUGIN_INTERFACE_VERSION) {
+                info.wrongVersion = true;
+            } else {
+                info.loaded = candidate.loader->load();
             }
+        }));
+    }
+}
 
-            for (auto plugin : candidates) {
-                qCDebug(plugins) << "Attempting plugin" << qPrintable(plugin);
-                auto loader = QSharedPointer<QPluginLoader>::create(pluginPath + plugin);
-                const QJsonObject pluginMetaData = loader->metaData();
+ auto PluginManager::getLoadedPlugins() const -> const LoaderList& {
+    static std::once_flag once;
+    static LoaderList loadedPlugins;
+    std::call_once(once, [&] {
+        std::call_once(pluginLoadingStarted, [&] { startLoadingPlugins(); });
 
-                PluginInfo info;
-                info.name = plugin;
-                info.metaData = pluginMetaData;
+        for (size_t i = 0; i < pluginCandidates.size(); ++i) {
+            pluginLoads[i].wait();
+            const auto& candidate = pluginCandidates[i];
+            const auto& info = candidate.info;
+            const auto& plugin = info.name;
+            qCDebug(plugins) << "Attempting plugin" << qPrintable(plugin);
 
 #if defined(HIFI_PLUGINMANAGER_DEBUG)
-                QJsonDocument metaDataDoc(pluginMetaData);
-                qCInfo(plugins) << "Metadata for " << qPrintable(plugin) << ": " << QString(metaDataDoc.toJson());
+            QJsonDocument metaDataDoc(info.metaData);
+            qCInfo(plugins) << "Metadata for " << qPrintable(plugin) << ": " << QString(metaDataDoc.toJson());
 #endif
-                if (isDisabled(pluginMetaData)) {
-                    qCWarning(plugins) << "Plugin" << qPrintable(plugin) << "is disabled";
-                    info.disabled = true;
-                    pluginInfo.push_back(info);
-
-                    // Skip this one, it's disabled
-                    continue;
-                }
-
-                if (!_pluginFilter(pluginMetaData)) {
-                    qCDebug(plugins) << "Plugin" << qPrintable(plugin) << "doesn't pass provided filter";
-                    info.filteredOut = true;
-                    pluginInfo.push_back(info);
-                    continue;
-                }
-
-                if (getPluginInterfaceVersionFromMetaData(pluginMetaData) != HIFI_PLUGIN_INTERFACE_VERSION) {
-                    qCWarning(plugins) << "Plugin" << qPrintable(plugin) << "interface version doesn't match, not loading:"
-                                       << getPluginInterfaceVersionFromMetaData(pluginMetaData)
-                                       << "doesn't match" << HIFI_PLUGIN_INTERFACE_VERSION;
-
-                    info.wrongVersion = true;
-                    pluginInfo.push_back(info);
-                    continue;
-                }
-
-                if (loader->load()) {
-                    qCDebug(plugins) << "Plugin" << qPrintable(plugin) << "loaded successfully";
-                    info.loaded = true;
-                    loadedPlugins.push_back(loader);
-                } else {
-                    qCDebug(plugins) << "Plugin" << qPrintable(plugin) << "failed to load:";
-                    qCDebug(plugins) << " " << qPrintable(loader->errorString());
-                }
-
-                pluginInfo.push_back(info);
+            if (info.disabled) {
+                qCWarning(plugins) << "Plugin" << qPrintable(plugin) << "is disabled";
+            } else if (info.filteredOut) {
+                qCDebug(plugins) << "Plugin" << qPrintable(plugin) << "doesn't pass provided filter";
+            } else if (info.wrongVersion) {
+                qCWarning(plugins) << "Plugin" << qPrintable(plugin) << "interface version doesn't match, not loading:"
+                                   << getPluginInterfaceVersionFromMetaData(info.metaData)
+                                   << "doesn't match" << HIFI_PLUGIN_INTERFACE_VERSION;
+            } else if (info.loaded) {
+                qCDebug(plugins) << "Plugin" << qPrintable(plugin) << "loaded successfully";
+                loadedPlugins.push_back(candidate.loader);
+            } else {
+                qCDebug(plugins) << "Plugin" << qPrintable(plugin) << "failed to load:";
+                qCDebug(plugins) << " " << qPrintable(candidate.loader->errorString());
             }
-        } else {
-            qWarning() << "pluginPath does not exit..." << pluginDir;
+
+            pluginInfo.push_back(info);
         }
+        pluginLoads.clear();
+        pluginCandidates.clear();
     });
     return loadedPlugins;
 }
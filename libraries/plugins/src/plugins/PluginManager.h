@@ -34,7 +34,7 @@ using PluginManagerPointer = QSharedPointer<PluginManager>;
  * added or removed once that happens.
  *
  * Initialization is performed in the getDisplayPlugins, getInputPlugins and getCodecPlugins
- * functions.
+ * functions. The plugin libraries can be loaded ahead of that, in the background, with preloadPlugins.
  */
 class PluginManager : public QObject, public Dependency {
     SINGLETON_DEPENDENCY
@@ -187,6 +187,18 @@ public:
     int instantiate();
     void shutdown();
 
+    /**
+     * @brief Start loading the runtime plugin libraries in the background
+     *
+     * Every candidate's metadata is read and its library loaded on a thread of its own, so the
+     * loading overlaps with the rest of startup. The plugins themselves are still only instantiated
+     * and initialized when getDisplayPlugins, getInputPlugins, etc. first need them.
+     *
+     * @note This must be called after the rest of the configuration (disableDisplays, disableInputs,
+     * setPluginFilter), which is made permanent by it. The plugin filter is called on the loading threads.
+     */
+    void preloadPlugins();
+
 
     /**
      * @brief Provide a list of statically linked plugins.
@@ -289,6 +301,7 @@ private:
     using Loader = QSharedPointer<QPluginLoader>;
     using LoaderList = QList<Loader>;
 
+    void startLoadingPlugins() const;
     const LoaderList& getLoadedPlugins() const;
     Setting::Handle<bool> _enableScriptingPlugins {
         "private/enableScriptingPlugins", (bool)qgetenv("enableScriptingPlugins").toInt()
@@ -304,4 +317,4 @@ private:
 //   plugins/*/src/plugin.json
 //   plugins/oculus/src/oculus.json
 //   etc
-static const int HIFI_PLUGIN_INTERFACE_VERSION = 1;
+static const int HIFI_PLUGIN_INTERFACE_VERSION = 2;
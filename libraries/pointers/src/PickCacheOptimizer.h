@@ -8,6 +8,7 @@
 #ifndef hifi_PickCacheOptimizer_h
 #define hifi_PickCacheOptimizer_h
 
+#include <algorithm>
 #include <unordered_map>
 
 #include "Pick.h"
@@ -31,46 +32,63 @@ namespace std {
     };
 }
 
+// The targets that the picks are intersected with, one at a time
+enum PickTarget {
+    PICK_TARGET_ENTITIES = 0,
+    PICK_TARGET_AVATARS,
+    PICK_TARGET_HUD,
+    NUM_PICK_TARGETS
+};
+
 // T is a mathematical representation of a Pick (a MathPick)
 // For example: RayPicks use T = PickRay
+//
+// The picks of a type are updated in three steps: prepare() gathers them and their mathematical picks on the main thread,
+// evaluate() intersects all of them with one target, and can run on another thread for the targets that allow it, then
+// publish() combines the results of the targets on the main thread and sets them on the picks.
 template<typename T>
 class PickCacheOptimizer {
 
 public:
-    QVector3D update(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks, uint32_t& nextToUpdate, uint64_t expiry, bool shouldPickHUD);
+    void prepare(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks, uint32_t nextToUpdate, bool shouldPickHUD);
+    // Intersects the prepared picks with the target until expiry, and at least one of them
+    void evaluate(PickTarget target, uint64_t expiry);
+    // Sets the results of the picks that were intersected with all their targets, and returns the number of intersections
+    // computed with each target.  The pick that the targets didn't get to is the first to update the next time.
+    QVector3D publish(uint32_t& nextToUpdate);
 
 protected:
     typedef std::unordered_map<T, std::unordered_map<PickCacheKey, PickResultPointer>> PickCache;
 
-    // Returns true if this pick exists in the cache, and if it does, update res if the cached result is closer
-    bool checkAndCompareCachedResults(T& pick, PickCache& cache, PickResultPointer& res, const PickCacheKey& key);
-    void cacheResult(const bool intersects, const PickResultPointer& resTemp, const PickCacheKey& key, PickResultPointer& res, T& mathPick, PickCache& cache, const std::shared_ptr<Pick<T>> pick);
-};
+    struct PreparedPick {
+        uint32_t id;
+        std::shared_ptr<Pick<T>> pick;
+        T mathPick;
+        bool targets[NUM_PICK_TARGETS];
+        PickCacheKey keys[NUM_PICK_TARGETS];
+        PickResultPointer results[NUM_PICK_TARGETS];
+    };
 
-template<typename T>
-bool PickCacheOptimizer<T>::checkAndCompareCachedResults(T& pick, PickCache& cache, PickResultPointer& res, const PickCacheKey& key) {
-    if (cache.find(pick) != cache.end() && cache[pick].find(key) != cache[pick].end()) {
-        res = res->compareAndProcessNewResult(cache[pick][key]);
-        return true;
-    }
-    return false;
-}
+    PickResultPointer getIntersection(PreparedPick& prepared, PickTarget target);
+
+    std::vector<PreparedPick> _prepared;
+    bool _isTargetUsed[NUM_PICK_TARGETS] { false, false, false };
+    // each target is only written to by the thread that evaluates it
+    size_t _numEvaluated[NUM_PICK_TARGETS] { 0, 0, 0 };
+    float _numIntersectionsComputed[NUM_PICK_TARGETS] { 0.0f, 0.0f, 0.0f };
+};
 
 template<typename T>
-void PickCacheOptimizer<T>::cacheResult(const bool needToCompareResults, const PickResultPointer& resTemp, const PickCacheKey& key, PickResultPointer& res, T& mathPick, PickCache& cache, const std::shared_ptr<Pick<T>> pick) {
-    if (needToCompareResults) {
-        cache[mathPick][key] = resTemp;
-        res = res->compareAndProcessNewResult(resTemp);
-    } else {
-        cache[mathPick][key] = pick->getDefaultResult(mathPick.toVariantMap());
+void PickCacheOptimizer<T>::prepare(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks, uint32_t nextToUpdate,
+        bool shouldPickHUD) {
+    _prepared.clear();
+    _prepared.reserve(picks.size());
+    for (int i = 0; i < NUM_PICK_TARGETS; i++) {
+        _isTargetUsed[i] = false;
+        _numEvaluated[i] = 0;
+        _numIntersectionsComputed[i] = 0.0f;
     }
-}
 
-template<typename T>
-QVector3D PickCacheOptimizer<T>::update(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks,
-        uint32_t& nextToUpdate, uint64_t expiry, bool shouldPickHUD) {
-    QVector3D numIntersectionsComputed;
-    PickCache results;
     const uint32_t INVALID_PICK_ID = 0;
     auto itr = picks.begin();
     if (nextToUpdate != INVALID_PICK_ID) {
@@ -79,67 +97,117 @@ QVector3D PickCacheOptimizer<T>::update(std::unordered_map<uint32_t, std::shared
             itr = picks.begin();
         }
     }
-    uint32_t numUpdates = 0;
-    while(numUpdates < picks.size()) {
+    for (size_t numPrepared = 0; numPrepared < picks.size(); ++numPrepared) {
         std::shared_ptr<Pick<T>> pick = std::static_pointer_cast<Pick<T>>(itr->second);
         T mathematicalPick = pick->getMathematicalPick();
-        PickResultPointer res = pick->getDefaultResult(mathematicalPick.toVariantMap());
 
         if (!pick->isEnabled() || pick->getMaxDistance() < 0.0f || !mathematicalPick) {
-            pick->setPickResult(res);
+            pick->setPickResult(pick->getDefaultResult(mathematicalPick.toVariantMap()));
         } else {
-            if (pick->getFilter().doesPickDomainEntities() || pick->getFilter().doesPickAvatarEntities() || pick->getFilter().doesPickLocalEntities()) {
-                PickCacheKey entityKey = { pick->getFilter().getEntityFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
-                if (!checkAndCompareCachedResults(mathematicalPick, results, res, entityKey)) {
-                    PickResultPointer entityRes = pick->getEntityIntersection(mathematicalPick);
-                    numIntersectionsComputed[0]++;
-                    if (entityRes) {
-                        cacheResult(entityRes->doesIntersect(), entityRes, entityKey, res, mathematicalPick, results, pick);
-                    }
-                }
-            }
-
-            if (pick->getFilter().doesPickAvatars()) {
-                PickCacheKey avatarKey = { pick->getFilter().getAvatarFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
-                if (!checkAndCompareCachedResults(mathematicalPick, results, res, avatarKey)) {
-                    PickResultPointer avatarRes = pick->getAvatarIntersection(mathematicalPick);
-                    numIntersectionsComputed[1]++;
-                    if (avatarRes) {
-                        cacheResult(avatarRes->doesIntersect(), avatarRes, avatarKey, res, mathematicalPick, results, pick);
-                    }
-                }
-            }
-
+            PreparedPick prepared { itr->first, pick, mathematicalPick };
+            PickFilter filter = pick->getFilter();
+            QVector<QUuid> include = pick->getIncludeItems();
+            QVector<QUuid> ignore = pick->getIgnoreItems();
+            prepared.targets[PICK_TARGET_ENTITIES] = filter.doesPickDomainEntities() || filter.doesPickAvatarEntities() ||
+                filter.doesPickLocalEntities();
+            prepared.keys[PICK_TARGET_ENTITIES] = { filter.getEntityFlags(), include, ignore };
+            prepared.targets[PICK_TARGET_AVATARS] = filter.doesPickAvatars();
+            prepared.keys[PICK_TARGET_AVATARS] = { filter.getAvatarFlags(), include, ignore };
             // Can't intersect with HUD in desktop mode
-            if (pick->getFilter().doesPickHUD() && shouldPickHUD) {
-                PickCacheKey hudKey = { pick->getFilter().getHUDFlags(), QVector<QUuid>(), QVector<QUuid>() };
-                if (!checkAndCompareCachedResults(mathematicalPick, results, res, hudKey)) {
-                    PickResultPointer hudRes = pick->getHUDIntersection(mathematicalPick);
-                    numIntersectionsComputed[2]++;
-                    if (hudRes) {
-                        cacheResult(true, hudRes, hudKey, res, mathematicalPick, results, pick);
-                    }
-                }
-            }
-
-            if (pick->getMaxDistance() == 0.0f || (pick->getMaxDistance() > 0.0f && res->checkOrFilterAgainstMaxDistance(pick->getMaxDistance()))) {
-                pick->setPickResult(res);
-            } else {
-                pick->setPickResult(pick->getDefaultResult(mathematicalPick.toVariantMap()));
+            prepared.targets[PICK_TARGET_HUD] = filter.doesPickHUD() && shouldPickHUD;
+            prepared.keys[PICK_TARGET_HUD] = { filter.getHUDFlags(), QVector<QUuid>(), QVector<QUuid>() };
+            for (int i = 0; i < NUM_PICK_TARGETS; i++) {
+                _isTargetUsed[i] = _isTargetUsed[i] || prepared.targets[i];
             }
+            _prepared.push_back(prepared);
         }
 
         ++itr;
         if (itr == picks.end()) {
             itr = picks.begin();
         }
-        nextToUpdate = itr->first;
-        ++numUpdates;
+    }
+}
+
+template<typename T>
+PickResultPointer PickCacheOptimizer<T>::getIntersection(PreparedPick& prepared, PickTarget target) {
+    switch (target) {
+        case PICK_TARGET_ENTITIES:
+            return prepared.pick->getEntityIntersection(prepared.mathPick);
+        case PICK_TARGET_AVATARS:
+            return prepared.pick->getAvatarIntersection(prepared.mathPick);
+        case PICK_TARGET_HUD:
+            return prepared.pick->getHUDIntersection(prepared.mathPick);
+        default:
+            return PickResultPointer();
+    }
+}
+
+template<typename T>
+void PickCacheOptimizer<T>::evaluate(PickTarget target, uint64_t expiry) {
+    // the same picks with the same filters are only intersected once
+    PickCache cache;
+    size_t numEvaluated = 0;
+    while (numEvaluated < _prepared.size()) {
+        PreparedPick& prepared = _prepared[numEvaluated++];
+        if (!prepared.targets[target]) {
+            continue;
+        }
+
+        auto& cachedResults = cache[prepared.mathPick];
+        auto cachedResult = cachedResults.find(prepared.keys[target]);
+        if (cachedResult != cachedResults.end()) {
+            prepared.results[target] = cachedResult->second;
+        } else {
+            PickResultPointer result = getIntersection(prepared, target);
+            _numIntersectionsComputed[target]++;
+            // only the results that hit something are compared, except on the HUD, which is always hit
+            if (result && target != PICK_TARGET_HUD && !result->doesIntersect()) {
+                result.reset();
+            }
+            cachedResults[prepared.keys[target]] = result;
+            prepared.results[target] = result;
+        }
+
         if (usecTimestampNow() > expiry) {
             break;
         }
     }
-    return numIntersectionsComputed;
+    _numEvaluated[target] = numEvaluated;
+}
+
+template<typename T>
+QVector3D PickCacheOptimizer<T>::publish(uint32_t& nextToUpdate) {
+    size_t numPublished = _prepared.size();
+    for (int i = 0; i < NUM_PICK_TARGETS; i++) {
+        if (_isTargetUsed[i]) {
+            numPublished = std::min(numPublished, _numEvaluated[i]);
+        }
+    }
+
+    for (size_t i = 0; i < numPublished; i++) {
+        PreparedPick& prepared = _prepared[i];
+        const auto& pick = prepared.pick;
+        PickResultPointer res = pick->getDefaultResult(prepared.mathPick.toVariantMap());
+        for (int j = 0; j < NUM_PICK_TARGETS; j++) {
+            if (prepared.results[j]) {
+                res = res->compareAndProcessNewResult(prepared.results[j]);
+            }
+        }
+
+        if (pick->getMaxDistance() == 0.0f || (pick->getMaxDistance() > 0.0f && res->checkOrFilterAgainstMaxDistance(pick->getMaxDistance()))) {
+            pick->setPickResult(res);
+        } else {
+            pick->setPickResult(pick->getDefaultResult(prepared.mathPick.toVariantMap()));
+        }
+    }
+    if (numPublished < _prepared.size()) {
+        nextToUpdate = _prepared[numPublished].id;
+    }
+    _prepared.clear();
+
+    return QVector3D(_numIntersectionsComputed[PICK_TARGET_ENTITIES], _numIntersectionsComputed[PICK_TARGET_AVATARS],
+        _numIntersectionsComputed[PICK_TARGET_HUD]);
 }
 
 #endif // hifi_PickCacheOptimizer_h
@@ -6,6 +6,9 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 #include "PickManager.h"
+
+#include <TBBHelpers.h>
+
 #include "PerfStat.h"
 #include "Profile.h"
 
@@ -156,27 +159,49 @@ void PickManager::update() {
     });
 
     bool shouldPickHUD = _shouldPickHUDOperator();
-    // FIXME: give each type its own expiry
-    // Each type will update at least one pick, regardless of the expiry
     {
-        PROFILE_RANGE_EX(picks, "StylusPicks", 0xffff0000, (uint64_t)_totalPickCounts[PickQuery::Stylus]);
-        PerformanceTimer perfTimer("StylusPicks");
-        _updatedPickCounts[PickQuery::Stylus] = _stylusPickCacheOptimizer.update(cachedPicks[PickQuery::Stylus], _nextPickToUpdate[PickQuery::Stylus], expiry, false);
-    }
-    {
-        PROFILE_RANGE_EX(picks, "RayPicks", 0xffff0000, (uint64_t)_totalPickCounts[PickQuery::Ray]);
-        PerformanceTimer perfTimer("RayPicks");
-        _updatedPickCounts[PickQuery::Ray] = _rayPickCacheOptimizer.update(cachedPicks[PickQuery::Ray], _nextPickToUpdate[PickQuery::Ray], expiry, shouldPickHUD);
-    }
+        PROFILE_RANGE(picks, "PreparePicks");
+        _stylusPickCacheOptimizer.prepare(cachedPicks[PickQuery::Stylus], _nextPickToUpdate[PickQuery::Stylus], false);
+        _rayPickCacheOptimizer.prepare(cachedPicks[PickQuery::Ray], _nextPickToUpdate[PickQuery::Ray], shouldPickHUD);
+        _parabolaPickCacheOptimizer.prepare(cachedPicks[PickQuery::Parabola], _nextPickToUpdate[PickQuery::Parabola], shouldPickHUD);
+        _collisionPickCacheOptimizer.prepare(cachedPicks[PickQuery::Collision], _nextPickToUpdate[PickQuery::Collision], false);
+    }
+
+    // Each type and target updates at least one pick, regardless of the expiry, and they all have the whole budget since
+    // they run in parallel: the entities, whose tree is locked for the picks, are intersected on a worker thread, and the
+    // collision picks on another one since the physics engine can only run one contact test at a time.  The avatars can
+    // only be intersected on the main thread, with the HUD.
+    tbb::task_group workers;
+    workers.run([&] {
+        PROFILE_RANGE_EX(picks, "EntityPicks", 0xffff0000, (uint64_t)(_totalPickCounts[PickQuery::Stylus] +
+            _totalPickCounts[PickQuery::Ray] + _totalPickCounts[PickQuery::Parabola]));
+        _stylusPickCacheOptimizer.evaluate(PICK_TARGET_ENTITIES, expiry);
+        _rayPickCacheOptimizer.evaluate(PICK_TARGET_ENTITIES, expiry);
+        _parabolaPickCacheOptimizer.evaluate(PICK_TARGET_ENTITIES, expiry);
+    });
+    workers.run([&] {
+        PROFILE_RANGE_EX(picks, "CollisionPicks", 0xffff0000, (uint64_t)_totalPickCounts[PickQuery::Collision]);
+        _collisionPickCacheOptimizer.evaluate(PICK_TARGET_ENTITIES, expiry);
+        _collisionPickCacheOptimizer.evaluate(PICK_TARGET_AVATARS, expiry);
+    });
     {
-        PROFILE_RANGE_EX(picks, "ParabolaPicks", 0xffff0000, (uint64_t)_totalPickCounts[PickQuery::Parabola]);
-        PerformanceTimer perfTimer("ParabolaPicks");
-        _updatedPickCounts[PickQuery::Parabola] = _parabolaPickCacheOptimizer.update(cachedPicks[PickQuery::Parabola], _nextPickToUpdate[PickQuery::Parabola], expiry, shouldPickHUD);
+        PROFILE_RANGE_EX(picks, "AvatarAndHUDPicks", 0xffff0000, (uint64_t)(_totalPickCounts[PickQuery::Ray] +
+            _totalPickCounts[PickQuery::Parabola]));
+        _stylusPickCacheOptimizer.evaluate(PICK_TARGET_AVATARS, expiry);
+        _rayPickCacheOptimizer.evaluate(PICK_TARGET_AVATARS, expiry);
+        _parabolaPickCacheOptimizer.evaluate(PICK_TARGET_AVATARS, expiry);
+        _rayPickCacheOptimizer.evaluate(PICK_TARGET_HUD, expiry);
+        _parabolaPickCacheOptimizer.evaluate(PICK_TARGET_HUD, expiry);
     }
+    workers.wait();
+
+    // the results of all the picks are set together, once all their targets are intersected
     {
-        PROFILE_RANGE_EX(picks, "CollisionPicks", 0xffff0000, (uint64_t)_totalPickCounts[PickQuery::Collision]);
-        PerformanceTimer perfTimer("CollisionPicks");
-        _updatedPickCounts[PickQuery::Collision] = _collisionPickCacheOptimizer.update(cachedPicks[PickQuery::Collision], _nextPickToUpdate[PickQuery::Collision], expiry, false);
+        PROFILE_RANGE(picks, "PublishPicks");
+        _updatedPickCounts[PickQuery::Stylus] = _stylusPickCacheOptimizer.publish(_nextPickToUpdate[PickQuery::Stylus]);
+        _updatedPickCounts[PickQuery::Ray] = _rayPickCacheOptimizer.publish(_nextPickToUpdate[PickQuery::Ray]);
+        _updatedPickCounts[PickQuery::Parabola] = _parabolaPickCacheOptimizer.publish(_nextPickToUpdate[PickQuery::Parabola]);
+        _updatedPickCounts[PickQuery::Collision] = _collisionPickCacheOptimizer.publish(_nextPickToUpdate[PickQuery::Collision]);
     }
 }
 
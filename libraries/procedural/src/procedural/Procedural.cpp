@@ -14,6 +14,7 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QDateTime>
+#include <QtCore/QCryptographicHash>
 
 #include <gpu/Batch.h>
 #include <SharedUtil.h>
@@ -21,6 +22,7 @@
 #include <GLMHelpers.h>
 #include <NetworkingConstants.h>
 #include <MetaverseAPI.h>
+#include <Profile.h>
 #include <shaders/Shaders.h>
 
 #include "ShaderConstants.h"
@@ -41,6 +43,38 @@ static const QString CHANNELS_KEY = "channels";
 static const std::string PROCEDURAL_BLOCK = "//PROCEDURAL_BLOCK";
 static const std::string PROCEDURAL_VERSION = "//PROCEDURAL_VERSION";
 
+// The programs of all the procedurals by the hash of their sources, so that the entities, skyboxes and materials with the
+// same shaders share one program that is compiled once.  A program is released with the last pipeline that uses it.
+class ProceduralProgramCache {
+public:
+    static ProceduralProgramCache& instance() {
+        static ProceduralProgramCache cache;
+        return cache;
+    }
+
+    gpu::ShaderPointer get(const std::string& hash) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto program = _programs.find(hash);
+        return program != _programs.end() ? program->second.lock() : gpu::ShaderPointer();
+    }
+
+    void insert(const std::string& hash, const gpu::ShaderPointer& program) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto itr = _programs.begin(); itr != _programs.end();) {
+            if (itr->second.expired()) {
+                itr = _programs.erase(itr);
+            } else {
+                ++itr;
+            }
+        }
+        _programs[hash] = program;
+    }
+
+private:
+    std::mutex _mutex;
+    std::unordered_map<std::string, std::weak_ptr<gpu::Shader>> _programs;
+};
+
 bool operator==(const ProceduralData& a, const ProceduralData& b) {
     return ((a.version == b.version) &&
             (a.fragmentShaderUrl == b.fragmentShaderUrl) &&
@@ -325,57 +359,22 @@ void Procedural::prepare(gpu::Batch& batch,
 
         gpu::Shader::Source& fragmentSource = (key.isTransparent() && _transparentFragmentSource.valid()) ? _transparentFragmentSource : _opaqueFragmentSource;
 
-        // Build the fragment and vertex shaders
-        auto versionDefine = "#define PROCEDURAL_V" + std::to_string(_data.version);
-        fragmentSource.replacements.clear();
-        fragmentSource.replacements[PROCEDURAL_VERSION] = versionDefine;
-        if (!_fragmentShaderSource.isEmpty()) {
-            fragmentSource.replacements[PROCEDURAL_BLOCK] = _fragmentShaderSource.toStdString();
-        }
-        vertexSource.replacements.clear();
-        vertexSource.replacements[PROCEDURAL_VERSION] = versionDefine;
-        if (!_vertexShaderSource.isEmpty()) {
-            vertexSource.replacements[PROCEDURAL_BLOCK] = _vertexShaderSource.toStdString();
-        }
-
-        // Set any userdata specified uniforms (if any)
-        if (!_data.uniforms.empty()) {
-            // First grab all the possible dialect/variant/reflections
-            std::vector<shader::Reflection*> allFragmentReflections;
-            for (auto dialectIt = fragmentSource.dialectSources.begin(); dialectIt != fragmentSource.dialectSources.end(); ++dialectIt) {
-                for (auto variantIt = (*dialectIt).second.variantSources.begin(); variantIt != (*dialectIt).second.variantSources.end(); ++variantIt) {
-                    allFragmentReflections.push_back(&(*variantIt).second.reflection);
-                }
-            }
-            std::vector<shader::Reflection*> allVertexReflections;
-            for (auto dialectIt = vertexSource.dialectSources.begin(); dialectIt != vertexSource.dialectSources.end(); ++dialectIt) {
-                for (auto variantIt = (*dialectIt).second.variantSources.begin(); variantIt != (*dialectIt).second.variantSources.end(); ++variantIt) {
-                    allVertexReflections.push_back(&(*variantIt).second.reflection);
-                }
-            }
-            // Then fill in every reflections the new custom bindings
-            int customSlot = procedural::slot::uniform::Custom;
-            for (const auto& key : _data.uniforms.keys()) {
-                std::string uniformName = key.toLocal8Bit().data();
-                for (auto reflection : allFragmentReflections) {
-                    reflection->uniforms[uniformName] = customSlot;
-                }
-                for (auto reflection : allVertexReflections) {
-                    reflection->uniforms[uniformName] = customSlot;
-                }
-                ++customSlot;
-            }
+        auto programHash = getProgramHash(vertexSource, fragmentSource);
+        gpu::ShaderPointer program = ProceduralProgramCache::instance().get(programHash);
+        if (!program) {
+            program = createProgram(vertexSource, fragmentSource);
+            ProceduralProgramCache::instance().insert(programHash, program);
         }
 
-        // Leave this here for debugging
-        //qCDebug(proceduralLog) << "FragmentShader:\n" << fragmentSource.getSource(shader::Dialect::glsl450, shader::Variant::Mono).c_str();
-        //qCDebug(proceduralLog) << "VertexShader:\n" << vertexSource.getSource(shader::Dialect::glsl450, shader::Variant::Mono).c_str();
-
-        gpu::ShaderPointer vertexShader = gpu::Shader::createVertex(vertexSource);
-        gpu::ShaderPointer fragmentShader = gpu::Shader::createPixel(fragmentSource);
-        gpu::ShaderPointer program = gpu::Shader::createProgram(vertexShader, fragmentShader);
-
         _proceduralPipelines[key] = gpu::Pipeline::create(program, key.isTransparent() ? _transparentState : _opaqueState);
+        // The backend skips the draws of the pipeline until it has compiled the program, which it can do in the background
+        if (program->isCompiled()) {
+            _compilationTime = program->getCompilationTime();
+            _compilingProgram.reset();
+        } else {
+            _compilationTime = 0;
+            _compilingProgram = program;
+        }
 
         _lastCompile = usecTimestampNow();
         if (_firstCompile == 0) {
@@ -385,6 +384,13 @@ void Procedural::prepare(gpu::Batch& batch,
         recompiledShader = true;
     }
 
+    if (_compilingProgram && _compilingProgram->isCompiled()) {
+        _compilationTime = _compilingProgram->getCompilationTime();
+        qCDebug(proceduralLog) << "Procedural shader" << _data.fragmentShaderUrl << _data.vertexShaderUrl << "compiled in"
+                               << (float)_compilationTime / (float)USECS_PER_MSEC << "msec";
+        _compilingProgram.reset();
+    }
+
     // FIXME: need to handle forward rendering
     batch.setPipeline(recompiledShader ? _proceduralPipelines[key] : pipeline->second);
 
@@ -419,6 +425,75 @@ void Procedural::prepare(gpu::Batch& batch,
 }
 
 
+std::string Procedural::getProgramHash(const gpu::Shader::Source& vertexSource, const gpu::Shader::Source& fragmentSource) const {
+    // The programs are the same if they have the same base shaders, the same procedural code and the same custom uniforms,
+    // which are bound in the order of their names
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray::number(vertexSource.id) + ":" + QByteArray::number(fragmentSource.id) + ":" +
+        QByteArray::number(_data.version) + ":");
+    hash.addData(_vertexShaderSource.toUtf8());
+    hash.addData(":");
+    hash.addData(_fragmentShaderSource.toUtf8());
+    for (const auto& key : _data.uniforms.keys()) {
+        hash.addData(":");
+        hash.addData(key.toUtf8());
+    }
+    return hash.result().toHex().toStdString();
+}
+
+gpu::ShaderPointer Procedural::createProgram(gpu::Shader::Source& vertexSource, gpu::Shader::Source& fragmentSource) {
+    PROFILE_RANGE(render, "Procedural::createProgram");
+    // Build the fragment and vertex shaders
+    auto versionDefine = "#define PROCEDURAL_V" + std::to_string(_data.version);
+    fragmentSource.replacements.clear();
+    fragmentSource.replacements[PROCEDURAL_VERSION] = versionDefine;
+    if (!_fragmentShaderSource.isEmpty()) {
+        fragmentSource.replacements[PROCEDURAL_BLOCK] = _fragmentShaderSource.toStdString();
+    }
+    vertexSource.replacements.clear();
+    vertexSource.replacements[PROCEDURAL_VERSION] = versionDefine;
+    if (!_vertexShaderSource.isEmpty()) {
+        vertexSource.replacements[PROCEDURAL_BLOCK] = _vertexShaderSource.toStdString();
+    }
+
+    // Set any userdata specified uniforms (if any)
+    if (!_data.uniforms.empty()) {
+        // First grab all the possible dialect/variant/reflections
+        std::vector<shader::Reflection*> allFragmentReflections;
+        for (auto dialectIt = fragmentSource.dialectSources.begin(); dialectIt != fragmentSource.dialectSources.end(); ++dialectIt) {
+            for (auto variantIt = (*dialectIt).second.variantSources.begin(); variantIt != (*dialectIt).second.variantSources.end(); ++variantIt) {
+                allFragmentReflections.push_back(&(*variantIt).second.reflection);
+            }
+        }
+        std::vector<shader::Reflection*> allVertexReflections;
+        for (auto dialectIt = vertexSource.dialectSources.begin(); dialectIt != vertexSource.dialectSources.end(); ++dialectIt) {
+            for (auto variantIt = (*dialectIt).second.variantSources.begin(); variantIt != (*dialectIt).second.variantSources.end(); ++variantIt) {
+                allVertexReflections.push_back(&(*variantIt).second.reflection);
+            }
+        }
+        // Then fill in every reflections the new custom bindings
+        int customSlot = procedural::slot::uniform::Custom;
+        for (const auto& key : _data.uniforms.keys()) {
+            std::string uniformName = key.toLocal8Bit().data();
+            for (auto reflection : allFragmentReflections) {
+                reflection->uniforms[uniformName] = customSlot;
+            }
+            for (auto reflection : allVertexReflections) {
+                reflection->uniforms[uniformName] = customSlot;
+            }
+            ++customSlot;
+        }
+    }
+
+    // Leave this here for debugging
+    //qCDebug(proceduralLog) << "FragmentShader:\n" << fragmentSource.getSource(shader::Dialect::glsl450, shader::Variant::Mono).c_str();
+    //qCDebug(proceduralLog) << "VertexShader:\n" << vertexSource.getSource(shader::Dialect::glsl450, shader::Variant::Mono).c_str();
+
+    gpu::ShaderPointer vertexShader = gpu::Shader::createVertex(vertexSource);
+    gpu::ShaderPointer fragmentShader = gpu::Shader::createPixel(fragmentSource);
+    return gpu::Shader::createProgram(vertexShader, fragmentShader);
+}
+
 void Procedural::setupUniforms() {
     _uniforms.clear();
     // Set any userdata specified uniforms
@@ -520,6 +595,16 @@ glm::vec4 Procedural::getColor(const glm::vec4& entityColor) const {
     return entityColor;
 }
 
+bool Procedural::isCompiling() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (bool)_compilingProgram;
+}
+
+uint64_t Procedural::getCompilationTime() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _compilationTime;
+}
+
 bool Procedural::hasVertexShader() const {
     std::lock_guard<std::mutex> lock(_mutex);
     return !_data.vertexShaderUrl.isEmpty();
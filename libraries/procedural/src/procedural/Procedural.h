@@ -114,6 +114,12 @@ public:
     void setDoesFade(bool doesFade) { _doesFade = doesFade; }
 
     bool hasVertexShader() const;
+
+    // Whether the program of the last pipeline that was prepared is still compiling, in which case it isn't drawn
+    bool isCompiling() const;
+    // The time that it took to compile the program of the last pipeline that was prepared, in usecs
+    uint64_t getCompilationTime() const;
+
     void setBoundOperator(const std::function<AABox(RenderArgs*)>& boundOperator) { _boundOperator = boundOperator; }
     bool hasBoundOperator() const { return (bool)_boundOperator; }
     AABox getBound(RenderArgs* args) { return _boundOperator(args); }
@@ -181,6 +187,8 @@ protected:
     NetworkTexturePointer _channels[MAX_PROCEDURAL_TEXTURE_CHANNELS];
 
     std::unordered_map<ProceduralProgramKey, gpu::PipelinePointer> _proceduralPipelines;
+    gpu::ShaderPointer _compilingProgram;
+    uint64_t _compilationTime { 0 };
 
     StandardInputs _standardInputs;
     gpu::BufferPointer _standardInputsBuffer;
@@ -192,6 +200,8 @@ protected:
     uint64_t _entityCreated;
 
 private:
+    std::string getProgramHash(const gpu::Shader::Source& vertexSource, const gpu::Shader::Source& fragmentSource) const;
+    gpu::ShaderPointer createProgram(gpu::Shader::Source& vertexSource, gpu::Shader::Source& fragmentSource);
     void setupUniforms();
 
     mutable uint64_t _fadeStartTime { 0 };
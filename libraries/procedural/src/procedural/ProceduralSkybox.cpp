@@ -45,6 +45,10 @@ void ProceduralSkybox::clear() {
 
 void ProceduralSkybox::render(gpu::Batch& batch, const ViewFrustum& frustum, bool forward) const {
     if (_procedural.isReady()) {
+        // the procedural isn't drawn until its program is compiled, so the regular skybox is drawn under it in the meantime
+        if (_procedural.isCompiling()) {
+            Skybox::render(batch, frustum, forward);
+        }
         ProceduralSkybox::render(batch, frustum, (*this), forward);
     } else {
         Skybox::render(batch, frustum, forward);
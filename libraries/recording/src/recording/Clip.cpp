@@ -8,6 +8,8 @@
 
 #include "Clip.h"
 
+#include <algorithm>
+
 #include "Frame.h"
 #include "Logging.h"
 
@@ -91,8 +93,28 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
     return true;
 }
 
+// the entries are split in frames under the maximum size of a frame
+static const size_t MAX_INDEX_FRAME_ENTRIES = std::numeric_limits<FrameSize>::max() / sizeof(FrameIndexEntry);
+
+static bool writeIndex(QIODevice& output, const std::vector<FrameIndexEntry>& entries) {
+    FrameIndexLocator locator;
+    locator.indexOffset = output.pos();
+    locator.frameCount = (quint32)entries.size();
+    locator.magic = FrameIndexLocator::MAGIC;
+    for (size_t i = 0; i < entries.size(); i += MAX_INDEX_FRAME_ENTRIES) {
+        size_t numEntries = std::min(MAX_INDEX_FRAME_ENTRIES, entries.size() - i);
+        QByteArray indexData((const char*)&entries[i], (int)(numEntries * sizeof(FrameIndexEntry)));
+        if (!writeFrame(output, Frame({ Frame::TYPE_INDEX, 0, indexData }), false)) {
+            return false;
+        }
+    }
+    QByteArray locatorData((const char*)&locator, sizeof(FrameIndexLocator));
+    return writeFrame(output, Frame({ Frame::TYPE_INDEX, 0, locatorData }), false);
+}
+
 const QString Clip::FRAME_TYPE_MAP = QStringLiteral("frameTypes");
 const QString Clip::FRAME_COMREPSSION_FLAG = QStringLiteral("compressed");
+const QString Clip::FRAME_INDEX_FLAG = QStringLiteral("indexed");
 
 bool Clip::write(QIODevice& output) {
     auto frameTypes = Frame::getFrameTypes();
@@ -105,6 +127,9 @@ bool Clip::write(QIODevice& output) {
     rootObject.insert(FRAME_TYPE_MAP, frameTypeObj);
     // Always mark new files as compressed
     rootObject.insert(FRAME_COMREPSSION_FLAG, true);
+    // the offsets of the frames can only be known on devices with a position
+    bool indexed = !output.isSequential();
+    rootObject.insert(FRAME_INDEX_FLAG, indexed);
     OVERTE_IGNORE_DEPRECATED_BEGIN
     // Can't use CBOR yet, will break the protocol.
     QByteArray headerFrameData = QJsonDocument(rootObject).toBinaryData();
@@ -116,10 +141,24 @@ bool Clip::write(QIODevice& output) {
 
     seek(0);
 
+    std::vector<FrameIndexEntry> indexEntries;
+    if (indexed) {
+        indexEntries.reserve(frameCount());
+    }
     for (auto frame = nextFrame(); frame; frame = nextFrame()) {
+        qint64 frameOffset = indexed ? output.pos() : 0;
         if (!writeFrame(output, *frame)) {
             return false;
         }
+        // the invalid frames aren't written
+        if (indexed && output.pos() > frameOffset) {
+            FrameIndexEntry entry;
+            entry.type = frame->type;
+            entry.timeOffset = frame->timeOffset;
+            entry.fileOffset = frameOffset + PointerClip::MINIMUM_FRAME_SIZE;
+            entry.size = (FrameSize)(output.pos() - (qint64)entry.fileOffset);
+            indexEntries.push_back(entry);
+        }
     }
-    return true;
+    return !indexed || writeIndex(output, indexEntries);
 }
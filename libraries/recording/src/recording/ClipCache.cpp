@@ -27,8 +27,37 @@ NetworkClipLoader::NetworkClipLoader(const QUrl& url) :
 }
 
 void NetworkClip::init(const QByteArray& clipData) {
+    // the local recordings are mapped rather than kept in memory, so that the processes playing the same recording,
+    // such as agents replaying it, share its pages
+    if (_file.isOpen()) {
+        _file.unmap(_data);
+        _file.close();
+    }
+    if (_url.isLocalFile()) {
+        _file.setFileName(_url.toLocalFile());
+        if (_file.open(QIODevice::ReadOnly)) {
+            auto size = _file.size();
+            auto mappedFile = _file.map(0, size, QFile::MapPrivateOption);
+            if (mappedFile) {
+                PointerClip::init(mappedFile, size);
+                return;
+            }
+            _file.close();
+        }
+    }
+
+    // the clip only reads the data, constData doesn't detach it from the downloaded copy
     _clipData = clipData;
-    PointerClip::init((uchar*)_clipData.data(), _clipData.size());
+    PointerClip::init(const_cast<uchar*>(reinterpret_cast<const uchar*>(_clipData.constData())), _clipData.size());
+}
+
+NetworkClip::~NetworkClip() {
+    Locker lock(_mutex);
+    if (_file.isOpen()) {
+        _file.unmap(_data);
+        _file.close();
+    }
+    reset();
 }
 
 void NetworkClipLoader::downloadFinished(const QByteArray& data) {
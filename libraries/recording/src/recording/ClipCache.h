@@ -9,6 +9,7 @@
 #ifndef hifi_Recording_ClipCache_h
 #define hifi_Recording_ClipCache_h
 
+#include <QtCore/QFile>
 #include <QtCore/QSharedPointer>
 
 #include <ResourceCache.h>
@@ -23,11 +24,14 @@ public:
     using Pointer = std::shared_ptr<NetworkClip>;
 
     NetworkClip(const QUrl& url) : _url(url) {}
+    virtual ~NetworkClip();
     virtual void init(const QByteArray& clipData);
     virtual QString getName() const override { return _url.toString(); }
 
 private:
     QByteArray _clipData;
+    // the local recordings are played from the mapped file
+    QFile _file;
     QUrl _url;
 };
 
@@ -36,6 +36,8 @@ struct FrameHeader {
 
     static const FrameType TYPE_INVALID = 0xFFFF;
     static const FrameType TYPE_HEADER = 0x0;
+    // the index at the end of the clip files, it's never registered so the versions that don't read it skip it
+    static const FrameType TYPE_INDEX = 0xFFFD;
 
     static Time secondsToFrameTime(float seconds);
     static float frameTimeToSeconds(Time frameTime);
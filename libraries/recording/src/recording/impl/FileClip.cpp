@@ -29,7 +29,12 @@ FileClip::FileClip(const QString& fileName) : _file(fileName) {
         qCWarning(recordingLog) << "Unable to open file " << fileName;
         return;
     }
+    // the frames are read from the mapped file as they're played, only the pages of the index are read to open it
     auto mappedFile = _file.map(0, size, QFile::MapPrivateOption);
+    if (!mappedFile) {
+        qCWarning(recordingLog) << "Unable to map file " << fileName;
+        return;
+    }
     init(mappedFile, size);
 }
 
@@ -45,35 +45,81 @@ FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
 }
 
 
-PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size) {
+// Reads the header of the frame at offset, returns false if the frame is truncated
+static bool parseFrameHeader(uchar* const start, size_t size, size_t offset, PointerFrameHeader& header) {
+    if (offset > size || size - offset < (size_t)PointerClip::MINIMUM_FRAME_SIZE) {
+        return false;
+    }
+    auto current = start + offset;
+    memcpy(&(header.type), current, sizeof(FrameType));
+    current += sizeof(FrameType);
+    memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
+    current += sizeof(Frame::Time);
+    memcpy(&(header.size), current, sizeof(FrameSize));
+    current += sizeof(FrameSize);
+    header.fileOffset = current - start;
+    return size - header.fileOffset >= header.size;
+}
+
+PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size, size_t offset) {
     PointerFrameHeaderList results;
-    auto current = start;
-    auto end = current + size;
     // Read all the frame headers
-    // FIXME move to Frame::readHeader?
-    while (end - current >= PointerClip::MINIMUM_FRAME_SIZE) {
-        PointerFrameHeader header;
-        memcpy(&(header.type), current, sizeof(FrameType));
-        current += sizeof(FrameType);
-        memcpy(&(header.timeOffset), current, sizeof(Frame::Time));
-        current += sizeof(Frame::Time);
-        memcpy(&(header.size), current, sizeof(FrameSize));
-        current += sizeof(FrameSize);
-        header.fileOffset = current - start;
-        if (end - current < header.size) {
-            break;
-        }
-        current += header.size;
+    PointerFrameHeader header;
+    while (parseFrameHeader(start, size, offset, header)) {
         results.push_back(header);
+        offset = header.fileOffset + header.size;
     }
     qDebug(recordingLog) << "Parsed source data into " << results.size() << " frames";
-//    int i = 0;
-//    for (const auto& frameHeader : results) {
-//        qDebug(recordingLog) << "Frame " << i++ << " time " << frameHeader.timeOffset << " Type " << frameHeader.type;
-//    }
     return results;
 }
 
+// Reads the frame headers from the index at the end of the data, returns false if there's no valid index
+static bool parseFrameIndex(uchar* const start, size_t size, size_t firstFrameOffset, PointerFrameHeaderList& results) {
+    const size_t LOCATOR_FRAME_SIZE = PointerClip::MINIMUM_FRAME_SIZE + sizeof(FrameIndexLocator);
+    PointerFrameHeader locatorHeader;
+    if (size < firstFrameOffset + LOCATOR_FRAME_SIZE || !parseFrameHeader(start, size, size - LOCATOR_FRAME_SIZE, locatorHeader) ||
+        locatorHeader.type != Frame::TYPE_INDEX || locatorHeader.size != sizeof(FrameIndexLocator)) {
+        return false;
+    }
+    FrameIndexLocator locator;
+    memcpy(&locator, start + locatorHeader.fileOffset, sizeof(FrameIndexLocator));
+    if (locator.magic != FrameIndexLocator::MAGIC || locator.indexOffset < firstFrameOffset ||
+        locator.indexOffset > size - LOCATOR_FRAME_SIZE) {
+        return false;
+    }
+
+    results.clear();
+    results.reserve(locator.frameCount);
+    size_t offset = locator.indexOffset;
+    while (results.size() < locator.frameCount) {
+        PointerFrameHeader indexHeader;
+        if (!parseFrameHeader(start, size, offset, indexHeader) || indexHeader.type != Frame::TYPE_INDEX ||
+            indexHeader.size == 0 || indexHeader.size % sizeof(FrameIndexEntry) != 0) {
+            return false;
+        }
+        auto entryData = start + indexHeader.fileOffset;
+        size_t numEntries = indexHeader.size / sizeof(FrameIndexEntry);
+        for (size_t i = 0; i < numEntries && results.size() < locator.frameCount; i++) {
+            FrameIndexEntry entry;
+            memcpy(&entry, entryData + i * sizeof(FrameIndexEntry), sizeof(FrameIndexEntry));
+            // the frames are all between the file header and the index
+            if (entry.fileOffset < firstFrameOffset + (size_t)PointerClip::MINIMUM_FRAME_SIZE ||
+                entry.fileOffset + entry.size > locator.indexOffset) {
+                return false;
+            }
+            PointerFrameHeader header;
+            header.type = entry.type;
+            header.timeOffset = entry.timeOffset;
+            header.size = entry.size;
+            header.fileOffset = entry.fileOffset;
+            results.push_back(header);
+        }
+        offset = indexHeader.fileOffset + indexHeader.size;
+    }
+    qDebug(recordingLog) << "Read the index of " << results.size() << " frames";
+    return true;
+}
+
 void PointerClip::reset() {
     _frames.clear();
     _data = nullptr;
@@ -87,24 +133,19 @@ void PointerClip::init(uchar* data, size_t size) {
     _data = data;
     _size = size;
 
-    auto parsedFrameHeaders = parseFrameHeaders(data, size);
-    // Verify that at least one frame exists and that the first frame is a header
-    if (0 == parsedFrameHeaders.size()) {
+    // Grab the file header, the first frame
+    PointerFrameHeader fileHeaderFrameHeader;
+    if (!parseFrameHeader(data, size, 0, fileHeaderFrameHeader)) {
         qWarning() << "No frames found, invalid file";
         reset();
         return;
     }
-
-    // Grab the file header
+    if (fileHeaderFrameHeader.type != Frame::TYPE_HEADER) {
+        qWarning() << "Missing header frame, invalid file";
+        reset();
+        return;
+    }
     {
-        auto fileHeaderFrameHeader = *parsedFrameHeaders.begin();
-        parsedFrameHeaders.pop_front();
-        if (fileHeaderFrameHeader.type != Frame::TYPE_HEADER) {
-            qWarning() << "Missing header frame, invalid file";
-            reset();
-            return;
-        }
-
         QByteArray fileHeaderData((char*)_data + fileHeaderFrameHeader.fileOffset, fileHeaderFrameHeader.size);
 
         OVERTE_IGNORE_DEPRECATED_BEGIN
@@ -127,6 +168,14 @@ void PointerClip::init(uchar* data, size_t size) {
             return;
         }
 
+        // The clips with an index are opened without going through all their frames, which for long recordings
+        // would page in the whole file
+        size_t firstFrameOffset = fileHeaderFrameHeader.fileOffset + fileHeaderFrameHeader.size;
+        PointerFrameHeaderList parsedFrameHeaders;
+        if (!_header.object()[FRAME_INDEX_FLAG].toBool() || !parseFrameIndex(data, size, firstFrameOffset, parsedFrameHeaders)) {
+            parsedFrameHeaders = parseFrameHeaders(data, size, firstFrameOffset);
+        }
+
         // Update the loaded headers with the frame data
         _frames.reserve(parsedFrameHeaders.size());
         for (auto& frameHeader : parsedFrameHeaders) {
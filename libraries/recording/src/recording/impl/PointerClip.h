@@ -27,7 +27,24 @@ struct PointerFrameHeader : public FrameHeader {
     quint64 fileOffset;
 };
 
-using PointerFrameHeaderList = std::list<PointerFrameHeader>;
+using PointerFrameHeaderList = std::vector<PointerFrameHeader>;
+
+// The clips written to a file or a buffer end with an index of their frames, so that they're opened without reading
+// every frame.  The entries are stored in frames of type Frame::TYPE_INDEX, followed by a last frame holding the locator.
+struct FrameIndexEntry {
+    FrameType type;
+    FrameSize size;
+    Frame::Time timeOffset;
+    quint64 fileOffset;
+};
+
+struct FrameIndexLocator {
+    static const uint32_t MAGIC = 0x58444E49; // "INDX"
+
+    quint64 indexOffset; // of the first index frame
+    quint32 frameCount;
+    quint32 magic;
+};
 
 class PointerClip : public ArrayClip<PointerFrameHeader> {
 public:
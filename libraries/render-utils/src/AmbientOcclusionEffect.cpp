@@ -36,6 +36,7 @@ gpu::PipelinePointer AmbientOcclusionEffect::_bilateralBlurPipeline;
 gpu::PipelinePointer AmbientOcclusionEffect::_mipCreationPipeline;
 gpu::PipelinePointer AmbientOcclusionEffect::_gatherPipeline;
 gpu::PipelinePointer AmbientOcclusionEffect::_buildNormalsPipeline;
+gpu::PipelinePointer AmbientOcclusionEffect::_temporalPipeline;
 
 AmbientOcclusionFramebuffer::AmbientOcclusionFramebuffer() {
 }
@@ -75,6 +76,11 @@ void AmbientOcclusionFramebuffer::clear() {
     _occlusionBlurredTexture.reset();
     _normalFramebuffer.reset();
     _normalTexture.reset();
+    for (int i = 0; i < 2; i++) {
+        _occlusionHistoryFramebuffers[i].reset();
+        _occlusionHistoryTextures[i].reset();
+    }
+    _isHistoryValid = false;
 }
 
 gpu::TexturePointer AmbientOcclusionFramebuffer::getLinearDepthTexture() {
@@ -145,6 +151,69 @@ void AmbientOcclusionFramebuffer::allocate() {
 #endif
 }
 
+void AmbientOcclusionFramebuffer::allocateHistory() {
+#if SSAO_BILATERAL_BLUR_USE_NORMAL    
+    auto occlusionformat = gpu::Element{ gpu::VEC4, gpu::HALF, gpu::RGBA };
+#else
+    auto occlusionformat = gpu::Element{ gpu::VEC3, gpu::NUINT8, gpu::RGB };
+#endif
+    auto width = _frameSize.x;
+    auto height = _frameSize.y;
+    auto sampler = gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_LINEAR, gpu::Sampler::WRAP_CLAMP);
+
+    for (int i = 0; i < 2; i++) {
+        _occlusionHistoryTextures[i] = gpu::Texture::createRenderBuffer(occlusionformat, width, height, gpu::Texture::SINGLE_MIP, sampler);
+        _occlusionHistoryFramebuffers[i] = gpu::FramebufferPointer(gpu::Framebuffer::create("occlusionHistory"));
+        _occlusionHistoryFramebuffers[i]->setRenderBuffer(0, _occlusionHistoryTextures[i]);
+    }
+    _isHistoryValid = false;
+}
+
+void AmbientOcclusionFramebuffer::setTemporalEnabled(bool enabled) {
+    if (_isTemporalEnabled != enabled) {
+        _isTemporalEnabled = enabled;
+        if (!enabled) {
+            // Free the history, it will start again from the occlusion of a single frame
+            for (int i = 0; i < 2; i++) {
+                _occlusionHistoryFramebuffers[i].reset();
+                _occlusionHistoryTextures[i].reset();
+            }
+        }
+        _isHistoryValid = false;
+    }
+}
+
+void AmbientOcclusionFramebuffer::swapOcclusionHistory() {
+    if (!_occlusionHistoryFramebuffers[0]) {
+        allocateHistory();
+    } else {
+        // The previous frame was accumulated into the current history buffer, so from now on it holds a valid history
+        _isHistoryValid = true;
+    }
+    _historyIndex = 1 - _historyIndex;
+}
+
+gpu::FramebufferPointer AmbientOcclusionFramebuffer::getOcclusionHistoryFramebuffer() {
+    if (!_occlusionHistoryFramebuffers[0]) {
+        allocateHistory();
+    }
+    return _occlusionHistoryFramebuffers[_historyIndex];
+}
+
+gpu::TexturePointer AmbientOcclusionFramebuffer::getOcclusionHistoryTexture() {
+    if (!_occlusionHistoryTextures[0]) {
+        allocateHistory();
+    }
+    return _occlusionHistoryTextures[_historyIndex];
+}
+
+gpu::TexturePointer AmbientOcclusionFramebuffer::getPreviousOcclusionHistoryTexture() {
+    if (!_occlusionHistoryTextures[0]) {
+        allocateHistory();
+    }
+    return _occlusionHistoryTextures[1 - _historyIndex];
+}
+
 #if SSAO_USE_QUAD_SPLIT
 gpu::FramebufferPointer AmbientOcclusionFramebuffer::getOcclusionSplitFramebuffer(int index) {
     assert(index < SSAO_SPLIT_COUNT*SSAO_SPLIT_COUNT);
@@ -170,6 +239,9 @@ gpu::FramebufferPointer AmbientOcclusionFramebuffer::getOcclusionFramebuffer() {
 }
 
 gpu::TexturePointer AmbientOcclusionFramebuffer::getOcclusionTexture() {
+    if (_isTemporalEnabled) {
+        return getOcclusionHistoryTexture();
+    }
     if (!_occlusionTexture) {
         allocate();
     }
@@ -210,6 +282,7 @@ AmbientOcclusionEffectConfig::AmbientOcclusionEffectConfig() :
     edgeSharpness{ 1.0f },
     blurRadius{ 4 },
     resolutionLevel{ 2 },
+    temporalBlend{ 0.9f },
 
     ssaoRadius{ 1.0f },
     ssaoObscuranceLevel{ 0.4f },
@@ -226,7 +299,8 @@ AmbientOcclusionEffectConfig::AmbientOcclusionEffectConfig() :
     ditheringEnabled{ true },
     borderingEnabled{ true },
     fetchMipsEnabled{ true },
-    jitterEnabled{ false }{
+    jitterEnabled{ false },
+    temporalEnabled{ false }{
 }
 
 void AmbientOcclusionEffectConfig::setSSAORadius(float newRadius) {
@@ -287,6 +361,11 @@ void AmbientOcclusionEffectConfig::setBlurRadius(int radius) {
     emit dirty(); 
 }
 
+void AmbientOcclusionEffectConfig::setTemporalBlend(float blend) {
+    temporalBlend = std::max(0.0f, std::min(blend, 0.98f));
+    emit dirty();
+}
+
 AmbientOcclusionEffect::AOParameters::AOParameters() {
     _resolutionInfo = glm::vec4{ 0.0f };
     _radiusInfo = glm::vec4{ 0.0f };
@@ -306,7 +385,11 @@ void AmbientOcclusionEffect::configure(const Config& config) {
     bool shouldUpdateBlurs = false;
     bool shouldUpdateTechnique = false;
 
-    _isJitterEnabled = config.jitterEnabled;
+    // The temporal accumulation needs a different rotation of the samples at each frame to converge
+    _isJitterEnabled = config.jitterEnabled || config.temporalEnabled;
+    _isTemporalEnabled = config.temporalEnabled;
+    _temporalBlend = config.temporalBlend;
+    const int sampleDivider = config.temporalEnabled ? config.TEMPORAL_SAMPLE_DIVIDER : 1;
 
     if (!_framebuffer) {
         _framebuffer = std::make_shared<AmbientOcclusionFramebuffer>();
@@ -392,10 +475,11 @@ void AmbientOcclusionEffect::configure(const Config& config) {
             current.w = 1.0f / current.z;
         }
 
-        if (shouldUpdateTechnique || config.hbaoNumSamples != _aoParametersBuffer->getNumSamples()) {
+        const int numSamples = std::max(1, config.hbaoNumSamples / sampleDivider);
+        if (shouldUpdateTechnique || numSamples != _aoParametersBuffer->getNumSamples()) {
             auto& current = _aoParametersBuffer.edit()._sampleInfo;
-            current.x = config.hbaoNumSamples;
-            current.y = 1.0f / config.hbaoNumSamples;
+            current.x = numSamples;
+            current.y = 1.0f / numSamples;
             updateRandomSamples();
             updateJitterSamples();
         }
@@ -425,10 +509,11 @@ void AmbientOcclusionEffect::configure(const Config& config) {
             current.z = config.ssaoNumSpiralTurns;
         }
 
-        if (shouldUpdateTechnique || config.ssaoNumSamples != _aoParametersBuffer->getNumSamples()) {
+        const int numSamples = std::max(1, config.ssaoNumSamples / sampleDivider);
+        if (shouldUpdateTechnique || numSamples != _aoParametersBuffer->getNumSamples()) {
             auto& current = _aoParametersBuffer.edit()._sampleInfo;
-            current.x = config.ssaoNumSamples;
-            current.y = 1.0f / config.ssaoNumSamples;
+            current.x = numSamples;
+            current.y = 1.0f / numSamples;
             updateRandomSamples();
             updateJitterSamples();
         }
@@ -577,6 +662,19 @@ const gpu::PipelinePointer& AmbientOcclusionEffect::getBuildNormalsPipeline() {
     return _buildNormalsPipeline;
 }
 
+const gpu::PipelinePointer& AmbientOcclusionEffect::getTemporalPipeline() {
+    if (!_temporalPipeline) {
+        gpu::ShaderPointer program = gpu::Shader::createProgram(shader::render_utils::program::ssao_temporal);
+        gpu::StatePointer state = std::make_shared<gpu::State>();
+
+        state->setColorWriteMask(true, true, true, true);
+
+        // Good to go add the brand new pipeline
+        _temporalPipeline = gpu::Pipeline::create(program, state);
+    }
+    return _temporalPipeline;
+}
+
 int AmbientOcclusionEffect::getDepthResolutionLevel() const {
     return std::min(1, _aoParametersBuffer->getResolutionLevel());
 }
@@ -608,6 +706,7 @@ void AmbientOcclusionEffect::run(const render::RenderContextPointer& renderConte
 
     const auto& frameTransform = input.get1();
     const auto& linearDepthFramebuffer = input.get3();
+    const auto& velocityFramebuffer = input.get4();
     
     const int resolutionLevel = _aoParametersBuffer->getResolutionLevel();
     const auto depthResolutionLevel = getDepthResolutionLevel();
@@ -639,6 +738,26 @@ void AmbientOcclusionEffect::run(const render::RenderContextPointer& renderConte
     
     auto occlusionFBO = _framebuffer->getOcclusionFramebuffer();
     auto occlusionBlurredFBO = _framebuffer->getOcclusionBlurredFramebuffer();
+
+    // The occlusion of this frame is blended with the history of the previous frames, reprojected with the velocity
+    const bool isTemporalEnabled = _isTemporalEnabled && velocityFramebuffer;
+    _framebuffer->setTemporalEnabled(isTemporalEnabled);
+    gpu::FramebufferPointer occlusionHistoryFBO;
+    gpu::TexturePointer previousOcclusionHistoryTexture;
+    gpu::TexturePointer velocityTexture;
+    gpu::PipelinePointer temporalPipeline;
+    if (isTemporalEnabled) {
+        _framebuffer->swapOcclusionHistory();
+        occlusionHistoryFBO = _framebuffer->getOcclusionHistoryFramebuffer();
+        previousOcclusionHistoryTexture = _framebuffer->getPreviousOcclusionHistoryTexture();
+        velocityTexture = velocityFramebuffer->getVelocityTexture();
+        temporalPipeline = getTemporalPipeline();
+
+        float historyWeight = _framebuffer->isHistoryValid() ? _temporalBlend : 0.0f;
+        if (_temporalParametersBuffer->_temporalInfo.x != historyWeight) {
+            _temporalParametersBuffer.edit()._temporalInfo.x = historyWeight;
+        }
+    }
     
     output.edit0() = _framebuffer;
     output.edit1() = _aoParametersBuffer;
@@ -819,6 +938,22 @@ void AmbientOcclusionEffect::run(const render::RenderContextPointer& renderConte
             batch.popProfileRange();
         }
 
+        if (isTemporalEnabled) {
+            PROFILE_RANGE_BATCH(batch, "Temporal");
+            batch.setModelTransform(Transform());
+            batch.setViewportTransform(sourceViewport);
+            batch.setFramebuffer(occlusionHistoryFBO);
+            batch.setPipeline(temporalPipeline);
+            batch.setUniformBuffer(render_utils::slot::buffer::SsaoTemporalParams, _temporalParametersBuffer);
+            batch.setResourceTexture(render_utils::slot::texture::SsaoOcclusion, occlusionFBO->getRenderBuffer(0));
+            batch.setResourceTexture(render_utils::slot::texture::SsaoHistory, previousOcclusionHistoryTexture);
+            batch.setResourceTexture(render_utils::slot::texture::SsaoVelocity, velocityTexture);
+            batch.draw(gpu::TRIANGLE_STRIP, 4);
+
+            batch.setResourceTexture(render_utils::slot::texture::SsaoHistory, nullptr);
+            batch.setResourceTexture(render_utils::slot::texture::SsaoVelocity, nullptr);
+        }
+
         batch.setResourceTexture(render_utils::slot::texture::SsaoDepth, nullptr);
         batch.setResourceTexture(render_utils::slot::texture::SsaoNormal, nullptr);
         batch.setResourceTexture(render_utils::slot::texture::SsaoOcclusion, nullptr);
@@ -21,6 +21,7 @@
 #include "DeferredFrameTransform.h"
 #include "DeferredFramebuffer.h"
 #include "SurfaceGeometryPass.h"
+#include "VelocityBufferPass.h"
 
 #include "ssao_shared.h"
 
@@ -37,6 +38,17 @@ public:
     gpu::FramebufferPointer getNormalFramebuffer();
     gpu::TexturePointer getNormalTexture();
 
+    // With the temporal accumulation, the occlusion of each frame is blended into one of two history buffers, the other
+    // one holding the result of the previous frame, and getOcclusionTexture() returns the accumulated result
+    void setTemporalEnabled(bool enabled);
+    bool isTemporalEnabled() const { return _isTemporalEnabled; }
+    bool isHistoryValid() const { return _isHistoryValid; }
+    // Make the history buffer of the previous frame the one this frame is accumulated into
+    void swapOcclusionHistory();
+    gpu::FramebufferPointer getOcclusionHistoryFramebuffer();
+    gpu::TexturePointer getOcclusionHistoryTexture();
+    gpu::TexturePointer getPreviousOcclusionHistoryTexture();
+
 #if SSAO_USE_QUAD_SPLIT
     gpu::FramebufferPointer getOcclusionSplitFramebuffer(int index);
     gpu::TexturePointer getOcclusionSplitTexture();
@@ -52,6 +64,7 @@ protected:
 
     void clear();
     void allocate();
+    void allocateHistory();
     
     gpu::TexturePointer _linearDepthTexture;
     
@@ -64,6 +77,12 @@ protected:
     gpu::FramebufferPointer _normalFramebuffer;
     gpu::TexturePointer _normalTexture;
 
+    gpu::FramebufferPointer _occlusionHistoryFramebuffers[2];
+    gpu::TexturePointer _occlusionHistoryTextures[2];
+    int _historyIndex{ 0 };
+    bool _isTemporalEnabled{ false };
+    bool _isHistoryValid{ false };
+
 #if SSAO_USE_QUAD_SPLIT
     gpu::FramebufferPointer _occlusionSplitFramebuffers[SSAO_SPLIT_COUNT*SSAO_SPLIT_COUNT];
     gpu::TexturePointer _occlusionSplitTexture;
@@ -84,10 +103,12 @@ class AmbientOcclusionEffectConfig : public render::GPUJobConfig::Persistent {
     Q_PROPERTY(bool borderingEnabled MEMBER borderingEnabled NOTIFY dirty)
     Q_PROPERTY(bool fetchMipsEnabled MEMBER fetchMipsEnabled NOTIFY dirty)
     Q_PROPERTY(bool jitterEnabled MEMBER jitterEnabled NOTIFY dirty)
+    Q_PROPERTY(bool temporalEnabled MEMBER temporalEnabled NOTIFY dirty)
 
     Q_PROPERTY(int resolutionLevel MEMBER resolutionLevel WRITE setResolutionLevel)
     Q_PROPERTY(float edgeSharpness MEMBER edgeSharpness WRITE setEdgeSharpness)
     Q_PROPERTY(int blurRadius MEMBER blurRadius WRITE setBlurRadius)
+    Q_PROPERTY(float temporalBlend MEMBER temporalBlend WRITE setTemporalBlend)
 
     // SSAO
     Q_PROPERTY(float ssaoRadius MEMBER ssaoRadius WRITE setSSAORadius)
@@ -107,10 +128,13 @@ public:
 
     const int MAX_RESOLUTION_LEVEL = 4;
     const int MAX_BLUR_RADIUS = 15;
+    // with the temporal accumulation, each frame only evaluates this fraction of the samples
+    const int TEMPORAL_SAMPLE_DIVIDER = 4;
 
     void setEdgeSharpness(float sharpness);
     void setResolutionLevel(int level);
     void setBlurRadius(int radius);
+    void setTemporalBlend(float blend);
 
     void setSSAORadius(float newRadius);
     void setSSAOObscuranceLevel(float level);
@@ -127,6 +151,7 @@ public:
     float edgeSharpness;
     int blurRadius; // 0 means no blurring
     int resolutionLevel;
+    float temporalBlend; // weight of the accumulated occlusion of the previous frames
 
     float ssaoRadius;
     float ssaoObscuranceLevel; // intensify or dim down the obscurance effect
@@ -144,6 +169,7 @@ public:
     bool borderingEnabled; // avoid evaluating information from non existing pixels out of the frame, should always be true
     bool fetchMipsEnabled; // fetch taps in sub mips to otpimize cache, should always be true
     bool jitterEnabled; // Add small jittering to AO samples at each frame
+    bool temporalEnabled; // Accumulate the jittered AO over the frames, with fewer samples per frame
 
 signals:
     void dirty();
@@ -153,7 +179,7 @@ signals:
 
 class AmbientOcclusionEffect {
 public:
-    using Input = render::VaryingSet4<LightingModelPointer, DeferredFrameTransformPointer, DeferredFramebufferPointer, LinearDepthFramebufferPointer>;
+    using Input = render::VaryingSet5<LightingModelPointer, DeferredFrameTransformPointer, DeferredFramebufferPointer, LinearDepthFramebufferPointer, VelocityFramebufferPointer>;
     using Output = render::VaryingSet2<AmbientOcclusionFramebufferPointer, gpu::BufferView>;
     using Config = AmbientOcclusionEffectConfig;
     using JobModel = render::Job::ModelIO<AmbientOcclusionEffect, Input, Output, Config>;
@@ -201,6 +227,7 @@ private:
     using BlurParametersBuffer = gpu::StructBuffer<BlurParameters>;
 
     using FrameParametersBuffer = gpu::StructBuffer< AmbientOcclusionFrameParams>;
+    using TemporalParametersBuffer = gpu::StructBuffer<AmbientOcclusionTemporalParams>;
 
     void updateBlurParameters();
     void updateFramebufferSizes();
@@ -213,6 +240,7 @@ private:
     FrameParametersBuffer _aoFrameParametersBuffer[SSAO_SPLIT_COUNT*SSAO_SPLIT_COUNT];
     BlurParametersBuffer _vblurParametersBuffer;
     BlurParametersBuffer _hblurParametersBuffer;
+    TemporalParametersBuffer _temporalParametersBuffer;
     float _blurEdgeSharpness{ 0.0f };
 
     static const gpu::PipelinePointer& getOcclusionPipeline();
@@ -220,17 +248,21 @@ private:
     static const gpu::PipelinePointer& getMipCreationPipeline();
     static const gpu::PipelinePointer& getGatherPipeline();
     static const gpu::PipelinePointer& getBuildNormalsPipeline();
+    static const gpu::PipelinePointer& getTemporalPipeline();
 
     static gpu::PipelinePointer _occlusionPipeline;
     static gpu::PipelinePointer _bilateralBlurPipeline;
     static gpu::PipelinePointer _mipCreationPipeline;
     static gpu::PipelinePointer _gatherPipeline;
     static gpu::PipelinePointer _buildNormalsPipeline;
+    static gpu::PipelinePointer _temporalPipeline;
 
     AmbientOcclusionFramebufferPointer _framebuffer;
     std::array<float, SSAO_RANDOM_SAMPLE_COUNT * SSAO_SPLIT_COUNT*SSAO_SPLIT_COUNT> _randomSamples;
     int _frameId{ 0 };
     bool _isJitterEnabled{ true };
+    bool _isTemporalEnabled{ false };
+    float _temporalBlend{ 0.9f };
     
     gpu::RangeTimerPointer _gpuTimer;
 
@@ -87,6 +87,17 @@ void Antialiasing::run(const render::RenderContextPointer& renderContext, const
 
     gpu::doInBatch("Antialiasing::run", args->_context, [&](gpu::Batch& batch) {
         batch.enableStereo(false);
+
+        if (previousBuffers) {
+            // Which of the two buffers is the history is only known when the batch is executed, so both are resampled,
+            // the history is at worst a frame older
+            for (unsigned int i = 0; i < 2; i++) {
+                const auto& previousBuffer = previousBuffers->get(i);
+                batch.blit(previousBuffer, glm::ivec4(0, 0, previousBuffer->getWidth(), previousBuffer->getHeight()),
+                    _antialiasingBuffers->get(i), glm::ivec4(0, 0, width, height));
+            }
+        }
+
         batch.setViewportTransform(args->_viewport);
 
         if (!_paramsBuffer) {
@@ -234,7 +245,11 @@ void Antialiasing::run(const render::RenderContextPointer& renderContext, const
     int width = sourceBuffer->getWidth();
     int height = sourceBuffer->getHeight();
 
+    gpu::FramebufferSwapChainPointer previousBuffers;
     if (_antialiasingBuffers && _antialiasingBuffers->get(0) && _antialiasingBuffers->get(0)->getSize() != uvec2(width, height)) {
+        // The history is resampled into the buffers of the new size, so that a change of the resolution scale doesn't
+        // restart the accumulation
+        previousBuffers = _antialiasingBuffers;
         _antialiasingBuffers.reset();
         _antialiasingTextures[0].reset();
         _antialiasingTextures[1].reset();
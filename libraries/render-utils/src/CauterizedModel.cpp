@@ -94,34 +94,17 @@ void CauterizedModel::createRenderItemSet() {
     }
 }
 
-void CauterizedModel::updateClusterMatrices() {
-    PerformanceTimer perfTimer("CauterizedModel::updateClusterMatrices");
+void CauterizedModel::computeClusterMatrices() {
+    Model::computeClusterMatrices();
 
-    if (!_needsUpdateClusterMatrices || !isLoaded()) {
-        return;
-    }
-    _needsUpdateClusterMatrices = false;
     const HFMModel& hfmModel = getHFMModel();
-
-    for (int i = 0; i < (int)_meshStates.size(); i++) {
-        Model::MeshState& state = _meshStates[i];
-        const HFMMesh& mesh = hfmModel.meshes.at(i);
-        int meshIndex = i;
-
-        for (int j = 0; j < mesh.clusters.size(); j++) {
-            const HFMCluster& cluster = mesh.clusters.at(j);
-            int clusterIndex = j;
-
-            if (_useDualQuaternionSkinning) {
-                auto jointPose = _rig.getJointPose(cluster.jointIndex);
-                Transform jointTransform(jointPose.rot(), jointPose.scale(), jointPose.trans());
-                Transform clusterTransform;
-                Transform::mult(clusterTransform, jointTransform, _rig.getAnimSkeleton()->getClusterBindMatricesOriginalValues(meshIndex, clusterIndex).inverseBindTransform);
-                state.clusterDualQuaternions[j] = Model::TransformDualQuaternion(clusterTransform);
-                state.clusterDualQuaternions[j].setCauterizationParameters(0.0f, jointPose.trans());
-            } else {
-                auto jointMatrix = _rig.getJointTransform(cluster.jointIndex);
-                glm_mat4u_mul(jointMatrix, _rig.getAnimSkeleton()->getClusterBindMatricesOriginalValues(meshIndex, clusterIndex).inverseBindMatrix, state.clusterMatrices[j]);
+    if (_useDualQuaternionSkinning) {
+        // the cauterization parameters of the uncauterized clusters are the positions of their joints
+        for (int i = 0; i < (int)_meshStates.size(); i++) {
+            Model::MeshState& state = _meshStates[i];
+            const HFMMesh& mesh = hfmModel.meshes.at(i);
+            for (int j = 0; j < mesh.clusters.size(); j++) {
+                state.clusterDualQuaternions[j].setCauterizationParameters(0.0f, _rig.getJointPose(mesh.clusters.at(j).jointIndex).trans());
             }
         }
     }
@@ -170,8 +153,6 @@ void CauterizedModel::updateClusterMatrices() {
             }
         }
     }
-
-    updateBlendshapes();
 }
 
 void CauterizedModel::updateRenderItems() {
@@ -32,13 +32,14 @@ public:
     bool updateGeometry() override;
 
     void createRenderItemSet() override;
-    
-    virtual void updateClusterMatrices() override;
+
     void updateRenderItems() override;
 
     const Model::MeshState& getCauterizeMeshState(int index) const;
 
 protected:
+    void computeClusterMatrices() override;
+
     std::unordered_set<int> _cauterizeBoneSet;
     QVector<Model::MeshState> _cauterizeMeshStates;
     bool _isCauterized { false };
@@ -23,6 +23,7 @@
 
 #include <FSTReader.h>
 #include <NumericalConstants.h>
+#include <SharedUtil.h>
 #include <graphics/TextureMap.h>
 #include <graphics/BufferViewHelpers.h>
 #include <render/Args.h>
@@ -1124,73 +1125,108 @@ void GeometryCache::renderBevelCornersRect(gpu::Batch& batch, int x, int y, int
     batch.draw(gpu::TRIANGLE_STRIP, details.vertices, 0);
 }
 
-void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec2& minCorner, const glm::vec2& maxCorner, const glm::vec4& color, int id) {
-    bool registered = (id != UNKNOWN_ID);
-    Vec4Pair key(glm::vec4(minCorner.x, minCorner.y, maxCorner.x, maxCorner.y), color);
-    BatchItemDetails& details = _registeredQuad2D[id];
-
-    // if this is a registered quad, and we have buffers, then check to see if the geometry changed and rebuild if needed
-    if (registered && details.isCreated) {
-        Vec4Pair & lastKey = _lastRegisteredQuad2D[id];
-        if (lastKey != key) {
-            details.clear();
-            _lastRegisteredQuad2D[id] = key;
-#ifdef WANT_DEBUG
-            qCDebug(renderutils) << "renderQuad() 2D ... RELEASING REGISTERED";
-#endif // def WANT_DEBUG
-        }
-#ifdef WANT_DEBUG
-        else {
-            qCDebug(renderutils) << "renderQuad() 2D ... REUSING PREVIOUSLY REGISTERED";
-        }
-#endif // def WANT_DEBUG
+// The formats of the quads and lines have their vertices in the first channel, a normal per instance in the second and
+// their colors in the third
+static gpu::Stream::FormatPointer makeImmediateFormat(const gpu::Element& positionElement, bool hasTexCoords,
+                                                      gpu::Stream::Frequency colorFrequency) {
+    auto format = std::make_shared<gpu::Stream::Format>();
+    format->setAttribute(gpu::Stream::POSITION, 0, positionElement);
+    if (hasTexCoords) {
+        format->setAttribute(gpu::Stream::TEXCOORD, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::UV), positionElement.getSize());
     }
+    format->setAttribute(gpu::Stream::NORMAL, 1, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0, gpu::Stream::PER_INSTANCE);
+    format->setAttribute(gpu::Stream::COLOR, 2, gpu::Element(gpu::VEC4, gpu::NUINT8, gpu::RGBA), 0, colorFrequency);
+    return format;
+}
 
-    if (!details.isCreated) {
-        static const int FLOATS_PER_VERTEX = 2; // vertices
-        static const int VERTICES = 4; // 1 quad = 4 vertices
+// whether the key of a registered quad or line differs from the one it was last drawn with
+template <typename Key>
+static bool updateLastKey(QHash<int, Key>& lastKeys, int id, const Key& key) {
+    auto lastKey = lastKeys.find(id);
+    if (lastKey != lastKeys.end() && *lastKey == key) {
+        return false;
+    }
+    lastKeys.insert(id, key);
+    return true;
+}
 
-        details.isCreated = true;
-        details.vertices = VERTICES;
-        details.vertexSize = FLOATS_PER_VERTEX;
+bool GeometryCache::isChangingOften(BatchItemDetails& details, bool changed) {
+    // quads and lines that were edited this recently are drawn from the transient buffers until they settle
+    static const quint64 CHANGING_OFTEN_USECS = 100 * USECS_PER_MSEC;
+    quint64 now = usecTimestampNow();
+    bool isOften = now - details.lastChanged < CHANGING_OFTEN_USECS;
+    if (changed) {
+        details.lastChanged = now;
+    }
+    return isOften;
+}
 
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto normalBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
-        auto streamFormat = std::make_shared<gpu::Stream::Format>();
-        auto stream = std::make_shared<gpu::BufferStream>();
+void GeometryCache::drawImmediate(gpu::Batch& batch, BatchItemDetails* details, bool changed,
+                                  const gpu::Stream::FormatPointer& format, gpu::Primitive primitive, int numVertices,
+                                  const void* vertices, gpu::Size verticesSize, const void* colors, gpu::Size colorsSize) {
+    static const glm::vec3 NORMAL(0.0f, 0.0f, 1.0f);
+    static const gpu::BufferPointer NORMAL_BUFFER =
+        std::make_shared<gpu::Buffer>(sizeof(NORMAL), (const gpu::Byte*)glm::value_ptr(NORMAL));
+    const auto& channels = format->getChannels();
 
-        details.verticesBuffer = verticesBuffer;
-        details.normalBuffer = normalBuffer;
-        details.colorBuffer = colorBuffer;
-        details.streamFormat = streamFormat;
-        details.stream = stream;
+    if (details && changed) {
+        details->clear();
+    }
 
-        details.streamFormat->setAttribute(gpu::Stream::POSITION, gpu::Stream::POSITION, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::XYZ));
-        details.streamFormat->setAttribute(gpu::Stream::NORMAL, gpu::Stream::NORMAL, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0, gpu::Stream::PER_INSTANCE);
-        details.streamFormat->setAttribute(gpu::Stream::COLOR, gpu::Stream::COLOR, gpu::Element(gpu::VEC4, gpu::NUINT8, gpu::RGBA), 0, gpu::Stream::PER_INSTANCE);
+    if (!details || (!details->isCreated && isChangingOften(*details, changed))) {
+        auto vertexRange = _transientBuffers.allocate(verticesSize, vertices);
+        auto colorRange = _transientBuffers.allocate(colorsSize, colors);
+        gpu::BufferStream stream;
+        stream.addBuffer(vertexRange.buffer, vertexRange.offset, channels.at(0)._stride);
+        stream.addBuffer(NORMAL_BUFFER, 0, channels.at(1)._stride);
+        stream.addBuffer(colorRange.buffer, colorRange.offset, channels.at(2)._stride);
+
+        batch.setInputFormat(format);
+        batch.setInputStream(0, stream);
+        batch.draw(primitive, numVertices, 0);
+        return;
+    }
 
-        details.stream->addBuffer(details.verticesBuffer, 0, details.streamFormat->getChannels().at(gpu::Stream::POSITION)._stride);
-        details.stream->addBuffer(details.normalBuffer, 0, details.streamFormat->getChannels().at(gpu::Stream::NORMAL)._stride);
-        details.stream->addBuffer(details.colorBuffer, 0, details.streamFormat->getChannels().at(gpu::Stream::COLOR)._stride);
+    if (!details->isCreated) {
+        details->isCreated = true;
+        details->vertices = numVertices;
+        details->vertexSize = (int)(verticesSize / numVertices / sizeof(float));
 
-        float vertexBuffer[VERTICES * FLOATS_PER_VERTEX] = {
-            minCorner.x, minCorner.y,
-            maxCorner.x, minCorner.y,
-            minCorner.x, maxCorner.y,
-            maxCorner.x, maxCorner.y,
-        };
+        details->verticesBuffer = std::make_shared<gpu::Buffer>(verticesSize, (const gpu::Byte*)vertices);
+        details->normalBuffer = NORMAL_BUFFER;
+        details->colorBuffer = std::make_shared<gpu::Buffer>(colorsSize, (const gpu::Byte*)colors);
+        details->streamFormat = format;
+        details->stream = std::make_shared<gpu::BufferStream>();
 
-        details.verticesBuffer->append(sizeof(vertexBuffer), (gpu::Byte*) vertexBuffer);
-        const glm::vec3 NORMAL(0.0f, 0.0f, 1.0f);
-        details.normalBuffer->append(3 * sizeof(float), (gpu::Byte*) glm::value_ptr(NORMAL));
-        int compactColor = GeometryCache::toCompactColor(color);
-        details.colorBuffer->append(sizeof(compactColor), (gpu::Byte*) &compactColor);
+        details->stream->addBuffer(details->verticesBuffer, 0, channels.at(0)._stride);
+        details->stream->addBuffer(details->normalBuffer, 0, channels.at(1)._stride);
+        details->stream->addBuffer(details->colorBuffer, 0, channels.at(2)._stride);
     }
 
-    batch.setInputFormat(details.streamFormat);
-    batch.setInputStream(0, *details.stream);
-    batch.draw(gpu::TRIANGLE_STRIP, 4, 0);
+    batch.setInputFormat(details->streamFormat);
+    batch.setInputStream(0, *details->stream);
+    batch.draw(primitive, details->vertices, 0);
+}
+
+void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec2& minCorner, const glm::vec2& maxCorner, const glm::vec4& color, int id) {
+    static const auto FORMAT = makeImmediateFormat(gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::XYZ), false, gpu::Stream::PER_INSTANCE);
+    static const int FLOATS_PER_VERTEX = 2; // vertices
+    static const int VERTICES = 4; // 1 quad = 4 vertices
+
+    bool registered = (id != UNKNOWN_ID);
+    Vec4Pair key(glm::vec4(minCorner.x, minCorner.y, maxCorner.x, maxCorner.y), color);
+    bool changed = registered && updateLastKey(_lastRegisteredQuad2D, id, key);
+
+    float vertexBuffer[VERTICES * FLOATS_PER_VERTEX] = {
+        minCorner.x, minCorner.y,
+        maxCorner.x, minCorner.y,
+        minCorner.x, maxCorner.y,
+        maxCorner.x, maxCorner.y,
+    };
+    int compactColor = GeometryCache::toCompactColor(color);
+
+    drawImmediate(batch, registered ? &_registeredQuad2D[id] : nullptr, changed, FORMAT, gpu::TRIANGLE_STRIP, VERTICES,
+                  vertexBuffer, sizeof(vertexBuffer), &compactColor, sizeof(compactColor));
 }
 
 void GeometryCache::renderUnitQuad(gpu::Batch& batch, const glm::vec4& color, int id) {
@@ -1204,146 +1240,47 @@ void GeometryCache::renderUnitQuad(gpu::Batch& batch, const glm::vec4& color, in
 void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec2& minCorner, const glm::vec2& maxCorner,
     const glm::vec2& texCoordMinCorner, const glm::vec2& texCoordMaxCorner,
     const glm::vec4& color, int id) {
+    static const auto FORMAT = makeImmediateFormat(gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::XYZ), true, gpu::Stream::PER_INSTANCE);
+    static const int FLOATS_PER_VERTEX = 2 + 2; // vertices + tex coords
+    static const int VERTICES = 4; // 1 quad = 4 vertices
 
+    bool registered = (id != UNKNOWN_ID);
     Vec4PairVec4 key(Vec4Pair(glm::vec4(minCorner.x, minCorner.y, maxCorner.x, maxCorner.y),
         glm::vec4(texCoordMinCorner.x, texCoordMinCorner.y, texCoordMaxCorner.x, texCoordMaxCorner.y)),
         color);
-    BatchItemDetails& details = _registeredQuad2DTextures[id];
+    bool changed = registered && updateLastKey(_lastRegisteredQuad2DTexture, id, key);
 
-    // if this is a registered quad, and we have buffers, then check to see if the geometry changed and rebuild if needed
-    if (details.isCreated) {
-        Vec4PairVec4& lastKey = _lastRegisteredQuad2DTexture[id];
-        if (lastKey != key) {
-            details.clear();
-            _lastRegisteredQuad2DTexture[id] = key;
-#ifdef WANT_DEBUG
-            qCDebug(renderutils) << "renderQuad() 2D+texture ... RELEASING REGISTERED";
-#endif // def WANT_DEBUG
-        }
-#ifdef WANT_DEBUG
-        else {
-            qCDebug(renderutils) << "renderQuad() 2D+texture ... REUSING PREVIOUSLY REGISTERED";
-        }
-#endif // def WANT_DEBUG
-    }
-
-    if (!details.isCreated) {
-        static const int FLOATS_PER_VERTEX = 2 + 2; // vertices + tex coords
-        static const int VERTICES = 4; // 1 quad = 4 vertices
-        static const int NUM_POS_COORDS = 2;
-        static const int VERTEX_TEXCOORD_OFFSET = NUM_POS_COORDS * sizeof(float);
-
-        details.isCreated = true;
-        details.vertices = VERTICES;
-        details.vertexSize = FLOATS_PER_VERTEX;
-
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto normalBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
-        auto streamFormat = std::make_shared<gpu::Stream::Format>();
-        auto stream = std::make_shared<gpu::BufferStream>();
-
-        details.verticesBuffer = verticesBuffer;
-        details.normalBuffer = normalBuffer;
-        details.colorBuffer = colorBuffer;
-        details.streamFormat = streamFormat;
-        details.stream = stream;
-
-        details.streamFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::XYZ));
-        details.streamFormat->setAttribute(gpu::Stream::TEXCOORD, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::UV), VERTEX_TEXCOORD_OFFSET);
-        details.streamFormat->setAttribute(gpu::Stream::NORMAL, 1, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0, gpu::Stream::PER_INSTANCE);
-        details.streamFormat->setAttribute(gpu::Stream::COLOR, 2, gpu::Element(gpu::VEC4, gpu::NUINT8, gpu::RGBA), 0, gpu::Stream::PER_INSTANCE);
-
-        details.stream->addBuffer(details.verticesBuffer, 0, details.streamFormat->getChannels().at(0)._stride);
-        details.stream->addBuffer(details.normalBuffer, 0, details.streamFormat->getChannels().at(1)._stride);
-        details.stream->addBuffer(details.colorBuffer, 0, details.streamFormat->getChannels().at(2)._stride);
-
-        float vertexBuffer[VERTICES * FLOATS_PER_VERTEX] = {
-            minCorner.x, minCorner.y, texCoordMinCorner.x, texCoordMinCorner.y,
-            maxCorner.x, minCorner.y, texCoordMaxCorner.x, texCoordMinCorner.y,
-            minCorner.x, maxCorner.y, texCoordMinCorner.x, texCoordMaxCorner.y,
-            maxCorner.x, maxCorner.y, texCoordMaxCorner.x, texCoordMaxCorner.y,
-        };
-
-        details.verticesBuffer->append(sizeof(vertexBuffer), (gpu::Byte*) vertexBuffer);
-        const glm::vec3 NORMAL(0.0f, 0.0f, 1.0f);
-        details.normalBuffer->append(3 * sizeof(float), (gpu::Byte*) glm::value_ptr(NORMAL));
-        int compactColor = GeometryCache::toCompactColor(color);
-        details.colorBuffer->append(sizeof(compactColor), (gpu::Byte*) &compactColor);
-    }
+    float vertexBuffer[VERTICES * FLOATS_PER_VERTEX] = {
+        minCorner.x, minCorner.y, texCoordMinCorner.x, texCoordMinCorner.y,
+        maxCorner.x, minCorner.y, texCoordMaxCorner.x, texCoordMinCorner.y,
+        minCorner.x, maxCorner.y, texCoordMinCorner.x, texCoordMaxCorner.y,
+        maxCorner.x, maxCorner.y, texCoordMaxCorner.x, texCoordMaxCorner.y,
+    };
+    int compactColor = GeometryCache::toCompactColor(color);
 
-    batch.setInputFormat(details.streamFormat);
-    batch.setInputStream(0, *details.stream);
-    batch.draw(gpu::TRIANGLE_STRIP, 4, 0);
+    drawImmediate(batch, registered ? &_registeredQuad2DTextures[id] : nullptr, changed, FORMAT, gpu::TRIANGLE_STRIP, VERTICES,
+                  vertexBuffer, sizeof(vertexBuffer), &compactColor, sizeof(compactColor));
 }
 
 void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec3& minCorner, const glm::vec3& maxCorner, const glm::vec4& color, int id) {
+    static const auto FORMAT = makeImmediateFormat(gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), false, gpu::Stream::PER_INSTANCE);
+    static const int FLOATS_PER_VERTEX = 3; // vertices
+    static const int VERTICES = 4; // 1 quad = 4 vertices
+
     bool registered = (id != UNKNOWN_ID);
     Vec3PairVec4 key(Vec3Pair(minCorner, maxCorner), color);
-    BatchItemDetails& details = _registeredQuad3D[id];
-
-    // if this is a registered quad, and we have buffers, then check to see if the geometry changed and rebuild if needed
-    if (registered && details.isCreated) {
-        Vec3PairVec4& lastKey = _lastRegisteredQuad3D[id];
-        if (lastKey != key) {
-            details.clear();
-            _lastRegisteredQuad3D[id] = key;
-#ifdef WANT_DEBUG
-            qCDebug(renderutils) << "renderQuad() 3D ... RELEASING REGISTERED";
-#endif // def WANT_DEBUG
-        }
-#ifdef WANT_DEBUG
-        else {
-            qCDebug(renderutils) << "renderQuad() 3D ... REUSING PREVIOUSLY REGISTERED";
-        }
-#endif // def WANT_DEBUG
-    }
-
-    if (!details.isCreated) {
-        static const int FLOATS_PER_VERTEX = 3; // vertices
-        static const int VERTICES = 4; // 1 quad = 4 vertices
-
-        details.isCreated = true;
-        details.vertices = VERTICES;
-        details.vertexSize = FLOATS_PER_VERTEX;
-
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto normalBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
-        auto streamFormat = std::make_shared<gpu::Stream::Format>();
-        auto stream = std::make_shared<gpu::BufferStream>();
-
-        details.verticesBuffer = verticesBuffer;
-        details.normalBuffer = normalBuffer;
-        details.colorBuffer = colorBuffer;
-        details.streamFormat = streamFormat;
-        details.stream = stream;
-
-        details.streamFormat->setAttribute(gpu::Stream::POSITION, gpu::Stream::POSITION, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ));
-        details.streamFormat->setAttribute(gpu::Stream::NORMAL, gpu::Stream::NORMAL, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0, gpu::Stream::PER_INSTANCE);
-        details.streamFormat->setAttribute(gpu::Stream::COLOR, gpu::Stream::COLOR, gpu::Element(gpu::VEC4, gpu::NUINT8, gpu::RGBA), 0, gpu::Stream::PER_INSTANCE);
-
-        details.stream->addBuffer(details.verticesBuffer, 0, details.streamFormat->getChannels().at(gpu::Stream::POSITION)._stride);
-        details.stream->addBuffer(details.normalBuffer, 0, details.streamFormat->getChannels().at(gpu::Stream::NORMAL)._stride);
-        details.stream->addBuffer(details.colorBuffer, 0, details.streamFormat->getChannels().at(gpu::Stream::COLOR)._stride);
-
-        float vertexBuffer[VERTICES * FLOATS_PER_VERTEX] = {
-            minCorner.x, minCorner.y, minCorner.z,
-            maxCorner.x, minCorner.y, minCorner.z,
-            minCorner.x, maxCorner.y, maxCorner.z,
-            maxCorner.x, maxCorner.y, maxCorner.z,
-        };
+    bool changed = registered && updateLastKey(_lastRegisteredQuad3D, id, key);
 
-        details.verticesBuffer->append(sizeof(vertexBuffer), (gpu::Byte*) vertexBuffer);
-        const glm::vec3 NORMAL(0.0f, 0.0f, 1.0f);
-        details.normalBuffer->append(3 * sizeof(float), (gpu::Byte*) glm::value_ptr(NORMAL));
-        int compactColor = GeometryCache::toCompactColor(color);
-        details.colorBuffer->append(sizeof(compactColor), (gpu::Byte*) &compactColor);
-    }
+    float vertexBuffer[VERTICES * FLOATS_PER_VERTEX] = {
+        minCorner.x, minCorner.y, minCorner.z,
+        maxCorner.x, minCorner.y, minCorner.z,
+        minCorner.x, maxCorner.y, maxCorner.z,
+        maxCorner.x, maxCorner.y, maxCorner.z,
+    };
+    int compactColor = GeometryCache::toCompactColor(color);
 
-    batch.setInputFormat(details.streamFormat);
-    batch.setInputStream(0, *details.stream);
-    batch.draw(gpu::TRIANGLE_STRIP, 4, 0);
+    drawImmediate(batch, registered ? &_registeredQuad3D[id] : nullptr, changed, FORMAT, gpu::TRIANGLE_STRIP, VERTICES,
+                  vertexBuffer, sizeof(vertexBuffer), &compactColor, sizeof(compactColor));
 }
 
 void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec3& topLeft, const glm::vec3& bottomLeft,
@@ -1363,160 +1300,46 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec3& topLeft, cons
     qCDebug(renderutils) << "    color:" << color;
 #endif //def WANT_DEBUG
 
+    static const auto FORMAT = makeImmediateFormat(gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), true, gpu::Stream::PER_INSTANCE);
+    static const int FLOATS_PER_VERTEX = 3 + 2; // vertices + tex coords
+    static const int VERTICES = 4; // 1 quad = 4 vertices
+
     bool registered = (id != UNKNOWN_ID);
     Vec3PairVec4Pair key(Vec3Pair(topLeft, bottomRight),
         Vec4Pair(glm::vec4(texCoordTopLeft.x, texCoordTopLeft.y, texCoordBottomRight.x, texCoordBottomRight.y),
         color));
+    bool changed = registered && updateLastKey(_lastRegisteredQuad3DTexture, id, key);
 
-    BatchItemDetails& details = _registeredQuad3DTextures[id];
-
-    // if this is a registered quad, and we have buffers, then check to see if the geometry changed and rebuild if needed
-    if (registered && details.isCreated) {
-        Vec3PairVec4Pair& lastKey = _lastRegisteredQuad3DTexture[id];
-        if (lastKey != key) {
-            details.clear();
-            _lastRegisteredQuad3DTexture[id] = key;
-#ifdef WANT_DEBUG
-            qCDebug(renderutils) << "renderQuad() 3D+texture ... RELEASING REGISTERED";
-#endif // def WANT_DEBUG
-        }
-#ifdef WANT_DEBUG
-        else {
-            qCDebug(renderutils) << "renderQuad() 3D+texture ... REUSING PREVIOUSLY REGISTERED";
-        }
-#endif // def WANT_DEBUG
-    }
-
-    if (!details.isCreated) {
-        static const int FLOATS_PER_VERTEX = 3 + 2; // vertices + tex coords
-        static const int VERTICES = 4; // 1 quad = 4 vertices
-        static const int NUM_POS_COORDS = 3;
-        static const int VERTEX_TEXCOORD_OFFSET = NUM_POS_COORDS * sizeof(float);
-
-        details.isCreated = true;
-        details.vertices = VERTICES;
-        details.vertexSize = FLOATS_PER_VERTEX; // NOTE: this isn't used for BatchItemDetails maybe we can get rid of it
-
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto normalBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
-        auto streamFormat = std::make_shared<gpu::Stream::Format>();
-        auto stream = std::make_shared<gpu::BufferStream>();
-
-        details.normalBuffer = normalBuffer;
-        details.colorBuffer = colorBuffer;
-        details.colorBuffer = colorBuffer;
-        details.streamFormat = streamFormat;
-        details.stream = stream;
-
-        details.streamFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ));
-        details.streamFormat->setAttribute(gpu::Stream::TEXCOORD, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::UV), VERTEX_TEXCOORD_OFFSET);
-        details.streamFormat->setAttribute(gpu::Stream::NORMAL, 1, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0, gpu::Stream::PER_INSTANCE);
-        details.streamFormat->setAttribute(gpu::Stream::COLOR, 2, gpu::Element(gpu::VEC4, gpu::NUINT8, gpu::RGBA), 0, gpu::Stream::PER_INSTANCE);
-
-        details.stream->addBuffer(details.verticesBuffer, 0, details.streamFormat->getChannels().at(0)._stride);
-        details.stream->addBuffer(details.normalBuffer, 0, details.streamFormat->getChannels().at(1)._stride);
-        details.stream->addBuffer(details.colorBuffer, 0, details.streamFormat->getChannels().at(2)._stride);
-
-        float vertexBuffer[VERTICES * FLOATS_PER_VERTEX] = {
-            bottomLeft.x, bottomLeft.y, bottomLeft.z, texCoordBottomLeft.x, texCoordBottomLeft.y,
-            bottomRight.x, bottomRight.y, bottomRight.z, texCoordBottomRight.x, texCoordBottomRight.y,
-            topLeft.x, topLeft.y, topLeft.z, texCoordTopLeft.x, texCoordTopLeft.y,
-            topRight.x, topRight.y, topRight.z, texCoordTopRight.x, texCoordTopRight.y,
-        };
-
-        details.verticesBuffer->append(sizeof(vertexBuffer), (gpu::Byte*) vertexBuffer);
-        const glm::vec3 NORMAL(0.0f, 0.0f, 1.0f);
-        details.normalBuffer->append(3 * sizeof(float), (gpu::Byte*) glm::value_ptr(NORMAL));
-        int compactColor = GeometryCache::toCompactColor(color);
-        details.colorBuffer->append(sizeof(compactColor), (gpu::Byte*) &compactColor);
-    }
+    float vertexBuffer[VERTICES * FLOATS_PER_VERTEX] = {
+        bottomLeft.x, bottomLeft.y, bottomLeft.z, texCoordBottomLeft.x, texCoordBottomLeft.y,
+        bottomRight.x, bottomRight.y, bottomRight.z, texCoordBottomRight.x, texCoordBottomRight.y,
+        topLeft.x, topLeft.y, topLeft.z, texCoordTopLeft.x, texCoordTopLeft.y,
+        topRight.x, topRight.y, topRight.z, texCoordTopRight.x, texCoordTopRight.y,
+    };
+    int compactColor = GeometryCache::toCompactColor(color);
 
-    batch.setInputFormat(details.streamFormat);
-    batch.setInputStream(0, *details.stream);
-    batch.draw(gpu::TRIANGLE_STRIP, 4, 0);
+    drawImmediate(batch, registered ? &_registeredQuad3DTextures[id] : nullptr, changed, FORMAT, gpu::TRIANGLE_STRIP, VERTICES,
+                  vertexBuffer, sizeof(vertexBuffer), &compactColor, sizeof(compactColor));
 }
 
 void GeometryCache::renderLine(gpu::Batch& batch, const glm::vec3& p1, const glm::vec3& p2,
     const glm::vec4& color1, const glm::vec4& color2, int id) {
+    static const auto FORMAT = makeImmediateFormat(gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), false, gpu::Stream::PER_VERTEX);
+    static const int FLOATS_PER_VERTEX = 3;  // vertices
+    static const int VERTICES = 2;
 
     bool registered = (id != UNKNOWN_ID);
     Vec3Pair key(p1, p2);
+    bool changed = registered && updateLastKey(_lastRegisteredLine3D, id, key);
 
-    BatchItemDetails& details = _registeredLine3DVBOs[id];
-
-    // if this is a registered quad, and we have buffers, then check to see if the geometry changed and rebuild if needed
-    if (registered && details.isCreated) {
-        Vec3Pair& lastKey = _lastRegisteredLine3D[id];
-        if (lastKey != key) {
-            details.clear();
-            _lastRegisteredLine3D[id] = key;
-#ifdef WANT_DEBUG
-            qCDebug(renderutils) << "renderLine() 3D ... RELEASING REGISTERED line";
-#endif // def WANT_DEBUG
-        }
-#ifdef WANT_DEBUG
-        else {
-            qCDebug(renderutils) << "renderLine() 3D ... REUSING PREVIOUSLY REGISTERED line";
-        }
-#endif // def WANT_DEBUG
-    }
-
-    if (!details.isCreated) {
-        static const int FLOATS_PER_VERTEX = 3;  // vertices
-        static const int vertices = 2;
-
-        details.isCreated = true;
-        details.vertices = vertices;
-        details.vertexSize = FLOATS_PER_VERTEX;
-
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto normalBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
-        auto streamFormat = std::make_shared<gpu::Stream::Format>();
-        auto stream = std::make_shared<gpu::BufferStream>();
-
-        details.verticesBuffer = verticesBuffer;
-        details.normalBuffer = normalBuffer;
-        details.colorBuffer = colorBuffer;
-        details.streamFormat = streamFormat;
-        details.stream = stream;
-
-        details.streamFormat->setAttribute(gpu::Stream::POSITION, gpu::Stream::POSITION, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ));
-        details.streamFormat->setAttribute(gpu::Stream::NORMAL, gpu::Stream::NORMAL, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0, gpu::Stream::PER_INSTANCE);
-        details.streamFormat->setAttribute(gpu::Stream::COLOR, gpu::Stream::COLOR, gpu::Element(gpu::VEC4, gpu::NUINT8, gpu::RGBA));
-
-        details.stream->addBuffer(details.verticesBuffer, 0, details.streamFormat->getChannels().at(gpu::Stream::POSITION)._stride);
-        details.stream->addBuffer(details.normalBuffer, 0, details.streamFormat->getChannels().at(gpu::Stream::NORMAL)._stride);
-        details.stream->addBuffer(details.colorBuffer, 0, details.streamFormat->getChannels().at(gpu::Stream::COLOR)._stride);
-
-        float vertexBuffer[vertices * FLOATS_PER_VERTEX] = {
-            p1.x, p1.y, p1.z,
-            p2.x, p2.y, p2.z
-        };
-
-        const int NUM_COLOR_SCALARS = 2;
-        int compactColor1 = GeometryCache::toCompactColor(color1);
-        int compactColor2 = GeometryCache::toCompactColor(color2);
-        int colors[NUM_COLOR_SCALARS] = { compactColor1, compactColor2 };
-
-        details.verticesBuffer->append(sizeof(vertexBuffer), (gpu::Byte*) vertexBuffer);
-        const glm::vec3 NORMAL(0.0f, 0.0f, 1.0f);
-        details.normalBuffer->append(3 * sizeof(float), (gpu::Byte*) glm::value_ptr(NORMAL));
-        details.colorBuffer->append(sizeof(colors), (gpu::Byte*) colors);
-
-#ifdef WANT_DEBUG
-        if (id == UNKNOWN_ID) {
-            qCDebug(renderutils) << "new renderLine() 3D VBO made -- _line3DVBOs.size():" << _line3DVBOs.size();
-        } else {
-            qCDebug(renderutils) << "new registered renderLine() 3D VBO made -- _registeredLine3DVBOs.size():" << _registeredLine3DVBOs.size();
-        }
-#endif
-    }
+    float vertexBuffer[VERTICES * FLOATS_PER_VERTEX] = {
+        p1.x, p1.y, p1.z,
+        p2.x, p2.y, p2.z
+    };
+    int colors[VERTICES] = { GeometryCache::toCompactColor(color1), GeometryCache::toCompactColor(color2) };
 
-    batch.setInputFormat(details.streamFormat);
-    batch.setInputStream(0, *details.stream);
-    batch.draw(gpu::LINES, 2, 0);
+    drawImmediate(batch, registered ? &_registeredLine3DVBOs[id] : nullptr, changed, FORMAT, gpu::LINES, VERTICES,
+                  vertexBuffer, sizeof(vertexBuffer), colors, sizeof(colors));
 }
 
 void GeometryCache::renderDashedLine(gpu::Batch& batch, const glm::vec3& start, const glm::vec3& end, const glm::vec4& color,
@@ -1629,7 +1452,8 @@ streamFormat(NULL),
 stream(NULL),
 vertices(0),
 vertexSize(0),
-isCreated(false) {
+isCreated(false),
+lastChanged(0) {
     population++;
 #ifdef WANT_DEBUG
     qCDebug(renderutils) << "BatchItemDetails()... population:" << population << "**********************************";
@@ -1644,7 +1468,8 @@ streamFormat(other.streamFormat),
 stream(other.stream),
 vertices(other.vertices),
 vertexSize(other.vertexSize),
-isCreated(other.isCreated) {
+isCreated(other.isCreated),
+lastChanged(other.lastChanged) {
     population++;
 #ifdef WANT_DEBUG
     qCDebug(renderutils) << "BatchItemDetails()... population:" << population << "**********************************";
@@ -31,6 +31,8 @@
 #include <graphics/Material.h>
 #include <graphics/Asset.h>
 
+#include "TransientBufferRing.h"
+
 class SimpleProgramKey;
 
 typedef QPair<glm::vec2, float> Vec2FloatPair;
@@ -342,6 +344,7 @@ private:
         int vertices;
         int vertexSize;
         bool isCreated;
+        quint64 lastChanged;
         
         BatchItemDetails();
         BatchItemDetails(const GeometryCache::BatchItemDetails& other);
@@ -349,6 +352,15 @@ private:
         void clear();
     };
 
+    static bool isChangingOften(BatchItemDetails& details, bool changed);
+    // Draws a quad or line from the buffers of its own, which are rebuilt when it changes, or from the transient buffers
+    // if it isn't registered or keeps changing
+    void drawImmediate(gpu::Batch& batch, BatchItemDetails* details, bool changed, const gpu::Stream::FormatPointer& format,
+                       gpu::Primitive primitive, int numVertices, const void* vertices, gpu::Size verticesSize,
+                       const void* colors, gpu::Size colorsSize);
+
+    TransientBufferRing _transientBuffers;
+
     QHash<IntPair, VerticesIndices> _coneVBOs;
 
     int _nextID{ 1 };
@@ -13,6 +13,9 @@
 #include <gpu/Context.h>
 #include <shaders/Shaders.h>
 #include <graphics/ShaderConstants.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <TBBHelpers.h>
 
 #include "RenderUtilsLogging.h"
 #include "render-utils/ShaderConstants.h"
@@ -254,66 +257,61 @@ uint32_t scanLightVolumeBox(FrustumGrid& grid, const FrustumGrid::Planes planes[
     return numClustersTouched;
 }
 
-uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zMin, int zMax, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, const glm::vec4& eyePosRadius,
+// Adds the light to the clusters of a z slice that its sphere touches
+uint32_t scanLightVolumeSphereSlice(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int z, const LightClusters::LightVolume& volume,
     std::vector< std::vector<LightClusters::LightIndex>>& clusterGrid) {
-    glm::ivec3 gridPosToOffset(1, grid.dims.x, grid.dims.x * grid.dims.y);
     uint32_t numClustersTouched = 0;
     const auto& xPlanes = planes[0];
     const auto& yPlanes = planes[1];
     const auto& zPlanes = planes[2];
 
-    // FInd the light origin cluster
-    auto centerCluster = grid.frustumGrid_eyeToClusterPos(glm::vec3(eyePosRadius));
-
-    int center_z = centerCluster.z;
-    int center_y = centerCluster.y;
+    int center_z = volume.centerCluster.z;
+    int center_y = volume.centerCluster.y;
 
-    for (auto z = zMin; (z <= zMax); z++) {
-        auto zSphere = eyePosRadius;
-        if (z != center_z) {
-            auto plane = (z < center_z) ? zPlanes[z + 1] : -zPlanes[z];
-            if (!reduceSphereToPlane(zSphere, plane, zSphere)) {
+    auto zSphere = volume.eyePosRadius;
+    if (z != center_z) {
+        auto plane = (z < center_z) ? zPlanes[z + 1] : -zPlanes[z];
+        if (!reduceSphereToPlane(zSphere, plane, zSphere)) {
+            // pass this slice!
+            return 0;
+        }
+    }
+    for (auto y = volume.yMin; (y <= volume.yMax); y++) {
+        auto ySphere = zSphere;
+        if (y != center_y) {
+            auto plane = (y < center_y) ? yPlanes[y + 1] : -yPlanes[y];
+            if (!reduceSphereToPlane(ySphere, plane, ySphere)) {
                 // pass this slice!
                 continue;
             }
         }
-        for (auto y = yMin; (y <= yMax); y++) {
-            auto ySphere = zSphere;
-            if (y != center_y) {
-                auto plane = (y < center_y) ? yPlanes[y + 1] : -yPlanes[y];
-                if (!reduceSphereToPlane(ySphere, plane, ySphere)) {
-                    // pass this slice!
-                    continue;
-                }
-            }
 
-            glm::vec3 spherePoint(ySphere);
+        glm::vec3 spherePoint(ySphere);
 
-            auto x = xMin;
-            for (; (x < xMax); ++x) {
-                const auto& plane = xPlanes[x + 1];
-                auto testDistance = distanceToPlane(spherePoint, plane) + ySphere.w;
-                if (testDistance >= 0.0f) {
-                    break;
-                }
+        auto x = volume.xMin;
+        for (; (x < volume.xMax); ++x) {
+            const auto& plane = xPlanes[x + 1];
+            auto testDistance = distanceToPlane(spherePoint, plane) + ySphere.w;
+            if (testDistance >= 0.0f) {
+                break;
             }
-            auto xs = xMax;
-            for (; (xs >= x); --xs) {
-                auto plane = -xPlanes[xs];
-                auto testDistance = distanceToPlane(spherePoint, plane) + ySphere.w;
-                if (testDistance >= 0.0f) {
-                    break;
-                }
+        }
+        auto xs = volume.xMax;
+        for (; (xs >= x); --xs) {
+            auto plane = -xPlanes[xs];
+            auto testDistance = distanceToPlane(spherePoint, plane) + ySphere.w;
+            if (testDistance >= 0.0f) {
+                break;
             }
+        }
 
-            for (; (x <= xs); x++) {
-                auto index = grid.frustumGrid_clusterToIndex(ivec3(x, y, z));
-                if (index < (int)clusterGrid.size()) {
-                    clusterGrid[index].emplace_back(lightId);
-                    numClustersTouched++;
-                } else {
-                    qCDebug(renderutils) << "WARNING: LightClusters::scanLightVolumeSphere invalid index found ? numClusters = " << clusterGrid.size() << " index = " << index << " found from cluster xyz = " << x << " " << y << " " << z;
-                }
+        for (; (x <= xs); x++) {
+            auto index = grid.frustumGrid_clusterToIndex(ivec3(x, y, z));
+            if (index < (int)clusterGrid.size()) {
+                clusterGrid[index].emplace_back(volume.lightId);
+                numClustersTouched++;
+            } else {
+                qCDebug(renderutils) << "WARNING: LightClusters::scanLightVolumeSphereSlice invalid index found ? numClusters = " << clusterGrid.size() << " index = " << index << " found from cluster xyz = " << x << " " << y << " " << z;
             }
         }
     }
@@ -321,168 +319,216 @@ uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes plan
     return numClustersTouched;
 }
 
-glm::ivec3 LightClusters::updateClusters() {
-    // Make sure resource are in good shape
-    updateClusterResource();
 
-    // Clean up last info
-    uint32_t numClusters = (uint32_t)_clusterGrid.size();
+bool LightClusters::evalLightVolume(FrustumGrid& grid, LightID lightId, LightVolume& volume) const {
+    auto light = _lightStage->getLight(lightId);
+    if (!light) {
+        return false;
+    }
 
-    std::vector< std::vector< LightIndex > > clusterGridPoint(numClusters);
-    std::vector< std::vector< LightIndex > > clusterGridSpot(numClusters);
+    auto worldOri = light->getPosition();
+    auto radius = light->getMaximumRadius();
+    bool isSpot = light->isSpot();
 
-    _clusterGrid.clear();
-    _clusterGrid.resize(numClusters, EMPTY_CLUSTER);
+    // Bring into frustum eye space
+    auto eyeOri = grid.frustumGrid_worldToEye(glm::vec4(worldOri, 1.0f));
 
-    uint32_t maxNumIndices = (uint32_t)_clusterContent.size();
-    _clusterContent.clear();
-    _clusterContent.resize(maxNumIndices, INVALID_LIGHT);
+    // Remove light that slipped through and is not in the z range
+    float eyeZMax = eyeOri.z - radius;
+    if (eyeZMax > -grid.rangeNear) {
+        return false;
+    }
+    float eyeZMin = eyeOri.z + radius;
+    bool beyondFar = false;
+    if (eyeZMin < -grid.rangeFar) {
+        beyondFar = true;
+    }
 
+    // Get z slices
+    int zMin = grid.frustumGrid_eyeDepthToClusterLayer(eyeZMin);
+    int zMax = grid.frustumGrid_eyeDepthToClusterLayer(eyeZMax);
+    // That should never happen
+    if (zMin == -2 && zMax == -2) {
+        return false;
+    }
 
-    auto theFrustumGrid(_frustumGridBuffer.get());
+    // Before Range NEar just apss, range neatr == true near for now
+    if ((zMin == -1) && (zMax == -1)) {
+        return false;
+    }
 
-    glm::ivec3 gridPosToOffset(1, theFrustumGrid.dims.x, theFrustumGrid.dims.x * theFrustumGrid.dims.y);
+    // CLamp the z range 
+    zMin = std::max(0, zMin);
 
-    uint32_t numClusterTouched = 0;
-    uint32_t numLightsIn = _visibleLightIndices[0];
-    uint32_t numClusteredLights = 0;
-    for (size_t lightNum = 1; lightNum < _visibleLightIndices.size(); ++lightNum) {
-        auto lightId = _visibleLightIndices[lightNum];
-        auto light = _lightStage->getLight(lightId);
-        if (!light) {
-            continue;
-        }
+    auto xLeftDistance = radius - distanceToPlane(eyeOri, _gridPlanes[0][0]);
+    auto xRightDistance = radius + distanceToPlane(eyeOri, _gridPlanes[0].back());
 
-        auto worldOri = light->getPosition();
-        auto radius = light->getMaximumRadius();
-        bool isSpot = light->isSpot();
+    auto yBottomDistance = radius - distanceToPlane(eyeOri, _gridPlanes[1][0]);
+    auto yTopDistance = radius + distanceToPlane(eyeOri, _gridPlanes[1].back());
 
-        // Bring into frustum eye space
-        auto eyeOri = theFrustumGrid.frustumGrid_worldToEye(glm::vec4(worldOri, 1.0f));
+    if ((xLeftDistance < 0.f) || (xRightDistance < 0.f) || (yBottomDistance < 0.f) || (yTopDistance < 0.f)) {
+        return false;
+    }
 
-        // Remove light that slipped through and is not in the z range
-        float eyeZMax = eyeOri.z - radius;
-        if (eyeZMax > -theFrustumGrid.rangeNear) {
-            continue;
-        }
-        float eyeZMin = eyeOri.z + radius;
-        bool beyondFar = false;
-        if (eyeZMin < -theFrustumGrid.rangeFar) {
-            beyondFar = true;
-        }
+    // find 2D corners of the sphere in grid
+    int xMin { 0 };
+    int xMax { grid.dims.x - 1 };
+    int yMin { 0 };
+    int yMax { grid.dims.y - 1 };
 
-        // Get z slices
-        int zMin = theFrustumGrid.frustumGrid_eyeDepthToClusterLayer(eyeZMin);
-        int zMax = theFrustumGrid.frustumGrid_eyeDepthToClusterLayer(eyeZMax);
-        // That should never happen
-        if (zMin == -2 && zMax == -2) {
-            continue;
-        }
+    float radius2 = radius * radius;
 
-        // Before Range NEar just apss, range neatr == true near for now
-        if ((zMin == -1) && (zMax == -1)) {
-            continue;
-        }
+    auto eyeOriH = glm::vec3(eyeOri);
+    auto eyeOriV = glm::vec3(eyeOri);
 
-        // CLamp the z range 
-        zMin = std::max(0, zMin);
+    eyeOriH.y = 0.0f;
+    eyeOriV.x = 0.0f;
 
-        auto xLeftDistance = radius - distanceToPlane(eyeOri, _gridPlanes[0][0]);
-        auto xRightDistance = radius + distanceToPlane(eyeOri, _gridPlanes[0].back());
+    float eyeOriLen2H = glm::length2(eyeOriH);
+    float eyeOriLen2V = glm::length2(eyeOriV);
 
-        auto yBottomDistance = radius - distanceToPlane(eyeOri, _gridPlanes[1][0]);
-        auto yTopDistance = radius + distanceToPlane(eyeOri, _gridPlanes[1].back());
+    if ((eyeOriLen2H > radius2)) {
+        float eyeOriLenH = sqrt(eyeOriLen2H);
 
-        if ((xLeftDistance < 0.f) || (xRightDistance < 0.f) || (yBottomDistance < 0.f) || (yTopDistance < 0.f)) {
-            continue;
-        }
+        auto eyeOriDirH = glm::vec3(eyeOriH) / eyeOriLenH;
 
-        // find 2D corners of the sphere in grid
-        int xMin { 0 };
-        int xMax { theFrustumGrid.dims.x - 1 };
-        int yMin { 0 };
-        int yMax { theFrustumGrid.dims.y - 1 };
+        float eyeToTangentCircleLenH = sqrt(eyeOriLen2H - radius2);
 
-        float radius2 = radius * radius;
+        float eyeToTangentCircleCosH = eyeToTangentCircleLenH / eyeOriLenH;
 
-        auto eyeOriH = glm::vec3(eyeOri);
-        auto eyeOriV = glm::vec3(eyeOri);
+        float eyeToTangentCircleSinH = radius / eyeOriLenH;
 
-        eyeOriH.y = 0.0f;
-        eyeOriV.x = 0.0f;
 
-        float eyeOriLen2H = glm::length2(eyeOriH);
-        float eyeOriLen2V = glm::length2(eyeOriV);
+        // rotate the eyeToOriDir (H & V) in both directions
+        glm::vec3 leftDir(eyeOriDirH.x * eyeToTangentCircleCosH + eyeOriDirH.z * eyeToTangentCircleSinH, 0.0f, eyeOriDirH.x * -eyeToTangentCircleSinH + eyeOriDirH.z * eyeToTangentCircleCosH);
+        glm::vec3 rightDir(eyeOriDirH.x * eyeToTangentCircleCosH - eyeOriDirH.z * eyeToTangentCircleSinH, 0.0f, eyeOriDirH.x * eyeToTangentCircleSinH + eyeOriDirH.z * eyeToTangentCircleCosH);
 
-        if ((eyeOriLen2H > radius2)) {
-            float eyeOriLenH = sqrt(eyeOriLen2H);
+        auto lc = grid.frustumGrid_eyeToClusterDirH(leftDir);
+        if (lc > xMax) {
+            lc = xMin;
+        }
+        auto rc = grid.frustumGrid_eyeToClusterDirH(rightDir);
+        if (rc < 0) {
+            rc = xMax;
+        }
+        xMin = std::max(xMin, lc);
+        xMax = std::min(rc, xMax);
+        assert(xMin <= xMax);
+    }
 
-            auto eyeOriDirH = glm::vec3(eyeOriH) / eyeOriLenH;
+    if ((eyeOriLen2V > radius2)) {
+        float eyeOriLenV = sqrt(eyeOriLen2V);
 
-            float eyeToTangentCircleLenH = sqrt(eyeOriLen2H - radius2);
+        auto eyeOriDirV = glm::vec3(eyeOriV) / eyeOriLenV;
 
-            float eyeToTangentCircleCosH = eyeToTangentCircleLenH / eyeOriLenH;
+        float eyeToTangentCircleLenV = sqrt(eyeOriLen2V - radius2);
 
-            float eyeToTangentCircleSinH = radius / eyeOriLenH;
+        float eyeToTangentCircleCosV = eyeToTangentCircleLenV / eyeOriLenV;
 
+        float eyeToTangentCircleSinV = radius / eyeOriLenV;
 
-            // rotate the eyeToOriDir (H & V) in both directions
-            glm::vec3 leftDir(eyeOriDirH.x * eyeToTangentCircleCosH + eyeOriDirH.z * eyeToTangentCircleSinH, 0.0f, eyeOriDirH.x * -eyeToTangentCircleSinH + eyeOriDirH.z * eyeToTangentCircleCosH);
-            glm::vec3 rightDir(eyeOriDirH.x * eyeToTangentCircleCosH - eyeOriDirH.z * eyeToTangentCircleSinH, 0.0f, eyeOriDirH.x * eyeToTangentCircleSinH + eyeOriDirH.z * eyeToTangentCircleCosH);
 
-            auto lc = theFrustumGrid.frustumGrid_eyeToClusterDirH(leftDir);
-            if (lc > xMax) {
-                lc = xMin;
-            }
-            auto rc = theFrustumGrid.frustumGrid_eyeToClusterDirH(rightDir);
-            if (rc < 0) {
-                rc = xMax;
-            }
-            xMin = std::max(xMin, lc);
-            xMax = std::min(rc, xMax);
-            assert(xMin <= xMax);
+        // rotate the eyeToOriDir (H & V) in both directions
+        glm::vec3 bottomDir(0.0f, eyeOriDirV.y * eyeToTangentCircleCosV + eyeOriDirV.z * eyeToTangentCircleSinV, eyeOriDirV.y * -eyeToTangentCircleSinV + eyeOriDirV.z * eyeToTangentCircleCosV);
+        glm::vec3 topDir(0.0f, eyeOriDirV.y * eyeToTangentCircleCosV - eyeOriDirV.z * eyeToTangentCircleSinV, eyeOriDirV.y * eyeToTangentCircleSinV + eyeOriDirV.z * eyeToTangentCircleCosV);
+
+        auto bc = grid.frustumGrid_eyeToClusterDirV(bottomDir);
+        auto tc = grid.frustumGrid_eyeToClusterDirV(topDir);
+        if (bc > yMax) {
+            bc = yMin;
         }
+        if (tc < 0) {
+            tc = yMax;
+        }
+        yMin = std::max(yMin, bc);
+        yMax =std::min(tc, yMax);
+        assert(yMin <= yMax);
+    }
 
-        if ((eyeOriLen2V > radius2)) {
-            float eyeOriLenV = sqrt(eyeOriLen2V);
+    volume = { lightId, glm::vec4(glm::vec3(eyeOri), radius), grid.frustumGrid_eyeToClusterPos(glm::vec3(eyeOri)),
+        zMin, zMax, yMin, yMax, xMin, xMax, isSpot, beyondFar };
+    return true;
+}
 
-            auto eyeOriDirV = glm::vec3(eyeOriV) / eyeOriLenV;
 
-            float eyeToTangentCircleLenV = sqrt(eyeOriLen2V - radius2);
+glm::ivec3 LightClusters::updateClusters() {
+    // Make sure resource are in good shape
+    updateClusterResource();
 
-            float eyeToTangentCircleCosV = eyeToTangentCircleLenV / eyeOriLenV;
+    // Clean up last info
+    uint32_t numClusters = (uint32_t)_clusterGrid.size();
 
-            float eyeToTangentCircleSinV = radius / eyeOriLenV;
+    // The lists of the clusters are kept from frame to frame so that their memory is reused
+    auto& clusterGridPoint = _clusterGridPoint;
+    auto& clusterGridSpot = _clusterGridSpot;
+    clusterGridPoint.resize(numClusters);
+    clusterGridSpot.resize(numClusters);
+    for (uint32_t i = 0; i < numClusters; i++) {
+        clusterGridPoint[i].clear();
+        clusterGridSpot[i].clear();
+    }
 
+    _clusterGrid.clear();
+    _clusterGrid.resize(numClusters, EMPTY_CLUSTER);
 
-            // rotate the eyeToOriDir (H & V) in both directions
-            glm::vec3 bottomDir(0.0f, eyeOriDirV.y * eyeToTangentCircleCosV + eyeOriDirV.z * eyeToTangentCircleSinV, eyeOriDirV.y * -eyeToTangentCircleSinV + eyeOriDirV.z * eyeToTangentCircleCosV);
-            glm::vec3 topDir(0.0f, eyeOriDirV.y * eyeToTangentCircleCosV - eyeOriDirV.z * eyeToTangentCircleSinV, eyeOriDirV.y * eyeToTangentCircleSinV + eyeOriDirV.z * eyeToTangentCircleCosV);
+    uint32_t maxNumIndices = (uint32_t)_clusterContent.size();
+    _clusterContent.clear();
+    _clusterContent.resize(maxNumIndices, INVALID_LIGHT);
 
-            auto bc = theFrustumGrid.frustumGrid_eyeToClusterDirV(bottomDir);
-            auto tc = theFrustumGrid.frustumGrid_eyeToClusterDirV(topDir);
-            if (bc > yMax) {
-                bc = yMin;
-            }
-            if (tc < 0) {
-                tc = yMax;
-            }
-            yMin = std::max(yMin, bc);
-            yMax =std::min(tc, yMax);
-            assert(yMin <= yMax);
+
+    auto theFrustumGrid(_frustumGridBuffer.get());
+
+    uint32_t numLightsIn = _visibleLightIndices[0];
+
+    // Find the clusters that the bounds of each light cover, in parallel over the lights
+    const size_t LIGHT_GRAIN_SIZE = 64;
+    size_t numLights = _visibleLightIndices.size() - 1;
+    _lightVolumes.resize(numLights);
+    std::vector<uint8_t> isLightClustered(numLights, 0);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numLights, LIGHT_GRAIN_SIZE), [&](const tbb::blocked_range<size_t>& range) {
+        auto grid = theFrustumGrid;
+        for (size_t i = range.begin(); i < range.end(); ++i) {
+            isLightClustered[i] = evalLightVolume(grid, _visibleLightIndices[i + 1], _lightVolumes[i]) ? 1 : 0;
         }
+    });
 
-        // now voxelize
-        auto& clusterGrid = (isSpot ? clusterGridSpot : clusterGridPoint);
-        if (beyondFar) {
-            numClusterTouched += scanLightVolumeBoxSlice(theFrustumGrid, _gridPlanes, zMin, yMin, yMax, xMin, xMax, lightId, glm::vec4(glm::vec3(eyeOri), radius), clusterGrid);
-        } else {
-            numClusterTouched += scanLightVolumeSphere(theFrustumGrid, _gridPlanes, zMin, zMax, yMin, yMax, xMin, xMax, lightId, glm::vec4(glm::vec3(eyeOri), radius), clusterGrid);
+    size_t numVolumes = 0;
+    for (size_t i = 0; i < numLights; ++i) {
+        if (isLightClustered[i]) {
+            _lightVolumes[numVolumes++] = _lightVolumes[i];
+        }
+    }
+    _lightVolumes.resize(numVolumes);
+    uint32_t numClusteredLights = (uint32_t)numVolumes;
+
+    // Then voxelize them, in parallel over the z slices as each slice has clusters of its own.  The lights are added to
+    // the clusters in the same order as when the voxelization was sequential.
+    int numSlices = theFrustumGrid.dims.z;
+    std::vector<uint32_t> numSliceClustersTouched(numSlices, 0);
+    tbb::parallel_for(0, numSlices, [&](int z) {
+        auto grid = theFrustumGrid;
+        uint32_t numClustersTouched = 0;
+        for (const auto& volume : _lightVolumes) {
+            if (z < volume.zMin || z > (volume.beyondFar ? volume.zMin : volume.zMax)) {
+                continue;
+            }
+            auto& clusterGrid = (volume.isSpot ? clusterGridSpot : clusterGridPoint);
+            if (volume.beyondFar) {
+                numClustersTouched += scanLightVolumeBoxSlice(grid, _gridPlanes, z, volume.yMin, volume.yMax, volume.xMin, volume.xMax,
+                    volume.lightId, volume.eyePosRadius, clusterGrid);
+            } else {
+                numClustersTouched += scanLightVolumeSphereSlice(grid, _gridPlanes, z, volume, clusterGrid);
+            }
         }
+        numSliceClustersTouched[z] = numClustersTouched;
+    });
 
-        numClusteredLights++;
+    uint32_t numClusterTouched = 0;
+    for (auto numClustersTouched : numSliceClustersTouched) {
+        numClusterTouched += numClustersTouched;
     }
 
+
     // Lights have been gathered now reexpress in terms of 2 sequential buffers
     // Start filling from near to far and stops if it overflows
     bool checkBudget = false;
@@ -494,8 +540,10 @@ glm::ivec3 LightClusters::updateClusters() {
         auto& clusterPoint = clusterGridPoint[i];
         auto& clusterSpot = clusterGridSpot[i];
 
-        uint8_t numLightsPoint = ((uint8_t)clusterPoint.size());
-        uint8_t numLightsSpot = ((uint8_t)clusterSpot.size());
+        // The counts are encoded on 8 bits, the lights past the first 255 of a kind in a cluster are left out
+        const size_t MAX_NUM_LIGHTS_OF_A_KIND = 0xFF;
+        uint8_t numLightsPoint = ((uint8_t)std::min(clusterPoint.size(), MAX_NUM_LIGHTS_OF_A_KIND));
+        uint8_t numLightsSpot = ((uint8_t)std::min(clusterSpot.size(), MAX_NUM_LIGHTS_OF_A_KIND));
         uint16_t numLights = numLightsPoint + numLightsSpot;
         uint16_t offset = indexOffset;
 
@@ -560,9 +608,11 @@ void LightClusteringPass::run(const render::RenderContextPointer& renderContext,
     auto lightStage = renderContext->_scene->getStage<LightStage>();
     assert(lightStage);
     _lightClusters->updateLightStage(lightStage);
+
+    quint64 startTime = usecTimestampNow();
     _lightClusters->updateLightFrame(lightFrame, lightingModel->isPointLightEnabled(), lightingModel->isSpotLightEnabled());
-    
     auto clusteringStats = _lightClusters->updateClusters();
+    quint64 clusteringTime = usecTimestampNow() - startTime;
 
     output = _lightClusters;
 
@@ -573,6 +623,7 @@ void LightClusteringPass::run(const render::RenderContextPointer& renderContext,
     config->setNumInputLights(clusteringStats.x);
     config->setNumClusteredLights(clusteringStats.y);
     config->setNumClusteredLightReferences(clusteringStats.z);
+    config->setClusteringTime((double)clusteringTime / USECS_PER_MSEC);
 }
 
 DebugLightClusters::DebugLightClusters() {
@@ -83,6 +83,23 @@ public:
 
     glm::ivec3  updateClusters();
 
+    // The clusters that the bounds of a light cover, found before the light is voxelized
+    struct LightVolume {
+        LightID lightId;
+        glm::vec4 eyePosRadius;
+        glm::ivec3 centerCluster;
+        int zMin;
+        int zMax;
+        int yMin;
+        int yMax;
+        int xMin;
+        int xMax;
+        bool isSpot;
+        bool beyondFar;
+    };
+    // Returns false if the light is outside of the grid
+    bool evalLightVolume(FrustumGrid& grid, LightID lightId, LightVolume& volume) const;
+
 
     ViewFrustum _frustum;
 
@@ -105,6 +122,9 @@ public:
 
     std::vector<uint32_t> _clusterGrid;
     std::vector<LightIndex> _clusterContent;
+    std::vector<LightVolume> _lightVolumes;
+    std::vector<std::vector<LightIndex>> _clusterGridPoint;
+    std::vector<std::vector<LightIndex>> _clusterGridSpot;
     gpu::BufferView _clusterGridBuffer;
     gpu::BufferView _clusterContentBuffer;
     uint32_t _clusterContentBudget { 0 };
@@ -131,6 +151,7 @@ class LightClusteringPassConfig : public render::Job::Config {
     Q_PROPERTY(int numClusteredLightReferences MEMBER numClusteredLightReferences NOTIFY dirty)
     Q_PROPERTY(int numInputLights MEMBER numInputLights NOTIFY dirty)
     Q_PROPERTY(int numClusteredLights MEMBER numClusteredLights NOTIFY dirty)
+    Q_PROPERTY(double clusteringTime MEMBER clusteringTime NOTIFY dirty)
 
     Q_PROPERTY(int numSceneLights MEMBER numSceneLights NOTIFY dirty)
     Q_PROPERTY(int numFreeSceneLights MEMBER numFreeSceneLights NOTIFY dirty)
@@ -156,6 +177,10 @@ public:
     void setNumInputLights(int numLights) { numInputLights = numLights; }
     void setNumClusteredLights(int numLights) { numClusteredLights = numLights; }
 
+    // The CPU time of the clustering, in msecs
+    double clusteringTime { 0.0 };
+    void setClusteringTime(double time) { clusteringTime = time; }
+
     int numSceneLights { 0 };
     int numFreeSceneLights { 0 };
     int numAllocatedSceneLights { 0 };
@@ -22,10 +22,17 @@
 #include "DeferredLightingEffect.h"
 
 #include "RenderPipelines.h"
+#include "SkinningPrepass.h"
 
 using namespace render;
 
 bool ModelMeshPartPayload::enableMaterialProceduralShaders = false;
+bool ModelMeshPartPayload::enableInstancing = true;
+bool ModelMeshPartPayload::enableMeshLODs = true;
+bool ModelMeshPartPayload::enableSkinningPrepass = false;
+
+// a simplified part is drawn once the surface it simplifies is off by less than this many pixels
+static const float MAX_LOD_ERROR_PIXELS = 1.0f;
 
 ModelMeshPartPayload::ModelMeshPartPayload(ModelPointer model, int meshIndex, int partIndex, int shapeIndex,
                                            const Transform& transform, const uint64_t& created) :
@@ -84,11 +91,22 @@ void ModelMeshPartPayload::initCache(const ModelPointer& model, int shapeID) {
 }
 
 void ModelMeshPartPayload::updateMeshPart(const std::shared_ptr<const graphics::Mesh>& drawMesh, int partIndex) {
+    if (drawMesh != _drawMesh) {
+        // the skinned vertex stream is made from the stream of the mesh
+        setSkinnedVertexBuffer(nullptr);
+    }
     _drawMesh = drawMesh;
     if (_drawMesh) {
         auto vertexFormat = _drawMesh->getVertexFormat();
         _drawPart = _drawMesh->getPartBuffer().get<graphics::Mesh::Part>(partIndex);
         _localBound = _drawMesh->evalPartBound(partIndex);
+
+        _lodParts.clear();
+        for (const auto& lod : _drawMesh->getLODs()) {
+            if (partIndex < (int)lod._parts.size() && lod._parts[partIndex]._numIndices > 0) {
+                _lodParts.emplace_back(lod._error, lod._parts[partIndex]);
+            }
+        }
     }
 }
 
@@ -180,13 +198,36 @@ void ModelMeshPartPayload::updateTransformForSkinnedMesh(const Transform& modelT
     _parentTransform = modelTransform;
 }
 
-void ModelMeshPartPayload::bindMesh(gpu::Batch& batch) {
+void ModelMeshPartPayload::setSkinnedVertexBuffer(const gpu::BufferPointer& skinnedVertexBuffer) {
+    if (skinnedVertexBuffer == _skinnedVertexBuffer) {
+        return;
+    }
+    if (!skinnedVertexBuffer || !_drawMesh ||
+        skinnedVertexBuffer->getSize() != (size_t)_meshNumVertices * sizeof(SkinningPrepass::Vertex)) {
+        _skinnedVertexBuffer.reset();
+        _skinnedVertexFormat.reset();
+        _skinnedVertexStream.clear();
+        return;
+    }
+
+    // the skinned vertices are read from one more channel than the mesh has
+    _skinnedVertexBuffer = skinnedVertexBuffer;
+    _skinnedVertexStream = _drawMesh->getVertexStream();
+    auto skinnedChannel = (gpu::Stream::Slot)_skinnedVertexStream.getNumBuffers();
+    _skinnedVertexStream.addBuffer(_skinnedVertexBuffer, 0, sizeof(SkinningPrepass::Vertex));
+    _skinnedVertexFormat = SkinningPrepass::makeVertexFormat(*_drawMesh->getVertexFormat(), skinnedChannel);
+}
+
+void ModelMeshPartPayload::bindMesh(gpu::Batch& batch, bool preskinned) {
     batch.setIndexBuffer(gpu::UINT32, (_drawMesh->getIndexBuffer()._buffer), 0);
-    batch.setInputFormat((_drawMesh->getVertexFormat()));
+    batch.setInputFormat(preskinned ? _skinnedVertexFormat : _drawMesh->getVertexFormat());
     if (_meshBlendshapeBuffer) {
         batch.setResourceBuffer(0, _meshBlendshapeBuffer);
     }
-    batch.setInputStream(0, _drawMesh->getVertexStream());
+    if (_blendshapeCoefficientsBuffer) {
+        batch.setResourceBuffer(1, _blendshapeCoefficientsBuffer);
+    }
+    batch.setInputStream(0, preskinned ? _skinnedVertexStream : _drawMesh->getVertexStream());
 }
 
 void ModelMeshPartPayload::bindTransform(gpu::Batch& batch, const Transform& transform, RenderArgs::RenderMode renderMode) const {
@@ -196,8 +237,40 @@ void ModelMeshPartPayload::bindTransform(gpu::Batch& batch, const Transform& tra
     batch.setModelTransform(transform);
 }
 
-void ModelMeshPartPayload::drawCall(gpu::Batch& batch) const {
-    batch.drawIndexed(gpu::TRIANGLES, _drawPart._numIndices, _drawPart._startIndex);
+void ModelMeshPartPayload::drawCall(gpu::Batch& batch, const graphics::Mesh::Part& drawPart) const {
+    batch.drawIndexed(gpu::TRIANGLES, drawPart._numIndices, drawPart._startIndex);
+}
+
+const graphics::Mesh::Part& ModelMeshPartPayload::selectDrawPart(RenderArgs* args, const Transform& modelTransform,
+                                                                  const AABox& worldBound) const {
+    if (!enableMeshLODs || _lodParts.empty() || !args->hasViewFrustum()) {
+        return _drawPart;
+    }
+
+    // the pixels a mesh unit covers, at the nearest point of the bound for a perspective projection
+    const auto& viewFrustum = args->getViewFrustum();
+    const auto& projection = viewFrustum.getProjection();
+    float pixelsPerUnit = 0.5f * projection[1][1] * (float)args->_viewport.w;
+    bool isPerspective = projection[3][3] == 0.0f;
+    if (isPerspective) {
+        float distance = glm::distance(viewFrustum.getPosition(), worldBound.calcCenter()) - 0.5f * glm::length(worldBound.getDimensions());
+        if (distance <= viewFrustum.getNearClip()) {
+            return _drawPart;
+        }
+        pixelsPerUnit /= distance;
+    }
+    glm::vec3 scale = glm::abs(modelTransform.getScale());
+    pixelsPerUnit *= glm::max(scale.x, glm::max(scale.y, scale.z));
+
+    // the least detailed version that is still close enough to the full part
+    const graphics::Mesh::Part* drawPart = &_drawPart;
+    for (const auto& lodPart : _lodParts) {
+        if (lodPart.first * pixelsPerUnit > MAX_LOD_ERROR_PIXELS) {
+            break;
+        }
+        drawPart = &lodPart.second;
+    }
+    return *drawPart;
 }
 
 void ModelMeshPartPayload::updateKey(const render::ItemKey& key) {
@@ -319,6 +392,56 @@ ShapeKey ModelMeshPartPayload::getShapeKey() const {
     return _shapeKey;
 }
 
+size_t ModelMeshPartPayload::getMaterialSortKey() const {
+    // parts with the same material layers bind the same textures and schema values, translucent parts keep their order
+    return _shapeKey.isTranslucent() ? 0 : _drawMaterials.getLayersHash();
+}
+
+bool ModelMeshPartPayload::isInstanceable() const {
+    // deformed parts draw per model vertices, and translucent parts have to keep their depth order
+    return !_isSkinned && !_isBlendShaped && !_shapeKey.hasOwnPipeline() && !_shapeKey.isTranslucent() &&
+        !_shapeKey.isFaded() && !_drawMaterials.isMToon();
+}
+
+void ModelMeshPartPayload::renderInstance(RenderArgs* args, gpu::Batch& batch, const Transform& modelTransform,
+                                          const graphics::Mesh::Part& drawPart) {
+    // parts of models with the same URL share their mesh, so the mesh part, the material layers and the pipeline
+    // identify the parts that draw the same but for their transform
+    size_t hash = std::hash<const graphics::Mesh*>()(_drawMesh.get());
+    hash = hash * 31 + drawPart._startIndex;
+    hash = hash * 31 + drawPart._numIndices;
+    hash = hash * 31 + _drawMaterials.getLayersHash();
+    hash = hash * 31 + std::hash<render::ShapePipelinePointer>()(args->_shapePipeline);
+    std::string instanceName = "model_parts_" + std::to_string(hash);
+
+    if (batch._namedData.find(instanceName) != batch._namedData.end()) {
+        args->_details._drawcallsSavedByInstancing++;
+    }
+
+    // the named calls are drawn when the batch is finished, within the frame, while the first part of each
+    // group is still in the scene
+    batch.setModelTransform(modelTransform);
+    auto pipeline = args->_shapePipeline;
+    auto numIndices = drawPart._numIndices;
+    auto startIndex = drawPart._startIndex;
+    batch.setupNamedCalls(instanceName, [this, args, pipeline, numIndices, startIndex](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+        batch.setPipeline(pipeline->pipeline);
+        pipeline->prepare(batch, args);
+
+        bindMesh(batch);
+        if (RenderPipelines::bindMaterials(_drawMaterials, batch, args->_renderMode, args->_enableTexturing)) {
+            args->_details._materialSwitches++;
+        }
+        const uint32_t compactColor = 0xFFFFFFFF;
+        _drawMesh->getColorBuffer()->setData(sizeof(compactColor), (const gpu::Byte*) &compactColor);
+
+        batch.drawIndexedInstanced((gpu::uint32)data.count(), gpu::TRIANGLES, numIndices, startIndex);
+    });
+
+    const int INDICES_PER_TRIANGLE = 3;
+    args->_details._trianglesRendered += drawPart._numIndices / INDICES_PER_TRIANGLE;
+}
+
 void ModelMeshPartPayload::render(RenderArgs* args) {
     PerformanceTimer perfTimer("ModelMeshPartPayload::render");
 
@@ -333,13 +456,28 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
         args->_renderMode == RenderArgs::RenderMode::SHADOW_RENDER_MODE ? BillboardModeHelpers::getPrimaryViewFrustumPosition() : args->getViewFrustum().getPosition()));
 
     Transform modelTransform = transform.worldTransform(_localTransform);
+
+    AABox worldBound = _adjustedLocalBound;
+    worldBound.transform(transform);
+    RenderPipelines::reportTextureScreenSize(_drawMaterials, args, worldBound);
+    const auto& drawPart = selectDrawPart(args, modelTransform, worldBound);
+
+    if (enableInstancing && args->_shapePipeline && isInstanceable()) {
+        renderInstance(args, batch, modelTransform, drawPart);
+        return;
+    }
     bindTransform(batch, modelTransform, args->_renderMode);
 
+    // the vertices skinned once for all the passes aren't skinned again in the vertex shader
+    bool preskinned = _skinnedVertexBuffer && args->_enableSkinning;
+
     //Bind the index buffer and vertex buffer and Blend shapes if needed
-    bindMesh(batch);
+    bindMesh(batch, preskinned);
 
     // IF deformed pass the mesh key
-    auto drawcallInfo = (uint16_t) (((_isBlendShaped && _meshBlendshapeBuffer && args->_enableBlendshape) << 0) | ((_isSkinned && args->_enableSkinning) << 1));
+    bool isBlendshaped = _isBlendShaped && _meshBlendshapeBuffer && args->_enableBlendshape;
+    auto drawcallInfo = (uint16_t) ((isBlendshaped << 0) | ((_isSkinned && args->_enableSkinning && !preskinned) << 1) |
+                                    ((isBlendshaped && _blendshapeCoefficientsBuffer) << 2));
     if (drawcallInfo) {
         batch.setDrawcallUniform(drawcallInfo);
     }
@@ -370,11 +508,11 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
     // Draw!
     {
         PerformanceTimer perfTimer("batch.drawIndexed()");
-        drawCall(batch);
+        drawCall(batch, drawPart);
     }
 
     const int INDICES_PER_TRIANGLE = 3;
-    args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
+    args->_details._trianglesRendered += drawPart._numIndices / INDICES_PER_TRIANGLE;
 }
 
 bool ModelMeshPartPayload::passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const {
@@ -401,15 +539,29 @@ void ModelMeshPartPayload::setBlendshapeBuffer(const std::unordered_map<int, gpu
         auto blendshapeBuffer = blendshapeBuffers.find(_meshIndex);
         if (blendshapeBuffer != blendshapeBuffers.end()) {
             _meshBlendshapeBuffer = blendshapeBuffer->second;
-            if (_isSkinned || (_isBlendShaped && _meshBlendshapeBuffer)) {
-                ShapeKey::Builder builder(_shapeKey);
-                builder.withDeformed();
-                if (_prevUseDualQuaternionSkinning) {
-                    builder.withDualQuatSkinned();
-                }
-                _shapeKey = builder.build();
-            }
+            _blendshapeCoefficientsBuffer.reset();
+            updateDeformedShapeKey();
+        }
+    }
+}
+
+void ModelMeshPartPayload::setGPUBlendshapeBuffers(const gpu::BufferPointer& meshBlendshapeBuffer, const gpu::BufferPointer& coefficientsBuffer) {
+    if (!_isBlendShaped || !meshBlendshapeBuffer || !coefficientsBuffer) {
+        return;
+    }
+    _meshBlendshapeBuffer = meshBlendshapeBuffer;
+    _blendshapeCoefficientsBuffer = coefficientsBuffer;
+    updateDeformedShapeKey();
+}
+
+void ModelMeshPartPayload::updateDeformedShapeKey() {
+    if (_isSkinned || (_isBlendShaped && _meshBlendshapeBuffer)) {
+        ShapeKey::Builder builder(_shapeKey);
+        builder.withDeformed();
+        if (_prevUseDualQuaternionSkinning) {
+            builder.withDualQuatSkinned();
         }
+        _shapeKey = builder.build();
     }
 }
 
@@ -452,4 +604,11 @@ template <> HighlightStyle payloadGetOutlineStyle(const ModelMeshPartPayload::Po
     }
     return HighlightStyle();
 }
+
+template <> size_t payloadGetMaterialSortKey(const ModelMeshPartPayload::Pointer& payload) {
+    if (payload) {
+        return payload->getMaterialSortKey();
+    }
+    return 0;
+}
 }
@@ -37,10 +37,13 @@ public:
 
     void updateTransformForSkinnedMesh(const Transform& modelTransform, const Model::MeshState& meshState, bool useDualQuaternionSkinning);
 
+    // Draw the vertices skinned by the model if not null, instead of skinning them in the vertex shader
+    void setSkinnedVertexBuffer(const gpu::BufferPointer& skinnedVertexBuffer);
+
     // ModelMeshPartPayload functions to perform render
-    void bindMesh(gpu::Batch& batch);
+    void bindMesh(gpu::Batch& batch, bool preskinned = false);
     virtual void bindTransform(gpu::Batch& batch, const Transform& transform, RenderArgs::RenderMode renderMode) const;
-    void drawCall(gpu::Batch& batch) const;
+    void drawCall(gpu::Batch& batch, const graphics::Mesh::Part& drawPart) const;
 
     void updateKey(const render::ItemKey& key);
     void setShapeKey(bool invalidateShapeKey, PrimitiveMode primitiveMode, bool useDualQuaternionSkinning);
@@ -62,20 +65,32 @@ public:
     void setBillboardMode(BillboardMode billboardMode) { _billboardMode = billboardMode; }
     bool passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const;
     render::HighlightStyle getOutlineStyle(const ViewFrustum& viewFrustum, const size_t height) const;
+    size_t getMaterialSortKey() const;
 
     void addMaterial(graphics::MaterialLayer material) { _drawMaterials.push(material); }
     void removeMaterial(graphics::MaterialPointer material) { _drawMaterials.remove(material); }
 
     void setBlendshapeBuffer(const std::unordered_map<int, gpu::BufferPointer>& blendshapeBuffers, const QVector<int>& blendedMeshSizes);
+    // Blend the blendshapes in the vertex shader, from the deltas of the mesh and the coefficients of the model
+    void setGPUBlendshapeBuffers(const gpu::BufferPointer& meshBlendshapeBuffer, const gpu::BufferPointer& coefficientsBuffer);
 
     static bool enableMaterialProceduralShaders;
+    static bool enableInstancing;
+    static bool enableMeshLODs;
+    static bool enableSkinningPrepass;
 
 private:
     void initCache(const ModelPointer& model, int shapeID);
+    bool isInstanceable() const;
+    void updateDeformedShapeKey();
+    void renderInstance(RenderArgs* args, gpu::Batch& batch, const Transform& modelTransform, const graphics::Mesh::Part& drawPart);
+    const graphics::Mesh::Part& selectDrawPart(RenderArgs* args, const Transform& modelTransform, const AABox& worldBound) const;
 
     int _meshIndex;
     std::shared_ptr<const graphics::Mesh> _drawMesh;
     graphics::Mesh::Part _drawPart;
+    // the simplified versions of the part, from the most detailed to the least, and their error in mesh units
+    std::vector<std::pair<float, graphics::Mesh::Part>> _lodParts;
     graphics::MultiMaterial _drawMaterials;
 
     gpu::BufferPointer _clusterBuffer;
@@ -83,8 +98,14 @@ private:
     ClusterBufferType _clusterBufferType { ClusterBufferType::Matrices };
 
     gpu::BufferPointer _meshBlendshapeBuffer;
+    // Set when the blendshapes are blended in the vertex shader, _meshBlendshapeBuffer then holds the deltas
+    gpu::BufferPointer _blendshapeCoefficientsBuffer;
     int _meshNumVertices;
 
+    gpu::BufferPointer _skinnedVertexBuffer;
+    gpu::Stream::FormatPointer _skinnedVertexFormat;
+    gpu::BufferStream _skinnedVertexStream;
+
     render::ItemKey _itemKey { render::ItemKey::Builder::opaqueShape().build() };
     render::ShapeKey _shapeKey { render::ShapeKey::Builder::invalid() };
 
@@ -111,6 +132,7 @@ namespace render {
     template <> void payloadRender(const ModelMeshPartPayload::Pointer& payload, RenderArgs* args);
     template <> bool payloadPassesZoneOcclusionTest(const ModelMeshPartPayload::Pointer& payload, const std::unordered_set<QUuid>& containingZones);
     template <> HighlightStyle payloadGetOutlineStyle(const ModelMeshPartPayload::Pointer& payload, const ViewFrustum& viewFrustum, const size_t height);
+    template <> size_t payloadGetMaterialSortKey(const ModelMeshPartPayload::Pointer& payload);
 }
 
 #endif // hifi_MeshPartPayload_h
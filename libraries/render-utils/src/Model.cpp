@@ -35,6 +35,7 @@
 
 #include "AbstractViewStateInterface.h"
 #include "MeshPartPayload.h"
+#include "SkinningPrepass.h"
 
 #include "RenderUtilsLogging.h"
 #include <Trace.h>
@@ -75,6 +76,7 @@ Model::Model(QObject* parent, SpatiallyNestable* spatiallyNestableOverride, uint
     setSnapModelToRegistrationPoint(true, glm::vec3(0.5f));
 
     connect(&_renderWatcher, &GeometryResourceWatcher::finished, this, &Model::loadURLFinished);
+    connect(&_renderWatcher, &GeometryResourceWatcher::previewLoaded, this, &Model::loadPreviewFinished);
 }
 
 Model::~Model() {
@@ -223,6 +225,7 @@ void Model::updateRenderItems() {
         // lazy update of cluster matrices used for rendering.
         // We need to update them here so we can correctly update the bounding box.
         self->updateClusterMatrices();
+        self->updateSkinnedVertexBuffers();
 
         Transform modelTransform = self->getTransform();
         modelTransform.setScale(glm::vec3(1.0f));
@@ -243,10 +246,14 @@ void Model::updateRenderItems() {
 
             bool invalidatePayloadShapeKey = self->shouldInvalidatePayloadShapeKey(meshIndex);
             bool useDualQuaternionSkinning = self->getUseDualQuaternionSkinning();
+            gpu::BufferPointer skinnedVertexBuffer;
+            if (meshIndex < (int)self->_skinnedVertexBuffers.size()) {
+                skinnedVertexBuffer = self->_skinnedVertexBuffers[meshIndex];
+            }
 
             transaction.updateItem<ModelMeshPartPayload>(itemID, [modelTransform, meshState, useDualQuaternionSkinning,
                                                                   invalidatePayloadShapeKey, primitiveMode, billboardMode, renderItemKeyGlobalFlags,
-                                                                  cauterized, renderWithZones](ModelMeshPartPayload& data) {
+                                                                  cauterized, renderWithZones, skinnedVertexBuffer](ModelMeshPartPayload& data) {
                 if (useDualQuaternionSkinning) {
                     data.updateClusterBuffer(meshState.clusterDualQuaternions);
                     data.computeAdjustedLocalBound(meshState.clusterDualQuaternions);
@@ -256,6 +263,7 @@ void Model::updateRenderItems() {
                 }
 
                 data.updateTransformForSkinnedMesh(modelTransform, meshState, useDualQuaternionSkinning);
+                data.setSkinnedVertexBuffer(skinnedVertexBuffer);
 
                 data.setCauterized(cauterized);
                 data.setRenderWithZones(renderWithZones);
@@ -1261,7 +1269,7 @@ int Model::getParentJointIndex(int jointIndex) const {
 }
 
 void Model::setTextures(const QVariantMap& textures) {
-    if (isLoaded()) {
+    if (isLoaded() && !_isShowingPreview) {
         _needsFixupInScene = true;
         _renderGeometry->setTextures(textures);
         _pendingTextures.clear();
@@ -1270,6 +1278,20 @@ void Model::setTextures(const QVariantMap& textures) {
     }
 }
 
+void Model::setLoadingPriority(float priority) {
+    // small changes aren't worth reordering the pending downloads for
+    const float MIN_LOADING_PRIORITY_CHANGE = 0.01f;
+    if (fabsf(priority - _loadingPriority) < MIN_LOADING_PRIORITY_CHANGE) {
+        return;
+    }
+    _loadingPriority = priority;
+
+    auto resource = _renderWatcher.getResource();
+    if (resource && !resource->isLoaded() && !resource->isFailed()) {
+        resource->setLoadPriority(this, _loadingPriority);
+    }
+}
+
 void Model::setURL(const QUrl& url) {
     // don't recreate the geometry if it's the same URL
     if (_url == url && _renderWatcher.getURL() == url) {
@@ -1293,6 +1315,7 @@ void Model::setURL(const QUrl& url) {
     // One might be tempted to _pendingTextures.clear(), thinking that a new URL means an old texture doesn't apply.
     // But sometimes, particularly when first setting the values, the texture might be set first. So let's not clear here.
     _visualGeometryRequestFailed = false;
+    _isShowingPreview = false;
     _needsFixupInScene = true;
     invalidCalculatedMeshBoxes();
     deleteGeometry();
@@ -1307,6 +1330,17 @@ void Model::setURL(const QUrl& url) {
 }
 
 void Model::loadURLFinished(bool success) {
+    if (_isShowingPreview) {
+        _isShowingPreview = false;
+        if (success) {
+            // the preview has the meshes and joints of the model, only its render items need replacing
+            _skinnedVertexBuffers.clear();
+            _needsFixupInScene = true;
+            invalidCalculatedMeshBoxes();
+            emit requestRenderUpdate();
+        }
+    }
+
     if (!success) {
         _visualGeometryRequestFailed = true;
     } else if (!_pendingTextures.empty()) {
@@ -1315,6 +1349,12 @@ void Model::loadURLFinished(bool success) {
     emit setURLFinished(success);
 }
 
+void Model::loadPreviewFinished() {
+    // the textures are set once the model replaces its preview, which has none
+    _isShowingPreview = true;
+    emit setURLFinished(true);
+}
+
 bool Model::getJointPositionInWorldFrame(int jointIndex, glm::vec3& position) const {
     return _rig.getJointPositionInWorldFrame(jointIndex, position, _translation, _rotation);
 }
@@ -1492,34 +1532,65 @@ void Model::updateRig(float deltaTime, glm::mat4 parentTransform) {
 void Model::updateClusterMatrices() {
     DETAILED_PERFORMANCE_TIMER("Model::updateClusterMatrices");
 
-    if (!_needsUpdateClusterMatrices || !isLoaded()) {
+    if (!isLoaded()) {
         return;
     }
+    if (_needsUpdateClusterMatrices) {
+        _needsUpdateClusterMatrices = false;
+        computeClusterMatrices();
+    } else if (!_clusterMatricesComputedAhead) {
+        return;
+    }
+    _clusterMatricesComputedAhead = false;
+
+    updateBlendshapes();
+}
+
+void Model::updateClusterMatrices(const std::vector<ModelPointer>& models) {
+    PerformanceTimer perfTimer("Model::updateClusterMatrices(models)");
+    PROFILE_RANGE(simulation_animation, __FUNCTION__);
+
+    // the blendshapes are left to updateClusterMatrices, on this thread
+    tbb::parallel_for((size_t)0, models.size(), [&](size_t i) {
+        const auto& model = models[i];
+        if (model && model->_needsUpdateClusterMatrices && model->isLoaded()) {
+            model->_needsUpdateClusterMatrices = false;
+            model->computeClusterMatrices();
+            model->_clusterMatricesComputedAhead = true;
+        }
+    });
+}
 
-    _needsUpdateClusterMatrices = false;
+// virtual
+void Model::computeClusterMatrices() {
     const HFMModel& hfmModel = getHFMModel();
+    const AnimSkeleton::ConstPointer skeleton = _rig.getAnimSkeleton();
+    const AnimPoseVec& jointPoses = _rig.getAbsoluteJointPoses();
+    const size_t numJoints = skeleton ? std::min(jointPoses.size(), (size_t)skeleton->getNumJoints()) : 0;
+    if (!_useDualQuaternionSkinning) {
+        _jointMatrices.resize(numJoints);
+        AnimSkeleton::computePoseMatrices(numJoints, jointPoses.data(), _jointMatrices.data());
+    }
+
     for (int i = 0; i < (int) _meshStates.size(); i++) {
         MeshState& state = _meshStates[i];
-        int meshIndex = i;
         const HFMMesh& mesh = hfmModel.meshes.at(i);
-        for (int j = 0; j < mesh.clusters.size(); j++) {
-            const HFMCluster& cluster = mesh.clusters.at(j);
-            int clusterIndex = j;
-
-            if (_useDualQuaternionSkinning) {
-                auto jointPose = _rig.getJointPose(cluster.jointIndex);
-                Transform jointTransform(jointPose.rot(), jointPose.scale(), jointPose.trans());
-                Transform clusterTransform;
-                Transform::mult(clusterTransform, jointTransform, _rig.getAnimSkeleton()->getClusterBindMatricesOriginalValues(meshIndex, clusterIndex).inverseBindTransform);
-                state.clusterDualQuaternions[j] = Model::TransformDualQuaternion(clusterTransform);
-            } else {
-                auto jointMatrix = _rig.getJointTransform(cluster.jointIndex);
-                glm_mat4u_mul(jointMatrix, _rig.getAnimSkeleton()->getClusterBindMatricesOriginalValues(meshIndex, clusterIndex).inverseBindMatrix, state.clusterMatrices[j]);
+        const int numClusters = mesh.clusters.size();
+        if (numClusters == 0 || !skeleton) {
+            continue;
+        }
+
+        if (_useDualQuaternionSkinning) {
+            _clusterPoses.resize(numClusters);
+            skeleton->computeClusterPoses(i, numJoints, jointPoses.data(), _clusterPoses.data());
+            for (int j = 0; j < numClusters; j++) {
+                const AnimPose& pose = _clusterPoses[j];
+                state.clusterDualQuaternions[j] = Model::TransformDualQuaternion(pose.scale(), pose.rot(), pose.trans());
             }
+        } else {
+            skeleton->computeClusterMatrices(i, numJoints, _jointMatrices.data(), state.clusterMatrices.data());
         }
     }
-
-    updateBlendshapes();
 }
 
 void Model::updateBlendshapes() {
@@ -1527,14 +1598,90 @@ void Model::updateBlendshapes() {
     auto modelBlender = DependencyManager::get<ModelBlender>();
     if (modelBlender->shouldComputeBlendshapes() && getHFMModel().hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
         _blendedBlendshapeCoefficients = _blendshapeCoefficients;
-        modelBlender->noteRequiresBlend(getThisPointer());
+        if (modelBlender->shouldBlendOnGPU()) {
+            updateGPUBlendshapes();
+        } else {
+            modelBlender->noteRequiresBlend(getThisPointer());
+        }
+    }
+}
+
+void Model::updateSkinnedVertexBuffers() {
+    if (!ModelMeshPartPayload::enableSkinningPrepass || !isLoaded()) {
+        _skinnedVertexBuffers.clear();
+        return;
+    }
+
+    PerformanceTimer perfTimer("Model::updateSkinnedVertexBuffers");
+    PROFILE_RANGE(render, __FUNCTION__);
+
+    const HFMModel& hfmModel = getHFMModel();
+    _skinnedVertexBuffers.resize(_meshStates.size());
+    std::vector<SkinningPrepass::Vertex> vertices;
+    for (int i = 0; i < (int)_meshStates.size(); i++) {
+        const HFMMesh& mesh = hfmModel.meshes.at(i);
+        auto& buffer = _skinnedVertexBuffers[i];
+        if (!SkinningPrepass::canSkin(mesh)) {
+            buffer.reset();
+            continue;
+        }
+
+        const MeshState& state = _meshStates[i];
+        if (_useDualQuaternionSkinning) {
+            SkinningPrepass::skinMesh(mesh, state.clusterDualQuaternions, vertices);
+        } else {
+            SkinningPrepass::skinMesh(mesh, state.clusterMatrices, vertices);
+        }
+
+        const auto size = vertices.size() * sizeof(SkinningPrepass::Vertex);
+        if (!buffer || buffer->getSize() != size) {
+            buffer = std::make_shared<gpu::Buffer>(size, (const gpu::Byte*)vertices.data(), size);
+        } else {
+            buffer->setSubData(0, size, (const gpu::Byte*)vertices.data());
+        }
+    }
+}
+
+void Model::updateGPUBlendshapes() {
+    if (!isLoaded()) {
+        return;
+    }
+    if (!_gpuBlendshapes) {
+        _gpuBlendshapes = GPUBlendshapes::get(getGeometry()->getConstHFMModelPointer());
+        _blendshapeCoefficientsBuffer = std::make_shared<gpu::Buffer>();
+        _gpuBlendedItemIDs.clear();
+    }
+
+    auto coefficients = GPUBlendshapes::layoutCoefficients(_blendshapeCoefficients, _gpuBlendshapes->getMaxBlendshapes());
+    _blendshapeCoefficientsBuffer->setData(coefficients.size() * sizeof(float), (const gpu::Byte*)coefficients.data());
+
+    // the render items keep the buffers, they only need them once
+    if (_gpuBlendedItemIDs == _modelMeshRenderItemIDs) {
+        return;
     }
+    _gpuBlendedItemIDs = _modelMeshRenderItemIDs;
+    render::Transaction transaction;
+    for (int i = 0; i < (int)_modelMeshRenderItemIDs.size(); i++) {
+        auto meshBuffer = _gpuBlendshapes->getMeshBuffer(_modelMeshRenderItemShapes[i].meshIndex);
+        if (!meshBuffer) {
+            continue;
+        }
+        auto coefficientsBuffer = _blendshapeCoefficientsBuffer;
+        transaction.updateItem<ModelMeshPartPayload>(_modelMeshRenderItemIDs[i], [meshBuffer, coefficientsBuffer](ModelMeshPartPayload& data) {
+            data.setGPUBlendshapeBuffers(meshBuffer, coefficientsBuffer);
+        });
+    }
+    AbstractViewStateInterface::instance()->getMain3DScene()->enqueueTransaction(transaction);
 }
 
 void Model::deleteGeometry() {
     _meshStates.clear();
     _rig.destroyAnimGraph();
     _blendedBlendshapeCoefficients.clear();
+    _gpuBlendshapes.reset();
+    _blendshapeCoefficientsBuffer.reset();
+    _gpuBlendedItemIDs.clear();
+    _skinnedVertexBuffers.clear();
     _renderGeometry.reset();
 }
 
@@ -1870,12 +2017,64 @@ Blender::Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendN
     _blendshapeCoefficients(blendshapeCoefficients) {
 }
 
-void Blender::run() {
-    DETAILED_PROFILE_RANGE_EX(simulation_animation, __FUNCTION__, 0xFFFF0000, 0, { { "url", _model->getURL().toString() } });
+// the normal and tangent offsets are scaled down so that they only bend the normals a little
+static const float BLENDSHAPE_NORMAL_COEFFICIENT_SCALE = 0.01f;
+static const float BLENDSHAPE_COEFFICIENT_EPSILON = 0.0001f;
+
+static void accumulateBlendshape_ref(BlendshapeOffsetUnpacked* unpacked, const HFMBlendshape& blendshape,
+                                     float vertexCoefficient, float normalCoefficient) {
+    for (int j = 0; j < blendshape.indices.size(); ++j) {
+        auto& currentBlendshapeOffset = unpacked[blendshape.indices.at(j)];
+        currentBlendshapeOffset.positionOffset += blendshape.vertices.at(j) * vertexCoefficient;
+        if (j < blendshape.normals.size()) {
+            currentBlendshapeOffset.normalOffset += blendshape.normals.at(j) * normalCoefficient;
+        }
+        if (j < blendshape.tangents.size()) {
+            currentBlendshapeOffset.tangentOffset += blendshape.tangents.at(j) * normalCoefficient;
+        }
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+// accumulates the 9 floats of each offset as two vec4s and a scalar
+static void accumulateBlendshape(BlendshapeOffsetUnpacked* unpacked, const HFMBlendshape& blendshape,
+                                 float vertexCoefficient, float normalCoefficient) {
+    static_assert(sizeof(BlendshapeOffsetUnpacked) == 9 * sizeof(float), "struct BlendshapeOffsetUnpacked size doesn't match.");
+    const int* indices = blendshape.indices.constData();
+    const glm::vec3* vertices = blendshape.vertices.constData();
+    const glm::vec3* normals = blendshape.normals.constData();
+    const glm::vec3* tangents = blendshape.tangents.empty() ? nullptr : blendshape.tangents.constData();
+    const glm::vec3 ZERO(0.0f);
+
+    const __m128 coefficient0 = _mm_setr_ps(vertexCoefficient, vertexCoefficient, vertexCoefficient, normalCoefficient);
+    const __m128 coefficient1 = _mm_set1_ps(normalCoefficient);
+    for (int j = 0, n = blendshape.indices.size(); j < n; ++j) {
+        const glm::vec3& vertex = vertices[j];
+        const glm::vec3& normal = normals[j];
+        const glm::vec3& tangent = tangents ? tangents[j] : ZERO;
+        float* offset = (float*)&unpacked[indices[j]];
+
+        __m128 delta0 = _mm_setr_ps(vertex.x, vertex.y, vertex.z, normal.x);
+        __m128 delta1 = _mm_setr_ps(normal.y, normal.z, tangent.x, tangent.y);
+        _mm_storeu_ps(offset + 0, _mm_add_ps(_mm_loadu_ps(offset + 0), _mm_mul_ps(delta0, coefficient0)));
+        _mm_storeu_ps(offset + 4, _mm_add_ps(_mm_loadu_ps(offset + 4), _mm_mul_ps(delta1, coefficient1)));
+        offset[8] += tangent.z * normalCoefficient;
+    }
+}
+
+#else   // portable reference code
+static auto& accumulateBlendshape = accumulateBlendshape_ref;
+#endif
+
+void ModelBlender::blendMeshes(const HFMModel& hfmModel, const QVector<float>& blendshapeCoefficients,
+                               QVector<BlendshapeOffset>& blendshapeOffsets, QVector<int>& blendedMeshSizes) {
     int numBlendshapeOffsets = 0;  // number of offsets required for all meshes.
     int maxBlendshapeOffsets = 0;  // number of offsets in the largest mesh.
     int numMeshes = 0;  // number of meshes in this model.
-    for (auto meshIter = _hfmModel->meshes.cbegin(); meshIter != _hfmModel->meshes.cend(); ++meshIter) {
+    for (auto meshIter = hfmModel.meshes.cbegin(); meshIter != hfmModel.meshes.cend(); ++meshIter) {
         numMeshes++;
         if (meshIter->blendshapes.isEmpty()) {
             continue;
@@ -1886,17 +2085,18 @@ void Blender::run() {
     }
 
     // allocate the required sizes
-    QVector<int> blendedMeshSizes;
-    blendedMeshSizes.reserve(numMeshes);
+    blendedMeshSizes.reserve(blendedMeshSizes.size() + numMeshes);
 
-    QVector<BlendshapeOffset> packedBlendshapeOffsets;
-    packedBlendshapeOffsets.resize(numBlendshapeOffsets);
+    int offset = blendshapeOffsets.size();
+    blendshapeOffsets.resize(offset + numBlendshapeOffsets);
 
-    QVector<BlendshapeOffsetUnpacked> unpackedBlendshapeOffsets;
-    unpackedBlendshapeOffsets.resize(maxBlendshapeOffsets);    // reuse for all meshes
+    // reused for all meshes, and by every blend run on this thread
+    static thread_local std::vector<BlendshapeOffsetUnpacked> unpackedBlendshapeOffsets;
+    if (unpackedBlendshapeOffsets.size() < (size_t)maxBlendshapeOffsets) {
+        unpackedBlendshapeOffsets.resize(maxBlendshapeOffsets);
+    }
 
-    int offset = 0;
-    for (auto meshIter = _hfmModel->meshes.cbegin(); meshIter != _hfmModel->meshes.cend(); ++meshIter) {
+    for (auto meshIter = hfmModel.meshes.cbegin(); meshIter != hfmModel.meshes.cend(); ++meshIter) {
         if (meshIter->blendshapes.isEmpty()) {
             blendedMeshSizes.push_back(0);
             continue;
@@ -1908,36 +2108,38 @@ void Blender::run() {
         memset(unpackedBlendshapeOffsets.data(), 0, numVertsInMesh * sizeof(BlendshapeOffsetUnpacked));
 
         // for each blendshape in this mesh, accumulate the offsets into unpackedBlendshapeOffsets.
-        const float NORMAL_COEFFICIENT_SCALE = 0.01f;
-        for (int i = 0, n = qMin(_blendshapeCoefficients.size(), meshIter->blendshapes.size()); i < n; i++) {
-            float vertexCoefficient = _blendshapeCoefficients.at(i);
-            const float EPSILON = 0.0001f;
-            if (vertexCoefficient < EPSILON) {
+        for (int i = 0, n = qMin(blendshapeCoefficients.size(), meshIter->blendshapes.size()); i < n; i++) {
+            float vertexCoefficient = blendshapeCoefficients.at(i);
+            if (vertexCoefficient < BLENDSHAPE_COEFFICIENT_EPSILON) {
                 continue;
             }
 
-            float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
+            // the baker sorted the offsets of each blendshape by vertex and padded their normals and tangents
+            float normalCoefficient = vertexCoefficient * BLENDSHAPE_NORMAL_COEFFICIENT_SCALE;
             const HFMBlendshape& blendshape = meshIter->blendshapes.at(i);
-            for (int j = 0; j < blendshape.indices.size(); ++j) {
-                int index = blendshape.indices.at(j);
-
-                auto& currentBlendshapeOffset = unpackedBlendshapeOffsets[index];
-                currentBlendshapeOffset.positionOffset += blendshape.vertices.at(j) * vertexCoefficient;
-                currentBlendshapeOffset.normalOffset += blendshape.normals.at(j) * normalCoefficient;
-                if (j < blendshape.tangents.size()) {
-                    currentBlendshapeOffset.tangentOffset += blendshape.tangents.at(j) * normalCoefficient;
-                }
+            if (blendshape.normals.size() != blendshape.indices.size() ||
+                (!blendshape.tangents.empty() && blendshape.tangents.size() != blendshape.indices.size())) {
+                accumulateBlendshape_ref(unpackedBlendshapeOffsets.data(), blendshape, vertexCoefficient, normalCoefficient);
+            } else {
+                accumulateBlendshape(unpackedBlendshapeOffsets.data(), blendshape, vertexCoefficient, normalCoefficient);
             }
         }
 
         // convert unpackedBlendshapeOffsets into packedBlendshapeOffsets for the gpu.
         auto unpacked = unpackedBlendshapeOffsets.data();
-        auto packed = packedBlendshapeOffsets.data() + offset;
+        auto packed = blendshapeOffsets.data() + offset;
         packBlendshapeOffsets(unpacked, packed, numVertsInMesh);
 
         offset += numVertsInMesh;
     }
-    Q_ASSERT(offset == numBlendshapeOffsets);
+    Q_ASSERT(offset == blendshapeOffsets.size());
+}
+
+void Blender::run() {
+    DETAILED_PROFILE_RANGE_EX(simulation_animation, __FUNCTION__, 0xFFFF0000, 0, { { "url", _model->getURL().toString() } });
+    QVector<BlendshapeOffset> packedBlendshapeOffsets;
+    QVector<int> blendedMeshSizes;
+    ModelBlender::blendMeshes(*_hfmModel, _blendshapeCoefficients, packedBlendshapeOffsets, blendedMeshSizes);
 
     // post the result to the ModelBlender, which will dispatch to the model if still alive
     QMetaObject::invokeMethod(DependencyManager::get<ModelBlender>().data(), "setBlendedVertices",
@@ -1946,6 +2148,135 @@ void Blender::run() {
                               Q_ARG(QVector<int>, blendedMeshSizes));
 }
 
+// The GPU blendshapes of a mesh are laid out as uvec4s:
+//   [0]                            the offsets of the vertex ranges, the deltas and the delta blendshapes, then the
+//                                  number of blendshapes
+//   [1, 1 + (vertices + 1) / 2)    the first delta and the number of deltas of each vertex, two vertices per uvec4
+//   [deltas, deltas + D)           the packed offset of each delta, as blended on the CPU but with halved normals and
+//                                  tangents so that the offsets between unit vectors fit the packing
+//   [indices, indices + D / 4)     the blendshape of each delta, four per uvec4
+// and the coefficients of the model follow in a second buffer, four per vec4.
+static const float GPU_BLENDSHAPE_NORMAL_SCALE = 0.5f;
+
+std::vector<BlendshapeOffset> GPUBlendshapes::layoutMesh(const HFMMesh& mesh) {
+    std::vector<BlendshapeOffset> layout;
+    uint32_t numVertices = (uint32_t)mesh.vertices.size();
+    if (mesh.blendshapes.isEmpty() || numVertices == 0) {
+        return layout;
+    }
+
+    std::vector<uint32_t> firstDeltas(numVertices, 0);
+    for (const auto& blendshape : mesh.blendshapes) {
+        for (int index : blendshape.indices) {
+            if (index >= 0 && (uint32_t)index < numVertices) {
+                firstDeltas[index]++;
+            }
+        }
+    }
+    uint32_t numDeltas = 0;
+    for (auto& firstDelta : firstDeltas) {
+        uint32_t count = firstDelta;
+        firstDelta = numDeltas;
+        numDeltas += count;
+    }
+
+    const uint32_t rangesOffset = 1;
+    const uint32_t deltasOffset = rangesOffset + (numVertices + 1) / 2;
+    const uint32_t indicesOffset = deltasOffset + numDeltas;
+    layout.resize(indicesOffset + (numDeltas + 3) / 4, BlendshapeOffset { glm::uvec4(0) });
+    layout[0].packedPosNorTan = glm::uvec4(rangesOffset, deltasOffset, indicesOffset, (uint32_t)mesh.blendshapes.size());
+
+    std::vector<BlendshapeOffsetUnpacked> deltas(numDeltas);
+    std::vector<uint32_t> nextDeltas = firstDeltas;
+    for (int i = 0; i < mesh.blendshapes.size(); i++) {
+        const HFMBlendshape& blendshape = mesh.blendshapes.at(i);
+        for (int j = 0; j < blendshape.indices.size(); ++j) {
+            int index = blendshape.indices.at(j);
+            if (index < 0 || (uint32_t)index >= numVertices) {
+                continue;
+            }
+            uint32_t delta = nextDeltas[index]++;
+            auto& unpacked = deltas[delta];
+            unpacked.positionOffset = blendshape.vertices.at(j);
+            unpacked.normalOffset = j < blendshape.normals.size() ? blendshape.normals.at(j) * GPU_BLENDSHAPE_NORMAL_SCALE : glm::vec3(0.0f);
+            unpacked.tangentOffset = j < blendshape.tangents.size() ? blendshape.tangents.at(j) * GPU_BLENDSHAPE_NORMAL_SCALE : glm::vec3(0.0f);
+            layout[indicesOffset + delta / 4].packedPosNorTan[delta % 4] = (uint32_t)i;
+        }
+    }
+    if (numDeltas > 0) {
+        packBlendshapeOffsets(deltas.data(), layout.data() + deltasOffset, (int)numDeltas);
+    }
+
+    for (uint32_t i = 0; i < numVertices; i++) {
+        uint32_t count = nextDeltas[i] - firstDeltas[i];
+        auto& ranges = layout[rangesOffset + i / 2].packedPosNorTan;
+        ranges[(i % 2) * 2] = firstDeltas[i];
+        ranges[(i % 2) * 2 + 1] = count;
+    }
+    return layout;
+}
+
+std::vector<float> GPUBlendshapes::layoutCoefficients(const QVector<float>& coefficients, int numBlendshapes) {
+    // a whole vec4 is read for each coefficient
+    std::vector<float> layout(std::max(4, (numBlendshapes + 3) / 4 * 4), 0.0f);
+    for (int i = 0, n = std::min(coefficients.size(), numBlendshapes); i < n; i++) {
+        float coefficient = coefficients.at(i);
+        layout[i] = coefficient < BLENDSHAPE_COEFFICIENT_EPSILON ? 0.0f : coefficient;
+    }
+    return layout;
+}
+
+GPUBlendshapes::GPUBlendshapes(const HFMModel& hfmModel) {
+    PROFILE_RANGE(render, __FUNCTION__);
+    _meshBuffers.resize(hfmModel.meshes.size());
+    for (int i = 0; i < hfmModel.meshes.size(); i++) {
+        const HFMMesh& mesh = hfmModel.meshes.at(i);
+        auto layout = layoutMesh(mesh);
+        if (layout.empty()) {
+            continue;
+        }
+        auto size = layout.size() * sizeof(BlendshapeOffset);
+        _meshBuffers[i] = std::make_shared<gpu::Buffer>(size, (const gpu::Byte*)layout.data(), size);
+        _maxBlendshapes = std::max(_maxBlendshapes, mesh.blendshapes.size());
+    }
+}
+
+GPUBlendshapes::Pointer GPUBlendshapes::get(const HFMModel::ConstPointer& hfmModel) {
+    struct Entry {
+        std::weak_ptr<const HFMModel> hfmModel;
+        std::weak_ptr<const GPUBlendshapes> blendshapes;
+    };
+    static std::mutex mutex;
+    static std::vector<Entry> entries;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Pointer blendshapes;
+    for (auto itr = entries.begin(); itr != entries.end();) {
+        auto entryModel = itr->hfmModel.lock();
+        auto entryBlendshapes = itr->blendshapes.lock();
+        if (!entryModel || !entryBlendshapes) {
+            itr = entries.erase(itr);
+            continue;
+        }
+        if (entryModel == hfmModel) {
+            blendshapes = entryBlendshapes;
+        }
+        ++itr;
+    }
+    if (!blendshapes) {
+        blendshapes = std::make_shared<GPUBlendshapes>(*hfmModel);
+        entries.push_back({ hfmModel, blendshapes });
+    }
+    return blendshapes;
+}
+
+gpu::BufferPointer GPUBlendshapes::getMeshBuffer(int meshIndex) const {
+    if (meshIndex < 0 || meshIndex >= (int)_meshBuffers.size()) {
+        return nullptr;
+    }
+    return _meshBuffers[meshIndex];
+}
+
 bool Model::maybeStartBlender() {
     if (isLoaded()) {
         QThreadPool::globalInstance()->start(new Blender(getThisPointer(), getGeometry()->getConstHFMModelPointer(),
@@ -19,6 +19,7 @@
 #include <QUrl>
 #include <QMutex>
 
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
@@ -80,6 +81,31 @@ struct SortedTriangleSet {
 
 using BlendShapeOperator = std::function<void(int, const QVector<BlendshapeOffset>&, const QVector<int>&, const render::ItemIDs&)>;
 
+/// The blendshapes of the meshes of a model laid out for the vertex shader to blend them, see Blendshape.slh.  They're
+/// uploaded once and shared by the models using the same geometry, which then only upload their coefficients.
+class GPUBlendshapes {
+public:
+    using Pointer = std::shared_ptr<const GPUBlendshapes>;
+
+    /// Returns the blendshapes of hfmModel, laid out on first use
+    static Pointer get(const HFMModel::ConstPointer& hfmModel);
+
+    /// Lays out the offsets of each vertex of mesh in each of its blendshapes, empty if it has no blendshapes
+    static std::vector<BlendshapeOffset> layoutMesh(const HFMMesh& mesh);
+    /// Lays out the coefficients of numBlendshapes blendshapes, dropping the ones too small to be blended
+    static std::vector<float> layoutCoefficients(const QVector<float>& coefficients, int numBlendshapes);
+
+    GPUBlendshapes(const HFMModel& hfmModel);
+
+    /// Returns the blendshape buffer of a mesh, or nullptr if the mesh has no blendshapes
+    gpu::BufferPointer getMeshBuffer(int meshIndex) const;
+    int getMaxBlendshapes() const { return _maxBlendshapes; }
+
+private:
+    std::vector<gpu::BufferPointer> _meshBuffers;
+    int _maxBlendshapes { 0 };
+};
+
 /// A generic 3D model displaying geometry loaded from a URL.
 class Model : public QObject, public std::enable_shared_from_this<Model>, public scriptable::ModelProvider {
     Q_OBJECT
@@ -166,6 +192,8 @@ public:
     bool maybeStartBlender();
 
     bool isLoaded() const { return (bool)_renderGeometry && _renderGeometry->isHFMModelLoaded(); }
+    /// Returns true while the geometry is the coarse preview of the model, drawn until the model itself loads
+    bool isShowingPreview() const { return _isShowingPreview; }
     bool isAddedToScene() const { return _addedToScene; }
 
     void reset();
@@ -178,6 +206,9 @@ public:
     virtual void updateClusterMatrices();
     virtual void updateBlendshapes();
 
+    /// Computes the cluster matrices of the models that need them across threads, ahead of their updateClusterMatrices
+    static void updateClusterMatrices(const std::vector<ModelPointer>& models);
+
     /// Returns a reference to the shared geometry.
     const Geometry::Pointer& getGeometry() const { return _renderGeometry; }
 
@@ -288,7 +319,8 @@ public:
     // returns 'true' if needs fullUpdate after geometry change
     virtual bool updateGeometry();
 
-    void setLoadingPriority(float priority) { _loadingPriority = priority; }
+    /// Sets the priority of the model's download, updating it if the download is still pending
+    void setLoadingPriority(float priority);
 
     size_t getRenderInfoVertexCount() const { return _renderInfoVertexCount; }
     size_t getRenderInfoTextureSize();
@@ -366,6 +398,7 @@ public:
 
 public slots:
     void loadURLFinished(bool success);
+    void loadPreviewFinished();
 
 signals:
     void setURLFinished(bool success);
@@ -428,6 +461,13 @@ protected:
 
     virtual void updateRig(float deltaTime, glm::mat4 parentTransform);
 
+    // Computes the cluster matrices from the rig.  It touches nothing but the mesh states of this model, so that
+    // several models can compute theirs at once
+    virtual void computeClusterMatrices();
+    // the absolute matrices of the joints of the rig, and the poses of the clusters for dual quaternion skinning
+    std::vector<glm::mat4> _jointMatrices;
+    AnimPoseVec _clusterPoses;
+
     /// Allow sub classes to force invalidating the bboxes
     void invalidCalculatedMeshBoxes() {
         _triangleSetsValid = false;
@@ -438,6 +478,11 @@ protected:
 
     virtual void deleteGeometry();
 
+    // Uploads the blendshape coefficients for the vertex shaders to blend the blendshapes
+    void updateGPUBlendshapes();
+    // Skins the meshes into _skinnedVertexBuffers, for every render pass to draw them without skinning them again
+    void updateSkinnedVertexBuffers();
+
     QUrl _url;
 
     BlendShapeOperator _modelBlendshapeOperator { nullptr };
@@ -445,6 +490,13 @@ protected:
     QVector<float> _blendedBlendshapeCoefficients;
     int _blendNumber { 0 };
 
+    GPUBlendshapes::Pointer _gpuBlendshapes;
+    gpu::BufferPointer _blendshapeCoefficientsBuffer;
+    // The render items given the GPU blendshapes
+    render::ItemIDs _gpuBlendedItemIDs;
+    // The skinned vertices of each mesh, null for the meshes skinned in the vertex shader
+    std::vector<gpu::BufferPointer> _skinnedVertexBuffers;
+
     mutable QRecursiveMutex _mutex;
 
     bool _overrideModelTransform { false };
@@ -474,12 +526,15 @@ protected:
     bool _needsFixupInScene { true }; // needs to be removed/re-added to scene
     bool _needsReload { true };
     bool _needsUpdateClusterMatrices { true };
+    // set when the cluster matrices were computed ahead of updateClusterMatrices, which still has to update the blendshapes
+    bool _clusterMatricesComputedAhead { false };
     QVariantMap _pendingTextures { };
 
     friend class ModelMeshPartPayload;
     Rig _rig;
 
     bool _visualGeometryRequestFailed { false };
+    bool _isShowingPreview { false };
 
     bool _renderItemsNeedUpdate { false };
 
@@ -531,10 +586,20 @@ public:
     void noteRequiresBlend(ModelPointer model);
 
     bool shouldComputeBlendshapes() { return _computeBlendshapes; }
+    /// Returns true if the blendshapes are blended by the vertex shaders rather than by Blender jobs
+    bool shouldBlendOnGPU() const { return _blendOnGPU && _gpuBlendingSupported; }
+
+    /// Blends the blendshapes of the meshes of hfmModel on the CPU, the offsets of the blended meshes are appended to
+    /// blendshapeOffsets and the number of vertices of every mesh, 0 if it isn't blended, to blendedMeshSizes
+    static void blendMeshes(const HFMModel& hfmModel, const QVector<float>& blendshapeCoefficients,
+                            QVector<BlendshapeOffset>& blendshapeOffsets, QVector<int>& blendedMeshSizes);
 
 public slots:
     void setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets, QVector<int> blendedMeshSizes);
     void setComputeBlendshapes(bool computeBlendshapes) { _computeBlendshapes = computeBlendshapes; }
+    void setBlendOnGPU(bool blendOnGPU) { _blendOnGPU = blendOnGPU; }
+    // Only the storage buffer shaders of the GL 4.5 backend blend blendshapes
+    void setGPUBlendingSupported(bool supported) { _gpuBlendingSupported = supported; }
 
 private:
     using Mutex = std::mutex;
@@ -549,6 +614,8 @@ private:
     Mutex _mutex;
 
     bool _computeBlendshapes { true };
+    std::atomic<bool> _blendOnGPU { true };
+    std::atomic<bool> _gpuBlendingSupported { false };
 };
 
 
@@ -33,6 +33,7 @@
 #include "TextureCache.h"
 #include "RenderCommonTask.h"
 #include "RenderHUDLayerTask.h"
+#include "DeferredLightingEffect.h"
 
 namespace ru {
     using render_utils::slot::texture::Texture;
@@ -47,6 +48,7 @@ namespace gr {
 using namespace render;
 
 extern void initForwardPipelines(ShapePlumber& plumber);
+extern void initZPassPipelines(ShapePlumber& plumber, gpu::StatePointer state, const render::ShapePipeline::BatchSetter& batchSetter, const render::ShapePipeline::ItemSetter& itemSetter);
 
 void PreparePrimaryFramebufferMSAAConfig::setResolutionScale(float scale) {
     const float SCALE_RANGE_MIN = 0.1f;
@@ -73,6 +75,12 @@ void RenderForwardTask::build(JobModel& task, const render::Varying& input, rend
     auto fadeEffect = DependencyManager::get<FadeEffect>();
     ShapePlumberPointer shapePlumber = std::make_shared<ShapePlumber>();
     initForwardPipelines(*shapePlumber);
+    ShapePlumberPointer depthPlumber = std::make_shared<ShapePlumber>();
+    {
+        auto state = std::make_shared<gpu::State>();
+        state->setColorWriteMask(false, false, false, false);
+        initZPassPipelines(*depthPlumber, state, fadeEffect->getBatchSetter(), fadeEffect->getItemUniformSetter());
+    }
 
     // Unpack inputs
     const auto& inputs = input.get<Input>();
@@ -121,8 +129,17 @@ void RenderForwardTask::build(JobModel& task, const render::Varying& input, rend
     // draw a stencil mask in hidden regions of the framebuffer.
     task.addJob<PrepareStencil>("PrepareStencil", scaledPrimaryFramebuffer);
 
+    // Light Clustering, the local lights are shaded in the forward pipelines from the cluster grid
+    // The clustering doesn't use the linear depth
+    const auto nullLinearDepth = Varying(LinearDepthFramebufferPointer());
+    const auto lightClusteringPassInputs = LightClusteringPass::Input(deferredFrameTransform, lightingModel, lightFrame, nullLinearDepth).asVarying();
+    const auto lightClusters = task.addJob<LightClusteringPass>("LightClustering", lightClusteringPassInputs);
+
+    // Lay the depth of the opaques first so that they are only shaded once per pixel
+    task.addJob<DrawForwardDepth>("DrawOpaqueDepth", opaques, depthPlumber);
+
     // Draw opaques forward
-    const auto opaqueInputs = DrawForward::Inputs(opaques, lightingModel, hazeFrame).asVarying();
+    const auto opaqueInputs = DrawForward::Inputs(opaques, lightingModel, hazeFrame, lightClusters).asVarying();
     task.addJob<DrawForward>("DrawOpaques", opaqueInputs, shapePlumber, true);
 
     // Similar to light stage, background stage has been filled by several potential render items and resolved for the frame in this job
@@ -130,7 +147,7 @@ void RenderForwardTask::build(JobModel& task, const render::Varying& input, rend
     task.addJob<DrawBackgroundStage>("DrawBackgroundForward", backgroundInputs);
 
     // Draw transparent objects forward
-    const auto transparentInputs = DrawForward::Inputs(transparents, lightingModel, hazeFrame).asVarying();
+    const auto transparentInputs = DrawForward::Inputs(transparents, lightingModel, hazeFrame, lightClusters).asVarying();
     task.addJob<DrawForward>("DrawTransparents", transparentInputs, shapePlumber, false);
 
      // Layered
@@ -247,12 +264,46 @@ void PrepareForward::run(const RenderContextPointer& renderContext, const Inputs
     });
 }
 
+void DrawForwardDepth::run(const RenderContextPointer& renderContext, const Inputs& inputs) {
+    RenderArgs* args = renderContext->args;
+
+    // The items with their own pipeline or a custom one don't have a z pass version, they only draw in the forward pass
+    _depthItems.clear();
+    for (const auto& item : inputs) {
+        const auto key = args->_scene->getItem(item.id).getShapeKey();
+        if (key.isValid() && !key.hasOwnPipeline() && !key.isCustom()) {
+            _depthItems.push_back(item);
+        }
+    }
+
+    gpu::doInBatch("DrawForwardDepth::run", args->_context, [&](gpu::Batch& batch) {
+        args->_batch = &batch;
+
+        // Setup projection
+        glm::mat4 projMat;
+        Transform viewMat;
+        args->getViewFrustum().evalProjectionMatrix(projMat);
+        args->getViewFrustum().evalViewTransform(viewMat);
+        batch.setProjectionTransform(projMat);
+        batch.setViewTransform(viewMat);
+        batch.setModelTransform(Transform());
+
+        renderStateSortShapes(renderContext, _shapePlumber, _depthItems);
+
+        args->_batch = nullptr;
+    });
+
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
+    config->setNumDrawn((int)_depthItems.size());
+}
+
 void DrawForward::run(const RenderContextPointer& renderContext, const Inputs& inputs) {
     RenderArgs* args = renderContext->args;
 
     const auto& inItems = inputs.get0();
     const auto& lightingModel = inputs.get1();
     const auto& hazeFrame = inputs.get2();
+    const auto& lightClusters = inputs.get3();
 
     graphics::HazePointer haze;
     const auto& hazeStage = renderContext->args->_scene->getStage<HazeStage>();
@@ -280,6 +331,11 @@ void DrawForward::run(const RenderContextPointer& renderContext, const Inputs& i
             batch.setUniformBuffer(graphics::slot::buffer::Buffer::HazeParams, haze->getHazeParametersBuffer());
         }
 
+        // Setup the local lights, shaded from the cluster grid
+        if (lightClusters) {
+            DeferredLightingEffect::setupLocalLightsBatch(batch, lightClusters);
+        }
+
         // From the lighting model define a global shapeKey ORED with individiual keys
         ShapeKey::Builder keyBuilder;
         if (lightingModel->isWireframeEnabled()) {
@@ -297,6 +353,10 @@ void DrawForward::run(const RenderContextPointer& renderContext, const Inputs& i
 
         args->_batch = nullptr;
         args->_globalShapeKey = 0;
+
+        if (lightClusters) {
+            DeferredLightingEffect::unsetLocalLightsBatch(batch);
+        }
     });
 }
 
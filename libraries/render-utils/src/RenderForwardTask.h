@@ -16,6 +16,7 @@
 #include <render/RenderFetchCullSortTask.h>
 #include "AssembleLightingStageTask.h"
 #include "LightingModel.h"
+#include "LightClusters.h"
 
 class RenderForwardTaskConfig : public render::Task::Config {
     Q_OBJECT
@@ -88,9 +89,45 @@ public:
 private:
 };
 
+class DrawForwardDepthConfig : public render::Job::Config {
+    Q_OBJECT
+    Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY numDrawnChanged)
+public:
+    DrawForwardDepthConfig() : render::Job::Config(true) {}
+
+    int getNumDrawn() { return numDrawn; }
+    void setNumDrawn(int num) { numDrawn = num; emit numDrawnChanged(); }
+
+signals:
+    void numDrawnChanged();
+    void dirty();
+
+protected:
+    int numDrawn{ 0 };
+};
+
+// Depth prepass of the opaques, so that the forward shading, which evaluates all the lights of a fragment in one go, only
+// runs once per pixel
+class DrawForwardDepth {
+public:
+    using Inputs = render::ItemBounds;
+    using Config = DrawForwardDepthConfig;
+    using JobModel = render::Job::ModelI<DrawForwardDepth, Inputs, Config>;
+
+    DrawForwardDepth(const render::ShapePlumberPointer& shapePlumber) : _shapePlumber(shapePlumber) {}
+
+    void configure(const Config& config) {}
+    void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
+
+private:
+    render::ShapePlumberPointer _shapePlumber;
+    // the items that draw with the z pass pipelines, reused from frame to frame
+    render::ItemBounds _depthItems;
+};
+
 class DrawForward{
 public:
-    using Inputs = render::VaryingSet3<render::ItemBounds, LightingModelPointer, HazeStage::FramePointer>;
+    using Inputs = render::VaryingSet4<render::ItemBounds, LightingModelPointer, HazeStage::FramePointer, LightClustersPointer>;
     using JobModel = render::Job::ModelI<DrawForward, Inputs>;
 
     DrawForward(const render::ShapePlumberPointer& shapePlumber, bool opaquePass) : _shapePlumber(shapePlumber), _opaquePass(opaquePass) {}
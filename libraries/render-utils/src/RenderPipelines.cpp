@@ -1236,10 +1236,32 @@ void RenderPipelines::updateMultiMaterial(graphics::MultiMaterial& multiMaterial
         schema._key = (uint32_t)schemaKey._flags.to_ulong();
         schemaBuffer.edit<graphics::MultiMaterial::Schema>() = schema;
     }
+    multiMaterial.updateMaterialTable();
     multiMaterial.setNeedsUpdate(false);
     multiMaterial.setInitialized();
 }
 
+void RenderPipelines::reportTextureScreenSize(const graphics::MultiMaterial& multiMaterial, const RenderArgs* args, const AABox& bound) {
+    if (args->_renderMode != render::Args::DEFAULT_RENDER_MODE || !args->_enableTexturing) {
+        return;
+    }
+    const auto& textureTable = multiMaterial.getTextureTable();
+    const ViewFrustum& frustum = args->getViewFrustum();
+    if (!textureTable || !frustum.isPerspective()) {
+        return;
+    }
+
+    // assumes the texture coordinates span the bound once
+    float distance = std::max(glm::distance(frustum.getPosition(), bound.calcCenter()), frustum.getNearClip());
+    float pixels = glm::length(bound.getDimensions()) / distance * frustum.getProjection()[1][1] * 0.5f * (float)args->_viewport.w;
+    uint32_t screenSize = (uint32_t)std::min(pixels, (float)UINT16_MAX);
+    for (const auto& texture : textureTable->getTextures()) {
+        if (texture) {
+            texture->reportScreenSize(screenSize);
+        }
+    }
+}
+
 bool RenderPipelines::bindMaterials(graphics::MultiMaterial& multiMaterial, gpu::Batch& batch, render::Args::RenderMode renderMode, bool enableTextures) {
     if (multiMaterial.shouldUpdate()) {
         updateMultiMaterial(multiMaterial);
@@ -1247,6 +1269,9 @@ bool RenderPipelines::bindMaterials(graphics::MultiMaterial& multiMaterial, gpu:
 
     if (multiMaterial.isMToon()) {
         multiMaterial.setMToonTime();
+        multiMaterial.updateMaterialTable();
+    } else if (multiMaterial.getMaterialID() == graphics::MaterialTable::INVALID_ID) {
+        multiMaterial.updateMaterialTable();
     }
 
     auto textureCache = DependencyManager::get<TextureCache>();
@@ -1285,8 +1310,8 @@ bool RenderPipelines::bindMaterials(graphics::MultiMaterial& multiMaterial, gpu:
     // For shadows, we only need opacity mask information
     auto key = multiMaterial.getMaterialKey();
     if (renderMode != render::Args::RenderMode::SHADOW_RENDER_MODE || (key.isOpacityMaskMap() || key.isTranslucentMap())) {
-        auto& schemaBuffer = multiMaterial.getSchemaBuffer();
-        batch.setUniformBuffer(gr::Buffer::Material, schemaBuffer);
+        // the materials share the buffers of the material table, so only the offset changes from one to the next
+        batch.setUniformBuffer(gr::Buffer::Material, multiMaterial.getMaterialTableView());
         if (enableTextures) {
             batch.setResourceTextureTable(multiMaterial.getTextureTable());
         } else {
@@ -19,6 +19,9 @@ public:
     static void updateMultiMaterial(graphics::MultiMaterial& multiMaterial);
     static bool bindMaterial(graphics::MaterialPointer& material, gpu::Batch& batch, render::Args::RenderMode renderMode, bool enableTextures);
     static bool bindMaterials(graphics::MultiMaterial& multiMaterial, gpu::Batch& batch, render::Args::RenderMode renderMode, bool enableTextures);
+
+    // Reports the screen size of an item drawn with multiMaterial to its textures, for the texture streaming
+    static void reportTextureScreenSize(const graphics::MultiMaterial& multiMaterial, const RenderArgs* args, const AABox& bound);
 };
 
 
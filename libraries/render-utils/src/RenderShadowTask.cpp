@@ -11,6 +11,9 @@
 
 #include "RenderShadowTask.h"
 
+#include <functional>
+#include <mutex>
+
 #include <gpu/Context.h>
 
 #include <ViewFrustum.h>
@@ -52,7 +55,10 @@ void RenderShadowTask::build(JobModel& task, const render::Varying& input, rende
         auto fadeEffect = DependencyManager::get<FadeEffect>();
         initZPassPipelines(*shapePlumber, std::make_shared<gpu::State>(), fadeEffect->getBatchSetter(), fadeEffect->getItemUniformSetter());
     }
-    const auto setupOutput = task.addJob<RenderShadowSetup>("ShadowSetup", input);
+    auto cascadeCache = std::make_shared<ShadowCascadeCache>();
+    const auto setupOutput = task.addJob<RenderShadowSetup>("ShadowSetup", input, cascadeCache);
+    // The cost of the whole shadow pass, each cascade's is in its RenderShadowMap's config
+    const auto shadowTimer = task.addJob<BeginGPURangeTimer>("BeginShadowTimer", "Shadows");
     const auto queryResolution = setupOutput.getN<RenderShadowSetup::Output>(1);
     const auto shadowFrame = setupOutput.getN<RenderShadowSetup::Output>(3);
     const auto currentKeyLight = setupOutput.getN<RenderShadowSetup::Output>(4);
@@ -85,32 +91,42 @@ void RenderShadowTask::build(JobModel& task, const render::Varying& input, rende
     };
 
     CascadeBoxes cascadeSceneBBoxes;
+    render::Varying shadowFilters[SHADOW_CASCADE_MAX_COUNT];
+    CullShadowCascades::Inputs cullInputs;
 
     for (auto i = 0; i < SHADOW_CASCADE_MAX_COUNT; i++) {
         char jobName[64];
         sprintf(jobName, "ShadowCascadeSetup%d", i);
         const auto cascadeSetupOutput = task.addJob<RenderShadowCascadeSetup>(jobName, shadowFrame, i, shadowCasterReceiverFilter);
-        const auto shadowFilter = cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(0);
+        shadowFilters[i] = cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(0);
         auto antiFrustum = render::Varying(ViewFrustumPointer());
         cascadeFrustums[i] = cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(1);
         if (i > 1) {
             antiFrustum = cascadeFrustums[i - 2];
         }
 
-        const auto cullInputs = CullShadowBounds::Inputs(sortedShapes, shadowFilter, antiFrustum, currentKeyLight, cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(2)).asVarying();
-        sprintf(jobName, "CullShadowCascade%d", i);
-        const auto culledShadowItemsAndBounds = task.addJob<CullShadowBounds>(jobName, cullInputs);
+        cullInputs[i] = CullShadowBounds::Inputs(sortedShapes, shadowFilters[i], antiFrustum, currentKeyLight,
+            cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(2), cascadeFrustums[i]).asVarying();
+    }
+
+    // The cascades are culled against their own frustums, independently of each other
+    const auto culledCascades = task.addJob<CullShadowCascades>("CullShadowCascades", render::Varying(cullInputs));
+
+    for (auto i = 0; i < SHADOW_CASCADE_MAX_COUNT; i++) {
+        char jobName[64];
+        const auto culledShadowItemsAndBounds = culledCascades.getN<CullShadowCascades::Outputs>(i);
 
         // GPU jobs: Render to shadow map
         sprintf(jobName, "RenderShadowMap%d", i);
         const auto shadowInputs = RenderShadowMap::Inputs(culledShadowItemsAndBounds.getN<CullShadowBounds::Outputs>(0),
             culledShadowItemsAndBounds.getN<CullShadowBounds::Outputs>(1), shadowFrame).asVarying();
-        task.addJob<RenderShadowMap>(jobName, shadowInputs, shapePlumber, i);
+        task.addJob<RenderShadowMap>(jobName, shadowInputs, shapePlumber, i, cascadeCache);
         sprintf(jobName, "ShadowCascadeTeardown%d", i);
-        task.addJob<RenderShadowCascadeTeardown>(jobName, shadowFilter);
+        task.addJob<RenderShadowCascadeTeardown>(jobName, shadowFilters[i]);
 
         cascadeSceneBBoxes[i] = culledShadowItemsAndBounds.getN<CullShadowBounds::Outputs>(1);
     }
+    task.addJob<EndGPURangeTimer>("ShadowTimer", shadowTimer);
     task.addJob<RenderShadowTeardown>("ShadowTeardown", setupOutput);
 
 
@@ -118,6 +134,16 @@ void RenderShadowTask::build(JobModel& task, const render::Varying& input, rende
 
 }
 
+void CullShadowCascades::build(JobModel& task, const render::Varying& inputs, render::Varying& outputs) {
+    Outputs culledCascades;
+    for (auto i = 0; i < SHADOW_CASCADE_MAX_COUNT; i++) {
+        char jobName[64];
+        sprintf(jobName, "CullShadowCascade%d", i);
+        culledCascades[i] = task.addJob<CullShadowBounds>(jobName, inputs.getN<Inputs>(i));
+    }
+    outputs = culledCascades;
+}
+
 static void computeNearFar(const Triangle& triangle, const Plane shadowClipPlanes[4], float& near, float& far) {
     static const int MAX_TRIANGLE_COUNT = 16;
     Triangle clippedTriangles[MAX_TRIANGLE_COUNT];
@@ -200,6 +226,41 @@ static void adjustNearFar(const AABox& inShapeBounds, ViewFrustum& shadowFrustum
     }
 }
 
+void ShadowCascadeCache::invalidate() {
+    for (auto& cascade : cascades) {
+        cascade.isRendered = false;
+        cascade.isFrustumReused = false;
+    }
+}
+
+// The casters of a cascade, by the items and their bounds, so that a cached shadow map is rendered again when any of
+// them moves, appears or goes away
+static size_t computeCastersSignature(const render::ShapeBounds& shapes) {
+    size_t signature = 0;
+    size_t shapeSignature = 0;
+    auto combine = [&shapeSignature](size_t value) {
+        shapeSignature ^= value + 0x9e3779b9 + (shapeSignature << 6) + (shapeSignature >> 2);
+    };
+    std::hash<float> hashFloat;
+    for (const auto& shape : shapes) {
+        shapeSignature = render::ShapeKey::Hash()(shape.first);
+        for (const auto& item : shape.second) {
+            combine(item.id);
+            const auto& corner = item.bound.getCorner();
+            const auto& scale = item.bound.getScale();
+            combine(hashFloat(corner.x));
+            combine(hashFloat(corner.y));
+            combine(hashFloat(corner.z));
+            combine(hashFloat(scale.x));
+            combine(hashFloat(scale.y));
+            combine(hashFloat(scale.z));
+        }
+        // the order of the shapes in the map doesn't matter
+        signature += shapeSignature;
+    }
+    return signature;
+}
+
 void RenderShadowMap::run(const render::RenderContextPointer& renderContext, const Inputs& inputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -218,20 +279,52 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
 
     auto& cascade = shadow->getCascade(_cascadeIndex);
     auto& fbo = cascade.framebuffer;
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
 
     RenderArgs* args = renderContext->args;
-    auto adjustedShadowFrustum = args->getViewFrustum();
+
+    size_t castersSignature = 0;
+    if (_cascadeCache->isCached(_cascadeIndex)) {
+        auto& cachedCascade = _cascadeCache->cascades[_cascadeIndex];
+        castersSignature = computeCastersSignature(inShapes);
+        if (cachedCascade.isFrustumReused && cachedCascade.isRendered && cachedCascade.castersSignature == castersSignature) {
+            // the map still holds this cascade, only its frustum is applied again for the lighting and the teardown
+            shadow->setCascadeFrustum(_cascadeIndex, cachedCascade.renderedFrustum);
+            args->pushViewFrustum(cachedCascade.renderedFrustum);
+            config->setStats(0, true);
+            return;
+        }
+    }
+
+    if (!_gpuTimer) {
+        _gpuTimer = std::make_shared<gpu::RangeTimer>(__FUNCTION__);
+    }
+
+    ViewFrustum adjustedShadowFrustum = *cascade.getFrustum();
 
     // Adjust the frustum near and far depths based on the rendered items bounding box to have
     // the minimal Z range.
     adjustNearFar(inShapeBounds, adjustedShadowFrustum);
-    // Reapply the frustum as it has been adjusted
+    // Reapply the frustum as it has been adjusted, the cascade teardown pops it
     shadow->setCascadeFrustum(_cascadeIndex, adjustedShadowFrustum);
-    args->popViewFrustum();
     args->pushViewFrustum(adjustedShadowFrustum);
 
+    if (_cascadeCache->isCached(_cascadeIndex)) {
+        auto& cachedCascade = _cascadeCache->cascades[_cascadeIndex];
+        cachedCascade.renderedFrustum = adjustedShadowFrustum;
+        cachedCascade.castersSignature = castersSignature;
+        cachedCascade.isRendered = true;
+        cachedCascade.age = 0;
+    }
+
+    int numDrawn = 0;
+    for (const auto& shape : inShapes) {
+        numDrawn += (int)shape.second.size();
+    }
+
     gpu::doInBatch("RenderShadowMap::run", args->_context, [&](gpu::Batch& batch) {
         args->_batch = &batch;
+        _gpuTimer->begin(batch);
         batch.enableStereo(false);
 
         glm::ivec4 viewport{0, 0, fbo->getWidth(), fbo->getHeight()};
@@ -254,11 +347,16 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
             sortAndRenderZPassShapes(_shapePlumber, renderContext, inShapes, itemBounds);
         }
 
+        _gpuTimer->end(batch);
         args->_batch = nullptr;
     });
+
+    config->setGPUBatchRunTime(_gpuTimer->getGPUAverage(), _gpuTimer->getBatchAverage());
+    config->setStats(numDrawn, false);
 }
 
-RenderShadowSetup::RenderShadowSetup() :
+RenderShadowSetup::RenderShadowSetup(ShadowCascadeCachePointer cascadeCache) :
+    _cascadeCache{ cascadeCache },
     _cameraFrustum{ std::make_shared<ViewFrustum>() },
     _coarseShadowFrustum{ std::make_shared<ViewFrustum>() } {
     _shadowFrameCache = std::make_shared<LightStage::ShadowFrame>();
@@ -275,6 +373,67 @@ void RenderShadowSetup::configure(const Config& config) {
     slopeBias3 = config.slopeBias3;
     biasInput = config.biasInput;
     maxDistance = config.maxDistance;
+
+    unsigned int firstCachedCascade = (unsigned int)glm::clamp(config.firstCachedCascade, 0, SHADOW_CASCADE_MAX_COUNT);
+    if (config.cachedCascades != _cascadeCache->isEnabled || firstCachedCascade != _cascadeCache->firstCachedCascade
+            || config.cachedCascadeMargin != _cascadeCache->margin) {
+        _cascadeCache->invalidate();
+    }
+    _cascadeCache->isEnabled = config.cachedCascades;
+    _cascadeCache->firstCachedCascade = firstCachedCascade;
+    _cascadeCache->margin = glm::max(config.cachedCascadeMargin, 0.0f);
+    _cascadeCache->refreshFrames = glm::max(config.cachedCascadeRefreshFrames, 1);
+}
+
+// The bounds of an orthographic frustum in its own space, from its projection
+static void getOrthoBounds(const glm::mat4& projection, glm::vec3& min, glm::vec3& max) {
+    for (int i = 0; i < 3; i++) {
+        float a = (-1.0f - projection[3][i]) / projection[i][i];
+        float b = (1.0f - projection[3][i]) / projection[i][i];
+        min[i] = glm::min(a, b);
+        max[i] = glm::max(a, b);
+    }
+}
+
+void RenderShadowSetup::fitCachedCascade(unsigned int cascadeIndex, const glm::vec3& lightDirection) {
+    auto& cachedCascade = _cascadeCache->cascades[cascadeIndex];
+    const auto& fittedFrustum = *_globalShadowObject->getCascade(cascadeIndex).getFrustum();
+
+    glm::vec3 min, max;
+    getOrthoBounds(fittedFrustum.getProjection(), min, max);
+
+    const float LIGHT_DIRECTION_TOLERANCE = 0.99999f;
+    bool isFrustumReused = cachedCascade.isRendered && cachedCascade.age < _cascadeCache->getRefreshFrames(cascadeIndex)
+        && glm::dot(cachedCascade.lightDirection, lightDirection) > LIGHT_DIRECTION_TOLERANCE;
+
+    if (isFrustumReused) {
+        // the frustums have the same orientation, the one fitted to the view this frame is moved into the space of the
+        // cached one to check that it's still inside
+        glm::vec3 cachedMin, cachedMax;
+        getOrthoBounds(cachedCascade.fittedFrustum.getProjection(), cachedMin, cachedMax);
+        glm::vec3 offset = glm::inverse(cachedCascade.fittedFrustum.getOrientation()) *
+            (fittedFrustum.getPosition() - cachedCascade.fittedFrustum.getPosition());
+        isFrustumReused = glm::all(glm::greaterThanEqual(min + offset, cachedMin)) &&
+            glm::all(glm::lessThanEqual(max + offset, cachedMax));
+    }
+
+    if (isFrustumReused) {
+        cachedCascade.age++;
+        _globalShadowObject->setCascadeFrustum(cascadeIndex, cachedCascade.fittedFrustum);
+    } else {
+        // the cascade is rendered again, with a margin so that it can be kept while the camera moves a little
+        glm::vec2 margin = glm::vec2(max - min) * _cascadeCache->margin;
+        ViewFrustum enlargedFrustum = fittedFrustum;
+        enlargedFrustum.setProjection(glm::ortho<float>(min.x - margin.x, max.x + margin.x, min.y - margin.y,
+                                                        max.y + margin.y, -max.z, -min.z));
+        enlargedFrustum.calculate();
+        _globalShadowObject->setCascadeFrustum(cascadeIndex, enlargedFrustum);
+
+        cachedCascade.fittedFrustum = enlargedFrustum;
+        cachedCascade.lightDirection = lightDirection;
+        cachedCascade.isRendered = false;
+    }
+    cachedCascade.isFrustumReused = isFrustumReused;
 }
 
 void RenderShadowSetup::calculateBiases(float biasInput) {
@@ -319,6 +478,7 @@ void RenderShadowSetup::run(const render::RenderContextPointer& renderContext, c
 
     const auto currentKeyLight = lightStage->getCurrentKeyLight(lightFrame);
     if (!lightingModel->isShadowEnabled() || !currentKeyLight || !currentKeyLight->getCastShadows()) {
+        _cascadeCache->invalidate();
         renderContext->taskFlow.abortTask();
         return;
     }
@@ -344,6 +504,9 @@ void RenderShadowSetup::run(const render::RenderContextPointer& renderContext, c
     // Adjust each cascade frustum
     for (unsigned int cascadeIndex = 0; cascadeIndex < _globalShadowObject->getCascadeCount(); ++cascadeIndex) {
         _globalShadowObject->setKeylightCascadeFrustum(cascadeIndex, args->getViewFrustum(), SHADOW_FRUSTUM_NEAR, SHADOW_FRUSTUM_FAR);
+        if (_cascadeCache->isCached(cascadeIndex)) {
+            fitCachedCascade(cascadeIndex, glm::normalize(currentKeyLight->getDirection()));
+        }
     }
 
     calculateBiases(biasInput > 0.0f ? biasInput : currentKeyLight->getShadowBias());
@@ -421,9 +584,6 @@ void RenderShadowSetup::run(const render::RenderContextPointer& renderContext, c
 void RenderShadowCascadeSetup::run(const render::RenderContextPointer& renderContext, const Inputs& input, Outputs& output) {
     const auto shadowFrame = input;
 
-    // Cache old render args
-    RenderArgs* args = renderContext->args;
-
     RenderShadowTask::CullFunctor cullFunctor;
     if (shadowFrame && !shadowFrame->_objects.empty() && shadowFrame->_objects[0]) {
         const auto globalShadow = shadowFrame->_objects[0];
@@ -431,10 +591,9 @@ void RenderShadowCascadeSetup::run(const render::RenderContextPointer& renderCon
         if (globalShadow && _cascadeIndex < globalShadow->getCascadeCount()) {
             output.edit0() = _filter;
 
-            // Set the keylight render args
+            // Select the keylight cascade
             auto& cascade = globalShadow->getCascade(_cascadeIndex);
             auto& cascadeFrustum = cascade.getFrustum();
-            args->pushViewFrustum(*cascadeFrustum);
             auto texelSize = glm::min(cascadeFrustum->getHeight(), cascadeFrustum->getWidth()) / cascade.framebuffer->getSize().x;
             // Set the cull threshold to 24 shadow texels. This is totally arbitrary
             const auto minTexelCount = 24.0f;
@@ -502,6 +661,7 @@ void CullShadowBounds::run(const render::RenderContextPointer& renderContext, co
 
     const auto& inShapes = inputs.get0();
     const auto& filter = inputs.get1();
+    const auto& frustum = inputs.get5();
     ViewFrustumPointer antiFrustum;
     auto& outShapes = outputs.edit0();
     auto& outBounds = outputs.edit1();
@@ -520,8 +680,9 @@ void CullShadowBounds::run(const render::RenderContextPointer& renderContext, co
     };
 
     if (!filter.selectsNothing() && currentKeyLight) {
-        auto& details = args->_details.edit(RenderDetails::SHADOW);
-        render::CullTest test(shadowCullFunctor, args, details, antiFrustum);
+        // the cascades are culled in parallel, so count locally and add to the shared details at the end
+        RenderDetails::Item details;
+        render::CullTest test(shadowCullFunctor, args, details, antiFrustum, frustum);
         auto scene = args->_scene;
         auto lightStage = renderContext->_scene->getStage<LightStage>();
         assert(lightStage);
@@ -575,5 +736,13 @@ void CullShadowBounds::run(const render::RenderContextPointer& renderContext, co
         for (auto& items : outShapes) {
             items.second.shrink_to_fit();
         }
+
+        static std::mutex detailsMutex;
+        std::lock_guard<std::mutex> lock(detailsMutex);
+        auto& shadowDetails = args->_details.edit(RenderDetails::SHADOW);
+        shadowDetails._considered += details._considered;
+        shadowDetails._outOfView += details._outOfView;
+        shadowDetails._tooSmall += details._tooSmall;
+        shadowDetails._rendered += details._rendered;
     }
 }
@@ -12,29 +12,90 @@
 #ifndef hifi_RenderShadowTask_h
 #define hifi_RenderShadowTask_h
 
+#include <array>
+
 #include <gpu/Framebuffer.h>
 #include <gpu/Pipeline.h>
+#include <gpu/Query.h>
 
 #include <render/CullTask.h>
+#include <render/Engine.h>
+#include <ViewFrustum.h>
 
 #include "Shadows_shared.slh"
 
 #include "LightingModel.h"
 #include "LightStage.h"
 
-class ViewFrustum;
+// The shadow maps of the far cascades, kept from one frame to the next while the cached mode is on.  A cascade is
+// rendered with a margin around the view, and its map is reused for as long as its shadow frustum still covers the
+// view, the light hasn't moved and the casters culled into it are the same.
+class ShadowCascadeCache {
+public:
+    struct Cascade {
+        // the frustum the cascade was fitted to, margin included, before its depth range was adjusted to the casters
+        ViewFrustum fittedFrustum;
+        // the frustum the shadow map was rendered with
+        ViewFrustum renderedFrustum;
+        glm::vec3 lightDirection;
+        size_t castersSignature { 0 };
+        int age { 0 };
+        bool isRendered { false };
+        // whether the setup kept the fitted frustum of the previous frames for this one
+        bool isFrustumReused { false };
+    };
+
+    bool isCached(unsigned int cascadeIndex) const { return isEnabled && cascadeIndex >= firstCachedCascade; }
+    // the farther cascades are refreshed less often, so that they don't all re-render in the same frame
+    int getRefreshFrames(unsigned int cascadeIndex) const { return refreshFrames << (cascadeIndex - firstCachedCascade); }
+    void invalidate();
+
+    bool isEnabled { false };
+    unsigned int firstCachedCascade { 2 };
+    float margin { 0.2f };
+    int refreshFrames { 30 };
+    std::array<Cascade, SHADOW_CASCADE_MAX_COUNT> cascades;
+};
+using ShadowCascadeCachePointer = std::shared_ptr<ShadowCascadeCache>;
+
+class RenderShadowMapConfig : public render::GPUJobConfig {
+    Q_OBJECT
+    Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY newStats)
+    Q_PROPERTY(bool cached READ isCached NOTIFY newStats)
+
+public:
+    int getNumDrawn() const { return numDrawn; }
+    bool isCached() const { return cached; }
+    void setStats(int drawn, bool isCached) {
+        numDrawn = drawn;
+        cached = isCached;
+        emit newStats();
+    }
+
+signals:
+    void newStats();
+
+private:
+    int numDrawn { 0 };
+    bool cached { false };
+};
 
 class RenderShadowMap {
 public:
     using Inputs = render::VaryingSet3<render::ShapeBounds, AABox, LightStage::ShadowFramePointer>;
-    using JobModel = render::Job::ModelI<RenderShadowMap, Inputs>;
+    using Config = RenderShadowMapConfig;
+    using JobModel = render::Job::ModelI<RenderShadowMap, Inputs, Config>;
 
-    RenderShadowMap(render::ShapePlumberPointer shapePlumber, unsigned int cascadeIndex) : _shapePlumber{ shapePlumber }, _cascadeIndex{ cascadeIndex } {}
+    RenderShadowMap(render::ShapePlumberPointer shapePlumber, unsigned int cascadeIndex, ShadowCascadeCachePointer cascadeCache) :
+        _shapePlumber{ shapePlumber }, _cascadeIndex{ cascadeIndex }, _cascadeCache{ cascadeCache } {}
+    void configure(const Config& config) {}
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
 protected:
     render::ShapePlumberPointer _shapePlumber;
     unsigned int _cascadeIndex;
+    ShadowCascadeCachePointer _cascadeCache;
+    gpu::RangeTimerPointer _gpuTimer;
 };
 
 //class RenderShadowTaskConfig : public render::Task::Config::Persistent {
@@ -87,6 +148,10 @@ class RenderShadowSetupConfig : public render::Job::Config {
     Q_PROPERTY(float slopeBias3 MEMBER slopeBias3 NOTIFY dirty)
     Q_PROPERTY(float biasInput MEMBER biasInput NOTIFY dirty)
     Q_PROPERTY(float maxDistance MEMBER maxDistance NOTIFY dirty)
+    Q_PROPERTY(bool cachedCascades MEMBER cachedCascades NOTIFY dirty)
+    Q_PROPERTY(int firstCachedCascade MEMBER firstCachedCascade NOTIFY dirty)
+    Q_PROPERTY(float cachedCascadeMargin MEMBER cachedCascadeMargin NOTIFY dirty)
+    Q_PROPERTY(int cachedCascadeRefreshFrames MEMBER cachedCascadeRefreshFrames NOTIFY dirty)
 
 public:
     // Set to > 0 to experiment with these values
@@ -101,6 +166,14 @@ public:
     float biasInput { 0.0f };
     float maxDistance { 0.0f };
 
+    // Keep the shadow maps of the far cascades while they still cover the view and their casters don't change
+    bool cachedCascades { false };
+    int firstCachedCascade { 2 };
+    // How much larger than the view a cached cascade is rendered, so that it can be kept while the camera moves
+    float cachedCascadeMargin { 0.2f };
+    // The first cached cascade is rendered again at least this often, each farther one half as often
+    int cachedCascadeRefreshFrames { 30 };
+
 signals:
     void dirty();
 };
@@ -112,11 +185,14 @@ public:
     using Config = RenderShadowSetupConfig;
     using JobModel = render::Job::ModelIO<RenderShadowSetup, Input, Output, Config>;
 
-    RenderShadowSetup();
+    RenderShadowSetup(ShadowCascadeCachePointer cascadeCache);
     void configure(const Config& config);
     void run(const render::RenderContextPointer& renderContext, const Input& input, Output& output);
 
 private:
+    void fitCachedCascade(unsigned int cascadeIndex, const glm::vec3& lightDirection);
+
+    ShadowCascadeCachePointer _cascadeCache;
     ViewFrustumPointer _cameraFrustum;
     ViewFrustumPointer _coarseShadowFrustum;
     struct {
@@ -173,13 +249,24 @@ public:
     void run(const render::RenderContextPointer& renderContext, const Input& input);
 };
 
+// Culls the shapes of one cascade against its own frustum, so the cascades can be culled in parallel
 class CullShadowBounds {
 public:
-    using Inputs = render::VaryingSet5<render::ShapeBounds, render::ItemFilter, ViewFrustumPointer, graphics::LightPointer, RenderShadowTask::CullFunctor>;
+    using Inputs = render::VaryingSet6<render::ShapeBounds, render::ItemFilter, ViewFrustumPointer, graphics::LightPointer, RenderShadowTask::CullFunctor, ViewFrustumPointer>;
     using Outputs = render::VaryingSet2<render::ShapeBounds, AABox>;
     using JobModel = render::Job::ModelIO<CullShadowBounds, Inputs, Outputs>;
 
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs);
 };
 
+// Runs the CullShadowBounds of all the cascades in parallel
+class CullShadowCascades {
+public:
+    using Inputs = render::VaryingArray<CullShadowBounds::Inputs, SHADOW_CASCADE_MAX_COUNT>;
+    using Outputs = render::VaryingArray<CullShadowBounds::Outputs, SHADOW_CASCADE_MAX_COUNT>;
+    using JobModel = render::Task::ParallelModelIO<CullShadowCascades, Inputs, Outputs>;
+
+    void build(JobModel& task, const render::Varying& inputs, render::Varying& outputs);
+};
+
 #endif // hifi_RenderShadowTask_h
@@ -0,0 +1,174 @@
+//
+//  SkinningPrepass.cpp
+//  libraries/render-utils/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "SkinningPrepass.h"
+
+#include <cstring>
+
+#include <TBBHelpers.h>
+
+static const int CLUSTERS_PER_VERTEX = 4;
+// the vertices are skinned by blocks of this many on the TBB threads
+static const size_t SKINNING_GRAIN_SIZE = 1024;
+
+bool SkinningPrepass::canSkin(const HFMMesh& mesh) {
+    const int numVertices = mesh.vertices.size();
+    // the meshes with one or two clusters are drawn with the transform of the first, see updateTransformForSkinnedMesh
+    return mesh.clusters.size() > 2 && mesh.blendshapes.empty() && numVertices > 0 &&
+        mesh.clusterIndices.size() == numVertices * CLUSTERS_PER_VERTEX &&
+        mesh.clusterWeights.size() == numVertices * CLUSTERS_PER_VERTEX &&
+        (mesh.normals.empty() || mesh.normals.size() == numVertices) &&
+        (mesh.tangents.empty() || mesh.tangents.size() == numVertices);
+}
+
+void SkinningPrepass::skinMesh(const HFMMesh& mesh, const std::vector<glm::mat4>& clusterMatrices, std::vector<Vertex>& vertices) {
+    const size_t numVertices = mesh.vertices.size();
+    const bool hasNormals = !mesh.normals.empty();
+    const bool hasTangents = !mesh.tangents.empty();
+    const int numClusters = (int)clusterMatrices.size();
+    vertices.resize(numVertices);
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numVertices, SKINNING_GRAIN_SIZE), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); i++) {
+            glm::vec4 position(0.0f);
+            glm::vec4 normal(0.0f);
+            glm::vec4 tangent(0.0f);
+            const glm::vec4 inPosition(mesh.vertices[(int)i], 1.0f);
+            for (int j = 0; j < CLUSTERS_PER_VERTEX; j++) {
+                int clusterIndex = mesh.clusterIndices[(int)i * CLUSTERS_PER_VERTEX + j];
+                float clusterWeight = (float)mesh.clusterWeights[(int)i * CLUSTERS_PER_VERTEX + j] / (float)UINT16_MAX;
+                if (clusterWeight == 0.0f || clusterIndex >= numClusters) {
+                    continue;
+                }
+                const glm::mat4& clusterMatrix = clusterMatrices[clusterIndex];
+                position += clusterMatrix * inPosition * clusterWeight;
+                if (hasNormals) {
+                    normal += clusterMatrix * glm::vec4(mesh.normals[(int)i], 0.0f) * clusterWeight;
+                }
+                if (hasTangents) {
+                    tangent += clusterMatrix * glm::vec4(mesh.tangents[(int)i], 0.0f) * clusterWeight;
+                }
+            }
+
+            auto& vertex = vertices[i];
+            vertex.position = glm::vec3(position);
+            vertex.normal = glm::vec3(normal);
+            vertex.tangent = glm::vec3(tangent);
+        }
+    });
+}
+
+static glm::mat4 dualQuatToMat4(const glm::vec4& real, const glm::vec4& dual) {
+    float twoRealXSq = 2.0f * real.x * real.x;
+    float twoRealYSq = 2.0f * real.y * real.y;
+    float twoRealZSq = 2.0f * real.z * real.z;
+    float twoRealXY = 2.0f * real.x * real.y;
+    float twoRealXZ = 2.0f * real.x * real.z;
+    float twoRealXW = 2.0f * real.x * real.w;
+    float twoRealZW = 2.0f * real.z * real.w;
+    float twoRealYZ = 2.0f * real.y * real.z;
+    float twoRealYW = 2.0f * real.y * real.w;
+    glm::vec4 col0(1.0f - twoRealYSq - twoRealZSq, twoRealXY + twoRealZW, twoRealXZ - twoRealYW, 0.0f);
+    glm::vec4 col1(twoRealXY - twoRealZW, 1.0f - twoRealXSq - twoRealZSq, twoRealYZ + twoRealXW, 0.0f);
+    glm::vec4 col2(twoRealXZ + twoRealYW, twoRealYZ - twoRealXW, 1.0f - twoRealXSq - twoRealYSq, 0.0f);
+    glm::vec4 col3(2.0f * (-dual.w * real.x + dual.x * real.w - dual.y * real.z + dual.z * real.y),
+                   2.0f * (-dual.w * real.y + dual.x * real.z + dual.y * real.w - dual.z * real.x),
+                   2.0f * (-dual.w * real.z - dual.x * real.y + dual.y * real.x + dual.z * real.w),
+                   1.0f);
+    return glm::mat4(col0, col1, col2, col3);
+}
+
+void SkinningPrepass::skinMesh(const HFMMesh& mesh, const std::vector<Model::TransformDualQuaternion>& clusterDualQuaternions,
+                               std::vector<Vertex>& vertices) {
+    // read the clusters as the vertex shader does, scale, real part, dual part and cauterized position
+    static_assert(sizeof(Model::TransformDualQuaternion) == sizeof(glm::mat4), "The clusters are uploaded as mat4s");
+    std::vector<glm::mat4> clusterMatrices(clusterDualQuaternions.size());
+    if (!clusterMatrices.empty()) {
+        memcpy(clusterMatrices.data(), clusterDualQuaternions.data(), clusterMatrices.size() * sizeof(glm::mat4));
+    }
+
+    const size_t numVertices = mesh.vertices.size();
+    const bool hasNormals = !mesh.normals.empty();
+    const bool hasTangents = !mesh.tangents.empty();
+    const int numClusters = (int)clusterMatrices.size();
+    vertices.resize(numVertices);
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numVertices, SKINNING_GRAIN_SIZE), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); i++) {
+            glm::vec4 sAccum(0.0f);
+            glm::vec4 rAccum(0.0f);
+            glm::vec4 dAccum(0.0f);
+            glm::vec4 cAccum(0.0f);
+            int firstIndex = glm::min<int>(mesh.clusterIndices[(int)i * CLUSTERS_PER_VERTEX], numClusters - 1);
+            glm::vec4 polarityReference = clusterMatrices[firstIndex][1];
+            for (int j = 0; j < CLUSTERS_PER_VERTEX; j++) {
+                int clusterIndex = mesh.clusterIndices[(int)i * CLUSTERS_PER_VERTEX + j];
+                float clusterWeight = (float)mesh.clusterWeights[(int)i * CLUSTERS_PER_VERTEX + j] / (float)UINT16_MAX;
+                if (clusterWeight == 0.0f || clusterIndex >= numClusters) {
+                    continue;
+                }
+                const glm::mat4& clusterMatrix = clusterMatrices[clusterIndex];
+                const glm::vec4& real = clusterMatrix[1];
+
+                // to ensure that we rotate along the shortest arc, reverse dual quaternions with negative polarity.
+                float dqClusterWeight = glm::dot(real, polarityReference) < 0.0f ? -clusterWeight : clusterWeight;
+
+                sAccum += clusterMatrix[0] * clusterWeight;
+                rAccum += real * dqClusterWeight;
+                dAccum += clusterMatrix[2] * dqClusterWeight;
+                cAccum += clusterMatrix[3] * clusterWeight;
+            }
+
+            float norm = glm::length(rAccum);
+            if (norm > 0.0f) {
+                rAccum /= norm;
+                dAccum /= norm;
+            }
+            glm::mat4 m = dualQuatToMat4(rAccum, dAccum);
+
+            auto& vertex = vertices[i];
+            const float CAUTERIZATION_THRESHOLD = 0.1f;
+            if (sAccum.w > CAUTERIZATION_THRESHOLD) {
+                vertex.position = glm::vec3(cAccum);
+            } else {
+                sAccum.w = 1.0f;
+                vertex.position = glm::vec3(m * (sAccum * glm::vec4(mesh.vertices[(int)i], 1.0f)));
+            }
+            vertex.normal = hasNormals ? glm::vec3(m * glm::vec4(mesh.normals[(int)i], 0.0f)) : glm::vec3(0.0f);
+            vertex.tangent = hasTangents ? glm::vec3(m * glm::vec4(mesh.tangents[(int)i], 0.0f)) : glm::vec3(0.0f);
+        }
+    });
+}
+
+gpu::Stream::FormatPointer SkinningPrepass::makeVertexFormat(const gpu::Stream::Format& format, gpu::Stream::Slot skinnedChannel) {
+    static const gpu::Element SKINNED_ELEMENT { gpu::VEC3, gpu::FLOAT, gpu::XYZ };
+
+    auto skinnedFormat = std::make_shared<gpu::Stream::Format>();
+    for (const auto& entry : format.getAttributes()) {
+        const auto& attribute = entry.second;
+        switch (attribute._slot) {
+            case gpu::Stream::POSITION:
+                skinnedFormat->setAttribute(gpu::Stream::POSITION, skinnedChannel, SKINNED_ELEMENT, offsetof(Vertex, position));
+                break;
+            case gpu::Stream::NORMAL:
+                skinnedFormat->setAttribute(gpu::Stream::NORMAL, skinnedChannel, SKINNED_ELEMENT, offsetof(Vertex, normal));
+                break;
+            case gpu::Stream::TANGENT:
+                skinnedFormat->setAttribute(gpu::Stream::TANGENT, skinnedChannel, SKINNED_ELEMENT, offsetof(Vertex, tangent));
+                break;
+            default:
+                skinnedFormat->setAttribute(attribute._slot, attribute._channel, attribute._element, attribute._offset,
+                                            attribute._frequency);
+                break;
+        }
+    }
+    return skinnedFormat;
+}
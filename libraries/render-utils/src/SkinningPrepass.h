@@ -0,0 +1,44 @@
+//
+//  SkinningPrepass.h
+//  libraries/render-utils/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_SkinningPrepass_h
+#define overte_SkinningPrepass_h
+
+#include <vector>
+
+#include <gpu/Stream.h>
+
+#include "Model.h"
+
+/// Skins the vertices of a mesh once per frame into a vertex buffer that every render pass then draws without skinning
+/// them again, rather than each of the shadow cascades, the main view, the secondary cameras and the highlights skinning
+/// them in their vertex shaders.  The result matches evalSkinning in Skinning.slh.
+class SkinningPrepass {
+public:
+    struct Vertex {
+        glm::vec3 position;
+        glm::vec3 normal;
+        glm::vec3 tangent;
+    };
+
+    /// Returns true if the vertices of mesh can be skinned before they're drawn, the meshes with blendshapes are blended
+    /// before they're skinned in the vertex shader and aren't
+    static bool canSkin(const HFMMesh& mesh);
+
+    static void skinMesh(const HFMMesh& mesh, const std::vector<glm::mat4>& clusterMatrices, std::vector<Vertex>& vertices);
+    static void skinMesh(const HFMMesh& mesh, const std::vector<Model::TransformDualQuaternion>& clusterDualQuaternions,
+                         std::vector<Vertex>& vertices);
+
+    /// Returns format, with its position, normal and tangent read from the skinned vertices in channel skinnedChannel
+    static gpu::Stream::FormatPointer makeVertexFormat(const gpu::Stream::Format& format, gpu::Stream::Slot skinnedChannel);
+};
+
+#endif // overte_SkinningPrepass_h
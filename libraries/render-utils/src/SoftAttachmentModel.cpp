@@ -31,16 +31,7 @@ int SoftAttachmentModel::getJointIndexOverride(int i) const {
 
 // virtual
 // use the _rigOverride matrices instead of the Model::_rig
-void SoftAttachmentModel::updateClusterMatrices() {
-    if (!_needsUpdateClusterMatrices) {
-        return;
-    }
-    if (!isLoaded()) {
-        return;
-    }
-
-    _needsUpdateClusterMatrices = false;
-
+void SoftAttachmentModel::computeClusterMatrices() {
     const HFMModel& hfmModel = getHFMModel();
 
     for (int i = 0; i < (int) _meshStates.size(); i++) {
@@ -68,6 +59,4 @@ void SoftAttachmentModel::updateClusterMatrices() {
             }
         }
     }
-
-    updateBlendshapes();
 }
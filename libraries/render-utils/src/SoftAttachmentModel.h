@@ -27,9 +27,9 @@ public:
     ~SoftAttachmentModel();
 
     void updateRig(float deltaTime, glm::mat4 parentTransform) override;
-    void updateClusterMatrices() override;
 
 protected:
+    void computeClusterMatrices() override;
     int getJointIndexOverride(int i) const;
 
     const Rig& _rigOverride;
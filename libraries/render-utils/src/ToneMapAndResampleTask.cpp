@@ -88,6 +88,15 @@ void ToneMapAndResample::run(const RenderContextPointer& renderContext, const In
 
     glm::ivec4 destViewport{ 0, 0, bufferSize.x, bufferSize.y };
 
+    // A buffer rendered at a lower resolution scale is upscaled with a bicubic filter rather than a bilinear one
+    glm::vec2 upscaleTexelSize { 0.0f };
+    if (args->_viewport.z < destViewport.z || args->_viewport.w < destViewport.w) {
+        upscaleTexelSize = 1.0f / glm::vec2(srcBufferSize);
+    }
+    if (_parametersBuffer.get<Parameters>()._upscaleTexelSize != upscaleTexelSize) {
+        _parametersBuffer.edit<Parameters>()._upscaleTexelSize = upscaleTexelSize;
+    }
+
     gpu::doInBatch("Resample::run", args->_context, [&](gpu::Batch& batch) {
         batch.enableStereo(false);
         batch.setFramebuffer(destinationFramebuffer);
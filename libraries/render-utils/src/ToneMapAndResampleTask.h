@@ -87,7 +87,8 @@ private:
     public:
         float _exposure = 0.0f;
         float _twoPowExposure = 1.0f;
-        glm::vec2 spareA;
+        // The size of a texel of the lighting buffer when it's upscaled, 0 when it isn't
+        glm::vec2 _upscaleTexelSize { 0.0f, 0.0f };
         int _toneCurve = (int)ToneCurve::Gamma22;
         glm::vec3 spareB;
 
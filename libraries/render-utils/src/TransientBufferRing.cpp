@@ -0,0 +1,74 @@
+//
+//  TransientBufferRing.cpp
+//  libraries/render-utils/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "TransientBufferRing.h"
+
+const gpu::Size TransientBufferRing::BUFFER_SIZE { 256 * 1024 };
+// enough for any vertex attribute
+const gpu::Size TransientBufferRing::ALIGNMENT { 16 };
+const size_t TransientBufferRing::MAX_BUFFERS { 16 };
+
+TransientBufferRing::Range TransientBufferRing::allocate(gpu::Size size, const void* data) {
+    if (size > BUFFER_SIZE) {
+        return { std::make_shared<gpu::Buffer>(size, reinterpret_cast<const gpu::Byte*>(data)), 0 };
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_entries.empty()) {
+        if (!advance()) {
+            return { std::make_shared<gpu::Buffer>(size, reinterpret_cast<const gpu::Byte*>(data)), 0 };
+        }
+    } else {
+        // the data in a buffer that a frame has taken are only drawn by that frame, so the next frame starts a buffer
+        const Entry& current = _entries[_current];
+        gpu::Size offset = (current.used + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        if ((isTaken(current) || offset + size > BUFFER_SIZE) && !advance()) {
+            return { std::make_shared<gpu::Buffer>(size, reinterpret_cast<const gpu::Byte*>(data)), 0 };
+        }
+    }
+
+    Entry& entry = _entries[_current];
+    gpu::Size offset = (entry.used + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    entry.buffer->setSubData(offset, size, reinterpret_cast<const gpu::Byte*>(data));
+    entry.used = offset + size;
+    entry.updateCount = entry.buffer->getUpdateCount();
+    return { entry.buffer, offset };
+}
+
+size_t TransientBufferRing::getNumBuffers() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+bool TransientBufferRing::advance() {
+    // a buffer isn't written again right after the frame that took it, while that frame may still be drawn from it
+    if (_entries.size() > 1) {
+        size_t next = (_current + 1) % _entries.size();
+        if (isTaken(_entries[next])) {
+            _current = next;
+            _entries[_current].used = 0;
+            return true;
+        }
+    }
+
+    if (_entries.size() >= MAX_BUFFERS) {
+        return false;
+    }
+
+    Entry entry;
+    entry.buffer = std::make_shared<gpu::Buffer>();
+    entry.buffer->resize(BUFFER_SIZE);
+    entry.updateCount = entry.buffer->getUpdateCount();
+    _current = _entries.empty() ? 0 : _current + 1;
+    _entries.insert(_entries.begin() + _current, entry);
+    return true;
+}
@@ -0,0 +1,55 @@
+//
+//  TransientBufferRing.h
+//  libraries/render-utils/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_TransientBufferRing_h
+#define overte_TransientBufferRing_h
+
+#include <mutex>
+#include <vector>
+
+#include <gpu/Buffer.h>
+
+// A ring of large buffers that the geometry drawn only in the frame being recorded is written into one after the other,
+// instead of into small buffers of its own, so that a frame uploads the dirty pages of a buffer or two however many
+// immediate draws it has. A buffer is written again once a frame has taken its data, which stands in for a fence.
+class TransientBufferRing {
+public:
+    static const gpu::Size BUFFER_SIZE;
+    static const gpu::Size ALIGNMENT;
+    static const size_t MAX_BUFFERS;
+
+    struct Range {
+        gpu::BufferPointer buffer;
+        gpu::Offset offset { 0 };
+    };
+
+    // Copies the data into the current buffer, moving to the next buffer of the ring when a frame has taken the current
+    // one's data or it is full. Data larger than a buffer, or beyond a full ring, get a buffer of their own.
+    Range allocate(gpu::Size size, const void* data);
+
+    size_t getNumBuffers() const;
+
+private:
+    struct Entry {
+        gpu::BufferPointer buffer;
+        gpu::Size used { 0 };
+        size_t updateCount { 0 };   // the update count of the buffer when it was last written
+    };
+
+    static bool isTaken(const Entry& entry) { return entry.buffer->getUpdateCount() != entry.updateCount; }
+    bool advance();
+
+    mutable std::mutex _mutex;
+    std::vector<Entry> _entries;
+    size_t _current { 0 };
+};
+
+#endif // overte_TransientBufferRing_h
@@ -92,9 +92,12 @@
 #define RENDER_UTILS_BUFFER_SSAO_DEBUG_PARAMS 3
 #define RENDER_UTILS_BUFFER_SSAO_BLUR_PARAMS 4
 #define RENDER_UTILS_BUFFER_SSAO_FRAME_PARAMS 5
+#define RENDER_UTILS_BUFFER_SSAO_TEMPORAL_PARAMS 6
 #define RENDER_UTILS_TEXTURE_SSAO_DEPTH 1
 #define RENDER_UTILS_TEXTURE_SSAO_NORMAL 2
 #define RENDER_UTILS_TEXTURE_SSAO_OCCLUSION 0
+#define RENDER_UTILS_TEXTURE_SSAO_HISTORY 3
+#define RENDER_UTILS_TEXTURE_SSAO_VELOCITY 4
 
 // Temporal anti-aliasing
 #define RENDER_UTILS_BUFFER_TAA_PARAMS 2
@@ -152,6 +155,7 @@ enum Buffer {
     SsaoFrameParams = RENDER_UTILS_BUFFER_SSAO_FRAME_PARAMS,
     SsaoDebugParams = RENDER_UTILS_BUFFER_SSAO_DEBUG_PARAMS,
     SsaoBlurParams = RENDER_UTILS_BUFFER_SSAO_BLUR_PARAMS,
+    SsaoTemporalParams = RENDER_UTILS_BUFFER_SSAO_TEMPORAL_PARAMS,
     LightIndex = RENDER_UTILS_BUFFER_LIGHT_INDEX,
     TaaParams = RENDER_UTILS_BUFFER_TAA_PARAMS,
     HighlightParams = RENDER_UTILS_BUFFER_HIGHLIGHT_PARAMS,
@@ -192,6 +196,8 @@ enum Texture {
     SsaoOcclusion = RENDER_UTILS_TEXTURE_SSAO_OCCLUSION,
     SsaoDepth = RENDER_UTILS_TEXTURE_SSAO_DEPTH,
     SsaoNormal = RENDER_UTILS_TEXTURE_SSAO_NORMAL,
+    SsaoHistory = RENDER_UTILS_TEXTURE_SSAO_HISTORY,
+    SsaoVelocity = RENDER_UTILS_TEXTURE_SSAO_VELOCITY,
     HighlightSceneDepth = RENDER_UTILS_TEXTURE_HIGHLIGHT_SCENE_DEPTH,
     HighlightDepth = RENDER_UTILS_TEXTURE_HIGHLIGHT_DEPTH,
     SurfaceGeometryDepth = RENDER_UTILS_TEXTURE_SG_DEPTH,
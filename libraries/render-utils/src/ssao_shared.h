@@ -53,6 +53,10 @@ struct AmbientOcclusionBlurParams {
     SSAO_VEC4 _blurAxis;
 };
 
+struct AmbientOcclusionTemporalParams {
+    SSAO_VEC4 _temporalInfo;
+};
+
 #endif // RENDER_UTILS_SHADER_CONSTANTS_H
 
 // <@if 1@>
@@ -31,6 +31,8 @@ static std::mutex fontMutex;
 
 std::map<std::tuple<bool, bool, bool>, gpu::PipelinePointer> Font::_pipelines;
 gpu::Stream::FormatPointer Font::_format;
+gpu::BufferPointer Font::_indicesBuffer;
+uint32_t Font::_numIndexedQuads { 0 };
 
 struct TextureVertex {
     glm::vec2 pos;
@@ -43,6 +45,9 @@ struct TextureVertex {
 static const int NUMBER_OF_INDICES_PER_QUAD = 6;  // 1 quad = 2 triangles
 static const int VERTICES_PER_QUAD = 4;           // 1 quad = 4 vertices (must match value in sdf_text3D.slv)
 const float DOUBLE_MAX_OFFSET_PIXELS = 20.0f;     // must match value in sdf_text3D.slh
+static const uint32_t MAX_QUADS = 65536 / VERTICES_PER_QUAD; // the indices are 16 bits
+// the layouts that no string uses anymore are removed once there are this many
+static const size_t LAYOUT_CACHE_PRUNE_SIZE = 1024;
 
 struct QuadBuilder {
     TextureVertex vertices[VERTICES_PER_QUAD];
@@ -246,6 +251,7 @@ void Font::read(QIODevice& in) {
     }
 
     _glyphs.clear();
+    _layouts.clear();
     glm::vec2 imageSize = toGlm(image.size());
     foreach(Glyph g, glyphs) {
         // Adjust the pixel texture coordinates into UV coordinates,
@@ -313,6 +319,49 @@ void Font::setupGPU() {
     }
 }
 
+bool Font::LayoutKey::operator<(const LayoutKey& other) const {
+    return std::tie(string, origin.x, origin.y, bounds.x, bounds.y, scale, alignment, enlargeForShadows) <
+        std::tie(other.string, other.origin.x, other.origin.y, other.bounds.x, other.bounds.y, other.scale, other.alignment,
+                 other.enlargeForShadows);
+}
+
+void Font::updateIndices(uint32_t numQuads) {
+    if (!_indicesBuffer) {
+        _indicesBuffer = std::make_shared<gpu::Buffer>();
+    }
+    // The quads already indexed keep their indices, the batches in flight can still use them
+    numQuads = std::min(numQuads, MAX_QUADS);
+    for (; _numIndexedQuads < numQuads; _numIndexedQuads++) {
+        quint16 verticesOffset = _numIndexedQuads * VERTICES_PER_QUAD;
+
+        // Sam's recommended triangle slices
+        // Triangle tri1 = { v0, v1, v3 };
+        // Triangle tri2 = { v1, v2, v3 };
+        // NOTE: Random guy on the internet's recommended triangle slices
+        // Triangle tri1 = { v0, v1, v2 };
+        // Triangle tri2 = { v2, v3, v0 };
+
+        // The problem here being that the 4 vertices are { ll, lr, ul, ur }, a Z pattern
+        // Additionally, you want to ensure that the shared side vertices are used sequentially
+        // to improve cache locality
+        //
+        //  2 -- 3
+        //  |    |
+        //  |    |
+        //  0 -- 1
+        //
+        //  { 0, 1, 2 } -> { 2, 1, 3 }
+        quint16 indices[NUMBER_OF_INDICES_PER_QUAD];
+        indices[0] = verticesOffset + 0;
+        indices[1] = verticesOffset + 1;
+        indices[2] = verticesOffset + 2;
+        indices[3] = verticesOffset + 2;
+        indices[4] = verticesOffset + 1;
+        indices[5] = verticesOffset + 3;
+        _indicesBuffer->append(sizeof(indices), (const gpu::Byte*)indices);
+    }
+}
+
 inline QuadBuilder adjustedQuadBuilderForAlignmentMode(const Glyph& glyph, glm::vec2 advance, float scale, float enlargeForShadows,
                                                 TextAlignment alignment, float rightSpacing) {
     if (alignment == TextAlignment::RIGHT) {
@@ -325,14 +374,26 @@ inline QuadBuilder adjustedQuadBuilderForAlignmentMode(const Glyph& glyph, glm::
 
 void Font::buildVertices(Font::DrawInfo& drawInfo, const QString& str, const glm::vec2& origin, const glm::vec2& bounds, float scale, bool enlargeForShadows,
                          TextAlignment alignment) {
-    drawInfo.verticesBuffer = std::make_shared<gpu::Buffer>();
-    drawInfo.indicesBuffer = std::make_shared<gpu::Buffer>();
-    drawInfo.indexCount = 0;
-    int numVertices = 0;
-
     drawInfo.string = str;
     drawInfo.bounds = bounds;
     drawInfo.origin = origin;
+    drawInfo.scale = scale;
+    drawInfo.alignment = alignment;
+
+    // The scale only changes the layout with the shadow enlargement
+    LayoutKey key { str, origin, bounds, enlargeForShadows ? scale : 0.0f, alignment, enlargeForShadows };
+    auto cachedLayout = _layouts.find(key);
+    if (cachedLayout != _layouts.end()) {
+        auto verticesBuffer = cachedLayout->second.verticesBuffer.lock();
+        if (verticesBuffer) {
+            drawInfo.verticesBuffer = verticesBuffer;
+            drawInfo.indexCount = cachedLayout->second.indexCount;
+            return;
+        }
+    }
+
+    drawInfo.verticesBuffer = std::make_shared<gpu::Buffer>();
+    drawInfo.indexCount = 0;
 
     float enlargedBoundsX = bounds.x - 0.5f * DOUBLE_MAX_OFFSET_PIXELS * float(enlargeForShadows);
     float rightEdge = origin.x + enlargedBoundsX;
@@ -410,38 +471,22 @@ void Font::buildVertices(Font::DrawInfo& drawInfo, const QString& str, const glm
     }
 
     // The quadBuilders is backwards now because we looped over the glyphs backwards to adjust their alignment
-    for (int i = quadBuilders.size() - 1; i >= 0; i--) {
-        quint16 verticesOffset = numVertices;
+    uint32_t numQuads = std::min((uint32_t)quadBuilders.size(), MAX_QUADS);
+    for (int i = quadBuilders.size() - 1; i >= (int)(quadBuilders.size() - numQuads); i--) {
         drawInfo.verticesBuffer->append(quadBuilders[i]);
-        numVertices += VERTICES_PER_QUAD;
-
-        // Sam's recommended triangle slices
-        // Triangle tri1 = { v0, v1, v3 };
-        // Triangle tri2 = { v1, v2, v3 };
-        // NOTE: Random guy on the internet's recommended triangle slices
-        // Triangle tri1 = { v0, v1, v2 };
-        // Triangle tri2 = { v2, v3, v0 };
+    }
+    drawInfo.indexCount = numQuads * NUMBER_OF_INDICES_PER_QUAD;
 
-        // The problem here being that the 4 vertices are { ll, lr, ul, ur }, a Z pattern
-        // Additionally, you want to ensure that the shared side vertices are used sequentially
-        // to improve cache locality
-        //
-        //  2 -- 3
-        //  |    |
-        //  |    |
-        //  0 -- 1
-        //
-        //  { 0, 1, 2 } -> { 2, 1, 3 }
-        quint16 indices[NUMBER_OF_INDICES_PER_QUAD];
-        indices[0] = verticesOffset + 0;
-        indices[1] = verticesOffset + 1;
-        indices[2] = verticesOffset + 2;
-        indices[3] = verticesOffset + 2;
-        indices[4] = verticesOffset + 1;
-        indices[5] = verticesOffset + 3;
-        drawInfo.indicesBuffer->append(sizeof(indices), (const gpu::Byte*)indices);
-        drawInfo.indexCount += NUMBER_OF_INDICES_PER_QUAD;
+    if (_layouts.size() >= LAYOUT_CACHE_PRUNE_SIZE) {
+        for (auto it = _layouts.begin(); it != _layouts.end();) {
+            if (it->second.verticesBuffer.expired()) {
+                it = _layouts.erase(it);
+            } else {
+                ++it;
+            }
+        }
     }
+    _layouts[key] = { drawInfo.verticesBuffer, drawInfo.indexCount };
 }
 
 void Font::drawString(gpu::Batch& batch, Font::DrawInfo& drawInfo, const QString& str, const glm::vec4& color,
@@ -455,15 +500,16 @@ void Font::drawString(gpu::Batch& batch, Font::DrawInfo& drawInfo, const QString
     const int SHADOW_EFFECT = (int)TextEffect::SHADOW_EFFECT;
 
     // If we're switching to or from shadow effect mode, we need to rebuild the vertices
-    if (str != drawInfo.string || bounds != drawInfo.bounds || origin != drawInfo.origin || alignment != _alignment ||
+    // The alignment and scale are kept per string, the texts that alternate between them don't rebuild each other's vertices
+    if (!drawInfo.verticesBuffer || str != drawInfo.string || bounds != drawInfo.bounds || origin != drawInfo.origin ||
+            alignment != drawInfo.alignment ||
             (drawInfo.params.effect != textEffect && (textEffect == SHADOW_EFFECT || drawInfo.params.effect == SHADOW_EFFECT)) ||
-            (textEffect == SHADOW_EFFECT && scale != _scale)) {
-        _scale = scale;
-        _alignment = alignment;
+            (textEffect == SHADOW_EFFECT && scale != drawInfo.scale)) {
         buildVertices(drawInfo, str, origin, bounds, scale, textEffect == SHADOW_EFFECT, alignment);
     }
 
     setupGPU();
+    updateIndices(drawInfo.indexCount / NUMBER_OF_INDICES_PER_QUAD);
 
     if (!drawInfo.paramsBuffer || drawInfo.params.color != color || drawInfo.params.effectColor != effectColor ||
             drawInfo.params.effectThickness != effectThickness || drawInfo.params.effect != textEffect) {
@@ -489,6 +535,6 @@ void Font::drawString(gpu::Batch& batch, Font::DrawInfo& drawInfo, const QString
     batch.setInputBuffer(0, drawInfo.verticesBuffer, 0, _format->getChannels().at(0)._stride);
     batch.setResourceTexture(render_utils::slot::texture::TextFont, _texture);
     batch.setUniformBuffer(0, drawInfo.paramsBuffer, 0, sizeof(DrawParams));
-    batch.setIndexBuffer(gpu::UINT16, drawInfo.indicesBuffer, 0);
+    batch.setIndexBuffer(gpu::UINT16, _indicesBuffer, 0);
     batch.drawIndexed(gpu::TRIANGLES, drawInfo.indexCount, 0);
 }
@@ -43,14 +43,16 @@ public:
     };
 
     struct DrawInfo {
+        // shared with the other strings that have the same layout, see buildVertices
         gpu::BufferPointer verticesBuffer { nullptr };
-        gpu::BufferPointer indicesBuffer { nullptr };
         gpu::BufferPointer paramsBuffer { nullptr };
-        uint32_t indexCount;
+        uint32_t indexCount { 0 };
 
         QString string;
         glm::vec2 origin;
         glm::vec2 bounds;
+        float scale { 0.0f };
+        TextAlignment alignment { TextAlignment::LEFT };
         DrawParams params;
     };
 
@@ -81,6 +83,25 @@ private:
                        TextAlignment alignment);
 
     void setupGPU();
+    static void updateIndices(uint32_t numQuads);
+
+    // The glyph vertices of a layout, a string laid out with the same origin, bounds, alignment and shadow enlargement,
+    // kept while one of the DrawInfos uses them so that the texts with the same layout share their vertices
+    struct LayoutKey {
+        QString string;
+        glm::vec2 origin;
+        glm::vec2 bounds;
+        float scale;
+        TextAlignment alignment;
+        bool enlargeForShadows;
+
+        bool operator<(const LayoutKey& other) const;
+    };
+    struct CachedLayout {
+        std::weak_ptr<gpu::Buffer> verticesBuffer;
+        uint32_t indexCount;
+    };
+    std::map<LayoutKey, CachedLayout> _layouts;
 
     // maps characters to cached glyph info
     // HACK... the operator[] const for QHash returns a
@@ -97,9 +118,6 @@ private:
     float _descent { 0.0f };
     float _spaceWidth { 0.0f };
 
-    float _scale { 0.0f };
-    TextAlignment _alignment;
-
     bool _loaded { true };
 
     gpu::TexturePointer _texture;
@@ -107,6 +125,9 @@ private:
 
     static std::map<std::tuple<bool, bool, bool>, gpu::PipelinePointer> _pipelines;
     static gpu::Stream::FormatPointer _format;
+    // all the quads are indexed the same way, so the strings of all the fonts share one index buffer
+    static gpu::BufferPointer _indicesBuffer;
+    static uint32_t _numIndexedQuads;
 };
 
 #endif
@@ -43,6 +43,7 @@ namespace render {
 
         int _materialSwitches = 0;
         int _trianglesRendered = 0;
+        int _drawcallsSavedByInstancing = 0;
 
         Item _item;
         Item _shadow;
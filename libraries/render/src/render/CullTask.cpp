@@ -14,19 +14,26 @@
 #include <algorithm>
 #include <assert.h>
 
+#include <tbb/parallel_for.h>
+
 #include <PerfStat.h>
 #include <OctreeUtils.h>
 
 using namespace render;
 
+// items culled by one task, enough to amortize the task over the cheap per item tests
+static const size_t CULL_CHUNK_SIZE = 256;
+
 std::unordered_set<QUuid> CullTest::_containingZones = std::unordered_set<QUuid>();
 std::unordered_set<QUuid> CullTest::_prevContainingZones = std::unordered_set<QUuid>();
 
-CullTest::CullTest(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails, ViewFrustumPointer antiFrustum) :
+CullTest::CullTest(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails, ViewFrustumPointer antiFrustum,
+                   ViewFrustumPointer frustum) :
     _functor(functor),
     _args(pargs),
     _renderDetails(renderDetails),
-    _antiFrustum(antiFrustum) {
+    _antiFrustum(antiFrustum),
+    _frustum(frustum) {
     // FIXME: Keep this code here even though we don't use it yet
     /*_eyePos = _args->getViewFrustum().getPosition();
     float a = glm::degrees(Octree::getPerspectiveAccuracyAngle(_args->_sizeScale, _args->_boundaryLevelAdjust));
@@ -38,7 +45,8 @@ CullTest::CullTest(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item&
 }
 
 bool CullTest::frustumTest(const AABox& bound) {
-    if (!_args->getViewFrustum().boxIntersectsFrustum(bound)) {
+    const ViewFrustum& frustum = _frustum ? *_frustum : _args->getViewFrustum();
+    if (!frustum.boxIntersectsFrustum(bound)) {
         _renderDetails._outOfView++;
         return false;
     }
@@ -170,8 +178,6 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         args->pushViewFrustum(_frozenFrustum); // replace the true view frustum by the frozen one
     }
 
-    CullTest test(_cullFunctor, args, details);
-
     // Now we have a selection of items to render
     outItems.clear();
     outItems.reserve(inSelection.numItems());
@@ -180,138 +186,65 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
     if (!srcFilter.selectsNothing()) {
         auto filter = render::ItemFilter::Builder(srcFilter).withoutSubMetaCulled().build();
 
-        // Now get the bound, and
-        // filter individually against the _filter
-        // visibility cull if partially selected ( octree cell contianing it was partial)
-        // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
-        if (_skipCulling || _overrideSkipCulling) {
-            // inside & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // inside & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // partial & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
+        // Cull the items of one part of the selection in chunks, in parallel, appending the chunks in selection order
+        auto cullItems = [&](const ItemIDs& ids, bool testFrustum, bool testSolidAngle) {
+            const size_t numChunks = (ids.size() + CULL_CHUNK_SIZE - 1) / CULL_CHUNK_SIZE;
+            std::vector<ItemBounds> chunkItems(numChunks);
+            std::vector<RenderDetails::Item> chunkDetails(numChunks);
+            tbb::parallel_for((size_t)0, numChunks, [&](size_t chunk) {
+                CullTest test(_cullFunctor, args, chunkDetails[chunk]);
+                auto& items = chunkItems[chunk];
+                size_t end = std::min(ids.size(), (chunk + 1) * CULL_CHUNK_SIZE);
+                for (size_t i = chunk * CULL_CHUNK_SIZE; i < end; ++i) {
+                    auto id = ids[i];
                     auto& item = scene->getItem(id);
                     if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
                         ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // partial & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
+                        if ((!testFrustum || test.frustumTest(itemBound.bound)) &&
+                            (!testSolidAngle || test.solidAngleTest(itemBound.bound))) {
+                            items.emplace_back(itemBound);
+                            if (item.getKey().isMetaCullGroup()) {
+                                item.fetchMetaSubItemBounds(items, (*scene), args);
+                            }
                         }
                     }
                 }
+            });
+            for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+                outItems.insert(outItems.end(), chunkItems[chunk].begin(), chunkItems[chunk].end());
+                details._outOfView += chunkDetails[chunk]._outOfView;
+                details._tooSmall += chunkDetails[chunk]._tooSmall;
             }
+        };
 
-        } else {
+        // Now get the bound, and
+        // filter individually against the _filter
+        // visibility cull if partially selected ( octree cell contianing it was partial)
+        // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
+        bool cull = !(_skipCulling || _overrideSkipCulling);
 
-            // inside & fit items: easy, just filter
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
+        // inside & fit items: easy, just filter
+        {
+            PerformanceTimer perfTimer("insideFitItems");
+            cullItems(inSelection.insideItems, false, false);
+        }
 
-            // inside & subcell items: filter & distance cull
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
+        // inside & subcell items: filter & distance cull
+        {
+            PerformanceTimer perfTimer("insideSmallItems");
+            cullItems(inSelection.insideSubcellItems, false, cull);
+        }
 
-            // partial & fit items: filter & frustum cull
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.frustumTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
+        // partial & fit items: filter & frustum cull
+        {
+            PerformanceTimer perfTimer("partialFitItems");
+            cullItems(inSelection.partialItems, cull, false);
+        }
 
-            // partial & subcell items:: filter & frutum cull & solidangle cull
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.frustumTest(itemBound.bound) && test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
+        // partial & subcell items:: filter & frutum cull & solidangle cull
+        {
+            PerformanceTimer perfTimer("partialSmallItems");
+            cullItems(inSelection.partialSubcellItems, cull, cull);
         }
     }
 
@@ -325,6 +258,47 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
     std::static_pointer_cast<Config>(renderContext->jobConfig)->numItems = (int)outItems.size();
 }
 
+void CullOccludedItems::configure(const Config& config) {
+    _skipOcclusion = config.skipOcclusion;
+}
+
+void CullOccludedItems::run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+    RenderArgs* args = renderContext->args;
+    auto& scene = renderContext->_scene;
+
+    outItems.clear();
+    _occlusionBuffer.clear(args->getViewFrustum());
+    if (!_skipOcclusion && _occlusionBuffer.isEnabled()) {
+        PerformanceTimer perfTimer("rasterizeOccluders");
+        for (auto& itemBound : inItems) {
+            AABox occluder;
+            if (scene->getItem(itemBound.id).getOccluder(occluder)) {
+                _occlusionBuffer.addOccluder(occluder);
+            }
+        }
+    }
+
+    if (_occlusionBuffer.getNumOccluders() == 0) {
+        outItems = inItems;
+    } else {
+        PerformanceTimer perfTimer("testOccludees");
+        outItems.reserve(inItems.size());
+        for (auto& itemBound : inItems) {
+            // only shapes are dropped, lights and meta items act beyond what they draw
+            if (scene->getItem(itemBound.id).getKey().isShape() && _occlusionBuffer.isOccluded(itemBound.bound)) {
+                continue;
+            }
+            outItems.emplace_back(itemBound);
+        }
+    }
+
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
+    config->numOccluders = _occlusionBuffer.getNumOccluders();
+    config->numOccluded = (int)(inItems.size() - outItems.size());
+}
+
 void CullShapeBounds::run(const RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -13,6 +13,7 @@
 #define hifi_render_CullTask_h
 
 #include "Engine.h"
+#include "OcclusionBuffer.h"
 #include "ViewFrustum.h"
 
 namespace render {
@@ -25,10 +26,13 @@ namespace render {
         RenderArgs* _args;
         RenderDetails::Item& _renderDetails;
         ViewFrustumPointer _antiFrustum;
+        ViewFrustumPointer _frustum;
         glm::vec3 _eyePos;
         float _squareTanAlpha;
 
-        CullTest(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails, ViewFrustumPointer antiFrustum = nullptr);
+        // The frustum test uses frustum if one is given, the view frustum of the args otherwise
+        CullTest(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails, ViewFrustumPointer antiFrustum = nullptr,
+            ViewFrustumPointer frustum = nullptr);
 
         bool frustumTest(const AABox& bound);
         bool antiFrustumTest(const AABox& bound);
@@ -121,6 +125,39 @@ namespace render {
         void run(const RenderContextPointer& renderContext, const Inputs& inputs, ItemBounds& outItems);
     };
 
+    class CullOccludedItemsConfig : public Job::Config {
+        Q_OBJECT
+        Q_PROPERTY(int numOccluders READ getNumOccluders)
+        Q_PROPERTY(int numOccluded READ getNumOccluded)
+        Q_PROPERTY(bool skipOcclusion MEMBER skipOcclusion WRITE setSkipOcclusion)
+    public:
+        int numOccluders{ 0 };
+        int numOccluded{ 0 };
+        int getNumOccluders() { return numOccluders; }
+        int getNumOccluded() { return numOccluded; }
+
+        bool skipOcclusion{ false };
+    public slots:
+        void setSkipOcclusion(bool enabled) { skipOcclusion = enabled; emit dirty(); }
+    signals:
+        void dirty();
+    };
+
+    // Drops the shapes hidden behind the occluders among the culled items, tested against a coarse depth buffer of
+    // the occluders rasterized on the cpu
+    class CullOccludedItems {
+    public:
+        using Config = CullOccludedItemsConfig;
+        using JobModel = Job::ModelIO<CullOccludedItems, ItemBounds, ItemBounds, Config>;
+
+        void configure(const Config& config);
+        void run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems);
+
+    private:
+        OcclusionBuffer _occlusionBuffer;
+        bool _skipOcclusion { false };
+    };
+
     class CullShapeBounds {
     public:
         using Inputs = render::VaryingSet4<ShapeBounds, ItemFilter, ItemFilter, ViewFrustumPointer>;
@@ -91,7 +91,8 @@ void render::renderStateSortShapes(const RenderContextPointer& renderContext,
     }
 
     using SortedPipelines = std::vector<render::ShapeKey>;
-    using SortedShapes = std::unordered_map<render::ShapeKey, std::vector<Item>, render::ShapeKey::Hash, render::ShapeKey::KeyEqual>;
+    using MaterialSortedItem = std::pair<size_t, Item>;
+    using SortedShapes = std::unordered_map<render::ShapeKey, std::vector<MaterialSortedItem>, render::ShapeKey::Hash, render::ShapeKey::KeyEqual>;
     SortedPipelines sortedPipelines;
     SortedShapes sortedShapes;
     std::vector< std::tuple<Item,ShapeKey> > ownPipelineBucket;
@@ -106,7 +107,7 @@ void render::renderStateSortShapes(const RenderContextPointer& renderContext,
                 if (bucket.empty()) {
                     sortedPipelines.push_back(key);
                 }
-                bucket.push_back(item);
+                bucket.emplace_back(item.getMaterialSortKey(), item);
             } else if (key.hasOwnPipeline()) {
                 ownPipelineBucket.push_back( std::make_tuple(item, key) );
             } else {
@@ -125,7 +126,14 @@ void render::renderStateSortShapes(const RenderContextPointer& renderContext,
             continue;
         }
         args->_itemShapeKey = pipelineKey._flags.to_ulong();
-        for (auto& item : bucket) {
+
+        // the items with the same material follow each other, in their depth order, so that its bindings are only
+        // changed once
+        std::stable_sort(bucket.begin(), bucket.end(), [](const MaterialSortedItem& a, const MaterialSortedItem& b) {
+            return a.first < b.first;
+        });
+        for (auto& materialAndItem : bucket) {
+            auto& item = materialAndItem.second;
             args->_shapePipeline->prepareShapeItem(args, pipelineKey, item);
             item.render(args);
         }
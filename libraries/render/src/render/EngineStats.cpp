@@ -47,6 +47,7 @@ void EngineStats::run(const RenderContextPointer& renderContext) {
     config->texturePendingGPUTransferSize = gpu::Context::getTexturePendingGPUTransferMemSize();
 
     config->textureResourcePopulatedGPUMemSize = gpu::Context::getTextureResourcePopulatedGPUMemSize();
+    config->textureResourceUnderDetailedCount = gpu::Context::getTextureResourceUnderDetailedCount();
 
     renderContext->args->_context->getFrameStats(_gpuStats);
 
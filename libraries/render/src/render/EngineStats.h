@@ -46,6 +46,7 @@ namespace render {
         Q_PROPERTY(quint32 texturePendingGPUTransferCount MEMBER texturePendingGPUTransferCount NOTIFY newStats)
         Q_PROPERTY(qint64 texturePendingGPUTransferSize MEMBER texturePendingGPUTransferSize NOTIFY newStats)
         Q_PROPERTY(qint64 textureResourcePopulatedGPUMemSize MEMBER textureResourcePopulatedGPUMemSize NOTIFY newStats)
+        Q_PROPERTY(quint32 textureResourceUnderDetailedCount MEMBER textureResourceUnderDetailedCount NOTIFY newStats)
 
         Q_PROPERTY(quint32 frameAPIDrawcallCount MEMBER frameAPIDrawcallCount NOTIFY newStats)
         Q_PROPERTY(quint32 frameDrawcallCount MEMBER frameDrawcallCount NOTIFY newStats)
@@ -86,6 +87,7 @@ namespace render {
         qint64 textureExternalGPUMemSize { 0 };
         qint64 texturePendingGPUTransferSize { 0 };
         qint64 textureResourcePopulatedGPUMemSize { 0 };
+        quint32 textureResourceUnderDetailedCount { 0 };
 
         quint32 frameAPIDrawcallCount{ 0 };
         quint32 frameDrawcallCount{ 0 };
@@ -78,6 +78,7 @@ void Item::update(const UpdateFunctorPointer& updateFunctor) {
         _payload->update(updateFunctor);
     }
     _key = _payload->getKey();
+    _shapeKey = evalShapeKey();
 }
 
 void Item::resetPayload(const PayloadPointer& payload) {
@@ -86,10 +87,15 @@ void Item::resetPayload(const PayloadPointer& payload) {
     } else {
         _payload = payload;
         _key = _payload->getKey();
+        _shapeKey = evalShapeKey();
     }
 }
 
-const ShapeKey Item::getShapeKey() const {
+ShapeKey Item::evalShapeKey() const {
+    if (!_payload) {
+        return ShapeKey();
+    }
+
     auto shapeKey = _payload->getShapeKey();
     if (!TransitionStage::isIndexInvalid(_transitionId)) {
         // Objects that are fading are rendered double-sided to give a sense of volume
@@ -168,4 +174,18 @@ namespace render {
         }
         return payload->getOutlineStyle(viewFrustum, height);
     }
+
+    template <> bool payloadGetOccluder(const PayloadProxyInterface::Pointer& payload, AABox& occluder) {
+        if (!payload) {
+            return false;
+        }
+        return payload->getOccluder(occluder);
+    }
+
+    template <> size_t payloadGetMaterialSortKey(const PayloadProxyInterface::Pointer& payload) {
+        if (!payload) {
+            return 0;
+        }
+        return payload->getMaterialSortKey();
+    }
 }
\ No newline at end of file
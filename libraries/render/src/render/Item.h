@@ -454,6 +454,10 @@ public:
 
         virtual HighlightStyle getOutlineStyle(const ViewFrustum& viewFrustum, const size_t height) const = 0;
 
+        virtual bool getOccluder(AABox& occluder) const = 0;
+
+        virtual size_t getMaterialSortKey() const = 0;
+
         ~PayloadInterface() {}
 
         // Status interface is local to the base class
@@ -498,8 +502,8 @@ public:
     // Render call for the item
     void render(RenderArgs* args) const { _payload->render(args); }
 
-    // Shape Type Interface
-    const ShapeKey getShapeKey() const;
+    // Shape Type Interface, the key is cached when the item is reset or updated so that the sorts don't ask the payload
+    const ShapeKey& getShapeKey() const { return _shapeKey; }
 
     // Meta Type Interface
     uint32_t fetchMetaSubItems(ItemIDs& subItems) const { return _payload->fetchMetaSubItems(subItems); }
@@ -509,15 +513,24 @@ public:
 
     HighlightStyle getOutlineStyle(const ViewFrustum& viewFrustum, const size_t height) const { return _payload->getOutlineStyle(viewFrustum, height); }
 
+    // Occluder Interface
+    bool getOccluder(AABox& occluder) const { return _payload->getOccluder(occluder); }
+
+    // Material Sort Interface
+    size_t getMaterialSortKey() const { return _payload->getMaterialSortKey(); }
+
     // Access the status
     const StatusPointer& getStatus() const { return _payload->getStatus(); }
 
-    void setTransitionId(Index id) { _transitionId = id; }
+    void setTransitionId(Index id) { _transitionId = id; _shapeKey = evalShapeKey(); }
     Index getTransitionId() const { return _transitionId; }
 
 protected:
+    ShapeKey evalShapeKey() const;
+
     PayloadPointer _payload;
     ItemKey _key;
+    ShapeKey _shapeKey;
     ItemCell _cell { INVALID_CELL };
     Index _transitionId { INVALID_INDEX };
 
@@ -569,6 +582,14 @@ template <class T> HighlightStyle payloadGetOutlineStyle(const std::shared_ptr<T
     return HighlightStyle();
 }
 
+// Occluder Interface
+// Allows payloads to provide a box within their solid geometry, which hides the items behind it
+template <class T> bool payloadGetOccluder(const std::shared_ptr<T>& payloadData, AABox& occluder) { return false; }
+
+// Material Sort Interface
+// Allows payloads drawn with the same material bindings to be drawn one after the other, see renderStateSortShapes
+template <class T> size_t payloadGetMaterialSortKey(const std::shared_ptr<T>& payloadData) { return 0; }
+
 // THe Payload class is the real Payload to be used
 // THis allow anything to be turned into a Payload as long as the required interface functions are available
 // When creating a new kind of payload from a new "stuff" class then you need to create specialized version for "stuff"
@@ -597,6 +618,10 @@ public:
 
     virtual HighlightStyle getOutlineStyle(const ViewFrustum& viewFrustum, const size_t height) const override { return payloadGetOutlineStyle<T>(_data, viewFrustum, height); }
 
+    virtual bool getOccluder(AABox& occluder) const override { return payloadGetOccluder<T>(_data, occluder); }
+
+    virtual size_t getMaterialSortKey() const override { return payloadGetMaterialSortKey<T>(_data); }
+
 protected:
     DataPointer _data;
 
@@ -653,6 +678,8 @@ public:
     virtual uint32_t metaFetchMetaSubItems(ItemIDs& subItems) const = 0;
     virtual bool passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const = 0;
     virtual HighlightStyle getOutlineStyle(const ViewFrustum& viewFrustum, const size_t height) const = 0;
+    virtual bool getOccluder(AABox& occluder) const { return false; }
+    virtual size_t getMaterialSortKey() const { return 0; }
 
     // FIXME: this isn't the best place for this since it's only used for ModelEntities, but currently all Entities use PayloadProxyInterface
     virtual void handleBlendedVertices(int blendshapeNumber, const QVector<BlendshapeOffset>& blendshapeOffsets,
@@ -666,6 +693,8 @@ template <> uint32_t metaFetchMetaSubItems(const PayloadProxyInterface::Pointer&
 template <> const ShapeKey shapeGetShapeKey(const PayloadProxyInterface::Pointer& payload);
 template <> bool payloadPassesZoneOcclusionTest(const PayloadProxyInterface::Pointer& payload, const std::unordered_set<QUuid>& containingZones);
 template <> HighlightStyle payloadGetOutlineStyle(const PayloadProxyInterface::Pointer& payload, const ViewFrustum& viewFrustum, const size_t height);
+template <> bool payloadGetOccluder(const PayloadProxyInterface::Pointer& payload, AABox& occluder);
+template <> size_t payloadGetMaterialSortKey(const PayloadProxyInterface::Pointer& payload);
 
 typedef Item::PayloadPointer PayloadPointer;
 typedef std::vector<PayloadPointer> Payloads;
@@ -13,31 +13,32 @@
 #include "ShapePipeline.h"
 
 #include <assert.h>
+#include <string.h>
+
+#include <Radix2InplaceSort.h>
+#include <Radix2IntegerScanner.h>
 #include <ViewFrustum.h>
 
 using namespace render;
 
-struct ItemBoundSort {
-    float _centerDepth = 0.0f;
-    float _nearDepth = 0.0f;
-    float _farDepth = 0.0f;
-    ItemID _id = 0;
-    AABox _bounds;
+// The depths are sorted as integers: the bits of a positive float are in the same order as the float, and the opaque
+// items only need to be roughly front to back so the low bits of their depths are dropped
+static const int OPAQUE_DEPTH_KEY_BITS = 16;
+static const int DEPTH_KEY_BITS = 32;
 
-    ItemBoundSort() {}
-    ItemBoundSort(float centerDepth, float nearDepth, float farDepth, ItemID id, const AABox& bounds) : _centerDepth(centerDepth), _nearDepth(nearDepth), _farDepth(farDepth), _id(id), _bounds(bounds) {}
-};
+struct ItemDepthSort {
+    uint32_t _depthKey = 0;
+    uint32_t _index = 0;
 
-struct FrontToBackSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth < right._centerDepth);
-    }
+    ItemDepthSort() {}
+    ItemDepthSort(uint32_t depthKey, uint32_t index) : _depthKey(depthKey), _index(index) {}
 };
 
-struct BackToFrontSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth > right._centerDepth);
-    }
+class ItemDepthScanner : public Radix2IntegerScanner<uint32_t> {
+public:
+    explicit ItemDepthScanner(int bits) : Radix2IntegerScanner<uint32_t>(bits) {}
+
+    bool bit(const ItemDepthSort& item, const state_type& s) const { return Radix2IntegerScanner<uint32_t>::bit(item._depthKey, s); }
 };
 
 void render::depthSortItems(const RenderContextPointer& renderContext, bool frontToBack, 
@@ -45,82 +46,96 @@ void render::depthSortItems(const RenderContextPointer& renderContext, bool fron
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
-    auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
 
-
     // Allocate and simply copy
     outItems.clear();
     outItems.reserve(inItems.size());
 
-
-    // Make a local dataset of the center distance and closest point distance
-    std::vector<ItemBoundSort> itemBoundSorts;
-    itemBoundSorts.reserve(outItems.size());
-
-    for (auto itemDetails : inItems) {
-        auto item = scene->getItem(itemDetails.id);
-        auto bound = itemDetails.bound; // item.getBound(args);
-        float distanceSquared = args->getViewFrustum().distanceToCameraSquared(bound.calcCenter());
-
-        itemBoundSorts.emplace_back(ItemBoundSort(distanceSquared, distanceSquared, distanceSquared, itemDetails.id, bound));
+    // Make a local dataset of the center distances, which is kept from one call to the next to not allocate it every frame
+    static thread_local std::vector<ItemDepthSort> itemDepthSorts;
+    itemDepthSorts.clear();
+    itemDepthSorts.reserve(inItems.size());
+
+    const int depthKeyBits = frontToBack ? OPAQUE_DEPTH_KEY_BITS : DEPTH_KEY_BITS;
+    const int depthKeyShift = DEPTH_KEY_BITS - depthKeyBits;
+    const auto& viewFrustum = args->getViewFrustum();
+    for (uint32_t i = 0; i < (uint32_t)inItems.size(); i++) {
+        float distanceSquared = viewFrustum.distanceToCameraSquared(inItems[i].bound.calcCenter());
+        uint32_t depthKey;
+        memcpy(&depthKey, &distanceSquared, sizeof(depthKey));
+        depthKey >>= depthKeyShift;
+        if (!frontToBack) {
+            depthKey = ~depthKey;
+        }
+        itemDepthSorts.emplace_back(depthKey, i);
     }
 
     // sort against Z
-    if (frontToBack) {
-        FrontToBackSort frontToBackSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), frontToBackSort);
-    } else {
-        BackToFrontSort  backToFrontSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), backToFrontSort);
-    }
+    radix2InplaceSort(itemDepthSorts.begin(), itemDepthSorts.end(), ItemDepthScanner(depthKeyBits));
 
     // Finally once sorted result to a list of itemID and keep uniques
     render::ItemID previousID = Item::INVALID_ITEM_ID;
     if (!bounds) {
-        for (auto& item : itemBoundSorts) {
-            if (item._id != previousID) {
-                outItems.emplace_back(ItemBound(item._id, item._bounds));
-                previousID = item._id;
+        for (auto& itemDepthSort : itemDepthSorts) {
+            const auto& item = inItems[itemDepthSort._index];
+            if (item.id != previousID) {
+                outItems.emplace_back(item);
+                previousID = item.id;
             }
         }
-    } else if (!itemBoundSorts.empty()) {
+    } else if (!itemDepthSorts.empty()) {
         if (bounds->isNull()) {
-            *bounds = itemBoundSorts.front()._bounds;
+            *bounds = inItems[itemDepthSorts.front()._index].bound;
         }
-        for (auto& item : itemBoundSorts) {
-            if (item._id != previousID) {
-                outItems.emplace_back(ItemBound(item._id, item._bounds));
-                previousID = item._id;
-                *bounds += item._bounds;
+        for (auto& itemDepthSort : itemDepthSorts) {
+            const auto& item = inItems[itemDepthSort._index];
+            if (item.id != previousID) {
+                outItems.emplace_back(item);
+                previousID = item.id;
+                *bounds += item.bound;
             }
         }
     }
 }
 
+// The buckets of the last frame are kept with their capacity, since the same shapes are usually seen from one frame to
+// the next, and the ones that are left empty are dropped
+static void clearShapes(ShapeBounds& shapes) {
+    for (auto& items : shapes) {
+        items.second.clear();
+    }
+}
+
+static void eraseEmptyShapes(ShapeBounds& shapes) {
+    for (auto items = shapes.begin(); items != shapes.end();) {
+        if (items->second.empty()) {
+            items = shapes.erase(items);
+        } else {
+            ++items;
+        }
+    }
+}
+
 void PipelineSortShapes::run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ShapeBounds& outShapes) {
     auto& scene = renderContext->_scene;
-    outShapes.clear();
+    clearShapes(outShapes);
 
     for (const auto& item : inItems) {
-        auto key = scene->getItem(item.id).getShapeKey();
+        const auto& key = scene->getItem(item.id).getShapeKey();
         auto outItems = outShapes.find(key);
         if (outItems == outShapes.end()) {
             outItems = outShapes.insert(std::make_pair(key, ItemBounds{})).first;
-            outItems->second.reserve(inItems.size());
         }
 
         outItems->second.push_back(item);
     }
 
-    for (auto& items : outShapes) {
-        items.second.shrink_to_fit();
-    }
+    eraseEmptyShapes(outShapes);
 }
 
 void DepthSortShapes::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, ShapeBounds& outShapes) {
-    outShapes.clear();
-    outShapes.reserve(inShapes.size());
+    clearShapes(outShapes);
 
     for (auto& pipeline : inShapes) {
         auto& inItems = pipeline.second;
@@ -131,14 +146,14 @@ void DepthSortShapes::run(const RenderContextPointer& renderContext, const Shape
 
         depthSortItems(renderContext, _frontToBack, inItems, outItems->second);
     }
+    eraseEmptyShapes(outShapes);
 }
 
 void DepthSortShapesAndComputeBounds::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, Outputs& outputs) {
     auto& outShapes = outputs.edit0();
     auto& outBounds = outputs.edit1();
 
-    outShapes.clear();
-    outShapes.reserve(inShapes.size());
+    clearShapes(outShapes);
     outBounds = AABox();
 
     for (auto& pipeline : inShapes) {
@@ -152,6 +167,7 @@ void DepthSortShapesAndComputeBounds::run(const RenderContextPointer& renderCont
         depthSortItems(renderContext, _frontToBack, inItems, outItems->second, &bounds);
         outBounds += bounds;
     }
+    eraseEmptyShapes(outShapes);
 }
 
 void DepthSortItems::run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems) {
@@ -371,11 +371,26 @@ void AssetScriptingInterface::resolveAsset(const ScriptValue& options, const Scr
     jsPromiseReady(getAssetInfo(asset), scope, callback);
 }
 
+namespace {
+    // The data of the options of a call, the script's ArrayBuffer is taken over rather than copied if it asked to transfer it
+    QByteArray getOptionsData(const ScriptValue& options, const ScriptValue& data) {
+        if (data.isString()) {
+            return data.toString().toUtf8();
+        }
+        if (options.isObject() && options.property("transfer").toBool() && data.engine()) {
+            return data.engine()->transferArrayBuffer(data);
+        }
+        return scriptvalue_cast<QByteArray>(data);
+    }
+}
+
 /*@jsdoc
  * Content and decompression options for {@link Assets.decompressData}.
  * @typedef {object} Assets.DecompressOptions
  * @property {ArrayBuffer} data - The data to decompress.
  * @property {Assets.ResponseType} [responseType=text] - The type of decompressed data to return.
+ * @property {boolean} [transfer=false] - <code>true</code> to hand the <code>data</code> ArrayBuffer over rather than have it 
+ *     copied. The ArrayBuffer is empty afterwards.
  */
 /*@jsdoc
  * Result value returned by {@link Assets.decompressData}.
@@ -388,7 +403,7 @@ void AssetScriptingInterface::resolveAsset(const ScriptValue& options, const Scr
  */
 void AssetScriptingInterface::decompressData(const ScriptValue& options, const ScriptValue& scope, const ScriptValue& callback) {
     auto data = options.property("data");
-    QByteArray dataByteArray = scriptvalue_cast<QByteArray>(data);
+    QByteArray dataByteArray = data.isString() ? scriptvalue_cast<QByteArray>(data) : getOptionsData(options, data);
     auto responseType = options.property("responseType").toString().toLower();
     if (responseType.isEmpty()) {
         responseType = "text";
@@ -418,6 +433,8 @@ namespace {
  * @property {number} level - The compression level, range <code>-1</code> &ndash; <code>9</code>. <code>-1</code> means 
  *     use the default gzip compression level, <code>0</code> means no compression, and <code>9</code> means maximum 
  *     compression.
+ * @property {boolean} [transfer=false] - <code>true</code> to hand the <code>data</code> ArrayBuffer over rather than have it 
+ *     copied. The ArrayBuffer is empty afterwards.
  */
 /*@jsdoc
  * Result value returned by {@link Assets.compressData}.
@@ -429,7 +446,7 @@ namespace {
  */
 void AssetScriptingInterface::compressData(const ScriptValue& options, const ScriptValue& scope, const ScriptValue& callback) {
     auto data = options.property("data").isValid() ? options.property("data") : options;
-    QByteArray dataByteArray = data.isString() ? data.toString().toUtf8() : scriptvalue_cast<QByteArray>(data);
+    QByteArray dataByteArray = getOptionsData(options, data);
     int level = options.property("level").isNumber() ? options.property("level").toInt32() : DEFAULT_GZIP_COMPRESSION_LEVEL;
     JS_VERIFY(level >= DEFAULT_GZIP_COMPRESSION_LEVEL || level <= MAX_GZIP_COMPRESSION_LEVEL, QString("invalid .level %1").arg(level));
     jsPromiseReady(compressBytes(dataByteArray, level), scope, callback);
@@ -445,6 +462,8 @@ void AssetScriptingInterface::compressData(const ScriptValue& options, const Scr
  *     <code>"atp:"</code>. If not specified, no path-to-hash mapping is set.
  *     <p>Note: The asset server destroys any unmapped SHA256-named file at server restart. Either set the mapping path 
  *     with this property or use {@link Assets.setMapping} to set a path-to-hash mapping for the uploaded file.</p>
+ * @property {boolean} [transfer=false] - <code>true</code> to hand the <code>data</code> ArrayBuffer over rather than have it 
+ *     copied. The ArrayBuffer is empty afterwards.
  */
 /*@jsdoc
  * Result value returned by {@link Assets.putAsset}.
@@ -462,7 +481,7 @@ void AssetScriptingInterface::putAsset(const ScriptValue& options, const ScriptV
     auto rawPath = options.property("path").toString();
     auto path = AssetUtils::getATPUrl(rawPath).path();
 
-    QByteArray dataByteArray = data.isString() ? data.toString().toUtf8() : scriptvalue_cast<QByteArray>(data);
+    QByteArray dataByteArray = getOptionsData(options, data);
 
     JS_VERIFY(path.isEmpty() || AssetUtils::isValidFilePath(path),
               QString("expected valid ATP file path '%1' ('%2')").arg(rawPath).arg(path));
@@ -569,12 +588,15 @@ bool AssetScriptingInterface::canWriteCacheValue(const QUrl& url) {
  * @property {Assets.SaveToCacheHeaders} [headers] - The last-modified and expiry times for the cache item.
  * @property {string} [url] - The URL to associate with the cache item. Must start with <code>"atp:"</code> or
  *     <code>"cache:"</code>. If not specified, the URL is <code>"atp:"</code> followed by the SHA256 hash of the content.
+ * @property {boolean} [transfer=false] - <code>true</code> to hand the <code>data</code> ArrayBuffer over rather than have it 
+ *     copied. The ArrayBuffer is empty afterwards.
  */
 void AssetScriptingInterface::saveToCache(const ScriptValue& options, const ScriptValue& scope, const ScriptValue& callback) {
     JS_VERIFY(options.isObject(), QString("expected options object as first parameter not: %1").arg(options.toVariant().typeName()));
 
     QString url = options.property("url").toString();
-    QByteArray data = scriptvalue_cast<QByteArray>(options.property("data"));
+    QByteArray data = options.property("data").isString() ? scriptvalue_cast<QByteArray>(options.property("data"))
+                                                          : getOptionsData(options, options.property("data"));
     QVariantMap headers = scriptvalue_cast<QVariantMap>(options.property("headers"));
 
     saveToCache(url, data, headers, scope, callback);
@@ -25,11 +25,12 @@ GetScriptStatusRequest::~GetScriptStatusRequest() {
 
 void GetScriptStatusRequest::start() {
     auto client = DependencyManager::get<EntityScriptClient>();
-    client->getEntityServerScriptStatus(_entityID, [this](bool responseReceived, bool isRunning, EntityScriptStatus status, QString errorInfo) {
+    client->getEntityServerScriptStatus(_entityID, [this](bool responseReceived, bool isRunning, EntityScriptStatus status, QString errorInfo, const EntityScriptProfile& profile) {
         _responseReceived = responseReceived;
         _isRunning = isRunning;
         _status = status;
         _errorInfo = errorInfo;
+        _profile = profile;
 
         emit finished(this);
     });
@@ -144,7 +145,7 @@ MessageID EntityScriptClient::getEntityServerScriptStatus(QUuid entityID, GetScr
         }
     }
 
-    callback(false, false, EntityScriptStatus::ERROR_LOADING_SCRIPT, "");
+    callback(false, false, EntityScriptStatus::ERROR_LOADING_SCRIPT, "", EntityScriptProfile());
     return INVALID_MESSAGE_ID;
 }
 
@@ -155,6 +156,7 @@ void EntityScriptClient::handleGetScriptStatusReply(QSharedPointer<ReceivedMessa
     bool isKnown { false };
     EntityScriptStatus status = EntityScriptStatus::ERROR_LOADING_SCRIPT;
     QString errorInfo { "" };
+    EntityScriptProfile profile;
 
     message->readPrimitive(&messageID);
     message->readPrimitive(&isKnown);
@@ -162,6 +164,20 @@ void EntityScriptClient::handleGetScriptStatusReply(QSharedPointer<ReceivedMessa
     if (isKnown) {
         message->readPrimitive(&status);
         errorInfo = message->readString();
+        // older servers don't send the time spent running the script, nor the rest of the profile
+        if (message->getBytesLeftToRead() >= (qint64)sizeof(profile.cpuTime)) {
+            message->readPrimitive(&profile.cpuTime);
+        }
+        const qint64 REST_OF_PROFILE_SIZE = 5 * sizeof(quint64) + 2 * sizeof(qint32);
+        if (message->getBytesLeftToRead() >= REST_OF_PROFILE_SIZE) {
+            message->readPrimitive(&profile.threadCPUTime);
+            message->readPrimitive(&profile.callCount);
+            message->readPrimitive(&profile.usedHeapSize);
+            message->readPrimitive(&profile.gcCount);
+            message->readPrimitive(&profile.gcPauseTime);
+            message->readPrimitive(&profile.numTimers);
+            message->readPrimitive(&profile.numSignalConnections);
+        }
     }
 
     // Check if we have any pending requests for this node
@@ -175,7 +191,7 @@ void EntityScriptClient::handleGetScriptStatusReply(QSharedPointer<ReceivedMessa
         auto requestIt = messageCallbackMap.find(messageID);
         if (requestIt != messageCallbackMap.end()) {
             auto callback = requestIt->second;
-            callback(true, isKnown, status, errorInfo);
+            callback(true, isKnown, status, errorInfo, profile);
             messageCallbackMap.erase(requestIt);
         }
 
@@ -211,7 +227,7 @@ void EntityScriptClient::forceFailureOfPendingRequests(SharedNodePointer node) {
         auto messageMapIt = _pendingEntityScriptStatusRequests.find(node);
         if (messageMapIt != _pendingEntityScriptStatusRequests.end()) {
             for (const auto& value : messageMapIt->second) {
-                value.second(false, false, EntityScriptStatus::ERROR_LOADING_SCRIPT, "");
+                value.second(false, false, EntityScriptStatus::ERROR_LOADING_SCRIPT, "", EntityScriptProfile());
             }
             messageMapIt->second.clear();
         }
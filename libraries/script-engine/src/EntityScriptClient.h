@@ -25,7 +25,21 @@
 #include <DependencyManager.h>
 #include <unordered_map>
 
-using GetScriptStatusCallback = std::function<void(bool responseReceived, bool isRunning, EntityScriptStatus status, QString errorInfo)>;
+/// The profiling counters that the entity script server reports with the status of an entity script, they're 0 when
+/// the server is too old to report them.  The times are in microseconds.
+struct EntityScriptProfile {
+    quint64 cpuTime { 0 };
+    quint64 threadCPUTime { 0 };
+    quint64 callCount { 0 };
+    // these are for the script engine that runs the script, which may be running other scripts too
+    quint64 usedHeapSize { 0 };
+    quint64 gcCount { 0 };
+    quint64 gcPauseTime { 0 };
+    qint32 numTimers { 0 };
+    qint32 numSignalConnections { 0 };
+};
+
+using GetScriptStatusCallback = std::function<void(bool responseReceived, bool isRunning, EntityScriptStatus status, QString errorInfo, const EntityScriptProfile& profile)>;
 
 class GetScriptStatusRequest : public QObject {
     Q_OBJECT
@@ -39,6 +53,8 @@ public:
     bool getIsRunning() const { return _isRunning; }
     EntityScriptStatus getStatus() const { return _status; }
     QString getErrorInfo() const { return _errorInfo;  }
+    quint64 getCPUTime() const { return _profile.cpuTime; }
+    const EntityScriptProfile& getProfile() const { return _profile; }
 
 signals:
     void finished(GetScriptStatusRequest* request);
@@ -51,6 +67,7 @@ private:
     bool _isRunning;
     EntityScriptStatus _status;
     QString _errorInfo;
+    EntityScriptProfile _profile;
 };
 
 class EntityScriptClient : public QObject, public Dependency {
@@ -35,12 +35,43 @@ const QString ScriptCache::STATUS_INLINE { "Inline" };
 const QString ScriptCache::STATUS_CACHED { "Cached" };
 
 ScriptCache::ScriptCache(QObject* parent) {
-    // nothing to do here...
+    _codeCache = std::make_shared<ScriptCodeCache>();
+    _codeCache->initialize();
 }
 
 void ScriptCache::clearCache() {
     Lock lock(_containerLock);
     _scriptCache.clear();
+    // the compiled code is kept, it's found by the hash of the source and can't be out of date
+}
+
+QByteArray ScriptCache::getCompiledCode(const std::string& key) {
+    QString codeKey = QString::fromStdString(key);
+    {
+        Lock lock(_containerLock);
+        auto itr = _compiledCode.find(codeKey);
+        if (itr != _compiledCode.end()) {
+            return itr.value();
+        }
+    }
+
+    // the disk is read without the lock, the engines of the other scripts don't wait for it
+    QByteArray code = _codeCache->readCode(key);
+    if (!code.isEmpty()) {
+        Lock lock(_containerLock);
+        _compiledCode[codeKey] = code;
+    }
+    return code;
+}
+
+void ScriptCache::setCompiledCode(const std::string& key, const QByteArray& code) {
+    {
+        Lock lock(_containerLock);
+        _compiledCode[QString::fromStdString(key)] = code;
+    }
+    if (!_codeCache->writeCode(key, code)) {
+        qCWarning(scriptengine) << "Unable to store the compiled code of a script";
+    }
 }
 
 void ScriptCache::clearATPScriptsFromCache() {
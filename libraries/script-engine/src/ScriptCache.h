@@ -17,9 +17,12 @@
 #ifndef hifi_ScriptCache_h
 #define hifi_ScriptCache_h
 
+#include <memory>
 #include <mutex>
 #include <DependencyManager.h>
 
+#include "ScriptCodeCache.h"
+
 using contentAvailableCallback = std::function<void(const QString& scriptOrURL, const QString& contents, bool isURL, bool contentAvailable, const QString& status)>;
 
 class ScriptUser {
@@ -58,6 +61,12 @@ public:
 
     void deleteScript(const QUrl& unnormalizedURL);
 
+    /// Returns the compiled code stored under key by setCompiledCode, or an empty array if there isn't any.  The key is
+    /// made by ScriptCodeCache::getKey, from the source and the version of the engine that compiled it.
+    QByteArray getCompiledCode(const std::string& key);
+    /// Stores the compiled code of a script, in memory for the engines of this process and on disk for the next sessions
+    void setCompiledCode(const std::string& key, const QByteArray& code);
+
 private:
     void scriptContentAvailable(int maxRetries); // new version
     ScriptCache(QObject* parent = NULL);
@@ -67,6 +76,9 @@ private:
     
     QHash<QUrl, QVariantMap> _scriptCache;
     QMultiMap<QUrl, ScriptUser*> _scriptUsers;
+
+    QHash<QString, QByteArray> _compiledCode;
+    std::shared_ptr<ScriptCodeCache> _codeCache;
 };
 
 #endif // hifi_ScriptCache_h
@@ -0,0 +1,83 @@
+//
+//  ScriptCodeCache.cpp
+//  libraries/script-engine/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ScriptCodeCache.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+
+#include "ScriptEngineLogging.h"
+
+const quint32 ScriptCodeCache::CURRENT_VERSION = 1;
+const std::string ScriptCodeCache::DIRNAME = "script_code";
+const std::string ScriptCodeCache::EXT = "jsc";
+
+static const quint32 SCRIPT_CODE_CACHE_MAGIC = 0x43534A53; // "SJSC"
+
+struct Header {
+    quint32 magic;
+    quint32 version;
+    quint32 codeSize;
+};
+
+ScriptCodeCache::ScriptCodeCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) {
+    // the code shares its disk space with the downloads of the scripts it was compiled from
+    setSharedBudget(cache::getResourceBudget());
+}
+
+std::string ScriptCodeCache::getKey(const QString& sourceCode, const QString& engineVersion) {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(reinterpret_cast<const char*>(&CURRENT_VERSION), sizeof(CURRENT_VERSION));
+    QByteArray version = engineVersion.toUtf8();
+    // the length keeps the version apart from the source
+    quint32 versionSize = version.size();
+    hash.addData(reinterpret_cast<const char*>(&versionSize), sizeof(versionSize));
+    hash.addData(version);
+    hash.addData(reinterpret_cast<const char*>(sourceCode.constData()), sourceCode.size() * (int)sizeof(QChar));
+    return hash.result().toHex().toStdString();
+}
+
+QByteArray ScriptCodeCache::readCode(const std::string& key) {
+    // the cache entry can't be ejected while it's held
+    auto file = getFile(key);
+    if (!file) {
+        return QByteArray();
+    }
+
+    QFile codeFile(QString::fromStdString(file->getFilepath()));
+    if (!codeFile.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    Header header;
+    if (codeFile.read(reinterpret_cast<char*>(&header), sizeof(Header)) != (qint64)sizeof(Header) ||
+            header.magic != SCRIPT_CODE_CACHE_MAGIC || header.version != CURRENT_VERSION ||
+            codeFile.size() != (qint64)(sizeof(Header) + header.codeSize)) {
+        qCWarning(scriptengine) << "Unable to read the cached script code" << key.c_str();
+        return QByteArray();
+    }
+    QByteArray code = codeFile.read(header.codeSize);
+    if (code.size() != (int)header.codeSize) {
+        return QByteArray();
+    }
+    return code;
+}
+
+bool ScriptCodeCache::writeCode(const std::string& key, const QByteArray& code) {
+    Header header;
+    header.magic = SCRIPT_CODE_CACHE_MAGIC;
+    header.version = CURRENT_VERSION;
+    header.codeSize = code.size();
+
+    QByteArray data(reinterpret_cast<const char*>(&header), sizeof(Header));
+    data.append(code);
+    return (bool)writeFile(data.constData(), Metadata(key, data.size()), true);
+}
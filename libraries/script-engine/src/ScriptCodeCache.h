@@ -0,0 +1,50 @@
+//
+//  ScriptCodeCache.h
+//  libraries/script-engine/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+/// @addtogroup ScriptEngine
+/// @{
+
+#ifndef overte_ScriptCodeCache_h
+#define overte_ScriptCodeCache_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include <shared/FileCache.h>
+
+/// Keeps the code that the script engines compile the scripts to on disk, so that a script that has been compiled once
+/// is only deserialized when it's loaded again, in this session or a later one.  The entries are keyed by the hash of
+/// the source and of the version of the engine, as the code of one version can't be used by another.
+class ScriptCodeCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to the stored format this value should be incremented,
+    // so that the entries of the previous format are no longer found
+    static const quint32 CURRENT_VERSION;
+    static const std::string DIRNAME;
+    static const std::string EXT;
+
+    ScriptCodeCache(const std::string& dir = DIRNAME, const std::string& ext = EXT);
+
+    /// Returns the key of the code of sourceCode, as compiled by the engine identified by engineVersion
+    static std::string getKey(const QString& sourceCode, const QString& engineVersion);
+
+    /// Returns the code stored under key, or an empty array if there isn't any or it can't be read
+    QByteArray readCode(const std::string& key);
+
+    /// Stores code under key, returns false if it can't be stored
+    bool writeCode(const std::string& key, const QByteArray& code);
+};
+
+#endif // overte_ScriptCodeCache_h
+
+/// @}
@@ -66,6 +66,27 @@ public:
 #endif
 };
 
+/**
+ * @brief Counters of the work done by a script engine since it was created
+ *
+ * They're kept up to date by the thread of the engine and can be read from any thread without waiting for it.
+ */
+class ScriptEngineProfilingStatistics {
+public:
+    /// Heap in use after the last garbage collection, in bytes
+    size_t usedHeapSize { 0 };
+    /// Heap reserved by the engine after the last garbage collection, in bytes
+    size_t totalHeapSize { 0 };
+    quint64 gcCount { 0 };
+    /// Time that the garbage collections have paused the script for, in microseconds
+    quint64 gcPauseTime { 0 };
+    /// Number of script functions connected to signals
+    int numSignalConnections { 0 };
+    quint64 signalCallCount { 0 };
+    /// Time spent calling the script functions connected to signals, in microseconds
+    quint64 signalCallTime { 0 };
+};
+
 /**
  * @brief Provides an engine-independent interface for a scripting engine
  *
@@ -294,7 +315,27 @@ public:
     ScriptManager* manager() const { return _manager; }
 
     virtual ScriptValue newArray(uint length = 0) = 0;
-    virtual ScriptValue newArrayBuffer(const QByteArray& message) = 0;
+    /**
+     * @brief Creates an ArrayBuffer holding data
+     *
+     * The data isn't copied when the ArrayBuffer is the only one to reference it, callers that don't need their QByteArray
+     * any more can move it in.
+     *
+     * @param data Contents of the ArrayBuffer
+     * @return ScriptValue ArrayBuffer
+     */
+    virtual ScriptValue newArrayBuffer(QByteArray data) = 0;
+
+    /**
+     * @brief Takes the data of an ArrayBuffer from the script
+     *
+     * The ArrayBuffer is detached, the script sees it as empty afterwards, so its data can be handed over without a copy
+     * when it was created by newArrayBuffer.  Other values are converted as scriptvalue_cast<QByteArray> does.
+     *
+     * @param value ArrayBuffer to transfer
+     * @return QByteArray Its data
+     */
+    virtual QByteArray transferArrayBuffer(const ScriptValue& value) = 0;
     virtual ScriptValue newFunction(FunctionSignature fun, int length = 0) {
         Q_ASSERT(false);
         return ScriptValue();
@@ -403,6 +444,16 @@ public:
      */
     virtual ScriptEngineMemoryStatistics getMemoryUsageStatistics() = 0;
 
+    /**
+     * @brief Return the profiling counters of the engine.
+     *
+     * Unlike getMemoryUsageStatistics() this doesn't wait for the script to yield, so it's cheap enough to poll for
+     * statistics while the script runs.
+     *
+     * @return ScriptEngineProfilingStatistics Object containing the counters.
+     */
+    virtual ScriptEngineProfilingStatistics getProfilingStatistics() const = 0;
+
     /**
      * @brief Start collecting object statistics that can later be reported with dumpHeapObjectStatistics().
      */
@@ -420,6 +471,8 @@ public:
 
     /**
      * @brief Stops collecting profiling data and saves it to a CSV file in Logs directory.
+     *
+     * If a trace is being recorded by the Tracer, the samples are also added to it, as events of the trace_script category.
      */
     virtual void stopProfilingAndSave() = 0;
 
@@ -449,6 +502,12 @@ public: // not for public use, but I don't like how Qt strings this along with p
     virtual void registerCustomType(int type, MarshalFunction mf, DemarshalFunction df) = 0;
     virtual QStringList getCurrentScriptURLs() const = 0;
     virtual void perManagerLoopIterationCleanup() = 0;
+    /**
+     * @brief Calls the functions connected to signals with connectCoalesced() with the emissions of the last frame
+     *
+     * Called by ScriptManager once per iteration of its loop.
+     */
+    virtual void dispatchCoalescedSignals() = 0;
 
 signals:
     /**
@@ -19,6 +19,7 @@
 #include <shared/QtHelpers.h>
 #include <SettingHandle.h>
 #include <UserActivityLogger.h>
+#include <NumericalConstants.h>
 #include <PathUtils.h>
 #include <shared/FileUtils.h>
 #include <QtConcurrent/QtConcurrent>
@@ -26,6 +27,7 @@
 #include "ScriptCache.h"
 #include "ScriptEngine.h"
 #include "ScriptEngineLogging.h"
+#include "ScriptWorker.h"
 
 #define __STR2__(x) #x
 #define __STR1__(x) __STR2__(x)
@@ -163,6 +165,23 @@ void ScriptEngines::removeScriptEngine(ScriptManagerPointer manager) {
     _entitiesSubscribedToEntityScriptMessages.remove(manager.get());
 }
 
+bool ScriptEngines::addScriptWorker(ScriptWorker* worker) {
+    if (_isStopped) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(_workersMutex);
+    if (_workers.size() >= _maxWorkers) {
+        return false;
+    }
+    _workers.insert(worker);
+    return true;
+}
+
+void ScriptEngines::removeScriptWorker(ScriptWorker* worker) {
+    std::lock_guard<std::mutex> lock(_workersMutex);
+    _workers.remove(worker);
+}
+
 void ScriptEngines::requestServerEntityScriptMessages(ScriptManager *manager) {
     std::lock_guard<std::mutex> lock(_subscriptionsToEntityScriptMessagesMutex);
     if (!_managersSubscribedToEntityScriptMessages.contains(manager)) {
@@ -337,6 +356,15 @@ QVariantList ScriptEngines::getLocal() {
  * @property {string} name - The script's file name.
  * @property {string} path - The script's path and file name &mdash; excluding the scheme if a local file.
  * @property {string} url - The full URL of the script &mdash; including the scheme if a local file.
+ * @property {number} numTimers - The number of timers of the script that are waiting to fire.
+ * @property {number} timerTime - The time that firing the timers of the script has taken, in milliseconds.
+ * @property {number} heapUsed - The size of the script's heap after its last garbage collection, in bytes.
+ * @property {number} gcCount - The number of garbage collections of the script's heap.
+ * @property {number} gcTime - The time that the garbage collections have paused the script for, in milliseconds.
+ * @property {number} numSignalConnections - The number of the script's functions that are connected to signals.
+ * @property {number} signalCalls - The number of calls to the script's functions that are connected to signals.
+ * @property {number} signalTime - The time that the calls to the script's functions that are connected to signals have
+ *     taken, in milliseconds.
  */
 QVariantList ScriptEngines::getRunning() {
     QVariantList result;
@@ -359,11 +387,33 @@ QVariantList ScriptEngines::getRunning() {
         resultNode.insert("path", displayURLString);
         resultNode.insert("url", normalizeScriptURL(runningScript).toString());
         resultNode.insert("local", runningScriptURL.isLocalFile());
+        auto scriptManager = getScriptEngine(runningScriptURL);
+        if (scriptManager) {
+            resultNode.insert("numTimers", scriptManager->getNumTimers());
+            resultNode.insert("timerTime", (double)scriptManager->getTimerDispatchTime() / USECS_PER_MSEC);
+            ScriptEngineProfilingStatistics engineStatistics = scriptManager->engine()->getProfilingStatistics();
+            resultNode.insert("heapUsed", (double)engineStatistics.usedHeapSize);
+            resultNode.insert("gcCount", (double)engineStatistics.gcCount);
+            resultNode.insert("gcTime", (double)engineStatistics.gcPauseTime / USECS_PER_MSEC);
+            resultNode.insert("numSignalConnections", engineStatistics.numSignalConnections);
+            resultNode.insert("signalCalls", (double)engineStatistics.signalCallCount);
+            resultNode.insert("signalTime", (double)engineStatistics.signalCallTime / USECS_PER_MSEC);
+        }
         result.append(resultNode);
     }
     return result;
 }
 
+QVariantList ScriptEngines::getWorkers() {
+    QVariantList result;
+    // the workers remove themselves under the same lock before they're destroyed
+    std::lock_guard<std::mutex> lock(_workersMutex);
+    for (auto worker : _workers) {
+        result.append(worker->getStatistics());
+    }
+    return result;
+}
+
 void ScriptEngines::loadDefaultScripts() {
     loadScript(DEFAULT_SCRIPTS_LOCATION);
 }
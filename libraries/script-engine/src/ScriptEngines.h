@@ -14,9 +14,11 @@
 #ifndef hifi_ScriptEngines_h
 #define hifi_ScriptEngines_h
 
+#include <algorithm>
 #include <functional>
 #include <atomic>
 #include <memory>
+#include <mutex>
 
 #include <QtCore/QObject>
 #include <QtCore/QMutex>
@@ -33,6 +35,7 @@
 #include "ScriptGatekeeper.h"
 
 class ScriptEngine;
+class ScriptWorker;
 
 /*@jsdoc
  * The <code>ScriptDiscoveryService</code> API provides facilities to work with Interface scripts.
@@ -54,6 +57,8 @@ class ScriptEngine;
  * @property {ScriptsModelFilter} scriptsModelFilter - Sorted and filtered information on the scripts that are in the default
  *     scripts directory of the Interface installation.
  *     <em>Read-only.</em>
+ * @property {number} maxWorkers=8 - The number of script workers that can be running at the same time. When this many are
+ *     running, {@link Script.createWorker} throws an error until one of them finishes.
  */
 /// Provides the <code><a href="https://apidocs.overte.org/ScriptDiscoveryService.html">ScriptDiscoveryService</a></code> scripting interface
 class ScriptEngines : public QObject, public Dependency, public ScriptInitializerMixin<ScriptManagerPointer> {
@@ -62,6 +67,7 @@ class ScriptEngines : public QObject, public Dependency, public ScriptInitialize
     Q_PROPERTY(ScriptsModel* scriptsModel READ scriptsModel CONSTANT)
     Q_PROPERTY(ScriptsModelFilter* scriptsModelFilter READ scriptsModelFilter CONSTANT)
     Q_PROPERTY(QString debugScriptUrl READ getDebugScriptUrl WRITE setDebugScriptUrl)
+    Q_PROPERTY(int maxWorkers READ getMaxWorkers WRITE setMaxWorkers)
 
 public:
     ScriptEngines(ScriptManager::Context context, const QUrl& defaultScriptsOverride = QUrl());
@@ -84,6 +90,10 @@ public:
 
     QString getDefaultScriptsLocation() const;
 
+    static const int DEFAULT_MAX_WORKERS = 8;
+    int getMaxWorkers() const { return _maxWorkers; }
+    void setMaxWorkers(int maxWorkers) { _maxWorkers = std::max(maxWorkers, 0); }
+
     /*@jsdoc
      * Starts running an Interface script, if it isn't already running. The script is automatically loaded next time Interface
      * starts.
@@ -157,6 +167,14 @@ public:
      */
     Q_INVOKABLE QVariantList getRunning();
 
+    /*@jsdoc
+     * Gets the script workers that are currently running, started by Interface, avatar, and client entity scripts with
+     * {@link Script.createWorker}.
+     * @function ScriptDiscoveryService.getWorkers
+     * @returns {ScriptWorker.Statistics[]} The statistics of the script workers that are running.
+     */
+    Q_INVOKABLE QVariantList getWorkers();
+
     /*@jsdoc
      * Gets a list of all script files that are in the default scripts directory of the Interface installation.
      * @function ScriptDiscoveryService.getPublic
@@ -186,6 +204,10 @@ public:
 
     void removeScriptEngine(ScriptManagerPointer);
 
+    // Called by ScriptWorker, addScriptWorker returns false when the pool of workers is full
+    bool addScriptWorker(ScriptWorker* worker);
+    void removeScriptWorker(ScriptWorker* worker);
+
     // Called by ScriptManagerScriptingInterface
     void requestServerEntityScriptMessages(ScriptManager *manager);
     void requestServerEntityScriptMessages(ScriptManager *manager, const QUuid& entityID);
@@ -419,6 +441,10 @@ protected:
     bool _defaultScriptsLocationOverridden { false };
     QString _debugScriptUrl;
 
+    std::mutex _workersMutex;
+    QSet<ScriptWorker*> _workers;
+    std::atomic<int> _maxWorkers { DEFAULT_MAX_WORKERS };
+
     // For subscriptions to server entity script messages
     std::mutex _subscriptionsToEntityScriptMessagesMutex;
     QSet<ScriptManager*> _managersSubscribedToEntityScriptMessages;
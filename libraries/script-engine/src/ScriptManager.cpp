@@ -13,7 +13,9 @@
 
 #include "ScriptManager.h"
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
 #include <thread>
 
 #include <QtCore/QCoreApplication>
@@ -56,6 +58,7 @@
 #include "ScriptProgram.h"
 #include "ScriptValueIterator.h"
 #include "ScriptValueUtils.h"
+#include "ScriptWorker.h"
 #include "ScriptManagerScriptingInterface.h"
 
 #include <Profile.h>
@@ -74,6 +77,7 @@ const QString ScriptManager::_SETTINGS_ENABLE_EXTENDED_EXCEPTIONS {
 
 const QString ScriptManager::SCRIPT_EXCEPTION_FORMAT{ "[%0] %1 in %2:%3" };
 const QString ScriptManager::SCRIPT_BACKTRACE_SEP{ "\n    " };
+std::atomic<quint64> ScriptManager::_totalScriptTime { 0 };
 
 static const int MAX_MODULE_ID_LENGTH { 4096 };
 static const int MAX_DEBUG_VALUE_LENGTH { 80 };
@@ -264,9 +268,14 @@ ScriptManager::ScriptManager(Context context, const QString& scriptContents, con
     _engine(newScriptEngine(this)),
     _scriptContents(scriptContents),
     _timerFunctionMap(),
+    _timerWheelTimer(new QTimer(this)),
     _fileNameString(fileNameString),
     _assetScriptingInterface(new AssetScriptingInterface(this))
 {
+    _timerWheelTimer->setSingleShot(true);
+    _timerWheelTimer->setTimerType(Qt::PreciseTimer);
+    connect(_timerWheelTimer, &QTimer::timeout, this, &ScriptManager::timerFired);
+    _timerWheelClock.start();
 
     switch (_context) {
         case Context::CLIENT_SCRIPT:
@@ -284,6 +293,9 @@ ScriptManager::ScriptManager(Context context, const QString& scriptContents, con
         case Context::NETWORKLESS_TEST_SCRIPT:
             _type = Type::NETWORKLESS_TEST;
             break;
+        case Context::WORKER_SCRIPT:
+            _type = Type::WORKER;
+            break;
     }
 
     qRegisterMetaType<ScriptValue>();
@@ -362,6 +374,8 @@ QString ScriptManager::getContext() const {
             return "agent";
         case NETWORKLESS_TEST_SCRIPT:
             return "networkless_test";
+        case WORKER_SCRIPT:
+            return "worker";
         default:
             return "unknown";
     }
@@ -736,7 +750,7 @@ void ScriptManager::init() {
 
     _isInitialized = true;
 
-    if (_context != NETWORKLESS_TEST_SCRIPT) {
+    if (!hasMinimalAPI()) {
         // This initializes a bunch of systems that want network access. We
         // want to avoid it in test script mode.
         runStaticInitializers(this);
@@ -744,7 +758,7 @@ void ScriptManager::init() {
 
     auto scriptEngine = _engine.get();
 
-    if (_context != NETWORKLESS_TEST_SCRIPT) {
+    if (!hasMinimalAPI()) {
         // For test scripts we want to minimize the amount of functionality available, for the least
         // amount of dependencies and faster test system startup.
 
@@ -787,7 +801,7 @@ void ScriptManager::init() {
     scriptEngine->registerGlobalObject("Mat4", &_mat4Library);
     scriptEngine->registerGlobalObject("Uuid", &_uuidLibrary);
 
-    if (_context != NETWORKLESS_TEST_SCRIPT) {
+    if (!hasMinimalAPI()) {
         // This requires networking, we want to avoid the need for it in test scripts
         scriptEngine->registerGlobalObject("Messages", DependencyManager::get<MessagesClient>().data());
     }
@@ -807,7 +821,7 @@ void ScriptManager::init() {
     // constants
     scriptEngine->globalObject().setProperty("TREE_SCALE", scriptEngine->newValue(TREE_SCALE));
 
-    if (_context != NETWORKLESS_TEST_SCRIPT) {
+    if (!hasMinimalAPI()) {
         // Scriptable cache access
         auto resourcePrototype = createScriptableResourcePrototype(shared_from_this());
         scriptEngine->globalObject().setProperty("Resource", resourcePrototype);
@@ -1064,6 +1078,11 @@ void ScriptManager::run() {
             emit releaseEntityPacketSenderMessages(false);
         }
 
+        if (!_isFinished) {
+            PROFILE_RANGE(script, "CoalescedSignals");
+            _engine->dispatchCoalescedSignals();
+        }
+
         qint64 now = usecTimestampNow();
 
         // we check for 'now' in the past in case people set their clock back
@@ -1078,6 +1097,7 @@ void ScriptManager::run() {
                 auto postUpdate = clock::now();
                 auto elapsed = (postUpdate - preUpdate);
                 totalUpdates += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+                _totalScriptTime += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
             }
         }
         _lastUpdate = now;
@@ -1117,23 +1137,23 @@ void ScriptManager::run() {
 // NOTE: This is private because it must be called on the same thread that created the timers, which is why
 // we want to only call it in our own run "shutdown" processing.
 void ScriptManager::stopAllTimers() {
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
+    // stopTimer() removes the timer from the map, so the map isn't iterated directly
+    const auto timers = _timerFunctionMap.keys();
     int j {0};
-    while (i.hasNext()) {
-        i.next();
-        QTimer* timer = i.key();
+    for (auto timer : timers) {
         qCDebug(scriptengine) << getFilename() << "stopAllTimers[" << j++ << "]";
         stopTimer(timer);
     }
+    _timerWheelTimer->stop();
 }
 
 void ScriptManager::stopAllTimersForEntityScript(const EntityItemID& entityID) {
      // We could maintain a separate map of entityID => QTimer, but someone will have to prove to me that it's worth the complexity. -HRS
     QVector<QTimer*> toDelete;
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
+    QMutableHashIterator<QTimer*, TimerData> i(_timerFunctionMap);
     while (i.hasNext()) {
         i.next();
-        if (i.value().definingEntityIdentifier != entityID) {
+        if (i.value().callback.definingEntityIdentifier != entityID) {
             continue;
         }
         QTimer* timer = i.key();
@@ -1180,26 +1200,47 @@ void ScriptManager::timerFired() {
     callTimer.start();
 #endif
 
-    QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
-    CallbackData timerData = _timerFunctionMap.value(callingTimer);
+    auto preDispatch = p_high_resolution_clock::now();
 
-    if (!callingTimer->isActive()) {
-        // this timer is done, we can kill it
-        _timerFunctionMap.remove(callingTimer);
-        delete callingTimer;
-    }
+    // the timers that are due are fired in one batch, the wheel is only advanced once for all of them
+    std::vector<ScriptTimerWheel::TimerID> dueTimers;
+    _timerWheel.advance(_timerWheelClock.elapsed(), dueTimers);
+    for (auto wheelID : dueTimers) {
+        if (isStopped()) {
+            break;
+        }
+        // the timer may have been stopped by a callback of the same batch
+        QTimer* callingTimer = _timersByWheelID.value(wheelID);
+        if (!callingTimer) {
+            continue;
+        }
+        CallbackData timerData = _timerFunctionMap.value(callingTimer).callback;
+
+        if (callingTimer->isSingleShot()) {
+            // this timer is done, we can kill it
+            _timerFunctionMap.remove(callingTimer);
+            _timersByWheelID.remove(wheelID);
+            _numTimers = _timerFunctionMap.size();
+            delete callingTimer;
+        }
 
-    // call the associated JS function, if it exists
-    if (timerData.function.isValid()) {
-        PROFILE_RANGE(script, __FUNCTION__);
-        auto preTimer = p_high_resolution_clock::now();
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, ScriptValueList());
-        auto postTimer = p_high_resolution_clock::now();
-        auto elapsed = (postTimer - preTimer);
-        _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
-    } else {
-        qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+        // call the associated JS function, if it exists
+        if (timerData.function.isValid()) {
+            PROFILE_RANGE(script, __FUNCTION__);
+            auto preTimer = p_high_resolution_clock::now();
+            callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, ScriptValueList());
+            auto postTimer = p_high_resolution_clock::now();
+            auto elapsed = (postTimer - preTimer);
+            _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+            _totalScriptTime += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        } else {
+            qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+        }
     }
+    updateTimerWheelTimer();
+
+    auto postDispatch = p_high_resolution_clock::now();
+    _timerDispatchTime += std::chrono::duration_cast<std::chrono::microseconds>(postDispatch - preDispatch).count();
 
 #ifdef SCRIPT_TIMER_PERFORMANCE_STATISTICS
     _totalTimeInTimerEvents_s += callTimer.elapsed() / 1000.0;
@@ -1207,29 +1248,34 @@ void ScriptManager::timerFired() {
 }
 
 QTimer* ScriptManager::setupTimerWithInterval(const ScriptValue& function, int intervalMS, bool isSingleShot) {
-    // create the timer, add it to the map, and start it
+    // create the handle of the timer, add it to the map, and schedule it
     QTimer* newTimer = new QTimer(this);
     newTimer->setSingleShot(isSingleShot);
+    newTimer->setInterval(intervalMS);
 
-    // The default timer type is not very accurate below about 200ms http://doc.qt.io/qt-5/qt.html#TimerType-enum
-    static const int MIN_TIMEOUT_FOR_COARSE_TIMER = 200;
-    if (intervalMS < MIN_TIMEOUT_FOR_COARSE_TIMER) {
-        newTimer->setTimerType(Qt::PreciseTimer);
-    }
-
-    connect(newTimer, &QTimer::timeout, this, &ScriptManager::timerFired);
-
-    // make sure the timer stops when the script does
-    connect(this, &ScriptManager::scriptEnding, newTimer, &QTimer::stop);
-
-
-    CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL };
+    TimerData timerData = { { function, currentEntityIdentifier, currentSandboxURL },
+                            _timerWheel.add(_timerWheelClock.elapsed(), intervalMS, isSingleShot) };
     _timerFunctionMap.insert(newTimer, timerData);
+    _timersByWheelID.insert(timerData.wheelID, newTimer);
+    _numTimers = _timerFunctionMap.size();
 
-    newTimer->start(intervalMS);
+    updateTimerWheelTimer();
     return newTimer;
 }
 
+void ScriptManager::updateTimerWheelTimer() {
+    qint64 timeUntilNextAdvance = _timerWheel.getTimeUntilNextAdvance(_timerWheelClock.elapsed());
+    if (timeUntilNextAdvance < 0) {
+        _timerWheelTimer->stop();
+        return;
+    }
+    // restarting the timer is only needed when the wheel has to advance sooner than it would fire
+    int interval = (int)std::min(timeUntilNextAdvance, (qint64)std::numeric_limits<int>::max());
+    if (!_timerWheelTimer->isActive() || _timerWheelTimer->remainingTime() > interval) {
+        _timerWheelTimer->start(interval);
+    }
+}
+
 QTimer* ScriptManager::setInterval(const ScriptValue& function, int intervalMS) {
     if (isStopped()) {
         int lineNumber = -1;
@@ -1263,9 +1309,12 @@ QTimer* ScriptManager::setTimeout(const ScriptValue& function, int timeoutMS) {
 }
 
 void ScriptManager::stopTimer(QTimer *timer) {
-    if (_timerFunctionMap.contains(timer)) {
-        timer->stop();
-        _timerFunctionMap.remove(timer);
+    auto itr = _timerFunctionMap.find(timer);
+    if (itr != _timerFunctionMap.end()) {
+        _timerWheel.remove(itr->wheelID);
+        _timersByWheelID.remove(itr->wheelID);
+        _timerFunctionMap.erase(itr);
+        _numTimers = _timerFunctionMap.size();
         delete timer;
     } else {
         qCDebug(scriptengine) << "stopTimer -- not in _timerFunctionMap" << timer;
@@ -1875,6 +1924,39 @@ void ScriptManager::load(const QString& loadFile) {
     }
 }
 
+ScriptValue ScriptManager::createWorker(const QString& url) {
+    if (!_engine->IS_THREADSAFE_INVOCATION(__FUNCTION__)) {
+        return _engine->undefinedValue();
+    }
+    if (isStopped()) {
+        _engine->raiseException("Script.createWorker() while shutting down is ignored... url:" + url);
+        return _engine->undefinedValue();
+    }
+
+    auto worker = new ScriptWorker(this, resolvePath(url));
+    if (!worker->start()) {
+        delete worker;
+        _engine->raiseException("Script.createWorker() failed, the most workers that can run at once are already running... url:" + url);
+        return _engine->undefinedValue();
+    }
+    // the worker is a child of this manager, which terminates it when the script ends
+    return _engine->newQObject(worker, ScriptEngine::QtOwnership);
+}
+
+void ScriptManager::setCoalescedSignalOptions(const QString& signalName, int interval, int maxEvents) {
+    if (!_engine->IS_THREADSAFE_INVOCATION(__FUNCTION__)) {
+        return;
+    }
+    CoalescedSignalOptions options;
+    options.interval = std::max(interval, 0);
+    options.maxEvents = std::max(maxEvents, 0);
+    _coalescedSignalOptions[signalName] = options;
+}
+
+ScriptManager::CoalescedSignalOptions ScriptManager::getCoalescedSignalOptions(const QString& signalName) const {
+    return _coalescedSignalOptions.value(signalName);
+}
+
 // Look up the handler associated with eventName and entityID. If found, evalute the argGenerator thunk and call the handler with those args
 void ScriptManager::forwardHandlerCall(const EntityItemID& entityID, const QString& eventName, const ScriptValueList& eventHandlerArgs) {
     if (QThread::currentThread() != thread()) {
@@ -1912,6 +1994,15 @@ int ScriptManager::getNumRunningEntityScripts() const {
     return sum;
 }
 
+quint64 ScriptManager::getEntityScriptsCPUTime() const {
+    QReadLocker locker { &_entityScriptsLock };
+    quint64 sum = 0;
+    for (const auto& st : _entityScripts) {
+        sum += st.cpuTime;
+    }
+    return sum;
+}
+
 void ScriptManager::setEntityScriptDetails(const EntityItemID& entityID, const EntityScriptDetails& details) {
     {
         QWriteLocker locker { &_entityScriptsLock };
@@ -2546,6 +2637,11 @@ void ScriptManager::doWithEnvironment(const EntityItemID& entityID, const QUrl&
     currentEntityIdentifier = entityID;
     currentSandboxURL = sandboxURL;
 
+    // the time is accounted to the outermost entity script, the calls it makes into others are its own
+    bool isAccounted = !entityID.isInvalidID() && oldIdentifier.isInvalidID();
+    quint64 start = isAccounted ? usecTimestampNow() : 0;
+    quint64 threadStart = isAccounted ? usecThreadCPUTimeNow() : 0;
+
 #if DEBUG_CURRENT_ENTITY
     ScriptValue oldData = this->globalObject().property("debugEntityID");
     this->globalObject().setProperty("debugEntityID", entityID.toScriptValue(this)); // Make the entityID available to javascript as a global.
@@ -2556,6 +2652,18 @@ void ScriptManager::doWithEnvironment(const EntityItemID& entityID, const QUrl&
 #endif
     currentEntityIdentifier = oldIdentifier;
     currentSandboxURL = oldSandboxURL;
+
+    if (isAccounted) {
+        quint64 elapsed = usecTimestampNow() - start;
+        quint64 threadElapsed = usecThreadCPUTimeNow() - threadStart;
+        QWriteLocker locker { &_entityScriptsLock };
+        auto it = _entityScripts.find(entityID);
+        if (it != _entityScripts.end()) {
+            it.value().cpuTime += elapsed;
+            it.value().threadCPUTime += threadElapsed;
+            it.value().callCount++;
+        }
+    }
 }
 
 void ScriptManager::callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, const ScriptValue& function, const ScriptValue& thisObject, const ScriptValueList& args) {
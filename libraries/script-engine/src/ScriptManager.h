@@ -22,6 +22,7 @@
 #include <unordered_map>
 #include <mutex>
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFuture>
 #include <QtCore/QHash>
 #include <QtCore/QObject>
@@ -47,6 +48,7 @@
 #include "ScriptUUID.h"
 #include "ScriptValue.h"
 #include "ScriptException.h"
+#include "ScriptTimerWheel.h"
 #include "Vec3.h"
 
 static const QString NO_SCRIPT("");
@@ -204,6 +206,26 @@ public:
      * not to the parent context.
      */
     QUrl definingSandboxURL { QUrl("about:EntityScript") };
+
+    /**
+     * @brief Time spent running the script, in microseconds
+     *
+     * The time that the calls into the script, its timers and its event handlers have taken on the thread of the engine
+     * since it was loaded.  The calls that it makes into other entity scripts of the same engine are counted as its own.
+     */
+    quint64 cpuTime { 0 };
+
+    /**
+     * @brief CPU time used by the thread of the engine while running the script, in microseconds
+     *
+     * This is measured over the same calls as cpuTime, which it's short of by the time that the thread spent waiting.
+     */
+    quint64 threadCPUTime { 0 };
+
+    /**
+     * @brief Number of calls into the script, counted as cpuTime is
+     */
+    quint64 callCount { 0 };
 };
 
 // declare a static script initializers
@@ -328,7 +350,15 @@ public:
          *
          * @warning This is going to break functionality like loadURL and require
          */
-        NETWORKLESS_TEST_SCRIPT
+        NETWORKLESS_TEST_SCRIPT,
+
+        /**
+         * @brief Worker script
+         * Runs a script started with Script.createWorker, on its own thread. It has the same minimal API as the
+         * network-less test context, plus the Worker object that it exchanges messages with the script that started it
+         * through.
+         */
+        WORKER_SCRIPT
     };
 
     /**
@@ -376,7 +406,14 @@ public:
          *
          * @warning This is a development-targeted bit of functionality.
          */
-        NETWORKLESS_TEST
+        NETWORKLESS_TEST,
+
+        /**
+         * @brief Worker script
+         *
+         * Started by another script with Script.createWorker.
+         */
+        WORKER
     };
     Q_ENUM(Type);
 
@@ -576,6 +613,13 @@ public:
      */
     Q_INVOKABLE bool isAgentScript() const { return _context == AGENT_SCRIPT; }
 
+    /**
+     * @brief Checks whether the script is running as a worker of another script.
+     *
+     * @return bool
+     */
+    Q_INVOKABLE bool isWorkerScript() const { return _context == WORKER_SCRIPT; }
+
     /**
      * @brief Registers a global object by name.
      *
@@ -631,6 +675,47 @@ public:
      */
     Q_INVOKABLE void load(const QString& loadfile);
 
+    /**
+     * @brief Starts running a script as a worker of this script, on a thread of its own
+     *
+     * The worker runs in the WORKER_SCRIPT context and exchanges messages with this script through the ScriptWorker
+     * object that's returned.  An exception is raised if the pool of workers of ScriptEngines is full.
+     *
+     * @param url URL of the worker script, which can be relative to the current script's URL
+     * @return ScriptValue The ScriptWorker object, or undefined if the worker couldn't be started
+     */
+    ScriptValue createWorker(const QString& url);
+
+    /**
+     * @brief How the emissions of a signal are delivered to the functions connected with connectCoalesced()
+     *
+     */
+    struct CoalescedSignalOptions {
+        /// Minimum time between two calls of the functions, in milliseconds, 0 to call them every frame that has emissions
+        int interval { 0 };
+        /// Maximum number of emissions that are kept between two calls, the oldest are dropped, 0 for no limit
+        int maxEvents { 0 };
+    };
+
+    /**
+     * @brief Sets how the functions connected with connectCoalesced() to the signals with this name are called
+     *
+     * The options apply to the signals of every object, from their next delivery on.
+     *
+     * @param signalName Name of the signal, without its parameters, e.g. "collisionWithEntity"
+     * @param interval Minimum time between two calls, in milliseconds
+     * @param maxEvents Maximum number of emissions passed to one call, 0 for no limit
+     */
+    Q_INVOKABLE void setCoalescedSignalOptions(const QString& signalName, int interval, int maxEvents = 0);
+
+    /**
+     * @brief Gets the options set with setCoalescedSignalOptions() for a signal, or the default ones
+     *
+     * @param signalName Name of the signal, without its parameters
+     * @return CoalescedSignalOptions The options of the signal
+     */
+    CoalescedSignalOptions getCoalescedSignalOptions(const QString& signalName) const;
+
     /**
      * @brief Includes JavaScript from other files in the current script.
      *
@@ -1002,6 +1087,13 @@ public:
      */
     bool isRunning() const { return _isRunning; } // used by ScriptWidget
 
+    /**
+     * @brief The time that all the scripts spent in their updates and timers since the start, in usecs
+     *
+     * @return quint64 The time of all the scripts
+     */
+    static quint64 getTotalScriptTime() { return _totalScriptTime; } // used by the performance telemetry
+
     // this is used by code in ScriptEngines.cpp during the "reload all" operation
     /**
      * @brief Whether this ScriptManager is stopping. Once this is true, it stays true.
@@ -1136,6 +1228,29 @@ public:
      */
     int getNumRunningEntityScripts() const;
 
+    /**
+     * @brief Get the time spent running the entity scripts
+     *
+     * @return quint64 The sum of EntityScriptDetails::cpuTime for the entity scripts of this engine, in microseconds
+     */
+    quint64 getEntityScriptsCPUTime() const;
+
+    /**
+     * @brief Returns the number of timers of the script that are waiting to fire
+     *
+     * @return int Number of timers
+     */
+    int getNumTimers() const { return _numTimers; }
+
+    /**
+     * @brief Returns the time spent firing the timers of the script, in microseconds
+     *
+     * This includes the timer callbacks and the cost of dispatching them.
+     *
+     * @return quint64 Time in microseconds
+     */
+    quint64 getTimerDispatchTime() const { return _timerDispatchTime; }
+
     /**
      * @brief Retrieves the details about an entity script
      *
@@ -1474,6 +1589,9 @@ protected:
      */
     void init();
 
+    // The test and worker scripts only get the APIs that don't need the network or the application
+    bool hasMinimalAPI() const { return _context == NETWORKLESS_TEST_SCRIPT || _context == WORKER_SCRIPT; }
+
     /**
      * @brief executeOnScriptThread
      *
@@ -1550,6 +1668,12 @@ protected:
      */
     QTimer* setupTimerWithInterval(const ScriptValue& function, int intervalMS, bool isSingleShot);
 
+    /**
+     * @brief Starts _timerWheelTimer for when _timerWheel has to advance next
+     *
+     */
+    void updateTimerWheelTimer();
+
     /**
      * @brief Stops a timer
      *
@@ -1620,8 +1744,23 @@ protected:
     std::atomic<bool> _isDoneRunning { false };
     bool _areMetaTypesInitialized { false };
     bool _isInitialized { false };
-    QHash<QTimer*, CallbackData> _timerFunctionMap;
+
+    struct TimerData {
+        CallbackData callback;
+        ScriptTimerWheel::TimerID wheelID;
+    };
+    // The timers are scheduled in _timerWheel, which fires them from the single _timerWheelTimer.  The QTimer of each one
+    // is never started, it's only the handle that the script holds to clear it.
+    QHash<QTimer*, TimerData> _timerFunctionMap;
+    QHash<ScriptTimerWheel::TimerID, QTimer*> _timersByWheelID;
+    ScriptTimerWheel _timerWheel;
+    QTimer* _timerWheelTimer;
+    QElapsedTimer _timerWheelClock;
+    std::atomic<int> _numTimers { 0 };
+    std::atomic<quint64> _timerDispatchTime { 0 };
     QSet<QUrl> _includedURLs;
+    // only used on the script thread, like the signal proxies that read it
+    QHash<QString, CoalescedSignalOptions> _coalescedSignalOptions;
     mutable QReadWriteLock _entityScriptsLock { QReadWriteLock::Recursive };
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
     EntityScriptContentAvailableMap _contentAvailableQueue;
@@ -1648,6 +1787,7 @@ protected:
     std::recursive_mutex _lock;
 
     std::chrono::microseconds _totalTimerExecution { 0 };
+    static std::atomic<quint64> _totalScriptTime;
 
     static const QString _SETTINGS_ENABLE_EXTENDED_EXCEPTIONS;
 
@@ -33,6 +33,7 @@
  *       <li><code>"entity_client"</code>: A client entity script.</li>
  *       <li><code>"entity_server"</code>: A server entity script.</li>
  *       <li><code>"agent"</code>: An assignment client script.</li>
+ *       <li><code>"worker"</code>: A worker script, started with {@link Script.createWorker}.</li>
  *     </ul>
  *     <em>Read-only.</em>
  * @property {string} type - The type of script that is running:
@@ -42,6 +43,7 @@
  *       <li><code>"avatar"</code>: An avatar script.</li>
  *       <li><code>"entity_server"</code>: A server entity script.</li>
  *       <li><code>"agent"</code>: An assignment client script.</li>
+ *       <li><code>"worker"</code>: A worker script, started with {@link Script.createWorker}.</li>
  *     </ul>
  *     <em>Read-only.</em>
  * @property {string} filename - The filename of the script file.
@@ -92,6 +94,7 @@ public:
      *   <li><code>"entity_client"</code>: A client entity script.</li>
      *   <li><code>"entity_server"</code>: A server entity script.</li>
      *   <li><code>"agent"</code>: An assignment client script.</li>
+     *   <li><code>"worker"</code>: A worker script, started with {@link Script.createWorker}.</li>
      * </ul>
      */
     Q_INVOKABLE QString getContext() const { return _manager->getContext(); }
@@ -135,6 +138,13 @@ public:
      */
     Q_INVOKABLE bool isAgentScript() const { return _manager->isAgentScript(); }
 
+    /*@jsdoc
+     * Checks whether the script is running as a worker of another script, started with {@link Script.createWorker}.
+     * @function Script.isWorkerScript
+     * @returns {boolean} <code>true</code> if the script is running as a worker, <code>false</code> if it isn't.
+     */
+    Q_INVOKABLE bool isWorkerScript() const { return _manager->isWorkerScript(); }
+
     /*@jsdoc
      * registers a global object by name.
      * @function Script.registerValue
@@ -212,6 +222,41 @@ public:
      */
     Q_INVOKABLE void load(const QString& loadfile) { _manager->load(loadfile); }
 
+    /*@jsdoc
+     * Starts running a script as a worker of this script, on a thread of its own, so that it can do heavy computations
+     * without holding up this script. The two scripts exchange messages through the {@link ScriptWorker} object that's
+     * returned and the {@link Worker} object of the worker script. The worker is terminated when this script ends.
+     * @function Script.createWorker
+     * @param {string} url - The URL of the worker script. This can be relative to the current script's URL.
+     * @returns {ScriptWorker} The worker.
+     * @throws Throws an error if {@link ScriptDiscoveryService|ScriptDiscoveryService.maxWorkers} workers are already
+     *     running.
+     */
+    Q_INVOKABLE ScriptValue createWorker(const QString& url) { return _manager->createWorker(url); }
+
+    /*@jsdoc
+     * Sets how a signal's emissions are delivered to the functions connected with <code>connectCoalesced</code>. Rather than
+     * being called once per emission, as with <code>connect</code>, these functions are called at most once per frame with
+     * an array of the emissions since their last call, each of which is the array of that emission's arguments. This suits
+     * signals that are emitted many times per frame, such as collisions.
+     * @function Script.setCoalescedSignalOptions
+     * @param {string} signalName - The name of the signal, e.g., <code>"collisionWithEntity"</code>. The options apply to the
+     *     signals of that name of every object.
+     * @param {number} interval - The minimum time between two calls of the functions, in ms. <code>0</code> to call them
+     *     every frame that has emissions.
+     * @param {number} [maxEvents=0] - The maximum number of emissions passed in one call. The oldest emissions are dropped
+     *     when there are more. <code>0</code> for no limit.
+     * @example <caption>Report the collisions of an entity at most twice a second.</caption>
+     * Script.setCoalescedSignalOptions("collisionWithEntity", 500, 20);
+     * Entities.collisionWithEntity.connectCoalesced(function (events) {
+     *     print("Collisions:", events.length, "last one between", events[events.length - 1][0], "and",
+     *         events[events.length - 1][1]);
+     * });
+     */
+    Q_INVOKABLE void setCoalescedSignalOptions(const QString& signalName, int interval, int maxEvents = 0) {
+        _manager->setCoalescedSignalOptions(signalName, interval, maxEvents);
+    }
+
     /*@jsdoc
      * Includes JavaScript from other files in the current script. If a callback is specified, the files are loaded and
      * included asynchronously, otherwise they are included synchronously (i.e., script execution blocks while the files are
@@ -0,0 +1,159 @@
+//
+//  ScriptTimerWheel.cpp
+//  libraries/script-engine/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ScriptTimerWheel.h"
+
+#include <algorithm>
+
+static int findFirstSetBit(uint64_t bits) {
+    int index = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        index++;
+    }
+    return index;
+}
+
+ScriptTimerWheel::TimerID ScriptTimerWheel::add(qint64 nowMS, int intervalMS, bool isSingleShot) {
+    if (_timers.empty()) {
+        // nothing has to fire in between, the wheel can jump to now
+        _currentTick = std::max(_currentTick, nowMS);
+    }
+    // a timer fires one tick later at the soonest, as QTimer does on the next iteration of the event loop
+    int interval = std::max(intervalMS, 1);
+    TimerID id = _nextID++;
+    _timers[id] = { std::max(nowMS, _currentTick) + interval, interval, isSingleShot };
+    schedule(id, _timers[id].due);
+    return id;
+}
+
+bool ScriptTimerWheel::remove(TimerID id) {
+    return _timers.erase(id) > 0;
+}
+
+void ScriptTimerWheel::clear() {
+    _timers.clear();
+    for (int level = 0; level < NUM_LEVELS; level++) {
+        for (auto& slot : _slots[level]) {
+            slot.clear();
+        }
+        _occupiedSlots[level] = 0;
+    }
+    _overflow.clear();
+}
+
+void ScriptTimerWheel::schedule(TimerID id, qint64 due) {
+    // the timer goes in the lowest level where it's in the same slot of the level above as the current tick, so that it
+    // comes down to the level below when that slot is reached
+    for (int level = 0; level < NUM_LEVELS; level++) {
+        int shift = BITS_PER_LEVEL * (level + 1);
+        if ((due >> shift) == (_currentTick >> shift)) {
+            int index = (int)((due >> (BITS_PER_LEVEL * level)) & SLOT_MASK);
+            _slots[level][index].push_back(id);
+            _occupiedSlots[level] |= (uint64_t)1 << index;
+            return;
+        }
+    }
+    _overflow.push_back(id);
+}
+
+void ScriptTimerWheel::cascade(int level) {
+    std::vector<TimerID> timers;
+    if (level == NUM_LEVELS) {
+        timers.swap(_overflow);
+    } else {
+        int index = (int)((_currentTick >> (BITS_PER_LEVEL * level)) & SLOT_MASK);
+        if (index == 0) {
+            // the level above moves first, its timers may come down into this slot
+            cascade(level + 1);
+        }
+        if (!(_occupiedSlots[level] & ((uint64_t)1 << index))) {
+            return;
+        }
+        timers.swap(_slots[level][index]);
+        _occupiedSlots[level] &= ~((uint64_t)1 << index);
+    }
+    for (TimerID id : timers) {
+        auto itr = _timers.find(id);
+        if (itr != _timers.end()) {
+            schedule(id, itr->second.due);
+        }
+    }
+}
+
+qint64 ScriptTimerWheel::getNextTick() const {
+    // the next tick is the next occupied slot of the lowest level that has one ahead of the current tick, as the levels
+    // below it are empty until then
+    for (int level = 0; level < NUM_LEVELS; level++) {
+        int shift = BITS_PER_LEVEL * level;
+        int index = (int)((_currentTick >> shift) & SLOT_MASK);
+        uint64_t ahead = index + 1 < SLOTS_PER_LEVEL ? _occupiedSlots[level] >> (index + 1) : 0;
+        if (ahead) {
+            return ((_currentTick >> shift) + 1 + findFirstSetBit(ahead)) << shift;
+        }
+    }
+    int shift = BITS_PER_LEVEL * NUM_LEVELS;
+    return ((_currentTick >> shift) + 1) << shift;
+}
+
+void ScriptTimerWheel::advance(qint64 nowMS, std::vector<TimerID>& dueTimers) {
+    std::vector<TimerID> timers;
+    while (_currentTick < nowMS) {
+        if (_timers.empty()) {
+            _currentTick = nowMS;
+            break;
+        }
+        qint64 nextTick = getNextTick();
+        if (nextTick > nowMS) {
+            _currentTick = nowMS;
+            break;
+        }
+        _currentTick = nextTick;
+
+        int index = (int)(_currentTick & SLOT_MASK);
+        if (index == 0) {
+            cascade(1);
+        }
+        if (!(_occupiedSlots[0] & ((uint64_t)1 << index))) {
+            continue;
+        }
+        timers.clear();
+        timers.swap(_slots[0][index]);
+        _occupiedSlots[0] &= ~((uint64_t)1 << index);
+
+        for (TimerID id : timers) {
+            auto itr = _timers.find(id);
+            if (itr == _timers.end()) {
+                continue;
+            }
+            dueTimers.push_back(id);
+            Timer& timer = itr->second;
+            if (timer.isSingleShot) {
+                _timers.erase(itr);
+            } else {
+                // a repeating timer that fell behind by more than an interval fires once, like a QTimer, rather than
+                // catching up on every interval it missed
+                timer.due += timer.interval;
+                if (timer.due <= nowMS) {
+                    timer.due = nowMS + timer.interval;
+                }
+                schedule(id, timer.due);
+            }
+        }
+    }
+}
+
+qint64 ScriptTimerWheel::getTimeUntilNextAdvance(qint64 nowMS) const {
+    if (_timers.empty()) {
+        return -1;
+    }
+    return std::max(getNextTick() - nowMS, (qint64)0);
+}
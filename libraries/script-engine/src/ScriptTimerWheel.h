@@ -0,0 +1,72 @@
+//
+//  ScriptTimerWheel.h
+//  libraries/script-engine/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ScriptTimerWheel_h
+#define overte_ScriptTimerWheel_h
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+/// The timers of a script, in a hierarchical timer wheel with a resolution of one millisecond.  A timer is kept in a slot
+/// of the lowest level whose range covers its due time, and is moved down a level whenever the level below rolls over, so
+/// that adding, removing and firing a timer take constant time however many timers there are.  The wheel only advances
+/// when it's told to, ScriptManager drives it from a single QTimer that's started for getTimeUntilNextAdvance().
+class ScriptTimerWheel {
+public:
+    using TimerID = uint32_t;
+
+    /// Adds a timer that's due intervalMS after nowMS, and then every intervalMS if it isn't single shot
+    TimerID add(qint64 nowMS, int intervalMS, bool isSingleShot);
+    /// Removes a timer, returns false if it had already fired or been removed
+    bool remove(TimerID id);
+    void clear();
+
+    /// Advances the wheel to nowMS and appends the timers that are due to dueTimers, in the order that they're due.  The
+    /// single shot timers are removed, the others are due again an interval later.
+    void advance(qint64 nowMS, std::vector<TimerID>& dueTimers);
+    /// Returns how long until advance() has to be called next, or -1 if there are no timers
+    qint64 getTimeUntilNextAdvance(qint64 nowMS) const;
+
+    size_t size() const { return _timers.size(); }
+    bool empty() const { return _timers.empty(); }
+
+private:
+    static const int BITS_PER_LEVEL = 6;
+    static const int SLOTS_PER_LEVEL = 1 << BITS_PER_LEVEL;
+    static const qint64 SLOT_MASK = SLOTS_PER_LEVEL - 1;
+    // the levels cover 2^24 ms, about 4.6 hours, the timers that are due later wait in _overflow
+    static const int NUM_LEVELS = 4;
+
+    struct Timer {
+        qint64 due;
+        int interval;
+        bool isSingleShot;
+    };
+
+    void schedule(TimerID id, qint64 due);
+    void cascade(int level);
+    qint64 getNextTick() const;
+
+    // removed timers are left in their slot and skipped when it's reached, as the IDs aren't reused
+    std::unordered_map<TimerID, Timer> _timers;
+    std::vector<TimerID> _slots[NUM_LEVELS][SLOTS_PER_LEVEL];
+    // the slots of each level that have timers, one bit each
+    uint64_t _occupiedSlots[NUM_LEVELS] { 0, 0, 0, 0 };
+    std::vector<TimerID> _overflow;
+    qint64 _currentTick { 0 };
+    TimerID _nextID { 1 };
+};
+
+#endif // overte_ScriptTimerWheel_h
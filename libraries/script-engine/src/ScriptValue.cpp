@@ -30,6 +30,7 @@ public:
     virtual ScriptEnginePointer engine() const override;
     virtual bool equals(const ScriptValue& other) const override;
     virtual bool isArray() const override;
+    virtual bool isArrayBuffer() const override;
     virtual bool isBool() const override;
     virtual bool isError() const override;
     virtual bool isFunction() const override;
@@ -124,6 +125,10 @@ bool ScriptValueProxyNull::isArray() const {
     return false;
 }
 
+bool ScriptValueProxyNull::isArrayBuffer() const {
+    return false;
+}
+
 bool ScriptValueProxyNull::isBool() const {
     return false;
 }
@@ -77,6 +77,7 @@ public:
     inline ScriptEnginePointer engine() const;
     inline bool equals(const ScriptValue& other) const;
     inline bool isArray() const;
+    inline bool isArrayBuffer() const;
     inline bool isBool() const;
     inline bool isError() const;
     inline bool isFunction() const;
@@ -140,6 +141,7 @@ public:
     virtual ScriptEnginePointer engine() const = 0;
     virtual bool equals(const ScriptValue& other) const = 0;
     virtual bool isArray() const = 0;
+    virtual bool isArrayBuffer() const = 0;
     virtual bool isBool() const = 0;
     virtual bool isError() const = 0;
     virtual bool isFunction() const = 0;
@@ -255,6 +257,11 @@ bool ScriptValue::isArray() const {
     return _proxy->isArray();
 }
 
+bool ScriptValue::isArrayBuffer() const {
+    Q_ASSERT(_proxy != nullptr);
+    return _proxy->isArrayBuffer();
+}
+
 bool ScriptValue::isBool() const {
     Q_ASSERT(_proxy != nullptr);
     return _proxy->isBool();
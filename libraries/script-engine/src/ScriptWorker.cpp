@@ -0,0 +1,486 @@
+//
+//  ScriptWorker.cpp
+//  libraries/script-engine/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ScriptWorker.h"
+
+#include <atomic>
+#include <deque>
+
+#include <DependencyManager.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include "ScriptEngine.h"
+#include "ScriptEngineCast.h"
+#include "ScriptEngines.h"
+#include "ScriptException.h"
+#include "ScriptManager.h"
+#include "ScriptValueIterator.h"
+
+// the messages are walked recursively, the ones that are deeper than this are most likely cyclic
+static const int MAX_MESSAGE_DEPTH = 64;
+
+// A message, or an uncaught exception of the worker script, on its way to the other end of the worker
+struct ScriptWorkerMessage {
+    QVariant data;
+    QString error;
+    int lineNumber;
+};
+
+// The messages on their way to one end of the worker.  Its receiver is told to deliver them when the first one comes in,
+// the messages that are posted before there's a receiver wait for it, and the ones posted after it has closed are dropped.
+class ScriptWorkerInbox {
+public:
+    void post(ScriptWorkerMessage&& message) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_isClosed) {
+            return;
+        }
+        bool wasEmpty = _messages.empty();
+        _messages.push_back(std::move(message));
+        if (wasEmpty && _receiver) {
+            QMetaObject::invokeMethod(_receiver, "deliverMessages", Qt::QueuedConnection);
+        }
+    }
+
+    std::deque<ScriptWorkerMessage> take() {
+        std::deque<ScriptWorkerMessage> messages;
+        std::lock_guard<std::mutex> lock(_mutex);
+        messages.swap(_messages);
+        return messages;
+    }
+
+    void open(QObject* receiver) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _receiver = receiver;
+        if (!_messages.empty()) {
+            QMetaObject::invokeMethod(_receiver, "deliverMessages", Qt::QueuedConnection);
+        }
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _receiver = nullptr;
+        _isClosed = true;
+        _messages.clear();
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _messages.size();
+    }
+
+private:
+    std::mutex _mutex;
+    QObject* _receiver { nullptr };
+    bool _isClosed { false };
+    std::deque<ScriptWorkerMessage> _messages;
+};
+
+class ScriptWorkerChannel {
+public:
+    ScriptWorkerInbox parentInbox;
+    ScriptWorkerInbox workerInbox;
+
+    std::atomic<quint64> messagesToWorker { 0 };
+    std::atomic<quint64> messagesToParent { 0 };
+    // time spent by the worker script handling the messages, in microseconds
+    std::atomic<quint64> workerMessageTime { 0 };
+};
+
+static bool cloneValue(const ScriptValue& value, const ScriptValueList& transfer, QVariant& clone, int depth, QString& error) {
+    if (depth > MAX_MESSAGE_DEPTH) {
+        error = "The message is nested too deeply or refers to itself";
+        return false;
+    }
+    if (!value.isValid() || value.isUndefined()) {
+        clone = QVariant();
+        return true;
+    }
+    if (value.isNull()) {
+        clone = QVariant::fromValue(nullptr);
+        return true;
+    }
+    if (value.isBool() || value.isNumber() || value.isString()) {
+        clone = value.toVariant();
+        return true;
+    }
+    if (value.isArrayBuffer()) {
+        for (const auto& transferred : transfer) {
+            if (transferred.strictlyEquals(value)) {
+                clone = value.engine()->transferArrayBuffer(value);
+                return true;
+            }
+        }
+        clone = scriptvalue_cast<QByteArray>(value);
+        return true;
+    }
+    if (value.isFunction() || value.toQObject()) {
+        error = "Functions and API objects can't be posted to or from a worker";
+        return false;
+    }
+    if (value.isArray()) {
+        QVariantList list;
+        quint32 length = value.property("length").toUInt32();
+        list.reserve(length);
+        for (quint32 i = 0; i < length; i++) {
+            QVariant element;
+            if (!cloneValue(value.property(i), transfer, element, depth + 1, error)) {
+                return false;
+            }
+            list.append(element);
+        }
+        clone = list;
+        return true;
+    }
+    if (value.isObject()) {
+        QVariantMap map;
+        ScriptValueIteratorPointer iterator = value.newIterator();
+        while (iterator->hasNext()) {
+            iterator->next();
+            QVariant property;
+            if (!cloneValue(iterator->value(), transfer, property, depth + 1, error)) {
+                return false;
+            }
+            map.insert(iterator->name(), property);
+        }
+        clone = map;
+        return true;
+    }
+    clone = value.toVariant();
+    return true;
+}
+
+static bool cloneMessage(const ScriptValue& message, const ScriptValue& transfer, QVariant& clone, QString& error) {
+    ScriptValueList transferList;
+    if (transfer.isArray()) {
+        quint32 length = transfer.property("length").toUInt32();
+        for (quint32 i = 0; i < length; i++) {
+            ScriptValue buffer = transfer.property(i);
+            if (!buffer.isArrayBuffer()) {
+                error = "Only ArrayBuffers can be transferred to or from a worker";
+                return false;
+            }
+            transferList.append(buffer);
+        }
+    } else if (transfer.isValid() && !transfer.isUndefined() && !transfer.isNull()) {
+        error = "The ArrayBuffers to transfer have to be given as an array";
+        return false;
+    }
+    return cloneValue(message, transferList, clone, 0, error);
+}
+
+// Builds the value of a cloned message in the engine that receives it, taking the data of the ArrayBuffers out of the clone
+// so that they aren't shared with it and can be handed over without a copy
+static ScriptValue rebuildValue(ScriptEngine* engine, QVariant& clone) {
+    switch (clone.userType()) {
+        case QMetaType::UnknownType:
+            return engine->undefinedValue();
+        case QMetaType::Nullptr:
+            return engine->nullValue();
+        case QMetaType::Bool:
+            return engine->newValue(clone.toBool());
+        case QMetaType::QString:
+            return engine->newValue(clone.toString());
+        case QMetaType::QByteArray: {
+            QByteArray data = clone.toByteArray();
+            clone = QVariant();
+            return engine->newArrayBuffer(std::move(data));
+        }
+        case QMetaType::QVariantList: {
+            QVariantList list = clone.toList();
+            clone = QVariant();
+            ScriptValue array = engine->newArray(list.size());
+            for (int i = 0; i < list.size(); i++) {
+                array.setProperty(i, rebuildValue(engine, list[i]));
+            }
+            return array;
+        }
+        case QMetaType::QVariantMap: {
+            QVariantMap map = clone.toMap();
+            clone = QVariant();
+            ScriptValue object = engine->newObject();
+            for (auto itr = map.begin(); itr != map.end(); ++itr) {
+                object.setProperty(itr.key(), rebuildValue(engine, itr.value()));
+            }
+            return object;
+        }
+        default:
+            if (clone.canConvert<double>()) {
+                return engine->newValue(clone.toDouble());
+            }
+            return engine->toScriptValue(clone);
+    }
+}
+
+ScriptWorker::ScriptWorker(ScriptManager* parent, const QUrl& url) :
+    QObject(parent),
+    _parent(parent),
+    _url(url),
+    _channel(std::make_shared<ScriptWorkerChannel>())
+{
+    _channel->parentInbox.open(this);
+
+    connect(parent, &ScriptManager::scriptEnding, this, [this] {
+        terminate();
+        // the handlers belong to the engine of the parent script, which is going away
+        _channel->parentInbox.close();
+        _onMessage = ScriptValue();
+        _onError = ScriptValue();
+    });
+}
+
+ScriptWorker::~ScriptWorker() {
+    _channel->parentInbox.close();
+    terminate();
+    release();
+}
+
+bool ScriptWorker::start() {
+    auto scriptEngines = DependencyManager::get<ScriptEngines>();
+    if (!scriptEngines || !scriptEngines->addScriptWorker(this)) {
+        return false;
+    }
+    _isInPool = true;
+
+    auto manager = newScriptManager(ScriptManager::WORKER_SCRIPT, NO_SCRIPT, _url.toString());
+    manager->setScriptEngines(scriptEngines);
+    // ScriptEngines stops the worker when scripting shuts down
+    scriptEngines->addScriptEngine(manager);
+
+    connect(manager.get(), &ScriptManager::scriptLoaded, this, &ScriptWorker::onLoaded);
+    connect(manager.get(), &ScriptManager::errorLoadingScript, this, &ScriptWorker::onLoadError);
+    connect(manager.get(), &ScriptManager::doneRunning, this, &ScriptWorker::onDoneRunning);
+    // the exceptions are reported in order with the messages, through the channel that outlives both ends
+    auto channel = _channel;
+    connect(manager.get(), &ScriptManager::unhandledException, manager.get(),
+            [channel](std::shared_ptr<ScriptException> exception) {
+        if (exception) {
+            channel->parentInbox.post({ QVariant(), exception->errorMessage, exception->errorLine });
+        }
+    }, Qt::DirectConnection);
+
+    {
+        std::lock_guard<std::mutex> lock(_managerMutex);
+        _manager = manager;
+    }
+    manager->loadURL(_url, false);
+    return true;
+}
+
+bool ScriptWorker::isRunning() const {
+    std::lock_guard<std::mutex> lock(_managerMutex);
+    return _manager && !_manager->isStopping();
+}
+
+void ScriptWorker::postMessage(const ScriptValue& message, const ScriptValue& transfer) {
+    auto engine = _parent->engine();
+    ScriptWorkerMessage clone { QVariant(), QString(), -1 };
+    QString error;
+    if (!cloneMessage(message, transfer, clone.data, error)) {
+        engine->raiseException(error, "DataCloneError");
+        return;
+    }
+    _channel->messagesToWorker++;
+    _channel->workerInbox.post(std::move(clone));
+}
+
+void ScriptWorker::terminate() {
+    std::lock_guard<std::mutex> lock(_managerMutex);
+    if (_manager && !_manager->isStopping()) {
+        _channel->workerInbox.close();
+        _manager->stop(true);
+        // interrupts the script if it's in the middle of a computation
+        _manager->engine()->abortEvaluation();
+    }
+}
+
+/*@jsdoc
+ * Statistics of a script worker.
+ * @typedef {object} ScriptWorker.Statistics
+ * @property {string} url - The URL of the worker script.
+ * @property {boolean} running - <code>true</code> while the worker script is loading or running.
+ * @property {number} messagesPosted - The number of messages posted to the worker.
+ * @property {number} messagesReceived - The number of messages that the worker posted back.
+ * @property {number} pendingMessages - The number of messages that haven't been handled yet, both ways.
+ * @property {number} messageTime - The time that the worker spent handling its messages, in ms.
+ * @property {number} numTimers - The number of timers of the worker that are waiting to fire.
+ * @property {number} heapUsed - The size of the objects on the heap of the worker, in bytes, as of its last garbage
+ *     collection.
+ * @property {number} gcCount - The number of garbage collections of the worker.
+ * @property {number} gcTime - The time that the worker was paused by its garbage collections, in ms.
+ */
+QVariantMap ScriptWorker::getStatistics() const {
+    QVariantMap statistics;
+    statistics.insert("url", getURL());
+    statistics.insert("messagesPosted", (double)_channel->messagesToWorker);
+    statistics.insert("messagesReceived", (double)_channel->messagesToParent);
+    statistics.insert("pendingMessages", (double)(_channel->workerInbox.size() + _channel->parentInbox.size()));
+    statistics.insert("messageTime", (double)_channel->workerMessageTime / USECS_PER_MSEC);
+
+    std::lock_guard<std::mutex> lock(_managerMutex);
+    statistics.insert("running", _manager && !_manager->isStopping());
+    if (_manager) {
+        statistics.insert("numTimers", _manager->getNumTimers());
+        ScriptEngineProfilingStatistics engineStatistics = _manager->engine()->getProfilingStatistics();
+        statistics.insert("heapUsed", (double)engineStatistics.usedHeapSize);
+        statistics.insert("gcCount", (double)engineStatistics.gcCount);
+        statistics.insert("gcTime", (double)engineStatistics.gcPauseTime / USECS_PER_MSEC);
+    }
+    return statistics;
+}
+
+/*@jsdoc
+ * Called when the worker posts a message.
+ * @callback ScriptWorker~onMessageCallback
+ * @param {ScriptWorker.MessageEvent} event - The message.
+ */
+/*@jsdoc
+ * A message posted by a worker or to it.
+ * @typedef {object} ScriptWorker.MessageEvent
+ * @property {*} data - The message.
+ */
+/*@jsdoc
+ * Called when the worker script fails to load or throws an exception that it doesn't catch.
+ * @callback ScriptWorker~onErrorCallback
+ * @param {ScriptWorker.ErrorEvent} event - The error.
+ */
+/*@jsdoc
+ * An error of a worker script.
+ * @typedef {object} ScriptWorker.ErrorEvent
+ * @property {string} message - The error message.
+ * @property {string} filename - The URL of the worker script.
+ * @property {number} lineno - The line at which the exception was thrown, <code>-1</code> if the script failed to load.
+ */
+void ScriptWorker::deliverMessages() {
+    auto engine = _parent->engine();
+    for (auto& message : _channel->parentInbox.take()) {
+        if (!message.error.isEmpty()) {
+            if (_onError.isFunction()) {
+                ScriptValue event = engine->newObject();
+                event.setProperty("message", message.error);
+                event.setProperty("filename", getURL());
+                event.setProperty("lineno", message.lineNumber);
+                _onError.call(ScriptValue(), ScriptValueList({ event }));
+            }
+        } else if (_onMessage.isFunction()) {
+            ScriptValue event = engine->newObject();
+            event.setProperty("data", rebuildValue(engine.get(), message.data));
+            _onMessage.call(ScriptValue(), ScriptValueList({ event }));
+        }
+    }
+}
+
+void ScriptWorker::onLoaded() {
+    ScriptManagerPointer manager;
+    {
+        std::lock_guard<std::mutex> lock(_managerMutex);
+        manager = _manager;
+    }
+    if (!manager) {
+        return;
+    }
+    if (manager->isStopping()) {
+        // terminated while it was loading
+        release();
+        return;
+    }
+
+    // the Worker object is a child of the manager and moves to the thread of the worker with it
+    auto scope = new ScriptWorkerScope(manager.get(), _channel);
+    manager->engine()->registerGlobalObject("Worker", scope);
+    manager->runInThread();
+}
+
+void ScriptWorker::onLoadError(const QString& url) {
+    _channel->parentInbox.post({ QVariant(), "Failed to load the worker script " + url, -1 });
+    release();
+}
+
+void ScriptWorker::onDoneRunning() {
+    release();
+}
+
+void ScriptWorker::release() {
+    ScriptManagerPointer manager;
+    {
+        std::lock_guard<std::mutex> lock(_managerMutex);
+        manager.swap(_manager);
+    }
+    auto scriptEngines = DependencyManager::get<ScriptEngines>();
+    if (!scriptEngines) {
+        return;
+    }
+    if (_isInPool) {
+        _isInPool = false;
+        scriptEngines->removeScriptWorker(this);
+    }
+    if (manager) {
+        scriptEngines->removeScriptEngine(manager);
+    }
+}
+
+ScriptWorkerScope::ScriptWorkerScope(ScriptManager* manager, std::shared_ptr<ScriptWorkerChannel> channel) :
+    QObject(manager),
+    _manager(manager),
+    _channel(channel)
+{
+    _channel->workerInbox.open(this);
+
+    connect(manager, &ScriptManager::scriptEnding, this, [this] {
+        // the handler belongs to the engine of the worker, which is going away
+        _channel->workerInbox.close();
+        _onMessage = ScriptValue();
+    });
+}
+
+ScriptWorkerScope::~ScriptWorkerScope() {
+    _channel->workerInbox.close();
+}
+
+void ScriptWorkerScope::postMessage(const ScriptValue& message, const ScriptValue& transfer) {
+    auto engine = _manager->engine();
+    ScriptWorkerMessage clone { QVariant(), QString(), -1 };
+    QString error;
+    if (!cloneMessage(message, transfer, clone.data, error)) {
+        engine->raiseException(error, "DataCloneError");
+        return;
+    }
+    _channel->messagesToParent++;
+    _channel->parentInbox.post(std::move(clone));
+}
+
+void ScriptWorkerScope::close() {
+    _channel->workerInbox.close();
+    _manager->stop();
+}
+
+/*@jsdoc
+ * Called when the script that started the worker posts a message to it.
+ * @callback Worker~onMessageCallback
+ * @param {ScriptWorker.MessageEvent} event - The message.
+ */
+void ScriptWorkerScope::deliverMessages() {
+    auto engine = _manager->engine();
+    for (auto& message : _channel->workerInbox.take()) {
+        if (_manager->isStopping()) {
+            break;
+        }
+        if (!_onMessage.isFunction()) {
+            continue;
+        }
+        quint64 start = usecTimestampNow();
+        ScriptValue event = engine->newObject();
+        event.setProperty("data", rebuildValue(engine.get(), message.data));
+        _onMessage.call(ScriptValue(), ScriptValueList({ event }));
+        _channel->workerMessageTime += usecTimestampNow() - start;
+    }
+}
@@ -0,0 +1,195 @@
+//
+//  ScriptWorker.h
+//  libraries/script-engine/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+/// @addtogroup ScriptEngine
+/// @{
+
+#ifndef overte_ScriptWorker_h
+#define overte_ScriptWorker_h
+
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QObject>
+#include <QtCore/QUrl>
+#include <QtCore/QVariant>
+
+#include "ScriptValue.h"
+
+class ScriptManager;
+class ScriptWorkerChannel;
+using ScriptManagerPointer = std::shared_ptr<ScriptManager>;
+
+/*@jsdoc
+ * A script that runs on a thread of its own, started with {@link Script.createWorker}, so that heavy computations don't hold
+ * up the script that started it. The two scripts exchange messages with <code>postMessage</code>: the messages are copied,
+ * except for the <code>ArrayBuffer</code>s that are listed as transferred, which are handed over without copying their
+ * contents. The worker script uses the {@link Worker} API to receive and post messages.
+ *
+ * @class ScriptWorker
+ *
+ * @hifi-interface
+ * @hifi-client-entity
+ * @hifi-avatar
+ * @hifi-server-entity
+ * @hifi-assignment-client
+ *
+ * @property {string} url - The URL of the worker script. <em>Read-only.</em>
+ * @property {boolean} running - <code>true</code> while the worker script is loading or running, <code>false</code> once it
+ *     has finished or has been terminated. <em>Read-only.</em>
+ * @property {ScriptWorker~onMessageCallback} onmessage - Function called when the worker posts a message.
+ * @property {ScriptWorker~onErrorCallback} onerror - Function called when the worker script fails to load or throws an
+ *     exception that it doesn't catch.
+ *
+ * @example <caption>Sum an array in a worker.</caption>
+ * // sum.js
+ * Worker.onmessage = function (event) {
+ *     var values = new Float64Array(event.data);
+ *     var sum = 0;
+ *     for (var i = 0; i < values.length; i++) {
+ *         sum += values[i];
+ *     }
+ *     Worker.postMessage({ sum: sum });
+ * };
+ *
+ * // main.js
+ * var worker = Script.createWorker("sum.js");
+ * worker.onmessage = function (event) {
+ *     print("Sum:", event.data.sum);
+ *     worker.terminate();
+ * };
+ * var values = new Float64Array(1000000).fill(0.5);
+ * worker.postMessage(values.buffer, [values.buffer]);
+ */
+/// The object through which a script talks to a worker that it started with ScriptManager::createWorker.  The worker runs
+/// in a ScriptManager of its own, in the WORKER_SCRIPT context, and the messages between the two are cloned into QVariants
+/// that the other engine builds them again from, except for the transferred ArrayBuffers whose data is handed over.
+class ScriptWorker : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(QString url READ getURL CONSTANT)
+    Q_PROPERTY(bool running READ isRunning)
+    Q_PROPERTY(ScriptValue onmessage READ getOnMessage WRITE setOnMessage)
+    Q_PROPERTY(ScriptValue onerror READ getOnError WRITE setOnError)
+
+public:
+    ScriptWorker(ScriptManager* parent, const QUrl& url);
+    ~ScriptWorker();
+
+    /// Starts loading the worker script, returns false if the pool of workers of ScriptEngines is full
+    bool start();
+
+    QString getURL() const { return _url.toString(); }
+    bool isRunning() const;
+
+    ScriptValue getOnMessage() const { return _onMessage; }
+    void setOnMessage(const ScriptValue& function) { _onMessage = function; }
+    ScriptValue getOnError() const { return _onError; }
+    void setOnError(const ScriptValue& function) { _onError = function; }
+
+public slots:
+
+    /*@jsdoc
+     * Posts a message to the worker, which receives it in {@link Worker.onmessage}.
+     * @function ScriptWorker.postMessage
+     * @param {*} message - The message. It can be made of numbers, strings, booleans, <code>null</code>, arrays, plain
+     *     objects and <code>ArrayBuffer</code>s, which are copied. Functions and API objects can't be posted.
+     * @param {ArrayBuffer[]} [transfer=[]] - <code>ArrayBuffer</code>s of the message to hand over to the worker instead of
+     *     copying them. They are empty in this script afterwards.
+     */
+    void postMessage(const ScriptValue& message, const ScriptValue& transfer = ScriptValue());
+
+    /*@jsdoc
+     * Stops the worker straight away, even if it's in the middle of a computation. The messages that it hasn't received
+     * yet are discarded.
+     * @function ScriptWorker.terminate
+     */
+    void terminate();
+
+    /*@jsdoc
+     * Gets the statistics of the worker.
+     * @function ScriptWorker.getStatistics
+     * @returns {ScriptWorker.Statistics} The statistics of the worker.
+     */
+    // This can be called from any thread
+    QVariantMap getStatistics() const;
+
+private slots:
+    void deliverMessages();
+    void onLoaded();
+    void onLoadError(const QString& url);
+    void onDoneRunning();
+
+private:
+    void release();
+
+    ScriptManager* _parent;
+    QUrl _url;
+    std::shared_ptr<ScriptWorkerChannel> _channel;
+    // guards _manager, which the statistics are read from on other threads
+    mutable std::mutex _managerMutex;
+    ScriptManagerPointer _manager;
+    bool _isInPool { false };
+
+    ScriptValue _onMessage;
+    ScriptValue _onError;
+};
+
+/*@jsdoc
+ * The <code>Worker</code> API is available in worker scripts, started by other scripts with {@link Script.createWorker}. It
+ * receives the messages of the script that started the worker and posts messages back to it.
+ * <p>Worker scripts run with a minimal API: {@link Script}, {@link Vec3}, {@link Quat}, {@link Mat4}, {@link Uuid},
+ * {@link console}, {@link print} and <code>Worker</code>.</p>
+ *
+ * @namespace Worker
+ *
+ * @property {Worker~onMessageCallback} onmessage - Function called when the script that started the worker posts a
+ *     message to it.
+ */
+/// Provides the Worker object of a worker script, the other end of its ScriptWorker
+class ScriptWorkerScope : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(ScriptValue onmessage READ getOnMessage WRITE setOnMessage)
+
+public:
+    ScriptWorkerScope(ScriptManager* manager, std::shared_ptr<ScriptWorkerChannel> channel);
+    ~ScriptWorkerScope();
+
+    ScriptValue getOnMessage() const { return _onMessage; }
+    void setOnMessage(const ScriptValue& function) { _onMessage = function; }
+
+public slots:
+
+    /*@jsdoc
+     * Posts a message to the script that started the worker, which receives it in {@link ScriptWorker.onmessage}.
+     * @function Worker.postMessage
+     * @param {*} message - The message, made of the same values as the messages of {@link ScriptWorker.postMessage}.
+     * @param {ArrayBuffer[]} [transfer=[]] - <code>ArrayBuffer</code>s of the message to hand over instead of copying them.
+     */
+    void postMessage(const ScriptValue& message, const ScriptValue& transfer = ScriptValue());
+
+    /*@jsdoc
+     * Stops the worker once the current function returns.
+     * @function Worker.close
+     */
+    void close();
+
+private slots:
+    void deliverMessages();
+
+private:
+    ScriptManager* _manager;
+    std::shared_ptr<ScriptWorkerChannel> _channel;
+    ScriptValue _onMessage;
+};
+
+#endif // overte_ScriptWorker_h
+
+/// @}
@@ -0,0 +1,91 @@
+//
+//  ByteArrayBackingStore.cpp
+//  libraries/script-engine/src/v8
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ByteArrayBackingStore.h"
+
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include "ScriptEngineLoggingV8.h"
+
+#ifndef V8_ENABLE_SANDBOX
+
+// The QByteArrays that the backing stores made by newByteArrayBuffer hold, by their data.  V8 may free a backing store
+// on any of its threads.
+static std::mutex byteArraysMutex;
+static std::unordered_map<const void*, QByteArray*> byteArrays;
+
+static void deleteByteArray(void* data, size_t length, void* deleterData) {
+    std::lock_guard<std::mutex> lock(byteArraysMutex);
+    byteArrays.erase(data);
+    delete static_cast<QByteArray*>(deleterData);
+}
+
+v8::Local<v8::ArrayBuffer> newByteArrayBuffer(v8::Isolate* isolate, QByteArray byteArray) {
+    if (byteArray.isEmpty()) {
+        return v8::ArrayBuffer::New(isolate, 0);
+    }
+    auto holder = new QByteArray(std::move(byteArray));
+    // this copies the data if it's still shared, so that the writes of the script don't change the other QByteArrays
+    char* data = holder->data();
+    size_t length = holder->size();
+    {
+        std::lock_guard<std::mutex> lock(byteArraysMutex);
+        byteArrays[data] = holder;
+    }
+    std::shared_ptr<v8::BackingStore> backingStore = v8::ArrayBuffer::NewBackingStore(data, length, deleteByteArray, holder);
+    return v8::ArrayBuffer::New(isolate, backingStore);
+}
+
+QByteArray byteArrayFromArrayBuffer(v8::Local<v8::ArrayBuffer> arrayBuffer, bool transfer) {
+    QByteArray result;
+    if (transfer && arrayBuffer->IsDetachable()) {
+        std::shared_ptr<v8::BackingStore> backingStore = arrayBuffer->GetBackingStore();
+        {
+            std::lock_guard<std::mutex> lock(byteArraysMutex);
+            auto itr = byteArrays.find(backingStore->Data());
+            if (itr != byteArrays.end()) {
+                result = *itr->second;
+            }
+        }
+        if (result.isNull()) {
+            result = QByteArray(static_cast<const char*>(backingStore->Data()), (int)backingStore->ByteLength());
+        }
+        // once the script can't reach the data, the QByteArrays are the only ones to use it
+        if (arrayBuffer->Detach(v8::Local<v8::Value>()).IsNothing()) {
+            // the buffer stays attached to the script, which may still write to it
+            result.detach();
+        }
+        return result;
+    }
+    result.resize((int)arrayBuffer->ByteLength());
+    memcpy(result.data(), arrayBuffer->Data(), arrayBuffer->ByteLength());
+    return result;
+}
+
+#else
+
+v8::Local<v8::ArrayBuffer> newByteArrayBuffer(v8::Isolate* isolate, QByteArray byteArray) {
+    v8::Local<v8::ArrayBuffer> arrayBuffer = v8::ArrayBuffer::New(isolate, byteArray.size());
+    memcpy(arrayBuffer->Data(), byteArray.constData(), byteArray.size());
+    return arrayBuffer;
+}
+
+QByteArray byteArrayFromArrayBuffer(v8::Local<v8::ArrayBuffer> arrayBuffer, bool transfer) {
+    QByteArray result(static_cast<const char*>(arrayBuffer->Data()), (int)arrayBuffer->ByteLength());
+    if (transfer && arrayBuffer->IsDetachable() && arrayBuffer->Detach(v8::Local<v8::Value>()).IsNothing()) {
+        qCWarning(scriptengine_v8) << "Unable to detach a transferred ArrayBuffer";
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,36 @@
+//
+//  ByteArrayBackingStore.h
+//  libraries/script-engine/src/v8
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+/// @addtogroup ScriptEngine
+/// @{
+
+#ifndef overte_ByteArrayBackingStore_h
+#define overte_ByteArrayBackingStore_h
+
+#include <QtCore/QByteArray>
+
+#include "v8.h"
+
+// ArrayBuffers whose memory is the data of a QByteArray, so that native data reaches the scripts without being copied,
+// and comes back from them without a copy when they transfer it.  V8 builds with the sandbox can't use memory they didn't
+// allocate, with those the data is copied in and out as usual.
+
+// Returns an ArrayBuffer holding the data of byteArray.  The script can write to the buffer, so the data is only used
+// without a copy if byteArray is the only QByteArray referencing it; callers that are done with their data move it in.
+v8::Local<v8::ArrayBuffer> newByteArrayBuffer(v8::Isolate* isolate, QByteArray byteArray);
+
+// Returns the data of arrayBuffer.  When transfer is true the buffer is detached, the script sees it as empty from then
+// on, and if it was made by newByteArrayBuffer its data is returned without a copy.
+QByteArray byteArrayFromArrayBuffer(v8::Local<v8::ArrayBuffer> arrayBuffer, bool transfer);
+
+#endif  // overte_ByteArrayBackingStore_h
+
+/// @}
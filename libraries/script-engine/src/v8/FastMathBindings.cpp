@@ -0,0 +1,404 @@
+//
+//  FastMathBindings.cpp
+//  libraries/script-engine/src/v8
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "FastMathBindings.h"
+
+#include <cfloat>
+#include <cstring>
+
+#include <GLMHelpers.h>
+
+#include "FastScriptValueUtils.h"
+#include "ScriptEngineV8.h"
+#include "ScriptValueV8Wrapper.h"
+
+static const char* KEY_NAMES[] = {
+    "x", "y", "z", "w",
+    "r0c0", "r1c0", "r2c0", "r3c0",
+    "r0c1", "r1c1", "r2c1", "r3c1",
+    "r0c2", "r1c2", "r2c2", "r3c2",
+    "r0c3", "r1c3", "r2c3", "r3c3"
+};
+
+// The arguments are read and the results built by type, so that the methods below are only their math
+
+static bool readArgument(FastMathBindings& bindings, v8::Local<v8::Context> context, v8::Local<v8::Value> value, float& number) {
+    if (!value->IsNumber()) {
+        return false;
+    }
+    number = (float)v8::Local<v8::Number>::Cast(value)->Value();
+    return true;
+}
+
+static bool readArgument(FastMathBindings& bindings, v8::Local<v8::Context> context, v8::Local<v8::Value> value, glm::vec3& vec3) {
+    return bindings.readVec3(context, value, vec3);
+}
+
+static bool readArgument(FastMathBindings& bindings, v8::Local<v8::Context> context, v8::Local<v8::Value> value, glm::quat& quat) {
+    return bindings.readQuat(context, value, quat);
+}
+
+static bool readArgument(FastMathBindings& bindings, v8::Local<v8::Context> context, v8::Local<v8::Value> value, glm::mat4& mat4) {
+    return bindings.readMat4(context, value, mat4);
+}
+
+static v8::Local<v8::Value> toValue(FastMathBindings& bindings, v8::Local<v8::Context> context, float number) {
+    return v8::Number::New(context->GetIsolate(), number);
+}
+
+static v8::Local<v8::Value> toValue(FastMathBindings& bindings, v8::Local<v8::Context> context, const glm::vec3& vec3) {
+    return bindings.newVec3(context, vec3);
+}
+
+static v8::Local<v8::Value> toValue(FastMathBindings& bindings, v8::Local<v8::Context> context, const glm::quat& quat) {
+    return bindings.newQuat(context, quat);
+}
+
+static v8::Local<v8::Value> toValue(FastMathBindings& bindings, v8::Local<v8::Context> context, const glm::mat4& mat4) {
+    return bindings.newMat4(context, mat4);
+}
+
+template <typename R, typename A, R (*op)(const A&)>
+static bool nativeCall(FastMathBindings& bindings, v8::Local<v8::Context> context, const v8::FunctionCallbackInfo<v8::Value>& info) {
+    A a;
+    if (info.Length() != 1 || !readArgument(bindings, context, info[0], a)) {
+        return false;
+    }
+    info.GetReturnValue().Set(toValue(bindings, context, op(a)));
+    return true;
+}
+
+template <typename R, typename A, typename B, R (*op)(const A&, const B&)>
+static bool nativeCall(FastMathBindings& bindings, v8::Local<v8::Context> context, const v8::FunctionCallbackInfo<v8::Value>& info) {
+    A a;
+    B b;
+    if (info.Length() != 2 || !readArgument(bindings, context, info[0], a) || !readArgument(bindings, context, info[1], b)) {
+        return false;
+    }
+    info.GetReturnValue().Set(toValue(bindings, context, op(a, b)));
+    return true;
+}
+
+template <typename R, typename A, typename B, typename C, R (*op)(const A&, const B&, const C&)>
+static bool nativeCall(FastMathBindings& bindings, v8::Local<v8::Context> context, const v8::FunctionCallbackInfo<v8::Value>& info) {
+    A a;
+    B b;
+    C c;
+    if (info.Length() != 3 || !readArgument(bindings, context, info[0], a) || !readArgument(bindings, context, info[1], b) ||
+        !readArgument(bindings, context, info[2], c)) {
+        return false;
+    }
+    info.GetReturnValue().Set(toValue(bindings, context, op(a, b, c)));
+    return true;
+}
+
+// These are the same as the slots of Vec3, Quat and Mat4
+
+static glm::vec3 vec3Sum(const glm::vec3& v1, const glm::vec3& v2) { return v1 + v2; }
+static glm::vec3 vec3Subtract(const glm::vec3& v1, const glm::vec3& v2) { return v1 - v2; }
+static glm::vec3 vec3MultiplyVbyV(const glm::vec3& v1, const glm::vec3& v2) { return v1 * v2; }
+static glm::vec3 vec3MultiplyQbyV(const glm::quat& q, const glm::vec3& v) { return q * v; }
+static float vec3Dot(const glm::vec3& v1, const glm::vec3& v2) { return glm::dot(v1, v2); }
+static glm::vec3 vec3Cross(const glm::vec3& v1, const glm::vec3& v2) { return glm::cross(v1, v2); }
+static float vec3Length(const glm::vec3& v) { return glm::length(v); }
+static float vec3Distance(const glm::vec3& v1, const glm::vec3& v2) { return glm::distance(v1, v2); }
+static glm::vec3 vec3Normalize(const glm::vec3& v) { return glm::normalize(v); }
+static glm::vec3 vec3Mix(const glm::vec3& v1, const glm::vec3& v2, const float& m) { return glm::mix(v1, v2, m); }
+
+static glm::quat quatMultiply(const glm::quat& q1, const glm::quat& q2) { return q1 * q2; }
+static glm::quat quatNormalize(const glm::quat& q) { return glm::normalize(q); }
+static glm::quat quatConjugate(const glm::quat& q) { return glm::conjugate(q); }
+static glm::quat quatInverse(const glm::quat& q) { return glm::inverse(q); }
+static glm::vec3 quatGetForward(const glm::quat& orientation) { return orientation * Vectors::FRONT; }
+static glm::vec3 quatGetRight(const glm::quat& orientation) { return orientation * Vectors::RIGHT; }
+static glm::vec3 quatGetUp(const glm::quat& orientation) { return orientation * Vectors::UP; }
+
+static glm::mat4 mat4Multiply(const glm::mat4& m1, const glm::mat4& m2) { return m1 * m2; }
+static glm::vec3 mat4TransformPoint(const glm::mat4& m, const glm::vec3& point) { return ::transformPoint(m, point); }
+static glm::vec3 mat4TransformVector(const glm::mat4& m, const glm::vec3& vector) { return ::transformVectorFast(m, vector); }
+static glm::mat4 mat4Inverse(const glm::mat4& m) { return glm::inverse(m); }
+
+// Vec3.multiply is overloaded, the vector can be either argument
+static bool vec3Multiply(FastMathBindings& bindings, v8::Local<v8::Context> context, const v8::FunctionCallbackInfo<v8::Value>& info) {
+    glm::vec3 v;
+    float f;
+    if (info.Length() != 2) {
+        return false;
+    }
+    if (info[0]->IsNumber()) {
+        if (!readArgument(bindings, context, info[0], f) || !readArgument(bindings, context, info[1], v)) {
+            return false;
+        }
+    } else if (!readArgument(bindings, context, info[0], v) || !readArgument(bindings, context, info[1], f)) {
+        return false;
+    }
+    info.GetReturnValue().Set(bindings.newVec3(context, v * f));
+    return true;
+}
+
+struct NativeMethod {
+    const char* name;
+    FastMathBindings::NativeCall call;
+    int length;
+};
+
+static const std::vector<NativeMethod> VEC3_METHODS = {
+    { "sum", nativeCall<glm::vec3, glm::vec3, glm::vec3, vec3Sum>, 2 },
+    { "subtract", nativeCall<glm::vec3, glm::vec3, glm::vec3, vec3Subtract>, 2 },
+    { "multiply", vec3Multiply, 2 },
+    { "multiplyVbyV", nativeCall<glm::vec3, glm::vec3, glm::vec3, vec3MultiplyVbyV>, 2 },
+    { "multiplyQbyV", nativeCall<glm::vec3, glm::quat, glm::vec3, vec3MultiplyQbyV>, 2 },
+    { "dot", nativeCall<float, glm::vec3, glm::vec3, vec3Dot>, 2 },
+    { "cross", nativeCall<glm::vec3, glm::vec3, glm::vec3, vec3Cross>, 2 },
+    { "length", nativeCall<float, glm::vec3, vec3Length>, 1 },
+    { "distance", nativeCall<float, glm::vec3, glm::vec3, vec3Distance>, 2 },
+    { "normalize", nativeCall<glm::vec3, glm::vec3, vec3Normalize>, 1 },
+    { "mix", nativeCall<glm::vec3, glm::vec3, glm::vec3, float, vec3Mix>, 3 }
+};
+
+static const std::vector<NativeMethod> QUAT_METHODS = {
+    { "multiply", nativeCall<glm::quat, glm::quat, glm::quat, quatMultiply>, 2 },
+    { "normalize", nativeCall<glm::quat, glm::quat, quatNormalize>, 1 },
+    { "conjugate", nativeCall<glm::quat, glm::quat, quatConjugate>, 1 },
+    { "inverse", nativeCall<glm::quat, glm::quat, quatInverse>, 1 },
+    { "getForward", nativeCall<glm::vec3, glm::quat, quatGetForward>, 1 },
+    { "getFront", nativeCall<glm::vec3, glm::quat, quatGetForward>, 1 },
+    { "getRight", nativeCall<glm::vec3, glm::quat, quatGetRight>, 1 },
+    { "getUp", nativeCall<glm::vec3, glm::quat, quatGetUp>, 1 }
+};
+
+static const std::vector<NativeMethod> MAT4_METHODS = {
+    { "multiply", nativeCall<glm::mat4, glm::mat4, glm::mat4, mat4Multiply>, 2 },
+    { "transformPoint", nativeCall<glm::vec3, glm::mat4, glm::vec3, mat4TransformPoint>, 2 },
+    { "transformVector", nativeCall<glm::vec3, glm::mat4, glm::vec3, mat4TransformVector>, 2 },
+    { "inverse", nativeCall<glm::mat4, glm::mat4, mat4Inverse>, 1 }
+};
+
+static const std::vector<NativeMethod>* getNativeMethods(const QString& name) {
+    if (name == "Vec3") {
+        return &VEC3_METHODS;
+    } else if (name == "Quat") {
+        return &QUAT_METHODS;
+    } else if (name == "Mat4") {
+        return &MAT4_METHODS;
+    }
+    return nullptr;
+}
+
+v8::Local<v8::Object> FastMathBindings::wrapGlobalObject(const QString& name, v8::Local<v8::Object> proxyObject) {
+    const std::vector<NativeMethod>* nativeMethods = getNativeMethods(name);
+    if (!nativeMethods) {
+        return proxyObject;
+    }
+
+    auto isolate = _engine->getIsolate();
+    v8::EscapableHandleScope handleScope(isolate);
+    auto context = _engine->getContext();
+    v8::Context::Scope contextScope(context);
+
+    v8::Local<v8::Array> propertyNames;
+    if (!proxyObject->GetPropertyNames(context).ToLocal(&propertyNames)) {
+        return handleScope.Escape(proxyObject);
+    }
+    v8::Local<v8::Object> object = v8::Object::New(isolate);
+    for (uint32_t i = 0; i < propertyNames->Length(); i++) {
+        v8::Local<v8::Value> propertyName;
+        if (!propertyNames->Get(context, i).ToLocal(&propertyName) || !propertyName->IsString()) {
+            continue;
+        }
+        v8::Local<v8::String> propertyNameString = v8::Local<v8::String>::Cast(propertyName);
+        v8::String::Utf8Value utf8Name(isolate, propertyNameString);
+
+        const NativeMethod* nativeMethod = nullptr;
+        for (const auto& method : *nativeMethods) {
+            if (strcmp(method.name, *utf8Name) == 0) {
+                nativeMethod = &method;
+                break;
+            }
+        }
+        v8::Local<v8::Value> proxyMethod;
+        if (nativeMethod && proxyObject->Get(context, propertyNameString).ToLocal(&proxyMethod) && proxyMethod->IsFunction()) {
+            auto method = std::make_unique<Method>();
+            method->bindings = this;
+            method->nativeCall = nativeMethod->call;
+            method->proxyMethod.Reset(isolate, proxyMethod);
+            auto function = v8::Function::New(context, callMethod, v8::External::New(isolate, method.get()),
+                                              nativeMethod->length).ToLocalChecked();
+            function->SetName(propertyNameString);
+            _methods.push_back(std::move(method));
+            if (!object->CreateDataProperty(context, propertyNameString, function).FromMaybe(false)) {
+                Q_ASSERT(false);
+            }
+        } else if (!object->SetAccessor(context, propertyNameString, forwardGetter, forwardSetter, proxyObject).FromMaybe(false)) {
+            Q_ASSERT(false);
+        }
+    }
+    return handleScope.Escape(object);
+}
+
+void FastMathBindings::callMethod(const v8::FunctionCallbackInfo<v8::Value>& info) {
+    Method* method = static_cast<Method*>(v8::Local<v8::External>::Cast(info.Data())->Value());
+    auto isolate = info.GetIsolate();
+    auto context = isolate->GetCurrentContext();
+    {
+        // the getters of the components can throw, the proxy method mustn't be called then
+        v8::TryCatch tryCatch(isolate);
+        if (method->nativeCall(*method->bindings, context, info)) {
+            return;
+        }
+        if (tryCatch.HasCaught()) {
+            tryCatch.ReThrow();
+            return;
+        }
+    }
+
+    std::vector<v8::Local<v8::Value>> arguments;
+    arguments.reserve(info.Length());
+    for (int i = 0; i < info.Length(); i++) {
+        arguments.push_back(info[i]);
+    }
+    v8::Local<v8::Function> proxyMethod = v8::Local<v8::Function>::Cast(v8::Local<v8::Value>::New(isolate, method->proxyMethod));
+    v8::Local<v8::Value> result;
+    if (proxyMethod->Call(context, info.This(), (int)arguments.size(), arguments.data()).ToLocal(&result)) {
+        info.GetReturnValue().Set(result);
+    }
+}
+
+void FastMathBindings::forwardGetter(v8::Local<v8::Name> name, const v8::PropertyCallbackInfo<v8::Value>& info) {
+    auto context = info.GetIsolate()->GetCurrentContext();
+    v8::Local<v8::Value> value;
+    if (v8::Local<v8::Object>::Cast(info.Data())->Get(context, name).ToLocal(&value)) {
+        info.GetReturnValue().Set(value);
+    }
+}
+
+void FastMathBindings::forwardSetter(v8::Local<v8::Name> name, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& info) {
+    auto context = info.GetIsolate()->GetCurrentContext();
+    v8::Local<v8::Object>::Cast(info.Data())->Set(context, name, value).FromMaybe(false);
+}
+
+v8::Local<v8::String> FastMathBindings::getKey(Key key) {
+    auto isolate = _engine->getIsolate();
+    if (_keys[key].IsEmpty()) {
+        _keys[key].Reset(isolate, v8::String::NewFromUtf8(isolate, KEY_NAMES[key], v8::NewStringType::kInternalized).ToLocalChecked());
+    }
+    return v8::Local<v8::String>::New(isolate, _keys[key]);
+}
+
+bool FastMathBindings::readNumber(v8::Local<v8::Context> context, v8::Local<v8::Object> object, Key key, float& number) {
+    v8::Local<v8::Value> value;
+    if (!object->Get(context, getKey(key)).ToLocal(&value) || !value->IsNumber()) {
+        return false;
+    }
+    number = (float)v8::Local<v8::Number>::Cast(value)->Value();
+    return true;
+}
+
+bool FastMathBindings::readVec3(v8::Local<v8::Context> context, v8::Local<v8::Value> value, glm::vec3& vec3) {
+    // numbers, color names and arrays are converted by vec3FromScriptValue, objects are read by x, y and z first
+    if (!value->IsObject() || value->IsArray()) {
+        return false;
+    }
+    v8::Local<v8::Object> object = v8::Local<v8::Object>::Cast(value);
+    return readNumber(context, object, KEY_X, vec3.x) && readNumber(context, object, KEY_Y, vec3.y) &&
+           readNumber(context, object, KEY_Z, vec3.z);
+}
+
+bool FastMathBindings::readQuat(v8::Local<v8::Context> context, v8::Local<v8::Value> value, glm::quat& quat) {
+    if (!value->IsObject()) {
+        return false;
+    }
+    v8::Local<v8::Object> object = v8::Local<v8::Object>::Cast(value);
+    if (!readNumber(context, object, KEY_X, quat.x) || !readNumber(context, object, KEY_Y, quat.y) ||
+        !readNumber(context, object, KEY_Z, quat.z) || !readNumber(context, object, KEY_W, quat.w)) {
+        return false;
+    }
+    // enforce normalized quaternion, as quatFromScriptValue does
+    float length = glm::length(quat);
+    if (length > FLT_EPSILON) {
+        quat /= length;
+    } else {
+        quat = glm::quat();
+    }
+    return true;
+}
+
+bool FastMathBindings::readMat4(v8::Local<v8::Context> context, v8::Local<v8::Value> value, glm::mat4& mat4) {
+    if (!value->IsObject()) {
+        return false;
+    }
+    v8::Local<v8::Object> object = v8::Local<v8::Object>::Cast(value);
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 4; row++) {
+            if (!readNumber(context, object, (Key)(KEY_MATRIX + 4 * column + row), mat4[column][row])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+v8::Local<v8::Value> FastMathBindings::getVec3Prototype() {
+    auto isolate = _engine->getIsolate();
+    if (_vec3Prototype.IsEmpty()) {
+        // the prototype is created by the first vec3 that the generic conversion builds
+        ScriptValue value = vec3ToScriptValue(_engine, glm::vec3());
+        ScriptValueV8Wrapper* wrapper = ScriptValueV8Wrapper::unwrap(value);
+        Q_ASSERT(wrapper);
+        v8::Local<v8::Object> object = v8::Local<v8::Object>::Cast(wrapper->toV8Value().get());
+        _vec3Prototype.Reset(isolate, object->GetPrototype());
+    }
+    return v8::Local<v8::Value>::New(isolate, _vec3Prototype);
+}
+
+v8::Local<v8::Object> FastMathBindings::newVec3(v8::Local<v8::Context> context, const glm::vec3& vec3) {
+    auto isolate = context->GetIsolate();
+    v8::Local<v8::Object> object = v8::Object::New(isolate);
+    for (int i = 0; i < 3; i++) {
+        if (!object->CreateDataProperty(context, getKey((Key)(KEY_X + i)), v8::Number::New(isolate, vec3[i])).FromMaybe(false)) {
+            Q_ASSERT(false);
+        }
+    }
+    if (!object->SetPrototype(context, getVec3Prototype()).FromMaybe(false)) {
+        Q_ASSERT(false);
+    }
+    return object;
+}
+
+v8::Local<v8::Object> FastMathBindings::newQuat(v8::Local<v8::Context> context, const glm::quat& quat) {
+    auto isolate = context->GetIsolate();
+    v8::Local<v8::Object> object = v8::Object::New(isolate);
+    if (quat.x != quat.x || quat.y != quat.y || quat.z != quat.z || quat.w != quat.w) {
+        // if quat contains a NaN don't try to convert it
+        return object;
+    }
+    const float components[] = { quat.x, quat.y, quat.z, quat.w };
+    for (int i = 0; i < 4; i++) {
+        if (!object->CreateDataProperty(context, getKey((Key)(KEY_X + i)), v8::Number::New(isolate, components[i])).FromMaybe(false)) {
+            Q_ASSERT(false);
+        }
+    }
+    return object;
+}
+
+v8::Local<v8::Object> FastMathBindings::newMat4(v8::Local<v8::Context> context, const glm::mat4& mat4) {
+    auto isolate = context->GetIsolate();
+    v8::Local<v8::Object> object = v8::Object::New(isolate);
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 4; row++) {
+            if (!object->CreateDataProperty(context, getKey((Key)(KEY_MATRIX + 4 * column + row)),
+                                            v8::Number::New(isolate, mat4[column][row])).FromMaybe(false)) {
+                Q_ASSERT(false);
+            }
+        }
+    }
+    return object;
+}
@@ -0,0 +1,86 @@
+//
+//  FastMathBindings.h
+//  libraries/script-engine/src/v8
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_FastMathBindings_h
+#define overte_FastMathBindings_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "v8.h"
+
+class ScriptEngineV8;
+
+/// Native V8 functions for the most used methods of the Vec3, Quat and Mat4 scripting objects.  They read the components
+/// of their arguments straight from the V8 objects and build their results the same way, instead of converting them
+/// through ScriptValue and QVariant and invoking the Qt slot through ScriptObjectV8Proxy.  When an argument isn't a plain
+/// object with numeric components, they call the proxy method instead, so the conversions behave as they always did.
+class FastMathBindings {
+public:
+    /// Computes the result of a method into info, returns false if the arguments have to go through the proxy method
+    using NativeCall = bool (*)(FastMathBindings& bindings, v8::Local<v8::Context> context,
+                                const v8::FunctionCallbackInfo<v8::Value>& info);
+
+    FastMathBindings(ScriptEngineV8* engine) : _engine(engine) {}
+
+    /// Returns the object to register as the global name: for Vec3, Quat and Mat4 an object holding the native functions,
+    /// which forwards the other properties to proxyObject, otherwise proxyObject itself
+    v8::Local<v8::Object> wrapGlobalObject(const QString& name, v8::Local<v8::Object> proxyObject);
+
+    // These return false for the values that the generic conversions have to handle
+    bool readVec3(v8::Local<v8::Context> context, v8::Local<v8::Value> value, glm::vec3& vec3);
+    bool readQuat(v8::Local<v8::Context> context, v8::Local<v8::Value> value, glm::quat& quat);
+    bool readMat4(v8::Local<v8::Context> context, v8::Local<v8::Value> value, glm::mat4& mat4);
+
+    // These build the same objects as the generic conversions
+    v8::Local<v8::Object> newVec3(v8::Local<v8::Context> context, const glm::vec3& vec3);
+    v8::Local<v8::Object> newQuat(v8::Local<v8::Context> context, const glm::quat& quat);
+    v8::Local<v8::Object> newMat4(v8::Local<v8::Context> context, const glm::mat4& mat4);
+
+private:
+    enum Key {
+        KEY_X = 0,
+        KEY_Y,
+        KEY_Z,
+        KEY_W,
+        // the elements of a matrix, r0c0 to r3c3 in column order
+        KEY_MATRIX,
+        NUM_KEYS = KEY_MATRIX + 16
+    };
+
+    struct Method {
+        FastMathBindings* bindings;
+        NativeCall nativeCall;
+        // the proxy method, called when the arguments aren't handled natively
+        v8::Persistent<v8::Value> proxyMethod;
+    };
+
+    static void callMethod(const v8::FunctionCallbackInfo<v8::Value>& info);
+    static void forwardGetter(v8::Local<v8::Name> name, const v8::PropertyCallbackInfo<v8::Value>& info);
+    static void forwardSetter(v8::Local<v8::Name> name, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& info);
+
+    v8::Local<v8::String> getKey(Key key);
+    bool readNumber(v8::Local<v8::Context> context, v8::Local<v8::Object> object, Key key, float& number);
+    v8::Local<v8::Value> getVec3Prototype();
+
+    ScriptEngineV8* _engine;
+    v8::Persistent<v8::String> _keys[NUM_KEYS];
+    // the prototype of the vec3 values, which gives them r, g, b and index accessors
+    v8::Persistent<v8::Value> _vec3Prototype;
+    std::vector<std::unique_ptr<Method>> _methods;
+};
+
+#endif  // overte_FastMathBindings_h
@@ -14,6 +14,7 @@
 #include <qcolor.h>
 
 #include "../ScriptEngine.h"
+#include "ByteArrayBackingStore.h"
 #include "V8Types.h"
 #include "ScriptValueV8Wrapper.h"
 
@@ -28,8 +29,7 @@ ScriptValue qBytearrayToScriptValue(ScriptEngine* engine, const QByteArray &qByt
     v8::HandleScope handleScope(isolate);
     auto context = engineV8->getContext();
     v8::Context::Scope contextScope(context);
-    v8::Local<v8::ArrayBuffer> arrayBuffer = v8::ArrayBuffer::New(isolate, qByteArray.size());
-    memcpy(arrayBuffer->GetBackingStore()->Data(), qByteArray.data(), qByteArray.size());
+    v8::Local<v8::ArrayBuffer> arrayBuffer = newByteArrayBuffer(isolate, qByteArray);
     v8::Local<v8::Value> arrayBufferValue = v8::Local<v8::Value>::Cast(arrayBuffer);
 
     return {new ScriptValueV8Wrapper(engineV8, V8ScriptValue(engineV8, arrayBufferValue))};
@@ -56,8 +56,7 @@ bool qBytearrayFromScriptValue(const ScriptValue& object, QByteArray &qByteArray
         return false;
     }
     v8::Local<v8::ArrayBuffer> arrayBuffer = v8::Local<v8::ArrayBuffer>::Cast(v8Value);
-    qByteArray.resize(arrayBuffer->ByteLength());
-    memcpy(qByteArray.data(), arrayBuffer->Data(), arrayBuffer->ByteLength());
+    qByteArray = byteArrayFromArrayBuffer(arrayBuffer, false);
     return true;
 }
 
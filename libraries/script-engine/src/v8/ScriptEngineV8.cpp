@@ -14,7 +14,9 @@
 
 #include "ScriptEngineV8.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <mutex>
 #include <thread>
 
@@ -44,12 +46,14 @@
 
 #include <v8-profiler.h>
 
+#include "../ScriptCache.h"
 #include "../ScriptEngineLogging.h"
 #include "../ScriptProgram.h"
 #include "../ScriptEngineCast.h"
 #include "../ScriptValue.h"
 #include "../ScriptManagerScriptingInterface.h"
 
+#include "ByteArrayBackingStore.h"
 #include "ScriptContextV8Wrapper.h"
 #include "ScriptObjectV8Proxy.h"
 #include "ScriptProgramV8Wrapper.h"
@@ -62,6 +66,20 @@ static const int MAX_DEBUG_VALUE_LENGTH { 80 };
 
 std::once_flag ScriptEngineV8::_v8InitOnceFlag;
 QMutex ScriptEngineV8::_v8InitMutex;
+v8::StartupData ScriptEngineV8::_startupSnapshot { nullptr, 0 };
+size_t ScriptEngineV8::_snapshotTemplateIndices[NUM_SNAPSHOT_TEMPLATES];
+
+// The native callbacks that the templates of the startup snapshot refer to, they must be the same when it's created
+// and when it's deserialized
+static const intptr_t V8_EXTERNAL_REFERENCES[] = {
+    reinterpret_cast<intptr_t>(&ScriptObjectV8Proxy::v8Get),
+    reinterpret_cast<intptr_t>(&ScriptObjectV8Proxy::v8Set),
+    reinterpret_cast<intptr_t>(&ScriptObjectV8Proxy::v8GetPropertyNames),
+    reinterpret_cast<intptr_t>(&ScriptVariantV8Proxy::v8Get),
+    reinterpret_cast<intptr_t>(&ScriptVariantV8Proxy::v8Set),
+    reinterpret_cast<intptr_t>(&ScriptVariantV8Proxy::v8GetPropertyNames),
+    0
+};
 
 bool ScriptEngineV8::IS_THREADSAFE_INVOCATION(const QThread* thread, const QString& method) {
     const QThread* currentThread = QThread::currentThread();
@@ -185,6 +203,56 @@ v8::Platform* ScriptEngineV8::getV8Platform() {
     return platform.get();
 }
 
+v8::Local<v8::ObjectTemplate> ScriptEngineV8::newObjectTemplate(v8::Isolate* isolate, SnapshotTemplate which) {
+    auto objectTemplate = v8::ObjectTemplate::New(isolate);
+    switch (which) {
+        case OBJECT_PROXY_TEMPLATE:
+            objectTemplate->SetInternalFieldCount(3);
+            objectTemplate->SetHandler(v8::NamedPropertyHandlerConfiguration(ScriptObjectV8Proxy::v8Get, ScriptObjectV8Proxy::v8Set, nullptr, nullptr, ScriptObjectV8Proxy::v8GetPropertyNames));
+            break;
+        case VARIANT_PROXY_TEMPLATE:
+            objectTemplate->SetInternalFieldCount(2);
+            objectTemplate->SetHandler(v8::NamedPropertyHandlerConfiguration(ScriptVariantV8Proxy::v8Get, ScriptVariantV8Proxy::v8Set, nullptr, nullptr, ScriptVariantV8Proxy::v8GetPropertyNames));
+            break;
+        default:
+            objectTemplate->SetInternalFieldCount(2);
+            break;
+    }
+    return objectTemplate;
+}
+
+void ScriptEngineV8::createStartupSnapshot() {
+    // The snapshot holds an empty context with V8's own bootstrapping done, and the templates that every engine uses to
+    // wrap its C++ objects.  The bindings themselves wrap objects of each engine, they can't be in it.
+    v8::SnapshotCreator creator(V8_EXTERNAL_REFERENCES);
+    v8::Isolate* isolate = creator.GetIsolate();
+    {
+        v8::HandleScope handleScope(isolate);
+        for (int i = 0; i < NUM_SNAPSHOT_TEMPLATES; i++) {
+            _snapshotTemplateIndices[i] = creator.AddData(newObjectTemplate(isolate, (SnapshotTemplate)i));
+        }
+        v8::Local<v8::Context> context = v8::Context::New(isolate);
+        creator.SetDefaultContext(context);
+    }
+    _startupSnapshot = creator.CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kClear);
+    if (_startupSnapshot.data && _startupSnapshot.raw_size > 0) {
+        qCDebug(scriptengine_v8) << "V8 startup snapshot created," << _startupSnapshot.raw_size << "bytes";
+    } else {
+        qCWarning(scriptengine_v8) << "Failed to create V8 startup snapshot, engines will be created without it";
+        _startupSnapshot = { nullptr, 0 };
+    }
+}
+
+v8::Local<v8::ObjectTemplate> ScriptEngineV8::getSnapshotTemplate(SnapshotTemplate which) {
+    v8::Local<v8::ObjectTemplate> objectTemplate;
+    // each datum of the snapshot can be taken once per isolate, the templates are kept once taken
+    if (_isFromStartupSnapshot &&
+        _v8Isolate->GetDataFromSnapshotOnce<v8::ObjectTemplate>(_snapshotTemplateIndices[which]).ToLocal(&objectTemplate)) {
+        return objectTemplate;
+    }
+    return newObjectTemplate(_v8Isolate, which);
+}
+
 ScriptEngineV8::ScriptEngineV8(ScriptManager *manager) : ScriptEngine(manager), _evaluatingCounter(0)
     //V8TODO _arrayBufferClass(new ArrayBufferClass(this))
 {
@@ -213,15 +281,23 @@ ScriptEngineV8::ScriptEngineV8(ScriptManager *manager) : ScriptEngine(manager),
         v8::Platform* platform = getV8Platform();
         v8::V8::InitializePlatform(platform);
         v8::V8::Initialize(); qCDebug(scriptengine_v8) << "V8 platform initialized";
+        createStartupSnapshot();
     } );
     _v8InitMutex.unlock();
     qCDebug(scriptengine_v8) << "Creating new script engine";
     {
         v8::Isolate::CreateParams isolateParams;
         isolateParams.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+        if (_startupSnapshot.data) {
+            isolateParams.snapshot_blob = &_startupSnapshot;
+            isolateParams.external_references = V8_EXTERNAL_REFERENCES;
+            _isFromStartupSnapshot = true;
+        }
         _v8Isolate = v8::Isolate::New(isolateParams);
         v8::Locker locker(_v8Isolate);
         v8::Isolate::Scope isolateScope(_v8Isolate);
+        _v8Isolate->AddGCPrologueCallback(gcPrologueCallback, this);
+        _v8Isolate->AddGCEpilogueCallback(gcEpilogueCallback, this);
         v8::HandleScope handleScope(_v8Isolate);
         v8::Local<v8::Context> context = v8::Context::New(_v8Isolate);
         Q_ASSERT(!context.IsEmpty());
@@ -259,6 +335,11 @@ ScriptEngineV8::ScriptEngineV8(ScriptManager *manager) : ScriptEngine(manager),
 
 ScriptEngineV8::~ScriptEngineV8() {
     deleteUnusedValueWrappers();
+    {
+        v8::Locker locker(_v8Isolate);
+        _v8Isolate->RemoveGCPrologueCallback(gcPrologueCallback, this);
+        _v8Isolate->RemoveGCEpilogueCallback(gcEpilogueCallback, this);
+    }
 #ifdef OVERTE_SCRIPT_USE_AFTER_DELETE_GUARD
     _wasDestroyed = true;
 #endif
@@ -269,6 +350,26 @@ void ScriptEngineV8::perManagerLoopIterationCleanup() {
     deleteUnusedValueWrappers();
 }
 
+void ScriptEngineV8::scheduleCoalescedSignal(ScriptSignalV8Proxy* proxy) {
+    _coalescedSignalProxies.append(proxy);
+}
+
+void ScriptEngineV8::dispatchCoalescedSignals() {
+    if (_coalescedSignalProxies.isEmpty()) {
+        return;
+    }
+    // the proxies that are held back by their interval schedule themselves again while they're delivered
+    QList<QPointer<ScriptSignalV8Proxy>> proxies;
+    proxies.swap(_coalescedSignalProxies);
+    qint64 now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    for (auto& proxy : proxies) {
+        if (proxy) {
+            proxy->deliverCoalescedEvents(now);
+        }
+    }
+}
+
 void ScriptEngineV8::disconnectSignalProxies() {
     _signalProxySetLock.lockForRead();
     while (!_signalProxySet.empty()) {
@@ -387,7 +488,12 @@ void ScriptEngineV8::registerGlobalObject(const QString& name, QObject* object,
     if (!v8GlobalObject->Get(context, v8Name).IsEmpty()) {
         if (object) {
             V8ScriptValue value = ScriptObjectV8Proxy::newQObject(this, object, ScriptEngine::QtOwnership);
-            if(!v8GlobalObject->Set(context, v8Name, value.get()).FromMaybe(false)) {
+            v8::Local<v8::Value> v8Value = value.get();
+            if (v8Value->IsObject()) {
+                // the math helpers get native functions for their most used methods
+                v8Value = _fastMathBindings.wrapGlobalObject(name, v8::Local<v8::Object>::Cast(v8Value));
+            }
+            if(!v8GlobalObject->Set(context, v8Name, v8Value).FromMaybe(false)) {
                 Q_ASSERT(false);
             }
         } else {
@@ -774,6 +880,49 @@ ScriptValue ScriptEngineV8::evaluateInClosure(const ScriptValue& _closure,
     return result;
 }
 
+v8::MaybeLocal<v8::Script> ScriptEngineV8::compileScript(const QString& sourceCode, v8::ScriptOrigin& scriptOrigin) {
+    auto context = getContext();
+    v8::Local<v8::String> sourceString = v8::String::NewFromUtf8(_v8Isolate, sourceCode.toStdString().c_str()).ToLocalChecked();
+    // below this size the lookup of the code takes longer than the compilation it saves
+    const int MIN_CACHED_SOURCE_SIZE = 1024;
+    if (sourceCode.size() < MIN_CACHED_SOURCE_SIZE || !DependencyManager::isSet<ScriptCache>()) {
+        return v8::Script::Compile(context, sourceString, &scriptOrigin);
+    }
+
+    auto scriptCache = DependencyManager::get<ScriptCache>();
+    // the code of a script is only valid for the version of V8 that compiled it
+    static const QString ENGINE_VERSION = QString("V8 ") + v8::V8::GetVersion();
+    std::string key = ScriptCodeCache::getKey(sourceCode, ENGINE_VERSION);
+    QByteArray code = scriptCache->getCompiledCode(key);
+
+    v8::Local<v8::Script> script;
+    if (!code.isEmpty()) {
+        // the source owns the cached data object, but not the code it points to, which outlives it
+        v8::ScriptCompiler::Source source(sourceString, scriptOrigin,
+            new v8::ScriptCompiler::CachedData(reinterpret_cast<const uint8_t*>(code.constData()), code.size(),
+                                               v8::ScriptCompiler::CachedData::BufferNotOwned));
+        if (!v8::ScriptCompiler::Compile(context, &source, v8::ScriptCompiler::kConsumeCodeCache).ToLocal(&script)) {
+            return v8::MaybeLocal<v8::Script>();
+        }
+        if (!source.GetCachedData()->rejected) {
+            return script;
+        }
+        // V8 compiled the source itself, the code it was given is replaced below by the code it compiled
+    } else {
+        v8::ScriptCompiler::Source source(sourceString, scriptOrigin);
+        if (!v8::ScriptCompiler::Compile(context, &source, v8::ScriptCompiler::kNoCompileOptions).ToLocal(&script)) {
+            return v8::MaybeLocal<v8::Script>();
+        }
+    }
+
+    // this holds the top level code and the functions that were compiled eagerly, like the closures of entity scripts
+    std::unique_ptr<v8::ScriptCompiler::CachedData> cachedData(v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+    if (cachedData && cachedData->length > 0) {
+        scriptCache->setCompiledCode(key, QByteArray(reinterpret_cast<const char*>(cachedData->data), cachedData->length));
+    }
+    return script;
+}
+
 ScriptValue ScriptEngineV8::evaluate(const QString& sourceCode, const QString& fileName) {
 
     if (QThread::currentThread() != thread()) {
@@ -800,7 +949,7 @@ ScriptValue ScriptEngineV8::evaluate(const QString& sourceCode, const QString& f
     v8::Local<v8::Script> script;
     {
         v8::TryCatch tryCatch(getIsolate());
-        if (!v8::Script::Compile(context, v8::String::NewFromUtf8(getIsolate(), sourceCode.toStdString().c_str()).ToLocalChecked(), &scriptOrigin).ToLocal(&script)) {
+        if (!compileScript(sourceCode, scriptOrigin).ToLocal(&script)) {
             QString errorMessage(QString("Error while compiling script: \"") + fileName + QString("\" ") + formatErrorMessageFromTryCatch(tryCatch));
             if (_manager) {
                 v8::Local<v8::Message> exceptionMessage = tryCatch.Message();
@@ -944,10 +1093,7 @@ QString ScriptEngineV8::formatErrorMessageFromTryCatch(v8::TryCatch &tryCatch) {
 v8::Local<v8::ObjectTemplate> ScriptEngineV8::getObjectProxyTemplate() {
     v8::EscapableHandleScope handleScope(_v8Isolate);
     if (_objectProxyTemplate.IsEmpty()) {
-        auto objectTemplate = v8::ObjectTemplate::New(_v8Isolate);
-        objectTemplate->SetInternalFieldCount(3);
-        objectTemplate->SetHandler(v8::NamedPropertyHandlerConfiguration(ScriptObjectV8Proxy::v8Get, ScriptObjectV8Proxy::v8Set, nullptr, nullptr, ScriptObjectV8Proxy::v8GetPropertyNames));
-        _objectProxyTemplate.Reset(_v8Isolate, objectTemplate);
+        _objectProxyTemplate.Reset(_v8Isolate, getSnapshotTemplate(OBJECT_PROXY_TEMPLATE));
     }
 
     return handleScope.Escape(_objectProxyTemplate.Get(_v8Isolate));
@@ -956,9 +1102,7 @@ v8::Local<v8::ObjectTemplate> ScriptEngineV8::getObjectProxyTemplate() {
 v8::Local<v8::ObjectTemplate> ScriptEngineV8::getMethodDataTemplate() {
     v8::EscapableHandleScope handleScope(_v8Isolate);
     if (_methodDataTemplate.IsEmpty()) {
-        auto methodDataTemplate = v8::ObjectTemplate::New(_v8Isolate);
-        methodDataTemplate->SetInternalFieldCount(2);
-        _methodDataTemplate.Reset(_v8Isolate, methodDataTemplate);
+        _methodDataTemplate.Reset(_v8Isolate, getSnapshotTemplate(METHOD_DATA_TEMPLATE));
     }
 
     return handleScope.Escape(_methodDataTemplate.Get(_v8Isolate));
@@ -967,9 +1111,7 @@ v8::Local<v8::ObjectTemplate> ScriptEngineV8::getMethodDataTemplate() {
 v8::Local<v8::ObjectTemplate> ScriptEngineV8::getFunctionDataTemplate() {
     v8::EscapableHandleScope handleScope(_v8Isolate);
     if (_functionDataTemplate.IsEmpty()) {
-        auto functionDataTemplate = v8::ObjectTemplate::New(_v8Isolate);
-        functionDataTemplate->SetInternalFieldCount(2);
-        _functionDataTemplate.Reset(_v8Isolate, functionDataTemplate);
+        _functionDataTemplate.Reset(_v8Isolate, getSnapshotTemplate(FUNCTION_DATA_TEMPLATE));
     }
 
     return handleScope.Escape(_functionDataTemplate.Get(_v8Isolate));
@@ -978,9 +1120,7 @@ v8::Local<v8::ObjectTemplate> ScriptEngineV8::getFunctionDataTemplate() {
 v8::Local<v8::ObjectTemplate> ScriptEngineV8::getVariantDataTemplate() {
     v8::EscapableHandleScope handleScope(_v8Isolate);
     if (_variantDataTemplate.IsEmpty()) {
-        auto variantDataTemplate = v8::ObjectTemplate::New(_v8Isolate);
-        variantDataTemplate->SetInternalFieldCount(2);
-        _variantDataTemplate.Reset(_v8Isolate, variantDataTemplate);
+        _variantDataTemplate.Reset(_v8Isolate, getSnapshotTemplate(VARIANT_DATA_TEMPLATE));
     }
 
     return handleScope.Escape(_variantDataTemplate.Get(_v8Isolate));
@@ -989,10 +1129,7 @@ v8::Local<v8::ObjectTemplate> ScriptEngineV8::getVariantDataTemplate() {
 v8::Local<v8::ObjectTemplate> ScriptEngineV8::getVariantProxyTemplate() {
     v8::EscapableHandleScope handleScope(_v8Isolate);
     if (_variantProxyTemplate.IsEmpty()) {
-        auto variantProxyTemplate = v8::ObjectTemplate::New(_v8Isolate);
-        variantProxyTemplate->SetInternalFieldCount(2);
-        variantProxyTemplate->SetHandler(v8::NamedPropertyHandlerConfiguration(ScriptVariantV8Proxy::v8Get, ScriptVariantV8Proxy::v8Set, nullptr, nullptr, ScriptVariantV8Proxy::v8GetPropertyNames));
-        _variantProxyTemplate.Reset(_v8Isolate, variantProxyTemplate);
+        _variantProxyTemplate.Reset(_v8Isolate, getSnapshotTemplate(VARIANT_PROXY_TEMPLATE));
     }
 
     return handleScope.Escape(_variantProxyTemplate.Get(_v8Isolate));
@@ -1117,25 +1254,31 @@ ScriptValue ScriptEngineV8::newArray(uint length) {
     return ScriptValue(new ScriptValueV8Wrapper(this, std::move(result)));
 }
 
-ScriptValue ScriptEngineV8::newArrayBuffer(const QByteArray& message) {
+ScriptValue ScriptEngineV8::newArrayBuffer(QByteArray data) {
     v8::Locker locker(_v8Isolate);
     v8::Isolate::Scope isolateScope(_v8Isolate);
     v8::HandleScope handleScope(_v8Isolate);
     v8::Context::Scope contextScope(getContext());
-    std::shared_ptr<v8::BackingStore> backingStore(v8::ArrayBuffer::NewBackingStore(_v8Isolate, message.size()));
-    std::memcpy(backingStore.get()->Data(), message.constData(), message.size());
-    auto arrayBuffer = v8::ArrayBuffer::New(_v8Isolate, backingStore);
-    //V8TODO: this needs to be finished and tested
-    /*V8ScriptValue data = QScriptEngine::newVariant(QVariant::fromValue(message));
-    V8ScriptValue ctor = QScriptEngine::globalObject().property("ArrayBuffer");
-    auto array = qscriptvalue_cast<ArrayBufferClass*>(ctor.data());
-    if (!array) {
-        return undefinedValue();
-    }*/
-    V8ScriptValue result(this, arrayBuffer);//QScriptEngine::newObject(array, data);
+    V8ScriptValue result(this, newByteArrayBuffer(_v8Isolate, std::move(data)));
     return ScriptValue(new ScriptValueV8Wrapper(this, std::move(result)));
 }
 
+QByteArray ScriptEngineV8::transferArrayBuffer(const ScriptValue& value) {
+    ScriptValueV8Wrapper* unwrapped = ScriptValueV8Wrapper::unwrap(value);
+    if (!unwrapped) {
+        return scriptvalue_cast<QByteArray>(value);
+    }
+    v8::Locker locker(_v8Isolate);
+    v8::Isolate::Scope isolateScope(_v8Isolate);
+    v8::HandleScope handleScope(_v8Isolate);
+    v8::Context::Scope contextScope(getContext());
+    v8::Local<v8::Value> v8Value = unwrapped->toV8Value().get();
+    if (!v8Value->IsArrayBuffer()) {
+        return scriptvalue_cast<QByteArray>(value);
+    }
+    return byteArrayFromArrayBuffer(v8::Local<v8::ArrayBuffer>::Cast(v8Value), true);
+}
+
 ScriptValue ScriptEngineV8::newObject() {
     ScriptValue result;
     {
@@ -1262,8 +1405,8 @@ ScriptValue ScriptEngineV8::undefinedValue() {
 }
 
 void ScriptEngineV8::abortEvaluation() {
-    //V8TODO
-    //QScriptEngine::abortEvaluation();
+    // safe to call from any thread, the running script is stopped and V8 resumes execution once it has returned
+    _v8Isolate->TerminateExecution();
 }
 
 void ScriptEngineV8::clearExceptions() {
@@ -1547,7 +1690,7 @@ ScriptEngineMemoryStatistics ScriptEngineV8::getMemoryUsageStatistics() {
     ScriptEngineMemoryStatistics statistics;
     v8::HeapStatistics heapStatistics;
     _v8Isolate->GetHeapStatistics(&heapStatistics);
-    statistics.totalHeapSize = heapStatistics.total_available_size();
+    statistics.totalHeapSize = heapStatistics.total_heap_size();
     statistics.usedHeapSize = heapStatistics.used_heap_size();
     statistics.totalAvailableSize = heapStatistics.total_available_size();
     statistics.totalGlobalHandlesSize = heapStatistics.total_global_handles_size();
@@ -1560,6 +1703,36 @@ ScriptEngineMemoryStatistics ScriptEngineV8::getMemoryUsageStatistics() {
     return statistics;
 }
 
+ScriptEngineProfilingStatistics ScriptEngineV8::getProfilingStatistics() const {
+    ScriptEngineProfilingStatistics statistics;
+    statistics.usedHeapSize = _usedHeapSize;
+    statistics.totalHeapSize = _totalHeapSize;
+    statistics.gcCount = _gcCount;
+    statistics.gcPauseTime = _gcPauseTime;
+    statistics.numSignalConnections = _numSignalConnections;
+    statistics.signalCallCount = _signalCallCount;
+    statistics.signalCallTime = _signalCallTime;
+    return statistics;
+}
+
+// The garbage collections run on the thread of the engine, which holds the isolate lock, while the script is paused
+void ScriptEngineV8::gcPrologueCallback(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags, void* data) {
+    auto engine = static_cast<ScriptEngineV8*>(data);
+    engine->_gcStartTime = std::chrono::steady_clock::now();
+}
+
+void ScriptEngineV8::gcEpilogueCallback(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags, void* data) {
+    auto engine = static_cast<ScriptEngineV8*>(data);
+    auto pauseTime = std::chrono::steady_clock::now() - engine->_gcStartTime;
+    engine->_gcPauseTime += std::chrono::duration_cast<std::chrono::microseconds>(pauseTime).count();
+    engine->_gcCount++;
+
+    v8::HeapStatistics heapStatistics;
+    isolate->GetHeapStatistics(&heapStatistics);
+    engine->_usedHeapSize = heapStatistics.used_heap_size();
+    engine->_totalHeapSize = heapStatistics.total_heap_size();
+}
+
 void ScriptEngineV8::startCollectingObjectStatistics() {
     auto heapProfiler = _v8Isolate->GetHeapProfiler();
     heapProfiler->StartTrackingHeapObjects();
@@ -1657,12 +1830,69 @@ void ScriptEngineV8::stopProfilingAndSave() {
     } else {
         qWarning(scriptengine_v8) << "ScriptEngineV8::stopProfilingAndSave: Cannot open output file";
     }
+    addProfileToTrace(profile);
     profile->Delete();
     _profiler->Dispose();
     _profiler = nullptr;
     qDebug(scriptengine_v8) << "Script profiler stopped, results written to: " << filename;
 };
 
+// Adds the samples of the profile to the trace as complete events, one for each run of consecutive samples in which a
+// function was on the stack, so that they show as the same flame chart as the PROFILE_RANGE events around them
+void ScriptEngineV8::addProfileToTrace(const v8::CpuProfile* profile) {
+    if (!DependencyManager::isSet<tracing::Tracer>()) {
+        return;
+    }
+    auto tracer = DependencyManager::get<tracing::Tracer>();
+    if (!tracer || !tracer->isEnabled()) {
+        return;
+    }
+
+    // the samples are timed by the clock of V8, the profile ended just now on the clock of the tracer
+    int64_t clockOffset = tracing::Tracer::now() - profile->GetEndTime();
+    // the functions on the stack of the previous sample, from the outermost, with the time they were first sampled at
+    std::vector<std::pair<const v8::CpuProfileNode*, int64_t>> openFrames;
+    std::vector<const v8::CpuProfileNode*> stack;
+    auto closeFrames = [&](size_t depth, int64_t timestamp) {
+        while (openFrames.size() > depth) {
+            const v8::CpuProfileNode* node = openFrames.back().first;
+            int64_t startTime = openFrames.back().second;
+            QString name = node->GetFunctionNameStr();
+            if (name.isEmpty()) {
+                name = "(anonymous function)";
+            }
+            QVariantMap args { { "url", node->GetScriptResourceNameStr() }, { "line", node->GetLineNumber() } };
+            QVariantMap extra { { "dur", (qint64)(timestamp - startTime) } };
+            tracer->traceEvent(trace_script(), name, tracing::Complete, startTime + clockOffset, "", args, extra);
+            openFrames.pop_back();
+        }
+    };
+
+    const v8::CpuProfileNode* root = profile->GetTopDownRoot();
+    for (int i = 0; i < profile->GetSamplesCount(); i++) {
+        stack.clear();
+        for (const v8::CpuProfileNode* node = profile->GetSample(i); node && node != root; node = node->GetParent()) {
+            stack.push_back(node);
+        }
+        std::reverse(stack.begin(), stack.end());
+        // the samples taken while the thread waited for events would hide everything else
+        if (stack.size() == 1 && strcmp(stack[0]->GetFunctionNameStr(), "(idle)") == 0) {
+            stack.clear();
+        }
+
+        int64_t timestamp = profile->GetSampleTimestamp(i);
+        size_t depth = 0;
+        while (depth < openFrames.size() && depth < stack.size() && openFrames[depth].first == stack[depth]) {
+            depth++;
+        }
+        closeFrames(depth, timestamp);
+        for (; depth < stack.size(); depth++) {
+            openFrames.emplace_back(stack[depth], timestamp);
+        }
+    }
+    closeFrames(0, profile->GetEndTime());
+}
+
 ContextScopeV8::ContextScopeV8(ScriptEngineV8 *engine) :
     _engine(engine) {
     Q_ASSERT(engine);
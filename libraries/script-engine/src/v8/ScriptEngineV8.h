@@ -19,6 +19,8 @@
 #ifndef hifi_ScriptEngineV8_h
 #define hifi_ScriptEngineV8_h
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 
 #include <QtCore/QByteArray>
@@ -41,6 +43,7 @@
 //#include "V8Types.h"
 
 #include "ArrayBufferClass.h"
+#include "FastMathBindings.h"
 
 class ScriptContextV8Wrapper;
 class ScriptEngineV8;
@@ -88,7 +91,8 @@ public:  // ScriptEngine implementation
     virtual ScriptValue checkScriptSyntax(ScriptProgramPointer program) override;
 
     virtual ScriptValue newArray(uint length = 0) override;
-    virtual ScriptValue newArrayBuffer(const QByteArray& message) override;
+    virtual ScriptValue newArrayBuffer(QByteArray data) override;
+    virtual QByteArray transferArrayBuffer(const ScriptValue& value) override;
     virtual ScriptValue newFunction(ScriptEngine::FunctionSignature fun, int length = 0) override;
     virtual ScriptValue newObject() override;
     virtual ScriptValue newMethod(QObject* object, V8ScriptValue lifetime,
@@ -140,13 +144,20 @@ public:  // ScriptEngine implementation
     QString scriptValueDebugListMembersV8(const V8ScriptValue &v8Value);
     virtual void logBacktrace(const QString &title = QString("")) override;
     virtual ScriptEngineMemoryStatistics getMemoryUsageStatistics() override;
+    virtual ScriptEngineProfilingStatistics getProfilingStatistics() const override;
     virtual void startCollectingObjectStatistics() override;
     virtual void dumpHeapObjectStatistics() override;
     virtual void startProfiling() override;
     virtual void stopProfilingAndSave() override;
+    // Compiles sourceCode in the current context, from the code that ScriptCache has for it if there is any, storing the
+    // code in ScriptCache otherwise.  The errors are left in the caller's TryCatch.
+    v8::MaybeLocal<v8::Script> compileScript(const QString& sourceCode, v8::ScriptOrigin& scriptOrigin);
     void scheduleValueWrapperForDeletion(ScriptValueV8Wrapper* wrapper) {_scriptValueWrappersToDelete.enqueue(wrapper);}
     void deleteUnusedValueWrappers();
     virtual void perManagerLoopIterationCleanup() override;
+    virtual void dispatchCoalescedSignals() override;
+    // Called by a signal proxy when it has emissions queued for its coalesced connections
+    void scheduleCoalescedSignal(ScriptSignalV8Proxy* proxy);
     virtual void disconnectSignalProxies() override;
 
     // helper to detect and log warnings when other code invokes QScriptEngine/BaseScriptEngine in thread-unsafe ways
@@ -230,6 +241,21 @@ protected:
     static std::once_flag _v8InitOnceFlag;
     static v8::Platform* getV8Platform();
 
+    // The object templates are built once into the startup snapshot that every isolate is created from
+    enum SnapshotTemplate {
+        OBJECT_PROXY_TEMPLATE = 0,
+        METHOD_DATA_TEMPLATE,
+        FUNCTION_DATA_TEMPLATE,
+        VARIANT_DATA_TEMPLATE,
+        VARIANT_PROXY_TEMPLATE,
+        NUM_SNAPSHOT_TEMPLATES
+    };
+    static v8::StartupData _startupSnapshot;
+    static size_t _snapshotTemplateIndices[NUM_SNAPSHOT_TEMPLATES];
+    static void createStartupSnapshot();
+    static v8::Local<v8::ObjectTemplate> newObjectTemplate(v8::Isolate* isolate, SnapshotTemplate which);
+    v8::Local<v8::ObjectTemplate> getSnapshotTemplate(SnapshotTemplate which);
+
     void setUncaughtEngineException(const QString &message, const QString& info = QString());
     void setUncaughtException(const v8::TryCatch &tryCatch, const QString& info = QString());
     void setUncaughtException(std::shared_ptr<ScriptException> exception);
@@ -241,6 +267,8 @@ protected:
 
     // V8TODO: clean up isolate when script engine is destroyed?
     v8::Isolate* _v8Isolate;
+    // the isolate was created from _startupSnapshot, its templates are taken from it
+    bool _isFromStartupSnapshot { false };
 
     struct CustomMarshal {
         ScriptEngine::MarshalFunction marshalFunc;
@@ -268,6 +296,9 @@ protected:
     v8::Persistent<v8::ObjectTemplate> _variantDataTemplate;
     v8::Persistent<v8::ObjectTemplate> _variantProxyTemplate;
 
+    // Native functions of the Vec3, Quat and Mat4 global objects
+    FastMathBindings _fastMathBindings { this };
+
 public:
     volatile int _memoryCorruptionIndicator = 12345678;
 private:
@@ -288,10 +319,26 @@ private:
     v8::CpuProfiler *_profiler{nullptr};
     v8::ProfilerId _profilerId{0};
 
+    static void gcPrologueCallback(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags, void* data);
+    static void gcEpilogueCallback(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags, void* data);
+    void addProfileToTrace(const v8::CpuProfile* profile);
+
+    // Counters for getProfilingStatistics(), the heap sizes are sampled at the end of every garbage collection
+    std::chrono::steady_clock::time_point _gcStartTime;
+    std::atomic<size_t> _usedHeapSize{0};
+    std::atomic<size_t> _totalHeapSize{0};
+    std::atomic<quint64> _gcCount{0};
+    std::atomic<quint64> _gcPauseTime{0};
+    std::atomic<int> _numSignalConnections{0};
+    std::atomic<quint64> _signalCallCount{0};
+    std::atomic<quint64> _signalCallTime{0};
+
     // Set of script signal proxy pointers. Used for disconnecting signals on cleanup.
     // V8TODO: later it would be also worth to make sure that script proxies themselves get deleted together with script engine
     QReadWriteLock _signalProxySetLock;
     QSet<ScriptSignalV8Proxy*> _signalProxySet;
+    // The signal proxies that have emissions waiting for dispatchCoalescedSignals(), only used on the script thread
+    QList<QPointer<ScriptSignalV8Proxy>> _coalescedSignalProxies;
 
     friend ScriptValueV8Wrapper;
     friend ScriptSignalV8Proxy;
@@ -14,6 +14,8 @@
 
 #include "ScriptObjectV8Proxy.h"
 
+#include <chrono>
+
 #include <QElapsedTimer>
 #include <QtCore/QList>
 #include <QtCore/QSharedPointer>
@@ -1216,6 +1218,7 @@ ScriptSignalV8Proxy::~ScriptSignalV8Proxy() {
     v8::HandleScope handleScope(isolate);
     _objectLifetime.Reset();
     _v8Context.Reset();
+    _coalescedEvents.clear();
 #ifdef OVERTE_SCRIPT_USE_AFTER_DELETE_GUARD
     Q_ASSERT(!_engine->_wasDestroyed);
 #endif
@@ -1256,6 +1259,7 @@ int ScriptSignalV8Proxy::qt_metacall(QMetaObject::Call call, int id, void** argu
     QElapsedTimer callTimer;
     callTimer.start();
 #endif
+    auto callStart = std::chrono::steady_clock::now();
 
     auto isolate = _engine->getIsolate();
     v8::Locker locker(isolate);
@@ -1281,63 +1285,138 @@ int ScriptSignalV8Proxy::qt_metacall(QMetaObject::Call call, int id, void** argu
             QVariant argValue(methodArgTypeId, arguments[arg + 1]);
             args[arg] = _engine->castVariantToValue(argValue).get();
         }
-        for (ConnectionList::iterator iter = connections.begin(); iter != connections.end(); ++iter) {
-            Connection& conn = *iter;
-            {
-                auto functionContext = context;
-
-                Q_ASSERT(!conn.callback.get().IsEmpty());
-                Q_ASSERT(!conn.callback.get()->IsUndefined());
-                if (conn.callback.get()->IsNull()) {
-                    qCDebug(scriptengine_v8) << "ScriptSignalV8Proxy::qt_metacall: Connection callback is Null";
-                    _engine->popContext();
-                    continue;
-                }
-                if (!conn.callback.get()->IsFunction()) {
-                    auto stringV8 = conn.callback.get()->ToDetailString(functionContext).ToLocalChecked();
-                    QString error = *v8::String::Utf8Value(_engine->getIsolate(), stringV8);
-                    qCDebug(scriptengine_v8) << error;
-                    Q_ASSERT(false);
-                }
-                v8::Local<v8::Function> callback = v8::Local<v8::Function>::Cast(conn.callback.get());
-
-                v8::Local<v8::Value> v8This;
-                if (conn.thisValue.get()->IsObject()) {
-                    v8This = conn.thisValue.get();
-                } else {
-                    v8This = functionContext->Global();
-                }
-
-                v8::TryCatch tryCatch(isolate);
-                callback->Call(functionContext, v8This, numArgs, args);
-                if (tryCatch.HasCaught()) {
-                    QString errorMessage(QString("Signal proxy ") + fullName() + " connection call failed: \""
-                                          + _engine->formatErrorMessageFromTryCatch(tryCatch)
-                                          + "\nThis provided: " + QString::number(conn.thisValue.get()->IsObject()));
-                    v8::Local<v8::Message> exceptionMessage = tryCatch.Message();
-                    int errorLineNumber = -1;
-                    if (!exceptionMessage.IsEmpty()) {
-                        errorLineNumber = exceptionMessage->GetLineNumber(context).FromJust();
-                    }
-                    if (_engine->_manager) {
-                        _engine->_manager->scriptErrorMessage(errorMessage, getFileNameFromTryCatch(tryCatch, isolate, context),
-                                                              errorLineNumber);
-                    } else {
-                        qDebug(scriptengine_v8) << errorMessage;
-                    }
-
-                    _engine->setUncaughtException(tryCatch, "Error in signal proxy");
-                }
+        bool hasCoalescedConnections = false;
+        for (const Connection& conn : connections) {
+            if (conn.isCoalesced) {
+                hasCoalescedConnections = true;
+                continue;
             }
+            callConnection(conn, context, numArgs, args);
+        }
+        if (hasCoalescedConnections) {
+            queueCoalescedEvent(v8::Array::New(isolate, args, numArgs));
         }
     }
 
+    _engine->_signalCallCount++;
+    _engine->_signalCallTime += std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - callStart).count();
+
 #ifdef SCRIPT_EVENT_PERFORMANCE_STATISTICS
     _totalCallTime_s += callTimer.elapsed() / 1000.0f;
 #endif
     return -1;
 }
 
+void ScriptSignalV8Proxy::callConnection(const Connection& conn, v8::Local<v8::Context> context, int numArgs,
+                                         v8::Local<v8::Value>* args) {
+    auto isolate = _engine->getIsolate();
+    auto functionContext = context;
+
+    Q_ASSERT(!conn.callback.constGet().IsEmpty());
+    Q_ASSERT(!conn.callback.constGet()->IsUndefined());
+    if (conn.callback.constGet()->IsNull()) {
+        qCDebug(scriptengine_v8) << "ScriptSignalV8Proxy::qt_metacall: Connection callback is Null";
+        _engine->popContext();
+        return;
+    }
+    if (!conn.callback.constGet()->IsFunction()) {
+        auto stringV8 = conn.callback.constGet()->ToDetailString(functionContext).ToLocalChecked();
+        QString error = *v8::String::Utf8Value(_engine->getIsolate(), stringV8);
+        qCDebug(scriptengine_v8) << error;
+        Q_ASSERT(false);
+    }
+    v8::Local<v8::Function> callback = v8::Local<v8::Function>::Cast(conn.callback.constGet());
+
+    v8::Local<v8::Value> v8This;
+    if (conn.thisValue.constGet()->IsObject()) {
+        v8This = conn.thisValue.constGet();
+    } else {
+        v8This = functionContext->Global();
+    }
+
+    v8::TryCatch tryCatch(isolate);
+    callback->Call(functionContext, v8This, numArgs, args);
+    if (tryCatch.HasCaught()) {
+        QString errorMessage(QString("Signal proxy ") + fullName() + " connection call failed: \""
+                              + _engine->formatErrorMessageFromTryCatch(tryCatch)
+                              + "\nThis provided: " + QString::number(conn.thisValue.constGet()->IsObject()));
+        v8::Local<v8::Message> exceptionMessage = tryCatch.Message();
+        int errorLineNumber = -1;
+        if (!exceptionMessage.IsEmpty()) {
+            errorLineNumber = exceptionMessage->GetLineNumber(context).FromJust();
+        }
+        if (_engine->_manager) {
+            _engine->_manager->scriptErrorMessage(errorMessage, getFileNameFromTryCatch(tryCatch, isolate, context),
+                                                  errorLineNumber);
+        } else {
+            qDebug(scriptengine_v8) << errorMessage;
+        }
+
+        _engine->setUncaughtException(tryCatch, "Error in signal proxy");
+    }
+}
+
+void ScriptSignalV8Proxy::queueCoalescedEvent(v8::Local<v8::Array> event) {
+    auto isolate = _engine->getIsolate();
+    if (!_isCoalescedDeliveryScheduled) {
+        // the options are looked up once per delivery rather than once per emission
+        _coalescedOptions = _engine->_manager ? _engine->_manager->getCoalescedSignalOptions(QString::fromLatin1(_meta.name()))
+                                              : ScriptManager::CoalescedSignalOptions();
+        _isCoalescedDeliveryScheduled = true;
+        _engine->scheduleCoalescedSignal(this);
+    }
+    _coalescedEvents.emplace_back(isolate, event);
+    if (_coalescedOptions.maxEvents > 0 && (int)_coalescedEvents.size() > _coalescedOptions.maxEvents) {
+        // the oldest events are dropped, the scripts that coalesce an event are usually after its latest state
+        _coalescedEvents.pop_front();
+    }
+}
+
+void ScriptSignalV8Proxy::deliverCoalescedEvents(qint64 nowMS) {
+    if (_coalescedOptions.interval > 0 && nowMS - _lastCoalescedDelivery < _coalescedOptions.interval) {
+        _engine->scheduleCoalescedSignal(this);
+        return;
+    }
+    _isCoalescedDeliveryScheduled = false;
+    _lastCoalescedDelivery = nowMS;
+    if (_coalescedEvents.empty()) {
+        return;
+    }
+
+    auto callStart = std::chrono::steady_clock::now();
+
+    auto isolate = _engine->getIsolate();
+    v8::Locker locker(isolate);
+    v8::Isolate::Scope isolateScope(isolate);
+    v8::HandleScope handleScope(isolate);
+    auto context = _engine->getContext();
+    v8::Context::Scope contextScope(context);
+
+    v8::Local<v8::Array> events = v8::Array::New(isolate, (int)_coalescedEvents.size());
+    uint32_t index = 0;
+    for (auto& event : _coalescedEvents) {
+        if (!events->Set(context, index++, event.Get(isolate)).FromMaybe(false)) {
+            Q_ASSERT(false);
+        }
+    }
+    _coalescedEvents.clear();
+
+    QList<Connection> connections;
+    withReadLock([&]{
+        connections = _connections;
+    });
+    v8::Local<v8::Value> args[] = { events };
+    for (const Connection& conn : connections) {
+        if (conn.isCoalesced) {
+            callConnection(conn, context, 1, args);
+        }
+    }
+
+    _engine->_signalCallTime += std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - callStart).count();
+}
+
 int ScriptSignalV8Proxy::discoverMetaCallIdx() {
     const QMetaObject* ourMeta = metaObject();
     return ourMeta->methodCount();
@@ -1362,6 +1441,14 @@ ScriptSignalV8Proxy::ConnectionList::iterator ScriptSignalV8Proxy::findConnectio
 }
 
 void ScriptSignalV8Proxy::connect(ScriptValue arg0, ScriptValue arg1) {
+    connectWith(arg0, arg1, false);
+}
+
+void ScriptSignalV8Proxy::connectCoalesced(ScriptValue arg0, ScriptValue arg1) {
+    connectWith(arg0, arg1, true);
+}
+
+void ScriptSignalV8Proxy::connectWith(ScriptValue arg0, ScriptValue arg1, bool isCoalesced) {
     v8::Isolate *isolate = _engine->getIsolate();
     v8::Locker locker(isolate);
     v8::Isolate::Scope isolateScope(isolate);
@@ -1395,7 +1482,8 @@ void ScriptSignalV8Proxy::connect(ScriptValue arg0, ScriptValue arg1) {
         callback = unwrappedArg0->toV8Value();
     }
     if (!callback.get()->IsFunction()) {
-        isolate->ThrowError("Function expected as argument to 'connect'");
+        isolate->ThrowError(isCoalesced ? "Function expected as argument to 'connectCoalesced'"
+                                        : "Function expected as argument to 'connect'");
         return;
     }
 
@@ -1470,11 +1558,12 @@ void ScriptSignalV8Proxy::connect(ScriptValue arg0, ScriptValue arg1) {
     }
 
     // add this to our internal list of connections
-    Connection newConnection(callbackThis, callback);
+    Connection newConnection(callbackThis, callback, isCoalesced);
 
     withWriteLock([&]{
         _connections.append(newConnection);
     });
+    _engine->_numSignalConnections++;
 
     // inform Qt that we're connecting to this signal
     if (!_isConnected) {
@@ -1535,6 +1624,7 @@ void ScriptSignalV8Proxy::disconnect(ScriptValue arg0, ScriptValue arg1) {
         withWriteLock([&]{
             _connections.erase(lookup);
         });
+        _engine->_numSignalConnections--;
     }
 
     // remove a reference to ourselves from the destination callback
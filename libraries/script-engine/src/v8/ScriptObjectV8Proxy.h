@@ -18,6 +18,8 @@
 #ifndef hifi_ScriptObjectV8Proxy_h
 #define hifi_ScriptObjectV8Proxy_h
 
+#include <deque>
+
 #include <QtCore/QHash>
 #include <QtCore/QList>
 #include <QtCore/QPointer>
@@ -239,6 +241,8 @@ public:  // API
     // arg1 was had Null default value, but that needs isolate pointer in V8
     Q_INVOKABLE virtual void connect(ScriptValue arg0, ScriptValue arg1 = ScriptValue()) = 0;
     Q_INVOKABLE virtual void disconnect(ScriptValue arg0, ScriptValue arg1 = ScriptValue()) = 0;
+    // Connects a function that is called once per frame with the arguments of all the emissions since the last call
+    Q_INVOKABLE virtual void connectCoalesced(ScriptValue arg0, ScriptValue arg1 = ScriptValue()) = 0;
 };
 
 class ScriptSignalV8Proxy final : public ScriptSignalV8ProxyBase, public ReadWriteLockable {
@@ -247,8 +251,9 @@ private:  // storage
     public:
         V8ScriptValue thisValue;
         V8ScriptValue callback;
-        Connection(const V8ScriptValue &v8ThisValue, const V8ScriptValue &v8Callback) : 
-            thisValue(v8ThisValue), callback(v8Callback) {};
+        bool isCoalesced;
+        Connection(const V8ScriptValue &v8ThisValue, const V8ScriptValue &v8Callback, bool coalesced = false) :
+            thisValue(v8ThisValue), callback(v8Callback), isCoalesced(coalesced) {};
     };
     using ConnectionList = QList<Connection>;
 
@@ -261,6 +266,9 @@ private:  // implementation
     virtual int qt_metacall(QMetaObject::Call call, int id, void** arguments) override;
     int discoverMetaCallIdx();
     ConnectionList::iterator findConnection(V8ScriptValue thisObject, V8ScriptValue callback);
+    void connectWith(ScriptValue arg0, ScriptValue arg1, bool isCoalesced);
+    void callConnection(const Connection& conn, v8::Local<v8::Context> context, int numArgs, v8::Local<v8::Value>* args);
+    void queueCoalescedEvent(v8::Local<v8::Array> event);
     //QString fullName() const;
     static void weakHandleCallback(const v8::WeakCallbackInfo<ScriptSignalV8Proxy> &info);
 
@@ -268,6 +276,12 @@ public:  // API
     // arg1 was had Null default value, but that needs isolate pointer to create Null in V8
     virtual void connect(ScriptValue arg0, ScriptValue arg1 = ScriptValue()) override;
     virtual void disconnect(ScriptValue arg0, ScriptValue arg1 = ScriptValue()) override;
+    virtual void connectCoalesced(ScriptValue arg0, ScriptValue arg1 = ScriptValue()) override;
+
+    // Calls the coalesced connections with an array of the arguments of the emissions queued since their last call, unless
+    // ScriptManager::CoalescedSignalOptions::interval holds them back until a later frame
+    void deliverCoalescedEvents(qint64 nowMS);
+
     //Moved to public temporarily for debugging:
     QString fullName() const;
 
@@ -288,6 +302,13 @@ private:  // storage
     ConnectionList _connections;
     bool _isConnected{ false };
 
+    // The arguments of the emissions that wait for the coalesced connections, and the options of the signal, which are
+    // looked up when the first of them is queued
+    std::deque<v8::Global<v8::Value>> _coalescedEvents;
+    ScriptManager::CoalescedSignalOptions _coalescedOptions;
+    qint64 _lastCoalescedDelivery{ 0 };
+    bool _isCoalescedDeliveryScheduled{ false };
+
     // This allows skipping qobject check during disconnect, which is needed during cleanup because qobject is already deleted
     bool _cleanup{ false };
     // Context in which it was created
@@ -675,6 +675,15 @@ bool ScriptValueV8Wrapper::isArray() const {
     return _value.constGet()->IsArray();
 }
 
+bool ScriptValueV8Wrapper::isArrayBuffer() const {
+    auto isolate = _engine->getIsolate();
+    v8::Locker locker(isolate);
+    v8::Isolate::Scope isolateScope(isolate);
+    v8::HandleScope handleScope(isolate);
+    v8::Context::Scope contextScope(_engine->getContext());
+    return _value.constGet()->IsArrayBuffer();
+}
+
 bool ScriptValueV8Wrapper::isBool() const {
     auto isolate = _engine->getIsolate();
     v8::Locker locker(isolate);
@@ -84,6 +84,7 @@ public:  // ScriptValue implementation
 
     virtual bool equals(const ScriptValue& other) const override;
     virtual bool isArray() const override;
+    virtual bool isArrayBuffer() const override;
     virtual bool isBool() const override;
     virtual bool isError() const override;
     virtual bool isFunction() const override;
@@ -19,6 +19,7 @@
 #include <QWeakPointer>
 #include <QMutex>
 
+#include <atomic>
 #include <functional>
 #include <typeinfo>
 
@@ -84,6 +85,11 @@ private:
     template<typename T>
     size_t getHashCode() const;
 
+    // The instance of T, cached by each thread until a dependency is set or destroyed, so that the lookups that find it in
+    // the cache cost one atomic load and take no lock
+    template<typename T>
+    static const QWeakPointer<T>& getCachedInstance();
+
     QSharedPointer<Dependency> safeGet(size_t hashCode) const;
 
     QHash<size_t, QSharedPointer<Dependency>> _instanceHash;
@@ -92,41 +98,54 @@ private:
     mutable QRecursiveMutex _instanceHashMutex;
     mutable QMutex _inheritanceHashMutex;
 
+    // bumped by every set and destroy, which invalidates the instances that the threads cached
+    std::atomic<uint64_t> _generation { 0 };
+
     bool _exiting { false };
 };
 
 template <typename T>
-QSharedPointer<T> DependencyManager::get() {
+const QWeakPointer<T>& DependencyManager::getCachedInstance() {
     static size_t hashCode = manager().getHashCode<T>();
-    static QWeakPointer<T> instance;
+    struct CachedInstance {
+        uint64_t generation { (uint64_t)-1 };
+        QWeakPointer<T> instance;
+    };
+    static thread_local CachedInstance cached;
+
+    auto& dependencyManager = manager();
+    uint64_t generation = dependencyManager._generation.load(std::memory_order_acquire);
+    if (cached.generation != generation) {
+        cached.instance = qSharedPointerCast<T>(dependencyManager.safeGet(hashCode));
+        cached.generation = generation;
+    }
+    return cached.instance;
+}
 
-    if (instance.isNull()) {
-        instance = qSharedPointerCast<T>(manager().safeGet(hashCode));
+template <typename T>
+QSharedPointer<T> DependencyManager::get() {
+    QSharedPointer<T> instance = getCachedInstance<T>().toStrongRef();
 
 #ifndef QT_NO_DEBUG
-        // debug builds...
-        if (instance.isNull()) {
-            qWarning() << "DependencyManager::get(): No instance available for" << typeid(T).name();
-        }
+    // debug builds...
+    if (instance.isNull()) {
+        qWarning() << "DependencyManager::get(): No instance available for" << typeid(T).name();
+    }
 #else
-        // for non-debug builds, don't print "No instance available" during shutdown, because
-        // the act of printing this often causes crashes (because the LogHandler has-been/is-being
-        // deleted).
-        if (!manager()._exiting && instance.isNull()) {
-            qWarning() << "DependencyManager::get(): No instance available for" << typeid(T).name();
-        }
-#endif
+    // for non-debug builds, don't print "No instance available" during shutdown, because
+    // the act of printing this often causes crashes (because the LogHandler has-been/is-being
+    // deleted).
+    if (!manager()._exiting && instance.isNull()) {
+        qWarning() << "DependencyManager::get(): No instance available for" << typeid(T).name();
     }
+#endif
 
-    return instance.toStrongRef();
+    return instance;
 }
 
 template <typename T>
 bool DependencyManager::isSet() {
-    static size_t hashCode = manager().getHashCode<T>();
-
-    QSharedPointer<Dependency> instance = manager().safeGet(hashCode);
-    return !instance.isNull();
+    return !getCachedInstance<T>().toStrongRef().isNull();
 }
 
 template <typename T, typename ...Args>
@@ -142,6 +161,7 @@ QSharedPointer<T> DependencyManager::set(Args&&... args) {
 
     QSharedPointer<T> newInstance(new T(args...), &T::customDeleter);
     manager()._instanceHash.insert(hashCode, newInstance);
+    manager()._generation.fetch_add(1, std::memory_order_release);
 
     return newInstance;
 }
@@ -159,6 +179,7 @@ QSharedPointer<T> DependencyManager::set(Args&&... args) {
 
     QSharedPointer<T> newInstance(new I(args...), &I::customDeleter);
     manager()._instanceHash.insert(hashCode, newInstance);
+    manager()._generation.fetch_add(1, std::memory_order_release);
 
     return newInstance;
 }
@@ -169,6 +190,7 @@ void DependencyManager::destroy() {
 
     QMutexLocker lock(&manager()._instanceHashMutex);
     QSharedPointer<Dependency> shared = manager()._instanceHash.take(hashCode);
+    manager()._generation.fetch_add(1, std::memory_order_release);
     QWeakPointer<Dependency> weak = shared;
     shared.clear();
 
@@ -11,6 +11,7 @@
 
 #include "GLMHelpers.h"
 
+#include <algorithm>
 #include <limits>
 
 #include <glm/gtc/matrix_transform.hpp>
@@ -110,6 +111,34 @@ int unpackFloatVec3FromSignedTwoByteFixed(const unsigned char* sourceBuffer, glm
     return sourceBuffer - startPosition;
 }
 
+int packFloatVec3sToSignedTwoByteFixed(unsigned char* destBuffer, const glm::vec3* srcVectors, int count, int radix) {
+    using FixedType = int16_t;
+    const float* src = &srcVectors[0].x;
+    const int numScalars = 3 * count;
+    const float scale = (float)(1 << radix);
+
+    // the vec3's are tightly packed, so this is one flat loop over their components
+    for (int i = 0; i < numScalars; i++) {
+        FixedType twoByteFixed = (FixedType) glm::clamp(src[i] * scale, (float)std::numeric_limits<FixedType>::min(),
+            (float)std::numeric_limits<FixedType>::max());
+        memcpy(destBuffer + i * sizeof(FixedType), &twoByteFixed, sizeof(FixedType));
+    }
+    return numScalars * sizeof(FixedType);
+}
+
+int unpackFloatVec3sFromSignedTwoByteFixed(const unsigned char* sourceBuffer, glm::vec3* destinations, int count, int radix) {
+    float* dest = &destinations[0].x;
+    const int numScalars = 3 * count;
+    const float scale = (float)(1 << radix);
+
+    for (int i = 0; i < numScalars; i++) {
+        int16_t twoByteFixed;
+        memcpy(&twoByteFixed, sourceBuffer + i * sizeof(int16_t), sizeof(int16_t));
+        dest[i] = twoByteFixed / scale;
+    }
+    return numScalars * sizeof(int16_t);
+}
+
 int packFloatAngleToTwoByte(unsigned char* buffer, float degrees) {
     const float ANGLE_CONVERSION_RATIO = (std::numeric_limits<uint16_t>::max() / 360.0f);
 
@@ -231,6 +260,121 @@ int unpackOrientationQuatFromSixBytes(const unsigned char* buffer, glm::quat& qu
     return 6;
 }
 
+// block size for the batched quat kernels, small enough for the block to stay in registers or L1
+static const int QUAT_BLOCK_SIZE = 16;
+
+int packOrientationQuatsToSixBytes(unsigned char* buffer, const glm::quat* quatInputs, int count) {
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+    const uint32_t NUM_BITS_PER_COMPONENT = 15;
+    const uint32_t RANGE = (1 << NUM_BITS_PER_COMPONENT) - 1;
+
+    for (int base = 0; base < count; base += QUAT_BLOCK_SIZE) {
+        const int n = std::min(QUAT_BLOCK_SIZE, count - base);
+        const glm::quat* q = quatInputs + base;
+
+        uint16_t components[3][QUAT_BLOCK_SIZE];
+        uint8_t largest[QUAT_BLOCK_SIZE];
+
+        for (int k = 0; k < n; k++) {
+            float x = q[k].x;
+            float y = q[k].y;
+            float z = q[k].z;
+            float w = q[k].w;
+
+            // find largest component, with the same tie-breaking as the single version.
+            // NOTE: every comparison is made unconditionally and each select has a single condition,
+            // otherwise the compiler can't if-convert the loop and won't vectorize it
+            float ax = fabsf(x), ay = fabsf(y), az = fabsf(z), aw = fabsf(w);
+            float max01 = std::max(ax, ay);
+            float max012 = std::max(max01, az);
+            int32_t isY = ay > ax;
+            int32_t isZ = az > max01;
+            int32_t isW = aw > max012;
+
+            int32_t index = isY;
+            index = isZ ? 2 : index;
+            index = isW ? 3 : index;
+            float maxValue = isY ? y : x;
+            maxValue = isZ ? z : maxValue;
+            maxValue = isW ? w : maxValue;
+
+            // ensure that the sign of the dropped component is always negative.
+            float sign = (maxValue > 0.0f) ? -1.0f : 1.0f;
+
+            // keep the smallest three, in order
+            float c0 = (index == 0) ? y : x;
+            float c1 = (index <= 1) ? z : y;
+            float c2 = (index == 3) ? z : w;
+
+            // transform each component into 0..1 range and quantize into 0..range
+            // (through int32_t, which has a vector conversion, the values are always in range)
+            components[0][k] = (uint16_t)(int32_t)(((sign * c0 + MAGNITUDE) / (2.0f * MAGNITUDE)) * RANGE);
+            components[1][k] = (uint16_t)(int32_t)(((sign * c1 + MAGNITUDE) / (2.0f * MAGNITUDE)) * RANGE);
+            components[2][k] = (uint16_t)(int32_t)(((sign * c2 + MAGNITUDE) / (2.0f * MAGNITUDE)) * RANGE);
+            largest[k] = (uint8_t)index;
+        }
+
+        unsigned char* out = buffer + 6 * base;
+        for (int k = 0; k < n; k++) {
+            // encode the largestComponent into the high bits of the first two components
+            uint16_t c0 = (0x7fff & components[0][k]) | ((0x01 & largest[k]) << 15);
+            uint16_t c1 = (0x7fff & components[1][k]) | ((0x02 & largest[k]) << 14);
+            uint16_t c2 = components[2][k];
+
+            out[6 * k + 0] = HI_BYTE(c0);
+            out[6 * k + 1] = LO_BYTE(c0);
+            out[6 * k + 2] = HI_BYTE(c1);
+            out[6 * k + 3] = LO_BYTE(c1);
+            out[6 * k + 4] = HI_BYTE(c2);
+            out[6 * k + 5] = LO_BYTE(c2);
+        }
+    }
+    return 6 * count;
+}
+
+int unpackOrientationQuatsFromSixBytes(const unsigned char* buffer, glm::quat* quatOutputs, int count) {
+    const uint32_t NUM_BITS_PER_COMPONENT = 15;
+    const float RANGE = (float)((1 << NUM_BITS_PER_COMPONENT) - 1);
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+
+    for (int base = 0; base < count; base += QUAT_BLOCK_SIZE) {
+        const int n = std::min(QUAT_BLOCK_SIZE, count - base);
+        const unsigned char* in = buffer + 6 * base;
+
+        float components[3][QUAT_BLOCK_SIZE];
+        float missing[QUAT_BLOCK_SIZE];
+        uint8_t largest[QUAT_BLOCK_SIZE];
+
+        for (int k = 0; k < n; k++) {
+            for (int i = 0; i < 3; i++) {
+                uint16_t component = ((uint16_t)(0x7f & in[6 * k + 2 * i]) << 8) | in[6 * k + 2 * i + 1];
+                components[i][k] = ((float)component / RANGE) * (2.0f * MAGNITUDE) - MAGNITUDE;
+            }
+            // largestComponent is encoded into the highest bits of the first 2 components
+            largest[k] = ((0x80 & in[6 * k + 2]) >> 6) | ((0x80 & in[6 * k]) >> 7);
+        }
+
+        // missingComponent is always negative.
+        for (int k = 0; k < n; k++) {
+            missing[k] = -sqrtf(1.0f - components[0][k] * components[0][k] - components[1][k] * components[1][k] -
+                components[2][k] * components[2][k]);
+        }
+
+        // put the missing component back in its place
+        glm::quat* q = quatOutputs + base;
+        for (int k = 0; k < n; k++) {
+            int32_t index = largest[k];
+            float y = (index < 1) ? components[0][k] : components[1][k];
+            float z = (index < 2) ? components[1][k] : components[2][k];
+            q[k].x = (index == 0) ? missing[k] : components[0][k];
+            q[k].y = (index == 1) ? missing[k] : y;
+            q[k].z = (index == 2) ? missing[k] : z;
+            q[k].w = (index == 3) ? missing[k] : components[2][k];
+        }
+    }
+    return 6 * count;
+}
+
 bool closeEnough(float a, float b, float relativeError) {
     assert(relativeError >= 0.0f);
     // NOTE: we add EPSILON to the denominator so we can avoid checking for division by zero.
@@ -118,6 +118,11 @@ int unpackOrientationQuatFromBytes(const unsigned char* buffer, glm::quat& quatO
 int packOrientationQuatToSixBytes(unsigned char* buffer, const glm::quat& quatInput);
 int unpackOrientationQuatFromSixBytes(const unsigned char* buffer, glm::quat& quatOutput);
 
+// batched forms of the above for count quats packed back to back, as avatar joint rotations are.
+// These produce the same bytes and values as the single versions, in branch-free loops the compiler can vectorize.
+int packOrientationQuatsToSixBytes(unsigned char* buffer, const glm::quat* quatInputs, int count);
+int unpackOrientationQuatsFromSixBytes(const unsigned char* buffer, glm::quat* quatOutputs, int count);
+
 // Ratios need the be highly accurate when less than 10, but not very accurate above 10, and they
 // are never greater than 1000 to 1, this allows us to encode each component in 16bits
 int packFloatRatioToTwoByte(unsigned char* buffer, float ratio);
@@ -140,6 +145,10 @@ int unpackFloatScalarFromSignedTwoByteFixed(const int16_t* byteFixedPointer, flo
 int packFloatVec3ToSignedTwoByteFixed(unsigned char* destBuffer, const glm::vec3& srcVector, int radix);
 int unpackFloatVec3FromSignedTwoByteFixed(const unsigned char* sourceBuffer, glm::vec3& destination, int radix);
 
+// and for count vec3's packed back to back
+int packFloatVec3sToSignedTwoByteFixed(unsigned char* destBuffer, const glm::vec3* srcVectors, int count, int radix);
+int unpackFloatVec3sFromSignedTwoByteFixed(const unsigned char* sourceBuffer, glm::vec3* destinations, int count, int radix);
+
 bool closeEnough(float a, float b, float relativeError);
 
 /// \return vec3 with euler angles in radians
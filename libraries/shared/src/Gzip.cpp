@@ -11,145 +11,399 @@
 
 #include "Gzip.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include <QBuffer>
+
 #include <zlib.h>
 
 const int GZIP_WINDOWS_BIT = 31;
-const int GZIP_CHUNK_SIZE = 4096;
+const int GZIP_CHUNK_SIZE = 65536;
 const int DEFAULT_MEM_LEVEL = 8;
 
-bool gunzip(QByteArray source, QByteArray &destination) {
-    destination.clear();
-    if (source.length() == 0) {
-        return true;
-    }
+// the blocks that are deflated in parallel, primed with the deflate window's worth of the input before them
+const int GZIP_BLOCK_SIZE = 131072;
+const int GZIP_DICTIONARY_SIZE = 32768;
+const int GZIP_BLOCKS_PER_THREAD = 2;
+// room for the empty stored block that a sync flush ends with, and the bits before it
+const int SYNC_FLUSH_SIZE = 16;
 
-    z_stream strm;
+const int GZIP_HEADER_SIZE = 10;
+const int GZIP_TRAILER_SIZE = 8;
+const unsigned char GZIP_MAGIC[] = { 0x1f, 0x8b };
+const unsigned char GZIP_OS_UNKNOWN = 0xff;
+// the most deflate can compress data
+const int MAX_DEFLATE_RATIO = 1032;
+
+namespace {
+
+struct DeflateBlock {
+    QByteArray input;
+    QByteArray output;
+    bool isLast { false };
+    bool succeeded { false };
+    uLong crc { 0 };
+};
+
+void initStream(z_stream& strm) {
     strm.zalloc = Z_NULL;
     strm.zfree = Z_NULL;
     strm.opaque = Z_NULL;
-    strm.avail_in = 0;
     strm.next_in = Z_NULL;
+    strm.avail_in = 0;
+}
+
+int clampCompressionLevel(int compressionLevel) {
+    return qMax(Z_DEFAULT_COMPRESSION, qMin(9, compressionLevel));
+}
 
-    int status = inflateInit2(&strm, GZIP_WINDOWS_BIT);
+// Deflates a block to raw deflate data that ends on a byte boundary, so that the blocks can be joined in order. Only the
+// last block is finished, the others end with a sync flush.
+void deflateBlock(DeflateBlock& block, const char* dictionary, int dictionarySize, int compressionLevel) {
+    block.succeeded = false;
+    block.crc = crc32(crc32(0L, Z_NULL, 0), (const Bytef*)block.input.constData(), (uInt)block.input.size());
 
-    if (status != Z_OK) {
-        return false;
+    z_stream strm;
+    initStream(strm);
+    if (deflateInit2(&strm, compressionLevel, Z_DEFLATED, -MAX_WBITS, DEFAULT_MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return;
+    }
+    if (dictionarySize > 0 && deflateSetDictionary(&strm, (const Bytef*)dictionary, (uInt)dictionarySize) != Z_OK) {
+        deflateEnd(&strm);
+        return;
     }
 
-    char *sourceData = source.data();
-    int sourceDataLength = source.length();
+    block.output.resize((int)deflateBound(&strm, (uLong)block.input.size()) + SYNC_FLUSH_SIZE);
+    strm.next_in = (Bytef*)block.input.constData();
+    strm.avail_in = (uInt)block.input.size();
 
+    int flush = block.isLast ? Z_FINISH : Z_SYNC_FLUSH;
+    int written = 0;
     for (;;) {
-        int chunkSize = qMin(GZIP_CHUNK_SIZE, sourceDataLength);
-        if (chunkSize <= 0) {
+        strm.next_out = (Bytef*)block.output.data() + written;
+        strm.avail_out = (uInt)(block.output.size() - written);
+        int status = deflate(&strm, flush);
+        written = block.output.size() - (int)strm.avail_out;
+        if (status == Z_STREAM_ERROR) {
+            break;
+        }
+        if (block.isLast ? status == Z_STREAM_END : strm.avail_out > 0) {
+            block.succeeded = true;
             break;
         }
+        if (strm.avail_out > 0) {
+            // no progress with room left
+            break;
+        }
+        block.output.resize(block.output.size() * 2);
+    }
+    block.output.resize(written);
+
+    deflateEnd(&strm);
+}
+
+void forEachBlock(size_t count, const std::function<void(size_t)>& function) {
+    size_t numThreads = std::min<size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+    if (numThreads <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            function(i);
+        }
+        return;
+    }
 
-        strm.next_in = (unsigned char*)sourceData;
-        strm.avail_in = chunkSize;
-        sourceData += chunkSize;
-        sourceDataLength -= chunkSize;
+    std::atomic<size_t> next { 0 };
+    auto work = [&] {
+        for (size_t i = next++; i < count; i = next++) {
+            function(i);
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (size_t i = 1; i < numThreads; i++) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
 
-        for (;;) {
-            char out[GZIP_CHUNK_SIZE];
+// reads until the buffer is full or the source ends
+qint64 readBlock(QIODevice& source, char* data, qint64 maxSize) {
+    qint64 total = 0;
+    while (total < maxSize) {
+        qint64 bytesRead = source.read(data + total, maxSize - total);
+        if (bytesRead < 0) {
+            return -1;
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+        total += bytesRead;
+    }
+    return total;
+}
 
-            strm.next_out = (unsigned char*)out;
-            strm.avail_out = GZIP_CHUNK_SIZE;
+bool writeLittleEndian(QIODevice& destination, quint32 value) {
+    char bytes[4];
+    for (int i = 0; i < 4; i++) {
+        bytes[i] = (char)((value >> (8 * i)) & 0xff);
+    }
+    return destination.write(bytes, 4) == 4;
+}
 
-            status = inflate(&strm, Z_NO_FLUSH);
+bool hasGzipMagic(const unsigned char* data, size_t size) {
+    return size >= 2 && data[0] == GZIP_MAGIC[0] && data[1] == GZIP_MAGIC[1];
+}
 
-            switch (status) {
-                case Z_NEED_DICT:
-                    status = Z_DATA_ERROR;
-                    // FALLTHRU
-                case Z_DATA_ERROR:
-                case Z_MEM_ERROR:
-                case Z_STREAM_ERROR:
-                    inflateEnd(&strm);
-                    return false;
+// Inflates the gzip members in the input one after the other, until the input or the room for the output runs out or
+// the last member ends. Returns Z_STREAM_END once it has, Z_OK if it ran out of input or room, or an error.
+int inflateMembers(z_stream& strm) {
+    for (;;) {
+        int status = inflate(&strm, Z_NO_FLUSH);
+        if (status == Z_STREAM_END) {
+            if (hasGzipMagic(strm.next_in, strm.avail_in)) {
+                inflateReset(&strm);
+                continue;
             }
+            return Z_STREAM_END;
+        }
+        if (status == Z_NEED_DICT) {
+            return Z_DATA_ERROR;
+        }
+        if (status != Z_OK && status != Z_BUF_ERROR) {
+            return status;
+        }
+        return Z_OK;
+    }
+}
 
-            int available = (GZIP_CHUNK_SIZE - strm.avail_out);
-            if (available > 0) {
-                destination.append((char*)out, available);
-            }
+}
 
-            if (strm.avail_out != 0) {
-                break;
+bool gzip(QIODevice& source, QIODevice& destination, int compressionLevel) {
+    compressionLevel = clampCompressionLevel(compressionLevel);
+
+    // no modification time, flags or extra compression info
+    const char header[GZIP_HEADER_SIZE] = { (char)GZIP_MAGIC[0], (char)GZIP_MAGIC[1], Z_DEFLATED, 0, 0, 0, 0, 0, 0,
+                                            (char)GZIP_OS_UNKNOWN };
+    if (destination.write(header, GZIP_HEADER_SIZE) != GZIP_HEADER_SIZE) {
+        return false;
+    }
+
+    size_t blocksPerBatch = std::max(1u, std::thread::hardware_concurrency()) * GZIP_BLOCKS_PER_THREAD;
+    std::vector<DeflateBlock> blocks(blocksPerBatch);
+    QByteArray dictionary;
+    uLong crc = crc32(0L, Z_NULL, 0);
+    quint64 totalSize = 0;
+
+    bool finished = false;
+    while (!finished) {
+        size_t count = 0;
+        while (count < blocksPerBatch && !finished) {
+            auto& block = blocks[count++];
+            block.input.resize(GZIP_BLOCK_SIZE);
+            qint64 bytesRead = readBlock(source, block.input.data(), GZIP_BLOCK_SIZE);
+            if (bytesRead < 0) {
+                return false;
             }
+            block.input.resize((int)bytesRead);
+            // a source that ends on a block boundary without knowing it is finished with an empty last block
+            finished = bytesRead < GZIP_BLOCK_SIZE || source.atEnd();
+            block.isLast = finished;
         }
 
-        if (status == Z_STREAM_END) {
-            break;
+        forEachBlock(count, [&](size_t i) {
+            const QByteArray& previous = i > 0 ? blocks[i - 1].input : dictionary;
+            int dictionarySize = std::min(previous.size(), GZIP_DICTIONARY_SIZE);
+            deflateBlock(blocks[i], previous.constData() + previous.size() - dictionarySize, dictionarySize,
+                         compressionLevel);
+        });
+
+        for (size_t i = 0; i < count; i++) {
+            const auto& block = blocks[i];
+            if (!block.succeeded || destination.write(block.output) != block.output.size()) {
+                return false;
+            }
+            crc = crc32_combine(crc, block.crc, (z_off_t)block.input.size());
+            totalSize += block.input.size();
         }
+        dictionary = blocks[count - 1].input.right(GZIP_DICTIONARY_SIZE);
     }
 
-    inflateEnd(&strm);
-    return status == Z_STREAM_END;
+    // the size is recorded modulo 2^32, as in any gzip file
+    return writeLittleEndian(destination, (quint32)crc) && writeLittleEndian(destination, (quint32)totalSize);
 }
 
-bool gzip(QByteArray source, QByteArray &destination, int compressionLevel) {
+bool gzip(const QByteArray& source, QByteArray& destination, int compressionLevel) {
     destination.clear();
     if (source.length() == 0) {
         return true;
     }
 
-    int flushOrFinish = 0;
-    z_stream strm;
-    strm.zalloc = Z_NULL;
-    strm.zfree = Z_NULL;
-    strm.opaque = Z_NULL;
-    strm.next_in = Z_NULL;
-    strm.avail_in = 0;
+    QBuffer input;
+    input.setData(source);
+    input.open(QIODevice::ReadOnly);
+    QBuffer output(&destination);
+    output.open(QIODevice::WriteOnly);
+    return gzip(input, output, compressionLevel);
+}
 
-    int status = deflateInit2(&strm,
-                              qMax(Z_DEFAULT_COMPRESSION, qMin(9, compressionLevel)),
-                              Z_DEFLATED,
-                              GZIP_WINDOWS_BIT,
-                              DEFAULT_MEM_LEVEL,
-                              Z_DEFAULT_STRATEGY);
-    if (status != Z_OK) {
+bool gunzip(QIODevice& source, QIODevice& destination) {
+    z_stream strm;
+    initStream(strm);
+    if (inflateInit2(&strm, GZIP_WINDOWS_BIT) != Z_OK) {
         return false;
     }
-    char *sourceData = source.data();
-    int sourceDataLength = source.length();
+
+    std::vector<char> input(GZIP_CHUNK_SIZE);
+    std::vector<char> output(GZIP_CHUNK_SIZE);
+    bool isSourceAtEnd = false;
+    bool hasReadAny = false;
+    bool hasMemberEnded = false;
+    bool succeeded = false;
 
     for (;;) {
-        int chunkSize = qMin(GZIP_CHUNK_SIZE, sourceDataLength);
-        strm.next_in = (unsigned char*)sourceData;
-        strm.avail_in = chunkSize;
-        sourceData += chunkSize;
-        sourceDataLength -= chunkSize;
-
-        if (sourceDataLength <= 0) {
-            flushOrFinish = Z_FINISH;
-        } else {
-            flushOrFinish = Z_NO_FLUSH;
-        }
-
-        for (;;) {
-            char out[GZIP_CHUNK_SIZE];
-            strm.next_out = (unsigned char*)out;
-            strm.avail_out = GZIP_CHUNK_SIZE;
-            status = deflate(&strm, flushOrFinish);
-            if (status == Z_STREAM_ERROR) {
-                deflateEnd(&strm);
-                return false;
+        if (!isSourceAtEnd && (strm.avail_in == 0 || hasMemberEnded)) {
+            // keep what is left, which may be the start of another member
+            if (strm.avail_in > 0) {
+                memmove(input.data(), strm.next_in, strm.avail_in);
+            }
+            qint64 bytesRead = source.read(input.data() + strm.avail_in, (qint64)input.size() - strm.avail_in);
+            if (bytesRead < 0) {
+                break;
             }
-            int available = (GZIP_CHUNK_SIZE - strm.avail_out);
-            if (available > 0) {
-                destination.append((char*)out, available);
+            isSourceAtEnd = bytesRead == 0;
+            hasReadAny = hasReadAny || bytesRead > 0;
+            strm.next_in = (Bytef*)input.data();
+            strm.avail_in += (uInt)bytesRead;
+        }
+
+        if (!hasReadAny) {
+            succeeded = true;
+            break;
+        }
+        if (hasMemberEnded) {
+            if (strm.avail_in < 2 && !isSourceAtEnd) {
+                continue;
             }
-            if (strm.avail_out != 0) {
+            if (!hasGzipMagic(strm.next_in, strm.avail_in)) {
+                succeeded = true;
                 break;
             }
+            inflateReset(&strm);
+            hasMemberEnded = false;
         }
 
-        if (flushOrFinish == Z_FINISH) {
+        strm.next_out = (Bytef*)output.data();
+        strm.avail_out = (uInt)output.size();
+        int status = inflateMembers(strm);
+        qint64 available = (qint64)output.size() - strm.avail_out;
+        if (available > 0 && destination.write(output.data(), available) != available) {
+            break;
+        }
+
+        if (status == Z_STREAM_END) {
+            if (isSourceAtEnd || strm.avail_in >= 2) {
+                succeeded = true;
+                break;
+            }
+            // too little is left to know whether another member follows
+            hasMemberEnded = true;
+        } else if (status != Z_OK || (strm.avail_out > 0 && (isSourceAtEnd || strm.avail_in > 0))) {
+            // bad or truncated data
             break;
         }
     }
 
-    deflateEnd(&strm);
+    inflateEnd(&strm);
+    return succeeded;
+}
+
+bool gunzip(const char* source, size_t sourceSize, char* destination, size_t capacity, size_t& size) {
+    size = 0;
+    if (sourceSize == 0) {
+        return true;
+    }
+    if (sourceSize > std::numeric_limits<uInt>::max() || capacity > std::numeric_limits<uInt>::max()) {
+        return false;
+    }
+
+    z_stream strm;
+    initStream(strm);
+    if (inflateInit2(&strm, GZIP_WINDOWS_BIT) != Z_OK) {
+        return false;
+    }
+
+    strm.next_in = (Bytef*)source;
+    strm.avail_in = (uInt)sourceSize;
+    strm.next_out = (Bytef*)destination;
+    strm.avail_out = (uInt)capacity;
+    int status = inflateMembers(strm);
+    size = capacity - strm.avail_out;
+
+    inflateEnd(&strm);
     return status == Z_STREAM_END;
 }
+
+bool gunzip(const QByteArray& source, QByteArray& destination) {
+    destination.clear();
+    if (source.length() == 0) {
+        return true;
+    }
+    // not gzip data, which the callers often try first
+    if (!hasGzipMagic((const unsigned char*)source.constData(), source.size())) {
+        return false;
+    }
+
+    z_stream strm;
+    initStream(strm);
+    if (inflateInit2(&strm, GZIP_WINDOWS_BIT) != Z_OK) {
+        return false;
+    }
+
+    // the last four bytes are the size of the last member, which is usually the only one
+    int capacity = source.size();
+    if (source.size() >= GZIP_HEADER_SIZE + GZIP_TRAILER_SIZE) {
+        const unsigned char* trailer = (const unsigned char*)source.constData() + source.size() - 4;
+        quint32 recordedSize = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | ((quint32)trailer[3] << 24);
+        if (recordedSize <= (quint64)source.size() * MAX_DEFLATE_RATIO &&
+            recordedSize <= (quint32)std::numeric_limits<int>::max()) {
+            capacity = std::max(capacity, (int)recordedSize);
+        }
+    }
+    destination.resize(capacity);
+
+    strm.next_in = (Bytef*)source.constData();
+    strm.avail_in = (uInt)source.size();
+    int written = 0;
+    bool succeeded = false;
+    for (;;) {
+        strm.next_out = (Bytef*)destination.data() + written;
+        strm.avail_out = (uInt)(destination.size() - written);
+        int status = inflateMembers(strm);
+        written = destination.size() - (int)strm.avail_out;
+        if (status == Z_STREAM_END) {
+            succeeded = true;
+            break;
+        }
+        if (status != Z_OK || strm.avail_out > 0 || destination.size() == std::numeric_limits<int>::max()) {
+            // bad or truncated data
+            break;
+        }
+        destination.resize((int)std::min<qint64>((qint64)destination.size() * 2, std::numeric_limits<int>::max()));
+    }
+
+    inflateEnd(&strm);
+    if (succeeded) {
+        destination.resize(written);
+    } else {
+        destination.clear();
+    }
+    return succeeded;
+}
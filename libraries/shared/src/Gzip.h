@@ -13,15 +13,30 @@
 #define GZIP_H
 
 #include <QByteArray>
+#include <QIODevice>
 
 // The compression level must be Z_DEFAULT_COMPRESSION (-1), or between 0 and
 // 9: 1 gives best speed, 9 gives best compression, 0 gives no
 // compression at all (the input data is simply copied a block at a
 // time).  Z_DEFAULT_COMPRESSION requests a default compromise between
 // speed and compression (currently equivalent to level 6).
+//
+// Inputs larger than a block of 128KB are split into blocks that are deflated on several threads, each primed with the
+// end of the block before it, and joined into a single standard gzip member, the way pigz does.
+
+bool gzip(const QByteArray& source, QByteArray& destination, int compressionLevel = -1); // -1 is Z_DEFAULT_COMPRESSION
+
+// Reads the source to its end, writing its compressed form to the destination as it goes, so that neither whole
+// needs to be held in memory
+bool gzip(QIODevice& source, QIODevice& destination, int compressionLevel = -1);
+
+// The QByteArray version sizes the destination from the length recorded at the end of the data and inflates into it in
+// place. Concatenated gzip members are decompressed one after the other.
+bool gunzip(const QByteArray& source, QByteArray& destination);
 
-bool gzip(QByteArray source, QByteArray &destination, int compressionLevel = -1); // -1 is Z_DEFAULT_COMPRESSION
+bool gunzip(QIODevice& source, QIODevice& destination);
 
-bool gunzip(QByteArray source, QByteArray &destination);
+// Decompresses into a buffer of the caller's, failing if it is too small. size is set to the number of bytes written.
+bool gunzip(const char* source, size_t sourceSize, char* destination, size_t capacity, size_t& size);
 
 #endif
@@ -0,0 +1,84 @@
+//
+//  InternedUrl.cpp
+//  libraries/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "InternedUrl.h"
+
+#include <QtCore/QReadWriteLock>
+
+namespace {
+
+    const int MIN_SIZE_TO_PRUNE = 1024;
+
+    struct UrlTable {
+        QReadWriteLock lock;
+        QHash<QUrl, std::weak_ptr<const QUrl>> urls;
+        int sizeToPrune { MIN_SIZE_TO_PRUNE };
+    };
+
+    UrlTable& getUrlTable() {
+        static UrlTable table;
+        return table;
+    }
+
+}
+
+InternedUrl::InternedUrl(const QUrl& url) {
+    if (url.isEmpty()) {
+        return;
+    }
+
+    auto& table = getUrlTable();
+    {
+        // most URLs are interned already, by the resource that was created for them
+        QReadLocker locker(&table.lock);
+        auto itr = table.urls.constFind(url);
+        if (itr != table.urls.constEnd()) {
+            _url = itr.value().lock();
+            if (_url) {
+                return;
+            }
+        }
+    }
+
+    QWriteLocker locker(&table.lock);
+    auto& entry = table.urls[url];
+    _url = entry.lock();
+    if (_url) {
+        return;
+    }
+    _url = std::make_shared<const QUrl>(url);
+    entry = _url;
+
+    if (table.urls.size() >= table.sizeToPrune) {
+        for (auto itr = table.urls.begin(); itr != table.urls.end();) {
+            if (itr.value().expired()) {
+                itr = table.urls.erase(itr);
+            } else {
+                ++itr;
+            }
+        }
+        table.sizeToPrune = 2 * table.urls.size();
+        if (table.sizeToPrune < MIN_SIZE_TO_PRUNE) {
+            table.sizeToPrune = MIN_SIZE_TO_PRUNE;
+        }
+    }
+}
+
+const QUrl& InternedUrl::getUrl() const {
+    static const QUrl EMPTY_URL;
+    return _url ? *_url : EMPTY_URL;
+}
+
+int InternedUrl::getNumInternedUrls() {
+    auto& table = getUrlTable();
+    QReadLocker locker(&table.lock);
+    return table.urls.size();
+}
@@ -0,0 +1,44 @@
+//
+//  InternedUrl.h
+//  libraries/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_InternedUrl_h
+#define overte_InternedUrl_h
+
+#include <memory>
+
+#include <QtCore/QHash>
+#include <QtCore/QUrl>
+
+/// A handle to a URL interned in a table shared by all threads, so that the handles of equal URLs are the same, and comparing
+/// or hashing handles is comparing or hashing a pointer instead of every component of the URLs.  The URLs are held as long
+/// as they have handles, the table drops the others once it has doubled in size since it was last pruned.
+class InternedUrl {
+public:
+    InternedUrl() {}
+    explicit InternedUrl(const QUrl& url);
+
+    /// The URL of the handle, an empty URL for the null handle
+    const QUrl& getUrl() const;
+    bool isNull() const { return !_url; }
+
+    bool operator==(const InternedUrl& other) const { return _url == other._url; }
+    bool operator!=(const InternedUrl& other) const { return _url != other._url; }
+
+    /// The number of URLs in the table, some of which may not have handles anymore
+    static int getNumInternedUrls();
+
+    friend uint qHash(const InternedUrl& url, uint seed = 0) { return qHash((quintptr)url._url.get(), seed); }
+
+private:
+    std::shared_ptr<const QUrl> _url;
+};
+
+#endif // overte_InternedUrl_h
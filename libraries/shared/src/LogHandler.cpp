@@ -12,7 +12,9 @@
 
 #include "LogHandler.h"
 #include "Breakpoint.h"
+#include "NumericalConstants.h"
 
+#include <chrono>
 #include <mutex>
 
 #ifdef Q_OS_WIN
@@ -39,12 +41,104 @@
 
 QRecursiveMutex LogHandler::_mutex;
 
+// a power of two, the messages that are logged while the queue is full are dropped
+static const size_t MESSAGE_QUEUE_CAPACITY = 8192;
+static const int DEFAULT_CATEGORY_RATE_LIMIT = 500; // messages per second
+// how long the log thread waits when the queue is empty, if it wasn't woken up by a message
+static const std::chrono::milliseconds LOG_THREAD_WAIT { 100 };
+
+// The message, its context and when and where it was logged, all copied so that they're formatted by the log thread
+struct LogHandler::QueuedMessage {
+    LogMsgType type { LogDebug };
+    qint64 timestamp { 0 }; // msecs since epoch
+    Qt::HANDLE threadID { nullptr };
+    QByteArray file;
+    int line { 0 };
+    QByteArray function;
+    QByteArray category;
+    QString message;
+};
+
+// A bounded queue after Dmitry Vyukov's that doesn't lock, the messages are pushed by the threads that log and popped
+// by the log thread or by the thread that flushes the queue.  Each cell has a sequence number that tells whether it's
+// free to push to, or to pop from, at a position.
+class LogHandler::MessageQueue {
+public:
+    MessageQueue(size_t capacity) : _cells(capacity), _mask(capacity - 1) {
+        for (size_t i = 0; i < capacity; ++i) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool push(QueuedMessage&& message) {
+        size_t position = _pushPosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &_cells[position & _mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+            if (difference == 0) {
+                if (_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                // the queue is full
+                return false;
+            } else {
+                position = _pushPosition.load(std::memory_order_relaxed);
+            }
+        }
+        cell->message = std::move(message);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(QueuedMessage& message) {
+        size_t position = _popPosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &_cells[position & _mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = (intptr_t)sequence - (intptr_t)(position + 1);
+            if (difference == 0) {
+                if (_popPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                // the queue is empty
+                return false;
+            } else {
+                position = _popPosition.load(std::memory_order_relaxed);
+            }
+        }
+        message = std::move(cell->message);
+        cell->sequence.store(position + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return _mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        QueuedMessage message;
+    };
+
+    std::vector<Cell> _cells;
+    const size_t _mask;
+    alignas(64) std::atomic<size_t> _pushPosition { 0 };
+    alignas(64) std::atomic<size_t> _popPosition { 0 };
+};
+
 LogHandler& LogHandler::getInstance() {
     static LogHandler staticInstance;
     return staticInstance;
 }
 
-LogHandler::LogHandler() {
+LogHandler::LogHandler() :
+    _queue(new MessageQueue(MESSAGE_QUEUE_CAPACITY)),
+    _categoryRateLimit(DEFAULT_CATEGORY_RATE_LIMIT)
+{
     QString logOptions = qgetenv("OVERTE_LOG_OPTIONS").toLower();
 
 #ifdef Q_OS_UNIX
@@ -64,6 +158,10 @@ LogHandler::LogHandler() {
     parseOptions(logOptions, "OVERTE_LOG_OPTIONS");
 }
 
+LogHandler::~LogHandler() {
+    stopLogThread();
+}
+
 const char* stringForLogType(LogMsgType msgType) {
     switch (msgType) {
         case LogInfo:
@@ -144,6 +242,10 @@ bool LogHandler::parseOptions(const QString& logOptions, const QString& paramNam
             _useJournald = true;
         } else if (option == "nojournald") {
             _useJournald = false;
+        } else if (option == "sync") {
+            _asynchronous = false;
+        } else if (option == "no_rate_limit") {
+            _categoryRateLimit = 0;
         } else if (option != "") {
             fprintf(stderr, "Unrecognized option in %s: '%s'\n", paramName.toUtf8().constData(), option.toUtf8().constData());
             return false;
@@ -201,7 +303,7 @@ void LogHandler::flushRepeatedMessages() {
         if (repeatCount > 1) {
             QString repeatLogMessage = QString().setNum(repeatCount) + " repeated log entries - Last entry: \""
                     + _repeatedMessageRecords[m].repeatString + "\"";
-            printMessage(LogSuppressed, QMessageLogContext(), repeatLogMessage);
+            queueMessage(LogSuppressed, QMessageLogContext(), repeatLogMessage);
             _repeatedMessageRecords[m].repeatCount = 0;
             _repeatedMessageRecords[m].repeatString = QString();
         }
@@ -209,6 +311,11 @@ void LogHandler::flushRepeatedMessages() {
 }
 
 QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& context, const QString& message) {
+    return printMessage(type, context, message, QDateTime::currentDateTime(), QThread::currentThreadId());
+}
+
+QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& context, const QString& message,
+                                 const QDateTime& timestamp, Qt::HANDLE threadID) {
     if (message.isEmpty()) {
         return QString();
     }
@@ -223,7 +330,7 @@ QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& cont
         dateFormatPtr = &DATE_STRING_FORMAT_WITH_MILLISECONDS;
     }
 
-    QString prefixString = QString("[%1] [%2] [%3]").arg(QDateTime::currentDateTime().toString(*dateFormatPtr),
+    QString prefixString = QString("[%1] [%2] [%3]").arg(timestamp.toString(*dateFormatPtr),
         stringForLogType(type), context.category);
 
     if (_shouldOutputProcessID) {
@@ -231,8 +338,7 @@ QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& cont
     }
 
     if (_shouldOutputThreadID) {
-        size_t threadID = (size_t)QThread::currentThreadId();
-        prefixString.append(QString(" [%1]").arg(threadID));
+        prefixString.append(QString(" [%1]").arg((size_t)threadID));
     }
 
     if (!_targetName.isEmpty()) {
@@ -270,7 +376,7 @@ QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& cont
         QByteArray sd_message = QString("MESSAGE=%1").arg(message).toUtf8();
         QByteArray sd_priority = QString("PRIORITY=%1").arg(priority).toUtf8();
         QByteArray sd_category = QString("CATEGORY=%1").arg(context.category).toUtf8();
-        QByteArray sd_tid = QString("TID=%1").arg((qlonglong)QThread::currentThreadId()).toUtf8();
+        QByteArray sd_tid = QString("TID=%1").arg((qlonglong)threadID).toUtf8();
         QByteArray sd_target = QString("COMPONENT=%1").arg(_targetName).toUtf8();
 
         std::vector<struct iovec> fields;
@@ -343,8 +449,165 @@ QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& cont
     return logMessage;
 }
 
+void LogHandler::queueMessage(LogMsgType type, const QMessageLogContext& context, const QString& message) {
+    if (message.isEmpty()) {
+        return;
+    }
+
+    if (!_asynchronous || type == LogFatal || _stopLogThread) {
+        // the application is aborted once a fatal message is handled, so it's written right away after the queue
+        QMutexLocker lock(&_mutex);
+        while (writeQueuedMessages()) {
+        }
+        QString logMessage = printMessage(type, context, message);
+        if (_messageSink && !logMessage.isEmpty()) {
+            _messageSink(type, logMessage);
+        }
+        return;
+    }
+
+    startLogThread();
+
+    QueuedMessage queuedMessage;
+    queuedMessage.type = type;
+    queuedMessage.timestamp = QDateTime::currentMSecsSinceEpoch();
+    queuedMessage.threadID = QThread::currentThreadId();
+    queuedMessage.file = context.file;
+    queuedMessage.line = context.line;
+    queuedMessage.function = context.function;
+    queuedMessage.category = context.category;
+    queuedMessage.message = message;
+    if (!_queue->push(std::move(queuedMessage))) {
+        ++_numDroppedMessages;
+        return;
+    }
+
+    // only wake up the log thread when it's waiting, it otherwise finds the message on its next pass
+    if (_logThreadWaiting) {
+        _logThreadCondition.notify_one();
+    }
+}
+
+void LogHandler::flush() {
+    QMutexLocker lock(&_mutex);
+    while (writeQueuedMessages()) {
+    }
+}
+
+void LogHandler::setAsynchronous(bool asynchronous) {
+    _asynchronous = asynchronous;
+    if (!asynchronous) {
+        flush();
+    }
+}
+
+void LogHandler::setMessageSink(std::function<void(LogMsgType, const QString&)> sink) {
+    QMutexLocker lock(&_mutex);
+    _messageSink = sink;
+}
+
+void LogHandler::setCategoryRateLimit(int messagesPerSecond) {
+    QMutexLocker lock(&_mutex);
+    _categoryRateLimit = messagesPerSecond;
+}
+
+void LogHandler::startLogThread() {
+    std::call_once(_logThreadStarted, [this] {
+        _logThread = std::thread([this] {
+            runLogThread();
+        });
+    });
+}
+
+void LogHandler::stopLogThread() {
+    _stopLogThread = true;
+    if (_logThread.joinable()) {
+        _logThreadCondition.notify_one();
+        _logThread.join();
+    }
+    flush();
+}
+
+void LogHandler::runLogThread() {
+    while (!_stopLogThread) {
+        bool wroteMessages;
+        {
+            QMutexLocker lock(&_mutex);
+            wroteMessages = writeQueuedMessages();
+        }
+        if (!wroteMessages) {
+            std::unique_lock<std::mutex> lock(_logThreadMutex);
+            _logThreadWaiting = true;
+            _logThreadCondition.wait_for(lock, LOG_THREAD_WAIT);
+            _logThreadWaiting = false;
+        }
+    }
+}
+
+bool LogHandler::writeQueuedMessages() {
+    // write no more than a queue's worth at a time so that the mutex isn't held for ever by a thread that logs a lot
+    bool wroteMessages = false;
+    QueuedMessage queuedMessage;
+    for (size_t i = 0; i < _queue->capacity() && _queue->pop(queuedMessage); ++i) {
+        writeQueuedMessage(queuedMessage);
+        wroteMessages = true;
+    }
+
+    quint64 numDroppedMessages = _numDroppedMessages;
+    if (numDroppedMessages != _numReportedDroppedMessages) {
+        QString droppedMessage = QString("[%1 log messages were dropped because the log queue was full]")
+            .arg(numDroppedMessages - _numReportedDroppedMessages);
+        _numReportedDroppedMessages = numDroppedMessages;
+        QString logMessage = printMessage(LogWarning, QMessageLogContext(), droppedMessage);
+        if (_messageSink) {
+            _messageSink(LogWarning, logMessage);
+        }
+    }
+    return wroteMessages;
+}
+
+static const char* constDataOrNull(const QByteArray& string) {
+    return string.isNull() ? nullptr : string.constData();
+}
+
+void LogHandler::writeQueuedMessage(QueuedMessage& queuedMessage) {
+    QDateTime timestamp = QDateTime::fromMSecsSinceEpoch(queuedMessage.timestamp);
+
+    // critical messages are never rate limited
+    if (_categoryRateLimit > 0 && queuedMessage.type != LogCritical) {
+        CategoryRate& rate = _categoryRates[queuedMessage.category];
+        if (queuedMessage.timestamp - rate.windowStart >= (qint64)MSECS_PER_SECOND) {
+            if (rate.dropped > 0) {
+                QString droppedMessage = QString("[%1 messages of the category were dropped by its rate limit]")
+                    .arg(rate.dropped);
+                QString logMessage = printMessage(LogWarning, QMessageLogContext(nullptr, 0, nullptr,
+                    constDataOrNull(queuedMessage.category)), droppedMessage, timestamp, queuedMessage.threadID);
+                if (_messageSink) {
+                    _messageSink(LogWarning, logMessage);
+                }
+            }
+            rate.windowStart = queuedMessage.timestamp;
+            rate.count = 0;
+            rate.dropped = 0;
+        }
+        if (rate.count >= _categoryRateLimit) {
+            ++rate.dropped;
+            ++_numRateLimitedMessages;
+            return;
+        }
+        ++rate.count;
+    }
+
+    QMessageLogContext context(constDataOrNull(queuedMessage.file), queuedMessage.line, constDataOrNull(queuedMessage.function),
+        constDataOrNull(queuedMessage.category));
+    QString logMessage = printMessage(queuedMessage.type, context, queuedMessage.message, timestamp, queuedMessage.threadID);
+    if (_messageSink && !logMessage.isEmpty()) {
+        _messageSink(queuedMessage.type, logMessage);
+    }
+}
+
 void LogHandler::verboseMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message) {
-    getInstance().printMessage((LogMsgType) type, context, message);
+    getInstance().queueMessage((LogMsgType) type, context, message);
 }
 
 void LogHandler::setupRepeatedMessageFlusher() {
@@ -374,7 +637,7 @@ void LogHandler::printRepeatedMessage(int messageID, LogMsgType type, const QMes
     }
 
     if (_repeatedMessageRecords[messageID].repeatCount == 0) {
-        printMessage(type, context, message);
+        queueMessage(type, context, message);
     } else {
         _repeatedMessageRecords[messageID].repeatString = message;
     }
@@ -15,8 +15,15 @@
 
 #include <QObject>
 #include <QString>
+#include <QDateTime>
 #include <QRegExp>
 #include <QRecursiveMutex>
+#include <QHash>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <memory>
 
@@ -121,6 +128,52 @@ public:
      */
     QString printMessage(LogMsgType type, const QMessageLogContext& context, const QString &message);
 
+    /**
+     * @brief Queue a log message to be formatted and written by the log thread
+     *
+     * This never blocks the calling thread: when the queue is full the message is dropped, and counted. Fatal messages
+     * are written right away, after the messages that were queued before them. When the logging isn't asynchronous
+     * this is the same as printMessage.
+     *
+     * @param type  Log message type
+     * @param context Context of the log message (source file, line, function)
+     * @param message Log message
+     */
+    void queueMessage(LogMsgType type, const QMessageLogContext& context, const QString &message);
+
+    /**
+     * @brief Write the queued log messages from the calling thread
+     */
+    void flush();
+
+    /**
+     * @brief Set whether the messages of queueMessage are written by the log thread
+     *
+     * @param asynchronous Whether to write the messages from the log thread
+     */
+    void setAsynchronous(bool asynchronous);
+
+    /**
+     * @brief Set a function that's called with the text of each queued message once the log thread wrote it
+     *
+     * For instance to send the messages to the log file as well. The function is called from the log thread.
+     *
+     * @param sink The function, or an empty function to stop calling it
+     */
+    void setMessageSink(std::function<void(LogMsgType, const QString&)> sink);
+
+    /**
+     * @brief Set how many queued messages of a category are written in a second, the others are dropped and counted
+     *
+     * @param messagesPerSecond The number of messages, or 0 to write them all
+     */
+    void setCategoryRateLimit(int messagesPerSecond);
+
+    /**
+     * @brief The number of queued messages that were dropped because the queue was full or by the rate limit
+     */
+    quint64 getNumDroppedMessages() const { return _numDroppedMessages + _numRateLimitedMessages; }
+
     /**
      * @brief A qtMessageHandler that can be hooked up to a target that links to Qt
      *
@@ -159,11 +212,24 @@ public:
      */
     static void breakOnMessage(const char *str);
 private:
+    class MessageQueue;
+    struct QueuedMessage;
+
     LogHandler();
-    ~LogHandler() = default;
+    ~LogHandler();
 
     void flushRepeatedMessages();
 
+    QString printMessage(LogMsgType type, const QMessageLogContext& context, const QString& message,
+        const QDateTime& timestamp, Qt::HANDLE threadID);
+
+    void startLogThread();
+    void stopLogThread();
+    void runLogThread();
+    // writes the queued messages, returns false if there were none, must be called with the mutex locked
+    bool writeQueuedMessages();
+    void writeQueuedMessage(QueuedMessage& queuedMessage);
+
     QString _targetName;
     bool _shouldOutputProcessID { false };
     bool _shouldOutputThreadID { false };
@@ -185,6 +251,29 @@ private:
 
     QStringList _breakMessages;
     static QRecursiveMutex _mutex;
+
+    // the messages are formatted and written by the log thread so that logging never blocks the threads that log
+    std::unique_ptr<MessageQueue> _queue;
+    std::atomic<bool> _asynchronous { true };
+    std::atomic<quint64> _numDroppedMessages { 0 };
+    quint64 _numReportedDroppedMessages { 0 };
+    std::function<void(LogMsgType, const QString&)> _messageSink;
+
+    std::once_flag _logThreadStarted;
+    std::thread _logThread;
+    std::atomic<bool> _stopLogThread { false };
+    std::atomic<bool> _logThreadWaiting { false };
+    std::mutex _logThreadMutex;
+    std::condition_variable _logThreadCondition;
+
+    struct CategoryRate {
+        qint64 windowStart { 0 };
+        int count { 0 };
+        int dropped { 0 };
+    };
+    int _categoryRateLimit;
+    QHash<QByteArray, CategoryRate> _categoryRates;
+    std::atomic<quint64> _numRateLimitedMessages { 0 };
 };
 
 #define HIFI_FCDEBUG(category, message) \
@@ -0,0 +1,234 @@
+//
+//  OcclusionBuffer.cpp
+//  libraries/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "OcclusionBuffer.h"
+
+#include <float.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "ViewFrustum.h"
+
+// the level of the pyramid read by a query is the first one where the bound spans at most this many cells per axis
+static const int MAX_QUERY_CELLS = 4;
+
+void OcclusionBuffer::clear(const ViewFrustum& frustum, int width, int height) {
+    _enabled = frustum.isPerspective();
+    _numOccluders = 0;
+    _pyramidDirty = false;
+    if (!_enabled) {
+        return;
+    }
+
+    glm::mat4 worldToView = glm::inverse(frustum.getView());
+    _viewProjection = frustum.getProjection() * worldToView;
+    // the view looks down -z
+    _depthRow = -glm::vec4(worldToView[0][2], worldToView[1][2], worldToView[2][2], worldToView[3][2]);
+    _eye = frustum.getPosition();
+    _nearClip = frustum.getNearClip();
+
+    if (width != _width || height != _height) {
+        _width = width;
+        _height = height;
+        _levels.clear();
+        _levelSizes.clear();
+        glm::ivec2 size(width, height);
+        while (true) {
+            _levelSizes.push_back(size);
+            _levels.emplace_back(size.x * size.y);
+            if (size.x == 1 && size.y == 1) {
+                break;
+            }
+            size = (size + glm::ivec2(1)) / 2;
+        }
+    }
+    for (auto& level : _levels) {
+        std::fill(level.begin(), level.end(), FLT_MAX);
+    }
+}
+
+bool OcclusionBuffer::project(const glm::vec3& point, glm::vec3& projected) const {
+    glm::vec4 position(point, 1.0f);
+    float depth = glm::dot(_depthRow, position);
+    if (depth < _nearClip) {
+        return false;
+    }
+    glm::vec4 clip = _viewProjection * position;
+    projected.x = (clip.x / clip.w * 0.5f + 0.5f) * (float)_width;
+    projected.y = (clip.y / clip.w * 0.5f + 0.5f) * (float)_height;
+    projected.z = depth;
+    return true;
+}
+
+void OcclusionBuffer::addOccluder(const AABox& occluder) {
+    if (!_enabled || occluder.contains(_eye)) {
+        return;
+    }
+
+    glm::vec3 minimum = occluder.getMinimumPoint();
+    glm::vec3 maximum = occluder.getMaximumPoint();
+    for (int axis = 0; axis < 3; ++axis) {
+        float plane;
+        if (_eye[axis] < minimum[axis]) {
+            plane = minimum[axis];
+        } else if (_eye[axis] > maximum[axis]) {
+            plane = maximum[axis];
+        } else {
+            continue;
+        }
+
+        int u = (axis + 1) % 3;
+        int v = (axis + 2) % 3;
+        glm::vec3 corners[4];
+        for (int i = 0; i < 4; ++i) {
+            corners[i][axis] = plane;
+            corners[i][u] = (i == 1 || i == 2) ? maximum[u] : minimum[u];
+            corners[i][v] = (i >= 2) ? maximum[v] : minimum[v];
+        }
+        rasterizeFace(corners);
+    }
+    ++_numOccluders;
+}
+
+void OcclusionBuffer::rasterizeFace(const glm::vec3 corners[4]) {
+    glm::vec3 projected[4];
+    for (int i = 0; i < 4; ++i) {
+        if (!project(corners[i], projected[i])) {
+            return;
+        }
+    }
+
+    // a rectangle in front of the view projects to a convex quad, a pixel is covered if its four corners are in it
+    float area = 0.0f;
+    float depth = 0.0f;
+    glm::vec2 minimum(FLT_MAX);
+    glm::vec2 maximum(-FLT_MAX);
+    for (int i = 0; i < 4; ++i) {
+        const glm::vec3& a = projected[i];
+        const glm::vec3& b = projected[(i + 1) % 4];
+        area += a.x * b.y - b.x * a.y;
+        depth = std::max(depth, a.z);
+        minimum = glm::min(minimum, glm::vec2(a));
+        maximum = glm::max(maximum, glm::vec2(a));
+    }
+    const float MIN_AREA = 1.0f;
+    if (fabsf(area) < MIN_AREA) {
+        return;
+    }
+    float winding = area > 0.0f ? 1.0f : -1.0f;
+    auto isInside = [&](float x, float y) {
+        for (int i = 0; i < 4; ++i) {
+            const glm::vec3& a = projected[i];
+            const glm::vec3& b = projected[(i + 1) % 4];
+            if (winding * ((b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x)) < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // clamp before converting, points near the near clip project very far out
+    glm::vec2 size((float)_width, (float)_height);
+    minimum = glm::clamp(minimum, glm::vec2(0.0f), size);
+    maximum = glm::clamp(maximum, glm::vec2(0.0f), size);
+    int x0 = (int)floorf(minimum.x);
+    int y0 = (int)floorf(minimum.y);
+    int x1 = std::min(_width - 1, (int)ceilf(maximum.x) - 1);
+    int y1 = std::min(_height - 1, (int)ceilf(maximum.y) - 1);
+    auto& pixels = _levels[0];
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            float fx = (float)x;
+            float fy = (float)y;
+            if (isInside(fx, fy) && isInside(fx + 1.0f, fy) && isInside(fx, fy + 1.0f) && isInside(fx + 1.0f, fy + 1.0f)) {
+                float& pixel = pixels[y * _width + x];
+                pixel = std::min(pixel, depth);
+            }
+        }
+    }
+    _pyramidDirty = true;
+}
+
+void OcclusionBuffer::buildPyramid() {
+    for (size_t level = 1; level < _levels.size(); ++level) {
+        const auto& fine = _levels[level - 1];
+        const glm::ivec2& fineSize = _levelSizes[level - 1];
+        auto& coarse = _levels[level];
+        const glm::ivec2& coarseSize = _levelSizes[level];
+        for (int y = 0; y < coarseSize.y; ++y) {
+            int fineY0 = 2 * y;
+            int fineY1 = std::min(fineY0 + 1, fineSize.y - 1);
+            for (int x = 0; x < coarseSize.x; ++x) {
+                int fineX0 = 2 * x;
+                int fineX1 = std::min(fineX0 + 1, fineSize.x - 1);
+                coarse[y * coarseSize.x + x] = std::max(
+                    std::max(fine[fineY0 * fineSize.x + fineX0], fine[fineY0 * fineSize.x + fineX1]),
+                    std::max(fine[fineY1 * fineSize.x + fineX0], fine[fineY1 * fineSize.x + fineX1]));
+            }
+        }
+    }
+    _pyramidDirty = false;
+}
+
+bool OcclusionBuffer::isOccluded(const AABox& bound) {
+    if (!_enabled || _numOccluders == 0) {
+        return false;
+    }
+    if (_pyramidDirty) {
+        buildPyramid();
+    }
+
+    // the nearest point of a box in front of the view is one of its corners
+    glm::vec3 corner = bound.getMinimumPoint();
+    glm::vec3 scale = bound.getScale();
+    glm::vec2 minimum(FLT_MAX);
+    glm::vec2 maximum(-FLT_MAX);
+    float nearestDepth = FLT_MAX;
+    for (int i = 0; i < 8; ++i) {
+        glm::vec3 vertex = corner + glm::vec3((i & 1) ? scale.x : 0.0f, (i & 2) ? scale.y : 0.0f, (i & 4) ? scale.z : 0.0f);
+        glm::vec3 projected;
+        if (!project(vertex, projected)) {
+            return false;
+        }
+        minimum = glm::min(minimum, glm::vec2(projected));
+        maximum = glm::max(maximum, glm::vec2(projected));
+        nearestDepth = std::min(nearestDepth, projected.z);
+    }
+
+    glm::vec2 size((float)_width, (float)_height);
+    if (maximum.x < 0.0f || maximum.y < 0.0f || minimum.x >= size.x || minimum.y >= size.y) {
+        // out of view, left to the frustum test
+        return false;
+    }
+    minimum = glm::max(minimum, glm::vec2(0.0f));
+    maximum = glm::min(maximum, size - glm::vec2(1.0f));
+    int x0 = (int)floorf(minimum.x);
+    int y0 = (int)floorf(minimum.y);
+    int x1 = (int)floorf(maximum.x);
+    int y1 = (int)floorf(maximum.y);
+
+    size_t level = 0;
+    while (level + 1 < _levels.size() &&
+           ((x1 >> level) - (x0 >> level) >= MAX_QUERY_CELLS || (y1 >> level) - (y0 >> level) >= MAX_QUERY_CELLS)) {
+        ++level;
+    }
+    const auto& cells = _levels[level];
+    int levelWidth = _levelSizes[level].x;
+    for (int y = y0 >> level; y <= (y1 >> level); ++y) {
+        for (int x = x0 >> level; x <= (x1 >> level); ++x) {
+            if (cells[y * levelWidth + x] >= nearestDepth) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
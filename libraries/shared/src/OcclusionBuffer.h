@@ -0,0 +1,69 @@
+//
+//  OcclusionBuffer.h
+//  libraries/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_OcclusionBuffer_h
+#define overte_OcclusionBuffer_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "AABox.h"
+
+class ViewFrustum;
+
+// Coarse depth buffer of the occluders in a perspective view, for culling the items they hide.
+//
+// Each pixel holds the view depth behind which an occluder hides everything. Occluders are boxes known to lie
+// within solid geometry, and only the pixels their front faces fully cover are written, with the farthest depth of
+// the face, so the buffer never hides more than the occluders do. Queries read a max pyramid of the pixels, testing
+// a few cells of the level that fits the projected bound of the item.
+class OcclusionBuffer {
+public:
+    static const int DEFAULT_WIDTH = 128;
+    static const int DEFAULT_HEIGHT = 64;
+
+    /// Empties the buffer for a view, it is left disabled if the view is not a perspective one
+    void clear(const ViewFrustum& frustum, int width = DEFAULT_WIDTH, int height = DEFAULT_HEIGHT);
+
+    bool isEnabled() const { return _enabled; }
+    int getNumOccluders() const { return _numOccluders; }
+
+    /// Rasterizes the faces of occluder that face the view
+    void addOccluder(const AABox& occluder);
+
+    /// Returns true if the occluders hide all of bound
+    bool isOccluded(const AABox& bound);
+
+    /// Returns the depth behind which pixel (x, y) is hidden, or FLT_MAX if no occluder covers it
+    float getDepth(int x, int y) const { return _levels[0][y * _width + x]; }
+
+private:
+    // Returns false if point is closer than the near clip, otherwise its pixel coordinates and view depth
+    bool project(const glm::vec3& point, glm::vec3& projected) const;
+    void rasterizeFace(const glm::vec3 corners[4]);
+    void buildPyramid();
+
+    glm::mat4 _viewProjection;
+    glm::vec4 _depthRow;
+    glm::vec3 _eye;
+    float _nearClip { 0.0f };
+    int _width { 0 };
+    int _height { 0 };
+    bool _enabled { false };
+    bool _pyramidDirty { false };
+    int _numOccluders { 0 };
+
+    std::vector<std::vector<float>> _levels;
+    std::vector<glm::ivec2> _levelSizes;
+};
+
+#endif // overte_OcclusionBuffer_h
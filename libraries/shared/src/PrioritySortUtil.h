@@ -11,6 +11,10 @@
 #ifndef hifi_PrioritySortUtil_h
 #define hifi_PrioritySortUtil_h
 
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
 #include <glm/glm.hpp>
 
 #include "NumericalConstants.h"
@@ -41,6 +45,22 @@ namespace PrioritySortUtil {
         float _priority { 0.0f };
     };
 
+    // Moves the numToSort highest priority things in [begin, end) to the front, highest first, and leaves the rest
+    // unordered behind them: O(n + k log k), rather than O(n log n) to sort everything when only the top k are used.
+    template <typename Iter>
+    void sortTop(Iter begin, Iter end, size_t numToSort) {
+        using T = typename std::iterator_traits<Iter>::value_type;
+        auto higherPriority = [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); };
+
+        size_t size = std::distance(begin, end);
+        if (numToSort < size) {
+            Iter top = begin + numToSort;
+            std::nth_element(begin, top, end, higherPriority);
+            end = top;
+        }
+        std::sort(begin, end, higherPriority);
+    }
+
     template <typename T>
     class PriorityQueue {
     public:
@@ -64,21 +84,29 @@ namespace PrioritySortUtil {
         void push(T thing) {
             thing.setPriority(computePriority(thing));
             _vector.push_back(thing);
+            _numSorted = 0;
         }
         void reserve(size_t num) {
             _vector.reserve(num);
         }
+
+        // Only the first numToSort things are in order (all of them for 0), see getNumSorted() and sortNextBatch()
         const std::vector<T>& getSortedVector(int numToSort = 0) {
-            if (numToSort == 0 || numToSort >= (int)_vector.size()) {
-                std::sort(_vector.begin(), _vector.end(),
-                    [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); });
-            } else {
-                std::partial_sort(_vector.begin(), _vector.begin() + numToSort, _vector.end(),
-                    [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); });
-            }
+            _numSorted = 0;
+            sortNextBatch(numToSort == 0 ? _vector.size() : (size_t)numToSort);
             return _vector;
         }
 
+        size_t getNumSorted() const { return _numSorted; }
+
+        // Orders the next numToSort things after the ones already sorted, for consumers who had budget
+        // left over after the first batch. Returns the new number of sorted things.
+        size_t sortNextBatch(size_t numToSort) {
+            sortTop(_vector.begin() + _numSorted, _vector.end(), numToSort);
+            _numSorted = std::min(_numSorted + numToSort, _vector.size());
+            return _numSorted;
+        }
+
     private:
 
         float computePriority(const T& thing) const {
@@ -129,6 +157,7 @@ namespace PrioritySortUtil {
         float _centerWeight { DEFAULT_CENTER_COEF };
         float _ageWeight { DEFAULT_AGE_COEF };
         quint64 _usecCurrentTime { 0 };
+        size_t _numSorted { 0 };
     };
 } // namespace PrioritySortUtil
 
@@ -53,13 +53,33 @@ static bool tracingEnabled() {
 ProfileDurationBase::ProfileDurationBase(const QLoggingCategory& category, const QString& name) : _name(name), _category(category) {
 }
 
+ProfileDurationBase::ProfileDurationBase(const QLoggingCategory& category, const char* staticName) :
+    _recordedName(staticName), _category(category) {
+}
+
 ProfileDuration::ProfileDuration(const QLoggingCategory& category,
                    const QString& name,
                    uint32_t argbColor,
                    uint64_t payload,
                    const QVariantMap& baseArgs) :
     ProfileDurationBase(category, name) {
-    if (tracingEnabled() && category.isDebugEnabled()) {
+    begin(argbColor, payload, baseArgs);
+}
+
+void ProfileDuration::begin(uint32_t argbColor, uint64_t payload, const QVariantMap& baseArgs) {
+    if (tracing::TraceRecorder::isEnabled() && _category.isDebugEnabled()) {
+        if (!_recordedName) {
+            _recordedName = tracing::TraceRecorder::internName(_name);
+        }
+        tracing::TraceRecorder::record(_category, _recordedName, tracing::DurationBegin);
+        _isRecorded = true;
+    }
+
+    if (tracingEnabled() && _category.isDebugEnabled()) {
+        if (_name.isEmpty() && _recordedName) {
+            _name = QString::fromUtf8(_recordedName);
+        }
+        _isTraced = true;
         QVariantMap args = baseArgs;
         args["nv_payload"] = QVariant::fromValue(payload);
         tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
@@ -71,7 +91,8 @@ ProfileDuration::ProfileDuration(const QLoggingCategory& category,
         eventAttrib.colorType = NVTX_COLOR_ARGB;
         eventAttrib.color = argbColor;
         eventAttrib.messageType = NVTX_MESSAGE_TYPE_ASCII;
-        eventAttrib.message.ascii = name.toUtf8().data();
+        QByteArray asciiName = _name.toUtf8();
+        eventAttrib.message.ascii = asciiName.data();
         eventAttrib.payload.llValue = payload;
         eventAttrib.payloadType = NVTX_PAYLOAD_TYPE_UNSIGNED_INT64;
 
@@ -81,7 +102,11 @@ ProfileDuration::ProfileDuration(const QLoggingCategory& category,
 }
 
 ProfileDuration::~ProfileDuration() {
-    if (tracingEnabled() && _category.isDebugEnabled()) {
+    if (_isRecorded) {
+        tracing::TraceRecorder::record(_category, _recordedName, tracing::DurationEnd);
+    }
+
+    if (_isTraced && tracingEnabled()) {
         tracing::traceEvent(_category, _name, tracing::DurationEnd);
 #ifdef NSIGHT_TRACING
         nvtxRangePop();
@@ -13,6 +13,7 @@
 #define HIFI_PROFILE_
 
 #include "Trace.h"
+#include "TraceRecorder.h"
 #include "SharedUtil.h"
 
 // When profiling something that may happen many times per frame, use a xxx_detail category so that they may easily be filtered out of trace results
@@ -43,17 +44,32 @@ class ProfileDurationBase {
 
 protected:
     ProfileDurationBase(const QLoggingCategory& category, const QString& name);
-    const QString _name;
+    ProfileDurationBase(const QLoggingCategory& category, const char* staticName);
+    // only built from the static name when the tracer is enabled, so that a disabled range doesn't allocate
+    QString _name;
+    const char* _recordedName { nullptr };
     const QLoggingCategory& _category;
 };
 
 class ProfileDuration : public ProfileDurationBase {
 public:
     ProfileDuration(const QLoggingCategory& category, const QString& name, uint32_t argbColor = 0xff0000ff, uint64_t payload = 0, const QVariantMap& args = QVariantMap());
+    // string literals and __FUNCTION__ are recorded by the trace recorder as they are, the other names are interned
+    template <size_t N>
+    ProfileDuration(const QLoggingCategory& category, const char (&name)[N], uint32_t argbColor = 0xff0000ff, uint64_t payload = 0, const QVariantMap& args = QVariantMap()) :
+        ProfileDurationBase(category, (const char*)name) {
+        begin(argbColor, payload, args);
+    }
     ~ProfileDuration();
 
     static uint64_t beginRange(const QLoggingCategory& category, const char* name, uint32_t argbColor);
     static void endRange(const QLoggingCategory& category, uint64_t rangeId);
+
+private:
+    void begin(uint32_t argbColor, uint64_t payload, const QVariantMap& args);
+
+    bool _isTraced { false };
+    bool _isRecorded { false };
 };
 
 class ConditionalProfileDuration : public ProfileDurationBase {
@@ -122,7 +138,7 @@ inline void metadata(const QString& metadataType, const QVariantMap& args) {
 #define PROFILE_COUNTER_IF_CHANGED(category, name, type, value) { static type lastValue = 0; type newValue = value;  if (newValue != lastValue) { counter(trace_##category(), name, { { name, newValue }}); lastValue = newValue; } }
 #define PROFILE_COUNTER(category, name, ...) counter(trace_##category(), name, ##__VA_ARGS__);
 #define PROFILE_INSTANT(category, name, ...) instant(trace_##category(), name, ##__VA_ARGS__);
-#define PROFILE_SET_THREAD_NAME(threadName) metadata("thread_name", { { "name", threadName } });
+#define PROFILE_SET_THREAD_NAME(threadName) metadata("thread_name", { { "name", threadName } }); tracing::TraceRecorder::getInstance().setThreadName(threadName);
 
 #define SAMPLE_PROFILE_RANGE(chance, category, name, ...) if (randFloat() <= chance) { PROFILE_RANGE(category, name); }
 #define SAMPLE_PROFILE_RANGE_EX(chance, category, name, ...) if (randFloat() <= chance) { PROFILE_RANGE_EX(category, name, argbColor, payload, ##__VA_ARGS__); }
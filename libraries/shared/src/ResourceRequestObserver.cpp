@@ -11,11 +11,16 @@
 
 #include "ResourceRequestObserver.h"
 
+#include <algorithm>
+
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QMetaMethod>
 #include <QString>
 #include <QUrl>
 
+#include "NumericalConstants.h"
+
 /*@jsdoc
  * Information about a resource request.
  * @typedef {object} ResourceRequestObserver.ResourceRequest
@@ -26,6 +31,12 @@
 void ResourceRequestObserver::update(const QUrl& requestUrl,
     const qint64 callerId,
     const QString& extra) {
+    // this is called for every resource that is looked up, so the event is only made when something listens to it
+    static const QMetaMethod resourceRequestEventSignal = QMetaMethod::fromSignal(&ResourceRequestObserver::resourceRequestEvent);
+    if (!isSignalConnected(resourceRequestEventSignal)) {
+        return;
+    }
+
     QJsonArray array;
     QJsonObject data { { "url", requestUrl.toString() },
         { "callerId", callerId },
@@ -33,3 +44,50 @@ void ResourceRequestObserver::update(const QUrl& requestUrl,
     };
     emit resourceRequestEvent(data.toVariantMap());
 }
+
+void ResourceRequestObserver::recordTiming(const QUrl& requestUrl, quint64 sentUsecs, quint64 firstByteUsecs,
+                                           quint64 finishedUsecs, qint64 bytes, bool multiplexed) {
+    QString host = requestUrl.scheme() + "://" + requestUrl.authority();
+    QMutexLocker locker(&_hostStatsMutex);
+    auto& stats = _hostStats[host];
+    stats.count++;
+    if (multiplexed) {
+        stats.multiplexed++;
+    }
+    stats.totalSentUsecs += sentUsecs;
+    stats.totalFirstByteUsecs += firstByteUsecs;
+    stats.totalFinishedUsecs += finishedUsecs;
+    stats.maxFinishedUsecs = std::max(stats.maxFinishedUsecs, finishedUsecs);
+    stats.bytes += bytes;
+}
+
+/*@jsdoc
+ * Timing statistics of the HTTP resource requests made to a host. The times are averages, in milliseconds from when the
+ * requests were made.
+ * @typedef {object} ResourceRequestObserver.HostStats
+ * @property {number} count - The number of requests that have finished.
+ * @property {number} multiplexed - The number of requests that shared an HTTP/2 connection.
+ * @property {number} sent - The average time until the request was sent, after waiting for the host's request limit.
+ * @property {number} firstByte - The average time until the first byte of the response arrived.
+ * @property {number} finished - The average time until the request finished.
+ * @property {number} maxFinished - The longest time until a request finished.
+ * @property {number} bytes - The total number of bytes received.
+ */
+QVariantMap ResourceRequestObserver::getHostStats() const {
+    QVariantMap result;
+    QMutexLocker locker(&_hostStatsMutex);
+    for (auto itr = _hostStats.begin(); itr != _hostStats.end(); ++itr) {
+        const auto& stats = itr.value();
+        double count = (double)std::max(stats.count, (quint64)1) * (double)USECS_PER_MSEC;
+        QVariantMap host;
+        host["count"] = (double)stats.count;
+        host["multiplexed"] = (double)stats.multiplexed;
+        host["sent"] = (double)stats.totalSentUsecs / count;
+        host["firstByte"] = (double)stats.totalFirstByteUsecs / count;
+        host["finished"] = (double)stats.totalFinishedUsecs / count;
+        host["maxFinished"] = (double)stats.maxFinishedUsecs / (double)USECS_PER_MSEC;
+        host["bytes"] = (double)stats.bytes;
+        result[itr.key()] = host;
+    }
+    return result;
+}
@@ -10,7 +10,9 @@
 //
 
 
+#include <QHash>
 #include <QJsonObject>
+#include <QMutex>
 #include <QString>
 #include <QNetworkRequest>
 
@@ -32,6 +34,18 @@ class ResourceRequestObserver : public QObject, public Dependency {
 public:
     void update(const QUrl& requestUrl, const qint64 callerId = -1, const QString& extra = "");
 
+    /// Adds a finished request to the timing statistics of its host, all times are from when the request was made
+    void recordTiming(const QUrl& requestUrl, quint64 sentUsecs, quint64 firstByteUsecs, quint64 finishedUsecs,
+                      qint64 bytes, bool multiplexed);
+
+    /*@jsdoc
+     * Gets timing statistics of the HTTP resource requests that have finished, by host.
+     * @function ResourceRequestObserver.getHostStats
+     * @returns {Object<string, ResourceRequestObserver.HostStats>} The statistics of each host, e.g.,
+     *     <code>"https://cdn.example.com"</code>.
+     */
+    Q_INVOKABLE QVariantMap getHostStats() const;
+
 signals:
     /*@jsdoc
      * Triggered when an observable resource request is made.
@@ -58,4 +72,18 @@ signals:
      * Script.setTimeout(importEntities, 2000);
      */
     void resourceRequestEvent(QVariantMap result);
+
+private:
+    struct HostStats {
+        quint64 count { 0 };
+        quint64 multiplexed { 0 };
+        quint64 totalSentUsecs { 0 };
+        quint64 totalFirstByteUsecs { 0 };
+        quint64 totalFinishedUsecs { 0 };
+        quint64 maxFinishedUsecs { 0 };
+        qint64 bytes { 0 };
+    };
+
+    mutable QMutex _hostStatsMutex;
+    QHash<QString, HostStats> _hostStats;
 };
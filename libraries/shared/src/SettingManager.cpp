@@ -30,30 +30,51 @@ namespace Setting {
         init();
     }
 
-    void WriteWorker::setValue(const QString key, const QVariant value) {
-       //qCDebug(settings_writer) << "Setting config " << key << "to" << value;
-
-        init();
-
-        if (!_qSettings->contains(key) || _qSettings->value(key) != value) {
-            _qSettings->setValue(key, value);
+    void WriteWorker::init() {
+        if (!_qSettings) {
+            _qSettings = new QSettings();
+        }
+        if (!_flushTimer) {
+            _flushTimer = new QTimer(this);
+            _flushTimer->setSingleShot(true);
+            _flushTimer->setInterval(FLUSH_DELAY_MSECS);
+            connect(_flushTimer, &QTimer::timeout, this, [this] {
+                flush();
+                _qSettings->sync();
+            });
         }
     }
 
-    void WriteWorker::removeKey(const QString key) {
+    void WriteWorker::scheduleFlush() {
         init();
-        _qSettings->remove(key);
+        if (!_flushTimer->isActive()) {
+            _flushTimer->start();
+        }
     }
 
-    void WriteWorker::clearAllSettings() {
+    void WriteWorker::flush() {
         init();
-        _qSettings->clear();
-        sync();
+        _flushTimer->stop();
+
+        auto changes = _manager->takePendingChanges();
+        //qCDebug(settings_writer) << "Writing" << changes.values.size() << "changed and" << changes.removedKeys.size() << "removed settings";
+
+        if (changes.clear) {
+            _qSettings->clear();
+        }
+        for (const auto& key : changes.removedKeys) {
+            _qSettings->remove(key);
+        }
+        for (auto it = changes.values.cbegin(); it != changes.values.cend(); ++it) {
+            if (!_qSettings->contains(it.key()) || _qSettings->value(it.key()) != it.value()) {
+                _qSettings->setValue(it.key(), it.value());
+            }
+        }
     }
 
     void WriteWorker::sync() {
         //qCDebug(settings_writer) << "Forcing settings sync";
-        init();
+        flush();
         _qSettings->sync();
     }
 
@@ -71,7 +92,7 @@ namespace Setting {
     }
 
     Manager::Manager(QObject *parent) {
-        WriteWorker *worker = new WriteWorker();
+        WriteWorker *worker = new WriteWorker(this);
 
         // We operate purely from memory, and forward all changes to a thread that has writing the
         // settings as its only job.
@@ -84,10 +105,8 @@ namespace Setting {
 
         // All normal connections are queued, so that we're sure they happen asynchronously.
         connect(&_workerThread, &QThread::finished, worker, &WriteWorker::threadFinished, Qt::QueuedConnection);
-        connect(this, &Manager::valueChanged, worker, &WriteWorker::setValue, Qt::QueuedConnection);
-        connect(this, &Manager::keyRemoved, worker, &WriteWorker::removeKey, Qt::QueuedConnection);
+        connect(this, &Manager::changesPending, worker, &WriteWorker::scheduleFlush, Qt::QueuedConnection);
         connect(this, &Manager::syncRequested, worker, &WriteWorker::sync, Qt::QueuedConnection);
-        connect(this, &Manager::clearAllSettingsRequested, worker, &WriteWorker::clearAllSettings, Qt::QueuedConnection);
 
         // This one is blocking because we want to wait until it's actually processed.
         connect(this, &Manager::terminationRequested, worker, &WriteWorker::terminate, Qt::BlockingQueuedConnection);
@@ -133,7 +152,7 @@ namespace Setting {
         const auto& key = handle->getKey();
 
         withWriteLock([&] {
-            QVariant loadedValue = _settings[key];
+            QVariant loadedValue = _settings.value(key);
 
             if (loadedValue.isValid()) {
                 handle->setVariant(loadedValue);
@@ -145,22 +164,55 @@ namespace Setting {
     void Manager::saveSetting(Interface* handle) {
         const auto& key = handle->getKey();
 
+        bool signalChanges = false;
         if (handle->isSet()) {
             QVariant handleValue = handle->getVariant();
 
             withWriteLock([&] {
-                _settings[key] = handleValue;
+                signalChanges = changeValue(key, handleValue);
             });
-
-            emit valueChanged(key, handleValue);
         } else {
             withWriteLock([&] {
-                _settings.remove(key);
+                signalChanges = removeValue(key);
             });
+        }
 
-            emit keyRemoved(key);
+        if (signalChanges) {
+            emit changesPending();
         }
+    }
+
+    bool Manager::changeValue(const QString& key, const QVariant& value) {
+        auto it = _settings.find(key);
+        if (it != _settings.end() && it.value() == value) {
+            return false;
+        }
+        _settings.insert(key, value);
+
+        _pendingChanges.values.insert(key, value);
+        _pendingChanges.removedKeys.remove(key);
+        bool wasPending = _hasPendingChanges;
+        _hasPendingChanges = true;
+        return !wasPending;
+    }
 
+    bool Manager::removeValue(const QString& key) {
+        _settings.remove(key);
+
+        _pendingChanges.values.remove(key);
+        _pendingChanges.removedKeys.insert(key);
+        bool wasPending = _hasPendingChanges;
+        _hasPendingChanges = true;
+        return !wasPending;
+    }
+
+    Manager::PendingChanges Manager::takePendingChanges() {
+        return resultWithWriteLock<PendingChanges>([&] {
+            PendingChanges changes;
+            std::swap(changes, _pendingChanges);
+            _hasPendingChanges = false;
+            return changes;
+        });
     }
 
     void Manager::forceSave() {
@@ -184,11 +236,14 @@ namespace Setting {
     }
 
     void Manager::remove(const QString &key) {
+        bool signalChanges = false;
         withWriteLock([&] {
-            _settings.remove(key);
+            signalChanges = removeValue(key);
         });
 
-        emit keyRemoved(key);
+        if (signalChanges) {
+            emit changesPending();
+        }
     }
 
     QStringList Manager::allKeys() const {
@@ -204,11 +259,14 @@ namespace Setting {
     }
 
     void Manager::setValue(const QString &key, const QVariant &value) {
+        bool signalChanges = false;
         withWriteLock([&] {
-            _settings[key] = value;
+            signalChanges = changeValue(key, value);
         });
 
-        emit valueChanged(key, value);
+        if (signalChanges) {
+            emit changesPending();
+        }
     }
 
     QVariant Manager::value(const QString &key, const QVariant &defaultValue) const {
@@ -220,8 +278,12 @@ namespace Setting {
     void Manager::clearAllSettings() {
         withWriteLock([&] {
             _settings.clear();
+            _pendingChanges = PendingChanges();
+            _pendingChanges.clear = true;
+            _hasPendingChanges = true;
         });
 
-        emit clearAllSettingsRequested();
+        // Clearing is written out right away rather than after the flush delay
+        emit syncRequested();
     }
 }
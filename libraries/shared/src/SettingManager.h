@@ -14,6 +14,7 @@
 #define hifi_SettingManager_h
 
 #include <QtCore/QPointer>
+#include <QtCore/QSet>
 #include <QtCore/QSettings>
 #include <QtCore/QTimer>
 #include <QtCore/QUuid>
@@ -36,13 +37,14 @@ class SettingsTestsWorker;
 
 namespace Setting {
     class Interface;
+    class Manager;
 
     /**
      * @brief Settings write worker
      *
      * This class is used by Setting::Manager to write settings to permanent storage
-     * without blocking anything else. It receives setting updates, and writes them
-     * to disk whenever convenient.
+     * without blocking anything else. Changes accumulate in the manager, and are taken
+     * from it and written to disk in one go a short while after the first of them.
      *
      * All communication to this class must be done over queued connections.
      *
@@ -52,37 +54,32 @@ namespace Setting {
     class WriteWorker : public QObject {
         Q_OBJECT
 
-        public slots:
+        public:
 
         /**
-         * @brief Initialize anything that needs initializing, called on thread start.
-         *
+         * @brief How long changes are held before being written, so that a burst of them is written at once
          */
-        void start();
+        static const int FLUSH_DELAY_MSECS = 1000;
 
-        /**
-         * @brief Sets a configuration value
-         *
-         * @param key Configuration key
-         * @param value Configuration value
-         */
-        void setValue(const QString key, const QVariant value);
+        WriteWorker(Manager* manager) : _manager(manager) {}
+
+        public slots:
 
         /**
-         * @brief Remove a value from the configuration
+         * @brief Initialize anything that needs initializing, called on thread start.
          *
-         * @param key Key to remove
          */
-        void removeKey(const QString key);
+        void start();
 
         /**
-         * @brief Remove all values from the configuration.
+         * @brief The manager has changes that haven't been written yet
          *
+         * They're written once FLUSH_DELAY_MSECS have passed.
          */
-        void clearAllSettings();
+        void scheduleFlush();
 
         /**
-         * @brief Force writing the config to disk
+         * @brief Force writing the config to disk, with any changes that haven't been written yet
          *
          */
         void sync();
@@ -101,13 +98,12 @@ namespace Setting {
 
         private:
 
-        void init() {
-            if (!_qSettings) {
-                _qSettings = new QSettings();
-            }
-        }
+        void init();
+        void flush();
 
+        Manager* _manager;
         QSettings* _qSettings = nullptr;
+        QTimer* _flushTimer = nullptr;
     };
 
     /**
@@ -120,7 +116,8 @@ namespace Setting {
      * both of which talk to the single global instance of this class.
      *
      * The class is thread-safe, and delegates config writing to a separate thread. It
-     * is safe to change settings as often as it might be needed.
+     * is safe to change settings as often as it might be needed: changes are kept in memory,
+     * only the latest value of each key, and handed to the writer in batches.
      *
      */
     class Manager : public QObject, public ReadWriteLockable, public Dependency {
@@ -218,19 +215,11 @@ namespace Setting {
 
     signals:
         /**
-         * @brief The value of a setting was changed
+         * @brief Settings were changed while none were waiting to be written
          *
-         * @param key Setting key
-         * @param value New value
+         * Further changes don't signal again until the writer has taken them.
          */
-        void valueChanged(const QString key, QVariant value);
-
-        /**
-         * @brief A setting was removed
-         *
-         * @param key Setting key
-         */
-        void keyRemoved(const QString key);
+        void changesPending();
 
         /**
          * @brief A request to synchronize the settings to permanent storage was made
@@ -238,12 +227,6 @@ namespace Setting {
          */
         void syncRequested();
 
-        /**
-         * @brief A request to clear all the settings was made
-         *
-         */
-        void clearAllSettingsRequested();
-
         /**
          * @brief The termination of the settings system was requested
          *
@@ -253,9 +236,25 @@ namespace Setting {
         void terminationRequested();
 
     private:
+        struct PendingChanges {
+            bool clear { false };           // the whole configuration was cleared before these changes
+            QHash<QString, QVariant> values;
+            QSet<QString> removedKeys;
+        };
+
+        // These must be called with the write lock held, and return whether changesPending needs emitting
+        bool changeValue(const QString& key, const QVariant& value);
+        bool removeValue(const QString& key);
+
+        /**
+         * @brief Takes the changes made since the last call, for the writer to write them
+         */
+        PendingChanges takePendingChanges();
+
         QHash<QString, Interface*> _handles;
 
         friend class Interface;
+        friend class WriteWorker;
         friend class ::SettingsTests;
         friend class ::SettingsTestsWorker;
 
@@ -264,6 +263,8 @@ namespace Setting {
 
 
         QHash<QString, QVariant> _settings;
+        PendingChanges _pendingChanges;
+        bool _hasPendingChanges { false };
         QString _fileName;
         QThread _workerThread;
     };
@@ -65,6 +65,7 @@ extern "C" FILE * __cdecl __iob_func(void) {
 #include "NumericalConstants.h"
 #include "OctalCode.h"
 #include "SharedLogging.h"
+#include "TraceRecorder.h"
 
 //     Global instances are stored inside the QApplication properties
 // to provide a single instance across DLL boundaries.
@@ -133,6 +134,25 @@ quint64 usecTimestampNow(bool wantDebug) {
     return duration_cast<microseconds>(system_clock::now() - unixEpoch).count() + usecTimestampNowAdjust;
 }
 
+quint64 usecThreadCPUTimeNow() {
+#ifdef Q_OS_WIN
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0;
+    }
+    // the times are in units of 100 nanoseconds
+    quint64 kernel = ((quint64)kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+    quint64 user = ((quint64)userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+    return (kernel + user) / 10;
+#else
+    timespec time;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) {
+        return 0;
+    }
+    return (quint64)time.tv_sec * USECS_PER_SECOND + time.tv_nsec / NSECS_PER_USEC;
+#endif
+}
+
 float secTimestampNow() {
     static const auto START_TIME = usecTimestampNow();
     const auto nowUsecs = usecTimestampNow() - START_TIME;
@@ -1160,6 +1180,13 @@ void setupHifiApplication(QString applicationName) {
 
     // Install the standard hifi message handler so we get consistant log formatting
     qInstallMessageHandler(LogHandler::verboseMessageHandler);
+
+    // The trace recorder is left on as a flight recorder when OVERTE_TRACE_RECORDER is set, its events are dumped to the
+    // temporary directory whenever the process receives SIGUSR2
+    if (qEnvironmentVariableIsSet("OVERTE_TRACE_RECORDER")) {
+        tracing::TraceRecorder::getInstance().setEnabled(true);
+        tracing::TraceRecorder::getInstance().setupDumpOnSignal();
+    }
 }
 
 #ifdef Q_OS_WIN
@@ -84,6 +84,8 @@ typedef unsigned char nodeColor[BYTES_PER_COLOR + BYTES_PER_FLAGS];
 // Equivalent to time_t but in usecs instead of secs
 quint64 usecTimestampNow(bool wantDebug = false);
 void usecTimestampNowForceClockSkew(qint64 clockSkew);
+// The CPU time that the calling thread has used, in usecs, 0 if it isn't available
+quint64 usecThreadCPUTimeNow();
 
 inline bool afterUsecs(quint64& startUsecs, quint64 maxIntervalUecs) {
     auto now = usecTimestampNow();
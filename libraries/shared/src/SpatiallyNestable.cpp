@@ -81,6 +81,11 @@ void SpatiallyNestable::setParentID(const QUuid& parentID) {
         }
     });
 
+    if (parentChanged) {
+        invalidateParentTransform();
+        invalidateDescendantTransforms();
+    }
+
     if (parentChanged && success && parent) {
         parent->recalculateChildCauterization();
     }
@@ -102,15 +107,58 @@ Transform SpatiallyNestable::getParentTransform(bool& success, int depth) const
     if (!success) {
         return result;
     }
-    if (parent) {
-        result = parent->getJointTransform(_parentJointIndex, success, depth + 1);
-        if (getScalesWithParent()) {
-            result.setScale(parent->scaleForChildren());
+    // read before the parent's transform is, so that a change of an ancestor while it's computed isn't cached
+    uint32_t generation = _parentTransformGeneration;
+    if (!parent) {
+        // the children of a root can cache their parent transform
+        _cachedParentTransformGeneration = generation;
+        return result;
+    }
+
+    bool cached = false;
+    _transformLock.withReadLock([&] {
+        if (_cachedParentTransformGeneration == generation && _cachedParent == parent.get()) {
+            result = _cachedParentTransform;
+            cached = true;
         }
+    });
+    if (cached) {
+        return result;
+    }
+
+    result = parent->getJointTransform(_parentJointIndex, success, depth + 1);
+    bool scalesWithParent = getScalesWithParent();
+    if (scalesWithParent) {
+        result.setScale(parent->scaleForChildren());
+    }
+
+    // joints and the scale of the parent change without telling its children, and neither do the ancestors of a parent
+    // whose transform can't be cached
+    if (success && _parentKnowsMe && _parentJointIndex == INVALID_JOINT_INDEX && !scalesWithParent &&
+        parent->isParentTransformCached()) {
+        _transformLock.withWriteLock([&] {
+            _cachedParentTransform = result;
+            _cachedParent = parent.get();
+            _cachedParentTransformGeneration = generation;
+        });
     }
     return result;
 }
 
+bool SpatiallyNestable::isParentTransformCached() const {
+    return _cachedParentTransformGeneration == _parentTransformGeneration;
+}
+
+void SpatiallyNestable::invalidateParentTransform() const {
+    _parentTransformGeneration++;
+}
+
+void SpatiallyNestable::invalidateDescendantTransforms() const {
+    forEachDescendant([&](const SpatiallyNestablePointer& object) {
+        object->invalidateParentTransform();
+    });
+}
+
 SpatiallyNestablePointer SpatiallyNestable::getParentPointer(bool& success) const {
     SpatiallyNestablePointer parent = _parent.lock();
     QUuid parentID = getParentID(); // used for its locking
@@ -141,6 +189,7 @@ SpatiallyNestablePointer SpatiallyNestable::getParentPointer(bool& success) cons
         _parentKnowsMe = false;
         _parent.reset();
     }
+    invalidateParentTransform();
 
     // we have a _parentID but no parent pointer, or our parent pointer was to the wrong thing
     QSharedPointer<SpatialParentFinder> parentFinder = DependencyManager::get<SpatialParentFinder>();
@@ -186,6 +235,8 @@ void SpatiallyNestable::forgetChild(SpatiallyNestablePointer newChild) const {
 
 void SpatiallyNestable::setParentJointIndex(quint16 parentJointIndex) {
     _parentJointIndex = parentJointIndex;
+    invalidateParentTransform();
+    invalidateDescendantTransforms();
     bool success = false;
     auto parent = getParentPointer(success);
     if (success && parent) {
@@ -517,6 +568,7 @@ void SpatiallyNestable::setWorldTransform(const glm::vec3& position, const glm::
             }
         });
         if (changed) {
+            invalidateDescendantTransforms();
             locationChanged(false);
         }
     }
@@ -560,6 +612,9 @@ void SpatiallyNestable::setWorldPosition(const glm::vec3& position, bool& succes
             _translationChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        invalidateDescendantTransforms();
+    }
     if (success && changed) {
         locationChanged(tellPhysics);
     }
@@ -613,6 +668,9 @@ void SpatiallyNestable::setWorldOrientation(const glm::quat& orientation, bool&
             _rotationChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        invalidateDescendantTransforms();
+    }
     if (success && changed) {
         locationChanged(tellPhysics);
     }
@@ -833,6 +891,7 @@ void SpatiallyNestable::setTransform(const Transform& transform, bool& success)
             }
         });
         if (changed) {
+            invalidateDescendantTransforms();
             locationChanged();
         }
     }
@@ -887,6 +946,9 @@ void SpatiallyNestable::setSNScale(const glm::vec3& scale, bool& success) {
             _scaleChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        invalidateDescendantTransforms();
+    }
     if (success && changed) {
         dimensionsChanged();
     }
@@ -919,6 +981,7 @@ void SpatiallyNestable::setLocalTransform(const Transform& transform) {
     });
 
     if (changed) {
+        invalidateDescendantTransforms();
         locationChanged();
     }
 }
@@ -946,6 +1009,7 @@ void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhy
         }
     });
     if (changed) {
+        invalidateDescendantTransforms();
         locationChanged(tellPhysics);
     }
 }
@@ -973,6 +1037,7 @@ void SpatiallyNestable::setLocalOrientation(const glm::quat& orientation) {
         }
     });
     if (changed) {
+        invalidateDescendantTransforms();
         locationChanged();
     }
 }
@@ -1029,6 +1094,7 @@ void SpatiallyNestable::setLocalSNScale(const glm::vec3& scale) {
         }
     });
     if (changed) {
+        invalidateDescendantTransforms();
         dimensionsChanged();
     }
 }
@@ -1393,6 +1459,7 @@ void SpatiallyNestable::setLocalTransformAndVelocities(
     });
 
     if (changed) {
+        invalidateDescendantTransforms();
         locationChanged(false);
     }
 }
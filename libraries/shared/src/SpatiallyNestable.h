@@ -234,6 +234,10 @@ protected:
     virtual void forgetChild(SpatiallyNestablePointer newChild) const;
     virtual void recalculateChildCauterization() const { }
 
+    // called when the world transform of this object changes, other than through its local transform, so that its
+    // descendants don't keep their cached parent transforms
+    void invalidateDescendantTransforms() const;
+
     mutable ReadWriteLockable _childrenLock;
     mutable QHash<QUuid, SpatiallyNestableWeakPointer> _children;
 
@@ -267,6 +271,17 @@ private:
     bool _isDead { false };
     bool _queryAACubeIsPuffed { false };
 
+    // the world transform of the parent (or of its joint) is cached by getParentTransform, so that the world transforms
+    // of a hierarchy are found from their parent rather than by walking up to its root.  A change of the world transform
+    // of an ancestor bumps _parentTransformGeneration, the cache is valid while _cachedParentTransformGeneration matches
+    // it.  Objects that are parented to a joint, or that scale with their parent, aren't cached, nor are their descendants.
+    mutable Transform _cachedParentTransform; // guarded by _transformLock
+    mutable const SpatiallyNestable* _cachedParent { nullptr };
+    mutable std::atomic<uint32_t> _cachedParentTransformGeneration { 0 };
+    mutable std::atomic<uint32_t> _parentTransformGeneration { 1 };
+
+    bool isParentTransformCached() const;
+    void invalidateParentTransform() const;
     void breakParentingLoop() const;
 };
 
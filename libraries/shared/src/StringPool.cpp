@@ -0,0 +1,71 @@
+//
+//  StringPool.cpp
+//  libraries/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "StringPool.h"
+
+StringPool& StringPool::instance() {
+    static StringPool pool;
+    return pool;
+}
+
+QString StringPool::intern(const QString& value) {
+    if (value.isEmpty()) {
+        return QString();
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto itr = _strings.constFind(value);
+    if (itr != _strings.constEnd()) {
+        return *itr;
+    }
+    if (_strings.size() >= _sizeToPrune) {
+        pruneLocked();
+    }
+    _numBytes += value.size() * sizeof(QChar);
+    // a copy of its own, so that the pool doesn't keep the spare capacity of the buffer of value
+    QString copy(value.constData(), value.size());
+    _strings.insert(copy);
+    return copy;
+}
+
+void StringPool::prune() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    pruneLocked();
+}
+
+void StringPool::pruneLocked() {
+    for (auto itr = _strings.begin(); itr != _strings.end();) {
+        if (itr->isDetached()) {
+            _numBytes -= itr->size() * sizeof(QChar);
+            itr = _strings.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+    _sizeToPrune = 2 * _strings.size();
+    if (_sizeToPrune < MIN_SIZE_TO_PRUNE) {
+        _sizeToPrune = MIN_SIZE_TO_PRUNE;
+    }
+}
+
+size_t StringPool::getUnsharedBytes(const QString& value) {
+    return (!value.isEmpty() && value.isDetached()) ? value.capacity() * sizeof(QChar) : 0;
+}
+
+int StringPool::getNumStrings() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _strings.size();
+}
+
+size_t StringPool::getNumBytes() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _numBytes;
+}
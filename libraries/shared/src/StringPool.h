@@ -0,0 +1,51 @@
+//
+//  StringPool.h
+//  libraries/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_StringPool_h
+#define overte_StringPool_h
+
+#include <mutex>
+
+#include <QtCore/QSet>
+#include <QtCore/QString>
+
+/// Interns the strings that many objects hold the same value of, like the URLs and the userData of the entities, so that
+/// the equal strings share one buffer instead of a copy each.  The strings that only the pool holds anymore are released
+/// once the pool has doubled in size since they were last pruned.
+class StringPool {
+public:
+    static StringPool& instance();
+
+    /// Returns a string equal to value that shares its buffer with the other interned strings of that value
+    QString intern(const QString& value);
+
+    /// Releases the strings that aren't used outside of the pool anymore
+    void prune();
+
+    /// The size of the buffer of value if it isn't shared with the pool or any other string, in bytes
+    static size_t getUnsharedBytes(const QString& value);
+
+    int getNumStrings() const;
+    /// The size of the buffers of the interned strings, in bytes
+    size_t getNumBytes() const;
+
+private:
+    void pruneLocked();
+
+    static const int MIN_SIZE_TO_PRUNE = 1024;
+
+    mutable std::mutex _mutex;
+    QSet<QString> _strings;
+    size_t _numBytes { 0 };
+    int _sizeToPrune { MIN_SIZE_TO_PRUNE };
+};
+
+#endif // overte_StringPool_h
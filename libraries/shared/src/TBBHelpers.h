@@ -30,6 +30,7 @@
 #include <tbb/concurrent_unordered_set.h>
 #include <tbb/concurrent_vector.h>
 #include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
 #include <tbb/blocked_range2d.h>
 
 
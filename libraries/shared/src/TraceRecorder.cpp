@@ -0,0 +1,238 @@
+//
+//  TraceRecorder.cpp
+//  libraries/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#ifndef Q_OS_WIN
+#include <csignal>
+#endif
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QThread>
+
+#include "Gzip.h"
+#include "PortableHighResolutionClock.h"
+#include "SharedLogging.h"
+
+using namespace tracing;
+
+// The events of a thread, written by that thread only.  The head is the number of events that were ever recorded,
+// the last EVENTS_PER_THREAD of which are in the buffer.
+struct TraceRecorder::ThreadBuffer {
+    qint64 threadID { 0 };
+    std::atomic<bool> isFinished { false };
+    std::atomic<uint64_t> head { 0 };
+    RecordedEvent events[EVENTS_PER_THREAD];
+};
+
+std::atomic<bool> TraceRecorder::_enabled { false };
+
+TraceRecorder& TraceRecorder::getInstance() {
+    static TraceRecorder staticInstance;
+    return staticInstance;
+}
+
+void TraceRecorder::setEnabled(bool enabled) {
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+std::shared_ptr<TraceRecorder::ThreadBuffer> TraceRecorder::createThreadBuffer() {
+    auto buffer = std::make_shared<ThreadBuffer>();
+    buffer->threadID = (qint64)QThread::currentThreadId();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    // the buffers of the threads that finished are dropped as new threads record
+    _threadBuffers.erase(std::remove_if(_threadBuffers.begin(), _threadBuffers.end(),
+        [](const std::shared_ptr<ThreadBuffer>& threadBuffer) { return threadBuffer->isFinished.load(); }),
+        _threadBuffers.end());
+    _threadBuffers.push_back(buffer);
+    return buffer;
+}
+
+void TraceRecorder::record(const QLoggingCategory& category, const char* name, EventType type) {
+    struct ThreadBufferHolder {
+        std::shared_ptr<ThreadBuffer> buffer { getInstance().createThreadBuffer() };
+        ~ThreadBufferHolder() { buffer->isFinished = true; }
+    };
+    static thread_local ThreadBufferHolder holder;
+
+    ThreadBuffer& buffer = *holder.buffer;
+    uint64_t index = buffer.head.load(std::memory_order_relaxed);
+    RecordedEvent& event = buffer.events[index % EVENTS_PER_THREAD];
+    event.timestamp = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        p_high_resolution_clock::now().time_since_epoch()).count();
+    event.name = name;
+    event.category = &category;
+    event.type = type;
+    buffer.head.store(index + 1, std::memory_order_release);
+}
+
+const char* TraceRecorder::internName(const QString& name) {
+    // the names are looked up in a cache of the thread first so that the threads don't contend for the lock
+    static thread_local QHash<QString, const char*> threadNames;
+    auto threadIt = threadNames.constFind(name);
+    if (threadIt != threadNames.constEnd()) {
+        return threadIt.value();
+    }
+
+    TraceRecorder& recorder = getInstance();
+    const char* internedName;
+    {
+        std::lock_guard<std::mutex> lock(recorder._mutex);
+        auto it = recorder._internedNames.find(name);
+        if (it == recorder._internedNames.end()) {
+            it = recorder._internedNames.insert(name, name.toUtf8());
+        }
+        // the data of the byte array isn't moved when the hash grows
+        internedName = it.value().constData();
+    }
+    threadNames.insert(name, internedName);
+    return internedName;
+}
+
+void TraceRecorder::setThreadName(const QString& name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _threadNames[(qint64)QThread::currentThreadId()] = name;
+}
+
+static void appendJsonString(QByteArray& out, const char* string) {
+    out.append('"');
+    for (const char* c = string; c && *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out.append('\\');
+            out.append(*c);
+        } else if ((unsigned char)*c < 0x20) {
+            out.append(QByteArray("\\u00") + QByteArray::number((int)*c, 16).rightJustified(2, '0'));
+        } else {
+            out.append(*c);
+        }
+    }
+    out.append('"');
+}
+
+QByteArray TraceRecorder::toChromeTrace() const {
+    std::vector<std::shared_ptr<ThreadBuffer>> threadBuffers;
+    QHash<qint64, QString> threadNames;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        threadBuffers = _threadBuffers;
+        threadNames = _threadNames;
+    }
+
+    QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+    QByteArray out;
+    out.append("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    bool first = true;
+    std::vector<RecordedEvent> events;
+    for (const auto& buffer : threadBuffers) {
+        QByteArray tid = QByteArray::number(buffer->threadID);
+
+        auto nameIt = threadNames.find(buffer->threadID);
+        if (nameIt != threadNames.end()) {
+            out.append(first ? "" : ",\n");
+            first = false;
+            out.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":" + tid + ",\"args\":{\"name\":");
+            appendJsonString(out, nameIt.value().toUtf8().constData());
+            out.append("}}");
+        }
+
+        // the thread keeps recording while its events are copied, so the ones that it may have overwritten meanwhile
+        // are dropped
+        uint64_t end = buffer->head.load(std::memory_order_acquire);
+        uint64_t begin = end > EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0;
+        events.clear();
+        for (uint64_t i = begin; i < end; ++i) {
+            events.push_back(buffer->events[i % EVENTS_PER_THREAD]);
+        }
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        size_t firstValid = 0;
+        if (head + 1 > begin + EVENTS_PER_THREAD) {
+            firstValid = (size_t)std::min<uint64_t>(head + 1 - EVENTS_PER_THREAD - begin, events.size());
+        }
+
+        for (size_t i = firstValid; i < events.size(); ++i) {
+            const RecordedEvent& event = events[i];
+            out.append(first ? "" : ",\n");
+            first = false;
+            out.append("{\"name\":");
+            appendJsonString(out, event.name);
+            out.append(",\"cat\":");
+            appendJsonString(out, event.category->categoryName());
+            out.append(",\"ph\":\"");
+            out.append((char)event.type);
+            // the timestamps are in usecs, with the nsecs as decimals
+            out.append("\",\"ts\":" + QByteArray::number(event.timestamp / 1000) + "." +
+                QByteArray::number(event.timestamp % 1000).rightJustified(3, '0'));
+            out.append(",\"pid\":" + pid + ",\"tid\":" + tid);
+            if (event.type == Instant) {
+                out.append(",\"s\":\"t\"");
+            }
+            out.append('}');
+        }
+    }
+    out.append("\n]}\n");
+    return out;
+}
+
+bool TraceRecorder::dump(const QString& filename) const {
+    QByteArray data = toChromeTrace();
+    if (filename.endsWith(".gz")) {
+        QByteArray compressed;
+        gzip(data, compressed);
+        data = compressed;
+    }
+
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(shared) << "TraceRecorder failed to open" << filename;
+        return false;
+    }
+    file.write(data);
+    qCInfo(shared) << "TraceRecorder dumped the recorded events to" << filename;
+    return true;
+}
+
+#ifndef Q_OS_WIN
+static std::atomic<bool> dumpRequested { false };
+
+static void requestDump(int) {
+    dumpRequested = true;
+}
+#endif
+
+void TraceRecorder::setupDumpOnSignal() {
+#ifndef Q_OS_WIN
+    static std::once_flag once;
+    std::call_once(once, [this] {
+        // the signal handler only raises a flag, the dump is written from a thread that polls it
+        signal(SIGUSR2, requestDump);
+        std::thread([this] {
+            static const std::chrono::seconds POLL_INTERVAL { 1 };
+            while (true) {
+                std::this_thread::sleep_for(POLL_INTERVAL);
+                if (dumpRequested.exchange(false)) {
+                    QString filename = QString("%1/%2-trace-%3-%4.json.gz").arg(QDir::tempPath(),
+                        QCoreApplication::applicationName(), QString::number(QCoreApplication::applicationPid()),
+                        QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss"));
+                    dump(filename);
+                }
+            }
+        }).detach();
+    });
+#endif
+}
@@ -0,0 +1,84 @@
+//
+//  TraceRecorder.h
+//  libraries/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_TraceRecorder_h
+#define overte_TraceRecorder_h
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
+
+#include "Trace.h"
+
+namespace tracing {
+
+/// An event of the trace recorder, whose name and category outlive the recorder so that recording it doesn't allocate
+struct RecordedEvent {
+    uint64_t timestamp; // nsecs
+    const char* name;
+    const QLoggingCategory* category;
+    EventType type;
+};
+
+/// Records the profiled ranges in a ring buffer per thread, with nanosecond timestamps and neither a lock nor an
+/// allocation per event, so that it can be left on as a flight recorder on the servers.  The last events of every
+/// thread are dumped on demand in the Chrome trace format, which Perfetto reads as well.
+class TraceRecorder {
+public:
+    static const size_t EVENTS_PER_THREAD = 8192;
+
+    static TraceRecorder& getInstance();
+
+    static bool isEnabled() { return _enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled);
+
+    /// Records an event in the buffer of the calling thread, the name must outlive the recorder
+    static void record(const QLoggingCategory& category, const char* name, EventType type);
+
+    /// Returns a copy of name that lives as long as the recorder, for the names that aren't static strings
+    static const char* internName(const QString& name);
+
+    void setThreadName(const QString& name);
+
+    /// The recorded events, oldest first for each thread, in the Chrome trace JSON format
+    QByteArray toChromeTrace() const;
+
+    /// Writes the recorded events to a file, compressed if its name ends with .gz
+    bool dump(const QString& filename) const;
+
+    /// Dumps the recorded events to a file in the temporary directory whenever the process receives SIGUSR2
+    void setupDumpOnSignal();
+
+private:
+    struct ThreadBuffer;
+
+    TraceRecorder() {}
+
+    std::shared_ptr<ThreadBuffer> createThreadBuffer();
+
+    static std::atomic<bool> _enabled;
+
+    mutable std::mutex _mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> _threadBuffers;
+    QHash<qint64, QString> _threadNames;
+    QHash<QString, QByteArray> _internedNames;
+};
+
+}
+
+#endif // overte_TraceRecorder_h
@@ -11,9 +11,57 @@
 
 #include "TriangleSet.h"
 
+#include <algorithm>
+
 #include "GLMHelpers.h"
 
-#include <list>
+// the leaves are tested four triangles at a time, like the boxes of the children of the nodes
+static const uint32_t MAX_LEAF_TRIANGLES = 4;
+static const int NUM_SAH_BINS = 12;
+static const uint32_t INVALID_TRIANGLE = (uint32_t)-1;
+
+namespace {
+
+struct BuildBox {
+    glm::vec3 minimum { FLT_MAX };
+    glm::vec3 maximum { -FLT_MAX };
+
+    void grow(const glm::vec3& point) {
+        minimum = glm::min(minimum, point);
+        maximum = glm::max(maximum, point);
+    }
+    void grow(const BuildBox& box) {
+        minimum = glm::min(minimum, box.minimum);
+        maximum = glm::max(maximum, box.maximum);
+    }
+    float getHalfArea() const {
+        if (minimum.x > maximum.x) {
+            return 0.0f;
+        }
+        glm::vec3 dimensions = maximum - minimum;
+        return dimensions.x * dimensions.y + dimensions.y * dimensions.z + dimensions.z * dimensions.x;
+    }
+};
+
+struct StackEntry {
+    uint32_t node;
+    float distance;
+};
+
+}
+
+struct TriangleSet::TriangleTreeBuild {
+    std::vector<BuildBox> bounds;
+    std::vector<glm::vec3> centroids;
+    // the triangles of the leaves are the ranges of indices that the nodes are built from
+    std::vector<uint32_t> indices;
+};
+
+AABox TriangleSet::TriangleTreeNode::getChildBounds(int child) const {
+    glm::vec3 minimum(minX[child], minY[child], minZ[child]);
+    glm::vec3 maximum(maxX[child], maxY[child], maxZ[child]);
+    return AABox(minimum, maximum - minimum);
+}
 
 void TriangleSet::insert(const Triangle& t) {
     _isBalanced = false;
@@ -29,7 +77,7 @@ void TriangleSet::clear() {
     _bounds.clear();
     _isBalanced = false;
 
-    _triangleTree.clear();
+    _nodes.clear();
 }
 
 bool TriangleSet::convexHullContains(const glm::vec3& point) const {
@@ -52,275 +100,413 @@ bool TriangleSet::convexHullContains(const glm::vec3& point) const {
 void TriangleSet::debugDump() {
     qDebug() << __FUNCTION__;
     qDebug() << "bounds:" << getBounds();
-    qDebug() << "triangles:" << size() << "at top level....";
-    qDebug() << "----- _triangleTree -----";
-    _triangleTree.debugDump();
-}
-
-void TriangleSet::balanceTree() {
-    _triangleTree.reset(_bounds);
-
-    // insert all the triangles
-    for (size_t i = 0; i < _triangles.size(); i++) {
-        _triangleTree.insert(i);
+    qDebug() << "triangles:" << size();
+    int numLeaves = 0;
+    int numEmpty = 0;
+    for (const auto& node : _nodes) {
+        for (int i = 0; i < NODE_WIDTH; i++) {
+            if (node.count[i] == EMPTY_CHILD) {
+                numEmpty++;
+            } else if (node.count[i] != INNER_CHILD) {
+                numLeaves++;
+            }
+        }
     }
-
-    _isBalanced = true;
-
-#if WANT_DEBUGGING
-    debugDump();
-#endif
+    qDebug() << "nodes:" << _nodes.size() << "leaves:" << numLeaves << "empty children:" << numEmpty;
 }
 
-// With an octree: 8 ^ MAX_DEPTH = 4096 leaves
-//static const int MAX_DEPTH = 4;
-// With a k-d tree: 2 ^ MAX_DEPTH = 4096 leaves
-static const int MAX_DEPTH = 12;
-
-TriangleSet::TriangleTreeCell::TriangleTreeCell(std::vector<Triangle>& allTriangles, const AABox& bounds, int depth) :
-    _allTriangles(allTriangles)
-{
-    reset(bounds, depth);
-}
+// Splits the range of indices in two with the binned surface area heuristic along the axis where the centroids are the most
+// spread, returns the start of the second half
+static uint32_t splitRange(std::vector<uint32_t>& indices, const std::vector<BuildBox>& bounds,
+                           const std::vector<glm::vec3>& centroids, uint32_t begin, uint32_t end) {
+    uint32_t middle = begin + (end - begin) / 2;
 
-void TriangleSet::TriangleTreeCell::clear() {
-    _population = 0;
-    _triangleIndices.clear();
-    _bounds.clear();
-    _children.first.reset();
-    _children.second.reset();
-}
-
-void TriangleSet::TriangleTreeCell::reset(const AABox& bounds, int depth) {
-    clear();
-    _bounds = bounds;
-    _depth = depth;
-}
+    BuildBox centroidBounds;
+    for (uint32_t i = begin; i < end; i++) {
+        centroidBounds.grow(centroids[indices[i]]);
+    }
+    glm::vec3 extent = centroidBounds.maximum - centroidBounds.minimum;
+    int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+    if (extent[axis] <= 0.0f) {
+        // the centroids are all in the same place, any split is as good
+        return middle;
+    }
+    float binScale = (float)NUM_SAH_BINS / extent[axis];
+    float binStart = centroidBounds.minimum[axis];
+    auto getBin = [&](uint32_t index) {
+        int bin = (int)((centroids[index][axis] - binStart) * binScale);
+        return std::min(bin, NUM_SAH_BINS - 1);
+    };
+
+    BuildBox binBounds[NUM_SAH_BINS];
+    uint32_t binCounts[NUM_SAH_BINS] = { 0 };
+    for (uint32_t i = begin; i < end; i++) {
+        int bin = getBin(indices[i]);
+        binBounds[bin].grow(bounds[indices[i]]);
+        binCounts[bin]++;
+    }
 
-void TriangleSet::TriangleTreeCell::debugDump() {
-    qDebug() << __FUNCTION__;
-    qDebug() << "               bounds:" << getBounds();
-    qDebug() << "                depth:" << _depth;
-    qDebug() << "           population:" << _population << "this level or below"
-             << " ---- triangleIndices:" << _triangleIndices.size() << "in this cell";
-
-    int numChildren = 0;
-    if (_children.first) {
-        numChildren++;
-    } else if (_children.second) {
-        numChildren++;
+    // sweep from the right to get the costs of the right sides, then from the left to find the cheapest split
+    float rightCosts[NUM_SAH_BINS];
+    BuildBox rightBounds;
+    uint32_t rightCount = 0;
+    for (int bin = NUM_SAH_BINS - 1; bin > 0; bin--) {
+        rightBounds.grow(binBounds[bin]);
+        rightCount += binCounts[bin];
+        rightCosts[bin] = rightBounds.getHalfArea() * (float)rightCount;
     }
-    qDebug() << "child cells:" << numChildren;
-    if (_depth < MAX_DEPTH) {
-        if (_children.first) {
-            qDebug() << "child: 0";
-            _children.first->debugDump();
+    BuildBox leftBounds;
+    uint32_t leftCount = 0;
+    float bestCost = FLT_MAX;
+    int bestBin = -1;
+    for (int bin = 0; bin < NUM_SAH_BINS - 1; bin++) {
+        leftBounds.grow(binBounds[bin]);
+        leftCount += binCounts[bin];
+        if (leftCount == 0 || leftCount == end - begin) {
+            continue;
         }
-        if (_children.second) {
-            qDebug() << "child: 1";
-            _children.second->debugDump();
+        float cost = leftBounds.getHalfArea() * (float)leftCount + rightCosts[bin + 1];
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestBin = bin;
         }
     }
-}
 
-std::pair<AABox, AABox> TriangleSet::TriangleTreeCell::getTriangleTreeCellChildBounds() {
-    std::pair<AABox, AABox> toReturn;
-    int axis = 0;
-    // find biggest axis
-    glm::vec3 dimensions = _bounds.getDimensions();
-    for (int i = 0; i < 3; i++) {
-        if (dimensions[i] >= dimensions[(i + 1) % 3] && dimensions[i] >= dimensions[(i + 2) % 3]) {
-            axis = i;
-            break;
+    if (bestBin >= 0) {
+        auto split = std::partition(indices.begin() + begin, indices.begin() + end,
+            [&](uint32_t index) { return getBin(index) <= bestBin; });
+        uint32_t splitIndex = (uint32_t)(split - indices.begin());
+        if (splitIndex > begin && splitIndex < end) {
+            return splitIndex;
         }
     }
 
-    // The new boxes are half the size in the largest dimension
-    glm::vec3 newDimensions = dimensions;
-    newDimensions[axis] *= 0.5f;
-    toReturn.first.setBox(_bounds.getCorner(), newDimensions);
-    glm::vec3 offset = glm::vec3(0.0f);
-    offset[axis] = newDimensions[axis];
-    toReturn.second.setBox(_bounds.getCorner() + offset, newDimensions);
-    return toReturn;
+    // fall back on the median of the centroids
+    std::nth_element(indices.begin() + begin, indices.begin() + middle, indices.begin() + end,
+        [&](uint32_t a, uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+    return middle;
 }
 
-void TriangleSet::TriangleTreeCell::insert(size_t triangleIndex) {
-    _population++;
-
-    // if we're not yet at the max depth, then check which child the triangle fits in
-    if (_depth < MAX_DEPTH) {
-        const Triangle& triangle = _allTriangles[triangleIndex];
-        auto childBounds = getTriangleTreeCellChildBounds();
-
-        auto insertOperator = [&](const AABox& childBound, std::shared_ptr<TriangleTreeCell>& child) {
-            // if the child AABox would contain the triangle...
-            if (childBound.contains(triangle)) {
-                // if the child cell doesn't yet exist, create it...
-                if (!child) {
-                    child = std::make_shared<TriangleTreeCell>(_allTriangles, childBound, _depth + 1);
-                }
+uint32_t TriangleSet::buildNode(TriangleTreeBuild& build, uint32_t begin, uint32_t end) {
+    // the node is filled in once its children are built, since they can reallocate the nodes
+    uint32_t nodeIndex = (uint32_t)_nodes.size();
+    _nodes.emplace_back();
+
+    // split the largest range until there's one for each child or they all fit in leaves
+    uint32_t ranges[NODE_WIDTH][2] = { { begin, end } };
+    int numRanges = 1;
+    while (numRanges < NODE_WIDTH) {
+        int largest = -1;
+        uint32_t largestCount = MAX_LEAF_TRIANGLES;
+        for (int i = 0; i < numRanges; i++) {
+            uint32_t count = ranges[i][1] - ranges[i][0];
+            if (count > largestCount) {
+                largest = i;
+                largestCount = count;
+            }
+        }
+        if (largest < 0) {
+            break;
+        }
+        uint32_t middle = splitRange(build.indices, build.bounds, build.centroids, ranges[largest][0], ranges[largest][1]);
+        ranges[numRanges][0] = middle;
+        ranges[numRanges][1] = ranges[largest][1];
+        ranges[largest][1] = middle;
+        numRanges++;
+    }
 
-                // insert the triangleIndex in the child cell
-                child->insert(triangleIndex);
-                return true;
+    TriangleTreeNode node;
+    for (int i = 0; i < NODE_WIDTH; i++) {
+        BuildBox childBounds;
+        if (i >= numRanges) {
+            node.first[i] = 0;
+            node.count[i] = EMPTY_CHILD;
+        } else {
+            for (uint32_t j = ranges[i][0]; j < ranges[i][1]; j++) {
+                childBounds.grow(build.bounds[build.indices[j]]);
+            }
+            uint32_t count = ranges[i][1] - ranges[i][0];
+            if (count <= MAX_LEAF_TRIANGLES) {
+                node.first[i] = ranges[i][0];
+                node.count[i] = count;
+            } else {
+                node.first[i] = buildNode(build, ranges[i][0], ranges[i][1]);
+                node.count[i] = INNER_CHILD;
             }
-            return false;
-        };
-        if (insertOperator(childBounds.first, _children.first) || insertOperator(childBounds.second, _children.second)) {
-            return;
         }
+        node.minX[i] = childBounds.minimum.x;
+        node.minY[i] = childBounds.minimum.y;
+        node.minZ[i] = childBounds.minimum.z;
+        node.maxX[i] = childBounds.maximum.x;
+        node.maxY[i] = childBounds.maximum.y;
+        node.maxZ[i] = childBounds.maximum.z;
     }
-    // either we're at max depth, or the triangle doesn't fit in one of our
-    // children and so we want to just record it here
-    _triangleIndices.push_back(triangleIndex);
+    _nodes[nodeIndex] = node;
+    return nodeIndex;
 }
 
-bool TriangleSet::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection, float& distance,
-                                      BoxFace& face, Triangle& triangle, bool precision, bool allowBackface) {
-    if (!_isBalanced) {
-        balanceTree();
+void TriangleSet::balanceTree() {
+    _nodes.clear();
+
+    uint32_t numTriangles = (uint32_t)_triangles.size();
+    if (numTriangles > 0) {
+        TriangleTreeBuild build;
+        build.bounds.resize(numTriangles);
+        build.centroids.resize(numTriangles);
+        build.indices.resize(numTriangles);
+        for (uint32_t i = 0; i < numTriangles; i++) {
+            const Triangle& triangle = _triangles[i];
+            BuildBox& bounds = build.bounds[i];
+            bounds.grow(triangle.v0);
+            bounds.grow(triangle.v1);
+            bounds.grow(triangle.v2);
+            build.centroids[i] = 0.5f * (bounds.minimum + bounds.maximum);
+            build.indices[i] = i;
+        }
+        _nodes.reserve(2 * numTriangles / MAX_LEAF_TRIANGLES + 1);
+        buildNode(build, 0, numTriangles);
+
+        // sort the triangles in the order of the leaves, which are ranges of them
+        std::vector<Triangle> sortedTriangles;
+        sortedTriangles.reserve(numTriangles);
+        for (uint32_t index : build.indices) {
+            sortedTriangles.push_back(_triangles[index]);
+        }
+        _triangles.swap(sortedTriangles);
     }
 
-    float localDistance = distance;
-    int trianglesTouched = 0;
-    bool hit = _triangleTree.findRayIntersection(origin, direction, invDirection, localDistance, face, triangle, precision, trianglesTouched, allowBackface);
-    if (hit) {
-        distance = localDistance;
-    }
+    _isBalanced = true;
 
 #if WANT_DEBUGGING
-    if (precision) {
-        qDebug() << "trianglesTouched :" << trianglesTouched << "out of:" << _triangleTree._population << "_triangles.size:" << _triangles.size();
-    }
+    debugDump();
 #endif
-    return hit;
 }
 
-// Determine of the given ray (origin/direction) in model space intersects with any triangles
-// in the set. If an intersection occurs, the distance and surface normal will be provided.
-bool TriangleSet::TriangleTreeCell::findRayIntersectionInternal(const glm::vec3& origin, const glm::vec3& direction,
-                                                                  float& distance, BoxFace& face, Triangle& triangle, bool precision,
-                                                                  int& trianglesTouched, bool allowBackface) {
-    bool intersectedSomething = false;
-    float bestDistance = FLT_MAX;
-    Triangle bestTriangle;
-
-    if (precision) {
-        for (const auto& triangleIndex : _triangleIndices) {
-            const auto& thisTriangle = _allTriangles[triangleIndex];
-            float thisTriangleDistance;
-            trianglesTouched++;
-            if (findRayTriangleIntersection(origin, direction, thisTriangle, thisTriangleDistance, allowBackface)) {
-                if (thisTriangleDistance < bestDistance) {
-                    bestDistance = thisTriangleDistance;
-                    bestTriangle = thisTriangle;
-                    intersectedSomething = true;
-                }
-            }
+int TriangleSet::findRayChildIntersections(const TriangleTreeNode& node, const glm::vec3& origin, const glm::vec3& invDirection,
+                                           float maxDistance, float distances[NODE_WIDTH]) const {
+    int mask = 0;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    __m128 zero = _mm_setzero_ps();
+    __m128 originX = _mm_set1_ps(origin.x);
+    __m128 originY = _mm_set1_ps(origin.y);
+    __m128 originZ = _mm_set1_ps(origin.z);
+    __m128 invDirectionX = _mm_set1_ps(invDirection.x);
+    __m128 invDirectionY = _mm_set1_ps(invDirection.y);
+    __m128 invDirectionZ = _mm_set1_ps(invDirection.z);
+
+    __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.minX), originX), invDirectionX);
+    __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.maxX), originX), invDirectionX);
+    __m128 entry = _mm_max_ps(zero, _mm_min_ps(t0, t1));
+    __m128 exit = _mm_min_ps(_mm_set1_ps(maxDistance), _mm_max_ps(t0, t1));
+
+    t0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.minY), originY), invDirectionY);
+    t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.maxY), originY), invDirectionY);
+    entry = _mm_max_ps(entry, _mm_min_ps(t0, t1));
+    exit = _mm_min_ps(exit, _mm_max_ps(t0, t1));
+
+    t0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.minZ), originZ), invDirectionZ);
+    t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.maxZ), originZ), invDirectionZ);
+    entry = _mm_max_ps(entry, _mm_min_ps(t0, t1));
+    exit = _mm_min_ps(exit, _mm_max_ps(t0, t1));
+
+    mask = _mm_movemask_ps(_mm_cmple_ps(entry, exit));
+    _mm_storeu_ps(distances, entry);
+#else
+    const float* minimums[3] = { node.minX, node.minY, node.minZ };
+    const float* maximums[3] = { node.maxX, node.maxY, node.maxZ };
+    for (int i = 0; i < NODE_WIDTH; i++) {
+        float entry = 0.0f;
+        float exit = maxDistance;
+        for (int axis = 0; axis < 3; axis++) {
+            float t0 = (minimums[axis][i] - origin[axis]) * invDirection[axis];
+            float t1 = (maximums[axis][i] - origin[axis]) * invDirection[axis];
+            entry = std::max(entry, std::min(t0, t1));
+            exit = std::min(exit, std::max(t0, t1));
+        }
+        distances[i] = entry;
+        if (entry <= exit) {
+            mask |= 1 << i;
         }
-    } else {
-        intersectedSomething = true;
-        bestDistance = distance;
     }
+#endif
 
-    if (intersectedSomething) {
-        distance = bestDistance;
-        triangle = bestTriangle;
+    // the empty children have inverted boxes, which the slabs don't reject in every direction
+    for (int i = 0; i < NODE_WIDTH; i++) {
+        if (node.count[i] == EMPTY_CHILD) {
+            mask &= ~(1 << i);
+        }
     }
+    return mask;
+}
 
-    return intersectedSomething;
+bool TriangleSet::findRayLeafIntersection(uint32_t first, uint32_t count, const glm::vec3& origin, const glm::vec3& direction,
+                                          float& distance, uint32_t& triangleIndex, bool allowBackface) const {
+    bool hit = false;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    // the same tests as findRayTriangleIntersection, on the four triangles at once
+    float coordinates[9][NODE_WIDTH];
+    for (uint32_t i = 0; i < (uint32_t)NODE_WIDTH; i++) {
+        // the missing triangles repeat the last one, whose result is masked out
+        const Triangle& triangle = _triangles[first + std::min(i, count - 1)];
+        for (int axis = 0; axis < 3; axis++) {
+            coordinates[axis][i] = triangle.v0[axis];
+            coordinates[3 + axis][i] = triangle.v1[axis] - triangle.v0[axis];
+            coordinates[6 + axis][i] = triangle.v2[axis] - triangle.v0[axis];
+        }
+    }
+    __m128 v0X = _mm_loadu_ps(coordinates[0]);
+    __m128 v0Y = _mm_loadu_ps(coordinates[1]);
+    __m128 v0Z = _mm_loadu_ps(coordinates[2]);
+    __m128 firstSideX = _mm_loadu_ps(coordinates[3]);
+    __m128 firstSideY = _mm_loadu_ps(coordinates[4]);
+    __m128 firstSideZ = _mm_loadu_ps(coordinates[5]);
+    __m128 secondSideX = _mm_loadu_ps(coordinates[6]);
+    __m128 secondSideY = _mm_loadu_ps(coordinates[7]);
+    __m128 secondSideZ = _mm_loadu_ps(coordinates[8]);
+    __m128 directionX = _mm_set1_ps(direction.x);
+    __m128 directionY = _mm_set1_ps(direction.y);
+    __m128 directionZ = _mm_set1_ps(direction.z);
+    __m128 epsilon = _mm_set1_ps(EPSILON);
+    __m128 zero = _mm_setzero_ps();
+    __m128 one = _mm_set1_ps(1.0f);
+
+    // P = cross(direction, secondSide)
+    __m128 pX = _mm_sub_ps(_mm_mul_ps(directionY, secondSideZ), _mm_mul_ps(directionZ, secondSideY));
+    __m128 pY = _mm_sub_ps(_mm_mul_ps(directionZ, secondSideX), _mm_mul_ps(directionX, secondSideZ));
+    __m128 pZ = _mm_sub_ps(_mm_mul_ps(directionX, secondSideY), _mm_mul_ps(directionY, secondSideX));
+    __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(firstSideX, pX), _mm_mul_ps(firstSideY, pY)), _mm_mul_ps(firstSideZ, pZ));
+    __m128 valid;
+    if (allowBackface) {
+        __m128 absDet = _mm_andnot_ps(_mm_set1_ps(-0.0f), det);
+        valid = _mm_cmpge_ps(absDet, epsilon);
+    } else {
+        valid = _mm_cmpge_ps(det, epsilon);
+    }
+    __m128 invDet = _mm_div_ps(one, det);
+
+    __m128 tX = _mm_sub_ps(_mm_set1_ps(origin.x), v0X);
+    __m128 tY = _mm_sub_ps(_mm_set1_ps(origin.y), v0Y);
+    __m128 tZ = _mm_sub_ps(_mm_set1_ps(origin.z), v0Z);
+    __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tX, pX), _mm_mul_ps(tY, pY)), _mm_mul_ps(tZ, pZ)), invDet);
+    valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+
+    // Q = cross(T, firstSide)
+    __m128 qX = _mm_sub_ps(_mm_mul_ps(tY, firstSideZ), _mm_mul_ps(tZ, firstSideY));
+    __m128 qY = _mm_sub_ps(_mm_mul_ps(tZ, firstSideX), _mm_mul_ps(tX, firstSideZ));
+    __m128 qZ = _mm_sub_ps(_mm_mul_ps(tX, firstSideY), _mm_mul_ps(tY, firstSideX));
+    __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(directionX, qX), _mm_mul_ps(directionY, qY)),
+        _mm_mul_ps(directionZ, qZ)), invDet);
+    valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+
+    __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(secondSideX, qX), _mm_mul_ps(secondSideY, qY)),
+        _mm_mul_ps(secondSideZ, qZ)), invDet);
+    valid = _mm_and_ps(valid, _mm_cmpgt_ps(t, epsilon));
+
+    int mask = _mm_movemask_ps(valid) & ((1 << count) - 1);
+    if (mask != 0) {
+        float distances[NODE_WIDTH];
+        _mm_storeu_ps(distances, t);
+        for (uint32_t i = 0; i < count; i++) {
+            if ((mask & (1 << i)) && distances[i] < distance) {
+                distance = distances[i];
+                triangleIndex = first + i;
+                hit = true;
+            }
+        }
+    }
+#else
+    for (uint32_t i = first; i < first + count; i++) {
+        float triangleDistance;
+        if (findRayTriangleIntersection(origin, direction, _triangles[i], triangleDistance, allowBackface) &&
+                triangleDistance < distance) {
+            distance = triangleDistance;
+            triangleIndex = i;
+            hit = true;
+        }
+    }
+#endif
+    return hit;
 }
 
-bool TriangleSet::TriangleTreeCell::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection,
-                                                        float& distance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-                                                        bool allowBackface) {
-    if (_population < 1) {
-        return false; // no triangles below here, so we can't intersect
+// Determine of the given ray (origin/direction) in model space intersects with any triangles
+// in the set. If an intersection occurs, the distance and surface normal will be provided.
+// If !precision, the distance is the one to the box of the closest leaf that the ray hits.
+bool TriangleSet::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection, float& distance,
+                                      BoxFace& face, Triangle& triangle, bool precision, bool allowBackface) {
+    if (!_isBalanced) {
+        balanceTree();
+    }
+    if (_nodes.empty()) {
+        return false;
     }
 
-    float bestLocalDistance = FLT_MAX;
-    BoxFace bestLocalFace;
-    Triangle bestLocalTriangle;
+    float bestDistance = FLT_MAX;
+    uint32_t bestTriangle = INVALID_TRIANGLE;
     bool intersects = false;
 
-    // Check our local triangle set first
-    // The distance passed in here is the distance to our bounding box.  If !precision, that distance is used
-    {
-        float internalDistance = distance;
-        BoxFace internalFace { UNKNOWN_FACE };
-        Triangle internalTriangle;
-        if (findRayIntersectionInternal(origin, direction, internalDistance, internalFace, internalTriangle, precision, trianglesTouched, allowBackface)) {
-            bestLocalDistance = internalDistance;
-            bestLocalFace = internalFace;
-            bestLocalTriangle = internalTriangle;
-            intersects = true;
+    static thread_local std::vector<StackEntry> stack;
+    stack.clear();
+    stack.push_back({ 0, 0.0f });
+    while (!stack.empty()) {
+        StackEntry entry = stack.back();
+        stack.pop_back();
+        if (entry.distance > bestDistance) {
+            continue;
+        }
+        const TriangleTreeNode& node = _nodes[entry.node];
+        float distances[NODE_WIDTH];
+        int mask = findRayChildIntersections(node, origin, invDirection, bestDistance, distances);
+        if (mask == 0) {
+            continue;
         }
-    }
-
-    // if we're not yet at the max depth, then check our children
-    if (_depth < MAX_DEPTH) {
-        std::list<SortedTriangleCell> sortedTriangleCells;
-        auto sortingOperator = [&](std::shared_ptr<TriangleTreeCell>& child) {
-            if (child) {
-                float priority = FLT_MAX;
-                if (child->getBounds().contains(origin)) {
-                    priority = 0.0f;
-                } else {
-                    float childBoundDistance = FLT_MAX;
-                    BoxFace childBoundFace;
-                    glm::vec3 childBoundNormal;
-                    if (child->getBounds().findRayIntersection(origin, direction, invDirection, childBoundDistance, childBoundFace, childBoundNormal)) {
-                        // We only need to add this cell if it's closer than the local triangle set intersection (if there was one)
-                        if (childBoundDistance < bestLocalDistance) {
-                            priority = childBoundDistance;
-                        }
-                    }
-                }
 
-                if (priority < FLT_MAX) {
-                    if (sortedTriangleCells.size() > 0 && priority < sortedTriangleCells.front().first) {
-                        sortedTriangleCells.emplace_front(priority, child);
-                    } else {
-                        sortedTriangleCells.emplace_back(priority, child);
-                    }
+        // visit the children from the nearest, the leaves straight away and the nodes pushed so that the nearest is next
+        int children[NODE_WIDTH];
+        int numChildren = 0;
+        for (int i = 0; i < NODE_WIDTH; i++) {
+            if (mask & (1 << i)) {
+                int j = numChildren++;
+                for (; j > 0 && distances[children[j - 1]] > distances[i]; j--) {
+                    children[j] = children[j - 1];
                 }
+                children[j] = i;
             }
-        };
-        sortingOperator(_children.first);
-        sortingOperator(_children.second);
-
-        for (auto it = sortedTriangleCells.begin(); it != sortedTriangleCells.end(); ++it) {
-            const SortedTriangleCell& sortedTriangleCell = *it;
-            float childDistance = sortedTriangleCell.first;
-            // We can exit once childDistance > bestLocalDistance
-            if (childDistance > bestLocalDistance) {
+        }
+        size_t firstPushed = stack.size();
+        for (int i = 0; i < numChildren; i++) {
+            int child = children[i];
+            float childDistance = distances[child];
+            if (childDistance > bestDistance) {
                 break;
             }
-            // If we're inside the child cell and !precision, we need the actual distance to the cell bounds
-            if (!precision && childDistance < EPSILON) {
-                BoxFace childBoundFace;
-                glm::vec3 childBoundNormal;
-                sortedTriangleCell.second->getBounds().findRayIntersection(origin, direction, invDirection, childDistance, childBoundFace, childBoundNormal);
-            }
-            BoxFace childFace;
-            Triangle childTriangle;
-            if (sortedTriangleCell.second->findRayIntersection(origin, direction, invDirection, childDistance, childFace, childTriangle, precision, trianglesTouched)) {
-                if (childDistance < bestLocalDistance) {
-                    bestLocalDistance = childDistance;
-                    bestLocalFace = childFace;
-                    bestLocalTriangle = childTriangle;
+            if (node.count[child] == INNER_CHILD) {
+                stack.push_back({ node.first[child], childDistance });
+            } else if (precision) {
+                if (findRayLeafIntersection(node.first[child], node.count[child], origin, direction, bestDistance,
+                        bestTriangle, allowBackface)) {
+                    intersects = true;
+                }
+            } else {
+                // If we're inside the leaf, we need the actual distance to its bounds
+                if (childDistance < EPSILON) {
+                    BoxFace childBoundFace;
+                    glm::vec3 childBoundNormal;
+                    node.getChildBounds(child).findRayIntersection(origin, direction, invDirection, childDistance,
+                        childBoundFace, childBoundNormal);
+                }
+                if (childDistance < bestDistance) {
+                    bestDistance = childDistance;
                     intersects = true;
-                    break;
                 }
             }
         }
+        std::reverse(stack.begin() + firstPushed, stack.end());
     }
 
     if (intersects) {
-        distance = bestLocalDistance;
-        face = bestLocalFace;
-        triangle = bestLocalTriangle;
+        distance = bestDistance;
+        face = UNKNOWN_FACE;
+        triangle = bestTriangle != INVALID_TRIANGLE ? _triangles[bestTriangle] : Triangle();
     }
     return intersects;
 }
@@ -330,146 +516,93 @@ bool TriangleSet::findParabolaIntersection(const glm::vec3& origin, const glm::v
     if (!_isBalanced) {
         balanceTree();
     }
-
-    float localDistance = parabolicDistance;
-    int trianglesTouched = 0;
-    bool hit = _triangleTree.findParabolaIntersection(origin, velocity, acceleration, localDistance, face, triangle, precision, trianglesTouched, allowBackface);
-    if (hit) {
-        parabolicDistance = localDistance;
+    if (_nodes.empty()) {
+        return false;
     }
 
-#if WANT_DEBUGGING
-    if (precision) {
-        qDebug() << "trianglesTouched :" << trianglesTouched << "out of:" << _triangleTree._population << "_triangles.size:" << _triangles.size();
-    }
-#endif
-    return hit;
-}
-
-bool TriangleSet::TriangleTreeCell::findParabolaIntersectionInternal(const glm::vec3& origin, const glm::vec3& velocity,
-                                                                       const glm::vec3& acceleration, float& parabolicDistance,
-                                                                       BoxFace& face, Triangle& triangle, bool precision,
-                                                                       int& trianglesTouched, bool allowBackface) {
-    bool intersectedSomething = false;
     float bestDistance = FLT_MAX;
-    Triangle bestTriangle;
-
-    if (precision) {
-        for (const auto& triangleIndex : _triangleIndices) {
-            const auto& thisTriangle = _allTriangles[triangleIndex];
-            float thisTriangleDistance;
-            trianglesTouched++;
-            if (findParabolaTriangleIntersection(origin, velocity, acceleration, thisTriangle, thisTriangleDistance, allowBackface)) {
-                if (thisTriangleDistance < bestDistance) {
-                    bestDistance = thisTriangleDistance;
-                    bestTriangle = thisTriangle;
-                    intersectedSomething = true;
-                }
-            }
-        }
-    } else {
-        intersectedSomething = true;
-        bestDistance = parabolicDistance;
-    }
-
-    if (intersectedSomething) {
-        parabolicDistance = bestDistance;
-        triangle = bestTriangle;
-    }
-
-    return intersectedSomething;
-}
-
-bool TriangleSet::TriangleTreeCell::findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity,
-                                                               const glm::vec3& acceleration, float& parabolicDistance,
-                                                               BoxFace& face, Triangle& triangle, bool precision,
-                                                               int& trianglesTouched, bool allowBackface) {
-    if (_population < 1) {
-        return false; // no triangles below here, so we can't intersect
-    }
-
-    float bestLocalDistance = FLT_MAX;
-    BoxFace bestLocalFace;
-    Triangle bestLocalTriangle;
+    uint32_t bestTriangle = INVALID_TRIANGLE;
     bool intersects = false;
 
-    // Check our local triangle set first
-    // The distance passed in here is the distance to our bounding box.  If !precision, that distance is used
-    {
-        float internalDistance = parabolicDistance;
-        BoxFace internalFace;
-        Triangle internalTriangle;
-        if (findParabolaIntersectionInternal(origin, velocity, acceleration, internalDistance, internalFace, internalTriangle, precision, trianglesTouched, allowBackface)) {
-            bestLocalDistance = internalDistance;
-            bestLocalFace = internalFace;
-            bestLocalTriangle = internalTriangle;
-            intersects = true;
+    // the parabolas are much rarer than the rays, their boxes are tested one at a time
+    static thread_local std::vector<StackEntry> stack;
+    stack.clear();
+    stack.push_back({ 0, 0.0f });
+    while (!stack.empty()) {
+        StackEntry entry = stack.back();
+        stack.pop_back();
+        if (entry.distance > bestDistance) {
+            continue;
         }
-    }
-
-    // if we're not yet at the max depth, then check our children
-    if (_depth < MAX_DEPTH) {
-        std::list<SortedTriangleCell> sortedTriangleCells;
-        auto sortingOperator = [&](std::shared_ptr<TriangleTreeCell>& child) {
-            if (child) {
-                float priority = FLT_MAX;
-                if (child->getBounds().contains(origin)) {
-                    priority = 0.0f;
-                } else {
-                    float childBoundDistance = FLT_MAX;
-                    BoxFace childBoundFace;
-                    glm::vec3 childBoundNormal;
-                    if (child->getBounds().findParabolaIntersection(origin, velocity, acceleration, childBoundDistance, childBoundFace, childBoundNormal)) {
-                        // We only need to add this cell if it's closer than the local triangle set intersection (if there was one)
-                        if (childBoundDistance < bestLocalDistance) {
-                            priority = childBoundDistance;
-                        }
-                    }
-                }
-
-                if (priority < FLT_MAX) {
-                    if (sortedTriangleCells.size() > 0 && priority < sortedTriangleCells.front().first) {
-                        sortedTriangleCells.emplace_front(priority, child);
-                    } else {
-                        sortedTriangleCells.emplace_back(priority, child);
-                    }
-                }
+        const TriangleTreeNode& node = _nodes[entry.node];
+
+        int children[NODE_WIDTH];
+        float distances[NODE_WIDTH];
+        int numChildren = 0;
+        for (int i = 0; i < NODE_WIDTH; i++) {
+            if (node.count[i] == EMPTY_CHILD) {
+                continue;
             }
-        };
-        sortingOperator(_children.first);
-        sortingOperator(_children.second);
-
-        for (auto it = sortedTriangleCells.begin(); it != sortedTriangleCells.end(); ++it) {
-            const SortedTriangleCell& sortedTriangleCell = *it;
-            float childDistance = sortedTriangleCell.first;
-            // We can exit once childDistance > bestLocalDistance
-            if (childDistance > bestLocalDistance) {
-                break;
-            }
-            // If we're inside the child cell and !precision, we need the actual distance to the cell bounds
-            if (!precision && childDistance < EPSILON) {
+            AABox childBounds = node.getChildBounds(i);
+            float childDistance = FLT_MAX;
+            if (childBounds.contains(origin)) {
+                childDistance = 0.0f;
+            } else {
                 BoxFace childBoundFace;
                 glm::vec3 childBoundNormal;
-                sortedTriangleCell.second->getBounds().findParabolaIntersection(origin, velocity, acceleration, childDistance, childBoundFace, childBoundNormal);
+                if (!childBounds.findParabolaIntersection(origin, velocity, acceleration, childDistance, childBoundFace,
+                        childBoundNormal) || childDistance > bestDistance) {
+                    continue;
+                }
+            }
+            distances[i] = childDistance;
+            int j = numChildren++;
+            for (; j > 0 && distances[children[j - 1]] > childDistance; j--) {
+                children[j] = children[j - 1];
+            }
+            children[j] = i;
+        }
+
+        size_t firstPushed = stack.size();
+        for (int i = 0; i < numChildren; i++) {
+            int child = children[i];
+            float childDistance = distances[child];
+            if (childDistance > bestDistance) {
+                break;
             }
-            BoxFace childFace;
-            Triangle childTriangle;
-            if (sortedTriangleCell.second->findParabolaIntersection(origin, velocity, acceleration, childDistance, childFace, childTriangle, precision, trianglesTouched)) {
-                if (childDistance < bestLocalDistance) {
-                    bestLocalDistance = childDistance;
-                    bestLocalFace = childFace;
-                    bestLocalTriangle = childTriangle;
+            if (node.count[child] == INNER_CHILD) {
+                stack.push_back({ node.first[child], childDistance });
+            } else if (precision) {
+                for (uint32_t j = node.first[child]; j < node.first[child] + node.count[child]; j++) {
+                    float triangleDistance;
+                    if (findParabolaTriangleIntersection(origin, velocity, acceleration, _triangles[j], triangleDistance,
+                            allowBackface) && triangleDistance < bestDistance) {
+                        bestDistance = triangleDistance;
+                        bestTriangle = j;
+                        intersects = true;
+                    }
+                }
+            } else {
+                // If we're inside the leaf, we need the actual distance to its bounds
+                if (childDistance < EPSILON) {
+                    BoxFace childBoundFace;
+                    glm::vec3 childBoundNormal;
+                    node.getChildBounds(child).findParabolaIntersection(origin, velocity, acceleration, childDistance,
+                        childBoundFace, childBoundNormal);
+                }
+                if (childDistance < bestDistance) {
+                    bestDistance = childDistance;
                     intersects = true;
-                    break;
                 }
             }
         }
+        std::reverse(stack.begin() + firstPushed, stack.end());
     }
 
     if (intersects) {
-        parabolicDistance = bestLocalDistance;
-        face = bestLocalFace;
-        triangle = bestLocalTriangle;
+        parabolicDistance = bestDistance;
+        face = UNKNOWN_FACE;
+        triangle = bestTriangle != INVALID_TRIANGLE ? _triangles[bestTriangle] : Triangle();
     }
     return intersects;
 }
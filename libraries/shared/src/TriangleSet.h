@@ -11,59 +11,18 @@
 
 #pragma once
 
+#include <stdint.h>
 #include <vector>
-#include <memory>
 
 #include "AABox.h"
 #include "GeometryUtil.h"
 
+/// A set of triangles that rays and parabolas are intersected with, through a bounding volume hierarchy built the first
+/// time that the set is picked after it changed.  The hierarchy is flattened in a vector of nodes with four children each,
+/// whose boxes are tested together, and its leaves are ranges of the triangles, which are sorted in the order of the leaves.
 class TriangleSet {
-
-    class TriangleTreeCell {
-    public:
-        TriangleTreeCell(std::vector<Triangle>& allTriangles) : _allTriangles(allTriangles) {}
-        TriangleTreeCell(std::vector<Triangle>& allTriangles, const AABox& bounds, int depth);
-
-        void insert(size_t triangleIndex);
-        void reset(const AABox& bounds, int depth = 0);
-        void clear();
-
-        bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& invDirection,
-            float& distance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-        bool findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
-            float& parabolicDistance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-
-        const AABox& getBounds() const { return _bounds; }
-
-        void debugDump();
-
-    protected:
-        // checks our internal list of triangles
-        bool findRayIntersectionInternal(const glm::vec3& origin, const glm::vec3& direction,
-            float& distance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-        bool findParabolaIntersectionInternal(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
-            float& parabolicDistance, BoxFace& face, Triangle& triangle, bool precision, int& trianglesTouched,
-            bool allowBackface = false);
-
-        std::pair<AABox, AABox> getTriangleTreeCellChildBounds();
-
-        std::vector<Triangle>& _allTriangles;
-        std::pair<std::shared_ptr<TriangleTreeCell>, std::shared_ptr<TriangleTreeCell>> _children;
-        int _depth { 0 };
-        int _population { 0 };
-        AABox _bounds;
-        std::vector<size_t> _triangleIndices;
-
-        friend class TriangleSet;
-    };
-
-    using SortedTriangleCell = std::pair<float, std::shared_ptr<TriangleTreeCell>>;
-
 public:
-    TriangleSet() : _triangleTree(_triangles) {}
+    TriangleSet() {}
 
     void debugDump();
 
@@ -87,8 +46,40 @@ public:
     const AABox& getBounds() const { return _bounds; }
 
 protected:
+    static const int NODE_WIDTH = 4;
+
+    // The boxes of the children are stored by coordinate so that they are tested together
+    struct TriangleTreeNode {
+        float minX[NODE_WIDTH];
+        float minY[NODE_WIDTH];
+        float minZ[NODE_WIDTH];
+        float maxX[NODE_WIDTH];
+        float maxY[NODE_WIDTH];
+        float maxZ[NODE_WIDTH];
+        // the index of the child node, or of the first triangle of the child leaf
+        uint32_t first[NODE_WIDTH];
+        // the number of triangles of the child leaf, EMPTY_CHILD or INNER_CHILD
+        uint32_t count[NODE_WIDTH];
+
+        AABox getChildBounds(int child) const;
+    };
+    static const uint32_t EMPTY_CHILD = 0;
+    static const uint32_t INNER_CHILD = (uint32_t)-1;
+
+    // The boxes and centroids of the triangles while the tree is built
+    struct TriangleTreeBuild;
+
+    uint32_t buildNode(TriangleTreeBuild& build, uint32_t begin, uint32_t end);
+
+    // Tests the boxes of the children of node against the ray, returns a mask of the children that are hit and their distances
+    int findRayChildIntersections(const TriangleTreeNode& node, const glm::vec3& origin, const glm::vec3& invDirection,
+        float maxDistance, float distances[NODE_WIDTH]) const;
+    // Tests the triangles of a leaf four at a time
+    bool findRayLeafIntersection(uint32_t first, uint32_t count, const glm::vec3& origin, const glm::vec3& direction,
+        float& distance, uint32_t& triangleIndex, bool allowBackface) const;
+
     bool _isBalanced { false };
     std::vector<Triangle> _triangles;
-    TriangleTreeCell _triangleTree;
+    std::vector<TriangleTreeNode> _nodes;
     AABox _bounds;
 };
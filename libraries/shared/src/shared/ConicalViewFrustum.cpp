@@ -51,7 +51,9 @@ bool ConicalViewFrustum::isVerySimilar(const ConicalViewFrustum& other) const {
             angleBetween(_direction, other._direction) < MIN_ANGLE_BETWEEN &&
             closeEnough(_angle, other._angle, MIN_RELATIVE_ERROR) &&
             closeEnough(_farClip, other._farClip, MIN_RELATIVE_ERROR) &&
-            closeEnough(_radius, other._radius, MIN_RELATIVE_ERROR);
+            closeEnough(_radius, other._radius, MIN_RELATIVE_ERROR) &&
+            _priorityWeight == other._priorityWeight &&
+            _lodScale == other._lodScale;
 }
 
 bool ConicalViewFrustum::intersects(const AACube& cube) const {
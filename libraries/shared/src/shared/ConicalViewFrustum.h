@@ -25,6 +25,8 @@ const float SQRT_TWO_OVER_TWO = 0.7071067811865f;
 const float DEFAULT_VIEW_ANGLE = 1.0f;
 const float DEFAULT_VIEW_RADIUS = 10.0f;
 const float DEFAULT_VIEW_FAR_CLIP = 100.0f;
+const float DEFAULT_VIEW_PRIORITY_WEIGHT = 1.0f;
+const float DEFAULT_VIEW_LOD_SCALE = 1.0f;
 
 // ConicalViewFrustum is an approximation of a ViewFrustum for fast calculation of sort priority.
 class ConicalViewFrustum {
@@ -41,6 +43,13 @@ public:
     float getRadius() const { return _radius; }
     float getFarClip() const { return _farClip; }
 
+    // Secondary views, like a spectator camera's, have a priority weight below 1 to send what only they see after what the
+    // main view sees, and a LOD scale above 1 to need things to look larger in them before they are sent.
+    float getPriorityWeight() const { return _priorityWeight; }
+    void setPriorityWeight(float priorityWeight) { _priorityWeight = priorityWeight; }
+    float getLODScale() const { return _lodScale; }
+    void setLODScale(float lodScale) { _lodScale = lodScale; }
+
     bool isVerySimilar(const ConicalViewFrustum& other) const;
 
     bool intersects(const AACube& cube) const;
@@ -64,6 +73,10 @@ private:
     float _radius { DEFAULT_VIEW_RADIUS };
     float _farClip { DEFAULT_VIEW_FAR_CLIP };
 
+    // sent after the views by OctreeQuery, not by serialize(), which the avatar query shares
+    float _priorityWeight { DEFAULT_VIEW_PRIORITY_WEIGHT };
+    float _lodScale { DEFAULT_VIEW_LOD_SCALE };
+
     float _sinAngle { SQRT_TWO_OVER_TWO };
     float _cosAngle { SQRT_TWO_OVER_TWO };
 };
@@ -20,6 +20,7 @@
 #include <QtCore/QDir>
 #include <QtCore/QSaveFile>
 #include <QtCore/QStorageInfo>
+#include <QtCore/QThreadPool>
 
 #include "../PathUtils.h"
 #include "../NumericalConstants.h"
@@ -43,6 +44,23 @@ static const char EXT_SEP = '.';
 const size_t FileCache::DEFAULT_MAX_SIZE { GB_TO_BYTES(5) };
 const size_t FileCache::MAX_MAX_SIZE { GB_TO_BYTES(100) };
 const size_t FileCache::DEFAULT_MIN_FREE_STORAGE_SPACE { GB_TO_BYTES(1) };
+static const size_t DEFAULT_RESOURCE_BUDGET { GB_TO_BYTES(10) };
+
+const SharedBudgetPointer& cache::getResourceBudget() {
+    static const SharedBudgetPointer budget = std::make_shared<SharedBudget>(DEFAULT_RESOURCE_BUDGET);
+    return budget;
+}
+
+// The thread the ejected files of all the caches are deleted on, so the users of a cache don't wait on the disk
+static QThreadPool& getDeletionThread() {
+    static QThreadPool thread;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        thread.setMaxThreadCount(1);
+        thread.setExpiryTimeout(-1);
+    });
+    return thread;
+}
 
 
 std::string getCacheName(const std::string& dirname_str) {
@@ -84,6 +102,15 @@ FileCache::FileCache(const std::string& dirname, const std::string& ext, QObject
 
 FileCache::~FileCache() {
     clear();
+    if (_budget) {
+        _budget->totalSize -= _totalFilesSize;
+    }
+}
+
+void FileCache::setSharedBudget(const SharedBudgetPointer& budget) {
+    Lock lock(_mutex);
+    assert(!_initialized);
+    _budget = budget;
 }
 
 void FileCache::initialize() {
@@ -128,6 +155,9 @@ FilePointer FileCache::addFile(Metadata&& metadata, const std::string& filepath)
     if (file) {
         _numTotalFiles += 1;
         _totalFilesSize += file->getLength();
+        if (_budget) {
+            _budget->totalSize += file->getLength();
+        }
         file->_parent = shared_from_this();
         file->_locked = true;
         emit dirty();
@@ -145,26 +175,34 @@ FilePointer FileCache::writeFile(const char* data, File::Metadata&& metadata, bo
         return file;
     }
 
+    std::string filepath;
+    bool deletionPending;
+    {
+        Lock lock(_mutex);
 
-    Lock lock(_mutex);
-
-    if (!_initialized) {
-        qCWarning(file_cache) << "File cache used before initialization";
-        return file;
-    }
+        if (!_initialized) {
+            qCWarning(file_cache) << "File cache used before initialization";
+            return file;
+        }
 
-    std::string filepath = getFilepath(metadata.key);
+        filepath = getFilepath(metadata.key);
 
-    // if file already exists, return it
-    file = getFile(metadata.key);
-    if (file) {
-        if (!overwrite) {
-            qCWarning(file_cache, "[%s] Attempted to overwrite %s", _dirname.c_str(), metadata.key.c_str());
-            return file;
-        } else {
-            qCWarning(file_cache, "[%s] Overwriting %s", _dirname.c_str(), metadata.key.c_str());
-            file.reset();
+        // if file already exists, return it
+        file = getFile(metadata.key);
+        if (file) {
+            if (!overwrite) {
+                qCWarning(file_cache, "[%s] Attempted to overwrite %s", _dirname.c_str(), metadata.key.c_str());
+                return file;
+            } else {
+                qCWarning(file_cache, "[%s] Overwriting %s", _dirname.c_str(), metadata.key.c_str());
+                file.reset();
+            }
         }
+        deletionPending = _pendingDeletions.count(metadata.key) > 0;
+    }
+
+    if (deletionPending) {
+        cancelDeletion(metadata.key);
     }
 
     QSaveFile saveFile(QString::fromStdString(filepath));
@@ -172,7 +210,10 @@ FilePointer FileCache::writeFile(const char* data, File::Metadata&& metadata, bo
         && saveFile.write(data, metadata.length) == static_cast<qint64>(metadata.length)
         && saveFile.commit()) {
 
-        file = addFile(std::move(metadata), filepath);
+        Lock lock(_mutex);
+        // another thread may have written the same file while this one was
+        FilePointer existing = overwrite ? FilePointer() : findFile(metadata.key);
+        file = existing ? existing : addFile(std::move(metadata), filepath);
     } else {
         qCWarning(file_cache, "[%s] Failed to write %s", _dirname.c_str(), metadata.key.c_str());
     }
@@ -182,20 +223,32 @@ FilePointer FileCache::writeFile(const char* data, File::Metadata&& metadata, bo
 
 
 FilePointer FileCache::getFile(const Key& key) {
-    Lock lock(_mutex);
-
     FilePointer file;
-    if (!_initialized) {
-        qCWarning(file_cache) << "File cache used before initialization";
-        return file;
+    {
+        Lock lock(_mutex);
+        if (!_initialized) {
+            qCWarning(file_cache) << "File cache used before initialization";
+            return file;
+        }
+        file = findFile(key);
     }
 
+    // touched outside of the lock, the file is in use so it can't be ejected meanwhile
+    if (file) {
+        file->touch();
+    }
+    assert(!file || (file->_locked && file->_parent.lock()));
+    return file;
+}
+
+FilePointer FileCache::findFile(const Key& key) {
+    FilePointer file;
+
     // check if file exists
     const auto it = _files.find(key);
     if (it != _files.cend()) {
         file = it->second.lock();
         if (file) {
-            file->touch();
             // if it exists, it is active - remove it from the cache
             if (_unusedFiles.erase(file)) {
                 assert(!file->_locked);
@@ -212,8 +265,6 @@ FilePointer FileCache::getFile(const Key& key) {
             _files.erase(it);
         }
     }
-
-    assert(!file || (file->_locked && file->_parent.lock()));
     return file;
 }
 
@@ -238,7 +289,7 @@ void FileCache::addUnusedFile(const FilePointer& file) {
 size_t FileCache::getOverbudgetAmount() const {
     size_t result = 0;
 
-    size_t currentFreeSpace = QStorageInfo(_dirpath.c_str()).bytesFree();
+    size_t currentFreeSpace = QStorageInfo(_dirpath.c_str()).bytesFree() + _pendingDeletionsSize;
     if (_minFreeSpaceSize > currentFreeSpace) {
         result = _minFreeSpaceSize - currentFreeSpace;
     }
@@ -247,6 +298,14 @@ size_t FileCache::getOverbudgetAmount() const {
         result = std::max(_totalFilesSize - _maxSize, result);
     }
 
+    if (_budget) {
+        size_t totalSize = _budget->totalSize;
+        size_t maxSize = _budget->maxSize;
+        if (totalSize > maxSize) {
+            result = std::max(totalSize - maxSize, result);
+        }
+    }
+
     return result;
 }
 
@@ -267,11 +326,76 @@ void FileCache::eject(FilePointer file) {
     if (0 != _files.erase(key)) {
         _numTotalFiles -= 1;
         _totalFilesSize -= length;
+        if (_budget) {
+            _budget->totalSize -= length;
+        }
     }
     if (0 != _unusedFiles.erase(file)) {
         _numUnusedFiles -= 1;
         _unusedFilesSize -= length;
     }
+
+    // the file is deleted from disk by scheduleDeletions rather than by its destructor
+    file->_shouldPersist = true;
+    if (_pendingDeletions.emplace(key, length).second) {
+        _pendingDeletionsSize += length;
+        _ejectedFiles.push_back({ key, file->getFilepath(), length });
+    }
+}
+
+void FileCache::scheduleDeletions() {
+    if (_ejectedFiles.empty()) {
+        return;
+    }
+    Deletions deletions;
+    deletions.swap(_ejectedFiles);
+    FileCacheWeakPointer weakCache = shared_from_this();
+    getDeletionThread().start(QRunnable::create([weakCache, deletions] {
+        deleteFiles(weakCache, deletions);
+    }));
+}
+
+void FileCache::deleteFiles(const FileCacheWeakPointer& weakCache, const Deletions& deletions) {
+    for (const auto& deletion : deletions) {
+        FileCachePointer cache = weakCache.lock();
+        if (!cache) {
+            // the cache is shutting down, nothing can write the file again
+            QFile::remove(deletion.filepath.c_str());
+            continue;
+        }
+
+        std::lock_guard<std::mutex> deletionLock(cache->_deletionMutex);
+        {
+            Lock lock(cache->_mutex);
+            if (0 == cache->_pendingDeletions.erase(deletion.key)) {
+                // deleted by a write of the same file
+                continue;
+            }
+        }
+        QFile::remove(deletion.filepath.c_str());
+        cache->_pendingDeletionsSize -= deletion.length;
+        qCDebug(file_cache, "[%s] Unlinked %s", cache->_dirname.c_str(), deletion.filepath.c_str());
+    }
+}
+
+void FileCache::cancelDeletion(const Key& key) {
+    std::lock_guard<std::mutex> deletionLock(_deletionMutex);
+    size_t length;
+    {
+        Lock lock(_mutex);
+        auto it = _pendingDeletions.find(key);
+        if (it == _pendingDeletions.end()) {
+            return;
+        }
+        length = it->second;
+        _pendingDeletions.erase(it);
+    }
+    QFile::remove(getFilepath(key).c_str());
+    _pendingDeletionsSize -= length;
+}
+
+void FileCache::waitForDeletions() {
+    getDeletionThread().waitForDone();
 }
 
 void FileCache::clean() {
@@ -295,6 +419,7 @@ void FileCache::clean() {
         auto length = file->getLength();
         overbudgetAmount -= std::min(length, overbudgetAmount);
     }
+    scheduleDeletions();
 }
 
 void FileCache::wipe() {
@@ -302,6 +427,7 @@ void FileCache::wipe() {
     while (!_unusedFiles.empty()) {
         eject(*_unusedFiles.begin());
     }
+    scheduleDeletions();
 }
 
 void FileCache::clear() {
@@ -349,8 +475,11 @@ File::File(Metadata&& metadata, const std::string& filepath) :
 }
 
 File::~File() {
+    if (_shouldPersist) {
+        return;
+    }
     QFile file(getFilepath().c_str());
-    if (file.exists() && !_shouldPersist) {
+    if (file.exists()) {
         qCInfo(file_cache, "Unlinked %s", getFilepath().c_str());
         file.remove();
     }
@@ -18,6 +18,7 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <QObject>
 #include <QLoggingCategory>
@@ -34,6 +35,18 @@ class FileCache;
 using FileCachePointer = std::shared_ptr<FileCache>;
 using FileCacheWeakPointer = std::weak_ptr<FileCache>;
 
+// Disk space shared by several caches.  Each cache ejects its own least recently used files while the caches sharing
+// the budget are over it, so that together their files stay within one size limit
+struct SharedBudget {
+    SharedBudget(size_t maxSize) : maxSize(maxSize) {}
+    std::atomic<size_t> maxSize;
+    std::atomic<size_t> totalSize { 0 };
+};
+using SharedBudgetPointer = std::shared_ptr<SharedBudget>;
+
+// The budget shared by the caches of downloaded resources
+const SharedBudgetPointer& getResourceBudget();
+
 class FileCache : public QObject, public std::enable_shared_from_this<FileCache> {
     Q_OBJECT
     Q_PROPERTY(size_t numTotal READ getNumTotalFiles NOTIFY dirty)
@@ -64,6 +77,9 @@ public:
     // Set the maximum amount of disk space to use on disk
     void setMaxSize(size_t maxCacheSize);
 
+    // Count the files of this cache against a budget shared with other caches, must be called before initialize
+    void setSharedBudget(const SharedBudgetPointer& budget);
+
     // Set the minumum amount of free disk space to retain.  This supercedes the max size,
     // so if the cache is consuming all but 500 MB of the drive, unused entries will be ejected 
     // to free up more space, regardless of the cache max size
@@ -95,10 +111,14 @@ public:
     /// must be called after construction to create the cache on the fs and restore persisted files
     virtual void initialize();
 
-    // Add file to the cache and return the cache entry.  
+    // Add file to the cache and return the cache entry.  The data is written without holding the lock of the cache, so
+    // the other users of the cache aren't blocked on the disk
     FilePointer writeFile(const char* data, Metadata&& metadata, bool overwrite = false);
     FilePointer getFile(const Key& key);
 
+    // Ejected files are deleted from disk on a background thread, this waits until the pending deletions are done
+    static void waitForDeletions();
+
     /// create a file
     virtual std::unique_ptr<File> createFile(Metadata&& metadata, const std::string& filepath);
 
@@ -108,18 +128,33 @@ private:
     using Map = std::unordered_map<Key, std::weak_ptr<File>>;
     using Set = std::unordered_set<FilePointer>;
     using KeySet = std::unordered_set<Key>;
+    // The lengths of the ejected files waiting to be deleted
+    using DeletionMap = std::unordered_map<Key, size_t>;
 
     friend class File;
 
+    struct Deletion {
+        Key key;
+        std::string filepath;
+        size_t length;
+    };
+    using Deletions = std::vector<Deletion>;
+
     std::string getFilepath(const Key& key);
 
     FilePointer addFile(Metadata&& metadata, const std::string& filepath);
+    // Find a file and mark it in use, must be called with the lock held
+    FilePointer findFile(const Key& key);
     void addUnusedFile(const FilePointer& file);
     void releaseFile(File* file);
     void clean();
     void clear();
-    // Remove a file from the cache
+    // Remove a file from the cache, its deletion from disk is queued for scheduleDeletions
     void eject(FilePointer file);
+    void scheduleDeletions();
+    static void deleteFiles(const FileCacheWeakPointer& weakCache, const Deletions& deletions);
+    // Deletes the file of key now if its deletion is still pending, so that it can be written again
+    void cancelDeletion(const Key& key);
 
     size_t getOverbudgetAmount() const;
 
@@ -131,6 +166,9 @@ private:
     std::atomic<size_t> _numUnusedFiles { 0 };
     std::atomic<size_t> _totalFilesSize { 0 };
     std::atomic<size_t> _unusedFilesSize { 0 };
+    // The size of the ejected files still on disk, they count as free space
+    std::atomic<size_t> _pendingDeletionsSize { 0 };
+    SharedBudgetPointer _budget;
 
     const std::string _ext;
     const std::string _dirname;
@@ -140,6 +178,10 @@ private:
     Mutex _mutex;
     Map _files;
     Set _unusedFiles;
+    Deletions _ejectedFiles;
+    DeletionMap _pendingDeletions;
+    // Held while a pending deletion is claimed and carried out
+    std::mutex _deletionMutex;
 };
 
 class File {
@@ -170,7 +212,8 @@ private:
 
     void touch();
     FileCacheWeakPointer _parent;
-    int64_t _modified { 0 };
+    // Touched by the users of the file without the lock of the cache
+    std::atomic<int64_t> _modified { 0 };
     bool _locked { false };
 
     bool _shouldPersist { false };
@@ -256,6 +256,34 @@ signals:
     void dirtyEnabled();
 };
 
+/*@jsdoc
+ * Configures and reports on a task that runs its jobs in parallel.
+ * @typedef {object} Workload.ParallelConfig
+ * @property {number} childrenRunTime - <em>Read-only.</em> The summed CPU run time of the jobs, in ms.
+ * @property {number} parallelSpeedup - <em>Read-only.</em> The summed CPU run time of the jobs divided by the run
+ *     time of the task.
+ */
+class ParallelConfig : public JobConfig {
+    Q_OBJECT
+    Q_PROPERTY(double childrenRunTime READ getChildrenRunTime NOTIFY newStats()) //ms
+    Q_PROPERTY(double parallelSpeedup READ getParallelSpeedup NOTIFY newStats())
+
+public:
+    ParallelConfig() = default;
+    ParallelConfig(bool enabled) : JobConfig(enabled) {}
+
+    void setChildrenRunTime(const std::chrono::nanoseconds& childrenRunTime, const std::chrono::nanoseconds& runTime) {
+        _msChildrenRunTime = std::chrono::duration<double, std::milli>(childrenRunTime).count();
+        _parallelSpeedup = runTime.count() > 0 ? (double)childrenRunTime.count() / (double)runTime.count() : 1.0;
+    }
+    double getChildrenRunTime() const { return _msChildrenRunTime; }
+    double getParallelSpeedup() const { return _parallelSpeedup; }
+
+private:
+    double _msChildrenRunTime { 0.0 };
+    double _parallelSpeedup { 1.0 };
+};
+
 using QConfigPointer = std::shared_ptr<JobConfig>;
 
 }
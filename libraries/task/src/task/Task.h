@@ -18,6 +18,9 @@
 #include "Varying.h"
 
 #include <unordered_map>
+#include <vector>
+
+#include <tbb/parallel_for.h>
 
 namespace task {
 
@@ -213,11 +216,17 @@ public:
     }
 
     virtual void run(const ContextPointer& jobContext) {
+        setCPURunTime(measureRun(jobContext));
+    }
+
+    // Runs the job and returns its run time without reporting it, for callers running the job off their own thread
+    std::chrono::nanoseconds measureRun(const ContextPointer& jobContext) {
         TimeProfiler probe(getName());
         auto startTime = std::chrono::high_resolution_clock::now();
         _conceptPtr->run(jobContext);
-        _conceptPtr->setCPURunTime((std::chrono::high_resolution_clock::now() - startTime));
+        return std::chrono::high_resolution_clock::now() - startTime;
     }
+    void setCPURunTime(const std::chrono::nanoseconds& runtime) { _conceptPtr->setCPURunTime(runtime); }
 
 protected:
     ConceptPointer _conceptPtr;
@@ -347,6 +356,65 @@ public:
     template <class T, class O, class C = Config> using ModelO = TaskModel<T, C, None, O>;
     template <class T, class I, class O, class C = Config> using ModelIO = TaskModel<T, C, I, O>;
 
+    // A parallel task runs its jobs concurrently rather than in order, each with its own copy of the context.
+    // The jobs must be independent branches: none may take another's output as input, nor write anything shared
+    // through the context (the render args in particular), so they are typically CPU work such as culling.
+    // The run time of each job is still reported to its config, and the config of the task reports the speedup.
+    template <class T, class C = ParallelConfig, class I = None, class O = None> class ParallelTaskModel : public TaskModel<T, C, I, O> {
+    public:
+        using Base = TaskModel<T, C, I, O>;
+
+        ParallelTaskModel(const std::string& name, const Varying& input, QConfigPointer config) :
+            Base(name, input, config) {}
+
+        template <class... A>
+        static std::shared_ptr<ParallelTaskModel> create(const std::string& name, const Varying& input, A&&... args) {
+            auto model = std::make_shared<ParallelTaskModel>(name, input, std::make_shared<C>());
+
+            {
+                TimeProfiler probe("build::" + model->getName());
+                model->_data.build(*(model), model->_input, model->_output, std::forward<A>(args)...);
+            }
+
+            return model;
+        }
+
+        template <class... A>
+        static std::shared_ptr<ParallelTaskModel> create(const std::string& name, A&&... args) {
+            const auto input = Varying(I());
+            return create(name, input, std::forward<A>(args)...);
+        }
+
+        void run(const ContextPointer& jobContext) override {
+            auto config = std::static_pointer_cast<C>(Concept::_config);
+            if (!config->isEnabled()) {
+                return;
+            }
+
+            auto& jobs = TaskConcept::_jobs;
+            std::vector<std::chrono::nanoseconds> runTimes(jobs.size());
+            auto startTime = std::chrono::high_resolution_clock::now();
+            tbb::parallel_for((size_t)0, jobs.size(), [&](size_t i) {
+                // the job config and the task flow of the context are per job
+                auto branchContext = std::make_shared<Context>(*jobContext);
+                runTimes[i] = jobs[i].measureRun(branchContext);
+            });
+            auto runTime = std::chrono::high_resolution_clock::now() - startTime;
+
+            // the configs signal their new stats, so report from this thread
+            std::chrono::nanoseconds childrenRunTime(0);
+            for (size_t i = 0; i < jobs.size(); ++i) {
+                jobs[i].setCPURunTime(runTimes[i]);
+                childrenRunTime += runTimes[i];
+            }
+            config->setChildrenRunTime(childrenRunTime, runTime);
+        }
+    };
+    template <class T, class C = ParallelConfig> using ParallelModel = ParallelTaskModel<T, C, None, None>;
+    template <class T, class I, class C = ParallelConfig> using ParallelModelI = ParallelTaskModel<T, C, I, None>;
+    template <class T, class O, class C = ParallelConfig> using ParallelModelO = ParallelTaskModel<T, C, None, O>;
+    template <class T, class I, class O, class C = ParallelConfig> using ParallelModelIO = ParallelTaskModel<T, C, I, O>;
+
     // Create a new job in the Task's queue; returns the job's output
     template <class T, class... A> const Varying addJob(std::string name, const Varying& input, A&&... args) {
         return std::static_pointer_cast<TaskConcept>(JobType::_conceptPtr)->template addJob<T>(name, input, std::forward<A>(args)...);
@@ -535,6 +603,7 @@ protected:
     using JobConfig = task::JobConfig; \
     using TaskConfig = task::JobConfig; \
     using SwitchConfig = task::JobConfig; \
+    using ParallelConfig = task::ParallelConfig; \
     template <class T> using PersistentConfig = task::PersistentConfig<T>; \
     using Job = task::Job<ContextType, TimeProfiler>; \
     using Switch = task::Switch<ContextType, TimeProfiler>; \
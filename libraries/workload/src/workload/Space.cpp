@@ -15,11 +15,21 @@
 #include "Space.h"
 #include <cstring>
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
 
 #include <glm/gtx/quaternion.hpp>
 
+#include <TBBHelpers.h>
+
 using namespace workload;
 
+// the proxies are categorized in parallel over chunks of this many, and their changes concatenated in order
+static const uint32_t CATEGORIZE_CHUNK_SIZE = 4096;
+static const double NEEDS_CATEGORIZE = -1.0;
+// taken off the margins, for the rounding of the distances they're computed from
+static const float MARGIN_EPSILON = 0.001f;
+
 Space::Space() : Collection() {
 }
 
@@ -31,6 +41,7 @@ void Space::processTransactionFrame(const Transaction& transaction) {
     if (maxID > (Index) _proxies.size()) {
         _proxies.resize(maxID + 100); // allocate the maxId and more
         _owners.resize(maxID + 100);
+        _driftLimits.resize(maxID + 100, NEEDS_CATEGORIZE);
     }
     // Now we know for sure that we have enough items in the array to
     // capture anything coming from the transaction
@@ -54,6 +65,7 @@ void Space::processResets(const Transaction::Resets& transactions) {
         // Reset the item with a new payload
         item.sphere = (std::get<1>(reset));
         item.prevRegion = item.region = Region::UNKNOWN;
+        _driftLimits[proxyID] = NEEDS_CATEGORIZE;
 
         _owners[proxyID] = (std::get<2>(reset));
     }
@@ -87,36 +99,68 @@ void Space::processUpdates(const Transaction::Updates& transactions) {
 
         // Update the item
         item.sphere = (std::get<1>(update));
+        _driftLimits[updateID] = NEEDS_CATEGORIZE;
     }
 }
 
-void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
-    std::unique_lock<std::mutex> lock(_proxiesMutex);
-    uint32_t numProxies = (uint32_t)_proxies.size();
+void Space::categorizeProxies(uint32_t begin, uint32_t end, bool testAll, std::vector<Space::Change>& changes) {
     uint32_t numViews = (uint32_t)_views.size();
-    for (uint32_t i = 0; i < numProxies; ++i) {
+    for (uint32_t i = begin; i < end; ++i) {
         Proxy& proxy = _proxies[i];
-        if (proxy.region < Region::INVALID) {
-            glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
-            float proxyRadius = proxy.sphere.w;
-            uint8_t region = Region::R4;
-            for (uint32_t j = 0; j < numViews; ++j) {
-                auto& view = _views[j];
-                // for each 'view' we need only increment 'k' below the current value of 'region'
-                for (uint8_t k = 0; k < region; ++k) {
-                    float touchDistance = proxyRadius + view.regions[k].w;
-                    if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
-                        region = k;
-                        break;
-                    }
-                }
-            }
+        if (proxy.region >= Region::INVALID) {
+            continue;
+        }
+        if (!testAll && _viewDrift < _driftLimits[i]) {
+            // the views haven't moved enough to flip any of the tests below
             proxy.prevRegion = proxy.region;
-            proxy.region = region;
-            if (proxy.region != proxy.prevRegion) {
-                changes.emplace_back(Space::Change((int32_t)i, proxy.region, proxy.prevRegion));
+            continue;
+        }
+        glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
+        float proxyRadius = proxy.sphere.w;
+        uint8_t region = Region::R4;
+        float margin = FLT_MAX;
+        for (uint32_t j = 0; j < numViews; ++j) {
+            auto& view = _views[j];
+            // for each 'view' we need only increment 'k' below the current value of 'region'
+            for (uint8_t k = 0; k < region; ++k) {
+                float touchDistance = proxyRadius + view.regions[k].w;
+                float distance = glm::distance(proxyCenter, glm::vec3(view.regions[k]));
+                margin = std::min(margin, fabsf(distance - touchDistance));
+                if (distance < touchDistance) {
+                    region = k;
+                    break;
+                }
             }
         }
+        _driftLimits[i] = _viewDrift + (double)(margin - MARGIN_EPSILON);
+        proxy.prevRegion = proxy.region;
+        proxy.region = region;
+        if (proxy.region != proxy.prevRegion) {
+            changes.emplace_back(Space::Change((int32_t)i, proxy.region, proxy.prevRegion));
+        }
+    }
+}
+
+void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
+    std::unique_lock<std::mutex> lock(_proxiesMutex);
+    uint32_t numProxies = (uint32_t)_proxies.size();
+    bool testAll = _viewsChanged;
+    _viewsChanged = false;
+
+    uint32_t numChunks = (numProxies + CATEGORIZE_CHUNK_SIZE - 1) / CATEGORIZE_CHUNK_SIZE;
+    if (numChunks <= 1) {
+        categorizeProxies(0, numProxies, testAll, changes);
+        return;
+    }
+    _chunkChanges.resize(numChunks);
+    tbb::parallel_for((uint32_t)0, numChunks, [&](uint32_t chunk) {
+        uint32_t begin = chunk * CATEGORIZE_CHUNK_SIZE;
+        uint32_t end = std::min(begin + CATEGORIZE_CHUNK_SIZE, numProxies);
+        _chunkChanges[chunk].clear();
+        categorizeProxies(begin, end, testAll, _chunkChanges[chunk]);
+    });
+    for (const auto& chunkChanges : _chunkChanges) {
+        changes.insert(changes.end(), chunkChanges.begin(), chunkChanges.end());
     }
 }
 
@@ -163,10 +207,28 @@ void Space::clear() {
     _IDAllocator.clear();
     _proxies.clear();
     _owners.clear();
+    _driftLimits.clear();
+    _chunkChanges.clear();
     _views.clear();
+    _viewDrift = 0.0;
+    _viewsChanged = true;
 }
 
 void Space::setViews(const Views& views) {
+    if (views.size() != _views.size()) {
+        _viewsChanged = true;
+    } else {
+        // no distance from a proxy to a region sphere changes by more than the sphere moved and grew
+        float drift = 0.0f;
+        for (size_t j = 0; j < views.size(); ++j) {
+            for (uint32_t k = 0; k < Region::NUM_TRACKED_REGIONS; ++k) {
+                const Sphere& region = views[j].regions[k];
+                const Sphere& prevRegion = _views[j].regions[k];
+                drift = std::max(drift, glm::distance(glm::vec3(region), glm::vec3(prevRegion)) + fabsf(region.w - prevRegion.w));
+            }
+        }
+        _viewDrift += (double)drift;
+    }
     _views = views;
 }
 
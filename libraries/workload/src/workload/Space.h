@@ -60,12 +60,22 @@ private:
     void processRemoves(const Transaction::Removes& transactions);
     void processUpdates(const Transaction::Updates& transactions);
 
+    void categorizeProxies(uint32_t begin, uint32_t end, bool testAll, std::vector<Change>& changes);
+
     // The database of proxies is protected for editing by a mutex
     mutable std::mutex _proxiesMutex;
     Proxy::Vector _proxies;
     std::vector<Owner> _owners;
+    // The region of a proxy can't change until the views have drifted past the limit of the proxy, which is the drift
+    // when it was last categorized plus how far it was from flipping any of its region tests.  A negative limit means that
+    // the proxy must be categorized again.
+    std::vector<double> _driftLimits;
+    std::vector<std::vector<Change>> _chunkChanges;
 
     Views _views;
+    // How far the region spheres of the views have moved or grown, summed over the frames
+    double _viewDrift { 0.0 };
+    bool _viewsChanged { true };
 };
 
 using SpacePointer = std::shared_ptr<Space>;
@@ -123,6 +123,8 @@ void ControlViews::run(const workload::WorkloadContextPointer& runContext, const
         // inTimings[3] = postPhysics
         // inTimings[4] = non-physical kinematics
         // inTimings[5] = game loop
+        // inTimings[6] = physics budget, optional
+        // inTimings[7] = non-physical kinematics budget, optional
         _dataExport.timings[workload::Region::R1] = std::chrono::duration<float, std::milli>(inTimings[2] + inTimings[3]).count();
         _dataExport.timings[workload::Region::R2] = _dataExport.timings[workload::Region::R1];
         _dataExport.timings[workload::Region::R3] = std::chrono::duration<float, std::milli>(inTimings[4]).count();
@@ -180,6 +182,14 @@ void ControlViews::regulateViews(workload::Views& outViews, const workload::Timi
     // timings[3] = postPhysics
     // timings[4] = non-physical kinematics
     // timings[5] = game loop
+    // timings[6] = physics budget, optional
+    // timings[7] = non-physical kinematics budget, optional
+
+    if (timings.size() > 7) {
+        regionRegulators[workload::Region::R1].setBudget(timings[6]);
+        regionRegulators[workload::Region::R2].setBudget(timings[6]);
+        regionRegulators[workload::Region::R3].setBudget(timings[7]);
+    }
 
     auto loopDuration = timings[5];
     regionBackFronts[workload::Region::R1] = regionRegulators[workload::Region::R1].run(loopDuration, timings[2] + timings[3], regionBackFronts[workload::Region::R1]);
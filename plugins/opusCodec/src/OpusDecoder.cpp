@@ -63,69 +63,74 @@ AthenaOpusDecoder::~AthenaOpusDecoder() {
 
 }
 
+int AthenaOpusDecoder::getFrameSize() const {
+    return AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * static_cast<int>(sizeof(int16_t)) * _opusNumChannels;
+}
+
 void AthenaOpusDecoder::decode(const QByteArray &encodedBuffer, QByteArray &decodedBuffer) {
+    decodedBuffer.resize(getFrameSize());
+    decodeInto(encodedBuffer.constData(), encodedBuffer.length(), decodedBuffer.data(), decodedBuffer.size());
+}
+
+void AthenaOpusDecoder::lostFrame(QByteArray &decodedBuffer) {
+    decodedBuffer.resize(getFrameSize());
+    lostFrameInto(decodedBuffer.data(), decodedBuffer.size());
+}
+
+int AthenaOpusDecoder::decodeInto(const char* encodedData, int encodedSize, char* decodedData, int maxDecodedSize) {
     assert(_decoder);
     PerformanceTimer perfTimer("AthenaOpusDecoder::decode");
 
-    // The audio system encodes and decodes always in fixed size chunks
-    int bufferSize = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * static_cast<int>(sizeof(int16_t))
-        * _opusNumChannels;
-
-    decodedBuffer.resize(bufferSize);
-    int bufferFrames = decodedBuffer.size() / _opusNumChannels / static_cast<int>(sizeof(opus_int16));
-    int decoded_frames = opus_decode(_decoder, reinterpret_cast<const unsigned char*>(encodedBuffer.data()),
-        encodedBuffer.length(), reinterpret_cast<opus_int16*>(decodedBuffer.data()), bufferFrames, 0);
-
-    if (decoded_frames >= 0) {
-
-        if (decoded_frames < bufferFrames) {
-            qCWarning(decoder) << "Opus decoder returned " << decoded_frames << ", but " << bufferFrames
-                << " were expected!";
-
-            int start = decoded_frames * static_cast<int>(sizeof(int16_t)) * _opusNumChannels;
-            memset( &decodedBuffer.data()[start], 0, static_cast<size_t>(decodedBuffer.length() - start));
-        } else if (decoded_frames > bufferFrames) {
-            // This should never happen
-            qCCritical(decoder) << "Opus decoder returned " << decoded_frames << ", but only " << bufferFrames
-                << " were expected! Buffer overflow!?";
-        }
-    } else {
-        qCCritical(decoder) << "Failed to decode audio: " << error_to_string(decoded_frames);
-        decodedBuffer.fill('\0');
+    int bufferSize = getFrameSize();
+    if (maxDecodedSize < bufferSize) {
+        return -1;
     }
 
+    int bufferFrames = bufferSize / _opusNumChannels / static_cast<int>(sizeof(opus_int16));
+    int decoded_frames = opus_decode(_decoder, reinterpret_cast<const unsigned char*>(encodedData),
+        encodedSize, reinterpret_cast<opus_int16*>(decodedData), bufferFrames, 0);
+
+    if (decoded_frames < 0) {
+        qCCritical(decoder) << "Failed to decode audio: " << error_to_string(decoded_frames);
+        memset(decodedData, 0, static_cast<size_t>(bufferSize));
+        return bufferSize;
+    }
+    return checkDecodedFrames(decoded_frames, decodedData, bufferFrames);
 }
 
-void AthenaOpusDecoder::lostFrame(QByteArray &decodedBuffer) {
+int AthenaOpusDecoder::lostFrameInto(char* decodedData, int maxDecodedSize) {
     assert(_decoder);
-
     PerformanceTimer perfTimer("AthenaOpusDecoder::lostFrame");
 
-    int bufferSize = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * static_cast<int>(sizeof(int16_t))
-        * _opusNumChannels;
-    decodedBuffer.resize(bufferSize);
-    int bufferFrames = decodedBuffer.size() / _opusNumChannels / static_cast<int>(sizeof(opus_int16));
+    int bufferSize = getFrameSize();
+    if (maxDecodedSize < bufferSize) {
+        return -1;
+    }
 
-    int decoded_frames = opus_decode(_decoder, nullptr, 0, reinterpret_cast<opus_int16*>(decodedBuffer.data()),
-        bufferFrames, 1);
+    int bufferFrames = bufferSize / _opusNumChannels / static_cast<int>(sizeof(opus_int16));
+    int decoded_frames = opus_decode(_decoder, nullptr, 0, reinterpret_cast<opus_int16*>(decodedData), bufferFrames, 1);
 
-    if (decoded_frames >= 0) {
+    if (decoded_frames < 0) {
+        qCCritical(decoder) << "Failed to decode lost frame: " << error_to_string(decoded_frames);
+        memset(decodedData, 0, static_cast<size_t>(bufferSize));
+        return bufferSize;
+    }
+    return checkDecodedFrames(decoded_frames, decodedData, bufferFrames);
+}
 
-        if ( decoded_frames < bufferFrames ) {
-            qCWarning(decoder) << "Opus decoder returned " << decoded_frames << ", but " << bufferFrames
-                << " were expected!";
+int AthenaOpusDecoder::checkDecodedFrames(int decodedFrames, char* decodedData, int bufferFrames) {
+    int bufferSize = bufferFrames * static_cast<int>(sizeof(int16_t)) * _opusNumChannels;
 
-            int start = decoded_frames * static_cast<int>(sizeof(int16_t)) * _opusNumChannels;
-            memset( &decodedBuffer.data()[start], 0, static_cast<size_t>(decodedBuffer.length() - start));
-        } else if (decoded_frames > bufferFrames) {
-            // This should never happen
-            qCCritical(decoder) << "Opus decoder returned " << decoded_frames << ", but only " << bufferFrames
-                << " were expected! Buffer overflow!?";
-        }
+    if (decodedFrames < bufferFrames) {
+        qCWarning(decoder) << "Opus decoder returned " << decodedFrames << ", but " << bufferFrames
+            << " were expected!";
 
-    } else {
-        qCCritical(decoder) << "Failed to decode lost frame: " << error_to_string(decoded_frames);
-        decodedBuffer.fill('\0');
+        int start = decodedFrames * static_cast<int>(sizeof(int16_t)) * _opusNumChannels;
+        memset(&decodedData[start], 0, static_cast<size_t>(bufferSize - start));
+    } else if (decodedFrames > bufferFrames) {
+        // This should never happen
+        qCCritical(decoder) << "Opus decoder returned " << decodedFrames << ", but only " << bufferFrames
+            << " were expected! Buffer overflow!?";
     }
-
+    return bufferSize;
 }
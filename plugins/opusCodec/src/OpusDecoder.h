@@ -25,8 +25,15 @@ public:
     virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override;
     virtual void lostFrame(QByteArray &decodedBuffer) override;
 
+    virtual int decodeInto(const char* encodedData, int encodedSize, char* decodedData, int maxDecodedSize) override;
+    virtual int lostFrameInto(char* decodedData, int maxDecodedSize) override;
+
 
 private:
+    // the audio system encodes and decodes always in fixed size chunks
+    int getFrameSize() const;
+    int checkDecodedFrames(int decodedFrames, char* decodedData, int bufferFrames);
+
     int _encodedSize;
 
     OpusDecoder* _decoder = nullptr;
@@ -21,13 +21,14 @@ public:
     ~AthenaOpusEncoder() override;
 
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) override;
+    virtual int encodeInto(const char* decodedData, int decodedSize, char* encodedData, int maxEncodedSize) override;
 
 
     int getComplexity() const;
-    void setComplexity(int complexity);
+    void setComplexity(int complexity) override;
 
     int getBitrate() const;
-    void setBitrate(int bitrate);
+    void setBitrate(int bitrate) override;
 
     int getVBR() const;
     void setVBR(int vbr);
@@ -49,7 +49,29 @@ public:
         memset(decodedBuffer.data(), 0, decodedBuffer.size());
     }
 
+    virtual int encodeInto(const char* decodedData, int decodedSize, char* encodedData, int maxEncodedSize) override {
+        return copyFrame(decodedData, decodedSize, encodedData, maxEncodedSize);
+    }
+
+    virtual int decodeInto(const char* encodedData, int encodedSize, char* decodedData, int maxDecodedSize) override {
+        return copyFrame(encodedData, encodedSize, decodedData, maxDecodedSize);
+    }
+
+    // the caller's buffer is sized for one frame of its stream
+    virtual int lostFrameInto(char* decodedData, int maxDecodedSize) override {
+        memset(decodedData, 0, maxDecodedSize);
+        return maxDecodedSize;
+    }
+
 private:
+    static int copyFrame(const char* data, int size, char* destination, int maxSize) {
+        if (size > maxSize) {
+            return -1;
+        }
+        memcpy(destination, data, size);
+        return size;
+    }
+
     static const char* NAME;
 };
 
@@ -0,0 +1,157 @@
+//
+//  AnimClipDataTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AnimClipDataTests.h"
+
+#include <random>
+
+#include <AnimClipData.h>
+#include <AnimSkeleton.h>
+#include <AnimUtil.h>
+#include <GLMHelpers.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(AnimClipDataTests)
+
+// about an avatar skeleton, with a few hundred frames of a clip animating its body but not its fingers
+static const int NUM_JOINTS = 100;
+static const int NUM_ANIMATED_JOINTS = 40;
+static const int NUM_FRAMES = 300;
+static const float EPSILON = 0.0001f;
+// of the rotations, quantized to 16 bits per component
+static const float ROTATION_EPSILON = 0.001f;
+
+static std::shared_ptr<AnimSkeleton> skeleton;
+static std::vector<AnimPoseVec> frames;
+
+static glm::quat randomRotation(std::mt19937& generator) {
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    return glm::normalize(glm::quat(distribution(generator), distribution(generator), distribution(generator), distribution(generator)));
+}
+
+static glm::vec3 randomVector(std::mt19937& generator) {
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    return glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+}
+
+static void compareRotations(const glm::quat& actual, const glm::quat& expected) {
+    // a rotation and its opposite are the same
+    QVERIFY(glm::abs(glm::dot(actual, expected)) > 1.0f - ROTATION_EPSILON);
+}
+
+void AnimClipDataTests::initTestCase() {
+    std::mt19937 generator(11);
+
+    std::vector<HFMJoint> joints;
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        HFMJoint joint;
+        joint.parentIndex = i - 1;
+        joint.translation = randomVector(generator);
+        joint.rotation = randomRotation(generator);
+        joint.name = QString("%1Joint%2").arg(i % 2 ? "Left" : "Right").arg(i / 2);
+        joints.push_back(joint);
+    }
+    skeleton = std::make_shared<AnimSkeleton>(joints, QMap<int, glm::quat>());
+
+    const AnimPoseVec& defaultPoses = skeleton->getRelativeDefaultPoses();
+    frames.resize(NUM_FRAMES, defaultPoses);
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        for (int i = 0; i < NUM_ANIMATED_JOINTS; i++) {
+            frames[frame][i].rot() = randomRotation(generator);
+        }
+        // the hips move
+        frames[frame][0].trans() = randomVector(generator);
+    }
+}
+
+void AnimClipDataTests::testSample() {
+    AnimClipData clipData(frames);
+    QCOMPARE(clipData.getNumFrames(), NUM_FRAMES);
+    QCOMPARE(clipData.getNumJoints(), NUM_JOINTS);
+
+    const float ALPHAS[] = { 0.0f, 0.25f, 0.5f, 1.0f };
+    AnimPoseVec expected(NUM_JOINTS);
+    AnimPoseVec poses(NUM_JOINTS);
+    for (int frame = 0; frame < NUM_FRAMES - 1; frame += 7) {
+        for (float alpha : ALPHAS) {
+            ::blend(NUM_JOINTS, frames[frame].data(), frames[frame + 1].data(), alpha, expected.data());
+            clipData.sample(frame, frame + 1, alpha, poses.data());
+            for (int i = 0; i < NUM_JOINTS; i++) {
+                compareRotations(poses[i].rot(), expected[i].rot());
+                QCOMPARE_WITH_ABS_ERROR(poses[i].trans(), expected[i].trans(), EPSILON);
+                QCOMPARE_WITH_ABS_ERROR(poses[i].scale(), expected[i].scale(), EPSILON);
+            }
+        }
+    }
+}
+
+void AnimClipDataTests::testConstantJoints() {
+    AnimClipData clipData(frames);
+
+    // the joints that don't move keep their default pose exactly
+    AnimPoseVec poses;
+    clipData.decodeFrame(NUM_FRAMES / 2, poses);
+    const AnimPoseVec& defaultPoses = skeleton->getRelativeDefaultPoses();
+    for (int i = NUM_ANIMATED_JOINTS; i < NUM_JOINTS; i++) {
+        QCOMPARE(poses[i].rot(), defaultPoses[i].rot());
+        QCOMPARE(poses[i].trans(), defaultPoses[i].trans());
+    }
+    QCOMPARE(poses[1].trans(), defaultPoses[1].trans());
+}
+
+void AnimClipDataTests::testMirror() {
+    AnimClipData clipData(frames);
+    auto mirror = clipData.getMirror(*skeleton);
+    QVERIFY(mirror);
+    // built only once
+    QVERIFY(clipData.getMirror(*skeleton) == mirror);
+    QCOMPARE(mirror->getNumFrames(), NUM_FRAMES);
+
+    AnimPoseVec poses;
+    for (int frame = 0; frame < NUM_FRAMES; frame += 13) {
+        AnimPoseVec expected = frames[frame];
+        skeleton->mirrorRelativePoses(expected);
+        mirror->decodeFrame(frame, poses);
+        for (int i = 0; i < NUM_JOINTS; i++) {
+            compareRotations(poses[i].rot(), expected[i].rot());
+            QCOMPARE_WITH_ABS_ERROR(poses[i].trans(), expected[i].trans(), EPSILON);
+        }
+    }
+}
+
+void AnimClipDataTests::testMemorySize() {
+    AnimClipData clipData(frames);
+    size_t uncompressedSize = NUM_FRAMES * NUM_JOINTS * sizeof(AnimPose);
+    qDebug() << "uncompressed" << uncompressedSize << "bytes, compressed" << clipData.getMemorySize() << "bytes";
+    QVERIFY(clipData.getMemorySize() * 10 < uncompressedSize);
+}
+
+// as AnimClip did with its uncompressed frames
+void AnimClipDataTests::benchmarkBlend() {
+    AnimPoseVec poses(NUM_JOINTS);
+    int frame = 0;
+    QBENCHMARK {
+        ::blend(NUM_JOINTS, frames[frame].data(), frames[frame + 1].data(), 0.5f, poses.data());
+        frame = (frame + 1) % (NUM_FRAMES - 1);
+    }
+}
+
+void AnimClipDataTests::benchmarkSample() {
+    AnimClipData clipData(frames);
+    AnimPoseVec poses(NUM_JOINTS);
+    int frame = 0;
+    QBENCHMARK {
+        clipData.sample(frame, frame + 1, 0.5f, poses.data());
+        frame = (frame + 1) % (NUM_FRAMES - 1);
+    }
+}
@@ -0,0 +1,29 @@
+//
+//  AnimClipDataTests.h
+//  tests/animation/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_AnimClipDataTests_h
+#define overte_AnimClipDataTests_h
+
+#include <QtTest/QtTest>
+
+class AnimClipDataTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void testSample();
+    void testConstantJoints();
+    void testMirror();
+    void testMemorySize();
+    void benchmarkBlend();
+    void benchmarkSample();
+};
+
+#endif // overte_AnimClipDataTests_h
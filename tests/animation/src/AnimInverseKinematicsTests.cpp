@@ -90,6 +90,53 @@ void makeTestFBXJoints(HFMModel& hfmModel) {
     }
 }
 
+// we make a pair of arms that look like this, with the elbows slightly bent:
+//
+//                 Spine
+// RightHand<--<---O--->-->LeftHand
+//                 |
+//                 O Hips
+void makeArmsFBXJoints(HFMModel& hfmModel) {
+    HFMJoint joint;
+    joint.preTransform = glm::mat4();
+    joint.preRotation = identity;
+    joint.rotation = identity;
+    joint.postRotation = identity;
+    joint.postTransform = glm::mat4();
+    joint.transform = glm::mat4();
+    joint.rotationMin = glm::vec3(-PI);
+    joint.rotationMax = glm::vec3(PI);
+    joint.inverseDefaultRotation = identity;
+    joint.inverseBindRotation = identity;
+    joint.bindTransform = glm::mat4();
+    joint.isSkeletonJoint = false;
+
+    const glm::vec3 ELBOW_BEND = 0.1f * zAxis;
+    struct { const char* name; int parentIndex; glm::vec3 translation; } joints[] = {
+        { "Hips", -1, origin },
+        { "Spine", 0, yAxis },
+        { "LeftArm", 1, xAxis },
+        { "LeftForeArm", 2, xAxis + ELBOW_BEND },
+        { "LeftHand", 3, xAxis - ELBOW_BEND },
+        { "RightArm", 1, -xAxis },
+        { "RightForeArm", 5, -xAxis + ELBOW_BEND },
+        { "RightHand", 6, -xAxis - ELBOW_BEND }
+    };
+    for (const auto& entry : joints) {
+        joint.name = entry.name;
+        joint.parentIndex = entry.parentIndex;
+        joint.translation = entry.translation;
+        joint.distanceToParent = glm::length(entry.translation);
+        hfmModel.joints.push_back(joint);
+    }
+
+    for (int i = 1; i < (int)hfmModel.joints.size(); ++i) {
+        HFMJoint& j = hfmModel.joints[i];
+        j.transform = hfmModel.joints[j.parentIndex].transform * glm::translate(j.translation);
+        j.bindTransform = j.transform;
+    }
+}
+
 void AnimInverseKinematicsTests::testSingleChain() {
 
     AnimContext context(false, false, false, glm::mat4(), glm::mat4(), 0);
@@ -303,3 +350,55 @@ void AnimInverseKinematicsTests::testBar() {
     QCOMPARE_WITH_ABS_ERROR(expectedTransC, poseC.trans(), EPSILON);
 }
 
+void AnimInverseKinematicsTests::benchmarkSolve() {
+    AnimContext context(false, false, false, glm::mat4(), glm::mat4(), 0);
+
+    HFMModel hfmModel;
+    makeArmsFBXJoints(hfmModel);
+    AnimSkeleton::Pointer skeletonPtr = std::make_shared<AnimSkeleton>(hfmModel);
+    AnimInverseKinematics ikDoll("doll");
+    ikDoll.setSkeleton(skeletonPtr);
+
+    AnimPoseVec poses = skeletonPtr->getRelativeDefaultPoses();
+    ikDoll.loadPoses(poses);
+
+    std::vector<float> flexCoefficients = { 1.0f, 1.0f, 1.0f, 1.0f };
+    for (const QString& side : { QString("Left"), QString("Right") }) {
+        QString suffix = side + "Hand";
+        ikDoll.setTargetVars(suffix, "position" + suffix, "rotation" + suffix, "targetType" + suffix, "weight" + suffix, 1.0f,
+                             flexCoefficients, "poleVectorEnabled" + suffix, "poleReferenceVector" + suffix, "poleVector" + suffix);
+    }
+
+    // the hands follow circles within their reach, as tracked controllers would
+    AnimVariantMap varMap;
+    AnimVariantMap triggers;
+    varMap.set("targetTypeLeftHand", (int)IKTarget::Type::RotationAndPosition);
+    varMap.set("targetTypeRightHand", (int)IKTarget::Type::RotationAndPosition);
+    varMap.set("poleVectorEnabledLeftHand", false);
+    varMap.set("poleVectorEnabledRightHand", false);
+    const float dt = 1.0f / 90.0f;
+    const float CIRCLE_RADIUS = 0.3f;
+    float angle = 0.0f;
+    auto setTargets = [&] {
+        glm::vec3 offset = CIRCLE_RADIUS * (cosf(angle) * yAxis + sinf(angle) * zAxis);
+        varMap.set("positionLeftHand", yAxis + 1.5f * xAxis + offset);
+        varMap.set("rotationLeftHand", identity);
+        varMap.set("positionRightHand", yAxis - 1.5f * xAxis + offset);
+        varMap.set("rotationRightHand", identity);
+        angle += dt;
+    };
+
+    // none of the targets is out of reach, the solve gets close to them
+    const int NUM_FRAMES = 30;
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        setTargets();
+        poses = ikDoll.overlay(varMap, context, dt, triggers, poses);
+    }
+    const float acceptableDistance = 0.1f;
+    QVERIFY(ikDoll.getMaxErrorOnLastSolve() < acceptableDistance);
+
+    QBENCHMARK {
+        setTargets();
+        poses = ikDoll.overlay(varMap, context, dt, triggers, poses);
+    }
+}
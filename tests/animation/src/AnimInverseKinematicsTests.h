@@ -22,6 +22,7 @@ class AnimInverseKinematicsTests : public QObject {
 private slots:
     void testSingleChain();
     void testBar();
+    void benchmarkSolve();
 };
 
 #endif // hifi_AnimInverseKinematicsTests_h
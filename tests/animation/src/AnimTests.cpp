@@ -271,6 +271,48 @@ void AnimTests::testVariant() {
     QVERIFY(q.z == 4.0f);
 }
 
+void AnimTests::testVariantMap() {
+    AnimVarKey emptyKey;
+    AnimVarKey fooKey("testVariantMapFoo");
+    QVERIFY(emptyKey.isEmpty());
+    QVERIFY(!fooKey.isEmpty());
+    QVERIFY(fooKey == AnimVarKey(QString("testVariantMapFoo")));
+    QVERIFY(fooKey != AnimVarKey("testVariantMapBar"));
+    QVERIFY(fooKey.getName() == "testVariantMapFoo");
+
+    AnimVariantMap vars;
+    QVERIFY(vars.size() == 0);
+    QVERIFY(!vars.hasKey(fooKey));
+    QVERIFY(vars.lookup(fooKey, 2.0f) == 2.0f);
+
+    vars.set(fooKey, 1.0f);
+    vars.set("testVariantMapBar", 3);
+    QVERIFY(vars.size() == 2);
+    QVERIFY(vars.hasKey("testVariantMapFoo"));
+    QVERIFY(vars.lookup(fooKey, 2.0f) == 1.0f);
+    QVERIFY(vars.lookup("testVariantMapBar", 0) == 3);
+
+    vars.set(fooKey, 4.0f);
+    QVERIFY(vars.size() == 2);
+    QVERIFY(vars.lookup(fooKey, 2.0f) == 4.0f);
+
+    AnimVariantMap other;
+    other.set("testVariantMapBaz", true);
+    other.set(fooKey, 5.0f);
+    vars.copyVariantsFrom(other);
+    QVERIFY(vars.size() == 3);
+    QVERIFY(vars.lookup(fooKey, 2.0f) == 5.0f);
+    QVERIFY(vars.lookup("testVariantMapBaz", false) == true);
+
+    vars.unset(fooKey);
+    QVERIFY(vars.size() == 2);
+    QVERIFY(!vars.hasKey(fooKey));
+
+    vars.clearMap();
+    QVERIFY(vars.size() == 0);
+    QVERIFY(!vars.hasKey("testVariantMapBar"));
+}
+
 void AnimTests::testAccumulateTime() {
 
     float startFrame = 0.0f;
@@ -0,0 +1,146 @@
+//
+//  ClusterMatricesTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ClusterMatricesTests.h"
+
+#include <random>
+
+#include <glm/gtx/transform.hpp>
+
+#include <AnimSkeleton.h>
+#include <GLMHelpers.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(ClusterMatricesTests)
+
+// about the skeleton of an avatar, with a full body mesh
+static const int NUM_JOINTS = 100;
+static const int NUM_CLUSTERS = 250;
+static const float EPSILON = 0.0001f;
+
+static std::shared_ptr<AnimSkeleton> skeleton;
+static AnimPoseVec jointPoses;
+
+static glm::quat randomRotation(std::mt19937& generator) {
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    return glm::normalize(glm::quat(distribution(generator), distribution(generator), distribution(generator), distribution(generator)));
+}
+
+static glm::vec3 randomVector(std::mt19937& generator) {
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    return glm::vec3(distribution(generator), distribution(generator), distribution(generator));
+}
+
+void ClusterMatricesTests::initTestCase() {
+    std::mt19937 generator(7);
+
+    HFMModel hfmModel;
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        HFMJoint joint;
+        joint.parentIndex = i - 1;
+        joint.translation = randomVector(generator);
+        joint.rotation = randomRotation(generator);
+        joint.name = QString("joint%1").arg(i);
+        hfmModel.joints.push_back(joint);
+    }
+    HFMMesh mesh;
+    for (int i = 0; i < NUM_CLUSTERS; i++) {
+        HFMCluster cluster;
+        cluster.jointIndex = i % NUM_JOINTS;
+        cluster.inverseBindMatrix = createMatFromScaleQuatAndPos(glm::vec3(0.01f), randomRotation(generator), randomVector(generator));
+        cluster.inverseBindTransform.evalFromRawMatrix(cluster.inverseBindMatrix);
+        mesh.clusters.push_back(cluster);
+    }
+    hfmModel.meshes.push_back(mesh);
+    skeleton = std::make_shared<AnimSkeleton>(hfmModel);
+
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        jointPoses.push_back(AnimPose(glm::vec3(1.5f), randomRotation(generator), randomVector(generator)));
+    }
+    // a joint with a non-uniform scale, which takes the slow path
+    jointPoses[1].scale() = glm::vec3(1.0f, 2.0f, 3.0f);
+}
+
+void ClusterMatricesTests::testClusterMatrices() {
+    std::vector<glm::mat4> jointMatrices(NUM_JOINTS);
+    AnimSkeleton::computePoseMatrices(NUM_JOINTS, jointPoses.data(), jointMatrices.data());
+    std::vector<glm::mat4> clusterMatrices(NUM_CLUSTERS);
+    skeleton->computeClusterMatrices(0, NUM_JOINTS, jointMatrices.data(), clusterMatrices.data());
+
+    for (int i = 0; i < NUM_CLUSTERS; i++) {
+        const HFMCluster& cluster = skeleton->getClusterBindMatricesOriginalValues(0, i);
+        glm::mat4 expected;
+        glm_mat4u_mul((glm::mat4)jointPoses[cluster.jointIndex], cluster.inverseBindMatrix, expected);
+        QCOMPARE_WITH_ABS_ERROR(clusterMatrices[i], expected, EPSILON);
+    }
+
+    // the clusters of joints the rig doesn't have take the identity, as Rig::getJointTransform
+    skeleton->computeClusterMatrices(0, 1, jointMatrices.data(), clusterMatrices.data());
+    QCOMPARE_WITH_ABS_ERROR(clusterMatrices[2], skeleton->getClusterBindMatricesOriginalValues(0, 2).inverseBindMatrix, EPSILON);
+}
+
+void ClusterMatricesTests::testClusterPoses() {
+    AnimPoseVec clusterPoses(NUM_CLUSTERS);
+    skeleton->computeClusterPoses(0, NUM_JOINTS, jointPoses.data(), clusterPoses.data());
+
+    for (int i = 0; i < NUM_CLUSTERS; i++) {
+        const HFMCluster& cluster = skeleton->getClusterBindMatricesOriginalValues(0, i);
+        const AnimPose& jointPose = jointPoses[cluster.jointIndex];
+        Transform jointTransform(jointPose.rot(), jointPose.scale(), jointPose.trans());
+        Transform expected;
+        Transform::mult(expected, jointTransform, cluster.inverseBindTransform);
+        QCOMPARE_WITH_ABS_ERROR(clusterPoses[i].scale(), expected.getScale(), EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(clusterPoses[i].rot(), expected.getRotation(), EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(clusterPoses[i].trans(), expected.getTranslation(), EPSILON);
+    }
+}
+
+// as Model::updateClusterMatrices did, a joint matrix and a copy of the cluster for each cluster
+void ClusterMatricesTests::benchmarkClusterMatricesPerCluster() {
+    std::vector<glm::mat4> clusterMatrices(NUM_CLUSTERS);
+    QBENCHMARK {
+        for (int i = 0; i < NUM_CLUSTERS; i++) {
+            const HFMCluster cluster = skeleton->getClusterBindMatricesOriginalValues(0, i);
+            glm::mat4 jointMatrix = jointPoses[cluster.jointIndex];
+            glm_mat4u_mul(jointMatrix, cluster.inverseBindMatrix, clusterMatrices[i]);
+        }
+    }
+}
+
+void ClusterMatricesTests::benchmarkClusterMatrices() {
+    std::vector<glm::mat4> jointMatrices(NUM_JOINTS);
+    std::vector<glm::mat4> clusterMatrices(NUM_CLUSTERS);
+    QBENCHMARK {
+        AnimSkeleton::computePoseMatrices(NUM_JOINTS, jointPoses.data(), jointMatrices.data());
+        skeleton->computeClusterMatrices(0, NUM_JOINTS, jointMatrices.data(), clusterMatrices.data());
+    }
+}
+
+void ClusterMatricesTests::benchmarkClusterPosesPerCluster() {
+    std::vector<Transform> clusterTransforms(NUM_CLUSTERS);
+    QBENCHMARK {
+        for (int i = 0; i < NUM_CLUSTERS; i++) {
+            const HFMCluster cluster = skeleton->getClusterBindMatricesOriginalValues(0, i);
+            const AnimPose& jointPose = jointPoses[cluster.jointIndex];
+            Transform jointTransform(jointPose.rot(), jointPose.scale(), jointPose.trans());
+            Transform::mult(clusterTransforms[i], jointTransform, cluster.inverseBindTransform);
+        }
+    }
+}
+
+void ClusterMatricesTests::benchmarkClusterPoses() {
+    AnimPoseVec clusterPoses(NUM_CLUSTERS);
+    QBENCHMARK {
+        skeleton->computeClusterPoses(0, NUM_JOINTS, jointPoses.data(), clusterPoses.data());
+    }
+}
@@ -0,0 +1,29 @@
+//
+//  ClusterMatricesTests.h
+//  tests/animation/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ClusterMatricesTests_h
+#define overte_ClusterMatricesTests_h
+
+#include <QtTest/QtTest>
+
+class ClusterMatricesTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void testClusterMatrices();
+    void testClusterPoses();
+    void benchmarkClusterMatricesPerCluster();
+    void benchmarkClusterMatrices();
+    void benchmarkClusterPosesPerCluster();
+    void benchmarkClusterPoses();
+};
+
+#endif // overte_ClusterMatricesTests_h
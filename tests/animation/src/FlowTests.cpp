@@ -0,0 +1,101 @@
+//
+//  FlowTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "FlowTests.h"
+
+#include <Flow.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(FlowTests)
+
+static const float EPSILON = 0.0001f;
+static const int NUM_THREAD_JOINTS = 20;
+static const float JOINT_LENGTH = 0.02f;
+static const float THREAD_RADIUS = 0.01f;
+
+// a thread hanging down from the origin
+static void buildThread(std::map<int, FlowJoint>& joints, FlowThread& thread) {
+    for (int i = 1; i <= NUM_THREAD_JOINTS; i++) {
+        FlowJoint joint(i, i - 1, i < NUM_THREAD_JOINTS ? i + 1 : -1, QString("flow_hair_%1").arg(i), "hair", FlowPhysicsSettings());
+        glm::vec3 position(0.0f, -JOINT_LENGTH * (i - 1), 0.0f);
+        joint.setInitialData(position, glm::vec3(0.0f, -JOINT_LENGTH, 0.0f), glm::quat(), position + glm::vec3(0.0f, JOINT_LENGTH, 0.0f));
+        joints.insert(std::pair<int, FlowJoint>(i, joint));
+    }
+    thread = FlowThread(1, &joints, 1.0f);
+    for (int i = 0; i < NUM_THREAD_JOINTS; i++) {
+        thread._positions.push_back(joints.at(i + 1).getCurrentPosition());
+    }
+    thread._radius = THREAD_RADIUS;
+}
+
+void FlowTests::testThreadCollisions() {
+    std::map<int, FlowJoint> joints;
+    FlowThread thread;
+    buildThread(joints, thread);
+    QCOMPARE((int)thread._joints.size(), NUM_THREAD_JOINTS);
+
+    const glm::vec3 tip = thread._positions.back();
+    FlowCollisionSettings settings(QUuid(), FlowCollisionType::CollisionSphere, glm::vec3(0.0f), 0.02f);
+    FlowCollisionSystem collisionSystem;
+    collisionSystem.addCollisionSphere(10, settings, tip + glm::vec3(0.01f, 0.0f, 0.0f));
+    collisionSystem.addCollisionSphere(11, settings, tip + glm::vec3(-0.005f, 0.005f, 0.0f));
+    // too far from the thread to touch it
+    collisionSystem.addCollisionSphere(12, settings, glm::vec3(10.0f, 0.0f, 0.0f));
+    collisionSystem.prepareCollisions();
+
+    std::vector<FlowCollisionResult> results;
+    collisionSystem.checkFlowThreadCollisions(thread, results);
+    QCOMPARE((int)results.size(), NUM_THREAD_JOINTS);
+
+    // each joint gets the average of the spheres it's in, as computeCollision
+    const auto& spheres = collisionSystem.getCollisions();
+    for (int i = 0; i < NUM_THREAD_JOINTS; i++) {
+        std::vector<FlowCollisionResult> collisions;
+        for (const auto& sphere : spheres) {
+            auto collision = sphere.computeSphereCollision(thread._positions[i], THREAD_RADIUS);
+            if (collision._offset > 0.0f) {
+                collisions.push_back(collision);
+            }
+        }
+        auto expected = collisionSystem.computeCollision(collisions);
+        QCOMPARE(results[i]._count, expected._count);
+        if (expected._count > 0) {
+            QCOMPARE_WITH_ABS_ERROR(results[i]._offset, expected._offset, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(results[i]._normal, expected._normal, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(results[i]._position, expected._position, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(results[i]._radius, expected._radius, EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(results[i]._distance, expected._distance, EPSILON);
+        }
+    }
+    QCOMPARE(results.back()._count, 2);
+    QCOMPARE(results.front()._count, 0);
+}
+
+void FlowTests::benchmarkThreadCollisions() {
+    std::map<int, FlowJoint> joints;
+    FlowThread thread;
+    buildThread(joints, thread);
+
+    FlowCollisionSettings settings(QUuid(), FlowCollisionType::CollisionSphere, glm::vec3(0.0f), 0.05f);
+    FlowCollisionSystem collisionSystem;
+    // the body and hands of a few avatars around
+    for (int i = 0; i < 30; i++) {
+        collisionSystem.addCollisionSphere(i, settings, glm::vec3(0.1f * (i % 10), -0.1f * (i / 10), 0.05f));
+    }
+    collisionSystem.prepareCollisions();
+
+    std::vector<FlowCollisionResult> results;
+    QBENCHMARK {
+        collisionSystem.checkFlowThreadCollisions(thread, results);
+    }
+}
@@ -0,0 +1,24 @@
+//
+//  FlowTests.h
+//  tests/animation/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_FlowTests_h
+#define overte_FlowTests_h
+
+#include <QtTest/QtTest>
+
+class FlowTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testThreadCollisions();
+    void benchmarkThreadCollisions();
+};
+
+#endif // overte_FlowTests_h
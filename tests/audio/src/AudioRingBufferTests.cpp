@@ -11,6 +11,9 @@
 
 #include "AudioRingBufferTests.h"
 
+#include <mutex>
+#include <thread>
+
 #include "SharedUtil.h"
 
 // Adds an implicit cast to make sure that actual and expected are of the same type.
@@ -125,3 +128,139 @@ void AudioRingBufferTests::runAllTests() {
         assertBufferSize(ringBuffer, 0);
     }
 }
+
+void AudioRingBufferTests::spscRingBufferTests() {
+
+    float writeData[300];
+    for (int i = 0; i < 300; i++) { writeData[i] = (float)i; }
+
+    float readData[300];
+
+    AudioSPSCMixRingBuffer ringBuffer(100);
+    QCOMPARE(ringBuffer.getSampleCapacity(), 100);
+
+    for (int T = 0; T < 300; T++) {
+
+        // write 73 samples, 73 samples in buffer
+        QCOMPARE(ringBuffer.writeSamples(&writeData[0], 73), 73);
+        QCOMPARE(ringBuffer.samplesAvailable(), 73);
+
+        // read 43 samples, 30 samples in buffer
+        QCOMPARE(ringBuffer.readSamples(&readData[0], 43), 43);
+        QCOMPARE(ringBuffer.samplesAvailable(), 30);
+
+        // write 80 samples, only 70 fit and nothing unread is overwritten
+        QCOMPARE(ringBuffer.writeSamples(&writeData[73], 80), 70);
+        QCOMPARE(ringBuffer.samplesAvailable(), 100);
+        QCOMPARE(ringBuffer.samplesFree(), 0);
+
+        // read 100 samples across the wrap, 0 samples in buffer
+        QCOMPARE(ringBuffer.readSamples(&readData[43], 200), 100);
+        QCOMPARE(ringBuffer.samplesAvailable(), 0);
+
+        for (int i = 0; i < 143; i++) {
+            QCOMPARE(readData[i], (float)i);
+        }
+
+        // append onto existing data
+        for (int i = 0; i < 50; i++) { readData[i] = 1.0f; }
+        QCOMPARE(ringBuffer.writeSamples(&writeData[0], 50), 50);
+        QCOMPARE(ringBuffer.appendSamples(&readData[0], 50), 50);
+        for (int i = 0; i < 50; i++) {
+            QCOMPARE(readData[i], (float)i + 1.0f);
+        }
+    }
+
+    // resize discards any data
+    ringBuffer.writeSamples(&writeData[0], 10);
+    ringBuffer.resize(20);
+    QCOMPARE(ringBuffer.getSampleCapacity(), 20);
+    QCOMPARE(ringBuffer.samplesAvailable(), 0);
+}
+
+// Streams an ascending sequence from a producer thread to this thread through the buffer,
+// in network-sized writes and device-sized reads, and returns the number of out-of-order samples.
+template <typename Write, typename Read>
+static int transferSamples(int numSamples, Write&& write, Read&& read) {
+    const int WRITE_SAMPLES = AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
+    const int READ_SAMPLES = 256;
+
+    std::thread producer([&] {
+        float block[WRITE_SAMPLES];
+        int numWritten = 0;
+        while (numWritten < numSamples) {
+            int n = std::min(WRITE_SAMPLES, numSamples - numWritten);
+            for (int i = 0; i < n; i++) {
+                block[i] = (float)(numWritten + i);
+            }
+            int w = 0;
+            while (w < n) {
+                int samples = write(&block[w], n - w);
+                if (samples == 0) {
+                    std::this_thread::yield();
+                }
+                w += samples;
+            }
+            numWritten += n;
+        }
+    });
+
+    float block[READ_SAMPLES];
+    int errors = 0;
+    int numRead = 0;
+    while (numRead < numSamples) {
+        int samples = read(block, READ_SAMPLES);
+        if (samples == 0) {
+            std::this_thread::yield();
+        }
+        for (int i = 0; i < samples; i++) {
+            errors += (block[i] != (float)(numRead + i));
+        }
+        numRead += samples;
+    }
+
+    producer.join();
+    return errors;
+}
+
+void AudioRingBufferTests::benchmarkContention_data() {
+    QTest::addColumn<bool>("lockFree");
+    QTest::newRow("mutex") << false;
+    QTest::newRow("spsc") << true;
+}
+
+void AudioRingBufferTests::benchmarkContention() {
+    QFETCH(bool, lockFree);
+
+    const int NUM_SAMPLES = 1 << 20;
+    const int CAPACITY = 4 * AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
+
+    int errors = 0;
+
+    if (lockFree) {
+        AudioSPSCMixRingBuffer ringBuffer(CAPACITY);
+        QBENCHMARK {
+            errors += transferSamples(NUM_SAMPLES,
+                [&](const float* source, int n) { return ringBuffer.writeSamples(source, n); },
+                [&](float* destination, int n) { return ringBuffer.readSamples(destination, n); });
+        }
+    } else {
+        // the locked baseline must not overwrite either, so writes are clamped to the free space
+        AudioMixRingBuffer ringBuffer(CAPACITY, 1);
+        std::mutex mutex;
+        QBENCHMARK {
+            errors += transferSamples(NUM_SAMPLES,
+                [&](const float* source, int n) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    n = std::min(n, ringBuffer.getSampleCapacity() - ringBuffer.samplesAvailable());
+                    return ringBuffer.writeSamples(source, n);
+                },
+                [&](float* destination, int n) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    return ringBuffer.readSamples(destination, n);
+                });
+        }
+    }
+
+    QCOMPARE(errors, 0);
+}
@@ -15,12 +15,16 @@
 #include <QtTest/QtTest>
 
 #include "AudioRingBuffer.h"
+#include "AudioSPSCRingBuffer.h"
 
 
 class AudioRingBufferTests : public QObject {
     Q_OBJECT
 private slots:
     void runAllTests();
+    void spscRingBufferTests();
+    void benchmarkContention_data();
+    void benchmarkContention();
 private:
     void assertBufferSize(const AudioRingBuffer& buffer, int samples);
 };
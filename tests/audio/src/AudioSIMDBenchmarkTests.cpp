@@ -0,0 +1,318 @@
+//
+//  AudioSIMDBenchmarkTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AudioSIMDBenchmarkTests.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <QDebug>
+
+#include <AudioFOA.h>
+#include <AudioHRTF.h>
+#include <AudioSRC.h>
+#include <CPUDetect.h>
+
+QTEST_GUILESS_MAIN(AudioSIMDBenchmarks)
+
+static const int NUM_FRAMES = 240;
+static const float KERNEL_TOLERANCE = 1.0e-4f;
+
+static std::vector<float> randomFloats(int numValues, unsigned int seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    std::vector<float> values(numValues);
+    for (auto& value : values) {
+        value = distribution(generator);
+    }
+    return values;
+}
+
+static std::vector<int16_t> randomSamples(int numSamples, unsigned int seed) {
+    std::vector<int16_t> samples(numSamples);
+    auto values = randomFloats(numSamples, seed);
+    for (int i = 0; i < numSamples; i++) {
+        samples[i] = (int16_t)(values[i] * 16384.0f);
+    }
+    return samples;
+}
+
+static float maxDifference(const float* a, const float* b, int numValues) {
+    float difference = 0.0f;
+    for (int i = 0; i < numValues; i++) {
+        difference = std::max(difference, std::fabs(a[i] - b[i]));
+    }
+    return difference;
+}
+
+//
+// The x86 kernels are linked in from the audio library,
+// the SSE and NEON ones are file-local and only reachable through the dispatch
+//
+#ifdef ARCH_X86
+
+void FIR_1x4_AVX2(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+void rfft512_cmadd_1X2_AVX2(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]);
+void rotate_4x4_AVX2(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames);
+
+// as in the library, the AVX512 kernels are left out of -fstack-protector builds
+#ifndef STACK_PROTECTOR
+void FIR_1x4_AVX512(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+void rfft512_cmadd_1X2_AVX512(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]);
+void rotate_4x4_AVX512(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames);
+#define AVX512_KERNEL(kernel) kernel
+#else
+#define AVX512_KERNEL(kernel) nullptr
+#endif
+
+using FIRKernel = void (*)(float*, float*, float*, float*, float*, float[4][HRTF_TAPS], int);
+using CmaddKernel = void (*)(const float*, const float*, const float*, float*, float*);
+using RotateKernel = void (*)(float* [4], const float[4][4], const float[4][4], const float*, int);
+
+template <typename Kernel>
+static Kernel selectKernel(const QString& path, Kernel avx2, Kernel avx512) {
+    if (path == "AVX2") {
+        return avx2;
+    }
+    if (path == "AVX512") {
+        return avx512;
+    }
+    return nullptr;
+}
+
+#endif
+
+static void addKernelRows() {
+    QTest::addColumn<QString>("path");
+
+    bool hasRows = false;
+#ifdef ARCH_X86
+    if (cpuSupportsAVX2()) {
+        QTest::newRow("AVX2") << QString("AVX2");
+        hasRows = true;
+    }
+#ifndef STACK_PROTECTOR
+    if (cpuSupportsAVX512()) {
+        QTest::newRow("AVX512") << QString("AVX512");
+        hasRows = true;
+    }
+#endif
+#endif
+    if (!hasRows) {
+        QTest::newRow("unsupported") << QString();
+    }
+}
+
+void AudioSIMDBenchmarks::initTestCase() {
+#ifdef ARCH_X86
+    qInfo() << "x86 dispatch: AVX2" << cpuSupportsAVX2() << "AVX512" << cpuSupportsAVX512();
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    qInfo() << "ARM NEON";
+#else
+    qInfo() << "portable reference code";
+#endif
+}
+
+void AudioSIMDBenchmarks::benchmarkHRTFRender() {
+    AudioHRTF hrtf;
+    auto input = randomSamples(NUM_FRAMES, 1);
+    std::vector<float> output(2 * NUM_FRAMES);
+
+    // a moving source, so the filters are interpolated every block
+    float azimuth = 0.0f;
+    QBENCHMARK {
+        hrtf.render(input.data(), output.data(), 1, azimuth, 4.0f, 0.5f, NUM_FRAMES);
+        azimuth = std::fmod(azimuth + 0.01f, 6.2831853f);
+    }
+}
+
+void AudioSIMDBenchmarks::benchmarkSRCRender_data() {
+    QTest::addColumn<int>("inputSampleRate");
+    QTest::addColumn<int>("numChannels");
+
+    QTest::newRow("rational mono") << 48000 << 1;
+    QTest::newRow("rational stereo") << 48000 << 2;
+    QTest::newRow("rational quad") << 48000 << 4;
+    QTest::newRow("irrational mono") << 44100 << 1;
+    QTest::newRow("irrational stereo") << 44100 << 2;
+    QTest::newRow("irrational quad") << 44100 << 4;
+}
+
+void AudioSIMDBenchmarks::benchmarkSRCRender() {
+    QFETCH(int, inputSampleRate);
+    QFETCH(int, numChannels);
+
+    AudioSRC src(inputSampleRate, 24000, numChannels);
+    auto input = randomSamples(NUM_FRAMES * numChannels, 2);
+    std::vector<int16_t> output(src.getMaxOutput(NUM_FRAMES) * numChannels);
+
+    QBENCHMARK {
+        src.render(input.data(), output.data(), NUM_FRAMES);
+    }
+}
+
+void AudioSIMDBenchmarks::benchmarkFOARender() {
+    AudioFOA foa;
+    auto input = randomSamples(4 * NUM_FRAMES, 3);
+    std::vector<float> output(2 * NUM_FRAMES);
+
+    // a turning listener, so the soundfield is rotated every block
+    float angle = 0.0f;
+    QBENCHMARK {
+        foa.render(input.data(), output.data(), 0, std::cos(angle), 0.0f, std::sin(angle), 0.0f, 0.5f, NUM_FRAMES);
+        angle = std::fmod(angle + 0.01f, 3.1415927f);
+    }
+}
+
+void AudioSIMDBenchmarks::benchmarkFIRKernel_data() {
+    addKernelRows();
+}
+
+void AudioSIMDBenchmarks::benchmarkFIRKernel() {
+    QFETCH(QString, path);
+#ifdef ARCH_X86
+    FIRKernel kernel = selectKernel<FIRKernel>(path, FIR_1x4_AVX2, AVX512_KERNEL(FIR_1x4_AVX512));
+    if (!kernel) {
+        QSKIP("no x86 kernels on this CPU");
+    }
+
+    // the kernel reads HRTF_TAPS - 1 frames of history before the block
+    auto input = randomFloats(HRTF_TAPS - 1 + NUM_FRAMES, 4);
+    float* src = input.data() + HRTF_TAPS - 1;
+
+    auto coefValues = randomFloats(4 * HRTF_TAPS, 5);
+    float coef[4][HRTF_TAPS];
+    memcpy(coef, coefValues.data(), sizeof(coef));
+
+    std::vector<float> dst(4 * NUM_FRAMES);
+    float* dsts[4] = { &dst[0 * NUM_FRAMES], &dst[1 * NUM_FRAMES], &dst[2 * NUM_FRAMES], &dst[3 * NUM_FRAMES] };
+
+    kernel(src, dsts[0], dsts[1], dsts[2], dsts[3], coef, NUM_FRAMES);
+
+    std::vector<float> expected(4 * NUM_FRAMES, 0.0f);
+    for (int ch = 0; ch < 4; ch++) {
+        for (int i = 0; i < NUM_FRAMES; i++) {
+            for (int k = 0; k < HRTF_TAPS; k++) {
+                expected[ch * NUM_FRAMES + i] += coef[ch][HRTF_TAPS - 1 - k] * src[i - HRTF_TAPS + 1 + k];
+            }
+        }
+    }
+    QVERIFY(maxDifference(dst.data(), expected.data(), 4 * NUM_FRAMES) < KERNEL_TOLERANCE * HRTF_TAPS);
+
+    QBENCHMARK {
+        kernel(src, dsts[0], dsts[1], dsts[2], dsts[3], coef, NUM_FRAMES);
+    }
+#else
+    Q_UNUSED(path);
+    QSKIP("no x86 kernels on this CPU");
+#endif
+}
+
+void AudioSIMDBenchmarks::benchmarkCmaddKernel_data() {
+    addKernelRows();
+}
+
+void AudioSIMDBenchmarks::benchmarkCmaddKernel() {
+    QFETCH(QString, path);
+#ifdef ARCH_X86
+    CmaddKernel kernel = selectKernel<CmaddKernel>(path, rfft512_cmadd_1X2_AVX2, AVX512_KERNEL(rfft512_cmadd_1X2_AVX512));
+    if (!kernel) {
+        QSKIP("no x86 kernels on this CPU");
+    }
+
+    auto src = randomFloats(FOA_NFFT, 6);
+    auto coef0 = randomFloats(FOA_NFFT, 7);
+    auto coef1 = randomFloats(FOA_NFFT, 8);
+    std::vector<float> dst0(FOA_NFFT, 0.0f);
+    std::vector<float> dst1(FOA_NFFT, 0.0f);
+
+    kernel(src.data(), coef0.data(), coef1.data(), dst0.data(), dst1.data());
+
+    // NOTE: x[n/2].re is packed into x[0].im
+    std::vector<float> expected0(FOA_NFFT);
+    std::vector<float> expected1(FOA_NFFT);
+    expected0[0] = src[0] * coef0[0];
+    expected0[1] = src[1] * coef0[1];
+    expected1[0] = src[0] * coef1[0];
+    expected1[1] = src[1] * coef1[1];
+    for (int i = 1; i < FOA_NFFT / 2; i++) {
+        expected0[2*i+0] = src[2*i+0] * coef0[2*i+0] - src[2*i+1] * coef0[2*i+1];
+        expected0[2*i+1] = src[2*i+0] * coef0[2*i+1] + src[2*i+1] * coef0[2*i+0];
+        expected1[2*i+0] = src[2*i+0] * coef1[2*i+0] - src[2*i+1] * coef1[2*i+1];
+        expected1[2*i+1] = src[2*i+0] * coef1[2*i+1] + src[2*i+1] * coef1[2*i+0];
+    }
+    QVERIFY(maxDifference(dst0.data(), expected0.data(), FOA_NFFT) < KERNEL_TOLERANCE);
+    QVERIFY(maxDifference(dst1.data(), expected1.data(), FOA_NFFT) < KERNEL_TOLERANCE);
+
+    QBENCHMARK {
+        kernel(src.data(), coef0.data(), coef1.data(), dst0.data(), dst1.data());
+    }
+#else
+    Q_UNUSED(path);
+    QSKIP("no x86 kernels on this CPU");
+#endif
+}
+
+void AudioSIMDBenchmarks::benchmarkRotateKernel_data() {
+    addKernelRows();
+}
+
+void AudioSIMDBenchmarks::benchmarkRotateKernel() {
+    QFETCH(QString, path);
+#ifdef ARCH_X86
+    RotateKernel kernel = selectKernel<RotateKernel>(path, rotate_4x4_AVX2, AVX512_KERNEL(rotate_4x4_AVX512));
+    if (!kernel) {
+        QSKIP("no x86 kernels on this CPU");
+    }
+
+    auto input = randomFloats(4 * NUM_FRAMES, 9);
+    auto window = randomFloats(NUM_FRAMES, 10);
+    auto matrices = randomFloats(2 * 16, 11);
+
+    float m0[4][4];
+    float m1[4][4];
+    memcpy(m0, &matrices[0], sizeof(m0));
+    memcpy(m1, &matrices[16], sizeof(m1));
+
+    std::vector<float> buffer = input;
+    float* buf[4] = { &buffer[0 * NUM_FRAMES], &buffer[1 * NUM_FRAMES], &buffer[2 * NUM_FRAMES], &buffer[3 * NUM_FRAMES] };
+
+    kernel(buf, m0, m1, window.data(), NUM_FRAMES);
+
+    // W is only scaled, XYZ are rotated
+    std::vector<float> expected(4 * NUM_FRAMES);
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        float frac = window[i];
+        float in[4] = { input[0 * NUM_FRAMES + i], input[1 * NUM_FRAMES + i],
+                        input[2 * NUM_FRAMES + i], input[3 * NUM_FRAMES + i] };
+
+        expected[i] = (m1[0][0] + frac * (m0[0][0] - m1[0][0])) * in[0];
+        for (int row = 1; row < 4; row++) {
+            float sum = 0.0f;
+            for (int col = 1; col < 4; col++) {
+                sum += (m1[row][col] + frac * (m0[row][col] - m1[row][col])) * in[col];
+            }
+            expected[row * NUM_FRAMES + i] = sum;
+        }
+    }
+    QVERIFY(maxDifference(buffer.data(), expected.data(), 4 * NUM_FRAMES) < KERNEL_TOLERANCE);
+
+    QBENCHMARK {
+        kernel(buf, m0, m1, window.data(), NUM_FRAMES);
+    }
+#else
+    Q_UNUSED(path);
+    QSKIP("no x86 kernels on this CPU");
+#endif
+}
@@ -0,0 +1,37 @@
+//
+//  AudioSIMDBenchmarkTests.h
+//  tests/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_AudioSIMDBenchmarkTests_h
+#define overte_AudioSIMDBenchmarkTests_h
+
+#include <QtTest/QtTest>
+
+// Times the HRTF, SRC and FOA renders on the path the runtime dispatch picks for this CPU,
+// and each x86 kernel the CPU supports against the others, checking that they agree.
+class AudioSIMDBenchmarks : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void benchmarkHRTFRender();
+    void benchmarkSRCRender_data();
+    void benchmarkSRCRender();
+    void benchmarkFOARender();
+
+    void benchmarkFIRKernel_data();
+    void benchmarkFIRKernel();
+    void benchmarkCmaddKernel_data();
+    void benchmarkCmaddKernel();
+    void benchmarkRotateKernel_data();
+    void benchmarkRotateKernel();
+};
+
+#endif // overte_AudioSIMDBenchmarkTests_h
@@ -123,3 +123,50 @@ void CodecTests::testDecoders () {
         qDebug() << "Codec" << plugin->getName() << "decoded a lost frame";
     }
 }
+
+void CodecTests::testIntoBuffers() {
+    const auto& codecPlugins = PluginManager::getInstance()->getCodecPlugins();
+
+    QVERIFY(codecPlugins.size() > 0);
+
+
+    for (const auto& plugin : codecPlugins) {
+        if (!plugin->isSupported()) {
+            qWarning() << "Skipping unsupported plugin" << plugin->getName();
+            continue;
+        }
+
+        Encoder* encoder = plugin->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+        Decoder* decoder = plugin->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+        QVERIFY(encoder != nullptr);
+        QVERIFY(decoder != nullptr);
+
+        QByteArray data(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
+        for (int i = 0; i < data.size() / (int)sizeof(int16_t); i++) {
+            reinterpret_cast<int16_t*>(data.data())[i] = (int16_t)((i % 64) * 256 - 8192);
+        }
+
+        // the caller's buffers give the same sizes as the QByteArray interface
+        char encoded[AudioConstants::NETWORK_FRAME_BYTES_STEREO];
+        int encodedSize = encoder->encodeInto(data.constData(), data.size(), encoded, sizeof(encoded));
+        QVERIFY(encodedSize > 0);
+
+        char decoded[AudioConstants::NETWORK_FRAME_BYTES_STEREO];
+        int decodedSize = decoder->decodeInto(encoded, encodedSize, decoded, sizeof(decoded));
+        QCOMPARE(decodedSize, data.size());
+
+        int lostSize = decoder->lostFrameInto(decoded, sizeof(decoded));
+        QCOMPARE(lostSize, data.size());
+
+        // and a buffer too small for the frame is refused rather than overrun
+        char tooSmall[16];
+        QCOMPARE(decoder->decodeInto(encoded, encodedSize, tooSmall, sizeof(tooSmall)), -1);
+
+        // the hints apply from the next frame on, for the codecs that take them
+        encoder->setBitrate(32000);
+        encoder->setComplexity(2);
+        QVERIFY(encoder->encodeInto(data.constData(), data.size(), encoded, sizeof(encoded)) > 0);
+
+        qDebug() << "Codec" << plugin->getName() << "encoded" << data.size() << "bytes into" << encodedSize << "in place";
+    }
+}
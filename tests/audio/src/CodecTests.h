@@ -26,6 +26,7 @@ private slots:
 
     void testEncoders();
     void testDecoders();
+    void testIntoBuffers();
 
 };
 
@@ -0,0 +1,63 @@
+//
+//  PacketDelayHistogramTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "PacketDelayHistogramTests.h"
+
+#include <AudioConstants.h>
+#include <PacketDelayHistogram.h>
+
+QTEST_MAIN(PacketDelayHistogramTests)
+
+static const uint64_t FRAME_USECS = AudioConstants::NETWORK_FRAME_USECS;
+
+void PacketDelayHistogramTests::steadyArrivals() {
+    PacketDelayHistogram histogram;
+
+    for (uint64_t i = 0; i < 1000; i++) {
+        histogram.packetArrived(i * FRAME_USECS, 1);
+    }
+
+    QCOMPARE(histogram.getLastDelayFrames(), 0);
+    QCOMPARE(histogram.getTargetFrames(0.01f), 1);
+    QCOMPARE(histogram.getLateLossRatio(1), 0.0f);
+}
+
+void PacketDelayHistogramTests::lateArrivals() {
+    PacketDelayHistogram histogram;
+
+    // every tenth packet is 3.5 frames late
+    for (uint64_t i = 0; i < 1000; i++) {
+        uint64_t delay = (i % 10 == 5) ? (7 * FRAME_USECS / 2) : 0;
+        histogram.packetArrived(i * FRAME_USECS + delay, 1);
+    }
+
+    // tolerating 20% late loss ignores the late packets, 5% does not
+    QCOMPARE(histogram.getTargetFrames(0.2f), 1);
+    QCOMPARE(histogram.getTargetFrames(0.05f), 4);
+
+    float lateLoss = histogram.getLateLossRatio(1);
+    QVERIFY(lateLoss > 0.08f && lateLoss < 0.12f);
+    QCOMPARE(histogram.getLateLossRatio(4), 0.0f);
+}
+
+void PacketDelayHistogramTests::lostAndReorderedArrivals() {
+    PacketDelayHistogram histogram;
+
+    histogram.packetArrived(0, 1);
+
+    // lost packets advance the reference without adding delay
+    histogram.packetArrived(3 * FRAME_USECS, 3);
+    QCOMPARE(histogram.getLastDelayFrames(), 0);
+
+    // a reordered packet two slots back, arriving now, was two frames late
+    histogram.packetArrived(3 * FRAME_USECS, -2);
+    QCOMPARE(histogram.getLastDelayFrames(), 2);
+}
@@ -0,0 +1,25 @@
+//
+//  PacketDelayHistogramTests.h
+//  tests/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_PacketDelayHistogramTests_h
+#define overte_PacketDelayHistogramTests_h
+
+#include <QtTest/QtTest>
+
+class PacketDelayHistogramTests : public QObject {
+    Q_OBJECT
+private slots:
+    void steadyArrivals();
+    void lateArrivals();
+    void lostAndReorderedArrivals();
+};
+
+#endif // overte_PacketDelayHistogramTests_h
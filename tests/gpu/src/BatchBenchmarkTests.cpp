@@ -0,0 +1,90 @@
+//
+//  BatchBenchmarkTests.cpp
+//  tests/gpu/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BatchBenchmarkTests.h"
+
+#include <thread>
+#include <vector>
+
+#include <QtTest/QtTest>
+
+#include <gpu/Context.h>
+
+QTEST_GUILESS_MAIN(BatchBenchmarkTests)
+
+static const int NUM_DRAWS = 10000;
+static const int NUM_THREADS = 4;
+
+static void recordDraws(gpu::Batch& batch, int numDraws) {
+    Transform model;
+    for (int i = 0; i < numDraws; ++i) {
+        model.setTranslation(glm::vec3((float)i, 0.0f, 0.0f));
+        batch.setModelTransform(model);
+        batch.drawIndexed(gpu::TRIANGLES, 36, 0);
+    }
+}
+
+// Records NUM_DRAWS draws split over NUM_THREADS threads, one batch per thread
+static std::vector<gpu::BatchPointer> recordOnWorkerThreads() {
+    std::vector<gpu::BatchPointer> batches(NUM_THREADS);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([&batches, i] {
+            batches[i] = gpu::Context::acquireBatch("BatchBenchmarkTests::worker");
+            recordDraws(*batches[i], NUM_DRAWS / NUM_THREADS);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return batches;
+}
+
+void BatchBenchmarkTests::testRecycledBatchKeepsCapacity() {
+    size_t capacity;
+    {
+        auto batch = gpu::Context::acquireBatch("BatchBenchmarkTests::first");
+        recordDraws(*batch, NUM_DRAWS);
+        capacity = batch->getCommands().capacity();
+        QVERIFY(capacity >= (size_t)NUM_DRAWS);
+    }
+
+    // the released batch is the next one this thread gets, cleared but as large as it was
+    auto batch = gpu::Context::acquireBatch("BatchBenchmarkTests::second");
+    QVERIFY(batch->getCommands().empty());
+    QCOMPARE(batch->getCommands().capacity(), capacity);
+}
+
+void BatchBenchmarkTests::testRecordOnWorkerThreads() {
+    auto batches = recordOnWorkerThreads();
+    size_t numCommands = 0;
+    for (const auto& batch : batches) {
+        QVERIFY(batch);
+        numCommands += batch->getCommands().size();
+    }
+
+    gpu::Batch reference;
+    recordDraws(reference, NUM_DRAWS / NUM_THREADS);
+    QCOMPARE(numCommands, NUM_THREADS * reference.getCommands().size());
+}
+
+void BatchBenchmarkTests::benchmarkRecordDraws() {
+    QBENCHMARK {
+        auto batch = gpu::Context::acquireBatch("BatchBenchmarkTests::benchmark");
+        recordDraws(*batch, NUM_DRAWS);
+    }
+}
+
+void BatchBenchmarkTests::benchmarkRecordDrawsOnWorkerThreads() {
+    QBENCHMARK {
+        recordOnWorkerThreads();
+    }
+}
@@ -0,0 +1,27 @@
+//
+//  BatchBenchmarkTests.h
+//  tests/gpu/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_BatchBenchmarkTests_h
+#define overte_BatchBenchmarkTests_h
+
+#include <QtCore/QObject>
+
+class BatchBenchmarkTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRecycledBatchKeepsCapacity();
+    void testRecordOnWorkerThreads();
+    void benchmarkRecordDraws();
+    void benchmarkRecordDrawsOnWorkerThreads();
+};
+
+#endif // overte_BatchBenchmarkTests_h
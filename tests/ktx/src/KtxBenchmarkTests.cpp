@@ -156,6 +156,23 @@ void KtxBenchmarks::benchmarkCreateTexture() {
     }
 }
 
+void KtxBenchmarks::benchmarkCreateLargeTexture() {
+    // A texture large enough for its mips and compression tiles to be spread over the workers
+    const int LARGE_TEXTURE_SIZE = 4096;
+    const QString TEST_IMAGE = getRootPath() + test_texture;
+    QImage sourceImage = QImage(TEST_IMAGE).scaled(LARGE_TEXTURE_SIZE, LARGE_TEXTURE_SIZE);
+    QVERIFY(!sourceImage.isNull());
+
+    QBENCHMARK {
+        QImage image = sourceImage;
+        std::atomic<bool> abortSignal { false };
+        gpu::TexturePointer testTexture = image::TextureUsage::process2DTextureColorFromImage(std::move(image), TEST_IMAGE.toStdString(),
+                                                                                              true, gpu::BackendTarget::GL45, true, abortSignal);
+        QVERIFY(testTexture);
+        QCOMPARE(testTexture->getWidth(), (gpu::uint16)LARGE_TEXTURE_SIZE);
+    }
+}
+
 void KtxBenchmarks::benchmarkSerializeTexture() {
     const QString TEST_IMAGE = getRootPath() +  test_texture;
     gpu::TexturePointer testTexture = loadTexture(TEST_IMAGE);
@@ -19,6 +19,7 @@ private slots:
     void benchmarkJPG();
 
     void benchmarkCreateTexture();
+    void benchmarkCreateLargeTexture();
     void benchmarkSerializeTexture();
     void benchmarkWriteKTX();
 };
@@ -13,6 +13,7 @@
 #include <QtTest/QtTest>
 
 #include <ktx/KTX.h>
+#include <ktx/KTX2.h>
 #include <gpu/Texture.h>
 #include <image/Image.h>
 #include <image/TextureProcessing.h>
@@ -201,3 +202,54 @@ int mainTemp(int, char**) {
     return 0;
 }
 #endif
+
+void KtxTests::testKtx2Serialization() {
+    QCOMPARE(sizeof(ktx::KTX2Header), (size_t)80);
+
+    // A data format descriptor for 16 byte texel blocks of the UASTC color model
+    ktx::KTX2::Bytes dfd(44, 0);
+    dfd[0] = (ktx::Byte)dfd.size();
+    dfd[12] = (ktx::Byte)ktx::ColorModel::UASTC;
+    dfd[20] = 16;
+
+    ktx::KTX2::LevelBytes levels;
+    levels.push_back(ktx::KTX2::Bytes(64, 0xAA));
+    levels.push_back(ktx::KTX2::Bytes(16, 0xBB));
+    ktx::KeyValues keyValues;
+    keyValues.emplace_back(ktx::KeyValue("KTXwriter", "test"));
+
+    ktx::KTX2Header header;
+    header.pixelWidth = 8;
+    header.pixelHeight = 8;
+    auto ktx2 = ktx::KTX2::create(header, dfd, levels, keyValues);
+    QVERIFY(ktx2.get());
+
+    const auto& storage = ktx2->getStorage();
+    QVERIFY(ktx::KTX2::checkIdentifier(storage->size(), storage->data()));
+    QVERIFY(!ktx::KTX2::checkIdentifier(ktx::Header::IDENTIFIER_LENGTH, ktx::Header::IDENTIFIER.data()));
+    QCOMPARE(ktx2->getHeader().levelCount, (uint32_t)2);
+    QCOMPARE(ktx2->getKeyValues().size(), (size_t)1);
+    QCOMPARE(ktx2->getColorModel(), ktx::ColorModel::UASTC);
+    QCOMPARE(ktx2->getTexelBlockByteSize(), (uint32_t)16);
+    QVERIFY(ktx2->isBasisUniversal());
+    QVERIFY(ktx2->requiresTranscoding());
+
+    // The smallest level comes first, each aligned to its texel blocks
+    const auto& levelIndex = ktx2->getLevels();
+    QVERIFY(levelIndex[1].byteOffset < levelIndex[0].byteOffset);
+    for (size_t i = 0; i < levels.size(); ++i) {
+        QCOMPARE(levelIndex[i].byteOffset % 16, (uint64_t)0);
+        QCOMPARE(levelIndex[i].byteLength, (uint64_t)levels[i].size());
+        auto levelData = ktx2->getLevelData((uint32_t)i);
+        QVERIFY(0 == memcmp(levelData->data(), levels[i].data(), levels[i].size()));
+    }
+
+    // Reading the serialized bytes back gives the same layout
+    auto copy = ktx::KTX2::create(storage->toMemoryStorage());
+    QVERIFY(copy.get());
+    QCOMPARE(copy->getLevels()[0].byteOffset, levelIndex[0].byteOffset);
+    QCOMPARE(copy->getKeyValues().front()._key, std::string("KTXwriter"));
+
+    // Truncated files are rejected
+    QVERIFY(!ktx::KTX2::create(storage->createView(storage->size() - 1)).get());
+}
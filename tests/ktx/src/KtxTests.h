@@ -16,6 +16,7 @@ private slots:
     void testKtxEvalFunctions();
     void testKhronosCompressionFunctions();
     void testKtxSerialization();
+    void testKtx2Serialization();
 };
 
 
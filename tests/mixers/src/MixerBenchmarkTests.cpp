@@ -0,0 +1,434 @@
+//
+//  MixerBenchmarkTests.cpp
+//  tests/mixers/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "MixerBenchmarkTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <AudioConstants.h>
+#include <AvatarData.h>
+#include <DependencyManager.h>
+#include <EntityTree.h>
+#include <GLMHelpers.h>
+#include <HeadData.h>
+#include <NLPacket.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <PortableHighResolutionClock.h>
+#include <ReceivedMessage.h>
+#include <UUID.h>
+#include <shared/ConicalViewFrustum.h>
+
+#include <AudioMixerClientData.h>
+#include <AudioMixerSlavePool.h>
+#include <AudioMixerStats.h>
+#include <AvatarMixerClientData.h>
+#include <AvatarMixerSlavePool.h>
+
+QTEST_GUILESS_MAIN(MixerBenchmarks)
+
+namespace {
+
+// the populations and what they send are seeded, so that the runs compare
+const unsigned int RANDOM_SEED = 20260101;
+
+// the audio frames that fill the jitter buffers before the mixes are timed
+const int AUDIO_WARMUP_FRAMES = 100;
+const int AUDIO_MEASURED_FRAMES = 200;
+const int AVATAR_WARMUP_FRAMES = 20;
+const int AVATAR_MEASURED_FRAMES = 200;
+const float AVATAR_FRAME_SECS = 1.0f / 45.0f;
+
+// the avatar mixer's default, 5 Mbps per node
+const float MAX_KBPS_PER_NODE = 5000.0f;
+
+const float GRID_SPACING = 3.0f;
+const float CLUSTER_RADIUS = 2.0f;
+const int CLUSTER_SIZE = 8;
+const float CLUSTER_AREA = 100.0f;
+const float CROWD_RADIUS = 5.0f;
+const float QUERY_RADIUS = 0.5f;
+const float WALK_SPEED = 1.0f;
+
+const float TONE_FREQUENCY = 440.0f;
+const float TONE_AMPLITUDE = 4000.0f;
+const char* AUDIO_CODEC_NAME = "pcm";
+
+enum Distribution {
+    UNIFORM = 0,    // a grid, a few meters apart
+    CLUSTERED,      // groups of a few avatars around the domain
+    CROWD           // everybody within a few meters
+};
+
+const char* distributionName(int distribution) {
+    switch (distribution) {
+        case UNIFORM: return "uniform";
+        case CLUSTERED: return "clustered";
+        default: return "crowd";
+    }
+}
+
+std::vector<glm::vec3> makePositions(int distribution, int numNodes, std::mt19937& random) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<glm::vec3> positions;
+    positions.reserve(numNodes);
+
+    if (distribution == UNIFORM) {
+        int side = (int)std::ceil(std::sqrt((float)numNodes));
+        for (int i = 0; i < numNodes; ++i) {
+            positions.emplace_back((i % side) * GRID_SPACING, 0.0f, (i / side) * GRID_SPACING);
+        }
+    } else {
+        glm::vec3 center;
+        for (int i = 0; i < numNodes; ++i) {
+            float radius = CROWD_RADIUS;
+            if (distribution == CLUSTERED) {
+                if (i % CLUSTER_SIZE == 0) {
+                    center = glm::vec3(unit(random) * CLUSTER_AREA, 0.0f, unit(random) * CLUSTER_AREA);
+                }
+                radius = CLUSTER_RADIUS;
+            }
+            float angle = unit(random) * TWO_PI;
+            float distance = radius * std::sqrt(unit(random));
+            positions.push_back(center + glm::vec3(distance * std::cos(angle), 0.0f, distance * std::sin(angle)));
+        }
+    }
+    return positions;
+}
+
+// the nodes of a population, in a NodeList of their own that the slaves send to
+std::vector<SharedNodePointer> addNodes(int numNodes, const SockAddr& sink, std::mt19937& random,
+                                        std::function<NodeData*(const QUuid&, Node::LocalID)> makeData) {
+    auto nodeList = DependencyManager::get<NodeList>();
+    std::vector<SharedNodePointer> nodes;
+    nodes.reserve(numNodes);
+    for (int i = 0; i < numNodes; ++i) {
+        // seeded too, since the mixers order some of their work by node
+        QByteArray rfc4122(NUM_BYTES_RFC4122_UUID, 0);
+        for (auto& byte : rfc4122) {
+            byte = (char)random();
+        }
+        QUuid uuid = QUuid::fromRfc4122(rfc4122);
+        Node::LocalID localID = (Node::LocalID)(i + 1);
+        auto node = nodeList->addOrUpdateNode(uuid, NodeType::Agent, sink, sink, localID);
+        node->activatePublicSocket();
+        node->setLinkedData(std::unique_ptr<NodeData>(makeData(uuid, localID)));
+        nodes.push_back(node);
+    }
+    return nodes;
+}
+
+QSharedPointer<ReceivedMessage> toMessage(NLPacket& packet, Node::LocalID sourceID) {
+    packet.writeSourceID(sourceID);
+    packet.seek(0);
+    return QSharedPointer<ReceivedMessage>::create(packet);
+}
+
+struct FrameTimes {
+    std::vector<qint64> nsecs;
+
+    void report(const QString& name) {
+        std::sort(nsecs.begin(), nsecs.end());
+        double mean = 0.0;
+        for (auto frameNsecs : nsecs) {
+            mean += frameNsecs;
+        }
+        mean /= std::max((size_t)1, nsecs.size());
+        qint64 p95 = nsecs.empty() ? 0 : nsecs[(nsecs.size() * 95) / 100];
+        qint64 max = nsecs.empty() ? 0 : nsecs.back();
+
+        qDebug().noquote() << name << "frame msecs mean" << mean / NSECS_PER_MSEC << "p95" << (double)p95 / NSECS_PER_MSEC
+            << "max" << (double)max / NSECS_PER_MSEC;
+        QTest::setBenchmarkResult(mean / NSECS_PER_MSEC, QTest::WalltimeMilliseconds);
+    }
+};
+
+class SyntheticAvatar : public AvatarData {
+public:
+    SyntheticAvatar() { _headData = new HeadData(this); }
+
+    QByteArray toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking = false) override {
+        // there's no simulation to compute it, like the ScriptableAvatar
+        _globalPosition = getWorldPosition();
+        return AvatarData::toByteArrayStateful(dataDetail, dropFaceTracking);
+    }
+};
+
+}
+
+void MixerBenchmarks::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::AudioMixer, INVALID_PORT);
+
+    QVERIFY(_sink.bind(QHostAddress::LocalHost, 0));
+}
+
+void MixerBenchmarks::cleanupTestCase() {
+    DependencyManager::destroy<NodeList>();
+}
+
+void MixerBenchmarks::benchmarkAudioMix_data() {
+    QTest::addColumn<int>("numNodes");
+    QTest::addColumn<int>("distribution");
+    QTest::addColumn<float>("talkerFraction");
+    QTest::addColumn<int>("numThreads");
+
+    int idealThreads = QThread::idealThreadCount();
+    for (int numNodes : { 50, 200, 500 }) {
+        for (int distribution : { UNIFORM, CLUSTERED, CROWD }) {
+            QTest::addRow("%d %s", numNodes, distributionName(distribution))
+                << numNodes << distribution << 0.2f << idealThreads;
+        }
+    }
+    QTest::addRow("200 crowd, all talking") << 200 << (int)CROWD << 1.0f << idealThreads;
+    QTest::addRow("200 crowd, 1 thread") << 200 << (int)CROWD << 0.2f << 1;
+}
+
+void MixerBenchmarks::benchmarkAudioMix() {
+    QFETCH(int, numNodes);
+    QFETCH(int, distribution);
+    QFETCH(float, talkerFraction);
+    QFETCH(int, numThreads);
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    std::mt19937 random(RANDOM_SEED);
+    auto positions = makePositions(distribution, numNodes, random);
+
+    SockAddr sink(SocketType::UDP, QHostAddress::LocalHost, _sink.localPort());
+    auto nodes = addNodes(numNodes, sink, random, [](const QUuid& uuid, Node::LocalID localID) {
+        return new AudioMixerClientData(uuid, localID);
+    });
+
+    // the talkers are the first of the shuffled nodes, each with a tone of its own
+    std::vector<int> order(numNodes);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), random);
+    std::vector<bool> isTalker(numNodes, false);
+    for (int i = 0; i < (int)(talkerFraction * numNodes); ++i) {
+        isTalker[order[i]] = true;
+    }
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<float> toneFrequencies(numNodes);
+    std::vector<glm::quat> orientations(numNodes);
+    for (int i = 0; i < numNodes; ++i) {
+        toneFrequencies[i] = TONE_FREQUENCY * (0.5f + unit(random));
+        orientations[i] = glm::angleAxis(unit(random) * TWO_PI, Vectors::UP);
+    }
+
+    AudioMixerSlave::SharedData sharedData;
+    AudioMixerSlavePool pool(sharedData, numThreads);
+    const glm::vec3 BOX_CORNER(-0.5f, 0.0f, -0.5f);
+    const glm::vec3 BOX_SCALE(1.0f, 1.8f, 1.0f);
+    int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+
+    FrameTimes frameTimes;
+    AudioMixerStats totalStats;
+    int numFrames = AUDIO_WARMUP_FRAMES + AUDIO_MEASURED_FRAMES;
+    for (int frame = 1; frame <= numFrames; ++frame) {
+        // each node sends its frame, off the clock
+        for (int i = 0; i < numNodes; ++i) {
+            auto packet = NLPacket::create(isTalker[i] ? PacketType::MicrophoneAudioNoEcho : PacketType::SilentAudioFrame);
+            packet->writePrimitive((quint16)frame);
+            packet->writeString(AUDIO_CODEC_NAME);
+            if (isTalker[i]) {
+                packet->writePrimitive((quint8)0); // mono
+            } else {
+                packet->writePrimitive((quint16)AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            }
+            packet->writePrimitive(positions[i]);
+            packet->writePrimitive(orientations[i]);
+            packet->writePrimitive(positions[i] + BOX_CORNER);
+            packet->writePrimitive(BOX_SCALE);
+            if (isTalker[i]) {
+                float phaseStep = TWO_PI * toneFrequencies[i] / AudioConstants::SAMPLE_RATE;
+                for (int s = 0; s < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; ++s) {
+                    int sample = frame * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL + s;
+                    samples[s] = (int16_t)(TONE_AMPLITUDE * std::sin(phaseStep * sample));
+                }
+                packet->write(reinterpret_cast<const char*>(samples), sizeof(samples));
+            }
+
+            auto data = static_cast<AudioMixerClientData*>(nodes[i]->getLinkedData());
+            data->queuePacket(toMessage(*packet, nodes[i]->getLocalID()), nodes[i]);
+        }
+
+        // the mixer's frame, without the sleeps and the events
+        auto start = p_high_resolution_clock::now();
+        sharedData.addedStreams.clear();
+        pool.processPackets(nodes.cbegin(), nodes.cend());
+        sharedData.removedNodes.clear();
+        sharedData.removedStreams.clear();
+
+        sharedData.spatializationCache.beginFrame(frame);
+        sharedData.foaBus.beginFrame(frame);
+        sharedData.mixDeduplicator.clear();
+        pool.mix(nodes.cbegin(), nodes.cend(), frame, 0.0f);
+        nodeList->flushSendBatch();
+        auto end = p_high_resolution_clock::now();
+
+        AudioMixerStats frameStats;
+        pool.each([&](AudioMixerSlave& slave) {
+            frameStats.accumulate(slave.stats);
+            slave.stats.reset();
+        });
+
+        if (frame == AUDIO_WARMUP_FRAMES) {
+            QJsonObject discarded;
+            pool.threadStats(discarded);
+        } else if (frame > AUDIO_WARMUP_FRAMES) {
+            frameTimes.nsecs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            totalStats.accumulate(frameStats);
+        }
+    }
+
+    QJsonObject threadStats;
+    pool.threadStats(threadStats);
+    QStringList busy;
+    for (const auto& thread : threadStats) {
+        busy << QString::number(thread.toObject()["busy_%"].toDouble(), 'f', 1) + "%";
+    }
+    qDebug().noquote() << "audio mixes per frame" << (double)totalStats.totalMixes / AUDIO_MEASURED_FRAMES
+        << "hrtf renders" << (double)totalStats.hrtfRenders / AUDIO_MEASURED_FRAMES
+        << "encodes" << (double)totalStats.mixEncodes / AUDIO_MEASURED_FRAMES
+        << "bytes sent" << (double)totalStats.mixBytes / AUDIO_MEASURED_FRAMES
+        << "threads busy" << busy.join(' ');
+    frameTimes.report(QString("audio mix of %1 %2 nodes").arg(numNodes).arg(distributionName(distribution)));
+
+    QVERIFY(totalStats.sumListeners == numNodes * AUDIO_MEASURED_FRAMES);
+
+    nodeList->eraseAllNodes("MixerBenchmarks::benchmarkAudioMix");
+}
+
+void MixerBenchmarks::benchmarkAvatarBroadcast_data() {
+    QTest::addColumn<int>("numNodes");
+    QTest::addColumn<int>("distribution");
+    QTest::addColumn<int>("numThreads");
+
+    int idealThreads = QThread::idealThreadCount();
+    for (int numNodes : { 50, 200, 500 }) {
+        for (int distribution : { UNIFORM, CLUSTERED, CROWD }) {
+            QTest::addRow("%d %s", numNodes, distributionName(distribution)) << numNodes << distribution << idealThreads;
+        }
+    }
+    QTest::addRow("200 crowd, 1 thread") << 200 << (int)CROWD << 1;
+}
+
+void MixerBenchmarks::benchmarkAvatarBroadcast() {
+    QFETCH(int, numNodes);
+    QFETCH(int, distribution);
+    QFETCH(int, numThreads);
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    std::mt19937 random(RANDOM_SEED);
+    auto positions = makePositions(distribution, numNodes, random);
+
+    SockAddr sink(SocketType::UDP, QHostAddress::LocalHost, _sink.localPort());
+    auto nodes = addNodes(numNodes, sink, random, [](const QUuid& uuid, Node::LocalID localID) {
+        return new AvatarMixerClientData(uuid, localID);
+    });
+
+    // the avatars walk in circles around where they start, each with its own view of the others
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<std::unique_ptr<SyntheticAvatar>> avatars;
+    std::vector<float> walkPhases;
+    for (int i = 0; i < numNodes; ++i) {
+        avatars.emplace_back(new SyntheticAvatar());
+        avatars.back()->setSessionUUID(nodes[i]->getUUID());
+        walkPhases.push_back(unit(random) * TWO_PI);
+
+        ConicalViewFrustum view;
+        view.setPositionAndSimpleRadius(positions[i], QUERY_RADIUS);
+        QByteArray query(1 + 256, 0);
+        auto destinationBuffer = reinterpret_cast<unsigned char*>(query.data());
+        *destinationBuffer++ = 1; // one frustum, no rate limits
+        destinationBuffer += view.serialize(destinationBuffer);
+        *destinationBuffer++ = 0;
+        *destinationBuffer++ = 0;
+        *destinationBuffer++ = 0;
+        query.resize((int)(destinationBuffer - reinterpret_cast<unsigned char*>(query.data())));
+        static_cast<AvatarMixerClientData*>(nodes[i]->getLinkedData())->readViewFrustumPacket(query);
+    }
+
+    SlaveSharedData sharedData;
+    sharedData.entityTree = std::make_shared<EntityTree>();
+    sharedData.entityTree->createRootElement();
+    AvatarMixerSlavePool pool(&sharedData, numThreads);
+
+    FrameTimes frameTimes;
+    AvatarMixerSlaveStats totalStats;
+    std::vector<quint64> threadBusyUsecs(numThreads, 0);
+    quint64 totalFrameUsecs = 0;
+    auto lastFrameTimestamp = p_high_resolution_clock::now();
+    int numFrames = AVATAR_WARMUP_FRAMES + AVATAR_MEASURED_FRAMES;
+    for (int frame = 1; frame <= numFrames; ++frame) {
+        // each avatar sends its data, off the clock
+        for (int i = 0; i < numNodes; ++i) {
+            float angle = walkPhases[i] + frame * AVATAR_FRAME_SECS * WALK_SPEED;
+            avatars[i]->setWorldPosition(positions[i] + glm::vec3(std::cos(angle), 0.0f, std::sin(angle)));
+            QByteArray avatarData = avatars[i]->toByteArrayStateful(AvatarData::CullSmallData);
+            avatars[i]->doneEncoding(true);
+
+            auto packet = NLPacket::create(PacketType::AvatarData, avatarData.size() + sizeof(AvatarDataSequenceNumber));
+            packet->writePrimitive((AvatarDataSequenceNumber)frame);
+            packet->write(avatarData);
+
+            auto data = static_cast<AvatarMixerClientData*>(nodes[i]->getLinkedData());
+            data->queuePacket(toMessage(*packet, nodes[i]->getLocalID()), nodes[i]);
+        }
+
+        // the mixer's frame, without the sleeps and the events
+        auto start = p_high_resolution_clock::now();
+        pool.processIncomingPackets(nodes.cbegin(), nodes.cend());
+        sharedData.avatarGrid.rebuild(nodes.cbegin(), nodes.cend(), frame);
+        pool.broadcastAvatarData(nodes.cbegin(), nodes.cend(), lastFrameTimestamp, MAX_KBPS_PER_NODE, 0.0f);
+        nodeList->flushSendBatch();
+        auto end = p_high_resolution_clock::now();
+        lastFrameTimestamp = start;
+
+        int thread = 0;
+        pool.each([&](AvatarMixerSlave& slave) {
+            AvatarMixerSlaveStats slaveStats;
+            slave.harvestStats(slaveStats);
+            if (frame > AVATAR_WARMUP_FRAMES) {
+                totalStats += slaveStats;
+                threadBusyUsecs[thread] += slaveStats.processIncomingPacketsElapsedTime + slaveStats.jobElapsedTime;
+            }
+            ++thread;
+        });
+
+        if (frame > AVATAR_WARMUP_FRAMES) {
+            auto frameNsecs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            frameTimes.nsecs.push_back(frameNsecs);
+            totalFrameUsecs += frameNsecs / NSECS_PER_USEC;
+        }
+    }
+
+    QStringList busy;
+    for (auto busyUsecs : threadBusyUsecs) {
+        busy << QString::number(totalFrameUsecs > 0 ? 100.0 * busyUsecs / totalFrameUsecs : 0.0, 'f', 1) + "%";
+    }
+    quint64 bytesSent = (quint64)totalStats.numDataBytesSent + totalStats.numTraitsBytesSent +
+        totalStats.numIdentityBytesSent;
+    qDebug().noquote() << "avatars included per frame" << (double)totalStats.numOthersIncluded / AVATAR_MEASURED_FRAMES
+        << "over budget" << (double)totalStats.overBudgetAvatars / AVATAR_MEASURED_FRAMES
+        << "bytes sent" << (double)bytesSent / AVATAR_MEASURED_FRAMES
+        << "threads busy" << busy.join(' ');
+    frameTimes.report(QString("avatar broadcast of %1 %2 nodes").arg(numNodes).arg(distributionName(distribution)));
+
+    QVERIFY(totalStats.nodesBroadcastedTo == numNodes * AVATAR_MEASURED_FRAMES);
+
+    nodeList->eraseAllNodes("MixerBenchmarks::benchmarkAvatarBroadcast");
+}
@@ -0,0 +1,36 @@
+//
+//  MixerBenchmarkTests.h
+//  tests/mixers/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_MixerBenchmarkTests_h
+#define overte_MixerBenchmarkTests_h
+
+#include <QtNetwork/QUdpSocket>
+#include <QtTest/QtTest>
+
+// Drives the audio and avatar mixer slave pools frame by frame over seeded populations of synthetic nodes, and
+// reports the time a frame takes, the share of it the slave threads were busy and the bytes the mixers sent.
+class MixerBenchmarks : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkAudioMix_data();
+    void benchmarkAudioMix();
+    void benchmarkAvatarBroadcast_data();
+    void benchmarkAvatarBroadcast();
+
+private:
+    // the mixes are sent here, and never read
+    QUdpSocket _sink;
+};
+
+#endif // overte_MixerBenchmarkTests_h
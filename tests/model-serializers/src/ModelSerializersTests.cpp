@@ -21,9 +21,14 @@
 #include "GLTFSerializer.h"
 #include "FBXSerializer.h"
 #include "OBJSerializer.h"
+#include "FBXWriter.h"
 
 #include "Gzip.h"
 #include "model-networking/ModelLoader.h"
+#include "model-networking/BakedModelCache.h"
+#include <model-baker/Baker.h>
+#include <model-baker/BuildMeshLODsTask.h>
+#include <model-baker/ReorderMeshesTask.h>
 #include <hfm/ModelFormatRegistry.h>
 #include "DependencyManager.h"
 #include "ResourceManager.h"
@@ -31,6 +36,10 @@
 #include "LimitedNodeList.h"
 #include "NodeList.h"
 
+#include <algorithm>
+#include <array>
+#include <random>
+
 #include <QUrl>
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
@@ -38,6 +47,7 @@
 #include <QByteArray>
 #include <QDebug>
 #include <QDirIterator>
+#include <QElapsedTimer>
 
 QTEST_MAIN(ModelSerializersTests)
 
@@ -141,7 +151,10 @@ void ModelSerializersTests::loadGLTF() {
 
 
 
+    QElapsedTimer timer;
+    timer.start();
     hfm::Model::Pointer model = loader.load(uncompressedData, serializerMapping, url, webMediaType);
+    qInfo() << "Parsed in" << timer.elapsed() << "ms";
     QVERIFY(expectParseFail == !model);
 
     if (!model) {
@@ -159,3 +172,241 @@ void ModelSerializersTests::loadGLTF() {
     QVERIFY(expectWarnings == (model->loadWarningCount>0));
     QVERIFY(expectErrors == (model->loadErrorCount>0));
 }
+
+// A grid of quads per mesh, enough meshes to keep every core busy extracting them
+static FBXNode createFBX(int numMeshes, int gridSize) {
+    FBXNode objects;
+    objects.name = "Objects";
+    for (int i = 0; i < numMeshes; i++) {
+        QVector<double> vertices;
+        for (int y = 0; y <= gridSize; y++) {
+            for (int x = 0; x <= gridSize; x++) {
+                vertices << x << y << i;
+            }
+        }
+        QVector<qint32> polygonIndices;
+        for (int y = 0; y < gridSize; y++) {
+            for (int x = 0; x < gridSize; x++) {
+                int corner = y * (gridSize + 1) + x;
+                // the last index of a polygon is stored negated, minus one
+                polygonIndices << corner << corner + 1 << corner + gridSize + 2 << -(corner + gridSize + 1) - 1;
+            }
+        }
+
+        FBXNode verticesNode;
+        verticesNode.name = "Vertices";
+        verticesNode.properties << QVariant::fromValue(vertices);
+        FBXNode indicesNode;
+        indicesNode.name = "PolygonVertexIndex";
+        indicesNode.properties << QVariant::fromValue(polygonIndices);
+
+        FBXNode geometry;
+        geometry.name = "Geometry";
+        geometry.properties << (qint64)(i + 1) << hifi::ByteArray("Geometry::") << hifi::ByteArray("Mesh");
+        geometry.children << verticesNode << indicesNode;
+        objects.children << geometry;
+    }
+
+    FBXNode root;
+    root.children << objects;
+    return root;
+}
+
+void ModelSerializersTests::benchmarkFBX() {
+    const int NUM_MESHES = 64;
+    const int GRID_SIZE = 100;
+    auto data = FBXWriter::encodeFBX(createFBX(NUM_MESHES, GRID_SIZE));
+    qInfo() << "Parsing" << NUM_MESHES << "meshes from" << data.size() << "bytes";
+
+    QBENCHMARK {
+        FBXSerializer serializer;
+        auto model = serializer.read(data, hifi::VariantHash());
+        QVERIFY(model);
+    }
+}
+
+void ModelSerializersTests::bakedModelRoundTrip() {
+    auto data = FBXWriter::encodeFBX(createFBX(4, 10));
+    FBXSerializer serializer;
+    auto hfmModel = serializer.read(data, hifi::VariantHash());
+    QVERIFY(hfmModel);
+    baker::Baker modelBaker(hfmModel, hifi::VariantHash(), hifi::URL());
+    modelBaker.run();
+    auto baked = modelBaker.getHFMModel();
+    QVERIFY(BakedModelCache::canSerialize(*baked));
+
+    auto serialized = BakedModelCache::serialize(*baked);
+    auto model = BakedModelCache::deserialize(serialized);
+    QVERIFY(model);
+    QCOMPARE(model->joints.size(), baked->joints.size());
+    QCOMPARE(model->jointIndices, baked->jointIndices);
+    QCOMPARE(model->materials.keys().toSet(), baked->materials.keys().toSet());
+    QCOMPARE(model->meshes.size(), baked->meshes.size());
+    for (int i = 0; i < baked->meshes.size(); i++) {
+        const auto& expected = baked->meshes[i];
+        const auto& actual = model->meshes[i];
+        QCOMPARE(actual.vertices, expected.vertices);
+        QCOMPARE(actual.normals, expected.normals);
+        QCOMPARE(actual.parts.size(), expected.parts.size());
+        QVERIFY(actual._mesh);
+        QCOMPARE(actual._mesh->getNumVertices(), expected._mesh->getNumVertices());
+        QCOMPARE(actual._mesh->getNumIndices(), expected._mesh->getNumIndices());
+        QCOMPARE(actual._mesh->getNumParts(), expected._mesh->getNumParts());
+        QCOMPARE(actual._mesh->getVertexFormat()->getNumAttributes(), expected._mesh->getVertexFormat()->getNumAttributes());
+    }
+
+    // anything cut short is rejected rather than read past its end
+    QVERIFY(!BakedModelCache::deserialize(serialized.left(serialized.size() / 2)));
+    QVERIFY(!BakedModelCache::deserialize(QByteArray()));
+}
+
+void ModelSerializersTests::bakeMeshLODs() {
+    const int GRID_SIZE = 40;
+    auto data = FBXWriter::encodeFBX(createFBX(1, GRID_SIZE));
+    FBXSerializer serializer;
+    // the vertices of the polygons are only shared once deduplicated, as the model cache loads them
+    hifi::VariantHash mapping;
+    mapping.insert("deduplicateIndices", true);
+    auto hfmModel = serializer.read(data, mapping);
+    QVERIFY(hfmModel);
+    baker::Baker modelBaker(hfmModel, hifi::VariantHash(), hifi::URL());
+    modelBaker.run();
+    auto baked = modelBaker.getHFMModel();
+    QCOMPARE(baked->meshes.size(), 1);
+
+    const auto& mesh = baked->meshes[0]._mesh;
+    QVERIFY(mesh);
+    const auto& lods = mesh->getLODs();
+    QVERIFY(!lods.empty());
+
+    auto fullPart = mesh->getPartBuffer().get<graphics::Mesh::Part>(0);
+    QCOMPARE((int)fullPart._numIndices, GRID_SIZE * GRID_SIZE * 6);
+    graphics::Index previousIndices = fullPart._numIndices;
+    graphics::Index nextIndex = fullPart._startIndex + fullPart._numIndices;
+    float previousError = 0.0f;
+    for (const auto& lod : lods) {
+        QCOMPARE(lod._parts.size(), (size_t)mesh->getNumParts());
+        const auto& part = lod._parts[0];
+        QCOMPARE(part._startIndex, nextIndex);
+        QVERIFY(part._numIndices < previousIndices);
+        QVERIFY(lod._error >= previousError);
+        nextIndex += part._numIndices;
+        previousIndices = part._numIndices;
+        previousError = lod._error;
+
+        // the meshlets cover the part, in order, within their limits
+        graphics::Index meshletIndex = part._startIndex;
+        for (const auto& meshlet : lod._meshlets) {
+            QCOMPARE(meshlet._startIndex, meshletIndex);
+            QVERIFY(meshlet._numIndices <= (graphics::Index)graphics::Mesh::Meshlet::MAX_MESHLET_TRIANGLES * 3);
+            meshletIndex += meshlet._numIndices;
+        }
+        QCOMPARE(meshletIndex, part._startIndex + part._numIndices);
+    }
+    QCOMPARE((size_t)nextIndex, mesh->getNumIndices());
+
+    // and they're kept by the baked model cache
+    auto model = BakedModelCache::deserialize(BakedModelCache::serialize(*baked));
+    QVERIFY(model);
+    QCOMPARE(model->meshes[0]._mesh->getLODs().size(), lods.size());
+    QCOMPARE(model->meshes[0]._mesh->getLODs().back()._parts[0]._numIndices, lods.back()._parts[0]._numIndices);
+}
+
+void ModelSerializersTests::reorderMeshes() {
+    // a grid with its triangles shuffled, so that hardly any vertex is still in the cache when it's used again
+    const int GRID_SIZE = 40;
+    hfm::Mesh mesh;
+    std::vector<std::array<int, 3>> triangles;
+    for (int y = 0; y <= GRID_SIZE; y++) {
+        for (int x = 0; x <= GRID_SIZE; x++) {
+            mesh.vertices.push_back(glm::vec3(x, y, 0.0f));
+            mesh.texCoords.push_back(glm::vec2(x, y));
+        }
+    }
+    for (int y = 0; y < GRID_SIZE; y++) {
+        for (int x = 0; x < GRID_SIZE; x++) {
+            int corner = y * (GRID_SIZE + 1) + x;
+            triangles.push_back({ { corner, corner + 1, corner + GRID_SIZE + 2 } });
+            triangles.push_back({ { corner, corner + GRID_SIZE + 2, corner + GRID_SIZE + 1 } });
+        }
+    }
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937(1));
+    hfm::MeshPart part;
+    for (const auto& triangle : triangles) {
+        part.triangleIndices << triangle[0] << triangle[1] << triangle[2];
+    }
+    mesh.parts.push_back(part);
+
+    std::vector<hfm::Blendshape> blendshapes(1);
+    blendshapes[0].indices << 0 << mesh.vertices.size() - 1;
+    glm::vec3 firstCorner = mesh.vertices.front();
+    glm::vec3 lastCorner = mesh.vertices.back();
+
+    const int numVertices = mesh.vertices.size();
+    baker::MeshIndices before(part.triangleIndices.begin(), part.triangleIndices.end());
+    baker::reorderMesh(mesh, blendshapes);
+    const auto& reordered = mesh.parts[0].triangleIndices;
+    baker::MeshIndices after(reordered.begin(), reordered.end());
+    QCOMPARE(after.size(), before.size());
+    QVERIFY(baker::computeACMR(after, numVertices) < baker::computeACMR(before, numVertices) * 0.5f);
+
+    // the vertices are in the order the triangles use them, with their attributes and blendshapes
+    QCOMPARE(after[0], 0);
+    for (int i = 0; i < numVertices; i++) {
+        QVERIFY(mesh.texCoords[i] == glm::vec2(mesh.vertices[i]));
+    }
+    QVERIFY(mesh.vertices[blendshapes[0].indices[0]] == firstCorner);
+    QVERIFY(mesh.vertices[blendshapes[0].indices[1]] == lastCorner);
+}
+
+void ModelSerializersTests::bakePreviewModel() {
+    const int GRID_SIZE = 40;
+    auto data = FBXWriter::encodeFBX(createFBX(1, GRID_SIZE));
+    FBXSerializer serializer;
+    hifi::VariantHash mapping;
+    mapping.insert("deduplicateIndices", true);
+    auto hfmModel = serializer.read(data, mapping);
+    QVERIFY(hfmModel);
+    QCOMPARE(hfmModel->meshes.size(), 1);
+
+    auto preview = baker::buildPreviewModel(*hfmModel);
+    QVERIFY(preview);
+    QCOMPARE(preview->meshes.size(), hfmModel->meshes.size());
+    const auto& fullMesh = hfmModel->meshes[0];
+    const auto& previewMesh = preview->meshes[0];
+    QCOMPARE(previewMesh.parts.size(), fullMesh.parts.size());
+
+    // the preview only keeps the vertices of its fewer triangles
+    int fullIndices = 0;
+    for (const auto& part : fullMesh.parts) {
+        fullIndices += part.quadTrianglesIndices.size() + part.triangleIndices.size();
+    }
+    const auto& previewPart = previewMesh.parts[0];
+    QVERIFY(previewPart.quadTrianglesIndices.isEmpty());
+    QVERIFY(previewPart.triangleIndices.size() > 0);
+    QVERIFY(previewPart.triangleIndices.size() < fullIndices / 4);
+    QVERIFY(previewMesh.vertices.size() < fullMesh.vertices.size());
+    for (int index : previewPart.triangleIndices) {
+        QVERIFY(index >= 0 && index < previewMesh.vertices.size());
+    }
+    // with the dimensions of the model
+    QVERIFY(previewMesh.meshExtents.minimum == fullMesh.meshExtents.minimum);
+    QVERIFY(previewMesh.meshExtents.maximum == fullMesh.meshExtents.maximum);
+    // and without textures
+    for (const auto& material : preview->materials) {
+        QVERIFY(material.albedoTexture.filename.isEmpty());
+    }
+
+    // it's baked and stored as the baked model cache stores models
+    baker::Baker modelBaker(preview, hifi::VariantHash(), hifi::URL());
+    modelBaker.run();
+    auto baked = modelBaker.getHFMModel();
+    auto model = BakedModelCache::deserialize(BakedModelCache::serialize(*baked));
+    QVERIFY(model);
+    QCOMPARE(model->meshes.size(), 1);
+    QCOMPARE((int)model->meshes[0]._mesh->getNumVertices(), previewMesh.vertices.size());
+
+    // the models with vertices the preview couldn't match have none
+    hfmModel->meshes[0].blendshapes.push_back(hfm::Blendshape());
+    QVERIFY(!baker::buildPreviewModel(*hfmModel));
+}
@@ -21,6 +21,11 @@ private slots:
     void initTestCase();
     void loadGLTF_data();
     void loadGLTF();
+    void benchmarkFBX();
+    void bakedModelRoundTrip();
+    void bakeMeshLODs();
+    void reorderMeshes();
+    void bakePreviewModel();
 
 };
 
@@ -0,0 +1,102 @@
+//
+//  ContentCacheTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ContentCacheTests.h"
+
+#include <AssetUtils.h>
+#include <ContentCache.h>
+
+QTEST_GUILESS_MAIN(ContentCacheTests)
+
+static const qint64 MAXIMUM_SIZE { 1024 * 1024 * 10 };
+static const QByteArray TEST_DATA { 64 * 1024, 'x' };
+
+static void store(ContentCache& cache, const QUrl& url, const QByteArray& data) {
+    QNetworkCacheMetaData metaData;
+    metaData.setUrl(url);
+    metaData.setSaveToDisk(true);
+    auto device = cache.prepare(metaData);
+    QVERIFY(device);
+    device->write(data);
+    cache.insert(device);
+}
+
+static QByteArray load(ContentCache& cache, const QUrl& url) {
+    std::unique_ptr<QIODevice> device { cache.data(url) };
+    return device ? device->readAll() : QByteArray();
+}
+
+void ContentCacheTests::sharedContentTest() {
+    ContentCache cache(QDir(_testDir.path()).filePath("shared"), MAXIMUM_SIZE);
+    QUrl atpUrl("atp:/" + AssetUtils::hashData(TEST_DATA).toHex());
+    QUrl httpUrl("http://example.com/asset.bin");
+    store(cache, atpUrl, TEST_DATA);
+    store(cache, httpUrl, TEST_DATA);
+
+    // served from memory until written
+    QCOMPARE(load(cache, httpUrl), TEST_DATA);
+
+    cache.flush();
+    QCOMPARE(cache.cacheSize(), (qint64)TEST_DATA.size());
+    QCOMPARE(cache.getContentHash(atpUrl), cache.getContentHash(httpUrl));
+    QCOMPARE(load(cache, atpUrl), TEST_DATA);
+    QCOMPARE(load(cache, httpUrl), TEST_DATA);
+}
+
+void ContentCacheTests::metaDataTest() {
+    ContentCache cache(QDir(_testDir.path()).filePath("metadata"), MAXIMUM_SIZE);
+    QUrl url("http://example.com/model.fst");
+    store(cache, url, TEST_DATA);
+
+    auto metaData = cache.metaData(url);
+    QVERIFY(metaData.isValid());
+    QCOMPARE(metaData.url(), url);
+
+    QDateTime lastModified = QDateTime::fromMSecsSinceEpoch(1000000000000);
+    metaData.setLastModified(lastModified);
+    cache.updateMetaData(metaData);
+    QCOMPARE(cache.metaData(url).lastModified(), lastModified);
+
+    QVERIFY(!cache.metaData(QUrl("http://example.com/missing.fst")).isValid());
+    QVERIFY(!cache.data(QUrl("http://example.com/missing.fst")));
+}
+
+void ContentCacheTests::removeTest() {
+    ContentCache cache(QDir(_testDir.path()).filePath("remove"), MAXIMUM_SIZE);
+    QUrl first("http://example.com/first.png");
+    QUrl second("http://example.com/second.png");
+    store(cache, first, TEST_DATA);
+    store(cache, second, TEST_DATA);
+    cache.flush();
+
+    QVERIFY(cache.remove(first));
+    QVERIFY(!cache.remove(first));
+    QVERIFY(!cache.metaData(first).isValid());
+    QCOMPARE(load(cache, second), TEST_DATA);
+}
+
+void ContentCacheTests::persistenceTest() {
+    QString directory = QDir(_testDir.path()).filePath("persistence");
+    QUrl url("http://example.com/texture.ktx");
+    {
+        ContentCache cache(directory, MAXIMUM_SIZE);
+        store(cache, url, TEST_DATA);
+    }
+
+    ContentCache cache(directory, MAXIMUM_SIZE);
+    QCOMPARE(cache.cacheSize(), (qint64)TEST_DATA.size());
+    QCOMPARE(cache.metaData(url).url(), url);
+    QCOMPARE(load(cache, url), TEST_DATA);
+
+    cache.clear();
+    QCOMPARE(cache.cacheSize(), (qint64)0);
+    QVERIFY(!cache.metaData(url).isValid());
+}
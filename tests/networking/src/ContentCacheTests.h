@@ -0,0 +1,30 @@
+//
+//  ContentCacheTests.h
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ContentCacheTests_h
+#define overte_ContentCacheTests_h
+
+#include <QtTest/QtTest>
+#include <QtCore/QTemporaryDir>
+
+class ContentCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void sharedContentTest();
+    void metaDataTest();
+    void removeTest();
+    void persistenceTest();
+
+private:
+    QTemporaryDir _testDir;
+};
+
+#endif // overte_ContentCacheTests_h
@@ -0,0 +1,150 @@
+//
+//  ForwardErrorCorrectionTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ForwardErrorCorrectionTests.h"
+
+#include <cstring>
+
+#include <udt/ControlPacket.h>
+#include <udt/ForwardErrorCorrection.h>
+#include <udt/Packet.h>
+
+QTEST_MAIN(ForwardErrorCorrectionTests)
+
+using namespace udt;
+
+static std::unique_ptr<Packet> createPacket(SequenceNumber sequenceNumber, int payloadSize) {
+    auto packet = Packet::create(payloadSize, false);
+    for (int i = 0; i < payloadSize; ++i) {
+        char byte = (char)((uint32_t)sequenceNumber * 31 + i);
+        packet->write(&byte, 1);
+    }
+    packet->writeSequenceNumber(sequenceNumber);
+    return packet;
+}
+
+// what the other end reads off the wire
+template <typename T>
+static std::unique_ptr<T> receive(const BasePacket& sent) {
+    auto data = PacketBufferPool::allocate(sent.getDataSize());
+    std::memcpy(data.get(), sent.getData(), sent.getDataSize());
+    return T::fromReceivedPacket(std::move(data), sent.getDataSize(), SockAddr());
+}
+
+// feeds the decoder packets with 4% of them lost, the next update asks for groups of 4
+static SequenceNumber primeDecoder(FECDecoder& decoder) {
+    SequenceNumber sequenceNumber;
+    for (int i = 0; i < 100; ++i, ++sequenceNumber) {
+        if (i % 25 != 24) {
+            decoder.processReceivedPacket(*receive<Packet>(*createPacket(sequenceNumber, 100)), false);
+        }
+    }
+    return sequenceNumber;
+}
+
+void ForwardErrorCorrectionTests::groupSizeForLossRateTest() {
+    QCOMPARE(fec::groupSizeForLossRate(0.0f, 0), 0);
+    QCOMPARE(fec::groupSizeForLossRate(0.01f, 0), 8);
+    QCOMPARE(fec::groupSizeForLossRate(0.03f, 8), 4);
+    QCOMPARE(fec::groupSizeForLossRate(0.2f, 4), 2);
+
+    // once on, parity stays on until the loss has clearly gone away
+    QCOMPARE(fec::groupSizeForLossRate(0.003f, 0), 0);
+    QCOMPARE(fec::groupSizeForLossRate(0.003f, 8), 8);
+    QCOMPARE(fec::groupSizeForLossRate(0.001f, 8), 0);
+}
+
+void ForwardErrorCorrectionTests::requestFromLossTest() {
+    FECDecoder decoder;
+    QCOMPARE(decoder.getRequestedGroupSize(), 0);
+
+    auto now = p_high_resolution_clock::now();
+    primeDecoder(decoder);
+    QVERIFY(decoder.updateRequestedGroupSize(now));
+    QCOMPARE(decoder.getRequestedGroupSize(), 4);
+
+    // nothing new until the next update interval
+    QVERIFY(!decoder.updateRequestedGroupSize(now));
+
+    // the sender goes quiet if the requests stop
+    FECEncoder encoder;
+    encoder.setGroupSize(decoder.getRequestedGroupSize(), now);
+    QCOMPARE(encoder.getGroupSize(), 4);
+    for (int i = 0; i < 8; ++i) {
+        QVERIFY(!encoder.addPacket(*createPacket(SequenceNumber(i), 100), now + std::chrono::seconds(10)));
+    }
+    QCOMPARE(encoder.getGroupSize(), 0);
+}
+
+void ForwardErrorCorrectionTests::recoverTest() {
+    auto now = p_high_resolution_clock::now();
+
+    FECDecoder decoder;
+    auto sequenceNumber = primeDecoder(decoder);
+    decoder.updateRequestedGroupSize(now);
+
+    FECEncoder encoder;
+    encoder.setGroupSize(decoder.getRequestedGroupSize(), now);
+
+    // a group of four protected packets of different sizes, with an unprotected packet in amongst them
+    std::vector<std::unique_ptr<Packet>> sent;
+    std::unique_ptr<ControlPacket> parityPacket;
+    for (int i = 0; i < 5; ++i, ++sequenceNumber) {
+        sent.push_back(createPacket(sequenceNumber, 100 + 50 * i));
+        if (i != 1) {
+            QVERIFY(!parityPacket);
+            parityPacket = encoder.addPacket(*sent.back(), now);
+        }
+    }
+    QVERIFY(parityPacket);
+
+    // lose the fourth packet
+    for (int i = 0; i < 5; ++i) {
+        if (i != 3) {
+            QVERIFY(decoder.processReceivedPacket(*receive<Packet>(*sent[i]), false));
+        }
+    }
+
+    auto recovered = decoder.recoverPacket(*receive<ControlPacket>(*parityPacket));
+    QVERIFY(recovered.data);
+    QCOMPARE(recovered.size, (int)sent[3]->getDataSize());
+    QCOMPARE(std::memcmp(recovered.data.get(), sent[3]->getData(), recovered.size), 0);
+
+    auto recoveredPacket = Packet::fromReceivedPacket(std::move(recovered.data), recovered.size, SockAddr());
+    QCOMPARE(recoveredPacket->getSequenceNumber(), sent[3]->getSequenceNumber());
+    QVERIFY(decoder.processReceivedPacket(*recoveredPacket, true));
+
+    // the original turning up late is a duplicate
+    QVERIFY(!decoder.processReceivedPacket(*receive<Packet>(*sent[3]), false));
+}
+
+void ForwardErrorCorrectionTests::twoLostTest() {
+    auto now = p_high_resolution_clock::now();
+
+    FECDecoder decoder;
+    auto sequenceNumber = primeDecoder(decoder);
+    decoder.updateRequestedGroupSize(now);
+
+    FECEncoder encoder;
+    encoder.setGroupSize(decoder.getRequestedGroupSize(), now);
+
+    std::unique_ptr<ControlPacket> parityPacket;
+    for (int i = 0; i < 4; ++i, ++sequenceNumber) {
+        auto packet = createPacket(sequenceNumber, 200);
+        parityPacket = encoder.addPacket(*packet, now);
+        if (i % 2 == 0) {
+            decoder.processReceivedPacket(*receive<Packet>(*packet), false);
+        }
+    }
+    QVERIFY(parityPacket);
+
+    QVERIFY(!decoder.recoverPacket(*receive<ControlPacket>(*parityPacket)).data);
+}
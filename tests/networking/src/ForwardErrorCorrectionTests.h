@@ -0,0 +1,26 @@
+//
+//  ForwardErrorCorrectionTests.h
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ForwardErrorCorrectionTests_h
+#define overte_ForwardErrorCorrectionTests_h
+
+#include <QtTest/QtTest>
+
+class ForwardErrorCorrectionTests : public QObject {
+    Q_OBJECT
+private slots:
+    void groupSizeForLossRateTest();
+    void requestFromLossTest();
+    void recoverTest();
+    void twoLostTest();
+};
+
+#endif // overte_ForwardErrorCorrectionTests_h
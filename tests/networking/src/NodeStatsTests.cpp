@@ -0,0 +1,114 @@
+//
+//  NodeStatsTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "NodeStatsTests.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+
+#include <NodeStats.h>
+
+QTEST_MAIN(NodeStatsTests)
+
+static QJsonObject listenerStats(int index) {
+    return QJsonObject {
+        { "username", QString("listener%1").arg(index) },
+        { "jitter", QJsonObject { { "frames_available", index }, { "starves", 0 }, { "lag", -index * 1.5 } } },
+        { "dropping", index % 2 == 0 }
+    };
+}
+
+static QJsonObject mixerStats() {
+    QJsonObject listeners;
+    for (int i = 0; i < 20; ++i) {
+        listeners[QString("{%1}").arg(i)] = listenerStats(i);
+    }
+    return QJsonObject {
+        { "io_stats", QJsonObject { { "inbound_kbps", 1234.5 }, { "outbound_pps", 300 } } },
+        { "negative", -42 },
+        { "large", 1e300 },
+        { "empty", QJsonObject() },
+        { "nothing", QJsonValue() },
+        { "values", QJsonArray { 1, 2.5, "three", true, QJsonArray { 4 } } },
+        { "listeners", listeners }
+    };
+}
+
+void NodeStatsTests::roundTripTest() {
+    QJsonObject stats = mixerStats();
+
+    NodeStats decoded;
+    QVERIFY(decoded.decode(NodeStats::encode(stats)));
+    QCOMPARE(decoded.toJson(), stats);
+
+    NodeStats empty;
+    QVERIFY(empty.decode(NodeStats::encode(QJsonObject())));
+    QCOMPARE(empty.toJson(), QJsonObject());
+}
+
+void NodeStatsTests::compactTest() {
+    // the names repeated by every listener are only sent once
+    QJsonObject stats = mixerStats();
+    QVERIFY(NodeStats::encode(stats).size() < QJsonDocument(stats).toJson(QJsonDocument::Compact).size() / 2);
+}
+
+void NodeStatsTests::malformedTest() {
+    QByteArray data = NodeStats::encode(mixerStats());
+
+    NodeStats decoded;
+    for (int size = 0; size < data.size(); ++size) {
+        QVERIFY(!decoded.decode(data.left(size)));
+        QVERIFY(decoded.getEntries().empty());
+    }
+
+    QByteArray newerSchema = data;
+    newerSchema[0] = (char)(NodeStats::SCHEMA_VERSION + 1);
+    QVERIFY(!decoded.decode(newerSchema));
+
+    QVERIFY(!decoded.decode(data + QByteArray(1, '\0')));
+}
+
+void NodeStatsTests::pathTest() {
+    NodeStats decoded;
+    QVERIFY(decoded.decode(NodeStats::encode(mixerStats())));
+
+    int index = decoded.findEntry("io_stats.inbound_kbps");
+    QVERIFY(index != -1);
+    QCOMPARE(decoded.getEntries()[index].number, 1234.5);
+    QCOMPARE(decoded.getPath(index), QString("io_stats.inbound_kbps"));
+
+    index = decoded.findEntry("listeners.{3}.jitter.frames_available");
+    QVERIFY(index != -1);
+    QCOMPARE(decoded.getEntries()[index].number, 3.0);
+
+    index = decoded.findEntry("values.1");
+    QVERIFY(index != -1);
+    QCOMPARE(decoded.getEntries()[index].number, 2.5);
+
+    QCOMPARE(decoded.findEntry("io_stats.missing"), -1);
+}
+
+void NodeStatsTests::overrideTest() {
+    NodeStats decoded;
+    QVERIFY(decoded.decode(NodeStats::encode(mixerStats())));
+
+    QJsonObject stats = decoded.toJson([](const QString& name, const QString& value, QString& overrideValue) {
+        if (name == "username" && value == "listener3") {
+            overrideValue = "alice";
+            return true;
+        }
+        return false;
+    });
+    QCOMPARE(stats["listeners"].toObject()["{3}"].toObject()["username"].toString(), QString("alice"));
+    QCOMPARE(stats["listeners"].toObject()["{4}"].toObject()["username"].toString(), QString("listener4"));
+    // the strings in arrays have no name to be overridden by
+    QCOMPARE(stats["values"].toArray()[2].toString(), QString("three"));
+}
@@ -0,0 +1,27 @@
+//
+//  NodeStatsTests.h
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_NodeStatsTests_h
+#define overte_NodeStatsTests_h
+
+#include <QtTest/QtTest>
+
+class NodeStatsTests : public QObject {
+    Q_OBJECT
+private slots:
+    void roundTripTest();
+    void compactTest();
+    void malformedTest();
+    void pathTest();
+    void overrideTest();
+};
+
+#endif // overte_NodeStatsTests_h
@@ -0,0 +1,85 @@
+//
+//  PacketBufferPoolTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "PacketBufferPoolTests.h"
+
+#include <thread>
+
+#include <NLPacket.h>
+#include <udt/PacketBufferPool.h>
+
+QTEST_MAIN(PacketBufferPoolTests)
+
+using namespace udt;
+
+void PacketBufferPoolTests::recycleTest() {
+    if (!PacketBufferPool::isEnabled()) {
+        QSKIP("Packet buffer pool disabled at build time");
+    }
+
+    auto buffer = PacketBufferPool::allocate(PacketBufferPool::SLAB_SIZE);
+    QVERIFY(buffer.get_deleter().isPooled);
+    char* slab = buffer.get();
+
+    auto before = PacketBufferPool::getStats();
+    buffer.reset();
+    QCOMPARE(PacketBufferPool::getStats().outstanding, before.outstanding - 1);
+
+    // the slab we just released is the first one handed out again on this thread
+    auto recycled = PacketBufferPool::allocate(100);
+    QCOMPARE(recycled.get(), slab);
+    QCOMPARE(PacketBufferPool::getStats().hits, before.hits + 1);
+    QVERIFY(PacketBufferPool::getStats().highWaterMark >= PacketBufferPool::getStats().outstanding);
+}
+
+void PacketBufferPoolTests::oversizedTest() {
+    auto before = PacketBufferPool::getStats();
+    auto buffer = PacketBufferPool::allocate(PacketBufferPool::SLAB_SIZE + 1);
+    QVERIFY(!buffer.get_deleter().isPooled);
+    QCOMPARE(PacketBufferPool::getStats().outstanding, before.outstanding);
+}
+
+void PacketBufferPoolTests::crossThreadReleaseTest() {
+    if (!PacketBufferPool::isEnabled()) {
+        QSKIP("Packet buffer pool disabled at build time");
+    }
+
+    auto before = PacketBufferPool::getStats();
+
+    // slabs allocated here and freed on another thread must not be lost
+    const int NUM_BUFFERS = 1000;
+    std::vector<PacketBuffer> buffers;
+    for (int i = 0; i < NUM_BUFFERS; ++i) {
+        buffers.push_back(PacketBufferPool::allocate(PacketBufferPool::SLAB_SIZE));
+    }
+
+    std::thread releaser([&buffers] {
+        buffers.clear();
+    });
+    releaser.join();
+
+    QCOMPARE(PacketBufferPool::getStats().outstanding, before.outstanding);
+}
+
+void PacketBufferPoolTests::packetTest() {
+    auto before = PacketBufferPool::getStats();
+    {
+        auto packet = NLPacket::create(PacketType::Unknown);
+        QCOMPARE(packet->getPayloadSize(), 0);
+        if (PacketBufferPool::isEnabled()) {
+            QCOMPARE(PacketBufferPool::getStats().outstanding, before.outstanding + 1);
+        }
+
+        auto copy = NLPacket::createCopy(*packet);
+        QCOMPARE(copy->getDataSize(), packet->getDataSize());
+    }
+    QCOMPARE(PacketBufferPool::getStats().outstanding, before.outstanding);
+}
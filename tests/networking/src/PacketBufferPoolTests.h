@@ -0,0 +1,26 @@
+//
+//  PacketBufferPoolTests.h
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_PacketBufferPoolTests_h
+#define overte_PacketBufferPoolTests_h
+
+#include <QtTest/QtTest>
+
+class PacketBufferPoolTests : public QObject {
+    Q_OBJECT
+private slots:
+    void recycleTest();
+    void oversizedTest();
+    void crossThreadReleaseTest();
+    void packetTest();
+};
+
+#endif // overte_PacketBufferPoolTests_h
@@ -0,0 +1,148 @@
+//
+//  ReceivedMessageTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ReceivedMessageTests.h"
+
+#include <cstring>
+
+#include <NLPacket.h>
+#include <ReceivedMessage.h>
+
+QTEST_MAIN(ReceivedMessageTests)
+
+using namespace udt;
+
+static const int PAYLOAD_SIZE = 100;
+
+static char byteAt(int position) {
+    return (char)(position * 7 + 3);
+}
+
+// a packet as it would come off the wire, holding bytes [first, first + PAYLOAD_SIZE) of the message
+static std::unique_ptr<NLPacket> createReceivedPacket(int first, Packet::PacketPosition position) {
+    auto packet = NLPacket::create(PacketType::EntityData, PAYLOAD_SIZE, true, position != Packet::ONLY);
+    for (int i = first; i < first + PAYLOAD_SIZE; ++i) {
+        char byte = byteAt(i);
+        packet->write(&byte, 1);
+    }
+    if (position != Packet::ONLY) {
+        packet->writeMessageNumber(1, position, first / PAYLOAD_SIZE);
+    }
+
+    auto size = packet->getDataSize();
+    auto data = std::unique_ptr<char[]>(new char[size]);
+    memcpy(data.get(), packet->getData(), size);
+    return NLPacket::fromReceivedPacket(std::move(data), size, SockAddr());
+}
+
+static std::unique_ptr<ReceivedMessage> createMessage(int numPackets) {
+    if (numPackets == 1) {
+        return std::unique_ptr<ReceivedMessage>(new ReceivedMessage(createReceivedPacket(0, Packet::ONLY)));
+    }
+
+    std::unique_ptr<ReceivedMessage> message(new ReceivedMessage(createReceivedPacket(0, Packet::FIRST)));
+    for (int i = 1; i < numPackets; ++i) {
+        message->appendPacket(createReceivedPacket(i * PAYLOAD_SIZE, i == numPackets - 1 ? Packet::LAST : Packet::MIDDLE));
+    }
+    return message;
+}
+
+static bool matches(const char* data, int first, int size) {
+    for (int i = 0; i < size; ++i) {
+        if (data[i] != byteAt(first + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ReceivedMessageTests::singlePacketTest() {
+    auto message = createMessage(1);
+
+    QCOMPARE(message->isComplete(), true);
+    QCOMPARE(message->getSize(), (qint64)PAYLOAD_SIZE);
+    QVERIFY(matches(message->getRawMessage(), 0, PAYLOAD_SIZE));
+
+    char head[10];
+    QCOMPARE(message->readHead(head, sizeof(head)), (qint64)sizeof(head));
+    QVERIFY(matches(head, 0, sizeof(head)));
+
+    auto rest = message->readWithoutCopy(message->getBytesLeftToRead());
+    QCOMPARE(rest.size(), PAYLOAD_SIZE - (int)sizeof(head));
+    QVERIFY(matches(rest.constData(), sizeof(head), rest.size()));
+    QCOMPARE(message->getBytesLeftToRead(), (qint64)0);
+}
+
+void ReceivedMessageTests::readAcrossPacketsTest() {
+    auto message = createMessage(3);
+
+    QCOMPARE(message->isComplete(), true);
+    QCOMPARE(message->getNumPackets(), (qint64)3);
+    QCOMPARE(message->getSize(), (qint64)3 * PAYLOAD_SIZE);
+
+    // straddling the first two packets
+    message->seek(PAYLOAD_SIZE - 10);
+    char data[20];
+    QCOMPARE(message->read(data, sizeof(data)), (qint64)sizeof(data));
+    QVERIFY(matches(data, PAYLOAD_SIZE - 10, sizeof(data)));
+
+    auto bytes = message->read(2 * PAYLOAD_SIZE);
+    QCOMPARE(bytes.size(), 2 * PAYLOAD_SIZE - 10);
+    QVERIFY(matches(bytes.constData(), PAYLOAD_SIZE + 10, bytes.size()));
+    QCOMPARE(message->getBytesLeftToRead(), (qint64)0);
+
+    message->seek(0);
+    auto all = message->readAll();
+    QCOMPARE(all.size(), 3 * PAYLOAD_SIZE);
+    QVERIFY(matches(all.constData(), 0, all.size()));
+}
+
+void ReceivedMessageTests::spansTest() {
+    auto message = createMessage(3);
+
+    message->seek(PAYLOAD_SIZE / 2);
+    auto spans = message->peekSpans(2 * PAYLOAD_SIZE);
+    QCOMPARE((int)spans.size(), 3);
+    QCOMPARE(spans[0].size, (qint64)PAYLOAD_SIZE / 2);
+    QCOMPARE(spans[1].size, (qint64)PAYLOAD_SIZE);
+    QCOMPARE(spans[2].size, (qint64)PAYLOAD_SIZE / 2);
+    QVERIFY(matches(spans[1].data, PAYLOAD_SIZE, PAYLOAD_SIZE));
+    QCOMPARE(message->getPosition(), (qint64)PAYLOAD_SIZE / 2);
+
+    // within one packet, and clipped to the end of the message
+    spans = message->readSpans(10);
+    QCOMPARE((int)spans.size(), 1);
+    QVERIFY(matches(spans[0].data, PAYLOAD_SIZE / 2, 10));
+
+    message->seek(3 * PAYLOAD_SIZE - 5);
+    spans = message->readSpans(PAYLOAD_SIZE);
+    QCOMPARE((int)spans.size(), 1);
+    QCOMPARE(spans[0].size, (qint64)5);
+    QCOMPARE(message->getBytesLeftToRead(), (qint64)0);
+    QVERIFY(message->readSpans(1).empty());
+}
+
+void ReceivedMessageTests::contiguousTest() {
+    auto message = createMessage(3);
+
+    message->seek(PAYLOAD_SIZE - 5);
+    auto straddling = message->readWithoutCopy(10);
+    QVERIFY(matches(straddling.constData(), PAYLOAD_SIZE - 5, 10));
+
+    QVERIFY(matches(message->getRawMessage(), 0, 3 * PAYLOAD_SIZE));
+    QCOMPARE(message->getMessage().size(), 3 * PAYLOAD_SIZE);
+
+    // reads keep working on the flattened message
+    message->seek(PAYLOAD_SIZE);
+    auto spans = message->readSpans(2 * PAYLOAD_SIZE);
+    QCOMPARE((int)spans.size(), 1);
+    QVERIFY(matches(spans[0].data, PAYLOAD_SIZE, 2 * PAYLOAD_SIZE));
+}
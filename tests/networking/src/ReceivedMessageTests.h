@@ -0,0 +1,26 @@
+//
+//  ReceivedMessageTests.h
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ReceivedMessageTests_h
+#define overte_ReceivedMessageTests_h
+
+#include <QtTest/QtTest>
+
+class ReceivedMessageTests : public QObject {
+    Q_OBJECT
+private slots:
+    void singlePacketTest();
+    void readAcrossPacketsTest();
+    void spansTest();
+    void contiguousTest();
+};
+
+#endif // overte_ReceivedMessageTests_h
@@ -0,0 +1,104 @@
+//
+//  ResourcePrefetcherTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ResourcePrefetcherTests.h"
+
+#include <ResourcePrefetcher.h>
+
+QTEST_MAIN(ResourcePrefetcherTests)
+
+static const QString CACHE = "TextureCache";
+
+void ResourcePrefetcherTests::rankingTest() {
+    PrefetchManifest manifest;
+    manifest.beginVisit();
+    manifest.recordRequest("http://a", CACHE);
+    manifest.recordRequest("http://b", CACHE);
+    manifest.beginVisit();
+    manifest.recordRequest("http://c", CACHE);
+    manifest.recordRequest("http://b", CACHE);
+
+    // b was needed by both visits, then c was needed by the latest one, a by an earlier one
+    auto selected = manifest.select(10, 0);
+    QCOMPARE((int)selected.size(), 3);
+    QCOMPARE(selected[0].url, QString("http://b"));
+    QCOMPARE(selected[1].url, QString("http://c"));
+    QCOMPARE(selected[2].url, QString("http://a"));
+    QCOMPARE(manifest.getNumVisits(), (uint32_t)2);
+
+    selected = manifest.select(1, 0);
+    QCOMPARE((int)selected.size(), 1);
+    QCOMPARE(selected[0].url, QString("http://b"));
+}
+
+void ResourcePrefetcherTests::visitDedupeTest() {
+    PrefetchManifest manifest;
+    manifest.beginVisit();
+    QVERIFY(manifest.recordRequest("http://a", CACHE));
+    QVERIFY(!manifest.recordRequest("http://a", CACHE));
+    QCOMPARE(manifest.getEntry("http://a")->visits, (uint32_t)1);
+
+    manifest.beginVisit();
+    QVERIFY(manifest.recordRequest("http://a", CACHE));
+    QCOMPARE(manifest.getEntry("http://a")->visits, (uint32_t)2);
+    QCOMPARE(manifest.getEntry("http://a")->order, (uint32_t)0);
+}
+
+void ResourcePrefetcherTests::byteBudgetTest() {
+    PrefetchManifest manifest;
+    manifest.beginVisit();
+    manifest.recordRequest("http://big", CACHE);
+    manifest.recordRequest("http://small", CACHE);
+    manifest.setSize("http://big", 1000);
+    manifest.setSize("http://small", 100);
+
+    // the entries over the budget are skipped, not the ones after them
+    auto selected = manifest.select(10, 500);
+    QCOMPARE((int)selected.size(), 1);
+    QCOMPARE(selected[0].url, QString("http://small"));
+    QCOMPARE(selected[0].size, (qint64)100);
+}
+
+void ResourcePrefetcherTests::pruneTest() {
+    PrefetchManifest manifest;
+    manifest.beginVisit();
+    manifest.recordRequest("http://kept", CACHE);
+    manifest.beginVisit();
+    manifest.recordRequest("http://kept", CACHE);
+    for (int i = 0; i < PrefetchManifest::MAX_ENTRIES; ++i) {
+        manifest.recordRequest(QString("http://%1").arg(i), CACHE);
+    }
+
+    QVERIFY(manifest.getNumEntries() <= PrefetchManifest::MAX_ENTRIES);
+    QVERIFY(manifest.getEntry("http://kept"));
+    // the requests made last in the visit rank lowest
+    QVERIFY(manifest.getEntry("http://0"));
+    QVERIFY(!manifest.getEntry(QString("http://%1").arg(PrefetchManifest::MAX_ENTRIES - 1)));
+}
+
+void ResourcePrefetcherTests::jsonTest() {
+    PrefetchManifest manifest;
+    manifest.beginVisit();
+    manifest.recordRequest("http://a", CACHE);
+    manifest.recordRequest("http://b", "ModelCache");
+    manifest.setSize("http://b", 4096);
+
+    auto copy = PrefetchManifest::fromJson(manifest.toJson());
+    QCOMPARE(copy.getNumVisits(), manifest.getNumVisits());
+    QCOMPARE(copy.getLastVisitTime(), manifest.getLastVisitTime());
+    QCOMPARE(copy.getNumEntries(), 2);
+    auto entry = copy.getEntry("http://b");
+    QVERIFY(entry);
+    QCOMPARE(entry->cache, QString("ModelCache"));
+    QCOMPARE(entry->size, (qint64)4096);
+    QCOMPARE(entry->order, (uint32_t)1);
+    QCOMPARE(entry->visits, (uint32_t)1);
+}
@@ -0,0 +1,27 @@
+//
+//  ResourcePrefetcherTests.h
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ResourcePrefetcherTests_h
+#define overte_ResourcePrefetcherTests_h
+
+#include <QtTest/QtTest>
+
+class ResourcePrefetcherTests : public QObject {
+    Q_OBJECT
+private slots:
+    void rankingTest();
+    void visitDedupeTest();
+    void byteBudgetTest();
+    void pruneTest();
+    void jsonTest();
+};
+
+#endif // overte_ResourcePrefetcherTests_h
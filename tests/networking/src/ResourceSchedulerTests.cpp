@@ -0,0 +1,140 @@
+//
+//  ResourceSchedulerTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ResourceSchedulerTests.h"
+
+#include <DependencyManager.h>
+#include <ResourceCache.h>
+
+QTEST_MAIN(ResourceSchedulerTests)
+
+static QSharedPointer<Resource> createResource(const QString& url, QObject* owner, float priority) {
+    auto resource = QSharedPointer<Resource>::create(QUrl(url));
+    resource->setSelf(resource);
+    resource->setLoadPriority(owner, priority);
+    return resource;
+}
+
+void ResourceSchedulerTests::initTestCase() {
+    DependencyManager::set<ResourceCacheSharedItems>();
+}
+
+void ResourceSchedulerTests::init() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    sharedItems->clear();
+    sharedItems->setRequestLimit(10);
+    sharedItems->setRequestByteLimit(32 * BYTES_PER_MEGABYTES);
+}
+
+void ResourceSchedulerTests::priorityOrderTest() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    QObject owner;
+    auto low = createResource("http://example.com/low", &owner, 1.0f);
+    auto high = createResource("http://example.com/high", &owner, 3.0f);
+    auto middle = createResource("http://example.com/middle", &owner, 2.0f);
+    auto file = createResource("file:///tmp/file", &owner, 0.0f);
+    sharedItems->appendRequest(low);
+    sharedItems->appendRequest(high);
+    sharedItems->appendRequest(middle);
+    sharedItems->appendRequest(file);
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)4);
+
+    // local files go first, then the highest priority
+    QCOMPARE(sharedItems->takeNextRequest(), file);
+    QCOMPARE(sharedItems->takeNextRequest(), high);
+    QCOMPARE(sharedItems->takeNextRequest(), middle);
+    QCOMPARE(sharedItems->takeNextRequest(), low);
+    QVERIFY(!sharedItems->takeNextRequest());
+    QCOMPARE(sharedItems->getLoadingRequestsCount(), (uint32_t)4);
+
+    sharedItems->removeRequest(high);
+    QCOMPARE(sharedItems->getLoadingRequestsCount(), (uint32_t)3);
+}
+
+void ResourceSchedulerTests::reprioritizeTest() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    QObject owner;
+    auto first = createResource("http://example.com/first", &owner, 2.0f);
+    auto second = createResource("http://example.com/second", &owner, 1.0f);
+    auto third = createResource("http://example.com/third", &owner, 0.0f);
+    sharedItems->appendRequest(first);
+    sharedItems->appendRequest(second);
+    sharedItems->appendRequest(third);
+
+    // appending a pending request again only re-reads its priority
+    second->setLoadPriority(&owner, 3.0f);
+    sharedItems->appendRequest(second);
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)3);
+
+    third->setLoadPriority(&owner, 4.0f);
+    sharedItems->reprioritize();
+    QCOMPARE(sharedItems->takeNextRequest(), third);
+    QCOMPARE(sharedItems->takeNextRequest(), second);
+    QCOMPARE(sharedItems->takeNextRequest(), first);
+}
+
+void ResourceSchedulerTests::byteLimitTest() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    sharedItems->setRequestByteLimit(BYTES_PER_MEGABYTES + BYTES_PER_MEGABYTES / 2);
+    QObject owner;
+    auto first = createResource("http://example.com/first", &owner, 2.0f);
+    auto second = createResource("http://example.com/second", &owner, 1.0f);
+    sharedItems->appendRequest(first);
+    sharedItems->appendRequest(second);
+
+    // the sizes aren't known yet, each is charged a default estimate
+    QCOMPARE(sharedItems->takeNextRequest(), first);
+    QVERIFY(!sharedItems->takeNextRequest());
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)1);
+
+    // once most of the first download has arrived the second fits
+    sharedItems->updateLoadingBytes(first.data(), BYTES_PER_MEGABYTES / 4);
+    QCOMPARE(sharedItems->getLoadingBytes(), BYTES_PER_MEGABYTES / 4);
+    QCOMPARE(sharedItems->takeNextRequest(), second);
+
+    sharedItems->removeRequest(first);
+    sharedItems->removeRequest(second);
+    QCOMPARE(sharedItems->getLoadingBytes(), (qint64)0);
+}
+
+void ResourceSchedulerTests::coalesceTest() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    QObject owner;
+    auto leader = createResource("http://example.com/shared", &owner, 2.0f);
+    auto follower = createResource("http://example.com/shared", &owner, 1.0f);
+    auto other = createResource("http://example.com/other", &owner, 0.0f);
+    sharedItems->appendRequest(leader);
+    sharedItems->appendRequest(follower);
+    sharedItems->appendRequest(other);
+
+    // the second request for the same URL waits for the first to finish
+    QCOMPARE(sharedItems->takeNextRequest(), leader);
+    QCOMPARE(sharedItems->takeNextRequest(), other);
+    QVERIFY(!sharedItems->takeNextRequest());
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)1);
+
+    sharedItems->removeRequest(leader);
+    QCOMPARE(sharedItems->takeNextRequest(), follower);
+    QCOMPARE(sharedItems->getPendingRequestsCount(), (uint32_t)0);
+}
+
+void ResourceSchedulerTests::queueTimeTest() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    QObject owner;
+    auto resource = createResource("http://example.com/timed", &owner, 0.0f);
+    auto countBefore = sharedItems->getQueueTimes().value(resource->getType()).count;
+    sharedItems->appendRequest(resource);
+    QCOMPARE(sharedItems->takeNextRequest(), resource);
+
+    auto queueTime = sharedItems->getQueueTimes().value(resource->getType());
+    QCOMPARE(queueTime.count, countBefore + 1);
+    QVERIFY(queueTime.maxUsecs >= queueTime.totalUsecs / queueTime.count);
+}
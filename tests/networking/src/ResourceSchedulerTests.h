@@ -0,0 +1,29 @@
+//
+//  ResourceSchedulerTests.h
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ResourceSchedulerTests_h
+#define overte_ResourceSchedulerTests_h
+
+#include <QtTest/QtTest>
+
+class ResourceSchedulerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void init();
+    void priorityOrderTest();
+    void reprioritizeTest();
+    void byteLimitTest();
+    void coalesceTest();
+    void queueTimeTest();
+};
+
+#endif // overte_ResourceSchedulerTests_h
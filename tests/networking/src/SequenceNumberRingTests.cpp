@@ -0,0 +1,109 @@
+//
+//  SequenceNumberRingTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "SequenceNumberRingTests.h"
+
+#include <memory>
+
+#include <udt/SequenceNumberRing.h>
+
+QTEST_MAIN(SequenceNumberRingTests)
+
+using namespace udt;
+
+void SequenceNumberRingTests::insertFindTest() {
+    SequenceNumberRing<int> ring;
+    QVERIFY(ring.empty());
+    QVERIFY(!ring.find(SequenceNumber(0)));
+
+    for (int i = 10; i < 20; ++i) {
+        ring[SequenceNumber(i)] = i * 2;
+    }
+
+    QCOMPARE(ring.size(), 10);
+    QCOMPARE(ring.getFirstSequenceNumber(), SequenceNumber(10));
+    QCOMPARE(*ring.find(SequenceNumber(15)), 30);
+    QVERIFY(!ring.find(SequenceNumber(9)));
+    QVERIFY(!ring.find(SequenceNumber(20)));
+
+    // erasing from the middle leaves a hole, erasing the front moves it forward
+    QVERIFY(ring.erase(SequenceNumber(15)));
+    QVERIFY(!ring.erase(SequenceNumber(15)));
+    QVERIFY(!ring.find(SequenceNumber(15)));
+    QVERIFY(ring.erase(SequenceNumber(10)));
+    QCOMPARE(ring.getFirstSequenceNumber(), SequenceNumber(11));
+    QCOMPARE(ring.size(), 8);
+
+    // an older sequence number moves the front back
+    ring[SequenceNumber(5)] = 5;
+    QCOMPARE(ring.getFirstSequenceNumber(), SequenceNumber(5));
+    QCOMPARE(*ring.find(SequenceNumber(19)), 38);
+}
+
+void SequenceNumberRingTests::eraseUpToTest() {
+    SequenceNumberRing<std::unique_ptr<int>> ring;
+    for (int i = 0; i < 50; ++i) {
+        ring[SequenceNumber(i)].reset(new int(i));
+    }
+
+    // an ACK behind the window doesn't remove anything
+    ring.eraseUpTo(SequenceNumber(10));
+    QCOMPARE(ring.eraseUpTo(SequenceNumber(SequenceNumber::MAX)), 0);
+    QCOMPARE(ring.size(), 39);
+
+    QVERIFY(ring.erase(SequenceNumber(20)));
+    QCOMPARE(ring.eraseUpTo(SequenceNumber(25)), 14);
+    QCOMPARE(ring.getFirstSequenceNumber(), SequenceNumber(26));
+    QCOMPARE(**ring.find(SequenceNumber(26)), 26);
+
+    // an ACK past the newest sequence number empties the ring
+    QCOMPARE(ring.eraseUpTo(SequenceNumber(1000)), 24);
+    QVERIFY(ring.empty());
+    QVERIFY(!ring.find(SequenceNumber(49)));
+
+    ring[SequenceNumber(2000)].reset(new int(2000));
+    QCOMPARE(ring.getFirstSequenceNumber(), SequenceNumber(2000));
+    QCOMPARE(ring.size(), 1);
+}
+
+void SequenceNumberRingTests::growTest() {
+    SequenceNumberRing<int> ring(4);
+    QCOMPARE(ring.capacity(), 4);
+
+    const int NUM_VALUES = 1000;
+    for (int i = 0; i < NUM_VALUES; ++i) {
+        ring[SequenceNumber(i)] = i;
+    }
+
+    QVERIFY(ring.capacity() >= NUM_VALUES);
+    QCOMPARE(ring.size(), NUM_VALUES);
+    for (int i = 0; i < NUM_VALUES; ++i) {
+        QCOMPARE(*ring.find(SequenceNumber(i)), i);
+    }
+}
+
+void SequenceNumberRingTests::rolloverTest() {
+    SequenceNumberRing<int> ring;
+
+    SequenceNumber seq(SequenceNumber::MAX - 100);
+    for (int i = 0; i < 200; ++i, ++seq) {
+        ring[seq] = i;
+    }
+
+    QCOMPARE(ring.size(), 200);
+    QCOMPARE(*ring.find(SequenceNumber(SequenceNumber::MAX)), 100);
+    QCOMPARE(*ring.find(SequenceNumber(0)), 101);
+
+    QCOMPARE(ring.eraseUpTo(SequenceNumber(50)), 152);
+    QCOMPARE(ring.getFirstSequenceNumber(), SequenceNumber(51));
+    QVERIFY(!ring.find(SequenceNumber(SequenceNumber::MAX)));
+    QCOMPARE(*ring.find(SequenceNumber(98)), 199);
+}
@@ -0,0 +1,26 @@
+//
+//  SequenceNumberRingTests.h
+//  tests/networking/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_SequenceNumberRingTests_h
+#define overte_SequenceNumberRingTests_h
+
+#include <QtTest/QtTest>
+
+class SequenceNumberRingTests : public QObject {
+    Q_OBJECT
+private slots:
+    void insertFindTest();
+    void eraseUpToTest();
+    void growTest();
+    void rolloverTest();
+};
+
+#endif // overte_SequenceNumberRingTests_h
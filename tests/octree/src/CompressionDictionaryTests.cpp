@@ -0,0 +1,77 @@
+//
+//  CompressionDictionaryTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "CompressionDictionaryTests.h"
+
+#include <OctreeCompressionDictionary.h>
+#include <OctreePacketData.h>
+
+QTEST_MAIN(CompressionDictionaryTests)
+
+static const int NUM_SAMPLES = 256;
+
+// records that share the strings of a domain's entities, but not their ids
+static QByteArray sampleRecord(int index) {
+    return QString("%1{\"modelURL\": \"https://cdn.example.org/models/chair.fbx\", "
+                   "\"userData\": {\"grabbableKey\": {\"grabbable\": true}, \"index\": %2}}")
+        .arg(QUuid::createUuid().toString(), QString::number(index)).toUtf8();
+}
+
+static QByteArray uncompressedContent(OctreePacketData& packetData) {
+    return QByteArray(reinterpret_cast<const char*>(packetData.getUncompressedData()), packetData.getUncompressedSize());
+}
+
+void CompressionDictionaryTests::testTrainedDictionaryRoundTrip() {
+    std::vector<QByteArray> samples;
+    for (int i = 0; i < NUM_SAMPLES; ++i) {
+        samples.push_back(sampleRecord(i));
+    }
+    QByteArray dictionary = OctreeCompressionDictionary::train(samples);
+    QVERIFY(!dictionary.isEmpty());
+    QVERIFY(dictionary.size() <= OctreeCompressionDictionary::MAX_SIZE);
+    QVERIFY(OctreeCompressionDictionary::checksum(dictionary) != 0);
+
+    QByteArray section = sampleRecord(NUM_SAMPLES);
+    OctreePacketData plain(true);
+    QVERIFY(plain.appendRawData(section));
+    OctreePacketData compressed(true);
+    compressed.setCompressionDictionary(dictionary);
+    QVERIFY(compressed.appendRawData(section));
+    QVERIFY(compressed.getFinalizedSize() < plain.getFinalizedSize());
+
+    OctreePacketData loaded(true);
+    loaded.setCompressionDictionary(dictionary);
+    loaded.loadFinalizedContent(compressed.getFinalizedData(), compressed.getFinalizedSize());
+    QCOMPARE(uncompressedContent(loaded), section);
+
+    // sections compressed before the viewer held the dictionary load as well
+    loaded.loadFinalizedContent(plain.getFinalizedData(), plain.getFinalizedSize());
+    QCOMPARE(uncompressedContent(loaded), section);
+}
+
+void CompressionDictionaryTests::testOtherDictionary() {
+    std::vector<QByteArray> samples;
+    for (int i = 0; i < NUM_SAMPLES; ++i) {
+        samples.push_back(sampleRecord(i));
+    }
+    QByteArray dictionary = OctreeCompressionDictionary::train(samples);
+
+    QByteArray section = sampleRecord(NUM_SAMPLES);
+    OctreePacketData compressed(true);
+    compressed.setCompressionDictionary(dictionary);
+    QVERIFY(compressed.appendRawData(section));
+
+    // a section compressed with another dictionary is dropped rather than misread
+    OctreePacketData loaded(true);
+    loaded.setCompressionDictionary(dictionary.mid(1));
+    loaded.loadFinalizedContent(compressed.getFinalizedData(), compressed.getFinalizedSize());
+    QCOMPARE(loaded.getUncompressedSize(), 0);
+}
@@ -0,0 +1,25 @@
+//
+//  CompressionDictionaryTests.h
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_CompressionDictionaryTests_h
+#define overte_CompressionDictionaryTests_h
+
+#include <QtTest/QtTest>
+
+// Trains a compression dictionary and round trips octree data sections compressed with it.
+class CompressionDictionaryTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testTrainedDictionaryRoundTrip();
+    void testOtherDictionary();
+};
+
+#endif // overte_CompressionDictionaryTests_h
@@ -0,0 +1,182 @@
+//
+//  EnterLeaveIndexTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EnterLeaveIndexTests.h"
+
+#include <algorithm>
+#include <random>
+
+#include <DependencyManager.h>
+#include <EnterLeaveIndex.h>
+#include <EntityItem.h>
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+
+QTEST_MAIN(EnterLeaveIndexTests)
+
+static const int NUM_ENTITIES = 2000;
+static const int NUM_POINTS = 200;
+static const float RADIUS = 0.01f;
+
+// nested zones of many sizes, scripted boxes, and boxes without scripts that the index should leave out
+static EntityTreePointer newPopulatedTree(QVector<EntityItemPointer>& entities) {
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> coordinate(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> size(1.0f, 100.0f);
+    tree->withWriteLock([&] {
+        for (int i = 0; i < NUM_ENTITIES; ++i) {
+            EntityItemProperties properties;
+            properties.setType(i % 3 == 0 ? EntityTypes::Zone : EntityTypes::Box);
+            if (i % 3 == 1) {
+                properties.setScript("http://localhost/enterLeave.js");
+            }
+            properties.setPosition(glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator)));
+            properties.setDimensions(glm::vec3(size(generator), size(generator), size(generator)));
+
+            QUuid id = QUuid::createUuid();
+            if (tree->addEntity(id, properties)) {
+                entities.push_back(tree->findEntityByID(id));
+            }
+        }
+    });
+    return tree;
+}
+
+static std::vector<glm::vec3> newPoints() {
+    std::vector<glm::vec3> points;
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> coordinate(-200.0f, 200.0f);
+    for (int i = 0; i < NUM_POINTS; ++i) {
+        points.emplace_back(coordinate(generator), coordinate(generator), coordinate(generator));
+    }
+    return points;
+}
+
+static QSet<QUuid> findCandidates(EnterLeaveIndex& index, const glm::vec3& point) {
+    std::vector<EntityItemPointer> candidates;
+    index.findCandidates(point, RADIUS, candidates);
+    QSet<QUuid> ids;
+    for (const auto& entity : candidates) {
+        ids.insert(entity->getID());
+    }
+    return ids;
+}
+
+// the candidates whose boxes touch the point, found without the index
+static QSet<QUuid> findCandidatesWithoutIndex(const QVector<EntityItemPointer>& entities, const glm::vec3& point) {
+    QSet<QUuid> ids;
+    for (const auto& entity : entities) {
+        bool success;
+        if (EnterLeaveIndex::isCandidate(entity) && entity->getAABox(success).touchesSphere(point, RADIUS) && success) {
+            ids.insert(entity->getID());
+        }
+    }
+    return ids;
+}
+
+void EnterLeaveIndexTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+void EnterLeaveIndexTests::testCandidates() {
+    QVector<EntityItemPointer> entities;
+    auto tree = newPopulatedTree(entities);
+    EnterLeaveIndex index;
+    for (const auto& entity : entities) {
+        index.update(entity);
+    }
+    QCOMPARE((int)index.size(), (int)std::count_if(entities.begin(), entities.end(), &EnterLeaveIndex::isCandidate));
+
+    int found = 0;
+    for (const auto& point : newPoints()) {
+        QSet<QUuid> expected = findCandidatesWithoutIndex(entities, point);
+        QCOMPARE(findCandidates(index, point), expected);
+        found += expected.size();
+    }
+    QVERIFY(found > 0);
+}
+
+void EnterLeaveIndexTests::testMovedCandidates() {
+    QVector<EntityItemPointer> entities;
+    auto tree = newPopulatedTree(entities);
+    EnterLeaveIndex index;
+    for (const auto& entity : entities) {
+        index.update(entity);
+    }
+    auto points = newPoints();
+    findCandidates(index, points[0]);
+
+    // the index isn't told about moves, it finds them when it is searched
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> offset(-50.0f, 50.0f);
+    for (int i = 0; i < entities.size(); i += 5) {
+        entities[i]->setWorldPosition(entities[i]->getWorldPosition() +
+            glm::vec3(offset(generator), offset(generator), offset(generator)));
+    }
+
+    for (const auto& point : points) {
+        QCOMPARE(findCandidates(index, point), findCandidatesWithoutIndex(entities, point));
+    }
+}
+
+void EnterLeaveIndexTests::testRemovedCandidates() {
+    QVector<EntityItemPointer> entities;
+    auto tree = newPopulatedTree(entities);
+    EnterLeaveIndex index;
+    for (const auto& entity : entities) {
+        index.update(entity);
+    }
+
+    // removed, and no longer a candidate once its script is cleared
+    QVector<EntityItemPointer> remaining;
+    for (int i = 0; i < entities.size(); i++) {
+        if (i % 4 == 0) {
+            index.remove(entities[i]->getEntityItemID());
+        } else {
+            if (i % 3 == 1 && i % 2 == 0) {
+                entities[i]->setScript(QString());
+                index.update(entities[i]);
+            }
+            remaining.push_back(entities[i]);
+        }
+    }
+
+    for (const auto& point : newPoints()) {
+        QCOMPARE(findCandidates(index, point), findCandidatesWithoutIndex(remaining, point));
+    }
+}
+
+void EnterLeaveIndexTests::testContainmentCache() {
+    QVector<EntityItemPointer> entities;
+    auto tree = newPopulatedTree(entities);
+    EnterLeaveIndex index;
+    const auto& zone = entities[0];
+    index.update(zone);
+
+    glm::vec3 inside = zone->getWorldPosition();
+    glm::vec3 outside = inside + zone->getScaledDimensions();
+    uint64_t now = usecTimestampNow();
+    QVERIFY(index.contains(zone, inside, now));
+    QVERIFY(!index.contains(zone, outside, now));
+
+    // moving the zone away changes its answer even though the point is the one tested
+    zone->setWorldPosition(outside);
+    std::vector<EntityItemPointer> candidates;
+    index.findCandidates(outside, RADIUS, candidates);
+    QVERIFY(index.contains(zone, outside, now));
+    QVERIFY(!index.contains(zone, inside, now));
+}
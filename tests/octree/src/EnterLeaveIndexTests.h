@@ -0,0 +1,30 @@
+//
+//  EnterLeaveIndexTests.h
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_EnterLeaveIndexTests_h
+#define overte_EnterLeaveIndexTests_h
+
+#include <QtTest/QtTest>
+
+// Checks that the enter/leave index finds the zones and scripted entities around a point as a search of all of them
+// does, as they are added, moved and removed.
+class EnterLeaveIndexTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void testCandidates();
+    void testMovedCandidates();
+    void testRemovedCandidates();
+    void testContainmentCache();
+};
+
+#endif // overte_EnterLeaveIndexTests_h
@@ -0,0 +1,165 @@
+//
+//  EntityPickTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EntityPickTests.h"
+
+#include <random>
+
+#include <DependencyManager.h>
+#include <EntityItem.h>
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <GeometryUtil.h>
+#include <NodeList.h>
+
+QTEST_MAIN(EntityPickTests)
+
+// enough entities of mixed sizes that many of them live in elements much larger than themselves
+static const int NUM_ENTITIES = 20000;
+static const int NUM_RAYS = 500;
+
+static const PickFilter SEARCH_FILTER(PickFilter::getBitMask(PickFilter::FlagBit::DOMAIN_ENTITIES) |
+    PickFilter::getBitMask(PickFilter::FlagBit::VISIBLE) | PickFilter::getBitMask(PickFilter::FlagBit::COLLIDABLE) |
+    PickFilter::getBitMask(PickFilter::FlagBit::NONCOLLIDABLE) | PickFilter::getBitMask(PickFilter::FlagBit::COARSE));
+
+struct Ray {
+    glm::vec3 origin;
+    glm::vec3 direction;
+};
+
+static EntityTreePointer newPopulatedTree(QVector<QUuid>& ids) {
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    std::uniform_real_distribution<float> size(0.5f, 40.0f);
+    tree->withWriteLock([&] {
+        for (int i = 0; i < NUM_ENTITIES; ++i) {
+            EntityItemProperties properties;
+            properties.setType(EntityTypes::Box);
+            properties.setPosition(glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator)));
+            properties.setDimensions(glm::vec3(size(generator), size(generator), size(generator)));
+
+            QUuid id = QUuid::createUuid();
+            if (tree->addEntity(id, properties)) {
+                ids.push_back(id);
+            }
+        }
+    });
+    return tree;
+}
+
+// from random points at random entities, so that most rays pass through crowded space before they hit
+static std::vector<Ray> newRays(const EntityTreePointer& tree, const QVector<QUuid>& ids) {
+    std::vector<Ray> rays;
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    std::uniform_int_distribution<int> index(0, ids.size() - 1);
+    for (int i = 0; i < NUM_RAYS; ++i) {
+        glm::vec3 origin(coordinate(generator), coordinate(generator), coordinate(generator));
+        glm::vec3 target = tree->findEntityByID(ids[index(generator)])->getWorldPosition();
+        rays.push_back({ origin, glm::normalize(target - origin) });
+    }
+    return rays;
+}
+
+// the nearest of the unrotated box entities that the ray hits, found without the tree
+static QUuid findNearestHit(const EntityTreePointer& tree, const QVector<QUuid>& ids, const Ray& ray,
+                            const QUuid& discarded, float& nearestDistance) {
+    QUuid nearest;
+    nearestDistance = FLT_MAX;
+    for (const auto& id : ids) {
+        if (id == discarded) {
+            continue;
+        }
+        bool success;
+        AABox box = tree->findEntityByID(id)->getAABox(success);
+        float distance;
+        BoxFace face;
+        glm::vec3 normal;
+        if (success && findRayAABoxIntersection(ray.origin, ray.direction, 1.0f / ray.direction, box.getMinimumPoint(),
+                box.getScale(), distance, face, normal) && distance < nearestDistance) {
+            nearestDistance = distance;
+            nearest = id;
+        }
+    }
+    return nearest;
+}
+
+static QUuid pick(const EntityTreePointer& tree, const Ray& ray, const QVector<EntityItemID>& discarded, float& distance) {
+    OctreeElementPointer element;
+    BoxFace face;
+    glm::vec3 normal;
+    QVariantMap extraInfo;
+    return tree->evalRayIntersection(ray.origin, ray.direction, QVector<EntityItemID>(), discarded, SEARCH_FILTER, element,
+        distance, face, normal, extraInfo, Octree::Lock);
+}
+
+void EntityPickTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+void EntityPickTests::testNearestHit() {
+    QVector<QUuid> ids;
+    auto tree = newPopulatedTree(ids);
+    QCOMPARE(ids.size(), NUM_ENTITIES);
+
+    for (const auto& ray : newRays(tree, ids)) {
+        float expectedDistance;
+        QUuid expected = findNearestHit(tree, ids, ray, QUuid(), expectedDistance);
+        QVERIFY(!expected.isNull());
+
+        float distance;
+        QUuid picked = pick(tree, ray, QVector<EntityItemID>(), distance);
+        QCOMPARE(picked, expected);
+        QVERIFY(fabsf(distance - expectedDistance) < 0.001f);
+    }
+}
+
+void EntityPickTests::testDiscardedNearest() {
+    QVector<QUuid> ids;
+    auto tree = newPopulatedTree(ids);
+
+    // the entity behind a discarded one is found even though the discarded one's element is nearer
+    for (const auto& ray : newRays(tree, ids)) {
+        float nearestDistance;
+        QUuid nearest = findNearestHit(tree, ids, ray, QUuid(), nearestDistance);
+        float expectedDistance;
+        QUuid expected = findNearestHit(tree, ids, ray, nearest, expectedDistance);
+
+        float distance;
+        QUuid picked = pick(tree, ray, { EntityItemID(nearest) }, distance);
+        QCOMPARE(picked, expected);
+        if (!expected.isNull()) {
+            QVERIFY(fabsf(distance - expectedDistance) < 0.001f);
+        }
+    }
+}
+
+void EntityPickTests::benchmarkRayPick() {
+    QVector<QUuid> ids;
+    auto tree = newPopulatedTree(ids);
+    auto rays = newRays(tree, ids);
+
+    int hits = 0;
+    QBENCHMARK {
+        for (const auto& ray : rays) {
+            float distance;
+            if (!pick(tree, ray, QVector<EntityItemID>(), distance).isNull()) {
+                hits++;
+            }
+        }
+    }
+    QVERIFY(hits > 0);
+}
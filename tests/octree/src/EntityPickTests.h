@@ -0,0 +1,29 @@
+//
+//  EntityPickTests.h
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_EntityPickTests_h
+#define overte_EntityPickTests_h
+
+#include <QtTest/QtTest>
+
+// Checks that ray picks through a large entity tree find the nearest entity, and times them.
+class EntityPickTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void testNearestHit();
+    void testDiscardedNearest();
+
+    void benchmarkRayPick();
+};
+
+#endif // overte_EntityPickTests_h
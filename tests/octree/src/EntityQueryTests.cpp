@@ -0,0 +1,169 @@
+//
+//  EntityQueryTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EntityQueryTests.h"
+
+#include <algorithm>
+#include <random>
+
+#include <DependencyManager.h>
+#include <EntityItem.h>
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+
+QTEST_MAIN(EntityQueryTests)
+
+// enough entities for the tree to be deep enough for a parallel traversal
+static const int NUM_ENTITIES = 5000;
+static const float QUERY_RADIUS = 200.0f;
+
+static const PickFilter SEARCH_FILTER(PickFilter::getBitMask(PickFilter::FlagBit::DOMAIN_ENTITIES) |
+    PickFilter::getBitMask(PickFilter::FlagBit::AVATAR_ENTITIES));
+
+static EntityTreePointer newPopulatedTree(QVector<QUuid>& ids) {
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    tree->withWriteLock([&] {
+        for (int i = 0; i < NUM_ENTITIES; ++i) {
+            EntityItemProperties properties;
+            properties.setType(EntityTypes::Box);
+            properties.setPosition(glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator)));
+            properties.setDimensions(glm::vec3(1.0f));
+
+            QUuid id = QUuid::createUuid();
+            if (tree->addEntity(id, properties)) {
+                ids.push_back(id);
+            }
+        }
+    });
+    return tree;
+}
+
+static QVector<QUuid> sorted(QVector<QUuid> ids) {
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+// the unrotated box entities that touch the sphere, found without the tree
+static QVector<QUuid> bruteForceSphere(const EntityTreePointer& tree, const QVector<QUuid>& ids, const glm::vec3& center, float radius) {
+    QVector<QUuid> found;
+    for (const auto& id : ids) {
+        bool success;
+        AABox box = tree->findEntityByID(id)->getAABox(success);
+        glm::vec3 penetration;
+        if (success && box.findSpherePenetration(center, radius, penetration)) {
+            found.push_back(id);
+        }
+    }
+    return sorted(found);
+}
+
+void EntityQueryTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+void EntityQueryTests::testSphereQuery() {
+    QVector<QUuid> ids;
+    auto tree = newPopulatedTree(ids);
+
+    glm::vec3 center(100.0f, -50.0f, 25.0f);
+    QVector<QUuid> found;
+    tree->withReadLock([&] {
+        tree->evalEntitiesInSphere(center, QUERY_RADIUS, SEARCH_FILTER, found);
+    });
+    QVERIFY(!found.isEmpty());
+    QCOMPARE(sorted(found), bruteForceSphere(tree, ids, center, QUERY_RADIUS));
+
+    // a query covering the whole tree spans every subtree
+    tree->withReadLock([&] {
+        tree->evalEntitiesInSphere(glm::vec3(0.0f), 10000.0f, SEARCH_FILTER, found);
+    });
+    QCOMPARE(sorted(found), sorted(ids));
+}
+
+void EntityQueryTests::testBatchQuery() {
+    QVector<QUuid> ids;
+    auto tree = newPopulatedTree(ids);
+
+    std::vector<EntityTree::SpatialQuery> queries(3);
+    queries[0].shape = EntityTree::SpatialQuery::Sphere;
+    queries[0].center = glm::vec3(100.0f, -50.0f, 25.0f);
+    queries[0].radius = QUERY_RADIUS;
+    queries[1].shape = EntityTree::SpatialQuery::Box;
+    queries[1].box = AABox(glm::vec3(-500.0f), glm::vec3(400.0f));
+    queries[2].shape = EntityTree::SpatialQuery::Sphere;
+    queries[2].center = glm::vec3(5000.0f);
+    queries[2].radius = 1.0f;
+
+    QVector<QUuid> sphereFound;
+    QVector<QUuid> boxFound;
+    tree->withReadLock([&] {
+        tree->evalEntitiesInBatch(queries, SEARCH_FILTER);
+        tree->evalEntitiesInSphere(queries[0].center, queries[0].radius, SEARCH_FILTER, sphereFound);
+        tree->evalEntitiesInBox(queries[1].box, SEARCH_FILTER, boxFound);
+    });
+    QCOMPARE(sorted(queries[0].foundEntities), sorted(sphereFound));
+    QCOMPARE(sorted(queries[1].foundEntities), sorted(boxFound));
+    QVERIFY(!queries[1].foundEntities.isEmpty());
+    QVERIFY(queries[2].foundEntities.isEmpty());
+}
+
+void EntityQueryTests::testCachedQueryAfterEdit() {
+    QVector<QUuid> ids;
+    auto tree = newPopulatedTree(ids);
+
+    glm::vec3 center(100.0f, -50.0f, 25.0f);
+    QVector<QUuid> before;
+    QVector<QUuid> again;
+    tree->withReadLock([&] {
+        tree->evalEntitiesInSphere(center, QUERY_RADIUS, SEARCH_FILTER, before);
+        tree->evalEntitiesInSphere(center, QUERY_RADIUS, SEARCH_FILTER, again);
+    });
+    QCOMPARE(again, before);
+
+    // an entity moved into the sphere is found by the same query right after
+    QUuid movedID = ids[0];
+    QVERIFY(!before.contains(movedID));
+    tree->withWriteLock([&] {
+        EntityItemProperties properties;
+        properties.setPosition(center);
+        QVERIFY(tree->updateEntity(movedID, properties));
+    });
+
+    QVector<QUuid> after;
+    tree->withReadLock([&] {
+        tree->evalEntitiesInSphere(center, QUERY_RADIUS, SEARCH_FILTER, after);
+    });
+    QVERIFY(after.contains(movedID));
+    QCOMPARE(after.size(), before.size() + 1);
+}
+
+void EntityQueryTests::benchmarkSphereQuery() {
+    QVector<QUuid> ids;
+    auto tree = newPopulatedTree(ids);
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    QVector<QUuid> found;
+    QBENCHMARK {
+        // a new center each time, so results are not found in the cache
+        glm::vec3 center(coordinate(generator), coordinate(generator), coordinate(generator));
+        tree->withReadLock([&] {
+            tree->evalEntitiesInSphere(center, QUERY_RADIUS, SEARCH_FILTER, found);
+        });
+    }
+}
@@ -0,0 +1,31 @@
+//
+//  EntityQueryTests.h
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_EntityQueryTests_h
+#define overte_EntityQueryTests_h
+
+#include <QtTest/QtTest>
+
+// Checks the spatial queries of an entity tree against a brute force search of its entities,
+// for the parallel traversal, the batched traversal and the cached results.
+class EntityQueryTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void testSphereQuery();
+    void testBatchQuery();
+    void testCachedQueryAfterEdit();
+
+    void benchmarkSphereQuery();
+};
+
+#endif // overte_EntityQueryTests_h
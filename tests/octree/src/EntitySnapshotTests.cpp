@@ -0,0 +1,213 @@
+//
+//  EntitySnapshotTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EntitySnapshotTests.h"
+
+#include <random>
+
+#include <QtCore/QTemporaryDir>
+
+#include <DependencyManager.h>
+#include <EntityItem.h>
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+#include <OctreeJournal.h>
+
+QTEST_MAIN(EntitySnapshotTests)
+
+// enough entities for several snapshot chunks
+static const int NUM_ENTITIES = 5000;
+
+static EntityTreePointer newTree() {
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+    return tree;
+}
+
+static EntityTreePointer newPopulatedTree(QVector<QUuid>& ids) {
+    auto tree = newTree();
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+
+    tree->withWriteLock([&] {
+        for (int i = 0; i < NUM_ENTITIES; ++i) {
+            EntityItemProperties properties;
+            properties.setType(EntityTypes::Box);
+            properties.setName(QString("box %1").arg(i));
+            properties.setPosition(glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator)));
+            properties.setDimensions(glm::vec3(1.0f + (float)(i % 7)));
+            properties.setUserData(QString("{\"index\": %1}").arg(i));
+
+            QUuid id = QUuid::createUuid();
+            if (tree->addEntity(id, properties)) {
+                ids.push_back(id);
+            }
+        }
+    });
+    return tree;
+}
+
+void EntitySnapshotTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+void EntitySnapshotTests::testSnapshotRoundTrip() {
+    QVector<QUuid> ids;
+    auto tree = newPopulatedTree(ids);
+    QCOMPARE(ids.size(), NUM_ENTITIES);
+
+    QByteArray snapshot;
+    QVERIFY(tree->writeToSnapshot(snapshot));
+
+    auto loadedTree = newTree();
+    bool success = false;
+    loadedTree->withWriteLock([&] {
+        success = loadedTree->readFromSnapshot(snapshot.constData(), snapshot.size());
+    });
+    QVERIFY(success);
+
+    for (const auto& id : ids) {
+        auto entity = tree->findEntityByID(id);
+        auto loadedEntity = loadedTree->findEntityByID(id);
+        QVERIFY(loadedEntity);
+        QCOMPARE(loadedEntity->getType(), entity->getType());
+        QCOMPARE(loadedEntity->getName(), entity->getName());
+        QCOMPARE(loadedEntity->getUserData(), entity->getUserData());
+        QCOMPARE(loadedEntity->getCreated(), entity->getCreated());
+        QCOMPARE(loadedEntity->getWorldPosition(), entity->getWorldPosition());
+        QCOMPARE(loadedEntity->getScaledDimensions(), entity->getScaledDimensions());
+    }
+}
+
+void EntitySnapshotTests::testTruncatedSnapshot() {
+    QVector<QUuid> ids;
+    auto tree = newPopulatedTree(ids);
+
+    QByteArray snapshot;
+    QVERIFY(tree->writeToSnapshot(snapshot));
+    snapshot.chop(snapshot.size() / 2);
+
+    auto loadedTree = newTree();
+    bool success = true;
+    loadedTree->withWriteLock([&] {
+        success = loadedTree->readFromSnapshot(snapshot.constData(), snapshot.size());
+    });
+    QVERIFY(!success);
+}
+
+void EntitySnapshotTests::testJournalReplay() {
+    QVector<QUuid> ids;
+    auto tree = newPopulatedTree(ids);
+
+    QByteArray snapshot;
+    QVERIFY(tree->writeToSnapshot(snapshot));
+
+    // edit, add and erase after the snapshot, with the tree journaling
+    tree->setIsJournaling(true);
+    QUuid editedID = ids[0];
+    QUuid erasedID = ids[1];
+    QUuid addedID = QUuid::createUuid();
+    tree->withWriteLock([&] {
+        EntityItemProperties properties;
+        properties.setName("edited box");
+        properties.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+        QVERIFY(tree->updateEntity(editedID, properties));
+
+        EntityItemProperties addedProperties;
+        addedProperties.setType(EntityTypes::Box);
+        addedProperties.setName("added box");
+        QVERIFY(tree->addEntity(addedID, addedProperties));
+
+        tree->deleteEntity(erasedID, true);
+    });
+
+    QByteArray records;
+    QVERIFY(tree->writeJournalRecords(records));
+
+    QTemporaryDir dir;
+    OctreeJournal journal(dir.filePath("models.journal"));
+    QVERIFY(journal.reset(tree->getPersistID(), tree->expectedVersion()));
+    QVERIFY(journal.append(records));
+    qint64 journalSize = journal.getSize();
+    // a record torn by a crash mid-append is cut on replay
+    QVERIFY(journal.append(records.left(3)));
+
+    auto loadedTree = newTree();
+    int numReplayed = 0;
+    loadedTree->withWriteLock([&] {
+        QVERIFY(loadedTree->readFromSnapshot(snapshot.constData(), snapshot.size()));
+        numReplayed = journal.replay(tree->getPersistID(), tree->expectedVersion(),
+            [&](OctreeJournal::RecordType type, const char* data, uint32_t size) {
+                return loadedTree->readJournalRecord(type, data, size);
+            });
+    });
+    QCOMPARE(numReplayed, 3);
+    QCOMPARE(journal.getSize(), journalSize);
+
+    auto editedEntity = loadedTree->findEntityByID(editedID);
+    QVERIFY(editedEntity);
+    QCOMPARE(editedEntity->getName(), QString("edited box"));
+    QCOMPARE(editedEntity->getWorldPosition(), glm::vec3(1.0f, 2.0f, 3.0f));
+    QVERIFY(loadedTree->findEntityByID(addedID));
+    QVERIFY(!loadedTree->findEntityByID(erasedID));
+    QVERIFY(loadedTree->findEntityByID(ids[2]));
+}
+
+void EntitySnapshotTests::benchmarkSnapshotSave() {
+    QVector<QUuid> ids;
+    auto tree = newPopulatedTree(ids);
+
+    QByteArray snapshot;
+    QBENCHMARK {
+        tree->writeToSnapshot(snapshot);
+    }
+    qDebug() << "snapshot of" << ids.size() << "entities:" << snapshot.size() << "bytes";
+}
+
+void EntitySnapshotTests::benchmarkSnapshotLoad() {
+    QVector<QUuid> ids;
+    QByteArray snapshot;
+    newPopulatedTree(ids)->writeToSnapshot(snapshot);
+
+    QBENCHMARK {
+        auto loadedTree = newTree();
+        loadedTree->withWriteLock([&] {
+            loadedTree->readFromSnapshot(snapshot.constData(), snapshot.size());
+        });
+    }
+}
+
+void EntitySnapshotTests::benchmarkJSONSave() {
+    QVector<QUuid> ids;
+    auto tree = newPopulatedTree(ids);
+
+    QByteArray json;
+    QBENCHMARK {
+        tree->toJSON(&json, nullptr, true);
+    }
+    qDebug() << "json.gz of" << ids.size() << "entities:" << json.size() << "bytes";
+}
+
+void EntitySnapshotTests::benchmarkJSONLoad() {
+    QVector<QUuid> ids;
+    QByteArray json;
+    newPopulatedTree(ids)->toJSON(&json, nullptr, true);
+
+    QBENCHMARK {
+        auto loadedTree = newTree();
+        loadedTree->withWriteLock([&] {
+            loadedTree->readFromByteArray("", json);
+        });
+    }
+}
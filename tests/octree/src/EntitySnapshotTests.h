@@ -0,0 +1,34 @@
+//
+//  EntitySnapshotTests.h
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_EntitySnapshotTests_h
+#define overte_EntitySnapshotTests_h
+
+#include <QtTest/QtTest>
+
+// Round trips an entity tree through the binary snapshot persist format and the edit journal,
+// and times saving and loading it against the json.gz persist.
+class EntitySnapshotTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void testSnapshotRoundTrip();
+    void testTruncatedSnapshot();
+    void testJournalReplay();
+
+    void benchmarkSnapshotSave();
+    void benchmarkSnapshotLoad();
+    void benchmarkJSONSave();
+    void benchmarkJSONLoad();
+};
+
+#endif // overte_EntitySnapshotTests_h
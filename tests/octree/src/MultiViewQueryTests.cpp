@@ -0,0 +1,113 @@
+//
+//  MultiViewQueryTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "MultiViewQueryTests.h"
+
+#include <DependencyManager.h>
+#include <DiffTraversal.h>
+#include <EntityItemProperties.h>
+#include <EntityPriorityQueue.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+#include <OctreeQuery.h>
+#include <ReceivedMessage.h>
+#include <udt/Constants.h>
+#include <udt/PacketHeaders.h>
+
+QTEST_MAIN(MultiViewQueryTests)
+
+static const float VIEW_RADIUS = 200.0f;
+
+static ConicalViewFrustum newView(const glm::vec3& position, float priorityWeight, float lodScale) {
+    ConicalViewFrustum view;
+    view.setPositionAndSimpleRadius(position, VIEW_RADIUS);
+    view.setPriorityWeight(priorityWeight);
+    view.setLODScale(lodScale);
+    return view;
+}
+
+// a 1m box at the origin, with the query cube the server would have for it
+static EntityItemPointer newEntity(EntityTreePointer& tree) {
+    tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setDimensions(glm::vec3(1.0f));
+    EntityItemPointer entity;
+    tree->withWriteLock([&] {
+        entity = tree->addEntity(QUuid::createUuid(), properties);
+    });
+    entity->setQueryAACube(AACube(glm::vec3(-0.5f), 1.0f));
+    return entity;
+}
+
+void MultiViewQueryTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+void MultiViewQueryTests::testQueryRoundTrip() {
+    OctreeQuery query;
+    query.setConicalViews({ newView(glm::vec3(0.0f), DEFAULT_VIEW_PRIORITY_WEIGHT, DEFAULT_VIEW_LOD_SCALE),
+                            newView(glm::vec3(10.0f), 0.25f, 2.0f),
+                            newView(glm::vec3(20.0f), 4.0f, 0.1f) });
+
+    QByteArray data(udt::MAX_PACKET_SIZE, 0);
+    int size = query.getBroadcastData(reinterpret_cast<unsigned char*>(data.data()));
+    data.resize(size);
+
+    ReceivedMessage message(data, PacketType::EntityQuery, versionForPacketType(PacketType::EntityQuery), SockAddr());
+    OctreeQuery received;
+    QCOMPARE(received.parseData(message), size);
+
+    auto views = received.getConicalViews();
+    QCOMPARE((int)views.size(), 3);
+    QCOMPARE(views[0].getPriorityWeight(), DEFAULT_VIEW_PRIORITY_WEIGHT);
+    QCOMPARE(views[0].getLODScale(), DEFAULT_VIEW_LOD_SCALE);
+    QCOMPARE(views[1].getPriorityWeight(), 0.25f);
+    QCOMPARE(views[1].getLODScale(), 2.0f);
+
+    // no view is taken to matter more than the main one, nor to need a finer LOD
+    QCOMPARE(views[2].getPriorityWeight(), DEFAULT_VIEW_PRIORITY_WEIGHT);
+    QCOMPARE(views[2].getLODScale(), DEFAULT_VIEW_LOD_SCALE);
+}
+
+void MultiViewQueryTests::testWeightedPriority() {
+    EntityTreePointer tree;
+    auto entity = newEntity(tree);
+    const float radius = 0.5f * SQRT_THREE;
+
+    // the entity is nearer the secondary view, but what the main view sees goes first
+    DiffTraversal::View view;
+    view.viewFrustums = { newView(glm::vec3(0.0f, 0.0f, 10.0f), DEFAULT_VIEW_PRIORITY_WEIGHT, DEFAULT_VIEW_LOD_SCALE),
+                          newView(glm::vec3(0.0f, 0.0f, -5.0f), 0.25f, DEFAULT_VIEW_LOD_SCALE) };
+    QCOMPARE(view.computePriority(entity), view.viewFrustums[0].getAngularSize(10.0f, radius));
+
+    // seen by the secondary view alone, it is sent with a lowered priority
+    view.viewFrustums = { newView(glm::vec3(0.0f, 0.0f, -5.0f), 0.25f, DEFAULT_VIEW_LOD_SCALE) };
+    QCOMPARE(view.computePriority(entity), 0.25f * view.viewFrustums[0].getAngularSize(5.0f, radius));
+}
+
+void MultiViewQueryTests::testViewLODScale() {
+    EntityTreePointer tree;
+    auto entity = newEntity(tree);
+
+    // large enough to be sent at 80m, but not at twice the minimum angular size
+    const glm::vec3 position(0.0f, 0.0f, 80.0f);
+    DiffTraversal::View view;
+    view.viewFrustums = { newView(position, DEFAULT_VIEW_PRIORITY_WEIGHT, DEFAULT_VIEW_LOD_SCALE) };
+    QVERIFY(view.computePriority(entity) > 0.0f);
+
+    view.viewFrustums = { newView(position, DEFAULT_VIEW_PRIORITY_WEIGHT, 2.0f) };
+    QCOMPARE(view.computePriority(entity), PrioritizedEntity::DO_NOT_SEND);
+}
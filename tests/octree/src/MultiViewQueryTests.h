@@ -0,0 +1,29 @@
+//
+//  MultiViewQueryTests.h
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_MultiViewQueryTests_h
+#define overte_MultiViewQueryTests_h
+
+#include <QtTest/QtTest>
+
+// Checks that the priority weights and LOD scales of the views in an entity query reach the server, and how they
+// order and cull the entities sent.
+class MultiViewQueryTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void testQueryRoundTrip();
+    void testWeightedPriority();
+    void testViewLODScale();
+};
+
+#endif // overte_MultiViewQueryTests_h
@@ -0,0 +1,156 @@
+//
+//  ParticleRingTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ParticleRingTests.h"
+
+#include <NumericalConstants.h>
+#include <ParticleRing.h>
+
+QTEST_MAIN(ParticleRingTests)
+
+// a frame at 60Hz, in usecs
+static const uint64_t FRAME_INTERVAL = 16667;
+
+// pushes a particle whose emission time is its index, so the tests can tell which particles are left
+static void pushIndexed(ParticleRing& ring, uint64_t expiration, int index) {
+    size_t slot = ring.push(expiration);
+    ring.timesAndSeeds[slot] = glm::vec2((float)index, 0.0f);
+}
+
+void ParticleRingTests::testPushWrap() {
+    ParticleRing ring;
+    QCOMPARE(ring.push(0), (size_t)-1);
+
+    ring.setCapacity(4);
+    for (int i = 0; i < 6; ++i) {
+        pushIndexed(ring, 100, i);
+    }
+
+    // the two oldest particles were dropped, and the oldest left is in slot 2
+    QCOMPARE(ring.getSize(), (size_t)4);
+    QCOMPARE(ring.getStart(), (size_t)2);
+    for (size_t i = 0; i < ring.getSize(); ++i) {
+        QCOMPARE(ring.timesAndSeeds[ring.slot(i)].x, (float)(i + 2));
+    }
+}
+
+void ParticleRingTests::testCull() {
+    ParticleRing ring;
+    ring.setCapacity(8);
+    for (int i = 0; i < 6; ++i) {
+        pushIndexed(ring, 10 * (i + 1), i);
+    }
+
+    QCOMPARE(ring.cull(5), (size_t)0);
+    QCOMPARE(ring.cull(30), (size_t)3);
+    QCOMPARE(ring.getSize(), (size_t)3);
+    QCOMPARE(ring.timesAndSeeds[ring.slot(0)].x, 3.0f);
+
+    QCOMPARE(ring.cull(1000), (size_t)3);
+    QVERIFY(ring.isEmpty());
+}
+
+void ParticleRingTests::testSetCapacity() {
+    ParticleRing ring;
+    ring.setCapacity(4);
+    for (int i = 0; i < 7; ++i) {
+        pushIndexed(ring, 100, i);
+    }
+
+    // shrinking keeps the newest particles, oldest first from slot 0
+    ring.setCapacity(2);
+    QCOMPARE(ring.getSize(), (size_t)2);
+    QCOMPARE(ring.getStart(), (size_t)0);
+    QCOMPARE(ring.timesAndSeeds[0].x, 5.0f);
+    QCOMPARE(ring.timesAndSeeds[1].x, 6.0f);
+
+    ring.setCapacity(8);
+    QCOMPARE(ring.getSize(), (size_t)2);
+    pushIndexed(ring, 100, 7);
+    QCOMPARE(ring.timesAndSeeds[ring.slot(2)].x, 7.0f);
+}
+
+void ParticleRingTests::testRebase() {
+    ParticleRing ring;
+    ring.setCapacity(2);
+    size_t slot = ring.push(100);
+    ring.positions[slot] = glm::vec3(1.0f, 0.0f, 0.0f);
+    ring.basePositions[slot] = glm::vec3(10.0f, 0.0f, 0.0f);
+
+    // from trailing, the world position is kept
+    ring.rebase(glm::vec3(20.0f, 0.0f, 0.0f), true);
+    QCOMPARE(ring.positions[slot] + ring.basePositions[slot], glm::vec3(11.0f, 0.0f, 0.0f));
+
+    // to trailing, the particle stays relative to the emitter
+    ring.rebase(glm::vec3(30.0f, 0.0f, 0.0f), false);
+    QCOMPARE(ring.positions[slot], glm::vec3(-9.0f, 0.0f, 0.0f));
+    QCOMPARE(ring.basePositions[slot], glm::vec3(30.0f, 0.0f, 0.0f));
+
+    ring.timesAndSeeds[slot] = glm::vec2(5.0f, 0.5f);
+    ring.shiftEmissionTimes(2.0f);
+    QCOMPARE(ring.timesAndSeeds[slot], glm::vec2(3.0f, 0.5f));
+}
+
+void ParticleRingTests::benchmarkFrame_data() {
+    QTest::addColumn<int>("numParticles");
+
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+}
+
+void ParticleRingTests::benchmarkFrame() {
+    QFETCH(int, numParticles);
+
+    // a full emitter with a one second lifespan, emitting and culling a frame's worth of particles
+    ParticleRing ring;
+    ring.setCapacity(numParticles);
+    const uint64_t lifespan = USECS_PER_SECOND;
+    const int numPerFrame = (int)((uint64_t)numParticles * FRAME_INTERVAL / lifespan) + 1;
+    uint64_t time = 0;
+    for (int i = 0; i < numParticles; ++i) {
+        ring.push(time + lifespan);
+        time += lifespan / numParticles;
+    }
+
+    QBENCHMARK {
+        for (int i = 0; i < numPerFrame; ++i) {
+            size_t slot = ring.push(time + lifespan);
+            ring.positions[slot] = glm::vec3(0.0f);
+            ring.timesAndSeeds[slot] = glm::vec2((float)time / (float)USECS_PER_SECOND, 0.0f);
+            ring.basePositions[slot] = glm::vec3(0.0f);
+            ring.velocities[slot] = glm::vec3(0.0f, 1.0f, 0.0f);
+            ring.accelerations[slot] = glm::vec3(0.0f, -9.8f, 0.0f);
+        }
+        time += FRAME_INTERVAL;
+        ring.cull(time);
+    }
+}
+
+void ParticleRingTests::benchmarkRebase_data() {
+    benchmarkFrame_data();
+}
+
+void ParticleRingTests::benchmarkRebase() {
+    QFETCH(int, numParticles);
+
+    ParticleRing ring;
+    ring.setCapacity(numParticles);
+    for (int i = 0; i < numParticles; ++i) {
+        ring.push(USECS_PER_SECOND);
+    }
+
+    bool keepWorldPositions = false;
+    QBENCHMARK {
+        ring.rebase(glm::vec3(1.0f, 2.0f, 3.0f), keepWorldPositions);
+        ring.shiftEmissionTimes(1.0f);
+        keepWorldPositions = !keepWorldPositions;
+    }
+}
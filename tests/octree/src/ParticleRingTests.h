@@ -0,0 +1,33 @@
+//
+//  ParticleRingTests.h
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ParticleRingTests_h
+#define overte_ParticleRingTests_h
+
+#include <QtTest/QtTest>
+
+// Checks the slots of the particle ring of a particle effect as it wraps, culls and resizes,
+// and times a frame of emitting and culling at the particle counts of large emitters.
+class ParticleRingTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testPushWrap();
+    void testCull();
+    void testSetCapacity();
+    void testRebase();
+
+    void benchmarkFrame_data();
+    void benchmarkFrame();
+    void benchmarkRebase_data();
+    void benchmarkRebase();
+};
+
+#endif // overte_ParticleRingTests_h
@@ -0,0 +1,157 @@
+//
+//  ContactMapTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ContactMapTests.h"
+
+#include <map>
+#include <random>
+
+#include <ContactMap.h>
+
+QTEST_MAIN(ContactMapTests)
+
+namespace {
+    // the keys are only compared, they stand for the motion states of the bodies in contact
+    std::vector<char> bodies(2048);
+
+    ContactKey makeKey(size_t a, size_t b) {
+        return ContactKey(&bodies[a], &bodies[b]);
+    }
+
+    btManifoldPoint makePoint(float distance) {
+        return btManifoldPoint(btVector3(0.0f, distance, 0.0f), btVector3(0.0f, 0.0f, 0.0f), btVector3(0.0f, 1.0f, 0.0f),
+                               distance);
+    }
+}
+
+void ContactMapTests::addAndFind() {
+    ContactMap contacts;
+    QVERIFY(contacts.empty());
+    QVERIFY(contacts.find(makeKey(0, 1)) == nullptr);
+
+    // enough to grow the table a few times
+    const size_t NUM_BODIES = 1000;
+    for (size_t i = 0; i < NUM_BODIES; ++i) {
+        contacts[makeKey(i, i + 1)].update(1, makePoint((float)i));
+    }
+    QCOMPARE(contacts.size(), NUM_BODIES);
+
+    for (size_t i = 0; i < NUM_BODIES; ++i) {
+        ContactInfo* contact = contacts.find(makeKey(i, i + 1));
+        QVERIFY(contact != nullptr);
+        QCOMPARE(contact->distance, (float)i);
+        // the order of the bodies matters
+        QVERIFY(contacts.find(makeKey(i + 1, i)) == nullptr);
+    }
+
+    // looking up a contact again doesn't add it
+    contacts[makeKey(3, 4)].update(2, makePoint(-1.0f));
+    QCOMPARE(contacts.size(), NUM_BODIES);
+    QCOMPARE(contacts.find(makeKey(3, 4))->distance, -1.0f);
+
+    contacts.clear();
+    QVERIFY(contacts.empty());
+    QVERIFY(contacts.find(makeKey(3, 4)) == nullptr);
+}
+
+void ContactMapTests::eraseMatchesMap() {
+    ContactMap contacts;
+    std::map<ContactKey, float> expected;
+    std::mt19937 generator(17);
+    std::uniform_int_distribution<size_t> body(0, 63);
+
+    // few bodies, so that the keys collide and the erasures shift the probe sequences
+    for (int i = 0; i < 20000; ++i) {
+        ContactKey key = makeKey(body(generator), body(generator));
+        if (generator() % 3 == 0) {
+            auto itr = expected.find(key);
+            for (size_t j = 0; j < contacts.size(); ++j) {
+                if (contacts.at(j).key == key) {
+                    contacts.eraseAt(j);
+                    break;
+                }
+            }
+            if (itr != expected.end()) {
+                expected.erase(itr);
+            }
+        } else {
+            contacts[key].update(1, makePoint((float)i));
+            expected[key] = (float)i;
+        }
+    }
+
+    QCOMPARE(contacts.size(), expected.size());
+    for (const auto& entry : expected) {
+        ContactInfo* contact = contacts.find(entry.first);
+        QVERIFY(contact != nullptr);
+        QCOMPARE(contact->distance, entry.second);
+    }
+}
+
+void ContactMapTests::eraseWhileWalking() {
+    ContactMap contacts;
+    const size_t NUM_BODIES = 500;
+    for (size_t i = 0; i < NUM_BODIES; ++i) {
+        contacts[makeKey(i, i + 1)].update(1, makePoint((float)i));
+    }
+
+    // every contact is seen once, the erased ones being replaced by ones that weren't seen yet
+    size_t numSeen = 0;
+    contacts.eraseIf([&](const ContactMap::Entry& entry) {
+        ++numSeen;
+        return (size_t)entry.info.distance % 2 == 0;
+    });
+    QCOMPARE(numSeen, NUM_BODIES);
+    QCOMPARE(contacts.size(), NUM_BODIES / 2);
+    for (size_t i = 0; i < NUM_BODIES; ++i) {
+        QCOMPARE(contacts.find(makeKey(i, i + 1)) != nullptr, i % 2 == 1);
+    }
+}
+
+void ContactMapTests::benchmarkSteps_data() {
+    QTest::addColumn<int>("numContacts");
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+}
+
+void ContactMapTests::benchmarkSteps() {
+    QFETCH(int, numContacts);
+    bodies.resize(2 * numContacts + 2);
+    ContactMap contacts;
+    const btManifoldPoint point = makePoint(-0.01f);
+    uint32_t step = 0;
+
+    // as PhysicsEngine does every step: update the contacts of the manifolds, then walk them for the events and drop the
+    // ones that ended, with a tenth of the contacts changing from one step to the next
+    QBENCHMARK {
+        ++step;
+        size_t first = (step % 10) * (numContacts / 10);
+        for (size_t i = first; i < first + (size_t)numContacts; ++i) {
+            contacts[makeKey(i, i + 1)].update(step, point);
+        }
+        size_t numEvents = 0;
+        size_t i = 0;
+        while (i < contacts.size()) {
+            ContactEventType type = contacts.at(i).info.computeType(step);
+            if (type != CONTACT_EVENT_TYPE_CONTINUE) {
+                ++numEvents;
+            }
+            if (type == CONTACT_EVENT_TYPE_END) {
+                contacts.eraseAt(i);
+            } else {
+                ++i;
+            }
+        }
+        QVERIFY(numEvents > 0);
+    }
+    bodies.resize(2048);
+}
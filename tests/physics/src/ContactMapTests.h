@@ -0,0 +1,29 @@
+//
+//  ContactMapTests.h
+//  tests/physics/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ContactMapTests_h
+#define overte_ContactMapTests_h
+
+#include <QtTest/QtTest>
+
+class ContactMapTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void addAndFind();
+    void eraseMatchesMap();
+    void eraseWhileWalking();
+
+    void benchmarkSteps_data();
+    void benchmarkSteps();
+};
+
+#endif // overte_ContactMapTests_h
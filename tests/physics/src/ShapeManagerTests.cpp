@@ -13,6 +13,8 @@
 
 #include <iostream>
 
+#include <ShapeCache.h>
+#include <ShapeFactory.h>
 #include <ShapeManager.h>
 #include <StreamUtils.h>
 #include <Extents.h>
@@ -244,3 +246,66 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+void ShapeManagerTests::cacheStaticMeshShape() {
+    // a grid of triangles
+    const int GRID_SIZE = 16;
+    ShapeInfo::PointList points;
+    for (int i = 0; i <= GRID_SIZE; ++i) {
+        for (int j = 0; j <= GRID_SIZE; ++j) {
+            points.push_back(glm::vec3((float)i, 0.1f * (float)((i * j) % 3), (float)j));
+        }
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_STATIC_MESH, glm::vec3(0.5f * (float)GRID_SIZE));
+    info.setPointCollection({ points });
+    auto& triangleIndices = info.getTriangleIndices();
+    for (int i = 0; i < GRID_SIZE; ++i) {
+        for (int j = 0; j < GRID_SIZE; ++j) {
+            int32_t corner = i * (GRID_SIZE + 1) + j;
+            triangleIndices << corner << corner + 1 << corner + GRID_SIZE + 1;
+            triangleIndices << corner + 1 << corner + GRID_SIZE + 2 << corner + GRID_SIZE + 1;
+        }
+    }
+
+    // the cache is given a full path rather than the name of a folder of the application data
+    QTemporaryDir directory;
+    auto cache = std::make_shared<ShapeCache>(directory.path().toStdString());
+    cache->initialize();
+
+    // the first shape builds its BVH and stores it
+    const btCollisionShape* builtShape = ShapeFactory::createShapeFromInfo(info, cache.get());
+    QVERIFY(builtShape != nullptr);
+    QCOMPARE(builtShape->getShapeType(), (int)TRIANGLE_MESH_SHAPE_PROXYTYPE);
+    QCOMPARE(cache->getNumTotalFiles(), (size_t)1);
+
+    // the second one reads it back
+    const btCollisionShape* cachedShape = ShapeFactory::createShapeFromInfo(info, cache.get());
+    QVERIFY(cachedShape != nullptr);
+    // the shapes are const in the manager, the getters of the BVH aren't
+    auto builtBvh = static_cast<btBvhTriangleMeshShape*>(const_cast<btCollisionShape*>(builtShape))->getOptimizedBvh();
+    auto cachedBvh = static_cast<btBvhTriangleMeshShape*>(const_cast<btCollisionShape*>(cachedShape))->getOptimizedBvh();
+    QVERIFY(cachedBvh != nullptr);
+    QVERIFY(cachedBvh != builtBvh);
+    QCOMPARE(cachedBvh->calculateSerializeBufferSize(), builtBvh->calculateSerializeBufferSize());
+    QCOMPARE(cachedBvh->getQuantizedNodeArray().size(), builtBvh->getQuantizedNodeArray().size());
+
+    // a ray down through the grid hits both shapes at the same place
+    auto castRay = [](const btCollisionShape* shape) {
+        btTransform identity;
+        identity.setIdentity();
+        btTransform rayFrom(btQuaternion::getIdentity(), btVector3(3.5f, 10.0f, 5.25f));
+        btTransform rayTo(btQuaternion::getIdentity(), btVector3(3.5f, -10.0f, 5.25f));
+        btCollisionObject object;
+        object.setCollisionShape(const_cast<btCollisionShape*>(shape));
+        btCollisionWorld::ClosestRayResultCallback result(rayFrom.getOrigin(), rayTo.getOrigin());
+        btCollisionWorld::rayTestSingle(rayFrom, rayTo, &object, shape, identity, result);
+        return result.hasHit() ? result.m_closestHitFraction : -1.0f;
+    };
+    float builtHit = castRay(builtShape);
+    QVERIFY(builtHit > 0.0f);
+    QCOMPARE(castRay(cachedShape), builtHit);
+
+    ShapeFactory::deleteShape(builtShape);
+    ShapeFactory::deleteShape(cachedShape);
+}
@@ -101,6 +101,44 @@ void testFilePersist() {
     QVERIFY(readClip->duration() == 5.0f);
 }
 
+void testIndexedFilePersist() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    // enough frames for the index to take several frames
+    const int NUM_FRAMES = 10000;
+    auto writeClip = Clip::newClip();
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)i, QByteArray::number(i)));
+    }
+    Clip::toFile(fileName, writeClip);
+
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == NUM_FRAMES);
+    QVERIFY(readClip->duration() == writeClip->duration());
+
+    // the frames are found from the index
+    readClip->seekFrameTime(NUM_FRAMES / 2);
+    auto readFrame = readClip->nextFrame();
+    QVERIFY(readFrame);
+    QVERIFY(readFrame->timeOffset == NUM_FRAMES / 2);
+    QVERIFY(readFrame->data == QByteArray::number(NUM_FRAMES / 2));
+
+    // the frames of a file truncated before its index are still read
+    QFile truncatedFile(fileName);
+    QVERIFY(truncatedFile.open(QIODevice::ReadWrite));
+    QVERIFY(truncatedFile.resize(truncatedFile.size() - 1));
+    truncatedFile.close();
+    readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == NUM_FRAMES);
+}
+
 void testClipOrdering() {
     auto writeClip = Clip::newClip();
     // simulate our of order addition of frames
@@ -124,5 +162,6 @@ int main(int, const char**) {
 
     testFrameTypeRegistration();
     testFilePersist();
+    testIndexedFilePersist();
     testClipOrdering();
 }
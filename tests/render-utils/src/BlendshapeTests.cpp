@@ -0,0 +1,141 @@
+//
+//  BlendshapeTests.cpp
+//  tests/render-utils/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BlendshapeTests.h"
+
+#include <Model.h>
+
+QTEST_MAIN(BlendshapeTests)
+
+// about the size of an ARKit face: 52 blendshapes, each moving a tenth of the vertices
+static const int NUM_VERTICES = 10000;
+static const int NUM_BLENDSHAPES = 52;
+static const int VERTICES_PER_BLENDSHAPE = NUM_VERTICES / 10;
+
+static HFMModel::Pointer hfmModel;
+static QVector<float> coefficients;
+
+static HFMMesh createMesh(int numVertices, int numBlendshapes, int verticesPerBlendshape) {
+    HFMMesh mesh;
+    mesh.vertices.resize(numVertices);
+    mesh.normals.resize(numVertices);
+    mesh.blendshapes.resize(numBlendshapes);
+    for (int i = 0; i < numBlendshapes; i++) {
+        auto& blendshape = mesh.blendshapes[i];
+        for (int j = 0; j < verticesPerBlendshape; j++) {
+            blendshape.indices.push_back((i * 37 + j * 7) % numVertices);
+            blendshape.vertices.push_back(glm::vec3(0.01f * j, 0.0f, 0.001f * i));
+            blendshape.normals.push_back(glm::vec3(0.0f, 0.1f, 0.0f));
+        }
+    }
+    return mesh;
+}
+
+void BlendshapeTests::initTestCase() {
+    hfmModel = std::make_shared<HFMModel>();
+    hfmModel->meshes.push_back(createMesh(NUM_VERTICES, NUM_BLENDSHAPES, VERTICES_PER_BLENDSHAPE));
+    for (int i = 0; i < NUM_BLENDSHAPES; i++) {
+        // a face rarely has more than a few blendshapes active at once
+        coefficients.push_back(i % 8 == 0 ? 0.5f : 0.0f);
+    }
+}
+
+void BlendshapeTests::testLayoutMesh() {
+    auto mesh = createMesh(5, 2, 3);
+    auto layout = GPUBlendshapes::layoutMesh(mesh);
+    QVERIFY(!layout.empty());
+
+    auto header = layout[0].packedPosNorTan;
+    QCOMPARE(header.x, 1u);
+    QCOMPARE(header.w, 2u);
+    // the ranges of 5 vertices take 3 uvec4s, and the 6 deltas then take 6 offsets and 2 uvec4s of indices
+    QCOMPARE(header.y, 4u);
+    QCOMPARE(header.z, 10u);
+    QCOMPARE((int)layout.size(), 12);
+
+    // every delta is in the range of the vertex it moves, from the blendshape it belongs to
+    uint32_t numDeltas = 0;
+    for (uint32_t vertex = 0; vertex < 5; vertex++) {
+        auto ranges = layout[header.x + vertex / 2].packedPosNorTan;
+        uint32_t first = ranges[(vertex % 2) * 2];
+        uint32_t count = ranges[(vertex % 2) * 2 + 1];
+        QCOMPARE(first, numDeltas);
+        for (uint32_t delta = first; delta < first + count; delta++) {
+            uint32_t blendshape = layout[header.z + delta / 4].packedPosNorTan[delta % 4];
+            QVERIFY(blendshape < 2u);
+            QVERIFY(mesh.blendshapes[blendshape].indices.contains((int)vertex));
+        }
+        numDeltas += count;
+    }
+    QCOMPARE(numDeltas, 6u);
+
+    QVERIFY(GPUBlendshapes::layoutMesh(createMesh(5, 0, 0)).empty());
+}
+
+void BlendshapeTests::testLayoutCoefficients() {
+    auto layout = GPUBlendshapes::layoutCoefficients({ 0.5f, 0.00001f, 1.0f, 0.25f, 0.75f, 0.1f }, 5);
+    QCOMPARE((int)layout.size(), 8);
+    QCOMPARE(layout[0], 0.5f);
+    QCOMPARE(layout[1], 0.0f);
+    QCOMPARE(layout[4], 0.75f);
+    QCOMPARE(layout[5], 0.0f);
+
+    QCOMPARE((int)GPUBlendshapes::layoutCoefficients({}, 0).size(), 4);
+}
+
+void BlendshapeTests::testBlendMeshes() {
+    HFMModel model;
+    HFMMesh mesh;
+    mesh.vertices.resize(3);
+    mesh.blendshapes.resize(3);
+    mesh.blendshapes[0].indices = { 1 };
+    mesh.blendshapes[0].vertices = { glm::vec3(1.0f, 0.0f, 0.0f) };
+    mesh.blendshapes[0].normals = { glm::vec3(0.0f) };
+    mesh.blendshapes[1].indices = { 1 };
+    mesh.blendshapes[1].vertices = { glm::vec3(0.0f, 4.0f, 0.0f) };
+    mesh.blendshapes[1].normals = { glm::vec3(0.0f) };
+    mesh.blendshapes[2].indices = { 2 };
+    mesh.blendshapes[2].vertices = { glm::vec3(0.0f, 0.0f, 8.0f) };
+    mesh.blendshapes[2].normals = { glm::vec3(0.0f) };
+    model.meshes.push_back(mesh);
+
+    QVector<BlendshapeOffset> offsets;
+    QVector<int> sizes;
+    ModelBlender::blendMeshes(model, { 1.0f, 0.5f, 0.00001f }, offsets, sizes);
+    QCOMPARE(sizes, QVector<int>({ 3 }));
+    QCOMPARE(offsets.size(), 3);
+
+    // the first component of a packed offset is the length it was normalized by, 1 when it doesn't move
+    QCOMPARE(glm::uintBitsToFloat(offsets[0].packedPosNorTan.x), 1.0f);
+    QCOMPARE(glm::uintBitsToFloat(offsets[1].packedPosNorTan.x), 2.0f);
+    QCOMPARE(glm::uintBitsToFloat(offsets[2].packedPosNorTan.x), 1.0f);
+}
+
+void BlendshapeTests::benchmarkBlendOnCPU() {
+    qint64 bytes = 0;
+    QBENCHMARK {
+        QVector<BlendshapeOffset> offsets;
+        QVector<int> sizes;
+        ModelBlender::blendMeshes(*hfmModel, coefficients, offsets, sizes);
+        bytes = offsets.size() * sizeof(BlendshapeOffset);
+    }
+    qDebug() << "Bytes uploaded per frame blending on the CPU:" << bytes;
+}
+
+void BlendshapeTests::benchmarkBlendOnGPU() {
+    qint64 bytes = 0;
+    QBENCHMARK {
+        auto layout = GPUBlendshapes::layoutCoefficients(coefficients, NUM_BLENDSHAPES);
+        bytes = layout.size() * sizeof(float);
+    }
+    qint64 staticBytes = GPUBlendshapes::layoutMesh(hfmModel->meshes[0]).size() * sizeof(BlendshapeOffset);
+    qDebug() << "Bytes uploaded per frame blending on the GPU:" << bytes << "after uploading" << staticBytes << "once";
+}
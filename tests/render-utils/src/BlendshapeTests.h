@@ -0,0 +1,28 @@
+//
+//  BlendshapeTests.h
+//  tests/render-utils/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_BlendshapeTests_h
+#define overte_BlendshapeTests_h
+
+#include <QtTest/QtTest>
+
+class BlendshapeTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void testLayoutMesh();
+    void testLayoutCoefficients();
+    void testBlendMeshes();
+    void benchmarkBlendOnCPU();
+    void benchmarkBlendOnGPU();
+};
+
+#endif // overte_BlendshapeTests_h
@@ -0,0 +1,95 @@
+//
+//  MaterialTableTests.cpp
+//  tests/render-utils/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "MaterialTableTests.h"
+
+#include <graphics/Material.h>
+#include <graphics/MaterialTable.h>
+
+#include <test-utils/GLMTestUtils.h>
+
+QTEST_MAIN(MaterialTableTests)
+
+using graphics::MaterialTable;
+
+void MaterialTableTests::testAllocate() {
+    MaterialTable table;
+    {
+        std::vector<MaterialTable::SlotPointer> slots;
+        for (size_t i = 0; i < MaterialTable::SLOTS_PER_BUFFER + 1; i++) {
+            slots.push_back(table.allocate());
+        }
+        QCOMPARE(table.getNumAllocated(), MaterialTable::SLOTS_PER_BUFFER + 1);
+        QCOMPARE(table.getNumBuffers(), (size_t)2);
+
+        // the slots of a buffer follow each other at aligned offsets
+        const auto& first = slots[0]->getView();
+        const auto& second = slots[1]->getView();
+        QVERIFY(first._buffer == second._buffer);
+        QCOMPARE((size_t)(second._offset - first._offset), MaterialTable::SLOT_SIZE);
+        QCOMPARE((size_t)first._size, MaterialTable::SLOT_SIZE);
+        QVERIFY(slots[0]->getID() != slots[1]->getID());
+        QVERIFY(slots.back()->getView()._buffer != first._buffer);
+    }
+    QCOMPARE(table.getNumAllocated(), (size_t)0);
+}
+
+void MaterialTableTests::testUpdate() {
+    MaterialTable table;
+    auto slot = table.allocate();
+    auto other = table.allocate();
+
+    graphics::MultiMaterial::Schema schema;
+    schema._albedo = glm::vec3(0.25f, 0.5f, 0.75f);
+    schema._key = 42;
+    slot->update(&schema, sizeof(schema));
+
+    const auto& updated = slot->getView().get<graphics::MultiMaterial::Schema>();
+    QCOMPARE(updated._albedo, schema._albedo);
+    QCOMPARE(updated._key, schema._key);
+    QVERIFY(slot->getView()._buffer->isDirty());
+
+    // the neighbouring slot isn't written
+    graphics::MultiMaterial::Schema otherSchema;
+    other->update(&otherSchema, sizeof(otherSchema));
+    QCOMPARE(slot->getView().get<graphics::MultiMaterial::Schema>()._key, schema._key);
+}
+
+void MaterialTableTests::testRecycle() {
+    MaterialTable table;
+    auto slot = table.allocate();
+    auto id = slot->getID();
+    auto buffer = slot->getView()._buffer;
+    slot.reset();
+
+    // the released slot might still be bound for the frame being recorded
+    auto next = table.allocate();
+    QVERIFY(next->getID() != id);
+
+    // once the frame has taken the data of the buffer, the slot is reused
+    auto update = buffer->getUpdate();
+    auto reused = table.allocate();
+    QCOMPARE(reused->getID(), id);
+}
+
+void MaterialTableTests::testMultiMaterial() {
+    graphics::MultiMaterial multiMaterial;
+    QCOMPARE(multiMaterial.getMaterialID(), MaterialTable::INVALID_ID);
+
+    multiMaterial.updateMaterialTable();
+    QVERIFY(multiMaterial.getMaterialID() != MaterialTable::INVALID_ID);
+    QCOMPARE(multiMaterial.getMaterialTableView().get<graphics::MultiMaterial::Schema>()._key,
+             multiMaterial.getSchemaBuffer().get<graphics::MultiMaterial::Schema>()._key);
+
+    // copies share the schema buffer, and the slot with it
+    graphics::MultiMaterial copy = multiMaterial;
+    QCOMPARE(copy.getMaterialID(), multiMaterial.getMaterialID());
+}
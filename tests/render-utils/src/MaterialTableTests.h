@@ -0,0 +1,26 @@
+//
+//  MaterialTableTests.h
+//  tests/render-utils/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_MaterialTableTests_h
+#define overte_MaterialTableTests_h
+
+#include <QtTest/QtTest>
+
+class MaterialTableTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testAllocate();
+    void testUpdate();
+    void testRecycle();
+    void testMultiMaterial();
+};
+
+#endif // overte_MaterialTableTests_h
@@ -0,0 +1,112 @@
+//
+//  SkinningPrepassTests.cpp
+//  tests/render-utils/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "SkinningPrepassTests.h"
+
+#include <glm/gtx/transform.hpp>
+
+#include <SkinningPrepass.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(SkinningPrepassTests)
+
+static const float EPSILON = 0.0001f;
+
+// three vertices, each weighted to one cluster, and a fourth shared by the first two
+static HFMMesh createMesh() {
+    HFMMesh mesh;
+    mesh.clusters.resize(3);
+    mesh.vertices = { glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(1.0f, 1.0f, 0.0f) };
+    mesh.normals = { glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) };
+    mesh.clusterIndices = { 0, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 0, 1, 0, 0 };
+    const uint16_t HALF_WEIGHT = UINT16_MAX / 2 + 1;
+    mesh.clusterWeights = { UINT16_MAX, 0, 0, 0, UINT16_MAX, 0, 0, 0, UINT16_MAX, 0, 0, 0, HALF_WEIGHT, HALF_WEIGHT, 0, 0 };
+    return mesh;
+}
+
+static const glm::mat4 TRANSLATION = glm::translate(glm::vec3(0.0f, 0.0f, 2.0f));
+static const glm::mat4 ROTATION = glm::rotate((float)M_PI_2, glm::vec3(0.0f, 0.0f, 1.0f));
+
+void SkinningPrepassTests::testCanSkin() {
+    auto mesh = createMesh();
+    QVERIFY(SkinningPrepass::canSkin(mesh));
+
+    // the meshes with one or two clusters take the transform of their first
+    auto rigidMesh = createMesh();
+    rigidMesh.clusters.resize(2);
+    QVERIFY(!SkinningPrepass::canSkin(rigidMesh));
+
+    auto blendshapedMesh = createMesh();
+    blendshapedMesh.blendshapes.resize(1);
+    QVERIFY(!SkinningPrepass::canSkin(blendshapedMesh));
+
+    auto unweightedMesh = createMesh();
+    unweightedMesh.clusterWeights.clear();
+    QVERIFY(!SkinningPrepass::canSkin(unweightedMesh));
+}
+
+void SkinningPrepassTests::testMatrixSkinning() {
+    auto mesh = createMesh();
+    std::vector<glm::mat4> clusterMatrices = { glm::mat4(), TRANSLATION, ROTATION };
+    std::vector<SkinningPrepass::Vertex> vertices;
+    SkinningPrepass::skinMesh(mesh, clusterMatrices, vertices);
+    QCOMPARE((int)vertices.size(), mesh.vertices.size());
+
+    QCOMPARE_WITH_ABS_ERROR(vertices[0].position, glm::vec3(1.0f, 0.0f, 0.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(vertices[1].position, glm::vec3(0.0f, 1.0f, 2.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(vertices[2].position, glm::vec3(0.0f, 0.0f, 1.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(vertices[2].normal, glm::vec3(-1.0f, 0.0f, 0.0f), EPSILON);
+    // the matrices are blended linearly, as in the vertex shader
+    QCOMPARE_WITH_ABS_ERROR(vertices[3].position, glm::vec3(1.0f, 1.0f, 1.0f), 0.001f);
+    QCOMPARE_WITH_ABS_ERROR(vertices[3].normal, glm::vec3(0.0f, 1.0f, 0.0f), 0.001f);
+}
+
+void SkinningPrepassTests::testDualQuaternionSkinning() {
+    auto mesh = createMesh();
+    std::vector<Model::TransformDualQuaternion> clusterDualQuaternions = {
+        Model::TransformDualQuaternion(glm::mat4()),
+        Model::TransformDualQuaternion(TRANSLATION),
+        Model::TransformDualQuaternion(ROTATION)
+    };
+    std::vector<SkinningPrepass::Vertex> vertices;
+    SkinningPrepass::skinMesh(mesh, clusterDualQuaternions, vertices);
+    QCOMPARE((int)vertices.size(), mesh.vertices.size());
+
+    QCOMPARE_WITH_ABS_ERROR(vertices[0].position, glm::vec3(1.0f, 0.0f, 0.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(vertices[1].position, glm::vec3(0.0f, 1.0f, 2.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(vertices[2].position, glm::vec3(0.0f, 0.0f, 1.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(vertices[2].normal, glm::vec3(-1.0f, 0.0f, 0.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(vertices[3].position, glm::vec3(1.0f, 1.0f, 1.0f), 0.001f);
+
+    // the cauterized vertices collapse to the cauterized position of their clusters
+    for (auto& clusterDualQuaternion : clusterDualQuaternions) {
+        clusterDualQuaternion.setCauterizationParameters(1.0f, glm::vec3(0.0f, 5.0f, 0.0f));
+    }
+    SkinningPrepass::skinMesh(mesh, clusterDualQuaternions, vertices);
+    QCOMPARE_WITH_ABS_ERROR(vertices[1].position, glm::vec3(0.0f, 5.0f, 0.0f), EPSILON);
+}
+
+void SkinningPrepassTests::testVertexFormat() {
+    gpu::Stream::Format format;
+    format.setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0);
+    format.setAttribute(gpu::Stream::NORMAL, 1, gpu::Element(gpu::VEC4, gpu::NINT2_10_10_10, gpu::XYZW), 0);
+    format.setAttribute(gpu::Stream::TEXCOORD, 2, gpu::Element(gpu::VEC2, gpu::HALF, gpu::UV), 0);
+
+    auto skinnedFormat = SkinningPrepass::makeVertexFormat(format, 3);
+    const auto& attributes = skinnedFormat->getAttributes();
+    QCOMPARE((int)attributes.size(), 3);
+    QCOMPARE((int)attributes.at(gpu::Stream::POSITION)._channel, 3);
+    QCOMPARE((int)attributes.at(gpu::Stream::NORMAL)._channel, 3);
+    QCOMPARE((int)attributes.at(gpu::Stream::NORMAL)._offset, (int)sizeof(glm::vec3));
+    QCOMPARE((int)attributes.at(gpu::Stream::TEXCOORD)._channel, 2);
+}
@@ -0,0 +1,26 @@
+//
+//  SkinningPrepassTests.h
+//  tests/render-utils/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_SkinningPrepassTests_h
+#define overte_SkinningPrepassTests_h
+
+#include <QtTest/QtTest>
+
+class SkinningPrepassTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testCanSkin();
+    void testMatrixSkinning();
+    void testDualQuaternionSkinning();
+    void testVertexFormat();
+};
+
+#endif // overte_SkinningPrepassTests_h
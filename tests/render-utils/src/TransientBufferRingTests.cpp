@@ -0,0 +1,78 @@
+//
+//  TransientBufferRingTests.cpp
+//  tests/render-utils/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "TransientBufferRingTests.h"
+
+#include <TransientBufferRing.h>
+
+QTEST_MAIN(TransientBufferRingTests)
+
+void TransientBufferRingTests::testAllocate() {
+    TransientBufferRing ring;
+    const float first[3] = { 1.0f, 2.0f, 3.0f };
+    const int second = 42;
+
+    auto firstRange = ring.allocate(sizeof(first), first);
+    auto secondRange = ring.allocate(sizeof(second), &second);
+
+    // the data of a frame follow each other in one buffer, at aligned offsets
+    QCOMPARE(ring.getNumBuffers(), (size_t)1);
+    QVERIFY(firstRange.buffer == secondRange.buffer);
+    QCOMPARE(firstRange.offset, (gpu::Offset)0);
+    QCOMPARE(secondRange.offset, (gpu::Offset)TransientBufferRing::ALIGNMENT);
+    QCOMPARE(reinterpret_cast<const float*>(firstRange.buffer->getData())[2], first[2]);
+    QCOMPARE(*reinterpret_cast<const int*>(secondRange.buffer->getData() + secondRange.offset), second);
+
+    // a full buffer moves on to another
+    std::vector<char> data(TransientBufferRing::BUFFER_SIZE / 2);
+    auto thirdRange = ring.allocate(data.size(), data.data());
+    auto fourthRange = ring.allocate(data.size(), data.data());
+    QVERIFY(thirdRange.buffer == firstRange.buffer);
+    QVERIFY(fourthRange.buffer != firstRange.buffer);
+    QCOMPARE(fourthRange.offset, (gpu::Offset)0);
+    QCOMPARE(ring.getNumBuffers(), (size_t)2);
+}
+
+void TransientBufferRingTests::testRecycle() {
+    TransientBufferRing ring;
+    const int value = 1;
+
+    auto range = ring.allocate(sizeof(value), &value);
+    auto buffer = range.buffer;
+
+    // the next frame starts another buffer, as the last frame may still be drawn from its buffer
+    auto update = buffer->getUpdate();
+    auto nextFrame = ring.allocate(sizeof(value), &value);
+    QVERIFY(nextFrame.buffer != buffer);
+    QCOMPARE(nextFrame.offset, (gpu::Offset)0);
+
+    // and the one after goes back to the first, the data of which the frame before has taken
+    auto nextUpdate = nextFrame.buffer->getUpdate();
+    auto frameAfter = ring.allocate(sizeof(value), &value);
+    QVERIFY(frameAfter.buffer == buffer);
+    QCOMPARE(frameAfter.offset, (gpu::Offset)0);
+    QCOMPARE(ring.getNumBuffers(), (size_t)2);
+
+    // a buffer whose data haven't been taken isn't written over
+    auto sameFrame = ring.allocate(sizeof(value), &value);
+    QVERIFY(sameFrame.buffer == buffer);
+    QVERIFY(sameFrame.offset > frameAfter.offset);
+}
+
+void TransientBufferRingTests::testLargeData() {
+    TransientBufferRing ring;
+    std::vector<char> data(TransientBufferRing::BUFFER_SIZE + 1, 7);
+
+    auto range = ring.allocate(data.size(), data.data());
+    QCOMPARE(range.offset, (gpu::Offset)0);
+    QCOMPARE((size_t)range.buffer->getSize(), data.size());
+    QCOMPARE(ring.getNumBuffers(), (size_t)0);
+}
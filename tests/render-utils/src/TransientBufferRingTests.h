@@ -0,0 +1,25 @@
+//
+//  TransientBufferRingTests.h
+//  tests/render-utils/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_TransientBufferRingTests_h
+#define overte_TransientBufferRingTests_h
+
+#include <QtTest/QtTest>
+
+class TransientBufferRingTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testAllocate();
+    void testRecycle();
+    void testLargeData();
+};
+
+#endif // overte_TransientBufferRingTests_h
@@ -0,0 +1,91 @@
+//
+//  ScriptCodeCacheTests.cpp
+//  tests/script-engine/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ScriptCodeCacheTests.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+
+#include <ScriptCodeCache.h>
+
+QTEST_MAIN(ScriptCodeCacheTests)
+
+static const QString SOURCE { "(function() { this.preload = function(entityID) { print(entityID); }; })" };
+static const QString ENGINE_VERSION { "V8 1.0" };
+
+void ScriptCodeCacheTests::testKey() {
+    auto key = ScriptCodeCache::getKey(SOURCE, ENGINE_VERSION);
+    QCOMPARE(ScriptCodeCache::getKey(SOURCE, ENGINE_VERSION), key);
+    QVERIFY(ScriptCodeCache::getKey(SOURCE + " ", ENGINE_VERSION) != key);
+    // the code of one version of the engine isn't found by another
+    QVERIFY(ScriptCodeCache::getKey(SOURCE, "V8 1.1") != key);
+}
+
+void ScriptCodeCacheTests::testReadWrite() {
+    // the cache is given a full path rather than the name of a folder of the application data
+    QTemporaryDir directory;
+    auto cache = std::make_shared<ScriptCodeCache>(directory.path().toStdString());
+    cache->initialize();
+
+    auto key = ScriptCodeCache::getKey(SOURCE, ENGINE_VERSION);
+    QVERIFY(cache->readCode(key).isEmpty());
+
+    QByteArray code(4096, '\0');
+    for (int i = 0; i < code.size(); i++) {
+        code[i] = (char)(i * 7);
+    }
+    QVERIFY(cache->writeCode(key, code));
+    QCOMPARE(cache->readCode(key), code);
+
+    // the code of a source is replaced when the engine rejects it and compiles the source again
+    QByteArray newCode(1024, 'x');
+    QVERIFY(cache->writeCode(key, newCode));
+    QCOMPARE(cache->readCode(key), newCode);
+    QCOMPARE(cache->getNumTotalFiles(), (size_t)1);
+}
+
+void ScriptCodeCacheTests::testPersistence() {
+    QTemporaryDir directory;
+    auto key = ScriptCodeCache::getKey(SOURCE, ENGINE_VERSION);
+    QByteArray code(2048, 'c');
+    {
+        auto cache = std::make_shared<ScriptCodeCache>(directory.path().toStdString());
+        cache->initialize();
+        QVERIFY(cache->writeCode(key, code));
+    }
+
+    // the next session finds the code on disk
+    auto cache = std::make_shared<ScriptCodeCache>(directory.path().toStdString());
+    cache->initialize();
+    QCOMPARE(cache->readCode(key), code);
+}
+
+void ScriptCodeCacheTests::testCorruptEntry() {
+    QTemporaryDir directory;
+    auto cache = std::make_shared<ScriptCodeCache>(directory.path().toStdString());
+    cache->initialize();
+
+    auto key = ScriptCodeCache::getKey(SOURCE, ENGINE_VERSION);
+    QVERIFY(cache->writeCode(key, QByteArray(2048, 'c')));
+    QString filepath;
+    {
+        auto file = cache->getFile(key);
+        QVERIFY(file);
+        filepath = QString::fromStdString(file->getFilepath());
+    }
+
+    // a truncated entry isn't returned
+    QFile file(filepath);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(100));
+    file.close();
+    QVERIFY(cache->readCode(key).isEmpty());
+}
@@ -0,0 +1,26 @@
+//
+//  ScriptCodeCacheTests.h
+//  tests/script-engine/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ScriptCodeCacheTests_h
+#define overte_ScriptCodeCacheTests_h
+
+#include <QtTest/QtTest>
+
+class ScriptCodeCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testKey();
+    void testReadWrite();
+    void testPersistence();
+    void testCorruptEntry();
+};
+
+#endif // overte_ScriptCodeCacheTests_h
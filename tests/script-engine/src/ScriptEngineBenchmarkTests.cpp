@@ -198,3 +198,43 @@ void ScriptEngineBenchmarkTests::benchmarkSimpleScript() {
     }
 
 }
+
+void ScriptEngineBenchmarkTests::benchmarkEngineCreation() {
+    // the first engine creates the startup snapshot, the following ones are created from it
+    auto firstEngine = newScriptEngine();
+
+    QBENCHMARK {
+        auto engine = newScriptEngine();
+        engine->newObject();
+    }
+}
+
+// Vec3.reflect is still invoked through the object proxy, Vec3.cross and Quat.multiply are native, with the same
+// arguments and results, so the difference between these is the cost of the proxy call and the conversions
+
+void ScriptEngineBenchmarkTests::benchmarkVec3ProxyMethod() {
+    QBENCHMARK {
+        auto sm = makeManager("var v = { x: 1, y: 2, z: 3 }; var n = { x: 0, y: 1, z: 0 };"
+                              "for (var i = 0; i < 10000; i++) { v = Vec3.reflect(v, n); }"
+                              "Script.stop(true);", "testVec3Proxy.js");
+        sm->run();
+    }
+}
+
+void ScriptEngineBenchmarkTests::benchmarkVec3NativeMethod() {
+    QBENCHMARK {
+        auto sm = makeManager("var v = { x: 1, y: 2, z: 3 }; var n = { x: 0, y: 1, z: 0 };"
+                              "for (var i = 0; i < 10000; i++) { v = Vec3.cross(v, n); }"
+                              "Script.stop(true);", "testVec3Native.js");
+        sm->run();
+    }
+}
+
+void ScriptEngineBenchmarkTests::benchmarkQuatNativeMethod() {
+    QBENCHMARK {
+        auto sm = makeManager("var q = Quat.IDENTITY; var delta = Quat.fromPitchYawRollDegrees(0, 0.1, 0);"
+                              "for (var i = 0; i < 10000; i++) { q = Quat.multiply(delta, q); }"
+                              "Script.stop(true);", "testQuatNative.js");
+        sm->run();
+    }
+}
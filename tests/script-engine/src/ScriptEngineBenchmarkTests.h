@@ -29,6 +29,10 @@ private slots:
     void benchmarkSetProperty16K();
     void benchmarkQueryProperty();
     void benchmarkSimpleScript();
+    void benchmarkEngineCreation();
+    void benchmarkVec3ProxyMethod();
+    void benchmarkVec3NativeMethod();
+    void benchmarkQuatNativeMethod();
 
 private:
     ScriptManagerPointer makeManager(const QString &source, const QString &filename);
@@ -215,3 +215,34 @@ void ScriptEngineNetworkedTests::testRequireInfinite() {
 
     QVERIFY(errors.contains("Maximum call stack size exceeded"));
 }
+
+void ScriptEngineNetworkedTests::testWorker() {
+    auto sm = makeManager(
+        "var worker = Script.createWorker('./tests/worker_echo.js');"
+        "var buffer = new Uint8Array([1, 2, 3, 4]).buffer;"
+        "worker.onmessage = function (event) {"
+        "    print(event.data.sum, event.data.buffer.byteLength, event.data.isWorker, worker.getStatistics().messagesReceived);"
+        "    Script.stop(true);"
+        "};"
+        "worker.onerror = function (event) {"
+        "    print('Error', event.message);"
+        "    Script.stop(true);"
+        "};"
+        "worker.postMessage({ values: [1, 2, 3], buffer: buffer }, [buffer]);"
+        "print('Posted', buffer.byteLength, worker.running);"
+        "Script.setTimeout(function () {"
+        "    print('Timed out');"
+        "    Script.stop(true);"
+        "}, 10000);", "testWorker.js");
+    QStringList printed;
+    QStringList expected { "Posted 0 true", "6 4 true 1" };
+
+    connect(sm.get(), &ScriptManager::printedMessage, [&printed](const QString& message, const QString& engineName){
+        printed.append(message);
+    });
+
+    sm->run();
+    QVERIFY(sm->isFinished());
+
+    QCOMPARE(printed, expected);
+}
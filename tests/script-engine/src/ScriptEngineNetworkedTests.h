@@ -29,6 +29,7 @@ private slots:
     void testRequire();
     void testScriptRequire();
     void testRequireInfinite();
+    void testWorker();
 
 
 private:
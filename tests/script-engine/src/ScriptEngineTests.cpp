@@ -271,6 +271,93 @@ void ScriptEngineTests::testSignal() {
     QVERIFY(printed.length() >= 10);
 }
 
+void ScriptEngineTests::testCoalescedSignal() {
+    QString script =
+        "var immediateCalls = 0;"
+        "var coalescedCalls = 0;"
+        "var coalescedEvents = 0;"
+        "Script.setCoalescedSignalOptions('update', 100);"
+        "Script.update.connect(function(deltaTime) {"
+        "    immediateCalls++;"
+        "});"
+        "Script.update.connectCoalesced(function(events) {"
+        "    coalescedCalls++;"
+        "    coalescedEvents += events.length;"
+        "    if (typeof events[0][0] !== 'number') {"
+        "        throw new Error('Expected the arguments of the update signal');"
+        "    }"
+        "    if (coalescedEvents >= 20) {"
+        "        print(coalescedCalls + ' ' + coalescedEvents + ' ' + immediateCalls);"
+        "        Script.stop(true);"
+        "    }"
+        "});";
+
+    QStringList printed;
+    auto sm = makeManager(script, "testCoalescedSignal.js");
+
+    connect(sm.get(), &ScriptManager::printedMessage, [&printed](const QString& message, const QString& engineName){
+        printed.append(message);
+    });
+
+    sm->run();
+    QVERIFY(sm->getUncaughtException() == nullptr);
+    QCOMPARE(printed.length(), 1);
+    QStringList counts = printed[0].split(' ');
+    QCOMPARE(counts.length(), 3);
+    // the emissions of several frames are delivered in one call, and none of them is delivered before it's emitted
+    QVERIFY(counts[0].toInt() < counts[1].toInt());
+    QVERIFY(counts[1].toInt() <= counts[2].toInt());
+}
+
+void ScriptEngineTests::testProfilingStatistics() {
+    QString script =
+        "var count = 0;"
+        "Script.update.connect(function(deltaTime) {"
+        "    count++;"
+        "    var garbage = [];"
+        "    for (var i = 0; i < 1000; i++) {"
+        "        garbage.push(new Array(1000).fill(i));"
+        "    }"
+        "    if (count >= 10) {"
+        "        Script.stop(true);"
+        "    }"
+        "});";
+
+    auto sm = makeManager(script, "testProfilingStatistics.js");
+    sm->run();
+
+    ScriptEngineProfilingStatistics statistics = sm->engine()->getProfilingStatistics();
+    QVERIFY(statistics.signalCallCount >= 10);
+    QVERIFY(statistics.gcCount > 0);
+    QVERIFY(statistics.usedHeapSize > 0);
+    QVERIFY(statistics.usedHeapSize <= statistics.totalHeapSize);
+}
+
+void ScriptEngineTests::testArrayBufferTransfer() {
+    auto sm = makeManager("", "testArrayBufferTransfer.js");
+    auto engine = sm->engine();
+
+    QByteArray data(1024, 1);
+    ScriptValue buffer = engine->newArrayBuffer(data);
+    engine->globalObject().setProperty("buffer", buffer);
+    // the script writes to its own copy, as data is still referenced here
+    engine->evaluate("new Uint8Array(buffer)[0] = 2;");
+    QCOMPARE(data.at(0), (char)1);
+    QCOMPARE(engine->evaluate("new Uint8Array(buffer)[0]").toInt32(), 2);
+
+    // the data is handed back without a copy and the script no longer sees it
+    QByteArray transferred = engine->transferArrayBuffer(buffer);
+    QCOMPARE(transferred.size(), 1024);
+    QCOMPARE(transferred.at(0), (char)2);
+    QCOMPARE(transferred.at(1), (char)1);
+    QCOMPARE(engine->evaluate("buffer.byteLength").toInt32(), 0);
+
+    // the buffers that the script makes are copied out, and detached too
+    ScriptValue scriptBuffer = engine->evaluate("var scriptBuffer = new Uint8Array([1, 2, 3]).buffer; scriptBuffer");
+    QCOMPARE(engine->transferArrayBuffer(scriptBuffer), QByteArray("\x01\x02\x03"));
+    QCOMPARE(engine->evaluate("scriptBuffer.byteLength").toInt32(), 0);
+}
+
 void ScriptEngineTests::testSignalWithException() {
     QString script =
         "var count = 0;"
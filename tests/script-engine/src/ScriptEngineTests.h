@@ -64,7 +64,10 @@ private slots:
     void testRaiseExceptionAndCatch();
     void testSignal();
     void testSignalWithException();
+    void testCoalescedSignal();
     void testQuat();
+    void testProfilingStatistics();
+    void testArrayBufferTransfer();
 
 
 private:
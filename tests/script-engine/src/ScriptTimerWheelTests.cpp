@@ -0,0 +1,131 @@
+//
+//  ScriptTimerWheelTests.cpp
+//  tests/script-engine/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ScriptTimerWheelTests.h"
+
+#include <vector>
+
+#include <ScriptTimerWheel.h>
+
+QTEST_MAIN(ScriptTimerWheelTests)
+
+using TimerIDs = std::vector<ScriptTimerWheel::TimerID>;
+
+void ScriptTimerWheelTests::testSingleShot() {
+    ScriptTimerWheel wheel;
+    TimerIDs due;
+    auto id = wheel.add(1000, 10, true);
+
+    wheel.advance(1009, due);
+    QVERIFY(due.empty());
+    wheel.advance(1010, due);
+    QCOMPARE(due, TimerIDs({ id }));
+    QVERIFY(wheel.empty());
+
+    due.clear();
+    wheel.advance(2000, due);
+    QVERIFY(due.empty());
+}
+
+void ScriptTimerWheelTests::testOrder() {
+    ScriptTimerWheel wheel;
+    TimerIDs due;
+    auto late = wheel.add(0, 500, true);
+    auto early = wheel.add(0, 5, true);
+    auto middle = wheel.add(0, 70, true);
+    auto sameAsMiddle = wheel.add(0, 70, true);
+
+    // the timers that are due in the same advance come in the order they're due, then in the order they were added
+    wheel.advance(1000, due);
+    QCOMPARE(due, TimerIDs({ early, middle, sameAsMiddle, late }));
+}
+
+void ScriptTimerWheelTests::testRepeating() {
+    ScriptTimerWheel wheel;
+    TimerIDs due;
+    auto id = wheel.add(0, 16, false);
+
+    for (qint64 now = 1; now <= 160; now++) {
+        wheel.advance(now, due);
+    }
+    QCOMPARE(due.size(), (size_t)10);
+    QCOMPARE(wheel.size(), (size_t)1);
+
+    // a timer that fell behind fires once instead of catching up
+    due.clear();
+    wheel.advance(1000, due);
+    QCOMPARE(due, TimerIDs({ id }));
+    due.clear();
+    wheel.advance(1015, due);
+    QVERIFY(due.empty());
+    wheel.advance(1016, due);
+    QCOMPARE(due, TimerIDs({ id }));
+}
+
+void ScriptTimerWheelTests::testRemove() {
+    ScriptTimerWheel wheel;
+    TimerIDs due;
+    auto removed = wheel.add(0, 100, false);
+    auto kept = wheel.add(0, 100, true);
+
+    QVERIFY(wheel.remove(removed));
+    QVERIFY(!wheel.remove(removed));
+    wheel.advance(100, due);
+    QCOMPARE(due, TimerIDs({ kept }));
+    QVERIFY(!wheel.remove(kept));
+    QVERIFY(wheel.empty());
+}
+
+void ScriptTimerWheelTests::testLongTimers() {
+    ScriptTimerWheel wheel;
+    TimerIDs due;
+    const qint64 start = 123456;
+    // one in each of the levels, and one past all of them
+    const std::vector<int> intervals { 50, 3000, 200000, 10000000, 20000000 };
+    TimerIDs ids;
+    for (int interval : intervals) {
+        ids.push_back(wheel.add(start, interval, true));
+    }
+
+    for (size_t i = 0; i < intervals.size(); i++) {
+        wheel.advance(start + intervals[i] - 1, due);
+        QCOMPARE(due.size(), i);
+        wheel.advance(start + intervals[i], due);
+        QCOMPARE(due.size(), i + 1);
+        QCOMPARE(due.back(), ids[i]);
+    }
+    QVERIFY(wheel.empty());
+}
+
+void ScriptTimerWheelTests::testNextAdvance() {
+    ScriptTimerWheel wheel;
+    QCOMPARE(wheel.getTimeUntilNextAdvance(0), (qint64)-1);
+
+    wheel.add(0, 10, true);
+    QCOMPARE(wheel.getTimeUntilNextAdvance(0), (qint64)10);
+    QCOMPARE(wheel.getTimeUntilNextAdvance(4), (qint64)6);
+    QCOMPARE(wheel.getTimeUntilNextAdvance(20), (qint64)0);
+
+    // advancing to the returned times reaches every timer when it's due, without advancing every millisecond
+    wheel.add(0, 100000, true);
+    TimerIDs due;
+    qint64 now = 0;
+    int numAdvances = 0;
+    while (!wheel.empty()) {
+        now += wheel.getTimeUntilNextAdvance(now);
+        wheel.advance(now, due);
+        numAdvances++;
+        QVERIFY(now <= 100000);
+    }
+    QCOMPARE(now, (qint64)100000);
+    QCOMPARE(due.size(), (size_t)2);
+    QVERIFY(numAdvances < 100);
+}
@@ -0,0 +1,28 @@
+//
+//  ScriptTimerWheelTests.h
+//  tests/script-engine/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ScriptTimerWheelTests_h
+#define overte_ScriptTimerWheelTests_h
+
+#include <QtTest/QtTest>
+
+class ScriptTimerWheelTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testSingleShot();
+    void testOrder();
+    void testRepeating();
+    void testRemove();
+    void testLongTimers();
+    void testNextAdvance();
+};
+
+#endif // overte_ScriptTimerWheelTests_h
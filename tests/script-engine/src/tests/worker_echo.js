@@ -0,0 +1,7 @@
+// Worker of ScriptEngineNetworkedTests::testWorker, sums the values that it's sent and sends back the buffer
+Worker.onmessage = function (event) {
+    var sum = event.data.values.reduce(function (a, b) {
+        return a + b;
+    }, 0);
+    Worker.postMessage({ sum: sum, buffer: event.data.buffer, isWorker: Script.isWorkerScript() }, [event.data.buffer]);
+};
@@ -216,3 +216,35 @@ void DependencyManagerTests::testDependencyManagerMultiThreaded() {
     getThread2.join();
     assertDeps(false);
 }
+
+void DependencyManagerTests::testReplacedDependency() {
+    auto first = DependencyManager::set<A>();
+    QCOMPARE(DependencyManager::get<A>(), first);
+
+    // the lookups find the new instance even while the old one is still held
+    auto second = DependencyManager::set<A>();
+    QVERIFY(second != first);
+    QCOMPARE(DependencyManager::get<A>(), second);
+
+    // and the instances cached by other threads are invalidated as well
+    QSharedPointer<A> fromThread;
+    std::thread getThread([&] { fromThread = DependencyManager::get<A>(); });
+    getThread.join();
+    QCOMPARE(fromThread, second);
+
+    first.clear();
+    second.clear();
+    fromThread.clear();
+    DependencyManager::destroy<A>();
+    QCOMPARE(DependencyManager::isSet<A>(), false);
+}
+
+void DependencyManagerTests::benchmarkGet() {
+    DependencyManager::set<B>();
+    QBENCHMARK {
+        for (int i = 0; i < 1000; i++) {
+            DependencyManager::get<B>();
+        }
+    }
+    DependencyManager::destroy<B>();
+}
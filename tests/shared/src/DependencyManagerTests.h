@@ -16,6 +16,8 @@ class DependencyManagerTests : public QObject {
 private slots:
     void testDependencyManager();
     void testDependencyManagerMultiThreaded();
+    void testReplacedDependency();
+    void benchmarkGet();
 };
 
 #endif // hifi_DependencyManagerTests_h
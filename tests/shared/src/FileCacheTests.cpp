@@ -10,6 +10,8 @@
 
 #include "FileCacheTests.h"
 
+#include <thread>
+
 #include <shared/FileCache.h>
 
 QTEST_GUILESS_MAIN(FileCacheTests)
@@ -62,6 +64,7 @@ void FileCacheTests::testUnusedFiles() {
         inUseFiles.clear();
         QCOMPARE(cache->getNumCachedFiles(), (size_t)10);
         QCOMPARE(cache->getNumTotalFiles(), (size_t)10);
+        FileCache::waitForDeletions();
         QVERIFY(getCacheDirectorySize() <= MAX_UNUSED_SIZE);
     }
 
@@ -132,6 +135,7 @@ void FileCacheTests::testFreeSpacePreservation() {
     cache->setMinFreeSize(targetFreeSpace);
     QCOMPARE(cache->getNumCachedFiles(), (size_t)5);
     QCOMPARE(cache->getNumTotalFiles(), (size_t)5);
+    FileCache::waitForDeletions();
     QVERIFY(getFreeSpace() >= targetFreeSpace);
     for (int i = 0; i < 95; ++i) {
         std::string key = getFileKey(i);
@@ -153,9 +157,107 @@ void FileCacheTests::testWipe() {
     cache->wipe();
     QCOMPARE(cache->getNumCachedFiles(), (size_t)0);
     QCOMPARE(cache->getNumTotalFiles(), (size_t)0);
+    FileCache::waitForDeletions();
     QCOMPARE(getCacheDirectorySize(), (size_t)0);
 }
 
+void FileCacheTests::testSharedBudget() {
+    auto budget = std::make_shared<SharedBudget>(MAX_UNUSED_SIZE / 2);
+    auto makeBudgetedCache = [&](const QString& dirname) {
+        auto result = std::make_shared<FileCache>(QDir(_testDir.path()).filePath(dirname).toStdString(), "tmp");
+        result->setSharedBudget(budget);
+        result->initialize();
+        result->setMaxSize(MAX_UNUSED_SIZE);
+        return result;
+    };
+    auto first = makeBudgetedCache("first");
+    auto second = makeBudgetedCache("second");
+
+    // Each cache is within its own size, together they're over the shared budget
+    for (int i = 0; i < 4; ++i) {
+        first->writeFile(TEST_DATA.data(), FileCache::Metadata(getFileKey(i), TEST_DATA.size()));
+    }
+    QCOMPARE(first->getNumCachedFiles(), (size_t)4);
+    for (int i = 0; i < 4; ++i) {
+        second->writeFile(TEST_DATA.data(), FileCache::Metadata(getFileKey(i), TEST_DATA.size()));
+    }
+    QCOMPARE(first->getNumCachedFiles(), (size_t)4);
+    QCOMPARE(second->getNumCachedFiles(), (size_t)1);
+    QCOMPARE((size_t)budget->totalSize, first->getSizeTotalFiles() + second->getSizeTotalFiles());
+    QVERIFY(budget->totalSize <= budget->maxSize);
+
+    second.reset();
+    QCOMPARE((size_t)budget->totalSize, first->getSizeTotalFiles());
+}
+
+void FileCacheTests::testConcurrentAccess() {
+    static const int NUM_THREADS { 4 };
+    static const int NUM_KEYS { 20 };
+    static const QByteArray FILE_DATA { 256 * 1024, '1' };
+    QString path = QDir(_testDir.path()).filePath("concurrent");
+    auto cache = makeFileCache(path);
+
+    // Together the threads write twice the size of the cache, so files are ejected and written again while in use
+    std::vector<std::thread> threads;
+    std::atomic<int> failures { 0 };
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 5 * NUM_KEYS; ++i) {
+                std::string key = getFileKey(t * NUM_KEYS + i % NUM_KEYS);
+                auto file = cache->getFile(key);
+                if (!file) {
+                    file = cache->writeFile(FILE_DATA.data(), FileCache::Metadata(key, FILE_DATA.size()));
+                }
+                if (!file || !QFileInfo::exists(file->getFilepath().c_str())) {
+                    ++failures;
+                }
+                auto other = cache->getFile(getFileKey(((t + 1) % NUM_THREADS) * NUM_KEYS + i % NUM_KEYS));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    FileCache::waitForDeletions();
+
+    QCOMPARE(failures.load(), 0);
+    QVERIFY(cache->getSizeTotalFiles() <= MAX_UNUSED_SIZE);
+    QCOMPARE(cache->getNumCachedFiles(), cache->getNumTotalFiles());
+
+    // The files on disk are exactly the ones in the cache
+    QDir dir(path);
+    auto filenames = dir.entryList({ "*.tmp" });
+    QCOMPARE((size_t)filenames.size(), cache->getNumTotalFiles());
+    for (const auto& filename : filenames) {
+        QVERIFY(cache->getFile(filename.section('.', 0, 0).toStdString()).get());
+    }
+}
+
+void FileCacheTests::benchmarkGetFile() {
+    auto cache = makeFileCache(QDir(_testDir.path()).filePath("getFileBenchmark"));
+    for (int i = 0; i < 10; ++i) {
+        cache->writeFile(TEST_DATA.data(), FileCache::Metadata(getFileKey(i), TEST_DATA.size()));
+    }
+    QBENCHMARK {
+        for (int i = 0; i < 10; ++i) {
+            auto file = cache->getFile(getFileKey(i));
+        }
+    }
+}
+
+void FileCacheTests::benchmarkEviction() {
+    static const QByteArray FILE_DATA { 16 * 1024, '2' };
+    auto cache = makeFileCache(QDir(_testDir.path()).filePath("evictionBenchmark"));
+    // Every write ejects a file once the cache is full
+    cache->setMaxSize(FILE_DATA.size() * 10);
+    int i = 0;
+    QBENCHMARK {
+        std::string key = QString::number(i++).toStdString();
+        cache->writeFile(FILE_DATA.data(), FileCache::Metadata(key, FILE_DATA.size()));
+    }
+    FileCache::waitForDeletions();
+    QVERIFY(cache->getNumTotalFiles() <= (size_t)10);
+}
 
 void FileCacheTests::cleanupTestCase() {
 }
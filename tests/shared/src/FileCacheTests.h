@@ -21,6 +21,10 @@ private slots:
     void testFreeSpacePreservation();
     void cleanupTestCase();
     void testWipe();
+    void testSharedBudget();
+    void testConcurrentAccess();
+    void benchmarkGetFile();
+    void benchmarkEviction();
 
 private:
     size_t getFreeSpace() const;
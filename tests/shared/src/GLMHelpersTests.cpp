@@ -105,6 +105,114 @@ void GLMHelpersTests::testSixByteOrientationCompression() {
     testQuatCompression(-(ROT_Z_30 * ROT_X_90 * ROT_Y_180));
 }
 
+static glm::quat randomQuat() {
+    glm::vec3 axis(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f));
+    if (glm::length(axis) < EPSILON) {
+        axis = Vectors::UNIT_Y;
+    }
+    return glm::angleAxis(randFloatInRange(-PI, PI), glm::normalize(axis));
+}
+
+void GLMHelpersTests::testBatchedOrientationCompression() {
+    // odd count so the tail after the last full block is covered too
+    const int NUM_QUATS = 83;
+    const int NUM_BYTES = NUM_QUATS * 6;
+    std::vector<glm::quat> quats;
+    for (int i = 0; i < NUM_QUATS; i++) {
+        quats.push_back(randomQuat());
+    }
+    quats[0] = Quaternions::IDENTITY;
+    quats[1] = -Quaternions::IDENTITY;
+    quats[2] = glm::angleAxis(PI, Vectors::UNIT_X);
+    quats[3] = glm::angleAxis(PI, Vectors::UNIT_Z);
+
+    std::vector<uint8_t> singleBytes(NUM_BYTES);
+    std::vector<uint8_t> batchedBytes(NUM_BYTES);
+    int singleSize = 0;
+    for (const auto& quat : quats) {
+        singleSize += packOrientationQuatToSixBytes(singleBytes.data() + singleSize, quat);
+    }
+    QCOMPARE(packOrientationQuatsToSixBytes(batchedBytes.data(), quats.data(), NUM_QUATS), NUM_BYTES);
+    QCOMPARE(singleSize, NUM_BYTES);
+    QVERIFY(singleBytes == batchedBytes);
+
+    std::vector<glm::quat> unpacked(NUM_QUATS);
+    QCOMPARE(unpackOrientationQuatsFromSixBytes(batchedBytes.data(), unpacked.data(), NUM_QUATS), NUM_BYTES);
+    int offset = 0;
+    for (int i = 0; i < NUM_QUATS; i++) {
+        glm::quat single;
+        offset += unpackOrientationQuatFromSixBytes(singleBytes.data() + offset, single);
+        QCOMPARE(unpacked[i], single);
+        testQuatCompression(quats[i]);
+    }
+}
+
+void GLMHelpersTests::testBatchedVec3Compression() {
+    const int NUM_VECS = 83;
+    const int RADIX = 14;
+    const int NUM_BYTES = NUM_VECS * 6;
+    std::vector<glm::vec3> vecs;
+    for (int i = 0; i < NUM_VECS; i++) {
+        vecs.emplace_back(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f));
+    }
+
+    std::vector<uint8_t> singleBytes(NUM_BYTES);
+    std::vector<uint8_t> batchedBytes(NUM_BYTES);
+    int singleSize = 0;
+    for (const auto& vec : vecs) {
+        singleSize += packFloatVec3ToSignedTwoByteFixed(singleBytes.data() + singleSize, vec, RADIX);
+    }
+    QCOMPARE(packFloatVec3sToSignedTwoByteFixed(batchedBytes.data(), vecs.data(), NUM_VECS, RADIX), NUM_BYTES);
+    QCOMPARE(singleSize, NUM_BYTES);
+    QVERIFY(singleBytes == batchedBytes);
+
+    std::vector<glm::vec3> unpacked(NUM_VECS);
+    QCOMPARE(unpackFloatVec3sFromSignedTwoByteFixed(batchedBytes.data(), unpacked.data(), NUM_VECS, RADIX), NUM_BYTES);
+    int offset = 0;
+    for (int i = 0; i < NUM_VECS; i++) {
+        glm::vec3 single;
+        offset += unpackFloatVec3FromSignedTwoByteFixed(singleBytes.data() + offset, single, RADIX);
+        QCOMPARE(unpacked[i], single);
+        QCOMPARE_WITH_ABS_ERROR(unpacked[i], vecs[i], 1.0f / (1 << RADIX));
+    }
+}
+
+void GLMHelpersTests::benchmarkOrientationPacking() {
+    // one full avatar skeleton, a thousand times over
+    const int NUM_JOINTS = 100;
+    const int NUM_FRAMES = 1000;
+    std::vector<glm::quat> quats;
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        quats.push_back(randomQuat());
+    }
+    std::vector<uint8_t> bytes(NUM_JOINTS * 6);
+    std::vector<glm::quat> unpacked(NUM_JOINTS);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        uint8_t* destination = bytes.data();
+        for (const auto& quat : quats) {
+            destination += packOrientationQuatToSixBytes(destination, quat);
+        }
+        const uint8_t* source = bytes.data();
+        for (auto& quat : unpacked) {
+            source += unpackOrientationQuatFromSixBytes(source, quat);
+        }
+    }
+    auto singleTime = std::chrono::high_resolution_clock::now() - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        packOrientationQuatsToSixBytes(bytes.data(), quats.data(), NUM_JOINTS);
+        unpackOrientationQuatsFromSixBytes(bytes.data(), unpacked.data(), NUM_JOINTS);
+    }
+    auto batchedTime = std::chrono::high_resolution_clock::now() - start;
+
+    qDebug() << "single:" << std::chrono::duration_cast<std::chrono::microseconds>(singleTime).count() << "us"
+             << ", batched:" << std::chrono::duration_cast<std::chrono::microseconds>(batchedTime).count() << "us"
+             << ", ratio:" << (float)singleTime.count() / (float)batchedTime.count();
+}
+
 #define LOOPS 500000
 
 void GLMHelpersTests::testSimd() {
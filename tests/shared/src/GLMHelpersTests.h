@@ -20,6 +20,9 @@ class GLMHelpersTests : public QObject {
 private slots:
     void testEulerDecomposition();
     void testSixByteOrientationCompression();
+    void testBatchedOrientationCompression();
+    void testBatchedVec3Compression();
+    void benchmarkOrientationPacking();
     void testSimd();
     void testGenerateBasisVectors();
     void roundPerf();
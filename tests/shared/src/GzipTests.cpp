@@ -0,0 +1,130 @@
+//
+//  GzipTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "GzipTests.h"
+
+#include <vector>
+
+#include <QBuffer>
+
+#include <Gzip.h>
+
+QTEST_MAIN(GzipTests)
+
+// json-like, so that it compresses the way the octree files do, with a little noise
+static QByteArray makeData(int size) {
+    QByteArray data;
+    data.reserve(size);
+    const QByteArray entity = "{ \"type\": \"Box\", \"position\": { \"x\": 1.5, \"y\": 2, \"z\": -3 } },\n";
+    quint32 seed = 1;
+    while (data.size() < size) {
+        data.append(entity);
+        seed = seed * 1664525 + 1013904223;
+        data.append(QByteArray::number(seed));
+    }
+    data.truncate(size);
+    return data;
+}
+
+void GzipTests::roundTrips_data() {
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("compressionLevel");
+
+    // the sizes around the blocks that are compressed separately
+    QTest::newRow("one byte") << 1 << -1;
+    QTest::newRow("one block") << 131072 << -1;
+    QTest::newRow("one block and a byte") << 131073 << -1;
+    QTest::newRow("many blocks") << 3000000 << -1;
+    QTest::newRow("stored") << 300000 << 0;
+    QTest::newRow("best") << 300000 << 9;
+}
+
+void GzipTests::roundTrips() {
+    QFETCH(int, size);
+    QFETCH(int, compressionLevel);
+    QByteArray data = makeData(size);
+
+    QByteArray compressed;
+    QVERIFY(gzip(data, compressed, compressionLevel));
+    QCOMPARE((unsigned char)compressed[0], (unsigned char)0x1f);
+    QCOMPARE((unsigned char)compressed[1], (unsigned char)0x8b);
+    if (compressionLevel != 0) {
+        QVERIFY(compressed.size() < data.size() / 2 || size < 1000);
+    }
+
+    // independently of the blocks, with zlib's own gzip decoding
+    QByteArray uncompressed;
+    QVERIFY(gunzip(compressed, uncompressed));
+    QCOMPARE(uncompressed, data);
+
+    QBuffer source(&compressed);
+    source.open(QIODevice::ReadOnly);
+    QByteArray streamed;
+    QBuffer destination(&streamed);
+    destination.open(QIODevice::WriteOnly);
+    QVERIFY(gunzip(source, destination));
+    QCOMPARE(streamed, data);
+}
+
+void GzipTests::decompressesConcatenatedMembers() {
+    QByteArray first = makeData(200000);
+    QByteArray second = makeData(1000);
+    QByteArray compressedFirst;
+    QByteArray compressedSecond;
+    QVERIFY(gzip(first, compressedFirst));
+    QVERIFY(gzip(second, compressedSecond));
+    QByteArray compressed = compressedFirst + compressedSecond;
+
+    QByteArray uncompressed;
+    QVERIFY(gunzip(compressed, uncompressed));
+    QCOMPARE(uncompressed, first + second);
+
+    QBuffer source(&compressed);
+    source.open(QIODevice::ReadOnly);
+    QByteArray streamed;
+    QBuffer destination(&streamed);
+    destination.open(QIODevice::WriteOnly);
+    QVERIFY(gunzip(source, destination));
+    QCOMPARE(streamed, first + second);
+}
+
+void GzipTests::rejectsBadData() {
+    QByteArray uncompressed;
+    // the octree files may be plain json
+    QVERIFY(!gunzip(QByteArray("{ \"Entities\": [] }"), uncompressed));
+
+    QByteArray compressed;
+    QVERIFY(gzip(makeData(10000), compressed));
+    QVERIFY(!gunzip(compressed.left(compressed.size() / 2), uncompressed));
+    QVERIFY(uncompressed.isEmpty());
+}
+
+void GzipTests::decompressesIntoBuffers() {
+    QByteArray data = makeData(50000);
+    QByteArray compressed;
+    QVERIFY(gzip(data, compressed));
+
+    std::vector<char> buffer(data.size());
+    size_t size = 0;
+    QVERIFY(gunzip(compressed.constData(), compressed.size(), buffer.data(), buffer.size(), size));
+    QCOMPARE(size, (size_t)data.size());
+    QCOMPARE(QByteArray(buffer.data(), (int)size), data);
+
+    QVERIFY(!gunzip(compressed.constData(), compressed.size(), buffer.data(), buffer.size() - 1, size));
+}
+
+void GzipTests::benchmarkGzip() {
+    QByteArray data = makeData(16 * 1024 * 1024);
+    QByteArray compressed;
+    QBENCHMARK {
+        gzip(data, compressed);
+    }
+}
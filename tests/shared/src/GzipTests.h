@@ -0,0 +1,29 @@
+//
+//  GzipTests.h
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_GzipTests_h
+#define overte_GzipTests_h
+
+#include <QtTest/QtTest>
+
+class GzipTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void roundTrips_data();
+    void roundTrips();
+    void decompressesConcatenatedMembers();
+    void rejectsBadData();
+    void decompressesIntoBuffers();
+    void benchmarkGzip();
+};
+
+#endif // overte_GzipTests_h
@@ -0,0 +1,46 @@
+//
+//  InternedUrlTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "InternedUrlTests.h"
+
+#include <InternedUrl.h>
+
+QTEST_MAIN(InternedUrlTests)
+
+void InternedUrlTests::equalUrlsHaveEqualHandles() {
+    InternedUrl first(QUrl("https://example.com/models/chair.fbx"));
+    InternedUrl second(QUrl(QString("https://example.com/models/") + "chair.fbx"));
+    InternedUrl other(QUrl("https://example.com/models/table.fbx"));
+
+    QVERIFY(first == second);
+    QVERIFY(first != other);
+    QCOMPARE(&first.getUrl(), &second.getUrl());
+    QCOMPARE(first.getUrl(), QUrl("https://example.com/models/chair.fbx"));
+    QCOMPARE(qHash(first), qHash(second));
+}
+
+void InternedUrlTests::emptyUrlIsNull() {
+    InternedUrl empty(QUrl(""));
+    QVERIFY(empty.isNull());
+    QVERIFY(empty == InternedUrl());
+    QVERIFY(empty.getUrl().isEmpty());
+}
+
+void InternedUrlTests::hashKeys() {
+    QHash<InternedUrl, int> values;
+    values[InternedUrl(QUrl("atp:/texture.png"))] = 1;
+    values[InternedUrl(QUrl("atp:/script.js"))] = 2;
+    values[InternedUrl(QUrl("atp:/texture.png"))] += 10;
+
+    QCOMPARE(values.size(), 2);
+    QCOMPARE(values.value(InternedUrl(QUrl("atp:/texture.png"))), 11);
+    QCOMPARE(values.value(InternedUrl(QUrl("atp:/script.js"))), 2);
+}
@@ -0,0 +1,26 @@
+//
+//  InternedUrlTests.h
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_InternedUrlTests_h
+#define overte_InternedUrlTests_h
+
+#include <QtTest/QtTest>
+
+class InternedUrlTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void equalUrlsHaveEqualHandles();
+    void emptyUrlIsNull();
+    void hashKeys();
+};
+
+#endif // overte_InternedUrlTests_h
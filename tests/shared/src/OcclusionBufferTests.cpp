@@ -0,0 +1,88 @@
+//
+//  OcclusionBufferTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "OcclusionBufferTests.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <OcclusionBuffer.h>
+#include <ViewFrustum.h>
+
+QTEST_MAIN(OcclusionBufferTests)
+
+// a view from the origin down -z
+static ViewFrustum newFrustum() {
+    ViewFrustum frustum;
+    frustum.setPosition(glm::vec3(0.0f));
+    frustum.setOrientation(glm::quat());
+    frustum.setProjection(60.0f, 2.0f, 0.1f, 100.0f);
+    frustum.calculate();
+    return frustum;
+}
+
+static AABox boxAt(const glm::vec3& center, const glm::vec3& dimensions) {
+    return AABox(center - 0.5f * dimensions, dimensions);
+}
+
+// a 10m wide wall, 1m thick, 10m in front of the view
+static const AABox WALL = boxAt(glm::vec3(0.0f, 0.0f, -10.0f), glm::vec3(10.0f, 10.0f, 1.0f));
+
+void OcclusionBufferTests::testHiddenBehindWall() {
+    OcclusionBuffer buffer;
+    buffer.clear(newFrustum());
+    buffer.addOccluder(WALL);
+    QCOMPARE(buffer.getNumOccluders(), 1);
+
+    QVERIFY(buffer.isOccluded(boxAt(glm::vec3(0.0f, 0.0f, -20.0f), glm::vec3(1.0f))));
+    QVERIFY(buffer.isOccluded(boxAt(glm::vec3(-6.0f, 3.0f, -40.0f), glm::vec3(4.0f))));
+    // in front of the wall
+    QVERIFY(!buffer.isOccluded(boxAt(glm::vec3(0.0f, 0.0f, -5.0f), glm::vec3(1.0f))));
+    // behind the wall, but seen past its edge
+    QVERIFY(!buffer.isOccluded(boxAt(glm::vec3(15.0f, 0.0f, -20.0f), glm::vec3(1.0f))));
+    // behind the wall and reaching past its edge
+    QVERIFY(!buffer.isOccluded(boxAt(glm::vec3(10.0f, 0.0f, -20.0f), glm::vec3(2.0f))));
+}
+
+void OcclusionBufferTests::testOccluderNotSelfOccluded() {
+    OcclusionBuffer buffer;
+    buffer.clear(newFrustum());
+    buffer.addOccluder(WALL);
+    QVERIFY(!buffer.isOccluded(WALL));
+}
+
+void OcclusionBufferTests::testNearClip() {
+    OcclusionBuffer buffer;
+    buffer.clear(newFrustum());
+    buffer.addOccluder(WALL);
+
+    // a box around the view is never hidden
+    QVERIFY(!buffer.isOccluded(boxAt(glm::vec3(0.0f, 0.0f, -10.0f), glm::vec3(30.0f))));
+
+    // an occluder around the view hides nothing
+    OcclusionBuffer aroundBuffer;
+    aroundBuffer.clear(newFrustum());
+    aroundBuffer.addOccluder(boxAt(glm::vec3(0.0f), glm::vec3(2.0f)));
+    QVERIFY(!aroundBuffer.isOccluded(boxAt(glm::vec3(0.0f, 0.0f, -20.0f), glm::vec3(1.0f))));
+}
+
+void OcclusionBufferTests::testOrthographic() {
+    ViewFrustum frustum;
+    frustum.setPosition(glm::vec3(0.0f));
+    frustum.setOrientation(glm::quat());
+    frustum.setProjection(glm::ortho(-10.0f, 10.0f, -10.0f, 10.0f, 0.1f, 100.0f));
+    frustum.calculate();
+
+    OcclusionBuffer buffer;
+    buffer.clear(frustum);
+    QVERIFY(!buffer.isEnabled());
+    buffer.addOccluder(WALL);
+    QVERIFY(!buffer.isOccluded(boxAt(glm::vec3(0.0f, 0.0f, -20.0f), glm::vec3(1.0f))));
+}
@@ -0,0 +1,26 @@
+//
+//  OcclusionBufferTests.h
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_OcclusionBufferTests_h
+#define overte_OcclusionBufferTests_h
+
+#include <QtTest/QtTest>
+
+class OcclusionBufferTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testHiddenBehindWall();
+    void testOccluderNotSelfOccluded();
+    void testNearClip();
+    void testOrthographic();
+};
+
+#endif // overte_OcclusionBufferTests_h
@@ -0,0 +1,140 @@
+//
+//  PrioritySortUtilTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "PrioritySortUtilTests.h"
+
+#include <random>
+
+#include <PrioritySortUtil.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(PrioritySortUtilTests)
+
+namespace {
+
+    class SortablePoint : public PrioritySortUtil::Sortable {
+    public:
+        SortablePoint(const glm::vec3& position, float radius) : _position(position), _radius(radius) {}
+
+        glm::vec3 getPosition() const override { return _position; }
+        float getRadius() const override { return _radius; }
+        uint64_t getTimestamp() const override { return 0; }
+
+    private:
+        glm::vec3 _position;
+        float _radius;
+    };
+
+    std::vector<SortablePoint> randomPoints(int numPoints) {
+        std::mt19937 generator(numPoints);
+        std::uniform_real_distribution<float> coordinate(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> priority(-20.0f, 20.0f);
+
+        std::vector<SortablePoint> points;
+        points.reserve(numPoints);
+        for (int i = 0; i < numPoints; ++i) {
+            points.emplace_back(glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator)), 0.5f);
+            points.back().setPriority(priority(generator));
+        }
+        return points;
+    }
+
+    bool isDescending(const std::vector<SortablePoint>& points, size_t numSorted) {
+        for (size_t i = 1; i < numSorted; ++i) {
+            if (points[i - 1].getPriority() < points[i].getPriority()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // as many candidates as the avatar mixer sorts for a typical viewer
+    const size_t NUM_TO_SORT = 50;
+}
+
+void PrioritySortUtilTests::sortTopBatches() {
+    auto points = randomPoints(1000);
+    auto sorted = points;
+    std::sort(sorted.begin(), sorted.end(),
+        [](const SortablePoint& left, const SortablePoint& right) { return left.getPriority() > right.getPriority(); });
+
+    // batch by batch, the result must match one full sort
+    for (size_t numSorted = 0; numSorted < points.size(); numSorted += NUM_TO_SORT) {
+        PrioritySortUtil::sortTop(points.begin() + numSorted, points.end(), NUM_TO_SORT);
+    }
+    for (size_t i = 0; i < points.size(); ++i) {
+        QCOMPARE(points[i].getPriority(), sorted[i].getPriority());
+    }
+
+    // asking for more than there is sorts everything
+    points = randomPoints(10);
+    PrioritySortUtil::sortTop(points.begin(), points.end(), NUM_TO_SORT);
+    QVERIFY(isDescending(points, points.size()));
+}
+
+void PrioritySortUtilTests::priorityQueueBatches() {
+    ConicalViewFrustums views(1);
+    PrioritySortUtil::PriorityQueue<SortablePoint> queue(views);
+
+    for (const auto& point : randomPoints(1000)) {
+        queue.push(point);
+    }
+
+    const auto& vector = queue.getSortedVector(NUM_TO_SORT);
+    QCOMPARE(queue.getNumSorted(), NUM_TO_SORT);
+    QVERIFY(isDescending(vector, NUM_TO_SORT));
+
+    // the next batch continues below the first one
+    float lowestOfFirstBatch = vector[NUM_TO_SORT - 1].getPriority();
+    QCOMPARE(queue.sortNextBatch(NUM_TO_SORT), 2 * NUM_TO_SORT);
+    QVERIFY(isDescending(vector, 2 * NUM_TO_SORT));
+    QVERIFY(vector[NUM_TO_SORT].getPriority() <= lowestOfFirstBatch);
+
+    // and stops at the end
+    QCOMPARE(queue.sortNextBatch(vector.size()), vector.size());
+    QVERIFY(isDescending(vector, vector.size()));
+
+    // 0 still means everything
+    queue.getSortedVector();
+    QCOMPARE(queue.getNumSorted(), vector.size());
+}
+
+void PrioritySortUtilTests::benchmarkFullSort_data() {
+    QTest::addColumn<int>("numCandidates");
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+}
+
+void PrioritySortUtilTests::benchmarkFullSort() {
+    QFETCH(int, numCandidates);
+    const auto points = randomPoints(numCandidates);
+
+    QBENCHMARK {
+        auto candidates = points;
+        std::sort(candidates.begin(), candidates.end(),
+            [](const SortablePoint& left, const SortablePoint& right) { return left.getPriority() > right.getPriority(); });
+    }
+}
+
+void PrioritySortUtilTests::benchmarkSortTop_data() {
+    benchmarkFullSort_data();
+}
+
+void PrioritySortUtilTests::benchmarkSortTop() {
+    QFETCH(int, numCandidates);
+    const auto points = randomPoints(numCandidates);
+
+    QBENCHMARK {
+        auto candidates = points;
+        PrioritySortUtil::sortTop(candidates.begin(), candidates.end(), NUM_TO_SORT);
+    }
+}
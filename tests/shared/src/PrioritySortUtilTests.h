@@ -0,0 +1,30 @@
+//
+//  PrioritySortUtilTests.h
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_PrioritySortUtilTests_h
+#define overte_PrioritySortUtilTests_h
+
+#include <QtTest/QtTest>
+
+class PrioritySortUtilTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void sortTopBatches();
+    void priorityQueueBatches();
+
+    void benchmarkFullSort_data();
+    void benchmarkFullSort();
+    void benchmarkSortTop_data();
+    void benchmarkSortTop();
+};
+
+#endif // overte_PrioritySortUtilTests_h
@@ -176,6 +176,25 @@ void SettingsTests::testHandle() {
     QVERIFY(!testHandle.isSet());
 }
 
+void SettingsTests::testWriteBack() {
+    auto sm = DependencyManager::get<Setting::Manager>();
+
+    sm->setValue("writeBackRemoved", 1);
+    for (int i = 0; i <= 1000; i++) {
+        sm->setValue("writeBackCoalesced", i);
+    }
+    sm->remove("writeBackRemoved");
+
+    // Only the last value of each key reaches the file, and without waiting for the flush delay once asked to
+    sm->forceSave();
+    QTRY_COMPARE_WITH_TIMEOUT(QSettings().value("writeBackCoalesced").toInt(), 1000, Setting::WriteWorker::FLUSH_DELAY_MSECS / 2);
+    QVERIFY(!QSettings().contains("writeBackRemoved"));
+
+    // Without asking, changes are written after the delay
+    sm->setValue("writeBackDelayed", 7);
+    QTRY_COMPARE_WITH_TIMEOUT(QSettings().value("writeBackDelayed").toInt(), 7, Setting::WriteWorker::FLUSH_DELAY_MSECS * 3);
+}
+
 
 void SettingsTests::benchmarkSetValue() {
     auto sm = DependencyManager::get<Setting::Manager>();
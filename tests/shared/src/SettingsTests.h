@@ -36,6 +36,7 @@ private slots:
 
     void testHandleUnused();
     void testHandle();
+    void testWriteBack();
 
 
     void benchmarkSetValue();
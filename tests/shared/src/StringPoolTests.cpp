@@ -0,0 +1,60 @@
+//
+//  StringPoolTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "StringPoolTests.h"
+
+#include <StringPool.h>
+
+QTEST_MAIN(StringPoolTests)
+
+void StringPoolTests::sharesEqualStrings() {
+    auto& pool = StringPool::instance();
+    // built separately, so that they don't share their buffers to begin with
+    QString first = QString("https://example.com/") + "model.fbx";
+    QString second = QString("https://example.com/model") + ".fbx";
+    QVERIFY(first.constData() != second.constData());
+
+    QString internedFirst = pool.intern(first);
+    QString internedSecond = pool.intern(second);
+    QCOMPARE(internedFirst, first);
+    QCOMPARE(internedSecond, second);
+    QCOMPARE(internedFirst.constData(), internedSecond.constData());
+
+    QVERIFY(pool.intern(QString()).isNull());
+}
+
+void StringPoolTests::prunesUnusedStrings() {
+    auto& pool = StringPool::instance();
+    pool.prune();
+    int numStrings = pool.getNumStrings();
+    size_t numBytes = pool.getNumBytes();
+    {
+        QString interned = pool.intern(QString("{ \"grabbableKey\": ") + "{ \"grabbable\": false } }");
+        QCOMPARE(pool.getNumStrings(), numStrings + 1);
+        QCOMPARE(pool.getNumBytes(), numBytes + interned.size() * sizeof(QChar));
+
+        // still used, so it stays in the pool
+        pool.prune();
+        QCOMPARE(pool.getNumStrings(), numStrings + 1);
+    }
+    pool.prune();
+    QCOMPARE(pool.getNumStrings(), numStrings);
+    QCOMPARE(pool.getNumBytes(), numBytes);
+}
+
+void StringPoolTests::unsharedBytes() {
+    QString value = QString("atp:/") + "script.js";
+    QCOMPARE(StringPool::getUnsharedBytes(value), (size_t)value.capacity() * sizeof(QChar));
+    QCOMPARE(StringPool::getUnsharedBytes(QString()), (size_t)0);
+
+    QString interned = StringPool::instance().intern(value);
+    QCOMPARE(StringPool::getUnsharedBytes(interned), (size_t)0);
+}
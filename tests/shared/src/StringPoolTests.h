@@ -0,0 +1,26 @@
+//
+//  StringPoolTests.h
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_StringPoolTests_h
+#define overte_StringPoolTests_h
+
+#include <QtTest/QtTest>
+
+class StringPoolTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void sharesEqualStrings();
+    void prunesUnusedStrings();
+    void unsharedBytes();
+};
+
+#endif // overte_StringPoolTests_h
@@ -0,0 +1,84 @@
+//
+//  TraceRecorderTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "TraceRecorderTests.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <Profile.h>
+#include <TraceRecorder.h>
+
+QTEST_MAIN(TraceRecorderTests)
+
+using namespace tracing;
+
+static QJsonArray recordedEvents() {
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(TraceRecorder::getInstance().toChromeTrace(), &error);
+    if (error.error != QJsonParseError::NoError) {
+        return QJsonArray();
+    }
+    return document.object()["traceEvents"].toArray();
+}
+
+void TraceRecorderTests::initTestCase() {
+    TraceRecorder::getInstance().setEnabled(true);
+}
+
+void TraceRecorderTests::recordsRanges() {
+    {
+        PROFILE_RANGE(app, "recordsRanges");
+    }
+    QJsonArray events = recordedEvents();
+    QVERIFY(events.size() >= 2);
+    QJsonObject begin = events[events.size() - 2].toObject();
+    QJsonObject end = events[events.size() - 1].toObject();
+    QCOMPARE(begin["name"].toString(), QString("recordsRanges"));
+    QCOMPARE(begin["cat"].toString(), QString("trace.app"));
+    QCOMPARE(begin["ph"].toString(), QString("B"));
+    QCOMPARE(end["ph"].toString(), QString("E"));
+    QVERIFY(end["ts"].toDouble() >= begin["ts"].toDouble());
+}
+
+void TraceRecorderTests::keepsTheLastEvents() {
+    for (size_t i = 0; i < TraceRecorder::EVENTS_PER_THREAD; ++i) {
+        TraceRecorder::record(trace_app(), "overwritten", Instant);
+    }
+    for (size_t i = 0; i < TraceRecorder::EVENTS_PER_THREAD / 2; ++i) {
+        TraceRecorder::record(trace_app(), "kept", Instant);
+    }
+
+    QJsonArray events = recordedEvents();
+    QCOMPARE((size_t)events.size(), TraceRecorder::EVENTS_PER_THREAD);
+    QCOMPARE(events[0].toObject()["name"].toString(), QString("overwritten"));
+    QCOMPARE(events[events.size() - 1].toObject()["name"].toString(), QString("kept"));
+}
+
+void TraceRecorderTests::internsNames() {
+    QString name = QString("interned") + " \"name\"";
+    const char* internedName = TraceRecorder::internName(name);
+    QCOMPARE(QString::fromUtf8(internedName), name);
+    QCOMPARE(TraceRecorder::internName(QString("interned \"name\"")), internedName);
+
+    {
+        PROFILE_RANGE(app, name);
+    }
+    QJsonArray events = recordedEvents();
+    QCOMPARE(events[events.size() - 1].toObject()["name"].toString(), name);
+}
+
+void TraceRecorderTests::benchmarkRecord() {
+    QBENCHMARK {
+        PROFILE_RANGE(app, "benchmarkRecord");
+    }
+}
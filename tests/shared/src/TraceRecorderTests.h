@@ -0,0 +1,28 @@
+//
+//  TraceRecorderTests.h
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_TraceRecorderTests_h
+#define overte_TraceRecorderTests_h
+
+#include <QtTest/QtTest>
+
+class TraceRecorderTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void recordsRanges();
+    void keepsTheLastEvents();
+    void internsNames();
+    void benchmarkRecord();
+};
+
+#endif // overte_TraceRecorderTests_h
@@ -0,0 +1,274 @@
+//
+//  TriangleSetTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "TriangleSetTests.h"
+
+#include <random>
+
+#include <GLMHelpers.h>
+#include <TriangleSet.h>
+
+QTEST_MAIN(TriangleSetTests)
+
+namespace {
+
+    std::vector<Triangle> randomTriangles(int numTriangles) {
+        std::mt19937 generator(numTriangles);
+        std::uniform_real_distribution<float> coordinate(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+
+        std::vector<Triangle> triangles;
+        triangles.reserve(numTriangles);
+        for (int i = 0; i < numTriangles; ++i) {
+            glm::vec3 center(coordinate(generator), coordinate(generator), coordinate(generator));
+            triangles.push_back({
+                center + glm::vec3(offset(generator), offset(generator), offset(generator)),
+                center + glm::vec3(offset(generator), offset(generator), offset(generator)),
+                center + glm::vec3(offset(generator), offset(generator), offset(generator))
+            });
+        }
+        return triangles;
+    }
+
+    // a sphere of radius 1 made of about numTriangles triangles, facing outwards, like the meshes of the models
+    std::vector<Triangle> sphereTriangles(int numTriangles) {
+        int rings = (int)sqrtf((float)numTriangles / 2.0f);
+        int sectors = 2 * rings;
+        auto getPoint = [&](int ring, int sector) {
+            float polar = PI * (float)ring / (float)rings;
+            float azimuth = TWO_PI * (float)sector / (float)sectors;
+            return glm::vec3(sinf(polar) * cosf(azimuth), cosf(polar), sinf(polar) * sinf(azimuth));
+        };
+
+        std::vector<Triangle> triangles;
+        triangles.reserve(2 * rings * sectors);
+        for (int ring = 0; ring < rings; ++ring) {
+            for (int sector = 0; sector < sectors; ++sector) {
+                glm::vec3 topLeft = getPoint(ring, sector);
+                glm::vec3 topRight = getPoint(ring, sector + 1);
+                glm::vec3 bottomLeft = getPoint(ring + 1, sector);
+                glm::vec3 bottomRight = getPoint(ring + 1, sector + 1);
+                triangles.push_back({ topLeft, topRight, bottomLeft });
+                triangles.push_back({ topRight, bottomRight, bottomLeft });
+            }
+        }
+        return triangles;
+    }
+
+    void insertAll(TriangleSet& set, const std::vector<Triangle>& triangles) {
+        set.reserve(triangles.size());
+        for (const auto& triangle : triangles) {
+            set.insert(triangle);
+        }
+    }
+
+    struct Ray {
+        glm::vec3 origin;
+        glm::vec3 direction;
+    };
+
+    std::vector<Ray> randomRays(int numRays, float distance) {
+        std::mt19937 generator(numRays);
+        std::uniform_real_distribution<float> coordinate(-1.0f, 1.0f);
+
+        std::vector<Ray> rays;
+        rays.reserve(numRays);
+        for (int i = 0; i < numRays; ++i) {
+            // from all around, towards the middle of the triangles
+            glm::vec3 origin = distance * glm::normalize(glm::vec3(coordinate(generator), coordinate(generator),
+                coordinate(generator)) + glm::vec3(EPSILON));
+            glm::vec3 target = 0.5f * distance * glm::vec3(coordinate(generator), coordinate(generator), coordinate(generator));
+            rays.push_back({ origin, glm::normalize(target - origin) });
+        }
+        return rays;
+    }
+
+    bool isClose(float distance, float expected) {
+        return fabsf(distance - expected) <= 1.0e-4f * std::max(1.0f, fabsf(expected));
+    }
+
+    const int NUM_PICKS = 1000;
+}
+
+void TriangleSetTests::rayPicksMatchAllTriangles() {
+    const auto triangles = randomTriangles(5000);
+    TriangleSet set;
+    insertAll(set, triangles);
+
+    int numHits = 0;
+    for (const auto& ray : randomRays(NUM_PICKS, 20.0f)) {
+        for (bool allowBackface : { false, true }) {
+            float expectedDistance = FLT_MAX;
+            for (const auto& triangle : triangles) {
+                float distance;
+                if (findRayTriangleIntersection(ray.origin, ray.direction, triangle, distance, allowBackface)) {
+                    expectedDistance = std::min(expectedDistance, distance);
+                }
+            }
+
+            float distance = FLT_MAX;
+            BoxFace face;
+            Triangle triangle;
+            bool hit = set.findRayIntersection(ray.origin, ray.direction, 1.0f / ray.direction, distance, face, triangle, true,
+                allowBackface);
+            QCOMPARE(hit, expectedDistance < FLT_MAX);
+            if (hit) {
+                QVERIFY(isClose(distance, expectedDistance));
+                QCOMPARE(face, UNKNOWN_FACE);
+                // the triangle that is returned is the one that was hit
+                float triangleDistance;
+                QVERIFY(findRayTriangleIntersection(ray.origin, ray.direction, triangle, triangleDistance, allowBackface));
+                QVERIFY(isClose(triangleDistance, distance));
+                numHits++;
+            }
+        }
+    }
+    QVERIFY(numHits > 0);
+}
+
+void TriangleSetTests::parabolaPicksMatchAllTriangles() {
+    const auto triangles = randomTriangles(2000);
+    TriangleSet set;
+    insertAll(set, triangles);
+
+    const glm::vec3 acceleration(0.0f, -9.8f, 0.0f);
+    int numHits = 0;
+    for (const auto& ray : randomRays(NUM_PICKS / 4, 20.0f)) {
+        glm::vec3 velocity = 10.0f * ray.direction;
+        float expectedDistance = FLT_MAX;
+        for (const auto& triangle : triangles) {
+            float distance;
+            if (findParabolaTriangleIntersection(ray.origin, velocity, acceleration, triangle, distance, false)) {
+                expectedDistance = std::min(expectedDistance, distance);
+            }
+        }
+
+        float distance = FLT_MAX;
+        BoxFace face;
+        Triangle triangle;
+        bool hit = set.findParabolaIntersection(ray.origin, velocity, acceleration, distance, face, triangle, true);
+        QCOMPARE(hit, expectedDistance < FLT_MAX);
+        if (hit) {
+            QVERIFY(isClose(distance, expectedDistance));
+            numHits++;
+        }
+    }
+    QVERIFY(numHits > 0);
+}
+
+void TriangleSetTests::coarseRayPicks() {
+    TriangleSet set;
+    insertAll(set, sphereTriangles(1000));
+
+    // without precision, the distance is the one to the box of a leaf, no further than the sphere's surface
+    glm::vec3 origin(0.013f, 0.021f, -5.0f);
+    glm::vec3 direction(0.0f, 0.0f, 1.0f);
+    float distance = FLT_MAX;
+    BoxFace face;
+    Triangle triangle;
+    QVERIFY(set.findRayIntersection(origin, direction, 1.0f / direction, distance, face, triangle, false));
+    QVERIFY(distance <= 4.0f + EPSILON);
+    QVERIFY(distance >= 3.9f);
+
+    // and rays that miss the bounds of the set miss
+    distance = FLT_MAX;
+    origin = glm::vec3(0.0f, 5.0f, -5.0f);
+    QVERIFY(!set.findRayIntersection(origin, direction, 1.0f / direction, distance, face, triangle, false));
+}
+
+void TriangleSetTests::rebalancesAfterChanges() {
+    TriangleSet set;
+    // off the vertices of the sphere
+    glm::vec3 origin(0.013f, 0.021f, -5.0f);
+    glm::vec3 direction(0.0f, 0.0f, 1.0f);
+    float distance = FLT_MAX;
+    BoxFace face;
+    Triangle triangle;
+
+    // an empty set has nothing to hit
+    QVERIFY(!set.findRayIntersection(origin, direction, 1.0f / direction, distance, face, triangle, true));
+
+    insertAll(set, sphereTriangles(1000));
+    QVERIFY(set.findRayIntersection(origin, direction, 1.0f / direction, distance, face, triangle, true, true));
+    QVERIFY(distance > 4.0f - EPSILON && distance < 4.01f);
+
+    // a triangle added in front is picked once the tree is rebuilt for it
+    set.insert({ glm::vec3(-1.0f, -1.0f, -2.0f), glm::vec3(0.0f, 1.0f, -2.0f), glm::vec3(1.0f, -1.0f, -2.0f) });
+    distance = FLT_MAX;
+    QVERIFY(set.findRayIntersection(origin, direction, 1.0f / direction, distance, face, triangle, true, true));
+    QVERIFY(isClose(distance, 3.0f));
+
+    set.clear();
+    distance = FLT_MAX;
+    QVERIFY(!set.findRayIntersection(origin, direction, 1.0f / direction, distance, face, triangle, true, true));
+}
+
+void TriangleSetTests::benchmarkBalance_data() {
+    QTest::addColumn<int>("numTriangles");
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+}
+
+void TriangleSetTests::benchmarkBalance() {
+    QFETCH(int, numTriangles);
+    const auto triangles = sphereTriangles(numTriangles);
+
+    QBENCHMARK {
+        TriangleSet set;
+        insertAll(set, triangles);
+        set.balanceTree();
+    }
+}
+
+void TriangleSetTests::benchmarkRayPick_data() {
+    benchmarkBalance_data();
+}
+
+void TriangleSetTests::benchmarkRayPick() {
+    QFETCH(int, numTriangles);
+    TriangleSet set;
+    insertAll(set, sphereTriangles(numTriangles));
+    set.balanceTree();
+    const auto rays = randomRays(NUM_PICKS, 4.0f);
+
+    QBENCHMARK {
+        for (const auto& ray : rays) {
+            float distance = FLT_MAX;
+            BoxFace face;
+            Triangle triangle;
+            set.findRayIntersection(ray.origin, ray.direction, 1.0f / ray.direction, distance, face, triangle, true, true);
+        }
+    }
+}
+
+void TriangleSetTests::benchmarkParabolaPick_data() {
+    benchmarkBalance_data();
+}
+
+void TriangleSetTests::benchmarkParabolaPick() {
+    QFETCH(int, numTriangles);
+    TriangleSet set;
+    insertAll(set, sphereTriangles(numTriangles));
+    set.balanceTree();
+    const auto rays = randomRays(NUM_PICKS / 10, 4.0f);
+    const glm::vec3 acceleration(0.0f, -9.8f, 0.0f);
+
+    QBENCHMARK {
+        for (const auto& ray : rays) {
+            float distance = FLT_MAX;
+            BoxFace face;
+            Triangle triangle;
+            set.findParabolaIntersection(ray.origin, 5.0f * ray.direction, acceleration, distance, face, triangle, true,
+                true);
+        }
+    }
+}
@@ -0,0 +1,34 @@
+//
+//  TriangleSetTests.h
+//  tests/shared/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_TriangleSetTests_h
+#define overte_TriangleSetTests_h
+
+#include <QtTest/QtTest>
+
+class TriangleSetTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void rayPicksMatchAllTriangles();
+    void parabolaPicksMatchAllTriangles();
+    void coarseRayPicks();
+    void rebalancesAfterChanges();
+
+    void benchmarkBalance_data();
+    void benchmarkBalance();
+    void benchmarkRayPick_data();
+    void benchmarkRayPick();
+    void benchmarkParabolaPick_data();
+    void benchmarkParabolaPick();
+};
+
+#endif // overte_TriangleSetTests_h
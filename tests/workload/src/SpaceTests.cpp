@@ -115,6 +115,84 @@ void SpaceTests::testOverlaps() {
 #endif
 }
 
+static uint8_t computeRegion(const workload::Views& views, const workload::Sphere& sphere) {
+    uint8_t region = workload::Region::R4;
+    for (const auto& view : views) {
+        for (uint8_t k = 0; k < region; ++k) {
+            float touchDistance = sphere.w + view.regions[k].w;
+            if (glm::distance(glm::vec3(sphere), glm::vec3(view.regions[k])) < touchDistance) {
+                region = k;
+                break;
+            }
+        }
+    }
+    return region;
+}
+
+void SpaceTests::testIncrementalCategorize() {
+    // enough proxies for several chunks, skipped or not, to be categorized in parallel
+    const uint32_t NUM_PROXIES = 20000;
+    const float HALF_WIDTH = 200.0f;
+    srand(7);
+    auto randomCoordinate = [] { return HALF_WIDTH * (2.0f * ((float)rand() / (float)RAND_MAX) - 1.0f); };
+
+    workload::Space space;
+    std::vector<workload::ProxyID> ids;
+    std::vector<workload::Sphere> spheres;
+    {
+        workload::Transaction transaction;
+        for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+            workload::Sphere sphere(randomCoordinate(), randomCoordinate(), randomCoordinate(), 0.5f + 0.01f * (float)(i % 100));
+            workload::ProxyID id = space.allocateID();
+            transaction.reset(id, sphere, workload::Owner());
+            ids.push_back(id);
+            spheres.push_back(sphere);
+        }
+        space.enqueueTransaction(transaction);
+    }
+
+    workload::Views views(2);
+    std::vector<uint8_t> regions(NUM_PROXIES, workload::Region::UNKNOWN);
+    for (uint32_t frame = 0; frame < 60; ++frame) {
+        // the views walk and their regions breathe, and some of the proxies move
+        for (uint32_t j = 0; j < views.size(); ++j) {
+            glm::vec3 center((float)j * 50.0f + 0.7f * (float)frame, 0.0f, -0.3f * (float)frame);
+            for (uint32_t k = 0; k < workload::Region::NUM_TRACKED_REGIONS; ++k) {
+                float radius = 20.0f * (float)(k + 1) + 2.0f * sinf(0.2f * (float)frame);
+                views[j].regions[k] = workload::Sphere(center + glm::vec3(0.0f, 0.0f, -5.0f * (float)k), radius);
+            }
+        }
+        space.setViews(views);
+        if (frame % 5 == 4) {
+            workload::Transaction transaction;
+            for (uint32_t i = frame; i < NUM_PROXIES; i += 97) {
+                spheres[i] += workload::Sphere(3.0f, 0.0f, -2.0f, 0.0f);
+                transaction.update(ids[i], spheres[i]);
+            }
+            space.enqueueTransaction(transaction);
+        }
+        space.enqueueFrame();
+        space.processTransactionQueue();
+
+        workload::Changes changes;
+        space.categorizeAndGetChanges(changes);
+
+        uint32_t numChanged = 0;
+        for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+            uint8_t region = computeRegion(views, spheres[i]);
+            QCOMPARE(space.getRegion(ids[i]), region);
+            if (region != regions[i]) {
+                ++numChanged;
+            }
+            regions[i] = region;
+        }
+        QCOMPARE((uint32_t)changes.size(), numChanged);
+        for (uint32_t i = 1; i < changes.size(); ++i) {
+            QVERIFY(changes[i - 1].proxyId < changes[i].proxyId);
+        }
+    }
+}
+
 #ifdef MANUAL_TEST
 
 const float WORLD_WIDTH = 1000.0f;
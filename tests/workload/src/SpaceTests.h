@@ -21,6 +21,7 @@ class SpaceTests : public QObject {
 
 private slots:
     void testOverlaps();
+    void testIncrementalCategorize();
 #ifdef MANUAL_TEST
     void benchmark();
 #endif // MANUAL_TEST
@@ -15,6 +15,7 @@
 #include <QThread>
 #include <QLoggingCategory>
 #include <QCommandLineParser>
+#include <QHostAddress>
 
 #include <NetworkLogging.h>
 #include <NetworkingConstants.h>
@@ -23,6 +24,9 @@
 #include <AddressManager.h>
 #include <DependencyManager.h>
 #include <SettingHandle.h>
+#include <shared/NetworkUtils.h>
+
+#include "BotSwarm.h"
 
 ACClientApp::ACClientApp(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
@@ -48,6 +52,30 @@ ACClientApp::ACClientApp(int argc, char* argv[]) :
     const QCommandLineOption listenPortOption("listenPort", "listen port", QString::number(INVALID_PORT));
     parser.addOption(listenPortOption);
 
+    const QCommandLineOption botsOption("bots", "connect a swarm of headless bots instead, to load the domain", "count");
+    parser.addOption(botsOption);
+
+    const QCommandLineOption profilesOption("profiles", "JSON array of the bot profiles", "file");
+    parser.addOption(profilesOption);
+
+    const QCommandLineOption recordingOption("recording", "recording the bots replay their avatar and audio from", "file");
+    parser.addOption(recordingOption);
+
+    const QCommandLineOption durationOption("duration", "seconds to run the bots for, until interrupted if 0", "seconds", "0");
+    parser.addOption(durationOption);
+
+    const QCommandLineOption rampUpOption("ramp", "seconds over which the bots are started", "seconds", "10");
+    parser.addOption(rampUpOption);
+
+    const QCommandLineOption threadsOption("threads", "threads the bots run on, one per core if 0", "count", "0");
+    parser.addOption(threadsOption);
+
+    const QCommandLineOption reportOption("report", "file the final report of the bots is written to", "file");
+    parser.addOption(reportOption);
+
+    const QCommandLineOption localAddressOption("local-address", "address the bots present to the domain", "address");
+    parser.addOption(localAddressOption);
+
     if (!parser.parse(QCoreApplication::arguments())) {
         qCritical() << parser.errorText() << Qt::endl;
         parser.showHelp();
@@ -99,6 +127,14 @@ ACClientApp::ACClientApp(int argc, char* argv[]) :
         _password = pieces[1];
     }
 
+    if (parser.isSet(botsOption)) {
+        startBotSwarm(parser.value(botsOption).toInt(), domainServerAddress, parser.value(profilesOption),
+                      parser.value(recordingOption), parser.value(durationOption).toInt(),
+                      parser.value(rampUpOption).toInt(), parser.value(threadsOption).toInt(),
+                      parser.value(reportOption), parser.value(localAddressOption));
+        return;
+    }
+
     DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
 
     DependencyManager::set<AccountManager>(false, [&]{ return QString("Mozilla/5.0 (HighFidelityACClient)"); });
@@ -164,6 +200,45 @@ ACClientApp::ACClientApp(int argc, char* argv[]) :
 }
 
 ACClientApp::~ACClientApp() {
+    delete _botSwarm;
+}
+
+void ACClientApp::startBotSwarm(int numBots, const QString& domainServerAddress, const QString& profilesFilename,
+                                const QString& recordingFilename, int durationSecs, int rampUpSecs, int numThreads,
+                                const QString& reportFilename, const QString& localAddress) {
+    BotSwarm::Settings settings;
+    settings.numBots = numBots;
+
+    QStringList hostAndPort = domainServerAddress.split(":");
+    quint16 port = hostAndPort.size() > 1 ? hostAndPort[1].toUShort() : DEFAULT_DOMAIN_SERVER_PORT;
+    settings.domainServer = SockAddr(SocketType::UDP, hostAndPort[0], port, true);
+    settings.localAddress = localAddress.isEmpty() ? getGuessedLocalAddress() : QHostAddress(localAddress);
+
+    if (!profilesFilename.isEmpty()) {
+        settings.profiles = BotSwarm::loadProfiles(profilesFilename);
+        if (settings.profiles.empty()) {
+            qCritical() << "Failed to read the bot profiles from" << profilesFilename;
+            QMetaObject::invokeMethod(this, [] { QCoreApplication::exit(1); }, Qt::QueuedConnection);
+            return;
+        }
+    }
+    if (!recordingFilename.isEmpty()) {
+        settings.recording = BotRecording::fromFile(recordingFilename);
+        if (!settings.recording) {
+            qCritical() << "Failed to read the bot recording from" << recordingFilename;
+            QMetaObject::invokeMethod(this, [] { QCoreApplication::exit(1); }, Qt::QueuedConnection);
+            return;
+        }
+    }
+    settings.durationSecs = durationSecs;
+    settings.rampUpSecs = rampUpSecs;
+    settings.numThreads = numThreads;
+    settings.reportFilename = reportFilename;
+
+    _botSwarm = new BotSwarm(settings);
+    connect(_botSwarm, &BotSwarm::finished, this, [] { QCoreApplication::exit(0); });
+    connect(this, &QCoreApplication::aboutToQuit, _botSwarm, &BotSwarm::stop);
+    _botSwarm->start();
 }
 
 
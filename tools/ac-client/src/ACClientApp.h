@@ -20,6 +20,7 @@
 #include <NetworkPeer.h>
 #include <NodeList.h>
 
+class BotSwarm;
 
 class ACClientApp : public QCoreApplication {
     Q_OBJECT
@@ -40,6 +41,9 @@ private:
     void timedOut();
     void printFailedServers();
     void finish(int exitCode);
+    void startBotSwarm(int numBots, const QString& domainServerAddress, const QString& profilesFilename,
+                       const QString& recordingFilename, int durationSecs, int rampUpSecs, int numThreads,
+                       const QString& reportFilename, const QString& localAddress);
     bool _verbose;
 
     bool _sawEntityServer { false };
@@ -50,6 +54,8 @@ private:
 
     QString _username;
     QString _password;
+
+    BotSwarm* _botSwarm { nullptr };
 };
 
 #endif //hifi_ACClientApp_h
@@ -0,0 +1,344 @@
+//
+//  BotSwarm.cpp
+//  tools/ac-client/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BotSwarm.h"
+
+#include <algorithm>
+
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+// the bots' streams are scheduled to the tick, the audio's is the shortest
+static const int TICK_MSECS = 10;
+static const int RAMP_UP_INTERVAL_MSECS = 10;
+
+/// Updates the bots that were given to it on its thread, where their sockets live
+class BotSwarm::Worker : public QObject {
+public:
+    Worker() {
+        _tickTimer.setTimerType(Qt::PreciseTimer);
+        connect(&_tickTimer, &QTimer::timeout, this, [this] {
+            quint64 now = usecTimestampNow();
+            for (auto bot : _bots) {
+                bot->update(now);
+            }
+        });
+    }
+
+    void addBot(SwarmBot* bot) {
+        bot->start();
+        _bots.push_back(bot);
+        if (!_tickTimer.isActive()) {
+            _tickTimer.start(TICK_MSECS);
+        }
+    }
+
+    void stopBots() {
+        _tickTimer.stop();
+        for (auto bot : _bots) {
+            bot->stop();
+        }
+        _bots.clear();
+    }
+
+private:
+    QTimer _tickTimer { this };
+    std::vector<SwarmBot*> _bots;
+};
+
+std::vector<BotProfile> BotSwarm::getDefaultProfiles() {
+    BotProfile idle;
+    idle.name = "idle";
+    idle.weight = 0.4f;
+    idle.walkRadius = 0.0f;
+    idle.talkFraction = 0.0f;
+
+    BotProfile walker;
+    walker.name = "walker";
+    walker.weight = 0.3f;
+    walker.talkFraction = 0.0f;
+
+    BotProfile talker;
+    talker.name = "talker";
+    talker.weight = 0.2f;
+    talker.walkRadius = 0.0f;
+    talker.talkFraction = 0.5f;
+
+    BotProfile chatty;
+    chatty.name = "chatty";
+    chatty.weight = 0.1f;
+    chatty.walkRadius = 2.0f;
+    chatty.messageRate = 1.0f;
+    chatty.listensToMessages = true;
+
+    return { idle, walker, talker, chatty };
+}
+
+std::vector<BotProfile> BotSwarm::loadProfiles(const QString& filename) {
+    std::vector<BotProfile> profiles;
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return profiles;
+    }
+    for (const auto& value : QJsonDocument::fromJson(file.readAll()).array()) {
+        if (value.isObject()) {
+            profiles.push_back(BotProfile::fromJson(value.toObject()));
+        }
+    }
+    return profiles;
+}
+
+BotSwarm::BotSwarm(const Settings& settings, QObject* parent) :
+    QObject(parent),
+    _settings(settings)
+{
+    if (_settings.profiles.empty()) {
+        _settings.profiles = getDefaultProfiles();
+    }
+    float totalWeight = 0.0f;
+    for (const auto& profile : _settings.profiles) {
+        totalWeight += std::max(profile.weight, 0.0f);
+    }
+
+    // the profiles are given out in proportion to their weights, evenly rather than at random so that small swarms get
+    // the same mix as large ones
+    for (int i = 0; i < _settings.numBots; ++i) {
+        float position = ((float)i + 0.5f) / (float)_settings.numBots * totalWeight;
+        size_t profileIndex = 0;
+        float cumulativeWeight = std::max(_settings.profiles[0].weight, 0.0f);
+        while (position > cumulativeWeight && profileIndex + 1 < _settings.profiles.size()) {
+            cumulativeWeight += std::max(_settings.profiles[++profileIndex].weight, 0.0f);
+        }
+        _bots.emplace_back(new SwarmBot(i, _settings.profiles[profileIndex], _settings.domainServer,
+                                        _settings.localAddress, _settings.recording));
+    }
+
+    int numThreads = _settings.numThreads > 0 ? _settings.numThreads : std::max(QThread::idealThreadCount(), 1);
+    for (int i = 0; i < numThreads; ++i) {
+        auto thread = new QThread(this);
+        thread->setObjectName("BotSwarm Worker " + QString::number(i));
+        auto worker = new Worker();
+        worker->moveToThread(thread);
+        connect(thread, &QThread::finished, worker, &QObject::deleteLater);
+        _threads.push_back(thread);
+        _workers.push_back(worker);
+    }
+
+    _rampUpTimer.setInterval(RAMP_UP_INTERVAL_MSECS);
+    connect(&_rampUpTimer, &QTimer::timeout, this, &BotSwarm::startBots);
+    _reportTimer.setInterval(std::max(_settings.reportIntervalSecs, 1) * (int)MSECS_PER_SECOND);
+    connect(&_reportTimer, &QTimer::timeout, this, &BotSwarm::logReport);
+}
+
+BotSwarm::~BotSwarm() {
+    stop();
+}
+
+void BotSwarm::start() {
+    for (auto thread : _threads) {
+        thread->start();
+    }
+    _elapsed.start();
+    _rampUpTimer.start();
+    _reportTimer.start();
+
+    if (_settings.durationSecs > 0) {
+        QTimer::singleShot(_settings.durationSecs * (int)MSECS_PER_SECOND, this, [this] {
+            stop();
+            emit finished();
+        });
+    }
+
+    qDebug() << "Starting" << _settings.numBots << "bots over" << _settings.rampUpSecs << "seconds on"
+        << _threads.size() << "threads, connecting to" << _settings.domainServer;
+}
+
+void BotSwarm::startBots() {
+    qint64 rampUpMsecs = (qint64)std::max(_settings.rampUpSecs, 0) * MSECS_PER_SECOND;
+    int numToStart = _settings.numBots;
+    if (rampUpMsecs > 0 && _elapsed.elapsed() < rampUpMsecs) {
+        numToStart = (int)(_settings.numBots * _elapsed.elapsed() / rampUpMsecs);
+    }
+
+    for (; _numStarted < numToStart; ++_numStarted) {
+        Worker* worker = _workers[_numStarted % _workers.size()];
+        SwarmBot* bot = _bots[_numStarted].get();
+        QMetaObject::invokeMethod(worker, [worker, bot] { worker->addBot(bot); }, Qt::QueuedConnection);
+    }
+    if (_numStarted >= _settings.numBots) {
+        _rampUpTimer.stop();
+    }
+}
+
+void BotSwarm::stop() {
+    if (_threads.empty() || !_threads.front()->isRunning()) {
+        return;
+    }
+    _rampUpTimer.stop();
+    _reportTimer.stop();
+    QByteArray report = QJsonDocument(getReport()).toJson();
+
+    // the bots' sockets are closed on the threads they were opened on
+    for (auto worker : _workers) {
+        QMetaObject::invokeMethod(worker, [worker] { worker->stopBots(); }, Qt::BlockingQueuedConnection);
+    }
+    for (auto thread : _threads) {
+        thread->quit();
+        thread->wait();
+    }
+
+    qDebug().noquote() << "Final report:" << report;
+    if (!_settings.reportFilename.isEmpty()) {
+        QFile file(_settings.reportFilename);
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(report);
+        } else {
+            qWarning() << "Failed to write the report to" << _settings.reportFilename;
+        }
+    }
+}
+
+static double percentile(std::vector<int>& values, float fraction) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    size_t index = std::min((size_t)(fraction * values.size()), values.size() - 1);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index] / (double)USECS_PER_MSEC;
+}
+
+QJsonObject BotSwarm::getReport() const {
+    int numConnected = 0;
+    int numEverConnected = 0;
+    qint64 totalConnectMsecs = 0;
+    int maxConnectMsecs = 0;
+    int numReconnects = 0;
+    int numDenials = 0;
+    quint64 bytesSent = 0;
+    quint64 bytesReceived = 0;
+    std::vector<int> pings[SwarmBot::NUM_MIXERS];
+    quint64 mixedAudioReceived = 0;
+    quint64 mixedAudioLost = 0;
+    quint64 messagesReceived = 0;
+    quint64 totalMessageUsecs = 0;
+    quint32 maxMessageUsecs = 0;
+    QJsonObject profiles;
+
+    for (int i = 0; i < _numStarted; ++i) {
+        const SwarmBot& bot = *_bots[i];
+        const BotStats& stats = bot.getStats();
+        profiles[bot.getProfile().name] = profiles[bot.getProfile().name].toInt() + 1;
+
+        if (stats.isConnected) {
+            ++numConnected;
+        }
+        int connectMsecs = stats.connectMsecs;
+        if (connectMsecs >= 0) {
+            ++numEverConnected;
+            totalConnectMsecs += connectMsecs;
+            maxConnectMsecs = std::max(maxConnectMsecs, connectMsecs);
+        }
+        numReconnects += stats.numReconnects;
+        numDenials += stats.numDenials;
+        bytesSent += stats.bytesSent;
+        bytesReceived += stats.bytesReceived;
+
+        for (int mixer = 0; mixer < SwarmBot::NUM_MIXERS; ++mixer) {
+            int pingUsecs = stats.lastPingUsecs[mixer];
+            if (stats.isConnected && pingUsecs >= 0) {
+                pings[mixer].push_back(pingUsecs);
+            }
+        }
+        mixedAudioReceived += stats.mixedAudioReceived;
+        mixedAudioLost += stats.mixedAudioLost;
+        messagesReceived += stats.messagesReceived;
+        totalMessageUsecs += stats.totalMessageUsecs;
+        maxMessageUsecs = std::max(maxMessageUsecs, stats.maxMessageUsecs.load());
+    }
+
+    double elapsedSecs = std::max((double)_elapsed.elapsed() / MSECS_PER_SECOND, 0.001);
+
+    QJsonObject report;
+    report["elapsed"] = elapsedSecs;
+    report["bots"] = _settings.numBots;
+    report["started"] = _numStarted;
+    report["connected"] = numConnected;
+    report["profiles"] = profiles;
+    report["connectMsecs"] = QJsonObject {
+        { "mean", numEverConnected > 0 ? (double)totalConnectMsecs / numEverConnected : 0.0 },
+        { "max", maxConnectMsecs }
+    };
+    report["reconnects"] = numReconnects;
+    report["denials"] = numDenials;
+    report["sentKbps"] = bytesSent * BITS_IN_BYTE / elapsedSecs / BYTES_PER_KILOBYTE;
+    report["receivedKbps"] = bytesReceived * BITS_IN_BYTE / elapsedSecs / BYTES_PER_KILOBYTE;
+
+    QJsonObject pingMsecs;
+    for (int mixer = 0; mixer < SwarmBot::NUM_MIXERS; ++mixer) {
+        pingMsecs[SwarmBot::getMixerName(mixer)] = QJsonObject {
+            { "p50", percentile(pings[mixer], 0.5f) },
+            { "p95", percentile(pings[mixer], 0.95f) },
+            { "max", percentile(pings[mixer], 1.0f) }
+        };
+    }
+    report["pingMsecs"] = pingMsecs;
+
+    quint64 mixedAudioExpected = mixedAudioReceived + mixedAudioLost;
+    report["mixedAudioLossPercent"] = mixedAudioExpected > 0 ? 100.0 * mixedAudioLost / mixedAudioExpected : 0.0;
+    report["messages"] = QJsonObject {
+        { "received", (qint64)messagesReceived },
+        { "meanMsecs", messagesReceived > 0 ? (double)totalMessageUsecs / messagesReceived / USECS_PER_MSEC : 0.0 },
+        { "maxMsecs", (double)maxMessageUsecs / USECS_PER_MSEC }
+    };
+    return report;
+}
+
+void BotSwarm::logReport() {
+    QJsonObject report = getReport();
+
+    // the bandwidth of the report is since the start, the log's is since the last one
+    quint64 bytesSent = 0;
+    quint64 bytesReceived = 0;
+    for (int i = 0; i < _numStarted; ++i) {
+        bytesSent += _bots[i]->getStats().bytesSent;
+        bytesReceived += _bots[i]->getStats().bytesReceived;
+    }
+    qint64 now = _elapsed.elapsed();
+    double intervalSecs = std::max((double)(now - _lastReportMsecs) / MSECS_PER_SECOND, 0.001);
+    double sentKbps = (bytesSent - _lastReportBytesSent) * BITS_IN_BYTE / intervalSecs / BYTES_PER_KILOBYTE;
+    double receivedKbps = (bytesReceived - _lastReportBytesReceived) * BITS_IN_BYTE / intervalSecs / BYTES_PER_KILOBYTE;
+    _lastReportBytesSent = bytesSent;
+    _lastReportBytesReceived = bytesReceived;
+    _lastReportMsecs = now;
+
+    QStringList pings;
+    QJsonObject pingMsecs = report["pingMsecs"].toObject();
+    for (int mixer = 0; mixer < SwarmBot::NUM_MIXERS; ++mixer) {
+        QJsonObject ping = pingMsecs[SwarmBot::getMixerName(mixer)].toObject();
+        pings << QString("%1 %2/%3").arg(SwarmBot::getMixerName(mixer))
+            .arg(ping["p50"].toDouble(), 0, 'f', 1).arg(ping["p95"].toDouble(), 0, 'f', 1);
+    }
+
+    QJsonObject messages = report["messages"].toObject();
+    qDebug().noquote() << QString("%1s: %2/%3 connected, %4 kbps up, %5 kbps down, ping p50/p95 msecs %6, "
+                                  "mixed audio loss %7%, message latency %8/%9 msecs")
+        .arg(report["elapsed"].toDouble(), 0, 'f', 0)
+        .arg(report["connected"].toInt()).arg(report["started"].toInt())
+        .arg(sentKbps, 0, 'f', 0).arg(receivedKbps, 0, 'f', 0)
+        .arg(pings.join(", "))
+        .arg(report["mixedAudioLossPercent"].toDouble(), 0, 'f', 2)
+        .arg(messages["meanMsecs"].toDouble(), 0, 'f', 1).arg(messages["maxMsecs"].toDouble(), 0, 'f', 1);
+}
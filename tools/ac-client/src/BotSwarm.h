@@ -0,0 +1,81 @@
+//
+//  BotSwarm.h
+//  tools/ac-client/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_BotSwarm_h
+#define overte_BotSwarm_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+
+#include "SwarmBot.h"
+
+/// Loads a domain with a swarm of SwarmBots, that are started over a ramp-up period and spread over a few worker threads,
+/// and reports their connection times, bandwidth, latencies and losses as it goes and as JSON at the end.
+class BotSwarm : public QObject {
+    Q_OBJECT
+public:
+    struct Settings {
+        int numBots { 0 };
+        SockAddr domainServer;
+        QHostAddress localAddress;
+        std::vector<BotProfile> profiles;
+        std::shared_ptr<const BotRecording> recording;
+        int rampUpSecs { 10 };          // the bots are started evenly over this time
+        int durationSecs { 0 };         // 0 runs until the process is stopped
+        int numThreads { 0 };           // 0 for one per core
+        int reportIntervalSecs { 5 };
+        QString reportFilename;         // the final report is only logged if it's empty
+    };
+
+    /// idle, walker, talker and chatty, in the proportions of a busy event
+    static std::vector<BotProfile> getDefaultProfiles();
+    /// An array of profiles, or an empty vector if the file can't be read
+    static std::vector<BotProfile> loadProfiles(const QString& filename);
+
+    BotSwarm(const Settings& settings, QObject* parent = nullptr);
+    ~BotSwarm();
+
+    void start();
+    void stop();
+
+    QJsonObject getReport() const;
+
+signals:
+    void finished();
+
+private:
+    class Worker;
+
+    void startBots();
+    void logReport();
+
+    Settings _settings;
+    std::vector<std::unique_ptr<SwarmBot>> _bots;
+    std::vector<QThread*> _threads;
+    std::vector<Worker*> _workers;
+    int _numStarted { 0 };
+
+    QTimer _rampUpTimer;
+    QTimer _reportTimer;
+    QElapsedTimer _elapsed;
+
+    quint64 _lastReportBytesSent { 0 };
+    quint64 _lastReportBytesReceived { 0 };
+    qint64 _lastReportMsecs { 0 };
+};
+
+#endif // overte_BotSwarm_h
@@ -0,0 +1,760 @@
+//
+//  SwarmBot.cpp
+//  tools/ac-client/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "SwarmBot.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QJsonObject>
+
+#include <AudioConstants.h>
+#include <GLMHelpers.h>
+#include <HeadData.h>
+#include <LimitedNodeList.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <OctreeQuery.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+#include <recording/Clip.h>
+#include <recording/Frame.h>
+#include <shared/ConicalViewFrustum.h>
+
+static const quint64 CHECK_IN_INTERVAL_USECS = DOMAIN_SERVER_CHECK_IN_MSECS * USECS_PER_MSEC;
+// the bots that hear nothing from the domain-server for this long start over, like the NodeList does after its silent
+// check-ins
+static const quint64 DOMAIN_LIST_TIMEOUT_USECS = 10 * USECS_PER_SECOND;
+static const int CHECK_INS_PER_FULL_DOMAIN_LIST = 10;
+
+static const quint64 PING_INTERVAL_USECS = USECS_PER_SECOND;
+static const quint64 AVATAR_QUERY_INTERVAL_USECS = USECS_PER_SECOND;
+static const quint64 SUBSCRIBE_INTERVAL_USECS = 10 * USECS_PER_SECOND;
+
+// the bots spawn on a disc, so that each of them sees and hears a realistic number of the others
+static const float SPAWN_RADIUS = 20.0f;
+static const float WALK_SPEED = 1.4f; // m/s
+static const float QUERY_RADIUS = 100.0f;
+static const glm::vec3 AVATAR_DIMENSIONS { 0.6f, 1.8f, 0.6f };
+
+static const float MIN_TALK_SPURT_SECS = 1.0f;
+static const float MAX_TALK_SPURT_SECS = 5.0f;
+static const float TONE_FREQUENCY = 220.0f;
+static const float TONE_AMPLITUDE = 4000.0f;
+// the frames that fell this far behind, when a tick was late, are dropped rather than sent in a burst
+static const int MAX_AUDIO_FRAMES_BEHIND = 10;
+static const QString AUDIO_CODEC_NAME = "pcm";
+
+static const QString MESSAGES_CHANNEL = "org.overte.botSwarm";
+
+const char* SwarmBot::getMixerName(int mixerIndex) {
+    static const char* MIXER_NAMES[NUM_MIXERS] = { "audio", "avatar", "entity", "messages" };
+    return mixerIndex >= 0 && mixerIndex < NUM_MIXERS ? MIXER_NAMES[mixerIndex] : "unknown";
+}
+
+static int mixerIndexForType(NodeType_t type) {
+    switch (type) {
+        case NodeType::AudioMixer:
+            return SwarmBot::AUDIO_MIXER;
+        case NodeType::AvatarMixer:
+            return SwarmBot::AVATAR_MIXER;
+        case NodeType::EntityServer:
+            return SwarmBot::ENTITY_SERVER;
+        case NodeType::MessagesMixer:
+            return SwarmBot::MESSAGES_MIXER;
+        default:
+            return -1;
+    }
+}
+
+BotProfile BotProfile::fromJson(const QJsonObject& object) {
+    BotProfile profile;
+    profile.name = object.value("name").toString(profile.name);
+    profile.weight = (float)object.value("weight").toDouble(profile.weight);
+    profile.avatarRate = (float)object.value("avatarRate").toDouble(profile.avatarRate);
+    profile.walkRadius = (float)object.value("walkRadius").toDouble(profile.walkRadius);
+    profile.maxAvatarUpdateRate = object.value("maxAvatarUpdateRate").toInt(profile.maxAvatarUpdateRate);
+    profile.maxAvatarReceiveKbps = object.value("maxAvatarReceiveKbps").toInt(profile.maxAvatarReceiveKbps);
+    profile.sendsAudio = object.value("sendsAudio").toBool(profile.sendsAudio);
+    profile.talkFraction = (float)object.value("talkFraction").toDouble(profile.talkFraction);
+    profile.entityQueryRate = (float)object.value("entityQueryRate").toDouble(profile.entityQueryRate);
+    profile.messageRate = (float)object.value("messageRate").toDouble(profile.messageRate);
+    profile.listensToMessages = object.value("listensToMessages").toBool(profile.listensToMessages);
+    return profile;
+}
+
+std::shared_ptr<const BotRecording> BotRecording::fromFile(const QString& filename) {
+    auto clip = recording::Clip::fromFile(filename);
+    if (!clip) {
+        return nullptr;
+    }
+
+    static const recording::FrameType AVATAR_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
+    static const recording::FrameType AUDIO_FRAME_TYPE =
+        recording::Frame::registerFrameType(AudioConstants::getAudioFrameName());
+
+    auto recording = std::make_shared<BotRecording>();
+    clip->seek(0.0f);
+    for (auto frame = clip->nextFrame(); frame; frame = clip->nextFrame()) {
+        if (frame->type == AVATAR_FRAME_TYPE) {
+            recording->avatarFrames.push_back({ frame->timeOffset, frame->data });
+        } else if (frame->type == AUDIO_FRAME_TYPE) {
+            recording->audioFrames.push_back({ frame->timeOffset, frame->data });
+        }
+    }
+    recording->duration = recording::Frame::secondsToFrameTime(clip->duration());
+
+    if (recording->avatarFrames.empty() && recording->audioFrames.empty()) {
+        return nullptr;
+    }
+    return recording;
+}
+
+BotStats::BotStats() {
+    for (int i = 0; i < SwarmBot::NUM_MIXERS; ++i) {
+        lastPingUsecs[i] = -1;
+        totalPingUsecs[i] = 0;
+        numPings[i] = 0;
+    }
+}
+
+SwarmBot::Avatar::Avatar() {
+    _headData = new HeadData(this);
+}
+
+QByteArray SwarmBot::Avatar::toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking) {
+    // like the ScriptableAvatar, which has no simulation to compute it either
+    _globalPosition = getWorldPosition();
+    return AvatarData::toByteArrayStateful(dataDetail, dropFaceTracking);
+}
+
+SwarmBot::SwarmBot(int index, const BotProfile& profile, const SockAddr& domainServer, const QHostAddress& localAddress,
+                   std::shared_ptr<const BotRecording> recording) :
+    _index(index),
+    _profile(profile),
+    _domainServer(domainServer),
+    _localAddress(localAddress),
+    _recording(recording)
+{
+    float angle = randFloatInRange(0.0f, TWO_PI);
+    float distance = SPAWN_RADIUS * sqrtf(randFloat());
+    _spawnPosition = glm::vec3(distance * cosf(angle), 0.0f, distance * sinf(angle));
+
+    if (_recording && _recording->duration > 0) {
+        _recordingOffset = (quint32)randIntInRange(0, (int)_recording->duration - 1);
+    }
+}
+
+SwarmBot::~SwarmBot() {
+    stop();
+}
+
+void SwarmBot::start() {
+    _socket.reset(new udt::Socket(nullptr, false));
+    _socket->bind(SocketType::UDP, QHostAddress::AnyIPv4);
+    _localSocket = SockAddr(SocketType::UDP, _localAddress, _socket->localPort(SocketType::UDP));
+
+    _socket->setPacketHandler([this](std::unique_ptr<udt::Packet> packet) {
+        handlePacket(std::move(packet));
+    });
+    _socket->setMessageHandler([this](std::unique_ptr<udt::Packet> packet) {
+        handleMessagePacket(std::move(packet));
+    });
+
+    _avatar.reset(new Avatar());
+    _avatar->setSessionUUID(QUuid::createUuid());
+    _avatar->setWorldPosition(_spawnPosition);
+    if (_recording && !_recording->avatarFrames.empty()) {
+        // the recordings are replayed around the spawn position of each bot, rather than where they were recorded
+        AvatarData::fromFrame(_recording->avatarFrames.front().data, *_avatar, false);
+        _recordingOrigin = _avatar->getWorldPosition();
+    }
+
+    _startTime = usecTimestampNow();
+    _lastDomainList = _startTime;
+    _nextCheckIn = _startTime;
+}
+
+void SwarmBot::stop() {
+    if (!_socket) {
+        return;
+    }
+    if (_stats.isConnected) {
+        auto packet = NLPacket::create(PacketType::DomainDisconnectRequest, 0);
+        send(*packet, _domainServer);
+        _stats.isConnected = false;
+    }
+    reset();
+    _socket.reset();
+    _avatar.reset();
+}
+
+void SwarmBot::reset() {
+    _sessionUUID = QUuid();
+    _sessionLocalID = 0;
+    _authenticatePackets = false;
+    _domainListVersion = 0;
+    _checkInsSinceFullDomainList = 0;
+    for (auto& mixer : _mixers) {
+        mixer = Mixer();
+    }
+    _nextSubscribe = 0;
+    _mixedAudioSequenceStats.reset();
+
+    if (_stats.isConnected) {
+        _stats.isConnected = false;
+        ++_stats.numReconnects;
+    }
+}
+
+void SwarmBot::update(quint64 now) {
+    if (!_socket) {
+        return;
+    }
+
+    if (now - _lastDomainList > DOMAIN_LIST_TIMEOUT_USECS && !_sessionUUID.isNull()) {
+        reset();
+    }
+    if (now >= _nextCheckIn) {
+        sendCheckIn(now);
+        _nextCheckIn = now + CHECK_IN_INTERVAL_USECS;
+    }
+    if (!_stats.isConnected) {
+        return;
+    }
+
+    for (auto& mixer : _mixers) {
+        if (!mixer.uuid.isNull() && now >= mixer.nextPing) {
+            sendPing(mixer, now);
+        }
+    }
+
+    if (_profile.avatarRate > 0.0f && now >= _nextAvatarData) {
+        sendAvatarData(now);
+        _nextAvatarData = now + (quint64)(USECS_PER_SECOND / _profile.avatarRate);
+    }
+    if (now >= _nextAvatarQuery) {
+        sendAvatarQuery();
+        _nextAvatarQuery = now + AVATAR_QUERY_INTERVAL_USECS;
+    }
+    if (_profile.sendsAudio) {
+        sendAudio(now);
+    }
+    if (_profile.entityQueryRate > 0.0f && now >= _nextEntityQuery) {
+        sendEntityQuery();
+        _nextEntityQuery = now + (quint64)(USECS_PER_SECOND / _profile.entityQueryRate);
+    }
+    if ((_profile.listensToMessages || _profile.messageRate > 0.0f) && now >= _nextSubscribe) {
+        // the subscriptions are sent unreliably, and sent again every so often in case they were lost
+        subscribeToMessages();
+        _nextSubscribe = now + SUBSCRIBE_INTERVAL_USECS;
+    }
+    if (_profile.messageRate > 0.0f && now >= _nextMessage) {
+        sendMessage(now);
+        // spread over an exponential distribution, so that the bots don't send their messages in lockstep
+        float interval = -logf(std::max(randFloat(), 0.0001f)) / _profile.messageRate;
+        _nextMessage = now + (quint64)(interval * USECS_PER_SECOND);
+    }
+}
+
+void SwarmBot::send(NLPacket& packet, const SockAddr& destination, HMACAuth* hmac) {
+    PacketType type = packet.getType();
+    if (!PacketTypeEnum::getNonSourcedPackets().contains(type)) {
+        packet.writeSourceID(_sessionLocalID);
+        if (_authenticatePackets && hmac && !PacketTypeEnum::getNonVerifiedPackets().contains(type)) {
+            packet.writeVerificationHash(*hmac);
+        }
+    }
+
+    qint64 bytesWritten = _socket->writePacket(packet, destination);
+    if (bytesWritten > 0) {
+        ++_stats.packetsSent;
+        _stats.bytesSent += bytesWritten;
+    }
+}
+
+void SwarmBot::sendToMixer(NLPacket& packet, int mixerIndex) {
+    Mixer& mixer = _mixers[mixerIndex];
+    if (mixer.activeSocket) {
+        send(packet, *mixer.activeSocket, mixer.hmac.get());
+    }
+}
+
+SwarmBot::Mixer* SwarmBot::mixerForSourceID(NetworkLocalID sourceID) {
+    for (auto& mixer : _mixers) {
+        if (!mixer.uuid.isNull() && mixer.localID == sourceID) {
+            return &mixer;
+        }
+    }
+    return nullptr;
+}
+
+void SwarmBot::sendCheckIn(quint64 now) {
+    bool isConnected = !_sessionUUID.isNull();
+    auto packet = NLPacket::create(isConnected ? PacketType::DomainListRequest : PacketType::DomainConnectRequest);
+    QDataStream packetStream(packet.get());
+
+    if (!isConnected) {
+        packetStream << QUuid();
+        QByteArray protocolVersionSig = protocolVersionsSignature();
+        packetStream.writeBytes(protocolVersionSig.constData(), protocolVersionSig.size());
+        packetStream << QString() << _machineFingerprint << QByteArray();
+        packetStream << LimitedNodeList::ConnectReason::Connect << quint64(0);
+    }
+
+    using namespace std::chrono;
+    packetStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
+
+    // the bots are on the local network of the domain, or behind the same NAT as all the others, so they present their
+    // local socket as their public one
+    QList<NodeType_t> interestList {
+        NodeType::AudioMixer, NodeType::AvatarMixer, NodeType::EntityServer, NodeType::MessagesMixer
+    };
+    packetStream << NodeType::Agent << _localSocket.getType() << _localSocket << _localSocket.getType() << _localSocket
+        << interestList;
+    packetStream << QString();
+
+    if (!isConnected) {
+        packetStream << QString() << QString();
+    } else if (++_checkInsSinceFullDomainList >= CHECK_INS_PER_FULL_DOMAIN_LIST) {
+        _checkInsSinceFullDomainList = 0;
+        packetStream << quint32(0);
+    } else {
+        packetStream << _domainListVersion;
+    }
+
+    send(*packet, _domainServer);
+}
+
+void SwarmBot::handlePacket(std::unique_ptr<udt::Packet> packet) {
+    if (!_socket) {
+        return;
+    }
+    auto nlPacket = NLPacket::fromBase(std::move(packet));
+    ++_stats.packetsReceived;
+    _stats.bytesReceived += nlPacket->getDataSize();
+
+    if (nlPacket->getVersion() != versionForPacketType(nlPacket->getType())) {
+        return;
+    }
+
+    QByteArray payload = QByteArray::fromRawData(nlPacket->getPayload(), (int)nlPacket->getPayloadSize());
+    switch (nlPacket->getType()) {
+        case PacketType::DomainList:
+            processDomainList(payload);
+            break;
+        case PacketType::DomainServerAddedNode: {
+            QDataStream stream(payload);
+            while (!stream.atEnd() && stream.status() == QDataStream::Ok) {
+                processNode(stream);
+            }
+            break;
+        }
+        case PacketType::DomainServerRemovedNode:
+            if (payload.size() >= NUM_BYTES_RFC4122_UUID) {
+                processRemovedNode(QUuid::fromRfc4122(payload.left(NUM_BYTES_RFC4122_UUID)));
+            }
+            break;
+        case PacketType::DomainConnectionDenied:
+            ++_stats.numDenials;
+            reset();
+            break;
+        case PacketType::Ping:
+            processPing(*nlPacket, nlPacket->getSenderSockAddr());
+            break;
+        case PacketType::PingReply:
+            processPingReply(*nlPacket, nlPacket->getSenderSockAddr());
+            break;
+        case PacketType::MixedAudio:
+        case PacketType::SilentAudioFrame:
+            if (payload.size() >= (int)sizeof(quint16)) {
+                quint16 sequence;
+                memcpy(&sequence, payload.constData(), sizeof(sequence));
+                _mixedAudioSequenceStats.sequenceNumberReceived(sequence);
+                _stats.mixedAudioReceived = _mixedAudioSequenceStats.getReceived();
+                _stats.mixedAudioLost = _mixedAudioSequenceStats.getLost();
+            }
+            break;
+        case PacketType::BulkAvatarData:
+        case PacketType::AvatarIdentity:
+        case PacketType::BulkAvatarTraits:
+            _stats.avatarBytesReceived += nlPacket->getDataSize();
+            break;
+        case PacketType::EntityData:
+        case PacketType::OctreeStats:
+            _stats.entityBytesReceived += nlPacket->getDataSize();
+            break;
+        case PacketType::MessagesData:
+            processMessage(payload);
+            break;
+        default:
+            break;
+    }
+}
+
+void SwarmBot::handleMessagePacket(std::unique_ptr<udt::Packet> packet) {
+    // the messages of more than one packet, like the domain lists of large domains, aren't put back together; the bots
+    // only need the messages mixer's, which are short
+    if (packet->getPacketPosition() == udt::Packet::PacketPosition::ONLY) {
+        handlePacket(std::move(packet));
+    }
+}
+
+void SwarmBot::processDomainList(const QByteArray& payload) {
+    QDataStream stream(payload);
+
+    QUuid domainUUID;
+    NetworkLocalID domainLocalID;
+    QUuid newUUID;
+    NetworkLocalID newLocalID;
+    NodePermissions permissions;
+    bool isAuthenticated;
+    quint64 connectRequestTimestamp;
+    quint64 domainServerPingSendTime;
+    quint64 domainServerCheckinProcessingTime;
+    bool newConnection;
+    quint32 listVersion;
+    stream >> domainUUID >> domainLocalID >> newUUID >> newLocalID >> permissions >> isAuthenticated
+        >> connectRequestTimestamp >> domainServerPingSendTime >> domainServerCheckinProcessingTime >> newConnection
+        >> listVersion;
+    if (stream.status() != QDataStream::Ok) {
+        return;
+    }
+
+    quint64 now = usecTimestampNow();
+    _lastDomainList = now;
+    if (_sessionUUID != newUUID) {
+        reset();
+        _sessionUUID = newUUID;
+        _avatar->setSessionUUID(newUUID);
+    }
+    _sessionLocalID = newLocalID;
+    _authenticatePackets = isAuthenticated;
+
+    if (!_stats.isConnected) {
+        _stats.isConnected = true;
+        if (_stats.connectMsecs < 0) {
+            _stats.connectMsecs = (int)((now - _startTime) / USECS_PER_MSEC);
+        }
+    }
+
+    while (!stream.atEnd() && stream.status() == QDataStream::Ok) {
+        processNode(stream);
+    }
+    _domainListVersion = listVersion;
+}
+
+void SwarmBot::processNode(QDataStream& stream) {
+    NodeType_t type;
+    QUuid uuid;
+    SocketType publicSocketType, localSocketType;
+    SockAddr publicSocket, localSocket;
+    NodePermissions permissions;
+    bool isReplicated;
+    NetworkLocalID localID;
+    QUuid connectionSecret;
+    stream >> type >> uuid >> publicSocketType >> publicSocket >> localSocketType >> localSocket >> permissions
+        >> isReplicated >> localID >> connectionSecret;
+    if (stream.status() != QDataStream::Ok) {
+        return;
+    }
+    publicSocket.setType(publicSocketType);
+    localSocket.setType(localSocketType);
+    if (publicSocket.getAddress().isNull()) {
+        publicSocket.setAddress(_domainServer.getAddress());
+    }
+
+    int mixerIndex = mixerIndexForType(type);
+    if (mixerIndex < 0) {
+        return;
+    }
+
+    Mixer& mixer = _mixers[mixerIndex];
+    if (mixer.uuid != uuid) {
+        mixer = Mixer();
+        mixer.uuid = uuid;
+    }
+    mixer.localID = localID;
+    if (mixer.publicSocket != publicSocket || mixer.localSocket != localSocket) {
+        mixer.publicSocket = publicSocket;
+        mixer.localSocket = localSocket;
+        mixer.activeSocket = nullptr;
+    }
+    if (!mixer.hmac) {
+        mixer.hmac.reset(new HMACAuth());
+    }
+    mixer.hmac->setKey(connectionSecret);
+}
+
+void SwarmBot::processRemovedNode(const QUuid& nodeUUID) {
+    for (auto& mixer : _mixers) {
+        if (!mixer.uuid.isNull() && mixer.uuid == nodeUUID) {
+            mixer = Mixer();
+        }
+    }
+}
+
+void SwarmBot::sendPing(Mixer& mixer, quint64 now) {
+    // until one of the sockets answers both are pinged, then the pings keep the connection alive and measure its latency
+    auto sendPingTo = [&](const SockAddr& socket, PingType_t pingType) {
+        auto packet = NLPacket::create(PacketType::Ping, sizeof(PingType_t) + sizeof(quint64) + sizeof(int64_t));
+        packet->writePrimitive(pingType);
+        packet->writePrimitive(now);
+        packet->writePrimitive((int64_t)0);
+        send(*packet, socket, mixer.hmac.get());
+    };
+
+    if (mixer.activeSocket) {
+        sendPingTo(*mixer.activeSocket, mixer.activeSocket == &mixer.localSocket ? PingType::Local : PingType::Public);
+    } else {
+        sendPingTo(mixer.localSocket, PingType::Local);
+        if (mixer.publicSocket != mixer.localSocket) {
+            sendPingTo(mixer.publicSocket, PingType::Public);
+        }
+    }
+    mixer.nextPing = now + PING_INTERVAL_USECS;
+}
+
+void SwarmBot::processPing(const NLPacket& packet, const SockAddr& senderSocket) {
+    Mixer* mixer = mixerForSourceID(packet.getSourceID());
+    if (!mixer || packet.getPayloadSize() < (qint64)(sizeof(PingType_t) + sizeof(quint64))) {
+        return;
+    }
+
+    PingType_t pingType;
+    quint64 pingTime;
+    memcpy(&pingType, packet.getPayload(), sizeof(pingType));
+    memcpy(&pingTime, packet.getPayload() + sizeof(pingType), sizeof(pingTime));
+
+    auto reply = NLPacket::create(PacketType::PingReply, sizeof(PingType_t) + sizeof(quint64) + sizeof(quint64));
+    reply->writePrimitive(pingType);
+    reply->writePrimitive(pingTime);
+    reply->writePrimitive(usecTimestampNow());
+    send(*reply, senderSocket, mixer->hmac.get());
+}
+
+void SwarmBot::processPingReply(const NLPacket& packet, const SockAddr& senderSocket) {
+    Mixer* mixer = mixerForSourceID(packet.getSourceID());
+    if (!mixer || packet.getPayloadSize() < (qint64)(sizeof(PingType_t) + sizeof(quint64))) {
+        return;
+    }
+
+    PingType_t pingType;
+    quint64 pingTime;
+    memcpy(&pingType, packet.getPayload(), sizeof(pingType));
+    memcpy(&pingTime, packet.getPayload() + sizeof(pingType), sizeof(pingTime));
+
+    if (!mixer->activeSocket) {
+        mixer->activeSocket = pingType == PingType::Local ? &mixer->localSocket : &mixer->publicSocket;
+    }
+
+    quint64 now = usecTimestampNow();
+    if (now >= pingTime) {
+        int mixerIndex = (int)(mixer - _mixers);
+        int pingUsecs = (int)(now - pingTime);
+        _stats.lastPingUsecs[mixerIndex] = pingUsecs;
+        _stats.totalPingUsecs[mixerIndex] += pingUsecs;
+        ++_stats.numPings[mixerIndex];
+    }
+}
+
+void SwarmBot::sendAvatarData(quint64 now) {
+    if (_recording && !_recording->avatarFrames.empty() && _recording->duration > 0) {
+        quint32 time = (quint32)(((now - _startTime) / USECS_PER_MSEC + _recordingOffset) % _recording->duration);
+        auto& frames = _recording->avatarFrames;
+        auto frame = std::upper_bound(frames.begin(), frames.end(), time, [](quint32 time, const BotRecording::Frame& frame) {
+            return time < frame.timeOffset;
+        });
+        if (frame != frames.begin()) {
+            --frame;
+        }
+        AvatarData::fromFrame(frame->data, *_avatar, false);
+        _avatar->setWorldPosition(_avatar->getWorldPosition() - _recordingOrigin + _spawnPosition);
+    } else if (_profile.walkRadius > 0.0f) {
+        float elapsed = (float)(now - _startTime) / USECS_PER_SECOND;
+        float phase = elapsed * WALK_SPEED / _profile.walkRadius + (float)_index;
+        glm::vec3 offset(cosf(phase), 0.0f, sinf(phase));
+        _avatar->setWorldPosition(_spawnPosition + _profile.walkRadius * offset);
+        // facing along the circle
+        _avatar->setWorldOrientation(glm::angleAxis(-phase, Vectors::UNIT_Y));
+    }
+
+    // like the AvatarData, a full update is sent every so often in case the ones that changed a joint were lost
+    bool cullSmallData = randFloat() < AVATAR_SEND_FULL_UPDATE_RATIO;
+    auto dataDetail = cullSmallData ? AvatarData::SendAllData : AvatarData::CullSmallData;
+    QByteArray avatarByteArray = _avatar->toByteArrayStateful(dataDetail);
+
+    int maximumByteArraySize = NLPacket::maxPayloadSize(PacketType::AvatarData) - sizeof(AvatarDataSequenceNumber);
+    if (avatarByteArray.size() > maximumByteArraySize) {
+        avatarByteArray = _avatar->toByteArrayStateful(AvatarData::MinimumData, true);
+        if (avatarByteArray.size() > maximumByteArraySize) {
+            return;
+        }
+    }
+    _avatar->doneEncoding(cullSmallData);
+
+    auto packet = NLPacket::create(PacketType::AvatarData, avatarByteArray.size() + sizeof(AvatarDataSequenceNumber));
+    packet->writePrimitive(_avatarSequenceNumber++);
+    packet->write(avatarByteArray);
+    sendToMixer(*packet, AVATAR_MIXER);
+}
+
+void SwarmBot::sendAvatarQuery() {
+    auto packet = NLPacket::create(PacketType::AvatarQuery);
+    auto destinationBuffer = reinterpret_cast<unsigned char*>(packet->getPayload());
+    unsigned char* bufferStart = destinationBuffer;
+
+    ConicalViewFrustum view;
+    view.setPositionAndSimpleRadius(_avatar->getWorldPosition(), QUERY_RADIUS);
+
+    uint8_t numFrustums = 1;
+    memcpy(destinationBuffer, &numFrustums, sizeof(numFrustums));
+    destinationBuffer += sizeof(numFrustums);
+    destinationBuffer += view.serialize(destinationBuffer);
+
+    uint8_t maxUpdateRate = (uint8_t)glm::clamp(_profile.maxAvatarUpdateRate, 0, (int)UINT8_MAX);
+    memcpy(destinationBuffer, &maxUpdateRate, sizeof(maxUpdateRate));
+    destinationBuffer += sizeof(maxUpdateRate);
+
+    uint16_t maxReceiveKbps = (uint16_t)glm::clamp(_profile.maxAvatarReceiveKbps, 0, (int)UINT16_MAX);
+    memcpy(destinationBuffer, &maxReceiveKbps, sizeof(maxReceiveKbps));
+    destinationBuffer += sizeof(maxReceiveKbps);
+
+    packet->setPayloadSize(destinationBuffer - bufferStart);
+    sendToMixer(*packet, AVATAR_MIXER);
+}
+
+void SwarmBot::sendAudio(quint64 now) {
+    if (_nextAudio == 0 || now > _nextAudio + MAX_AUDIO_FRAMES_BEHIND * AudioConstants::NETWORK_FRAME_USECS) {
+        _nextAudio = now;
+    }
+
+    while (now >= _nextAudio) {
+        _nextAudio += AudioConstants::NETWORK_FRAME_USECS;
+
+        // the bots talk in spurts, and are silent in between
+        if (now >= _talkSpurtEnd) {
+            _isTalking = randFloat() < _profile.talkFraction;
+            float spurtSecs = randFloatInRange(MIN_TALK_SPURT_SECS, MAX_TALK_SPURT_SECS);
+            _talkSpurtEnd = now + (quint64)(spurtSecs * USECS_PER_SECOND);
+        }
+
+        auto packet = NLPacket::create(_isTalking ? PacketType::MicrophoneAudioNoEcho : PacketType::SilentAudioFrame);
+        packet->writePrimitive(_audioSequenceNumber++);
+        packet->writeString(AUDIO_CODEC_NAME);
+        if (_isTalking) {
+            quint8 channelFlag = 0;
+            packet->writePrimitive(channelFlag);
+        } else {
+            quint16 numSilentSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+            packet->writePrimitive(numSilentSamples);
+        }
+
+        glm::vec3 position = _avatar->getWorldPosition();
+        packet->writePrimitive(position);
+        packet->writePrimitive(_avatar->getWorldOrientation());
+        packet->writePrimitive(position - 0.5f * AVATAR_DIMENSIONS);
+        packet->writePrimitive(AVATAR_DIMENSIONS);
+
+        if (_isTalking) {
+            int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] {};
+            if (_recording && !_recording->audioFrames.empty()) {
+                // the recorded frames are the network frames of the microphone, which are looped
+                const QByteArray& frame = _recording->audioFrames[_audioFrameIndex].data;
+                _audioFrameIndex = (_audioFrameIndex + 1) % _recording->audioFrames.size();
+                memcpy(samples, frame.constData(), std::min((size_t)frame.size(), sizeof(samples)));
+            } else {
+                const float PHASE_STEP = TWO_PI * TONE_FREQUENCY / AudioConstants::SAMPLE_RATE;
+                for (auto& sample : samples) {
+                    sample = (int16_t)(TONE_AMPLITUDE * sinf(_tonePhase));
+                    _tonePhase = fmodf(_tonePhase + PHASE_STEP, TWO_PI);
+                }
+            }
+            packet->write(reinterpret_cast<const char*>(samples), sizeof(samples));
+        }
+        sendToMixer(*packet, AUDIO_MIXER);
+    }
+}
+
+void SwarmBot::sendEntityQuery() {
+    ConicalViewFrustum view;
+    view.setPositionAndSimpleRadius(_avatar->getWorldPosition(), QUERY_RADIUS);
+
+    OctreeQuery query;
+    query.setConicalViews({ view });
+    query.setWantCompressionDictionary(false);
+
+    auto packet = NLPacket::create(PacketType::EntityQuery);
+    int size = query.getBroadcastData(reinterpret_cast<unsigned char*>(packet->getPayload()));
+    packet->setPayloadSize(size);
+    sendToMixer(*packet, ENTITY_SERVER);
+}
+
+void SwarmBot::subscribeToMessages() {
+    auto packet = NLPacket::create(PacketType::MessagesSubscribe);
+    packet->write(MESSAGES_CHANNEL.toUtf8());
+    sendToMixer(*packet, MESSAGES_MIXER);
+}
+
+void SwarmBot::sendMessage(quint64 now) {
+    // the messages carry the time they were sent, the bots all run on the same clock
+    QByteArray channel = MESSAGES_CHANNEL.toUtf8();
+    QByteArray message = QByteArray::number(now);
+
+    auto packet = NLPacket::create(PacketType::MessagesData);
+    packet->writePrimitive((quint16)channel.size());
+    packet->write(channel);
+    packet->writePrimitive(true);
+    packet->writePrimitive((quint32)message.size());
+    packet->write(message);
+    packet->write(_sessionUUID.toRfc4122());
+    sendToMixer(*packet, MESSAGES_MIXER);
+}
+
+void SwarmBot::processMessage(const QByteArray& payload) {
+    const char* data = payload.constData();
+    const char* end = data + payload.size();
+
+    quint16 channelLength;
+    if (end - data < (qint64)sizeof(channelLength)) {
+        return;
+    }
+    memcpy(&channelLength, data, sizeof(channelLength));
+    data += sizeof(channelLength);
+    if (end - data < channelLength + 1 || QByteArray::fromRawData(data, channelLength) != MESSAGES_CHANNEL.toUtf8()) {
+        return;
+    }
+    data += channelLength + 1; // and the isText flag
+
+    quint32 messageLength;
+    if (end - data < (qint64)sizeof(messageLength)) {
+        return;
+    }
+    memcpy(&messageLength, data, sizeof(messageLength));
+    data += sizeof(messageLength);
+    if ((quint64)(end - data) < messageLength) {
+        return;
+    }
+
+    bool ok;
+    quint64 sentTime = QByteArray(data, (int)messageLength).toULongLong(&ok);
+    quint64 now = usecTimestampNow();
+    if (ok && now >= sentTime) {
+        quint32 latency = (quint32)std::min(now - sentTime, (quint64)UINT32_MAX);
+        ++_stats.messagesReceived;
+        _stats.totalMessageUsecs += latency;
+        quint32 maxLatency = _stats.maxMessageUsecs;
+        while (latency > maxLatency && !_stats.maxMessageUsecs.compare_exchange_weak(maxLatency, latency)) {
+        }
+    }
+}
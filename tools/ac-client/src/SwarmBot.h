@@ -0,0 +1,206 @@
+//
+//  SwarmBot.h
+//  tools/ac-client/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_SwarmBot_h
+#define overte_SwarmBot_h
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtCore/QUuid>
+
+#include <AvatarData.h>
+#include <HMACAuth.h>
+#include <NLPacket.h>
+#include <NodeType.h>
+#include <SequenceNumberStats.h>
+#include <SockAddr.h>
+#include <udt/Socket.h>
+
+/// What a bot of the swarm does, once it's connected.  The rates are per second and zero turns a stream off.
+struct BotProfile {
+    QString name { "default" };
+    float weight { 1.0f };               // the share of the bots that get this profile
+
+    float avatarRate { 45.0f };
+    float walkRadius { 5.0f };           // avatars that aren't replaying a recording walk in circles of this radius
+    int maxAvatarUpdateRate { 0 };       // the rate and the bandwidth the avatar mixer sends the others at, 0 for no limit
+    int maxAvatarReceiveKbps { 0 };
+    bool sendsAudio { true };            // sends silent frames when it isn't talking
+    float talkFraction { 0.1f };         // the share of the time the bot talks, in spurts of a few seconds
+    float entityQueryRate { 1.0f };
+    float messageRate { 0.0f };
+    bool listensToMessages { false };    // subscribes to the swarm's channel, which measures the messages' latency
+
+    static BotProfile fromJson(const QJsonObject& object);
+};
+
+/// The frames the bots replay, shared by all of them.  Each bot starts at a random offset and loops.
+struct BotRecording {
+    struct Frame {
+        quint32 timeOffset;  // msecs
+        QByteArray data;
+    };
+    std::vector<Frame> avatarFrames;
+    std::vector<Frame> audioFrames;
+    quint32 duration { 0 };
+
+    static std::shared_ptr<const BotRecording> fromFile(const QString& filename);
+};
+
+/// The measurements of a bot, read by the swarm's report from another thread
+struct BotStats {
+    std::atomic<bool> isConnected { false };
+    std::atomic<int> connectMsecs { -1 };
+    std::atomic<int> numReconnects { 0 };
+    std::atomic<int> numDenials { 0 };
+
+    std::atomic<quint64> packetsSent { 0 };
+    std::atomic<quint64> bytesSent { 0 };
+    std::atomic<quint64> packetsReceived { 0 };
+    std::atomic<quint64> bytesReceived { 0 };
+
+    // the round trip times of the pings, in usecs, to the mixers indexed by MixerIndex
+    std::atomic<int> lastPingUsecs[4];
+    std::atomic<quint64> totalPingUsecs[4];
+    std::atomic<quint32> numPings[4];
+
+    // the mixed audio lost on the way back from the audio mixer
+    std::atomic<quint32> mixedAudioReceived { 0 };
+    std::atomic<quint32> mixedAudioLost { 0 };
+
+    std::atomic<quint64> avatarBytesReceived { 0 };
+    std::atomic<quint64> entityBytesReceived { 0 };
+
+    // the time the swarm's messages took from their sender to this bot
+    std::atomic<quint32> messagesReceived { 0 };
+    std::atomic<quint64> totalMessageUsecs { 0 };
+    std::atomic<quint32> maxMessageUsecs { 0 };
+
+    BotStats();
+};
+
+/// A lightweight avatar client, that connects its own socket to the domain and the mixers without a NodeList or a
+/// script engine, so that a single process can simulate thousands of them.  The bot lives on the thread of its
+/// worker, which calls update() on every tick.
+class SwarmBot : public QObject {
+    Q_OBJECT
+public:
+    enum MixerIndex {
+        AUDIO_MIXER = 0,
+        AVATAR_MIXER,
+        ENTITY_SERVER,
+        MESSAGES_MIXER,
+        NUM_MIXERS
+    };
+
+    static const char* getMixerName(int mixerIndex);
+
+    SwarmBot(int index, const BotProfile& profile, const SockAddr& domainServer, const QHostAddress& localAddress,
+             std::shared_ptr<const BotRecording> recording);
+    ~SwarmBot();
+
+    void start();
+    void update(quint64 now);
+    void stop();
+
+    int getIndex() const { return _index; }
+    const BotProfile& getProfile() const { return _profile; }
+    const BotStats& getStats() const { return _stats; }
+
+private:
+    struct Mixer {
+        QUuid uuid;
+        NetworkLocalID localID { 0 };
+        SockAddr publicSocket;
+        SockAddr localSocket;
+        const SockAddr* activeSocket { nullptr };
+        std::unique_ptr<HMACAuth> hmac;
+        quint64 nextPing { 0 };
+    };
+
+    class Avatar : public AvatarData {
+    public:
+        Avatar();
+        QByteArray toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking = false) override;
+    };
+
+    void handlePacket(std::unique_ptr<udt::Packet> packet);
+    void handleMessagePacket(std::unique_ptr<udt::Packet> packet);
+
+    void processDomainList(const QByteArray& payload);
+    void processNode(QDataStream& stream);
+    void processRemovedNode(const QUuid& nodeUUID);
+    void processPing(const NLPacket& packet, const SockAddr& senderSocket);
+    void processPingReply(const NLPacket& packet, const SockAddr& senderSocket);
+    void processMessage(const QByteArray& payload);
+
+    void sendCheckIn(quint64 now);
+    void sendPing(Mixer& mixer, quint64 now);
+    void sendAvatarData(quint64 now);
+    void sendAvatarQuery();
+    void sendAudio(quint64 now);
+    void sendEntityQuery();
+    void sendMessage(quint64 now);
+    void subscribeToMessages();
+
+    void send(NLPacket& packet, const SockAddr& destination, HMACAuth* hmac = nullptr);
+    void sendToMixer(NLPacket& packet, int mixerIndex);
+    Mixer* mixerForSourceID(NetworkLocalID sourceID);
+    void reset();
+
+    int _index;
+    BotProfile _profile;
+    SockAddr _domainServer;
+    QHostAddress _localAddress;
+    SockAddr _localSocket;
+    std::shared_ptr<const BotRecording> _recording;
+    std::unique_ptr<udt::Socket> _socket;
+
+    QUuid _sessionUUID;
+    NetworkLocalID _sessionLocalID { 0 };
+    bool _authenticatePackets { false };
+    quint32 _domainListVersion { 0 };
+    int _checkInsSinceFullDomainList { 0 };
+    QUuid _machineFingerprint { QUuid::createUuid() };
+    quint64 _startTime { 0 };
+    quint64 _lastDomainList { 0 };
+    quint64 _nextCheckIn { 0 };
+
+    Mixer _mixers[NUM_MIXERS];
+
+    std::unique_ptr<Avatar> _avatar;
+    glm::vec3 _spawnPosition;
+    glm::vec3 _recordingOrigin;
+    quint32 _recordingOffset { 0 };
+    quint64 _nextAvatarData { 0 };
+    quint64 _nextAvatarQuery { 0 };
+    quint16 _avatarSequenceNumber { 0 };
+
+    quint64 _nextAudio { 0 };
+    quint64 _talkSpurtEnd { 0 };
+    bool _isTalking { false };
+    size_t _audioFrameIndex { 0 };
+    float _tonePhase { 0.0f };
+    quint16 _audioSequenceNumber { 0 };
+    SequenceNumberStats _mixedAudioSequenceStats;
+
+    quint64 _nextEntityQuery { 0 };
+    quint64 _nextMessage { 0 };
+    quint64 _nextSubscribe { 0 };
+
+    BotStats _stats;
+};
+
+#endif // overte_SwarmBot_h
@@ -0,0 +1,387 @@
+//
+//  FrameBenchmark.cpp
+//  tools/gpu-frame-player/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "FrameBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+
+#include <gl/Config.h>
+#include <gl/GLHelpers.h>
+#include <gpu/Context.h>
+#include <gpu/Frame.h>
+#include <gpu/FrameIO.h>
+#include <gpu/Query.h>
+#include <gpu/gl/GLBackend.h>
+
+namespace {
+
+using Clock = std::chrono::high_resolution_clock;
+
+double getMilliseconds(const Clock::time_point& start, const Clock::time_point& end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+const QString MEDIAN_KEY { "median" };
+
+}
+
+FrameBenchmark::FrameBenchmark(const Settings& settings) : _settings(settings) {
+}
+
+FrameBenchmark::~FrameBenchmark() {
+    _frames.clear();
+    _pendingQueries.clear();
+    if (_gpuContext) {
+        _canvas.makeCurrent();
+        _gpuContext->shutdown();
+        _gpuContext.reset();
+        glDeleteTextures(1, &_externalTexture);
+        _canvas.doneCurrent();
+    }
+}
+
+QJsonObject FrameBenchmark::summarize(const Samples& samples) {
+    QJsonObject summary;
+    if (samples.empty()) {
+        return summary;
+    }
+    Samples sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (double sample : sorted) {
+        total += sample;
+    }
+    summary["mean"] = total / sorted.size();
+    summary[MEDIAN_KEY] = sorted[sorted.size() / 2];
+    summary["p95"] = sorted[(sorted.size() * 95) / 100];
+    summary["max"] = sorted.back();
+    return summary;
+}
+
+bool FrameBenchmark::initialize() {
+    getDefaultOpenGLSurfaceFormat();
+    if (!_canvas.create() || !_canvas.makeCurrent()) {
+        qCritical() << "Unable to create an offscreen GL context";
+        return false;
+    }
+    gl::initModuleGl();
+
+    // the frames are read with this in place of the external textures, as in the interactive player
+    glGenTextures(1, &_externalTexture);
+    glBindTexture(GL_TEXTURE_2D, _externalTexture);
+    static const glm::u8vec4 color { 0 };
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &color);
+
+    gpu::Context::init<gpu::gl::GLBackend>();
+    _gpuContext = std::make_shared<gpu::Context>();
+    _gpuContext->beginFrame();
+    _gpuContext->endFrame();
+    return true;
+}
+
+bool FrameBenchmark::loadFrames() {
+    QStringList filenames;
+    for (const auto& path : _settings.framePaths) {
+        QFileInfo info(path);
+        if (info.isDir()) {
+            for (const auto& entry : QDir(path).entryInfoList({ "*.hfb" }, QDir::Files, QDir::Name)) {
+                filenames << entry.absoluteFilePath();
+            }
+        } else {
+            filenames << info.absoluteFilePath();
+        }
+    }
+    if (filenames.isEmpty()) {
+        qCritical() << "No frames to replay in" << _settings.framePaths;
+        return false;
+    }
+
+    for (const auto& filename : filenames) {
+        auto frame = gpu::readFrame(filename.toStdString(), _externalTexture);
+        if (!frame || !frame->framebuffer) {
+            qCritical() << "Failed to read the frame" << filename;
+            return false;
+        }
+
+        FrameTiming timing;
+        timing.name = QFileInfo(filename).fileName();
+        timing.frame = frame;
+        timing.cpu.resize(_settings.iterations, 0.0);
+        for (size_t i = 0; i < frame->batches.size(); ++i) {
+            BatchTiming batchTiming;
+            batchTiming.name = frame->batches[i]->getName();
+            if (batchTiming.name.empty()) {
+                batchTiming.name = "batch " + std::to_string(i);
+            }
+            batchTiming.gpu.resize(_settings.iterations, 0.0);
+            batchTiming.cpu.resize(_settings.iterations, 0.0);
+            timing.batches.push_back(batchTiming);
+        }
+        _frames.push_back(std::move(timing));
+    }
+    return true;
+}
+
+void FrameBenchmark::replay(FrameTiming& timing, int iteration) {
+    const auto& frame = timing.frame;
+    const auto& backend = _gpuContext->getBackend();
+    bool isTimed = iteration >= 0;
+
+    backend->recycle();
+    backend->syncCache();
+
+    // the depth is cleared the way the interactive player does
+    auto& glBackend = static_cast<gpu::gl::GLBackend&>(*backend);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, glBackend.getFramebufferID(frame->framebuffer));
+    glClearDepth(0);
+    glClear(GL_DEPTH_BUFFER_BIT);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+
+    _gpuContext->consumeFrameUpdates(frame);
+    backend->setStereoState(frame->stereoState);
+
+    auto frameStart = Clock::now();
+    for (size_t i = 0; i < frame->batches.size(); ++i) {
+        const auto& batch = *frame->batches[i];
+        if (!isTimed) {
+            backend->render(batch);
+            continue;
+        }
+
+        // each batch is bracketed by a query of its own, which reports the GPU time and the time the backend took
+        auto& batchTiming = timing.batches[i];
+        auto pending = std::make_shared<PendingQuery>();
+        PendingQuery* pendingPointer = pending.get();
+        pending->query = std::make_shared<gpu::Query>([&batchTiming, iteration, pendingPointer](const gpu::Query& query) {
+            batchTiming.gpu[iteration] = query.getGPUElapsedTime();
+            batchTiming.cpu[iteration] = query.getBatchElapsedTime();
+            pendingPointer->isResolved = true;
+        }, batchTiming.name);
+        _pendingQueries.push_back(pending);
+
+        gpu::ContextStats beginStats;
+        backend->getStats(beginStats);
+        _gpuContext->executeBatch("FrameBenchmark::beginQuery", [&](gpu::Batch& queryBatch) {
+            queryBatch.beginQuery(pending->query);
+        });
+        backend->render(batch);
+        _gpuContext->executeBatch("FrameBenchmark::endQuery", [&](gpu::Batch& queryBatch) {
+            queryBatch.endQuery(pending->query);
+        });
+        if (iteration == 0) {
+            gpu::ContextStats endStats;
+            backend->getStats(endStats);
+            gpu::ContextStats batchStats;
+            batchStats.evalDelta(beginStats, endStats);
+            batchTiming.drawcalls = batchStats._DSNumAPIDrawcalls;
+            batchTiming.triangles = batchStats._DSNumTriangles;
+        }
+    }
+    if (isTimed) {
+        timing.cpu[iteration] = getMilliseconds(frameStart, Clock::now());
+    }
+    (void)CHECK_GL_ERROR();
+}
+
+void FrameBenchmark::resolveQueries(bool wait) {
+    if (_pendingQueries.empty()) {
+        return;
+    }
+    if (wait) {
+        glFinish();
+    }
+
+    _gpuContext->executeBatch("FrameBenchmark::getQueries", [&](gpu::Batch& batch) {
+        for (const auto& pending : _pendingQueries) {
+            batch.getQuery(pending->query);
+        }
+    });
+    _pendingQueries.erase(std::remove_if(_pendingQueries.begin(), _pendingQueries.end(),
+        [](const std::shared_ptr<PendingQuery>& pending) { return pending->isResolved; }), _pendingQueries.end());
+
+    if (wait) {
+        _numUnresolvedQueries += (int)_pendingQueries.size();
+        _pendingQueries.clear();
+    }
+}
+
+QJsonObject FrameBenchmark::getResults() const {
+    QJsonObject results;
+    results["renderer"] = QString((const char*)glGetString(GL_RENDERER));
+    results["backend"] = QString::fromStdString(_gpuContext->getBackendVersion());
+    results["iterations"] = _settings.iterations;
+
+    // the batches of the same name are summed, across the frames too, since they're the same pass
+    struct Named {
+        int numBatches { 0 };
+        Samples gpu;
+        Samples cpu;
+    };
+    std::map<std::string, Named> named;
+
+    QJsonArray frames;
+    for (const auto& timing : _frames) {
+        Samples frameGPU(_settings.iterations, 0.0);
+        QJsonArray batches;
+        for (const auto& batchTiming : timing.batches) {
+            auto& namedTiming = named[batchTiming.name];
+            if (namedTiming.gpu.empty()) {
+                namedTiming.gpu.resize(_settings.iterations, 0.0);
+                namedTiming.cpu.resize(_settings.iterations, 0.0);
+            }
+            ++namedTiming.numBatches;
+            for (int i = 0; i < _settings.iterations; ++i) {
+                frameGPU[i] += batchTiming.gpu[i];
+                namedTiming.gpu[i] += batchTiming.gpu[i];
+                namedTiming.cpu[i] += batchTiming.cpu[i];
+            }
+
+            QJsonObject batch;
+            batch["name"] = QString::fromStdString(batchTiming.name);
+            batch["drawcalls"] = (int)batchTiming.drawcalls;
+            batch["triangles"] = (qint64)batchTiming.triangles;
+            batch["gpu_ms"] = summarize(batchTiming.gpu);
+            batch["cpu_ms"] = summarize(batchTiming.cpu);
+            batches.push_back(batch);
+        }
+
+        QJsonObject frame;
+        frame["name"] = timing.name;
+        frame["gpu_ms"] = summarize(frameGPU);
+        frame["cpu_ms"] = summarize(timing.cpu);
+        frame["batches"] = batches;
+        frames.push_back(frame);
+    }
+    results["frames"] = frames;
+
+    QJsonObject namedResults;
+    for (const auto& entry : named) {
+        QJsonObject namedResult;
+        namedResult["batches"] = entry.second.numBatches;
+        namedResult["gpu_ms"] = summarize(entry.second.gpu);
+        namedResult["cpu_ms"] = summarize(entry.second.cpu);
+        namedResults[QString::fromStdString(entry.first)] = namedResult;
+    }
+    results["named"] = namedResults;
+    return results;
+}
+
+bool FrameBenchmark::compare(const QJsonObject& results, const QJsonObject& baseline) const {
+    if (results["renderer"] != baseline["renderer"]) {
+        qWarning() << "The baseline was measured on" << baseline["renderer"].toString() << "rather than"
+            << results["renderer"].toString();
+    }
+
+    bool hasRegressed = false;
+    auto compareTimings = [&](const QString& name, const QJsonObject& current, const QJsonObject& previous) {
+        for (const char* key : { "gpu_ms", "cpu_ms" }) {
+            double now = current[key].toObject()[MEDIAN_KEY].toDouble();
+            double before = previous[key].toObject()[MEDIAN_KEY].toDouble();
+            double change = before > 0.0 ? (now - before) / before : 0.0;
+            bool regressed = now > before * (1.0 + _settings.tolerance) && now - before > _settings.minRegressionMsecs;
+            hasRegressed |= regressed;
+            qInfo().noquote() << (regressed ? "REGRESSED" : "         ") << name << key << QString::number(before, 'f', 3)
+                << "->" << QString::number(now, 'f', 3) << QString("(%1%)").arg(change * 100.0, 0, 'f', 1);
+        }
+    };
+
+    std::map<QString, QJsonObject> baselineFrames;
+    for (const auto& frame : baseline["frames"].toArray()) {
+        baselineFrames[frame.toObject()["name"].toString()] = frame.toObject();
+    }
+    for (const auto& value : results["frames"].toArray()) {
+        QJsonObject frame = value.toObject();
+        auto itr = baselineFrames.find(frame["name"].toString());
+        if (itr == baselineFrames.end()) {
+            qWarning() << "The baseline has no frame" << frame["name"].toString();
+            continue;
+        }
+        compareTimings("frame " + frame["name"].toString(), frame, itr->second);
+    }
+
+    QJsonObject named = results["named"].toObject();
+    QJsonObject baselineNamed = baseline["named"].toObject();
+    for (auto itr = named.constBegin(); itr != named.constEnd(); ++itr) {
+        if (baselineNamed.contains(itr.key())) {
+            compareTimings(itr.key(), itr.value().toObject(), baselineNamed[itr.key()].toObject());
+        }
+    }
+    return !hasRegressed;
+}
+
+FrameBenchmark::ReturnCode FrameBenchmark::run() {
+    if (_settings.iterations <= 0 || _settings.warmupIterations < 0) {
+        qCritical() << "The number of iterations must be positive";
+        return BAD_ARGUMENTS;
+    }
+
+    QJsonObject baseline;
+    if (!_settings.baselineFilename.isEmpty()) {
+        QFile file(_settings.baselineFilename);
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCritical() << "Failed to open file" << file.fileName();
+            return FAILED_TO_READ;
+        }
+        baseline = QJsonDocument::fromJson(file.readAll()).object();
+    }
+
+    if (!initialize() || !loadFrames()) {
+        return FAILED_TO_READ;
+    }
+
+    for (int i = 0; i < _settings.warmupIterations; ++i) {
+        for (auto& frame : _frames) {
+            replay(frame, -1);
+        }
+        glFinish();
+    }
+    for (int i = 0; i < _settings.iterations; ++i) {
+        for (auto& frame : _frames) {
+            replay(frame, i);
+        }
+        resolveQueries(false);
+    }
+    resolveQueries(true);
+    if (_numUnresolvedQueries > 0) {
+        qWarning() << _numUnresolvedQueries << "GPU queries never returned, their batches count as 0 ms";
+    }
+
+    QJsonObject results = getResults();
+    for (const auto& value : results["frames"].toArray()) {
+        QJsonObject frame = value.toObject();
+        qInfo().noquote() << frame["name"].toString() << "gpu" << frame["gpu_ms"].toObject()[MEDIAN_KEY].toDouble()
+            << "ms, cpu" << frame["cpu_ms"].toObject()[MEDIAN_KEY].toDouble() << "ms, median of"
+            << _settings.iterations << "replays";
+    }
+
+    if (!_settings.outputFilename.isEmpty()) {
+        QFile file(_settings.outputFilename);
+        if (!file.open(QIODevice::WriteOnly)) {
+            qCritical() << "Failed to open file" << file.fileName();
+            return FAILED_TO_WRITE;
+        }
+        file.write(QJsonDocument(results).toJson());
+    }
+
+    if (!baseline.isEmpty() && !compare(results, baseline)) {
+        return REGRESSED;
+    }
+    return SUCCESS;
+}
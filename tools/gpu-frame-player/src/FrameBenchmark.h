@@ -0,0 +1,95 @@
+//
+//  FrameBenchmark.h
+//  tools/gpu-frame-player/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_FrameBenchmark_h
+#define overte_FrameBenchmark_h
+
+#include <string>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QStringList>
+
+#include <gl/OffscreenGLCanvas.h>
+#include <gpu/Forward.h>
+
+/// Replays frames captured with gpu::writeFrame in an offscreen context, timing each of their batches on the GPU with
+/// gpu::Query and on the CPU, and compares the timings with a baseline from an earlier run, so that changes to the
+/// render path can be measured on fixed content.
+class FrameBenchmark {
+public:
+    enum ReturnCode {
+        SUCCESS = 0,
+        BAD_ARGUMENTS = 1,
+        FAILED_TO_READ = 2,
+        FAILED_TO_WRITE = 3,
+        REGRESSED = 4
+    };
+
+    struct Settings {
+        QStringList framePaths;         // .hfb files, or directories of them, that are replayed in this order
+        int iterations { 100 };
+        int warmupIterations { 10 };    // not timed, so that the shaders are compiled and the textures resident
+        QString outputFilename;
+        QString baselineFilename;
+        float tolerance { 0.1f };       // how much slower than the baseline a timing can be
+        double minRegressionMsecs { 0.05 }; // smaller changes are noise
+    };
+
+    FrameBenchmark(const Settings& settings);
+    ~FrameBenchmark();
+
+    ReturnCode run();
+
+private:
+    // the timings of each timed iteration, in msecs
+    using Samples = std::vector<double>;
+
+    struct BatchTiming {
+        std::string name;
+        uint32_t drawcalls { 0 };
+        uint32_t triangles { 0 };
+        Samples gpu;
+        Samples cpu;
+    };
+
+    struct FrameTiming {
+        QString name;
+        gpu::FramePointer frame;
+        std::vector<BatchTiming> batches;
+        Samples cpu;    // the whole frame, with the backend's own work between the batches
+    };
+
+    static QJsonObject summarize(const Samples& samples);
+
+    bool initialize();
+    bool loadFrames();
+    void replay(FrameTiming& frame, int iteration);
+    void resolveQueries(bool wait);
+    QJsonObject getResults() const;
+    bool compare(const QJsonObject& results, const QJsonObject& baseline) const;
+
+    Settings _settings;
+    OffscreenGLCanvas _canvas;
+    gpu::ContextPointer _gpuContext;
+    uint32_t _externalTexture { 0 };
+
+    std::vector<FrameTiming> _frames;
+
+    struct PendingQuery {
+        gpu::QueryPointer query;
+        bool isResolved { false };
+    };
+    std::vector<std::shared_ptr<PendingQuery>> _pendingQueries;
+    int _numUnresolvedQueries { 0 };
+};
+
+#endif // overte_FrameBenchmark_h
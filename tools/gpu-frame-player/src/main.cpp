@@ -7,9 +7,11 @@
 //
 
 #include <QtWidgets/QApplication>
+#include <QtCore/QCommandLineParser>
 #include <QtCore/QSharedPointer>
 
 #include <shared/FileLogger.h>
+#include "FrameBenchmark.h"
 #include "PlayerWindow.h"
 
 Q_DECLARE_LOGGING_CATEGORY(gpu_player_logging)
@@ -29,6 +31,42 @@ int main(int argc, char** argv) {
     QApplication app(argc, argv);
     logger.reset(new FileLogger());
     setup();
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Overte GPU Frame Player");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+    const QCommandLineOption benchmarkOption("benchmark", "replay the frames without a window and report their timings",
+                                             "iterations");
+    parser.addOption(benchmarkOption);
+    const QCommandLineOption warmupOption("warmup", "untimed replays before the benchmark", "iterations", "10");
+    parser.addOption(warmupOption);
+    const QCommandLineOption outputOption("o", "JSON file for the timings of the benchmark", "filename.json");
+    parser.addOption(outputOption);
+    const QCommandLineOption baselineOption("baseline", "timings of an earlier benchmark to compare with", "filename.json");
+    parser.addOption(baselineOption);
+    const QCommandLineOption toleranceOption("tolerance", "the percent a timing can regress by", "percent", "10");
+    parser.addOption(toleranceOption);
+    parser.addPositionalArgument("frames", "the .hfb frames, or directories of them, to benchmark");
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText();
+        parser.showHelp(FrameBenchmark::BAD_ARGUMENTS);
+    }
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+    }
+
+    if (parser.isSet(benchmarkOption)) {
+        FrameBenchmark::Settings settings;
+        settings.framePaths = parser.positionalArguments();
+        settings.iterations = parser.value(benchmarkOption).toInt();
+        settings.warmupIterations = parser.value(warmupOption).toInt();
+        settings.outputFilename = parser.value(outputOption);
+        settings.baselineFilename = parser.value(baselineOption);
+        settings.tolerance = parser.value(toleranceOption).toFloat() / 100.0f;
+        return FrameBenchmark(settings).run();
+    }
+
     PlayerWindow window;
     app.exec();
     return 0;
@@ -0,0 +1,239 @@
+//
+//  BakeQueue.cpp
+//  tools/oven/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BakeQueue.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+
+#include "ModelBakingLoggingCategory.h"
+
+const int BakeQueue::DEFAULT_CLAIM_TIMEOUT_SECS = 2 * 60 * 60;
+
+static const QString INPUTS_FOLDER = "inputs";
+static const QString JOBS_FOLDER = "jobs";
+static const QString CLAIMED_FOLDER = "claimed";
+static const QString WORK_FOLDER = "work";
+static const QString RESULTS_FOLDER = "results";
+static const QString FAILED_FOLDER = "failed";
+
+static const QString JOB_EXTENSION = ".json";
+static const QString ERRORS_EXTENSION = ".txt";
+
+static const QString INPUT_KEY = "input";
+static const QString TYPE_KEY = "type";
+static const QString COMPRESS_TEXTURES_KEY = "compressTextures";
+static const QString WORKER_KEY = "worker";
+static const QString TIME_KEY = "time";
+
+static bool copyDirectory(const QString& from, const QString& to) {
+    QDir source(from);
+    QDir destination(to);
+    if (!destination.mkpath(".")) {
+        return false;
+    }
+    QDirIterator it(from, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        QString relativePath = source.relativeFilePath(it.filePath());
+        QString targetPath = destination.filePath(relativePath);
+        destination.mkpath(QFileInfo(targetPath).path());
+        QFile::remove(targetPath);
+        if (!QFile::copy(it.filePath(), targetPath)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool writeJob(const QString& path, const QJsonObject& job) {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(QJsonDocument(job).toJson());
+    return file.commit();
+}
+
+static QJsonObject readJob(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QJsonObject();
+    }
+    return QJsonDocument::fromJson(file.readAll()).object();
+}
+
+BakeQueue::BakeQueue(const QString& path) : _directory(path) {
+    _isValid = true;
+    for (const auto& folder : { INPUTS_FOLDER, JOBS_FOLDER, CLAIMED_FOLDER, WORK_FOLDER, RESULTS_FOLDER, FAILED_FOLDER }) {
+        _isValid = _directory.mkpath(folder) && _isValid;
+    }
+    if (!_isValid) {
+        qCWarning(model_baking) << "Unable to create the bake queue in" << path;
+    }
+}
+
+QString BakeQueue::getKey(const QByteArray& input, const QString& type, int bakeVersion, bool compressTextures) {
+    QString hash = QCryptographicHash::hash(input, QCryptographicHash::Sha256).toHex();
+    return hash + "-" + type.toLower() + "-v" + QString::number(bakeVersion) + (compressTextures ? "" : "-uncompressed");
+}
+
+QString BakeQueue::getJobPath(const QString& folder, const QString& key) const {
+    return _directory.filePath(folder + "/" + key + JOB_EXTENSION);
+}
+
+QString BakeQueue::submit(const QString& inputFile, const QString& type, int bakeVersion, bool compressTextures) {
+    QFile file(inputFile);
+    if (!_isValid || !file.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+    QString key = getKey(file.readAll(), type, bakeVersion, compressTextures);
+    file.close();
+
+    auto status = getStatus(key);
+    if (status == Status::Done || status == Status::Pending) {
+        return key;
+    }
+    // failures aren't cached, they may not happen again
+    QFile::remove(_directory.filePath(FAILED_FOLDER + "/" + key + ERRORS_EXTENSION));
+
+    // the workers bake a copy of the input with the same name, so the output is named the same as a local bake
+    QString fileName = QFileInfo(inputFile).fileName();
+    QDir inputDirectory(_directory.filePath(INPUTS_FOLDER + "/" + key));
+    inputDirectory.mkpath(".");
+    QString inputPath = inputDirectory.filePath(fileName);
+    if (!QFile::exists(inputPath) && !QFile::copy(inputFile, inputPath)) {
+        qCWarning(model_baking) << "Unable to copy" << inputFile << "to the bake queue";
+        return QString();
+    }
+
+    QJsonObject job;
+    job[INPUT_KEY] = fileName;
+    job[TYPE_KEY] = type;
+    job[COMPRESS_TEXTURES_KEY] = compressTextures;
+    job[TIME_KEY] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    if (!writeJob(getJobPath(JOBS_FOLDER, key), job)) {
+        qCWarning(model_baking) << "Unable to add" << inputFile << "to the bake queue";
+        return QString();
+    }
+    return key;
+}
+
+BakeQueue::Status BakeQueue::getStatus(const QString& key) const {
+    if (_directory.exists(RESULTS_FOLDER + "/" + key)) {
+        return Status::Done;
+    }
+    if (_directory.exists(FAILED_FOLDER + "/" + key + ERRORS_EXTENSION)) {
+        return Status::Failed;
+    }
+    if (QFile::exists(getJobPath(JOBS_FOLDER, key)) || QFile::exists(getJobPath(CLAIMED_FOLDER, key))) {
+        return Status::Pending;
+    }
+    return Status::Unknown;
+}
+
+bool BakeQueue::copyResult(const QString& key, const QString& outputPath) const {
+    return copyDirectory(_directory.filePath(RESULTS_FOLDER + "/" + key), outputPath);
+}
+
+QString BakeQueue::getErrors(const QString& key) const {
+    QFile file(_directory.filePath(FAILED_FOLDER + "/" + key + ERRORS_EXTENSION));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+    return QString::fromUtf8(file.readAll());
+}
+
+bool BakeQueue::claimJob(Job& job, const QString& workerName) {
+    QDir jobs(_directory.filePath(JOBS_FOLDER));
+    auto entries = jobs.entryInfoList({ "*" + JOB_EXTENSION }, QDir::Files, QDir::Time | QDir::Reversed);
+    for (const auto& entry : entries) {
+        QString key = entry.completeBaseName();
+        QString claimedPath = getJobPath(CLAIMED_FOLDER, key);
+        // the rename is atomic, if another worker took this bake first it fails
+        if (!QFile::rename(entry.filePath(), claimedPath)) {
+            continue;
+        }
+
+        auto object = readJob(claimedPath);
+        // the claimed file is rewritten so that its modification time is the time it was claimed
+        object[WORKER_KEY] = workerName;
+        object[TIME_KEY] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+        writeJob(claimedPath, object);
+
+        job.key = key;
+        job.inputPath = _directory.filePath(INPUTS_FOLDER + "/" + key + "/" + object[INPUT_KEY].toString());
+        job.type = object[TYPE_KEY].toString();
+        job.compressTextures = object[COMPRESS_TEXTURES_KEY].toBool(true);
+        if (!QFile::exists(job.inputPath)) {
+            failJob(job, workerName, "The input of the bake is missing from the queue");
+            continue;
+        }
+        QDir(getWorkPath(job, workerName)).removeRecursively();
+        return true;
+    }
+    return false;
+}
+
+QString BakeQueue::getWorkPath(const Job& job, const QString& workerName) const {
+    return _directory.filePath(WORK_FOLDER + "/" + job.key + "." + workerName);
+}
+
+void BakeQueue::removeJob(const Job& job, const QString& workerName) {
+    QDir(getWorkPath(job, workerName)).removeRecursively();
+    QFile::remove(getJobPath(CLAIMED_FOLDER, job.key));
+    QDir(_directory.filePath(INPUTS_FOLDER + "/" + job.key)).removeRecursively();
+}
+
+bool BakeQueue::completeJob(const Job& job, const QString& workerName) {
+    QString resultPath = _directory.filePath(RESULTS_FOLDER + "/" + job.key);
+    bool completed = true;
+    // another worker may have finished it already, if it was requeued while this one was still baking
+    if (!QFile::exists(resultPath) && !_directory.rename(getWorkPath(job, workerName), resultPath)) {
+        completed = copyDirectory(getWorkPath(job, workerName), resultPath);
+    }
+    if (completed) {
+        QFile::remove(_directory.filePath(FAILED_FOLDER + "/" + job.key + ERRORS_EXTENSION));
+    } else {
+        qCWarning(model_baking) << "Unable to store the result of the bake" << job.key;
+        QDir(resultPath).removeRecursively();
+    }
+    removeJob(job, workerName);
+    return completed;
+}
+
+void BakeQueue::failJob(const Job& job, const QString& workerName, const QString& errors) {
+    QSaveFile file(_directory.filePath(FAILED_FOLDER + "/" + job.key + ERRORS_EXTENSION));
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(errors.toUtf8());
+        file.commit();
+    }
+    removeJob(job, workerName);
+}
+
+int BakeQueue::requeueStaleJobs(int timeoutSecs) {
+    int numRequeued = 0;
+    auto staleTime = QDateTime::currentDateTimeUtc().addSecs(-timeoutSecs);
+    QDir claimed(_directory.filePath(CLAIMED_FOLDER));
+    for (const auto& entry : claimed.entryInfoList({ "*" + JOB_EXTENSION }, QDir::Files)) {
+        if (entry.lastModified().toUTC() < staleTime &&
+            QFile::rename(entry.filePath(), getJobPath(JOBS_FOLDER, entry.completeBaseName()))) {
+            numRequeued++;
+        }
+    }
+    return numRequeued;
+}
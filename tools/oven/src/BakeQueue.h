@@ -0,0 +1,78 @@
+//
+//  BakeQueue.h
+//  tools/oven/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_BakeQueue_h
+#define overte_BakeQueue_h
+
+#include <QtCore/QDir>
+#include <QtCore/QString>
+
+/// A persistent queue of bakes kept in a directory, shared by the ovens submitting bakes and the ovens baking them,
+/// on this machine or on others mounting the same directory.  The bakes are keyed by the hash of their input, their
+/// type and their bake version, and their results are kept, so submitting an asset that didn't change reuses its result.
+///
+///     inputs/<key>/<file>    the file to bake, copied there by the submitter
+///     jobs/<key>.json        the bakes waiting for a worker
+///     claimed/<key>.json     the bakes a worker took, a worker renames them from jobs/ to claim them
+///     work/<key>.<worker>/   where a worker bakes
+///     results/<key>/         the output of the finished bakes
+///     failed/<key>.txt       the errors of the failed bakes
+class BakeQueue {
+public:
+    enum class Status {
+        Unknown,
+        Pending,
+        Done,
+        Failed
+    };
+
+    struct Job {
+        QString key;
+        QString inputPath;
+        QString type;
+        bool compressTextures { true };
+    };
+
+    // a claimed bake not finished after this long is given to another worker
+    static const int DEFAULT_CLAIM_TIMEOUT_SECS;
+
+    BakeQueue(const QString& path);
+
+    bool isValid() const { return _isValid; }
+    const QDir& getDirectory() const { return _directory; }
+
+    static QString getKey(const QByteArray& input, const QString& type, int bakeVersion, bool compressTextures);
+
+    /// Queues the bake of inputFile, unless its result is cached.  Returns its key, or an empty string on error
+    QString submit(const QString& inputFile, const QString& type, int bakeVersion, bool compressTextures);
+    Status getStatus(const QString& key) const;
+    /// Copies the output of a finished bake into outputPath
+    bool copyResult(const QString& key, const QString& outputPath) const;
+    QString getErrors(const QString& key) const;
+
+    /// Takes the oldest queued bake, returns false if there's none
+    bool claimJob(Job& job, const QString& workerName);
+    QString getWorkPath(const Job& job, const QString& workerName) const;
+    /// Moves the output of the bake from its work path to the results
+    bool completeJob(const Job& job, const QString& workerName);
+    void failJob(const Job& job, const QString& workerName, const QString& errors);
+    /// Puts back in the queue the bakes claimed by workers that stopped, returns how many there were
+    int requeueStaleJobs(int timeoutSecs = DEFAULT_CLAIM_TIMEOUT_SECS);
+
+private:
+    QString getJobPath(const QString& folder, const QString& key) const;
+    void removeJob(const Job& job, const QString& workerName);
+
+    QDir _directory;
+    bool _isValid { false };
+};
+
+#endif // overte_BakeQueue_h
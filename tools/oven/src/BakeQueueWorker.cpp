@@ -0,0 +1,75 @@
+//
+//  BakeQueueWorker.cpp
+//  tools/oven/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BakeQueueWorker.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QSysInfo>
+
+#include <TextureBaker.h>
+
+#include "BakerCLI.h"
+#include "ModelBakingLoggingCategory.h"
+
+BakeQueueWorker::BakeQueueWorker(const QString& bakeQueuePath, QObject* parent) :
+    QObject(parent),
+    _bakeQueue(bakeQueuePath),
+    _workerName(QSysInfo::machineHostName() + "-" + QString::number(QCoreApplication::applicationPid()))
+{
+    _pollTimer.setSingleShot(true);
+    connect(&_pollTimer, &QTimer::timeout, this, &BakeQueueWorker::bakeNextJob);
+}
+
+void BakeQueueWorker::start() {
+    if (!_bakeQueue.isValid()) {
+        QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+        return;
+    }
+    qCDebug(model_baking) << "Baking the jobs of the bake queue" << _bakeQueue.getDirectory().absolutePath() << "as" << _workerName;
+    bakeNextJob();
+}
+
+void BakeQueueWorker::bakeNextJob() {
+    int numRequeued = _bakeQueue.requeueStaleJobs();
+    if (numRequeued > 0) {
+        qCDebug(model_baking) << "Requeued" << numRequeued << "bakes claimed by workers that stopped";
+    }
+
+    while (_bakeQueue.claimJob(_job, _workerName)) {
+        qCDebug(model_baking) << "Baking" << _job.inputPath << "for the bake queue";
+        // the texture compression is part of the key of a bake, each job tells which it wants
+        TextureBaker::setCompressionEnabled(_job.compressTextures);
+        _baker = BakerCLI::createBaker(QUrl::fromLocalFile(_job.inputPath), _bakeQueue.getWorkPath(_job, _workerName), _job.type);
+        if (!_baker) {
+            _bakeQueue.failJob(_job, _workerName, "Failed to determine baker type for file");
+            continue;
+        }
+        connect(_baker.get(), &Baker::finished, this, &BakeQueueWorker::handleFinishedBaker);
+        QMetaObject::invokeMethod(_baker.get(), "bake");
+        return;
+    }
+
+    // nothing to bake, look again later
+    _pollTimer.start(BAKE_QUEUE_POLL_INTERVAL_MSECS);
+}
+
+void BakeQueueWorker::handleFinishedBaker() {
+    if (_baker->wasAborted()) {
+        _bakeQueue.failJob(_job, _workerName, "The bake was aborted");
+    } else if (_baker->hasErrors()) {
+        _bakeQueue.failJob(_job, _workerName, _baker->getErrors().join('\n'));
+    } else if (_bakeQueue.completeJob(_job, _workerName)) {
+        qCDebug(model_baking) << "Finished baking" << _job.inputPath << "for the bake queue";
+    }
+    // it's the sender of the signal being handled
+    _baker.release()->deleteLater();
+    QTimer::singleShot(0, this, &BakeQueueWorker::bakeNextJob);
+}
@@ -0,0 +1,46 @@
+//
+//  BakeQueueWorker.h
+//  tools/oven/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_BakeQueueWorker_h
+#define overte_BakeQueueWorker_h
+
+#include <memory>
+
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+
+#include "Baker.h"
+#include "BakeQueue.h"
+
+/// Bakes the jobs of a bake queue one after the other, until the oven is stopped
+class BakeQueueWorker : public QObject {
+    Q_OBJECT
+
+public:
+    BakeQueueWorker(const QString& bakeQueuePath, QObject* parent = nullptr);
+
+public slots:
+    void start();
+
+private slots:
+    void bakeNextJob();
+    void handleFinishedBaker();
+
+private:
+    BakeQueue _bakeQueue;
+    QString _workerName;
+    QTimer _pollTimer;
+
+    BakeQueue::Job _job;
+    std::unique_ptr<Baker> _baker;
+};
+
+#endif // overte_BakeQueueWorker_h
@@ -25,12 +25,14 @@
 #include "TextureBaker.h"
 #include "MaterialBaker.h"
 
-BakerCLI::BakerCLI(OvenCLIApplication* parent) : QObject(parent) {
-
+BakerCLI::BakerCLI(OvenCLIApplication* parent, const QString& bakeQueuePath, int bakeVersion) :
+    QObject(parent),
+    _bakeQueuePath(bakeQueuePath),
+    _bakeVersion(bakeVersion)
+{
 }
 
-void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type) {
-
+std::unique_ptr<Baker> BakerCLI::createBaker(QUrl inputUrl, const QString& outputPath, const QString& type) {
     // if the URL doesn't have a scheme, assume it is a local file
     if (inputUrl.scheme() != "http" && inputUrl.scheme() != "https" && inputUrl.scheme() != "ftp" && inputUrl.scheme() != "file") {
         inputUrl = QUrl::fromLocalFile(inputUrl.toString());
@@ -43,24 +45,19 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
     static const QString MATERIAL_EXTENSION { "material" };
     static const QString SCRIPT_EXTENSION { "js" };
 
-    _outputPath.setPath(outputPath);
+    std::unique_ptr<Baker> baker;
 
     // create our appropiate baker
     if (type == MODEL_EXTENSION || type == FBX_EXTENSION) {
         QUrl bakeableModelURL = getBakeableModelURL(inputUrl);
         if (!bakeableModelURL.isEmpty()) {
-            _baker = getModelBaker(bakeableModelURL, outputPath);
-            if (_baker) {
-                _baker->moveToThread(Oven::instance().getNextWorkerThread());
-            }
+            baker = getModelBaker(bakeableModelURL, outputPath);
         }
     } else if (type == SCRIPT_EXTENSION) {
         // FIXME: disabled for now because it breaks some scripts
-        //_baker = std::unique_ptr<Baker> { new JSBaker(inputUrl, outputPath) };
-        //_baker->moveToThread(Oven::instance().getNextWorkerThread());
+        //baker = std::unique_ptr<Baker> { new JSBaker(inputUrl, outputPath) };
     } else if (type == MATERIAL_EXTENSION) {
-        _baker = std::unique_ptr<Baker> { new MaterialBaker(inputUrl.toDisplayString(), true, outputPath) };
-        _baker->moveToThread(Oven::instance().getNextWorkerThread());
+        baker = std::unique_ptr<Baker> { new MaterialBaker(inputUrl.toDisplayString(), true, outputPath) };
     } else {
         // If the type doesn't match the above, we assume we have a texture, and the type specified is the
         // texture usage type (albedo, cubemap, normals, etc.)
@@ -91,15 +88,33 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
             auto it = STRING_TO_TEXTURE_USAGE_TYPE_MAP.find(type);
             if (it == STRING_TO_TEXTURE_USAGE_TYPE_MAP.end()) {
                 qCDebug(model_baking) << "Unknown texture usage type:" << type;
-                QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+                return nullptr;
             }
-            _baker = std::unique_ptr<Baker> { new TextureBaker(inputUrl, it->second, outputPath) };
-            _baker->moveToThread(Oven::instance().getNextWorkerThread());
+            baker = std::unique_ptr<Baker> { new TextureBaker(inputUrl, it->second, outputPath) };
         }
     }
 
-    if (!_baker) {
+    if (baker) {
+        baker->moveToThread(Oven::instance().getNextWorkerThread());
+    } else {
         qCDebug(model_baking) << "Failed to determine baker type for file" << inputUrl;
+    }
+    return baker;
+}
+
+void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type) {
+    _outputPath.setPath(outputPath);
+
+    // the local files are baked by the ovens serving the queue, the others are downloaded and baked here
+    if (!_bakeQueuePath.isEmpty() && (inputUrl.isLocalFile() || inputUrl.scheme().isEmpty())) {
+        QString inputFile = inputUrl.isLocalFile() ? inputUrl.toLocalFile() : inputUrl.toString();
+        _bakeQueue.reset(new BakeQueue(_bakeQueuePath));
+        submitToBakeQueue(inputFile, type);
+        return;
+    }
+
+    _baker = createBaker(inputUrl, outputPath, type);
+    if (!_baker) {
         QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
         return;
     }
@@ -111,6 +126,58 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
     connect(_baker.get(), &Baker::finished, this, &BakerCLI::handleFinishedBaker);
 }
 
+void BakerCLI::submitToBakeQueue(const QString& inputFile, const QString& type) {
+    QString key = _bakeQueue->submit(inputFile, type, _bakeVersion, TextureBaker::isCompressionEnabled());
+    if (key.isEmpty()) {
+        writeErrors({ "Unable to add the file to the bake queue" });
+        QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+        return;
+    }
+
+    auto checkStatus = [this, key, inputFile, type] {
+        switch (_bakeQueue->getStatus(key)) {
+            case BakeQueue::Status::Done:
+                _bakeQueueTimer.stop();
+                if (_bakeQueue->copyResult(key, _outputPath.absolutePath())) {
+                    qCDebug(model_baking) << "Finished baking file through the bake queue.";
+                    QCoreApplication::exit(OVEN_STATUS_CODE_SUCCESS);
+                } else {
+                    writeErrors({ "Unable to copy the result of the bake from the bake queue" });
+                    QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+                }
+                break;
+            case BakeQueue::Status::Failed:
+                _bakeQueueTimer.stop();
+                writeErrors({ _bakeQueue->getErrors(key) });
+                QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+                break;
+            case BakeQueue::Status::Unknown:
+                // the queue lost it, its result was removed before it was copied
+                _bakeQueueTimer.stop();
+                QTimer::singleShot(0, this, [this, inputFile, type] {
+                    submitToBakeQueue(inputFile, type);
+                });
+                break;
+            case BakeQueue::Status::Pending:
+                break;
+        }
+    };
+
+    _bakeQueueTimer.disconnect();
+    connect(&_bakeQueueTimer, &QTimer::timeout, this, checkStatus);
+    _bakeQueueTimer.start(BAKE_QUEUE_POLL_INTERVAL_MSECS);
+    checkStatus();
+}
+
+void BakerCLI::writeErrors(const QStringList& errors) {
+    QDir().mkpath(_outputPath.absolutePath());
+    QFile errorFile { _outputPath.absoluteFilePath(OVEN_ERROR_FILENAME) };
+    if (errorFile.open(QFile::WriteOnly)) {
+        errorFile.write(errors.join('\n').toUtf8());
+        errorFile.close();
+    }
+}
+
 void BakerCLI::handleFinishedBaker() {
     qCDebug(model_baking) << "Finished baking file.";
     int exitCode = OVEN_STATUS_CODE_SUCCESS;
@@ -119,11 +186,7 @@ void BakerCLI::handleFinishedBaker() {
         exitCode = OVEN_STATUS_CODE_ABORT;
     } else if (_baker->hasErrors()) {
         exitCode = OVEN_STATUS_CODE_FAIL;
-        QFile errorFile { _outputPath.absoluteFilePath(OVEN_ERROR_FILENAME) };
-        if (errorFile.open(QFile::WriteOnly)) {
-            errorFile.write(_baker->getErrors().join('\n').toUtf8());
-            errorFile.close();
-        }
+        writeErrors(_baker->getErrors());
     }
     QCoreApplication::exit(exitCode);
 }
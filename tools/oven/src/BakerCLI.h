@@ -13,12 +13,14 @@
 #define hifi_BakerCLI_h
 
 #include <QtCore/QObject>
+#include <QtCore/QTimer>
 #include <QDir>
 #include <QUrl>
 
 #include <memory>
 
 #include "Baker.h"
+#include "BakeQueue.h"
 #include "OvenCLIApplication.h"
 
 static const int OVEN_STATUS_CODE_SUCCESS { 0 };
@@ -27,11 +29,17 @@ static const int OVEN_STATUS_CODE_ABORT { 2 };
 
 static const QString OVEN_ERROR_FILENAME = "errors.txt";
 
+static const int BAKE_QUEUE_POLL_INTERVAL_MSECS { 1000 };
+
 class BakerCLI : public QObject {
     Q_OBJECT
 
 public:
-    BakerCLI(OvenCLIApplication* parent);
+    // when bakeQueuePath is set, the local files are baked by the ovens serving that bake queue
+    BakerCLI(OvenCLIApplication* parent, const QString& bakeQueuePath = QString(), int bakeVersion = 0);
+
+    /// Returns the baker for the type of asset, on an oven worker thread, or nullptr if the type isn't bakeable
+    static std::unique_ptr<Baker> createBaker(QUrl inputUrl, const QString& outputPath, const QString& type);
 
 public slots:
     void bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type = QString());
@@ -40,8 +48,16 @@ private slots:
     void handleFinishedBaker();  
 
 private:
+    void submitToBakeQueue(const QString& inputFile, const QString& type);
+    void writeErrors(const QStringList& errors);
+
     QDir _outputPath;
     std::unique_ptr<Baker> _baker;
+
+    QString _bakeQueuePath;
+    int _bakeVersion { 0 };
+    std::unique_ptr<BakeQueue> _bakeQueue;
+    QTimer _bakeQueueTimer;
 };
 
 #endif // hifi_BakerCLI_h
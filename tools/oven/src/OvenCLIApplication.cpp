@@ -20,20 +20,33 @@
 #include <TextureBaker.h>
 #include <crash-handler/CrashHandler.h>
 #include "BakerCLI.h"
+#include "BakeQueueWorker.h"
 
 static const QString CLI_INPUT_PARAMETER = "i";
 static const QString CLI_OUTPUT_PARAMETER = "o";
 static const QString CLI_TYPE_PARAMETER = "t";
 static const QString CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER = "disable-texture-compression";
+static const QString CLI_BAKE_QUEUE_PARAMETER = "queue";
+static const QString CLI_BAKE_QUEUE_WORKER_PARAMETER = "worker";
+static const QString CLI_BAKE_VERSION_PARAMETER = "bake-version";
 
 QUrl OvenCLIApplication::_inputUrlParameter;
 QUrl OvenCLIApplication::_outputUrlParameter;
 QString OvenCLIApplication::_typeParameter;
+QString OvenCLIApplication::_bakeQueueParameter;
+bool OvenCLIApplication::_bakeQueueWorkerParameter { false };
+int OvenCLIApplication::_bakeVersionParameter { 0 };
 
 OvenCLIApplication::OvenCLIApplication(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
 {
-    BakerCLI* cli = new BakerCLI(this);
+    if (_bakeQueueWorkerParameter) {
+        BakeQueueWorker* worker = new BakeQueueWorker(_bakeQueueParameter, this);
+        QMetaObject::invokeMethod(worker, "start", Qt::QueuedConnection);
+        return;
+    }
+
+    BakerCLI* cli = new BakerCLI(this, _bakeQueueParameter, _bakeVersionParameter);
     QMetaObject::invokeMethod(cli, "bakeFile", Qt::QueuedConnection, Q_ARG(QUrl, _inputUrlParameter),
                               Q_ARG(QString, _outputUrlParameter.toString()), Q_ARG(QString, _typeParameter));
 }
@@ -47,7 +60,11 @@ OvenCLIApplication::parseResult OvenCLIApplication::parseCommandLine(int argc, c
         { CLI_INPUT_PARAMETER, "Path to file that you would like to bake.", "input" },
         { CLI_OUTPUT_PARAMETER, "Path to folder that will be used as output.", "output" },
         { CLI_TYPE_PARAMETER, "Type of asset. [model|material]"/*|js]"*/, "type" },
-        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." }
+        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." },
+        { CLI_BAKE_QUEUE_PARAMETER, "Path to a bake queue shared with other ovens. The input is baked by the ovens serving the queue, "
+                                    "or its result reused if it was baked before.", "queue" },
+        { CLI_BAKE_QUEUE_WORKER_PARAMETER, "Bake the jobs of the bake queue until stopped." },
+        { CLI_BAKE_VERSION_PARAMETER, "Version of the bake, the results of a bake queue are kept per version.", "version" }
     });
 
 
@@ -92,6 +109,22 @@ OvenCLIApplication::parseResult OvenCLIApplication::parseCommandLine(int argc, c
         Q_UNREACHABLE();
     }
 
+    if (parser.isSet(CLI_BAKE_QUEUE_PARAMETER)) {
+        _bakeQueueParameter = QDir::fromNativeSeparators(parser.value(CLI_BAKE_QUEUE_PARAMETER));
+        _bakeVersionParameter = parser.value(CLI_BAKE_VERSION_PARAMETER).toInt();
+    }
+
+    if (parser.isSet(CLI_BAKE_QUEUE_WORKER_PARAMETER)) {
+        if (_bakeQueueParameter.isEmpty() || parser.isSet(CLI_INPUT_PARAMETER)) {
+            std::cout << "Error: A worker needs a queue and no input" << std::endl; // Avoid Qt log spam
+            QCoreApplication mockApp(argc, argv); // required for call to showHelp()
+            parser.showHelp();
+            Q_UNREACHABLE();
+        }
+        _bakeQueueWorkerParameter = true;
+        return OvenCLIApplication::CLIMode;
+    }
+
     if (parser.isSet(CLI_INPUT_PARAMETER) &&  parser.isSet(CLI_OUTPUT_PARAMETER)) {
         _inputUrlParameter = QDir::fromNativeSeparators(parser.value(CLI_INPUT_PARAMETER));
         _outputUrlParameter = QDir::fromNativeSeparators(parser.value(CLI_OUTPUT_PARAMETER));
@@ -47,6 +47,9 @@ private:
     static QUrl _inputUrlParameter;
     static QUrl _outputUrlParameter;
     static QString _typeParameter;
+    static QString _bakeQueueParameter;
+    static bool _bakeQueueWorkerParameter;
+    static int _bakeVersionParameter;
 };
 
 #endif // hifi_OvenCLIApplication_h
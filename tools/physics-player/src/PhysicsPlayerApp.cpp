@@ -0,0 +1,251 @@
+//
+//  PhysicsPlayerApp.cpp
+//  tools/physics-player/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "PhysicsPlayerApp.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+
+#include <QCommandLineParser>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QTextStream>
+
+#include <PhysicsEngine.h>
+#include <PhysicsRecorder.h>
+#include <ShapeManager.h>
+
+#include "ReplayMotionState.h"
+
+namespace {
+
+enum Phase {
+    TRANSACTION = 0,
+    CHANGES,
+    STEP,
+    EVENTS,
+    OUTGOING,
+    NUM_PHASES
+};
+
+const char* PHASE_NAMES[NUM_PHASES] = { "transaction", "changes", "step", "events", "outgoing" };
+
+using Clock = std::chrono::high_resolution_clock;
+
+double getMicroseconds(const Clock::time_point& start, const Clock::time_point& end) {
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+}
+
+PhysicsPlayerApp::PhysicsPlayerApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Overte Physics Recording Player");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "recording to replay", "filename");
+    parser.addOption(inputFilenameOption);
+    const QCommandLineOption outputFilenameOption("o", "CSV file for the timings of each step", "filename.csv");
+    parser.addOption(outputFilenameOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << Qt::endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    QFile file(parser.value(inputFilenameOption));
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open file" << file.fileName();
+        _returnCode = 2;
+        return;
+    }
+    QDataStream stream(&file);
+    if (!PhysicsRecorder::readHeader(stream)) {
+        qCritical() << file.fileName() << "is not a physics recording of version" << PhysicsRecorder::CURRENT_VERSION;
+        _returnCode = 3;
+        return;
+    }
+
+    QFile csvFile;
+    QTextStream csv;
+    if (parser.isSet(outputFilenameOption)) {
+        csvFile.setFileName(parser.value(outputFilenameOption));
+        if (!csvFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            qCritical() << "Failed to open file" << csvFile.fileName();
+            _returnCode = 2;
+            return;
+        }
+        csv.setDevice(&csvFile);
+        csv << "frame,bodies";
+        for (int phase = 0; phase < NUM_PHASES; ++phase) {
+            csv << "," << PHASE_NAMES[phase] << "_us";
+        }
+        csv << "\n";
+    }
+
+    ShapeManager shapeManager;
+    ObjectMotionState::setShapeManager(&shapeManager);
+    PhysicsEngine engine(glm::vec3(0.0f));
+    engine.init();
+
+    PhysicsRecorder::Shapes shapes;
+    PhysicsRecorder::Frame frame;
+    // ordered by id, so that the hash of the final state doesn't depend on the order of a hash table
+    std::map<quint32, ReplayMotionState*> motionStates;
+    PhysicsEngine::Transaction transaction;
+    VectorOfMotionStates kinematicObjects;
+
+    double totals[NUM_PHASES] = { 0.0 };
+    double maxima[NUM_PHASES] = { 0.0 };
+    uint32_t numFrames = 0;
+    size_t numCollisionEvents = 0;
+
+    while (PhysicsRecorder::readFrame(stream, frame, shapes)) {
+        double times[NUM_PHASES] = { 0.0 };
+
+        // removes and adds
+        Clock::time_point start = Clock::now();
+        transaction.clear();
+        for (quint32 id : frame.removedBodies) {
+            auto itr = motionStates.find(id);
+            if (itr != motionStates.end()) {
+                transaction.objectsToRemove.push_back(itr->second);
+            }
+        }
+        std::vector<ReplayMotionState*> added;
+        added.reserve(frame.addedBodies.size());
+        for (const auto& body : frame.addedBodies) {
+            ReplayMotionState* motionState = new ReplayMotionState(shapes.get(body.shapeID), body.state);
+            motionStates[body.id] = motionState;
+            transaction.objectsToAdd.push_back(motionState);
+            added.push_back(motionState);
+        }
+        engine.processTransaction(transaction);
+        for (quint32 id : frame.removedBodies) {
+            auto itr = motionStates.find(id);
+            if (itr != motionStates.end()) {
+                delete itr->second;
+                motionStates.erase(itr);
+            }
+        }
+        for (size_t i = 0; i < added.size(); ++i) {
+            btRigidBody* body = added[i]->getRigidBody();
+            if (body) {
+                body->forceActivationState(frame.addedBodies[i].state.activationState);
+            }
+        }
+        Clock::time_point end = Clock::now();
+        times[TRANSACTION] = getMicroseconds(start, end);
+
+        // changes made from outside of the simulation, and the kinematic bodies moved by the step
+        start = end;
+        for (const auto& change : frame.changedBodies) {
+            auto itr = motionStates.find(change.id);
+            if (itr != motionStates.end()) {
+                itr->second->setState(change.state);
+                if (itr->second->getMotionType() == MOTION_TYPE_STATIC && itr->second->getRigidBody()) {
+                    engine.getDynamicsWorld()->updateSingleAabb(itr->second->getRigidBody());
+                }
+            }
+        }
+        for (const auto& move : frame.movedBodies) {
+            auto itr = motionStates.find(move.id);
+            if (itr != motionStates.end()) {
+                itr->second->setTargetTransform(move.transform);
+            }
+        }
+        end = Clock::now();
+        times[CHANGES] = getMicroseconds(start, end);
+
+        start = end;
+        engine.stepSimulation(frame.timeStep);
+        end = Clock::now();
+        times[STEP] = getMicroseconds(start, end);
+
+        start = end;
+        if (engine.hasOutgoingChanges()) {
+            numCollisionEvents += engine.getCollisionEvents().size();
+        }
+        end = Clock::now();
+        times[EVENTS] = getMicroseconds(start, end);
+
+        start = end;
+        if (engine.hasOutgoingChanges()) {
+            engine.getChangedMotionStates();
+        }
+        end = Clock::now();
+        times[OUTGOING] = getMicroseconds(start, end);
+
+        if (csv.device()) {
+            csv << numFrames << "," << motionStates.size();
+        }
+        for (int phase = 0; phase < NUM_PHASES; ++phase) {
+            totals[phase] += times[phase];
+            maxima[phase] = std::max(maxima[phase], times[phase]);
+            if (csv.device()) {
+                csv << "," << times[phase];
+            }
+        }
+        if (csv.device()) {
+            csv << "\n";
+        }
+        ++numFrames;
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "The recording is truncated after frame" << numFrames;
+    }
+
+    // the final transforms, which are the same in every replay of a recording as long as the simulation is deterministic
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const auto& entry : motionStates) {
+        btTransform transform;
+        btRigidBody* body = entry.second->getRigidBody();
+        if (body) {
+            transform = body->getWorldTransform();
+        } else {
+            transform = entry.second->getTransform();
+        }
+        btTransformFloatData data;
+        transform.serializeFloat(data);
+        hash.addData((const char*)&entry.first, sizeof(entry.first));
+        hash.addData((const char*)&data, sizeof(data));
+    }
+
+    QTextStream out(stdout);
+    out << "frames: " << numFrames << ", bodies: " << motionStates.size() << ", collision events: " << numCollisionEvents << "\n";
+    for (int phase = 0; phase < NUM_PHASES; ++phase) {
+        double mean = numFrames > 0 ? totals[phase] / numFrames : 0.0;
+        out << PHASE_NAMES[phase] << ": total " << totals[phase] / 1000.0 << " ms, mean " << mean << " us, max " << maxima[phase] << " us\n";
+    }
+    out << "state hash: " << hash.result().toHex() << "\n";
+
+    VectorOfMotionStates objects;
+    objects.reserve(motionStates.size());
+    for (const auto& entry : motionStates) {
+        objects.push_back(entry.second);
+    }
+    engine.removeObjects(objects);
+    for (auto motionState : objects) {
+        delete motionState;
+    }
+}
+
+PhysicsPlayerApp::~PhysicsPlayerApp() {
+}
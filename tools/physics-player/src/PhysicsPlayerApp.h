@@ -0,0 +1,31 @@
+//
+//  PhysicsPlayerApp.h
+//  tools/physics-player/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_PhysicsPlayerApp_h
+#define overte_PhysicsPlayerApp_h
+
+#include <QCoreApplication>
+
+/// Replays a recording made with Test.startPhysicsRecording() through a PhysicsEngine, with fixed time steps and no
+/// rendering or networking, and prints how long each phase of the simulation took
+class PhysicsPlayerApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    PhysicsPlayerApp(int argc, char* argv[]);
+    ~PhysicsPlayerApp();
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    int _returnCode { 0 };
+};
+
+#endif // overte_PhysicsPlayerApp_h
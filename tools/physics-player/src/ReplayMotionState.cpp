@@ -0,0 +1,65 @@
+//
+//  ReplayMotionState.cpp
+//  tools/physics-player/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ReplayMotionState.h"
+
+ReplayMotionState::ReplayMotionState(const btCollisionShape* shape, const PhysicsRecorder::BodyState& state) :
+    ObjectMotionState(shape),
+    _state(state),
+    _id(QUuid::createUuid())
+{
+}
+
+ReplayMotionState::~ReplayMotionState() {
+    // the shapes belong to the recording, not to the ShapeManager
+    _shape = nullptr;
+}
+
+void ReplayMotionState::setState(const PhysicsRecorder::BodyState& state) {
+    bool massChanged = state.mass != _state.mass;
+    _state = state;
+    if (!_body) {
+        return;
+    }
+    _body->setWorldTransform(state.transform);
+    _body->setInterpolationWorldTransform(state.transform);
+    if (_motionType == MOTION_TYPE_DYNAMIC) {
+        if (massChanged) {
+            updateBodyMassProperties();
+        }
+        _body->setLinearVelocity(state.linearVelocity);
+        _body->setAngularVelocity(state.angularVelocity);
+        _body->setInterpolationLinearVelocity(state.linearVelocity);
+        _body->setInterpolationAngularVelocity(state.angularVelocity);
+        _body->setGravity(state.gravity);
+    }
+    updateBodyMaterialProperties();
+    _body->forceActivationState(state.activationState);
+    if (state.activationState == ACTIVE_TAG) {
+        _body->setDeactivationTime(0.0f);
+    }
+}
+
+PhysicsMotionType ReplayMotionState::computePhysicsMotionType() const {
+    if (_state.isKinematic) {
+        return MOTION_TYPE_KINEMATIC;
+    }
+    return (_state.collisionFlags & btCollisionObject::CF_STATIC_OBJECT) ? MOTION_TYPE_STATIC : MOTION_TYPE_DYNAMIC;
+}
+
+bool ReplayMotionState::isMoving() const {
+    return _state.linearVelocity.length2() > 0.0f || _state.angularVelocity.length2() > 0.0f;
+}
+
+void ReplayMotionState::computeCollisionGroupAndMask(int32_t& group, int32_t& mask) const {
+    group = _state.group;
+    mask = _state.mask;
+}
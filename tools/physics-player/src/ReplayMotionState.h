@@ -0,0 +1,66 @@
+//
+//  ReplayMotionState.h
+//  tools/physics-player/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef overte_ReplayMotionState_h
+#define overte_ReplayMotionState_h
+
+#include <BulletUtil.h>
+#include <ObjectMotionState.h>
+#include <PhysicsRecorder.h>
+
+/// The motion state of a recorded body, which the PhysicsEngine simulates as it did the object it was recorded from
+class ReplayMotionState : public ObjectMotionState {
+public:
+    ReplayMotionState(const btCollisionShape* shape, const PhysicsRecorder::BodyState& state);
+    ~ReplayMotionState() override;
+
+    /// Sets the body to state, as the changes made from outside of the simulation were
+    void setState(const PhysicsRecorder::BodyState& state);
+    /// Moves a kinematic body to transform in the next step
+    void setTargetTransform(const btTransform& transform) { _state.transform = transform; }
+    const btTransform& getTransform() const { return _state.transform; }
+
+    uint32_t getIncomingDirtyFlags() const override { return 0; }
+    void clearIncomingDirtyFlags(uint32_t mask = DIRTY_PHYSICS_FLAGS) override {}
+
+    PhysicsMotionType computePhysicsMotionType() const override;
+    bool isMoving() const override;
+
+    void getWorldTransform(btTransform& worldTrans) const override { worldTrans = _state.transform; }
+    void setWorldTransform(const btTransform& worldTrans) override { _state.transform = worldTrans; }
+
+    float getMass() const override { return _state.mass; }
+
+    float getObjectRestitution() const override { return _state.restitution; }
+    float getObjectFriction() const override { return _state.friction; }
+    float getObjectLinearDamping() const override { return _state.linearDamping; }
+    float getObjectAngularDamping() const override { return _state.angularDamping; }
+
+    glm::vec3 getObjectPosition() const override { return bulletToGLM(_state.transform.getOrigin()); }
+    glm::quat getObjectRotation() const override { return bulletToGLM(_state.transform.getRotation()); }
+    glm::vec3 getObjectLinearVelocity() const override { return bulletToGLM(_state.linearVelocity); }
+    glm::vec3 getObjectAngularVelocity() const override { return bulletToGLM(_state.angularVelocity); }
+    glm::vec3 getObjectGravity() const override { return bulletToGLM(_state.gravity); }
+
+    const QUuid getObjectID() const override { return _id; }
+    QUuid getSimulatorID() const override { return QUuid(); }
+    ShapeType getShapeType() const override { return SHAPE_TYPE_NONE; }
+
+    void computeCollisionGroupAndMask(int32_t& group, int32_t& mask) const override;
+
+    bool isLocallyOwnedOrShouldBe() const override { return _state.isOwned; }
+
+private:
+    PhysicsRecorder::BodyState _state;
+    QUuid _id;
+};
+
+#endif // overte_ReplayMotionState_h
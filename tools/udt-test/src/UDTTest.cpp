@@ -13,10 +13,13 @@
 #include "UDTTest.h"
 
 #include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
 
+#include <udt/CongestionControl.h>
 #include <udt/Constants.h>
 #include <udt/Packet.h>
 #include <udt/PacketList.h>
+#include <udt/SequenceNumberRing.h>
 
 #include <LogHandler.h>
 
@@ -57,6 +60,19 @@ const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
 
+const QCommandLineOption CONGESTION_CONTROL {
+    "congestion-control", "congestion control for sent packets, one of " +
+    udt::getCongestionControlNames().join(", ") + " (default is " + udt::VEGAS_CONGESTION_CONTROL_NAME + ")", "name"
+};
+const QCommandLineOption AB_TEST_INTERVAL {
+    "ab-test", "alternate the sender between each congestion control on a fresh connection every given number of "
+    "seconds and output a summary of each run", "seconds"
+};
+
+const QCommandLineOption SENT_LIST_BENCHMARK {
+    "sent-list-benchmark", "time the send queue's sent packet ring against a hash map, then quit"
+};
+
 const QStringList CLIENT_STATS_TABLE_HEADERS {
     "Send (Mb/s)", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)", "Period (us)",
     "Recv ACK", "Procd ACK", "Sent Packets", "Re-sent Packets"
@@ -71,6 +87,12 @@ UDTTest::UDTTest(int& argc, char** argv) :
     QCoreApplication(argc, argv)
 {
     parseArguments();
+
+    if (_argumentParser.isSet(SENT_LIST_BENCHMARK)) {
+        runSentListBenchmark();
+        QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        return;
+    }
     
     // randomize the seed for packet size randomization
     srand(time(NULL));
@@ -95,6 +117,38 @@ UDTTest::UDTTest(int& argc, char** argv) :
             qDebug() << "Packets will be sent to" << _target;
         }
     }
+
+    if (_argumentParser.isSet(CONGESTION_CONTROL)) {
+        QString name = _argumentParser.value(CONGESTION_CONTROL);
+        auto factory = udt::createCongestionControlFactory(name);
+
+        if (!factory) {
+            qCritical() << "Unknown congestion control" << name << "- expected one of"
+                << udt::getCongestionControlNames().join(", ");
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        } else {
+            _socket.setCongestionControlFactory(std::move(factory));
+            qDebug() << "Using" << name << "congestion control";
+        }
+    }
+
+    if (_argumentParser.isSet(AB_TEST_INTERVAL)) {
+        int intervalSeconds = _argumentParser.value(AB_TEST_INTERVAL).toInt();
+
+        if (_target.isNull() || intervalSeconds <= 0) {
+            qCritical() << "ab-test needs a target and a positive number of seconds per run.";
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        } else {
+            _abTestControllers = udt::getCongestionControlNames();
+            _socket.setCongestionControlFactory(udt::createCongestionControlFactory(_abTestControllers.front()));
+            qDebug() << "A/B testing" << _abTestControllers.join(", ") << "for" << intervalSeconds << "seconds each";
+
+            static const int MSECS_PER_SECOND = 1000;
+            QTimer* abTestTimer = new QTimer(this);
+            connect(abTestTimer, &QTimer::timeout, this, &UDTTest::switchCongestionControl);
+            abTestTimer->start(intervalSeconds * MSECS_PER_SECOND);
+        }
+    }
     
     if (_argumentParser.isSet(PACKET_SIZE)) {
         // parse the desired packet size
@@ -215,6 +269,84 @@ UDTTest::UDTTest(int& argc, char** argv) :
     statsTimer->start(_statsInterval);
 }
 
+// replays the send queue's use of its sent packet list - a full flow window in flight, a lookup for every lost packet
+// and an ACK every few packets - against the hash map it used to be and the sequence number ring it is now
+template <typename SentList, typename Find, typename ACK>
+static qint64 timeSentList(SentList& sentList, Find find, ACK ack, int windowSize, int numPackets) {
+    using namespace udt;
+
+    static const int ACK_INTERVAL = 16;
+    static const int LOSS_INTERVAL = 50;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    SequenceNumber nextSequenceNumber;
+    SequenceNumber lastACK;
+    uint64_t checksum = 0;
+
+    for (int i = 0; i < numPackets; ++i) {
+        sentList[nextSequenceNumber] = { 0, (uint64_t)i };
+        ++nextSequenceNumber;
+
+        if (i % LOSS_INTERVAL == 0) {
+            // NAKs are for packets that are still in flight
+            auto entry = find(sentList, nextSequenceNumber - std::max(1, windowSize / 2));
+            if (entry) {
+                ++entry->first;
+                checksum += entry->second;
+            }
+        }
+
+        if (i % ACK_INTERVAL == 0 && seqlen(lastACK, nextSequenceNumber) > windowSize) {
+            auto ackNumber = nextSequenceNumber - windowSize;
+            ack(sentList, lastACK, ackNumber);
+            lastACK = ackNumber;
+        }
+    }
+
+    auto elapsed = timer.nsecsElapsed();
+
+    // keeps the lookups from being optimized out
+    qDebug() << "    checksum" << checksum;
+    return elapsed;
+}
+
+void UDTTest::runSentListBenchmark() {
+    using namespace udt;
+    using Entry = std::pair<uint8_t, uint64_t>;
+    using Map = std::unordered_map<SequenceNumber, Entry>;
+    using Ring = SequenceNumberRing<Entry>;
+
+    static const int NUM_PACKETS = 10000000;
+
+    for (int windowSize : { 64, 1024, 8192, 25600 }) {
+        qDebug() << "Sent list benchmark -" << NUM_PACKETS << "packets with a window of" << windowSize;
+
+        Map map;
+        auto mapTime = timeSentList(map,
+            [](Map& list, SequenceNumber seq) {
+                auto it = list.find(seq);
+                return it != list.end() ? &it->second : nullptr;
+            },
+            [](Map& list, SequenceNumber lastACK, SequenceNumber ack) {
+                for (auto seq = lastACK; seq <= ack; ++seq) {
+                    list.erase(seq);
+                }
+            },
+            windowSize, NUM_PACKETS);
+
+        Ring ring;
+        auto ringTime = timeSentList(ring,
+            [](Ring& list, SequenceNumber seq) { return list.find(seq); },
+            [](Ring& list, SequenceNumber, SequenceNumber ack) { list.eraseUpTo(ack); },
+            windowSize, NUM_PACKETS);
+
+        qDebug() << "    unordered_map" << QString::number(mapTime / (double)NUM_PACKETS, 'f', 1) << "ns/packet";
+        qDebug() << "    SequenceNumberRing" << QString::number(ringTime / (double)NUM_PACKETS, 'f', 1) << "ns/packet";
+    }
+}
+
 void UDTTest::parseArguments() {
     // use a QCommandLineParser to setup command line arguments and give helpful output
     _argumentParser.setApplicationDescription("High Fidelity UDT Protocol Test Client");
@@ -225,7 +357,7 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL, CONGESTION_CONTROL, AB_TEST_INTERVAL, SENT_LIST_BENCHMARK
     });
     
     if (!_argumentParser.parse(arguments())) {
@@ -332,6 +464,32 @@ void UDTTest::sendPacket() {
     
 }
 
+void UDTTest::switchCongestionControl() {
+    static const double USECS_PER_MSEC = 1000.0;
+    static const double PPS_TO_MBPS = udt::MAX_PACKET_SIZE * 8.0 / 1000000.0;
+
+    // summarize the run that just finished
+    const QString& name = _abTestControllers[_abTestIndex];
+    int samples = std::max(_abTestRun.samples, 1);
+    double retransmitPercent = _abTestRun.sentPackets > 0 ?
+        100.0 * _abTestRun.retransmittedPackets / _abTestRun.sentPackets : 0.0;
+
+    qDebug() << qPrintable(QString("A/B run %1 - %2: avg send %3 Mb/s, avg RTT %4 ms, %5 sent, %6 re-sent (%7%)")
+        .arg(++_abTestRunCount).arg(name, -5)
+        .arg(_abTestRun.sendRate / samples * PPS_TO_MBPS, 0, 'f', 2)
+        .arg(_abTestRun.rtt / samples / USECS_PER_MSEC, 0, 'f', 2)
+        .arg(_abTestRun.sentPackets).arg(_abTestRun.retransmittedPackets)
+        .arg(retransmitPercent, 0, 'f', 2));
+    _abTestRun = ABTestRun();
+
+    // start the next controller on a fresh connection so it doesn't inherit the last one's state
+    _abTestIndex = (_abTestIndex + 1) % _abTestControllers.size();
+    _socket.setCongestionControlFactory(udt::createCongestionControlFactory(_abTestControllers[_abTestIndex]));
+    _socket.cleanupConnection(_target);
+
+    sendInitialPackets();
+}
+
 void UDTTest::handleMessage(std::unique_ptr<Message> message) {
     // generate the byte array that should match this message - using the same seed the sender did
     
@@ -374,6 +532,14 @@ void UDTTest::sampleStats() {
         }
         
         udt::ConnectionStats::Stats stats = _socket.sampleStatsForConnection(_target);
+
+        if (!_abTestControllers.isEmpty()) {
+            ++_abTestRun.samples;
+            _abTestRun.sendRate += stats.sendRate;
+            _abTestRun.rtt += stats.rtt;
+            _abTestRun.sentPackets += stats.sentPackets;
+            _abTestRun.retransmittedPackets += stats.retransmittedPackets;
+        }
         
         int headerIndex = -1;
         
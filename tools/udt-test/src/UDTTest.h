@@ -39,9 +39,11 @@ public:
 public slots:
     void refillPacket() { sendPacket(); } // adds a new packet to the queue when we are told one is sent
     void sampleStats();
+    void switchCongestionControl(); // ends the current A/B test run and starts the next controller
     
 private:
     void parseArguments();
+    void runSentListBenchmark(); // compares sent packet list containers for the send queue
     void handleMessage(std::unique_ptr<Message> message);
     
     void sendInitialPackets(); // fills the queue with packets to start
@@ -72,6 +74,19 @@ private:
     int _totalQueuedBytes { 0 }; // keeps track of the number of bytes we have already queued
     
     int _statsInterval { 100 }; // recording interval for stats in milliseconds
+
+    struct ABTestRun {
+        int samples { 0 };
+        double sendRate { 0.0 }; // summed over samples, in packets per second
+        double rtt { 0.0 }; // summed over samples, in microseconds
+        int sentPackets { 0 };
+        int retransmittedPackets { 0 };
+    };
+
+    QStringList _abTestControllers; // congestion controls being alternated between, empty unless A/B testing
+    int _abTestIndex { 0 };
+    int _abTestRunCount { 0 };
+    ABTestRun _abTestRun;
 };
 
 #endif // hifi_UDTTest_h